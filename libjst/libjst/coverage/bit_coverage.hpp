@@ -13,7 +13,11 @@
 #pragma once
 
 #include <algorithm>
+#include <cstdint>
+#include <memory>
 #include <ranges>
+#include <span>
+#include <stdexcept>
 
 #include <libjst/coverage/concept.hpp>
 #include <libjst/coverage/range_domain.hpp>
@@ -23,11 +27,33 @@ namespace libjst
 {
 
     template <std::unsigned_integral value_t>
+    class bit_coverage_view;
+
+    template <std::unsigned_integral value_t>
+    class run_length_coverage_view;
+
+    /*!\brief A coverage storing one bit per member of its coverage domain.
+     *
+     * \tparam value_t The value type of the coverage domain.
+     * \tparam allocator_t The allocator of the bits; defaults to std::allocator.
+     *
+     * \details
+     *
+     * The coverages of the traversed nodes are copied on every branch. With a libjst::arena_allocator these copies
+     * are allocated from the arena of the traversing thread instead of the global heap.
+     */
+    template <std::unsigned_integral value_t, typename allocator_t = std::allocator<uint64_t>>
     class bit_coverage {
 
+        template <std::unsigned_integral>
+        friend class bit_coverage_view;
+
+        template <std::unsigned_integral>
+        friend class run_length_coverage_view;
+
         using coverage_domain_t = range_domain<value_t>;
         using domain_value_type = typename coverage_domain_t::value_type;
-        using data_type = bit_vector<>;
+        using data_type = bit_vector<allocator_t>;
 
         data_type _data{};
         [[no_unique_address]] coverage_domain_t _domain{};
@@ -69,6 +95,21 @@ namespace libjst
             });
         }
 
+        //!\brief Constructs the coverage from a copy of the bits referenced by the given view.
+        explicit constexpr bit_coverage(bit_coverage_view<value_t> const & view) :
+            bit_coverage{view.get_domain()}
+        {
+            std::ranges::copy(view.words(), _data.data());
+        }
+
+        //!\brief Constructs the coverage by decoding the runs referenced by the given view.
+        //!\details Implicit, such that the decoded coverage is the common reference of the view and the coverage.
+        constexpr bit_coverage(run_length_coverage_view<value_t> const & view) :
+            bit_coverage{view.get_domain()}
+        {
+            view.decode_into(_data.data());
+        }
+
         explicit constexpr bit_coverage(std::initializer_list<value_type> from_list, coverage_domain_t domain) :
             bit_coverage{std::move(domain)}
         {
@@ -79,7 +120,27 @@ namespace libjst
             });
         }
 
-
+        /*!\brief Constructs the coverage from its packed bits, e.g. the genotypes of a variant over the samples.
+         *
+         * \param[in] words The bits of the coverage, where bit `i % 64` of the word `i / 64` is set if `i` is a member.
+         * \param[in] domain The coverage domain.
+         *
+         * \details
+         *
+         * The words are copied as a whole instead of setting every member on its own. The bits beyond the domain in
+         * the last word are ignored. Throws std::invalid_argument if there are fewer words than the domain needs.
+         */
+        static constexpr bit_coverage from_words(std::span<uint64_t const> words, coverage_domain_t domain) {
+            bit_coverage coverage{std::move(domain)};
+            std::size_t const word_count = (coverage.max_size() + 63) / 64;
+            if (words.size() < word_count)
+                throw std::invalid_argument{"The words must hold a bit for every member of the coverage domain!"};
+
+            std::ranges::copy(words.first(word_count), coverage._data.data());
+            if (std::size_t const tail_size = coverage.max_size() % 64; tail_size != 0)
+                coverage._data.data()[word_count - 1] &= (uint64_t{1} << tail_size) - 1;
+            return coverage;
+        }
 
         // explicit constexpr bit_coverage(std::initializer_list<value_type> init_list, coverage_domain_t domain) :
         //     bit_coverage{std::move(domain)}
@@ -144,6 +205,11 @@ namespace libjst
             return _domain;
         }
 
+        //!\brief Returns the words storing the bits of the coverage.
+        constexpr std::span<uint64_t const> words() const noexcept {
+            return {_data.data(), (max_size() + 63) / 64};
+        }
+
         constexpr iterator begin() const noexcept {
             return _data.begin();
         }
@@ -156,6 +222,11 @@ namespace libjst
             return _data.any();
         }
 
+        //!\brief Returns the number of bytes allocated for the bits.
+        constexpr size_t memory_usage() const noexcept {
+            return _data.memory_usage();
+        }
+
         // ----------------------------------------------------------------------------
         // Serialisation
         // ----------------------------------------------------------------------------
@@ -192,5 +263,54 @@ namespace libjst
             return bit_coverage{first._data.and_not(second._data), first.get_domain()};
         }
 
+        constexpr friend bit_coverage
+        tag_invoke(libjst::tag_t<coverage_union>, bit_coverage const & first, bit_coverage const & second) {
+            return bit_coverage{first._data | second._data, first.get_domain()};
+        }
+
+        constexpr friend bool
+        tag_invoke(libjst::tag_t<coverage_intersects>,
+                   bit_coverage const & first,
+                   bit_coverage const & second) noexcept {
+            return first._data.intersects(second._data);
+        }
+
+        constexpr friend size_t
+        tag_invoke(libjst::tag_t<coverage_intersection_count>,
+                   bit_coverage const & first,
+                   bit_coverage const & second) noexcept {
+            return first._data.intersection_count(second._data);
+        }
+
+        constexpr friend bit_coverage &
+        tag_invoke(libjst::tag_t<coverage_intersect_into>,
+                   bit_coverage & target,
+                   bit_coverage const & first,
+                   bit_coverage const & second) {
+            target._domain = first.get_domain();
+            target._data.assign_and(first._data, second._data);
+            return target;
+        }
+
+        constexpr friend bit_coverage &
+        tag_invoke(libjst::tag_t<coverage_difference_into>,
+                   bit_coverage & target,
+                   bit_coverage const & first,
+                   bit_coverage const & second) {
+            target._domain = first.get_domain();
+            target._data.assign_and_not(first._data, second._data);
+            return target;
+        }
+
+        constexpr friend bit_coverage &
+        tag_invoke(libjst::tag_t<coverage_union_into>,
+                   bit_coverage & target,
+                   bit_coverage const & first,
+                   bit_coverage const & second) {
+            target._domain = first.get_domain();
+            target._data.assign_or(first._data, second._data);
+            return target;
+        }
+
     };
 }  // namespace libjst
@@ -0,0 +1,271 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides a container storing the words of many bit coverages in one contiguous buffer.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/coverage/bit_coverage_view.hpp>
+#include <libjst/coverage/range_domain.hpp>
+#include <libjst/utility/huge_pages.hpp>
+#include <libjst/utility/prefetch.hpp>
+
+namespace libjst
+{
+
+    /*!\brief A random access container of bit coverages sharing one coverage domain.
+     *
+     * \tparam value_t The value type of the coverage domain.
+     *
+     * \details
+     *
+     * Instead of allocating one bit vector per coverage, the words of all stored coverages are kept in a single buffer,
+     * where the i-th coverage occupies the words `[i * w, (i + 1) * w)` with `w` being the number of words per
+     * coverage. The elements are accessed through a libjst::bit_coverage_view into this buffer, hence iterating the
+     * coverages streams linearly through memory. The coverage domain is adopted from the first inserted coverage and
+     * all further coverages must share it.
+     *
+     * The container can be used as storage of a libjst::contiguous_multimap. Inserting or reserving memory invalidates
+     * all views handed out before.
+     */
+    template <std::unsigned_integral value_t>
+    class bit_coverage_pool {
+    private:
+
+        using coverage_domain_t = range_domain<value_t>;
+        using word_type = uint64_t;
+        using buffer_type = std::vector<word_type>;
+
+        class iterator_impl;
+
+        buffer_type _words{};
+        coverage_domain_t _domain{};
+        std::size_t _size{};
+
+    public:
+
+        using value_type = bit_coverage<value_t>;
+        using reference = bit_coverage_view<value_t>;
+        using const_reference = reference;
+        using iterator = iterator_impl;
+        using const_iterator = iterator_impl;
+        using difference_type = std::ptrdiff_t;
+        using size_type = std::size_t;
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        constexpr bit_coverage_pool() = default; //!< Default.
+
+        //!\brief Constructs an empty pool for coverages over the given domain.
+        constexpr explicit bit_coverage_pool(coverage_domain_t domain) : _domain{std::move(domain)}
+        {}
+        //!\}
+
+        /*!\brief Inserts a copy of the coverage before the given position.
+         *
+         * \param[in] pos The position to insert the coverage at.
+         * \param[in] coverage The coverage to insert.
+         *
+         * \returns An iterator to the inserted coverage.
+         *
+         * \details
+         *
+         * Throws std::domain_error if the pool is not empty and the coverage domains differ.
+         */
+        iterator insert(const_iterator pos, value_type const & coverage) {
+            if (empty())
+                _domain = coverage.get_domain();
+            else if (coverage.get_domain() != _domain)
+                throw std::domain_error{"Trying to insert a coverage from a different coverage domain!"};
+
+            difference_type const offset = pos - begin();
+            auto words = reference{coverage}.words();
+            auto words_it = std::ranges::next(_words.begin(), offset * static_cast<difference_type>(stride()));
+            _words.insert(words_it, words.begin(), words.end());
+            ++_size;
+            return std::ranges::next(begin(), offset);
+        }
+
+        constexpr void reserve(size_type const new_capacity) {
+            _words.reserve(new_capacity * stride());
+        }
+
+        constexpr void clear() noexcept {
+            _words.clear();
+            _size = 0;
+        }
+
+        constexpr reference operator[](difference_type const idx) const noexcept {
+            return begin()[idx];
+        }
+
+        constexpr size_type size() const noexcept {
+            return _size;
+        }
+
+        constexpr bool empty() const noexcept {
+            return size() == 0;
+        }
+
+        //!\brief Returns the number of bytes allocated for the words of all coverages.
+        constexpr size_type memory_usage() const noexcept {
+            return _words.capacity() * sizeof(word_type);
+        }
+
+        //!\brief Prefetches the first words of the coverage at the given position if it exists.
+        [[gnu::always_inline]] void prefetch(difference_type const position) const noexcept {
+            if (position >= 0 && static_cast<size_type>(position) < size())
+                libjst::prefetch(_words.data() + position * static_cast<difference_type>(stride()));
+        }
+
+        //!\brief Advises the kernel to back the words by transparent huge pages, see libjst::advise_huge_pages.
+        size_type advise_huge_pages() const noexcept {
+            return libjst::advise_huge_pages(_words);
+        }
+
+        //!\brief Returns the number of words stored per coverage.
+        constexpr size_type stride() const noexcept {
+            return reference::word_count(_domain);
+        }
+
+        constexpr coverage_domain_t const & get_domain() const noexcept {
+            return _domain;
+        }
+
+        constexpr iterator begin() const noexcept {
+            return iterator{this, 0};
+        }
+
+        constexpr iterator end() const noexcept {
+            return iterator{this, static_cast<difference_type>(size())};
+        }
+
+        // ----------------------------------------------------------------------------
+        // Serialisation
+        // ----------------------------------------------------------------------------
+
+        template <typename archive_t>
+        void load(archive_t & iarchive)
+        {
+            iarchive(_words, _domain, _size);
+        }
+
+        template <typename archive_t>
+        void save(archive_t & oarchive) const
+        {
+            oarchive(_words, _domain, _size);
+        }
+    };
+
+    //!\brief Random access iterator over the coverages of the pool.
+    template <std::unsigned_integral value_t>
+    class bit_coverage_pool<value_t>::iterator_impl {
+    public:
+
+        using value_type = bit_coverage_pool::value_type;
+        using reference = bit_coverage_pool::reference;
+        using difference_type = bit_coverage_pool::difference_type;
+        using pointer = void;
+        using iterator_category = std::random_access_iterator_tag;
+
+    private:
+
+        friend bit_coverage_pool;
+
+        bit_coverage_pool const * _pool{};
+        difference_type _position{};
+
+        constexpr explicit iterator_impl(bit_coverage_pool const * pool, difference_type const position) noexcept :
+            _pool{pool},
+            _position{position}
+        {}
+
+    public:
+
+        constexpr iterator_impl() = default;
+
+        constexpr reference operator*() const noexcept {
+            difference_type const stride = static_cast<difference_type>(_pool->stride());
+            return reference{_pool->_words.data() + _position * stride, _pool->get_domain()};
+        }
+
+        constexpr reference operator[](difference_type const step) const noexcept {
+            return *(*this + step);
+        }
+
+        constexpr iterator_impl & operator++() noexcept {
+            ++_position;
+            return *this;
+        }
+
+        constexpr iterator_impl operator++(int) noexcept {
+            iterator_impl tmp{*this};
+            ++(*this);
+            return tmp;
+        }
+
+        constexpr iterator_impl & operator+=(difference_type const step) noexcept {
+            _position += step;
+            return *this;
+        }
+
+        constexpr iterator_impl & operator--() noexcept {
+            --_position;
+            return *this;
+        }
+
+        constexpr iterator_impl operator--(int) noexcept {
+            iterator_impl tmp{*this};
+            --(*this);
+            return tmp;
+        }
+
+        constexpr iterator_impl & operator-=(difference_type const step) noexcept {
+            _position -= step;
+            return *this;
+        }
+
+    private:
+
+        constexpr friend iterator_impl operator+(iterator_impl lhs, difference_type const step) noexcept {
+            return lhs += step;
+        }
+
+        constexpr friend iterator_impl operator+(difference_type const step, iterator_impl rhs) noexcept {
+            return rhs += step;
+        }
+
+        constexpr friend iterator_impl operator-(iterator_impl lhs, difference_type const step) noexcept {
+            return lhs -= step;
+        }
+
+        constexpr friend difference_type operator-(iterator_impl const & lhs, iterator_impl const & rhs) noexcept {
+            return lhs._position - rhs._position;
+        }
+
+        constexpr friend bool operator==(iterator_impl const & lhs, iterator_impl const & rhs) noexcept {
+            return lhs._position == rhs._position;
+        }
+
+        constexpr friend std::strong_ordering operator<=>(iterator_impl const & lhs, iterator_impl const & rhs) noexcept {
+            return lhs._position <=> rhs._position;
+        }
+    };
+}  // namespace libjst
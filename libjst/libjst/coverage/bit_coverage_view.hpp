@@ -0,0 +1,316 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides a non-owning view over the bits of a bit coverage.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <compare>
+#include <cstdint>
+#include <iterator>
+#include <span>
+#include <type_traits>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/coverage/concept.hpp>
+#include <libjst/coverage/range_domain.hpp>
+
+namespace libjst
+{
+
+    /*!\brief A read-only view over the words of a bit coverage.
+     *
+     * \tparam value_t The value type of the coverage domain.
+     *
+     * \details
+     *
+     * The view references the words of a libjst::bit_coverage or a slice of a libjst::bit_coverage_pool and behaves
+     * like a constant bit coverage. It is cheap to copy and is invalidated whenever the referenced words are
+     * reallocated. Intersections and differences with other views or bit coverages operate directly on the referenced
+     * words and return an owning libjst::bit_coverage.
+     */
+    template <std::unsigned_integral value_t>
+    class bit_coverage_view {
+    private:
+
+        using coverage_domain_t = range_domain<value_t>;
+        using domain_value_type = typename coverage_domain_t::value_type;
+        using word_type = uint64_t;
+
+        class iterator_impl;
+
+        static constexpr std::size_t word_size = sizeof(word_type) * 8;
+
+        word_type const * _words{};
+        coverage_domain_t _domain{};
+
+    public:
+
+        using value_type = domain_value_type;
+        using iterator = iterator_impl;
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        constexpr bit_coverage_view() = default; //!< Default.
+
+        //!\brief Constructs a view over the words of the given coverage.
+        constexpr bit_coverage_view(bit_coverage<value_t> const & coverage) noexcept :
+            _words{coverage._data.data()},
+            _domain{coverage.get_domain()}
+        {}
+
+        //!\brief Constructs a view over `word_count(domain)` many words beginning at `words`.
+        constexpr explicit bit_coverage_view(word_type const * words, coverage_domain_t domain) noexcept :
+            _words{words},
+            _domain{std::move(domain)}
+        {}
+        //!\}
+
+        //!\brief Returns the number of words needed to store a coverage over the given domain.
+        static constexpr std::size_t word_count(coverage_domain_t const & domain) noexcept {
+            return (domain.size() + word_size - 1) / word_size;
+        }
+
+        constexpr bool operator[](std::ptrdiff_t idx) const noexcept {
+            return begin()[idx];
+        }
+
+        constexpr value_type front() const noexcept {
+            assert(!empty());
+            return *begin();
+        }
+
+        constexpr value_type back() const noexcept {
+            assert(!empty());
+            return *std::ranges::prev(end());
+        }
+
+        constexpr bool empty() const noexcept {
+            return !any();
+        }
+
+        constexpr bool any() const noexcept {
+            return std::ranges::any_of(words(), [] (word_type const word) { return word != 0; });
+        }
+
+        constexpr size_t size() const noexcept {
+            return max_size();
+        }
+
+        constexpr size_t max_size() const noexcept {
+            return get_domain().size();
+        }
+
+        constexpr coverage_domain_t const & get_domain() const noexcept {
+            return _domain;
+        }
+
+        //!\brief Returns the referenced words.
+        constexpr std::span<word_type const> words() const noexcept {
+            return {_words, word_count(get_domain())};
+        }
+
+        constexpr iterator begin() const noexcept {
+            return iterator{_words, 0};
+        }
+
+        constexpr iterator end() const noexcept {
+            return iterator{_words, static_cast<std::ptrdiff_t>(size())};
+        }
+
+    private:
+
+        constexpr friend bool operator==(bit_coverage_view const & lhs, bit_coverage_view const & rhs) noexcept {
+            return lhs.get_domain() == rhs.get_domain() && std::ranges::equal(lhs.words(), rhs.words());
+        }
+
+        template <typename word_op_t>
+        static constexpr bit_coverage<value_t> transform_words(bit_coverage_view const & first,
+                                                               bit_coverage_view const & second,
+                                                               word_op_t && word_op) {
+            assert(first.get_domain() == second.get_domain());
+
+            bit_coverage<value_t> result{first.get_domain()};
+            std::ranges::transform(first.words(), second.words(), result._data.data(), word_op);
+            return result;
+        }
+
+        constexpr friend bit_coverage<value_t>
+        tag_invoke(libjst::tag_t<coverage_intersection>, bit_coverage_view const & first, bit_coverage_view const & second) {
+            return transform_words(first, second, [] (word_type const a, word_type const b) { return a & b; });
+        }
+
+        constexpr friend bit_coverage<value_t>
+        tag_invoke(libjst::tag_t<coverage_difference>, bit_coverage_view const & first, bit_coverage_view const & second) {
+            return transform_words(first, second, [] (word_type const a, word_type const b) { return a & ~b; });
+        }
+
+        constexpr friend bit_coverage<value_t>
+        tag_invoke(libjst::tag_t<coverage_union>, bit_coverage_view const & first, bit_coverage_view const & second) {
+            bit_coverage<value_t> result{first.get_domain()};
+            return transform_words_into(result, first, second, &detail::bit_kernels::or_words);
+        }
+
+        constexpr friend bool
+        tag_invoke(libjst::tag_t<coverage_intersects>,
+                   bit_coverage_view const & first,
+                   bit_coverage_view const & second) noexcept {
+            assert(first.get_domain() == second.get_domain());
+            return detail::intersects_bits(first._words, second._words, first.size());
+        }
+
+        constexpr friend size_t
+        tag_invoke(libjst::tag_t<coverage_intersection_count>,
+                   bit_coverage_view const & first,
+                   bit_coverage_view const & second) noexcept {
+            assert(first.get_domain() == second.get_domain());
+            return detail::intersection_count_bits(first._words, second._words, first.size());
+        }
+
+        constexpr friend bit_coverage<value_t> &
+        tag_invoke(libjst::tag_t<coverage_intersect_into>,
+                   bit_coverage<value_t> & target,
+                   bit_coverage_view const & first,
+                   bit_coverage_view const & second) {
+            return transform_words_into(target, first, second, &detail::bit_kernels::and_words);
+        }
+
+        constexpr friend bit_coverage<value_t> &
+        tag_invoke(libjst::tag_t<coverage_difference_into>,
+                   bit_coverage<value_t> & target,
+                   bit_coverage_view const & first,
+                   bit_coverage_view const & second) {
+            return transform_words_into(target, first, second, &detail::bit_kernels::and_not_words);
+        }
+
+        constexpr friend bit_coverage<value_t> &
+        tag_invoke(libjst::tag_t<coverage_union_into>,
+                   bit_coverage<value_t> & target,
+                   bit_coverage_view const & first,
+                   bit_coverage_view const & second) {
+            return transform_words_into(target, first, second, &detail::bit_kernels::or_words);
+        }
+
+        //!\brief Overwrites the words of target with the given kernel; reallocates only if the domains differ.
+        static constexpr bit_coverage<value_t> &
+        transform_words_into(bit_coverage<value_t> & target,
+                             bit_coverage_view const & first,
+                             bit_coverage_view const & second,
+                             detail::bit_kernels::binary_kernel_type detail::bit_kernels::* const kernel) {
+            assert(first.get_domain() == second.get_domain());
+
+            if (target.get_domain() != first.get_domain()) // the words of target are not referenced by the views.
+                target = bit_coverage<value_t>{first.get_domain()};
+
+            word_type * target_words = target._data.data();
+            size_t const count = first.words().size();
+            if (std::is_constant_evaluated())
+                (detail::scalar_bit_kernels.*kernel)(target_words, first._words, second._words, count);
+            else
+                (detail::active_bit_kernels().*kernel)(target_words, first._words, second._words, count);
+            return target;
+        }
+    };
+
+    //!\brief Random access iterator over the bits of the view.
+    template <std::unsigned_integral value_t>
+    class bit_coverage_view<value_t>::iterator_impl {
+    private:
+
+        friend bit_coverage_view;
+
+        word_type const * _words{};
+        std::ptrdiff_t _position{};
+
+        constexpr explicit iterator_impl(word_type const * words, std::ptrdiff_t const position) noexcept :
+            _words{words},
+            _position{position}
+        {}
+
+    public:
+
+        using value_type = bool;
+        using reference = bool;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using iterator_category = std::random_access_iterator_tag;
+
+        constexpr iterator_impl() = default;
+
+        constexpr reference operator*() const noexcept {
+            return (_words[_position / word_size] >> (_position % word_size)) & 1u;
+        }
+
+        constexpr reference operator[](difference_type const step) const noexcept {
+            return *(*this + step);
+        }
+
+        constexpr iterator_impl & operator++() noexcept {
+            ++_position;
+            return *this;
+        }
+
+        constexpr iterator_impl operator++(int) noexcept {
+            iterator_impl tmp{*this};
+            ++(*this);
+            return tmp;
+        }
+
+        constexpr iterator_impl & operator+=(difference_type const step) noexcept {
+            _position += step;
+            return *this;
+        }
+
+        constexpr iterator_impl & operator--() noexcept {
+            --_position;
+            return *this;
+        }
+
+        constexpr iterator_impl operator--(int) noexcept {
+            iterator_impl tmp{*this};
+            --(*this);
+            return tmp;
+        }
+
+        constexpr iterator_impl & operator-=(difference_type const step) noexcept {
+            _position -= step;
+            return *this;
+        }
+
+    private:
+
+        constexpr friend iterator_impl operator+(iterator_impl lhs, difference_type const step) noexcept {
+            return lhs += step;
+        }
+
+        constexpr friend iterator_impl operator+(difference_type const step, iterator_impl rhs) noexcept {
+            return rhs += step;
+        }
+
+        constexpr friend iterator_impl operator-(iterator_impl lhs, difference_type const step) noexcept {
+            return lhs -= step;
+        }
+
+        constexpr friend difference_type operator-(iterator_impl const & lhs, iterator_impl const & rhs) noexcept {
+            return lhs._position - rhs._position;
+        }
+
+        constexpr friend bool operator==(iterator_impl const & lhs, iterator_impl const & rhs) noexcept {
+            return lhs._position == rhs._position;
+        }
+
+        constexpr friend std::strong_ordering operator<=>(iterator_impl const & lhs, iterator_impl const & rhs) noexcept {
+            return lhs._position <=> rhs._position;
+        }
+    };
+}  // namespace libjst
@@ -0,0 +1,529 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides a coverage storing its sorted ids as blocks of variable length encoded gaps.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <libjst/coverage/concept.hpp>
+#include <libjst/coverage/range_domain.hpp>
+
+namespace libjst
+{
+    /*!\brief A coverage storing its sorted ids compressed in blocks of gaps encoded with a variable number of bytes.
+     *
+     * \tparam value_t The value type of the coverage domain.
+     *
+     * \details
+     *
+     * The ids are split into blocks of libjst::compressed_int_coverage::block_size consecutive ids. The first id of
+     * every block is stored in a skip table together with the offset of the block in a byte stream, which stores the
+     * gaps between the following ids of the block as little endian base-128 integers, i.e. seven bits per byte.
+     * Gaps below 128 take one byte and gaps below 16384 two bytes, such that a variant carried by one in a thousand
+     * samples occupies about two instead of the four bytes per carrier of a libjst::int_coverage, plus one skip entry
+     * per block.
+     *
+     * Intersections gallop over the skip tables: the iterator behind skips all blocks whose successor begins at or
+     * before the id of the other operand by an exponential search on the skip table and only decodes the gaps of the
+     * block containing the id. Intersecting a rare variant with a large path coverage therefore decodes a few blocks of
+     * the large coverage instead of all of its ids. The coverage is meant to be built once, e.g. when importing the
+     * variants, and computed by the set operations; inserting an id smaller than the last id reencodes the coverage.
+     */
+    template <std::unsigned_integral value_t>
+    class compressed_int_coverage {
+    private:
+
+        using coverage_domain_t = range_domain<value_t>;
+        using domain_value_type = typename coverage_domain_t::value_type;
+
+        //!\brief The first id of a block and the offset of its gaps in the byte stream.
+        struct block_type {
+            domain_value_type first{};
+            uint32_t offset{};
+
+            template <typename archive_t>
+            void serialize(archive_t & archive) {
+                archive(first, offset);
+            }
+
+            constexpr friend bool operator==(block_type const &, block_type const &) noexcept = default;
+        };
+
+        class iterator_impl;
+        class appender;
+
+        std::vector<block_type> _blocks{};
+        std::vector<uint8_t> _gaps{};
+        std::size_t _size{};
+        coverage_domain_t _domain{};
+
+    public:
+
+        //!\brief The number of ids per block of the skip table.
+        static constexpr std::size_t block_size{64};
+
+        using value_type = domain_value_type;
+        using iterator = iterator_impl;
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        constexpr compressed_int_coverage() = default; //!< Default.
+
+        //!\brief Constructs an empty coverage over the given domain.
+        explicit constexpr compressed_int_coverage(coverage_domain_t domain) noexcept : _domain{std::move(domain)}
+        {}
+
+        //!\brief Constructs the coverage from a range of ids, which may be unsorted and contain duplicates.
+        template <typename elem_range_t>
+            requires (!std::same_as<std::remove_cvref_t<elem_range_t>, compressed_int_coverage>) &&
+                     (!std::same_as<std::remove_cvref_t<elem_range_t>, std::initializer_list<value_type>>) &&
+                      std::integral<std::ranges::range_value_t<elem_range_t>>
+        explicit constexpr compressed_int_coverage(elem_range_t && from_list, coverage_domain_t domain) :
+            compressed_int_coverage{std::move(domain)}
+        {
+            assign_ids(from_list);
+        }
+
+        //!\brief Constructs the coverage from a list of ids, which may be unsorted and contain duplicates.
+        explicit constexpr compressed_int_coverage(std::initializer_list<value_type> from_list,
+                                                   coverage_domain_t domain) :
+            compressed_int_coverage{std::move(domain)}
+        {
+            assign_ids(from_list);
+        }
+        //!\}
+
+        /*!\name Element access and modification
+         * \{
+         */
+        //!\brief Returns whether the given id is covered.
+        constexpr bool contains(value_type const elem) const noexcept {
+            if (empty() || elem < _blocks.front().first)
+                return false;
+
+            auto block_it = std::ranges::upper_bound(_blocks, elem, std::ranges::less{}, &block_type::first);
+            iterator it{this, static_cast<std::size_t>(std::ranges::prev(block_it) - _blocks.begin())};
+            it.seek(elem);
+            return it != end() && *it == elem;
+        }
+
+        /*!\brief Inserts the given id.
+         *
+         * \details
+         *
+         * Throws std::domain_error if the id is no member of the coverage domain. Ids greater than the last id are
+         * appended in constant time, smaller ids reencode the coverage.
+         */
+        constexpr void insert(value_type const elem) {
+            if (!get_domain().is_member(elem))
+                throw std::domain_error{"The given element " + std::to_string(elem) + " is no member of the coverage domain!"};
+
+            if (empty() || back() < elem) {
+                appender{*this, empty() ? value_type{} : back()}.push_back(elem);
+            } else if (!contains(elem)) {
+                std::vector<value_type> ids{begin(), end()};
+                ids.insert(std::ranges::upper_bound(ids, elem), elem);
+                clear();
+                appender append{*this};
+                std::ranges::for_each(ids, [&] (value_type const id) { append.push_back(id); });
+            }
+        }
+
+        constexpr void clear() noexcept {
+            _blocks.clear();
+            _gaps.clear();
+            _size = 0;
+        }
+
+        constexpr value_type front() const noexcept {
+            assert(!empty());
+            return _blocks.front().first;
+        }
+
+        constexpr value_type back() const noexcept {
+            assert(!empty());
+            iterator it{this, _blocks.size() - 1};
+            value_type last{*it};
+            for (++it; it != end(); ++it)
+                last = *it;
+            return last;
+        }
+        //!\}
+
+        /*!\name Capacity
+         * \{
+         */
+        constexpr bool empty() const noexcept {
+            return _size == 0;
+        }
+
+        constexpr bool any() const noexcept {
+            return !empty();
+        }
+
+        //!\brief Returns the number of covered ids.
+        constexpr std::size_t size() const noexcept {
+            return _size;
+        }
+
+        constexpr std::size_t max_size() const noexcept {
+            return get_domain().size();
+        }
+
+        constexpr coverage_domain_t const & get_domain() const noexcept {
+            return _domain;
+        }
+
+        //!\brief Returns the number of bytes allocated for the skip table and the gaps.
+        std::size_t memory_usage() const noexcept {
+            return _blocks.capacity() * sizeof(block_type) + _gaps.capacity();
+        }
+        //!\}
+
+        /*!\name Iterators
+         * \{
+         */
+        constexpr iterator begin() const noexcept {
+            return iterator{this, 0};
+        }
+
+        constexpr iterator end() const noexcept {
+            return iterator{this};
+        }
+        //!\}
+
+        // ----------------------------------------------------------------------------
+        // Serialisation
+        // ----------------------------------------------------------------------------
+
+        template <typename archive_t>
+        void load(archive_t & iarchive)
+        {
+            iarchive(_blocks, _gaps, _size, _domain);
+        }
+
+        template <typename archive_t>
+        void save(archive_t & oarchive) const
+        {
+            oarchive(_blocks, _gaps, _size, _domain);
+        }
+
+    private:
+
+        template <typename ids_t>
+        constexpr void assign_ids(ids_t && from_list) {
+            std::vector<value_type> ids{};
+            for (auto && id : from_list) {
+                if (!get_domain().is_member(id))
+                    throw std::domain_error{"The given element " + std::to_string(id) + " is no member of the coverage domain!"};
+                ids.push_back(static_cast<value_type>(id));
+            }
+            std::ranges::sort(ids);
+            auto duplicates = std::ranges::unique(ids);
+
+            appender append{*this};
+            std::ranges::for_each(ids.begin(), duplicates.begin(), [&] (value_type const id) { append.push_back(id); });
+        }
+
+        //!\brief Decodes the gap at the given offset and moves the offset behind it.
+        constexpr value_type decode_gap(std::size_t & offset) const noexcept {
+            uint64_t gap{};
+            for (std::size_t shift = 0;; shift += 7) {
+                uint8_t const byte = _gaps[offset++];
+                gap |= static_cast<uint64_t>(byte & 0x7f) << shift;
+                if ((byte & 0x80) == 0)
+                    return static_cast<value_type>(gap);
+            }
+        }
+
+        // Invokes `fn(first_it, second_it)` for every id shared by both coverages, skipping ahead by galloping.
+        template <typename fn_t>
+        static constexpr void for_each_shared(compressed_int_coverage const & first,
+                                              compressed_int_coverage const & second,
+                                              fn_t && fn) {
+            if (first.empty() || second.empty() || first.back() < second.front() || second.back() < first.front())
+                return;
+
+            iterator first_it = first.begin();
+            iterator second_it = second.begin();
+            while (first_it != first.end() && second_it != second.end()) {
+                if (*first_it == *second_it) {
+                    if (!fn(*first_it))
+                        return;
+                    ++first_it;
+                    ++second_it;
+                } else if (*first_it < *second_it) {
+                    first_it.seek(*second_it);
+                } else {
+                    second_it.seek(*first_it);
+                }
+            }
+        }
+
+        // Appends the ids of first that are not in second to the target.
+        static constexpr void append_difference(appender & target,
+                                                compressed_int_coverage const & first,
+                                                compressed_int_coverage const & second) {
+            iterator second_it = second.begin();
+            for (value_type const id : first) {
+                second_it.seek(id);
+                if (second_it == second.end() || *second_it != id)
+                    target.push_back(id);
+            }
+        }
+
+        constexpr friend bool operator==(compressed_int_coverage const &, compressed_int_coverage const &) noexcept = default;
+
+        constexpr friend compressed_int_coverage
+        tag_invoke(libjst::tag_t<coverage_intersection>,
+                   compressed_int_coverage const & first,
+                   compressed_int_coverage const & second) {
+            compressed_int_coverage result{first.get_domain()};
+            appender append{result};
+            for_each_shared(first, second, [&] (value_type const id) { append.push_back(id); return true; });
+            return result;
+        }
+
+        constexpr friend compressed_int_coverage
+        tag_invoke(libjst::tag_t<coverage_difference>,
+                   compressed_int_coverage const & first,
+                   compressed_int_coverage const & second) {
+            compressed_int_coverage result{first.get_domain()};
+            appender append{result};
+            append_difference(append, first, second);
+            return result;
+        }
+
+        constexpr friend compressed_int_coverage
+        tag_invoke(libjst::tag_t<coverage_union>,
+                   compressed_int_coverage const & first,
+                   compressed_int_coverage const & second) {
+            compressed_int_coverage result{first.get_domain()};
+            appender append{result};
+            std::ranges::set_union(first, second, std::back_inserter(append));
+            return result;
+        }
+
+        constexpr friend bool
+        tag_invoke(libjst::tag_t<coverage_intersects>,
+                   compressed_int_coverage const & first,
+                   compressed_int_coverage const & second) noexcept {
+            bool intersects{false};
+            for_each_shared(first, second, [&] (value_type) { intersects = true; return false; });
+            return intersects;
+        }
+
+        constexpr friend std::size_t
+        tag_invoke(libjst::tag_t<coverage_intersection_count>,
+                   compressed_int_coverage const & first,
+                   compressed_int_coverage const & second) noexcept {
+            std::size_t count{};
+            for_each_shared(first, second, [&] (value_type) { ++count; return true; });
+            return count;
+        }
+
+        constexpr friend compressed_int_coverage &
+        tag_invoke(libjst::tag_t<coverage_intersect_into>,
+                   compressed_int_coverage & target,
+                   compressed_int_coverage const & first,
+                   compressed_int_coverage const & second) {
+            if (&target == &first || &target == &second) // the operands are read while the result is written.
+                return target = libjst::coverage_intersection(first, second);
+
+            target.clear();
+            target._domain = first.get_domain();
+            appender append{target};
+            for_each_shared(first, second, [&] (value_type const id) { append.push_back(id); return true; });
+            return target;
+        }
+
+        constexpr friend compressed_int_coverage &
+        tag_invoke(libjst::tag_t<coverage_difference_into>,
+                   compressed_int_coverage & target,
+                   compressed_int_coverage const & first,
+                   compressed_int_coverage const & second) {
+            if (&target == &first || &target == &second) // the operands are read while the result is written.
+                return target = libjst::coverage_difference(first, second);
+
+            target.clear();
+            target._domain = first.get_domain();
+            appender append{target};
+            append_difference(append, first, second);
+            return target;
+        }
+
+        constexpr friend compressed_int_coverage &
+        tag_invoke(libjst::tag_t<coverage_union_into>,
+                   compressed_int_coverage & target,
+                   compressed_int_coverage const & first,
+                   compressed_int_coverage const & second) {
+            if (&target == &first || &target == &second) // the operands are read while the result is written.
+                return target = libjst::coverage_union(first, second);
+
+            target.clear();
+            target._domain = first.get_domain();
+            appender append{target};
+            std::ranges::set_union(first, second, std::back_inserter(append));
+            return target;
+        }
+    };
+
+    //!\brief Appends strictly increasing ids to a coverage.
+    template <std::unsigned_integral value_t>
+    class compressed_int_coverage<value_t>::appender {
+    public:
+
+        using value_type = typename compressed_int_coverage::value_type;
+
+    private:
+        compressed_int_coverage * _target{};
+        value_type _last{};
+
+    public:
+
+        //!\brief Appends to the given coverage, whose last id is given if it is not empty.
+        explicit constexpr appender(compressed_int_coverage & target, value_type const last = {}) noexcept :
+            _target{std::addressof(target)},
+            _last{last}
+        {}
+
+        constexpr void push_back(value_type const id) {
+            assert(_target->empty() || _last < id);
+
+            if (_target->_size % block_size == 0) {
+                if (_target->_gaps.size() > std::numeric_limits<uint32_t>::max())
+                    throw std::length_error{"The gaps of the compressed coverage exceed the offset type!"};
+                _target->_blocks.push_back(block_type{id, static_cast<uint32_t>(_target->_gaps.size())});
+            } else {
+                uint64_t gap = id - _last - 1;
+                for (; gap >= 0x80; gap >>= 7)
+                    _target->_gaps.push_back(static_cast<uint8_t>(gap | 0x80));
+                _target->_gaps.push_back(static_cast<uint8_t>(gap));
+            }
+            _last = id;
+            ++_target->_size;
+        }
+    };
+
+    //!\brief A forward iterator decoding the ids of the coverage, which can skip ahead with seek.
+    template <std::unsigned_integral value_t>
+    class compressed_int_coverage<value_t>::iterator_impl {
+    private:
+
+        friend compressed_int_coverage;
+
+        compressed_int_coverage const * _host{};
+        std::size_t _index{};
+        std::size_t _block{};
+        std::size_t _offset{};
+        domain_value_type _value{};
+
+        //!\brief Positions the iterator at the first id of the given block.
+        constexpr iterator_impl(compressed_int_coverage const * host, std::size_t const block) noexcept :
+            _host{host}
+        {
+            if (block < _host->_blocks.size())
+                enter_block(block);
+            else
+                _index = _host->size();
+        }
+
+        //!\brief Positions the iterator at the end.
+        explicit constexpr iterator_impl(compressed_int_coverage const * host) noexcept :
+            _host{host},
+            _index{host->size()}
+        {}
+
+        constexpr void enter_block(std::size_t const block) noexcept {
+            _block = block;
+            _index = block * block_size;
+            _offset = _host->_blocks[block].offset;
+            _value = _host->_blocks[block].first;
+        }
+
+    public:
+
+        using value_type = typename compressed_int_coverage::value_type;
+        using reference = value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using iterator_category = std::forward_iterator_tag;
+
+        constexpr iterator_impl() = default; //!< Default.
+
+        constexpr reference operator*() const noexcept {
+            assert(_index < _host->size());
+            return _value;
+        }
+
+        constexpr iterator_impl & operator++() noexcept {
+            assert(_index < _host->size());
+            if (++_index == _host->size())
+                return *this;
+
+            if (_index % block_size == 0)
+                enter_block(_block + 1);
+            else
+                _value += _host->decode_gap(_offset) + 1;
+            return *this;
+        }
+
+        constexpr iterator_impl operator++(int) noexcept {
+            iterator_impl tmp{*this};
+            ++(*this);
+            return tmp;
+        }
+
+        /*!\brief Moves the iterator to the first id that is not less than the given id, or to the end.
+         *
+         * \details
+         *
+         * Skips the blocks beginning at or before the given id by an exponential search over the skip table followed
+         * by a binary search, and decodes the gaps of the last of these blocks. Never moves the iterator backwards.
+         */
+        constexpr void seek(value_type const id) noexcept {
+            if (_index == _host->size() || id <= _value)
+                return;
+
+            auto const & blocks = _host->_blocks;
+            if (std::size_t next = _block + 1; next < blocks.size() && blocks[next].first <= id) {
+                std::size_t step{1};
+                for (; next + step < blocks.size() && blocks[next + step].first <= id; step *= 2)
+                    next += step;
+                auto last = blocks.begin() + std::min(next + step, blocks.size());
+                auto block_it = std::ranges::upper_bound(blocks.begin() + next, last, id, std::ranges::less{},
+                                                         &block_type::first);
+                enter_block(std::ranges::prev(block_it) - blocks.begin());
+            }
+
+            while (_index < _host->size() && _value < id)
+                ++(*this);
+        }
+
+        constexpr friend bool operator==(iterator_impl const & lhs, iterator_impl const & rhs) noexcept {
+            return lhs._index == rhs._index;
+        }
+    };
+}  // namespace libjst
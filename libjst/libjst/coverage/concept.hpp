@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <concepts>
+
 #include <libjst/utility/tag_invoke.hpp>
 
 namespace libjst
@@ -65,6 +67,200 @@ namespace libjst
      */
     inline constexpr _coverage_difference::_cpo coverage_difference{};
 
+    namespace _coverage_union {
+
+        struct _cpo  {
+            template <typename coverage1_t, typename coverage2_t>
+                requires libjst::tag_invocable<_cpo, coverage1_t, coverage2_t>
+            constexpr auto operator()(coverage1_t && c1, coverage2_t && c2) const
+                noexcept(libjst::is_nothrow_tag_invocable_v<_cpo, coverage1_t, coverage2_t>)
+                -> libjst::tag_invoke_result_t<_cpo, coverage1_t, coverage2_t>
+            {
+                return libjst::tag_invoke(_cpo{}, (coverage1_t &&) c1, (coverage2_t &&) c2);
+            }
+        };
+    } // namespace _coverage_union
+
+    /**
+     * @brief A customization point object for computing the union of two coverages.
+     * @tparam coverage1_t The type of the first coverage.
+     * @tparam coverage2_t The type of the second coverage.
+     * @param c1 The first coverage.
+     * @param c2 The second coverage.
+     * @returns The set union of the two given coverages.
+     */
+    inline constexpr _coverage_union::_cpo coverage_union{};
+
+    namespace _coverage_intersects {
+        struct _cpo  {
+            template <typename coverage1_t, typename coverage2_t>
+                requires libjst::tag_invocable<_cpo, coverage1_t, coverage2_t>
+            constexpr auto operator()(coverage1_t && c1, coverage2_t && c2) const
+                noexcept(libjst::is_nothrow_tag_invocable_v<_cpo, coverage1_t, coverage2_t>)
+                -> libjst::tag_invoke_result_t<_cpo, coverage1_t, coverage2_t>
+            {
+                return libjst::tag_invoke(_cpo{}, (coverage1_t &&) c1, (coverage2_t &&) c2);
+            }
+        };
+    } // namespace _coverage_intersects
+
+    /**
+     * @brief A customization point object for testing whether two coverages intersect.
+     * @tparam coverage1_t The type of the first coverage.
+     * @tparam coverage2_t The type of the second coverage.
+     * @param c1 The first coverage.
+     * @param c2 The second coverage.
+     * @returns `true` if the two coverages share at least one element, `false` otherwise.
+     *
+     * Equivalent to `!coverage_intersection(c1, c2).empty()`, but stops at the first shared element and does not
+     * allocate the intersection.
+     */
+    inline constexpr _coverage_intersects::_cpo coverage_intersects{};
+
+    namespace _coverage_intersection_count {
+        struct _cpo  {
+            template <typename coverage1_t, typename coverage2_t>
+                requires libjst::tag_invocable<_cpo, coverage1_t, coverage2_t>
+            constexpr auto operator()(coverage1_t && c1, coverage2_t && c2) const
+                noexcept(libjst::is_nothrow_tag_invocable_v<_cpo, coverage1_t, coverage2_t>)
+                -> libjst::tag_invoke_result_t<_cpo, coverage1_t, coverage2_t>
+            {
+                return libjst::tag_invoke(_cpo{}, (coverage1_t &&) c1, (coverage2_t &&) c2);
+            }
+        };
+    } // namespace _coverage_intersection_count
+
+    /**
+     * @brief A customization point object for counting the elements shared by two coverages.
+     * @tparam coverage1_t The type of the first coverage.
+     * @tparam coverage2_t The type of the second coverage.
+     * @param c1 The first coverage.
+     * @param c2 The second coverage.
+     * @returns The number of elements of the set intersection of the two coverages, computed without allocating it.
+     */
+    inline constexpr _coverage_intersection_count::_cpo coverage_intersection_count{};
+
+    namespace _coverage_intersect_into {
+        struct _cpo  {
+            template <typename target_t, typename coverage1_t, typename coverage2_t>
+                requires libjst::tag_invocable<_cpo, target_t &, coverage1_t, coverage2_t>
+            constexpr auto operator()(target_t & target, coverage1_t && c1, coverage2_t && c2) const
+                noexcept(libjst::is_nothrow_tag_invocable_v<_cpo, target_t &, coverage1_t, coverage2_t>)
+                -> libjst::tag_invoke_result_t<_cpo, target_t &, coverage1_t, coverage2_t>
+            {
+                return libjst::tag_invoke(_cpo{}, target, (coverage1_t &&) c1, (coverage2_t &&) c2);
+            }
+        };
+    } // namespace _coverage_intersect_into
+
+    /**
+     * @brief A customization point object for computing the intersection of two coverages into an existing coverage.
+     * @tparam target_t The type of the coverage to store the result in.
+     * @tparam coverage1_t The type of the first coverage.
+     * @tparam coverage2_t The type of the second coverage.
+     * @param target The coverage which is overwritten with the intersection; may alias c1 or c2.
+     * @param c1 The first coverage.
+     * @param c2 The second coverage.
+     * @returns A reference to target.
+     *
+     * Reuses the memory of target such that repeated intersections, e.g. along a path, do not allocate.
+     */
+    inline constexpr _coverage_intersect_into::_cpo coverage_intersect_into{};
+
+    namespace _coverage_difference_into {
+        struct _cpo  {
+            template <typename target_t, typename coverage1_t, typename coverage2_t>
+                requires libjst::tag_invocable<_cpo, target_t &, coverage1_t, coverage2_t>
+            constexpr auto operator()(target_t & target, coverage1_t && c1, coverage2_t && c2) const
+                noexcept(libjst::is_nothrow_tag_invocable_v<_cpo, target_t &, coverage1_t, coverage2_t>)
+                -> libjst::tag_invoke_result_t<_cpo, target_t &, coverage1_t, coverage2_t>
+            {
+                return libjst::tag_invoke(_cpo{}, target, (coverage1_t &&) c1, (coverage2_t &&) c2);
+            }
+        };
+    } // namespace _coverage_difference_into
+
+    /**
+     * @brief A customization point object for computing the difference of two coverages into an existing coverage.
+     * @tparam target_t The type of the coverage to store the result in.
+     * @tparam coverage1_t The type of the first coverage.
+     * @tparam coverage2_t The type of the second coverage.
+     * @param target The coverage which is overwritten with the difference; may alias c1 or c2.
+     * @param c1 The first coverage.
+     * @param c2 The second coverage.
+     * @returns A reference to target.
+     *
+     * The counterpart of libjst::coverage_intersect_into for libjst::coverage_difference, i.e. c1 \ c2.
+     */
+    inline constexpr _coverage_difference_into::_cpo coverage_difference_into{};
+
+    namespace _coverage_union_into {
+        struct _cpo  {
+            template <typename target_t, typename coverage1_t, typename coverage2_t>
+                requires libjst::tag_invocable<_cpo, target_t &, coverage1_t, coverage2_t>
+            constexpr auto operator()(target_t & target, coverage1_t && c1, coverage2_t && c2) const
+                noexcept(libjst::is_nothrow_tag_invocable_v<_cpo, target_t &, coverage1_t, coverage2_t>)
+                -> libjst::tag_invoke_result_t<_cpo, target_t &, coverage1_t, coverage2_t>
+            {
+                return libjst::tag_invoke(_cpo{}, target, (coverage1_t &&) c1, (coverage2_t &&) c2);
+            }
+        };
+    } // namespace _coverage_union_into
+
+    /**
+     * @brief A customization point object for computing the union of two coverages into an existing coverage.
+     * @tparam target_t The type of the coverage to store the result in.
+     * @tparam coverage1_t The type of the first coverage.
+     * @tparam coverage2_t The type of the second coverage.
+     * @param target The coverage which is overwritten with the union; may alias c1 or c2.
+     * @param c1 The first coverage.
+     * @param c2 The second coverage.
+     * @returns A reference to target.
+     *
+     * The counterpart of libjst::coverage_intersect_into for libjst::coverage_union, e.g. to accumulate the coverages
+     * of many variants with `coverage_union_into(target, target, variant_coverage)`.
+     */
+    inline constexpr _coverage_union_into::_cpo coverage_union_into{};
+
+    namespace detail
+    {
+        //!\brief Assigns `first & second` to target, reusing the memory of target if the coverages support it.
+        template <typename target_t, typename coverage1_t, typename coverage2_t>
+        constexpr void assign_coverage_intersection(target_t & target,
+                                                    coverage1_t const & first,
+                                                    coverage2_t const & second) {
+            if constexpr (std::invocable<libjst::tag_t<libjst::coverage_intersect_into>,
+                                         target_t &, coverage1_t const &, coverage2_t const &>)
+                libjst::coverage_intersect_into(target, first, second);
+            else
+                target = libjst::coverage_intersection(first, second);
+        }
+
+        //!\brief Assigns `first \ second` to target, reusing the memory of target if the coverages support it.
+        template <typename target_t, typename coverage1_t, typename coverage2_t>
+        constexpr void assign_coverage_difference(target_t & target,
+                                                  coverage1_t const & first,
+                                                  coverage2_t const & second) {
+            if constexpr (std::invocable<libjst::tag_t<libjst::coverage_difference_into>,
+                                         target_t &, coverage1_t const &, coverage2_t const &>)
+                libjst::coverage_difference_into(target, first, second);
+            else
+                target = libjst::coverage_difference(first, second);
+        }
+
+        //!\brief Assigns `first | second` to target, reusing the memory of target if the coverages support it.
+        template <typename target_t, typename coverage1_t, typename coverage2_t>
+        constexpr void assign_coverage_union(target_t & target,
+                                             coverage1_t const & first,
+                                             coverage2_t const & second) {
+            if constexpr (std::invocable<libjst::tag_t<libjst::coverage_union_into>,
+                                         target_t &, coverage1_t const &, coverage2_t const &>)
+                libjst::coverage_union_into(target, first, second);
+            else
+                target = libjst::coverage_union(first, second);
+        }
+    } // namespace detail
+
     namespace _get_domain {
         inline constexpr struct _cpo  {
             template <typename coverage_t>
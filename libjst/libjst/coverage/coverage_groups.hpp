@@ -0,0 +1,255 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::coverage_groups.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <libjst/coverage/concept.hpp>
+#include <libjst/utility/bit_vector_kernels.hpp>
+#include <libjst/utility/memory_usage.hpp>
+
+namespace libjst
+{
+    /*!\brief A partition of the members of a coverage domain into groups, e.g. the populations of a cohort, whose
+     *        members of a coverage are counted in a single pass.
+     *
+     * \details
+     *
+     * The groups are given by the group of every member of the domain, in the order of the offsets into the domain.
+     * They are precomputed into a sequence of masks ordered by the words of a bit coverage: a run of words whose
+     * members all belong to the same group is counted at once with the popcount kernel of the executing CPU, see
+     * libjst::detail::active_bit_kernels, and every other word is counted once per group with members in it.
+     * If the groups are contiguous, e.g. after the samples have been reordered by population, a coverage is hence
+     * counted with about one popcount per word regardless of the number of groups. If the groups are interleaved
+     * such that more than eight groups share a word on average, the set bits of the words are enumerated instead.
+     *
+     * Coverages exposing the words of their bits, e.g. libjst::bit_coverage and libjst::bit_coverage_view, are counted
+     * with the masks. Other coverages enumerate their members, which are looked up in the group of every member.
+     */
+    class coverage_groups {
+    public:
+
+        using size_type = std::size_t;
+        using group_type = uint32_t; //!< The index of a group.
+
+    private:
+
+        using word_type = uint64_t;
+
+        static constexpr size_type word_size{64};
+        static constexpr word_type full_mask{~word_type{0}};
+        //!\brief The average number of masks per word above which the set bits are enumerated instead.
+        static constexpr size_type interleaved_masks_per_word{8};
+
+        //!\brief The members of a group within `[first_word, first_word + word_count)`.
+        struct mask_entry {
+            size_type first_word{}; //!< The first word of the entry.
+            size_type word_count{}; //!< The number of words; one unless all bits of the words belong to the group.
+            word_type mask{}; //!< The members of the group in the first word; all bits if the entry spans words.
+            group_type group{}; //!< The group of the masked members.
+        };
+
+        std::vector<group_type> _group_of{}; //!< The group of every member of the domain.
+        std::vector<mask_entry> _entries{}; //!< The masks ordered by their words.
+        size_type _group_count{};
+
+    public:
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        coverage_groups() = default; //!< Default.
+
+        /*!\brief Constructs the groups from the group of every member of the domain.
+         *
+         * \param[in] group_of_members The group of every member in the order of the offsets into the domain.
+         * \param[in] group_count The number of groups.
+         *
+         * ### Exception
+         *
+         * Throws std::invalid_argument if a group is not less than the number of groups.
+         *
+         * ### Complexity
+         *
+         * Linear in the number of members.
+         */
+        template <std::ranges::input_range groups_t>
+            requires std::integral<std::remove_cvref_t<std::ranges::range_reference_t<groups_t>>>
+        coverage_groups(groups_t && group_of_members, size_type const group_count) : _group_count{group_count}
+        {
+            for (auto && group : group_of_members) {
+                if (std::cmp_less(group, 0) || std::cmp_greater_equal(group, group_count))
+                    throw std::invalid_argument{"The group " + std::to_string(group) + " of the member " +
+                                                std::to_string(_group_of.size()) + " is not less than the number of "
+                                                "groups!"};
+                _group_of.push_back(static_cast<group_type>(group));
+            }
+
+            build_entries();
+        }
+        //!\}
+
+        /*!\brief Returns the groups of the rows of a permutation of the members.
+         *
+         * \param[in] permutation The permutation mapping every row to its original member, e.g. a
+         *                        libjst::sample_permutation applied by libjst::rcs_store::reorder_samples.
+         *
+         * \details
+         *
+         * The groups are given for the original members. The returned groups count the coverages of the reordered
+         * store, whose offsets are the rows of the permutation.
+         *
+         * ### Exception
+         *
+         * Throws std::invalid_argument if the permutation has a different number of members.
+         */
+        template <typename permutation_t>
+            requires requires (permutation_t const & permutation, size_type const row) {
+                { permutation.original_sample(row) } -> std::convertible_to<size_type>;
+                { permutation.size() } -> std::convertible_to<size_type>;
+            }
+        coverage_groups permuted(permutation_t const & permutation) const {
+            if (permutation.size() != size())
+                throw std::invalid_argument{"The permutation has " + std::to_string(permutation.size()) +
+                                            " instead of " + std::to_string(size()) + " members!"};
+
+            return coverage_groups{std::views::iota(size_type{0}, size()) | std::views::transform([&] (size_type row) {
+                return _group_of[permutation.original_sample(row)];
+            }), _group_count};
+        }
+
+        /*!\brief Writes the number of members of the coverage of every group to counts.
+         *
+         * \param[in] coverage The coverage over the domain of the groups.
+         * \param[out] counts The number of members of every group; must have group_count() elements.
+         *
+         * ### Complexity
+         *
+         * Linear in the number of words of the coverage and the number of groups sharing a word, or linear in the
+         * number of members of the coverage if it does not expose its words.
+         */
+        template <typename coverage_t>
+        void count_into(coverage_t const & coverage, std::span<size_type> counts) const {
+            assert(counts.size() == group_count());
+
+            std::ranges::fill(counts, 0);
+            if constexpr (requires { { coverage.words() } -> std::convertible_to<std::span<uint64_t const>>; }) {
+                std::span<uint64_t const> words = coverage.words();
+                assert(words.size() * word_size >= size());
+                if (is_interleaved()) { // fewer set bits than masks to test.
+                    for (size_type word_idx = 0; word_idx * word_size < size(); ++word_idx)
+                        for (word_type word = words[word_idx]; word != 0; word &= word - 1)
+                            ++counts[_group_of[word_idx * word_size + std::countr_zero(word)]];
+                    return;
+                }
+
+                for (mask_entry const & entry : _entries) {
+                    if (entry.mask == full_mask)
+                        counts[entry.group] += detail::active_bit_kernels().count_words(words.data() + entry.first_word,
+                                                                                       entry.word_count);
+                    else
+                        counts[entry.group] += std::popcount(words[entry.first_word] & entry.mask);
+                }
+            } else {
+                size_type const first = libjst::get_domain(coverage).min();
+                for (auto && id : coverage) {
+                    assert(static_cast<size_type>(id) - first < size());
+                    ++counts[_group_of[static_cast<size_type>(id) - first]];
+                }
+            }
+        }
+
+        //!\brief Returns the number of members of the coverage of every group, see count_into.
+        template <typename coverage_t>
+        std::vector<size_type> count(coverage_t const & coverage) const {
+            std::vector<size_type> counts(group_count());
+            count_into(coverage, counts);
+            return counts;
+        }
+
+        //!\brief Returns the group of the member at the given offset into the domain.
+        constexpr group_type group_of(size_type const offset) const noexcept {
+            assert(offset < size());
+            return _group_of[offset];
+        }
+
+        //!\brief Returns the number of groups.
+        constexpr size_type group_count() const noexcept {
+            return _group_count;
+        }
+
+        //!\brief Returns the number of members of the domain.
+        constexpr size_type size() const noexcept {
+            return _group_of.size();
+        }
+
+        //!\brief Returns the number of masks a coverage is counted with, at least one per word.
+        constexpr size_type mask_count() const noexcept {
+            return _entries.size();
+        }
+
+        //!\brief Returns the number of bytes allocated for the groups and the masks.
+        size_type memory_usage() const noexcept {
+            return libjst::memory_usage(_group_of) + libjst::memory_usage(_entries);
+        }
+
+    private:
+
+        //!\brief Whether the groups share the words such that enumerating the set bits is cheaper than the masks.
+        constexpr bool is_interleaved() const noexcept {
+            return _entries.size() > interleaved_masks_per_word * ((size() + word_size - 1) / word_size);
+        }
+
+        void build_entries() {
+            std::vector<word_type> masks(_group_count);
+            std::vector<group_type> touched{};
+            size_type const word_count = (size() + word_size - 1) / word_size;
+            for (size_type word = 0; word < word_count; ++word) {
+                size_type const word_begin = word * word_size;
+                size_type const word_end = std::min(word_begin + word_size, size());
+                for (size_type offset = word_begin; offset < word_end; ++offset) {
+                    group_type const group = _group_of[offset];
+                    if (masks[group] == 0)
+                        touched.push_back(group);
+                    masks[group] |= word_type{1} << (offset - word_begin);
+                }
+
+                std::ranges::sort(touched);
+                for (group_type const group : touched) {
+                    word_type const mask = std::exchange(masks[group], 0);
+                    if (mask != full_mask) {
+                        _entries.push_back(mask_entry{word, 1, mask, group});
+                    } else if (!_entries.empty() && _entries.back().mask == full_mask && _entries.back().group == group) {
+                        ++_entries.back().word_count; // the previous word belongs to the same group.
+                    } else {
+                        _entries.push_back(mask_entry{word, 1, full_mask, group});
+                    }
+                }
+                touched.clear();
+            }
+        }
+    };
+}  // namespace libjst
@@ -0,0 +1,106 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides member tests for blocks of coverage elements.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+namespace libjst
+{
+
+    //!\brief Returns whether the given id is a member of the coverage.
+    template <typename coverage_t>
+    constexpr bool covers(coverage_t const & coverage, std::size_t const id) noexcept {
+        if constexpr (requires { { coverage.contains(id) } -> std::convertible_to<bool>; })
+            return coverage.contains(id);
+        else
+            return coverage[id];
+    }
+
+    /*!\brief Invokes `fn(id - first)` for every member `id` of the coverage within `[first, first + count)`.
+     *
+     * \details
+     *
+     * Coverages exposing the words of their bits, e.g. libjst::bit_coverage and libjst::bit_coverage_view, are tested
+     * for 64 ids with a single word load and the members are enumerated by their set bits. Other coverages are probed
+     * with libjst::covers for every id of the block.
+     */
+    template <typename coverage_t, typename fn_t>
+    constexpr void for_each_covered(coverage_t const & coverage,
+                                    std::size_t const first,
+                                    std::size_t const count,
+                                    fn_t && fn) {
+        constexpr std::size_t word_size = 64;
+
+        if (count == 0)
+            return;
+
+        if constexpr (requires { { coverage.words() } -> std::convertible_to<std::span<uint64_t const>>; }) {
+            std::span<uint64_t const> words = coverage.words();
+            std::size_t const last = first + count;
+            for (std::size_t word_idx = first / word_size; word_idx <= (last - 1) / word_size; ++word_idx) {
+                uint64_t word = words[word_idx];
+                std::size_t const word_begin = word_idx * word_size;
+                if (word_begin < first)
+                    word &= ~uint64_t{0} << (first - word_begin);
+                if (word_begin + word_size > last)
+                    word &= ~uint64_t{0} >> (word_begin + word_size - last);
+
+                for (; word != 0; word &= word - 1)
+                    fn(word_begin + std::countr_zero(word) - first);
+            }
+        } else {
+            for (std::size_t idx = 0; idx < count; ++idx)
+                if (libjst::covers(coverage, first + idx))
+                    fn(idx);
+        }
+    }
+
+    /*!\brief Returns the members of the coverage within `[first, first + count)` as a word, whose bit `i` is set if
+     *        `first + i` is a member.
+     *
+     * \details
+     *
+     * The block must not exceed 64 ids. Coverages exposing the words of their bits are read with at most two word
+     * loads, e.g. to fill the blocks transposed by libjst::transpose_bit_blocks.
+     */
+    template <typename coverage_t>
+    constexpr uint64_t covered_bits(coverage_t const & coverage, std::size_t const first, std::size_t const count) {
+        constexpr std::size_t word_size = 64;
+        assert(count <= word_size);
+
+        if (count == 0)
+            return 0;
+
+        uint64_t const block_mask = ~uint64_t{0} >> (word_size - count);
+        if constexpr (requires { { coverage.words() } -> std::convertible_to<std::span<uint64_t const>>; }) {
+            std::span<uint64_t const> words = coverage.words();
+            std::size_t const word_idx = first / word_size;
+            std::size_t const shift = first % word_size;
+            uint64_t bits = words[word_idx] >> shift;
+            if (shift != 0 && shift + count > word_size)
+                bits |= words[word_idx + 1] << (word_size - shift);
+            return bits & block_mask;
+        } else {
+            uint64_t bits{};
+            for (std::size_t idx = 0; idx < count; ++idx)
+                bits |= static_cast<uint64_t>(libjst::covers(coverage, first + idx)) << idx;
+            return bits;
+        }
+    }
+
+}  // namespace libjst
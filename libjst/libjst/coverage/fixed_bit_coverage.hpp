@@ -0,0 +1,334 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::fixed_bit_coverage, a bit coverage for a number of haplotypes known at compile time.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+
+#include <cereal/types/array.hpp>
+
+#include <libjst/coverage/concept.hpp>
+#include <libjst/coverage/range_domain.hpp>
+
+namespace libjst
+{
+
+    /*!\brief A bit coverage whose bits are stored inline for at most the given number of haplotypes.
+     *
+     * \tparam value_t The value type of the coverage domain.
+     * \tparam max_haplotype_count The largest coverage domain the coverage can hold; must be greater than 0.
+     *
+     * \details
+     *
+     * A drop-in replacement of libjst::bit_coverage for cohorts whose size is known at compile time, e.g. a store
+     * `libjst::dna_compressed_multisequence<source_t, libjst::fixed_bit_coverage<uint32_t, 64>>` for panels of up
+     * to 64 haplotypes. The bits are kept in a `std::array` of `(max_haplotype_count + 63) / 64` words, such that
+     * copying a coverage never allocates and the coverages carried by the nodes of a libjst::coloured_tree or a
+     * libjst::prune_tree live inside the nodes. The set operations loop over the fixed number of words, which the
+     * compiler unrolls into a single instruction per word, e.g. one `and` for up to 64 haplotypes.
+     *
+     * The coverage domain is given at runtime like for libjst::bit_coverage and must not exceed max_haplotype_count;
+     * the bits beyond the domain are always unset. Cohorts larger than max_haplotype_count use libjst::bit_coverage.
+     */
+    template <std::unsigned_integral value_t, std::size_t max_haplotype_count>
+        requires (max_haplotype_count > 0)
+    class fixed_bit_coverage {
+    private:
+
+        class iterator_impl;
+
+        using coverage_domain_t = range_domain<value_t>;
+        using domain_value_type = typename coverage_domain_t::value_type;
+        using word_type = uint64_t;
+
+        static constexpr std::size_t word_size = sizeof(word_type) * 8;
+        static constexpr std::size_t word_count = (max_haplotype_count + word_size - 1) / word_size;
+
+        using data_type = std::array<word_type, word_count>;
+
+        data_type _words{};
+        [[no_unique_address]] coverage_domain_t _domain{0, static_cast<domain_value_type>(max_haplotype_count)};
+
+    public:
+
+        using value_type = domain_value_type;
+        using iterator = iterator_impl;
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        constexpr fixed_bit_coverage() = default; //!< Default.
+
+        /*!\brief Constructs an empty coverage over the given domain.
+         *
+         * \throws std::length_error if the domain exceeds max_haplotype_count.
+         */
+        explicit constexpr fixed_bit_coverage(coverage_domain_t domain) :
+            _domain{std::move(domain)}
+        {
+            if (_domain.max() > max_haplotype_count)
+                throw std::length_error{"The domain size " + std::to_string(_domain.max()) + " exceeds the " +
+                                        std::to_string(max_haplotype_count) + " haplotypes of the fixed coverage!"};
+        }
+
+        template <typename elem_range_t>
+            requires (!std::same_as<std::remove_cvref_t<elem_range_t>, fixed_bit_coverage>) &&
+                     (!std::same_as<std::remove_cvref_t<elem_range_t>, std::initializer_list<value_type>>) &&
+                      std::integral<std::ranges::range_value_t<elem_range_t>>
+        explicit constexpr fixed_bit_coverage(elem_range_t && from_list, coverage_domain_t domain) :
+            fixed_bit_coverage{std::move(domain)}
+        {
+            std::ranges::for_each(from_list, [&] (auto const & elem) { insert(elem); });
+        }
+
+        explicit constexpr fixed_bit_coverage(std::initializer_list<value_type> from_list, coverage_domain_t domain) :
+            fixed_bit_coverage{std::move(domain)}
+        {
+            std::ranges::for_each(from_list, [&] (value_type const elem) { insert(elem); });
+        }
+        //!\}
+
+        constexpr bool operator[](std::ptrdiff_t idx) const noexcept {
+            assert(idx >= 0 && static_cast<std::size_t>(idx) < word_count * word_size);
+            return (_words[idx / word_size] >> (idx % word_size)) & 1u;
+        }
+
+        constexpr bool contains(std::ptrdiff_t idx) const noexcept {
+            return idx >= 0 && static_cast<std::size_t>(idx) < max_size() && (*this)[idx];
+        }
+
+        constexpr iterator insert(value_type elem) {
+            if (!get_domain().is_member(elem) || elem >= max_size())
+                throw std::domain_error{"The given element " + std::to_string(elem) + " is no member of the coverage domain!"};
+            _words[elem / word_size] |= word_type{1} << (elem % word_size);
+            return iterator{this, elem};
+        }
+
+        constexpr void clear() noexcept {
+            _words.fill(0);
+        }
+
+        constexpr bool front() const noexcept {
+            assert(size() > 0);
+            return (*this)[0];
+        }
+
+        constexpr bool back() const noexcept {
+            assert(size() > 0);
+            return (*this)[size() - 1];
+        }
+
+        constexpr bool empty() const noexcept {
+            return !any();
+        }
+
+        constexpr bool any() const noexcept {
+            return std::ranges::any_of(_words, [] (word_type const word) { return word != 0; });
+        }
+
+        constexpr size_t size() const noexcept {
+            return max_size();
+        }
+
+        constexpr size_t max_size() const noexcept {
+            return get_domain().size();
+        }
+
+        //!\brief Returns the number of covered haplotypes.
+        constexpr size_t count() const noexcept {
+            size_t bit_count{};
+            for (word_type const word : _words)
+                bit_count += std::popcount(word);
+            return bit_count;
+        }
+
+        constexpr coverage_domain_t const & get_domain() const noexcept {
+            return _domain;
+        }
+
+        //!\brief Returns the words storing the bits of the coverage.
+        constexpr std::span<uint64_t const> words() const noexcept {
+            return {_words.data(), (max_size() + word_size - 1) / word_size};
+        }
+
+        constexpr iterator begin() const noexcept {
+            return iterator{this, 0};
+        }
+
+        constexpr iterator end() const noexcept {
+            return iterator{this, size()};
+        }
+
+        //!\brief Returns 0, since the bits are stored inline.
+        constexpr size_t memory_usage() const noexcept {
+            return 0;
+        }
+
+        // ----------------------------------------------------------------------------
+        // Serialisation
+        // ----------------------------------------------------------------------------
+
+        template <typename archive_t>
+        void load(archive_t & iarchive)
+        {
+            iarchive(_words, _domain);
+        }
+
+        template <typename archive_t>
+        void save(archive_t & oarchive) const
+        {
+            oarchive(_words, _domain);
+        }
+
+    private:
+
+        template <typename word_fn_t>
+        static constexpr fixed_bit_coverage & transform_words_into(fixed_bit_coverage & target,
+                                                                   fixed_bit_coverage const & first,
+                                                                   fixed_bit_coverage const & second,
+                                                                   word_fn_t && word_fn) noexcept {
+            target._domain = first.get_domain();
+            for (std::size_t idx = 0; idx < word_count; ++idx)
+                target._words[idx] = word_fn(first._words[idx], second._words[idx]);
+            return target;
+        }
+
+        constexpr friend bool operator==(fixed_bit_coverage const &, fixed_bit_coverage const &) noexcept = default;
+
+        constexpr friend fixed_bit_coverage
+        tag_invoke(libjst::tag_t<coverage_intersection>,
+                   fixed_bit_coverage first,
+                   fixed_bit_coverage const & second) noexcept {
+            return transform_words_into(first, first, second, [] (word_type lhs, word_type rhs) { return lhs & rhs; });
+        }
+
+        constexpr friend fixed_bit_coverage
+        tag_invoke(libjst::tag_t<coverage_difference>,
+                   fixed_bit_coverage first,
+                   fixed_bit_coverage const & second) noexcept {
+            return transform_words_into(first, first, second, [] (word_type lhs, word_type rhs) { return lhs & ~rhs; });
+        }
+
+        constexpr friend fixed_bit_coverage
+        tag_invoke(libjst::tag_t<coverage_union>,
+                   fixed_bit_coverage first,
+                   fixed_bit_coverage const & second) noexcept {
+            return transform_words_into(first, first, second, [] (word_type lhs, word_type rhs) { return lhs | rhs; });
+        }
+
+        constexpr friend bool
+        tag_invoke(libjst::tag_t<coverage_intersects>,
+                   fixed_bit_coverage const & first,
+                   fixed_bit_coverage const & second) noexcept {
+            word_type shared{};
+            for (std::size_t idx = 0; idx < word_count; ++idx)
+                shared |= first._words[idx] & second._words[idx];
+            return shared != 0;
+        }
+
+        constexpr friend size_t
+        tag_invoke(libjst::tag_t<coverage_intersection_count>,
+                   fixed_bit_coverage const & first,
+                   fixed_bit_coverage const & second) noexcept {
+            size_t bit_count{};
+            for (std::size_t idx = 0; idx < word_count; ++idx)
+                bit_count += std::popcount(first._words[idx] & second._words[idx]);
+            return bit_count;
+        }
+
+        constexpr friend fixed_bit_coverage &
+        tag_invoke(libjst::tag_t<coverage_intersect_into>,
+                   fixed_bit_coverage & target,
+                   fixed_bit_coverage const & first,
+                   fixed_bit_coverage const & second) noexcept {
+            return transform_words_into(target, first, second, [] (word_type lhs, word_type rhs) { return lhs & rhs; });
+        }
+
+        constexpr friend fixed_bit_coverage &
+        tag_invoke(libjst::tag_t<coverage_difference_into>,
+                   fixed_bit_coverage & target,
+                   fixed_bit_coverage const & first,
+                   fixed_bit_coverage const & second) noexcept {
+            return transform_words_into(target, first, second, [] (word_type lhs, word_type rhs) { return lhs & ~rhs; });
+        }
+
+        constexpr friend fixed_bit_coverage &
+        tag_invoke(libjst::tag_t<coverage_union_into>,
+                   fixed_bit_coverage & target,
+                   fixed_bit_coverage const & first,
+                   fixed_bit_coverage const & second) noexcept {
+            return transform_words_into(target, first, second, [] (word_type lhs, word_type rhs) { return lhs | rhs; });
+        }
+    };
+
+    //!\brief Forward iterator over the bits of the coverage domain, like the iterator of libjst::bit_coverage.
+    template <std::unsigned_integral value_t, std::size_t max_haplotype_count>
+        requires (max_haplotype_count > 0)
+    class fixed_bit_coverage<value_t, max_haplotype_count>::iterator_impl {
+    public:
+
+        using value_type = bool;
+        using reference = bool;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using iterator_category = std::forward_iterator_tag;
+
+    private:
+
+        friend fixed_bit_coverage;
+
+        fixed_bit_coverage const * _host{};
+        std::size_t _index{};
+
+        constexpr iterator_impl(fixed_bit_coverage const * host, std::size_t const index) noexcept :
+            _host{host},
+            _index{index}
+        {}
+
+    public:
+
+        constexpr iterator_impl() = default;
+
+        constexpr reference operator*() const noexcept {
+            return (*_host)[_index];
+        }
+
+        constexpr iterator_impl & operator++() noexcept {
+            ++_index;
+            return *this;
+        }
+
+        constexpr iterator_impl operator++(int) noexcept {
+            iterator_impl tmp{*this};
+            ++(*this);
+            return tmp;
+        }
+
+    private:
+
+        constexpr friend bool operator==(iterator_impl const & lhs, iterator_impl const & rhs) noexcept {
+            return lhs._index == rhs._index;
+        }
+    };
+}  // namespace libjst
@@ -0,0 +1,113 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::genotype_coverages to build the coverages of many variants from a packed genotype matrix.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/coverage/range_domain.hpp>
+#include <libjst/utility/bit_matrix_transpose.hpp>
+#include <libjst/utility/parallel_for_each_job.hpp>
+
+namespace libjst
+{
+    //!\brief The order of the rows of a packed genotype matrix, see libjst::genotype_coverages.
+    enum struct genotype_order {
+        variant_major, //!< One row of sample bits per variant, e.g. a BCF genotype block.
+        sample_major //!< One row of variant bits per sample, e.g. a PGEN genotype block.
+    };
+
+    /*!\brief Builds the coverages of many variants at once from a packed genotype matrix.
+     *
+     * \tparam value_t The value type of the coverage domains.
+     *
+     * \param[in] words The packed rows of the matrix, each beginning at a new word; the bit `i % 64` of the word
+     *                  `i / 64` of a row is its column `i`.
+     * \param[in] variant_count The number of variants.
+     * \param[in] sample_count The number of samples, i.e. the size of the coverage domains.
+     * \param[in] order Whether the rows of the matrix are the variants or the samples.
+     * \param[in] thread_count The number of threads building the coverages.
+     *
+     * \returns The coverage over the samples of every variant.
+     *
+     * \details
+     *
+     * The variants are split into blocks of 64 variants, which are built in parallel. The words of a variant-major
+     * matrix are copied into the coverages as a whole, see libjst::bit_coverage::from_words. A sample-major matrix is
+     * tiled into blocks of 64 variants and 64 samples, whose words are transposed with libjst::transpose_bit_blocks
+     * and copied into the coverages, instead of setting every genotype on its own.
+     *
+     * ### Exception
+     *
+     * Throws std::invalid_argument if the matrix holds fewer words than its rows need.
+     */
+    template <std::unsigned_integral value_t = uint32_t>
+    std::vector<bit_coverage<value_t>> genotype_coverages(std::span<uint64_t const> words,
+                                                          std::size_t const variant_count,
+                                                          std::size_t const sample_count,
+                                                          genotype_order const order,
+                                                          std::size_t const thread_count =
+                                                              std::thread::hardware_concurrency())
+    {
+        using coverage_t = bit_coverage<value_t>;
+
+        std::size_t const row_count = (order == genotype_order::variant_major) ? variant_count : sample_count;
+        std::size_t const column_count = (order == genotype_order::variant_major) ? sample_count : variant_count;
+        std::size_t const row_words = (column_count + bit_block_size - 1) / bit_block_size;
+        if (words.size() < row_count * row_words)
+            throw std::invalid_argument{"The genotype matrix must hold a word for every 64 columns of every row!"};
+
+        range_domain<value_t> const domain{0, static_cast<value_t>(sample_count)};
+        std::vector<coverage_t> coverages(variant_count);
+        std::size_t const block_count = (variant_count + bit_block_size - 1) / bit_block_size;
+        std::size_t const sample_words = (sample_count + bit_block_size - 1) / bit_block_size;
+
+        detail::parallel_for_each_job(block_count, thread_count, [&] (std::size_t const block) {
+            std::size_t const first_variant = block * bit_block_size;
+            std::size_t const block_size = std::min(bit_block_size, variant_count - first_variant);
+            if (order == genotype_order::variant_major) {
+                for (std::size_t variant = first_variant; variant < first_variant + block_size; ++variant)
+                    coverages[variant] = coverage_t::from_words(words.subspan(variant * row_words, row_words), domain);
+                return;
+            }
+
+            // Transposes the tile of the 64 samples of every sample word and the 64 variants of the block.
+            std::vector<uint64_t> variant_words(block_size * sample_words);
+            std::vector<uint64_t> tile(bit_block_size);
+            for (std::size_t sample_word = 0; sample_word < sample_words; ++sample_word) {
+                std::size_t const first_sample = sample_word * bit_block_size;
+                std::size_t const tile_samples = std::min(bit_block_size, sample_count - first_sample);
+                std::ranges::fill(tile, 0);
+                for (std::size_t sample = 0; sample < tile_samples; ++sample)
+                    tile[sample] = words[(first_sample + sample) * row_words + block];
+
+                libjst::transpose_bit_blocks(tile);
+                for (std::size_t variant = 0; variant < block_size; ++variant)
+                    variant_words[variant * sample_words + sample_word] = tile[variant];
+            }
+
+            std::span<uint64_t const> transposed{variant_words};
+            for (std::size_t variant = 0; variant < block_size; ++variant)
+                coverages[first_variant + variant] =
+                    coverage_t::from_words(transposed.subspan(variant * sample_words, sample_words), domain);
+        });
+        return coverages;
+    }
+}  // namespace libjst
@@ -0,0 +1,884 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides a coverage choosing between a sparse, a run-length and a dense representation.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <libjst/coverage/concept.hpp>
+#include <libjst/coverage/range_domain.hpp>
+#include <libjst/utility/bit_vector.hpp>
+#include <libjst/utility/multi_invocable.hpp>
+
+namespace libjst
+{
+    //!\brief The representations of a libjst::hybrid_coverage.
+    enum class hybrid_coverage_kind : uint8_t {
+        sparse, //!< The sorted ids.
+        runs, //!< The sorted half-open intervals of consecutive ids.
+        dense //!< One bit per member of the domain.
+    };
+
+    /*!\brief A coverage which stores its ids in the most compact of three representations.
+     *
+     * \tparam value_t The value type of the coverage domain.
+     *
+     * \details
+     *
+     * Rare variants are carried by few samples and are stored as sorted ids, variants carried by contiguous blocks of
+     * samples, e.g. the full coverage of the sentinel breakends, are stored as runs and common variants are stored as
+     * a bitmap over the domain. The representation is chosen by the estimated memory of each representation whenever
+     * the coverage is constructed from a list of ids, computed by an intersection, difference or union, or reoptimised via
+     * libjst::hybrid_coverage::optimise. Inserting ids only promotes to the dense representation once the current
+     * representation becomes larger than the bitmap.
+     *
+     * Intersections, differences and unions are computed without converting the operands: sparse and run-length operands are
+     * merged, sparse ids are tested directly against the bits of a dense operand and dense operands are combined
+     * word-wise. The coverage iterates over its ids in increasing order like libjst::int_coverage.
+     */
+    template <std::unsigned_integral value_t>
+    class hybrid_coverage {
+    private:
+
+        using coverage_domain_t = range_domain<value_t>;
+        using domain_value_type = typename coverage_domain_t::value_type;
+        using word_type = uint64_t;
+
+        //!\brief A half-open interval `[first, last)` of consecutive ids.
+        struct run_type {
+            domain_value_type first{};
+            domain_value_type last{};
+
+            template <typename archive_t>
+            void serialize(archive_t & archive) {
+                archive(first, last);
+            }
+
+            constexpr friend bool operator==(run_type const &, run_type const &) noexcept = default;
+        };
+
+        using sparse_type = std::vector<domain_value_type>;
+        using runs_type = std::vector<run_type>;
+        using dense_type = bit_vector<>;
+        using data_type = std::variant<sparse_type, runs_type, dense_type>;
+
+        class iterator_impl;
+        class sparse_builder;
+        class runs_builder;
+
+        static constexpr std::size_t word_size = sizeof(word_type) * 8;
+
+        data_type _data{};
+        coverage_domain_t _domain{};
+
+    public:
+
+        using value_type = domain_value_type;
+        using iterator = iterator_impl;
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        constexpr hybrid_coverage() = default; //!< Default.
+
+        //!\brief Constructs an empty coverage over the given domain.
+        explicit constexpr hybrid_coverage(coverage_domain_t domain) noexcept :
+            _data{},
+            _domain{std::move(domain)}
+        {}
+
+        //!\brief Constructs the coverage from a range of ids, which may be unsorted and contain duplicates.
+        template <typename elem_range_t>
+            requires (!std::same_as<std::remove_cvref_t<elem_range_t>, hybrid_coverage>) &&
+                     (!std::same_as<std::remove_cvref_t<elem_range_t>, std::initializer_list<value_type>>) &&
+                      std::integral<std::ranges::range_value_t<elem_range_t>>
+        explicit constexpr hybrid_coverage(elem_range_t && from_list, coverage_domain_t domain) :
+            hybrid_coverage{std::move(domain)}
+        {
+            assign_ids(from_list);
+        }
+
+        //!\brief Constructs the coverage from a list of ids, which may be unsorted and contain duplicates.
+        explicit constexpr hybrid_coverage(std::initializer_list<value_type> from_list, coverage_domain_t domain) :
+            hybrid_coverage{std::move(domain)}
+        {
+            assign_ids(from_list);
+        }
+        //!\}
+
+        /*!\name Element access and modification
+         * \{
+         */
+        //!\brief Returns whether the given id is covered.
+        constexpr bool contains(value_type const elem) const noexcept {
+            if (!is_member(elem))
+                return false;
+
+            return std::visit([&] (auto const & data) { return contains_impl(data, elem); }, _data);
+        }
+
+        /*!\brief Inserts the given id.
+         *
+         * \details
+         *
+         * Throws std::domain_error if the id is no member of the coverage domain. Switches to the dense
+         * representation if the current representation outgrows it.
+         */
+        constexpr void insert(value_type const elem) {
+            if (!is_member(elem))
+                throw std::domain_error{"The given element " + std::to_string(elem) + " is no member of the coverage domain!"};
+
+            std::visit([&] (auto & data) { insert_impl(data, elem); }, _data);
+            if (kind() != hybrid_coverage_kind::dense && current_bytes() > dense_bytes())
+                convert_to(hybrid_coverage_kind::dense);
+        }
+
+        constexpr void clear() {
+            _data = sparse_type{};
+        }
+
+        constexpr value_type front() const noexcept {
+            assert(!empty());
+            return *begin();
+        }
+
+        constexpr value_type back() const noexcept {
+            assert(!empty());
+            return std::visit(multi_invocable{
+                [] (sparse_type const & ids) { return ids.back(); },
+                [] (runs_type const & runs) { return static_cast<value_type>(runs.back().last - 1); },
+                [&] (dense_type const & bits) {
+                    std::size_t position = bits.size();
+                    while (!bits[--position]) {}
+                    return to_id(position);
+                }}, _data);
+        }
+        //!\}
+
+        /*!\name Capacity and representation
+         * \{
+         */
+        constexpr bool empty() const noexcept {
+            return !any();
+        }
+
+        constexpr bool any() const noexcept {
+            return std::visit(multi_invocable{
+                [] (sparse_type const & ids) { return !ids.empty(); },
+                [] (runs_type const & runs) { return !runs.empty(); },
+                [] (dense_type const & bits) { return bits.any(); }}, _data);
+        }
+
+        //!\brief Returns the number of covered ids.
+        constexpr size_t size() const noexcept {
+            return std::visit(multi_invocable{
+                [] (sparse_type const & ids) { return ids.size(); },
+                [] (runs_type const & runs) {
+                    size_t count{};
+                    for (run_type const & run : runs)
+                        count += run.last - run.first;
+                    return count;
+                },
+                [] (dense_type const & bits) { return bits.count(); }}, _data);
+        }
+
+        constexpr size_t max_size() const noexcept {
+            return get_domain().size();
+        }
+
+        constexpr coverage_domain_t const & get_domain() const noexcept {
+            return _domain;
+        }
+
+        //!\brief Returns the current representation.
+        constexpr hybrid_coverage_kind kind() const noexcept {
+            return static_cast<hybrid_coverage_kind>(_data.index());
+        }
+
+        //!\brief Returns the number of bytes allocated for the ids in the current representation.
+        constexpr size_t memory_usage() const noexcept {
+            return current_bytes();
+        }
+
+        /*!\brief Switches to the representation requiring the least memory.
+         *
+         * \details
+         *
+         * Ties are broken in favour of the sparse and then the run-length representation, which are cheaper to
+         * intersect. Linear in the size of the current representation.
+         */
+        constexpr hybrid_coverage & optimise() {
+            size_t id_count{};
+            size_t run_count{};
+            for_each_run([&] (value_type const first, value_type const last) {
+                id_count += last - first;
+                ++run_count;
+            });
+
+            size_t const sparse = id_count * sizeof(value_type);
+            size_t const runs = run_count * sizeof(run_type);
+            size_t const dense = dense_bytes();
+
+            if (sparse <= runs && sparse <= dense)
+                convert_to(hybrid_coverage_kind::sparse);
+            else if (runs <= dense)
+                convert_to(hybrid_coverage_kind::runs);
+            else
+                convert_to(hybrid_coverage_kind::dense);
+
+            return *this;
+        }
+        //!\}
+
+        /*!\name Iterators
+         * \{
+         */
+        constexpr iterator begin() const noexcept {
+            return iterator{this, true};
+        }
+
+        constexpr iterator end() const noexcept {
+            return iterator{this, false};
+        }
+        //!\}
+
+        // ----------------------------------------------------------------------------
+        // Serialisation
+        // ----------------------------------------------------------------------------
+
+        template <typename archive_t>
+        void load(archive_t & iarchive)
+        {
+            hybrid_coverage_kind stored_kind{};
+            iarchive(stored_kind, _domain);
+            switch (stored_kind) {
+                case hybrid_coverage_kind::sparse: iarchive(_data.template emplace<sparse_type>()); break;
+                case hybrid_coverage_kind::runs: iarchive(_data.template emplace<runs_type>()); break;
+                case hybrid_coverage_kind::dense: iarchive(_data.template emplace<dense_type>()); break;
+                default: throw std::runtime_error{"Unknown representation of the hybrid coverage."};
+            }
+        }
+
+        template <typename archive_t>
+        void save(archive_t & oarchive) const
+        {
+            oarchive(kind(), _domain);
+            std::visit([&] (auto const & data) { oarchive(data); }, _data);
+        }
+
+    private:
+
+        // ----------------------------------------------------------------------------
+        // Ids and bits
+        // ----------------------------------------------------------------------------
+
+        constexpr bool is_member(value_type const elem) const noexcept {
+            return elem >= get_domain().min() && elem < get_domain().max();
+        }
+
+        constexpr size_t to_position(value_type const elem) const noexcept {
+            return elem - get_domain().min();
+        }
+
+        constexpr value_type to_id(size_t const position) const noexcept {
+            return static_cast<value_type>(get_domain().min() + position);
+        }
+
+        constexpr size_t dense_bytes() const noexcept {
+            return (max_size() + word_size - 1) / word_size * sizeof(word_type);
+        }
+
+        constexpr size_t current_bytes() const noexcept {
+            return std::visit(multi_invocable{
+                [] (sparse_type const & ids) { return ids.size() * sizeof(value_type); },
+                [] (runs_type const & runs) { return runs.size() * sizeof(run_type); },
+                [&] (dense_type const &) { return dense_bytes(); }}, _data);
+        }
+
+        //!\brief Invokes `fn(word_index, mask)` for the words spanned by the bit positions `[first, last)`.
+        template <typename fn_t>
+        static constexpr void for_each_word_mask(size_t first, size_t const last, fn_t && fn) {
+            while (first < last) {
+                size_t const offset = first % word_size;
+                size_t const width = std::min(word_size - offset, last - first);
+                word_type const mask = (width == word_size) ? ~word_type{0} : ((word_type{1} << width) - 1) << offset;
+                if (fn(first / word_size, mask))
+                    return;
+                first += width;
+            }
+        }
+
+        //!\brief Returns the first position in `[position, bit_count)` whose bit equals `bit`, or `bit_count`.
+        static constexpr size_t find_bit(dense_type const & bits, size_t position, bool const bit) noexcept {
+            size_t const bit_count = bits.size();
+            if (position >= bit_count)
+                return bit_count;
+
+            word_type const flip = bit ? word_type{0} : ~word_type{0};
+            size_t word_index = position / word_size;
+            word_type word = (bits.data()[word_index] ^ flip) & (~word_type{0} << (position % word_size));
+            while (word == 0) {
+                if (++word_index * word_size >= bit_count)
+                    return bit_count;
+                word = bits.data()[word_index] ^ flip;
+            }
+            return std::min(word_index * word_size + std::countr_zero(word), bit_count);
+        }
+
+        //!\brief Invokes `fn(first, last)` for the maximal runs of consecutive ids in increasing order.
+        template <typename fn_t>
+        constexpr void for_each_run(fn_t && fn) const {
+            std::visit(multi_invocable{
+                [&] (sparse_type const & ids) {
+                    for (size_t i = 0; i < ids.size();) {
+                        size_t j = i + 1;
+                        while (j < ids.size() && ids[j] == ids[j - 1] + 1)
+                            ++j;
+                        fn(ids[i], static_cast<value_type>(ids[j - 1] + 1));
+                        i = j;
+                    }
+                },
+                [&] (runs_type const & runs) {
+                    for (run_type const & run : runs)
+                        fn(run.first, run.last);
+                },
+                [&] (dense_type const & bits) {
+                    for (size_t first = find_bit(bits, 0, true); first < bits.size();) {
+                        size_t const last = find_bit(bits, first, false);
+                        fn(to_id(first), to_id(last));
+                        first = find_bit(bits, last, true);
+                    }
+                }}, _data);
+        }
+
+        constexpr void convert_to(hybrid_coverage_kind const target_kind) {
+            if (target_kind == kind())
+                return;
+
+            data_type converted{};
+            switch (target_kind) {
+                case hybrid_coverage_kind::sparse: {
+                    sparse_builder builder{};
+                    for_each_run([&] (auto const first, auto const last) { builder.push_run(first, last); });
+                    converted = std::move(builder).extract();
+                    break;
+                }
+                case hybrid_coverage_kind::runs: {
+                    runs_builder builder{};
+                    for_each_run([&] (auto const first, auto const last) { builder.push_run(first, last); });
+                    converted = std::move(builder).extract();
+                    break;
+                }
+                case hybrid_coverage_kind::dense: {
+                    dense_type bits(max_size(), false);
+                    for_each_run([&] (value_type const first, value_type const last) { set_bits(bits, first, last); });
+                    converted = std::move(bits);
+                    break;
+                }
+            }
+            _data = std::move(converted);
+        }
+
+        template <typename ids_t>
+        constexpr void assign_ids(ids_t && from_list) {
+            sparse_type ids{};
+            for (auto && elem : from_list) {
+                if (!std::in_range<value_type>(elem) || !is_member(static_cast<value_type>(elem)))
+                    throw std::domain_error{"The given element " + std::to_string(elem) + " is no member of the coverage domain!"};
+                ids.push_back(static_cast<value_type>(elem));
+            }
+
+            if (!std::ranges::is_sorted(ids))
+                std::ranges::sort(ids);
+            ids.erase(std::ranges::unique(ids).begin(), ids.end());
+            _data = std::move(ids);
+            optimise();
+        }
+
+        // ----------------------------------------------------------------------------
+        // Per representation implementation
+        // ----------------------------------------------------------------------------
+
+        constexpr bool contains_impl(sparse_type const & ids, value_type const elem) const noexcept {
+            return std::ranges::binary_search(ids, elem);
+        }
+
+        constexpr bool contains_impl(runs_type const & runs, value_type const elem) const noexcept {
+            auto it = std::ranges::upper_bound(runs, elem, std::ranges::less{}, &run_type::first);
+            return it != runs.begin() && elem < std::ranges::prev(it)->last;
+        }
+
+        constexpr bool contains_impl(dense_type const & bits, value_type const elem) const noexcept {
+            return bits[to_position(elem)];
+        }
+
+        constexpr void insert_impl(sparse_type & ids, value_type const elem) {
+            if (auto it = std::ranges::lower_bound(ids, elem); it == ids.end() || *it != elem)
+                ids.insert(it, elem);
+        }
+
+        constexpr void insert_impl(runs_type & runs, value_type const elem) {
+            if (contains_impl(runs, elem))
+                return;
+
+            auto next = std::ranges::upper_bound(runs, elem, std::ranges::less{}, &run_type::first);
+            bool const extends_previous = next != runs.begin() && std::ranges::prev(next)->last == elem;
+            bool const extends_next = next != runs.end() && next->first == elem + 1;
+            if (extends_previous && extends_next) {
+                std::ranges::prev(next)->last = next->last;
+                runs.erase(next);
+            } else if (extends_previous) {
+                std::ranges::prev(next)->last = elem + 1;
+            } else if (extends_next) {
+                next->first = elem;
+            } else {
+                runs.insert(next, run_type{elem, static_cast<value_type>(elem + 1)});
+            }
+        }
+
+        constexpr void insert_impl(dense_type & bits, value_type const elem) {
+            bits[to_position(elem)] = true;
+        }
+
+        // ----------------------------------------------------------------------------
+        // Set operations
+        // ----------------------------------------------------------------------------
+
+        template <typename data_t>
+        static constexpr bool is_dense_v = std::same_as<data_t, dense_type>;
+
+        template <typename data_t>
+        static constexpr bool is_sparse_v = std::same_as<data_t, sparse_type>;
+
+        //!\brief Returns the k-th id of a sparse operand as run.
+        static constexpr run_type run_at(sparse_type const & ids, size_t const k) noexcept {
+            return run_type{ids[k], static_cast<value_type>(ids[k] + 1)};
+        }
+
+        static constexpr run_type run_at(runs_type const & runs, size_t const k) noexcept {
+            return runs[k];
+        }
+
+        //!\brief Invokes `fn(first, last)` for the overlaps of two sparse or run-length operands until it returns true.
+        template <typename lhs_t, typename rhs_t, typename fn_t>
+        static constexpr void for_each_overlap(lhs_t const & lhs, rhs_t const & rhs, fn_t && fn) {
+            size_t i = 0;
+            size_t j = 0;
+            while (i < lhs.size() && j < rhs.size()) {
+                run_type const a = run_at(lhs, i);
+                run_type const b = run_at(rhs, j);
+                value_type const first = std::max(a.first, b.first);
+                value_type const last = std::min(a.last, b.last);
+                if (first < last && fn(first, last))
+                    return;
+
+                if (a.last < b.last)
+                    ++i;
+                else
+                    ++j;
+            }
+        }
+
+        //!\brief Invokes `fn(first, last)` for the ids of lhs, which are not in rhs.
+        template <typename lhs_t, typename rhs_t, typename fn_t>
+        static constexpr void for_each_difference(lhs_t const & lhs, rhs_t const & rhs, fn_t && fn) {
+            size_t j = 0;
+            for (size_t i = 0; i < lhs.size(); ++i) {
+                run_type const a = run_at(lhs, i);
+                value_type current = a.first;
+                while (j < rhs.size() && run_at(rhs, j).last <= current)
+                    ++j;
+
+                for (size_t k = j; k < rhs.size() && run_at(rhs, k).first < a.last; ++k) {
+                    run_type const b = run_at(rhs, k);
+                    if (current < b.first)
+                        fn(current, b.first);
+                    current = std::max(current, b.last);
+                }
+                if (current < a.last)
+                    fn(current, a.last);
+            }
+        }
+
+        //!\brief Invokes `fn(first, last)` for the maximal runs of ids of lhs or rhs.
+        template <typename lhs_t, typename rhs_t, typename fn_t>
+        static constexpr void for_each_union(lhs_t const & lhs, rhs_t const & rhs, fn_t && fn) {
+            size_t i = 0;
+            size_t j = 0;
+            bool has_current{false};
+            run_type current{};
+            while (i < lhs.size() || j < rhs.size()) {
+                bool const take_left = j == rhs.size() || (i < lhs.size() && run_at(lhs, i).first < run_at(rhs, j).first);
+                run_type const next = take_left ? run_at(lhs, i++) : run_at(rhs, j++);
+                if (has_current && next.first <= current.last) { // overlapping or adjacent runs are merged.
+                    current.last = std::max(current.last, next.last);
+                } else {
+                    if (has_current)
+                        fn(current.first, current.last);
+                    current = next;
+                    has_current = true;
+                }
+            }
+            if (has_current)
+                fn(current.first, current.last);
+        }
+
+        //!\brief Invokes `fn(first, last)` for every run or id of a sparse or run-length operand.
+        template <typename data_t, typename fn_t>
+        static constexpr void for_each_run_of(data_t const & data, fn_t && fn) {
+            for (size_t k = 0; k < data.size(); ++k) {
+                run_type const run = run_at(data, k);
+                fn(run.first, run.last);
+            }
+        }
+
+        //!\brief Returns the bits of the run-length operand over the given domain.
+        constexpr dense_type to_dense(runs_type const & runs) const {
+            dense_type bits(max_size(), false);
+            for (run_type const & run : runs)
+                set_bits(bits, run.first, run.last);
+            return bits;
+        }
+
+        //!\brief Sets the bits within `[first, last)`.
+        constexpr void set_bits(dense_type & bits, value_type const first, value_type const last) const noexcept {
+            for_each_word_mask(to_position(first), to_position(last), [&] (size_t const i, word_type const mask) {
+                bits.data()[i] |= mask;
+                return false;
+            });
+        }
+
+        //!\brief Clears the bits within `[first, last)`.
+        constexpr void clear_bits(dense_type & bits, value_type const first, value_type const last) const noexcept {
+            for_each_word_mask(to_position(first), to_position(last), [&] (size_t const i, word_type const mask) {
+                bits.data()[i] &= ~mask;
+                return false;
+            });
+        }
+
+        constexpr hybrid_coverage with_data(data_type data) const {
+            hybrid_coverage result{get_domain()};
+            result._data = std::move(data);
+            result.optimise();
+            return result;
+        }
+
+        template <typename builder_t, typename lhs_t, typename rhs_t>
+        static constexpr data_type build_overlap(lhs_t const & lhs, rhs_t const & rhs) {
+            builder_t builder{};
+            for_each_overlap(lhs, rhs, [&] (value_type const first, value_type const last) {
+                builder.push_run(first, last);
+                return false;
+            });
+            return std::move(builder).extract();
+        }
+
+        constexpr hybrid_coverage intersect(hybrid_coverage const & other) const {
+            return std::visit([&] <typename lhs_t, typename rhs_t> (lhs_t const & lhs, rhs_t const & rhs) {
+                if constexpr (is_dense_v<lhs_t> && is_dense_v<rhs_t>) {
+                    return with_data(lhs & rhs);
+                } else if constexpr (is_dense_v<rhs_t>) {
+                    return other.intersect(*this);
+                } else if constexpr (is_dense_v<lhs_t> && is_sparse_v<rhs_t>) { // at most as large as rhs.
+                    sparse_type ids{};
+                    std::ranges::copy_if(rhs, std::back_inserter(ids), [&] (value_type const id) {
+                        return lhs[to_position(id)];
+                    });
+                    return with_data(std::move(ids));
+                } else if constexpr (is_dense_v<lhs_t>) { // clears the bits between the runs.
+                    dense_type bits{lhs};
+                    value_type previous = get_domain().min();
+                    for (run_type const & run : rhs) {
+                        clear_bits(bits, previous, run.first);
+                        previous = run.last;
+                    }
+                    clear_bits(bits, previous, get_domain().max());
+                    return with_data(std::move(bits));
+                } else if constexpr (is_sparse_v<lhs_t> || is_sparse_v<rhs_t>) {
+                    return with_data(build_overlap<sparse_builder>(lhs, rhs));
+                } else {
+                    return with_data(build_overlap<runs_builder>(lhs, rhs));
+                }
+            }, _data, other._data);
+        }
+
+        constexpr hybrid_coverage subtract(hybrid_coverage const & other) const {
+            return std::visit([&] <typename lhs_t, typename rhs_t> (lhs_t const & lhs, rhs_t const & rhs) {
+                if constexpr (is_dense_v<lhs_t> && is_dense_v<rhs_t>) {
+                    dense_type bits{lhs};
+                    bits.and_not(rhs);
+                    return with_data(std::move(bits));
+                } else if constexpr (is_dense_v<lhs_t>) {
+                    dense_type bits{lhs};
+                    for_each_run_of(rhs, [&] (value_type const first, value_type const last) {
+                        clear_bits(bits, first, last);
+                    });
+                    return with_data(std::move(bits));
+                } else if constexpr (is_sparse_v<lhs_t> && is_dense_v<rhs_t>) {
+                    sparse_type ids{};
+                    std::ranges::copy_if(lhs, std::back_inserter(ids), [&] (value_type const id) {
+                        return !rhs[to_position(id)];
+                    });
+                    return with_data(std::move(ids));
+                } else if constexpr (is_dense_v<rhs_t>) {
+                    dense_type bits = to_dense(lhs);
+                    bits.and_not(rhs);
+                    return with_data(std::move(bits));
+                } else {
+                    std::conditional_t<is_sparse_v<lhs_t>, sparse_builder, runs_builder> builder{};
+                    for_each_difference(lhs, rhs, [&] (value_type const first, value_type const last) {
+                        builder.push_run(first, last);
+                    });
+                    return with_data(std::move(builder).extract());
+                }
+            }, _data, other._data);
+        }
+
+        constexpr hybrid_coverage unite(hybrid_coverage const & other) const {
+            return std::visit([&] <typename lhs_t, typename rhs_t> (lhs_t const & lhs, rhs_t const & rhs) {
+                if constexpr (is_dense_v<lhs_t> && is_dense_v<rhs_t>) {
+                    return with_data(lhs | rhs);
+                } else if constexpr (is_dense_v<rhs_t>) {
+                    return other.unite(*this);
+                } else if constexpr (is_dense_v<lhs_t>) {
+                    dense_type bits{lhs};
+                    for_each_run_of(rhs, [&] (value_type const first, value_type const last) {
+                        set_bits(bits, first, last);
+                    });
+                    return with_data(std::move(bits));
+                } else {
+                    std::conditional_t<is_sparse_v<lhs_t> && is_sparse_v<rhs_t>, sparse_builder, runs_builder> builder{};
+                    for_each_union(lhs, rhs, [&] (value_type const first, value_type const last) {
+                        builder.push_run(first, last);
+                    });
+                    return with_data(std::move(builder).extract());
+                }
+            }, _data, other._data);
+        }
+
+        constexpr size_t count_shared(hybrid_coverage const & other, bool const stop_at_first) const noexcept {
+            return std::visit([&] <typename lhs_t, typename rhs_t> (lhs_t const & lhs, rhs_t const & rhs) -> size_t {
+                if constexpr (is_dense_v<lhs_t> && is_dense_v<rhs_t>) {
+                    return stop_at_first ? lhs.intersects(rhs) : lhs.intersection_count(rhs);
+                } else if constexpr (is_dense_v<rhs_t>) {
+                    return other.count_shared(*this, stop_at_first);
+                } else if constexpr (is_dense_v<lhs_t>) {
+                    size_t count{};
+                    for (size_t k = 0; k < rhs.size() && !(stop_at_first && count > 0); ++k) {
+                        run_type const run = run_at(rhs, k);
+                        for_each_word_mask(to_position(run.first), to_position(run.last),
+                                           [&] (size_t const i, word_type const mask) {
+                            count += std::popcount(lhs.data()[i] & mask);
+                            return stop_at_first && count > 0;
+                        });
+                    }
+                    return count;
+                } else {
+                    size_t count{};
+                    for_each_overlap(lhs, rhs, [&] (value_type const first, value_type const last) {
+                        count += last - first;
+                        return stop_at_first;
+                    });
+                    return count;
+                }
+            }, _data, other._data);
+        }
+
+        constexpr friend bool operator==(hybrid_coverage const & lhs, hybrid_coverage const & rhs) noexcept {
+            if (lhs.get_domain() != rhs.get_domain())
+                return false;
+            if (lhs.kind() == rhs.kind())
+                return lhs._data == rhs._data;
+
+            return std::ranges::equal(lhs, rhs);
+        }
+
+        constexpr friend hybrid_coverage
+        tag_invoke(libjst::tag_t<coverage_intersection>, hybrid_coverage const & first, hybrid_coverage const & second) {
+            assert(first.get_domain() == second.get_domain());
+            return first.intersect(second);
+        }
+
+        constexpr friend hybrid_coverage
+        tag_invoke(libjst::tag_t<coverage_difference>, hybrid_coverage const & first, hybrid_coverage const & second) {
+            assert(first.get_domain() == second.get_domain());
+            return first.subtract(second);
+        }
+
+        constexpr friend hybrid_coverage
+        tag_invoke(libjst::tag_t<coverage_union>, hybrid_coverage const & first, hybrid_coverage const & second) {
+            assert(first.get_domain() == second.get_domain());
+            return first.unite(second);
+        }
+
+        constexpr friend bool
+        tag_invoke(libjst::tag_t<coverage_intersects>,
+                   hybrid_coverage const & first,
+                   hybrid_coverage const & second) noexcept {
+            assert(first.get_domain() == second.get_domain());
+            return first.count_shared(second, true) > 0;
+        }
+
+        constexpr friend size_t
+        tag_invoke(libjst::tag_t<coverage_intersection_count>,
+                   hybrid_coverage const & first,
+                   hybrid_coverage const & second) noexcept {
+            assert(first.get_domain() == second.get_domain());
+            return first.count_shared(second, false);
+        }
+
+        constexpr friend hybrid_coverage &
+        tag_invoke(libjst::tag_t<coverage_intersect_into>,
+                   hybrid_coverage & target,
+                   hybrid_coverage const & first,
+                   hybrid_coverage const & second) {
+            assert(first.get_domain() == second.get_domain());
+            target = first.intersect(second); // the representation of the result may differ from the one of target.
+            return target;
+        }
+
+        constexpr friend hybrid_coverage &
+        tag_invoke(libjst::tag_t<coverage_difference_into>,
+                   hybrid_coverage & target,
+                   hybrid_coverage const & first,
+                   hybrid_coverage const & second) {
+            assert(first.get_domain() == second.get_domain());
+            target = first.subtract(second); // the representation of the result may differ from the one of target.
+            return target;
+        }
+
+        constexpr friend hybrid_coverage &
+        tag_invoke(libjst::tag_t<coverage_union_into>,
+                   hybrid_coverage & target,
+                   hybrid_coverage const & first,
+                   hybrid_coverage const & second) {
+            assert(first.get_domain() == second.get_domain());
+            target = first.unite(second); // the representation of the result may differ from the one of target.
+            return target;
+        }
+    };
+
+    //!\brief Collects sorted, disjoint runs as sorted ids.
+    template <std::unsigned_integral value_t>
+    class hybrid_coverage<value_t>::sparse_builder {
+    private:
+        sparse_type _ids{};
+
+    public:
+        constexpr void push_run(value_type const first, value_type const last) {
+            for (value_type id = first; id < last; ++id)
+                _ids.push_back(id);
+        }
+
+        constexpr sparse_type extract() && noexcept {
+            return std::move(_ids);
+        }
+    };
+
+    //!\brief Collects sorted, disjoint runs and merges adjacent ones.
+    template <std::unsigned_integral value_t>
+    class hybrid_coverage<value_t>::runs_builder {
+    private:
+        runs_type _runs{};
+
+    public:
+        constexpr void push_run(value_type const first, value_type const last) {
+            if (!_runs.empty() && _runs.back().last == first)
+                _runs.back().last = last;
+            else
+                _runs.push_back(run_type{first, last});
+        }
+
+        constexpr runs_type extract() && noexcept {
+            return std::move(_runs);
+        }
+    };
+
+    //!\brief Forward iterator over the covered ids in increasing order.
+    template <std::unsigned_integral value_t>
+    class hybrid_coverage<value_t>::iterator_impl {
+    public:
+
+        using value_type = typename hybrid_coverage::value_type;
+        using reference = value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using iterator_category = std::forward_iterator_tag;
+
+    private:
+
+        friend hybrid_coverage;
+
+        hybrid_coverage const * _host{};
+        size_t _index{}; //!< The index of the id, of the run or of the bit.
+        value_type _value{}; //!< The current id within the current run.
+
+        constexpr iterator_impl(hybrid_coverage const * host, bool const at_begin) noexcept : _host{host} {
+            std::visit(multi_invocable{
+                [&] (sparse_type const & ids) { _index = at_begin ? 0 : ids.size(); },
+                [&] (runs_type const & runs) {
+                    _index = at_begin ? 0 : runs.size();
+                    _value = (at_begin && !runs.empty()) ? runs.front().first : value_type{};
+                },
+                [&] (dense_type const & bits) { _index = at_begin ? find_bit(bits, 0, true) : bits.size(); }},
+                _host->_data);
+        }
+
+    public:
+
+        constexpr iterator_impl() = default;
+
+        constexpr reference operator*() const noexcept {
+            return std::visit(multi_invocable{
+                [&] (sparse_type const & ids) { return ids[_index]; },
+                [&] (runs_type const &) { return _value; },
+                [&] (dense_type const &) { return _host->to_id(_index); }}, _host->_data);
+        }
+
+        constexpr iterator_impl & operator++() noexcept {
+            std::visit(multi_invocable{
+                [&] (sparse_type const &) { ++_index; },
+                [&] (runs_type const & runs) {
+                    if (++_value == runs[_index].last) {
+                        ++_index;
+                        _value = (_index < runs.size()) ? runs[_index].first : value_type{};
+                    }
+                },
+                [&] (dense_type const & bits) { _index = find_bit(bits, _index + 1, true); }}, _host->_data);
+            return *this;
+        }
+
+        constexpr iterator_impl operator++(int) noexcept {
+            iterator_impl tmp{*this};
+            ++(*this);
+            return tmp;
+        }
+
+    private:
+
+        constexpr friend bool operator==(iterator_impl const & lhs, iterator_impl const & rhs) noexcept {
+            return lhs._index == rhs._index && lhs._value == rhs._value;
+        }
+    };
+}  // namespace libjst
@@ -13,7 +13,10 @@
 #pragma once
 
 #include <algorithm>
+#include <iterator>
 #include <ranges>
+#include <stdexcept>
+#include <string>
 
 #include <libjst/coverage/concept.hpp>
 #include <libjst/coverage/range_domain.hpp>
@@ -51,23 +54,13 @@ namespace libjst
         explicit constexpr int_coverage(elem_range_t && from_list, coverage_domain_t domain) :
             int_coverage{std::move(domain)}
         {
-            std::ranges::for_each(from_list, [&] (value_type elem) {
-                if (!get_domain().is_member(elem))
-                    throw std::domain_error{"The given element " + std::to_string(elem) + " is no member of the coverage domain!"};
-
-                _data.emplace_hint(_data.end(), std::move(elem));
-            });
+            _data.insert(from_list | std::views::transform(checked_member_fn()));
         }
 
         explicit constexpr int_coverage(std::initializer_list<value_type> from_list, coverage_domain_t domain) :
             int_coverage{std::move(domain)}
         {
-            std::ranges::for_each(from_list, [&] (value_type elem) {
-                if (!get_domain().is_member(elem))
-                    throw std::domain_error{"The given element " + std::to_string(elem) + " is no member of the coverage domain!"};
-
-                _data.emplace_hint(_data.end(), std::move(elem));
-            });
+            _data.insert(from_list | std::views::transform(checked_member_fn()));
         }
 
         constexpr bool contains(std::ptrdiff_t idx) const noexcept {
@@ -134,6 +127,11 @@ namespace libjst
             return !_data.empty();
         }
 
+        //!\brief Returns the number of bytes allocated for the ids.
+        size_t memory_usage() const noexcept {
+            return _data.memory_usage();
+        }
+
         constexpr iterator begin() const noexcept {
             return _data.begin();
         }
@@ -160,6 +158,16 @@ namespace libjst
 
     private:
 
+        // Returns the element if it is a member of the coverage domain and throws std::domain_error otherwise.
+        constexpr auto checked_member_fn() const noexcept {
+            return [this] (value_type elem) -> value_type {
+                if (!get_domain().is_member(elem))
+                    throw std::domain_error{"The given element " + std::to_string(elem) + " is no member of the coverage domain!"};
+
+                return elem;
+            };
+        }
+
         constexpr friend bool operator==(int_coverage const &, int_coverage const &) noexcept = default;
 
         constexpr friend int_coverage
@@ -188,11 +196,149 @@ namespace libjst
             // if (first.get_domain() != second.get_domain())
             //     throw std::domain_error{"Trying to intersect elements from different coverage domains."};
 
-            int_coverage result{};
+            int_coverage result{first.get_domain()};
             std::ranges::set_difference(first, second, std::inserter(result, result.end()));
             return result;
         }
 
+        constexpr friend int_coverage
+        tag_invoke(libjst::tag_t<coverage_union>, int_coverage const & first, int_coverage const & second) {
+            int_coverage result{first.get_domain()};
+            std::ranges::set_union(first, second, std::inserter(result, result.end()));
+            return result;
+        }
+
+        constexpr friend bool
+        tag_invoke(libjst::tag_t<coverage_intersects>,
+                   int_coverage const & first,
+                   int_coverage const & second) noexcept {
+            if (first.empty() || second.empty() || first.back() < second.front() || second.back() < first.front())
+                return false;
+
+            auto lhs_it = first.begin();
+            auto rhs_it = second.begin();
+            while (lhs_it != first.end() && rhs_it != second.end()) {
+                if (*lhs_it == *rhs_it)
+                    return true;
+
+                bool const left_less = *lhs_it < *rhs_it;
+                lhs_it += left_less;
+                rhs_it += !left_less;
+            }
+            return false;
+        }
+
+        constexpr friend size_t
+        tag_invoke(libjst::tag_t<coverage_intersection_count>,
+                   int_coverage const & first,
+                   int_coverage const & second) noexcept {
+            size_t count{};
+            auto lhs_it = first.begin();
+            auto rhs_it = second.begin();
+            while (lhs_it != first.end() && rhs_it != second.end()) {
+                bool const is_equal = *lhs_it == *rhs_it;
+                bool const left_less = *lhs_it < *rhs_it;
+                count += is_equal;
+                lhs_it += left_less || is_equal;
+                rhs_it += !left_less;
+            }
+            return count;
+        }
+
+        constexpr friend int_coverage &
+        tag_invoke(libjst::tag_t<coverage_intersect_into>,
+                   int_coverage & target,
+                   int_coverage const & first,
+                   int_coverage const & second) {
+            auto & target_elements = target._data.data();
+            if (&target == &first || &target == &second) { // compact the aliased operand in-place.
+                int_coverage const & other = (&target == &first) ? second : first;
+                auto inserter = target_elements.begin();
+                auto other_it = other.begin();
+                for (auto it = target_elements.begin(); it != target_elements.end() && other_it != other.end();) {
+                    if (*it == *other_it) {
+                        *inserter++ = *it++;
+                        ++other_it;
+                    } else {
+                        bool const left_less = *it < *other_it;
+                        it += left_less;
+                        other_it += !left_less;
+                    }
+                }
+                target_elements.erase(inserter, target_elements.end());
+            } else {
+                target_elements.clear();
+                std::ranges::set_intersection(first._data.data(),
+                                              second._data.data(),
+                                              std::back_inserter(target_elements));
+            }
+            target._domain = first.get_domain();
+            return target;
+        }
+
+        constexpr friend int_coverage &
+        tag_invoke(libjst::tag_t<coverage_difference_into>,
+                   int_coverage & target,
+                   int_coverage const & first,
+                   int_coverage const & second) {
+            if (&target == &second) // the removed elements are read from target.
+                return target = libjst::coverage_difference(first, second);
+
+            auto & target_elements = target._data.data();
+            if (&target == &first) { // compact the aliased operand in-place.
+                auto inserter = target_elements.begin();
+                auto other_it = second.begin();
+                for (auto it = target_elements.begin(); it != target_elements.end(); ++it) {
+                    while (other_it != second.end() && *other_it < *it)
+                        ++other_it;
+                    if (other_it == second.end() || *other_it != *it)
+                        *inserter++ = *it;
+                }
+                target_elements.erase(inserter, target_elements.end());
+            } else {
+                target_elements.clear();
+                std::ranges::set_difference(first._data.data(),
+                                            second._data.data(),
+                                            std::back_inserter(target_elements));
+            }
+            target._domain = first.get_domain();
+            return target;
+        }
+
+        constexpr friend int_coverage &
+        tag_invoke(libjst::tag_t<coverage_union_into>,
+                   int_coverage & target,
+                   int_coverage const & first,
+                   int_coverage const & second) {
+            auto & target_elements = target._data.data();
+            if (&target == &first || &target == &second) { // merge the other operand from the back in-place.
+                int_coverage const & other = (&target == &first) ? second : first;
+                if (&other == &target)
+                    return target;
+
+                std::size_t const target_size = target_elements.size();
+                target_elements.resize(target_size + other.size() - libjst::coverage_intersection_count(target, other));
+                auto it = target_elements.begin() + target_size;
+                auto other_it = other._data.data().end();
+                auto inserter = target_elements.end();
+                while (other_it != other._data.data().begin()) {
+                    if (it != target_elements.begin() && *(it - 1) >= *(other_it - 1)) {
+                        other_it -= (*(it - 1) == *(other_it - 1));
+                        *--inserter = *--it;
+                    } else {
+                        *--inserter = *--other_it;
+                    }
+                }
+            } else {
+                target_elements.clear();
+                std::ranges::set_union(first._data.data(),
+                                       second._data.data(),
+                                       std::back_inserter(target_elements));
+            }
+            target._domain = first.get_domain();
+            return target;
+        }
+
         constexpr int_coverage compute_intersection(int_coverage rhs) const noexcept {
             auto lhs_it = _data.data().begin();
             auto rhs_it = rhs._data.data().begin();
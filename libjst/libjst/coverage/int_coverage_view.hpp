@@ -0,0 +1,119 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides a read-only view over the sorted ids of an int coverage.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <span>
+
+#include <libjst/coverage/int_coverage.hpp>
+#include <libjst/coverage/range_domain.hpp>
+
+namespace libjst
+{
+
+    /*!\brief A read-only view over the sorted ids of an int coverage.
+     *
+     * \tparam value_t The value type of the coverage domain.
+     *
+     * \details
+     *
+     * The view references a sorted sequence of ids, e.g. a slice of the ids of many coverages stored in one buffer,
+     * and behaves like a constant libjst::int_coverage. It is cheap to copy and is invalidated whenever the referenced
+     * ids are reallocated. An owning coverage is obtained with the explicit conversion to libjst::int_coverage.
+     */
+    template <std::unsigned_integral value_t>
+    class int_coverage_view {
+    private:
+
+        using coverage_domain_t = range_domain<value_t>;
+        using domain_value_type = typename coverage_domain_t::value_type;
+
+        std::span<domain_value_type const> _ids{};
+        coverage_domain_t _domain{};
+
+    public:
+
+        using value_type = domain_value_type;
+        using iterator = typename std::span<domain_value_type const>::iterator;
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        constexpr int_coverage_view() = default; //!< Default.
+
+        //!\brief Constructs a view over the given sorted ids of the domain.
+        constexpr explicit int_coverage_view(std::span<domain_value_type const> ids,
+                                             coverage_domain_t domain) noexcept :
+            _ids{ids},
+            _domain{std::move(domain)}
+        {
+            assert(std::ranges::is_sorted(_ids));
+        }
+        //!\}
+
+        //!\brief Returns an owning copy of the viewed coverage.
+        constexpr explicit operator int_coverage<value_t>() const {
+            return int_coverage<value_t>{_ids, get_domain()};
+        }
+
+        constexpr value_type front() const noexcept {
+            assert(!empty());
+            return _ids.front();
+        }
+
+        constexpr value_type back() const noexcept {
+            assert(!empty());
+            return _ids.back();
+        }
+
+        constexpr bool empty() const noexcept {
+            return _ids.empty();
+        }
+
+        constexpr bool any() const noexcept {
+            return !empty();
+        }
+
+        constexpr size_t size() const noexcept {
+            return _ids.size();
+        }
+
+        constexpr size_t max_size() const noexcept {
+            return get_domain().size();
+        }
+
+        constexpr coverage_domain_t const & get_domain() const noexcept {
+            return _domain;
+        }
+
+        constexpr iterator begin() const noexcept {
+            return _ids.begin();
+        }
+
+        constexpr iterator end() const noexcept {
+            return _ids.end();
+        }
+
+    private:
+
+        constexpr friend bool operator==(int_coverage_view const & lhs, int_coverage_view const & rhs) noexcept {
+            return lhs.get_domain() == rhs.get_domain() && std::ranges::equal(lhs, rhs);
+        }
+
+        constexpr friend bool operator==(int_coverage_view const & lhs, int_coverage<value_t> const & rhs) noexcept {
+            return lhs.get_domain() == rhs.get_domain() && std::ranges::equal(lhs, rhs);
+        }
+    };
+}  // namespace libjst
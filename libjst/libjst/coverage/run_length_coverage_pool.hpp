@@ -0,0 +1,314 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides a coverage matrix storing the run-length encoded columns of many bit coverages.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/coverage/bit_coverage_view.hpp>
+#include <libjst/coverage/range_domain.hpp>
+#include <libjst/coverage/run_length_coverage_view.hpp>
+#include <libjst/utility/huge_pages.hpp>
+#include <libjst/utility/prefetch.hpp>
+
+namespace libjst
+{
+
+    /*!\brief A random access container of run-length encoded bit coverages sharing one coverage domain.
+     *
+     * \tparam value_t The value type of the coverage domain.
+     *
+     * \details
+     *
+     * The container stores a coverage matrix with one column per coverage. Every column is encoded as its maximal runs
+     * of covered ids, and the runs of all columns are kept in a single buffer, followed by the number of ids
+     * preceding each run. A column hence costs memory proportional to its number of runs instead of the domain size,
+     * which pays off for large domains, where most columns are either rare or consist of few long runs of haplotypes.
+     * The elements are accessed through a libjst::run_length_coverage_view, which answers membership, rank and select
+     * queries and intersects with the bits of a libjst::bit_coverage, e.g. the colour of the current path, without
+     * decoding the column. The coverage domain is adopted from the first inserted coverage and all further coverages
+     * must share it.
+     *
+     * The container can be used as storage of a libjst::contiguous_multimap. Inserting or reserving memory invalidates
+     * all views handed out before.
+     */
+    template <std::unsigned_integral value_t>
+    class run_length_coverage_pool {
+    private:
+
+        using coverage_domain_t = range_domain<value_t>;
+        using domain_value_type = typename coverage_domain_t::value_type;
+        using run_type = typename run_length_coverage_view<value_t>::run_type;
+        using word_type = uint64_t;
+
+        class iterator_impl;
+
+        std::vector<run_type> _runs{};
+        std::vector<domain_value_type> _ranks{};
+        std::vector<size_t> _offsets{size_t{0}};
+        coverage_domain_t _domain{};
+
+    public:
+
+        using value_type = bit_coverage<value_t>;
+        using reference = run_length_coverage_view<value_t>;
+        using const_reference = reference;
+        using iterator = iterator_impl;
+        using const_iterator = iterator_impl;
+        using difference_type = std::ptrdiff_t;
+        using size_type = std::size_t;
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        constexpr run_length_coverage_pool() = default; //!< Default.
+
+        //!\brief Constructs an empty pool for coverages over the given domain.
+        constexpr explicit run_length_coverage_pool(coverage_domain_t domain) : _domain{std::move(domain)}
+        {}
+        //!\}
+
+        /*!\brief Inserts the run-length encoding of the coverage before the given position.
+         *
+         * \param[in] pos The position to insert the coverage at.
+         * \param[in] coverage The coverage to insert.
+         *
+         * \returns An iterator to the inserted coverage.
+         *
+         * \details
+         *
+         * Throws std::domain_error if the pool is not empty and the coverage domains differ.
+         */
+        iterator insert(const_iterator pos, value_type const & coverage) {
+            if (empty())
+                _domain = coverage.get_domain();
+            else if (coverage.get_domain() != _domain)
+                throw std::domain_error{"Trying to insert a coverage from a different coverage domain!"};
+
+            std::vector<run_type> runs = encode(coverage);
+            std::vector<domain_value_type> ranks(runs.size());
+            domain_value_type rank{};
+            for (size_t i = 0; i < runs.size(); ++i) {
+                ranks[i] = rank;
+                rank += runs[i].last - runs[i].first;
+            }
+
+            difference_type const offset = pos - begin();
+            size_t const run_offset = _offsets[offset];
+            _runs.insert(std::ranges::next(_runs.begin(), run_offset), runs.begin(), runs.end());
+            _ranks.insert(std::ranges::next(_ranks.begin(), run_offset), ranks.begin(), ranks.end());
+            auto offset_it = _offsets.insert(std::ranges::next(_offsets.begin(), offset + 1), run_offset);
+            std::ranges::for_each(offset_it, _offsets.end(), [&] (size_t & run_end) { run_end += runs.size(); });
+            return std::ranges::next(begin(), offset);
+        }
+
+        constexpr void reserve(size_type const new_capacity) {
+            _offsets.reserve(new_capacity + 1);
+        }
+
+        constexpr void clear() noexcept {
+            _runs.clear();
+            _ranks.clear();
+            _offsets.resize(1);
+        }
+
+        constexpr reference operator[](difference_type const idx) const noexcept {
+            return begin()[idx];
+        }
+
+        constexpr size_type size() const noexcept {
+            return _offsets.size() - 1;
+        }
+
+        constexpr bool empty() const noexcept {
+            return size() == 0;
+        }
+
+        //!\brief Returns the number of runs stored over all coverages.
+        constexpr size_type run_count() const noexcept {
+            return _runs.size();
+        }
+
+        //!\brief Returns the number of bytes occupied by the encoded coverages.
+        constexpr size_type memory_usage() const noexcept {
+            return _runs.size() * sizeof(run_type) +
+                   _ranks.size() * sizeof(domain_value_type) +
+                   _offsets.size() * sizeof(size_t);
+        }
+
+        //!\brief Prefetches the first runs of the coverage at the given position if it exists.
+        [[gnu::always_inline]] void prefetch(difference_type const position) const noexcept {
+            if (position >= 0 && static_cast<size_type>(position) < size()) {
+                size_t const run_offset = _offsets[position];
+                libjst::prefetch(_runs.data() + run_offset);
+                libjst::prefetch(_ranks.data() + run_offset);
+            }
+        }
+
+        //!\brief Advises the kernel to back the runs by transparent huge pages, see libjst::advise_huge_pages.
+        size_type advise_huge_pages() const noexcept {
+            return libjst::advise_huge_pages(_runs) + libjst::advise_huge_pages(_ranks) +
+                   libjst::advise_huge_pages(_offsets);
+        }
+
+        constexpr coverage_domain_t const & get_domain() const noexcept {
+            return _domain;
+        }
+
+        constexpr iterator begin() const noexcept {
+            return iterator{this, 0};
+        }
+
+        constexpr iterator end() const noexcept {
+            return iterator{this, static_cast<difference_type>(size())};
+        }
+
+        // ----------------------------------------------------------------------------
+        // Serialisation
+        // ----------------------------------------------------------------------------
+
+        template <typename archive_t>
+        void load(archive_t & iarchive)
+        {
+            iarchive(_runs, _ranks, _offsets, _domain);
+        }
+
+        template <typename archive_t>
+        void save(archive_t & oarchive) const
+        {
+            oarchive(_runs, _ranks, _offsets, _domain);
+        }
+
+    private:
+
+        //!\brief Returns the maximal runs of set bits of the coverage.
+        static std::vector<run_type> encode(value_type const & coverage) {
+            std::span<word_type const> words = bit_coverage_view<value_t>{coverage}.words();
+            size_t const bit_count = coverage.max_size();
+
+            std::vector<run_type> runs{};
+            size_t first = detail::find_bit(words.data(), bit_count, 0, true);
+            while (first < bit_count) {
+                size_t const last = detail::find_bit(words.data(), bit_count, first, false);
+                runs.push_back(run_type{static_cast<domain_value_type>(first), static_cast<domain_value_type>(last)});
+                first = detail::find_bit(words.data(), bit_count, last, true);
+            }
+            return runs;
+        }
+    };
+
+    //!\brief Random access iterator over the coverages of the pool.
+    template <std::unsigned_integral value_t>
+    class run_length_coverage_pool<value_t>::iterator_impl {
+    public:
+
+        using value_type = run_length_coverage_pool::value_type;
+        using reference = run_length_coverage_pool::reference;
+        using difference_type = run_length_coverage_pool::difference_type;
+        using pointer = void;
+        using iterator_category = std::random_access_iterator_tag;
+
+    private:
+
+        friend run_length_coverage_pool;
+
+        run_length_coverage_pool const * _pool{};
+        difference_type _position{};
+
+        constexpr explicit iterator_impl(run_length_coverage_pool const * pool, difference_type const position) noexcept :
+            _pool{pool},
+            _position{position}
+        {}
+
+    public:
+
+        constexpr iterator_impl() = default;
+
+        constexpr reference operator*() const noexcept {
+            size_t const run_offset = _pool->_offsets[_position];
+            return reference{_pool->_runs.data() + run_offset,
+                             _pool->_ranks.data() + run_offset,
+                             _pool->_offsets[_position + 1] - run_offset,
+                             _pool->get_domain()};
+        }
+
+        constexpr reference operator[](difference_type const step) const noexcept {
+            return *(*this + step);
+        }
+
+        constexpr iterator_impl & operator++() noexcept {
+            ++_position;
+            return *this;
+        }
+
+        constexpr iterator_impl operator++(int) noexcept {
+            iterator_impl tmp{*this};
+            ++(*this);
+            return tmp;
+        }
+
+        constexpr iterator_impl & operator+=(difference_type const step) noexcept {
+            _position += step;
+            return *this;
+        }
+
+        constexpr iterator_impl & operator--() noexcept {
+            --_position;
+            return *this;
+        }
+
+        constexpr iterator_impl operator--(int) noexcept {
+            iterator_impl tmp{*this};
+            --(*this);
+            return tmp;
+        }
+
+        constexpr iterator_impl & operator-=(difference_type const step) noexcept {
+            _position -= step;
+            return *this;
+        }
+
+    private:
+
+        constexpr friend iterator_impl operator+(iterator_impl lhs, difference_type const step) noexcept {
+            return lhs += step;
+        }
+
+        constexpr friend iterator_impl operator+(difference_type const step, iterator_impl rhs) noexcept {
+            return rhs += step;
+        }
+
+        constexpr friend iterator_impl operator-(iterator_impl lhs, difference_type const step) noexcept {
+            return lhs -= step;
+        }
+
+        constexpr friend difference_type operator-(iterator_impl const & lhs, iterator_impl const & rhs) noexcept {
+            return lhs._position - rhs._position;
+        }
+
+        constexpr friend bool operator==(iterator_impl const & lhs, iterator_impl const & rhs) noexcept {
+            return lhs._position == rhs._position;
+        }
+
+        constexpr friend std::strong_ordering operator<=>(iterator_impl const & lhs, iterator_impl const & rhs) noexcept {
+            return lhs._position <=> rhs._position;
+        }
+    };
+}  // namespace libjst
@@ -0,0 +1,607 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides a non-owning view over the run-length encoded column of a coverage matrix.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <iterator>
+#include <span>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/coverage/concept.hpp>
+#include <libjst/coverage/range_domain.hpp>
+
+namespace libjst
+{
+    namespace detail
+    {
+        //!\brief Invokes `fn(word_index, mask)` for the words spanned by the bit positions `[first, last)`.
+        template <typename fn_t>
+        constexpr void for_each_word_mask(size_t first, size_t const last, fn_t && fn) {
+            constexpr size_t word_size = sizeof(uint64_t) * 8;
+            while (first < last) {
+                size_t const offset = first % word_size;
+                size_t const width = std::min(word_size - offset, last - first);
+                uint64_t const mask = (width == word_size) ? ~uint64_t{0} : ((uint64_t{1} << width) - 1) << offset;
+                fn(first / word_size, mask);
+                first += width;
+            }
+        }
+
+        //!\brief Returns the first position in `[position, bit_count)` whose bit equals `bit`, or `bit_count`.
+        constexpr size_t find_bit(uint64_t const * words,
+                                  size_t const bit_count,
+                                  size_t const position,
+                                  bool const bit) noexcept {
+            constexpr size_t word_size = sizeof(uint64_t) * 8;
+            if (position >= bit_count)
+                return bit_count;
+
+            uint64_t const flip = bit ? uint64_t{0} : ~uint64_t{0};
+            size_t word_index = position / word_size;
+            uint64_t word = (words[word_index] ^ flip) & (~uint64_t{0} << (position % word_size));
+            while (word == 0) {
+                if (++word_index * word_size >= bit_count)
+                    return bit_count;
+                word = words[word_index] ^ flip;
+            }
+            return std::min(word_index * word_size + std::countr_zero(word), bit_count);
+        }
+    } // namespace detail
+
+    /*!\brief A read-only view over the runs of set bits of one coverage stored in a libjst::run_length_coverage_pool.
+     *
+     * \tparam value_t The value type of the coverage domain.
+     *
+     * \details
+     *
+     * The covered ids are stored as the sorted, maximal half-open runs `[first, last)` of consecutive bit positions
+     * together with the number of ids preceding every run. This allows to answer libjst::run_length_coverage_view::rank
+     * and libjst::run_length_coverage_view::select queries by a binary search over the runs without decoding the
+     * column. Like libjst::bit_coverage_view the bit positions are the raw ids, hence the view is interchangeable with
+     * a libjst::bit_coverage over the same domain. Intersections and differences with a libjst::bit_coverage only touch
+     * the words spanned by the runs and return an owning libjst::bit_coverage. The view iterates over its ids in
+     * increasing order and is invalidated whenever the pool reallocates.
+     */
+    template <std::unsigned_integral value_t>
+    class run_length_coverage_view {
+    private:
+
+        using coverage_domain_t = range_domain<value_t>;
+        using domain_value_type = typename coverage_domain_t::value_type;
+        using word_type = uint64_t;
+
+        class iterator_impl;
+
+    public:
+
+        //!\brief A half-open interval `[first, last)` of consecutive bit positions.
+        struct run_type {
+            domain_value_type first{};
+            domain_value_type last{};
+
+            template <typename archive_t>
+            void serialize(archive_t & archive) {
+                archive(first, last);
+            }
+
+            constexpr friend bool operator==(run_type const &, run_type const &) noexcept = default;
+        };
+
+    private:
+
+        run_type const * _runs{};
+        domain_value_type const * _ranks{};
+        size_t _run_count{};
+        coverage_domain_t _domain{};
+
+    public:
+
+        using value_type = domain_value_type;
+        using iterator = iterator_impl;
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        constexpr run_length_coverage_view() = default; //!< Default.
+
+        /*!\brief Constructs a view over `run_count` many runs.
+         *
+         * \param[in] runs Pointer to the first run.
+         * \param[in] ranks Pointer to the number of ids preceding the first run; one rank per run.
+         * \param[in] run_count The number of runs.
+         * \param[in] domain The coverage domain.
+         */
+        constexpr explicit run_length_coverage_view(run_type const * runs,
+                                                    domain_value_type const * ranks,
+                                                    size_t const run_count,
+                                                    coverage_domain_t domain) noexcept :
+            _runs{runs},
+            _ranks{ranks},
+            _run_count{run_count},
+            _domain{std::move(domain)}
+        {}
+        //!\}
+
+        /*!\name Rank and select
+         * \{
+         */
+        //!\brief Returns whether the id is covered.
+        constexpr bool contains(value_type const id) const noexcept {
+            run_type const * run = run_before(id);
+            return run != nullptr && id < run->last;
+        }
+
+        //!\brief Returns the number of covered ids smaller than `id`.
+        constexpr size_t rank(value_type const id) const noexcept {
+            run_type const * run = run_before(id);
+            if (run == nullptr)
+                return 0;
+            return _ranks[run - _runs] + (std::min(id, run->last) - run->first);
+        }
+
+        //!\brief Returns the `k`-th smallest covered id, counting from 0; requires `k < size()`.
+        constexpr value_type select(size_t const k) const noexcept {
+            assert(k < size());
+            std::span<domain_value_type const> ranks{_ranks, _run_count};
+            size_t const run_index = std::ranges::upper_bound(ranks, k) - ranks.begin() - 1;
+            return static_cast<value_type>(_runs[run_index].first + (k - _ranks[run_index]));
+        }
+        //!\}
+
+        constexpr value_type front() const noexcept {
+            assert(!empty());
+            return _runs[0].first;
+        }
+
+        constexpr value_type back() const noexcept {
+            assert(!empty());
+            return static_cast<value_type>(_runs[_run_count - 1].last - 1);
+        }
+
+        constexpr bool empty() const noexcept {
+            return !any();
+        }
+
+        constexpr bool any() const noexcept {
+            return _run_count > 0;
+        }
+
+        //!\brief Returns the number of covered ids.
+        constexpr size_t size() const noexcept {
+            if (empty())
+                return 0;
+            run_type const & last_run = _runs[_run_count - 1];
+            return _ranks[_run_count - 1] + (last_run.last - last_run.first);
+        }
+
+        constexpr size_t max_size() const noexcept {
+            return get_domain().size();
+        }
+
+        constexpr coverage_domain_t const & get_domain() const noexcept {
+            return _domain;
+        }
+
+        //!\brief Returns the referenced runs.
+        constexpr std::span<run_type const> runs() const noexcept {
+            return {_runs, _run_count};
+        }
+
+        //!\brief Sets the bits of all covered ids in the given words, which must span the coverage domain.
+        constexpr void decode_into(word_type * words) const noexcept {
+            for (run_type const & run : runs())
+                detail::for_each_word_mask(run.first, run.last, [&] (size_t const word_index, word_type const mask) {
+                    words[word_index] |= mask;
+                });
+        }
+
+        constexpr iterator begin() const noexcept {
+            return iterator{_runs, _runs + _run_count};
+        }
+
+        constexpr iterator end() const noexcept {
+            return iterator{_runs + _run_count, _runs + _run_count};
+        }
+
+    private:
+
+        //!\brief Returns the last run beginning at or before `id`, or `nullptr` if there is none.
+        constexpr run_type const * run_before(value_type const id) const noexcept {
+            run_type const * run = std::ranges::upper_bound(_runs, _runs + _run_count, id, std::ranges::less{},
+                                                            &run_type::first);
+            return (run == _runs) ? nullptr : std::ranges::prev(run);
+        }
+
+        //!\brief Invokes `fn(first, last)` for the non-empty overlaps of the runs of both views in increasing order.
+        template <typename fn_t>
+        static constexpr void for_each_overlap(run_length_coverage_view const & first,
+                                               run_length_coverage_view const & second,
+                                               fn_t && fn) {
+            run_type const * lhs = first._runs;
+            run_type const * rhs = second._runs;
+            run_type const * lhs_end = lhs + first._run_count;
+            run_type const * rhs_end = rhs + second._run_count;
+            while (lhs != lhs_end && rhs != rhs_end) {
+                value_type const overlap_first = std::max(lhs->first, rhs->first);
+                value_type const overlap_last = std::min(lhs->last, rhs->last);
+                if (overlap_first < overlap_last && fn(overlap_first, overlap_last))
+                    return;
+                (lhs->last < rhs->last) ? ++lhs : ++rhs;
+            }
+        }
+
+        //!\brief Clears all bits in `words` which are not covered by the view.
+        constexpr void clear_uncovered(word_type * words) const noexcept {
+            auto clear = [&] (size_t const word_index, word_type const mask) { words[word_index] &= ~mask; };
+            size_t position = 0;
+            for (run_type const & run : runs()) {
+                detail::for_each_word_mask(position, run.first, clear);
+                position = run.last;
+            }
+            detail::for_each_word_mask(position, max_size(), clear);
+        }
+
+        //!\brief Returns the bits of the coverage as words; the coverage must share the domain of the view.
+        static constexpr word_type const * words_of(bit_coverage<value_t> const & coverage) noexcept {
+            return coverage._data.data();
+        }
+
+        static constexpr word_type * words_of(bit_coverage<value_t> & coverage) noexcept {
+            return coverage._data.data();
+        }
+
+        static constexpr bit_coverage<value_t> decode(run_length_coverage_view const & view) {
+            bit_coverage<value_t> result{view.get_domain()};
+            view.decode_into(words_of(result));
+            return result;
+        }
+
+        static constexpr bit_coverage<value_t> intersect(run_length_coverage_view const & view,
+                                                         bit_coverage<value_t> const & coverage) {
+            assert(view.get_domain() == coverage.get_domain());
+
+            bit_coverage<value_t> result{view.get_domain()};
+            word_type const * source = words_of(coverage);
+            word_type * target = words_of(result);
+            for (run_type const & run : view.runs())
+                detail::for_each_word_mask(run.first, run.last, [&] (size_t const word_index, word_type const mask) {
+                    target[word_index] |= source[word_index] & mask;
+                });
+            return result;
+        }
+
+        static constexpr bool intersects(run_length_coverage_view const & view,
+                                         bit_coverage<value_t> const & coverage) noexcept {
+            assert(view.get_domain() == coverage.get_domain());
+
+            word_type const * words = words_of(coverage);
+            return std::ranges::any_of(view.runs(), [&] (run_type const & run) {
+                bool found = false;
+                detail::for_each_word_mask(run.first, run.last, [&] (size_t const word_index, word_type const mask) {
+                    found |= (words[word_index] & mask) != 0;
+                });
+                return found;
+            });
+        }
+
+        static constexpr size_t intersection_count(run_length_coverage_view const & view,
+                                                   bit_coverage<value_t> const & coverage) noexcept {
+            assert(view.get_domain() == coverage.get_domain());
+
+            word_type const * words = words_of(coverage);
+            size_t count = 0;
+            for (run_type const & run : view.runs())
+                detail::for_each_word_mask(run.first, run.last, [&] (size_t const word_index, word_type const mask) {
+                    count += std::popcount(words[word_index] & mask);
+                });
+            return count;
+        }
+
+        //!\brief Copies the coverage into target unless they alias and clears the bits covered by the view.
+        static constexpr bit_coverage<value_t> & subtract_into(bit_coverage<value_t> & target,
+                                                               bit_coverage<value_t> const & coverage,
+                                                               run_length_coverage_view const & view) {
+            assert(view.get_domain() == coverage.get_domain());
+
+            if (std::addressof(target) != std::addressof(coverage))
+                target = coverage;
+            view.clear_covered(words_of(target));
+            return target;
+        }
+
+        //!\brief Copies the coverage into target unless they alias and clears the bits not covered by the view.
+        static constexpr bit_coverage<value_t> & intersect_into(bit_coverage<value_t> & target,
+                                                                bit_coverage<value_t> const & coverage,
+                                                                run_length_coverage_view const & view) {
+            assert(view.get_domain() == coverage.get_domain());
+
+            if (std::addressof(target) != std::addressof(coverage))
+                target = coverage;
+            view.clear_uncovered(words_of(target));
+            return target;
+        }
+
+        constexpr friend bool operator==(run_length_coverage_view const & lhs,
+                                         run_length_coverage_view const & rhs) noexcept {
+            return lhs.get_domain() == rhs.get_domain() && std::ranges::equal(lhs.runs(), rhs.runs());
+        }
+
+        //!\brief Compares the runs of the view with the maximal runs of set bits of the coverage.
+        constexpr friend bool operator==(run_length_coverage_view const & lhs,
+                                         bit_coverage<value_t> const & rhs) noexcept {
+            if (lhs.get_domain() != rhs.get_domain())
+                return false;
+
+            word_type const * words = words_of(rhs);
+            size_t const bit_count = rhs.max_size();
+            size_t position = detail::find_bit(words, bit_count, 0, true);
+            for (run_type const & run : lhs.runs()) {
+                if (position != run.first)
+                    return false;
+                position = detail::find_bit(words, bit_count, position, false);
+                if (position != run.last)
+                    return false;
+                position = detail::find_bit(words, bit_count, position, true);
+            }
+            return position == bit_count;
+        }
+
+        /*!\name Set operations
+         * \{
+         */
+        constexpr friend bit_coverage<value_t>
+        tag_invoke(libjst::tag_t<coverage_intersection>,
+                   run_length_coverage_view const & first,
+                   run_length_coverage_view const & second) {
+            assert(first.get_domain() == second.get_domain());
+
+            bit_coverage<value_t> result{first.get_domain()};
+            word_type * words = words_of(result);
+            for_each_overlap(first, second, [&] (value_type const overlap_first, value_type const overlap_last) {
+                detail::for_each_word_mask(overlap_first, overlap_last, [&] (size_t const word_index,
+                                                                             word_type const mask) {
+                    words[word_index] |= mask;
+                });
+                return false;
+            });
+            return result;
+        }
+
+        constexpr friend bit_coverage<value_t>
+        tag_invoke(libjst::tag_t<coverage_intersection>,
+                   bit_coverage<value_t> const & first,
+                   run_length_coverage_view const & second) {
+            return intersect(second, first);
+        }
+
+        constexpr friend bit_coverage<value_t>
+        tag_invoke(libjst::tag_t<coverage_intersection>,
+                   run_length_coverage_view const & first,
+                   bit_coverage<value_t> const & second) {
+            return intersect(first, second);
+        }
+
+        constexpr friend bit_coverage<value_t>
+        tag_invoke(libjst::tag_t<coverage_difference>,
+                   run_length_coverage_view const & first,
+                   run_length_coverage_view const & second) {
+            bit_coverage<value_t> result = decode(first);
+            second.clear_covered(words_of(result));
+            return result;
+        }
+
+        constexpr friend bit_coverage<value_t>
+        tag_invoke(libjst::tag_t<coverage_difference>,
+                   bit_coverage<value_t> const & first,
+                   run_length_coverage_view const & second) {
+            assert(first.get_domain() == second.get_domain());
+
+            bit_coverage<value_t> result{first};
+            second.clear_covered(words_of(result));
+            return result;
+        }
+
+        constexpr friend bit_coverage<value_t>
+        tag_invoke(libjst::tag_t<coverage_difference>,
+                   run_length_coverage_view const & first,
+                   bit_coverage<value_t> const & second) {
+            assert(first.get_domain() == second.get_domain());
+
+            bit_coverage<value_t> result{first.get_domain()};
+            word_type const * source = words_of(second);
+            word_type * target = words_of(result);
+            for (run_type const & run : first.runs())
+                detail::for_each_word_mask(run.first, run.last, [&] (size_t const word_index, word_type const mask) {
+                    target[word_index] |= ~source[word_index] & mask;
+                });
+            return result;
+        }
+        //!\}
+
+        /*!\name Fused predicates
+         * \{
+         */
+        constexpr friend bool
+        tag_invoke(libjst::tag_t<coverage_intersects>,
+                   run_length_coverage_view const & first,
+                   run_length_coverage_view const & second) noexcept {
+            assert(first.get_domain() == second.get_domain());
+
+            bool found = false;
+            for_each_overlap(first, second, [&] (value_type, value_type) { return found = true; });
+            return found;
+        }
+
+        constexpr friend bool
+        tag_invoke(libjst::tag_t<coverage_intersects>,
+                   bit_coverage<value_t> const & first,
+                   run_length_coverage_view const & second) noexcept {
+            return intersects(second, first);
+        }
+
+        constexpr friend bool
+        tag_invoke(libjst::tag_t<coverage_intersects>,
+                   run_length_coverage_view const & first,
+                   bit_coverage<value_t> const & second) noexcept {
+            return intersects(first, second);
+        }
+
+        constexpr friend size_t
+        tag_invoke(libjst::tag_t<coverage_intersection_count>,
+                   run_length_coverage_view const & first,
+                   run_length_coverage_view const & second) noexcept {
+            assert(first.get_domain() == second.get_domain());
+
+            size_t count = 0;
+            for_each_overlap(first, second, [&] (value_type const overlap_first, value_type const overlap_last) {
+                count += overlap_last - overlap_first;
+                return false;
+            });
+            return count;
+        }
+
+        constexpr friend size_t
+        tag_invoke(libjst::tag_t<coverage_intersection_count>,
+                   bit_coverage<value_t> const & first,
+                   run_length_coverage_view const & second) noexcept {
+            return intersection_count(second, first);
+        }
+
+        constexpr friend size_t
+        tag_invoke(libjst::tag_t<coverage_intersection_count>,
+                   run_length_coverage_view const & first,
+                   bit_coverage<value_t> const & second) noexcept {
+            return intersection_count(first, second);
+        }
+
+        constexpr friend bit_coverage<value_t> &
+        tag_invoke(libjst::tag_t<coverage_intersect_into>,
+                   bit_coverage<value_t> & target,
+                   bit_coverage<value_t> const & first,
+                   run_length_coverage_view const & second) {
+            return intersect_into(target, first, second);
+        }
+
+        constexpr friend bit_coverage<value_t> &
+        tag_invoke(libjst::tag_t<coverage_intersect_into>,
+                   bit_coverage<value_t> & target,
+                   run_length_coverage_view const & first,
+                   bit_coverage<value_t> const & second) {
+            return intersect_into(target, second, first);
+        }
+
+        constexpr friend bit_coverage<value_t> &
+        tag_invoke(libjst::tag_t<coverage_intersect_into>,
+                   bit_coverage<value_t> & target,
+                   run_length_coverage_view const & first,
+                   run_length_coverage_view const & second) {
+            return target = libjst::coverage_intersection(first, second);
+        }
+
+        constexpr friend bit_coverage<value_t> &
+        tag_invoke(libjst::tag_t<coverage_difference_into>,
+                   bit_coverage<value_t> & target,
+                   bit_coverage<value_t> const & first,
+                   run_length_coverage_view const & second) {
+            return subtract_into(target, first, second);
+        }
+        //!\}
+
+        //!\brief Clears all bits in `words` which are covered by the view.
+        constexpr void clear_covered(word_type * words) const noexcept {
+            for (run_type const & run : runs())
+                detail::for_each_word_mask(run.first, run.last, [&] (size_t const word_index, word_type const mask) {
+                    words[word_index] &= ~mask;
+                });
+        }
+    };
+
+    //!\brief Forward iterator over the covered ids in increasing order.
+    template <std::unsigned_integral value_t>
+    class run_length_coverage_view<value_t>::iterator_impl {
+    public:
+
+        using value_type = run_length_coverage_view::value_type;
+        using reference = value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using iterator_category = std::forward_iterator_tag;
+
+    private:
+
+        friend run_length_coverage_view;
+
+        run_type const * _run{};
+        run_type const * _run_end{};
+        value_type _id{};
+
+        constexpr explicit iterator_impl(run_type const * run, run_type const * run_end) noexcept :
+            _run{run},
+            _run_end{run_end},
+            _id{(run != run_end) ? run->first : value_type{}}
+        {}
+
+    public:
+
+        constexpr iterator_impl() = default;
+
+        constexpr reference operator*() const noexcept {
+            return _id;
+        }
+
+        constexpr iterator_impl & operator++() noexcept {
+            assert(_run != _run_end);
+            if (++_id == _run->last)
+                _id = (++_run != _run_end) ? _run->first : value_type{};
+            return *this;
+        }
+
+        constexpr iterator_impl operator++(int) noexcept {
+            iterator_impl tmp{*this};
+            ++(*this);
+            return tmp;
+        }
+
+    private:
+
+        constexpr friend bool operator==(iterator_impl const & lhs, iterator_impl const & rhs) noexcept {
+            return lhs._run == rhs._run && lhs._id == rhs._id;
+        }
+    };
+}  // namespace libjst
+
+namespace std {
+
+    //!\brief The common reference of a run-length coverage view and a bit coverage is the decoded bit coverage.
+    template <std::unsigned_integral value_t, template <typename> typename view_q, template <typename> typename coverage_q>
+    struct basic_common_reference<libjst::run_length_coverage_view<value_t>,
+                                  libjst::bit_coverage<value_t>,
+                                  view_q,
+                                  coverage_q>
+    {
+        using type = libjst::bit_coverage<value_t>;
+    };
+
+    template <std::unsigned_integral value_t, template <typename> typename coverage_q, template <typename> typename view_q>
+    struct basic_common_reference<libjst::bit_coverage<value_t>,
+                                  libjst::run_length_coverage_view<value_t>,
+                                  coverage_q,
+                                  view_q>
+    {
+        using type = libjst::bit_coverage<value_t>;
+    };
+
+} // namespace std
@@ -13,10 +13,15 @@
 
 #pragma once
 
+#include <cassert>
 #include <concepts>
+#include <cstddef>
 #include <exception>
 #include <memory>
+#include <new>
 #include <string_view>
+#include <type_traits>
+#include <utility>
 
 namespace libjst
 {
@@ -55,6 +60,11 @@ namespace libjst
       * @tparam sequence_t The general type of the sequence. This type must be default constructible.
       *
       * @note In order for the type erasure to work the wrapped sequence must be convertible to `sequence_t`.
+      *
+      * Concrete sequences that fit into a buffer of four pointers and are nothrow move constructible, e.g. short
+      * std::strings or views, are stored inside of the any_sequence without allocating memory. Larger sequences are
+      * allocated on the heap. Instead of a virtual base class, the any_sequence stores a pointer to the accessor of the
+      * concrete sequence, such that accessing the value calls the accessor directly on the stored object.
       */
     template <typename sequence_t>
     class any_sequence
@@ -66,30 +76,64 @@ namespace libjst
         using value_type = sequence_t;
 
     private:
-        class sequence_base
+        static constexpr std::size_t buffer_size = 4 * sizeof(void *);
+
+        union storage_type
         {
-        public:
-            constexpr sequence_base() = default;
-            virtual ~sequence_base() = default;
+            void * heap;
+            alignas(void *) std::byte buffer[buffer_size];
+        };
 
-            virtual sequence_t get() const = 0;
+        enum struct operation
+        {
+            move,
+            destroy
         };
 
+        using access_function_type = sequence_t (*)(storage_type const &);
+        using manage_function_type = void (*)(operation, storage_type &, storage_type &) noexcept;
+
+        template <typename concrete_sequence_t>
+        static constexpr bool is_stored_inline = sizeof(concrete_sequence_t) <= buffer_size &&
+                                                 alignof(concrete_sequence_t) <= alignof(storage_type) &&
+                                                 std::is_nothrow_move_constructible_v<concrete_sequence_t>;
+
         template <typename concrete_sequence_t>
-            requires std::convertible_to<concrete_sequence_t, sequence_t>
-        class sequence_impl final : public sequence_base
+        struct inline_dispatch
         {
-        private:
-            concrete_sequence_t _sequence{};
+            static concrete_sequence_t * get(storage_type & storage) noexcept
+            {
+                return std::launder(reinterpret_cast<concrete_sequence_t *>(storage.buffer));
+            }
 
-        public:
-            constexpr sequence_impl() = default;
-            constexpr sequence_impl(concrete_sequence_t sequence) : _sequence{std::move(sequence)} {}
-            virtual ~sequence_impl() = default;
+            static sequence_t access(storage_type const & storage)
+            {
+                return *std::launder(reinterpret_cast<concrete_sequence_t const *>(storage.buffer));
+            }
 
-            constexpr sequence_t get() const override
+            static void manage(operation op, storage_type & storage, storage_type & target) noexcept
             {
-                return _sequence;
+                if (op == operation::move)
+                    ::new (static_cast<void *>(target.buffer)) concrete_sequence_t{std::move(*get(storage))};
+
+                std::destroy_at(get(storage));
+            }
+        };
+
+        template <typename concrete_sequence_t>
+        struct heap_dispatch
+        {
+            static sequence_t access(storage_type const & storage)
+            {
+                return *static_cast<concrete_sequence_t const *>(storage.heap);
+            }
+
+            static void manage(operation op, storage_type & storage, storage_type & target) noexcept
+            {
+                if (op == operation::move)
+                    target.heap = storage.heap;
+                else
+                    delete static_cast<concrete_sequence_t *>(storage.heap);
             }
         };
     /// @}
@@ -97,7 +141,9 @@ namespace libjst
         /// @name Member variables
         /// @{
     private:
-        std::unique_ptr<sequence_base> _sequence_ptr{}; ///< The pointer to the underlying sequence.
+        storage_type _storage; ///< The storage of the underlying sequence.
+        access_function_type _access{}; ///< The accessor of the underlying sequence.
+        manage_function_type _manage{}; ///< The function to move or destroy the underlying sequence.
         /// @}
 
         /// @name Member functions
@@ -105,7 +151,8 @@ namespace libjst
     public:
 
         /// @brief The default constructor.
-        constexpr any_sequence() = default;
+        constexpr any_sequence() noexcept : _storage{nullptr}
+        {}
 
         /**
          * @brief Construct the any_sequence from a concrete sequence.
@@ -115,31 +162,62 @@ namespace libjst
          * @note The concrete sequence type must be convertible to `sequence_t`.
          */
         template <typename concrete_sequence_t>
-        constexpr any_sequence(concrete_sequence_t sequence)
-            noexcept(std::is_nothrow_move_constructible_v<concrete_sequence_t>) :
-            _sequence_ptr{std::make_unique<sequence_impl<concrete_sequence_t>>(std::move(sequence))}
-        {}
+            requires (!std::same_as<concrete_sequence_t, any_sequence> &&
+                      std::convertible_to<concrete_sequence_t, sequence_t>)
+        any_sequence(concrete_sequence_t sequence) noexcept(is_stored_inline<concrete_sequence_t>)
+        {
+            if constexpr (is_stored_inline<concrete_sequence_t>) {
+                ::new (static_cast<void *>(_storage.buffer)) concrete_sequence_t{std::move(sequence)};
+                _access = &inline_dispatch<concrete_sequence_t>::access;
+                _manage = &inline_dispatch<concrete_sequence_t>::manage;
+            } else {
+                _storage.heap = new concrete_sequence_t{std::move(sequence)};
+                _access = &heap_dispatch<concrete_sequence_t>::access;
+                _manage = &heap_dispatch<concrete_sequence_t>::manage;
+            }
+        }
+
+        any_sequence(any_sequence const &) = delete;
+        any_sequence(any_sequence && other) noexcept
+        {
+            steal(other);
+        }
+
+        any_sequence & operator=(any_sequence const &) = delete;
+        any_sequence & operator=(any_sequence && other) noexcept
+        {
+            if (this != &other) {
+                reset();
+                steal(other);
+            }
+            return *this;
+        }
+
+        ~any_sequence()
+        {
+            reset();
+        }
         /// @}
 
         /// @name Accessor
         /// @{
-        constexpr sequence_t value() const
+        sequence_t value() const
         {
             if (!has_value())
                 throw bad_sequence_access{};
 
-            return _sequence_ptr->get();
+            return _access(_storage);
         }
 
-        constexpr sequence_t operator*() const
+        sequence_t operator*() const
         {
             assert(has_value());
-            return _sequence_ptr->get();
+            return _access(_storage);
         }
 
         constexpr bool has_value() const noexcept
         {
-            return _sequence_ptr != nullptr;
+            return _access != nullptr;
         }
 
         constexpr explicit operator bool() const noexcept
@@ -148,6 +226,25 @@ namespace libjst
         }
         /// @}
 
+    private:
+
+        void steal(any_sequence & other) noexcept
+        {
+            if (other.has_value()) {
+                other._manage(operation::move, other._storage, _storage);
+                _access = std::exchange(other._access, nullptr);
+                _manage = std::exchange(other._manage, nullptr);
+            }
+        }
+
+        void reset() noexcept
+        {
+            if (has_value()) {
+                _manage(operation::destroy, _storage, _storage);
+                _access = nullptr;
+                _manage = nullptr;
+            }
+        }
     };
     /// @endcond
 }  //namespace libjst
@@ -0,0 +1,832 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides a journal implementation using a balanced tree with implicit positions to store the elements.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <libjst/reference_sequence/reference_sequence_concept.hpp>
+
+namespace libjst
+{
+
+    /**
+     * @class balanced_sequence_journal
+     * @brief A journal over non-overlapping segments with logarithmic edits and lookups.
+     * @tparam source_t The type of the source sequence. Must model libjst::preserving_reference_sequence.
+     * @tparam allocator_t The allocator of the records; defaults to std::allocator.
+     *
+     * The `balanced_sequence_journal` offers the same interface as the libjst::inline_sequence_journal and can be
+     * used as the journal of a libjst::journaled_sequence. The inline journal stores the records in a sorted vector
+     * and shifts the positions of all records behind an edit, such that recording all variants of a haplotype
+     * is quadratic in the number of variants.
+     *
+     * Instead, the records are stored in a treap whose nodes hold the total length of the segments in their subtree.
+     * The position of a record is thus implicit and computed while descending the tree, and an edit splits the tree
+     * at the low and the high end of the replaced interval and merges the remaining parts with the new record.
+     * Recording and looking up a record takes expected O(log n) time, and iterating over the records amortised
+     * constant time per record. The nodes are stored in a single vector and linked by their indices, such that
+     * copying a journal is a single allocation and erased nodes are reused by later edits.
+     *
+     * As for the inline journal, the journal always holds a sentinel record with an empty sequence behind the last
+     * record, and all iterators are invalidated by an edit.
+     */
+    template <libjst::preserving_reference_sequence source_t, typename allocator_t = std::allocator<std::byte>>
+    class balanced_sequence_journal
+    {
+    private:
+        class record_impl;
+
+        class breakend_impl;
+
+        template <bool>
+        class iterator_impl;
+
+        struct node_type;
+
+        ///@name Member types
+        ///@{
+    private:
+
+        /// @brief The type of the index of a node.
+        using node_index_type = std::size_t;
+        /// @brief The type of the pool holding the nodes of the tree.
+        using node_pool_type =
+            std::vector<node_type, typename std::allocator_traits<allocator_t>::template rebind_alloc<node_type>>;
+        /// @brief The type of the list of the erased nodes.
+        using free_list_type =
+            std::vector<node_index_type,
+                        typename std::allocator_traits<allocator_t>::template rebind_alloc<node_index_type>>;
+
+        static constexpr node_index_type nil{std::numeric_limits<node_index_type>::max()}; ///< The missing node.
+
+    public:
+        using source_type = source_t;  ///< The type of the source sequence.
+        using sequence_type = libjst::breakpoint_slice_t<source_t const>; ///< The type of the sequence obtained from the journal.
+        using breakend_type = breakend_impl; ///< The type of a breakend inside the journal.
+        using breakpoint_type = std::pair<breakend_type, breakend_type>; ///< The type of a breakpoint inside the journal.
+        using size_type = std::ranges::range_size_t<source_type>; ///< The type of the size of the journal.
+        using key_type = size_type; ///< The type of the key used to access the journal.
+        using iterator = iterator_impl<false>; ///< The type of the iterator to the journal.
+        using const_iterator = iterator_impl<true>; ///< The type of the iterator to an inmutable journal.
+        ///@}
+
+        /// @name Member Variables
+        /// @{
+    private:
+        source_type _source;  ///< The source sequence to which the journal is applied.
+        node_pool_type _nodes{}; ///< The nodes of the tree.
+        free_list_type _free_nodes{}; ///< The erased nodes, which are reused first.
+        node_index_type _root{nil}; ///< The root of the tree.
+        std::uint32_t _priority_state{0x9e3779b9u}; ///< The state of the generator of the node priorities.
+        /// @}
+
+        /// @name Member functions
+        /// @{
+    public:
+
+        /**
+         * @brief Initializes the journal with an empty source sequence.
+         *
+         * After construction the journal contains one entry that represents an empty sequence.
+         *
+         * @note The default constructor is only available if the source type is default constructible.
+         */
+        constexpr balanced_sequence_journal()
+            requires std::default_initializable<source_type>
+        {
+            initialize_journal();
+        }
+
+        /**
+         * @brief Initializes the journal with the given source sequence.
+         *
+         * After construction the journal contains one entry that covers the entire source sequence.
+         */
+        constexpr explicit balanced_sequence_journal(source_type source) : _source{std::move(source)}
+        {
+            initialize_journal();
+        }
+
+        /// @brief Returns the source sequence of the journal.
+        constexpr source_type const & source() const & noexcept
+        {
+            return _source;
+        }
+
+        /// @brief Returns the source sequence of the journal.
+        constexpr source_type source() && noexcept
+        {
+            return std::move(_source);
+        }
+        /// @}
+
+        /// @name Iterators
+        /// @{
+    public:
+        /// @brief Returns an iterator to the beginning of the journal.
+        iterator begin() noexcept
+        {
+            return iterator{this, leftmost(_root), 0};
+        }
+
+        /// @brief Returns a const iterator to the beginning of the journal.
+        const_iterator begin() const noexcept
+        {
+            return const_iterator{this, leftmost(_root), 0};
+        }
+
+        /// @brief Returns an iterator to the end of the journal, which points to the sentinel record.
+        iterator end() noexcept
+        {
+            return iterator{this, rightmost(_root), sequence_size()};
+        }
+
+        /// @brief Returns a const iterator to the end of the journal, which points to the sentinel record.
+        const_iterator end() const noexcept
+        {
+            return const_iterator{this, rightmost(_root), sequence_size()};
+        }
+        /// @}
+
+        /// @name Capacity
+        /// @{
+    public:
+        /// @brief Returns the number of records in the journal.
+        size_type size() const noexcept
+        {
+            return _nodes.size() - _free_nodes.size() - 1; // the sentinel is not counted.
+        }
+
+        /// @brief Returns the maximal number of records the journal can hold.
+        size_type max_size() const noexcept
+        {
+            return _nodes.max_size() - 1;
+        }
+
+        /// @brief Returns whether the journal is empty.
+        constexpr bool empty() const noexcept
+        {
+            return size() == 0;
+        }
+        /// @}
+
+        /// @name Modifiers
+        /// @{
+    public:
+        /// @brief Clears the journal.
+        void clear()
+        {
+            _nodes.clear();
+            _free_nodes.clear();
+            _root = nil;
+            initialize_journal();
+        }
+
+        /**
+         * @brief Records a new sequence in the journal at the given breakpoint.
+         *
+         * @param breakpoint The breakpoint in the journal at which to record the new sequence.
+         * @param sequence The sequence to record in the journal.
+         * @return An iterator to the recorded sequence, or to the record behind the breakpoint if the sequence is
+         *         empty.
+         *
+         * This function will overwrite the existing sequence at the given breakpoint with the new sequence in
+         * expected O(log n) time.
+         */
+        iterator record(breakpoint_type breakpoint, sequence_type sequence)
+        {
+            return record_at(static_cast<size_type>(libjst::low_breakend(breakpoint)),
+                             static_cast<size_type>(libjst::high_breakend(breakpoint)),
+                             std::move(sequence));
+        }
+
+        /**
+         * @brief Records a new sequence behind the begin of the last record.
+         *
+         * @param low The position of the first replaced symbol; must not be less than the position of the last record.
+         * @param high The position behind the last replaced symbol; must not be greater than the sequence size.
+         * @param sequence The sequence to record in the journal.
+         * @return An iterator to the recorded sequence, or to the record behind `high` if the sequence is empty.
+         *
+         * Offered for the interface of the libjst::inline_sequence_journal; the edit takes expected O(log n) time as
+         * for record().
+         */
+        iterator record_back(key_type const low, key_type const high, sequence_type sequence)
+        {
+            assert(empty() || std::ranges::prev(end())->position() <= low);
+            return record_at(low, high, std::move(sequence));
+        }
+        /// @}
+
+        /// @name Lookup
+        /// @{
+    public:
+        /// @brief Returns an iterator to the first element in the journal that is not less than the given key.
+        /// @param key The key to search for.
+        iterator lower_bound(key_type const key) noexcept
+        {
+            auto [node, position] = find_first(key, false);
+            return iterator{this, node, position};
+        }
+
+        /// @brief Returns an iterator to the first element in the journal that is not less than the given key.
+        /// @param key The key to search for.
+        const_iterator lower_bound(key_type const key) const noexcept
+        {
+            auto [node, position] = find_first(key, false);
+            return const_iterator{this, node, position};
+        }
+
+        /// @brief Returns an iterator to the first element in the journal that is greater than the given key.
+        /// @param key The key to search for.
+        iterator upper_bound(key_type const key) noexcept
+        {
+            auto [node, position] = find_first(key, true);
+            return iterator{this, node, position};
+        }
+
+        /// @brief Returns an iterator to the first element in the journal that is greater than the given key.
+        /// @param key The key to search for.
+        const_iterator upper_bound(key_type const key) const noexcept
+        {
+            auto [node, position] = find_first(key, true);
+            return const_iterator{this, node, position};
+        }
+
+        /// @brief Returns an iterator to the element in the journal that contains the given key.
+        /// @param key The key to search for.
+        iterator find(key_type const key) noexcept
+        {
+            return (key < sequence_size()) ? std::ranges::prev(upper_bound(key)) : end();
+        }
+
+        /// @brief Returns an iterator to the element in the journal that contains the given key.
+        /// @param key The key to search for.
+        const_iterator find(key_type const key) const noexcept
+        {
+            return (key < sequence_size()) ? std::ranges::prev(upper_bound(key)) : end();
+        }
+        /// @}
+
+        /// @name Utilities
+        /// @{
+    private:
+
+        /// @brief Replaces the symbols `[low, high)` with the given sequence.
+        iterator record_at(size_type const low, size_type const high, sequence_type sequence)
+        {
+            assert(low <= high);
+            assert(high <= sequence_size());
+
+            auto [prefix, remaining] = split(_root, low);
+            auto [replaced, suffix] = split(remaining, high - low);
+            release(replaced);
+
+            if (!std::ranges::empty(sequence))
+                prefix = merge(prefix, make_node(std::move(sequence)));
+
+            _root = merge(prefix, suffix);
+            _nodes[_root].parent = nil;
+
+            assert(check_journal_invariants());
+
+            return lower_bound(low);
+        }
+
+        /// @brief Returns the length of the represented sequence.
+        size_type sequence_size() const noexcept
+        {
+            return subtree_size(_root);
+        }
+
+        /// @brief Returns the total length of the segments in the subtree of the given node.
+        size_type subtree_size(node_index_type const node) const noexcept
+        {
+            return (node == nil) ? 0 : _nodes[node].subtree_size;
+        }
+
+        /// @brief Returns the record in the subtree of the given node with the smallest position.
+        node_index_type leftmost(node_index_type node) const noexcept
+        {
+            while (_nodes[node].left != nil)
+                node = _nodes[node].left;
+            return node;
+        }
+
+        /// @brief Returns the record in the subtree of the given node with the largest position.
+        node_index_type rightmost(node_index_type node) const noexcept
+        {
+            while (_nodes[node].right != nil)
+                node = _nodes[node].right;
+            return node;
+        }
+
+        /// @brief Returns the record following the given one.
+        node_index_type successor(node_index_type node) const noexcept
+        {
+            if (_nodes[node].right != nil)
+                return leftmost(_nodes[node].right);
+
+            node_index_type parent = _nodes[node].parent;
+            while (parent != nil && _nodes[parent].right == node) {
+                node = parent;
+                parent = _nodes[node].parent;
+            }
+            return parent;
+        }
+
+        /// @brief Returns the record preceding the given one.
+        node_index_type predecessor(node_index_type node) const noexcept
+        {
+            if (_nodes[node].left != nil)
+                return rightmost(_nodes[node].left);
+
+            node_index_type parent = _nodes[node].parent;
+            while (parent != nil && _nodes[parent].left == node) {
+                node = parent;
+                parent = _nodes[node].parent;
+            }
+            return parent;
+        }
+
+        /**
+         * @brief Returns the first record whose position is not less, or greater if `strict` is set, than the key.
+         *
+         * @returns A pair of the found node and its position; the sentinel if no other record qualifies.
+         */
+        std::pair<node_index_type, size_type> find_first(key_type const key, bool const strict) const noexcept
+        {
+            std::pair<node_index_type, size_type> found{rightmost(_root), sequence_size()};
+            size_type offset{};
+            for (node_index_type node = _root; node != nil;) {
+                node_type const & current = _nodes[node];
+                size_type const position = offset + subtree_size(current.left);
+                if (strict ? (position > key) : (position >= key)) {
+                    found = {node, position};
+                    node = current.left;
+                } else {
+                    offset = position + std::ranges::size(current.sequence);
+                    node = current.right;
+                }
+            }
+            return found;
+        }
+
+        /// @brief Recomputes the subtree size of the given node and links its children to it.
+        void update(node_index_type const node) noexcept
+        {
+            node_type & current = _nodes[node];
+            current.subtree_size = subtree_size(current.left) + std::ranges::size(current.sequence) +
+                                   subtree_size(current.right);
+            if (current.left != nil)
+                _nodes[current.left].parent = node;
+            if (current.right != nil)
+                _nodes[current.right].parent = node;
+        }
+
+        /**
+         * @brief Splits the subtree of the given node after the given number of symbols.
+         *
+         * @returns A pair of the subtrees, where the first one represents the first `count` symbols and the second
+         *          one the remaining symbols. A record covering the split position is split into two records.
+         */
+        std::pair<node_index_type, node_index_type> split(node_index_type const node, size_type const count)
+        {
+            if (node == nil)
+                return {nil, nil};
+
+            size_type const left_size = subtree_size(_nodes[node].left);
+            if (count <= left_size) { // empty records at the split position, i.e. the sentinel, go to the right.
+                auto [left, right] = split(_nodes[node].left, count);
+                _nodes[node].left = right;
+                update(node);
+                return {left, node};
+            }
+
+            auto segment = _nodes[node].sequence;
+            size_type const segment_size = std::ranges::size(segment);
+            if (count >= left_size + segment_size) {
+                auto [left, right] = split(_nodes[node].right, count - left_size - segment_size);
+                _nodes[node].right = left;
+                update(node);
+                return {node, right};
+            }
+
+            // Splits the record of the node, whose prefix remains in the node.
+            auto split_it = std::ranges::next(std::ranges::begin(segment), count - left_size);
+            auto suffix = make_node(get_breakpoint_slice(segment, split_it, std::ranges::end(segment)));
+            _nodes[node].sequence = get_breakpoint_slice(segment, std::ranges::begin(segment), split_it);
+            node_index_type const right = _nodes[node].right;
+            _nodes[node].right = nil;
+            update(node);
+            return {node, merge(suffix, right)};
+        }
+
+        /// @brief Merges the two subtrees, where all records of the left one precede the ones of the right one.
+        node_index_type merge(node_index_type const left, node_index_type const right) noexcept
+        {
+            if (left == nil)
+                return right;
+            if (right == nil)
+                return left;
+
+            if (_nodes[left].priority > _nodes[right].priority) {
+                _nodes[left].right = merge(_nodes[left].right, right);
+                update(left);
+                return left;
+            } else {
+                _nodes[right].left = merge(left, _nodes[right].left);
+                update(right);
+                return right;
+            }
+        }
+
+        /// @brief Returns a new single node tree holding the given sequence.
+        node_index_type make_node(sequence_type sequence)
+        {
+            _priority_state ^= _priority_state << 13;
+            _priority_state ^= _priority_state >> 17;
+            _priority_state ^= _priority_state << 5;
+
+            node_type node{.sequence = std::move(sequence), .priority = _priority_state};
+            node.subtree_size = std::ranges::size(node.sequence);
+            if (_free_nodes.empty()) {
+                _nodes.push_back(std::move(node));
+                return _nodes.size() - 1;
+            }
+
+            node_index_type const index = _free_nodes.back();
+            _free_nodes.pop_back();
+            _nodes[index] = std::move(node);
+            return index;
+        }
+
+        /// @brief Releases all nodes of the given subtree for reuse.
+        void release(node_index_type const node)
+        {
+            if (node == nil)
+                return;
+
+            release(_nodes[node].left);
+            release(_nodes[node].right);
+            _nodes[node] = node_type{};
+            _free_nodes.push_back(node);
+        }
+
+        /// @brief Returns the breakpoint slice of the segment between the two iterators.
+        template <typename sequence_t>
+        constexpr static auto get_breakpoint_slice(sequence_t && segment,
+                                                   std::ranges::iterator_t<sequence_t> from,
+                                                   std::ranges::iterator_t<sequence_t> to)
+        {
+            auto breakpoint = libjst::to_breakpoint(segment, std::move(from), std::move(to));
+            return libjst::breakpoint_slice(segment, std::move(breakpoint));
+        }
+
+        /**
+         * @brief Sanity check for the journal.
+         *
+         * @returns `true` if the journal invariants are valid, `false` otherwise.
+         */
+        bool check_journal_invariants() const noexcept {
+            // 1. check if only the sentinel record is empty and it is the last record
+            // 2. check if all adjacent records are non-overlapping such that end position of smaller record is equal to begin position of successor
+            if (_root == nil || _nodes[_root].parent != nil)
+                return false;
+
+            size_type position{};
+            for (auto it = begin(); it != end(); ++it) {
+                if (it->position() != position || std::ranges::empty(it->sequence()))
+                    return false;
+                position += std::ranges::size(it->sequence());
+            }
+            return position == sequence_size() && std::ranges::empty(end()->sequence());
+        }
+
+        /**
+         * @brief Initializes the underlying tree.
+         *
+         * If the source is not empty, the first record in the journal will be a breakpoint slice of the source
+         * sequence. Additionally, a sentinel record is added representing an empty sequence.
+         */
+        void initialize_journal()
+        {
+            _root = make_node(sequence_type{});
+            if (!std::ranges::empty(source())) {
+                auto src_bpt = libjst::to_breakpoint(source(), std::ranges::begin(source()), std::ranges::end(source()));
+                _root = merge(make_node(libjst::breakpoint_slice(source(), std::move(src_bpt))), _root);
+            }
+            _nodes[_root].parent = nil;
+        }
+        /// @}
+    };
+
+    template <libjst::preserving_reference_sequence source_t, typename allocator_t>
+    struct balanced_sequence_journal<source_t, allocator_t>::node_type
+    {
+        sequence_type sequence{}; ///< The segment of the record.
+        std::uint32_t priority{}; ///< The heap priority of the node.
+        size_type subtree_size{}; ///< The total length of the segments in the subtree.
+        node_index_type left{nil}; ///< The left child.
+        node_index_type right{nil}; ///< The right child.
+        node_index_type parent{nil}; ///< The parent.
+    };
+
+    template <libjst::preserving_reference_sequence source_t, typename allocator_t>
+    class balanced_sequence_journal<source_t, allocator_t>::record_impl
+    {
+        ///@name Public member types
+        ///@{
+    public:
+        using size_type = balanced_sequence_journal::size_type; ///< The type of the record position.
+        using sequence_type = balanced_sequence_journal::sequence_type; ///< The type of the record sequence.
+        ///@}
+
+        /** @name Member variables */
+        ///@{
+    private:
+        size_type _position{}; ///< The begin position of the referenced segment in the journaled sequence.
+        sequence_type _sequence{}; ///< The referenced segment in the journaled sequence.
+        ///@}
+
+        ///@name Constructors, assignment and destructor */
+        ///@{
+    public:
+        /// @brief Default constructor.
+        constexpr record_impl()
+            requires std::default_initializable<sequence_type>
+        = default;
+
+        /// @brief Constructs a journal entry from a position and a sequence.
+        constexpr record_impl(size_type position, sequence_type sequence) :
+            _position{position},
+            _sequence{std::move(sequence)}
+        {
+        }
+        ///@}
+
+        /** @name Accessors */
+        ///@{
+    public:
+        /// @brief Returns the begin position of the referenced segment in the journaled sequence.
+        constexpr size_type position() const noexcept
+        {
+            return _position;
+        }
+
+        /// @brief Returns the represented sequence slice.
+        constexpr sequence_type sequence() const noexcept(std::is_nothrow_copy_constructible_v<sequence_type>)
+        {
+            return _sequence;
+        }
+        ///@}
+
+        /// @name Non-member functions
+        /// @{
+    public:
+        /// @brief Returns whether both entries refer to the same segment at the same position.
+        constexpr friend bool operator==(record_impl const &lhs, record_impl const &rhs) noexcept
+        {
+            return lhs.position() == rhs.position() &&
+                   std::ranges::begin(lhs.sequence()) == std::ranges::begin(rhs.sequence()) &&
+                   std::ranges::size(lhs.sequence()) == std::ranges::size(rhs.sequence());
+        }
+
+        /// @brief Compares the begin positions of the journal entries.
+        constexpr friend std::weak_ordering operator<=>(record_impl const &lhs, record_impl const &rhs) noexcept
+        {
+            return lhs.position() <=> rhs.position();
+        }
+        ///@}
+    };
+
+    /**
+     * @brief The bidirectional iterator over the records of a libjst::balanced_sequence_journal.
+     *
+     * The iterator caches the position of the pointed-to record and dereferences to a record by value.
+     */
+    template <libjst::preserving_reference_sequence source_t, typename allocator_t>
+    template <bool is_const>
+    class balanced_sequence_journal<source_t, allocator_t>::iterator_impl
+    {
+        friend balanced_sequence_journal;
+
+        template <bool>
+        friend class iterator_impl;
+
+        /// @name Member types
+        /// @{
+    private:
+        using maybe_const_journal_type = std::conditional_t<is_const,
+                                                            balanced_sequence_journal const,
+                                                            balanced_sequence_journal>;
+
+        /// @brief Holds the dereferenced record to give access to its members.
+        struct arrow_proxy
+        {
+            record_impl record;
+
+            constexpr record_impl const * operator->() const noexcept
+            {
+                return std::addressof(record);
+            }
+        };
+
+    public:
+        using value_type = record_impl;
+        using reference = record_impl;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using iterator_category = std::input_iterator_tag;
+        using iterator_concept = std::bidirectional_iterator_tag;
+        /// @}
+
+        /// @name Member variables
+        /// @{
+    private:
+        maybe_const_journal_type * _journal{}; ///< The iterated journal.
+        node_index_type _node{nil}; ///< The node of the current record.
+        size_type _position{}; ///< The position of the current record.
+        /// @}
+
+        /// @name Member functions
+        /// @{
+    private:
+        constexpr iterator_impl(maybe_const_journal_type * journal,
+                                node_index_type const node,
+                                size_type const position) noexcept :
+            _journal{journal},
+            _node{node},
+            _position{position}
+        {
+        }
+
+    public:
+        /// @brief Default constructor.
+        constexpr iterator_impl() = default;
+
+        /// @brief Converts a mutable iterator into a const iterator.
+        constexpr iterator_impl(iterator_impl<!is_const> other) noexcept requires is_const :
+            _journal{other._journal},
+            _node{other._node},
+            _position{other._position}
+        {
+        }
+
+        /// @brief Returns the current record.
+        constexpr reference operator*() const noexcept
+        {
+            return record_impl{_position, _journal->_nodes[_node].sequence};
+        }
+
+        /// @brief Gives access to the members of the current record.
+        constexpr arrow_proxy operator->() const noexcept
+        {
+            return arrow_proxy{**this};
+        }
+
+        /// @brief Advances to the next record.
+        constexpr iterator_impl & operator++() noexcept
+        {
+            _position += std::ranges::size(_journal->_nodes[_node].sequence);
+            _node = _journal->successor(_node);
+            return *this;
+        }
+
+        /// @brief Advances to the next record.
+        constexpr iterator_impl operator++(int) noexcept
+        {
+            iterator_impl tmp{*this};
+            ++(*this);
+            return tmp;
+        }
+
+        /// @brief Goes back to the previous record.
+        constexpr iterator_impl & operator--() noexcept
+        {
+            _node = _journal->predecessor(_node);
+            _position -= std::ranges::size(_journal->_nodes[_node].sequence);
+            return *this;
+        }
+
+        /// @brief Goes back to the previous record.
+        constexpr iterator_impl operator--(int) noexcept
+        {
+            iterator_impl tmp{*this};
+            --(*this);
+            return tmp;
+        }
+
+        /// @brief Returns whether both iterators point to the same record.
+        constexpr friend bool operator==(iterator_impl const & lhs, iterator_impl const & rhs) noexcept
+        {
+            return lhs._node == rhs._node;
+        }
+        /// @}
+    };
+
+    template <libjst::preserving_reference_sequence source_t, typename allocator_t>
+    class balanced_sequence_journal<source_t, allocator_t>::breakend_impl
+    {
+        /// @name Member types
+        /// @{
+    private:
+        using sequence_iterator = std::ranges::iterator_t<sequence_type const>; ///< The iterator type of the sequence.
+        /// @}
+
+        /// @name Member variables
+        /// @{
+    private:
+        const_iterator _journal_it{}; ///< The iterator to the journal entry.
+        sequence_iterator _sequence_it{}; ///< The iterator to the sequence entry.
+        /// @}
+
+        /// @name Member functions
+        /// @{
+    public:
+
+        /// @brief Default constructor.
+        constexpr breakend_impl() = default;
+
+        /**
+         * @brief Constructs a breakend from the given journal and sequence iterators.
+         *
+         * @param journal_it The iterator to the journal entry.
+         * @param sequence_it The iterator to the sequence entry.
+         */
+        constexpr explicit breakend_impl(const_iterator journal_it, sequence_iterator sequence_it)
+            noexcept(std::is_nothrow_move_constructible_v<sequence_iterator>) :
+            _journal_it{std::move(journal_it)},
+            _sequence_it{std::move(sequence_it)}
+        {
+        }
+
+        /// @brief Returns the underlying journal and sequence iterators as a pair.
+        constexpr std::pair<const_iterator, sequence_iterator> base() const &
+            noexcept(std::is_nothrow_copy_constructible_v<sequence_iterator>)
+        {
+            return {_journal_it, _sequence_it};
+        }
+
+        /// @brief Returns the underlying journal and sequence iterators as a pair.
+        constexpr std::pair<const_iterator, sequence_iterator> base() && noexcept
+        {
+            return {std::move(_journal_it), std::move(_sequence_it)};
+        }
+        /// @}
+
+        /// @name Conversion
+        /// @{
+    public:
+        /// @brief Converts the breakend to a global position inside of the concatenated view of all records.
+        template <std::integral integral_t>
+        constexpr operator integral_t() const noexcept
+        {
+            return _journal_it->position() +
+                   std::ranges::distance(std::ranges::begin(_journal_it->sequence()), _sequence_it);
+        }
+        /// @}
+
+        /// @name Non-member functions
+        /// @{
+    public:
+        /// @brief Returns the distance between two breakends.
+        constexpr friend std::ptrdiff_t operator-(breakend_impl const & lhs, breakend_impl const & rhs) noexcept
+        {
+            return static_cast<std::ptrdiff_t>(lhs) - static_cast<std::ptrdiff_t>(rhs);
+        }
+
+        /// @brief Returns whether both breakends refer to the same position.
+        constexpr friend bool operator==(breakend_impl const & lhs, breakend_impl const & rhs) noexcept
+        {
+            return lhs._journal_it == rhs._journal_it && lhs._sequence_it == rhs._sequence_it;
+        }
+
+        /// @brief Compares the positions of both breakends.
+        constexpr friend std::strong_ordering operator<=>(breakend_impl const & lhs, breakend_impl const & rhs) noexcept
+        {
+            return static_cast<std::ptrdiff_t>(lhs) <=> static_cast<std::ptrdiff_t>(rhs);
+        }
+        /// @}
+    };
+
+}  // namespace libjst
@@ -13,8 +13,11 @@
 
 #pragma once
 
+#include <algorithm>
 #include <functional>
-#include <set>
+#include <ranges>
+#include <tuple>
+#include <vector>
 
 #include <libjst/journal/any_sequence.hpp>
 #include <libjst/journal/breakpoint_multijournal_sequence_tree_adapter.hpp>
@@ -29,9 +32,16 @@ namespace libjst
      * This class is experimental and is removed from the public API.
      */
     /**
-     * @brief A journal implementation that stores multiple segments in a multimap.
+     * @brief A journal implementation that stores multiple segments in a sorted vector.
      *
      * @tparam source_t The type of the source sequence. Must model libjst::reference_sequence.
+     *
+     * The records are kept in a contiguous buffer sorted by their breakpoints, such that the lookup is a binary search
+     * and iterating the records, e.g. by the libjst::breakpoint_multijournal_sequence_tree_adapter, scans contiguous
+     * memory. Records inserted with the same breakpoint as existing records are placed behind them, as in a
+     * std::multiset. Recording an edit invalidates all iterators; appending records in ascending order takes amortised
+     * constant time and the bulk constructor sorts unsorted input once.
+     *
      * @warning This is experimental and may change in the future.
      */
     template <libjst::reference_sequence source_t>
@@ -42,7 +52,7 @@ namespace libjst
     private:
         class record_impl;
 
-        using breakpoint_map_type = std::multiset<record_impl, std::less<void>>;
+        using breakpoint_map_type = std::vector<record_impl>;
     public:
         using source_type = source_t;
         using sequence_type = libjst::breakpoint_slice_t<source_type const>;
@@ -71,6 +81,32 @@ namespace libjst
         {
         }
 
+        /**
+         * @brief Constructs the journal from a range of records.
+         *
+         * @param source The source sequence.
+         * @param records A range over pairs of a breakpoint and the sequence recorded for it.
+         *
+         * Records with the same breakpoint keep their relative order, such that the journal equals the one obtained
+         * by recording the records one by one. If the records are already sorted, the construction is linear.
+         */
+        template <std::ranges::input_range records_t>
+            requires std::constructible_from<breakpoint_type,
+                                             std::tuple_element_t<0, std::ranges::range_value_t<records_t>>>
+        constexpr breakpoint_multijournal(source_type source, records_t && records)
+            : _source{std::move(source)}
+        {
+            if constexpr (std::ranges::sized_range<records_t>)
+                _breakpoint_map.reserve(std::ranges::size(records));
+
+            for (auto && record : records)
+                _breakpoint_map.emplace_back(std::get<0>(std::forward<decltype(record)>(record)),
+                                             std::get<1>(std::forward<decltype(record)>(record)));
+
+            if (!std::ranges::is_sorted(_breakpoint_map, std::less<void>{}))
+                std::ranges::stable_sort(_breakpoint_map, std::less<void>{});
+        }
+
         constexpr source_type const & source() const & noexcept
         {
             return _source;
@@ -105,7 +141,19 @@ namespace libjst
             requires std::convertible_to<concrete_sequence_t, sequence_type>
         constexpr iterator record(breakpoint_type breakpoint, concrete_sequence_t && sequence)
         {
-            return _breakpoint_map.emplace(std::move(breakpoint), std::forward<concrete_sequence_t>(sequence));
+            record_impl new_record{std::move(breakpoint), std::forward<concrete_sequence_t>(sequence)};
+            if (_breakpoint_map.empty() || !(new_record < _breakpoint_map.back())) {
+                _breakpoint_map.push_back(std::move(new_record));
+                return std::ranges::prev(_breakpoint_map.end());
+            }
+
+            auto position = std::ranges::upper_bound(_breakpoint_map, new_record, std::less<void>{});
+            return _breakpoint_map.insert(position, std::move(new_record));
+        }
+
+        constexpr void reserve(size_t const new_capacity)
+        {
+            _breakpoint_map.reserve(new_capacity);
         }
         /// @}
 
@@ -137,7 +185,8 @@ namespace libjst
             constexpr iterator lower_bound(breakend_t const & breakend) const & noexcept
             {
                 using low_breakend_type = std::remove_cvref_t<libjst::low_breakend_t<breakpoint_type>>;
-                return _breakpoint_map.lower_bound(static_cast<low_breakend_type const &>(breakend));
+                return std::ranges::lower_bound(_breakpoint_map, static_cast<low_breakend_type const &>(breakend),
+                                                std::less<void>{});
             }
 
             template <typename breakend_t>
@@ -145,7 +194,8 @@ namespace libjst
             constexpr iterator upper_bound(breakend_t const & breakend) const & noexcept
             {
                 using low_breakend_type = std::remove_cvref_t<libjst::low_breakend_t<breakpoint_type>>;
-                return _breakpoint_map.upper_bound(static_cast<low_breakend_type const &>(breakend));
+                return std::ranges::upper_bound(_breakpoint_map, static_cast<low_breakend_type const &>(breakend),
+                                                std::less<void>{});
             }
         /// @}
 
@@ -13,8 +13,18 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
 #include <libjst/journal/breakpoint_multijournal.hpp>
 #include <libjst/coverage/int_coverage.hpp>
+#include <libjst/coverage/int_coverage_view.hpp>
 
 namespace libjst
 {
@@ -23,6 +33,19 @@ namespace libjst
      * @cond
      * This class is experimental and is removed from the public API.
      */
+    /**
+     * @brief A breakpoint multijournal whose records are associated with the coverage of the recorded sequence.
+     *
+     * @tparam source_t The type of the source sequence. Must model libjst::reference_sequence.
+     *
+     * The ids of all coverages are stored in one contiguous pool, in which every record references the ids of its
+     * coverage by an index, instead of allocating a coverage per record. The records expose their coverage as a
+     * libjst::int_coverage_view into the pool. Coverages recorded in ascending order of their records, e.g. by the bulk
+     * constructor, are stored in the order of the records, such that iterating the journal streams through the pool.
+     * All coverages must share the coverage domain of the first recorded coverage.
+     *
+     * @warning This is experimental and may change in the future.
+     */
     template <libjst::reference_sequence source_t>
     class coverage_augmented_breakpoint_multijournal
     {
@@ -41,10 +64,12 @@ namespace libjst
         using sequence_type = typename base_journal_t::sequence_type;
         using breakpoint_type = typename base_journal_t::breakpoint_type;
         using coverage_type = int_coverage<uint32_t>;
+        using coverage_view_type = int_coverage_view<uint32_t>;
         using iterator = iterator_impl<true>;
 
     private:
-        using coverages_type = std::vector<coverage_type>;
+        using coverage_domain_type = libjst::coverage_domain_t<coverage_type>;
+        using coverage_ids_type = std::vector<size_t>;
         ///@}
 
         /// @name Member variables
@@ -52,7 +77,10 @@ namespace libjst
     private:
 
         base_journal_t _journal{};
-        coverages_type _coverages{};
+        coverage_ids_type _coverage_ids{}; // The index of the coverage of every record in the pool.
+        std::vector<uint32_t> _pool_ids{}; // The ids of all coverages in the pool.
+        std::vector<size_t> _pool_offsets{size_t{0}}; // The first id of every coverage in the pool and the id count.
+        coverage_domain_type _domain{};
         /// @}
 
         /// @name Member functions
@@ -67,6 +95,52 @@ namespace libjst
         {
         }
 
+        /**
+         * @brief Constructs the journal from a range of records.
+         *
+         * @param source The source sequence.
+         * @param records A range over tuples of a breakpoint, the sequence recorded for it and its coverage.
+         *
+         * The records are sorted once as by the bulk constructor of the libjst::breakpoint_multijournal, and their
+         * coverages are appended to the pool in the sorted order. Throws std::domain_error if the coverage domains
+         * of the records differ.
+         */
+        template <std::ranges::input_range records_t>
+            requires std::constructible_from<breakpoint_type,
+                                             std::tuple_element_t<0, std::ranges::range_value_t<records_t>>> &&
+                     std::convertible_to<std::tuple_element_t<2, std::ranges::range_value_t<records_t>>,
+                                         coverage_type const &>
+        constexpr coverage_augmented_breakpoint_multijournal(source_type source, records_t && records)
+        {
+            using record_t = std::ranges::range_value_t<records_t>;
+            std::vector<record_t> buffer{};
+            if constexpr (std::ranges::sized_range<records_t>)
+                buffer.reserve(std::ranges::size(records));
+            for (auto && record : records)
+                buffer.emplace_back(std::forward<decltype(record)>(record));
+
+            // Sorts stably by the breakpoints and then by the equivalence rank of the records, see record_impl.
+            auto rank = [&] (size_t const idx) {
+                breakpoint_type const breakpoint{std::get<0>(buffer[idx])};
+                return std::pair{breakpoint, static_cast<std::ptrdiff_t>(libjst::breakend_span(breakpoint)) -
+                                             std::ranges::ssize(std::get<1>(buffer[idx]))};
+            };
+            std::vector<size_t> order(buffer.size());
+            std::iota(order.begin(), order.end(), 0);
+            std::ranges::stable_sort(order, std::less<void>{}, rank);
+
+            _coverage_ids.reserve(buffer.size());
+            _pool_offsets.reserve(buffer.size() + 1);
+            for (size_t const idx : order)
+                _coverage_ids.push_back(append_coverage(std::get<2>(buffer[idx])));
+
+            using sequence_t = std::tuple_element_t<1, record_t>;
+            _journal = base_journal_t{std::move(source), order | std::views::transform([&] (size_t const idx) {
+                return std::tuple<breakpoint_type, sequence_t const &>{std::get<0>(buffer[idx]),
+                                                                        std::get<1>(buffer[idx])};
+            })};
+        }
+
         constexpr source_type const & source() const & noexcept(noexcept(_journal.source()))
         {
             return _journal.source();
@@ -84,12 +158,12 @@ namespace libjst
 
         constexpr iterator begin() const noexcept
         {
-            return iterator{_journal.begin(), _coverages.begin()};
+            return iterator{this, _journal.begin(), _coverage_ids.begin()};
         }
 
         constexpr iterator end() const noexcept
         {
-            return iterator{_journal.end(), _coverages.end()};
+            return iterator{this, _journal.end(), _coverage_ids.end()};
         }
         /// @}
 
@@ -97,19 +171,67 @@ namespace libjst
         /// @{
     public:
 
+        /**
+         * @brief Records the sequence with its coverage.
+         *
+         * The ids of the coverage are appended to the pool. Throws std::domain_error if the coverage domain differs
+         * from the domain of the coverages recorded before.
+         */
         template <typename concrete_sequence_t>
             requires std::convertible_to<concrete_sequence_t, sequence_type>
         constexpr iterator record(breakpoint_type breakpoint,
                                   concrete_sequence_t && sequence,
-                                  coverage_type coverage)
+                                  coverage_type const & coverage)
         {
-            // TODO: check if coverage is valid in the sense that it is from the same domain?
-            // but how can we ensure this -> by wrapping it and not storing the domain information inside of a coverage object.
-            _coverages.reserve(_coverages.size() + 1);
+            _coverage_ids.reserve(_coverage_ids.size() + 1);
+            size_t const coverage_id = append_coverage(coverage);
             auto it = _journal.record(std::move(breakpoint), std::forward<concrete_sequence_t>(sequence));
-            auto cov_it = _coverages.insert(std::next(_coverages.begin(), std::distance(_journal.begin(), it)),
-                                            std::move(coverage));
-            return iterator{std::move(it), std::move(cov_it)};
+            auto cov_it = _coverage_ids.insert(std::next(_coverage_ids.begin(), std::distance(_journal.begin(), it)),
+                                               coverage_id);
+            return iterator{this, std::move(it), std::move(cov_it)};
+        }
+        /// @}
+
+        /// @name Coverage pool
+        /// @{
+    public:
+
+        /// @brief Returns the domain shared by all coverages of the journal.
+        constexpr coverage_domain_type const & coverage_domain() const noexcept
+        {
+            return _domain;
+        }
+
+        /// @brief Returns the number of bytes occupied by the pooled coverages.
+        constexpr size_t coverage_memory_usage() const noexcept
+        {
+            return _coverage_ids.size() * sizeof(size_t) + _pool_ids.size() * sizeof(uint32_t) +
+                   _pool_offsets.size() * sizeof(size_t);
+        }
+        /// @}
+
+        /// @name Utilities
+        /// @{
+    private:
+
+        constexpr size_t append_coverage(coverage_type const & coverage)
+        {
+            if (_pool_offsets.size() == 1)
+                _domain = coverage.get_domain();
+            else if (coverage.get_domain() != _domain)
+                throw std::domain_error{"Trying to record a coverage from a different coverage domain!"};
+
+            _pool_ids.insert(_pool_ids.end(), coverage.begin(), coverage.end());
+            _pool_offsets.push_back(_pool_ids.size());
+            return _pool_offsets.size() - 2;
+        }
+
+        constexpr coverage_view_type coverage_at(size_t const coverage_id) const noexcept
+        {
+            std::span<uint32_t const> ids{_pool_ids};
+            return coverage_view_type{ids.subspan(_pool_offsets[coverage_id],
+                                                  _pool_offsets[coverage_id + 1] - _pool_offsets[coverage_id]),
+                                      _domain};
         }
         /// @}
 
@@ -163,7 +285,7 @@ namespace libjst
             return _record.sequence();
         }
 
-        constexpr coverage_type coverage() const noexcept
+        constexpr coverage_t coverage() const noexcept
         {
             return _coverage;
         }
@@ -212,13 +334,13 @@ namespace libjst
         template <typename t>
         using maybe_const_t = std::conditional_t<is_const, t const, t>;
 
+        using host_t = maybe_const_t<coverage_augmented_breakpoint_multijournal>;
         using journal_iterator = std::ranges::iterator_t<maybe_const_t<base_journal_t>>;
-        using coverages_iterator = std::ranges::iterator_t<maybe_const_t<coverages_type>>;
+        using coverage_ids_iterator = std::ranges::iterator_t<maybe_const_t<coverage_ids_type>>;
         using base_record_t = std::iter_reference_t<journal_iterator>;
-        using coverage_t = std::iter_reference_t<coverages_iterator>;
     public:
 
-        using value_type = record_impl<base_record_t, coverage_t>;
+        using value_type = record_impl<base_record_t, coverage_view_type>;
         using reference = value_type;
         using pointer = void;
         using difference_type = std::iter_difference_t<journal_iterator>;
@@ -228,18 +350,21 @@ namespace libjst
         /// @name Member variables
         /// @{
     private:
+        host_t * _host{};
         journal_iterator _journal_it{};
-        coverages_iterator _coverages_it{};
+        coverage_ids_iterator _coverage_ids_it{};
         /// @}
 
         /// @name Member functions
         /// @{
     private:
 
-        constexpr explicit iterator_impl(journal_iterator journal_it, coverages_iterator coverages_it)
+        constexpr explicit iterator_impl(host_t * host,
+                                         journal_iterator journal_it,
+                                         coverage_ids_iterator coverage_ids_it)
             noexcept(std::is_nothrow_move_constructible_v<journal_iterator> &&
-                     std::is_nothrow_move_constructible_v<coverages_iterator>)
-            : _journal_it{std::move(journal_it)}, _coverages_it{std::move(coverages_it)}
+                     std::is_nothrow_move_constructible_v<coverage_ids_iterator>)
+            : _host{host}, _journal_it{std::move(journal_it)}, _coverage_ids_it{std::move(coverage_ids_it)}
         {}
     public:
 
@@ -248,12 +373,14 @@ namespace libjst
         template <bool other_const>
         constexpr iterator_impl(iterator_impl<other_const> other)
             requires (is_const && !other_const)
-            : _journal_it{std::move(other._journal_it)}, _coverages_it{std::move(other._coverages_it)}
+            : _host{other._host},
+              _journal_it{std::move(other._journal_it)},
+              _coverage_ids_it{std::move(other._coverage_ids_it)}
         {}
 
         constexpr reference operator*() const noexcept
         {
-            return {*_journal_it, *_coverages_it};
+            return {*_journal_it, _host->coverage_at(*_coverage_ids_it)};
         }
         /// @}
 
@@ -262,7 +389,7 @@ namespace libjst
         constexpr iterator_impl & operator++() noexcept
         {
             ++_journal_it;
-            ++_coverages_it;
+            ++_coverage_ids_it;
             return *this;
         }
 
@@ -276,7 +403,7 @@ namespace libjst
         constexpr iterator_impl & operator--() noexcept
         {
             --_journal_it;
-            --_coverages_it;
+            --_coverage_ids_it;
             return *this;
         }
 
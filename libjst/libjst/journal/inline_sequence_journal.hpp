@@ -13,7 +13,10 @@
 #pragma once
 
 #include <algorithm>
+#include <cassert>
+#include <cstddef>
 #include <iterator>
+#include <memory>
 #include <vector>
 #include <ranges>
 #include <type_traits>
@@ -28,6 +31,7 @@ namespace libjst
      * @class inline_sequence_journal
      * @brief Represents a dictionary over non-overlapping segments that, when concatenated, form a new sequence.
      * @tparam source_t The type of the source sequence. Must model libjst::preserving_reference_sequence.
+     * @tparam allocator_t The allocator of the records; defaults to std::allocator.
      *
      * The `inline_sequence_journal` class is designed to manage and manipulate sequences by dividing them into
      * non-overlapping segments whose type is determined by the type trait libjst::breakpoint_slice_t.
@@ -48,7 +52,7 @@ namespace libjst
      * The libjst::journaled_sequence is a wrapper around the libjst::inline_sequence_journal that provides a natural
      * sequence interface.
      */
-    template <libjst::preserving_reference_sequence source_t>
+    template <libjst::preserving_reference_sequence source_t, typename allocator_t = std::allocator<std::byte>>
     class inline_sequence_journal
     {
     private:
@@ -61,7 +65,8 @@ namespace libjst
     private:
 
         /// @brief The type of the underlying journal to hold the records.
-        using journal_type = std::vector<record_impl>;
+        using journal_type =
+            std::vector<record_impl, typename std::allocator_traits<allocator_t>::template rebind_alloc<record_impl>>;
 
     public:
         using source_type = source_t;  ///< The type of the source sequence.
@@ -212,6 +217,55 @@ namespace libjst
         {
             return record_inline(std::move(breakpoint), std::move(sequence));
         }
+
+        /**
+         * @brief Records a new sequence behind the begin of the last record in amortised constant time.
+         *
+         * @param low The position of the first replaced symbol; must not be less than the position of the last record.
+         * @param high The position behind the last replaced symbol; must not be greater than the sequence size.
+         * @param sequence The sequence to record in the journal.
+         * @return An iterator to the recorded sequence, or to the record behind `high` if the sequence is empty.
+         *
+         * Producers recording their edits from left to right, e.g. while replaying the variants of a haplotype, only
+         * ever split the last record. Unlike record(), this function neither searches the affected records nor
+         * updates the positions of the records behind the edit, but rewrites the tail of the journal in place.
+         */
+        constexpr iterator record_back(key_type const low, key_type const high, sequence_type sequence)
+        {
+            assert(low <= high);
+            assert(high <= end()->position());
+            assert(empty() || std::ranges::prev(end())->position() <= low);
+
+            size_type const sequence_size = end()->position();
+            if (_journal.capacity() < _journal.size() + 2) // at most the suffix and the new record are added.
+                _journal.reserve(std::max(2 * _journal.capacity(), _journal.size() + 2));
+            _journal.pop_back(); // the sentinel is restored below.
+
+            sequence_type suffix{};
+            if (!_journal.empty()) {
+                size_type const tail_position = _journal.back().position();
+                auto tail = _journal.back().sequence();
+                auto low_it = std::ranges::next(std::ranges::begin(tail), low - tail_position);
+                auto high_it = std::ranges::next(std::ranges::begin(tail), high - tail_position);
+                suffix = get_breakpoint_slice(tail, high_it, std::ranges::end(tail));
+                if (low == tail_position)
+                    _journal.pop_back();
+                else
+                    _journal.back() = record_impl{tail_position, get_breakpoint_slice(tail, std::ranges::begin(tail), low_it)};
+            }
+
+            std::ptrdiff_t const first_recorded = std::ranges::ssize(_journal);
+            size_type const insertion_size = std::ranges::size(sequence);
+            if (insertion_size > 0)
+                _journal.emplace_back(low, std::move(sequence));
+            if (!std::ranges::empty(suffix))
+                _journal.emplace_back(low + insertion_size, std::move(suffix));
+            _journal.emplace_back(sequence_size - (high - low) + insertion_size, sequence_type{});
+
+            assert(check_journal_invariants());
+
+            return std::ranges::next(begin(), first_recorded);
+        }
         /// @}
 
         /// @name Lookup
@@ -423,8 +477,8 @@ namespace libjst
         /// @}
     };
 
-    template <libjst::preserving_reference_sequence source_t>
-    class inline_sequence_journal<source_t>::record_impl
+    template <libjst::preserving_reference_sequence source_t, typename allocator_t>
+    class inline_sequence_journal<source_t, allocator_t>::record_impl
     {
         ///@name Public member types
         ///@{
@@ -541,8 +595,8 @@ namespace libjst
         ///@}
     };
 
-    template <libjst::preserving_reference_sequence source_t>
-    class inline_sequence_journal<source_t>::breakend_impl
+    template <libjst::preserving_reference_sequence source_t, typename allocator_t>
+    class inline_sequence_journal<source_t, allocator_t>::breakend_impl
     {
         /// @name Member types
         /// @{
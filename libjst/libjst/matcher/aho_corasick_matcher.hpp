@@ -0,0 +1,262 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides an exact multi-pattern matcher based on the Aho-Corasick automaton.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <libjst/matcher/concept.hpp>
+#include <libjst/utility/memory_usage.hpp>
+
+namespace libjst
+{
+    /*!\brief Finds the exact occurrences of many patterns of the same length at once with the Aho-Corasick automaton.
+     *
+     * \details
+     *
+     * The patterns are compiled into a deterministic automaton over the symbols occurring in them, whose transitions
+     * are stored in one table; every other symbol returns to the root. Hence, every consumed symbol costs a single
+     * table lookup regardless of the number of patterns, e.g. tens of thousands of guides or primers. The state is
+     * the index of the active node, such that capturing and restoring it for the libjst::state_capture_traverser
+     * copies one 32-bit word.
+     *
+     * All patterns must have the same length, which is the window size of the matcher. Then the nodes of that depth
+     * are exactly the ends of the patterns and, since the nodes are numbered breadth first, a hit is detected by a
+     * single comparison. It also ensures that the left extended labels of the libjst::state_oblivious_traverser do
+     * not report the hits of shorter patterns in their context a second time. Patterns of different lengths are
+     * searched with one matcher per length. Within the callback, matched_patterns() returns the indices of the
+     * patterns ending at the reported symbol; identical patterns are reported together.
+     */
+    class aho_corasick_matcher {
+    private:
+
+        using node_type = uint32_t;
+
+        static constexpr std::size_t alphabet_size = 256;
+
+        std::array<node_type, alphabet_size> _ranks{}; //!< The column of every symbol in the transition table.
+        std::vector<node_type> _transitions{}; //!< The next node for every node and column.
+        std::vector<node_type> _pattern_offsets{}; //!< The first pattern index of every pattern end.
+        std::vector<node_type> _pattern_ids{}; //!< The indices of the patterns, grouped by their end.
+        node_type _first_end{std::numeric_limits<node_type>::max()}; //!< The first node ending a pattern.
+        node_type _state{};
+        uint32_t _rank_shift{};
+        std::size_t _size{};
+
+    public:
+
+        using state_type = node_type; //!< The captured state.
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        aho_corasick_matcher() = default; //!< Default.
+
+        /*!\brief Constructs the matcher for the given patterns.
+         *
+         * \param[in] patterns The patterns to search.
+         *
+         * \details
+         *
+         * Throws std::invalid_argument if the patterns differ in their length, and std::length_error if the automaton
+         * would have more nodes than representable by its state.
+         *
+         * ### Complexity
+         *
+         * Linear in the total length of the patterns times the number of distinct symbols in them.
+         */
+        template <std::ranges::input_range patterns_t>
+            requires std::ranges::forward_range<std::ranges::range_reference_t<patterns_t>> &&
+                     std::convertible_to<std::ranges::range_reference_t<std::ranges::range_reference_t<patterns_t>>,
+                                         char>
+        explicit aho_corasick_matcher(patterns_t && patterns)
+        {
+            std::vector<std::string> sequences{};
+            for (auto && pattern : patterns) {
+                sequences.emplace_back(std::ranges::begin(pattern), std::ranges::end(pattern));
+                if (sequences.back().size() != sequences.front().size())
+                    throw std::invalid_argument{"The pattern " + std::to_string(sequences.size() - 1) + " has " +
+                                                std::to_string(sequences.back().size()) + " instead of " +
+                                                std::to_string(sequences.front().size()) + " symbols! Patterns of "
+                                                "different lengths must be searched with separate matchers."};
+            }
+
+            if (!sequences.empty())
+                _size = sequences.front().size();
+            if (_size > 0)
+                build(sequences);
+        }
+        //!\}
+
+        constexpr std::size_t window_size() const noexcept {
+            return _size;
+        }
+
+        //!\brief Returns the number of patterns.
+        constexpr std::size_t pattern_count() const noexcept {
+            return _pattern_ids.size();
+        }
+
+        //!\brief Returns the number of nodes of the automaton.
+        constexpr std::size_t node_count() const noexcept {
+            return _transitions.size() >> _rank_shift;
+        }
+
+        /*!\brief Returns the indices of the patterns ending at the last consumed symbol.
+         *
+         * \details
+         *
+         * Meant to be called from the callback of a hit; returns an empty span if no pattern ends at the symbol.
+         */
+        constexpr std::span<node_type const> matched_patterns() const noexcept {
+            if (_state < _first_end)
+                return {};
+
+            std::size_t const end = _state - _first_end;
+            return std::span{_pattern_ids}.subspan(_pattern_offsets[end], _pattern_offsets[end + 1] -
+                                                                          _pattern_offsets[end]);
+        }
+
+        //!\brief Searches the haystack and invokes the callback with the iterator to the last symbol of every hit.
+        template <std::ranges::input_range haystack_t, typename callback_t>
+        constexpr void operator()(haystack_t && haystack, callback_t && callback) {
+            if (_size == 0)
+                return;
+
+            for (auto it = std::ranges::begin(haystack); it != std::ranges::end(haystack); ++it) {
+                std::size_t const rank = _ranks[static_cast<unsigned char>(*it)];
+                _state = _transitions[(std::size_t{_state} << _rank_shift) | rank];
+                if (_state >= _first_end)
+                    callback(it);
+            }
+        }
+
+        constexpr state_type capture() const noexcept {
+            return _state;
+        }
+
+        constexpr void restore(state_type const state) noexcept {
+            _state = state;
+        }
+
+        //!\brief Resets the state as if no symbol was consumed.
+        constexpr void reset() noexcept {
+            _state = 0;
+        }
+
+        //!\brief Returns the number of bytes allocated for the automaton.
+        std::size_t memory_usage() const noexcept {
+            return libjst::memory_usage(_transitions) + libjst::memory_usage(_pattern_offsets) +
+                   libjst::memory_usage(_pattern_ids);
+        }
+
+    private:
+
+        void build(std::vector<std::string> const & patterns) {
+            constexpr node_type no_child = std::numeric_limits<node_type>::max();
+
+            // The symbols of the patterns occupy the first columns, every other symbol the last one.
+            node_type symbol_count{};
+            std::array<bool, alphabet_size> occurs{};
+            for (std::string const & pattern : patterns)
+                for (char const symbol : pattern)
+                    occurs[static_cast<unsigned char>(symbol)] = true;
+            for (std::size_t symbol = 0; symbol < alphabet_size; ++symbol)
+                if (occurs[symbol])
+                    _ranks[symbol] = symbol_count++;
+            for (std::size_t symbol = 0; symbol < alphabet_size; ++symbol)
+                if (!occurs[symbol])
+                    _ranks[symbol] = symbol_count;
+            _rank_shift = std::bit_width(static_cast<std::size_t>(symbol_count));
+            std::size_t const stride = std::size_t{1} << _rank_shift;
+
+            // The trie in insertion order.
+            std::vector<node_type> trie(stride, no_child);
+            std::vector<node_type> end_of_pattern{};
+            end_of_pattern.reserve(patterns.size());
+            for (std::string const & pattern : patterns) {
+                std::size_t node = 0;
+                for (char const symbol : pattern) {
+                    std::size_t const slot = (node << _rank_shift) | _ranks[static_cast<unsigned char>(symbol)];
+                    if (trie[slot] == no_child) {
+                        std::size_t const child = trie.size() >> _rank_shift;
+                        if (child >= no_child)
+                            throw std::length_error{"The patterns exceed the number of nodes of the automaton."};
+                        trie[slot] = static_cast<node_type>(child);
+                        trie.resize(trie.size() + stride, no_child);
+                    }
+                    node = trie[slot];
+                }
+                end_of_pattern.push_back(static_cast<node_type>(node));
+            }
+
+            // Numbers the nodes breadth first, such that the pattern ends, which are the deepest nodes, come last.
+            std::size_t const node_count = trie.size() >> _rank_shift;
+            std::vector<node_type> order{0};
+            std::vector<node_type> number_of(node_count);
+            order.reserve(node_count);
+            for (std::size_t i = 0; i < order.size(); ++i) {
+                number_of[order[i]] = static_cast<node_type>(i);
+                for (std::size_t rank = 0; rank < symbol_count; ++rank)
+                    if (node_type const child = trie[(std::size_t{order[i]} << _rank_shift) | rank]; child != no_child)
+                        order.push_back(child);
+            }
+            assert(order.size() == node_count);
+
+            // Resolves the failure links into the transitions, parents before children.
+            _transitions.assign(trie.size(), 0);
+            std::vector<node_type> failure(node_count, 0);
+            for (std::size_t node = 0; node < node_count; ++node) {
+                std::size_t const old_node = order[node];
+                for (std::size_t rank = 0; rank < symbol_count; ++rank) {
+                    node_type const old_child = trie[(old_node << _rank_shift) | rank];
+                    std::size_t const fallback_slot = (std::size_t{failure[node]} << _rank_shift) | rank;
+                    node_type const fallback = (node == 0) ? 0 : _transitions[fallback_slot];
+                    if (old_child == no_child) {
+                        _transitions[(node << _rank_shift) | rank] = fallback;
+                    } else {
+                        node_type const child = number_of[old_child];
+                        _transitions[(node << _rank_shift) | rank] = child;
+                        failure[child] = fallback;
+                    }
+                }
+            }
+
+            // Groups the pattern indices by their end; all ends have the depth of the pattern length.
+            std::size_t first_end = node_count;
+            for (node_type const end : end_of_pattern)
+                first_end = std::min<std::size_t>(first_end, number_of[end]);
+            _first_end = static_cast<node_type>(first_end);
+            _pattern_offsets.assign(node_count - first_end + 1, 0);
+            for (node_type const end : end_of_pattern)
+                ++_pattern_offsets[number_of[end] - first_end + 1];
+            for (std::size_t i = 1; i < _pattern_offsets.size(); ++i)
+                _pattern_offsets[i] += _pattern_offsets[i - 1];
+            _pattern_ids.resize(patterns.size());
+            std::vector<node_type> next_slot(_pattern_offsets.begin(), _pattern_offsets.end() - 1);
+            for (std::size_t pattern = 0; pattern < patterns.size(); ++pattern)
+                _pattern_ids[next_slot[number_of[end_of_pattern[pattern]] - first_end]++] =
+                    static_cast<node_type>(pattern);
+        }
+    };
+}  // namespace libjst
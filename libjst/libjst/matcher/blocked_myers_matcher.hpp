@@ -0,0 +1,238 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides an approximate matcher for long patterns based on the blocked variant of Myers' algorithm.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <vector>
+
+#include <libjst/matcher/concept.hpp>
+#include <libjst/matcher/myers_kernels.hpp>
+
+namespace libjst
+{
+    /*!\brief Finds the occurrences of a pattern of arbitrary length with at most `k` edits.
+     *
+     * \details
+     *
+     * The pattern is split into blocks of 64 rows, whose vertical deltas are stored in one word each. Following
+     * Ukkonen's cut-off, only the blocks up to the last block that may contain a cell with at most `k` edits are
+     * active and computed; a block is activated once the score of the bottom row of its predecessor drops to `k`.
+     * The column over the active blocks is computed by the SIMD kernels selected for the executing CPU, see
+     * libjst::detail::active_myers_kernels, which resolve the carries between the words of one vector at once.
+     *
+     * The captured state stores only the active blocks, i.e. for a read with few errors the state of usually one or
+     * two blocks is copied per branch, independent of the pattern length. The state is a range of `uint64_t` words:
+     * the number of active blocks followed by the positive and negative vertical deltas and the score of every
+     * active block.
+     */
+    class blocked_myers_matcher {
+    public:
+
+        using state_type = std::vector<uint64_t>; //!< The captured state.
+
+    private:
+
+        static constexpr std::size_t word_size = 64;
+        static constexpr std::size_t words_per_block = 3;
+
+        std::vector<uint64_t> _peq{};
+        std::vector<uint64_t> _rows{};
+        std::vector<uint64_t> _vp{};
+        std::vector<uint64_t> _vn{};
+        std::vector<uint64_t> _scores{};
+        std::size_t _size{};
+        std::size_t _max_errors{};
+        std::size_t _block_count{};
+        std::size_t _active_blocks{};
+        detail::myers_kernels::column_kernel_type _column{detail::scalar_myers_kernels.column};
+
+    public:
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        blocked_myers_matcher() = default; //!< Default.
+
+        /*!\brief Constructs the matcher for the given pattern and error bound.
+         *
+         * \param[in] pattern The pattern to search.
+         * \param[in] max_errors The maximal number of edits of a hit.
+         */
+        template <std::ranges::forward_range pattern_t>
+            requires std::convertible_to<std::ranges::range_reference_t<pattern_t>, char>
+        blocked_myers_matcher(pattern_t && pattern, std::size_t const max_errors) :
+            blocked_myers_matcher{(pattern_t &&) pattern, max_errors, detail::active_myers_kernels()}
+        {}
+
+        /*!\brief Constructs the matcher for the given pattern and error bound using the kernels of the given target.
+         *
+         * \param[in] pattern The pattern to search.
+         * \param[in] max_errors The maximal number of edits of a hit.
+         * \param[in] target The instruction set of the kernels; falls back to scalar kernels if it is not supported.
+         */
+        template <std::ranges::forward_range pattern_t>
+            requires std::convertible_to<std::ranges::range_reference_t<pattern_t>, char>
+        blocked_myers_matcher(pattern_t && pattern, std::size_t const max_errors, detail::bit_kernel_target target) :
+            blocked_myers_matcher{(pattern_t &&) pattern, max_errors, detail::select_myers_kernels(target)}
+        {}
+        //!\}
+
+        constexpr std::size_t window_size() const noexcept {
+            return (_size == 0) ? 0 : _size + _max_errors;
+        }
+
+        //!\brief Returns the maximal number of edits of a hit.
+        constexpr std::size_t max_errors() const noexcept {
+            return _max_errors;
+        }
+
+        /*!\brief Returns the edit distance of the best occurrence ending at the last consumed symbol.
+         *
+         * \details
+         *
+         * The distance is exact if it is at most libjst::blocked_myers_matcher::max_errors, otherwise some value
+         * greater than the error bound is returned.
+         */
+        constexpr std::size_t score() const noexcept {
+            return (_active_blocks == _block_count) ? _scores.back() : _max_errors + 1;
+        }
+
+        /*!\brief Returns a lower bound of the score of every hit continuing the occurrences of the current state.
+         *
+         * \details
+         *
+         * Like libjst::myers_matcher::lower_bound, the minimal distance of the rows of the last column, where the
+         * rows of the inactive blocks are known to exceed the error bound.
+         */
+        constexpr std::size_t lower_bound() const noexcept {
+            if (_size == 0)
+                return 0;
+
+            std::size_t bound = (_active_blocks == _block_count) ? _scores.back() : _max_errors + 1;
+            for (std::size_t block = 0; block < _active_blocks; ++block) {
+                std::size_t row_score = (block == 0) ? 0 : _scores[block - 1];
+                for (std::size_t row = 0; row < rows_of_block(block); ++row) {
+                    row_score += (_vp[block] >> row) & 1;
+                    row_score -= (_vn[block] >> row) & 1;
+                    bound = std::min(bound, row_score);
+                }
+            }
+            return bound;
+        }
+
+        //!\brief Returns the number of blocks that are currently computed.
+        constexpr std::size_t active_blocks() const noexcept {
+            return _active_blocks;
+        }
+
+        //!\brief Searches the haystack and invokes the callback with the iterator to the last symbol of every hit.
+        template <std::ranges::input_range haystack_t, typename callback_t>
+        void operator()(haystack_t && haystack, callback_t && callback) {
+            if (_size == 0)
+                return;
+
+            for (auto it = std::ranges::begin(haystack); it != std::ranges::end(haystack); ++it) {
+                if (_active_blocks < _block_count && _scores[_active_blocks - 1] <= _max_errors)
+                    activate_block();
+
+                uint64_t const * eq = _peq.data() + static_cast<unsigned char>(*it) * _block_count;
+                _column(_vp.data(), _vn.data(), _scores.data(), eq, _rows.data(), _active_blocks);
+
+                while (_active_blocks > 1 &&
+                       _scores[_active_blocks - 1] >= _max_errors + rows_of_block(_active_blocks - 1))
+                    --_active_blocks;
+
+                if (_active_blocks == _block_count && _scores.back() <= _max_errors)
+                    callback(it);
+            }
+        }
+
+        state_type capture() const {
+            state_type state{};
+            state.reserve(1 + words_per_block * _active_blocks);
+            state.push_back(_active_blocks);
+            for (std::size_t block = 0; block < _active_blocks; ++block) {
+                state.push_back(_vp[block]);
+                state.push_back(_vn[block]);
+                state.push_back(_scores[block]);
+            }
+            return state;
+        }
+
+        void restore(state_type const & state) noexcept {
+            _active_blocks = state[0];
+            for (std::size_t block = 0; block < _active_blocks; ++block) {
+                _vp[block] = state[1 + words_per_block * block];
+                _vn[block] = state[2 + words_per_block * block];
+                _scores[block] = state[3 + words_per_block * block];
+            }
+        }
+
+        //!\brief Resets the state as if no symbol was consumed.
+        void reset() noexcept {
+            std::ranges::fill(_vp, ~uint64_t{0});
+            std::ranges::fill(_vn, 0);
+            for (std::size_t block = 0; block < _block_count; ++block)
+                _scores[block] = std::min((block + 1) * word_size, _size);
+
+            // Activate all blocks whose first row can be within the error bound.
+            _active_blocks = std::clamp<std::size_t>((_max_errors + word_size - 1) / word_size, 1, _block_count);
+        }
+
+    private:
+
+        template <typename pattern_t>
+        blocked_myers_matcher(pattern_t && pattern,
+                              std::size_t const max_errors,
+                              detail::myers_kernels const & kernels) :
+            _size{static_cast<std::size_t>(std::ranges::distance(pattern))},
+            _max_errors{max_errors},
+            _block_count{(_size + word_size - 1) / word_size},
+            _column{kernels.column}
+        {
+            _peq.resize(256 * _block_count);
+            std::size_t row = 0;
+            for (char const symbol : pattern) {
+                _peq[static_cast<unsigned char>(symbol) * _block_count + row / word_size] |=
+                    uint64_t{1} << (row % word_size);
+                ++row;
+            }
+
+            _rows.assign(_block_count, uint64_t{1} << (word_size - 1));
+            if (_block_count > 0)
+                _rows.back() = uint64_t{1} << (rows_of_block(_block_count - 1) - 1);
+
+            _vp.resize(_block_count);
+            _vn.resize(_block_count);
+            _scores.resize(_block_count);
+            if (_block_count > 0)
+                reset();
+        }
+
+        //!\brief Returns the number of pattern symbols of the given block.
+        constexpr std::size_t rows_of_block(std::size_t const block) const noexcept {
+            return std::min(word_size, _size - block * word_size);
+        }
+
+        //!\brief Activates the next block assuming that its cells of the last column exceed the bottom row above.
+        void activate_block() noexcept {
+            std::size_t const block = _active_blocks++;
+            _vp[block] = ~uint64_t{0};
+            _vn[block] = 0;
+            _scores[block] = _scores[block - 1] + rows_of_block(block);
+        }
+    };
+}  // namespace libjst
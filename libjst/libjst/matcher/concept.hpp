@@ -0,0 +1,166 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides concepts and CPOs for pattern matchers used by the tree traversers.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <type_traits>
+
+#include <libjst/utility/tag_invoke.hpp>
+
+namespace libjst
+{
+    // ----------------------------------------------------------------------------
+    // Operation CPOs for matchers
+    // ----------------------------------------------------------------------------
+
+    // window_size
+    namespace _window_size {
+        inline constexpr struct _cpo  {
+            template <typename matcher_t>
+                requires libjst::tag_invocable<_cpo, matcher_t>
+            constexpr auto operator()(matcher_t && matcher) const
+                noexcept(libjst::is_nothrow_tag_invocable_v<_cpo, matcher_t>)
+                -> libjst::tag_invoke_result_t<_cpo, matcher_t>
+            {
+                return libjst::tag_invoke(_cpo{}, (matcher_t &&)matcher);
+            }
+
+        private:
+
+            template <typename matcher_t>
+                requires requires (matcher_t && matcher) { { std::forward<matcher_t &&>(matcher).window_size() } -> std::integral; }
+            constexpr friend auto tag_invoke(_cpo, matcher_t && matcher)
+                noexcept(noexcept(std::declval<matcher_t &&>().window_size()))
+                -> decltype(std::declval<matcher_t &&>().window_size())
+            {
+                return std::forward<matcher_t &&>(matcher).window_size();
+            }
+        } window_size;
+    } // namespace _window_size
+    using _window_size::window_size;
+
+    // ----------------------------------------------------------------------------
+    // Associated types of matchers
+    // ----------------------------------------------------------------------------
+
+    template <typename matcher_t>
+    using matcher_state_t = std::remove_cvref_t<decltype(std::declval<matcher_t const &>().capture())>;
+
+    // ----------------------------------------------------------------------------
+    // Matcher concepts
+    // ----------------------------------------------------------------------------
+
+    template <typename matcher_t>
+    concept window_matcher = requires (matcher_t const & matcher) {
+        { libjst::window_size(matcher) } -> std::integral;
+    };
+
+    /*!\brief The window size of a matcher known at compile time, or 0 if it is only known at runtime.
+     *
+     * \details
+     *
+     * A matcher advertises its window size with a `static constexpr std::size_t static_window_size` member, e.g.
+     * libjst::static_window_matcher. The traversers then instantiate the adaptor pipeline with the left extension as
+     * a template parameter, see libjst::detail::left_extension.
+     */
+    template <typename matcher_t>
+    inline constexpr std::size_t static_window_size_v = 0;
+
+    template <typename matcher_t>
+        requires (!std::same_as<matcher_t, std::remove_cvref_t<matcher_t>>)
+    inline constexpr std::size_t static_window_size_v<matcher_t> = static_window_size_v<std::remove_cvref_t<matcher_t>>;
+
+    template <typename matcher_t>
+        requires std::same_as<matcher_t, std::remove_cvref_t<matcher_t>> &&
+                 requires { { std::integral_constant<std::size_t, matcher_t::static_window_size>{} }; }
+    inline constexpr std::size_t static_window_size_v<matcher_t> = matcher_t::static_window_size;
+
+    namespace detail
+    {
+        /*!\brief Returns the number of symbols preceding a window, i.e. `window_size(matcher) - 1`, which the trim and
+         *        left extend adaptors of the search pipeline are instantiated with.
+         *
+         * \details
+         *
+         * Returns a std::integral_constant if the matcher has a static window size, see libjst::static_window_size_v,
+         * and a std::size_t otherwise. The window size must not be 0.
+         */
+        template <typename matcher_t>
+        constexpr auto left_extension(matcher_t const & matcher) noexcept {
+            if constexpr (static_window_size_v<matcher_t> > 0)
+                return std::integral_constant<std::size_t, static_window_size_v<matcher_t> - 1>{};
+            else
+                return static_cast<std::size_t>(libjst::window_size(matcher) - 1);
+        }
+    } // namespace detail
+
+    template <typename matcher_t>
+    concept state_capturing_matcher = window_matcher<matcher_t> && requires (matcher_t & matcher) {
+        { matcher.capture() };
+        matcher.restore(matcher.capture());
+    };
+
+    /*!\brief A matcher scoring its hits, e.g. libjst::myers_matcher, where lower scores are better.
+     *
+     * \details
+     *
+     * `score()` returns the score of the hit reported to the callback and `lower_bound()` a lower bound of the
+     * score of every hit that continues one of the occurrences of the current state. The occurrences beginning
+     * after the last consumed symbol are not bounded.
+     */
+    template <typename matcher_t>
+    concept score_bounded_matcher = state_capturing_matcher<matcher_t> && requires (matcher_t const & matcher) {
+        { matcher.score() } -> std::integral;
+        { matcher.lower_bound() } -> std::integral;
+    };
+
+    /*!\brief A sequence of dna ranks packed with two bits per base, e.g. libjst::packed_dna_sequence.
+     *
+     * \details
+     *
+     * `word_at(position)` returns the ranks of the 32 bases beginning at `position` in one word, where the base at
+     * `position + i` occupies the bits `[2 * i, 2 * i + 2)`. The symbols that are not one of 'A', 'C', 'G', 'T' are
+     * reported by the sorted runs in `runs()`.
+     */
+    template <typename sequence_t>
+    concept packed_dna_range = requires (sequence_t const & sequence, std::size_t const position) {
+        { sequence.size() } -> std::integral;
+        { sequence.word_at(position) } -> std::same_as<uint64_t>;
+        { sequence.runs() } -> std::ranges::forward_range;
+    };
+
+    namespace detail
+    {
+        //!\brief The callback type used to check the packed input overload of a matcher.
+        struct packed_hit_callback {
+            constexpr void operator()(std::size_t) const noexcept {}
+        };
+    } // namespace detail
+
+    /*!\brief A matcher that can additionally consume a packed dna sequence.
+     *
+     * \details
+     *
+     * The packed overload `matcher(sequence, callback)` invokes the callback with the position of the last symbol of
+     * a hit in the packed sequence, instead of an iterator into the haystack. Labels of the sequence
+     * trees are `char` sequences, so the traversers always call the unpacked overload.
+     */
+    template <typename matcher_t, typename packed_sequence_t>
+    concept packed_matcher = window_matcher<matcher_t> && packed_dna_range<packed_sequence_t> &&
+        requires (matcher_t & matcher, packed_sequence_t const & sequence) {
+            matcher(sequence, detail::packed_hit_callback{});
+    };
+}  // namespace libjst
@@ -0,0 +1,86 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides an exact matcher based on Horspool's algorithm.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <ranges>
+#include <vector>
+
+#include <libjst/matcher/concept.hpp>
+
+namespace libjst
+{
+    /*!\brief Finds the exact occurrences of a pattern with Horspool's algorithm.
+     *
+     * \details
+     *
+     * The matcher skips over the haystack by the bad character shift of the last symbol of the current window and
+     * compares the window only if its last symbol matches. It has no state besides the pattern and searches every
+     * haystack on its own; hence, it is meant for the libjst::state_oblivious_traverser, whose labels contain the
+     * preceding `window_size() - 1` symbols. Long patterns over large alphabets benefit most from the skipping.
+     */
+    class horspool_matcher {
+    private:
+
+        std::vector<char> _pattern{};
+        std::array<std::size_t, 256> _shifts{};
+
+    public:
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        horspool_matcher() = default; //!< Default.
+
+        //!\brief Constructs the matcher for the given pattern.
+        template <std::ranges::forward_range pattern_t>
+            requires std::convertible_to<std::ranges::range_reference_t<pattern_t>, char>
+        explicit horspool_matcher(pattern_t && pattern) :
+            _pattern{std::ranges::begin(pattern), std::ranges::end(pattern)}
+        {
+            _shifts.fill(_pattern.size());
+            for (std::size_t i = 0; i + 1 < _pattern.size(); ++i)
+                _shifts[static_cast<unsigned char>(_pattern[i])] = _pattern.size() - 1 - i;
+        }
+        //!\}
+
+        constexpr std::size_t window_size() const noexcept {
+            return _pattern.size();
+        }
+
+        //!\brief Searches the haystack and invokes the callback with the iterator to the last symbol of every hit.
+        template <std::ranges::random_access_range haystack_t, typename callback_t>
+            requires std::ranges::sized_range<haystack_t>
+        constexpr void operator()(haystack_t && haystack, callback_t && callback) const {
+            std::size_t const size = _pattern.size();
+            std::size_t const haystack_size = std::ranges::size(haystack);
+            if (size == 0 || haystack_size < size)
+                return;
+
+            using difference_t = std::ranges::range_difference_t<haystack_t>;
+            char const last_symbol = _pattern.back();
+            auto first = std::ranges::begin(haystack);
+            for (std::size_t end = size - 1; end < haystack_size;) {
+                auto last = first + static_cast<difference_t>(end);
+                char const symbol = *last;
+                if (symbol == last_symbol && std::ranges::equal(_pattern.begin(), _pattern.end() - 1,
+                                                                last - static_cast<difference_t>(size - 1), last))
+                    callback(last);
+
+                end += _shifts[static_cast<unsigned char>(symbol)];
+            }
+        }
+    };
+}  // namespace libjst
@@ -0,0 +1,289 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides SIMD kernels for the multi-word column update of Myers' bit-vector algorithm.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include <libjst/utility/bit_vector_kernels.hpp>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define LIBJST_MYERS_KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+namespace libjst::detail
+{
+    /*!\brief The table of kernels computing one column of Myers' algorithm over several words.
+     *
+     * \details
+     *
+     * The column kernel updates the vertical deltas `vp` and `vn` of `count` words for the pattern symbols `eq` that
+     * match the current text symbol. The words form one bit vector of `64 * count` rows, i.e. the carry of the
+     * addition and the horizontal deltas shifted out of a word enter the next word. The first row is zero, as in
+     * the semi-global alignment. `scores[i]` is incremented by the horizontal delta at the row of word `i` selected
+     * by the single bit of `rows[i]`.
+     *
+     * The carry propagation is resolved per vector with a carry lookahead over the lanes, such that all words of a
+     * vector are updated at once.
+     */
+    struct myers_kernels {
+        using word_type = uint64_t;
+        using column_kernel_type = void (*)(word_type *, word_type *, word_type *,
+                                            word_type const *, word_type const *, std::size_t) noexcept;
+
+        bit_kernel_target target; //!< The instruction set of the kernels.
+        column_kernel_type column; //!< Computes the next column of all words.
+    };
+
+    //!\brief The bits entering the next word of a column: the carry of the addition and the shifted horizontal deltas.
+    struct myers_word_carries {
+        uint64_t carry{};
+        uint64_t ph{};
+        uint64_t mh{};
+    };
+
+    // ----------------------------------------------------------------------------
+    // Scalar kernels
+    // ----------------------------------------------------------------------------
+
+    constexpr myers_word_carries scalar_myers_words(uint64_t * vp,
+                                                    uint64_t * vn,
+                                                    uint64_t * scores,
+                                                    uint64_t const * eq,
+                                                    uint64_t const * rows,
+                                                    std::size_t const count,
+                                                    myers_word_carries carries = {}) noexcept {
+        for (std::size_t i = 0; i < count; ++i) {
+            uint64_t const e = eq[i];
+            uint64_t const p = vp[i];
+            uint64_t const n = vn[i];
+            uint64_t const xv = e | n;
+
+            uint64_t const a = e & p;
+            uint64_t const partial_sum = a + p;
+            uint64_t const sum = partial_sum + carries.carry;
+            carries.carry = (partial_sum < a) | (sum < partial_sum);
+
+            uint64_t const xh = (sum ^ p) | e;
+            uint64_t const ph = n | ~(xh | p);
+            uint64_t const mh = p & xh;
+            scores[i] += ((ph & rows[i]) != 0);
+            scores[i] -= ((mh & rows[i]) != 0);
+
+            uint64_t const shifted_ph = (ph << 1) | carries.ph;
+            uint64_t const shifted_mh = (mh << 1) | carries.mh;
+            carries.ph = ph >> 63;
+            carries.mh = mh >> 63;
+
+            vp[i] = shifted_mh | ~(xv | shifted_ph);
+            vn[i] = shifted_ph & xv;
+        }
+        return carries;
+    }
+
+    constexpr void scalar_myers_column(uint64_t * vp,
+                                       uint64_t * vn,
+                                       uint64_t * scores,
+                                       uint64_t const * eq,
+                                       uint64_t const * rows,
+                                       std::size_t const count) noexcept {
+        scalar_myers_words(vp, vn, scores, eq, rows, count);
+    }
+
+    inline constexpr myers_kernels scalar_myers_kernels{
+        .target = bit_kernel_target::scalar,
+        .column = scalar_myers_column
+    };
+
+#if LIBJST_MYERS_KERNELS_X86
+    // ----------------------------------------------------------------------------
+    // AVX2 kernels
+    // ----------------------------------------------------------------------------
+
+    __attribute__((target("avx2")))
+    inline void avx2_myers_column(uint64_t * vp,
+                                  uint64_t * vn,
+                                  uint64_t * scores,
+                                  uint64_t const * eq,
+                                  uint64_t const * rows,
+                                  std::size_t const count) noexcept {
+        __m256i const ones = _mm256_set1_epi64x(-1);
+        __m256i const zero = _mm256_setzero_si256();
+        __m256i const sign = _mm256_set1_epi64x(INT64_MIN);
+        __m256i const lane_index = _mm256_setr_epi64x(0, 1, 2, 3);
+        __m256i const lane_one = _mm256_set1_epi64x(1);
+
+        myers_word_carries carries{};
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m256i const e = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(eq + i));
+            __m256i const p = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(vp + i));
+            __m256i const n = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(vn + i));
+            __m256i const xv = _mm256_or_si256(e, n);
+
+            // Add the lanes independently and resolve the carries between them with the generate and propagate masks.
+            __m256i const a = _mm256_and_si256(e, p);
+            __m256i sum = _mm256_add_epi64(a, p);
+            unsigned const generate = _mm256_movemask_pd(_mm256_castsi256_pd(
+                _mm256_cmpgt_epi64(_mm256_xor_si256(a, sign), _mm256_xor_si256(sum, sign)))); // unsigned sum < a
+            unsigned const propagate = _mm256_movemask_pd(_mm256_castsi256_pd(_mm256_cmpeq_epi64(sum, ones)));
+            unsigned const rippled = ((generate << 1) | static_cast<unsigned>(carries.carry)) + propagate;
+            unsigned const carry_in = (rippled ^ propagate) & 0xf;
+            carries.carry = (rippled >> 4) & 1;
+            sum = _mm256_add_epi64(sum, _mm256_and_si256(_mm256_srlv_epi64(_mm256_set1_epi64x(carry_in), lane_index),
+                                                         lane_one));
+
+            __m256i const xh = _mm256_or_si256(_mm256_xor_si256(sum, p), e);
+            __m256i const ph = _mm256_or_si256(n, _mm256_andnot_si256(_mm256_or_si256(xh, p), ones));
+            __m256i const mh = _mm256_and_si256(p, xh);
+
+            __m256i const r = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(rows + i));
+            __m256i score = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(scores + i));
+            score = _mm256_add_epi64(score, _mm256_cmpeq_epi64(_mm256_and_si256(ph, r), zero)); // -1 without delta
+            score = _mm256_sub_epi64(score, _mm256_cmpeq_epi64(_mm256_and_si256(mh, r), zero));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(scores + i), score);
+
+            // Rotate the lanes by one to shift the top bit of every word into the next word.
+            __m256i const previous_ph = _mm256_blend_epi32(_mm256_permute4x64_epi64(ph, _MM_SHUFFLE(2, 1, 0, 3)),
+                                                           _mm256_set1_epi64x(static_cast<int64_t>(carries.ph << 63)),
+                                                           0b00000011);
+            __m256i const previous_mh = _mm256_blend_epi32(_mm256_permute4x64_epi64(mh, _MM_SHUFFLE(2, 1, 0, 3)),
+                                                           _mm256_set1_epi64x(static_cast<int64_t>(carries.mh << 63)),
+                                                           0b00000011);
+            __m256i const shifted_ph = _mm256_or_si256(_mm256_slli_epi64(ph, 1), _mm256_srli_epi64(previous_ph, 63));
+            __m256i const shifted_mh = _mm256_or_si256(_mm256_slli_epi64(mh, 1), _mm256_srli_epi64(previous_mh, 63));
+            carries.ph = static_cast<uint64_t>(_mm256_extract_epi64(ph, 3)) >> 63;
+            carries.mh = static_cast<uint64_t>(_mm256_extract_epi64(mh, 3)) >> 63;
+
+            __m256i const new_vp = _mm256_or_si256(shifted_mh,
+                                                   _mm256_andnot_si256(_mm256_or_si256(xv, shifted_ph), ones));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(vp + i), new_vp);
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(vn + i), _mm256_and_si256(shifted_ph, xv));
+        }
+
+        scalar_myers_words(vp + i, vn + i, scores + i, eq + i, rows + i, count - i, carries);
+    }
+
+    inline constexpr myers_kernels avx2_myers_kernels{
+        .target = bit_kernel_target::avx2,
+        .column = avx2_myers_column
+    };
+
+    // ----------------------------------------------------------------------------
+    // AVX-512 kernels
+    // ----------------------------------------------------------------------------
+
+    __attribute__((target("avx512f")))
+    inline void avx512_myers_column(uint64_t * vp,
+                                    uint64_t * vn,
+                                    uint64_t * scores,
+                                    uint64_t const * eq,
+                                    uint64_t const * rows,
+                                    std::size_t const count) noexcept {
+        __m512i const ones = _mm512_set1_epi64(-1);
+        __m512i const lane_one = _mm512_set1_epi64(1);
+
+        myers_word_carries carries{};
+        for (std::size_t i = 0; i < count; i += 8) { // the remaining words are processed with masked operations.
+            __mmask8 const lanes = (count - i >= 8) ? __mmask8{0xff} : static_cast<__mmask8>((1u << (count - i)) - 1);
+            __m512i const e = _mm512_maskz_loadu_epi64(lanes, eq + i);
+            __m512i const p = _mm512_maskz_loadu_epi64(lanes, vp + i);
+            __m512i const n = _mm512_maskz_loadu_epi64(lanes, vn + i);
+            __m512i const xv = _mm512_or_si512(e, n);
+
+            __m512i const a = _mm512_and_si512(e, p);
+            __m512i sum = _mm512_add_epi64(a, p);
+            unsigned const generate = _mm512_cmplt_epu64_mask(sum, a);
+            unsigned const propagate = _mm512_cmpeq_epu64_mask(sum, ones);
+            unsigned const rippled = ((generate << 1) | static_cast<unsigned>(carries.carry)) + propagate;
+            __mmask8 const carry_in = static_cast<__mmask8>(rippled ^ propagate);
+            carries.carry = (rippled >> 8) & 1;
+            sum = _mm512_mask_add_epi64(sum, carry_in, sum, lane_one);
+
+            __m512i const xh = _mm512_or_si512(_mm512_xor_si512(sum, p), e);
+            __m512i const ph = _mm512_or_si512(n, _mm512_xor_si512(_mm512_or_si512(xh, p), ones));
+            __m512i const mh = _mm512_and_si512(p, xh);
+
+            __m512i const r = _mm512_maskz_loadu_epi64(lanes, rows + i);
+            __m512i score = _mm512_maskz_loadu_epi64(lanes, scores + i);
+            score = _mm512_mask_add_epi64(score, _mm512_test_epi64_mask(ph, r), score, lane_one);
+            score = _mm512_mask_sub_epi64(score, _mm512_test_epi64_mask(mh, r), score, lane_one);
+            _mm512_mask_storeu_epi64(scores + i, lanes, score);
+
+            // Shift the lanes by one to move the top bit of every word into the next word. The masked intrinsics are
+            // used, since the unmasked ones warn spuriously with GCC 12.
+            __m512i const previous_ph = _mm512_maskz_alignr_epi64(0xff, ph, _mm512_set1_epi64(
+                                                                  static_cast<int64_t>(carries.ph << 63)), 7);
+            __m512i const previous_mh = _mm512_maskz_alignr_epi64(0xff, mh, _mm512_set1_epi64(
+                                                                  static_cast<int64_t>(carries.mh << 63)), 7);
+            __m512i const shifted_ph = _mm512_or_si512(_mm512_maskz_slli_epi64(0xff, ph, 1),
+                                                       _mm512_maskz_srli_epi64(0xff, previous_ph, 63));
+            __m512i const shifted_mh = _mm512_or_si512(_mm512_maskz_slli_epi64(0xff, mh, 1),
+                                                       _mm512_maskz_srli_epi64(0xff, previous_mh, 63));
+            __m256i const upper_ph = _mm512_maskz_extracti64x4_epi64(0xf, ph, 1);
+            __m256i const upper_mh = _mm512_maskz_extracti64x4_epi64(0xf, mh, 1);
+            carries.ph = static_cast<uint64_t>(_mm256_extract_epi64(upper_ph, 3)) >> 63;
+            carries.mh = static_cast<uint64_t>(_mm256_extract_epi64(upper_mh, 3)) >> 63;
+
+            __m512i const new_vp = _mm512_or_si512(shifted_mh,
+                                                   _mm512_xor_si512(_mm512_or_si512(xv, shifted_ph), ones));
+            _mm512_mask_storeu_epi64(vp + i, lanes, new_vp);
+            _mm512_mask_storeu_epi64(vn + i, lanes, _mm512_and_si512(shifted_ph, xv));
+        }
+    }
+
+    inline constexpr myers_kernels avx512_myers_kernels{
+        .target = bit_kernel_target::avx512,
+        .column = avx512_myers_column
+    };
+#endif // LIBJST_MYERS_KERNELS_X86
+
+    // ----------------------------------------------------------------------------
+    // Dispatch
+    // ----------------------------------------------------------------------------
+
+    /*!\brief Returns the kernels of the given target.
+     *
+     * \details
+     *
+     * Falls back to the scalar kernels if the given target is not supported by the executing CPU or has no
+     * Myers kernels.
+     */
+    inline myers_kernels select_myers_kernels(bit_kernel_target const target) noexcept {
+        if (!supports_bit_kernel_target(target))
+            return scalar_myers_kernels;
+
+        switch (target) {
+#if LIBJST_MYERS_KERNELS_X86
+            case bit_kernel_target::avx2: return avx2_myers_kernels;
+            case bit_kernel_target::avx512: return avx512_myers_kernels;
+#endif
+            default: return scalar_myers_kernels;
+        }
+    }
+
+    //!\brief Returns the kernels of the widest target supported by the executing CPU, which is selected once.
+    inline myers_kernels const & active_myers_kernels() noexcept {
+        static myers_kernels const kernels = [] () {
+            for (bit_kernel_target target : {bit_kernel_target::avx512, bit_kernel_target::avx2})
+                if (supports_bit_kernel_target(target))
+                    return select_myers_kernels(target);
+
+            return scalar_myers_kernels;
+        }();
+        return kernels;
+    }
+}  // namespace libjst::detail
+
+#undef LIBJST_MYERS_KERNELS_X86
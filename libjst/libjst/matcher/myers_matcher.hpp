@@ -0,0 +1,172 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides an approximate bit-parallel matcher based on Myers' bit-vector algorithm.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <stdexcept>
+
+#include <libjst/matcher/concept.hpp>
+
+namespace libjst
+{
+    /*!\brief Finds the occurrences of a pattern of at most 64 symbols with at most `k` edits.
+     *
+     * \details
+     *
+     * Implements the semi-global variant of Myers' bit-vector algorithm: the matcher keeps the vertical deltas of the
+     * last column of the dynamic programming matrix in two words and the edit distance of the pattern to the best
+     * substring ending at the current symbol. A hit is reported for every symbol at which this distance is at most
+     * `k`; the distance itself can be queried with libjst::myers_matcher::score inside of the callback.
+     * The window size is the pattern size plus `k`, which is the longest substring an occurrence can span.
+     *
+     * The state consists of three words and is copied as a whole on capture and restore. Longer patterns are
+     * supported by libjst::blocked_myers_matcher.
+     */
+    class myers_matcher {
+    public:
+
+        //!\brief The captured state, i.e. the last column of the dynamic programming matrix.
+        struct state_type {
+            uint64_t vp{~uint64_t{0}}; //!< The positive vertical deltas.
+            uint64_t vn{}; //!< The negative vertical deltas.
+            uint64_t score{}; //!< The edit distance of the last row.
+
+            constexpr friend bool operator==(state_type const &, state_type const &) noexcept = default;
+        };
+
+    private:
+
+        static constexpr std::size_t max_pattern_size = 64;
+
+        std::array<uint64_t, 256> _peq{};
+        uint64_t _last_row{};
+        std::size_t _size{};
+        std::size_t _max_errors{};
+        state_type _state{};
+
+    public:
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        myers_matcher() = default; //!< Default.
+
+        /*!\brief Constructs the matcher for the given pattern and error bound.
+         *
+         * \param[in] pattern The pattern to search.
+         * \param[in] max_errors The maximal number of edits of a hit.
+         *
+         * \details
+         *
+         * Throws std::length_error if the pattern is longer than 64 symbols.
+         */
+        template <std::ranges::forward_range pattern_t>
+            requires std::convertible_to<std::ranges::range_reference_t<pattern_t>, char>
+        myers_matcher(pattern_t && pattern, std::size_t const max_errors) :
+            _size{static_cast<std::size_t>(std::ranges::distance(pattern))},
+            _max_errors{max_errors}
+        {
+            if (_size > max_pattern_size)
+                throw std::length_error{"The myers matcher supports patterns of at most 64 symbols."};
+
+            std::size_t i = 0;
+            for (char const symbol : pattern)
+                _peq[static_cast<unsigned char>(symbol)] |= uint64_t{1} << i++;
+
+            _last_row = (_size == 0) ? 0 : uint64_t{1} << (_size - 1);
+            reset();
+        }
+        //!\}
+
+        constexpr std::size_t window_size() const noexcept {
+            return (_size == 0) ? 0 : _size + _max_errors;
+        }
+
+        //!\brief Returns the maximal number of edits of a hit.
+        constexpr std::size_t max_errors() const noexcept {
+            return _max_errors;
+        }
+
+        //!\brief Returns the edit distance of the best occurrence ending at the last consumed symbol.
+        constexpr std::size_t score() const noexcept {
+            return _state.score;
+        }
+
+        /*!\brief Returns a lower bound of the score of every hit continuing the occurrences of the current state.
+         *
+         * \details
+         *
+         * The scores along an alignment do not decrease, hence a hit extending one of the alignments of the last
+         * column has at least the minimal distance of the rows of this column. Only the occurrences beginning after
+         * the last consumed symbol can score less.
+         */
+        constexpr std::size_t lower_bound() const noexcept {
+            std::size_t row_score = 0;
+            std::size_t bound = _state.score;
+            for (std::size_t row = 0; row < _size; ++row) {
+                row_score += (_state.vp >> row) & 1;
+                row_score -= (_state.vn >> row) & 1;
+                bound = std::min(bound, row_score);
+            }
+            return bound;
+        }
+
+        //!\brief Searches the haystack and invokes the callback with the iterator to the last symbol of every hit.
+        template <std::ranges::input_range haystack_t, typename callback_t>
+        constexpr void operator()(haystack_t && haystack, callback_t && callback) {
+            if (_size == 0)
+                return;
+
+            // Keep the state in registers while scanning the haystack.
+            auto [vp, vn, score] = _state;
+            for (auto it = std::ranges::begin(haystack); it != std::ranges::end(haystack); ++it) {
+                uint64_t const eq = _peq[static_cast<unsigned char>(*it)];
+                uint64_t const xv = eq | vn;
+                uint64_t const xh = (((eq & vp) + vp) ^ vp) | eq;
+                uint64_t ph = vn | ~(xh | vp);
+                uint64_t mh = vp & xh;
+
+                score += ((ph & _last_row) != 0);
+                score -= ((mh & _last_row) != 0);
+
+                ph <<= 1; // the first row is zero, i.e. an occurrence may start anywhere
+                mh <<= 1;
+                vp = mh | ~(xv | ph);
+                vn = ph & xv;
+
+                if (score <= _max_errors) {
+                    _state = state_type{vp, vn, score};
+                    callback(it);
+                }
+            }
+            _state = state_type{vp, vn, score};
+        }
+
+        constexpr state_type capture() const noexcept {
+            return _state;
+        }
+
+        constexpr void restore(state_type const & state) noexcept {
+            _state = state;
+        }
+
+        //!\brief Resets the state as if no symbol was consumed.
+        constexpr void reset() noexcept {
+            _state = state_type{.vp = ~uint64_t{0}, .vn = 0, .score = _size};
+        }
+    };
+}  // namespace libjst
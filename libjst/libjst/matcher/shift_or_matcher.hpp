@@ -0,0 +1,203 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides an exact bit-parallel shift-or matcher.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+
+#include <libjst/matcher/concept.hpp>
+
+namespace libjst
+{
+    /*!\brief Finds the exact occurrences of a pattern of at most 64 symbols with the shift-or algorithm.
+     *
+     * \details
+     *
+     * The state is a single word whose bit `i` is cleared if the last `i + 1` symbols match the prefix of the pattern
+     * of the same length. Hence, capturing and restoring the state for the libjst::state_capture_traverser copies one
+     * word. Besides ranges of characters, the matcher consumes sequences modelling libjst::packed_dna_range, reading
+     * 32 bases per word load. Symbols of the packed sequence that are not one of 'A', 'C', 'G', 'T' never match.
+     */
+    class shift_or_matcher {
+    private:
+
+        static constexpr std::size_t max_pattern_size = 64;
+
+        std::array<uint64_t, 256> _masks{};
+        std::array<uint64_t, 4> _rank_masks{};
+        uint64_t _hit_mask{};
+        uint64_t _state{~uint64_t{0}};
+        std::size_t _size{};
+
+    public:
+
+        using state_type = uint64_t; //!< The captured state.
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        shift_or_matcher() = default; //!< Default.
+
+        /*!\brief Constructs the matcher for the given pattern.
+         *
+         * \param[in] pattern The pattern to search.
+         *
+         * \details
+         *
+         * Throws std::length_error if the pattern is longer than 64 symbols.
+         */
+        template <std::ranges::forward_range pattern_t>
+            requires std::convertible_to<std::ranges::range_reference_t<pattern_t>, char>
+        explicit shift_or_matcher(pattern_t && pattern) : _size{static_cast<std::size_t>(std::ranges::distance(pattern))}
+        {
+            if (_size > max_pattern_size)
+                throw std::length_error{"The shift-or matcher supports patterns of at most 64 symbols."};
+
+            _masks.fill(~uint64_t{0});
+            std::size_t i = 0;
+            for (char const symbol : pattern)
+                _masks[static_cast<unsigned char>(symbol)] &= ~(uint64_t{1} << i++);
+
+            _rank_masks = {_masks['A'], _masks['C'], _masks['G'], _masks['T']};
+            _hit_mask = (_size == 0) ? 0 : uint64_t{1} << (_size - 1);
+        }
+        //!\}
+
+        constexpr std::size_t window_size() const noexcept {
+            return _size;
+        }
+
+        //!\brief Searches the haystack and invokes the callback with the iterator to the last symbol of every hit.
+        template <std::ranges::input_range haystack_t, typename callback_t>
+            requires (!packed_dna_range<std::remove_cvref_t<haystack_t>>)
+        constexpr void operator()(haystack_t && haystack, callback_t && callback) {
+            if (_size == 0)
+                return;
+
+            for (auto it = std::ranges::begin(haystack); it != std::ranges::end(haystack); ++it) {
+                _state = (_state << 1) | _masks[static_cast<unsigned char>(*it)];
+                if ((_state & _hit_mask) == 0)
+                    callback(it);
+            }
+        }
+
+        //!\brief Searches the packed haystack and invokes the callback with the position of the last symbol of every hit.
+        template <packed_dna_range haystack_t, typename callback_t>
+        constexpr void operator()(haystack_t const & haystack, callback_t && callback) {
+            if (_size == 0)
+                return;
+
+            constexpr std::size_t bases_per_word = 32;
+            std::size_t const size = haystack.size();
+
+            auto run_it = std::ranges::begin(haystack.runs());
+            auto run_end = std::ranges::end(haystack.runs());
+            auto masked_begin = [&] () -> std::size_t { return (run_it != run_end) ? run_it->position : size; };
+            std::size_t next_masked = masked_begin();
+
+            for (std::size_t block = 0; block < size; block += bases_per_word) {
+                uint64_t word = haystack.word_at(block);
+                std::size_t const block_end = std::min(block + bases_per_word, size);
+                for (std::size_t position = block; position < block_end; ++position, word >>= 2) {
+                    _state = (_state << 1) | _rank_masks[word & 0b11];
+                    if (position < next_masked) {
+                        if ((_state & _hit_mask) == 0)
+                            callback(position);
+                    } else { // the symbol is not a dna base and resets the state.
+                        _state = ~uint64_t{0};
+                        if (position + 1 == run_it->position + run_it->length) {
+                            ++run_it;
+                            next_masked = masked_begin();
+                        }
+                    }
+                }
+            }
+        }
+
+        /*!\brief Searches several haystacks at once, one lane per haystack, see libjst::lockstep_matcher.
+         *
+         * \param[in, out] states The state of every lane, which is updated to the state after its haystack.
+         * \param[in] haystacks The haystack of every lane.
+         * \param[in] callback The callback invoked with the lane and the iterator to the last symbol of every hit.
+         *
+         * \details
+         *
+         * The lanes are processed in blocks of eight, such that the state updates of one block, which have no
+         * dependencies between the lanes, are compiled to vector instructions. The state of the matcher is not changed.
+         */
+        template <std::ranges::random_access_range haystacks_t, typename callback_t>
+            requires std::ranges::random_access_range<std::ranges::range_reference_t<haystacks_t>>
+        constexpr void search_lanes(std::span<state_type> states,
+                                    haystacks_t && haystacks,
+                                    callback_t && callback) const {
+            using haystack_iterator_t = std::ranges::iterator_t<std::ranges::range_reference_t<haystacks_t>>;
+            constexpr std::size_t block_lanes = 8;
+
+            if (_size == 0)
+                return;
+
+            for (std::size_t first_lane = 0; first_lane < states.size(); first_lane += block_lanes) {
+                std::size_t const lane_count = std::min(block_lanes, states.size() - first_lane);
+                std::array<uint64_t, block_lanes> lane_states{};
+                std::array<std::size_t, block_lanes> lane_sizes{};
+                std::array<haystack_iterator_t, block_lanes> lane_begins{};
+                std::size_t max_size{};
+                for (std::size_t lane = 0; lane < lane_count; ++lane) {
+                    auto && haystack = std::ranges::begin(haystacks)[first_lane + lane];
+                    lane_states[lane] = states[first_lane + lane];
+                    lane_sizes[lane] = std::ranges::size(haystack);
+                    lane_begins[lane] = std::ranges::begin(haystack);
+                    max_size = std::max(max_size, lane_sizes[lane]);
+                }
+
+                for (std::size_t position = 0; position < max_size; ++position) {
+                    uint64_t hit_lanes{};
+                    for (std::size_t lane = 0; lane < block_lanes; ++lane) {
+                        bool const active = position < lane_sizes[lane];
+                        auto const offset = static_cast<std::ptrdiff_t>(position);
+                        unsigned char const symbol = active ? static_cast<unsigned char>(lane_begins[lane][offset]) : 0;
+                        uint64_t const next_state = (lane_states[lane] << 1) | _masks[symbol];
+                        lane_states[lane] = active ? next_state : lane_states[lane];
+                        hit_lanes |= static_cast<uint64_t>(active && (next_state & _hit_mask) == 0) << lane;
+                    }
+
+                    for (; hit_lanes != 0; hit_lanes &= hit_lanes - 1) {
+                        std::size_t const lane = std::countr_zero(hit_lanes);
+                        callback(first_lane + lane, lane_begins[lane] + static_cast<std::ptrdiff_t>(position));
+                    }
+                }
+
+                std::ranges::copy_n(lane_states.begin(), lane_count, states.begin() + first_lane);
+            }
+        }
+
+        constexpr state_type capture() const noexcept {
+            return _state;
+        }
+
+        constexpr void restore(state_type const state) noexcept {
+            _state = state;
+        }
+
+        //!\brief Resets the state as if no symbol was consumed.
+        constexpr void reset() noexcept {
+            _state = ~uint64_t{0};
+        }
+    };
+}  // namespace libjst
@@ -0,0 +1,75 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::static_window_matcher.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <libjst/matcher/concept.hpp>
+
+namespace libjst
+{
+    /*!\brief Fixes the window size of a matcher at compile time.
+     *
+     * \tparam matcher_t The adapted matcher type; must model libjst::window_matcher.
+     * \tparam window_size_v The window size of every matcher of this type; must not be 0.
+     *
+     * \details
+     *
+     * Behaves like the adapted matcher, but advertises its window size as libjst::static_window_size_v. The
+     * traversers then instantiate the trimmed and left extended search trees with the left extension as template
+     * parameter, such that the extension is neither stored in every node nor loaded when the labels are computed.
+     * This pays off for applications searching many patterns of a few fixed lengths, e.g. reads of 150 bases or
+     * guides of 23 bases, which instantiate one pipeline per length.
+     */
+    template <window_matcher matcher_t, std::size_t window_size_v>
+        requires (window_size_v > 0)
+    class static_window_matcher : public matcher_t {
+    public:
+
+        //!\brief The window size known at compile time.
+        static constexpr std::size_t static_window_size = window_size_v;
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        static_window_matcher() = default; //!< Default.
+
+        /*!\brief Constructs the adapted matcher from the given arguments.
+         *
+         * \param[in] args The arguments to construct the adapted matcher with.
+         *
+         * \details
+         *
+         * Throws std::invalid_argument if the window size of the constructed matcher differs from `window_size_v`.
+         */
+        template <typename ...args_t>
+            requires (sizeof...(args_t) > 0) && std::constructible_from<matcher_t, args_t...>
+        explicit static_window_matcher(args_t && ...args) : matcher_t((args_t &&)args...)
+        {
+            auto const actual_size = libjst::window_size(static_cast<matcher_t const &>(*this));
+            if (static_cast<std::size_t>(actual_size) != window_size_v)
+                throw std::invalid_argument{"The window size " + std::to_string(actual_size) + " of the matcher "
+                                            "differs from the static window size " + std::to_string(window_size_v) +
+                                            "!"};
+        }
+        //!\}
+
+        //!\brief Returns the static window size.
+        static constexpr std::size_t window_size() noexcept {
+            return window_size_v;
+        }
+    };
+}  // namespace libjst
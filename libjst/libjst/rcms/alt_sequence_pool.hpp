@@ -0,0 +1,176 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides a pool storing distinct alternate sequences in one contiguous buffer.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ranges>
+#include <span>
+#include <tuple>
+#include <unordered_map>
+#include <vector>
+
+#include <cereal/types/vector.hpp>
+
+#include <libjst/utility/memory_usage.hpp>
+
+namespace libjst
+{
+
+    //!\brief Refers to a sequence stored in a libjst::alt_sequence_pool by its offset and size.
+    struct alt_sequence_slice {
+        uint64_t offset{}; //!< The offset of the first symbol in the pool.
+        uint64_t size{}; //!< The number of symbols.
+
+        static constexpr bool raw_serialisable = true; //!< Bulk archived by the libjst::raw_binary_output_archive.
+
+        constexpr friend bool operator==(alt_sequence_slice const &, alt_sequence_slice const &) noexcept = default;
+
+        template <typename archive_t>
+        void serialize(archive_t & archive)
+        {
+            archive(offset, size);
+        }
+    };
+
+    /*!\brief Interns alternate sequences such that every distinct sequence is stored once.
+     *
+     * \tparam value_t The symbol type of the sequences.
+     *
+     * \details
+     *
+     * All distinct sequences are appended to one contiguous buffer and are referred to by a libjst::alt_sequence_slice.
+     * Interning a sequence that is already contained returns the slice of the stored sequence, such that recurrent
+     * alternate sequences of different variants share their symbols. The lookup table for interning is not serialised
+     * but rebuilt when the pool is loaded; the buffer itself is written as a single block.
+     *
+     * Interning a new sequence may reallocate the buffer and invalidates all sequences returned by operator[].
+     */
+    template <typename value_t>
+    class alt_sequence_pool {
+    private:
+
+        std::vector<value_t> _buffer{};
+        std::unordered_multimap<std::size_t, alt_sequence_slice> _lookup{};
+
+    public:
+
+        using value_type = value_t;
+        using slice_type = alt_sequence_slice;
+        using sequence_type = std::span<value_t const>;
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        alt_sequence_pool() = default; //!< Default.
+        //!\}
+
+        /*!\brief Stores the given sequence if it is not yet contained.
+         *
+         * \param[in] sequence The sequence to intern.
+         *
+         * \returns The slice of the stored sequence equal to the given one.
+         */
+        template <std::ranges::forward_range sequence_t>
+            requires std::convertible_to<std::ranges::range_reference_t<sequence_t>, value_t>
+        slice_type intern(sequence_t && sequence) {
+            std::size_t const hash = hash_of(sequence);
+            auto [first, last] = _lookup.equal_range(hash);
+            for (; first != last; ++first)
+                if (std::ranges::equal((*this)[first->second], sequence))
+                    return first->second;
+
+            slice_type slice{.offset = _buffer.size(), .size = static_cast<uint64_t>(std::ranges::distance(sequence))};
+            _buffer.insert(_buffer.end(), std::ranges::begin(sequence), std::ranges::end(sequence));
+            _lookup.emplace(hash, slice);
+            return slice;
+        }
+
+        //!\brief Returns the sequence referred to by the given slice.
+        constexpr sequence_type operator[](slice_type const & slice) const noexcept {
+            return sequence_type{_buffer.data() + slice.offset, static_cast<std::size_t>(slice.size)};
+        }
+
+        //!\brief Returns the number of distinct sequences.
+        constexpr std::size_t size() const noexcept {
+            return _lookup.size();
+        }
+
+        constexpr bool empty() const noexcept {
+            return _lookup.empty();
+        }
+
+        /*!\brief Returns the number of bytes allocated for the symbols and the lookup table.
+         *
+         * \details
+         *
+         * The memory of the lookup table is estimated from its buckets and nodes, assuming a singly linked node
+         * storing the cached hash next to the entry.
+         */
+        std::size_t memory_usage() const noexcept {
+            using node_type = std::tuple<void *, std::size_t, typename decltype(_lookup)::value_type>;
+            return libjst::memory_usage(_buffer) +
+                   _lookup.bucket_count() * sizeof(void *) +
+                   _lookup.size() * sizeof(node_type);
+        }
+
+        //!\brief Returns the buffer storing the symbols of all distinct sequences.
+        constexpr sequence_type data() const noexcept {
+            return _buffer;
+        }
+
+        void clear() noexcept {
+            _buffer.clear();
+            _lookup.clear();
+        }
+
+        // ----------------------------------------------------------------------------
+        // Serialisation
+        // ----------------------------------------------------------------------------
+
+        template <typename archive_t>
+        void load(archive_t & iarchive)
+        {
+            std::vector<slice_type> slices{};
+            iarchive(_buffer, slices);
+
+            _lookup.clear();
+            _lookup.reserve(slices.size());
+            for (slice_type const & slice : slices)
+                _lookup.emplace(hash_of((*this)[slice]), slice);
+        }
+
+        template <typename archive_t>
+        void save(archive_t & oarchive) const
+        {
+            std::vector<slice_type> slices{};
+            slices.reserve(_lookup.size());
+            for (auto && entry : _lookup)
+                slices.push_back(entry.second);
+            std::ranges::sort(slices, std::ranges::less{}, &slice_type::offset);
+            oarchive(_buffer, slices);
+        }
+
+    private:
+
+        template <typename sequence_t>
+        static std::size_t hash_of(sequence_t && sequence) {
+            std::size_t hash = std::ranges::distance(sequence);
+            for (auto && symbol : sequence)
+                hash ^= std::hash<value_t>{}(symbol) + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+            return hash;
+        }
+    };
+}  // namespace libjst
@@ -0,0 +1,506 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides a block compressed archive of the mapped layout of a store, compressed in parallel.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <unistd.h>
+
+#include <libjst/rcms/mapped_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/serialisation/raw_archive.hpp>
+#include <libjst/utility/lz_block_codec.hpp>
+#include <libjst/utility/parallel_for_each_job.hpp>
+
+namespace libjst
+{
+    //!\brief The options of libjst::save_block_compressed.
+    struct block_compression_options {
+        std::size_t block_size{std::size_t{1} << 20}; //!< The number of uncompressed bytes per block.
+        std::size_t thread_count{std::thread::hardware_concurrency()}; //!< The number of compressing threads.
+    };
+
+    namespace detail
+    {
+        //!\brief The header of a block compressed archive, which is followed by the block index and the blocks.
+        struct block_compressed_header {
+            static constexpr std::array<char, 8> expected_magic{'L', 'I', 'B', 'J', 'S', 'T', 'B', 'C'};
+            static constexpr uint32_t current_version{1};
+            static constexpr uint32_t expected_byte_order{0x01020304};
+
+            std::array<char, 8> magic{expected_magic};
+            uint32_t version{current_version};
+            uint32_t byte_order{expected_byte_order};
+            uint64_t layout_size{}; // number of bytes of the uncompressed mapped layout
+            uint64_t block_size{};
+            uint64_t block_count{};
+        };
+
+        //!\brief An entry of the block index.
+        struct block_compressed_entry {
+            uint64_t compressed_size{};
+            uint64_t checksum{}; // of the uncompressed bytes
+            uint32_t is_stored{}; // whether the block is stored uncompressed as it did not shrink
+            uint32_t reserved{};
+        };
+
+        inline uint64_t block_checksum(std::span<std::byte const> bytes) noexcept {
+            raw_archive_checksum checksum{};
+            checksum.update(bytes.data(), bytes.size());
+            return checksum.value();
+        }
+    } // namespace detail
+
+    /*!\brief Writes the variants of the store as block compressed mapped layout.
+     *
+     * \param[in] ostream The binary output stream to write to.
+     * \param[in] store The store to write.
+     * \param[in] options The block size and the number of threads compressing the blocks.
+     *
+     * \details
+     *
+     * The mapped layout written by libjst::save_mapped, i.e. the source, the breakend keys, the coverage words, the
+     * indel links and the inserted sequences, is split into blocks of `options.block_size` bytes, which are compressed
+     * independently with libjst::lz_block_codec on `options.thread_count` threads. The archive stores an index of
+     * the compressed blocks, such that libjst::block_compressed_layout can decompress the blocks in parallel or only
+     * the blocks needed for a region. The sparse coverage words compress to a small fraction of their size.
+     *
+     * Throws std::invalid_argument if the block size is zero or not a multiple of eight and std::runtime_error if
+     * writing to the stream fails.
+     */
+    template <typename source_t, typename cms_t>
+    void save_block_compressed(std::ostream & ostream,
+                               rcs_store<source_t, cms_t> const & store,
+                               block_compression_options const & options = {}) {
+        if (options.block_size == 0 || options.block_size % 8 != 0)
+            throw std::invalid_argument{"The block size must be a positive multiple of eight."};
+
+        std::ostringstream layout_stream{};
+        save_mapped(layout_stream, store);
+        std::string const layout = std::move(layout_stream).str();
+        std::span<std::byte const> const layout_bytes = std::as_bytes(std::span{layout});
+
+        detail::block_compressed_header header{};
+        header.layout_size = layout_bytes.size();
+        header.block_size = options.block_size;
+        header.block_count = (header.layout_size + header.block_size - 1) / header.block_size;
+
+        std::vector<detail::block_compressed_entry> entries(header.block_count);
+        std::vector<std::vector<std::byte>> blocks(header.block_count);
+        detail::parallel_for_each_job(header.block_count, options.thread_count, [&] (std::size_t const block) {
+            std::span<std::byte const> const bytes = layout_bytes.subspan(block * header.block_size).first(
+                std::min<std::size_t>(header.block_size, header.layout_size - block * header.block_size));
+            lz_block_codec::compress(bytes, blocks[block]);
+            if (blocks[block].size() >= bytes.size()) {
+                blocks[block].assign(bytes.begin(), bytes.end());
+                entries[block].is_stored = 1;
+            }
+            entries[block].compressed_size = blocks[block].size();
+            entries[block].checksum = detail::block_checksum(bytes);
+        });
+
+        ostream.write(reinterpret_cast<char const *>(&header), sizeof(header));
+        ostream.write(reinterpret_cast<char const *>(entries.data()),
+                      static_cast<std::streamsize>(entries.size() * sizeof(detail::block_compressed_entry)));
+        for (std::vector<std::byte> const & block : blocks)
+            ostream.write(reinterpret_cast<char const *>(block.data()), static_cast<std::streamsize>(block.size()));
+
+        if (!ostream)
+            throw std::runtime_error{"Could not write the block compressed store."};
+    }
+
+    /*!\brief Reads the given number of bytes at the given offset of an archive, e.g. by an HTTP range request.
+     *
+     * \details
+     *
+     * The reader is invoked as `reader(offset, bytes)` and must fill all of `bytes` with the bytes of the archive
+     * beginning at `offset`, e.g. by a request with the header `Range: bytes=offset-(offset + bytes.size() - 1)` to an
+     * S3-compatible object store. It must throw if the bytes can not be read, e.g. if the range exceeds the archive,
+     * and it is invoked concurrently by the threads of a libjst::block_compressed_layout.
+     */
+    using byte_range_reader = std::function<void(uint64_t, std::span<std::byte>)>;
+
+    /*!\brief Decompresses the blocks of an archive written by libjst::save_block_compressed on demand.
+     *
+     * \details
+     *
+     * The index of the blocks is read on construction, while the blocks are read when they are decompressed, either
+     * from a stream, which must hence outlive the layout and support seeking, or by a libjst::byte_range_reader. The
+     * decompressed blocks are kept in an aligned buffer of the size of the mapped layout, which is used by
+     * libjst::mapped_compressed_multisequence once the required blocks are decompressed, see
+     * libjst::load_block_compressed and libjst::load_block_compressed_region. The pages of the buffer are only
+     * touched by the decompressed blocks, such that loading a region of a large archive occupies the memory of the
+     * blocks of the region only.
+     *
+     * A stream is read sequentially and the read blocks are decompressed in parallel. A range reader is invoked by
+     * every decompressing thread for its own block, such that as many requests as threads are in flight, which hides
+     * the latency of a remote archive. The fetched blocks can further be kept in a local block cache, see
+     * set_block_cache, to avoid fetching them again in later processes.
+     *
+     * Throws std::runtime_error if the archive is invalid, the stream fails or a block does not match its checksum.
+     */
+    class block_compressed_layout {
+    private:
+
+        using header_type = detail::block_compressed_header;
+        using entry_type = detail::block_compressed_entry;
+
+        std::istream * _stream{};
+        byte_range_reader _reader{}; // used if no stream is given
+        std::filesystem::path _cache_directory{}; // optional, see set_block_cache
+        header_type _header{};
+        std::vector<entry_type> _entries{};
+        std::vector<uint64_t> _block_offsets{}; // stream positions of the compressed blocks
+        std::unique_ptr<uint64_t[]> _words{}; // the aligned buffer of the layout, whose pages are touched on demand
+        std::vector<bool> _decompressed{};
+        std::size_t _thread_count{};
+        std::size_t _fetched_bytes{};
+
+    public:
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        block_compressed_layout() = delete; //!< Deleted.
+
+        /*!\brief Reads the index of the archive stored in the given stream.
+         *
+         * \param[in] istream The seekable binary input stream positioned at the beginning of the archive.
+         * \param[in] thread_count The number of threads decompressing the blocks.
+         */
+        explicit block_compressed_layout(std::istream & istream,
+                                         std::size_t const thread_count = std::thread::hardware_concurrency()) :
+            _stream{&istream},
+            _thread_count{std::max<std::size_t>(thread_count, 1)}
+        {
+            read_index(static_cast<uint64_t>(_stream->tellg()));
+        }
+
+        /*!\brief Reads the index of the archive by the given range reader, e.g. from an object store.
+         *
+         * \param[in] reader The reader of the archive, which is invoked concurrently.
+         * \param[in] thread_count The number of threads fetching and decompressing the blocks, i.e. the maximal
+         *                         number of reads in flight.
+         */
+        explicit block_compressed_layout(byte_range_reader reader,
+                                         std::size_t const thread_count = std::thread::hardware_concurrency()) :
+            _reader{std::move(reader)},
+            _thread_count{std::max<std::size_t>(thread_count, 1)}
+        {
+            read_index(0);
+        }
+        //!\}
+
+        /*!\brief Keeps the fetched compressed blocks in the given directory and reads the blocks cached there.
+         *
+         * \details
+         *
+         * A cached block is named by the checksum and the size of its compressed bytes, such that the cache can be
+         * shared by all archives and processes and never serves a block of a modified archive. A cached block whose
+         * checksum does not match is fetched again. The cache is only used by a layout reading by a range reader,
+         * since a stream is read from local storage already. The directory is created if it does not exist.
+         */
+        void set_block_cache(std::filesystem::path directory) {
+            std::filesystem::create_directories(directory);
+            _cache_directory = std::move(directory);
+        }
+
+        //!\brief Returns the number of compressed bytes read from the stream or the range reader so far.
+        constexpr std::size_t fetched_bytes() const noexcept {
+            return _fetched_bytes;
+        }
+
+        constexpr std::size_t block_count() const noexcept {
+            return _entries.size();
+        }
+
+
+        constexpr std::size_t block_size() const noexcept {
+            return _header.block_size;
+        }
+
+        //!\brief Returns the number of bytes of the uncompressed layout.
+        constexpr std::size_t layout_size() const noexcept {
+            return _header.layout_size;
+        }
+
+        //!\brief Returns the number of compressed bytes of the block.
+        constexpr std::size_t compressed_size(std::size_t const block) const noexcept {
+            return _entries[block].compressed_size;
+        }
+
+        bool is_decompressed(std::size_t const block) const noexcept {
+            return _decompressed[block];
+        }
+
+        //!\brief Decompresses the blocks overlapping the given byte interval of the layout in parallel.
+        void decompress(std::size_t const first, std::size_t const last) {
+            std::size_t const clamped_last = std::min(last, layout_size());
+            if (first >= clamped_last)
+                return;
+
+            std::vector<std::size_t> pending{};
+            for (std::size_t block = first / block_size(); block <= (clamped_last - 1) / block_size(); ++block)
+                if (!_decompressed[block])
+                    pending.push_back(block);
+
+            // A stream is read sequentially, while a range reader fetches the blocks in the decompressing threads.
+            std::vector<std::vector<std::byte>> compressed(pending.size());
+            std::vector<std::size_t> fetched(pending.size());
+            std::vector<uint8_t> is_cached(pending.size()); // written concurrently
+            auto fetch_job = [&] (std::size_t const job) {
+                is_cached[job] = read_cached_block(pending[job], compressed[job]);
+                if (!is_cached[job])
+                    fetched[job] = fetch_block(pending[job], compressed[job]);
+            };
+            if (_stream != nullptr)
+                for (std::size_t job = 0; job < pending.size(); ++job)
+                    fetch_job(job);
+
+            detail::parallel_for_each_job(pending.size(), _thread_count, [&] (std::size_t const job) {
+                std::size_t const block = pending[job];
+                if (_stream == nullptr)
+                    fetch_job(job);
+
+                if (is_cached[job]) {
+                    bool is_valid{false};
+                    try {
+                        is_valid = decompress_block(block, compressed[job]);
+                    } catch (std::runtime_error const &) {
+                    }
+                    if (is_valid)
+                        return;
+                    fetched[job] = fetch_block(block, compressed[job]); // a corrupted cached block is fetched again
+                }
+
+                if (!decompress_block(block, compressed[job]))
+                    throw std::runtime_error{"The checksum of a block of the block compressed store does not match."};
+                write_cached_block(block, compressed[job]);
+            });
+
+            for (std::size_t const block : pending)
+                _decompressed[block] = true;
+            for (std::size_t const byte_count : fetched)
+                _fetched_bytes += byte_count;
+        }
+
+        //!\brief Decompresses all blocks in parallel.
+        void decompress() {
+            decompress(0, layout_size());
+        }
+
+        /*!\brief Returns the bytes of the layout, which are only valid within the decompressed blocks.
+         *
+         * \details
+         *
+         * The bytes are aligned to eight bytes and remain valid as long as the layout.
+         */
+        std::span<std::byte const> bytes() const noexcept {
+            return std::as_bytes(std::span{_words.get(), word_count()}).first(layout_size());
+        }
+
+    private:
+
+        constexpr std::size_t word_count() const noexcept {
+            return (layout_size() + 7) / 8;
+        }
+
+        // Reads the header and the block index, which begin at the given offset of the archive.
+        void read_index(uint64_t const archive_offset) {
+            read(archive_offset, &_header, sizeof(header_type));
+            if (_header.magic != header_type::expected_magic)
+                throw std::runtime_error{"The given data is no block compressed store."};
+            if (_header.version != header_type::current_version)
+                throw std::runtime_error{"Unsupported version " + std::to_string(_header.version) +
+                                         " of the block compressed store."};
+            if (_header.byte_order != header_type::expected_byte_order)
+                throw std::runtime_error{"The block compressed store was written with a different byte order."};
+            if (_header.block_size == 0 || _header.block_size % 8 != 0 ||
+                _header.block_count != (_header.layout_size + _header.block_size - 1) / _header.block_size)
+                throw std::runtime_error{"The block index of the block compressed store is corrupted."};
+
+            _entries.resize(_header.block_count);
+            read(archive_offset + sizeof(header_type), _entries.data(), _entries.size() * sizeof(entry_type));
+
+            _block_offsets.reserve(_entries.size());
+            uint64_t offset = archive_offset + sizeof(header_type) + _entries.size() * sizeof(entry_type);
+            for (entry_type const & entry : _entries) {
+                _block_offsets.push_back(offset);
+                offset += entry.compressed_size;
+            }
+            _words = std::make_unique_for_overwrite<uint64_t[]>(word_count());
+            _decompressed.resize(_entries.size());
+        }
+
+        // Reads the compressed block from the stream or the range reader and returns the number of read bytes.
+        std::size_t fetch_block(std::size_t const block, std::vector<std::byte> & compressed) {
+            compressed.resize(_entries[block].compressed_size);
+            read(_block_offsets[block], compressed.data(), compressed.size());
+            return compressed.size();
+        }
+
+        // Decompresses the block into the buffer and returns whether it matches its checksum.
+        bool decompress_block(std::size_t const block, std::span<std::byte const> compressed) {
+            std::span<std::byte> const buffer = std::as_writable_bytes(std::span{_words.get(), word_count()});
+            std::span<std::byte> const bytes = buffer.subspan(block * block_size()).first(
+                std::min<std::size_t>(block_size(), layout_size() - block * block_size()));
+            if (_entries[block].is_stored) {
+                if (compressed.size() != bytes.size())
+                    throw std::runtime_error{"The block index of the block compressed store is corrupted."};
+                std::ranges::copy(compressed, bytes.begin());
+            } else {
+                lz_block_codec::decompress(compressed, bytes);
+            }
+            return detail::block_checksum(bytes) == _entries[block].checksum;
+        }
+
+        std::filesystem::path cached_block_path(std::size_t const block) const {
+            return _cache_directory / (std::to_string(_entries[block].checksum) + "_" +
+                                       std::to_string(_entries[block].compressed_size) + ".blk");
+        }
+
+        // Reads the block from the cache and returns whether it was cached.
+        bool read_cached_block(std::size_t const block, std::vector<std::byte> & compressed) const {
+            if (_cache_directory.empty() || _stream != nullptr)
+                return false;
+
+            std::ifstream cached{cached_block_path(block), std::ios::binary};
+            if (!cached)
+                return false;
+            compressed.resize(_entries[block].compressed_size);
+            cached.read(reinterpret_cast<char *>(compressed.data()), static_cast<std::streamsize>(compressed.size()));
+            return static_cast<std::size_t>(cached.gcount()) == compressed.size();
+        }
+
+        // Writes the fetched block to the cache under a temporary name, which is renamed such that concurrent
+        // processes never read a partially written block. A failure to write the cache is ignored.
+        void write_cached_block(std::size_t const block, std::span<std::byte const> compressed) const {
+            if (_cache_directory.empty() || _stream != nullptr)
+                return;
+
+            std::filesystem::path const cached_path = cached_block_path(block);
+            std::filesystem::path temporary_path{cached_path};
+            temporary_path += ".tmp" + std::to_string(::getpid()) + "_" + std::to_string(block);
+            {
+                std::ofstream cached{temporary_path, std::ios::binary | std::ios::trunc};
+                cached.write(reinterpret_cast<char const *>(compressed.data()),
+                             static_cast<std::streamsize>(compressed.size()));
+                if (!cached.flush())
+                    return;
+            }
+            std::error_code error{};
+            std::filesystem::rename(temporary_path, cached_path, error);
+            if (error)
+                std::filesystem::remove(temporary_path, error);
+        }
+
+        void read(uint64_t const offset, void * data, std::size_t const byte_count) {
+            if (_stream == nullptr) {
+                _reader(offset, std::span{static_cast<std::byte *>(data), byte_count});
+                return;
+            }
+
+            _stream->seekg(static_cast<std::streamoff>(offset));
+            _stream->read(static_cast<char *>(data), static_cast<std::streamsize>(byte_count));
+            if (static_cast<std::size_t>(_stream->gcount()) != byte_count)
+                throw std::runtime_error{"The block compressed store is truncated."};
+        }
+    };
+
+    /*!\brief Loads the store written by libjst::save_block_compressed, decompressing the blocks in parallel.
+     *
+     * \tparam source_t The source type of the loaded store, which must own its characters.
+     * \tparam coverage_store_t The type storing the coverages of the loaded multisequence.
+     * \tparam breakend_position_t The unsigned integer type of the breakend keys the store was written with.
+     *
+     * \details
+     *
+     * Throws std::runtime_error if the archive is invalid or corrupted.
+     */
+    template <typename source_t = std::string,
+              typename coverage_store_t = std::vector<bit_coverage<uint32_t>>,
+              std::unsigned_integral breakend_position_t = uint32_t>
+    auto load_block_compressed(std::istream & istream,
+                               std::size_t const thread_count = std::thread::hardware_concurrency()) {
+        block_compressed_layout layout{istream, thread_count};
+        layout.decompress();
+        mapped_compressed_multisequence<breakend_position_t> multisequence{layout.bytes()};
+        return load_region<source_t, coverage_store_t>(multisequence, 0, std::ranges::size(multisequence.source()));
+    }
+
+    /*!\brief Loads the deltas whose low breakend lies in the given source interval, see libjst::load_region.
+     *
+     * \param[in] layout The layout to load from.
+     * \param[in] first The first source position of the interval.
+     * \param[in] last The source position one past the end of the interval.
+     *
+     * \details
+     *
+     * Only the blocks containing the source, the breakend keys, the indel links and the coverages and inserted
+     * sequences of the selected deltas are decompressed; blocks decompressed by earlier calls are reused.
+     */
+    template <typename source_t = std::string,
+              typename coverage_store_t = std::vector<bit_coverage<uint32_t>>,
+              std::unsigned_integral breakend_position_t = uint32_t>
+    auto load_block_compressed_region(block_compressed_layout & layout,
+                                      std::size_t const first,
+                                      std::size_t const last) {
+        layout.decompress(0, sizeof(mapped_multisequence_header));
+        mapped_multisequence_header const & header =
+            *reinterpret_cast<mapped_multisequence_header const *>(layout.bytes().data());
+        mapped_compressed_multisequence<breakend_position_t> multisequence{layout.bytes()};
+
+        // The source, the keys, needed for the binary search, and the links, needed for the deletion breakpoints.
+        layout.decompress(header.source_offset(), header.coverage_offset());
+        layout.decompress(header.link_offset(), header.insertion_offset());
+
+        auto to_position = [] (auto && delta) -> std::size_t { return libjst::position(delta); };
+        auto region_begin = std::ranges::lower_bound(multisequence, first, std::ranges::less{}, to_position);
+        auto region_end = std::ranges::lower_bound(region_begin, multisequence.end(), last,
+                                                   std::ranges::less{}, to_position);
+        std::size_t const first_breakend = region_begin - multisequence.begin();
+        std::size_t const last_breakend = region_end - multisequence.begin();
+        std::size_t const coverage_bytes = header.coverage_stride * sizeof(uint64_t);
+        layout.decompress(header.coverage_offset() + first_breakend * coverage_bytes,
+                          header.coverage_offset() + last_breakend * coverage_bytes);
+
+        uint64_t const * const links = reinterpret_cast<uint64_t const *>(layout.bytes().data() + header.link_offset());
+        std::size_t insertion_first{header.insertion_size};
+        std::size_t insertion_last{0};
+        for (std::size_t breakend = first_breakend; breakend < last_breakend; ++breakend) {
+            auto const key = multisequence.begin()[breakend].get_key();
+            if (key.is_indel() && key.indel_kind() == indel_breakend_kind::insertion_low) {
+                insertion_first = std::min<std::size_t>(insertion_first, links[2 * breakend]);
+                insertion_last = std::max<std::size_t>(insertion_last, links[2 * breakend] + links[2 * breakend + 1]);
+            }
+        }
+        layout.decompress(header.insertion_offset() + insertion_first, header.insertion_offset() + insertion_last);
+
+        return load_region<source_t, coverage_store_t>(multisequence, first, last);
+    }
+}  // namespace libjst
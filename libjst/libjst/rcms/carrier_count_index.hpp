@@ -0,0 +1,100 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::carrier_count_index.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ranges>
+#include <vector>
+
+#include <libjst/utility/memory_usage.hpp>
+
+namespace libjst
+{
+    /*!\brief The number of haplotypes carrying every breakend of a multisequence.
+     *
+     * \details
+     *
+     * Stores the popcount of the coverage of every breakend, i.e. the allele count of its variant within the cohort,
+     * in the stored order of the breakends. The support of a variant is thus a single lookup instead of a pass over its
+     * coverage, such that libjst::min_support skips the rare variants before any coverage is intersected. Counts that
+     * exceed the count type are saturated.
+     *
+     * The index occupies four bytes per breakend and is a snapshot of the breakends it was built from.
+     */
+    class carrier_count_index {
+    private:
+
+        using count_type = uint32_t;
+
+        std::vector<count_type> _counts{};
+
+    public:
+
+        using size_type = std::size_t;
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        carrier_count_index() = default; //!< Default.
+
+        /*!\brief Builds the index over the carrier counts of the breakends.
+         *
+         * \param[in] carrier_counts The number of haplotypes covering every breakend in the stored order.
+         *
+         * ### Complexity
+         *
+         * Linear in the number of breakends.
+         */
+        template <std::ranges::input_range carrier_counts_t>
+            requires std::unsigned_integral<std::remove_cvref_t<std::ranges::range_reference_t<carrier_counts_t>>>
+        explicit carrier_count_index(carrier_counts_t && carrier_counts)
+        {
+            if constexpr (std::ranges::sized_range<carrier_counts_t>)
+                _counts.reserve(std::ranges::size(carrier_counts));
+
+            for (auto && count : carrier_counts)
+                _counts.push_back(static_cast<count_type>(std::min<std::size_t>(count,
+                                                                   std::numeric_limits<count_type>::max())));
+        }
+        //!\}
+
+        //!\brief Returns the number of haplotypes carrying the breakend at the given position.
+        constexpr size_type operator[](size_type const position) const noexcept {
+            assert(position < size());
+            return _counts[position];
+        }
+
+        //!\brief Returns whether the breakend at the given position is carried by at least the given number of haplotypes.
+        constexpr bool is_supported(size_type const position, size_type const min_support) const noexcept {
+            return (*this)[position] >= min_support;
+        }
+
+        constexpr size_type size() const noexcept {
+            return _counts.size();
+        }
+
+        constexpr bool empty() const noexcept {
+            return _counts.empty();
+        }
+
+        //!\brief Returns the number of bytes allocated for the counts.
+        size_type memory_usage() const noexcept {
+            return libjst::memory_usage(_counts);
+        }
+    };
+}  // namespace libjst
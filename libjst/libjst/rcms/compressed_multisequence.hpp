@@ -12,20 +12,31 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cassert>
 #include <cmath>
+#include <iterator>
+#include <limits>
+#include <optional>
 #include <ranges>
-#include <unordered_map>
+#include <stdexcept>
+#include <vector>
 
 #include <libjst/utility/member_type_trait.hpp>
 #include <libjst/utility/tag_invoke.hpp>
 
 #include <libjst/coverage/concept.hpp>
+#include <libjst/rcms/alt_sequence_pool.hpp>
 #include <libjst/rcms/contiguous_multimap.hpp>
 #include <libjst/rcms/delta_sequence_variant.hpp>
 #include <libjst/rcms/generic_delta.hpp>
+#include <libjst/rcms/indel_index.hpp>
 #include <libjst/rcms/indel_variant.hpp>
+#include <libjst/rcms/interior_breakends.hpp>
 #include <libjst/rcms/packed_breakend_key.hpp>
+#include <libjst/utility/memory_usage.hpp>
 #include <libjst/utility/multi_invocable.hpp>
+#include <libjst/utility/prefetch.hpp>
 
 namespace libjst
 {
@@ -40,7 +51,12 @@ namespace libjst
 
     // requires is_object_v<source_t>
     // requires breakpoint_coverage<coverage_t>
-    template <typename source_t, typename coverage_t>
+    // coverage_store_t holds the coverages of all breakends, e.g. libjst::bit_coverage_pool keeps them in one buffer
+    // and libjst::run_length_coverage_pool keeps them as run-length encoded columns of one coverage matrix.
+    template <typename source_t,
+              typename coverage_t,
+              std::unsigned_integral breakend_position_t = uint32_t,
+              typename coverage_store_t = std::vector<coverage_t>>
     class compressed_multisequence { // TODO: breakend multimap
 
         using value_t = std::ranges::range_value_t<source_t>;
@@ -48,24 +64,22 @@ namespace libjst
 
         // so what is the value type?
         // how can we change the different implementations for static and dynamic?
-        using position_type = uint32_t;
+        using position_type = breakend_position_t;
         using breakend_key_type = packed_breakend_key<position_type>;
-        using breakend_map_type = contiguous_multimap<breakend_key_type, coverage_t>;
+        using breakend_map_type = contiguous_multimap<breakend_key_type, coverage_t, coverage_store_t>;
+        using coverage_reference = std::ranges::range_reference_t<coverage_store_t const>;
 
         using coverage_value_type = std::ranges::range_value_t<coverage_t>;
         using indel_key_type = std::pair<breakend_key_type, coverage_value_type>;
 
-        struct indel_key_hash {
-            constexpr std::size_t operator()(indel_key_type const & key) const noexcept {
-                return std::hash<breakend_key_type>{}(key.first) ^ std::hash<coverage_value_type>{}(key.second);
-            }
-        };
-
-        using deletion_type = deletion_element<std::ranges::iterator_t<breakend_map_type>>;
-        using insertion_type = insertion_element<source_t>;
+        // A deletion links to the position of its mate breakend in the breakend map, which stays valid when the
+        // multisequence is copied, moved or serialised.
+        using deletion_type = deletion_element<typename breakend_map_type::size_type>;
+        using alt_pool_type = alt_sequence_pool<value_t>;
+        using insertion_type = insertion_element<typename alt_pool_type::slice_type>;
         using indel_type = indel_variant<deletion_type, insertion_type>;
 
-        using indel_map_type = std::unordered_map<indel_key_type, indel_type, indel_key_hash>;
+        using indel_map_type = indel_index<indel_key_type, indel_type>;
         using coverage_domain_type = libjst::coverage_domain_t<coverage_t>;
 
         template <bool>
@@ -74,9 +88,33 @@ namespace libjst
         template <typename>
         class delta_proxy;
 
+        //!\brief A breakend collected by the bulk construction before it is stored in the breakend map.
+        struct staged_breakend {
+            breakend_key_type key{};
+            coverage_t coverage{};
+            std::optional<insertion_type> insertion{};
+            std::optional<std::size_t> deletion_mate{}; // index of the staged mate breakend of a deletion
+        };
+
+        //!\brief The serialised form of an indel, which stores the position of a deletion mate in the breakend map.
+        struct indel_record {
+            breakend_key_type key{};
+            coverage_value_type coverage_head{};
+            bool is_deletion{};
+            std::size_t mate_position{};
+            typename alt_pool_type::slice_type insertion{};
+
+            template <typename archive_t>
+            void serialize(archive_t & archive)
+            {
+                archive(key, coverage_head, is_deletion, mate_position, insertion);
+            }
+        };
+
         source_t _source{}; // only links to the source.
         breakend_map_type _breakend_map{};
         indel_map_type _indel_map{};
+        alt_pool_type _alt_pool{}; // stores every distinct inserted sequence once.
         coverage_domain_type _coverage_domain{};
 
     public:
@@ -93,12 +131,178 @@ namespace libjst
             _coverage_domain{std::move(coverage_domain)}
         {
             using position_t = libjst::breakend_t<value_type>;
-            position_t source_size = std::ranges::size(_source);
+            position_t source_size = check_source_size();
             coverage_t def_coverage{std::views::iota(_coverage_domain.min(), _coverage_domain.max()), _coverage_domain};
             _breakend_map.emplace(breakend_key_type{indel_breakend_kind::nil, 0}, def_coverage);
             _breakend_map.emplace(breakend_key_type{indel_breakend_kind::nil, source_size}, def_coverage);
         }
 
+        /*!\brief Constructs the multisequence from a range of deltas in a single pass.
+         *
+         * \param[in] source The source sequence.
+         * \param[in] coverage_domain The coverage domain of all deltas.
+         * \param[in] deltas The deltas to store; should be sorted by their low breakend.
+         *
+         * \details
+         *
+         * In contrast to inserting the deltas one by one, which shifts the stored breakends for every insertion,
+         * all breakends are first appended to a staging buffer and the breakend map is built once in the end.
+         * The low breakends are only sorted if the deltas are not given in sorted order; the high breakends of the
+         * deletions are sorted separately and merged with the low breakends.
+         *
+         * ### Exception
+         *
+         * Throws std::domain_error if the coverage domain of a delta differs from the given coverage domain.
+         *
+         * ### Complexity
+         *
+         * Linear in the number of deltas if they are sorted and there are no deletions, otherwise
+         * \f$O(n \log n)\f$ in the number of unsorted deltas and deletions, respectively.
+         */
+        template <std::ranges::input_range deltas_t>
+            requires std::convertible_to<std::ranges::range_reference_t<deltas_t>, value_type>
+        explicit compressed_multisequence(source_t source, coverage_domain_type coverage_domain, deltas_t && deltas) :
+            _source{std::move(source)},
+            _coverage_domain{std::move(coverage_domain)}
+        {
+            using position_t = libjst::breakend_t<value_type>;
+            position_t source_size = check_source_size();
+            coverage_t def_coverage{std::views::iota(_coverage_domain.min(), _coverage_domain.max()), _coverage_domain};
+
+            std::vector<staged_breakend> staged{};
+            std::vector<std::size_t> low_ids{};
+            std::vector<std::size_t> high_ids{};
+            if constexpr (std::ranges::sized_range<deltas_t>) {
+                staged.reserve(std::ranges::size(deltas) + 2);
+                low_ids.reserve(std::ranges::size(deltas) + 1);
+            }
+
+            auto stage = [&] (std::vector<std::size_t> & ids, breakend_key_type key, coverage_t coverage) -> std::size_t {
+                ids.push_back(staged.size());
+                staged.push_back(staged_breakend{.key = std::move(key), .coverage = std::move(coverage)});
+                return staged.size() - 1;
+            };
+
+            stage(low_ids, breakend_key_type{indel_breakend_kind::nil, 0}, def_coverage);
+            for (auto && delta : deltas) {
+                value_type value = (decltype(delta) &&) delta;
+                if (libjst::get_domain(libjst::coverage(value)) != _coverage_domain)
+                    throw std::domain_error{"Trying to insert an element from a different coverage domain!"};
+
+                detail::delta_kind const kind = select_delta_kind(value);
+                using underlying_kind_t = std::underlying_type_t<detail::delta_kind>;
+                auto has_kind = [&] (detail::delta_kind const query) {
+                    return static_cast<underlying_kind_t>(kind) & static_cast<underlying_kind_t>(query);
+                };
+
+                if (kind == detail::delta_kind::snv) {
+                    stage(low_ids, breakend_key_type{to_snv_code(value), libjst::low_breakend(value)},
+                          libjst::coverage(value));
+                    continue;
+                }
+
+                if (has_kind(detail::delta_kind::insertion)) {
+                    std::size_t id = stage(low_ids,
+                                           breakend_key_type{indel_breakend_kind::insertion_low, libjst::low_breakend(value)},
+                                           libjst::coverage(value));
+                    staged[id].insertion = insertion_type{_alt_pool.intern(libjst::alt_sequence(value))};
+                }
+
+                if (has_kind(detail::delta_kind::deletion)) {
+                    std::size_t low_id = stage(low_ids,
+                                               breakend_key_type{indel_breakend_kind::deletion_low, libjst::low_breakend(value)},
+                                               libjst::coverage(value));
+                    std::size_t high_id = stage(high_ids,
+                                                breakend_key_type{indel_breakend_kind::deletion_high, libjst::high_breakend(value)},
+                                                libjst::coverage(value));
+                    staged[low_id].deletion_mate = high_id;
+                    staged[high_id].deletion_mate = low_id;
+                }
+            }
+            stage(high_ids, breakend_key_type{indel_breakend_kind::nil, source_size}, def_coverage);
+            finalise_breakends(staged, low_ids, high_ids);
+        }
+
+        /*!\brief Constructs the multisequence by merging shards covering disjoint intervals of the same source.
+         *
+         * \param[in] shards The shards to merge; should be ordered by the source intervals they cover.
+         *
+         * \details
+         *
+         * All shards must share the same source and coverage domain. The sentinel breakends of the shards are dropped
+         * and replaced by a single pair of sentinels for the merged multisequence. The source and the coverage domain
+         * are taken from the first shard. If no shard is given, the multisequence is default constructed.
+         *
+         * ### Exception
+         *
+         * Throws std::domain_error if the coverage domains of the shards differ and std::invalid_argument if the
+         * sources of the shards have different sizes.
+         *
+         * ### Complexity
+         *
+         * Linear in the total number of breakends if the shards are given in order and no deletion spans into the
+         * interval of a subsequent shard.
+         */
+        template <std::ranges::input_range shards_t>
+            requires std::same_as<std::remove_cvref_t<std::ranges::range_reference_t<shards_t>>, compressed_multisequence>
+        explicit compressed_multisequence(shards_t && shards)
+        {
+            auto shard_it = std::ranges::begin(shards);
+            auto shard_end = std::ranges::end(shards);
+            if (shard_it == shard_end)
+                return;
+
+            _source = (*shard_it)._source;
+            _coverage_domain = (*shard_it)._coverage_domain;
+
+            using position_t = libjst::breakend_t<value_type>;
+            position_t source_size = check_source_size();
+            coverage_t def_coverage{std::views::iota(_coverage_domain.min(), _coverage_domain.max()), _coverage_domain};
+
+            std::vector<staged_breakend> staged{};
+            std::vector<std::size_t> low_ids{};
+            std::vector<std::size_t> high_ids{};
+            auto stage = [&] (std::vector<std::size_t> & ids, breakend_key_type key, coverage_t coverage) -> std::size_t {
+                ids.push_back(staged.size());
+                staged.push_back(staged_breakend{.key = std::move(key), .coverage = std::move(coverage)});
+                return staged.size() - 1;
+            };
+
+            stage(low_ids, breakend_key_type{indel_breakend_kind::nil, 0}, def_coverage);
+            for (; shard_it != shard_end; ++shard_it) {
+                compressed_multisequence const & shard = *shard_it;
+                if (shard._coverage_domain != _coverage_domain)
+                    throw std::domain_error{"Trying to merge a shard from a different coverage domain!"};
+                if (std::ranges::size(shard._source) != source_size)
+                    throw std::invalid_argument{"Trying to merge a shard with a different source!"};
+
+                // The first and the last breakend of every shard are its sentinels.
+                std::size_t const offset = staged.size() - 1;
+                auto shard_begin = shard._breakend_map.begin();
+                for (auto breakend_it = std::ranges::next(shard_begin); breakend_it != std::ranges::prev(shard._breakend_map.end());
+                     ++breakend_it) {
+                    auto && breakend = *breakend_it;
+                    breakend_key_type const key = breakend.first;
+                    bool const is_indel = key.is_indel();
+                    bool const is_high = is_indel && key.indel_kind() == indel_breakend_kind::deletion_high;
+                    std::size_t id = stage(is_high ? high_ids : low_ids, key, coverage_t{breakend.second});
+                    if (!is_indel)
+                        continue;
+
+                    shard._indel_map.at(indel_key_type{key, breakend.second.front()}).visit(libjst::multi_invocable{
+                        [&] (deletion_type const & deletion) {
+                            staged[id].deletion_mate = offset + deletion.value();
+                        },
+                        [&] (insertion_type const & insertion) {
+                            staged[id].insertion = insertion_type{_alt_pool.intern(shard._alt_pool[insertion.value()])};
+                        }
+                    });
+                }
+            }
+            stage(high_ids, breakend_key_type{indel_breakend_kind::nil, source_size}, def_coverage);
+            finalise_breakends(staged, low_ids, high_ids);
+        }
+
         iterator insert(value_type value) { // low_breakend, alt_sequence, coverage
             if (libjst::get_domain(libjst::coverage(value)) != _coverage_domain)
                 throw std::domain_error{"Trying to insert an element from a different coverage domain!"};
@@ -115,18 +319,18 @@ namespace libjst
             }
         }
 
-        // Check if given value is conflicting with some of the variants!
+        // Check if given value is conflicting with some of the variants at its position! See libjst::find_conflicts
+        // for batches of variants and for overlaps with deletions.
         constexpr bool has_conflicts(value_type const & value) const  noexcept {
             // find equal range in position
-            auto candidates = std::ranges::equal_range(std::ranges::next(_breakend_map.begin()),
-                                                       std::ranges::prev(_breakend_map.end()),
+            auto candidates = std::ranges::equal_range(libjst::interior_breakends(_breakend_map),
                                                        libjst::low_breakend(value),
                                                        std::ranges::less{},
                                                        [] (auto && breakend) {
                                                           return breakend.first.position();
                                                        });
             for (auto && breakend : candidates) {
-                if (!libjst::coverage_intersection(libjst::coverage(value), breakend.second).empty())
+                if (libjst::coverage_intersects(libjst::coverage(value), breakend.second))
                     return true;
             }
             return false;
@@ -165,6 +369,17 @@ namespace libjst
             return _coverage_domain;
         }
 
+        //!\brief Returns the memory allocated by the multisequence broken down by its components.
+        store_memory_usage memory_usage() const noexcept {
+            return store_memory_usage{
+                .source = libjst::memory_usage(_source),
+                .breakend_keys = _breakend_map.key_memory_usage(),
+                .coverages = _breakend_map.value_memory_usage(),
+                .alt_sequences = _alt_pool.memory_usage(),
+                .indel_map = _indel_map.memory_usage(),
+            };
+        }
+
         constexpr iterator begin() noexcept {
             return get_iterator(_breakend_map.begin());
         }
@@ -188,17 +403,97 @@ namespace libjst
         template <typename archive_t>
         void load(archive_t & iarchive)
         {
-            iarchive(_source, _breakend_map, /*_indel_map,*/ _coverage_domain);
+            std::vector<indel_record> indel_records{};
+            iarchive(_source, _breakend_map, indel_records, _coverage_domain, _alt_pool);
+
+            _indel_map.clear();
+            _indel_map.reserve(indel_records.size());
+            for (indel_record & record : indel_records) {
+                indel_key_type indel_key{std::move(record.key), std::move(record.coverage_head)};
+                if (record.is_deletion) {
+                    deletion_type deletion{record.mate_position};
+                    _indel_map.emplace(std::move(indel_key), std::move(deletion));
+                } else {
+                    _indel_map.emplace(std::move(indel_key), insertion_type{std::move(record.insertion)});
+                }
+            }
         }
 
         template <typename archive_t>
         void save(archive_t & oarchive) const
         {
-            oarchive(_source, _breakend_map, /*_indel_map,*/ _coverage_domain);
+            std::vector<indel_record> indel_records{};
+            indel_records.reserve(_indel_map.size());
+            for (std::size_t id = 0; id < _indel_map.size(); ++id) {
+                indel_key_type const & indel_key = _indel_map.keys()[id];
+                indel_record & record = indel_records.emplace_back(indel_record{.key = indel_key.first,
+                                                                                .coverage_head = indel_key.second});
+                _indel_map.indels()[id].visit(libjst::multi_invocable{
+                    [&] (deletion_type const & deletion) {
+                        record.is_deletion = true;
+                        record.mate_position = deletion.value();
+                    },
+                    [&] (insertion_type const & insertion) {
+                        record.insertion = insertion.value();
+                    }
+                });
+            }
+            oarchive(_source, _breakend_map, indel_records, _coverage_domain, _alt_pool);
         }
 
     private:
 
+        //!\brief Returns the size of the source or throws std::length_error if it exceeds the range of the breakend keys.
+        libjst::breakend_t<value_type> check_source_size() const {
+            using position_t = libjst::breakend_t<value_type>;
+            constexpr std::size_t max_size = std::min<std::size_t>(breakend_key_type::max_position,
+                                                                   std::numeric_limits<position_t>::max());
+            if (std::ranges::size(_source) > max_size)
+                throw std::length_error{"The source size exceeds the maximal position of the breakend keys! "
+                                        "Consider using a wider breakend position type."};
+            return std::ranges::size(_source);
+        }
+
+        //!\brief Builds the breakend map and the indel map from the staged breakends in a single pass.
+        void finalise_breakends(std::vector<staged_breakend> & staged,
+                                std::vector<std::size_t> & low_ids,
+                                std::vector<std::size_t> & high_ids) {
+            auto by_key = [&] (std::size_t const id) -> breakend_key_type const & { return staged[id].key; };
+            if (!std::ranges::is_sorted(low_ids, std::ranges::less{}, by_key))
+                std::ranges::stable_sort(low_ids, std::ranges::less{}, by_key);
+            if (!std::ranges::is_sorted(high_ids, std::ranges::less{}, by_key))
+                std::ranges::stable_sort(high_ids, std::ranges::less{}, by_key);
+
+            std::vector<std::size_t> order{};
+            order.reserve(staged.size());
+            std::ranges::merge(low_ids, high_ids, std::back_inserter(order), std::ranges::less{}, by_key, by_key);
+
+            std::vector<std::size_t> final_position(staged.size());
+            _breakend_map.reserve(order.size());
+            for (std::size_t position = 0; position < order.size(); ++position) {
+                staged_breakend & breakend = staged[order[position]];
+                _breakend_map.emplace_hint(_breakend_map.end(), breakend.key, std::move(breakend.coverage));
+                final_position[order[position]] = position;
+            }
+
+            // Visiting the breakends in the final order appends the indels to the index in key order.
+            auto map_begin = _breakend_map.begin();
+            _indel_map.reserve(std::ranges::count_if(staged, [] (staged_breakend const & breakend) {
+                return breakend.insertion.has_value() || breakend.deletion_mate.has_value();
+            }));
+            for (std::size_t position = 0; position < order.size(); ++position) {
+                std::size_t const id = order[position];
+                auto breakend_it = std::ranges::next(map_begin, position);
+                indel_key_type indel_key{breakend_it->first, breakend_it->second.front()};
+                if (staged[id].insertion.has_value()) {
+                    _indel_map.emplace(std::move(indel_key), std::move(*staged[id].insertion));
+                } else if (staged[id].deletion_mate.has_value()) {
+                    deletion_type deletion{final_position[*staged[id].deletion_mate]};
+                    _indel_map.emplace(std::move(indel_key), std::move(deletion));
+                }
+            }
+        }
+
         constexpr detail::delta_kind select_delta_kind(value_type const & value) {
             detail::delta_kind kind{detail::delta_kind::snv};
             if (libjst::breakpoint_span(value) != 1 || std::ranges::size(libjst::alt_sequence(value)) != 1) {
@@ -217,11 +512,13 @@ namespace libjst
         }
 
         constexpr iterator get_iterator(std::ranges::iterator_t<breakend_map_type> it) noexcept {
-            return iterator{std::move(it), std::addressof(_indel_map)};
+            return iterator{std::move(it), std::addressof(_breakend_map), std::addressof(_indel_map),
+                            std::addressof(_alt_pool)};
         }
 
         constexpr const_iterator get_iterator(std::ranges::iterator_t<breakend_map_type const> it) const noexcept {
-            return const_iterator{std::move(it), std::addressof(_indel_map)};
+            return const_iterator{std::move(it), std::addressof(_breakend_map), std::addressof(_indel_map),
+                                  std::addressof(_alt_pool)};
         }
 
         template <typename code_t, typename fwd_value_t>
@@ -234,33 +531,54 @@ namespace libjst
                     position = libjst::high_breakend((fwd_value_t &&)value);
                 }
             }
-            return _breakend_map.emplace_hint(std::ranges::prev(_breakend_map.end()),
-                                              breakend_key_type{code, position},
-                                              libjst::coverage((fwd_value_t &&) value));
+            auto breakend_it = _breakend_map.emplace_hint(std::ranges::prev(_breakend_map.end()),
+                                                          breakend_key_type{code, position},
+                                                          libjst::coverage((fwd_value_t &&) value));
+            shift_deletion_mates(std::ranges::distance(_breakend_map.begin(), breakend_it));
+            return breakend_it;
+        }
+
+        //!\brief Moves the deletion mates behind the breakend that was inserted at the given position by one.
+        void shift_deletion_mates(size_type const inserted_position) noexcept {
+            if (inserted_position + 2 == std::ranges::size(_breakend_map)) // appended before the sink, which is never a mate.
+                return;
+
+            for (indel_type & indel : _indel_map.mutable_indels()) {
+                if (deletion_type * deletion = std::get_if<deletion_type>(std::addressof(indel.value()));
+                    deletion != nullptr && deletion->value() >= inserted_position) {
+                    ++deletion->value();
+                }
+            }
+        }
+
+        static auto to_snv_code(value_type const & value) {
+            return libjst::alt_sequence(value)[0];
         }
 
         iterator insert_snv_impl(value_type value) {
-            auto breakend_it = insert_breakend(libjst::alt_sequence(value)[0], std::move(value));
+            auto breakend_it = insert_breakend(to_snv_code(value), std::move(value));
             return get_iterator(std::move(breakend_it));
         }
 
         iterator insert_deletion_impl(value_type value) {
             // coverages are linked
-            auto low_it = insert_breakend(indel_breakend_kind::deletion_low, value);
-            auto high_it = insert_breakend(indel_breakend_kind::deletion_high, std::move(value));
-
-            deletion_type low_deletion{high_it};
-            deletion_type high_deletion{low_it};
-            _indel_map.emplace(indel_key_type{low_it->first, low_it->second.front()}, low_deletion);
-            _indel_map.emplace(indel_key_type{high_it->first, high_it->second.front()}, high_deletion);
-
-            // TODO: fix resolving the updates of the deletion variants.
+            // the high breakend is always inserted behind the low breakend and does not move it.
+            size_type const low_position =
+                std::ranges::distance(_breakend_map.begin(), insert_breakend(indel_breakend_kind::deletion_low, value));
+            size_type const high_position =
+                std::ranges::distance(_breakend_map.begin(),
+                                      insert_breakend(indel_breakend_kind::deletion_high, std::move(value)));
+
+            auto low_it = std::ranges::next(_breakend_map.begin(), low_position);
+            auto high_it = std::ranges::next(_breakend_map.begin(), high_position);
+            _indel_map.emplace(indel_key_type{low_it->first, low_it->second.front()}, deletion_type{high_position});
+            _indel_map.emplace(indel_key_type{high_it->first, high_it->second.front()}, deletion_type{low_position});
 
             return get_iterator(std::move(low_it));
         }
 
         iterator insert_insertion_impl(value_type value) {
-            insertion_type insertion{std::move(libjst::alt_sequence(value))};
+            insertion_type insertion{_alt_pool.intern(libjst::alt_sequence(value))};
             auto breakend_it = insert_breakend(indel_breakend_kind::insertion_low, std::move(value));
             _indel_map.emplace(indel_key_type{breakend_it->first, breakend_it->second.front()}, std::move(insertion));
 
@@ -269,9 +587,9 @@ namespace libjst
 
     };
 
-    template <typename source_t, typename coverage_t>
+    template <typename source_t, typename coverage_t, std::unsigned_integral breakend_position_t, typename coverage_store_t>
     template <bool is_const>
-    class compressed_multisequence<source_t, coverage_t>::iterator_impl {
+    class compressed_multisequence<source_t, coverage_t, breakend_position_t, coverage_store_t>::iterator_impl {
 
         friend compressed_multisequence;
 
@@ -282,11 +600,18 @@ namespace libjst
         using breakend_iterator = std::ranges::iterator_t<maybe_const_map_type>;
 
         breakend_iterator _breakend_it{};
+        breakend_map_type const * _breakend_map{};
         indel_map_type const * _indel_map{};
+        alt_pool_type const * _alt_pool{};
 
-        explicit constexpr iterator_impl(breakend_iterator breakend_it, indel_map_type const * indel_map) noexcept :
+        explicit constexpr iterator_impl(breakend_iterator breakend_it,
+                                         breakend_map_type const * breakend_map,
+                                         indel_map_type const * indel_map,
+                                         alt_pool_type const * alt_pool) noexcept :
             _breakend_it{std::move(breakend_it)},
-            _indel_map{indel_map}
+            _breakend_map{breakend_map},
+            _indel_map{indel_map},
+            _alt_pool{alt_pool}
         {}
 
     public:
@@ -300,11 +625,13 @@ namespace libjst
         constexpr iterator_impl() = default;
         constexpr iterator_impl(iterator_impl<!is_const> other) noexcept requires is_const :
             _breakend_it{std::move(other._breakend_it)},
-            _indel_map{other._indel_map}
+            _breakend_map{other._breakend_map},
+            _indel_map{other._indel_map},
+            _alt_pool{other._alt_pool}
         {}
 
         constexpr reference operator*() const noexcept {
-            return reference{*_breakend_it, *_indel_map};
+            return reference{*_breakend_it, *_breakend_map, *_indel_map, *_alt_pool};
         }
 
         constexpr reference operator[](difference_type const step) const noexcept {
@@ -343,6 +670,11 @@ namespace libjst
             return *this;
         }
 
+        //!\brief Prefetches the breakend the given number of steps ahead, see libjst::contiguous_multimap.
+        [[gnu::always_inline]] void prefetch(difference_type const distance) const noexcept {
+            libjst::prefetch_ahead(_breakend_it, distance);
+        }
+
     private:
 
         constexpr friend iterator_impl operator+(iterator_impl lhs, difference_type const step) noexcept {
@@ -370,9 +702,9 @@ namespace libjst
         }
     };
 
-    template <typename source_t, typename coverage_t>
+    template <typename source_t, typename coverage_t, std::unsigned_integral breakend_position_t, typename coverage_store_t>
     template <typename breakend_iterator>
-    class compressed_multisequence<source_t, coverage_t>::delta_proxy {
+    class compressed_multisequence<source_t, coverage_t, breakend_position_t, coverage_store_t>::delta_proxy {
 
         friend compressed_multisequence;
 
@@ -381,11 +713,18 @@ namespace libjst
         using sequence_reference = source_type;
 
         breakend_reference_t _breakend_reference;
+        breakend_map_type const & _breakend_map;
         indel_map_type const & _indel_map;
+        alt_pool_type const & _alt_pool;
 
-        explicit constexpr delta_proxy(breakend_reference_t breakend_reference, indel_map_type const & indel_map) noexcept :
+        explicit constexpr delta_proxy(breakend_reference_t breakend_reference,
+                                       breakend_map_type const & breakend_map,
+                                       indel_map_type const & indel_map,
+                                       alt_pool_type const & alt_pool) noexcept :
             _breakend_reference{breakend_reference},
-            _indel_map{indel_map}
+            _breakend_map{breakend_map},
+            _indel_map{indel_map},
+            _alt_pool{alt_pool}
         {}
 
     public:
@@ -394,13 +733,18 @@ namespace libjst
 
         constexpr operator value_type() const noexcept {
             auto seq = libjst::alt_sequence(*this);
-            return value_type{libjst::get_breakpoint(*this), source_t{seq.begin(), seq.end()}, libjst::coverage(*this)};
+            return value_type{libjst::get_breakpoint(*this), source_t{seq.begin(), seq.end()}, coverage_t{libjst::coverage(*this)}};
         }
 
         constexpr breakend_key_type get_key() const noexcept {
             return _breakend_reference.first;
         }
 
+        //!\brief Whether the breakend is a SNV, which is tested without decoding the kind of the breakend.
+        constexpr bool is_snv() const noexcept {
+            return !_breakend_reference.first.is_indel();
+        }
+
         constexpr breakpoint_end get_breakpoint_end() const noexcept {
             return _breakend_reference.first.visit(libjst::multi_invocable{
                 [pos = _breakend_reference.first.position()] (indel_breakend_kind code) {
@@ -426,9 +770,12 @@ namespace libjst
                         case indel_breakend_kind::deletion_low: [[fallthrough]];
                         case indel_breakend_kind::deletion_high: {
                             indel_key_type key{_breakend_reference.first, _breakend_reference.second.front()};
-                            return _indel_map.find(key)->second.visit(libjst::multi_invocable{
+                            return _indel_map.at(key).visit(libjst::multi_invocable{
                                 [&] (deletion_type const & deletion) -> optional_mate {
-                                    return iterator_impl<true>{deletion.value(), std::addressof(_indel_map)};
+                                    return mate_iterator{std::ranges::next(_breakend_map.begin(), deletion.value()),
+                                                         std::addressof(_breakend_map),
+                                                         std::addressof(_indel_map),
+                                                         std::addressof(_alt_pool)};
                                 },
                                 [] (insertion_type const &) -> optional_mate { return std::nullopt; }
                             });
@@ -444,18 +791,12 @@ namespace libjst
 
     private:
 
-        constexpr breakend_reference_t get_breakend_mate(indel_key_type key) const noexcept {
-            using optional_it_t = std::optional<breakend_iterator>;
+        constexpr breakend_key_type get_breakend_mate(indel_key_type key) const noexcept {
             assert(_indel_map.contains(key));
-            optional_it_t mate = _indel_map.find(key)->second.visit(libjst::multi_invocable{
-                [] (deletion_type const & deletion) -> optional_it_t { return deletion.value(); },
-                [&] (insertion_type const &) -> optional_it_t { return std::nullopt; }
+            return _indel_map.at(key).visit(libjst::multi_invocable{
+                [&] (deletion_type const & deletion) { return (*std::ranges::next(_breakend_map.begin(), deletion.value())).first; },
+                [&] (insertion_type const &) { return _breakend_reference.first; }
             });
-            if (mate.has_value()) {
-                return *(mate.value());
-            } else {
-                return _breakend_reference;
-            }
         }
 
         constexpr breakpoint get_deletion_breakpoint(indel_breakend_kind const deletion_kind) const noexcept {
@@ -466,23 +807,23 @@ namespace libjst
             using breakend_t = typename breakpoint::value_type;
 
             indel_key_type indel_key{_breakend_reference.first, _breakend_reference.second.front()};
-            breakend_reference_t breakend_mate = get_breakend_mate(std::move(indel_key));
+            breakend_key_type const breakend_mate = get_breakend_mate(std::move(indel_key));
 
             breakend_t low_breakend = (deletion_kind == indel_breakend_kind::deletion_low) ?
                                         _breakend_reference.first.position() :
-                                        breakend_mate.first.position();
+                                        breakend_mate.position();
 
 
-            size_t deletion_size = std::abs(static_cast<signed_position_t>(breakend_mate.first.position()) -
+            size_t deletion_size = std::abs(static_cast<signed_position_t>(breakend_mate.position()) -
                                             static_cast<signed_position_t>(_breakend_reference.first.position()));
             return breakpoint{low_breakend, deletion_size};
         }
 
         constexpr breakpoint extract_breakpoint() const noexcept {
             // what can we have:
-            using position_t = breakend_key_type::underlying_type;
+            using position_t = typename breakpoint::value_type; // sources are bounded by check_source_size
             breakend_key_type key = _breakend_reference.first;
-            position_t const position = key.position();
+            position_t const position = static_cast<position_t>(key.position());
             return key.visit(libjst::multi_invocable{
                 [&] (indel_breakend_kind indel_kind) {
                     if (indel_kind == indel_breakend_kind::deletion_low ||
@@ -503,8 +844,8 @@ namespace libjst
                     indel_key_type indel_key{_breakend_reference.first, _breakend_reference.second.front()};
                     if (breakend_kind != indel_breakend_kind::nil) {
                         assert(_indel_map.contains(indel_key));
-                        return _indel_map.find(indel_key)->second.visit(libjst::multi_invocable{
-                            [] (insertion_type const & insertion) { return sequence_reference{insertion.value()}; },
+                        return _indel_map.at(indel_key).visit(libjst::multi_invocable{
+                            [&] (insertion_type const & insertion) { return _alt_pool[insertion.value()]; },
                             [] (deletion_type const &) { return sequence_reference{}; }
                         });
                     } else {
@@ -541,7 +882,7 @@ namespace libjst
             return me.extract_alt_sequence();
         }
 
-        friend constexpr coverage_t const & tag_invoke(libjst::tag_t<libjst::coverage>, delta_proxy me) noexcept
+        friend constexpr coverage_reference tag_invoke(libjst::tag_t<libjst::coverage>, delta_proxy me) noexcept
         {
             return me._breakend_reference.second;
         }
@@ -0,0 +1,260 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides a view over a referentially compressed multisequence (rcms) with index based iterators.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <compare>
+#include <concepts>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <stdexcept>
+
+#include <libjst/utility/tag_invoke.hpp>
+
+#include <libjst/coverage/concept.hpp>
+#include <libjst/variant/concept.hpp>
+
+namespace libjst
+{
+    /*!\brief A view over a referentially compressed multisequence whose iterators store a breakend index.
+     *
+     * \tparam rcms_t The type of the wrapped multisequence.
+     * \tparam index_t The unsigned integer type storing the breakend index; defaults to `uint32_t`.
+     *
+     * \details
+     *
+     * The iterators of the wrapped multisequence, e.g. libjst::dna_compressed_multisequence, carry the iterators
+     * into the breakend map as well as pointers to the indel map and the pool of inserted sequences. The sequence
+     * tree nodes store several of these iterators and every layer of tree adaptors copies them whenever a child is
+     * visited. The iterator of this view only stores one pointer to the wrapped multisequence and the breakend
+     * index relative to it, such that the nodes of a tree over libjst::rcs_store_compact occupy less than half of
+     * the size. Dereferencing the iterator recomputes the iterator of the wrapped multisequence from the index and
+     * returns a proxy that forwards to the wrapped breakend.
+     *
+     * The view references the wrapped multisequence, which must outlive it.
+     */
+    template <typename rcms_t, std::unsigned_integral index_t = uint32_t>
+    class compressed_multisequence_compact {
+    private:
+
+        using wrapped_source_t = typename rcms_t::source_type;
+        using wrapped_iterator = std::ranges::iterator_t<rcms_t const &>;
+        using coverage_type = libjst::variant_coverage_t<std::iter_reference_t<wrapped_iterator>>;
+        using coverage_domain_type = libjst::coverage_domain_t<coverage_type>;
+
+        class iterator_impl;
+        class delta_proxy;
+
+        rcms_t const * _wrappee{};
+
+    public:
+
+        using source_type = wrapped_source_t;
+        using iterator = iterator_impl;
+        using value_type = std::iter_value_t<iterator>;
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        compressed_multisequence_compact() = default; //!< Default.
+
+        /*!\brief Constructs the view over the given multisequence.
+         *
+         * \param[in] wrappee The multisequence to wrap.
+         *
+         * ### Exception
+         *
+         * Throws std::length_error if the number of breakends exceeds the range of `index_t`.
+         */
+        explicit compressed_multisequence_compact(rcms_t const & wrappee) :
+            _wrappee{std::addressof(wrappee)}
+        {
+            if (std::ranges::size(wrappee) > std::numeric_limits<index_t>::max())
+                throw std::length_error{"The number of breakends exceeds the index type of the compact view!"};
+        }
+        //!\}
+
+        constexpr source_type source() const noexcept {
+            return _wrappee->source();
+        }
+
+        constexpr size_t size() const noexcept {
+            return _wrappee->size();
+        }
+
+        constexpr coverage_domain_type const & coverage_domain() const noexcept {
+            return _wrappee->coverage_domain();
+        }
+
+        constexpr iterator begin() const noexcept {
+            return iterator{_wrappee, 0};
+        }
+
+        constexpr iterator end() const noexcept {
+            return iterator{_wrappee, static_cast<index_t>(std::ranges::size(*_wrappee))};
+        }
+
+        //!\brief Returns the first breakend at or behind the given position using the lookup of the wrapped rcms.
+        template <typename position_t>
+            requires requires (rcms_t const & rcms, position_t const & position) {
+                { rcms.lower_bound(position) } -> std::same_as<wrapped_iterator>;
+            }
+        constexpr iterator lower_bound(position_t const & position) const {
+            return iterator{_wrappee, index_of(_wrappee->lower_bound(position))};
+        }
+
+    private:
+
+        constexpr index_t index_of(wrapped_iterator const & it) const noexcept {
+            return static_cast<index_t>(it - std::ranges::begin(*_wrappee));
+        }
+    };
+
+    template <typename rcms_t, std::unsigned_integral index_t>
+    class compressed_multisequence_compact<rcms_t, index_t>::iterator_impl {
+
+        friend compressed_multisequence_compact;
+
+        rcms_t const * _wrappee{};
+        index_t _index{};
+
+        explicit constexpr iterator_impl(rcms_t const * wrappee, index_t index) noexcept :
+            _wrappee{wrappee},
+            _index{index}
+        {}
+
+    public:
+
+        using value_type = delta_proxy;
+        using reference = value_type;
+        using difference_type = std::iter_difference_t<wrapped_iterator>;
+        using pointer = void;
+        using iterator_category = std::random_access_iterator_tag;
+
+        constexpr iterator_impl() = default;
+
+        constexpr reference operator*() const noexcept {
+            return reference{std::ranges::next(std::ranges::begin(*_wrappee), _index), _wrappee};
+        }
+
+        constexpr reference operator[](difference_type const step) const noexcept {
+            return *(*this + step);
+        }
+
+        constexpr iterator_impl & operator++() noexcept {
+            ++_index;
+            return *this;
+        }
+
+        constexpr iterator_impl operator++(int) noexcept {
+            iterator_impl tmp{*this};
+            ++(*this);
+            return tmp;
+        }
+
+        constexpr iterator_impl & operator+=(difference_type const step) noexcept {
+            _index = static_cast<index_t>(_index + step);
+            return *this;
+        }
+
+        constexpr iterator_impl & operator--() noexcept {
+            --_index;
+            return *this;
+        }
+
+        constexpr iterator_impl operator--(int) noexcept {
+            iterator_impl tmp{*this};
+            --(*this);
+            return tmp;
+        }
+
+        constexpr iterator_impl & operator-=(difference_type const step) noexcept {
+            _index = static_cast<index_t>(_index - step);
+            return *this;
+        }
+
+    private:
+
+        constexpr friend iterator_impl operator+(iterator_impl lhs, difference_type const step) noexcept {
+            return lhs += step;
+        }
+
+        constexpr friend iterator_impl operator+(difference_type const step, iterator_impl rhs) noexcept {
+            return rhs + step;
+        }
+
+        constexpr friend iterator_impl operator-(iterator_impl lhs, difference_type const step) noexcept {
+            return lhs -= step;
+        }
+
+        constexpr friend difference_type operator-(iterator_impl const & lhs, iterator_impl const & rhs) noexcept {
+            return static_cast<difference_type>(lhs._index) - static_cast<difference_type>(rhs._index);
+        }
+
+        constexpr friend bool operator==(iterator_impl const & lhs, iterator_impl const & rhs) noexcept {
+            return lhs._index == rhs._index;
+        }
+
+        constexpr friend std::strong_ordering operator<=>(iterator_impl const & lhs, iterator_impl const & rhs) noexcept {
+            return lhs._index <=> rhs._index;
+        }
+    };
+
+    template <typename rcms_t, std::unsigned_integral index_t>
+    class compressed_multisequence_compact<rcms_t, index_t>::delta_proxy {
+
+        friend compressed_multisequence_compact;
+
+        wrapped_iterator _wrapped_it{};
+        rcms_t const * _wrappee{};
+
+        explicit constexpr delta_proxy(wrapped_iterator wrapped_it, rcms_t const * wrappee) noexcept :
+            _wrapped_it{std::move(wrapped_it)},
+            _wrappee{wrappee}
+        {}
+
+    public:
+
+        delta_proxy() = delete;
+
+        constexpr auto get_key() const noexcept -> decltype((*_wrapped_it).get_key()) {
+            return (*_wrapped_it).get_key();
+        }
+
+        constexpr breakpoint_end get_breakpoint_end() const noexcept {
+            return (*_wrapped_it).get_breakpoint_end();
+        }
+
+        constexpr std::optional<iterator_impl> jump_to_mate() const noexcept {
+            if (auto mate = (*_wrapped_it).jump_to_mate(); mate.has_value()) {
+                return iterator_impl{_wrappee, static_cast<index_t>(*mate - std::ranges::begin(*_wrappee))};
+            }
+            return std::nullopt;
+        }
+
+    private:
+
+        template <typename cpo_t, typename me_t>
+            requires std::same_as<std::remove_cvref_t<me_t>, delta_proxy> &&
+                     libjst::tag_invocable<cpo_t, std::iter_reference_t<wrapped_iterator>>
+        friend constexpr auto tag_invoke(cpo_t cpo, me_t && me)
+            noexcept(libjst::is_nothrow_tag_invocable_v<cpo_t, std::iter_reference_t<wrapped_iterator>>)
+            -> libjst::tag_invoke_result_t<cpo_t, std::iter_reference_t<wrapped_iterator>>
+        {
+            return cpo(*me._wrapped_it);
+        }
+    };
+
+}  // namespace libjst
@@ -0,0 +1,176 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::find_conflicts detecting the conflicts of a batch of variants in a single sweep.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <libjst/coverage/concept.hpp>
+#include <libjst/coverage/coverage_members.hpp>
+#include <libjst/rcms/interior_breakends.hpp>
+#include <libjst/variant/concept.hpp>
+
+namespace libjst
+{
+    //!\brief A haplotype of a variant of a batch carrying another, overlapping variant.
+    struct variant_conflict {
+        std::size_t batch_index{}; //!< The index of the variant in the batch.
+        std::size_t haplotype{}; //!< The haplotype carrying both variants, as offset into the coverage domain.
+        std::size_t other_index{}; //!< The index of the other variant in the batch or of its breakend in the variants.
+        bool other_in_batch{}; //!< Whether the other variant is a variant of the batch.
+
+        friend constexpr bool operator==(variant_conflict const &, variant_conflict const &) noexcept = default;
+    };
+
+    namespace detail
+    {
+        //!\brief The variants of a haplotype seen so far by the sweep of libjst::find_conflicts.
+        struct conflict_state {
+            static constexpr std::size_t none{std::numeric_limits<std::size_t>::max()};
+
+            struct source {
+                std::size_t index{none};
+                bool in_batch{};
+            };
+
+            std::size_t last_begin{none}; // the low breakend of the last variant
+            std::size_t reach{}; // the high breakend of the furthest reaching variant
+            source last_begin_source{};
+            source reach_source{};
+
+            //!\brief Returns the variant conflicting with a variant beginning at the given position, if any.
+            constexpr source const * conflict(std::size_t const position) const noexcept {
+                if (position == last_begin)
+                    return &last_begin_source;
+                if (position < reach)
+                    return &reach_source;
+                return nullptr;
+            }
+
+            constexpr void add(std::size_t const position, std::size_t const end, source const variant) noexcept {
+                last_begin = position;
+                last_begin_source = variant;
+                if (end >= reach) {
+                    reach = end;
+                    reach_source = variant;
+                }
+            }
+        };
+    } // namespace detail
+
+    /*!\brief Finds all haplotypes of a batch of variants that carry overlapping variants.
+     *
+     * \param[in] variants The multisequence the batch is checked against, e.g. libjst::rcs_store::variants().
+     * \param[in] batch The variants to check, sorted by their low breakend.
+     *
+     * \returns The conflicts ordered by the index of the variant in the batch and the haplotype.
+     *
+     * \details
+     *
+     * Two variants of the same haplotype conflict if they begin at the same position, like in `has_conflicts` of
+     * the multisequences, or if one begins within the breakpoint of the other, e.g. a SNV within a deletion.
+     * Conflicts of a variant of the batch are reported with the variants of the multisequence and with the other
+     * variants of the batch, but the conflicts among the variants of the multisequence are not, see
+     * libjst::dna_compressed_multisequence::validate.
+     *
+     * The batch and the low breakends of the multisequence are merged by position in a single sweep. For every
+     * haplotype the sweep keeps the begin of its last variant and the end of its furthest reaching variant, such
+     * that a variant is tested against all preceding variants of its haplotypes at once, instead of looking up the
+     * breakends at its position like `has_conflicts` does for every variant. Every haplotype of a variant of the batch
+     * that carries a conflicting variant is reported at least once, together with one of the conflicting variants.
+     *
+     * ### Exception
+     *
+     * Throws std::invalid_argument if the batch is not sorted by the low breakend and std::domain_error if the
+     * coverage domain of a variant of the batch differs from the one of the multisequence.
+     *
+     * ### Complexity
+     *
+     * Linear in the number of breakends and variants of the batch and in the members of their coverages.
+     */
+    template <typename variants_t, std::ranges::random_access_range batch_t>
+    std::vector<variant_conflict> find_conflicts(variants_t const & variants, batch_t const & batch) {
+        using state_source = detail::conflict_state::source;
+
+        auto const & domain = variants.coverage_domain();
+        std::size_t const batch_size = std::ranges::size(batch);
+        std::size_t batch_reach{};
+        for (std::size_t index = 0; index < batch_size; ++index) {
+            auto const & variant = batch[index];
+            if (libjst::get_domain(libjst::coverage(variant)) != domain)
+                throw std::domain_error{"The variant " + std::to_string(index) + " of the batch has a different "
+                                        "coverage domain!"};
+            if (index > 0 && libjst::low_breakend(batch[index - 1]) > libjst::low_breakend(variant))
+                throw std::invalid_argument{"The batch is not sorted by the low breakend at variant " +
+                                            std::to_string(index) + "."};
+            batch_reach = std::max<std::size_t>(batch_reach, libjst::high_breakend(variant));
+        }
+
+        std::vector<detail::conflict_state> states(domain.size());
+        std::vector<variant_conflict> conflicts{};
+
+        // Tests the variant against the haplotypes it covers and adds it to their states.
+        auto sweep = [&] (auto const & coverage, std::size_t const position, std::size_t const end,
+                          state_source const variant) {
+            libjst::for_each_covered(coverage, domain.min(), domain.size(), [&] (std::size_t const haplotype) {
+                detail::conflict_state & state = states[haplotype];
+                if (state_source const * other = state.conflict(position); other != nullptr) {
+                    if (variant.in_batch)
+                        conflicts.push_back(variant_conflict{variant.index, haplotype, other->index, other->in_batch});
+                    if (other->in_batch) // the variant of the batch was swept before the conflicting one
+                        conflicts.push_back(variant_conflict{other->index, haplotype, variant.index, variant.in_batch});
+                }
+                state.add(position, end, variant);
+            });
+        };
+
+        // Sweeps the low breakends of the variants, skipping the high breakends of the deletions.
+        auto interior = libjst::interior_breakends(variants);
+        auto breakend_it = interior.begin();
+        std::size_t breakend_index = 1; // behind the first sentinel
+        auto skip_high_breakends = [&] () {
+            for (; breakend_it != interior.end() && (*breakend_it).get_breakpoint_end() == breakpoint_end::high;
+                 ++breakend_it, ++breakend_index)
+            {}
+        };
+        auto sweep_breakends_before = [&] (auto const & is_before) {
+            for (skip_high_breakends(); breakend_it != interior.end() && is_before(libjst::position(*breakend_it));
+                 ++breakend_it, ++breakend_index, skip_high_breakends()) {
+                auto const breakpoint = libjst::get_breakpoint(*breakend_it);
+                sweep(libjst::coverage(*breakend_it), libjst::low_breakend(breakpoint),
+                      libjst::high_breakend(breakpoint), state_source{breakend_index, false});
+            }
+        };
+
+        for (std::size_t index = 0; index < batch_size; ++index) {
+            auto const & variant = batch[index];
+            std::size_t const position = libjst::low_breakend(variant);
+            sweep_breakends_before([&] (std::size_t const begin) { return begin <= position; });
+            sweep(libjst::coverage(variant), position, libjst::high_breakend(variant), state_source{index, true});
+        }
+
+        // The stored variants behind the batch only conflict with it if they begin within a variant of the batch.
+        sweep_breakends_before([&] (std::size_t const begin) { return begin < batch_reach; });
+
+        std::ranges::stable_sort(conflicts, [] (variant_conflict const & lhs, variant_conflict const & rhs) {
+            return std::pair{lhs.batch_index, lhs.haplotype} < std::pair{rhs.batch_index, rhs.haplotype};
+        });
+        return conflicts;
+    }
+}  // namespace libjst
@@ -15,7 +15,12 @@
 #include <algorithm>
 #include <bit>
 #include <concepts>
+#include <utility>
 
+#include <libjst/utility/huge_pages.hpp>
+#include <libjst/utility/memory_usage.hpp>
+#include <libjst/utility/pointer_random_access_iterator.hpp>
+#include <libjst/utility/prefetch.hpp>
 #include <libjst/utility/sorted_vector.hpp>
 #include <libjst/utility/stable_random_access_iterator.hpp>
 
@@ -57,7 +62,19 @@ namespace libjst
 
     };
 
-    template <typename key_t, typename value_t>
+    /*!\brief A sorted multimap storing the keys and the values in two separate buffers.
+     *
+     * \tparam key_t The key type.
+     * \tparam value_t The mapped type.
+     * \tparam data_t The random access container storing the mapped values; defaults to `std::vector<value_t>`.
+     *
+     * \details
+     *
+     * The container of the mapped values can be replaced by a container whose reference type is a proxy, e.g.
+     * libjst::bit_coverage_pool, which stores all bit coverages in one buffer. The reference type of this map then
+     * holds the proxy of the value container instead of a reference.
+     */
+    template <typename key_t, typename value_t, typename data_t = std::vector<value_t>>
     class contiguous_multimap { // contiguous_multimap
     public:
 
@@ -67,7 +84,7 @@ namespace libjst
     private:
 
         using multiset_type = sorted_vector<key_type>;
-        using data_type = std::vector<value_t>;
+        using data_type = data_t;
 
         template <bool is_const>
         class iterator_impl;
@@ -107,11 +124,61 @@ namespace libjst
         // void erase(const_iterator first, const_iterator last = std::ranges::next(first));
         // iterator find(key_type);
 
+        //!\brief Returns an iterator to the first element whose key is not less than the given key.
+        template <typename comparable_key_t>
+        iterator lower_bound(comparable_key_t const & key) {
+            auto breakend_it = _breakends.lower_bound(key);
+            auto data_offset = std::ranges::distance(_breakends.begin(), breakend_it);
+            return iterator{std::move(breakend_it), get_data_iter(data_offset)};
+        }
+
+        //!\overload
+        template <typename comparable_key_t>
+        const_iterator lower_bound(comparable_key_t const & key) const {
+            auto breakend_it = _breakends.lower_bound(key);
+            auto data_offset = std::ranges::distance(_breakends.begin(), breakend_it);
+            return const_iterator{std::move(breakend_it), get_data_iter(data_offset)};
+        }
+
+        /*!\brief Builds a search index over the keys, which speeds up lower_bound.
+         *
+         * \details
+         *
+         * See libjst::sorted_vector::build_search_index. The index is dropped by every insertion.
+         */
+        void build_search_index() {
+            _breakends.build_search_index();
+        }
+
+        constexpr bool has_search_index() const noexcept {
+            return _breakends.has_search_index();
+        }
+
         constexpr void reserve(size_type const new_capacity) {
             _breakends.reserve(new_capacity);
             _data.reserve(new_capacity);
         }
 
+        //!\brief Returns the number of bytes allocated for the keys including their search index.
+        size_type key_memory_usage() const noexcept {
+            return _breakends.memory_usage();
+        }
+
+        //!\brief Returns the number of bytes allocated for the mapped values, see libjst::memory_usage.
+        size_type value_memory_usage() const noexcept {
+            return libjst::memory_usage(_data);
+        }
+
+        //!\brief Returns the number of bytes allocated for the keys and the mapped values.
+        size_type memory_usage() const noexcept {
+            return key_memory_usage() + value_memory_usage();
+        }
+
+        //!\brief Advises the kernel to back the keys and the mapped values by transparent huge pages.
+        size_type advise_huge_pages() const noexcept {
+            return libjst::advise_huge_pages(_breakends) + libjst::advise_huge_pages(_data);
+        }
+
         iterator begin() noexcept {
             return iterator{_breakends.begin(), get_data_iter(0)};
         }
@@ -151,7 +218,7 @@ namespace libjst
         }
 
         constexpr auto get_data_iter(std::ptrdiff_t const & pos) const noexcept {
-            return stable_random_access_iterator{std::addressof(_data), pos};
+            return const_random_access_iterator_t<data_type>{std::addressof(_data), pos};
         }
 
         iterator insert_impl(value_type elem) {
@@ -164,9 +231,11 @@ namespace libjst
         }
 
         iterator insert_impl(const_iterator hint, value_type elem) {
+            // The hint is kept as offset, since a const iterator may be a raw pointer invalidated by the reserve.
+            auto const hint_offset = std::ranges::distance(std::as_const(_breakends).begin(), hint.base().first);
             // now iterator remains stable + strong exception guarantee
             reserve(std::bit_ceil(_data.size() + 1));
-            auto [breakend_hint, data_hint] = std::move(hint).base();
+            auto breakend_hint = std::ranges::next(std::as_const(_breakends).begin(), hint_offset);
             auto breakend_it = _breakends.emplace_hint(std::move(breakend_hint), std::move(get<0>(elem)));
             auto data_offset = std::ranges::distance(_breakends.begin(), breakend_it);
             _data.insert(std::ranges::next(_data.begin(), data_offset), std::move(get<1>(elem)));
@@ -174,9 +243,9 @@ namespace libjst
         }
     };
 
-    template <typename key_t, typename value_t>
+    template <typename key_t, typename value_t, typename data_t>
     template <bool is_const>
-    class contiguous_multimap<key_t, value_t>::iterator_impl {
+    class contiguous_multimap<key_t, value_t, data_t>::iterator_impl {
 
         friend contiguous_multimap;
 
@@ -187,7 +256,9 @@ namespace libjst
         using maybe_const_t = std::conditional_t<is_const, t const, t>;
 
         using breakend_iterator = std::ranges::iterator_t<maybe_const_t<multiset_type>>;
-        using data_iterator = stable_random_access_iterator<maybe_const_t<data_type>>;
+        using data_iterator = std::conditional_t<is_const,
+                                                 const_random_access_iterator_t<data_type>,
+                                                 stable_random_access_iterator<data_type>>;
 
         breakend_iterator _breakend_it{};
         data_iterator _data_it{};
@@ -268,6 +339,12 @@ namespace libjst
             return *this;
         }
 
+        //!\brief Prefetches the key and the mapped value the given number of steps ahead, see libjst::prefetch_ahead.
+        [[gnu::always_inline]] void prefetch(difference_type const distance) const noexcept {
+            libjst::prefetch_ahead(_breakend_it, distance);
+            libjst::prefetch_ahead(_data_it, distance);
+        }
+
     private:
 
         constexpr friend iterator_impl operator+(iterator_impl lhs, difference_type const step) noexcept {
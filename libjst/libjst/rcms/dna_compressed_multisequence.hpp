@@ -12,27 +12,55 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cassert>
 #include <cmath>
+#include <exception>
+#include <iterator>
+#include <limits>
+#include <optional>
 #include <ranges>
-#include <unordered_map>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <variant>
+#include <vector>
 
 #include <libjst/utility/member_type_trait.hpp>
 #include <libjst/utility/tag_invoke.hpp>
 
 #include <libjst/coverage/concept.hpp>
+#include <libjst/coverage/coverage_members.hpp>
 #include <libjst/rcms/compressed_multisequence.hpp>
+#include <libjst/rcms/alt_sequence_pool.hpp>
 #include <libjst/rcms/contiguous_multimap.hpp>
 #include <libjst/rcms/delta_sequence_variant.hpp>
 #include <libjst/rcms/generic_delta.hpp>
+#include <libjst/rcms/indel_index.hpp>
 #include <libjst/rcms/indel_variant.hpp>
+#include <libjst/rcms/interior_breakends.hpp>
 #include <libjst/rcms/packed_breakend_key.hpp>
+#include <libjst/rcms/carrier_count_index.hpp>
+#include <libjst/rcms/sample_permutation.hpp>
+#include <libjst/rcms/sampled_position_index.hpp>
+#include <libjst/rcms/store_validation.hpp>
+#include <libjst/rcms/variant_class_index.hpp>
+#include <libjst/sequence/packed_dna_sequence.hpp>
+#include <libjst/utility/huge_pages.hpp>
+#include <libjst/utility/prefetch.hpp>
+#include <libjst/utility/memory_usage.hpp>
 #include <libjst/utility/multi_invocable.hpp>
 
 namespace libjst
 {
     // requires is_object_v<source_t>
     // requires breakpoint_coverage<coverage_t>
-    template <typename source_t, typename coverage_t>
+    // coverage_store_t holds the coverages of all breakends, e.g. libjst::bit_coverage_pool keeps them in one buffer
+    // and libjst::run_length_coverage_pool keeps them as run-length encoded columns of one coverage matrix.
+    template <typename source_t,
+              typename coverage_t,
+              std::unsigned_integral breakend_position_t = uint32_t,
+              typename coverage_store_t = std::vector<coverage_t>>
         requires std::same_as<std::ranges::range_value_t<source_t>, char>
     class dna_compressed_multisequence { // TODO: breakend multimap
 
@@ -55,24 +83,23 @@ namespace libjst
 
         // so what is the value type?
         // how can we change the different implementations for static and dynamic?
-        using position_type = uint32_t;
+        using position_type = breakend_position_t;
         using breakend_key_type = packed_breakend_key<position_type>;
-        using breakend_map_type = contiguous_multimap<breakend_key_type, coverage_t>;
+        using breakend_map_type = contiguous_multimap<breakend_key_type, coverage_t, coverage_store_t>;
+        using coverage_reference = std::ranges::range_reference_t<coverage_store_t const>;
 
         using coverage_value_type = std::ranges::range_value_t<coverage_t>;
         using indel_key_type = std::pair<breakend_key_type, coverage_value_type>;
 
-        struct indel_key_hash {
-            constexpr std::size_t operator()(indel_key_type const & key) const noexcept {
-                return std::hash<breakend_key_type>{}(key.first) ^ std::hash<coverage_value_type>{}(key.second);
-            }
-        };
-
-        using deletion_type = deletion_element<std::ranges::iterator_t<breakend_map_type>>;
-        using insertion_type = insertion_element<source_t>;
+        // A deletion links to the position of its mate breakend in the breakend map, which stays valid when the
+        // multisequence is copied, moved or serialised.
+        using deletion_type = deletion_element<typename breakend_map_type::size_type>;
+        using alt_pool_type = alt_sequence_pool<value_t>;
+        using insertion_type = insertion_element<typename alt_pool_type::slice_type>;
         using indel_type = indel_variant<deletion_type, insertion_type>;
 
-        using indel_map_type = std::unordered_map<indel_key_type, indel_type, indel_key_hash>;
+        using indel_map_type = indel_index<indel_key_type, indel_type>;
+        using position_index_type = sampled_position_index<typename breakend_map_type::size_type>;
         using coverage_domain_type = libjst::coverage_domain_t<coverage_t>;
 
         template <bool>
@@ -81,10 +108,37 @@ namespace libjst
         template <typename>
         class delta_proxy;
 
+        //!\brief A breakend collected by the bulk construction before it is stored in the breakend map.
+        struct staged_breakend {
+            breakend_key_type key{};
+            coverage_t coverage{};
+            std::optional<insertion_type> insertion{};
+            std::optional<std::size_t> deletion_mate{}; // index of the staged mate breakend of a deletion
+        };
+
+        //!\brief The serialised form of an indel, which stores the position of a deletion mate in the breakend map.
+        struct indel_record {
+            breakend_key_type key{};
+            coverage_value_type coverage_head{};
+            bool is_deletion{};
+            std::size_t mate_position{};
+            typename alt_pool_type::slice_type insertion{};
+
+            template <typename archive_t>
+            void serialize(archive_t & archive)
+            {
+                archive(key, coverage_head, is_deletion, mate_position, insertion);
+            }
+        };
+
         source_t _source{}; // only links to the source.
         breakend_map_type _breakend_map{};
         indel_map_type _indel_map{};
+        alt_pool_type _alt_pool{}; // stores every distinct inserted sequence once.
         coverage_domain_type _coverage_domain{};
+        position_index_type _position_index{}; // optional, see build_position_index.
+        variant_class_index _variant_classes{}; // optional, see build_variant_class_index.
+        carrier_count_index _carrier_counts{}; // optional, see build_carrier_count_index.
 
     public:
 
@@ -100,16 +154,247 @@ namespace libjst
             _coverage_domain{std::move(coverage_domain)}
         {
             using position_t = libjst::breakend_t<value_type>;
-            position_t source_size = std::ranges::size(_source);
+            position_t source_size = check_source_size();
             coverage_t def_coverage{std::views::iota(_coverage_domain.min(), _coverage_domain.max()), _coverage_domain};
             _breakend_map.emplace(breakend_key_type{indel_breakend_kind::nil, 0}, def_coverage);
             _breakend_map.emplace(breakend_key_type{indel_breakend_kind::nil, source_size}, def_coverage);
         }
 
+        /*!\brief Constructs the multisequence from a range of deltas in a single pass.
+         *
+         * \param[in] source The source sequence.
+         * \param[in] coverage_domain The coverage domain of all deltas.
+         * \param[in] deltas The deltas to store; should be sorted by their low breakend.
+         *
+         * \details
+         *
+         * In contrast to inserting the deltas one by one, which shifts the stored breakends for every insertion,
+         * all breakends are first appended to a staging buffer and the breakend map is built once in the end.
+         * The low breakends are only sorted if the deltas are not given in sorted order; the high breakends of the
+         * deletions are sorted separately and merged with the low breakends.
+         *
+         * ### Exception
+         *
+         * Throws std::domain_error if the coverage domain of a delta differs from the given coverage domain.
+         *
+         * ### Complexity
+         *
+         * Linear in the number of deltas if they are sorted and there are no deletions, otherwise
+         * \f$O(n \log n)\f$ in the number of unsorted deltas and deletions, respectively.
+         */
+        template <std::ranges::input_range deltas_t>
+            requires std::convertible_to<std::ranges::range_reference_t<deltas_t>, value_type>
+        explicit dna_compressed_multisequence(source_t source, coverage_domain_type coverage_domain, deltas_t && deltas) :
+            _source{std::move(source)},
+            _coverage_domain{std::move(coverage_domain)}
+        {
+            assign_deltas((deltas_t &&) deltas);
+        }
+
+        /*!\brief Constructs the multisequence by merging shards covering disjoint intervals of the same source.
+         *
+         * \param[in] shards The shards to merge; should be ordered by the source intervals they cover.
+         *
+         * \details
+         *
+         * All shards must share the same source and coverage domain. The sentinel breakends of the shards are dropped
+         * and replaced by a single pair of sentinels for the merged multisequence. The source and the coverage domain
+         * are taken from the first shard. If no shard is given, the multisequence is default constructed.
+         *
+         * ### Exception
+         *
+         * Throws std::domain_error if the coverage domains of the shards differ and std::invalid_argument if the
+         * sources of the shards have different sizes.
+         *
+         * ### Complexity
+         *
+         * Linear in the total number of breakends if the shards are given in order and no deletion spans into the
+         * interval of a subsequent shard.
+         */
+        template <std::ranges::input_range shards_t>
+            requires std::same_as<std::remove_cvref_t<std::ranges::range_reference_t<shards_t>>, dna_compressed_multisequence>
+        explicit dna_compressed_multisequence(shards_t && shards)
+        {
+            auto shard_it = std::ranges::begin(shards);
+            auto shard_end = std::ranges::end(shards);
+            if (shard_it == shard_end)
+                return;
+
+            _source = (*shard_it)._source;
+            _coverage_domain = (*shard_it)._coverage_domain;
+
+            using position_t = libjst::breakend_t<value_type>;
+            position_t source_size = check_source_size();
+            coverage_t def_coverage{std::views::iota(_coverage_domain.min(), _coverage_domain.max()), _coverage_domain};
+
+            std::vector<staged_breakend> staged{};
+            std::vector<std::size_t> low_ids{};
+            std::vector<std::size_t> high_ids{};
+            auto stage = [&] (std::vector<std::size_t> & ids, breakend_key_type key, coverage_t coverage) -> std::size_t {
+                ids.push_back(staged.size());
+                staged.push_back(staged_breakend{.key = std::move(key), .coverage = std::move(coverage)});
+                return staged.size() - 1;
+            };
+
+            stage(low_ids, breakend_key_type{indel_breakend_kind::nil, 0}, def_coverage);
+            for (; shard_it != shard_end; ++shard_it) {
+                dna_compressed_multisequence const & shard = *shard_it;
+                if (shard._coverage_domain != _coverage_domain)
+                    throw std::domain_error{"Trying to merge a shard from a different coverage domain!"};
+                if (std::ranges::size(shard._source) != source_size)
+                    throw std::invalid_argument{"Trying to merge a shard with a different source!"};
+
+                // The first and the last breakend of every shard are its sentinels.
+                std::size_t const offset = staged.size() - 1;
+                auto shard_begin = shard._breakend_map.begin();
+                for (auto breakend_it = std::ranges::next(shard_begin); breakend_it != std::ranges::prev(shard._breakend_map.end());
+                     ++breakend_it) {
+                    auto && breakend = *breakend_it;
+                    breakend_key_type const key = breakend.first;
+                    bool const is_indel = key.is_indel();
+                    bool const is_high = is_indel && key.indel_kind() == indel_breakend_kind::deletion_high;
+                    std::size_t id = stage(is_high ? high_ids : low_ids, key, coverage_t{breakend.second});
+                    if (!is_indel)
+                        continue;
+
+                    shard._indel_map.at(indel_key_type{key, breakend.second.front()}).visit(libjst::multi_invocable{
+                        [&] (deletion_type const & deletion) {
+                            staged[id].deletion_mate = offset + deletion.value();
+                        },
+                        [&] (insertion_type const & insertion) {
+                            staged[id].insertion = insertion_type{_alt_pool.intern(shard._alt_pool[insertion.value()])};
+                        }
+                    });
+                }
+            }
+            stage(high_ids, breakend_key_type{indel_breakend_kind::nil, source_size}, def_coverage);
+            finalise_breakends(staged, low_ids, high_ids);
+        }
+
+        /*!\brief Extends the coverage domain by new haplotypes and merges in their deltas in a single pass.
+         *
+         * \param[in] extended_domain The new coverage domain; must contain the current one and begin at its minimum.
+         * \param[in] deltas The deltas of the new haplotypes over the extended domain; should be sorted by their low
+         *                   breakend.
+         *
+         * \details
+         *
+         * The coverages of the stored deltas are carried over into the extended domain. A given delta with the same
+         * breakpoint and alternate sequence as a stored delta adds its coverage to the stored delta, all other deltas
+         * are added as new deltas. The stored and the given deltas are merged by their position and the breakend map
+         * is then rebuilt once, as in the bulk construction, instead of shifting the stored breakends for every new
+         * delta.
+         *
+         * ### Exception
+         *
+         * Throws std::domain_error if the extended domain does not contain the current domain or if the coverage
+         * domain of a given delta differs from the extended domain, and std::invalid_argument for an invalid SNV.
+         * The multisequence is left unchanged in these cases.
+         *
+         * ### Complexity
+         *
+         * Linear in the number of stored and given deltas and in the size of their coverages if the given deltas are
+         * sorted and only few deltas share a position, plus the sorting of the deletion ends as in the bulk
+         * construction.
+         */
+        template <std::ranges::input_range deltas_t>
+            requires std::convertible_to<std::ranges::range_reference_t<deltas_t>, value_type>
+        void extend(coverage_domain_type extended_domain, deltas_t && deltas) {
+            if (extended_domain.min() != _coverage_domain.min() || extended_domain.max() < _coverage_domain.max())
+                throw std::domain_error{"The extended coverage domain must contain the current coverage domain!"};
+
+            auto by_position = [] (value_type const & delta) { return libjst::low_breakend(delta); };
+            auto equal_delta = [] (value_type const & lhs, value_type const & rhs) {
+                return libjst::breakpoint_span(lhs) == libjst::breakpoint_span(rhs) &&
+                       std::ranges::equal(libjst::alt_sequence(lhs), libjst::alt_sequence(rhs));
+            };
+
+            std::vector<value_type> added{};
+            if constexpr (std::ranges::sized_range<deltas_t>)
+                added.reserve(std::ranges::size(deltas));
+            for (auto && delta : deltas) {
+                value_type value = (decltype(delta) &&) delta;
+                if (libjst::get_domain(libjst::coverage(value)) != extended_domain)
+                    throw std::domain_error{"Trying to insert an element from a different coverage domain!"};
+
+                to_low_key(value); // validates the snv before the multisequence is modified.
+                added.push_back(std::move(value));
+            }
+            if (!std::ranges::is_sorted(added, std::ranges::less{}, by_position))
+                std::ranges::stable_sort(added, std::ranges::less{}, by_position);
+
+            // The stored deltas are visited at their low breakends, which are ordered by their keys.
+            std::vector<value_type> merged{};
+            merged.reserve(size() + added.size());
+            std::vector<std::size_t> members{}; // the members of a stored coverage
+            auto added_it = added.begin();
+            auto sort_group = [&] (std::size_t const group_offset) {
+                auto group_begin = std::ranges::next(merged.begin(), group_offset);
+                if (!std::ranges::is_sorted(group_begin, merged.end(), std::ranges::less{}, to_low_key_fn()))
+                    std::ranges::stable_sort(group_begin, merged.end(), std::ranges::less{}, to_low_key_fn());
+            };
+            auto merge_preceding = [&] (auto const position) {
+                std::size_t const group_begin = merged.size();
+                for (; added_it != added.end() && libjst::low_breakend(*added_it) < position; ++added_it)
+                    merged.push_back(std::move(*added_it));
+                sort_group(group_begin);
+            };
+
+            auto const interior = libjst::interior_breakends(*this);
+            auto const breakend_end = interior.end();
+            for (auto breakend_it = interior.begin(); breakend_it != breakend_end;) {
+                auto const position = libjst::position(*breakend_it);
+                merge_preceding(position); // the new deltas in front of the stored deltas at this position
+
+                std::size_t const group_begin = merged.size();
+                for (; breakend_it != breakend_end && libjst::position(*breakend_it) == position; ++breakend_it) {
+                    if ((*breakend_it).get_breakpoint_end() == breakpoint_end::high)
+                        continue;
+
+                    value_type stored = *breakend_it;
+                    members.clear();
+                    libjst::for_each_covered(libjst::coverage(stored), _coverage_domain.min(), _coverage_domain.size(),
+                                             [&] (std::size_t const offset) {
+                        members.push_back(_coverage_domain.min() + offset);
+                    });
+                    libjst::coverage(stored) = coverage_t{members, extended_domain};
+                    merged.push_back(std::move(stored));
+                }
+                for (; added_it != added.end() && libjst::low_breakend(*added_it) == position; ++added_it) {
+                    auto stored_it = std::ranges::find_if(std::ranges::next(merged.begin(), group_begin), merged.end(),
+                                                          [&] (value_type const & delta) {
+                        return equal_delta(delta, *added_it);
+                    });
+                    if (stored_it != merged.end())
+                        detail::assign_coverage_union(libjst::coverage(*stored_it),
+                                                      libjst::coverage(*stored_it),
+                                                      libjst::coverage(*added_it));
+                    else
+                        merged.push_back(std::move(*added_it));
+                }
+                sort_group(group_begin);
+            }
+            std::size_t const tail_begin = merged.size(); // the new deltas behind the last stored delta
+            std::ranges::move(added_it, added.end(), std::back_inserter(merged));
+            sort_group(tail_begin);
+
+            _breakend_map = breakend_map_type{};
+            _indel_map.clear();
+            _alt_pool.clear();
+            _position_index = position_index_type{};
+            _variant_classes = variant_class_index{};
+            _carrier_counts = carrier_count_index{};
+            _coverage_domain = std::move(extended_domain);
+            assign_deltas(merged);
+        }
+
         iterator insert(value_type value) { // low_breakend, alt_sequence, coverage
             if (libjst::get_domain(libjst::coverage(value)) != _coverage_domain)
                 throw std::domain_error{"Trying to insert an element from a different coverage domain!"};
 
+            _position_index = position_index_type{};
+            _variant_classes = variant_class_index{};
+            _carrier_counts = carrier_count_index{};
             switch (select_delta_kind(value)) {
                 case detail::delta_kind::snv: return insert_snv_impl(std::move(value));
                 case detail::delta_kind::insertion: return insert_insertion_impl(std::move(value));
@@ -122,23 +407,120 @@ namespace libjst
             }
         }
 
-        // Check if given value is conflicting with some of the variants!
+        // Check if given value is conflicting with some of the variants at its position! See libjst::find_conflicts
+        // for batches of variants and for overlaps with deletions.
         constexpr bool has_conflicts(value_type const & value) const  noexcept {
             // find equal range in position
-            auto candidates = std::ranges::equal_range(std::ranges::next(_breakend_map.begin()),
-                                                       std::ranges::prev(_breakend_map.end()),
-                                                       libjst::low_breakend(value),
-                                                       std::ranges::less{},
-                                                       [] (auto && breakend) {
-                                                          return breakend.first.position();
-                                                       });
-            for (auto && breakend : candidates) {
-                if (!libjst::coverage_intersection(libjst::coverage(value), breakend.second).empty())
+            auto const position = libjst::low_breakend(value);
+            auto const interior = libjst::interior_breakends(_breakend_map);
+            auto breakend_it = std::ranges::max(interior.begin(), breakend_lower_bound(position));
+            for (auto breakend_end = interior.end(); breakend_it != breakend_end && (*breakend_it).first.position() == position; ++breakend_it) {
+                if (libjst::coverage_intersects(libjst::coverage(value), (*breakend_it).second))
                     return true;
             }
             return false;
         }
 
+        /*!\brief Returns an iterator to the first breakend at or behind the given source position.
+         *
+         * \details
+         *
+         * Uses the position index if it was built with build_position_index and otherwise the search index of the
+         * breakend map if it was built with build_search_index. Note that the first sentinel is found for position 0.
+         */
+        const_iterator lower_bound(libjst::breakend_t<value_type> const position) const {
+            return get_iterator(breakend_lower_bound(position));
+        }
+
+        /*!\brief Builds a libjst::sampled_position_index over the breakends, which speeds up lower_bound.
+         *
+         * \param[in] sample_distance The number of source positions per sample; must be a power of two.
+         *
+         * \details
+         *
+         * Every lookup of a position then costs a constant time access to the samples and a search within the
+         * breakends of a single block of the source, which pays off whenever many small regions or chunks are looked
+         * up, e.g. by libjst::partial_tree or libjst::region_viewer. The index is dropped by every modification of the
+         * multisequence.
+         *
+         * ### Exception
+         *
+         * Throws std::invalid_argument if the sample distance is not a power of two.
+         */
+        void build_position_index(std::size_t const sample_distance = position_index_type::default_sample_distance) {
+            auto positions = _breakend_map | std::views::transform([] (auto && breakend) -> std::size_t {
+                return breakend.first.position();
+            });
+            _position_index = position_index_type{positions, std::ranges::size(_source), sample_distance};
+        }
+
+        constexpr bool has_position_index() const noexcept {
+            return !_position_index.empty();
+        }
+
+        /*!\brief Builds a libjst::variant_class_index over the breakends.
+         *
+         * \details
+         *
+         * Traversals and viewers dispatch on the class of every breakend they visit. With the index the class is a
+         * single bit lookup at the index of the breakend within the multisequence, and runs of SNVs are found a word
+         * at a time. The index is dropped by every modification of the multisequence.
+         */
+        void build_variant_class_index() {
+            _variant_classes = variant_class_index{_breakend_map | std::views::transform([] (auto && breakend) {
+                return breakend.first;
+            })};
+        }
+
+        constexpr bool has_variant_class_index() const noexcept {
+            return !_variant_classes.empty();
+        }
+
+        //!\brief Returns the variant class index, which is empty unless built with build_variant_class_index.
+        constexpr variant_class_index const & variant_classes() const noexcept {
+            return _variant_classes;
+        }
+
+        /*!\brief Builds a libjst::carrier_count_index over the coverages of the breakends.
+         *
+         * \details
+         *
+         * Queries on common variants only, see libjst::min_support, compare the carrier count of every variant they
+         * branch into against a threshold. With the index this is a single lookup at the index of the breakend
+         * within the multisequence. The index is dropped by every modification of the multisequence.
+         */
+        void build_carrier_count_index() {
+            _carrier_counts = carrier_count_index{_breakend_map | std::views::transform([] (auto && breakend) {
+                return static_cast<std::size_t>(libjst::coverage_intersection_count(breakend.second, breakend.second));
+            })};
+        }
+
+        constexpr bool has_carrier_count_index() const noexcept {
+            return !_carrier_counts.empty();
+        }
+
+        //!\brief Returns the carrier count index, which is empty unless built with build_carrier_count_index.
+        constexpr carrier_count_index const & carrier_counts() const noexcept {
+            return _carrier_counts;
+        }
+
+        /*!\brief Builds a search index over the breakend keys, which speeds up lower_bound.
+         *
+         * \details
+         *
+         * The breakend map is searched whenever a tree over a chunk of the source is constructed, see for example
+         * libjst::partial_tree. For millions of breakends, the search index of the breakend map, see
+         * libjst::sorted_vector::build_search_index, answers these lookups with considerably fewer cache misses.
+         * It occupies one key and one rank per breakend and is dropped by every modification of the multisequence.
+         */
+        void build_search_index() {
+            _breakend_map.build_search_index();
+        }
+
+        constexpr bool has_search_index() const noexcept {
+            return _breakend_map.has_search_index();
+        }
+
         // void erase(const_iterator first = end(), const_iterator last = end()) {
 
         // }
@@ -147,9 +529,71 @@ namespace libjst
 
         // }
 
-        // constexpr dna_compressed_multisequence extract(coverage_t) const noexcept {
-        //     return leaves this without the coverages here and returns a new compressed mul
-        // }
+        /*!\brief Returns a new multisequence with the deltas of the given samples only.
+         *
+         * \param[in] samples The haplotypes to extract; must be a coverage over the coverage domain.
+         * \param[in] thread_count The number of threads projecting the coverages; defaults to 1.
+         *
+         * \details
+         *
+         * The coverage of every stored delta is intersected with the given samples and the remaining members are
+         * renumbered in their order into the compact domain `[0, n)`, where `n` is the number of selected samples.
+         * Deltas not covered by any selected sample are dropped. The breakends are split into blocks of consecutive
+         * positions, which are projected in parallel, and the extracted multisequence is built in place from the
+         * projected deltas in one pass, as in the bulk construction. This multisequence is not modified.
+         *
+         * ### Exception
+         *
+         * Throws std::domain_error if the samples have a different coverage domain. If a block fails to be projected,
+         * the first exception is rethrown after all threads have joined.
+         *
+         * ### Complexity
+         *
+         * Linear in the number of stored deltas and the sizes of their coverages, divided by the number of threads.
+         */
+        dna_compressed_multisequence extract(coverage_t const & samples, std::size_t const thread_count = 1) const {
+            if (libjst::get_domain(samples) != _coverage_domain)
+                throw std::domain_error{"Trying to extract samples from a different coverage domain!"};
+
+            // Maps the offset of a haplotype in the coverage domain to its id in the extracted domain.
+            std::vector<std::optional<std::size_t>> extracted_ids(_coverage_domain.size());
+            std::size_t sample_count{};
+            libjst::for_each_covered(samples, _coverage_domain.min(), _coverage_domain.size(),
+                                     [&] (std::size_t const offset) {
+                extracted_ids[offset] = sample_count++;
+            });
+            using domain_value_t = typename coverage_domain_type::value_type;
+            return project(extracted_ids, coverage_domain_type{0, static_cast<domain_value_t>(sample_count)},
+                           thread_count);
+        }
+
+        /*!\brief Returns a new multisequence whose coverages store the haplotypes in the order of the permutation.
+         *
+         * \param[in] permutation The permutation of the haplotypes, see libjst::sample_permutation.
+         * \param[in] thread_count The number of threads projecting the coverages; defaults to 1.
+         *
+         * \details
+         *
+         * The haplotype with the offset `i` in the coverage domain is stored at the row `permutation.row_of(i)` of the
+         * compact domain `[0, n)`. The coverages are projected in parallel like in extract. This multisequence is not
+         * modified.
+         *
+         * ### Exception
+         *
+         * Throws std::domain_error if the permutation has a different size than the coverage domain.
+         */
+        dna_compressed_multisequence reorder_samples(sample_permutation const & permutation,
+                                                     std::size_t const thread_count = 1) const {
+            if (permutation.size() != _coverage_domain.size())
+                throw std::domain_error{"The permutation has a different size than the coverage domain!"};
+
+            std::vector<std::optional<std::size_t>> permuted_ids(_coverage_domain.size());
+            for (std::size_t offset = 0; offset < permuted_ids.size(); ++offset)
+                permuted_ids[offset] = permutation.row_of(offset);
+            using domain_value_t = typename coverage_domain_type::value_type;
+            return project(permuted_ids, coverage_domain_type{0, static_cast<domain_value_t>(permutation.size())},
+                           thread_count);
+        }
 
         // constexpr source_t const & merge(dna_compressed_multisequence()) const noexcept {
         //      collision: like same coverage element in both multisequences.
@@ -172,6 +616,116 @@ namespace libjst
             return _coverage_domain;
         }
 
+        //!\brief Returns the memory allocated by the multisequence broken down by its components.
+        store_memory_usage memory_usage() const noexcept {
+            return store_memory_usage{
+                .source = libjst::memory_usage(_source),
+                .breakend_keys = _breakend_map.key_memory_usage(),
+                .coverages = _breakend_map.value_memory_usage(),
+                .alt_sequences = _alt_pool.memory_usage(),
+                .indel_map = _indel_map.memory_usage(),
+                .position_index = _position_index.memory_usage(),
+                .variant_classes = _variant_classes.memory_usage(),
+                .carrier_counts = _carrier_counts.memory_usage(),
+            };
+        }
+
+        /*!\brief Advises the kernel to back the largest arrays by transparent huge pages.
+         *
+         * \returns The number of bytes that were advised.
+         *
+         * \details
+         *
+         * Advises the breakend keys, the coverages and the source, if it is owned by the multisequence, which are
+         * accessed with little locality by the binary searches and seeks. Call it after the multisequence was built
+         * or loaded, since a modification may reallocate the arrays. See libjst::advise_huge_pages.
+         */
+        std::size_t advise_huge_pages() const noexcept {
+            return _breakend_map.advise_huge_pages() + libjst::advise_huge_pages(_source);
+        }
+
+        /*!\brief Validates the invariants of the breakends, the indels and the coverages in parallel.
+         *
+         * \param[in] thread_count The number of threads validating blocks of consecutive breakends.
+         *
+         * \returns The violated invariants, see libjst::store_invariant.
+         *
+         * \details
+         *
+         * Meant to be run after the multisequence was loaded or built from external input and before it is searched,
+         * as the traversals assume the invariants and read out of bounds instead of failing on a corrupted store.
+         * The breakends are split into one block per thread. The first sweep checks every breakend on its own and
+         * records per block the last variant beginning and the furthest reaching variant of every haplotype. The
+         * second sweep checks the variants of every haplotype for conflicts, starting with the state carried over
+         * from the preceding blocks.
+         *
+         * ### Complexity
+         *
+         * Linear in the number of breakends and the members of their coverages, plus the number of haplotypes times
+         * the number of threads.
+         */
+        store_validation_report validate(std::size_t const thread_count = 1) const {
+            std::size_t const breakend_count = std::ranges::size(_breakend_map);
+            std::size_t const block_count = std::clamp<std::size_t>(thread_count, 1, std::max<std::size_t>(breakend_count, 1));
+            std::size_t const haplotype_count = _coverage_domain.size();
+
+            std::vector<block_validation> blocks(block_count);
+            auto block_begin = [&] (std::size_t const block) { return block * breakend_count / block_count; };
+
+            // The haplotype states at the end of every block are only needed to start the subsequent blocks.
+            parallel_blocks(block_count, [&] (std::size_t const block) {
+                block_validation & validation = blocks[block];
+                if (block + 1 < block_count)
+                    validation.state.assign(haplotype_count, haplotype_state{});
+                validate_breakends(validation, block_begin(block), block_begin(block + 1));
+            });
+
+            std::vector<haplotype_state> carried(haplotype_count);
+            for (std::size_t block = 0; block < block_count; ++block) {
+                blocks[block].carried = carried;
+                if (block + 1 < block_count)
+                    for (std::size_t haplotype = 0; haplotype < haplotype_count; ++haplotype)
+                        carried[haplotype].merge(blocks[block].state[haplotype]);
+            }
+
+            parallel_blocks(block_count, [&] (std::size_t const block) {
+                block_validation & validation = blocks[block];
+                validate_conflicts(validation, block_begin(block), block_begin(block + 1));
+                validation.carried = std::vector<haplotype_state>{};
+            });
+
+            store_validation_report report{};
+            std::size_t indel_count{};
+            for (block_validation & validation : blocks) {
+                indel_count += validation.indel_count;
+                std::ranges::stable_sort(validation.violations, std::ranges::less{}, &store_violation::breakend_index);
+                for (store_violation & violation : validation.violations)
+                    report_violation(report, std::move(violation));
+                report.truncated |= validation.truncated;
+            }
+
+            if (breakend_count < 2 || !is_sentinel((*_breakend_map.begin()).first, 0) ||
+                !is_sentinel((*std::ranges::prev(_breakend_map.end())).first, std::ranges::size(_source))) {
+                report.violations.insert(report.violations.begin(), store_violation{
+                    .invariant = store_invariant::sentinels,
+                    .message = "The breakends must begin and end with the sentinels at 0 and " +
+                               std::to_string(std::ranges::size(_source)) + "."
+                });
+                if (report.violations.size() > store_validation_report::max_violations) {
+                    report.violations.pop_back();
+                    report.truncated = true;
+                }
+            }
+            if (indel_count != _indel_map.size())
+                report_violation(report, store_violation{
+                    .invariant = store_invariant::indel_entry,
+                    .breakend_index = breakend_count,
+                    .message = "The indel map stores " + std::to_string(_indel_map.size()) + " indels for " +
+                               std::to_string(indel_count) + " indel breakends."
+                });
+            return report;
+        }
+
         constexpr iterator begin() noexcept {
             return get_iterator(_breakend_map.begin());
         }
@@ -192,20 +746,496 @@ namespace libjst
         // Serialisation
         // ----------------------------------------------------------------------------
 
+        // The source is archived as libjst::packed_dna_sequence with two bits per base and unpacked when loaded.
         template <typename archive_t>
         void load(archive_t & iarchive)
         {
-            iarchive(_source, _breakend_map, /*_indel_map,*/ _coverage_domain);
+            std::vector<indel_record> indel_records{};
+            packed_dna_sequence packed_source{};
+            _position_index = position_index_type{};
+            _variant_classes = variant_class_index{};
+            _carrier_counts = carrier_count_index{};
+            iarchive(packed_source, _breakend_map, indel_records, _coverage_domain, _alt_pool);
+
+            source_t source{};
+            if constexpr (requires { source.reserve(packed_source.size()); })
+                source.reserve(packed_source.size());
+            packed_source.unpack(std::back_inserter(source));
+            _source = std::move(source);
+
+            _indel_map.clear();
+            _indel_map.reserve(indel_records.size());
+            for (indel_record & record : indel_records) {
+                indel_key_type indel_key{std::move(record.key), std::move(record.coverage_head)};
+                if (record.is_deletion) {
+                    deletion_type deletion{record.mate_position};
+                    _indel_map.emplace(std::move(indel_key), std::move(deletion));
+                } else {
+                    _indel_map.emplace(std::move(indel_key), insertion_type{std::move(record.insertion)});
+                }
+            }
         }
 
         template <typename archive_t>
         void save(archive_t & oarchive) const
         {
-            oarchive(_source, _breakend_map, /*_indel_map,*/ _coverage_domain);
+            std::vector<indel_record> indel_records{};
+            indel_records.reserve(_indel_map.size());
+            for (std::size_t id = 0; id < _indel_map.size(); ++id) {
+                indel_key_type const & indel_key = _indel_map.keys()[id];
+                indel_record & record = indel_records.emplace_back(indel_record{.key = indel_key.first,
+                                                                                .coverage_head = indel_key.second});
+                _indel_map.indels()[id].visit(libjst::multi_invocable{
+                    [&] (deletion_type const & deletion) {
+                        record.is_deletion = true;
+                        record.mate_position = deletion.value();
+                    },
+                    [&] (insertion_type const & insertion) {
+                        record.insertion = insertion.value();
+                    }
+                });
+            }
+            oarchive(packed_dna_sequence{_source}, _breakend_map, indel_records, _coverage_domain, _alt_pool);
         }
 
     private:
 
+        // Renumbers the members of all coverages by the given ids, dropping the members without an id and the deltas
+        // without any member. The breakends are split into blocks of consecutive positions projected in parallel.
+        dna_compressed_multisequence project(std::vector<std::optional<std::size_t>> const & projected_ids,
+                                             coverage_domain_type projected_domain,
+                                             std::size_t const thread_count) const {
+            std::size_t const domain_size = _coverage_domain.size();
+            // The sentinels are not projected.
+            std::size_t const breakend_count = size() - 2;
+            std::size_t const block_count = std::clamp<std::size_t>(thread_count, 1,
+                                                                    std::max<std::size_t>(breakend_count, 1));
+            std::size_t const block_size = (breakend_count + block_count - 1) / block_count;
+            std::vector<std::vector<value_type>> blocks(block_count);
+            std::vector<std::exception_ptr> errors(block_count);
+
+            auto project_block = [&] (std::size_t const block_id) {
+                try {
+                    std::size_t const first = 1 + std::min(block_id * block_size, breakend_count);
+                    std::size_t const last = 1 + std::min(first - 1 + block_size, breakend_count);
+                    std::vector<std::size_t> members{};
+                    auto breakend_it = std::ranges::next(begin(), first);
+                    auto breakend_end = std::ranges::next(begin(), last);
+                    for (; breakend_it != breakend_end; ++breakend_it) {
+                        if ((*breakend_it).get_breakpoint_end() == breakpoint_end::high)
+                            continue;
+
+                        members.clear();
+                        libjst::for_each_covered(libjst::coverage(*breakend_it), _coverage_domain.min(), domain_size,
+                                                 [&] (std::size_t const offset) {
+                            if (projected_ids[offset].has_value())
+                                members.push_back(*projected_ids[offset]);
+                        });
+                        if (members.empty())
+                            continue;
+                        if (!std::ranges::is_sorted(members))
+                            std::ranges::sort(members);
+
+                        value_type extracted = *breakend_it;
+                        libjst::coverage(extracted) = coverage_t{members, projected_domain};
+                        blocks[block_id].push_back(std::move(extracted));
+                    }
+                } catch (...) {
+                    errors[block_id] = std::current_exception();
+                }
+            };
+
+            std::vector<std::thread> workers{};
+            workers.reserve(block_count - 1);
+            for (std::size_t block_id = 1; block_id < block_count; ++block_id)
+                workers.emplace_back(project_block, block_id);
+
+            project_block(0); // the calling thread projects the first block.
+            std::ranges::for_each(workers, [] (std::thread & worker) { worker.join(); });
+
+            if (auto error = std::ranges::find_if(errors, [] (std::exception_ptr const & e) { return e != nullptr; });
+                error != errors.end())
+                std::rethrow_exception(*error);
+
+            // The blocks are ordered by position and so are the deltas in their concatenation.
+            return dna_compressed_multisequence{_source, std::move(projected_domain), blocks | std::views::join};
+        }
+
+        // ----------------------------------------------------------------------------
+        // Validation
+        // ----------------------------------------------------------------------------
+
+        //!\brief The variants of a haplotype seen so far by the validation.
+        struct haplotype_state {
+            static constexpr std::size_t none{std::numeric_limits<std::size_t>::max()};
+
+            std::size_t last_begin{none}; // the low breakend of the last variant
+            std::size_t reach{}; // the high breakend of the furthest reaching variant
+
+            //!\brief Returns whether a variant beginning at the given position conflicts with the seen variants.
+            constexpr bool conflicts(std::size_t const position) const noexcept {
+                return position == last_begin || position < reach;
+            }
+
+            constexpr void add(std::size_t const position, std::size_t const end) noexcept {
+                last_begin = position;
+                reach = std::max(reach, end);
+            }
+
+            //!\brief Appends the state of a subsequent block.
+            constexpr void merge(haplotype_state const & next) noexcept {
+                if (next.last_begin != none)
+                    last_begin = next.last_begin;
+                reach = std::max(reach, next.reach);
+            }
+        };
+
+        struct block_validation {
+            std::vector<store_violation> violations{};
+            bool truncated{false};
+            std::size_t indel_count{};
+            std::vector<haplotype_state> state{}; // the states at the end of the block
+            std::vector<haplotype_state> carried{}; // the states at the begin of the block
+        };
+
+        template <typename fn_t>
+        static void parallel_blocks(std::size_t const block_count, fn_t && fn) {
+            std::vector<std::exception_ptr> errors(block_count);
+            auto work = [&] (std::size_t const block) {
+                try {
+                    fn(block);
+                } catch (...) {
+                    errors[block] = std::current_exception();
+                }
+            };
+
+            std::vector<std::thread> workers{};
+            workers.reserve(block_count - 1);
+            for (std::size_t block = 1; block < block_count; ++block)
+                workers.emplace_back(work, block);
+
+            work(0);
+            std::ranges::for_each(workers, [] (std::thread & worker) { worker.join(); });
+
+            if (auto error = std::ranges::find_if(errors, [] (std::exception_ptr const & e) { return e != nullptr; });
+                error != errors.end())
+                std::rethrow_exception(*error);
+        }
+
+        static void report_violation(store_validation_report & report, store_violation violation) {
+            if (report.violations.size() < store_validation_report::max_violations)
+                report.violations.push_back(std::move(violation));
+            else
+                report.truncated = true;
+        }
+
+        static void report_violation(block_validation & validation, store_violation violation) {
+            if (validation.violations.size() < store_validation_report::max_violations)
+                validation.violations.push_back(std::move(violation));
+            else
+                validation.truncated = true;
+        }
+
+        constexpr auto breakend_at(std::size_t const index) const noexcept {
+            return *std::ranges::next(_breakend_map.begin(), index);
+        }
+
+        static constexpr bool is_sentinel(breakend_key_type const & key, std::size_t const position) noexcept {
+            return key.is_indel() && key.indel_kind() == indel_breakend_kind::nil && key.position() == position;
+        }
+
+        //!\brief Returns the indel of the breakend or `nullptr` if it is not stored in the indel map.
+        indel_type const * find_indel(std::size_t const index) const noexcept {
+            auto const breakend = breakend_at(index);
+            if (breakend.second.empty())
+                return nullptr;
+            return _indel_map.find(indel_key_type{breakend.first, breakend.second.front()});
+        }
+
+        //!\brief Returns the index of the mate of a deletion breakend if it is stored in the breakend map.
+        std::optional<std::size_t> find_deletion_mate(std::size_t const index) const noexcept {
+            indel_type const * indel = find_indel(index);
+            deletion_type const * deletion = (indel != nullptr) ? std::get_if<deletion_type>(std::addressof(indel->value()))
+                                                                : nullptr;
+            if (deletion == nullptr || deletion->value() >= std::ranges::size(_breakend_map))
+                return std::nullopt;
+            return deletion->value();
+        }
+
+        //!\brief Returns the end of the variant beginning at the given breakend or std::nullopt for high breakends.
+        std::optional<std::size_t> variant_end(std::size_t const index) const noexcept {
+            breakend_key_type const key = breakend_at(index).first;
+            if (!key.is_indel())
+                return key.position() + 1;
+
+            switch (key.indel_kind()) {
+                case indel_breakend_kind::insertion_low: return key.position();
+                case indel_breakend_kind::deletion_low: {
+                    std::optional<std::size_t> mate = find_deletion_mate(index);
+                    return (mate.has_value()) ? std::max<std::size_t>(breakend_at(*mate).first.position(),
+                                                                      key.position())
+                                              : key.position();
+                }
+                default: return std::nullopt;
+            }
+        }
+
+        //!\brief Checks the breakends in `[first, last)` and records the haplotype states at the end of the block.
+        void validate_breakends(block_validation & validation, std::size_t const first, std::size_t const last) const {
+            std::size_t const breakend_count = std::ranges::size(_breakend_map);
+            std::size_t const source_size = std::ranges::size(_source);
+            auto violate = [&] (store_invariant const invariant, std::size_t const index, std::string message) {
+                report_violation(validation, store_violation{invariant, index, std::move(message)});
+            };
+
+            for (std::size_t index = first; index < last; ++index) {
+                auto const breakend = breakend_at(index);
+                breakend_key_type const key = breakend.first;
+                std::size_t const position = key.position();
+
+                if (index > 0 && breakend_key_type{breakend_at(index - 1).first} > key)
+                    violate(store_invariant::breakend_order, index, "The breakend precedes its predecessor.");
+                if (position > source_size || (!key.is_indel() && position == source_size))
+                    violate(store_invariant::breakend_order, index, "The breakend at " + std::to_string(position) +
+                                                                    " exceeds the source.");
+                if (libjst::get_domain(breakend.second) != _coverage_domain)
+                    violate(store_invariant::coverage_domain, index, "The coverage has a different domain.");
+
+                if (key.is_indel() && key.indel_kind() == indel_breakend_kind::nil) {
+                    if (index != 0 && index + 1 != breakend_count)
+                        violate(store_invariant::sentinels, index, "A sentinel is stored between the breakends.");
+                } else if (key.is_indel()) {
+                    ++validation.indel_count;
+                    validate_indel(validation, index);
+                }
+
+                if (!validation.state.empty()) {
+                    if (std::optional<std::size_t> end = variant_end(index); end.has_value()) {
+                        libjst::for_each_covered(breakend.second, _coverage_domain.min(), _coverage_domain.size(),
+                                                 [&] (std::size_t const haplotype) {
+                            validation.state[haplotype].add(position, *end);
+                        });
+                    }
+                }
+            }
+        }
+
+        //!\brief Checks the indel entry of the breakend and the mate of a deletion.
+        void validate_indel(block_validation & validation, std::size_t const index) const {
+            auto const breakend = breakend_at(index);
+            indel_breakend_kind const kind = breakend.first.indel_kind();
+            auto violate = [&] (store_invariant const invariant, std::string message) {
+                report_violation(validation, store_violation{invariant, index, std::move(message)});
+            };
+
+            indel_type const * indel = find_indel(index);
+            if (indel == nullptr) {
+                violate(store_invariant::indel_entry, "The indel breakend has no entry in the indel map.");
+                return;
+            }
+
+            if (kind == indel_breakend_kind::insertion_low) {
+                insertion_type const * insertion = std::get_if<insertion_type>(std::addressof(indel->value()));
+                if (insertion == nullptr)
+                    violate(store_invariant::indel_entry, "The insertion breakend refers to a deletion.");
+                else if (insertion->value().offset + insertion->value().size > std::ranges::size(_alt_pool.data()))
+                    violate(store_invariant::alt_sequence, "The inserted sequence exceeds the alternate sequences.");
+                return;
+            }
+
+            if (std::get_if<deletion_type>(std::addressof(indel->value())) == nullptr) {
+                violate(store_invariant::indel_entry, "The deletion breakend refers to an insertion.");
+                return;
+            }
+
+            std::optional<std::size_t> mate = find_deletion_mate(index);
+            bool const is_low = kind == indel_breakend_kind::deletion_low;
+            indel_breakend_kind const mate_kind = is_low ? indel_breakend_kind::deletion_high
+                                                         : indel_breakend_kind::deletion_low;
+            if (!mate.has_value()) {
+                violate(store_invariant::deletion_mate, "The mate of the deletion is not a breakend.");
+            } else if (breakend_key_type const mate_key = breakend_at(*mate).first;
+                       !mate_key.is_indel() || mate_key.indel_kind() != mate_kind) {
+                violate(store_invariant::deletion_mate, "The mate at " + std::to_string(*mate) +
+                                                        " is not the other end of a deletion.");
+            } else if (is_low ? (*mate <= index || mate_key.position() <= breakend.first.position())
+                              : (*mate >= index || mate_key.position() >= breakend.first.position())) {
+                violate(store_invariant::deletion_mate, "The mate at " + std::to_string(*mate) +
+                                                        " is on the wrong side of the deletion.");
+            } else if (find_deletion_mate(*mate) != index) {
+                violate(store_invariant::deletion_mate, "The mate at " + std::to_string(*mate) +
+                                                        " does not refer back to the breakend.");
+            } else if (is_low && !std::ranges::equal(breakend.second, breakend_at(*mate).second)) {
+                violate(store_invariant::deletion_mate, "The mate at " + std::to_string(*mate) +
+                                                        " has a different coverage.");
+            }
+        }
+
+        //!\brief Checks the variants beginning in `[first, last)` for conflicts with the variants of their haplotypes.
+        void validate_conflicts(block_validation & validation, std::size_t const first, std::size_t const last) const {
+            std::vector<haplotype_state> & state = validation.carried;
+            for (std::size_t index = first; index < last; ++index) {
+                std::optional<std::size_t> end = variant_end(index);
+                if (!end.has_value())
+                    continue;
+
+                std::size_t const position = breakend_at(index).first.position();
+                libjst::for_each_covered(breakend_at(index).second, _coverage_domain.min(), _coverage_domain.size(),
+                                         [&] (std::size_t const haplotype) {
+                    if (state[haplotype].conflicts(position))
+                        report_violation(validation, store_violation{
+                            store_invariant::haplotype_conflict, index,
+                            "The variant at " + std::to_string(position) + " overlaps another variant of haplotype " +
+                            std::to_string(haplotype) + "."
+                        });
+                    state[haplotype].add(position, *end);
+                });
+            }
+        }
+
+        //!\brief Returns the size of the source or throws std::length_error if it exceeds the range of the breakend keys.
+        libjst::breakend_t<value_type> check_source_size() const {
+            using position_t = libjst::breakend_t<value_type>;
+            constexpr std::size_t max_size = std::min<std::size_t>(breakend_key_type::max_position,
+                                                                   std::numeric_limits<position_t>::max());
+            if (std::ranges::size(_source) > max_size)
+                throw std::length_error{"The source size exceeds the maximal position of the breakend keys! "
+                                        "Consider using a wider breakend position type."};
+            return std::ranges::size(_source);
+        }
+
+        //!\brief Stages the breakends of the given deltas, see the bulk constructor, and builds the maps from them.
+        template <typename deltas_t>
+        void assign_deltas(deltas_t && deltas) {
+            using position_t = libjst::breakend_t<value_type>;
+            position_t source_size = check_source_size();
+            coverage_t def_coverage{std::views::iota(_coverage_domain.min(), _coverage_domain.max()), _coverage_domain};
+
+            std::vector<staged_breakend> staged{};
+            std::vector<std::size_t> low_ids{};
+            std::vector<std::size_t> high_ids{};
+            if constexpr (std::ranges::sized_range<deltas_t>) {
+                staged.reserve(std::ranges::size(deltas) + 2);
+                low_ids.reserve(std::ranges::size(deltas) + 1);
+            }
+
+            auto stage = [&] (std::vector<std::size_t> & ids, breakend_key_type key, coverage_t coverage) -> std::size_t {
+                ids.push_back(staged.size());
+                staged.push_back(staged_breakend{.key = std::move(key), .coverage = std::move(coverage)});
+                return staged.size() - 1;
+            };
+
+            stage(low_ids, breakend_key_type{indel_breakend_kind::nil, 0}, def_coverage);
+            for (auto && delta : deltas) {
+                value_type value = (decltype(delta) &&) delta;
+                if (libjst::get_domain(libjst::coverage(value)) != _coverage_domain)
+                    throw std::domain_error{"Trying to insert an element from a different coverage domain!"};
+
+                detail::delta_kind const kind = select_delta_kind(value);
+                using underlying_kind_t = std::underlying_type_t<detail::delta_kind>;
+                auto has_kind = [&] (detail::delta_kind const query) {
+                    return static_cast<underlying_kind_t>(kind) & static_cast<underlying_kind_t>(query);
+                };
+
+                if (kind == detail::delta_kind::snv) {
+                    stage(low_ids, breakend_key_type{to_snv_code(value), libjst::low_breakend(value)},
+                          libjst::coverage(value));
+                    continue;
+                }
+
+                if (has_kind(detail::delta_kind::insertion)) {
+                    std::size_t id = stage(low_ids,
+                                           breakend_key_type{indel_breakend_kind::insertion_low, libjst::low_breakend(value)},
+                                           libjst::coverage(value));
+                    staged[id].insertion = insertion_type{_alt_pool.intern(libjst::alt_sequence(value))};
+                }
+
+                if (has_kind(detail::delta_kind::deletion)) {
+                    std::size_t low_id = stage(low_ids,
+                                               breakend_key_type{indel_breakend_kind::deletion_low, libjst::low_breakend(value)},
+                                               libjst::coverage(value));
+                    std::size_t high_id = stage(high_ids,
+                                                breakend_key_type{indel_breakend_kind::deletion_high, libjst::high_breakend(value)},
+                                                libjst::coverage(value));
+                    staged[low_id].deletion_mate = high_id;
+                    staged[high_id].deletion_mate = low_id;
+                }
+            }
+            stage(high_ids, breakend_key_type{indel_breakend_kind::nil, source_size}, def_coverage);
+            finalise_breakends(staged, low_ids, high_ids);
+        }
+
+        //!\brief Returns the first breakend of the map at or behind the given position.
+        std::ranges::iterator_t<breakend_map_type const> breakend_lower_bound(std::size_t const position) const {
+            breakend_key_type const key{indel_breakend_kind::nil, static_cast<position_type>(position)};
+            if (!has_position_index())
+                return _breakend_map.lower_bound(key);
+
+            auto [first, last] = _position_index.candidates(position);
+            auto map_begin = _breakend_map.begin();
+            return std::ranges::lower_bound(std::ranges::next(map_begin, first), std::ranges::next(map_begin, last),
+                                            key, std::ranges::less{}, [] (auto && breakend) { return breakend.first; });
+        }
+
+        //!\brief Returns the key of the low breakend of the given snv, insertion or deletion.
+        breakend_key_type to_low_key(value_type const & value) {
+            switch (select_delta_kind(value)) {
+                case detail::delta_kind::snv:
+                    return breakend_key_type{to_snv_code(value), libjst::low_breakend(value)};
+                case detail::delta_kind::insertion:
+                    return breakend_key_type{indel_breakend_kind::insertion_low, libjst::low_breakend(value)};
+                default:
+                    return breakend_key_type{indel_breakend_kind::deletion_low, libjst::low_breakend(value)};
+            }
+        }
+
+        auto to_low_key_fn() noexcept {
+            return [this] (value_type const & value) { return to_low_key(value); };
+        }
+
+        //!\brief Builds the breakend map and the indel map from the staged breakends in a single pass.
+        void finalise_breakends(std::vector<staged_breakend> & staged,
+                                std::vector<std::size_t> & low_ids,
+                                std::vector<std::size_t> & high_ids) {
+            auto by_key = [&] (std::size_t const id) -> breakend_key_type const & { return staged[id].key; };
+            if (!std::ranges::is_sorted(low_ids, std::ranges::less{}, by_key))
+                std::ranges::stable_sort(low_ids, std::ranges::less{}, by_key);
+            if (!std::ranges::is_sorted(high_ids, std::ranges::less{}, by_key))
+                std::ranges::stable_sort(high_ids, std::ranges::less{}, by_key);
+
+            std::vector<std::size_t> order{};
+            order.reserve(staged.size());
+            std::ranges::merge(low_ids, high_ids, std::back_inserter(order), std::ranges::less{}, by_key, by_key);
+
+            std::vector<std::size_t> final_position(staged.size());
+            _breakend_map.reserve(order.size());
+            for (std::size_t position = 0; position < order.size(); ++position) {
+                staged_breakend & breakend = staged[order[position]];
+                _breakend_map.emplace_hint(_breakend_map.end(), breakend.key, std::move(breakend.coverage));
+                final_position[order[position]] = position;
+            }
+
+            // Visiting the breakends in the final order appends the indels to the index in key order.
+            auto map_begin = _breakend_map.begin();
+            _indel_map.reserve(std::ranges::count_if(staged, [] (staged_breakend const & breakend) {
+                return breakend.insertion.has_value() || breakend.deletion_mate.has_value();
+            }));
+            for (std::size_t position = 0; position < order.size(); ++position) {
+                std::size_t const id = order[position];
+                if (!staged[id].insertion.has_value() && !staged[id].deletion_mate.has_value())
+                    continue; // the coverage of a sentinel may be empty.
+
+                auto breakend_it = std::ranges::next(map_begin, position);
+                indel_key_type indel_key{breakend_it->first, breakend_it->second.front()};
+                if (staged[id].insertion.has_value()) {
+                    _indel_map.emplace(std::move(indel_key), std::move(*staged[id].insertion));
+                } else if (staged[id].deletion_mate.has_value()) {
+                    deletion_type deletion{final_position[*staged[id].deletion_mate]};
+                    _indel_map.emplace(std::move(indel_key), std::move(deletion));
+                }
+            }
+        }
+
         constexpr detail::delta_kind select_delta_kind(value_type const & value) {
             detail::delta_kind kind{detail::delta_kind::snv};
             if (libjst::breakpoint_span(value) != 1 || std::ranges::size(libjst::alt_sequence(value)) != 1) {
@@ -224,11 +1254,13 @@ namespace libjst
         }
 
         constexpr iterator get_iterator(std::ranges::iterator_t<breakend_map_type> it) noexcept {
-            return iterator{std::move(it), std::addressof(_indel_map)};
+            return iterator{std::move(it), std::addressof(_breakend_map), std::addressof(_indel_map),
+                            std::addressof(_alt_pool)};
         }
 
         constexpr const_iterator get_iterator(std::ranges::iterator_t<breakend_map_type const> it) const noexcept {
-            return const_iterator{std::move(it), std::addressof(_indel_map)};
+            return const_iterator{std::move(it), std::addressof(_breakend_map), std::addressof(_indel_map),
+                                  std::addressof(_alt_pool)};
         }
 
         template <typename code_t, typename fwd_value_t>
@@ -241,12 +1273,27 @@ namespace libjst
                     position = libjst::high_breakend((fwd_value_t &&)value);
                 }
             }
-            return _breakend_map.emplace_hint(std::ranges::prev(_breakend_map.end()),
-                                              breakend_key_type{code, position},
-                                              libjst::coverage((fwd_value_t &&) value));
+            auto breakend_it = _breakend_map.emplace_hint(std::ranges::prev(_breakend_map.end()),
+                                                          breakend_key_type{code, position},
+                                                          libjst::coverage((fwd_value_t &&) value));
+            shift_deletion_mates(std::ranges::distance(_breakend_map.begin(), breakend_it));
+            return breakend_it;
         }
 
-        iterator insert_snv_impl(value_type value) {
+        //!\brief Moves the deletion mates behind the breakend that was inserted at the given position by one.
+        void shift_deletion_mates(size_type const inserted_position) noexcept {
+            if (inserted_position + 2 == std::ranges::size(_breakend_map)) // appended before the sink, which is never a mate.
+                return;
+
+            for (indel_type & indel : _indel_map.mutable_indels()) {
+                if (deletion_type * deletion = std::get_if<deletion_type>(std::addressof(indel.value()));
+                    deletion != nullptr && deletion->value() >= inserted_position) {
+                    ++deletion->value();
+                }
+            }
+        }
+
+        static uint8_t to_snv_code(value_type const & value) {
             assert(libjst::breakpoint_span(value) == 1);
             assert(std::ranges::size(libjst::alt_sequence(value)) == 1);
 
@@ -255,28 +1302,34 @@ namespace libjst
             if (snv_rank == 4)
                 throw std::invalid_argument{"Invalid SNV value. Expected one of 'A', 'C', 'G', 'T', but got " +
                                             std::string{snv_value} + " instead."};
+            return snv_rank;
+        }
 
+        iterator insert_snv_impl(value_type value) {
+            uint8_t const snv_rank = to_snv_code(value);
             auto breakend_it = insert_breakend(snv_rank, std::move(value));
             return get_iterator(std::move(breakend_it));
         }
 
         iterator insert_deletion_impl(value_type value) {
             // coverages are linked
-            auto low_it = insert_breakend(indel_breakend_kind::deletion_low, value);
-            auto high_it = insert_breakend(indel_breakend_kind::deletion_high, std::move(value));
-
-            deletion_type low_deletion{high_it};
-            deletion_type high_deletion{low_it};
-            _indel_map.emplace(indel_key_type{low_it->first, low_it->second.front()}, low_deletion);
-            _indel_map.emplace(indel_key_type{high_it->first, high_it->second.front()}, high_deletion);
-
-            // TODO: fix resolving the updates of the deletion variants.
+            // the high breakend is always inserted behind the low breakend and does not move it.
+            size_type const low_position =
+                std::ranges::distance(_breakend_map.begin(), insert_breakend(indel_breakend_kind::deletion_low, value));
+            size_type const high_position =
+                std::ranges::distance(_breakend_map.begin(),
+                                      insert_breakend(indel_breakend_kind::deletion_high, std::move(value)));
+
+            auto low_it = std::ranges::next(_breakend_map.begin(), low_position);
+            auto high_it = std::ranges::next(_breakend_map.begin(), high_position);
+            _indel_map.emplace(indel_key_type{low_it->first, low_it->second.front()}, deletion_type{high_position});
+            _indel_map.emplace(indel_key_type{high_it->first, high_it->second.front()}, deletion_type{low_position});
 
             return get_iterator(std::move(low_it));
         }
 
         iterator insert_insertion_impl(value_type value) {
-            insertion_type insertion{std::move(libjst::alt_sequence(value))};
+            insertion_type insertion{_alt_pool.intern(libjst::alt_sequence(value))};
             auto breakend_it = insert_breakend(indel_breakend_kind::insertion_low, std::move(value));
             _indel_map.emplace(indel_key_type{breakend_it->first, breakend_it->second.front()}, std::move(insertion));
 
@@ -285,10 +1338,10 @@ namespace libjst
 
     };
 
-    template <typename source_t, typename coverage_t>
+    template <typename source_t, typename coverage_t, std::unsigned_integral breakend_position_t, typename coverage_store_t>
         requires std::same_as<std::ranges::range_value_t<source_t>, char>
     template <bool is_const>
-    class dna_compressed_multisequence<source_t, coverage_t>::iterator_impl {
+    class dna_compressed_multisequence<source_t, coverage_t, breakend_position_t, coverage_store_t>::iterator_impl {
 
         friend dna_compressed_multisequence;
 
@@ -299,11 +1352,18 @@ namespace libjst
         using breakend_iterator = std::ranges::iterator_t<maybe_const_map_type>;
 
         breakend_iterator _breakend_it{};
+        breakend_map_type const * _breakend_map{};
         indel_map_type const * _indel_map{};
+        alt_pool_type const * _alt_pool{};
 
-        explicit constexpr iterator_impl(breakend_iterator breakend_it, indel_map_type const * indel_map) noexcept :
+        explicit constexpr iterator_impl(breakend_iterator breakend_it,
+                                         breakend_map_type const * breakend_map,
+                                         indel_map_type const * indel_map,
+                                         alt_pool_type const * alt_pool) noexcept :
             _breakend_it{std::move(breakend_it)},
-            _indel_map{indel_map}
+            _breakend_map{breakend_map},
+            _indel_map{indel_map},
+            _alt_pool{alt_pool}
         {}
 
     public:
@@ -317,15 +1377,17 @@ namespace libjst
         constexpr iterator_impl() = default;
         constexpr iterator_impl(iterator_impl<!is_const> other) noexcept requires is_const :
             _breakend_it{std::move(other._breakend_it)},
-            _indel_map{other._indel_map}
+            _breakend_map{other._breakend_map},
+            _indel_map{other._indel_map},
+            _alt_pool{other._alt_pool}
         {}
 
         constexpr reference operator*() const noexcept {
-            return reference{*_breakend_it, *_indel_map};
+            return reference{*_breakend_it, *_breakend_map, *_indel_map, *_alt_pool};
         }
 
         constexpr reference operator[](difference_type const step) const noexcept {
-            return *(this->operator+(step));
+            return *(*this + step);
         }
 
         constexpr iterator_impl & operator++() noexcept {
@@ -360,6 +1422,11 @@ namespace libjst
             return *this;
         }
 
+        //!\brief Prefetches the breakend the given number of steps ahead, see libjst::contiguous_multimap.
+        [[gnu::always_inline]] void prefetch(difference_type const distance) const noexcept {
+            libjst::prefetch_ahead(_breakend_it, distance);
+        }
+
     private:
 
         constexpr friend iterator_impl operator+(iterator_impl lhs, difference_type const step) noexcept {
@@ -387,10 +1454,10 @@ namespace libjst
         }
     };
 
-    template <typename source_t, typename coverage_t>
+    template <typename source_t, typename coverage_t, std::unsigned_integral breakend_position_t, typename coverage_store_t>
         requires std::same_as<std::ranges::range_value_t<source_t>, char>
     template <typename breakend_iterator>
-    class dna_compressed_multisequence<source_t, coverage_t>::delta_proxy {
+    class dna_compressed_multisequence<source_t, coverage_t, breakend_position_t, coverage_store_t>::delta_proxy {
 
         friend dna_compressed_multisequence;
 
@@ -399,11 +1466,18 @@ namespace libjst
         using sequence_reference = source_type;
 
         breakend_reference_t _breakend_reference;
+        breakend_map_type const & _breakend_map;
         indel_map_type const & _indel_map;
+        alt_pool_type const & _alt_pool;
 
-        explicit constexpr delta_proxy(breakend_reference_t breakend_reference, indel_map_type const & indel_map) noexcept :
+        explicit constexpr delta_proxy(breakend_reference_t breakend_reference,
+                                       breakend_map_type const & breakend_map,
+                                       indel_map_type const & indel_map,
+                                       alt_pool_type const & alt_pool) noexcept :
             _breakend_reference{breakend_reference},
-            _indel_map{indel_map}
+            _breakend_map{breakend_map},
+            _indel_map{indel_map},
+            _alt_pool{alt_pool}
         {}
 
     public:
@@ -412,13 +1486,18 @@ namespace libjst
 
         constexpr operator value_type() const noexcept {
             auto seq = libjst::alt_sequence(*this);
-            return value_type{libjst::get_breakpoint(*this), source_t{seq.begin(), seq.end()}, libjst::coverage(*this)};
+            return value_type{libjst::get_breakpoint(*this), source_t{seq.begin(), seq.end()}, coverage_t{libjst::coverage(*this)}};
         }
 
         constexpr breakend_key_type get_key() const noexcept {
             return _breakend_reference.first;
         }
 
+        //!\brief Whether the breakend is a SNV, which is tested without decoding the kind of the breakend.
+        constexpr bool is_snv() const noexcept {
+            return !_breakend_reference.first.is_indel();
+        }
+
         constexpr breakpoint_end get_breakpoint_end() const noexcept {
             return _breakend_reference.first.visit(libjst::multi_invocable{
                 [pos = _breakend_reference.first.position()] (indel_breakend_kind code) {
@@ -444,9 +1523,12 @@ namespace libjst
                         case indel_breakend_kind::deletion_low: [[fallthrough]];
                         case indel_breakend_kind::deletion_high: {
                             indel_key_type key{_breakend_reference.first, _breakend_reference.second.front()};
-                            return _indel_map.find(key)->second.visit(libjst::multi_invocable{
+                            return _indel_map.at(key).visit(libjst::multi_invocable{
                                 [&] (deletion_type const & deletion) -> optional_mate {
-                                    return iterator_impl<true>{deletion.value(), std::addressof(_indel_map)};
+                                    return mate_iterator{std::ranges::next(_breakend_map.begin(), deletion.value()),
+                                                         std::addressof(_breakend_map),
+                                                         std::addressof(_indel_map),
+                                                         std::addressof(_alt_pool)};
                                 },
                                 [] (insertion_type const &) -> optional_mate { return std::nullopt; }
                             });
@@ -462,18 +1544,12 @@ namespace libjst
 
     private:
 
-        constexpr breakend_reference_t get_breakend_mate(indel_key_type key) const noexcept {
-            using optional_it_t = std::optional<breakend_iterator>;
+        constexpr breakend_key_type get_breakend_mate(indel_key_type key) const noexcept {
             assert(_indel_map.contains(key));
-            optional_it_t mate = _indel_map.find(key)->second.visit(libjst::multi_invocable{
-                [] (deletion_type const & deletion) -> optional_it_t { return deletion.value(); },
-                [&] (insertion_type const &) -> optional_it_t { return std::nullopt; }
+            return _indel_map.at(key).visit(libjst::multi_invocable{
+                [&] (deletion_type const & deletion) { return (*std::ranges::next(_breakend_map.begin(), deletion.value())).first; },
+                [&] (insertion_type const &) { return _breakend_reference.first; }
             });
-            if (mate.has_value()) {
-                return *(mate.value());
-            } else {
-                return _breakend_reference;
-            }
         }
 
         constexpr breakpoint get_deletion_breakpoint(indel_breakend_kind const deletion_kind) const noexcept {
@@ -484,23 +1560,23 @@ namespace libjst
             using breakend_t = typename breakpoint::value_type;
 
             indel_key_type indel_key{_breakend_reference.first, _breakend_reference.second.front()};
-            breakend_reference_t breakend_mate = get_breakend_mate(std::move(indel_key));
+            breakend_key_type const breakend_mate = get_breakend_mate(std::move(indel_key));
 
             breakend_t low_breakend = (deletion_kind == indel_breakend_kind::deletion_low) ?
                                         _breakend_reference.first.position() :
-                                        breakend_mate.first.position();
+                                        breakend_mate.position();
 
 
-            size_t deletion_size = std::abs(static_cast<signed_position_t>(breakend_mate.first.position()) -
+            size_t deletion_size = std::abs(static_cast<signed_position_t>(breakend_mate.position()) -
                                             static_cast<signed_position_t>(_breakend_reference.first.position()));
             return breakpoint{low_breakend, deletion_size};
         }
 
         constexpr breakpoint extract_breakpoint() const noexcept {
             // what can we have:
-            using position_t = breakend_key_type::underlying_type;
+            using position_t = typename breakpoint::value_type; // sources are bounded by check_source_size
             breakend_key_type key = _breakend_reference.first;
-            position_t const position = key.position();
+            position_t const position = static_cast<position_t>(key.position());
             return key.visit(libjst::multi_invocable{
                 [&] (indel_breakend_kind indel_kind) {
                     if (indel_kind == indel_breakend_kind::deletion_low ||
@@ -521,8 +1597,8 @@ namespace libjst
                     indel_key_type indel_key{_breakend_reference.first, _breakend_reference.second.front()};
                     if (breakend_kind != indel_breakend_kind::nil) {
                         assert(_indel_map.contains(indel_key));
-                        return _indel_map.find(indel_key)->second.visit(libjst::multi_invocable{
-                            [] (insertion_type const & insertion) { return sequence_reference{insertion.value()}; },
+                        return _indel_map.at(indel_key).visit(libjst::multi_invocable{
+                            [&] (insertion_type const & insertion) { return _alt_pool[insertion.value()]; },
                             [] (deletion_type const &) { return sequence_reference{}; }
                         });
                     } else {
@@ -559,7 +1635,7 @@ namespace libjst
             return me.extract_alt_sequence();
         }
 
-        friend constexpr coverage_t const & tag_invoke(libjst::tag_t<libjst::coverage>, delta_proxy me) noexcept
+        friend constexpr coverage_reference tag_invoke(libjst::tag_t<libjst::coverage>, delta_proxy me) noexcept
         {
             return me._breakend_reference.second;
         }
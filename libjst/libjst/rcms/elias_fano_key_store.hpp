@@ -0,0 +1,157 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::elias_fano_key_store.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <vector>
+
+#include <libjst/rcms/packed_breakend_key.hpp>
+#include <libjst/utility/elias_fano_sequence.hpp>
+#include <libjst/utility/memory_usage.hpp>
+
+namespace libjst
+{
+    /*!\brief A compressed copy of the breakend keys of a multisequence that is no longer modified.
+     *
+     * \tparam breakend_position_t The unsigned integer type of the libjst::packed_breakend_key.
+     *
+     * \details
+     *
+     * The breakend keys of a multisequence are sorted by their position, which occupies all but the three most
+     * significant bits of every libjst::packed_breakend_key. The key store encodes the positions with a
+     * libjst::elias_fano_sequence over the source positions and keeps the three bit codes of the keys in a bit packed
+     * side array. For dense stores, e.g. a variant every 16 positions, a key occupies about ten instead of 32 bits.
+     *
+     * The keys are accessed and searched by their offset in the multisequence, i.e. the offset of a key equals the
+     * distance of its breakend from the begin of the multisequence it was built from. Thus, the frozen multisequence
+     * returned by libjst::freeze can keep the compressed keys alongside to find the successor of a position, as needed
+     * to seek the trees or to skip to the next variant, with `multisequence.begin() + keys.upper_bound(position)`.
+     * Like the frozen multisequence, the key store is a snapshot of the breakends it was built from.
+     */
+    template <std::unsigned_integral breakend_position_t = uint32_t>
+    class elias_fano_key_store {
+    public:
+
+        using key_type = packed_breakend_key<breakend_position_t>; //!< The type of the breakend keys.
+
+    private:
+
+        static constexpr std::size_t position_bits{std::bit_width(key_type::max_position)};
+        static constexpr std::size_t code_bits{sizeof(breakend_position_t) * 8 - position_bits};
+        static constexpr std::size_t codes_per_word{64 / code_bits};
+
+        elias_fano_sequence _positions{}; //!< The sorted positions of the keys.
+        std::vector<uint64_t> _codes{}; //!< The bit packed codes of the keys.
+
+    public:
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        elias_fano_key_store() = default; //!< Default.
+
+        /*!\brief Compresses the breakend keys of the given multisequence.
+         *
+         * \param[in] multisequence The multisequence, whose breakends provide their key with `get_key()`.
+         *
+         * \details
+         *
+         * The positions are encoded over the universe of the source positions including the end of the source, at
+         * which the sentinel breakend is stored.
+         *
+         * ### Exception
+         *
+         * Throws std::invalid_argument if the breakends are not sorted by their position or lie behind the source.
+         *
+         * ### Complexity
+         *
+         * Linear in the number of breakends.
+         */
+        template <std::ranges::forward_range multisequence_t>
+            requires std::ranges::sized_range<multisequence_t const> &&
+                     requires (multisequence_t const & multisequence,
+                               std::ranges::range_reference_t<multisequence_t const> breakend) {
+                         { std::ranges::size(multisequence.source()) } -> std::convertible_to<std::size_t>;
+                         { breakend.get_key() } -> std::convertible_to<key_type>;
+                     }
+        explicit elias_fano_key_store(multisequence_t const & multisequence) :
+            _positions{multisequence | std::views::transform([] (auto && breakend) -> uint64_t {
+                return key_type{breakend.get_key()}.position();
+            }), static_cast<uint64_t>(std::ranges::size(multisequence.source())) + 1},
+            _codes((std::ranges::size(multisequence) + codes_per_word - 1) / codes_per_word)
+        {
+            std::size_t index{};
+            for (auto && breakend : multisequence) {
+                uint64_t const code = key_type{breakend.get_key()}.packed() >> position_bits;
+                _codes[index / codes_per_word] |= code << ((index % codes_per_word) * code_bits);
+                ++index;
+            }
+        }
+        //!\}
+
+        /*!\name Element access
+         * \{
+         */
+        //!\brief Returns the key at the given offset; requires `offset < size()`.
+        key_type operator[](std::size_t const offset) const noexcept {
+            assert(offset < size());
+            uint64_t const code = (_codes[offset / codes_per_word] >> ((offset % codes_per_word) * code_bits)) &
+                                  ((uint64_t{1} << code_bits) - 1);
+            return key_type::from_packed(static_cast<breakend_position_t>((code << position_bits) | position(offset)));
+        }
+
+        //!\brief Returns the position of the key at the given offset; requires `offset < size()`.
+        breakend_position_t position(std::size_t const offset) const noexcept {
+            return static_cast<breakend_position_t>(_positions[offset]);
+        }
+        //!\}
+
+        /*!\name Search
+         * \{
+         */
+        //!\brief Returns the offset of the first key whose position is not less than the given position.
+        std::size_t lower_bound(std::size_t const position) const noexcept {
+            return _positions.lower_bound(position);
+        }
+
+        //!\brief Returns the offset of the first key whose position is greater than the given position.
+        std::size_t upper_bound(std::size_t const position) const noexcept {
+            return _positions.upper_bound(position);
+        }
+        //!\}
+
+        /*!\name Capacity
+         * \{
+         */
+        //!\brief Returns the number of keys.
+        constexpr std::size_t size() const noexcept {
+            return _positions.size();
+        }
+
+        //!\brief Returns whether the store has no keys.
+        constexpr bool empty() const noexcept {
+            return _positions.empty();
+        }
+
+        //!\brief Returns the number of bytes allocated for the positions and the codes.
+        std::size_t memory_usage() const noexcept {
+            return _positions.memory_usage() + libjst::memory_usage(_codes);
+        }
+        //!\}
+    };
+}  // namespace libjst
@@ -0,0 +1,171 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::federated_store to traverse the stores of several cohorts over one source at once.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <libjst/coverage/concept.hpp>
+#include <libjst/coverage/coverage_members.hpp>
+#include <libjst/rcms/interior_breakends.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/variant/concept.hpp>
+
+namespace libjst
+{
+    /*!\brief The stores of several cohorts over the same source, federated into a single store.
+     *
+     * \tparam source_t The type of the shared source sequence.
+     * \tparam cms_t The type of the compressed multisequence storing the variants of every cohort.
+     *
+     * \details
+     *
+     * The rows of the cohorts are concatenated in the given order, i.e. the rows of cohort `k` are the rows
+     * `[cohort_rows(k).min(), cohort_rows(k).max())` of the federated store. The variants of every cohort are merged
+     * into the federated store with libjst::rcs_store::extend, such that a variant found in several cohorts is stored
+     * once with the union of its coverages. A tree over the federated store, e.g.
+     * `libjst::volatile_tree{federation.store()} | libjst::coloured() | libjst::prune()`, hence visits every stretch
+     * of the source and every shared variant once for all cohorts instead of once per cohort. The coverage of a node
+     * label refers to the federated rows and is split into the coverages of the cohorts with cohort_coverage.
+     *
+     * The federation copies the variants of the cohorts, which can be destroyed afterwards. It is built with one merge
+     * pass per cohort, i.e. in linear time in the number of cohorts and the size of the federated store.
+     */
+    template <std::ranges::random_access_range source_t, typename cms_t>
+    class federated_store
+    {
+    private:
+
+        using store_type = rcs_store<source_t, cms_t>;
+        using value_type = typename store_type::value_type;
+        using coverage_type = std::remove_cvref_t<decltype(libjst::coverage(std::declval<value_type &>()))>;
+        using coverage_domain_type = libjst::coverage_domain_t<coverage_type>;
+
+        store_type _store{};
+        std::vector<std::size_t> _row_offsets{0}; // the first row of every cohort and the total row count.
+
+    public:
+
+        using size_type = typename store_type::size_type;
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        federated_store() = default; //!< Default.
+
+        /*!\brief Federates the given cohorts over the shared source.
+         *
+         * \param[in] source The source sequence shared by all cohorts.
+         * \param[in] cohorts The stores of the cohorts.
+         *
+         * \throws std::invalid_argument if the source of a cohort differs from the given source.
+         */
+        template <std::ranges::input_range cohorts_t>
+            requires std::same_as<std::remove_cvref_t<std::ranges::range_reference_t<cohorts_t>>, store_type>
+        federated_store(source_t source, cohorts_t && cohorts)
+        {
+            std::vector<store_type const *> members{};
+            for (store_type const & cohort : cohorts) {
+                if (!std::ranges::equal(cohort.source(), source))
+                    throw std::invalid_argument{"The source of a cohort differs from the shared source!"};
+
+                members.push_back(&cohort);
+                _row_offsets.push_back(_row_offsets.back() + cohort.size());
+            }
+
+            size_type const row_count = static_cast<size_type>(_row_offsets.back());
+            _store = store_type{std::move(source), row_count};
+            for (std::size_t cohort_id = 0; cohort_id < members.size(); ++cohort_id)
+                _store.extend(row_count, shifted_variants(*members[cohort_id], _row_offsets[cohort_id], row_count));
+        }
+        //!\}
+
+        //!\brief Returns the federated store over the rows of all cohorts.
+        constexpr store_type const & store() const noexcept {
+            return _store;
+        }
+
+        constexpr std::size_t cohort_count() const noexcept {
+            return _row_offsets.size() - 1;
+        }
+
+        //!\brief Returns the rows of the federated store belonging to the given cohort.
+        constexpr coverage_domain_type cohort_rows(std::size_t const cohort_id) const noexcept {
+            assert(cohort_id < cohort_count());
+            return coverage_domain_type{static_cast<size_type>(_row_offsets[cohort_id]),
+                                        static_cast<size_type>(_row_offsets[cohort_id + 1])};
+        }
+
+        //!\brief Returns the cohort of the given row of the federated store.
+        constexpr std::size_t cohort_of(std::size_t const row) const noexcept {
+            assert(row < _row_offsets.back());
+            return std::ranges::distance(_row_offsets.begin(), std::ranges::upper_bound(_row_offsets, row)) - 1;
+        }
+
+        /*!\brief Returns the part of a federated coverage belonging to the given cohort.
+         *
+         * \param[in] coverage A coverage over the rows of the federated store, e.g. the coverage of a node label.
+         * \param[in] cohort_id The cohort to select.
+         *
+         * \returns A coverage over the rows `[0, n)` of the cohort's own store with `n` rows.
+         */
+        template <typename federated_coverage_t>
+        coverage_type cohort_coverage(federated_coverage_t const & coverage, std::size_t const cohort_id) const {
+            coverage_domain_type const rows = cohort_rows(cohort_id);
+            std::vector<size_type> members{};
+            libjst::for_each_covered(coverage, rows.min(), rows.size(), [&] (std::size_t const offset) {
+                members.push_back(static_cast<size_type>(offset));
+            });
+            return coverage_type{members, coverage_domain_type{0, static_cast<size_type>(rows.size())}};
+        }
+
+        //!\brief Returns whether a federated coverage contains any row of the given cohort.
+        template <typename federated_coverage_t>
+        bool covers_cohort(federated_coverage_t const & coverage, std::size_t const cohort_id) const {
+            coverage_domain_type const rows = cohort_rows(cohort_id);
+            bool is_covered{false};
+            libjst::for_each_covered(coverage, rows.min(), rows.size(), [&] (std::size_t) { is_covered = true; });
+            return is_covered;
+        }
+
+    private:
+
+        // The variants of the cohort with their coverages moved to the rows of the cohort in the federated store.
+        static std::vector<value_type> shifted_variants(store_type const & cohort,
+                                                        std::size_t const row_offset,
+                                                        size_type const row_count) {
+            coverage_domain_type const federated_domain{0, row_count};
+            std::vector<value_type> variants{};
+            std::vector<size_type> members{};
+            for (auto && breakend : libjst::interior_breakends(cohort.variants())) {
+                if (breakend.get_breakpoint_end() == breakpoint_end::high)
+                    continue;
+
+                value_type variant = breakend;
+                members.clear();
+                libjst::for_each_covered(libjst::coverage(variant), 0, cohort.size(), [&] (std::size_t const row) {
+                    members.push_back(static_cast<size_type>(row_offset + row));
+                });
+                libjst::coverage(variant) = coverage_type{members, federated_domain};
+                variants.push_back(std::move(variant));
+            }
+            return variants;
+        }
+    };
+}  // namespace libjst
@@ -0,0 +1,354 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::haplotype_fasta_writer streaming many haplotypes of a rcs store as FASTA.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <ostream>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <libjst/coverage/coverage_members.hpp>
+#include <libjst/rcms/haplotype_viewer.hpp>
+#include <libjst/rcms/region_viewer.hpp>
+#include <libjst/utility/bgzf_codec.hpp>
+
+namespace libjst
+{
+    /*!\brief Writes the haplotypes of a rcs store as line wrapped FASTA records to a stream.
+     *
+     * \tparam rcs_store_t The type of the rcs store.
+     *
+     * \details
+     *
+     * The requested haplotypes are processed in batches of libjst::haplotype_fasta_writer::options::batch_size
+     * haplotypes in the given order. The haplotypes of a batch are spelled with the batched materialisation of the
+     * libjst::haplotype_viewer, which sweeps the variants once for a block of neighbouring ids, and their records are
+     * formatted by `thread_count` threads. Only the records of one batch are held in memory, such that all haplotypes
+     * of a large store can be streamed to disk.
+     *
+     * With libjst::haplotype_fasta_writer::options::bgzip, the records are compressed into the BGZF blocks of the
+     * libjst::bgzf_codec, which are compressed concurrently and written in order; the file is readable by every gzip
+     * reader and can be indexed with `samtools faidx`. The last partial block of a batch is carried over to the next
+     * one, such that all but the last block are full. Requires libjst to be built with `LIBJST_WITH_ZLIB`.
+     *
+     * The writer must be closed to write the last block and the end-of-file marker of a compressed file; the destructor
+     * closes the writer, but ignores its errors.
+     */
+    template <typename rcs_store_t>
+    class haplotype_fasta_writer
+    {
+    public:
+
+        //!\brief Returns the name of the record of a haplotype id.
+        using name_function_type = std::function<std::string(std::size_t)>;
+
+        //!\brief The options of the writer.
+        struct options {
+            std::size_t line_width{60}; //!< The number of symbols per line; 0 writes every sequence on a single line.
+            std::size_t thread_count{1}; //!< The number of threads materialising, formatting and compressing.
+            std::size_t batch_size{64}; //!< The number of haplotypes held in memory at once; at least 1.
+            bool bgzip{false}; //!< Whether to compress the output in BGZF blocks.
+            int compression_level{-1}; //!< The zlib compression level of the BGZF blocks.
+        };
+
+    private:
+
+        using viewer_type = haplotype_viewer<rcs_store_t>;
+        using haplotype_type = typename viewer_type::haplotype_type;
+
+        viewer_type _viewer;
+        std::ostream * _stream{};
+        options _options{};
+        name_function_type _name{};
+        std::vector<char> _pending{}; // the uncompressed tail of the last BGZF block
+        bool _closed{false};
+
+    public:
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        haplotype_fasta_writer() = delete; //!< Deleted.
+        haplotype_fasta_writer(haplotype_fasta_writer const &) = delete; //!< Deleted.
+        haplotype_fasta_writer & operator=(haplotype_fasta_writer const &) = delete; //!< Deleted.
+
+        /*!\brief Creates a writer for the given store and stream.
+         *
+         * \param[in] store The rcs store of the haplotypes; must outlive the writer.
+         * \param[in] stream The stream the records are written to; must outlive the writer.
+         * \param[in] writer_options The options of the writer.
+         * \param[in] name Returns the name of the record of a haplotype id; defaults to `haplotype_<id>`;
+         *                 invoked concurrently by the formatting threads.
+         *
+         * \details
+         *
+         * Throws std::logic_error if compression is requested but libjst was built without zlib.
+         */
+        haplotype_fasta_writer(rcs_store_t const & store,
+                               std::ostream & stream,
+                               options writer_options = {},
+                               name_function_type name = default_name) :
+            _viewer{store},
+            _stream{std::addressof(stream)},
+            _options{std::move(writer_options)},
+            _name{std::move(name)}
+        {
+            _options.batch_size = std::max<std::size_t>(_options.batch_size, 1);
+            _options.thread_count = std::max<std::size_t>(_options.thread_count, 1);
+            if (_options.bgzip && !bgzf_enabled)
+                throw std::logic_error{"libjst was built without zlib; enable LIBJST_WITH_ZLIB to write bgzip files."};
+        }
+
+        //!\brief Closes the writer, ignoring its errors.
+        ~haplotype_fasta_writer() {
+            try {
+                close();
+            } catch (...) {
+            }
+        }
+        //!\}
+
+        //!\brief Returns the options of the writer.
+        constexpr options const & get_options() const noexcept {
+            return _options;
+        }
+
+        /*!\brief Writes the whole haplotypes of the given ids in the given order.
+         *
+         * \details
+         *
+         * Throws std::out_of_range if an id exceeds the haplotypes of the store, in which case the records of the
+         * preceding batches were already written.
+         */
+        void write(std::span<std::size_t const> ids) {
+            check_open();
+            for (std::size_t batch_begin = 0; batch_begin < ids.size(); batch_begin += _options.batch_size) {
+                std::span<std::size_t const> batch = ids.subspan(batch_begin,
+                                                                 std::min(_options.batch_size, ids.size() - batch_begin));
+                std::vector<haplotype_type> haplotypes = materialise(batch);
+                std::vector<std::string> records(batch.size());
+                parallel_for(batch.size(), [&] (std::size_t const idx) {
+                    records[idx] = format(_name(batch[idx]), haplotypes[idx]);
+                    haplotype_type{}.swap(haplotypes[idx]);
+                });
+                emit(records);
+            }
+        }
+
+        /*!\brief Writes the sequences of the given haplotypes within the source region `[first, last)`.
+         *
+         * \details
+         *
+         * The sequences are spelled by the libjst::region_viewer, and the record names are suffixed with
+         * `:<first>-<last>`, where `last` is clamped to the size of the source. Throws std::out_of_range if an id
+         * exceeds the haplotypes of the store or if the region is invalid.
+         */
+        void write_region(std::span<std::size_t const> ids, std::size_t const first, std::size_t last) {
+            check_open();
+            std::size_t const haplotype_count = _viewer.size();
+            for (std::size_t id : ids)
+                check_id(id);
+
+            last = std::min<std::size_t>(last, std::ranges::size(_viewer.base().source()));
+            using region_viewer_type = region_viewer<rcs_store_t>;
+            using sequence_type = typename region_viewer_type::sequence_type;
+            auto const groups = region_viewer_type{_viewer.base()}(first, last);
+            std::vector<sequence_type const *> sequences(haplotype_count);
+            for (auto const & group : groups)
+                libjst::for_each_covered(group.coverage, 0, haplotype_count, [&] (std::size_t const idx) {
+                    sequences[idx] = std::addressof(group.sequence);
+                });
+
+            std::string const suffix = ":" + std::to_string(first) + "-" + std::to_string(last);
+            for (std::size_t batch_begin = 0; batch_begin < ids.size(); batch_begin += _options.batch_size) {
+                std::span<std::size_t const> batch = ids.subspan(batch_begin,
+                                                                 std::min(_options.batch_size, ids.size() - batch_begin));
+                std::vector<std::string> records(batch.size());
+                parallel_for(batch.size(), [&] (std::size_t const idx) {
+                    records[idx] = format(_name(batch[idx]) + suffix, *sequences[batch[idx]]);
+                });
+                emit(records);
+            }
+        }
+
+        /*!\brief Writes the last block and the end-of-file marker of a compressed file and flushes the stream.
+         *
+         * \details
+         *
+         * Throws std::runtime_error if the stream failed. Calling close again has no effect; writing after close
+         * throws std::logic_error.
+         */
+        void close() {
+            if (std::exchange(_closed, true))
+                return;
+
+            if (_options.bgzip) {
+                std::vector<char> block{};
+                if (!_pending.empty())
+                    bgzf_codec::compress(_pending, block, _options.compression_level);
+                bgzf_codec::finish(block);
+                _pending.clear();
+                write_bytes(block);
+            }
+            _stream->flush();
+            check_stream();
+        }
+
+    private:
+
+        static std::string default_name(std::size_t const id) {
+            return "haplotype_" + std::to_string(id);
+        }
+
+        void check_open() const {
+            if (_closed)
+                throw std::logic_error{"Cannot write to a closed haplotype FASTA writer."};
+        }
+
+        void check_id(std::size_t const id) const {
+            if (id >= _viewer.size())
+                throw std::out_of_range{"The haplotype " + std::to_string(id) + " exceeds the " +
+                                        std::to_string(_viewer.size()) + " haplotypes of the store."};
+        }
+
+        void check_stream() const {
+            if (!*_stream)
+                throw std::runtime_error{"Could not write the haplotypes to the stream."};
+        }
+
+        // Materialises neighbouring ids in a single sweep and scattered ids one by one.
+        std::vector<haplotype_type> materialise(std::span<std::size_t const> batch) const {
+            std::ranges::for_each(batch, [this] (std::size_t const id) { check_id(id); });
+            std::vector<haplotype_type> haplotypes(batch.size());
+            if (batch.empty())
+                return haplotypes;
+
+            auto [min_id, max_id] = std::ranges::minmax(batch);
+            std::size_t const span = max_id - min_id + 1;
+            if (span <= 2 * batch.size()) {
+                std::vector<haplotype_type> block = _viewer.materialise(min_id, span, _options.thread_count);
+                for (std::size_t idx = 0; idx < batch.size(); ++idx) {
+                    if (idx + 1 < batch.size() && std::ranges::find(batch.subspan(idx + 1), batch[idx]) != batch.end())
+                        haplotypes[idx] = block[batch[idx] - min_id]; // the id is requested again
+                    else
+                        haplotypes[idx] = std::move(block[batch[idx] - min_id]);
+                }
+            } else {
+                parallel_for(batch.size(), [&] (std::size_t const idx) {
+                    haplotypes[idx] = std::move(_viewer.materialise(batch[idx], 1).front());
+                });
+            }
+            return haplotypes;
+        }
+
+        template <typename sequence_t>
+        std::string format(std::string const & name, sequence_t const & sequence) const {
+            std::size_t const size = std::ranges::size(sequence);
+            std::size_t const line_width = (_options.line_width == 0) ? std::max<std::size_t>(size, 1)
+                                                                      : _options.line_width;
+            std::string record{};
+            record.reserve(name.size() + 2 + size + size / line_width + 1);
+            record.push_back('>');
+            record.append(name);
+            record.push_back('\n');
+            std::size_t column{};
+            for (auto const & symbol : sequence) {
+                record.push_back(to_char(symbol));
+                if (++column == line_width) {
+                    record.push_back('\n');
+                    column = 0;
+                }
+            }
+            if (column != 0)
+                record.push_back('\n');
+            return record;
+        }
+
+        template <typename symbol_t>
+        static char to_char(symbol_t const & symbol) noexcept {
+            if constexpr (requires { { symbol.to_char() } -> std::convertible_to<char>; })
+                return symbol.to_char();
+            else
+                return static_cast<char>(symbol);
+        }
+
+        void emit(std::vector<std::string> const & records) {
+            if (!_options.bgzip) {
+                for (std::string const & record : records)
+                    _stream->write(record.data(), static_cast<std::streamsize>(record.size()));
+                check_stream();
+                return;
+            }
+
+            for (std::string const & record : records)
+                _pending.insert(_pending.end(), record.begin(), record.end());
+
+            // Compresses all full blocks concurrently and keeps the tail for the next batch.
+            std::size_t const block_count = _pending.size() / bgzf_codec::max_block_size;
+            std::vector<std::vector<char>> blocks(block_count);
+            parallel_for(block_count, [&] (std::size_t const block) {
+                std::span<char const> input{_pending.data() + block * bgzf_codec::max_block_size,
+                                            bgzf_codec::max_block_size};
+                bgzf_codec::compress(input, blocks[block], _options.compression_level);
+            });
+            for (std::vector<char> const & block : blocks)
+                write_bytes(block);
+            _pending.erase(_pending.begin(), _pending.begin() + block_count * bgzf_codec::max_block_size);
+        }
+
+        void write_bytes(std::vector<char> const & bytes) {
+            _stream->write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+            check_stream();
+        }
+
+        // Splits the indices into one contiguous block per thread; the calling thread processes the first block.
+        template <typename fn_t>
+        void parallel_for(std::size_t const count, fn_t && fn) const {
+            std::size_t const block_count = std::clamp<std::size_t>(_options.thread_count, 1,
+                                                                    std::max<std::size_t>(count, 1));
+            std::vector<std::exception_ptr> errors(block_count);
+            auto work = [&] (std::size_t const block) {
+                try {
+                    std::size_t const block_end = (block + 1) * count / block_count;
+                    for (std::size_t idx = block * count / block_count; idx < block_end; ++idx)
+                        fn(idx);
+                } catch (...) {
+                    errors[block] = std::current_exception();
+                }
+            };
+
+            std::vector<std::thread> workers{};
+            for (std::size_t block = 1; block < block_count; ++block)
+                workers.emplace_back(work, block);
+            work(0);
+            std::ranges::for_each(workers, [] (std::thread & worker) { worker.join(); });
+
+            for (std::exception_ptr const & error : errors)
+                if (error)
+                    std::rethrow_exception(error);
+        }
+    };
+
+    template <typename rcs_store_t>
+    haplotype_fasta_writer(rcs_store_t const &, std::ostream &) -> haplotype_fasta_writer<rcs_store_t>;
+
+}  // namespace libjst
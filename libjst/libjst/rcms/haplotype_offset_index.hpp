@@ -0,0 +1,212 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides an index translating source positions into the coordinates of the haplotypes of a rcs store.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <optional>
+#include <ranges>
+#include <stdexcept>
+#include <vector>
+
+#include <libjst/coverage/coverage_members.hpp>
+#include <libjst/rcms/interior_breakends.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/variant/concept.hpp>
+
+namespace libjst
+{
+    /*!\brief Translates positions of the source into the coordinates of the haplotypes without replaying the journal.
+     *
+     * \tparam rcs_store_t The type of the store.
+     *
+     * \details
+     *
+     * For every haplotype the index stores the breakpoints of the variants applied to it, in the order of the store
+     * and skipping the variants overlapping a preceding one like libjst::haplotype_viewer, together with the
+     * difference of their alternate sequence and their deleted length. The cumulative shift of the haplotype before
+     * every `sample_interval`-th variant is sampled, such that a position is translated with a binary search over
+     * the breakpoints of the haplotype and at most `sample_interval - 1` additions.
+     *
+     * The bulk translation invokes a callback for every haplotype of a coverage, i.e. for all carriers of a hit.
+     */
+    template <typename rcs_store_t>
+    class haplotype_offset_index {
+    private:
+
+        struct haplotype_offsets {
+            std::vector<uint32_t> lows{}; //!< The low breakends of the applied variants.
+            std::vector<uint32_t> highs{}; //!< The high breakends of the applied variants.
+            std::vector<int32_t> shifts{}; //!< The alternate size minus the deleted size of the applied variants.
+            std::vector<int64_t> samples{}; //!< The cumulative shift before every sample_interval-th variant.
+        };
+
+        std::size_t _sample_interval{64};
+        std::vector<haplotype_offsets> _haplotypes{};
+
+    public:
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        haplotype_offset_index() = default; //!< Default.
+
+        /*!\brief Builds the index over the haplotypes of the store.
+         *
+         * \param[in] store The store to build the index for.
+         * \param[in] sample_interval The number of applied variants between two sampled shifts.
+         *
+         * \details
+         *
+         * Throws std::invalid_argument if the sample interval is zero.
+         */
+        explicit haplotype_offset_index(rcs_store_t const & store, std::size_t const sample_interval = 64) :
+            _sample_interval{sample_interval},
+            _haplotypes(store.size())
+        {
+            if (_sample_interval == 0)
+                throw std::invalid_argument{"The sample interval must be greater than zero."};
+
+            std::vector<std::size_t> source_positions(_haplotypes.size());
+            for (auto && variant : libjst::interior_breakends(store.variants())) {
+                if (variant.get_breakpoint_end() != breakpoint_end::low)
+                    continue;
+
+                auto const breakpoint = libjst::get_breakpoint(variant);
+                std::size_t const low = libjst::low_breakend(breakpoint);
+                std::size_t const high = libjst::high_breakend(breakpoint);
+                int32_t const shift = static_cast<int32_t>(std::ranges::size(libjst::alt_sequence(variant))) -
+                                      static_cast<int32_t>(high - low);
+
+                libjst::for_each_covered(libjst::coverage(variant), 0, _haplotypes.size(), [&] (std::size_t const idx) {
+                    if (low < source_positions[idx])
+                        return;
+
+                    haplotype_offsets & offsets = _haplotypes[idx];
+                    offsets.lows.push_back(static_cast<uint32_t>(low));
+                    offsets.highs.push_back(static_cast<uint32_t>(high));
+                    offsets.shifts.push_back(shift);
+                    source_positions[idx] = high;
+                });
+            }
+
+            for (haplotype_offsets & offsets : _haplotypes) {
+                offsets.samples.reserve(offsets.shifts.size() / _sample_interval + 1);
+                int64_t cumulative_shift{};
+                for (std::size_t variant = 0; variant < offsets.shifts.size(); ++variant) {
+                    if (variant % _sample_interval == 0)
+                        offsets.samples.push_back(cumulative_shift);
+                    cumulative_shift += offsets.shifts[variant];
+                }
+                if (offsets.shifts.size() % _sample_interval == 0)
+                    offsets.samples.push_back(cumulative_shift);
+            }
+        }
+        //!\}
+
+        //!\brief Returns the number of haplotypes.
+        constexpr std::size_t size() const noexcept {
+            return _haplotypes.size();
+        }
+
+        constexpr std::size_t sample_interval() const noexcept {
+            return _sample_interval;
+        }
+
+        //!\brief Returns the number of variants applied to the haplotype.
+        constexpr std::size_t variant_count(std::size_t const haplotype) const noexcept {
+            return _haplotypes[haplotype].lows.size();
+        }
+
+        /*!\brief Returns the position of the source symbol within the haplotype.
+         *
+         * \returns The position or std::nullopt if the symbol is deleted or replaced in the haplotype.
+         */
+        std::optional<std::size_t> to_haplotype(std::size_t const haplotype, std::size_t const source_position) const {
+            haplotype_offsets const & offsets = _haplotypes[haplotype];
+            // The variants ending before the symbol, which includes the insertions right in front of it.
+            std::size_t const preceding = std::ranges::distance(offsets.highs.begin(),
+                                                                std::ranges::upper_bound(offsets.highs,
+                                                                                         source_position));
+            if (preceding < offsets.lows.size() && offsets.lows[preceding] <= source_position)
+                return std::nullopt;
+
+            return static_cast<std::size_t>(static_cast<int64_t>(source_position) + shift_before(offsets, preceding));
+        }
+
+        /*!\brief Returns the position of a symbol of the alternate sequence of a variant within the haplotype.
+         *
+         * \param[in] haplotype The haplotype the variant is applied to.
+         * \param[in] breakpoint The breakpoint of the variant.
+         * \param[in] alt_offset The offset of the symbol within the alternate sequence.
+         */
+        template <typename breakpoint_t>
+        std::size_t to_haplotype(std::size_t const haplotype,
+                                 breakpoint_t const & breakpoint,
+                                 std::size_t const alt_offset) const {
+            haplotype_offsets const & offsets = _haplotypes[haplotype];
+            std::size_t const low = libjst::low_breakend(breakpoint);
+            std::size_t const high = libjst::high_breakend(breakpoint);
+            // The applied variants are ordered by their low and then their high breakend.
+            std::size_t preceding = std::ranges::distance(offsets.lows.begin(),
+                                                          std::ranges::lower_bound(offsets.lows, low));
+            while (preceding < offsets.lows.size() && offsets.lows[preceding] == low && offsets.highs[preceding] < high)
+                ++preceding;
+
+            return static_cast<std::size_t>(static_cast<int64_t>(low) + shift_before(offsets, preceding)) + alt_offset;
+        }
+
+        /*!\brief Invokes the callback with every covered haplotype and the position of the source symbol within it.
+         *
+         * \details
+         *
+         * The callback is invoked as `fn(haplotype, position)` in increasing order of the haplotypes, skipping the
+         * haplotypes in which the symbol is deleted or replaced.
+         */
+        template <typename coverage_t, typename fn_t>
+        void for_each_position(coverage_t const & coverage, std::size_t const source_position, fn_t && fn) const {
+            libjst::for_each_covered(coverage, 0, size(), [&] (std::size_t const haplotype) {
+                if (std::optional<std::size_t> position = to_haplotype(haplotype, source_position); position)
+                    fn(haplotype, *position);
+            });
+        }
+
+        //!\brief Invokes the callback with every covered haplotype and the position of the alternate symbol within it.
+        template <typename coverage_t, typename breakpoint_t, typename fn_t>
+        void for_each_position(coverage_t const & coverage,
+                               breakpoint_t const & breakpoint,
+                               std::size_t const alt_offset,
+                               fn_t && fn) const {
+            libjst::for_each_covered(coverage, 0, size(), [&] (std::size_t const haplotype) {
+                fn(haplotype, to_haplotype(haplotype, breakpoint, alt_offset));
+            });
+        }
+
+    private:
+
+        // Returns the cumulative shift of the first variants of the haplotype.
+        int64_t shift_before(haplotype_offsets const & offsets, std::size_t const variant_count) const noexcept {
+            std::size_t const sample = variant_count / _sample_interval;
+            auto const first = offsets.shifts.begin() + sample * _sample_interval;
+            return std::accumulate(first, offsets.shifts.begin() + variant_count, offsets.samples[sample]);
+        }
+    };
+
+    template <typename rcs_store_t>
+    haplotype_offset_index(rcs_store_t const &) -> haplotype_offset_index<rcs_store_t>;
+
+    template <typename rcs_store_t>
+    haplotype_offset_index(rcs_store_t const &, std::size_t) -> haplotype_offset_index<rcs_store_t>;
+}  // namespace libjst
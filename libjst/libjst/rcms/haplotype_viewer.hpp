@@ -12,12 +12,25 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <concepts>
+#include <cstdint>
+#include <exception>
 #include <ranges>
+#include <span>
+#include <stdexcept>
+#include <thread>
 #include <type_traits>
+#include <vector>
 
+#include <libjst/coverage/coverage_members.hpp>
+#include <libjst/rcms/interior_breakends.hpp>
 #include <libjst/sequence/journaled_sequence.hpp>
 #include <libjst/rcms/rcs_store.hpp>
+#include <libjst/utility/bit_matrix_transpose.hpp>
+#include <libjst/utility/bit_vector.hpp>
+#include <libjst/utility/thread_scratch.hpp>
 #include <libjst/variant/concept.hpp>
 
 namespace libjst
@@ -42,6 +55,7 @@ namespace libjst
     public:
 
         using reference = proxy;
+        using haplotype_type = std::vector<std::ranges::range_value_t<source_type>>; //!< The materialised haplotype.
 
         haplotype_viewer() = delete;
         explicit haplotype_viewer(rcs_store_t const & wrappee) : _wrappee{wrappee}
@@ -58,6 +72,163 @@ namespace libjst
         constexpr size_t size() const noexcept {
             return base().size();
         }
+
+        /*!\name Batched materialisation
+         * \brief Spells the sequences of a block of haplotypes in one sweep over the variants.
+         *
+         * \details
+         *
+         * Every haplotype in `[first, first + count)` is written out as a copy of the source, in which the variants
+         * covering the haplotype are applied. The variants are visited once for the whole block, and coverages storing
+         * their bits in words, e.g. libjst::bit_coverage, are tested for 64 haplotypes of the block with a single
+         * word load. Variants overlapping a preceding variant of the same haplotype are ignored.
+         *
+         * The parallel overload splits the block into sub-blocks of a multiple of 64 haplotypes, which are swept by
+         * `thread_count` threads. The first exception thrown by a worker is rethrown on the calling thread.
+         *
+         * Throws std::out_of_range if the block exceeds the haplotypes of the store.
+         * \{
+         */
+        std::vector<haplotype_type> materialise(size_t const first, size_t const count) const {
+            check_block(first, count);
+            std::vector<haplotype_type> haplotypes(count);
+            materialise_into(haplotypes, first);
+            return haplotypes;
+        }
+
+        std::vector<haplotype_type> materialise(size_t const first, size_t const count, size_t const thread_count) const {
+            check_block(first, count);
+            std::vector<haplotype_type> haplotypes(count);
+
+            size_t const block_size = std::max<size_t>((count + std::max<size_t>(thread_count, 1) - 1) /
+                                                       std::max<size_t>(thread_count, 1), 1);
+            size_t const aligned_block_size = (block_size + word_size - 1) / word_size * word_size;
+            size_t const block_count = (count + aligned_block_size - 1) / aligned_block_size;
+
+            std::atomic<size_t> next_block{0};
+            std::exception_ptr exception{};
+            std::atomic_flag failed{};
+
+            auto work = [&] () {
+                for (size_t block = next_block++; block < block_count && !failed.test(); block = next_block++) {
+                    try {
+                        size_t const block_begin = block * aligned_block_size;
+                        size_t const block_end = std::min(block_begin + aligned_block_size, count);
+                        materialise_into(std::span{haplotypes}.subspan(block_begin, block_end - block_begin),
+                                         first + block_begin);
+                    } catch (...) {
+                        if (!failed.test_and_set())
+                            exception = std::current_exception();
+                    }
+                }
+            };
+
+            std::vector<std::thread> workers{};
+            for (size_t worker = 1; worker < std::min(thread_count, block_count); ++worker)
+                workers.emplace_back(work);
+            work();
+            std::ranges::for_each(workers, [] (std::thread & worker) { worker.join(); });
+
+            if (exception)
+                std::rethrow_exception(exception);
+            return haplotypes;
+        }
+
+        std::vector<haplotype_type> materialise_all(size_t const thread_count = 1) const {
+            return materialise(0, size(), thread_count);
+        }
+        //!\}
+
+        /*!\brief Returns the variants carried by every haplotype of the block, i.e. the sample-major genotypes.
+         *
+         * \details
+         *
+         * The bit vector of the haplotype `first + i` is stored at the index `i` and has the bit `v` set if the haplotype
+         * carries the `v`-th variant, counting the low breakends between the sentinels in the stored order. The
+         * coverages are variant-major, hence the bits of 64 variants and 64 haplotypes are read as one block with
+         * libjst::covered_bits and transposed with libjst::transpose_bit_blocks instead of testing every bit.
+         *
+         * Throws std::out_of_range if the block exceeds the haplotypes of the store.
+         */
+        std::vector<bit_vector<>> carried_variants(size_t const first, size_t const count) const {
+            check_block(first, count);
+            auto const variants = libjst::interior_breakends(base().variants());
+            auto is_low = [] (auto && variant) { return variant.get_breakpoint_end() == breakpoint_end::low; };
+            size_t const variant_count = std::ranges::count_if(variants, is_low);
+
+            std::vector<bit_vector<>> haplotypes(count, bit_vector<>(variant_count, false));
+            size_t const haplotype_words = (count + word_size - 1) / word_size;
+            std::vector<uint64_t> blocks(haplotype_words * word_size);
+            size_t variant_idx{};
+            auto flush = [&] () { // transposes the blocks of the current 64 variants into the haplotypes.
+                libjst::transpose_bit_blocks(blocks);
+                for (size_t haplotype = 0; haplotype < count; ++haplotype)
+                    haplotypes[haplotype].data()[(variant_idx - 1) / word_size] = blocks[haplotype];
+                std::ranges::fill(blocks, 0);
+            };
+
+            for (auto && variant : variants) {
+                if (!is_low(variant))
+                    continue;
+
+                auto && coverage = libjst::coverage(variant);
+                for (size_t word = 0; word < haplotype_words; ++word)
+                    blocks[word * word_size + variant_idx % word_size] =
+                        libjst::covered_bits(coverage, first + word * word_size,
+                                             std::min(word_size, count - word * word_size));
+                if (++variant_idx % word_size == 0)
+                    flush();
+            }
+            if (variant_idx % word_size != 0)
+                flush();
+            return haplotypes;
+        }
+
+    private:
+
+        static constexpr size_t word_size = 64;
+
+        void check_block(size_t const first, size_t const count) const {
+            if (first > size() || count > size() - first)
+                throw std::out_of_range{"The haplotypes [" + std::to_string(first) + ", " +
+                                        std::to_string(first + count) + ") exceed the " + std::to_string(size()) +
+                                        " haplotypes of the store."};
+        }
+
+        void materialise_into(std::span<haplotype_type> haplotypes, size_t const first) const {
+            auto const source = base().source();
+            auto const source_begin = std::ranges::begin(source);
+            auto source_positions_scratch = libjst::acquire_scratch<std::vector<size_t>>();
+            std::vector<size_t> & source_positions = *source_positions_scratch;
+            source_positions.assign(haplotypes.size(), 0);
+            std::ranges::for_each(haplotypes, [&] (haplotype_type & haplotype) {
+                haplotype.clear();
+                haplotype.reserve(std::ranges::size(source));
+            });
+
+            for (auto && variant : libjst::interior_breakends(base().variants())) {
+                if (variant.get_breakpoint_end() != breakpoint_end::low)
+                    continue;
+
+                auto const breakpoint = libjst::get_breakpoint(variant);
+                size_t const low = libjst::low_breakend(breakpoint);
+                size_t const high = libjst::high_breakend(breakpoint);
+                auto && alt_sequence = libjst::alt_sequence(variant);
+
+                libjst::for_each_covered(libjst::coverage(variant), first, haplotypes.size(), [&] (size_t const idx) {
+                    if (low < source_positions[idx])
+                        return;
+
+                    haplotype_type & haplotype = haplotypes[idx];
+                    haplotype.insert(haplotype.end(), source_begin + source_positions[idx], source_begin + low);
+                    haplotype.insert(haplotype.end(), std::ranges::begin(alt_sequence), std::ranges::end(alt_sequence));
+                    source_positions[idx] = high;
+                });
+            }
+
+            for (size_t idx = 0; idx < haplotypes.size(); ++idx)
+                haplotypes[idx].insert(haplotypes[idx].end(), source_begin + source_positions[idx], std::ranges::end(source));
+        }
     };
 
     template <typename rcs_store_t>
@@ -75,17 +246,27 @@ namespace libjst
             _journaled_source{host.base().source()}
         {
             if (offset >= 0 && offset < host.base().size()) {
+                auto && variants = host.base().variants();
+                auto const first = std::ranges::begin(variants);
+                auto const interior = libjst::interior_breakends(variants);
                 std::ptrdiff_t journal_offset{};
-                auto it = host.base().variants().begin() + 1;
-                auto last = host.base().variants().end() - 1;
-                for (; it != last; ++it) {
-                // std::ranges::for_each(host.base().variants(), [&] (auto && variant) {
+                for (auto it = interior.begin(); it != interior.end(); ++it) {
                     auto && variant = *it;
-                    if (libjst::coverage(variant).contains(offset)) {
-                        record(variant, journal_offset + libjst::position(variant));
-                        journal_offset += libjst::effective_size(variant);
+                    if (!libjst::covers(libjst::coverage(variant), offset))
+                        continue;
+
+                    // Only the low breakend of a deletion is recorded and the SNVs skip the dispatch on the kind.
+                    switch (variant_class(variants, variant, it - first)) {
+                        case variant_class_kind::snv: {
+                            record_snv(libjst::alt_sequence(variant), journal_offset + libjst::position(variant));
+                            break;
+                        } case variant_class_kind::indel_low: {
+                            record(variant, journal_offset + libjst::position(variant));
+                            journal_offset += libjst::effective_size(variant);
+                            break;
+                        } default: break;
                     }
-                };
+                }
             }
         }
     public:
@@ -101,17 +282,56 @@ namespace libjst
 
     private:
 
+        enum struct variant_class_kind { snv, indel_low, other };
+
+        // Uses the variant class index of the multisequence if it was built, e.g. with build_variant_class_index.
+        template <typename variants_t>
+        static constexpr variant_class_kind variant_class(variants_t const & variants,
+                                                          variant_type const & variant,
+                                                          std::size_t const index) noexcept {
+            if constexpr (requires { variants.variant_classes().is_snv(index); }) {
+                if (variants.has_variant_class_index()) {
+                    auto const & classes = variants.variant_classes();
+                    return classes.is_snv(index) ? variant_class_kind::snv :
+                           classes.is_indel_low(index) ? variant_class_kind::indel_low : variant_class_kind::other;
+                }
+            }
+
+            if constexpr (requires { { variant.is_snv() } -> std::convertible_to<bool>; }) {
+                if (variant.is_snv())
+                    return variant_class_kind::snv;
+            }
+            return (variant.get_breakpoint_end() == breakpoint_end::low) ? variant_class_kind::indel_low :
+                                                                          variant_class_kind::other;
+        }
+
+        template <typename segment_t>
+        constexpr void record_at(std::size_t const position, std::size_t const deletion_size, segment_t && segment) {
+            if (_journaled_source.accepts_append(position)) {
+                _journaled_source.append_replace(position, position + deletion_size, (segment_t &&) segment);
+            } else {
+                auto hint = _journaled_source.begin() + position;
+                _journaled_source.replace(hint, hint + deletion_size, (segment_t &&) segment);
+            }
+        }
+
+        template <typename alt_sequence_t>
+        constexpr void record_snv(alt_sequence_t && alt_sequence, std::size_t const position) {
+            record_at(position, 1, (alt_sequence_t &&) alt_sequence);
+        }
+
+        // The variants are visited in increasing position order, hence every edit is appended to the journal.
         constexpr void record(variant_type const & variant, std::size_t position) {
-            auto hint = _journaled_source.begin() + position;
             switch (libjst::alt_kind(variant)) {
                 case alternate_sequence_kind::replacement: {
-                    _journaled_source.replace(hint, hint + 1, libjst::alt_sequence(variant));
+                    record_at(position, 1, libjst::alt_sequence(variant));
                     break;
                 } case alternate_sequence_kind::deletion: {
-                    _journaled_source.erase(hint, hint + libjst::breakpoint_span(libjst::get_breakpoint(variant)));
+                    record_at(position, libjst::breakpoint_span(libjst::get_breakpoint(variant)),
+                              typename journaled_sequence_type::sequence_type{});
                     break;
                 } case alternate_sequence_kind::insertion: {
-                    _journaled_source.insert(hint, libjst::alt_sequence(variant));
+                    record_at(position, 0, libjst::alt_sequence(variant));
                     break;
                 } case alternate_sequence_kind::unknown: {
                     break;
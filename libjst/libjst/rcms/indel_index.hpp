@@ -0,0 +1,139 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides a flat index mapping indel breakends to their indel information.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <vector>
+
+#include <libjst/utility/memory_usage.hpp>
+
+namespace libjst
+{
+    /*!\brief A flat map from indel keys to indels stored in two sorted arrays.
+     *
+     * \tparam key_t The key type; must be totally ordered.
+     * \tparam indel_t The type of the stored indels.
+     *
+     * \details
+     *
+     * The keys and the indels are stored contiguously in two separate buffers, such that the binary search for a key
+     * only touches the key buffer and no allocation per entry is required. Keys are unique; emplacing an existing key
+     * leaves the index unchanged. Emplacing keys in ascending order appends them in amortised constant time, which is
+     * the case when the index is built in the order of the breakend map.
+     */
+    template <typename key_t, typename indel_t>
+    class indel_index {
+    private:
+
+        std::vector<key_t> _keys{};
+        std::vector<indel_t> _indels{};
+
+    public:
+
+        using key_type = key_t;
+        using mapped_type = indel_t;
+        using size_type = typename std::vector<key_t>::size_type;
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        constexpr indel_index() = default; //!< Default.
+        //!\}
+
+        /*!\brief Inserts the indel for the given key if the key is not yet contained.
+         *
+         * \param[in] key The key of the indel.
+         * \param[in] args The arguments to construct the indel from.
+         *
+         * \returns `true` if the indel was inserted, otherwise `false`.
+         */
+        template <typename ...args_t>
+            requires std::constructible_from<mapped_type, args_t...>
+        constexpr bool emplace(key_type key, args_t &&... args) {
+            auto key_it = _keys.end();
+            if (!_keys.empty() && !(_keys.back() < key)) {
+                key_it = std::ranges::lower_bound(_keys, key);
+                if (*key_it == key)
+                    return false;
+            }
+
+            auto offset = std::ranges::distance(_keys.begin(), key_it);
+            _keys.insert(key_it, std::move(key));
+            _indels.emplace(std::ranges::next(_indels.begin(), offset), (args_t &&) args...);
+            return true;
+        }
+
+        //!\brief Returns a pointer to the indel stored for the given key or `nullptr` if the key is not contained.
+        constexpr mapped_type const * find(key_type const & key) const noexcept {
+            auto key_it = std::ranges::lower_bound(_keys, key);
+            if (key_it == _keys.end() || !(*key_it == key))
+                return nullptr;
+
+            return std::addressof(_indels[std::ranges::distance(_keys.begin(), key_it)]);
+        }
+
+        constexpr bool contains(key_type const & key) const noexcept {
+            return find(key) != nullptr;
+        }
+
+        //!\brief Returns the indel stored for the given key, which must be contained.
+        constexpr mapped_type const & at(key_type const & key) const noexcept {
+            mapped_type const * indel = find(key);
+            assert(indel != nullptr);
+            return *indel;
+        }
+
+        constexpr size_type size() const noexcept {
+            return _keys.size();
+        }
+
+        constexpr bool empty() const noexcept {
+            return _keys.empty();
+        }
+
+        constexpr void reserve(size_type const new_capacity) {
+            _keys.reserve(new_capacity);
+            _indels.reserve(new_capacity);
+        }
+
+        //!\brief Returns the number of bytes allocated for the keys and the indels.
+        size_type memory_usage() const noexcept {
+            return libjst::memory_usage(_keys) + libjst::memory_usage(_indels);
+        }
+
+        constexpr void clear() noexcept {
+            _keys.clear();
+            _indels.clear();
+        }
+
+        //!\brief Returns the sorted keys.
+        constexpr std::vector<key_type> const & keys() const noexcept {
+            return _keys;
+        }
+
+        //!\brief Returns the indels in the order of their keys.
+        constexpr std::vector<mapped_type> const & indels() const noexcept {
+            return _indels;
+        }
+
+        //!\brief Returns the modifiable indels in the order of their keys; the keys cannot be changed this way.
+        constexpr std::span<mapped_type> mutable_indels() noexcept {
+            return _indels;
+        }
+    };
+}  // namespace libjst
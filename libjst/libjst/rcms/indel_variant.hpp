@@ -13,30 +13,41 @@
 #pragma once
 
 #include <type_traits>
+#include <utility>
 
 #include <cereal/types/variant.hpp>
 
 namespace libjst
 {
 
-    template <typename mate_iterator_t>
+    /*!\brief A deletion breakend linking to its mate breakend.
+     *
+     * \tparam mate_t The type of the link to the mate breakend.
+     *
+     * \details
+     *
+     * The multisequences link the mates by their position in the breakend map instead of an iterator, such that
+     * the link stays valid if the breakend map is copied, moved, serialised or concatenated with the breakends of
+     * another shard, where only the offset of the shard has to be added.
+     */
+    template <typename mate_t>
     class deletion_element {
-        mate_iterator_t _mate_it{};
+        mate_t _mate{};
     public:
 
-        using value_type = mate_iterator_t;
+        using value_type = mate_t;
 
         constexpr deletion_element() = default;
-        constexpr deletion_element(value_type mate_it)
-            noexcept(std::is_nothrow_move_constructible_v<value_type>) : _mate_it{mate_it}
+        constexpr deletion_element(value_type mate)
+            noexcept(std::is_nothrow_move_constructible_v<value_type>) : _mate{std::move(mate)}
         {}
 
         constexpr value_type const & value() const noexcept {
-            return _mate_it;
+            return _mate;
         }
 
         constexpr value_type & value() noexcept {
-            return _mate_it;
+            return _mate;
         }
 
         // ----------------------------------------------------------------------------
@@ -0,0 +1,41 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::interior_breakends to iterate the breakends of a multisequence without its sentinels.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <cassert>
+#include <iterator>
+#include <ranges>
+
+namespace libjst
+{
+    /*!\brief Returns the breakends of a multisequence without the nil breakends at the begin and the end of the source.
+     *
+     * \param[in] breakends The breakends of the multisequence, e.g. libjst::rcs_store::variants().
+     *
+     * \returns A subrange over the interior breakends, which is empty if the multisequence stores no variant.
+     *
+     * \details
+     *
+     * Every multisequence stores a nil breakend at position 0 and one at the size of the source, which bound the
+     * sequence tree. Loops over the variants iterate the returned subrange, whose bounds are computed once, instead
+     * of testing every breakend for being a sentinel. The end of the subrange is the high nil breakend.
+     */
+    template <std::ranges::bidirectional_range breakends_t>
+        requires std::ranges::common_range<breakends_t>
+    constexpr auto interior_breakends(breakends_t & breakends) noexcept
+        -> std::ranges::subrange<std::ranges::iterator_t<breakends_t>>
+    {
+        assert(std::ranges::distance(breakends) >= 2);
+        return {std::ranges::next(std::ranges::begin(breakends)), std::ranges::prev(std::ranges::end(breakends))};
+    }
+}  // namespace libjst
@@ -0,0 +1,762 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides a read-only compressed multisequence operating directly on a memory mapped binary layout.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/coverage/bit_coverage_view.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/generic_delta.hpp>
+#include <libjst/rcms/packed_breakend_key.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/utility/mapped_file.hpp>
+#include <libjst/utility/multi_invocable.hpp>
+#include <libjst/utility/tag_invoke.hpp>
+#include <libjst/variant/alternate_sequence_kind.hpp>
+#include <libjst/variant/breakpoint.hpp>
+#include <libjst/variant/concept.hpp>
+
+namespace libjst
+{
+    /*!\brief The header of the binary layout of a mapped compressed multisequence.
+     *
+     * \details
+     *
+     * The layout is written in the native byte order and consists of this header followed by five sections, each
+     * beginning at a multiple of eight bytes:
+     *
+     *  1. the characters of the source,
+     *  2. the packed breakend keys (see libjst::packed_breakend_key::packed) in the order of the breakend map,
+     *  3. the coverage words of all breakends, `coverage_stride` many words per breakend,
+     *  4. two 64 bit words per breakend linking an indel to its data: the position of the mate of a deletion
+     *     breakend or the offset and the size of the inserted sequence of an insertion breakend,
+     *  5. the characters of all inserted sequences.
+     *
+     * Readers must reject layouts with a different magic, version, byte order or key width.
+     */
+    struct mapped_multisequence_header {
+        static constexpr std::array<char, 8> expected_magic{'L', 'I', 'B', 'J', 'S', 'T', 'M', 'S'};
+        static constexpr uint32_t current_version{1};
+        static constexpr uint32_t expected_byte_order{0x01020304};
+
+        std::array<char, 8> magic{expected_magic};
+        uint32_t version{current_version};
+        uint32_t byte_order{expected_byte_order};
+        uint64_t key_width{}; // number of bytes of one packed breakend key
+        uint64_t source_size{};
+        uint64_t breakend_count{};
+        uint64_t coverage_min{};
+        uint64_t coverage_max{};
+        uint64_t coverage_stride{}; // number of coverage words per breakend
+        uint64_t insertion_size{}; // total number of inserted characters
+
+        //!\brief Returns the size of the given number of bytes padded to the next multiple of eight.
+        static constexpr uint64_t padded(uint64_t const byte_count) noexcept {
+            return (byte_count + 7) & ~uint64_t{7};
+        }
+
+        constexpr uint64_t source_offset() const noexcept {
+            return padded(sizeof(mapped_multisequence_header));
+        }
+
+        constexpr uint64_t key_offset() const noexcept {
+            return source_offset() + padded(source_size);
+        }
+
+        constexpr uint64_t coverage_offset() const noexcept {
+            return key_offset() + padded(breakend_count * key_width);
+        }
+
+        constexpr uint64_t link_offset() const noexcept {
+            return coverage_offset() + breakend_count * coverage_stride * sizeof(uint64_t);
+        }
+
+        constexpr uint64_t insertion_offset() const noexcept {
+            return link_offset() + breakend_count * 2 * sizeof(uint64_t);
+        }
+
+        //!\brief Returns the total number of bytes of the layout.
+        constexpr uint64_t layout_size() const noexcept {
+            return insertion_offset() + padded(insertion_size);
+        }
+    };
+
+    /*!\brief A read-only DNA compressed multisequence over the binary layout written by libjst::save_mapped.
+     *
+     * \tparam breakend_position_t The unsigned integer type of the packed breakend keys.
+     *
+     * \details
+     *
+     * The multisequence does not copy any data: the source, the breakend keys, the coverages and the inserted
+     * sequences are accessed in place, typically from a file mapped with libjst::mapped_file. Opening a multisequence
+     * therefore takes constant time and processes mapping the same file share its pages.
+     * The breakends are iterated in the same order and offer the same interface as the breakends of the
+     * libjst::dna_compressed_multisequence the layout was written from, where the coverages are returned as
+     * libjst::bit_coverage_view. Accordingly, the multisequence can be used as variant map of a
+     * libjst::rcs_store, see libjst::mapped_rcs_store.
+     */
+    template <std::unsigned_integral breakend_position_t = uint32_t>
+    class mapped_compressed_multisequence {
+    private:
+
+        static constexpr std::array<char, 4> _snv_table{'A', 'C', 'G', 'T'};
+
+        using position_type = breakend_position_t;
+        using breakend_key_type = packed_breakend_key<position_type>;
+        using word_type = uint64_t;
+        using coverage_type = bit_coverage<uint32_t>;
+        using coverage_reference = bit_coverage_view<uint32_t>;
+        using coverage_domain_type = libjst::coverage_domain_t<coverage_type>;
+
+        class iterator_impl;
+        class delta_proxy;
+
+        std::shared_ptr<void const> _owner{}; // the mapped file or the frozen layout; empty if the layout is borrowed.
+        char const * _source{};
+        position_type const * _keys{};
+        word_type const * _coverages{};
+        word_type const * _links{};
+        char const * _insertions{};
+        std::size_t _source_size{};
+        std::size_t _size{};
+        std::size_t _coverage_stride{};
+        coverage_domain_type _coverage_domain{};
+
+    public:
+
+        using iterator = iterator_impl;
+        using const_iterator = iterator_impl;
+        using value_type = std::iter_value_t<iterator>;
+        using source_type = std::span<char const>;
+        using size_type = std::size_t;
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        mapped_compressed_multisequence() = default; //!< Default.
+
+        /*!\brief Maps the layout stored in the given file.
+         *
+         * \details
+         *
+         * If huge_pages is true, the kernel is advised to back the mapping by huge pages, see libjst::mapped_file.
+         * Throws std::system_error if the file can not be mapped and std::runtime_error if it does not contain a
+         * valid layout.
+         */
+        explicit mapped_compressed_multisequence(std::filesystem::path const & path, bool const huge_pages = false) :
+            mapped_compressed_multisequence{std::make_shared<mapped_file const>(path, huge_pages)}
+        {}
+
+        /*!\brief Uses the layout stored in the given bytes without taking ownership.
+         *
+         * \details
+         *
+         * The bytes must be aligned to eight bytes and must outlive the multisequence.
+         * Throws std::runtime_error if the bytes do not contain a valid layout.
+         */
+        explicit mapped_compressed_multisequence(std::span<std::byte const> layout) {
+            attach(layout);
+        }
+
+        //!\brief Uses the layout of the given mapped file, which is kept alive by the multisequence.
+        explicit mapped_compressed_multisequence(std::shared_ptr<mapped_file const> file) {
+            attach(file->bytes());
+            _owner = std::move(file);
+        }
+
+        //!\brief Uses the layout held in the given words, which are kept alive by the multisequence, see libjst::freeze.
+        explicit mapped_compressed_multisequence(std::shared_ptr<std::vector<uint64_t> const> layout) {
+            attach(std::as_bytes(std::span{*layout}));
+            _owner = std::move(layout);
+        }
+        //!\}
+
+        constexpr size_type size() const noexcept {
+            return _size;
+        }
+
+        constexpr coverage_domain_type const & coverage_domain() const noexcept {
+            return _coverage_domain;
+        }
+
+        constexpr source_type source() const noexcept {
+            return source_type{_source, _source_size};
+        }
+
+        constexpr iterator begin() const noexcept {
+            return iterator{this, 0};
+        }
+
+        constexpr iterator end() const noexcept {
+            return iterator{this, static_cast<std::ptrdiff_t>(size())};
+        }
+
+    private:
+
+        void attach(std::span<std::byte const> layout) {
+            using header_type = mapped_multisequence_header;
+
+            if (reinterpret_cast<std::uintptr_t>(layout.data()) % alignof(word_type) != 0)
+                throw std::runtime_error{"The mapped multisequence must be aligned to eight bytes."};
+
+            if (layout.size() < sizeof(header_type))
+                throw std::runtime_error{"The mapped multisequence is too small to contain a header."};
+
+            header_type const & header = *reinterpret_cast<header_type const *>(layout.data());
+            if (header.magic != header_type::expected_magic)
+                throw std::runtime_error{"The given data is no mapped multisequence."};
+            if (header.version != header_type::current_version)
+                throw std::runtime_error{"Unsupported version " + std::to_string(header.version) +
+                                         " of the mapped multisequence."};
+            if (header.byte_order != header_type::expected_byte_order)
+                throw std::runtime_error{"The mapped multisequence was written with a different byte order."};
+            if (header.key_width != sizeof(position_type))
+                throw std::runtime_error{"The mapped multisequence stores breakend keys of " +
+                                         std::to_string(header.key_width) + " bytes, but " +
+                                         std::to_string(sizeof(position_type)) + " bytes were expected."};
+            if (header.coverage_stride != coverage_reference::word_count(coverage_domain_type{
+                    static_cast<uint32_t>(header.coverage_min), static_cast<uint32_t>(header.coverage_max)}))
+                throw std::runtime_error{"The coverage words of the mapped multisequence do not match its domain."};
+            if (layout.size() < header.layout_size())
+                throw std::runtime_error{"The mapped multisequence is truncated."};
+
+            auto section = [&] <typename value_t> (value_t const *, uint64_t const offset) {
+                return reinterpret_cast<value_t const *>(layout.data() + offset);
+            };
+
+            _source = section(_source, header.source_offset());
+            _keys = section(_keys, header.key_offset());
+            _coverages = section(_coverages, header.coverage_offset());
+            _links = section(_links, header.link_offset());
+            _insertions = section(_insertions, header.insertion_offset());
+            _source_size = header.source_size;
+            _size = header.breakend_count;
+            _coverage_stride = header.coverage_stride;
+            _coverage_domain = coverage_domain_type{static_cast<uint32_t>(header.coverage_min),
+                                                    static_cast<uint32_t>(header.coverage_max)};
+        }
+
+        constexpr breakend_key_type key_at(std::ptrdiff_t const position) const noexcept {
+            return breakend_key_type::from_packed(_keys[position]);
+        }
+
+        constexpr coverage_reference coverage_at(std::ptrdiff_t const position) const noexcept {
+            return coverage_reference{_coverages + position * static_cast<std::ptrdiff_t>(_coverage_stride),
+                                      _coverage_domain};
+        }
+
+        constexpr word_type const * link_at(std::ptrdiff_t const position) const noexcept {
+            return _links + 2 * position;
+        }
+    };
+
+    template <std::unsigned_integral breakend_position_t>
+    class mapped_compressed_multisequence<breakend_position_t>::iterator_impl {
+    private:
+
+        friend mapped_compressed_multisequence;
+
+        mapped_compressed_multisequence const * _host{};
+        std::ptrdiff_t _position{};
+
+        explicit constexpr iterator_impl(mapped_compressed_multisequence const * host,
+                                         std::ptrdiff_t const position) noexcept :
+            _host{host},
+            _position{position}
+        {}
+
+    public:
+
+        using value_type = generic_delta<std::string, coverage_type>;
+        using reference = delta_proxy;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using iterator_category = std::random_access_iterator_tag;
+
+        constexpr iterator_impl() = default;
+
+        constexpr reference operator*() const noexcept {
+            return reference{_host, _position};
+        }
+
+        constexpr reference operator[](difference_type const step) const noexcept {
+            return *(*this + step);
+        }
+
+        constexpr iterator_impl & operator++() noexcept {
+            ++_position;
+            return *this;
+        }
+
+        constexpr iterator_impl operator++(int) noexcept {
+            iterator_impl tmp{*this};
+            ++(*this);
+            return tmp;
+        }
+
+        constexpr iterator_impl & operator+=(difference_type const step) noexcept {
+            _position += step;
+            return *this;
+        }
+
+        constexpr iterator_impl & operator--() noexcept {
+            --_position;
+            return *this;
+        }
+
+        constexpr iterator_impl operator--(int) noexcept {
+            iterator_impl tmp{*this};
+            --(*this);
+            return tmp;
+        }
+
+        constexpr iterator_impl & operator-=(difference_type const step) noexcept {
+            _position -= step;
+            return *this;
+        }
+
+    private:
+
+        constexpr friend iterator_impl operator+(iterator_impl lhs, difference_type const step) noexcept {
+            return lhs += step;
+        }
+
+        constexpr friend iterator_impl operator+(difference_type const step, iterator_impl rhs) noexcept {
+            return rhs += step;
+        }
+
+        constexpr friend iterator_impl operator-(iterator_impl lhs, difference_type const step) noexcept {
+            return lhs -= step;
+        }
+
+        constexpr friend difference_type operator-(iterator_impl const & lhs, iterator_impl const & rhs) noexcept {
+            return lhs._position - rhs._position;
+        }
+
+        constexpr friend bool operator==(iterator_impl const & lhs, iterator_impl const & rhs) noexcept {
+            return lhs._position == rhs._position;
+        }
+
+        constexpr friend std::strong_ordering operator<=>(iterator_impl const & lhs, iterator_impl const & rhs) noexcept {
+            return lhs._position <=> rhs._position;
+        }
+    };
+
+    template <std::unsigned_integral breakend_position_t>
+    class mapped_compressed_multisequence<breakend_position_t>::delta_proxy {
+    private:
+
+        friend mapped_compressed_multisequence;
+
+        using value_type = std::iter_value_t<iterator_impl>;
+        using sequence_reference = source_type;
+
+        mapped_compressed_multisequence const * _host;
+        std::ptrdiff_t _position;
+
+        explicit constexpr delta_proxy(mapped_compressed_multisequence const * host,
+                                       std::ptrdiff_t const position) noexcept :
+            _host{host},
+            _position{position}
+        {}
+
+    public:
+
+        delta_proxy() = delete;
+
+        constexpr operator value_type() const {
+            auto seq = libjst::alt_sequence(*this);
+            return value_type{libjst::get_breakpoint(*this),
+                              std::string{seq.begin(), seq.end()},
+                              coverage_type{libjst::coverage(*this)}};
+        }
+
+        constexpr breakend_key_type get_key() const noexcept {
+            return _host->key_at(_position);
+        }
+
+        constexpr breakpoint_end get_breakpoint_end() const noexcept {
+            breakend_key_type const key = get_key();
+            return key.visit(libjst::multi_invocable{
+                [pos = key.position()] (indel_breakend_kind code) {
+                    switch (code) {
+                        case indel_breakend_kind::deletion_low: [[fallthrough]];
+                        case indel_breakend_kind::insertion_low: return breakpoint_end::low;
+                        case indel_breakend_kind::nil: return (pos == 0) ? breakpoint_end::low : breakpoint_end::high;
+                        default: return breakpoint_end::high;
+                    }
+                },
+                [] (...) {
+                    return breakpoint_end::low;
+                }
+            });
+        }
+
+        constexpr std::optional<iterator_impl> jump_to_mate() const noexcept {
+            if (!is_deletion())
+                return std::nullopt;
+
+            return iterator_impl{_host, mate_position()};
+        }
+
+    private:
+
+        constexpr bool is_deletion() const noexcept {
+            breakend_key_type const key = get_key();
+            return key.is_indel() && (key.indel_kind() == indel_breakend_kind::deletion_low ||
+                                      key.indel_kind() == indel_breakend_kind::deletion_high);
+        }
+
+        constexpr std::ptrdiff_t mate_position() const noexcept {
+            assert(is_deletion());
+            return static_cast<std::ptrdiff_t>(_host->link_at(_position)[0]);
+        }
+
+        constexpr breakpoint extract_breakpoint() const noexcept {
+            using position_t = typename breakpoint::value_type;
+            using signed_position_t = std::make_signed_t<position_type>;
+
+            breakend_key_type const key = get_key();
+            position_t const position = static_cast<position_t>(key.position());
+            if (is_deletion()) {
+                position_type const mate = _host->key_at(mate_position()).position();
+                position_t const low_breakend = (key.indel_kind() == indel_breakend_kind::deletion_low) ?
+                                                    position : static_cast<position_t>(mate);
+                size_t deletion_size = std::abs(static_cast<signed_position_t>(mate) -
+                                                static_cast<signed_position_t>(key.position()));
+                return breakpoint{low_breakend, deletion_size};
+            } else if (key.is_indel()) {
+                return breakpoint{position, 0};
+            } else {
+                return breakpoint{position, 1};
+            }
+        }
+
+        constexpr sequence_reference extract_alt_sequence() const noexcept {
+            breakend_key_type const key = get_key();
+            if (!key.is_indel())
+                return sequence_reference{std::addressof(_snv_table[key.snv_value()]), 1};
+
+            if (key.indel_kind() == indel_breakend_kind::insertion_low) {
+                word_type const * link = _host->link_at(_position);
+                return sequence_reference{_host->_insertions + link[0], static_cast<std::size_t>(link[1])};
+            }
+            return sequence_reference{};
+        }
+
+        constexpr coverage_reference extract_coverage() const noexcept {
+            return _host->coverage_at(_position);
+        }
+
+        template <typename result_t>
+        using make_result_t = std::conditional_t<std::is_rvalue_reference_v<result_t>,
+                                                 std::remove_reference_t<result_t>,
+                                                 result_t>;
+
+        template <typename cpo_t>
+            requires libjst::tag_invocable<cpo_t, breakpoint>
+        friend constexpr auto tag_invoke(cpo_t cpo, delta_proxy me)
+            noexcept(libjst::is_nothrow_tag_invocable_v<cpo_t, breakpoint>)
+            -> make_result_t<libjst::tag_invoke_result_t<cpo_t, breakpoint>>
+        {
+            return libjst::tag_invoke(cpo, libjst::get_breakpoint(std::move(me)));
+        }
+
+        friend constexpr breakpoint tag_invoke(libjst::tag_t<libjst::get_breakpoint>, delta_proxy me) noexcept
+        {
+            return me.extract_breakpoint();
+        }
+
+        friend constexpr sequence_reference tag_invoke(libjst::tag_t<libjst::alt_sequence>, delta_proxy me) noexcept
+        {
+            return me.extract_alt_sequence();
+        }
+
+        friend constexpr coverage_reference tag_invoke(libjst::tag_t<libjst::coverage>, delta_proxy me) noexcept
+        {
+            return me.extract_coverage();
+        }
+
+        friend constexpr position_type tag_invoke(libjst::tag_t<libjst::position>, delta_proxy me) noexcept
+        {
+            return me.get_key().position();
+        }
+
+        friend constexpr alternate_sequence_kind tag_invoke(libjst::tag_t<libjst::alt_kind>, delta_proxy me) noexcept
+        {
+            return me.get_key().visit(libjst::multi_invocable{
+                [&] (indel_breakend_kind indel_kind) {
+                    switch (indel_kind) {
+                        case indel_breakend_kind::insertion_low: return alternate_sequence_kind::insertion;
+                        case indel_breakend_kind::deletion_low: [[fallthrough]];
+                        case indel_breakend_kind::deletion_high: return alternate_sequence_kind::deletion;
+                        default: return alternate_sequence_kind::unknown;
+                    }
+                },
+                [] (...) { return alternate_sequence_kind::replacement; }
+            });
+        }
+
+        friend constexpr std::ptrdiff_t tag_invoke(libjst::tag_t<libjst::effective_size>, delta_proxy me) noexcept
+        {
+            return std::ranges::ssize(libjst::alt_sequence(me)) -
+                   static_cast<std::ptrdiff_t>(libjst::breakpoint_span(libjst::get_breakpoint(me)));
+        }
+    };
+
+    namespace detail {
+        //!\brief Returns the header of the binary layout of the given multisequence, see libjst::save_mapped.
+        template <typename source_t, std::unsigned_integral breakend_position_t, typename coverage_store_t>
+        mapped_multisequence_header make_mapped_header(dna_compressed_multisequence<source_t,
+                                                                                    bit_coverage<uint32_t>,
+                                                                                    breakend_position_t,
+                                                                                    coverage_store_t> const &
+                                                           multisequence) {
+            mapped_multisequence_header header{};
+            header.key_width = sizeof(breakend_position_t);
+            header.source_size = std::ranges::size(multisequence.source());
+            header.breakend_count = std::ranges::size(multisequence);
+            header.coverage_min = multisequence.coverage_domain().min();
+            header.coverage_max = multisequence.coverage_domain().max();
+            header.coverage_stride = bit_coverage_view<uint32_t>::word_count(multisequence.coverage_domain());
+            for (auto && delta : multisequence) {
+                auto const key = delta.get_key();
+                if (key.is_indel() && key.indel_kind() == indel_breakend_kind::insertion_low)
+                    header.insertion_size += std::ranges::size(libjst::alt_sequence(delta));
+            }
+            return header;
+        }
+    } // namespace detail
+
+    //!\brief A read-only rcs store over a memory mapped multisequence.
+    template <std::unsigned_integral breakend_position_t = uint32_t>
+    using mapped_rcs_store = rcs_store<std::span<char const>, mapped_compressed_multisequence<breakend_position_t>>;
+
+    namespace detail {
+        //!\brief Writes the binary layout of the given multisequence with the given header to the sink.
+        template <typename source_t,
+                  std::unsigned_integral breakend_position_t,
+                  typename coverage_store_t,
+                  typename write_t>
+        void write_mapped_layout(dna_compressed_multisequence<source_t,
+                                                              bit_coverage<uint32_t>,
+                                                              breakend_position_t,
+                                                              coverage_store_t> const & multisequence,
+                                 mapped_multisequence_header const & header,
+                                 write_t && write) {
+            using header_type = mapped_multisequence_header;
+            using coverage_view_type = bit_coverage_view<uint32_t>;
+
+            auto pad = [&] (std::size_t const byte_count) {
+                std::array<char, 8> const zeros{};
+                write(zeros.data(), header_type::padded(byte_count) - byte_count);
+            };
+
+            auto multisequence_begin = multisequence.begin();
+            auto is_insertion = [] (auto const & key) {
+                return key.is_indel() && key.indel_kind() == indel_breakend_kind::insertion_low;
+            };
+
+            write(&header, sizeof(header_type));
+            pad(sizeof(header_type));
+
+            write(std::ranges::data(multisequence.source()), header.source_size);
+            pad(header.source_size);
+
+            for (auto && delta : multisequence) {
+                breakend_position_t const packed_key = delta.get_key().packed();
+                write(&packed_key, sizeof(packed_key));
+            }
+            pad(header.breakend_count * header.key_width);
+
+            for (auto && delta : multisequence) {
+                auto words = coverage_view_type{libjst::coverage(delta)}.words();
+                write(words.data(), words.size_bytes());
+            }
+
+            uint64_t insertion_offset{};
+            for (auto && delta : multisequence) {
+                std::array<uint64_t, 2> link{};
+                if (auto mate = delta.jump_to_mate(); mate.has_value()) {
+                    link[0] = static_cast<uint64_t>(*mate - multisequence_begin);
+                } else if (is_insertion(delta.get_key())) {
+                    link[0] = insertion_offset;
+                    link[1] = std::ranges::size(libjst::alt_sequence(delta));
+                    insertion_offset += link[1];
+                }
+                write(link.data(), sizeof(link));
+            }
+
+            for (auto && delta : multisequence) {
+                if (is_insertion(delta.get_key())) {
+                    auto insertion = libjst::alt_sequence(delta);
+                    write(std::ranges::data(insertion), std::ranges::size(insertion));
+                }
+            }
+            pad(header.insertion_size);
+        }
+    } // namespace detail
+
+    /*!\brief Writes the binary layout of the given multisequence, which can be used by
+     *        libjst::mapped_compressed_multisequence.
+     *
+     * \param[in] ostream The binary output stream to write to.
+     * \param[in] multisequence The multisequence to write.
+     *
+     * \details
+     *
+     * Throws std::runtime_error if writing to the stream fails.
+     */
+    template <typename source_t, std::unsigned_integral breakend_position_t, typename coverage_store_t>
+    void save_mapped(std::ostream & ostream,
+                     dna_compressed_multisequence<source_t,
+                                                  bit_coverage<uint32_t>,
+                                                  breakend_position_t,
+                                                  coverage_store_t> const & multisequence) {
+        detail::write_mapped_layout(multisequence, detail::make_mapped_header(multisequence),
+                                    [&] (void const * data, std::size_t const byte_count) {
+            ostream.write(static_cast<char const *>(data), static_cast<std::streamsize>(byte_count));
+        });
+
+        if (!ostream)
+            throw std::runtime_error{"Could not write the mapped multisequence."};
+    }
+
+    //!\brief Writes the binary layout of the variants of the given store, see libjst::save_mapped.
+    template <typename source_t, typename cms_t>
+    void save_mapped(std::ostream & ostream, rcs_store<source_t, cms_t> const & store) {
+        save_mapped(ostream, store.variants());
+    }
+
+    /*!\brief Converts a multisequence that is no longer modified into the read-only layout of the mapped format.
+     *
+     * \param[in] multisequence The multisequence to freeze.
+     *
+     * \returns A libjst::mapped_compressed_multisequence owning its layout.
+     *
+     * \details
+     *
+     * The build-time containers of the libjst::dna_compressed_multisequence, i.e. the breakend map, the coverages
+     * allocated per breakend, the indel map and the pool of inserted sequences with its hash table, are written into
+     * a single allocation of exactly the size of the layout written by libjst::save_mapped. The breakends link to the
+     * mates of deletions and to the inserted sequences by index, such that no lookup into an indel map is needed to
+     * jump over a deletion. The frozen multisequence is hence the in-memory image of a mapped file and offers the
+     * same interface; it can be copied cheaply, as the copies share the layout.
+     *
+     * ### Complexity
+     *
+     * Linear in the size of the layout.
+     */
+    template <typename source_t, std::unsigned_integral breakend_position_t, typename coverage_store_t>
+    mapped_compressed_multisequence<breakend_position_t> freeze(dna_compressed_multisequence<source_t,
+                                                                                             bit_coverage<uint32_t>,
+                                                                                             breakend_position_t,
+                                                                                             coverage_store_t> const &
+                                                                    multisequence) {
+        mapped_multisequence_header const header = detail::make_mapped_header(multisequence);
+        auto layout = std::make_shared<std::vector<uint64_t>>(header.layout_size() / sizeof(uint64_t));
+        std::byte * layout_it = reinterpret_cast<std::byte *>(layout->data());
+        detail::write_mapped_layout(multisequence, header, [&] (void const * data, std::size_t const byte_count) {
+            std::memcpy(layout_it, data, byte_count);
+            layout_it += byte_count;
+        });
+        assert(layout_it == reinterpret_cast<std::byte *>(layout->data() + layout->size()));
+        return mapped_compressed_multisequence<breakend_position_t>{
+            std::shared_ptr<std::vector<uint64_t> const>{std::move(layout)}
+        };
+    }
+
+    //!\brief Freezes the variants of the given store into a libjst::mapped_rcs_store, see libjst::freeze.
+    template <typename source_t, typename cms_t>
+    auto freeze(rcs_store<source_t, cms_t> const & store) {
+        auto frozen = freeze(store.variants());
+        return rcs_store<std::span<char const>, decltype(frozen)>{std::move(frozen)};
+    }
+
+    /*!\brief Loads the deltas of a mapped multisequence whose low breakend lies in the given source interval.
+     *
+     * \tparam source_t The source type of the loaded store, which must own its characters.
+     * \tparam coverage_store_t The type storing the coverages of the loaded multisequence.
+     *
+     * \param[in] multisequence The mapped multisequence to load from.
+     * \param[in] first The first source position of the interval.
+     * \param[in] last The source position one past the end of the interval.
+     *
+     * \returns An rcs store over the entire source containing only the selected deltas.
+     *
+     * \details
+     *
+     * The breakends are sorted by their position, such that the interval is located by a binary search over the
+     * mapped breakend keys and only the keys, coverages and inserted sequences of the selected deltas are read.
+     * Deletions are loaded entirely if their low breakend is inside the interval, which is the same rule used to
+     * assign deltas to shards in libjst::sharded_rcs_builder. The positions of the loaded store refer to the
+     * entire source, such that a libjst::partial_tree can be used directly on the loaded store. Note that the
+     * partial tree of a bin extends its paths beyond the end of the bin, so the interval must cover this extension.
+     *
+     * ### Complexity
+     *
+     * Logarithmic in the number of breakends plus linear in the number of selected breakends and the source size.
+     */
+    template <typename source_t = std::string,
+              typename coverage_store_t = std::vector<bit_coverage<uint32_t>>,
+              std::unsigned_integral breakend_position_t>
+    auto load_region(mapped_compressed_multisequence<breakend_position_t> const & multisequence,
+                     std::size_t const first,
+                     std::size_t const last) {
+        using cms_type = dna_compressed_multisequence<source_t,
+                                                      bit_coverage<uint32_t>,
+                                                      breakend_position_t,
+                                                      coverage_store_t>;
+        using store_type = rcs_store<source_t, cms_type>;
+        using delta_type = std::ranges::range_value_t<cms_type>;
+
+        assert(first <= last);
+        auto to_position = [] (auto && delta) -> std::size_t { return libjst::position(delta); };
+        auto region_begin = std::ranges::lower_bound(multisequence, first, std::ranges::less{}, to_position);
+        auto region_end = std::ranges::lower_bound(region_begin, multisequence.end(), last,
+                                                   std::ranges::less{}, to_position);
+
+        std::vector<delta_type> deltas{};
+        deltas.reserve(region_end - region_begin);
+        for (auto && delta : std::ranges::subrange{region_begin, region_end}) {
+            auto const key = delta.get_key();
+            if (key.is_indel() && key.indel_kind() != indel_breakend_kind::insertion_low &&
+                                  key.indel_kind() != indel_breakend_kind::deletion_low)
+                continue; // only the low breakend of a delta is loaded.
+
+            auto seq = libjst::alt_sequence(delta);
+            deltas.emplace_back(libjst::get_breakpoint(delta), source_t{seq.begin(), seq.end()},
+                                bit_coverage<uint32_t>{libjst::coverage(delta)});
+        }
+
+        // The store constructs the multisequence in place, as moving it would invalidate the deletion mates.
+        auto source = multisequence.source();
+        return store_type{source_t{source.begin(), source.end()}, multisequence.coverage_domain().max(), deltas};
+    }
+}  // namespace libjst
@@ -0,0 +1,419 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides containers of the rcs stores of several contigs sharing one haplotype domain.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <ostream>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <libjst/coverage/concept.hpp>
+#include <libjst/rcms/mapped_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/utility/mapped_file.hpp>
+
+namespace libjst
+{
+    /*!\brief The rcs stores of several contigs, e.g. the chromosomes of a genome, over the same haplotypes.
+     *
+     * \tparam store_t The type of the rcs store of a single contig.
+     *
+     * \details
+     *
+     * Every contig is identified by its index in the order the contigs were added and by a unique name. All contigs
+     * share the coverage domain of the container, such that a haplotype refers to the same sample on every contig.
+     * The stores are constructed in place and are never moved afterwards, such that references to a contig stay
+     * valid when further contigs are added.
+     *
+     * The container can be written into a single file with libjst::save_multi_contig, from which the contigs are mapped
+     * individually and on demand by libjst::mapped_multi_contig_store.
+     */
+    template <typename store_t>
+    class multi_contig_store {
+    private:
+
+        struct contig_entry {
+            std::string name{};
+            store_t store;
+
+            template <typename ...args_t>
+            contig_entry(std::string contig_name, args_t && ...args) :
+                name{std::move(contig_name)},
+                store{(args_t &&) args...}
+            {}
+        };
+
+        std::deque<contig_entry> _contigs{};
+        typename store_t::size_type _haplotype_count{};
+
+    public:
+
+        using store_type = store_t;
+        using size_type = typename store_t::size_type;
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        multi_contig_store() = default; //!< Default.
+        multi_contig_store(multi_contig_store const &) = delete; //!< Deleted.
+        multi_contig_store & operator=(multi_contig_store const &) = delete; //!< Deleted.
+        multi_contig_store(multi_contig_store &&) = default; //!< Default.
+        multi_contig_store & operator=(multi_contig_store &&) = default; //!< Default.
+
+        //!\brief Constructs an empty container for the given number of haplotypes.
+        explicit multi_contig_store(size_type const haplotype_count) noexcept : _haplotype_count{haplotype_count}
+        {}
+        //!\}
+
+        /*!\brief Constructs the store of a new contig in place from the given arguments.
+         *
+         * \param[in] name The unique name of the contig.
+         * \param[in] args The arguments forwarded to the constructor of the store.
+         *
+         * \returns The index of the new contig.
+         *
+         * \details
+         *
+         * Throws std::invalid_argument if a contig with the same name exists already or if the store does not cover
+         * the haplotypes of the container. The container is left unchanged in this case.
+         */
+        template <typename ...args_t>
+            requires std::constructible_from<store_t, args_t...>
+        std::size_t emplace_contig(std::string name, args_t && ...args) {
+            if (find(name).has_value())
+                throw std::invalid_argument{"The contig " + name + " exists already."};
+
+            contig_entry & entry = _contigs.emplace_back(std::move(name), (args_t &&) args...);
+            if (entry.store.size() != _haplotype_count) {
+                _contigs.pop_back();
+                throw std::invalid_argument{"The store of a contig must cover " + std::to_string(_haplotype_count) +
+                                            " haplotypes."};
+            }
+            return _contigs.size() - 1;
+        }
+
+        //!\brief Returns the number of contigs.
+        constexpr std::size_t contig_count() const noexcept {
+            return _contigs.size();
+        }
+
+        //!\brief Returns the number of haplotypes shared by all contigs.
+        constexpr size_type size() const noexcept {
+            return _haplotype_count;
+        }
+
+        //!\brief Returns the name of the contig with the given index.
+        constexpr std::string const & name(std::size_t const contig_idx) const noexcept {
+            return _contigs[contig_idx].name;
+        }
+
+        //!\brief Returns the store of the contig with the given index.
+        constexpr store_t const & contig(std::size_t const contig_idx) const noexcept {
+            return _contigs[contig_idx].store;
+        }
+
+        //!\brief Returns the store of the contig with the given name; throws std::out_of_range if there is none.
+        store_t const & contig(std::string_view const contig_name) const {
+            return contig(index_of(contig_name));
+        }
+
+        //!\brief Returns the index of the contig with the given name or std::nullopt if there is none.
+        std::optional<std::size_t> find(std::string_view const contig_name) const noexcept {
+            for (std::size_t contig_idx = 0; contig_idx < contig_count(); ++contig_idx)
+                if (name(contig_idx) == contig_name)
+                    return contig_idx;
+            return std::nullopt;
+        }
+
+        //!\brief Returns the index of the contig with the given name; throws std::out_of_range if there is none.
+        std::size_t index_of(std::string_view const contig_name) const {
+            if (auto contig_idx = find(contig_name); contig_idx.has_value())
+                return *contig_idx;
+            throw std::out_of_range{"There is no contig " + std::string{contig_name} + "."};
+        }
+    };
+
+    /*!\brief The header of the binary layout of a libjst::multi_contig_store.
+     *
+     * \details
+     *
+     * The layout is written in the native byte order and consists of this header, followed by one
+     * libjst::multi_contig_entry per contig, the characters of all contig names and the mapped layouts of the contigs
+     * (see libjst::mapped_multisequence_header). The names and every mapped layout begin at a multiple of eight bytes.
+     */
+    struct multi_contig_header {
+        static constexpr std::array<char, 8> expected_magic{'L', 'I', 'B', 'J', 'S', 'T', 'M', 'C'};
+        static constexpr uint32_t current_version{1};
+        static constexpr uint32_t expected_byte_order{0x01020304};
+
+        std::array<char, 8> magic{expected_magic};
+        uint32_t version{current_version};
+        uint32_t byte_order{expected_byte_order};
+        uint64_t contig_count{};
+        uint64_t haplotype_count{};
+    };
+
+    //!\brief The location of the name and of the mapped layout of a contig within a multi contig layout.
+    struct multi_contig_entry {
+        uint64_t name_offset{};
+        uint64_t name_size{};
+        uint64_t layout_offset{};
+        uint64_t layout_size{};
+    };
+
+    /*!\brief Writes all contigs of the given container into a single binary layout, which can be used by
+     *        libjst::mapped_multi_contig_store.
+     *
+     * \param[in] ostream The binary output stream to write to.
+     * \param[in] multi_store The contigs to write.
+     *
+     * \details
+     *
+     * The contigs are written one after the other with libjst::save_mapped, such that no contig is copied.
+     * Throws std::runtime_error if writing to the stream fails.
+     */
+    template <typename store_t>
+    void save_multi_contig(std::ostream & ostream, multi_contig_store<store_t> const & multi_store) {
+        using padding = mapped_multisequence_header;
+
+        auto write = [&] (void const * data, std::size_t const byte_count) {
+            ostream.write(static_cast<char const *>(data), static_cast<std::streamsize>(byte_count));
+        };
+
+        multi_contig_header header{};
+        header.contig_count = multi_store.contig_count();
+        header.haplotype_count = multi_store.size();
+
+        std::vector<multi_contig_entry> entries(multi_store.contig_count());
+        uint64_t offset = sizeof(multi_contig_header) + entries.size() * sizeof(multi_contig_entry);
+        for (std::size_t contig_idx = 0; contig_idx < entries.size(); ++contig_idx) {
+            entries[contig_idx].name_offset = offset;
+            entries[contig_idx].name_size = multi_store.name(contig_idx).size();
+            offset += entries[contig_idx].name_size;
+        }
+        offset = padding::padded(offset);
+        for (std::size_t contig_idx = 0; contig_idx < entries.size(); ++contig_idx) {
+            entries[contig_idx].layout_offset = offset;
+            entries[contig_idx].layout_size =
+                detail::make_mapped_header(multi_store.contig(contig_idx).variants()).layout_size();
+            offset += entries[contig_idx].layout_size;
+        }
+
+        write(&header, sizeof(header));
+        write(entries.data(), entries.size() * sizeof(multi_contig_entry));
+        uint64_t names_end = sizeof(multi_contig_header) + entries.size() * sizeof(multi_contig_entry);
+        for (std::size_t contig_idx = 0; contig_idx < entries.size(); ++contig_idx) {
+            write(multi_store.name(contig_idx).data(), entries[contig_idx].name_size);
+            names_end += entries[contig_idx].name_size;
+        }
+        std::array<char, 8> const zeros{};
+        write(zeros.data(), padding::padded(names_end) - names_end);
+
+        for (std::size_t contig_idx = 0; contig_idx < entries.size(); ++contig_idx)
+            save_mapped(ostream, multi_store.contig(contig_idx));
+
+        if (!ostream)
+            throw std::runtime_error{"Could not write the multi contig store."};
+    }
+
+    /*!\brief A read-only container of the contigs of the binary layout written by libjst::save_multi_contig.
+     *
+     * \tparam breakend_position_t The unsigned integer type of the packed breakend keys.
+     *
+     * \details
+     *
+     * Opening the container only reads the index of the contigs. A contig is mapped as libjst::mapped_rcs_store when
+     * it is accessed for the first time, which validates its layout; concurrent first accesses are synchronised.
+     * A contig can also be loaded entirely into memory with load_contig, e.g. to modify it.
+     * The container offers the same interface as libjst::multi_contig_store for reading the contigs.
+     */
+    template <std::unsigned_integral breakend_position_t = uint32_t>
+    class mapped_multi_contig_store {
+    public:
+
+        using store_type = mapped_rcs_store<breakend_position_t>;
+        using size_type = typename store_type::size_type;
+
+    private:
+
+        struct contig_slot {
+            std::string name{};
+            std::span<std::byte const> layout{};
+            std::once_flag mapped_flag{};
+            std::optional<store_type> store{};
+        };
+
+        std::shared_ptr<mapped_file const> _file{}; // empty if the layout is borrowed.
+        std::unique_ptr<contig_slot[]> _contigs{};
+        std::size_t _contig_count{};
+        size_type _haplotype_count{};
+
+    public:
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        mapped_multi_contig_store() = default; //!< Default.
+
+        /*!\brief Maps the layout stored in the given file.
+         *
+         * \details
+         *
+         * If huge_pages is true, the kernel is advised to back the mapping by huge pages, see libjst::mapped_file.
+         * Throws std::system_error if the file can not be mapped and std::runtime_error if it does not contain a
+         * valid layout.
+         */
+        explicit mapped_multi_contig_store(std::filesystem::path const & path, bool const huge_pages = false) :
+            mapped_multi_contig_store{std::make_shared<mapped_file const>(path, huge_pages)}
+        {}
+
+        /*!\brief Uses the layout stored in the given bytes without taking ownership.
+         *
+         * \details
+         *
+         * The bytes must be aligned to eight bytes and must outlive the container.
+         * Throws std::runtime_error if the bytes do not contain a valid layout.
+         */
+        explicit mapped_multi_contig_store(std::span<std::byte const> layout) {
+            attach(layout);
+        }
+
+        //!\brief Uses the layout of the given mapped file, which is kept alive by the container.
+        explicit mapped_multi_contig_store(std::shared_ptr<mapped_file const> file) : _file{std::move(file)} {
+            attach(_file->bytes());
+        }
+        //!\}
+
+        //!\brief Returns the number of contigs.
+        constexpr std::size_t contig_count() const noexcept {
+            return _contig_count;
+        }
+
+        //!\brief Returns the number of haplotypes shared by all contigs.
+        constexpr size_type size() const noexcept {
+            return _haplotype_count;
+        }
+
+        //!\brief Returns the name of the contig with the given index.
+        constexpr std::string const & name(std::size_t const contig_idx) const noexcept {
+            return _contigs[contig_idx].name;
+        }
+
+        /*!\brief Returns the store of the contig with the given index, which is mapped on the first access.
+         *
+         * \details
+         *
+         * Throws std::runtime_error if the layout of the contig is invalid.
+         */
+        store_type const & contig(std::size_t const contig_idx) const {
+            contig_slot & slot = _contigs[contig_idx];
+            std::call_once(slot.mapped_flag, [&] () {
+                store_type store{mapped_compressed_multisequence<breakend_position_t>{slot.layout}};
+                if (store.size() != _haplotype_count)
+                    throw std::runtime_error{"The contig " + slot.name + " does not cover the haplotypes of the "
+                                             "multi contig store."};
+                slot.store.emplace(std::move(store));
+            });
+            return *slot.store;
+        }
+
+        //!\brief Returns the store of the contig with the given name; throws std::out_of_range if there is none.
+        store_type const & contig(std::string_view const contig_name) const {
+            return contig(index_of(contig_name));
+        }
+
+        //!\brief Returns whether the contig with the given index has been mapped already.
+        bool is_mapped(std::size_t const contig_idx) const noexcept {
+            return _contigs[contig_idx].store.has_value();
+        }
+
+        /*!\brief Loads the contig with the given index into memory, see libjst::load_region.
+         *
+         * \tparam source_t The source type of the loaded store, which must own its characters.
+         * \tparam coverage_store_t The type storing the coverages of the loaded multisequence.
+         */
+        template <typename source_t = std::string, typename coverage_store_t = std::vector<bit_coverage<uint32_t>>>
+        auto load_contig(std::size_t const contig_idx) const {
+            auto const & variants = contig(contig_idx).variants();
+            return load_region<source_t, coverage_store_t>(variants, 0, std::ranges::size(variants.source()));
+        }
+
+        //!\brief Returns the index of the contig with the given name or std::nullopt if there is none.
+        std::optional<std::size_t> find(std::string_view const contig_name) const noexcept {
+            for (std::size_t contig_idx = 0; contig_idx < contig_count(); ++contig_idx)
+                if (name(contig_idx) == contig_name)
+                    return contig_idx;
+            return std::nullopt;
+        }
+
+        //!\brief Returns the index of the contig with the given name; throws std::out_of_range if there is none.
+        std::size_t index_of(std::string_view const contig_name) const {
+            if (auto contig_idx = find(contig_name); contig_idx.has_value())
+                return *contig_idx;
+            throw std::out_of_range{"There is no contig " + std::string{contig_name} + "."};
+        }
+
+    private:
+
+        void attach(std::span<std::byte const> layout) {
+            using header_type = multi_contig_header;
+
+            if (reinterpret_cast<std::uintptr_t>(layout.data()) % alignof(uint64_t) != 0)
+                throw std::runtime_error{"The multi contig store must be aligned to eight bytes."};
+            if (layout.size() < sizeof(header_type))
+                throw std::runtime_error{"The multi contig store is too small to contain a header."};
+
+            header_type const & header = *reinterpret_cast<header_type const *>(layout.data());
+            if (header.magic != header_type::expected_magic)
+                throw std::runtime_error{"The given data is no multi contig store."};
+            if (header.version != header_type::current_version)
+                throw std::runtime_error{"Unsupported version " + std::to_string(header.version) +
+                                         " of the multi contig store."};
+            if (header.byte_order != header_type::expected_byte_order)
+                throw std::runtime_error{"The multi contig store was written with a different byte order."};
+            if ((layout.size() - sizeof(header_type)) / sizeof(multi_contig_entry) < header.contig_count)
+                throw std::runtime_error{"The multi contig store is truncated."};
+
+            auto const * entries = reinterpret_cast<multi_contig_entry const *>(layout.data() + sizeof(header_type));
+            auto is_inside = [&] (uint64_t const offset, uint64_t const size) {
+                return offset <= layout.size() && size <= layout.size() - offset;
+            };
+
+            _contig_count = header.contig_count;
+            _haplotype_count = static_cast<size_type>(header.haplotype_count);
+            _contigs = std::make_unique<contig_slot[]>(_contig_count);
+            for (std::size_t contig_idx = 0; contig_idx < _contig_count; ++contig_idx) {
+                multi_contig_entry const & entry = entries[contig_idx];
+                if (!is_inside(entry.name_offset, entry.name_size) ||
+                    !is_inside(entry.layout_offset, entry.layout_size))
+                    throw std::runtime_error{"The multi contig store is truncated."};
+
+                _contigs[contig_idx].name.assign(reinterpret_cast<char const *>(layout.data()) + entry.name_offset,
+                                                 entry.name_size);
+                _contigs[contig_idx].layout = layout.subspan(entry.layout_offset, entry.layout_size);
+            }
+        }
+    };
+}  // namespace libjst
@@ -0,0 +1,111 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::to_rcs_store to convert a coverage augmented multijournal into an rcs_store.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <libjst/coverage/concept.hpp>
+#include <libjst/journal/coverage_augmented_breakpoint_multijournal.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/variant/breakpoint.hpp>
+
+namespace libjst
+{
+    /*!\brief Converts the records of a coverage augmented multijournal into an rcs_store in one pass.
+     *
+     * \tparam cms_t The type of the compressed multisequence of the store.
+     * \tparam source_t The type of the source of the journal and of the store.
+     *
+     * \param[in] journal The journal to convert.
+     * \param[in] row_count The number of rows of the store; every member of a record coverage must be less.
+     *
+     * \returns A store over the source of the journal holding one variant per distinct record.
+     *
+     * \details
+     *
+     * The records of the journal are sorted by their breakpoints, such that the records with the same breakpoint
+     * follow each other. Records with the same breakpoint and sequence, e.g. recorded once per haplotype, are
+     * grouped into one variant covered by the union of their coverages; records neither replacing nor inserting a
+     * symbol are skipped. The variants are bulk inserted by the constructor of the store instead of being added one
+     * by one with libjst::rcs_store::add, which shifts the stored breakends for every variant. The conversion takes
+     * linear time in the size of the journal and its coverages, given that few distinct sequences share a
+     * breakpoint.
+     */
+    template <typename cms_t, typename source_t>
+    rcs_store<source_t, cms_t> to_rcs_store(coverage_augmented_breakpoint_multijournal<source_t> const & journal,
+                                            typename rcs_store<source_t, cms_t>::size_type const row_count)
+    {
+        using store_type = rcs_store<source_t, cms_t>;
+        using value_type = typename store_type::value_type;
+        using size_type = typename store_type::size_type;
+        using sequence_type = typename coverage_augmented_breakpoint_multijournal<source_t>::sequence_type;
+        using coverage_type = std::remove_cvref_t<decltype(libjst::coverage(std::declval<value_type &>()))>;
+        using coverage_domain_type = libjst::coverage_domain_t<coverage_type>;
+
+        // The distinct sequences recorded for the current breakpoint, each with the members of all its records.
+        struct allele {
+            sequence_type sequence;
+            std::vector<size_type> members{};
+        };
+
+        coverage_domain_type const domain{0, row_count};
+        std::vector<value_type> variants{};
+        variants.reserve(journal.size());
+        std::vector<allele> alleles{};
+
+        auto emit_alleles = [&] (std::ptrdiff_t const low, std::ptrdiff_t const high) {
+            for (allele & current : alleles) {
+                std::ranges::sort(current.members);
+                auto duplicates = std::ranges::unique(current.members);
+                current.members.erase(duplicates.begin(), duplicates.end());
+                variants.emplace_back(libjst::breakpoint{static_cast<uint32_t>(low), static_cast<uint32_t>(high - low)},
+                                      source_t{current.sequence.begin(), current.sequence.end()},
+                                      coverage_type{current.members, domain});
+            }
+            alleles.clear();
+        };
+
+        std::ptrdiff_t low{-1};
+        std::ptrdiff_t high{-1};
+        for (auto && record : journal) {
+            std::ptrdiff_t const record_low = libjst::low_breakend(record);
+            std::ptrdiff_t const record_high = libjst::high_breakend(record);
+            sequence_type sequence = record.sequence();
+            if (record_low == record_high && std::ranges::empty(sequence))
+                continue;
+
+            if (record_low != low || record_high != high) {
+                emit_alleles(low, high);
+                low = record_low;
+                high = record_high;
+            }
+
+            auto it = std::ranges::find_if(alleles, [&] (allele const & other) {
+                return std::ranges::equal(other.sequence, sequence);
+            });
+            if (it == alleles.end())
+                it = alleles.insert(it, allele{std::move(sequence)});
+            std::ranges::copy(record.coverage(), std::back_inserter(it->members));
+        }
+        emit_alleles(low, high);
+
+        auto const & source = journal.source();
+        return store_type{source_t{source.begin(), source.end()}, row_count, variants};
+    }
+}  // namespace libjst
@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <bit>
 #include <concepts>
 #include <type_traits>
 
@@ -24,19 +25,38 @@ namespace libjst
         deletion_low = 0b111
     };
 
-    template <typename position_t = uint32_t>
+    /*!\brief A breakend key packing the breakend kind and its position into a single unsigned integer.
+     *
+     * \tparam position_t The unsigned integer type storing the key.
+     *
+     * \details
+     *
+     * The three most significant bits store the breakend code and the remaining bits store the position.
+     * Accordingly, a 32 bit key can address positions up to \f$2^{29}-1\f$ and a 64 bit key positions up to
+     * \f$2^{61}-1\f$.
+     */
+    template <std::unsigned_integral position_t = uint32_t>
     class packed_breakend_key {
     private:
 
+        static constexpr std::size_t code_bits{3};
+        static constexpr std::size_t position_bits{sizeof(position_t) * 8 - code_bits};
+
         static constexpr position_t indel_mask{0b100};
         static constexpr position_t snv_mask{0b011};
 
-        position_t _code : 3;
-        position_t _position : 29;
+        position_t _code : code_bits;
+        position_t _position : position_bits;
     public:
 
         using underlying_type = position_t;
 
+        //!\brief Bulk archived by the libjst::raw_binary_output_archive, as the key occupies a single position_t.
+        static constexpr bool raw_serialisable = true;
+
+        //!\brief The largest position that can be stored in the key.
+        static constexpr underlying_type max_position{static_cast<underlying_type>((underlying_type{1} << position_bits) - 1)};
+
         constexpr packed_breakend_key() noexcept : _code{0}, _position{0}
         {}
 
@@ -52,6 +72,21 @@ namespace libjst
             _position{position}
         {}
 
+        //!\brief Constructs the key from its packed representation as returned by libjst::packed_breakend_key::packed.
+        static constexpr packed_breakend_key from_packed(underlying_type const packed_key) noexcept {
+            packed_breakend_key key{};
+            key._code = packed_key >> position_bits;
+            key._position = packed_key;
+            return key;
+        }
+
+        //!\brief Returns the key as a single integer storing the code in the most significant bits.
+        constexpr underlying_type packed() const noexcept {
+            underlying_type packed_key = static_cast<underlying_type>(_code) << position_bits;
+            packed_key |= _position;
+            return packed_key;
+        }
+
         constexpr bool is_indel() const noexcept {
             return _code & indel_mask;
         }
@@ -93,16 +128,13 @@ namespace libjst
         {
             position_t packed_key{};
             iarchive(packed_key);
-            _code = packed_key >> ((sizeof(position_t) * 8) - 3ull);
-            _position = packed_key;
+            *this = from_packed(packed_key);
         }
 
         template <typename archive_t>
         void save(archive_t & oarchive) const
         {
-            position_t packed_key = _code << ((sizeof(position_t) * 8) - 3ull);
-            packed_key |= _position;
-            oarchive(packed_key);
+            oarchive(packed());
         }
 
 
@@ -141,11 +173,14 @@ namespace libjst
 }  // namespace libjst
 
 namespace std {
-    template <typename position_t>
+    template <std::unsigned_integral position_t>
     struct hash<libjst::packed_breakend_key<position_t>> {
         constexpr std::size_t operator()(libjst::packed_breakend_key<position_t> const & key) const noexcept {
             return static_cast<std::size_t>(key.position()) |
-                    key.visit([&] (auto const & code) { return static_cast<std::size_t>(code) << 29; });
+                    key.visit([&] (auto const & code) {
+                        constexpr int position_bits = std::bit_width(libjst::packed_breakend_key<position_t>::max_position);
+                        return static_cast<std::size_t>(code) << position_bits;
+                    });
         }
     };
 }
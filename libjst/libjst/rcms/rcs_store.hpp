@@ -13,13 +13,38 @@
 #pragma once
 
 #include <algorithm>
+#include <cstddef>
 #include <ranges>
+#include <vector>
 
+#include <libjst/rcms/sample_permutation.hpp>
+#include <libjst/rcms/source_mask.hpp>
+#include <libjst/rcms/store_validation.hpp>
+#include <libjst/utility/memory_usage.hpp>
 #include <libjst/variant/concept.hpp>
 
 namespace libjst
 {
-    // Client needs to make sure that the value types are compatible!?
+    /*!\brief A referentially compressed sequence store over a source sequence and a compressed multisequence.
+     *
+     * \tparam source_sequence_t The type of the source sequence.
+     * \tparam cms_t The type of the compressed multisequence storing the variants.
+     *
+     * \details
+     *
+     * The client needs to make sure that the value types of the source and the variants are compatible.
+     *
+     * ### Thread safety
+     *
+     * A store that is not modified can be read by any number of threads concurrently: all const member functions,
+     * the views over the store, e.g. libjst::haplotype_viewer or libjst::region_viewer, and the trees over the store
+     * only read the store and never build a cache within it. The optional indexes, e.g. the position index or the
+     * variant class index, are built eagerly by the non-const build functions, and the contigs of a
+     * libjst::multi_contig_store are mapped under a std::once_flag. All non-const member functions, including the
+     * build functions, require exclusive access. The views and trees refer to the store and must not outlive it.
+     * The scratch memory of the traversals, e.g. the label buffers and the path coverages, is acquired per thread,
+     * see libjst::acquire_scratch.
+     */
     template <std::ranges::random_access_range source_sequence_t, typename cms_t>
         requires (!std::ranges::range<std::ranges::range_value_t<source_sequence_t>>)
     class rcs_store
@@ -29,6 +54,30 @@ namespace libjst
         using coverage_domain_type = std::remove_cvref_t<decltype(std::declval<cms_t const &>().coverage_domain())>;
 
         cms_t _variant_map{};
+        source_mask _n_run_mask{}; // optional, see build_n_run_mask.
+        source_mask _dirty_regions{}; // the breakend ranges modified since clear_dirty_regions, see mark_dirty.
+
+        struct extract_tag{};
+
+        // Initialises the variant map directly with the extracted variant map, which is not moved.
+        template <typename samples_t>
+        constexpr rcs_store(extract_tag,
+                            cms_t const & variant_map,
+                            samples_t const & samples,
+                            std::size_t const thread_count) :
+            _variant_map(variant_map.extract(samples, thread_count))
+        {}
+
+        struct reorder_tag{};
+
+        // Initialises the variant map directly with the reordered variant map and keeps the mask of the source.
+        constexpr rcs_store(reorder_tag,
+                            rcs_store const & other,
+                            sample_permutation const & permutation,
+                            std::size_t const thread_count) :
+            _variant_map(other._variant_map.reorder_samples(permutation, thread_count)),
+            _n_run_mask{other._n_run_mask}
+        {}
 
     public:
 
@@ -46,6 +95,24 @@ namespace libjst
         constexpr rcs_store(source_sequence_t source, size_type initial_row_count) :
             _variant_map{std::move(source), coverage_domain_type{0, initial_row_count}}
         {}
+
+        //!\brief Constructs the store from a range of variants, which are bulk inserted into the variant map.
+        template <std::ranges::input_range variants_t>
+            requires std::constructible_from<cms_t, source_sequence_t, coverage_domain_type, variants_t>
+        constexpr rcs_store(source_sequence_t source, size_type initial_row_count, variants_t && variants) :
+            _variant_map{std::move(source), coverage_domain_type{0, initial_row_count}, (variants_t &&) variants}
+        {}
+
+        //!\brief Constructs the store by merging the variant maps of shards covering disjoint source intervals.
+        template <std::ranges::input_range shards_t>
+            requires std::same_as<std::remove_cvref_t<std::ranges::range_reference_t<shards_t>>, cms_t> &&
+                     std::constructible_from<cms_t, shards_t>
+        constexpr explicit rcs_store(shards_t && shards) : _variant_map{(shards_t &&) shards}
+        {}
+
+        //!\brief Constructs the store over an existing variant map, e.g. a libjst::mapped_compressed_multisequence.
+        constexpr explicit rcs_store(variant_map_type variant_map) : _variant_map{std::move(variant_map)}
+        {}
         //!\}
 
         // what can we do to add some information
@@ -83,10 +150,174 @@ namespace libjst
             //                                                 return key.first < libjst::position(variant);
             //                                        });
             // mapped_type value{src_position, std::move(variant), std::move(coverage)};
+            mark_dirty(value);
             _variant_map.insert(std::move(value));
             return true;
         }
 
+        /*!\brief Appends new rows, e.g. the haplotypes of new samples, and merges in their variants.
+         *
+         * \param[in] extended_row_count The total number of rows after the extension.
+         * \param[in] variants The variants of the new rows, whose coverages refer to the extended rows.
+         *
+         * \details
+         *
+         * The variant map is extended in a single merge pass over its sorted breakends, see for example
+         * libjst::dna_compressed_multisequence::extend. The breakends of the variants are marked as dirty, see
+         * dirty_regions, which requires a second pass over them; the whole source is marked if the variants can only
+         * be read once.
+         */
+        template <std::ranges::input_range variants_t>
+            requires requires (cms_t & variant_map, coverage_domain_type domain, variants_t && variants) {
+                variant_map.extend(std::move(domain), (variants_t &&) variants);
+            }
+        constexpr void extend(size_type const extended_row_count, variants_t && variants)
+        {
+            if constexpr (std::ranges::forward_range<variants_t>) {
+                std::vector<source_interval> intervals{};
+                for (auto const & value : variants)
+                    intervals.push_back(dirty_interval(value));
+                _dirty_regions.merge(source_mask{std::move(intervals)});
+            } else {
+                _dirty_regions.insert(source_interval{.begin = 0, .end = std::ranges::size(source())});
+            }
+            _variant_map.extend(coverage_domain_type{0, extended_row_count}, (variants_t &&) variants);
+        }
+
+        /*!\brief Returns the source intervals whose breakends were modified since the last clear_dirty_regions.
+         *
+         * \details
+         *
+         * Every variant added by add or extend marks the interval from its low to its high breakend, or the position
+         * of an insertion. Only the windows overlapping a dirty interval can spell other sequences than before the
+         * modification, see libjst::incremental_search, which re-searches only the chunks overlapping these windows.
+         * The overlapping and adjacent intervals are merged as they are marked, such that the regions never hold more
+         * intervals than there are disjoint modified ranges. The dirty regions are not serialised, i.e. a loaded store
+         * is clean.
+         */
+        source_mask const & dirty_regions() const noexcept
+        {
+            return _dirty_regions;
+        }
+
+        //!\brief Marks all regions as clean, e.g. after the results of the store were updated.
+        void clear_dirty_regions() noexcept
+        {
+            _dirty_regions = source_mask{};
+        }
+
+        /*!\brief Returns a new store with the rows of the given samples only.
+         *
+         * \param[in] samples The coverage of the rows to extract.
+         * \param[in] thread_count The number of threads extracting the variants; defaults to 1.
+         *
+         * \details
+         *
+         * The extracted rows are renumbered in their order and variants not covered by any of them are dropped, see
+         * for example libjst::dna_compressed_multisequence::extract.
+         */
+        template <typename samples_t>
+            requires requires (cms_t const & variant_map, samples_t const & samples) {
+                { variant_map.extract(samples, std::size_t{}) } -> std::same_as<cms_t>;
+            }
+        constexpr rcs_store extract(samples_t const & samples, std::size_t const thread_count = 1) const
+        {
+            return rcs_store{extract_tag{}, _variant_map, samples, thread_count};
+        }
+
+        /*!\brief Returns a new store whose coverages store the rows in the order of the given permutation.
+         *
+         * \param[in] permutation The permutation of the rows, e.g. libjst::sample_permutation::by_similarity.
+         * \param[in] thread_count The number of threads reordering the coverages; defaults to 1.
+         *
+         * \details
+         *
+         * The new store reports the rows of the permutation, which are mapped back to the rows of this store with
+         * libjst::sample_permutation::original_sample. See libjst::dna_compressed_multisequence::reorder_samples.
+         */
+        constexpr rcs_store reorder_samples(sample_permutation const & permutation,
+                                            std::size_t const thread_count = 1) const
+            requires requires (cms_t const & variant_map) {
+                { variant_map.reorder_samples(permutation, std::size_t{}) } -> std::same_as<cms_t>;
+            }
+        {
+            return rcs_store{reorder_tag{}, *this, permutation, thread_count};
+        }
+
+        //!\brief Builds the search index of the variant map, see libjst::dna_compressed_multisequence.
+        void build_search_index()
+            requires requires (cms_t & variant_map) { variant_map.build_search_index(); }
+        {
+            _variant_map.build_search_index();
+        }
+
+        //!\brief Builds the position index of the variant map, see libjst::dna_compressed_multisequence.
+        template <typename ...args_t>
+            requires requires (cms_t & variant_map, args_t && ...args) {
+                variant_map.build_position_index((args_t &&) args...);
+            }
+        void build_position_index(args_t && ...args)
+        {
+            _variant_map.build_position_index((args_t &&) args...);
+        }
+
+        //!\brief Builds the variant class index of the variant map, see libjst::dna_compressed_multisequence.
+        void build_variant_class_index()
+            requires requires (cms_t & variant_map) { variant_map.build_variant_class_index(); }
+        {
+            _variant_map.build_variant_class_index();
+        }
+
+        //!\brief Builds the carrier count index of the variant map, see libjst::dna_compressed_multisequence.
+        void build_carrier_count_index()
+            requires requires (cms_t & variant_map) { variant_map.build_carrier_count_index(); }
+        {
+            _variant_map.build_carrier_count_index();
+        }
+
+        /*!\brief Builds the mask of the runs of `N` in the source, see libjst::source_mask::unknown_runs.
+         *
+         * \details
+         *
+         * The runs of `N`, e.g. the gaps and centromeres of an assembly, can not be matched by any pattern without
+         * unknown symbols. A libjst::masked_forest over the mask skips them instead of traversing them. The mask
+         * depends on the source only and is hence kept by the modifications of the variants; it is not serialised.
+         */
+        void build_n_run_mask(std::size_t const min_run_length = source_mask::default_min_run_length)
+            requires requires (source_type const & source) { source_mask::unknown_runs(source); }
+        {
+            _n_run_mask = source_mask::unknown_runs(source(), min_run_length);
+        }
+
+        constexpr bool has_n_run_mask() const noexcept {
+            return !_n_run_mask.empty();
+        }
+
+        //!\brief Returns the mask of the runs of `N`, which is empty unless built with build_n_run_mask.
+        constexpr source_mask const & n_run_mask() const noexcept {
+            return _n_run_mask;
+        }
+
+        //!\brief Advises the kernel to back the arrays of the variant map by huge pages, see libjst::advise_huge_pages.
+        std::size_t advise_huge_pages() const noexcept
+            requires requires (cms_t const & variant_map) { variant_map.advise_huge_pages(); }
+        {
+            return _variant_map.advise_huge_pages();
+        }
+
+        /*!\brief Validates the invariants of the variant map, see libjst::dna_compressed_multisequence::validate.
+         *
+         * \details
+         *
+         * Call it after the store was loaded or built from external input, e.g. as `store.validate(threads)
+         * .throw_if_invalid()`.
+         */
+        store_validation_report validate(std::size_t const thread_count = 1) const
+            requires requires (cms_t const & variant_map) { variant_map.validate(thread_count); }
+        {
+            return _variant_map.validate(thread_count);
+        }
+
         constexpr void reserve(size_type const new_capacity)
         {
             _variant_map.reserve(new_capacity);
@@ -111,6 +342,15 @@ namespace libjst
             return variants().coverage_domain().size();
         }
 
+        //!\brief Returns the memory allocated by the store per component, see libjst::store_memory_usage.
+        auto memory_usage() const noexcept
+            requires requires (cms_t const & variant_map) { variant_map.memory_usage(); }
+        {
+            store_memory_usage usage = variants().memory_usage();
+            usage.source_masks = _n_run_mask.memory_usage() + _dirty_regions.memory_usage();
+            return usage;
+        }
+
         // ----------------------------------------------------------------------------
         // Serialisation
         // ----------------------------------------------------------------------------
@@ -118,6 +358,8 @@ namespace libjst
         template <typename archive_t>
         void load(archive_t & iarchive)
         {
+            _n_run_mask = source_mask{};
+            _dirty_regions = source_mask{};
             iarchive(_variant_map);
         }
 
@@ -126,5 +368,23 @@ namespace libjst
         {
             oarchive(_variant_map);
         }
+
+    private:
+
+        // Returns the interval between the breakends of the variant, or the position of an insertion.
+        template <typename variant_t>
+        static source_interval dirty_interval(variant_t const & value)
+        {
+            std::size_t const low = libjst::low_breakend(value);
+            std::size_t const high = libjst::high_breakend(value);
+            return source_interval{.begin = low, .end = std::max(high, low + 1)};
+        }
+
+        // Marks the interval of the variant and merges it with the overlapping and adjacent dirty regions.
+        template <typename variant_t>
+        void mark_dirty(variant_t const & value)
+        {
+            _dirty_regions.insert(dirty_interval(value));
+        }
     };
 }  // namespace libjst
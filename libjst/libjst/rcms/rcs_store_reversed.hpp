@@ -13,8 +13,16 @@
 #pragma once
 
 #include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <ranges>
+#include <vector>
 
 #include <libjst/rcms/compressed_multisequence_reversed.hpp>
+#include <libjst/rcms/interior_breakends.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/variant/breakpoint.hpp>
+#include <libjst/variant/concept.hpp>
 
 namespace libjst
 {
@@ -64,4 +72,63 @@ namespace libjst
             return variants().coverage_domain().size();
         }
     };
+
+    /*!\brief Returns a store holding the reversed source and the reversed deltas of the given store.
+     *
+     * \param[in] store The forward store.
+     *
+     * \details
+     *
+     * libjst::rcs_store_reversed translates every access to the forward store, i.e. it computes the reversed breakpoints
+     * and walks the source, the breakends and the alternate sequences backwards. The materialised store instead
+     * stores a reversed copy of the source and every delta \f$[l, h)\f$ of the forward store as the delta
+     * \f$[n - h, n - l)\f$ with the reversed alternate sequence and the same coverage, where \f$n\f$ is the size of
+     * the source. Its trees report the same labels as the trees over libjst::rcs_store_reversed, but are traversed at
+     * the speed of a forward store, which pays off for workloads extending many seeds to the left, e.g.
+     * libjst::seed_extend_traverser.
+     *
+     * The materialised store is a snapshot, which does not follow later modifications of the forward store. It
+     * occupies the memory of a second store; the optional indexes and masks of the forward store are not carried
+     * over and can be built on the materialised store.
+     *
+     * ### Complexity
+     *
+     * Linear in the size of the source and the number of deltas, plus sorting the reversed deltas if the forward store
+     * contains deletions overlapping other deltas.
+     */
+    template <typename source_sequence_t, typename cms_t,
+              typename store_t = rcs_store<source_sequence_t, cms_t>>
+        requires std::constructible_from<source_sequence_t,
+                                         std::ranges::iterator_t<std::ranges::reverse_view<typename store_t::source_type>>,
+                                         std::ranges::sentinel_t<std::ranges::reverse_view<typename store_t::source_type>>>
+    store_t materialise_reversed(rcs_store<source_sequence_t, cms_t> const & store)
+    {
+        using value_t = typename store_t::value_type;
+
+        auto const reversed_source = store.source() | std::views::reverse;
+        auto const source_size = std::ranges::size(reversed_source);
+
+        // The deltas are collected by decreasing high breakend, which is the order of their reversed low breakends
+        // unless a deletion overlaps another delta.
+        std::vector<value_t> reversed{};
+        reversed.reserve(std::ranges::size(store.variants()));
+        auto const interior = libjst::interior_breakends(store.variants());
+        for (auto breakend_it = interior.begin(); breakend_it != interior.end(); ++breakend_it) {
+            if ((*breakend_it).get_breakpoint_end() == breakpoint_end::high)
+                continue;
+
+            value_t value = *breakend_it;
+            auto const span = libjst::breakpoint_span(value);
+            auto const low = source_size - libjst::high_breakend(value);
+            libjst::get_breakpoint(value) = breakpoint{static_cast<typename breakpoint::value_type>(low),
+                                                       static_cast<std::size_t>(span)};
+            std::ranges::reverse(libjst::alt_sequence(value));
+            reversed.push_back(std::move(value));
+        }
+        std::ranges::reverse(reversed);
+
+        return store_t{source_sequence_t{std::ranges::begin(reversed_source), std::ranges::end(reversed_source)},
+                       static_cast<typename store_t::size_type>(store.size()),
+                       std::move(reversed)};
+    }
 }  // namespace libjst
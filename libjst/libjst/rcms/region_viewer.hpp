@@ -0,0 +1,182 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides a viewer of the distinct haplotypes within a region of the rcs store.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <libjst/coverage/coverage_members.hpp>
+#include <libjst/rcms/interior_breakends.hpp>
+#include <libjst/variant/concept.hpp>
+
+namespace libjst
+{
+
+    //!\brief A distinct haplotype sequence of a region together with the haplotypes spelling it.
+    template <typename sequence_t, typename coverage_t>
+    struct region_haplotype {
+        sequence_t sequence{}; //!< The sequence of the region.
+        coverage_t coverage{}; //!< The haplotypes spelling the sequence.
+    };
+
+    /*!\brief Extracts the distinct haplotype sequences of source regions from a rcs store.
+     *
+     * \tparam rcs_store_t The type of the rcs store.
+     *
+     * \details
+     *
+     * Instead of materialising the haplotypes over the entire source, the viewer locates the breakends of a region
+     * with a binary search in the breakend map and only visits the variants whose breakpoints may intersect the region.
+     * Deletions beginning in front of the region are found by additionally visiting the breakends within the span of
+     * the longest deletion in front of the region, which is determined once on construction.
+     *
+     * The sequence of a haplotype within the region `[first, last)` consists of the source symbols in `[first, last)`
+     * that are not deleted by a variant of the haplotype, and the alternate sequences of the variants of the haplotype
+     * beginning in `[first, last)`. Variants overlapping a preceding variant of the same haplotype are ignored.
+     */
+    template <typename rcs_store_t>
+    class region_viewer
+    {
+    private:
+
+        using source_type = typename rcs_store_t::source_type;
+        using coverage_type = libjst::variant_coverage_t<typename rcs_store_t::value_type>;
+
+        std::reference_wrapper<rcs_store_t const> _wrappee;
+        std::size_t _max_deletion_size{};
+
+    public:
+
+        using sequence_type = std::vector<std::ranges::range_value_t<source_type>>; //!< The sequence of a region.
+        using value_type = region_haplotype<sequence_type, coverage_type>; //!< A distinct haplotype of a region.
+
+        region_viewer() = delete;
+        explicit region_viewer(rcs_store_t const & wrappee) : _wrappee{wrappee}
+        {
+            std::ranges::for_each(libjst::interior_breakends(base().variants()), [&] (auto && variant) {
+                if (variant.get_breakpoint_end() == breakpoint_end::low)
+                    _max_deletion_size = std::max<std::size_t>(_max_deletion_size,
+                                                               libjst::breakpoint_span(libjst::get_breakpoint(variant)));
+            });
+        }
+
+        constexpr rcs_store_t const & base() const noexcept {
+            return _wrappee.get();
+        }
+
+        //!\brief Returns the span of the longest deletion, which bounds the breakends visited in front of a region.
+        constexpr std::size_t max_deletion_size() const noexcept {
+            return _max_deletion_size;
+        }
+
+        /*!\brief Returns the distinct haplotype sequences of the source region `[first, last)`.
+         *
+         * \param[in] first The begin position of the region in the source.
+         * \param[in] last The end position of the region in the source; clamped to the size of the source.
+         *
+         * \returns The distinct sequences in lexicographical order, each with the coverage of the haplotypes spelling
+         *          it. The coverages partition the haplotypes of the store.
+         *
+         * \details
+         *
+         * Only the haplotypes covered by a variant of the region are copied; all others share the source sequence of
+         * the region. Throws std::out_of_range if `first` is greater than the clamped `last`.
+         */
+        std::vector<value_type> operator()(std::size_t const first, std::size_t last) const {
+            auto const source = base().source();
+            auto const source_begin = std::ranges::begin(source);
+            last = std::min<std::size_t>(last, std::ranges::size(source));
+            if (first > last)
+                throw std::out_of_range{"The region [" + std::to_string(first) + ", " + std::to_string(last) +
+                                        ") is not a valid region of the source."};
+
+            std::size_t const haplotype_count = base().size();
+            std::vector<sequence_type> sequences(haplotype_count);
+            std::vector<std::size_t> source_positions(haplotype_count, first);
+            std::vector<bool> is_modified(haplotype_count, false);
+
+            auto const & variants = base().variants();
+            auto variant_position = [] (auto breakend_proxy) -> std::size_t {
+                return libjst::position(std::move(breakend_proxy));
+            };
+            auto const interior = libjst::interior_breakends(variants);
+            auto variants_last = interior.end();
+            // Uses the lookup of the variant map if it provides one, e.g. libjst::dna_compressed_multisequence.
+            auto find_variant = [&] <typename iterator_t> (iterator_t variants_first, std::size_t const position) {
+                if constexpr (requires { { variants.lower_bound(position) } -> std::same_as<iterator_t>; })
+                    return std::ranges::clamp(variants.lower_bound(position), variants_first, variants_last);
+                else
+                    return std::ranges::lower_bound(variants_first, variants_last, position, std::ranges::less{},
+                                                    variant_position);
+            };
+            auto it = find_variant(interior.begin(), first - std::min(first, _max_deletion_size));
+            auto region_last = find_variant(it, last);
+            for (; it != region_last; ++it) {
+                auto && variant = *it;
+                if (variant.get_breakpoint_end() != breakpoint_end::low)
+                    continue;
+
+                auto const breakpoint = libjst::get_breakpoint(variant);
+                std::size_t const low = libjst::low_breakend(breakpoint);
+                std::size_t const high = libjst::high_breakend(breakpoint);
+                if ((low < first && high <= first) || low >= last) // does not intersect the region
+                    continue;
+
+                auto && alt_sequence = libjst::alt_sequence(variant);
+                libjst::for_each_covered(libjst::coverage(variant), 0, haplotype_count, [&] (std::size_t const idx) {
+                    // A deletion in front of the region only takes effect if it extends the deleted prefix.
+                    std::size_t & source_position = source_positions[idx];
+                    if (low < source_position && (low >= first || high <= source_position))
+                        return;
+
+                    sequence_type & sequence = sequences[idx];
+                    if (low >= first) {
+                        sequence.insert(sequence.end(), source_begin + source_position, source_begin + low);
+                        sequence.insert(sequence.end(), std::ranges::begin(alt_sequence), std::ranges::end(alt_sequence));
+                    }
+                    source_position = std::min(high, last);
+                    is_modified[idx] = true;
+                });
+            }
+
+            // Group the haplotypes by their sequence; the unmodified ones spell the source region.
+            sequence_type const source_region(source_begin + first, source_begin + last);
+            std::map<sequence_type, std::vector<std::size_t>> groups{};
+            for (std::size_t idx = 0; idx < haplotype_count; ++idx) {
+                if (is_modified[idx]) {
+                    sequences[idx].insert(sequences[idx].end(), source_begin + source_positions[idx], source_begin + last);
+                    groups[std::move(sequences[idx])].push_back(idx);
+                } else {
+                    groups[source_region].push_back(idx);
+                }
+            }
+
+            std::vector<value_type> haplotypes{};
+            haplotypes.reserve(groups.size());
+            for (auto & [sequence, ids] : groups)
+                haplotypes.push_back(value_type{sequence, coverage_type{ids, variants.coverage_domain()}});
+            return haplotypes;
+        }
+    };
+
+    template <typename rcs_store_t>
+    region_viewer(rcs_store_t const &) -> region_viewer<rcs_store_t>;
+
+}  // namespace libjst
@@ -0,0 +1,241 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::sample_partitioned_store to split a store into stores over disjoint ranges of its rows.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <ranges>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <libjst/coverage/concept.hpp>
+#include <libjst/coverage/coverage_members.hpp>
+#include <libjst/rcms/interior_breakends.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/utility/parallel_for_each_job.hpp>
+#include <libjst/variant/concept.hpp>
+
+namespace libjst
+{
+    /*!\brief A store split into partition stores over consecutive ranges of its rows, i.e. of its haplotypes.
+     *
+     * \tparam source_t The type of the shared source sequence.
+     * \tparam cms_t The type of the compressed multisequence storing the variants of every partition.
+     *
+     * \details
+     *
+     * The rows of the store are split into `K` consecutive ranges of almost equal size, such that the rows
+     * `[partition_rows(k).min(), partition_rows(k).max())` of the store are the rows `[0, n)` of the partition `k`.
+     * Every partition stores only the variants carried by at least one of its rows, with the coverage restricted to
+     * these rows. The coverages of the partitions are hence `K` times narrower than the coverages of the store, which
+     * dominate the costs of the traversal if a store holds many haplotypes. A partition is a self-contained store over
+     * the same source, which can be searched on its own, e.g. on another node of a cluster, or by search on several
+     * threads. This is the reverse of libjst::federated_store, which merges the stores of cohorts into one store.
+     *
+     * The hits of the partitions refer to their own rows and are combined into hits over the rows of the store by
+     * merge_hits, which joins equal hits found in several partitions. Hits that depend on the tree, e.g. seek
+     * positions, are not comparable between the partitions, as every partition holds other variants; the hits must
+     * be identified by the sequence or the source position instead.
+     */
+    template <std::ranges::random_access_range source_t, typename cms_t>
+    class sample_partitioned_store
+    {
+    private:
+
+        using store_type = rcs_store<source_t, cms_t>;
+        using value_type = typename store_type::value_type;
+        using coverage_type = std::remove_cvref_t<decltype(libjst::coverage(std::declval<value_type &>()))>;
+        using coverage_domain_type = libjst::coverage_domain_t<coverage_type>;
+
+        std::vector<store_type> _partitions{};
+        std::vector<std::size_t> _row_offsets{0}; // the first row of every partition and the total row count.
+
+    public:
+
+        using size_type = typename store_type::size_type;
+
+        //!\brief A hit together with the rows of the store or of a partition it was found in.
+        template <typename hit_t>
+        using covered_hit = std::pair<hit_t, coverage_type>;
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        sample_partitioned_store() = default; //!< Default.
+
+        /*!\brief Splits the rows of the given store into the given number of partitions.
+         *
+         * \param[in] store The store to split; not referenced after the construction.
+         * \param[in] partition_count The number of partitions.
+         *
+         * \throws std::invalid_argument if the partition count is zero or exceeds the number of rows of the store.
+         *
+         * \details
+         *
+         * The store is read in a single pass over its variants, which visits the rows covering every variant.
+         */
+        sample_partitioned_store(store_type const & store, std::size_t const partition_count)
+        {
+            if (partition_count == 0 || partition_count > store.size())
+                throw std::invalid_argument{"The partition count must be between one and the number of rows!"};
+
+            for (std::size_t partition_id = 1; partition_id <= partition_count; ++partition_id)
+                _row_offsets.push_back(partition_id * store.size() / partition_count);
+
+            std::vector<std::vector<value_type>> variants(partition_count);
+            std::vector<std::vector<size_type>> members(partition_count);
+            for (auto && breakend : libjst::interior_breakends(store.variants())) {
+                if (breakend.get_breakpoint_end() == breakpoint_end::high)
+                    continue;
+
+                value_type variant = breakend;
+                std::ranges::for_each(members, [] (std::vector<size_type> & rows) { rows.clear(); });
+                libjst::for_each_covered(libjst::coverage(variant), 0, store.size(), [&] (std::size_t const row) {
+                    std::size_t const partition_id = partition_of(row);
+                    members[partition_id].push_back(static_cast<size_type>(row - _row_offsets[partition_id]));
+                });
+                for (std::size_t partition_id = 0; partition_id < partition_count; ++partition_id) {
+                    if (members[partition_id].empty())
+                        continue;
+
+                    value_type & partition_variant = variants[partition_id].emplace_back(variant);
+                    libjst::coverage(partition_variant) = coverage_type{members[partition_id],
+                                                                        partition_domain(partition_id)};
+                }
+            }
+
+            auto const & source = store.source();
+            _partitions.reserve(partition_count);
+            for (std::size_t partition_id = 0; partition_id < partition_count; ++partition_id) {
+                size_type const row_count = partition_domain(partition_id).size();
+                store_type & partition = _partitions.emplace_back(source_t{source.begin(), source.end()},
+                                                                    row_count);
+                partition.extend(row_count, std::move(variants[partition_id]));
+            }
+        }
+        //!\}
+
+        constexpr std::size_t partition_count() const noexcept {
+            return _partitions.size();
+        }
+
+        //!\brief Returns the store of the given partition.
+        constexpr store_type const & partition(std::size_t const partition_id) const noexcept {
+            assert(partition_id < partition_count());
+            return _partitions[partition_id];
+        }
+
+        //!\brief Returns the number of rows of all partitions, i.e. of the split store.
+        constexpr std::size_t size() const noexcept {
+            return _row_offsets.back();
+        }
+
+        //!\brief Returns the rows of the split store belonging to the given partition.
+        constexpr coverage_domain_type partition_rows(std::size_t const partition_id) const noexcept {
+            assert(partition_id < partition_count());
+            return coverage_domain_type{static_cast<size_type>(_row_offsets[partition_id]),
+                                        static_cast<size_type>(_row_offsets[partition_id + 1])};
+        }
+
+        //!\brief Returns the partition of the given row of the split store.
+        constexpr std::size_t partition_of(std::size_t const row) const noexcept {
+            assert(row < _row_offsets.back());
+            return std::ranges::distance(_row_offsets.begin(), std::ranges::upper_bound(_row_offsets, row)) - 1;
+        }
+
+        /*!\brief Moves a coverage over the rows of a partition to the rows of the split store.
+         *
+         * \param[in] coverage A coverage over the rows of the partition, e.g. the coverage of a node label.
+         * \param[in] partition_id The partition the coverage refers to.
+         */
+        template <typename partition_coverage_t>
+        coverage_type store_coverage(partition_coverage_t const & coverage, std::size_t const partition_id) const {
+            std::size_t const row_offset = _row_offsets[partition_id];
+            std::vector<size_type> members{};
+            libjst::for_each_covered(coverage, 0, partition_rows(partition_id).size(), [&] (std::size_t const row) {
+                members.push_back(static_cast<size_type>(row_offset + row));
+            });
+            return coverage_type{members, coverage_domain_type{0, static_cast<size_type>(size())}};
+        }
+
+        /*!\brief Combines the hits of all partitions into hits over the rows of the split store.
+         *
+         * \param[in] partition_hits The hits of every partition, each with its coverage over the rows of the partition.
+         *
+         * \returns The distinct hits in ascending order, each with the union of the coverages it was found with.
+         *
+         * \details
+         *
+         * The hits may be reported several times by a partition, e.g. once per node of a tree spelling them, and are
+         * joined as well.
+         */
+        template <std::totally_ordered hit_t, typename partition_coverage_t>
+        std::vector<covered_hit<hit_t>>
+        merge_hits(std::vector<std::vector<std::pair<hit_t, partition_coverage_t>>> const & partition_hits) const {
+            if (partition_hits.size() != partition_count())
+                throw std::invalid_argument{"The hits must be given for every partition!"};
+
+            std::vector<covered_hit<hit_t>> hits{};
+            for (std::size_t partition_id = 0; partition_id < partition_hits.size(); ++partition_id)
+                for (auto const & [hit, coverage] : partition_hits[partition_id])
+                    hits.emplace_back(hit, store_coverage(coverage, partition_id));
+
+            std::ranges::stable_sort(hits, std::ranges::less{}, &covered_hit<hit_t>::first);
+            std::vector<covered_hit<hit_t>> merged_hits{};
+            for (covered_hit<hit_t> & hit : hits) {
+                if (!merged_hits.empty() && merged_hits.back().first == hit.first)
+                    merged_hits.back().second = libjst::coverage_union(merged_hits.back().second, hit.second);
+                else
+                    merged_hits.push_back(std::move(hit));
+            }
+            return merged_hits;
+        }
+
+        /*!\brief Searches all partitions in parallel and combines their hits with merge_hits.
+         *
+         * \param[in] search Invoked as `search(partition_id, partition, hits)` with the store of the partition and an
+         *                   empty `std::vector<std::pair<hit_t, coverage_type>> &` to fill with the hits and their
+         *                   coverages over the rows of the partition. Invoked concurrently for different partitions.
+         * \param[in] thread_count The number of threads searching the partitions.
+         *
+         * \details
+         *
+         * Rethrows the first exception thrown by a search after all partitions were searched.
+         */
+        template <std::totally_ordered hit_t, typename search_t>
+            requires std::invocable<search_t &, std::size_t, store_type const &, std::vector<covered_hit<hit_t>> &>
+        std::vector<covered_hit<hit_t>> search(search_t && search,
+                                               std::size_t const thread_count = std::thread::hardware_concurrency())
+            const
+        {
+            std::vector<std::vector<covered_hit<hit_t>>> partition_hits(partition_count());
+            detail::parallel_for_each_job(partition_count(), thread_count, [&] (std::size_t const partition_id) {
+                std::invoke(search, partition_id, partition(partition_id), partition_hits[partition_id]);
+            });
+            return merge_hits(partition_hits);
+        }
+
+    private:
+
+        constexpr coverage_domain_type partition_domain(std::size_t const partition_id) const noexcept {
+            return coverage_domain_type{0, static_cast<size_type>(_row_offsets[partition_id + 1] -
+                                                                 _row_offsets[partition_id])};
+        }
+    };
+}  // namespace libjst
@@ -0,0 +1,189 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::sample_permutation.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <ranges>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <cereal/types/vector.hpp>
+
+#include <libjst/coverage/coverage_members.hpp>
+#include <libjst/variant/concept.hpp>
+
+namespace libjst
+{
+    /*!\brief A permutation of the samples, i.e. the rows of the coverages, of a multisequence.
+     *
+     * \details
+     *
+     * The coverages index the haplotypes in the order of the input, which scatters the carriers of a variant across
+     * the words of its coverage. Reordering the samples such that haplotypes sharing variants are adjacent turns the
+     * carriers into few runs, which compress better, e.g. in a libjst::run_length_coverage_pool, and lets the
+     * intersection tests, see libjst::coverage_intersects, find a shared haplotype or a run of empty words early.
+     * The permutation is applied to all coverages by libjst::rcs_store::reorder_samples; the permuted store reports
+     * rows, which are mapped back to the samples of the input with original_sample. The permutation is not part of
+     * the store and must be serialised alongside it.
+     */
+    class sample_permutation {
+    private:
+
+        std::vector<std::size_t> _original_samples{}; //!< The sample of the input at every row.
+        std::vector<std::size_t> _rows{}; //!< The row of every sample of the input.
+
+    public:
+
+        using size_type = std::size_t;
+
+        //!\brief The default number of variants considered by by_similarity.
+        static constexpr size_type default_signature_size{256};
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        sample_permutation() = default; //!< Default.
+
+        /*!\brief Constructs the permutation from the sample of the input at every row.
+         *
+         * \throws std::invalid_argument if the samples are not a permutation of `[0, n)`.
+         */
+        explicit sample_permutation(std::vector<size_type> original_samples) :
+            _original_samples{std::move(original_samples)},
+            _rows(_original_samples.size(), _original_samples.size())
+        {
+            for (size_type row = 0; row < _original_samples.size(); ++row) {
+                size_type const sample = _original_samples[row];
+                if (sample >= _rows.size() || _rows[sample] != _rows.size())
+                    throw std::invalid_argument{"The samples are not a permutation!"};
+                _rows[sample] = row;
+            }
+        }
+        //!\}
+
+        /*!\brief Orders the samples by the variants they carry, such that the carriers of the common variants are
+         *        adjacent.
+         *
+         * \param[in] variants The variant map, e.g. libjst::dna_compressed_multisequence.
+         * \param[in] signature_size The number of most common variants the samples are sorted by.
+         *
+         * \details
+         *
+         * Every sample gets a signature of the variants it carries among the most common ones, which are ordered by
+         * descending carrier count. The samples are sorted lexicographically by their signatures, such that the
+         * carriers of the most common variant form one run, the carriers of the second one at most two runs, and so
+         * on, which is the common heuristic to reduce the runs of the columns of a bitmap index. Samples with the same
+         * signature keep their input order. The sentinels and the high ends of the deletions are ignored.
+         *
+         * ### Complexity
+         *
+         * Linear in the size of the coverages of all variants plus `O(n log n)` signature comparisons for `n` samples.
+         */
+        template <std::ranges::random_access_range variants_t>
+        static sample_permutation by_similarity(variants_t const & variants,
+                                                size_type const signature_size = default_signature_size) {
+            constexpr size_type word_size = 64;
+
+            auto const & domain = variants.coverage_domain();
+            size_type const sample_count = domain.size();
+            size_type const variant_count = std::ranges::size(variants);
+
+            // The low ends of the variants between the sentinels, ordered by descending carrier count.
+            std::vector<std::pair<size_type, size_type>> common_variants{}; // (carrier count, breakend index)
+            for (size_type idx = 1; idx + 1 < variant_count; ++idx) {
+                auto && breakend = std::ranges::begin(variants)[idx];
+                if (breakend.get_breakpoint_end() != breakpoint_end::low)
+                    continue;
+                auto const & coverage = libjst::coverage(breakend);
+                common_variants.emplace_back(libjst::coverage_intersection_count(coverage, coverage), idx);
+            }
+            size_type const selected_count = std::min(signature_size, common_variants.size());
+            auto by_count = [] (auto const & lhs, auto const & rhs) {
+                return lhs.first > rhs.first || (lhs.first == rhs.first && lhs.second < rhs.second);
+            };
+            std::ranges::partial_sort(common_variants, common_variants.begin() + selected_count, by_count);
+
+            // The signatures are compared word by word; the most common variant is the highest bit of the first word.
+            size_type const signature_words = (selected_count + word_size - 1) / word_size;
+            std::vector<uint64_t> signatures(sample_count * signature_words);
+            for (size_type rank = 0; rank < selected_count; ++rank) {
+                auto && breakend = std::ranges::begin(variants)[common_variants[rank].second];
+                uint64_t const bit = uint64_t{1} << (word_size - 1 - rank % word_size);
+                libjst::for_each_covered(libjst::coverage(breakend), domain.min(), sample_count,
+                                         [&] (size_type const sample) {
+                    signatures[sample * signature_words + rank / word_size] |= bit;
+                });
+            }
+
+            // Carriers come first, such that the run of the most common variant starts at the first word.
+            std::vector<size_type> original_samples(sample_count);
+            std::iota(original_samples.begin(), original_samples.end(), size_type{0});
+            std::ranges::stable_sort(original_samples, [&] (size_type const lhs, size_type const rhs) {
+                auto lhs_words = signatures.begin() + lhs * signature_words;
+                auto rhs_words = signatures.begin() + rhs * signature_words;
+                return std::lexicographical_compare(rhs_words, rhs_words + signature_words,
+                                                    lhs_words, lhs_words + signature_words);
+            });
+            return sample_permutation{std::move(original_samples)};
+        }
+
+        //!\brief Returns the sample of the input stored at the given row.
+        constexpr size_type original_sample(size_type const row) const noexcept {
+            return _original_samples[row];
+        }
+
+        //!\brief Returns the row of the given sample of the input.
+        constexpr size_type row_of(size_type const original_sample) const noexcept {
+            return _rows[original_sample];
+        }
+
+        //!\brief Returns the samples of the input in the order of the rows.
+        constexpr std::vector<size_type> const & original_samples() const noexcept {
+            return _original_samples;
+        }
+
+        constexpr size_type size() const noexcept {
+            return _original_samples.size();
+        }
+
+        constexpr bool empty() const noexcept {
+            return _original_samples.empty();
+        }
+
+        constexpr friend bool operator==(sample_permutation const & lhs, sample_permutation const & rhs) noexcept {
+            return lhs._original_samples == rhs._original_samples;
+        }
+
+        // ----------------------------------------------------------------------------
+        // Serialisation
+        // ----------------------------------------------------------------------------
+
+        template <typename archive_t>
+        void load(archive_t & iarchive)
+        {
+            std::vector<size_type> original_samples{};
+            iarchive(original_samples);
+            *this = sample_permutation{std::move(original_samples)};
+        }
+
+        template <typename archive_t>
+        void save(archive_t & oarchive) const
+        {
+            oarchive(_original_samples);
+        }
+    };
+}  // namespace libjst
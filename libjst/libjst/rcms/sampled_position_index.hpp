@@ -0,0 +1,145 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::sampled_position_index.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ranges>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <libjst/utility/memory_usage.hpp>
+
+namespace libjst
+{
+    /*!\brief A direct address index over the sorted positions of the breakends sampled in blocks of the source.
+     *
+     * \tparam offset_t The unsigned integer type storing the offsets of the breakends.
+     *
+     * \details
+     *
+     * The source is divided into blocks of `sample_distance` positions and the index stores for every block the
+     * offset of the first breakend at or behind the beginning of the block. The lower bound of a position is thus
+     * enclosed by the samples of its block and of the next block, which are found in constant time, and only the
+     * breakends within the block of the position are searched afterwards. The sample distance must be a power of
+     * two, such that the block of a position is computed by a shift.
+     *
+     * The index occupies one offset per block, e.g. one kilobyte for every megabase of source with the default
+     * sample distance of 4096, and is a snapshot of the breakends it was built from.
+     */
+    template <std::unsigned_integral offset_t = uint32_t>
+    class sampled_position_index {
+    private:
+
+        std::vector<offset_t> _samples{}; //!< The offset of the first breakend of every block and the breakend count.
+        std::size_t _sample_shift{};
+
+    public:
+
+        //!\brief The default number of source positions per sample.
+        static constexpr std::size_t default_sample_distance{4096};
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        sampled_position_index() = default; //!< Default.
+
+        /*!\brief Builds the index over the given sorted breakend positions.
+         *
+         * \param[in] sorted_positions The positions of the breakends in sorted order; must not exceed source_size.
+         * \param[in] source_size The size of the source.
+         * \param[in] sample_distance The number of source positions per sample; must be a power of two.
+         *
+         * ### Exception
+         *
+         * Throws std::invalid_argument if the sample distance is not a power of two and std::length_error if the
+         * number of breakends exceeds the range of `offset_t`.
+         *
+         * ### Complexity
+         *
+         * Linear in the number of breakends and the number of blocks.
+         */
+        template <std::ranges::input_range positions_t>
+            requires std::convertible_to<std::ranges::range_reference_t<positions_t>, std::size_t>
+        sampled_position_index(positions_t && sorted_positions,
+                               std::size_t const source_size,
+                               std::size_t const sample_distance = default_sample_distance)
+        {
+            if (!std::has_single_bit(sample_distance))
+                throw std::invalid_argument{"The sample distance of the position index must be a power of two!"};
+
+            _sample_shift = std::countr_zero(sample_distance);
+            std::size_t const block_count = (source_size >> _sample_shift) + 1; // covers the position source_size
+            _samples.reserve(block_count + 1);
+
+            std::size_t offset{};
+            auto position_it = std::ranges::begin(sorted_positions);
+            auto position_end = std::ranges::end(sorted_positions);
+            for (std::size_t block = 0; block < block_count; ++block) {
+                std::size_t const block_begin = block << _sample_shift;
+                for (; position_it != position_end && static_cast<std::size_t>(*position_it) < block_begin;
+                     ++position_it)
+                    ++offset;
+                _samples.push_back(checked_offset(offset));
+            }
+            for (; position_it != position_end; ++position_it)
+                ++offset;
+            _samples.push_back(checked_offset(offset));
+        }
+        //!\}
+
+        /*!\brief Returns the offsets enclosing the lower bound of the given position.
+         *
+         * \param[in] position The source position.
+         *
+         * \returns The pair `[first, last]` of breakend offsets, such that the first breakend at or behind the given
+         *          position lies in `[first, last)`, or is at `last` if no breakend of `[first, last)` qualifies.
+         *
+         * ### Complexity
+         *
+         * Constant.
+         */
+        constexpr std::pair<std::size_t, std::size_t> candidates(std::size_t const position) const noexcept {
+            std::size_t const block = std::min(position >> _sample_shift, _samples.size() - 2);
+            return {_samples[block], _samples[block + 1]};
+        }
+
+        //!\brief Returns the number of source positions per sample.
+        constexpr std::size_t sample_distance() const noexcept {
+            return std::size_t{1} << _sample_shift;
+        }
+
+        //!\brief Returns whether the index was not built.
+        constexpr bool empty() const noexcept {
+            return _samples.empty();
+        }
+
+        //!\brief Returns the number of bytes allocated for the samples.
+        std::size_t memory_usage() const noexcept {
+            return libjst::memory_usage(_samples);
+        }
+
+    private:
+
+        static offset_t checked_offset(std::size_t const offset) {
+            if (offset > std::numeric_limits<offset_t>::max())
+                throw std::length_error{"The number of breakends exceeds the offset type of the position index!"};
+            return static_cast<offset_t>(offset);
+        }
+    };
+}  // namespace libjst
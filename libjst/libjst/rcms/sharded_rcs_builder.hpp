@@ -0,0 +1,138 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides a builder constructing an rcs_store from independently built shards in parallel.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <exception>
+#include <optional>
+#include <ranges>
+#include <thread>
+#include <vector>
+
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/variant/concept.hpp>
+
+namespace libjst
+{
+    /*!\brief Builds an rcs_store by constructing one variant map per source interval in parallel.
+     *
+     * \tparam source_t The type of the source sequence.
+     * \tparam cms_t The type of the compressed multisequence storing the variants.
+     *
+     * \details
+     *
+     * The source is divided into as many intervals of equal size as shards are requested. Every delta is assigned to
+     * the shard whose interval contains its low breakend and every shard is bulk constructed on its own thread.
+     * Afterwards, the shards are merged into a single variant map, replacing the sentinel breakends of each shard by
+     * the sentinels of the entire source. Every shard holds its own copy of the source during the construction, such
+     * that a cheap to copy source type, e.g. a view, is preferable for large sources.
+     * If a shard fails to build, the first exception is rethrown after all threads have joined.
+     */
+    template <std::ranges::random_access_range source_t, typename cms_t>
+    class sharded_rcs_builder
+    {
+    private:
+
+        using store_type = rcs_store<source_t, cms_t>;
+        using value_type = std::ranges::range_value_t<cms_t>;
+        using size_type = typename store_type::size_type;
+        using coverage_domain_type = std::remove_cvref_t<decltype(std::declval<cms_t const &>().coverage_domain())>;
+
+        source_t _source{};
+        size_type _row_count{};
+        std::size_t _shard_count{1};
+
+    public:
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        sharded_rcs_builder() = default; //!< Default.
+
+        /*!\brief Constructs the builder for the given source and number of rows.
+         *
+         * \param[in] source The source sequence.
+         * \param[in] row_count The number of rows, i.e. haplotypes, of the constructed store.
+         * \param[in] shard_count The number of shards built in parallel; defaults to the number of hardware threads.
+         */
+        sharded_rcs_builder(source_t source,
+                            size_type row_count,
+                            std::size_t shard_count = std::thread::hardware_concurrency()) :
+            _source{std::move(source)},
+            _row_count{row_count},
+            _shard_count{std::max<std::size_t>(shard_count, 1)}
+        {}
+        //!\}
+
+        constexpr std::size_t shard_count() const noexcept {
+            return _shard_count;
+        }
+
+        //!\brief Builds the store from the given deltas, which should be sorted by their low breakend within a shard.
+        template <std::ranges::input_range deltas_t>
+            requires std::convertible_to<std::ranges::range_reference_t<deltas_t>, value_type>
+        store_type operator()(deltas_t && deltas) const {
+            std::vector<std::vector<value_type>> buckets = partition((deltas_t &&) deltas);
+            std::vector<std::optional<cms_t>> shards(buckets.size());
+            std::vector<std::exception_ptr> errors(buckets.size());
+            coverage_domain_type domain{0, _row_count};
+
+            auto build_shard = [&] (std::size_t const shard_id) {
+                try {
+                    shards[shard_id].emplace(_source, domain, buckets[shard_id]);
+                } catch (...) {
+                    errors[shard_id] = std::current_exception();
+                }
+            };
+
+            std::vector<std::thread> workers{};
+            workers.reserve(buckets.size() - 1);
+            for (std::size_t shard_id = 1; shard_id < buckets.size(); ++shard_id)
+                workers.emplace_back(build_shard, shard_id);
+
+            build_shard(0); // the calling thread builds the first shard.
+            std::ranges::for_each(workers, [] (std::thread & worker) { worker.join(); });
+
+            if (auto error = std::ranges::find_if(errors, [] (std::exception_ptr const & e) { return e != nullptr; });
+                error != errors.end())
+                std::rethrow_exception(*error);
+
+            return store_type{shards | std::views::transform([] (std::optional<cms_t> const & shard) -> cms_t const & {
+                return *shard;
+            })};
+        }
+
+    private:
+
+        template <typename deltas_t>
+        std::vector<std::vector<value_type>> partition(deltas_t && deltas) const {
+            std::size_t const source_size = std::ranges::size(_source);
+            std::size_t const interval_size = std::max<std::size_t>((source_size + _shard_count - 1) / _shard_count, 1);
+
+            std::vector<std::vector<value_type>> buckets(_shard_count);
+            if constexpr (std::ranges::sized_range<deltas_t>) {
+                std::ranges::for_each(buckets, [&] (auto & bucket) {
+                    bucket.reserve(std::ranges::size(deltas) / _shard_count);
+                });
+            }
+
+            for (auto && delta : deltas) {
+                value_type value = (decltype(delta) &&) delta;
+                std::size_t const shard_id = std::min<std::size_t>(libjst::low_breakend(value) / interval_size,
+                                                                   _shard_count - 1);
+                buckets[shard_id].push_back(std::move(value));
+            }
+            return buckets;
+        }
+    };
+}  // namespace libjst
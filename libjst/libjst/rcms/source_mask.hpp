@@ -0,0 +1,215 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::source_mask.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <ranges>
+#include <vector>
+
+#include <libjst/utility/memory_usage.hpp>
+
+namespace libjst
+{
+    //!\brief A half open interval `[begin, end)` of source positions.
+    struct source_interval {
+        std::size_t begin{};
+        std::size_t end{};
+
+        constexpr std::size_t size() const noexcept {
+            return end - begin;
+        }
+
+        constexpr friend bool operator==(source_interval const &, source_interval const &) noexcept = default;
+    };
+
+    /*!\brief A set of masked source intervals, e.g. the runs of `N` or the intervals masked by the user.
+     *
+     * \details
+     *
+     * The intervals are kept sorted, and overlapping or adjacent intervals are merged, such that the mask is a sorted
+     * list of disjoint intervals separated by at least one unmasked position. The complement of the mask within a
+     * source, i.e. the intervals that are still searched, is returned by unmasked, see libjst::masked_forest.
+     */
+    class source_mask {
+    private:
+
+        std::vector<source_interval> _intervals{};
+
+    public:
+
+        using size_type = std::size_t;
+
+        //!\brief The default minimal length of a run of unknown symbols that is masked.
+        static constexpr size_type default_min_run_length{64};
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        source_mask() = default; //!< Default.
+
+        //!\brief Constructs the mask from the given intervals, which may be unsorted, overlapping or empty.
+        explicit source_mask(std::vector<source_interval> intervals) : _intervals{std::move(intervals)}
+        {
+            normalise();
+        }
+        //!\}
+
+        /*!\brief Masks the runs of unknown symbols, i.e. `N` and `n`, of the given source.
+         *
+         * \param[in] source The source sequence.
+         * \param[in] min_run_length The minimal length of a masked run; shorter runs are cheaper to traverse than to
+         *                           break the source at their boundaries.
+         *
+         * ### Complexity
+         *
+         * Linear in the size of the source.
+         */
+        template <std::ranges::random_access_range source_t>
+            requires std::equality_comparable_with<std::ranges::range_value_t<source_t>, char>
+        static source_mask unknown_runs(source_t const & source,
+                                        size_type const min_run_length = default_min_run_length) {
+            auto is_unknown = [] (auto const & symbol) { return symbol == 'N' || symbol == 'n'; };
+
+            source_mask mask{};
+            auto first = std::ranges::begin(source);
+            auto last = std::ranges::end(source);
+            for (auto run_begin = std::ranges::find_if(first, last, is_unknown); run_begin != last;) {
+                auto run_end = std::ranges::find_if_not(run_begin, last, is_unknown);
+                if (static_cast<size_type>(run_end - run_begin) >= std::max<size_type>(min_run_length, 1))
+                    mask._intervals.push_back(source_interval{.begin = static_cast<size_type>(run_begin - first),
+                                                              .end = static_cast<size_type>(run_end - first)});
+                run_begin = std::ranges::find_if(run_end, last, is_unknown);
+            }
+            return mask;
+        }
+
+        /*!\brief Adds a single interval and merges it with the overlapping and adjacent intervals.
+         *
+         * ### Complexity
+         *
+         * Logarithmic in the number of intervals to find the position, plus linear to shift the intervals behind it.
+         */
+        source_mask & insert(source_interval const interval) {
+            if (interval.begin >= interval.end)
+                return *this;
+
+            // The first interval ending at or behind the begin and the first interval beginning behind the end.
+            auto first = std::ranges::lower_bound(_intervals, interval.begin, std::ranges::less{},
+                                                  &source_interval::end);
+            auto last = std::ranges::upper_bound(first, _intervals.end(), interval.end, std::ranges::less{},
+                                                 &source_interval::begin);
+            if (first == last) {
+                _intervals.insert(first, interval);
+            } else {
+                first->begin = std::min(first->begin, interval.begin);
+                first->end = std::max(std::ranges::prev(last)->end, interval.end);
+                _intervals.erase(std::ranges::next(first), last);
+            }
+            return *this;
+        }
+
+        //!\brief Adds the intervals of the other mask, e.g. the intervals masked by the user to the runs of `N`.
+        source_mask & merge(source_mask const & other) {
+            _intervals.insert(_intervals.end(), other._intervals.begin(), other._intervals.end());
+            normalise();
+            return *this;
+        }
+
+        /*!\brief Returns the unmasked intervals of a source with the given size.
+         *
+         * \param[in] source_size The size of the source; masked intervals beyond it are ignored.
+         * \param[in] max_interval_size The unmasked intervals are split into intervals of at most this size, e.g. to
+         *                              balance the trees of a libjst::masked_forest across threads.
+         */
+        std::vector<source_interval> unmasked(size_type const source_size,
+                                              size_type const max_interval_size =
+                                                    std::numeric_limits<size_type>::max()) const {
+            std::vector<source_interval> intervals{};
+            size_type const split_size = std::max<size_type>(max_interval_size, 1);
+            auto append = [&] (size_type begin, size_type const end) {
+                for (; end - begin > split_size; begin += split_size)
+                    intervals.push_back(source_interval{.begin = begin, .end = begin + split_size});
+                if (begin < end)
+                    intervals.push_back(source_interval{.begin = begin, .end = end});
+            };
+
+            size_type unmasked_begin{0};
+            for (source_interval const & masked : _intervals) {
+                if (masked.begin >= source_size)
+                    break;
+                append(unmasked_begin, masked.begin);
+                unmasked_begin = std::min(masked.end, source_size);
+            }
+            append(unmasked_begin, source_size);
+            return intervals;
+        }
+
+        //!\brief Returns the number of masked source positions.
+        size_type masked_size() const noexcept {
+            return std::accumulate(_intervals.begin(), _intervals.end(), size_type{0},
+                                   [] (size_type const sum, source_interval const & interval) {
+                                       return sum + interval.size();
+                                   });
+        }
+
+        //!\brief Returns whether the given source position is masked.
+        bool contains(size_type const position) const noexcept {
+            auto it = std::ranges::upper_bound(_intervals, position, std::ranges::less{}, &source_interval::begin);
+            return it != _intervals.begin() && position < std::ranges::prev(it)->end;
+        }
+
+        auto begin() const noexcept {
+            return _intervals.begin();
+        }
+
+        auto end() const noexcept {
+            return _intervals.end();
+        }
+
+        size_type size() const noexcept {
+            return _intervals.size();
+        }
+
+        bool empty() const noexcept {
+            return _intervals.empty();
+        }
+
+        //!\brief Returns the memory allocated by the intervals.
+        size_type memory_usage() const noexcept {
+            return libjst::memory_usage(_intervals);
+        }
+
+        friend bool operator==(source_mask const &, source_mask const &) noexcept = default;
+
+    private:
+
+        // Sorts the intervals, drops the empty ones and merges the overlapping and adjacent ones.
+        void normalise() {
+            std::erase_if(_intervals, [] (source_interval const & interval) { return interval.begin >= interval.end; });
+            std::ranges::sort(_intervals, std::ranges::less{}, &source_interval::begin);
+
+            auto merged_end = _intervals.begin();
+            for (auto it = _intervals.begin(); it != _intervals.end(); ++it) {
+                if (merged_end != _intervals.begin() && it->begin <= std::ranges::prev(merged_end)->end)
+                    std::ranges::prev(merged_end)->end = std::max(std::ranges::prev(merged_end)->end, it->end);
+                else
+                    *merged_end++ = *it;
+            }
+            _intervals.erase(merged_end, _intervals.end());
+        }
+    };
+}  // namespace libjst
@@ -0,0 +1,242 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::diff and libjst::patch to compare two stores over the same source.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+#include <vector>
+
+#include <cereal/types/vector.hpp>
+
+#include <libjst/coverage/concept.hpp>
+#include <libjst/rcms/interior_breakends.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/variant/concept.hpp>
+
+namespace libjst
+{
+    /*!\brief The difference between two stores over the same source, see libjst::diff.
+     *
+     * \tparam value_t The type of the deltas, i.e. the value type of the stores.
+     *
+     * \details
+     *
+     * A delta is identified by its breakpoint and its alternate sequence. The delta lists the deltas only stored in
+     * the second store, the deltas only stored in the first store and the deltas of both stores whose coverage
+     * differs, which carry the coverage of the second store. All lists are sorted by libjst::delta_order.
+     */
+    template <typename value_t>
+    struct store_delta {
+        std::vector<value_t> added{}; //!< The deltas only stored in the second store.
+        std::vector<value_t> removed{}; //!< The deltas only stored in the first store.
+        std::vector<value_t> changed{}; //!< The deltas of both stores with the coverage of the second store.
+
+        //!\brief Returns whether both stores hold the same deltas with the same coverages.
+        constexpr bool empty() const noexcept {
+            return added.empty() && removed.empty() && changed.empty();
+        }
+
+        template <typename archive_t>
+        void serialize(archive_t & archive)
+        {
+            archive(added, removed, changed);
+        }
+    };
+
+    //!\brief Orders deltas by their low breakend, their breakpoint span and their alternate sequence.
+    struct delta_order {
+        template <typename value_t>
+        constexpr bool operator()(value_t const & lhs, value_t const & rhs) const {
+            if (libjst::low_breakend(lhs) != libjst::low_breakend(rhs))
+                return libjst::low_breakend(lhs) < libjst::low_breakend(rhs);
+            if (libjst::breakpoint_span(lhs) != libjst::breakpoint_span(rhs))
+                return libjst::breakpoint_span(lhs) < libjst::breakpoint_span(rhs);
+            return std::ranges::lexicographical_compare(libjst::alt_sequence(lhs), libjst::alt_sequence(rhs));
+        }
+    };
+
+    namespace detail
+    {
+        // Collects the deltas of the next position from the breakends into the group sorted by libjst::delta_order.
+        // The high breakends are skipped, such that every delta is visited once at its low breakend.
+        template <typename value_t, typename iterator_t>
+        iterator_t next_delta_group(iterator_t breakend_it, iterator_t const breakend_end, std::vector<value_t> & group)
+        {
+            group.clear();
+            for (; breakend_it != breakend_end; ++breakend_it) {
+                if ((*breakend_it).get_breakpoint_end() == breakpoint_end::high)
+                    continue;
+                if (!group.empty() && libjst::position(*breakend_it) != libjst::low_breakend(group.front()))
+                    break;
+                group.push_back(*breakend_it);
+            }
+            if (!std::ranges::is_sorted(group, delta_order{}))
+                std::ranges::sort(group, delta_order{});
+            return breakend_it;
+        }
+
+        // Merge-joins the deltas of both variant maps position by position and invokes the function with the delta
+        // of the first and of the second map, either of which is null if the delta is not stored in that map.
+        template <typename value_t, typename lhs_variants_t, typename rhs_variants_t, typename fn_t>
+        void join_deltas(lhs_variants_t const & lhs_variants, rhs_variants_t const & rhs_variants, fn_t && fn)
+        {
+            auto const lhs_interior = libjst::interior_breakends(lhs_variants);
+            auto const rhs_interior = libjst::interior_breakends(rhs_variants);
+            auto lhs_it = lhs_interior.begin();
+            auto rhs_it = rhs_interior.begin();
+            std::vector<value_t> lhs_group{};
+            std::vector<value_t> rhs_group{};
+            std::size_t lhs_idx{};
+            std::size_t rhs_idx{};
+            delta_order const less{};
+
+            while (true) {
+                if (lhs_idx == lhs_group.size()) {
+                    lhs_it = next_delta_group(lhs_it, lhs_interior.end(), lhs_group);
+                    lhs_idx = 0;
+                }
+                if (rhs_idx == rhs_group.size()) {
+                    rhs_it = next_delta_group(rhs_it, rhs_interior.end(), rhs_group);
+                    rhs_idx = 0;
+                }
+                if (lhs_group.empty() && rhs_group.empty())
+                    break;
+
+                if (rhs_group.empty() || (!lhs_group.empty() && less(lhs_group[lhs_idx], rhs_group[rhs_idx]))) {
+                    fn(&lhs_group[lhs_idx++], nullptr);
+                } else if (lhs_group.empty() || less(rhs_group[rhs_idx], lhs_group[lhs_idx])) {
+                    fn(nullptr, &rhs_group[rhs_idx++]);
+                } else {
+                    fn(&lhs_group[lhs_idx++], &rhs_group[rhs_idx++]);
+                }
+            }
+        }
+    } // namespace detail
+
+    /*!\brief Returns the difference between two stores over the same source.
+     *
+     * \param[in] lhs The first store, e.g. the previous release of a cohort.
+     * \param[in] rhs The second store, which is restored by applying the returned delta to the first store.
+     *
+     * \details
+     *
+     * The breakends of both stores are sorted by their position, such that their deltas are merge-joined in a single
+     * pass over both stores; only the few deltas sharing a position are sorted by libjst::delta_order. The coverages
+     * of the deltas stored in both stores are compared as a whole, i.e. word by word for libjst::bit_coverage.
+     *
+     * ### Exception
+     *
+     * Throws std::invalid_argument if the sources of the stores differ and std::domain_error if their coverage
+     * domains differ. To compare stores with a different number of haplotypes, the domain of the smaller store must be
+     * extended first, see libjst::rcs_store::extend.
+     *
+     * ### Complexity
+     *
+     * Linear in the size of the source and the number of stored deltas and the sizes of their coverages.
+     */
+    template <typename store_t>
+    store_delta<typename store_t::value_type> diff(store_t const & lhs, store_t const & rhs)
+    {
+        using value_t = typename store_t::value_type;
+
+        if (!std::ranges::equal(lhs.source(), rhs.source()))
+            throw std::invalid_argument{"The stores must have the same source!"};
+        if (lhs.variants().coverage_domain() != rhs.variants().coverage_domain())
+            throw std::domain_error{"The stores must have the same coverage domain!"};
+
+        store_delta<value_t> delta{};
+        detail::join_deltas<value_t>(lhs.variants(), rhs.variants(), [&] (value_t * lhs_delta, value_t * rhs_delta) {
+            if (rhs_delta == nullptr)
+                delta.removed.push_back(std::move(*lhs_delta));
+            else if (lhs_delta == nullptr)
+                delta.added.push_back(std::move(*rhs_delta));
+            else if (!(libjst::coverage(*lhs_delta) == libjst::coverage(*rhs_delta)))
+                delta.changed.push_back(std::move(*rhs_delta));
+        });
+        return delta;
+    }
+
+    /*!\brief Returns the store obtained by applying the delta to the given store.
+     *
+     * \param[in] store The store the delta was computed from, i.e. the first store of libjst::diff.
+     * \param[in] delta The delta to apply.
+     *
+     * \details
+     *
+     * The deltas of the store are merged with the delta in a single pass and the variant map of the returned store is
+     * built once from the merged deltas, as in the bulk construction, over a copy of the source. The optional indexes
+     * and masks of the store are not carried over. A removed or changed delta that is not stored is ignored, and an
+     * added delta that is stored already is kept once with the added coverage, such that applying a delta twice has
+     * no further effect.
+     *
+     * ### Exception
+     *
+     * Throws std::domain_error if the coverage domain of a delta differs from the coverage domain of the store.
+     */
+    template <typename source_sequence_t, typename cms_t,
+              typename store_t = rcs_store<source_sequence_t, cms_t>,
+              typename value_t = typename store_t::value_type>
+        requires std::constructible_from<source_sequence_t,
+                                         std::ranges::iterator_t<typename store_t::source_type const>,
+                                         std::ranges::sentinel_t<typename store_t::source_type const>>
+    store_t patch(rcs_store<source_sequence_t, cms_t> const & store, store_delta<value_t> const & delta)
+    {
+        auto const & domain = store.variants().coverage_domain();
+        auto has_other_domain = [&] (value_t const & value) {
+            return libjst::get_domain(libjst::coverage(value)) != domain;
+        };
+        if (std::ranges::any_of(delta.added, has_other_domain) || std::ranges::any_of(delta.changed, has_other_domain))
+            throw std::domain_error{"Trying to apply a delta from a different coverage domain!"};
+
+        delta_order const less{};
+        auto removed_it = delta.removed.begin();
+        auto changed_it = delta.changed.begin();
+        auto added_it = delta.added.begin();
+        // Advances the iterator behind all entries ordered before the value and returns whether it is at the value.
+        auto seek = [&] (auto & it, auto const end, value_t const & value) {
+            for (; it != end && less(*it, value); ++it)
+            {}
+            return it != end && !less(value, *it);
+        };
+
+        std::vector<value_t> patched{};
+        patched.reserve(std::ranges::size(store.variants()) + delta.added.size());
+        auto const interior = libjst::interior_breakends(store.variants());
+        std::vector<value_t> group{};
+        for (auto breakend_it = interior.begin(); breakend_it != interior.end();) {
+            breakend_it = detail::next_delta_group(breakend_it, interior.end(), group);
+            for (value_t & value : group) {
+                for (; added_it != delta.added.end() && less(*added_it, value); ++added_it)
+                    patched.push_back(*added_it);
+                if (added_it != delta.added.end() && !less(value, *added_it)) { // stored already
+                    patched.push_back(*added_it++);
+                    continue;
+                }
+                if (seek(removed_it, delta.removed.end(), value))
+                    continue;
+                if (seek(changed_it, delta.changed.end(), value))
+                    libjst::coverage(value) = libjst::coverage(*changed_it);
+                patched.push_back(std::move(value));
+            }
+        }
+        std::ranges::copy(added_it, delta.added.end(), std::back_inserter(patched));
+
+        auto const & source = store.source();
+        return store_t{source_sequence_t{std::ranges::begin(source), std::ranges::end(source)},
+                       static_cast<typename store_t::size_type>(store.size()),
+                       std::move(patched)};
+    }
+}  // namespace libjst
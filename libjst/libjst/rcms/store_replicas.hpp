@@ -0,0 +1,109 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::store_replicas to keep a copy of a store in the memory of every NUMA node.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <libjst/utility/numa_topology.hpp>
+
+namespace libjst
+{
+    /*!\brief One read-only copy of a store per NUMA node.
+     *
+     * \tparam store_t The type of the store, e.g. libjst::rcs_store; must be copy constructible.
+     *
+     * \details
+     *
+     * Every replica is copied by a thread bound to the CPUs of its node. Under the default first touch policy of the
+     * operating system, the pages of a replica are hence allocated in the memory of its node. A
+     * libjst::replicated_chunked_tree over the replicas lets the workers of a libjst::parallel_chunk_traverser traverse
+     * the replica of the node they are bound to, such that no worker reads the store from the memory of another node.
+     *
+     * The replicas occupy the memory of the store once per node. A store mapping a file, e.g. one over a
+     * libjst::mapped_compressed_multisequence, shares the page cache between its copies and must be loaded into memory
+     * to be replicated. If the platform does not support thread affinities, the replicas are plain copies.
+     */
+    template <std::copy_constructible store_t>
+    class store_replicas {
+    private:
+
+        numa_topology _topology{};
+        std::vector<std::unique_ptr<store_t const>> _replicas{};
+
+    public:
+
+        using store_type = store_t;
+        using size_type = std::size_t;
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        store_replicas() = default; //!< Default.
+
+        /*!\brief Copies the store into the memory of every node of the topology.
+         *
+         * \param[in] store The store to replicate.
+         * \param[in] topology The nodes to replicate the store on; defaults to the nodes of the running machine.
+         *
+         * \details
+         *
+         * The replicas are copied concurrently. If a copy throws, the first exception is rethrown after all copies
+         * have finished.
+         */
+        explicit store_replicas(store_t const & store, numa_topology topology = numa_topology::system()) :
+            _topology{std::move(topology)},
+            _replicas(_topology.node_count())
+        {
+            std::vector<std::exception_ptr> errors(_topology.node_count());
+            std::vector<std::thread> copy_threads{};
+            copy_threads.reserve(_topology.node_count());
+            for (size_type node = 0; node < _topology.node_count(); ++node) {
+                copy_threads.emplace_back([&, node] () {
+                    try {
+                        numa_binding const binding = _topology.bind_current_thread(node);
+                        _replicas[node] = std::make_unique<store_t const>(store);
+                    } catch (...) {
+                        errors[node] = std::current_exception();
+                    }
+                });
+            }
+            std::ranges::for_each(copy_threads, [] (std::thread & copy_thread) { copy_thread.join(); });
+
+            for (std::exception_ptr const & error : errors)
+                if (error)
+                    std::rethrow_exception(error);
+        }
+        //!\}
+
+        //!\brief Returns the replica in the memory of the given node.
+        store_t const & operator[](size_type const node) const noexcept {
+            assert(node < size());
+            return *_replicas[node];
+        }
+
+        constexpr size_type size() const noexcept {
+            return _replicas.size();
+        }
+
+        constexpr numa_topology const & topology() const noexcept {
+            return _topology;
+        }
+    };
+}  // namespace libjst
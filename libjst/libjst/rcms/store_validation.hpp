@@ -0,0 +1,84 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::store_validation_report listing the violated invariants of a rcs store.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace libjst
+{
+    //!\brief The invariants of a rcs store checked by the validation of its variant map.
+    enum class store_invariant {
+        sentinels, //!< The breakends begin and end with the sentinels at the begin and the end of the source.
+        breakend_order, //!< The breakends are sorted and within the source.
+        coverage_domain, //!< Every coverage has the coverage domain of the store.
+        indel_entry, //!< Every indel breakend has a matching entry in the indel map and vice versa.
+        deletion_mate, //!< The breakends of a deletion refer to each other and have the same coverage.
+        alt_sequence, //!< Every inserted sequence lies within the pool of alternate sequences.
+        haplotype_conflict //!< No haplotype carries two variants beginning at the same position or overlapping.
+    };
+
+    //!\brief Returns the name of the invariant.
+    constexpr std::string_view to_string(store_invariant const invariant) noexcept {
+        switch (invariant) {
+            case store_invariant::sentinels: return "sentinels";
+            case store_invariant::breakend_order: return "breakend order";
+            case store_invariant::coverage_domain: return "coverage domain";
+            case store_invariant::indel_entry: return "indel entry";
+            case store_invariant::deletion_mate: return "deletion mate";
+            case store_invariant::alt_sequence: return "alternate sequence";
+            default: return "haplotype conflict";
+        }
+    }
+
+    //!\brief A violated invariant found at a breakend of the variant map.
+    struct store_violation {
+        store_invariant invariant{}; //!< The violated invariant.
+        std::size_t breakend_index{}; //!< The index of the breakend in the breakend map.
+        std::string message{}; //!< Describes the violation.
+    };
+
+    /*!\brief The violations found by the validation of a rcs store, ordered by their breakend index.
+     *
+     * \details
+     *
+     * A corrupted store may violate an invariant at every breakend. The report hence keeps at most
+     * libjst::store_validation_report::max_violations violations and flags whether more were found.
+     */
+    struct store_validation_report {
+        //!\brief The maximal number of violations kept by the report.
+        static constexpr std::size_t max_violations{100};
+
+        std::vector<store_violation> violations{}; //!< The first violations found.
+        bool truncated{false}; //!< Whether more violations were found than kept.
+
+        //!\brief Returns whether the store satisfies all invariants.
+        constexpr bool valid() const noexcept {
+            return violations.empty();
+        }
+
+        //!\brief Throws std::runtime_error describing the first violation if the store is not valid.
+        void throw_if_invalid() const {
+            if (valid())
+                return;
+
+            store_violation const & first = violations.front();
+            throw std::runtime_error{"Invalid store: the " + std::string{to_string(first.invariant)} +
+                                     " invariant is violated at breakend " + std::to_string(first.breakend_index) +
+                                     ": " + first.message};
+        }
+    };
+}  // namespace libjst
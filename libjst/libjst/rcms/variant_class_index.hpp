@@ -0,0 +1,166 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::variant_class_index.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <vector>
+
+#include <libjst/rcms/packed_breakend_key.hpp>
+#include <libjst/utility/memory_usage.hpp>
+
+namespace libjst
+{
+    /*!\brief Bitmaps storing the class of every breakend of a multisequence.
+     *
+     * \details
+     *
+     * For every breakend the index stores one bit marking it as a SNV, one marking it as the low end of an indel, i.e.
+     * of an insertion or a deletion, and one marking it as the high end of a deletion. The nil breakends belong to
+     * none of the classes. The class of a breakend is thus tested with a single bit lookup instead of decoding its key,
+     * and runs of consecutive SNVs, which make up the majority of most stores, are found a word at a time with
+     * libjst::variant_class_index::snv_run_length.
+     *
+     * The index occupies three bits per breakend and is a snapshot of the breakends it was built from.
+     */
+    class variant_class_index {
+    private:
+
+        using word_type = uint64_t;
+        static constexpr std::size_t word_size{sizeof(word_type) * 8};
+
+        std::vector<word_type> _is_snv{};
+        std::vector<word_type> _is_indel_low{};
+        std::vector<word_type> _is_indel_high{};
+        std::size_t _size{};
+
+    public:
+
+        using size_type = std::size_t;
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        variant_class_index() = default; //!< Default.
+
+        /*!\brief Builds the index over the keys of the breakends.
+         *
+         * \param[in] breakend_keys The keys of the breakends, e.g. libjst::packed_breakend_key, in the stored order.
+         *
+         * ### Complexity
+         *
+         * Linear in the number of breakends.
+         */
+        template <std::ranges::input_range breakend_keys_t>
+            requires requires (std::ranges::range_reference_t<breakend_keys_t> key) {
+                { key.is_indel() } -> std::convertible_to<bool>;
+                { key.indel_kind() } -> std::same_as<indel_breakend_kind>;
+            }
+        explicit variant_class_index(breakend_keys_t && breakend_keys)
+        {
+            if constexpr (std::ranges::sized_range<breakend_keys_t>) {
+                size_type const word_count = (std::ranges::size(breakend_keys) + word_size - 1) / word_size;
+                _is_snv.reserve(word_count);
+                _is_indel_low.reserve(word_count);
+                _is_indel_high.reserve(word_count);
+            }
+
+            for (auto && key : breakend_keys) {
+                if (_size % word_size == 0) {
+                    _is_snv.push_back(0);
+                    _is_indel_low.push_back(0);
+                    _is_indel_high.push_back(0);
+                }
+
+                word_type const bit = word_type{1} << (_size % word_size);
+                if (!key.is_indel()) {
+                    _is_snv.back() |= bit;
+                } else {
+                    switch (key.indel_kind()) {
+                        case indel_breakend_kind::insertion_low: [[fallthrough]];
+                        case indel_breakend_kind::deletion_low: _is_indel_low.back() |= bit; break;
+                        case indel_breakend_kind::deletion_high: _is_indel_high.back() |= bit; break;
+                        default: /*nil*/;
+                    }
+                }
+                ++_size;
+            }
+        }
+        //!\}
+
+        constexpr bool is_snv(size_type const position) const noexcept {
+            return test(_is_snv, position);
+        }
+
+        constexpr bool is_indel_low(size_type const position) const noexcept {
+            return test(_is_indel_low, position);
+        }
+
+        constexpr bool is_indel_high(size_type const position) const noexcept {
+            return test(_is_indel_high, position);
+        }
+
+        /*!\brief Returns the number of consecutive SNV breakends beginning at the given breakend.
+         *
+         * \param[in] position The position of the first breakend of the run.
+         *
+         * \details
+         *
+         * Scans the SNV bitmap a word at a time and returns 0 if the given breakend is not a SNV or lies behind the
+         * last breakend.
+         */
+        constexpr size_type snv_run_length(size_type const position) const noexcept {
+            if (position >= _size)
+                return 0;
+
+            size_type word_position = position / word_size;
+            size_type const offset = position % word_size;
+            size_type run_length = std::countr_one(_is_snv[word_position] >> offset);
+            if (run_length < word_size - offset)
+                return run_length;
+
+            // The run reaches the end of the first word; the unused bits of the last word are never set.
+            for (++word_position; word_position < _is_snv.size(); ++word_position) {
+                size_type const word_run = std::countr_one(_is_snv[word_position]);
+                run_length += word_run;
+                if (word_run < word_size)
+                    break;
+            }
+            return run_length;
+        }
+
+        constexpr size_type size() const noexcept {
+            return _size;
+        }
+
+        constexpr bool empty() const noexcept {
+            return _size == 0;
+        }
+
+        //!\brief Returns the number of bytes allocated for the bitmaps.
+        size_type memory_usage() const noexcept {
+            return libjst::memory_usage(_is_snv) + libjst::memory_usage(_is_indel_low) +
+                   libjst::memory_usage(_is_indel_high);
+        }
+
+    private:
+
+        static constexpr bool test(std::vector<word_type> const & bitmap, size_type const position) noexcept {
+            return (bitmap[position / word_size] >> (position % word_size)) & 1;
+        }
+    };
+}  // namespace libjst
@@ -0,0 +1,477 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides a streaming importer building an rcs_store from the records of a VCF file.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <istream>
+#include <iterator>
+#include <map>
+#include <mutex>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/utility/generator.hpp>
+#include <libjst/variant/breakpoint.hpp>
+#include <libjst/variant/concept.hpp>
+
+namespace libjst
+{
+    //!\brief The options of the libjst::vcf_importer.
+    struct vcf_import_options {
+        std::size_t chunk_size{4096}; //!< The number of records parsed together.
+        std::size_t thread_count{std::thread::hardware_concurrency()}; //!< The number of threads parsing the chunks.
+        std::size_t max_pending_chunks{0}; //!< The number of chunks read ahead; zero selects twice the thread count.
+        std::size_t ploidy{2}; //!< The number of haplotypes per sample.
+        std::string contig{}; //!< The contig to import; empty selects the contig of the first record.
+        bool check_reference{true}; //!< Whether the reference alleles must match the source.
+    };
+
+    /*!\brief Builds an rcs_store from the records of a VCF file while streaming through it.
+     *
+     * \tparam source_t The type of the source sequence, which must own its characters as it is also the type of the
+     *                  alternate sequences.
+     * \tparam cms_t The type of the compressed multisequence storing the variants.
+     *
+     * \details
+     *
+     * The records are read in chunks of libjst::vcf_import_options::chunk_size lines on a separate thread and the
+     * chunks are parsed on libjst::vcf_import_options::thread_count threads, which convert the genotype column of
+     * every sample directly into the coverages of the alternate alleles. The parsed chunks are fed in the order of the
+     * file into the bulk construction of the multisequence. At most libjst::vcf_import_options::max_pending_chunks
+     * chunks are read but not yet consumed, such that the memory spent on the records is bounded independent of the
+     * size of the file.
+     *
+     * Every haplotype of a sample, in the order of the samples, is a row of the store. The alleles are normalised by
+     * removing the prefix and the suffix they share with the reference allele, such that the padding base of indels
+     * is dropped. As the multisequence stores SNVs, insertions and deletions, a substitution of several bases is
+     * split into SNVs and any other complex allele into a deletion and an insertion. Missing alleles and absent
+     * haplotypes, e.g. haploid calls, are treated as reference. Symbolic alleles, breakends and records of other
+     * contigs are skipped. Only text VCF is supported; compressed files must be decompressed into the stream.
+     *
+     * Throws std::runtime_error, naming the line, if the header is missing, a record is malformed, the genotype
+     * field is not the first format field or a reference allele does not match the source.
+     */
+    template <std::ranges::random_access_range source_t, typename cms_t>
+    class vcf_importer
+    {
+    private:
+
+        using store_type = rcs_store<source_t, cms_t>;
+        using value_type = std::ranges::range_value_t<cms_t>;
+        using size_type = typename store_type::size_type;
+        using coverage_domain_type = std::remove_cvref_t<decltype(std::declval<cms_t const &>().coverage_domain())>;
+        using coverage_type = std::remove_cvref_t<decltype(libjst::coverage(std::declval<value_type const &>()))>;
+
+        //!\brief The records of a chunk and their line numbers.
+        struct chunk {
+            std::size_t id{};
+            std::vector<std::string> lines{};
+            std::vector<std::size_t> line_numbers{};
+        };
+
+        class pipeline;
+
+        source_t _source{};
+        vcf_import_options _options{};
+
+    public:
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        vcf_importer() = default; //!< Default.
+
+        //!\brief Constructs the importer for the given source and options.
+        explicit vcf_importer(source_t source, vcf_import_options options = {}) :
+            _source{std::move(source)},
+            _options{std::move(options)}
+        {
+            _options.chunk_size = std::max<std::size_t>(_options.chunk_size, 1);
+            _options.thread_count = std::max<std::size_t>(_options.thread_count, 1);
+            _options.ploidy = std::max<std::size_t>(_options.ploidy, 1);
+            if (_options.max_pending_chunks == 0)
+                _options.max_pending_chunks = 2 * _options.thread_count;
+        }
+        //!\}
+
+        constexpr vcf_import_options const & options() const noexcept {
+            return _options;
+        }
+
+        //!\brief Imports the records of the VCF stream.
+        store_type operator()(std::istream & vcf) const {
+            std::size_t line_number{};
+            std::string line{};
+            std::size_t const sample_count = read_header(vcf, line, line_number);
+            size_type const row_count = static_cast<size_type>(sample_count * _options.ploidy);
+
+            if (!next_record(vcf, line, line_number))
+                return store_type{_source, row_count};
+
+            std::string contig = _options.contig;
+            if (contig.empty())
+                contig = line.substr(0, line.find('\t'));
+
+            pipeline records{*this, sample_count, std::move(contig)};
+            records.start(vcf, std::move(line), line_number);
+            return store_type{_source, row_count, records.deltas()};
+        }
+
+    private:
+
+        [[noreturn]] static void fail(std::size_t const line_number, std::string const & message) {
+            throw std::runtime_error{"Invalid VCF record in line " + std::to_string(line_number) + ": " + message};
+        }
+
+        // Reads the header lines and returns the number of samples of the #CHROM line.
+        static std::size_t read_header(std::istream & vcf, std::string & line, std::size_t & line_number) {
+            while (std::getline(vcf, line)) {
+                ++line_number;
+                if (line.starts_with("##"))
+                    continue;
+                if (!line.starts_with("#CHROM"))
+                    break;
+
+                std::size_t const column_count = std::ranges::count(line, '\t') + 1;
+                return (column_count > 9) ? column_count - 9 : 0;
+            }
+            throw std::runtime_error{"The VCF stream does not contain a #CHROM header line."};
+        }
+
+        // Reads the next non-empty line.
+        static bool next_record(std::istream & vcf, std::string & line, std::size_t & line_number) {
+            while (std::getline(vcf, line)) {
+                ++line_number;
+                if (!line.empty() && line.back() == '\r')
+                    line.pop_back();
+                if (!line.empty())
+                    return true;
+            }
+            return false;
+        }
+
+        static bool is_symbolic(std::string_view const allele) noexcept {
+            return allele.empty() || allele == "*" || allele == "." || allele.front() == '<' ||
+                   allele.find_first_of("[]") != std::string_view::npos;
+        }
+
+        static bool equal_base(char const lhs, char const rhs) noexcept {
+            return std::toupper(static_cast<unsigned char>(lhs)) == std::toupper(static_cast<unsigned char>(rhs));
+        }
+
+        // Parses one record and appends a delta for every alternate allele carried by at least one haplotype.
+        void parse_record(std::string_view const record,
+                          std::size_t const line_number,
+                          std::size_t const sample_count,
+                          std::string_view const contig,
+                          std::vector<std::string_view> & fields,
+                          std::vector<std::vector<uint32_t>> & carriers,
+                          std::vector<value_type> & deltas) const {
+            fields.clear();
+            for (std::size_t first = 0; first <= record.size();) {
+                std::size_t const last = std::min(record.find('\t', first), record.size());
+                fields.push_back(record.substr(first, last - first));
+                first = last + 1;
+            }
+
+            if (fields.size() < 8)
+                fail(line_number, "expected at least 8 columns.");
+            if (fields[0] != contig)
+                return;
+
+            std::size_t position{};
+            if (auto [ptr, error] = std::from_chars(fields[1].data(), fields[1].data() + fields[1].size(), position);
+                error != std::errc{} || ptr != fields[1].data() + fields[1].size() || position == 0)
+                fail(line_number, "invalid position '" + std::string{fields[1]} + "'.");
+            --position;
+
+            std::string_view const ref = fields[3];
+            if (_options.check_reference) {
+                std::size_t const source_size = std::ranges::size(_source);
+                if (position > source_size || ref.size() > source_size - position ||
+                    !std::ranges::equal(ref, std::ranges::subrange{std::ranges::next(std::ranges::begin(_source),
+                                                                                     position),
+                                                                   std::ranges::next(std::ranges::begin(_source),
+                                                                                     position + ref.size())},
+                                        equal_base))
+                    fail(line_number, "the reference allele does not match the source.");
+            }
+
+            std::vector<std::string_view> alts{};
+            for (std::size_t first = 0; first <= fields[4].size();) {
+                std::size_t const last = std::min(fields[4].find(',', first), fields[4].size());
+                alts.push_back(fields[4].substr(first, last - first));
+                first = last + 1;
+            }
+
+            if (sample_count == 0)
+                return;
+            if (fields.size() != 9 + sample_count)
+                fail(line_number, "expected " + std::to_string(9 + sample_count) + " columns.");
+            if (fields[8] != "GT" && !fields[8].starts_with("GT:"))
+                fail(line_number, "the genotype must be the first format field.");
+
+            carriers.resize(std::max(carriers.size(), alts.size()));
+            std::ranges::for_each(carriers, [] (std::vector<uint32_t> & haplotypes) { haplotypes.clear(); });
+            for (std::size_t sample = 0; sample < sample_count; ++sample) {
+                std::string_view genotype = fields[9 + sample];
+                genotype = genotype.substr(0, genotype.find(':'));
+                std::size_t haplotype{};
+                for (std::size_t first = 0; first <= genotype.size(); ++haplotype) {
+                    std::size_t const last = std::min(genotype.find_first_of("|/", first), genotype.size());
+                    std::string_view const allele = genotype.substr(first, last - first);
+                    first = last + 1;
+                    if (haplotype == _options.ploidy)
+                        fail(line_number, "the genotype has more than " + std::to_string(_options.ploidy) +
+                                          " alleles.");
+                    if (allele == ".")
+                        continue;
+
+                    std::size_t allele_index{};
+                    if (auto [ptr, error] = std::from_chars(allele.data(), allele.data() + allele.size(), allele_index);
+                        error != std::errc{} || ptr != allele.data() + allele.size() || allele_index > alts.size())
+                        fail(line_number, "invalid allele '" + std::string{allele} + "'.");
+                    if (allele_index > 0)
+                        carriers[allele_index - 1].push_back(static_cast<uint32_t>(sample * _options.ploidy +
+                                                                                   haplotype));
+                }
+            }
+
+            coverage_domain_type const domain{0, static_cast<size_type>(sample_count * _options.ploidy)};
+            for (std::size_t alt_id = 0; alt_id < alts.size(); ++alt_id) {
+                std::string_view alt = alts[alt_id];
+                if (carriers[alt_id].empty() || is_symbolic(alt))
+                    continue;
+
+                std::string_view deleted = ref;
+                std::size_t prefix{};
+                while (prefix < deleted.size() && prefix < alt.size() && equal_base(deleted[prefix], alt[prefix]))
+                    ++prefix;
+                deleted.remove_prefix(prefix);
+                alt.remove_prefix(prefix);
+                while (!deleted.empty() && !alt.empty() && equal_base(deleted.back(), alt.back())) {
+                    deleted.remove_suffix(1);
+                    alt.remove_suffix(1);
+                }
+                if (deleted.empty() && alt.empty())
+                    continue;
+
+                std::size_t const low = position + prefix;
+                auto add_delta = [&] (std::size_t const delta_low, std::size_t const span, std::string_view bases) {
+                    source_t alt_sequence{};
+                    std::ranges::transform(bases, std::back_inserter(alt_sequence), [] (char const base) {
+                        return static_cast<char>(std::toupper(static_cast<unsigned char>(base)));
+                    });
+                    using breakend_type = typename breakpoint::value_type;
+                    deltas.emplace_back(breakpoint{static_cast<breakend_type>(delta_low),
+                                                   static_cast<breakend_type>(span)},
+                                        std::move(alt_sequence),
+                                        coverage_type{carriers[alt_id], domain});
+                };
+
+                if (deleted.size() == alt.size()) { // one SNV per substituted base
+                    for (std::size_t offset = 0; offset < alt.size(); ++offset)
+                        if (!equal_base(deleted[offset], alt[offset]))
+                            add_delta(low + offset, 1, alt.substr(offset, 1));
+                } else if (!deleted.empty() && !alt.empty()) { // a deletion followed by an insertion
+                    add_delta(low, deleted.size(), {});
+                    add_delta(low, 0, alt);
+                } else {
+                    add_delta(low, deleted.size(), alt);
+                }
+            }
+        }
+    };
+
+    // Reads the chunks on one thread, parses them on the worker threads and hands them over in order.
+    template <std::ranges::random_access_range source_t, typename cms_t>
+    class vcf_importer<source_t, cms_t>::pipeline {
+    private:
+
+        vcf_importer const & _importer;
+        std::size_t _sample_count{};
+        std::string _contig{};
+
+        std::mutex _mutex{};
+        std::condition_variable _condition{};
+        std::deque<chunk> _read_chunks{};
+        std::map<std::size_t, std::vector<value_type>> _parsed_chunks{};
+        std::size_t _pending_count{}; // read but not yet consumed
+        std::size_t _chunk_count{};
+        bool _input_done{};
+        bool _stopped{};
+        std::exception_ptr _error{};
+
+        std::thread _reader{};
+        std::vector<std::thread> _workers{};
+
+    public:
+
+        pipeline(vcf_importer const & importer, std::size_t const sample_count, std::string contig) :
+            _importer{importer},
+            _sample_count{sample_count},
+            _contig{std::move(contig)}
+        {}
+
+        pipeline(pipeline const &) = delete;
+        pipeline & operator=(pipeline const &) = delete;
+
+        //!\brief Stops the threads, e.g. if the construction of the store failed.
+        ~pipeline() {
+            {
+                std::scoped_lock lock{_mutex};
+                _stopped = true;
+            }
+            _condition.notify_all();
+            if (_reader.joinable())
+                _reader.join();
+            std::ranges::for_each(_workers, [] (std::thread & worker) { worker.join(); });
+        }
+
+        void start(std::istream & vcf, std::string first_record, std::size_t const line_number) {
+            _reader = std::thread{[this, &vcf, first_record = std::move(first_record), line_number] () mutable {
+                guarded([&] () { read_chunks(vcf, std::move(first_record), line_number); });
+                std::scoped_lock lock{_mutex};
+                _input_done = true;
+                _condition.notify_all();
+            }};
+
+            for (std::size_t worker = 0; worker < _importer._options.thread_count; ++worker)
+                _workers.emplace_back([this] () { guarded([&] () { parse_chunks(); }); });
+        }
+
+        //!\brief Yields the deltas of the parsed chunks in the order of the file.
+        generator<value_type> deltas() {
+            for (std::size_t chunk_id = 0;; ++chunk_id) {
+                std::vector<value_type> chunk_deltas{};
+                {
+                    std::unique_lock lock{_mutex};
+                    _condition.wait(lock, [&] () {
+                        return _error || _parsed_chunks.contains(chunk_id) || (_input_done && chunk_id == _chunk_count);
+                    });
+                    if (_error)
+                        std::rethrow_exception(_error);
+                    if (!_parsed_chunks.contains(chunk_id))
+                        co_return;
+
+                    auto parsed = _parsed_chunks.extract(chunk_id);
+                    chunk_deltas = std::move(parsed.mapped());
+                    --_pending_count;
+                }
+                _condition.notify_all();
+
+                for (value_type const & delta : chunk_deltas)
+                    co_yield delta;
+            }
+        }
+
+    private:
+
+        // Records the first error and stops the other threads.
+        template <typename fn_t>
+        void guarded(fn_t && fn) {
+            try {
+                fn();
+            } catch (...) {
+                std::scoped_lock lock{_mutex};
+                if (!_error)
+                    _error = std::current_exception();
+                _stopped = true;
+                _condition.notify_all();
+            }
+        }
+
+        void read_chunks(std::istream & vcf, std::string first_record, std::size_t line_number) {
+            std::size_t const chunk_size = _importer._options.chunk_size;
+            chunk current{};
+            auto add_record = [&] (std::string record) {
+                if (current.lines.empty()) {
+                    current.lines.reserve(chunk_size);
+                    current.line_numbers.reserve(chunk_size);
+                }
+                current.lines.push_back(std::move(record));
+                current.line_numbers.push_back(line_number);
+            };
+            add_record(std::move(first_record));
+
+            auto hand_over = [&] () {
+                std::unique_lock lock{_mutex};
+                _condition.wait(lock, [&] () {
+                    return _stopped || _pending_count < _importer._options.max_pending_chunks;
+                });
+                if (_stopped)
+                    return false;
+
+                current.id = _chunk_count++;
+                ++_pending_count;
+                _read_chunks.push_back(std::move(current));
+                _condition.notify_all();
+                return true;
+            };
+
+            std::string line{};
+            while (next_record(vcf, line, line_number)) {
+                if (current.lines.size() == chunk_size) {
+                    if (!hand_over())
+                        return;
+                    current = chunk{};
+                }
+                add_record(std::move(line));
+            }
+            if (vcf.bad())
+                throw std::runtime_error{"Could not read the VCF stream."};
+            hand_over();
+        }
+
+        void parse_chunks() {
+            std::vector<std::string_view> fields{};
+            std::vector<std::vector<uint32_t>> carriers{};
+            while (true) {
+                chunk current{};
+                {
+                    std::unique_lock lock{_mutex};
+                    _condition.wait(lock, [&] () { return _stopped || _input_done || !_read_chunks.empty(); });
+                    if (_stopped || _read_chunks.empty())
+                        return;
+
+                    current = std::move(_read_chunks.front());
+                    _read_chunks.pop_front();
+                }
+
+                std::vector<value_type> chunk_deltas{};
+                for (std::size_t record = 0; record < current.lines.size(); ++record)
+                    _importer.parse_record(current.lines[record], current.line_numbers[record], _sample_count,
+                                           _contig, fields, carriers, chunk_deltas);
+
+                {
+                    std::scoped_lock lock{_mutex};
+                    _parsed_chunks.emplace(current.id, std::move(chunk_deltas));
+                }
+                _condition.notify_all();
+            }
+        }
+    };
+}  // namespace libjst
@@ -0,0 +1,174 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::versioned_store to update a store while readers traverse a stable snapshot.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cassert>
+#include <concepts>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace libjst
+{
+    /*!\brief A version of a store pinned by a reader, see libjst::versioned_store::snapshot.
+     *
+     * \tparam store_t The type of the store.
+     *
+     * \details
+     *
+     * The snapshot shares the ownership of its version, which is released with the last snapshot referring to it
+     * after a newer version was published. The trees and views over the store of a snapshot remain valid as long as
+     * the snapshot is alive.
+     */
+    template <typename store_t>
+    class store_snapshot {
+    private:
+
+        template <std::copy_constructible>
+        friend class versioned_store;
+
+        struct version {
+            store_t store;
+            uint64_t epoch;
+        };
+
+        std::shared_ptr<version const> _version{};
+
+        explicit store_snapshot(std::shared_ptr<version const> pinned) noexcept : _version{std::move(pinned)}
+        {}
+
+    public:
+
+        using store_type = store_t;
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        store_snapshot() = default; //!< Default.
+        //!\}
+
+        //!\brief Returns the pinned store.
+        store_t const & operator*() const noexcept {
+            assert(_version != nullptr);
+            return _version->store;
+        }
+
+        store_t const * operator->() const noexcept {
+            assert(_version != nullptr);
+            return std::addressof(_version->store);
+        }
+
+        //!\brief Returns the epoch of the pinned version, which increases with every published version.
+        uint64_t epoch() const noexcept {
+            assert(_version != nullptr);
+            return _version->epoch;
+        }
+
+        //!\brief Returns whether the snapshot pins a version.
+        explicit operator bool() const noexcept {
+            return _version != nullptr;
+        }
+    };
+
+    /*!\brief Publishes new versions of a store atomically while the readers traverse the versions they pinned.
+     *
+     * \tparam store_t The type of the store, e.g. libjst::rcs_store; must be copy constructible.
+     *
+     * \details
+     *
+     * A store is modified in place by its non-const member functions, which invalidates the breakend iterators of the
+     * nodes of every tree over it. The versioned store never modifies a published version. Instead, a writer applies
+     * its update to a copy of the latest version and publishes the updated copy atomically under the next epoch. A
+     * reader pins the latest version by libjst::versioned_store::snapshot and traverses it undisturbed by later
+     * updates; a version is reclaimed when the last snapshot pinning it is released, such that an in-flight traversal
+     * never observes a partial update and queries need not be stopped to apply one.
+     *
+     * Taking a snapshot never waits for an update in progress and costs an atomic load of the latest version and a
+     * reference count increment. The writers are serialised, such that no update is lost. The memory of the store is
+     * occupied by every version that is still pinned, plus once more during an update.
+     */
+    template <std::copy_constructible store_t>
+    class versioned_store {
+    private:
+
+        using version_type = typename store_snapshot<store_t>::version;
+
+        std::atomic<std::shared_ptr<version_type const>> _latest{};
+        std::mutex _writer_mutex{};
+
+    public:
+
+        using store_type = store_t;
+        using snapshot_type = store_snapshot<store_t>;
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        //!\brief Publishes the given store as the version of epoch 0.
+        explicit versioned_store(store_t store) :
+            _latest{std::make_shared<version_type const>(version_type{std::move(store), 0})}
+        {}
+
+        versioned_store(versioned_store const &) = delete; //!< Deleted.
+        versioned_store & operator=(versioned_store const &) = delete; //!< Deleted.
+        //!\}
+
+        //!\brief Pins the latest published version.
+        snapshot_type snapshot() const noexcept {
+            return snapshot_type{_latest.load(std::memory_order_acquire)};
+        }
+
+        //!\brief Returns the epoch of the latest published version.
+        uint64_t epoch() const noexcept {
+            return _latest.load(std::memory_order_acquire)->epoch;
+        }
+
+        /*!\brief Applies the update to a copy of the latest version and publishes the copy under the next epoch.
+         *
+         * \param[in] update Invoked with a reference to the copied store, e.g. to add variants or to extend the rows.
+         *
+         * \returns The snapshot of the published version.
+         *
+         * \details
+         *
+         * The readers keep traversing the version they pinned while the update is applied. If the update throws, no
+         * version is published and the exception is propagated.
+         */
+        template <typename update_t>
+            requires std::invocable<update_t &, store_t &>
+        snapshot_type update(update_t && update) {
+            std::scoped_lock lock{_writer_mutex};
+            std::shared_ptr<version_type const> current = _latest.load(std::memory_order_acquire);
+            store_t updated{current->store};
+            std::invoke(update, updated);
+            return publish_locked(std::move(updated), current->epoch + 1);
+        }
+
+        //!\brief Publishes the given store as the next version, e.g. a store rebuilt by libjst::patch.
+        snapshot_type publish(store_t store) {
+            std::scoped_lock lock{_writer_mutex};
+            return publish_locked(std::move(store), _latest.load(std::memory_order_acquire)->epoch + 1);
+        }
+
+    private:
+
+        snapshot_type publish_locked(store_t && store, uint64_t const epoch) {
+            auto published = std::make_shared<version_type const>(version_type{std::move(store), epoch});
+            _latest.store(published, std::memory_order_release);
+            return snapshot_type{std::move(published)};
+        }
+    };
+}  // namespace libjst
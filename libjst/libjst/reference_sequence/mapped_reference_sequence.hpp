@@ -0,0 +1,243 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides a reference sequence read in place from a memory mapped file.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <unistd.h>
+
+#include <libjst/utility/mapped_file.hpp>
+
+namespace libjst
+{
+    //!\brief A record of a FASTA index, i.e. a line of a `.fai` file as written by `samtools faidx`.
+    struct fasta_index_record {
+        std::string name{}; //!< The name of the sequence.
+        std::size_t length{}; //!< The number of symbols of the sequence.
+        std::size_t offset{}; //!< The byte offset of the first symbol in the FASTA file.
+        std::size_t line_bases{}; //!< The number of symbols per line.
+        std::size_t line_width{}; //!< The number of bytes per line including the line break.
+    };
+
+    /*!\brief Reads the record of the sequence with the given name from a FASTA index.
+     *
+     * \details
+     *
+     * Throws std::runtime_error if the index can not be read, is malformed or does not contain the sequence.
+     */
+    inline fasta_index_record read_fasta_index(std::filesystem::path const & index_path, std::string_view const name)
+    {
+        std::ifstream index{index_path};
+        if (!index)
+            throw std::runtime_error{"Could not open the FASTA index " + index_path.string()};
+
+        std::string line{};
+        while (std::getline(index, line)) {
+            std::istringstream fields{line};
+            fasta_index_record record{};
+            if (!std::getline(fields, record.name, '\t'))
+                continue;
+            if (record.name != name)
+                continue;
+
+            if (!(fields >> record.length >> record.offset >> record.line_bases >> record.line_width) ||
+                (record.length > record.line_bases && record.line_bases == 0) ||
+                record.line_width < record.line_bases)
+                throw std::runtime_error{"The FASTA index record of " + record.name + " is malformed."};
+            return record;
+        }
+        throw std::runtime_error{"The FASTA index " + index_path.string() + " has no sequence " + std::string{name}};
+    }
+
+    /*!\brief Writes the symbols of a FASTA record without the line breaks to the given file.
+     *
+     * \details
+     *
+     * The file is written under a temporary name and renamed afterwards, such that concurrent processes packing the
+     * same record never map a partially written file.
+     * Throws std::system_error if the FASTA file can not be mapped and std::runtime_error if it is shorter than the
+     * record or the packed file can not be written.
+     */
+    inline void pack_fasta_record(std::filesystem::path const & fasta_path,
+                                  fasta_index_record const & record,
+                                  std::filesystem::path const & packed_path)
+    {
+        mapped_file const fasta{fasta_path};
+        if (std::size_t const last = record.length - 1;
+            record.length > 0 && fasta.size() <= record.offset + last / record.line_bases * record.line_width +
+                                                 last % record.line_bases)
+            throw std::runtime_error{"The FASTA file " + fasta_path.string() + " is shorter than its index."};
+
+        std::filesystem::path temporary_path{packed_path};
+        temporary_path += ".tmp" + std::to_string(::getpid());
+        {
+            std::ofstream packed{temporary_path, std::ios::binary | std::ios::trunc};
+            char const * const symbols = reinterpret_cast<char const *>(fasta.bytes().data());
+            for (std::size_t position = 0; position < record.length; position += record.line_bases) {
+                std::size_t const line = position / record.line_bases;
+                packed.write(symbols + record.offset + line * record.line_width,
+                             std::min(record.line_bases, record.length - position));
+            }
+            if (!packed.flush())
+                throw std::runtime_error{"Could not write the packed sequence " + temporary_path.string()};
+        }
+        std::filesystem::rename(temporary_path, packed_path);
+    }
+
+    /*!\brief A reference sequence of characters read in place from a memory mapped file.
+     *
+     * \details
+     *
+     * The symbols are not copied but accessed in the shared mapping of the file, such that all processes using the
+     * same reference share the pages of the page cache and opening a reference takes constant time. Copies share the
+     * mapping, which is released with the last copy. The sequence is a contiguous range of `char const`, such that it
+     * models libjst::preserving_reference_sequence and can be used directly as the source of a
+     * libjst::dna_compressed_multisequence or a libjst::journaled_sequence, whose slices are `std::span<char const>`.
+     *
+     * A FASTA record can only be read in place if it is stored in a single line. The records with line breaks are
+     * packed once into a raw file without line breaks, see libjst::mapped_reference_sequence::from_fasta, which is
+     * reused by later calls.
+     */
+    class mapped_reference_sequence {
+    private:
+
+        std::shared_ptr<mapped_file const> _file{};
+        char const * _data{};
+        std::size_t _size{};
+
+    public:
+
+        using value_type = char;
+        using reference = char const &;
+        using const_reference = char const &;
+        using iterator = char const *;
+        using const_iterator = char const *;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        mapped_reference_sequence() = default; //!< Default.
+
+        /*!\brief Maps the given file, whose bytes are the symbols of the sequence.
+         *
+         * \details
+         *
+         * If huge_pages is true, the kernel is advised to back the mapping by huge pages, see libjst::mapped_file.
+         * Throws std::system_error if the file can not be mapped.
+         */
+        explicit mapped_reference_sequence(std::filesystem::path const & path, bool const huge_pages = false) :
+            mapped_reference_sequence{std::make_shared<mapped_file const>(path, huge_pages)}
+        {}
+
+        //!\brief Uses all bytes of the given mapped file, which is kept alive by the sequence.
+        explicit mapped_reference_sequence(std::shared_ptr<mapped_file const> file) :
+            mapped_reference_sequence{file, 0, file->size()}
+        {}
+
+        /*!\brief Uses the given bytes of the mapped file, which is kept alive by the sequence.
+         *
+         * \details
+         *
+         * Throws std::out_of_range if the bytes exceed the file.
+         */
+        mapped_reference_sequence(std::shared_ptr<mapped_file const> file,
+                                  std::size_t const offset,
+                                  std::size_t const size) :
+            _size{size}
+        {
+            if (offset > file->size() || size > file->size() - offset)
+                throw std::out_of_range{"The mapped sequence exceeds the mapped file."};
+            _data = reinterpret_cast<char const *>(file->bytes().data()) + offset;
+            _file = std::move(file);
+        }
+        //!\}
+
+        /*!\brief Opens the sequence with the given name from a FASTA file with a `.fai` index.
+         *
+         * \param[in] fasta_path The path of the FASTA file, whose index is expected at `fasta_path.fai`.
+         * \param[in] name The name of the sequence in the index.
+         * \param[in] packed_path The path of the raw file the sequence is packed into if it has line breaks.
+         * \param[in] huge_pages Whether to advise the kernel to back the mapping by huge pages; defaults to false.
+         *
+         * \details
+         *
+         * A sequence in a single line is read in place from the FASTA file. Otherwise, the sequence is packed into
+         * the given raw file, unless a file of the length of the sequence exists already, and the raw file is mapped.
+         * Throws std::runtime_error if the index has no such sequence or the FASTA file does not match its index,
+         * and std::system_error if a file can not be mapped.
+         */
+        static mapped_reference_sequence from_fasta(std::filesystem::path const & fasta_path,
+                                                    std::string_view const name,
+                                                    std::filesystem::path const & packed_path,
+                                                    bool const huge_pages = false)
+        {
+            std::filesystem::path index_path{fasta_path};
+            index_path += ".fai";
+            fasta_index_record const record = read_fasta_index(index_path, name);
+
+            if (record.length <= record.line_bases) {
+                auto fasta = std::make_shared<mapped_file const>(fasta_path, huge_pages);
+                if (record.offset > fasta->size() || record.length > fasta->size() - record.offset)
+                    throw std::runtime_error{"The FASTA file " + fasta_path.string() + " is shorter than its index."};
+                return mapped_reference_sequence{std::move(fasta), record.offset, record.length};
+            }
+
+            std::error_code error{};
+            if (std::filesystem::file_size(packed_path, error) != record.length || error)
+                pack_fasta_record(fasta_path, record, packed_path);
+            return mapped_reference_sequence{packed_path, huge_pages};
+        }
+
+        constexpr const_iterator begin() const noexcept {
+            return _data;
+        }
+
+        constexpr const_iterator end() const noexcept {
+            return _data + _size;
+        }
+
+        constexpr const_reference operator[](size_type const position) const noexcept {
+            assert(position < size());
+            return _data[position];
+        }
+
+        constexpr char const * data() const noexcept {
+            return _data;
+        }
+
+        constexpr size_type size() const noexcept {
+            return _size;
+        }
+
+        constexpr bool empty() const noexcept {
+            return _size == 0;
+        }
+
+        //!\brief Returns zero, since the symbols are held by the page cache and shared with other processes.
+        constexpr size_type memory_usage() const noexcept {
+            return 0;
+        }
+    };
+}  // namespace libjst
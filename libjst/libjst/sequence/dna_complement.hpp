@@ -0,0 +1,54 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides the complement and the reverse complement of dna sequences.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <ranges>
+#include <utility>
+
+namespace libjst
+{
+    namespace detail
+    {
+        // Maps every character to its complement; characters other than the IUPAC nucleotides map to themselves.
+        inline constexpr std::array<char, 256> dna_complement_table = [] () {
+            std::array<char, 256> table{};
+            for (std::size_t symbol = 0; symbol < table.size(); ++symbol)
+                table[symbol] = static_cast<char>(symbol);
+
+            constexpr std::array<std::array<char, 2>, 16> complements{{
+                {'A', 'T'}, {'C', 'G'}, {'G', 'C'}, {'T', 'A'}, {'U', 'A'}, {'R', 'Y'}, {'Y', 'R'}, {'K', 'M'},
+                {'M', 'K'}, {'B', 'V'}, {'V', 'B'}, {'D', 'H'}, {'H', 'D'}, {'S', 'S'}, {'W', 'W'}, {'N', 'N'}
+            }};
+            constexpr char to_lower = 'a' - 'A';
+            for (auto [symbol, complement] : complements) {
+                table[static_cast<unsigned char>(symbol)] = complement;
+                table[static_cast<unsigned char>(symbol + to_lower)] = static_cast<char>(complement + to_lower);
+            }
+            return table;
+        }();
+    } // namespace detail
+
+    //!\brief Returns the complement of the given nucleotide, keeping its case; other characters are returned as is.
+    constexpr char dna_complement(char const symbol) noexcept {
+        return detail::dna_complement_table[static_cast<unsigned char>(symbol)];
+    }
+
+    //!\brief Returns a view over the reverse complement of the given bidirectional sequence of nucleotides.
+    template <std::ranges::viewable_range sequence_t>
+        requires std::ranges::bidirectional_range<sequence_t>
+    constexpr auto reverse_complement(sequence_t && sequence) {
+        return std::views::reverse(std::forward<sequence_t>(sequence)) | std::views::transform(dna_complement);
+    }
+}  // namespace libjst
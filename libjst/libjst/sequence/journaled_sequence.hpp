@@ -12,17 +12,36 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cassert>
 #include <concepts>
+#include <cstddef>
 #include <iterator>
 #include <limits>
+#include <memory>
 #include <ranges>
 
+#include <libjst/journal/balanced_sequence_journal.hpp>
 #include <libjst/journal/inline_sequence_journal.hpp>
 
 namespace libjst
 {
 
-    template <libjst::preserving_reference_sequence source_t>
+    /*!\brief A sequence represented by a journal of edits applied to a source sequence.
+     *
+     * \tparam source_t The type of the source sequence. Must model libjst::preserving_reference_sequence.
+     * \tparam allocator_t The allocator of the journal records; defaults to std::allocator.
+     * \tparam journal_t The journal storing the records; defaults to the libjst::inline_sequence_journal.
+     *
+     * \details
+     *
+     * The libjst::inline_sequence_journal stores the records contiguously, which makes iterating fast but costs
+     * linear time per edit. Use the libjst::balanced_sequence_journal, e.g. via libjst::balanced_journaled_sequence,
+     * when many edits are recorded at arbitrary positions; each edit then costs logarithmic time.
+     */
+    template <libjst::preserving_reference_sequence source_t,
+              typename allocator_t = std::allocator<std::byte>,
+              typename journal_t = inline_sequence_journal<source_t, allocator_t>>
     class journaled_sequence
     {
         // ----------------------------------------------------------------------------
@@ -36,7 +55,7 @@ namespace libjst
         // Member Types
         // ----------------------------------------------------------------------------
     private:
-        using journal_type = inline_sequence_journal<source_t>;
+        using journal_type = journal_t;
         using source_type = typename journal_type::source_type;
         using journal_breakend_type = journal_type::breakend_type;
         using journal_breakpoint_type = journal_type::breakpoint_type;
@@ -131,6 +150,12 @@ namespace libjst
             return std::numeric_limits<size_type>::max();
         }
 
+        //!\brief Returns the number of bytes of the journal records, which are copied with the sequence.
+        std::size_t journal_bytes() const noexcept
+        {
+            return std::ranges::size(_journal) * sizeof(entry_type);
+        }
+
         // ----------------------------------------------------------------------------
         // Modifiers
 
@@ -160,15 +185,149 @@ namespace libjst
             return iterator{std::addressof(_journal),
                             _journal.record(journal_breakpoint_type{std::move(from), std::move(to)}, std::move(segment))};
         }
+
+        /*!\name Ordered edits
+         * \brief Records edits arriving in increasing position order without searching the journal.
+         *
+         * \details
+         *
+         * A producer replaying its edits from left to right, e.g. the variants of a haplotype, only modifies the last
+         * record of the journal. append_replace() then records the edit in amortised constant time with the
+         * libjst::inline_sequence_journal, instead of locating the edit positions and updating the positions of the
+         * subsequent records. The positions refer to the current, i.e. already modified, sequence. Replaying n
+         * ordered edits is thus linear in n.
+         * \{
+         */
+        //!\brief Returns whether an edit beginning at the given position can be recorded with append_replace().
+        bool accepts_append(size_type const position) const noexcept
+        {
+            if (position > size())
+                return false;
+            return _journal.empty() || std::ranges::prev(_journal.end())->position() <= position;
+        }
+
+        /*!\brief Replaces the symbols `[first, last)` with the given segment.
+         *
+         * \param[in] first The position of the first replaced symbol; accepts_append() must hold for it.
+         * \param[in] last The position behind the last replaced symbol; must not be greater than size().
+         * \param[in] segment The segment to insert.
+         *
+         * \returns An iterator to the begin of the inserted segment, or to the symbol behind the replaced ones if the
+         *          segment is empty.
+         */
+        iterator append_replace(size_type const first, size_type const last, sequence_type segment)
+        {
+            assert(accepts_append(first));
+            assert(first <= last && last <= size());
+            return iterator{std::addressof(_journal), _journal.record_back(first, last, std::move(segment))};
+        }
+        //!\}
+
+        // ----------------------------------------------------------------------------
+        // Segments
+
+        //!\brief Returns whether `[first, last)` lies within the sequence of a single journal record.
+        bool is_single_segment(const_iterator const & first, const_iterator const & last) const noexcept
+        {
+            assert(first <= last);
+            if (first._journal_it == last._journal_it)
+                return true;
+
+            // An iterator to the end of a record points to the begin of the next record.
+            return std::ranges::next(first._journal_it) == last._journal_it &&
+                   last._sequence_it == std::ranges::begin(last._journal_it->sequence());
+        }
+
+        /*!\brief Returns the contiguous segments spelling the sequence `[first, last)`.
+         *
+         * \details
+         *
+         * Yields one libjst::journaled_sequence::sequence_type per journal record overlapping `[first, last)`, i.e. a
+         * std::span into the source or an inserted sequence if the source is contiguous. The first and the last
+         * segment are trimmed to the given range. Consumers copying or scanning the sequence iterate the segments
+         * instead of the symbols and thus check the record boundaries once per segment instead of once per symbol.
+         */
+        auto segments(const_iterator const & first, const_iterator const & last) const
+        {
+            assert(first <= last);
+            auto last_journal_it = last._journal_it;
+            if (last._sequence_it != std::ranges::begin(last._journal_it->sequence()))
+                ++last_journal_it;
+
+            // The records are identified by their positions, as the journals may return them by value.
+            return std::ranges::subrange{first._journal_it, std::move(last_journal_it)}
+                 | std::views::transform([first_position = first._journal_it->position(),
+                                          first_it = first._sequence_it,
+                                          last_position = last._journal_it->position(),
+                                          last_it = last._sequence_it] (auto && record) -> sequence_type {
+                auto segment = record.sequence();
+                auto segment_begin = std::ranges::begin(segment);
+                auto segment_end = std::ranges::end(segment);
+                if (record.position() == first_position)
+                    segment_begin = first_it;
+                if (record.position() == last_position)
+                    segment_end = last_it;
+                return sequence_type{std::move(segment_begin), std::move(segment_end)};
+            });
+        }
+
+        //!\overload
+        auto segments() const
+        {
+            return segments(begin(), end());
+        }
     };
 
+    /*!\brief Copies the sequence `[first, last)` of a libjst::journaled_sequence segment by segment.
+     *
+     * \param[in] sequence The journaled sequence.
+     * \param[in] first The iterator to the first copied symbol.
+     * \param[in] last The iterator behind the last copied symbol.
+     * \param[in] out The output iterator to copy the symbols to.
+     *
+     * 
+eturns The output iterator behind the last copied symbol.
+     *
+     * \details
+     *
+     * Copies every segment returned by libjst::journaled_sequence::segments at once, which moves the segments of a
+     * contiguous source into contiguous output memory with a single memmove each.
+     */
+    template <typename source_t, typename allocator_t, typename journal_t, std::weakly_incrementable out_t>
+    constexpr out_t segmented_copy(journaled_sequence<source_t, allocator_t, journal_t> const & sequence,
+                                   std::ranges::iterator_t<journaled_sequence<source_t, allocator_t, journal_t> const> first,
+                                   std::ranges::iterator_t<journaled_sequence<source_t, allocator_t, journal_t> const> last,
+                                   out_t out)
+    {
+        for (auto && segment : sequence.segments(first, last)) {
+            // Unlike std::ranges::copy, std::copy unwraps the iterators of a std::span before dispatching to memmove.
+            if constexpr (std::ranges::common_range<decltype(segment)> && std::copyable<out_t>)
+                out = std::copy(std::ranges::begin(segment), std::ranges::end(segment), std::move(out));
+            else
+                out = std::ranges::copy(segment, std::move(out)).out;
+        }
+        return out;
+    }
+
+    //!\overload
+    template <typename source_t, typename allocator_t, typename journal_t, std::weakly_incrementable out_t>
+    constexpr out_t segmented_copy(journaled_sequence<source_t, allocator_t, journal_t> const & sequence, out_t out)
+    {
+        return segmented_copy(sequence, sequence.begin(), sequence.end(), std::move(out));
+    }
+
     // deduction guide
     template <libjst::preserving_reference_sequence source_t>
     journaled_sequence(source_t &&) -> journaled_sequence<std::remove_reference_t<source_t>>;
 
-    template <libjst::preserving_reference_sequence source_t>
+    //!\brief A libjst::journaled_sequence with logarithmic edits using the libjst::balanced_sequence_journal.
+    template <libjst::preserving_reference_sequence source_t, typename allocator_t = std::allocator<std::byte>>
+    using balanced_journaled_sequence =
+        journaled_sequence<source_t, allocator_t, balanced_sequence_journal<source_t, allocator_t>>;
+
+    template <libjst::preserving_reference_sequence source_t, typename allocator_t, typename journal_t>
     template <bool is_const>
-    class journaled_sequence<source_t>::iterator_impl
+    class journaled_sequence<source_t, allocator_t, journal_t>::iterator_impl
     {
         friend journaled_sequence;
 
@@ -285,7 +444,7 @@ namespace libjst
             if (auto next_position = current_position() + count; current_record_covers(next_position)) {
                 _sequence_it += count;
             } else {
-                _journal_it = _journal->lower_bound(next_position);
+                _journal_it = find_record(next_position);
                 if (static_cast<difference_type>(_journal_it->position()) > next_position)
                     --_journal_it;
 
@@ -360,6 +519,13 @@ namespace libjst
 
         // ----------------------------------------------------------------------------
         // Utility functions
+    public:
+        //!\brief Returns the position of the iterator within the journaled sequence in constant time.
+        difference_type position() const noexcept
+        {
+            return current_position();
+        }
+
     private:
         difference_type current_position() const noexcept
         {
@@ -369,11 +535,57 @@ namespace libjst
                    std::ranges::distance(std::ranges::begin(_journal_it->sequence()), _sequence_it);
         }
 
+        /*!\brief Returns the first record whose position is not less than the given position.
+         *
+         * \details
+         *
+         * If the records are stored contiguously, the search starts from the current record and doubles its step
+         * until it passes the position, before it searches the passed bracket binary. Hence, a jump over `k` records,
+         * e.g. the shift of a skip-heavy search, costs O(log k) instead of O(log n) comparisons for a journal with `n`
+         * records. Jumps beyond a few dozen records and the journals without contiguous records search the entire
+         * journal instead.
+         */
+        journal_iterator find_record(difference_type const next_position) const noexcept
+        {
+            if constexpr (std::random_access_iterator<journal_iterator>) {
+                using position_t = typename std::remove_cvref_t<journal_record_t>::size_type;
+                position_t const key = static_cast<position_t>(next_position);
+                auto record_position = [] (auto const & record) { return record.position(); };
+
+                // Far jumps, e.g. from the begin of the sequence, are searched in the entire journal.
+                constexpr difference_type max_gallop_step = 16;
+                difference_type step = 1;
+                if (_journal_it->position() < key) { // gallop forward; the end record bounds the search.
+                    journal_iterator first = _journal_it;
+                    journal_iterator const last = _journal->end();
+                    for (; step <= max_gallop_step; step *= 2) {
+                        journal_iterator const probe = first + std::min(step, last - first);
+                        if (probe == last || probe->position() >= key)
+                            return std::ranges::lower_bound(first, probe, key, std::ranges::less{}, record_position);
+                        first = probe;
+                    }
+                } else { // gallop backward
+                    journal_iterator last = _journal_it;
+                    journal_iterator const first = _journal->begin();
+                    for (; step <= max_gallop_step && last != first; step *= 2) {
+                        journal_iterator const probe = last - std::min(step, last - first);
+                        if (probe->position() < key)
+                            return std::ranges::lower_bound(probe, last, key, std::ranges::less{}, record_position);
+                        last = probe;
+                    }
+                    if (last == first)
+                        return first;
+                }
+            }
+
+            return _journal->lower_bound(next_position);
+        }
+
         constexpr bool current_record_covers(difference_type next_position) const noexcept
         {
             using position_t = typename std::remove_cvref_t<journal_record_t>::size_type;
             return _journal_it->position() <= static_cast<position_t>(next_position) &&
-                   static_cast<position_t>(next_position) < (_journal_it + 1)->position();
+                   static_cast<position_t>(next_position) < std::ranges::next(_journal_it)->position();
         }
     };
 
@@ -0,0 +1,232 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides a dna sequence storing two bits per base.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <vector>
+
+#include <cereal/types/vector.hpp>
+
+#include <libjst/sequence/rank_alphabet.hpp>
+
+namespace libjst
+{
+
+    //!\brief A run of identical symbols of a libjst::packed_dna_sequence that are not one of 'A', 'C', 'G', 'T'.
+    struct packed_symbol_run {
+        uint64_t position{}; //!< The position of the first symbol of the run.
+        uint64_t length{}; //!< The number of symbols of the run.
+        char symbol{}; //!< The symbol of the run, e.g. 'N'.
+
+        constexpr friend bool operator==(packed_symbol_run const &, packed_symbol_run const &) noexcept = default;
+
+        template <typename archive_t>
+        void serialize(archive_t & archive)
+        {
+            archive(position, length, symbol);
+        }
+    };
+
+    /*!\brief A dna sequence storing the ranks of the bases with two bits per base.
+     *
+     * \details
+     *
+     * The bases 'A', 'C', 'G' and 'T' are stored by their ranks 0 to 3 in 64 bit words holding 32 bases each, where
+     * the base at position `i` occupies the bits `[2 * (i % 32), 2 * (i % 32) + 2)` of the word `i / 32`. All other
+     * symbols, e.g. 'N' or soft-masked bases, are packed with rank 0 and recorded additionally in a sorted list of
+     * symbol runs, which restores them on access. Bit-parallel matchers can load 32 consecutive bases at any position
+     * with a single call to libjst::packed_dna_sequence::word_at.
+     */
+    class packed_dna_sequence {
+    private:
+
+        static constexpr std::size_t bases_per_word = 32;
+
+        static constexpr std::array<char, 4> _to_base{'A', 'C', 'G', 'T'};
+        static constexpr std::array<uint8_t, 256> _to_rank{
+            [] () constexpr {
+                std::array<uint8_t, 256> table{};
+                for (size_t i = 0; i < 256; ++i)
+                    table[i] = 4;
+
+                table['A'] = 0;
+                table['C'] = 1;
+                table['G'] = 2;
+                table['T'] = 3;
+                return table;
+            }()
+        };
+
+        std::vector<uint64_t> _words{};
+        std::vector<packed_symbol_run> _runs{};
+        std::size_t _size{};
+
+    public:
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        packed_dna_sequence() = default; //!< Default.
+
+        //!\brief Packs the given sequence of characters.
+        template <std::ranges::input_range sequence_t>
+            requires std::convertible_to<std::ranges::range_reference_t<sequence_t>, char>
+        explicit packed_dna_sequence(sequence_t && sequence)
+        {
+            if constexpr (std::ranges::sized_range<sequence_t>)
+                _words.reserve((std::ranges::size(sequence) + bases_per_word - 1) / bases_per_word);
+
+            uint64_t word{};
+            for (char const symbol : sequence) {
+                uint8_t rank = _to_rank[static_cast<unsigned char>(symbol)];
+                if (rank == 4) {
+                    if (_runs.empty() || _runs.back().symbol != symbol ||
+                        _runs.back().position + _runs.back().length != _size)
+                        _runs.push_back(packed_symbol_run{.position = _size, .length = 0, .symbol = symbol});
+                    ++_runs.back().length;
+                    rank = 0;
+                }
+
+                word |= static_cast<uint64_t>(rank) << (2 * (_size % bases_per_word));
+                if (++_size % bases_per_word == 0) {
+                    _words.push_back(word);
+                    word = 0;
+                }
+            }
+
+            if (_size % bases_per_word != 0)
+                _words.push_back(word);
+        }
+
+        /*!\brief Packs the given sequence over a rank alphabet, e.g. a `seqan3::dna4_vector`.
+         *
+         * \details
+         *
+         * The ranks of a libjst::dna_rank_alphabet are stored as they are, without converting the symbols to
+         * characters. The symbols of other alphabets, e.g. `seqan3::dna5`, are packed by their characters.
+         */
+        template <std::ranges::input_range sequence_t>
+            requires (rank_alphabet_range<sequence_t> &&
+                      !std::convertible_to<std::ranges::range_reference_t<sequence_t>, char>)
+        explicit packed_dna_sequence(sequence_t && sequence)
+        {
+            using alphabet_t = std::ranges::range_value_t<sequence_t>;
+            if constexpr (!dna_rank_alphabet<alphabet_t>) {
+                *this = packed_dna_sequence{as_chars((sequence_t &&)sequence)};
+            } else {
+                if constexpr (std::ranges::sized_range<sequence_t>)
+                    _words.reserve((std::ranges::size(sequence) + bases_per_word - 1) / bases_per_word);
+
+                uint64_t word{};
+                for (auto && symbol : sequence) {
+                    word |= static_cast<uint64_t>(symbol.to_rank()) << (2 * (_size % bases_per_word));
+                    if (++_size % bases_per_word == 0) {
+                        _words.push_back(word);
+                        word = 0;
+                    }
+                }
+
+                if (_size % bases_per_word != 0)
+                    _words.push_back(word);
+            }
+        }
+        //!\}
+
+        constexpr std::size_t size() const noexcept {
+            return _size;
+        }
+
+        constexpr bool empty() const noexcept {
+            return _size == 0;
+        }
+
+        //!\brief Returns the symbol at the given position.
+        constexpr char operator[](std::size_t const position) const noexcept {
+            auto run_it = std::ranges::upper_bound(_runs, position, std::ranges::less{}, &packed_symbol_run::position);
+            if (run_it != _runs.begin()) {
+                --run_it;
+                if (position < run_it->position + run_it->length)
+                    return run_it->symbol;
+            }
+            return _to_base[rank_at(position)];
+        }
+
+        //!\brief Returns the rank of the base at the given position; symbols other than 'A', 'C', 'G', 'T' have rank 0.
+        constexpr uint8_t rank_at(std::size_t const position) const noexcept {
+            return (_words[position / bases_per_word] >> (2 * (position % bases_per_word))) & 0b11;
+        }
+
+        /*!\brief Returns the ranks of the 32 bases beginning at the given position in one word.
+         *
+         * \details
+         *
+         * The base at `position + i` occupies the bits `[2 * i, 2 * i + 2)` of the returned word. Bases beyond the end
+         * of the sequence are returned with rank 0.
+         */
+        constexpr uint64_t word_at(std::size_t const position) const noexcept {
+            std::size_t const word_idx = position / bases_per_word;
+            std::size_t const offset = 2 * (position % bases_per_word);
+            if (word_idx >= _words.size())
+                return 0;
+
+            uint64_t word = _words[word_idx] >> offset;
+            if (offset != 0 && word_idx + 1 < _words.size())
+                word |= _words[word_idx + 1] << (64 - offset);
+            return word;
+        }
+
+        //!\brief Returns the words storing the packed bases.
+        constexpr std::span<uint64_t const> words() const noexcept {
+            return _words;
+        }
+
+        //!\brief Returns the runs of symbols other than 'A', 'C', 'G', 'T' sorted by their position.
+        constexpr std::span<packed_symbol_run const> runs() const noexcept {
+            return _runs;
+        }
+
+        //!\brief Writes the unpacked symbols to the given output iterator and returns the iterator past the last symbol.
+        template <std::output_iterator<char> out_t>
+        constexpr out_t unpack(out_t out) const {
+            auto run_it = _runs.begin();
+            for (std::size_t position = 0; position < _size;) {
+                if (run_it != _runs.end() && run_it->position == position) {
+                    out = std::ranges::fill_n(std::move(out), static_cast<std::iter_difference_t<out_t>>(run_it->length),
+                                              run_it->symbol);
+                    position += run_it->length;
+                    ++run_it;
+                } else {
+                    *out = _to_base[rank_at(position++)];
+                    ++out;
+                }
+            }
+            return out;
+        }
+
+        // ----------------------------------------------------------------------------
+        // Serialisation
+        // ----------------------------------------------------------------------------
+
+        template <typename archive_t>
+        void serialize(archive_t & archive)
+        {
+            archive(_size, _words, _runs);
+        }
+    };
+}  // namespace libjst
@@ -0,0 +1,96 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides the interoperability with rank based alphabets, e.g. the alphabets of seqan3.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <ranges>
+
+namespace libjst
+{
+    /*!\brief An alphabet whose symbols are represented by their ranks, e.g. `seqan3::dna4` or `seqan3::dna5`.
+     *
+     * \details
+     *
+     * The concept is modelled structurally by the member interface of the seqan3 alphabets, such that libjst does not
+     * depend on seqan3.
+     */
+    template <typename alphabet_t>
+    concept rank_alphabet = std::semiregular<alphabet_t> && requires (alphabet_t symbol, alphabet_t const csymbol) {
+        { csymbol.to_rank() } -> std::integral;
+        { csymbol.to_char() } -> std::convertible_to<char>;
+        { symbol.assign_rank(0) } -> std::convertible_to<alphabet_t &>;
+        { alphabet_t::alphabet_size } -> std::convertible_to<std::size_t>;
+    };
+
+    namespace detail
+    {
+        template <rank_alphabet alphabet_t>
+        constexpr bool has_dna_ranks() noexcept {
+            if constexpr (alphabet_t::alphabet_size != 4) {
+                return false;
+            } else {
+                for (unsigned rank = 0; rank < 4; ++rank) {
+                    alphabet_t symbol{};
+                    symbol.assign_rank(rank);
+                    if (static_cast<char>(symbol.to_char()) != "ACGT"[rank])
+                        return false;
+                }
+                return true;
+            }
+        }
+    } // namespace detail
+
+    /*!\brief A rank alphabet of the four bases 'A', 'C', 'G' and 'T' with the ranks 0 to 3, e.g. `seqan3::dna4`.
+     *
+     * \details
+     *
+     * The ranks equal the ranks of libjst::packed_dna_sequence, which packs such sequences without a lookup.
+     */
+    template <typename alphabet_t>
+    concept dna_rank_alphabet = rank_alphabet<alphabet_t> && detail::has_dna_ranks<alphabet_t>();
+
+    //!\brief A range over a libjst::rank_alphabet, e.g. `seqan3::dna4_vector` or `seqan3::bitpacked_sequence`.
+    template <typename sequence_t>
+    concept rank_alphabet_range = std::ranges::input_range<sequence_t> &&
+                                  rank_alphabet<std::ranges::range_value_t<sequence_t>>;
+
+    namespace _as_chars
+    {
+        struct to_char_fn {
+            // The proxy references, e.g. of a seqan3::bitpacked_sequence, provide the same member interface.
+            template <typename reference_t>
+            constexpr char operator()(reference_t && symbol) const noexcept {
+                return static_cast<char>(symbol.to_char());
+            }
+        };
+
+        inline constexpr struct _fn {
+            /*!\brief Returns a lazy view of the characters of a sequence over a rank alphabet.
+             *
+             * \details
+             *
+             * The view converts every symbol on access and does not copy the sequence, such that a query over a rank
+             * alphabet can be passed directly to the matchers, which require patterns of `char`. The view preserves
+             * the random access and the size of the underlying sequence.
+             */
+            template <std::ranges::viewable_range sequence_t>
+                requires rank_alphabet_range<sequence_t>
+            constexpr auto operator()(sequence_t && sequence) const {
+                return std::views::transform((sequence_t &&)sequence, to_char_fn{});
+            }
+        } as_chars{};
+    } // namespace _as_chars
+
+    using _as_chars::as_chars;
+}  // namespace libjst
@@ -0,0 +1,131 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::branch_jump_table.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <type_traits>
+#include <vector>
+
+#include <libjst/variant/concept.hpp>
+
+namespace libjst
+{
+    /*!\brief Stores the next branching breakend of every breakend of a variant map.
+     *
+     * \tparam variant_map_t The type of the variant map.
+     *
+     * \details
+     *
+     * The next branching breakend of a breakend is the next breakend that is a low end, i.e. at which a variant
+     * begins, or the sink of the variant map if there is none. libjst::merge_tree_impl uses the table to move a
+     * reference node over the high ends of the deletions in one step, instead of visiting every breakend in between.
+     *
+     * The table references the variant map; it must be rebuilt after the variant map has been modified.
+     */
+    template <std::ranges::random_access_range variant_map_t>
+    class branch_jump_table {
+    private:
+        using variant_iterator = std::ranges::iterator_t<variant_map_t const>;
+
+        variant_iterator _first{}; //!< The first breakend of the variant map.
+        std::vector<std::size_t> _next_branch{}; //!< The index of the next branching breakend per breakend.
+
+    public:
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        branch_jump_table() = default; //!< Default.
+
+        //!\brief Computes the next branching breakends of the given variant map.
+        explicit branch_jump_table(variant_map_t const & variants) : _first{std::ranges::begin(variants)}
+        {
+            std::size_t const breakend_count = std::ranges::size(variants);
+            if (breakend_count == 0)
+                return;
+
+            _next_branch.resize(breakend_count);
+            std::size_t next_branch = breakend_count - 1; // the sink
+            _next_branch[next_branch] = next_branch;
+            for (std::size_t idx = breakend_count - 1; idx > 0; --idx) {
+                if (idx < breakend_count - 1 && (*std::ranges::next(_first, idx)).get_breakpoint_end() == breakpoint_end::low)
+                    next_branch = idx;
+                _next_branch[idx - 1] = next_branch;
+            }
+        }
+        //!\}
+
+        //!\brief Returns the next breakend after the given one that is a low end, or the sink.
+        constexpr variant_iterator next_branch(variant_iterator const & breakend) const noexcept {
+            std::size_t const idx = static_cast<std::size_t>(breakend - _first);
+            assert(idx < _next_branch.size());
+            return std::ranges::next(_first, _next_branch[idx]);
+        }
+
+        //!\brief Returns the number of breakends.
+        constexpr std::size_t size() const noexcept {
+            return _next_branch.size();
+        }
+    };
+
+    namespace detail
+    {
+        //!\brief Whether the type is a libjst::branch_jump_table.
+        template <typename t>
+        inline constexpr bool is_branch_jump_table_v = false;
+
+        template <typename variant_map_t>
+        inline constexpr bool is_branch_jump_table_v<branch_jump_table<variant_map_t>> = true;
+
+        template <typename member_t>
+        struct ref_jump_member;
+
+        template <typename node_t, typename target_t>
+        struct ref_jump_member<bool (node_t::*)(target_t) noexcept> {
+            using node_type = node_t;
+            using target_type = target_t;
+        };
+
+        /*!\brief A node that can be moved along the reference to a later breakend with `node.jump_ref(target)`.
+         *
+         * \details
+         *
+         * The jump must leave the node in the same state as visiting the reference children up to the node whose
+         * high boundary is the target breakend, which is only true for nodes that do not change along the reference.
+         * Hence, a node must declare the member itself and does not inherit it from the node it wraps.
+         */
+        template <typename node_t>
+        concept ref_jumpable_node = requires { &node_t::jump_ref; } &&
+                                    std::same_as<typename ref_jump_member<decltype(&node_t::jump_ref)>::node_type,
+                                                 node_t>;
+
+        template <typename node_t>
+        struct ref_jump_target
+        {
+            using type = std::nullptr_t;
+        };
+
+        template <ref_jumpable_node node_t>
+        struct ref_jump_target<node_t>
+        {
+            using type = typename ref_jump_member<decltype(&node_t::jump_ref)>::target_type;
+        };
+
+        //!\brief The breakend type of a libjst::detail::ref_jumpable_node, or std::nullptr_t otherwise.
+        template <typename node_t>
+        using ref_jump_target_t = typename ref_jump_target<node_t>::type;
+    } // namespace detail
+}  // namespace libjst
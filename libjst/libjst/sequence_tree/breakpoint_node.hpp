@@ -14,10 +14,22 @@
 
 #include <libjst/sequence_tree/breakend_site.hpp>
 #include <libjst/sequence_tree/node_descriptor.hpp>
+#include <libjst/utility/prefetch.hpp>
 
 namespace libjst
 {
-    template <typename breakend_iterator>
+    /*!\brief A node of a sequence tree bounded by two breakend sites.
+     *
+     * \tparam breakend_iterator The iterator over the breakends of the variant map.
+     * \tparam prefetch_distance The number of breakends prefetched ahead of the high boundary of a reference child,
+     *                           see libjst::prefetch_ahead; defaults to libjst::default_prefetch_distance.
+     *
+     * \details
+     *
+     * The children of a node move forward over the breakends, such that the keys and the coverages of the upcoming
+     * breakends are prefetched while the current node is processed.
+     */
+    template <typename breakend_iterator, std::ptrdiff_t prefetch_distance = default_prefetch_distance>
     class breakpoint_node : public node_descriptor
     {
     private:
@@ -96,10 +108,16 @@ namespace libjst
 
         position_t next_high_boundary_ref(position_t const & boundary) const noexcept {
             auto next_breakend = std::ranges::next(boundary.get_breakend());
+            if constexpr (prefetch_distance > 0)
+                libjst::prefetch_ahead(next_breakend, prefetch_distance);
             breakpoint_end next_site = (*next_breakend).get_breakpoint_end();
             position_t next_high_boundary{std::move(next_breakend), std::move(next_site)};
-            // Move over all
-            while (this->from_variant() && libjst::position(next_high_boundary) < libjst::position(high_boundary())) {
+            if (!this->from_variant())
+                return next_high_boundary;
+
+            // Moves over all breakends spanned by the variant; its end position is evaluated only once.
+            auto const variant_end = libjst::position(high_boundary());
+            while (libjst::position(next_high_boundary) < variant_end) {
                 next_breakend = std::ranges::next(next_high_boundary.get_breakend());
                 next_site = (*next_breakend).get_breakpoint_end();
                 next_high_boundary = position_t{std::move(next_breakend), std::move(next_site)};
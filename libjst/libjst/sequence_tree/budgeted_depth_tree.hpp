@@ -0,0 +1,248 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides a tree adaptor limiting the alternate subtrees by a node budget.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+
+#include <libjst/utility/closure_object.hpp>
+
+#include <libjst/rcms/carrier_count_index.hpp>
+#include <libjst/sequence_tree/branch_jump_table.hpp>
+#include <libjst/sequence_tree/concept.hpp>
+
+namespace libjst
+{
+    //!\brief Collects the children cut by libjst::depth_budget, e.g. to report the loss of an approximate search.
+    struct depth_budget_report {
+        std::atomic<std::size_t> cut_alternates{}; //!< The alternate children that were not expanded.
+        std::atomic<std::size_t> cut_continuations{}; //!< The reference children on alternate paths not expanded.
+        std::atomic<std::size_t> cut_carriers{}; //!< The sum of the carrier counts of the cut alternate children.
+    };
+
+    /*!\brief A tree adaptor limiting every alternate subtree to a budget of nodes.
+     *
+     * \tparam base_tree_t The type of the wrapped tree, e.g. libjst::volatile_tree or libjst::partial_tree.
+     *
+     * \details
+     *
+     * Unlike libjst::k_depth, which cuts every alternate path at the same depth, the adaptor bounds the number of
+     * nodes of the subtree below every alternate child of the reference path, its region. The root of a region
+     * receives the entire budget and every node passes its budget minus itself on to its children: the alternate
+     * child receives the share of the haplotypes carrying its variant, looked up in the libjst::carrier_count_index
+     * of the variant map, and the reference child the rest, which keeps at least one node of a non-empty budget.
+     * The depth is hence limited adaptively: the paths of a sparse region reach deep, while a hyper-variable region
+     * is cut early, and the frequent alternates are kept over the rare ones. A child whose share is empty is not expanded, which bounds the work per region and hence
+     * the latency of a search, at the price of the hits spanning the cut children.
+     *
+     * The cut children are counted in an optional libjst::depth_budget_report, which must outlive the traversal.
+     * A child is counted every time it is cut, i.e. once per traversal of its parent. Like libjst::min_support, the
+     * adaptor is applied directly to the tree over the store, before any label is built.
+     */
+    template <typename base_tree_t>
+    class budgeted_depth_tree_impl {
+    private:
+        using base_node_type = libjst::tree_node_t<base_tree_t>;
+        using sink_type = libjst::tree_sink_t<base_tree_t>;
+        using breakend_iterator = std::remove_cvref_t<
+                decltype(std::declval<base_node_type const &>().low_boundary().get_breakend())>;
+
+        //!\brief The state shared by all nodes to split the budget of a node between its children.
+        struct budget_policy {
+            carrier_count_index const * carrier_counts{};
+            breakend_iterator first{};
+            std::size_t haplotype_count{};
+            std::size_t region_budget{};
+            depth_budget_report * report{};
+
+            constexpr std::size_t carriers(breakend_iterator const & breakend) const noexcept {
+                return (*carrier_counts)[static_cast<std::size_t>(breakend - first)];
+            }
+        };
+
+        class node_impl;
+
+        base_tree_t _wrappee{};
+        std::size_t _region_budget{};
+        depth_budget_report * _report{};
+
+    public:
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        constexpr budgeted_depth_tree_impl() = default; //!< Default.
+
+        /*!\brief Limits every alternate subtree to the given number of nodes.
+         *
+         * \throws std::invalid_argument if the carrier count index of the variant map was not built.
+         */
+        template <typename wrapped_tree_t>
+            requires (!std::same_as<std::remove_cvref_t<wrapped_tree_t>, budgeted_depth_tree_impl> &&
+                      std::constructible_from<base_tree_t, wrapped_tree_t>)
+        constexpr budgeted_depth_tree_impl(wrapped_tree_t && wrappee,
+                                           std::size_t const region_budget,
+                                           depth_budget_report * report = nullptr) :
+            _wrappee{(wrapped_tree_t &&)wrappee},
+            _region_budget{region_budget},
+            _report{report}
+        {
+            if (!data().variants().has_carrier_count_index())
+                throw std::invalid_argument{"The carrier count index of the variants must be built first!"};
+        }
+        //!\}
+
+        constexpr node_impl root() const noexcept {
+            budget_policy policy{.carrier_counts = std::addressof(data().variants().carrier_counts()),
+                                 .first = std::ranges::begin(data().variants()),
+                                 .haplotype_count = std::max<std::size_t>(data().size(), 1),
+                                 .region_budget = _region_budget,
+                                 .report = _report};
+            return node_impl{libjst::root(_wrappee), std::move(policy), 0};
+        }
+
+        constexpr sink_type sink() const noexcept {
+            return libjst::sink(_wrappee);
+        }
+
+        constexpr auto const & data() const noexcept {
+            return _wrappee.data();
+        }
+
+        constexpr std::size_t region_budget() const noexcept {
+            return _region_budget;
+        }
+    };
+
+    template <typename base_tree_t>
+    class budgeted_depth_tree_impl<base_tree_t>::node_impl : public base_node_type {
+    private:
+
+        friend budgeted_depth_tree_impl;
+
+        budget_policy _policy{};
+        std::size_t _budget{}; // the nodes of the subtree including this node; unused on the reference path.
+
+        explicit constexpr node_impl(base_node_type && base_node, budget_policy policy, std::size_t budget) noexcept :
+            base_node_type{std::move(base_node)},
+            _policy{std::move(policy)},
+            _budget{budget}
+        {}
+
+    public:
+
+        node_impl() = default;
+
+        constexpr std::optional<node_impl> next_alt() const noexcept {
+            auto maybe_child = base_node_type::next_alt();
+            if (!maybe_child)
+                return std::nullopt;
+
+            if (std::size_t const budget = alt_budget(); budget > 0)
+                return node_impl{std::move(*maybe_child), _policy, budget};
+
+            if (_policy.report != nullptr) {
+                _policy.report->cut_alternates.fetch_add(1, std::memory_order_relaxed);
+                _policy.report->cut_carriers.fetch_add(_policy.carriers(this->high_boundary().get_breakend()),
+                                                       std::memory_order_relaxed);
+            }
+            return std::nullopt;
+        }
+
+        constexpr std::optional<node_impl> next_ref() const noexcept {
+            auto maybe_child = base_node_type::next_ref();
+            if (!maybe_child)
+                return std::nullopt;
+
+            if (!base_node_type::on_alternate_path())
+                return node_impl{std::move(*maybe_child), _policy, 0};
+
+            if (std::size_t const budget = remaining_budget() - alt_budget(); budget > 0)
+                return node_impl{std::move(*maybe_child), _policy, budget};
+
+            if (_policy.report != nullptr)
+                _policy.report->cut_continuations.fetch_add(1, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+
+        //!\brief Returns the number of nodes the subtree of this node may still expand, including itself.
+        constexpr std::size_t budget() const noexcept {
+            return _budget;
+        }
+
+        //!\brief Forwards to the wrapped node on the reference path, where the budget is not consumed.
+        constexpr bool jump_ref(detail::ref_jump_target_t<base_node_type> target) noexcept
+            requires detail::ref_jumpable_node<base_node_type>
+        {
+            if (base_node_type::on_alternate_path())
+                return false;
+            return base_node_type::jump_ref(std::move(target));
+        }
+
+    private:
+
+        constexpr std::size_t remaining_budget() const noexcept {
+            return (_budget > 0) ? _budget - 1 : 0;
+        }
+
+        // The budget of the alternate child, i.e. the share of the remaining budget of the carriers of its variant.
+        constexpr std::size_t alt_budget() const noexcept {
+            if (!base_node_type::on_alternate_path())
+                return _policy.region_budget;
+            if (!this->high_boundary().is_low_end())
+                return 0;
+
+            std::size_t const carriers = std::min(_policy.carriers(this->high_boundary().get_breakend()),
+                                                  _policy.haplotype_count);
+            // The reference child is weighted by one more haplotype, such that it keeps a node of every budget.
+            return remaining_budget() * carriers / (_policy.haplotype_count + 1);
+        }
+
+        constexpr friend bool operator==(node_impl const & lhs, sink_type const & rhs) noexcept
+        {
+            return static_cast<base_node_type const &>(lhs) == rhs;
+        }
+    };
+
+    namespace _tree_adaptor {
+        inline constexpr struct _depth_budget
+        {
+            template <typename base_tree_t, std::unsigned_integral budget_t>
+            constexpr auto operator()(base_tree_t && tree,
+                                      budget_t const region_budget,
+                                      depth_budget_report * report = nullptr) const
+                -> budgeted_depth_tree_impl<std::remove_cvref_t<base_tree_t>>
+            {
+                using adapted_tree_t = budgeted_depth_tree_impl<std::remove_cvref_t<base_tree_t>>;
+                return adapted_tree_t{(base_tree_t &&)tree, static_cast<std::size_t>(region_budget), report};
+            }
+
+            template <std::unsigned_integral budget_t>
+            constexpr auto operator()(budget_t const region_budget, depth_budget_report * report = nullptr) const
+                noexcept(std::is_nothrow_invocable_v<libjst::tag_t<libjst::make_closure>,
+                                                     budget_t, depth_budget_report *>)
+                -> libjst::closure_result_t<_depth_budget, budget_t, depth_budget_report *>
+            {
+                return libjst::make_closure(_depth_budget{}, region_budget, report);
+            }
+        } depth_budget{};
+    } // namespace _tree_adaptor
+
+    using _tree_adaptor::depth_budget;
+}  // namespace libjst
@@ -61,6 +61,31 @@ namespace libjst
         constexpr iterator end() const noexcept {
             return iterator{this, max_chunk_count()};
         }
+
+        constexpr rcms_t const & data() const noexcept {
+            return base();
+        }
+
+        constexpr size_type chunk_size() const noexcept {
+            return _chunk_size;
+        }
+
+        constexpr size_type overlap_size() const noexcept {
+            return _overlap_size;
+        }
+
+        /*!\brief Returns the chunk with the given index without the overlap.
+         *
+         * \details
+         *
+         * The traversers left extend every label by the trimmed window of the pattern, such that a hit is reported in
+         * the node holding the last symbol of the match. The chunk without the overlap hence reports exactly the hits
+         * ending within the chunk, and the hits of all owned chunks partition the hits of the whole tree.
+         */
+        constexpr chunk_type owned_chunk(size_t const chunk_idx) const noexcept {
+            using offset_t = typename breakpoint::value_type;
+            return chunk_type{base(), static_cast<offset_t>(chunk_idx * _chunk_size), _chunk_size};
+        }
     private:
 
         constexpr rcms_t const & base() const noexcept {
@@ -12,16 +12,36 @@
 
 #pragma once
 
+#include <concepts>
+#include <memory>
+#include <stdexcept>
 #include <type_traits>
 
+#include <libjst/coverage/concept.hpp>
 #include <libjst/utility/closure_object.hpp>
 
+#include <libjst/sequence_tree/branch_jump_table.hpp>
 #include <libjst/sequence_tree/concept.hpp>
+#include <libjst/sequence_tree/tree_metrics.hpp>
 #include <libjst/variant/concept.hpp>
 
 namespace libjst
 {
 
+    /*!\brief Adds the coverage of the current path to the labels of the wrapped tree.
+     *
+     * \tparam wrapped_tree_t The type of the wrapped tree.
+     *
+     * \details
+     *
+     * The nodes on the reference path carry the root colour, which is the coverage of the reference sentinel and
+     * thus covers all haplotypes by default. A subset of the haplotypes, e.g. a population or a case cohort, can be
+     * given as root colour instead, i.e. `coloured(subset)`. The libjst::prune_tree over this tree starts from the
+     * subset and removes every alternate path that is not covered by any of its haplotypes, such that a query on the
+     * subset does not traverse the variants of the other haplotypes. The subset must have the coverage domain of the
+     * variant map. If the variant map returns its coverages as views, e.g. into a libjst::bit_coverage_pool, the
+     * subset is such a view and must outlive the tree.
+     */
     template <typename wrapped_tree_t>
     class coloured_tree {
     private:
@@ -32,12 +52,31 @@ namespace libjst
         using boundary_type = typename base_node_type::position_type;
         using delta_reference = typename boundary_type::delta_reference;
         using coverage_type = libjst::variant_coverage_t<delta_reference>;
+        using coverage_reference = decltype(libjst::coverage(std::declval<delta_reference>()));
+        // Coverages returned by value are views, e.g. into a libjst::bit_coverage_pool, and are held as such.
+        static constexpr bool holds_coverage_view = !std::is_lvalue_reference_v<coverage_reference>;
+        using coverage_handle = std::conditional_t<holds_coverage_view, coverage_type, coverage_type const *>;
+
+        struct no_subset {};
+        // An owned subset is shared between the copies of the tree, such that the handle stays valid when the tree
+        // is moved into the adaptors stacked on top of it.
+        using subset_holder = std::conditional_t<holds_coverage_view,
+                                                 no_subset,
+                                                 std::shared_ptr<coverage_type const>>;
 
         class node_impl;
         class cargo_impl;
 
         wrapped_tree_t _wrappee{};
-        coverage_type const * _coverage{};
+        coverage_handle _coverage{};
+        [[no_unique_address]] subset_holder _subset{};
+
+        static constexpr coverage_handle to_handle(coverage_reference coverage) noexcept {
+            if constexpr (holds_coverage_view)
+                return coverage;
+            else
+                return std::addressof(coverage);
+        }
 
     public:
 
@@ -46,7 +85,28 @@ namespace libjst
                       std::constructible_from<wrapped_tree_t, wrappee_t>)
         constexpr explicit coloured_tree(wrappee_t && wrappee) noexcept : _wrappee{(wrappee_t &&)wrappee}
         {
-            _coverage = std::addressof(libjst::coverage(*(data().variants().begin())));
+            _coverage = to_handle(libjst::coverage(*(data().variants().begin())));
+        }
+
+        /*!\brief Uses the given subset of the haplotypes as root colour.
+         *
+         * \throws std::domain_error if the subset has a different coverage domain than the variant map.
+         */
+        template <typename wrappee_t>
+            requires (!std::same_as<std::remove_cvref_t<wrappee_t>, coloured_tree> &&
+                      std::constructible_from<wrapped_tree_t, wrappee_t>)
+        constexpr explicit coloured_tree(wrappee_t && wrappee, coverage_type subset) :
+            _wrappee{(wrappee_t &&)wrappee}
+        {
+            if (libjst::get_domain(subset) != libjst::get_domain(libjst::coverage(*(data().variants().begin()))))
+                throw std::domain_error{"The subset has a different coverage domain than the variants!"};
+
+            if constexpr (holds_coverage_view) {
+                _coverage = std::move(subset);
+            } else {
+                _subset = std::make_shared<coverage_type const>(std::move(subset));
+                _coverage = _subset.get();
+            }
         }
 
         constexpr node_impl root() const noexcept {
@@ -94,15 +154,24 @@ namespace libjst
                 return cargo_impl{*(static_cast<base_t const &>(*this)), _host->_coverage};
             } else {
                 return cargo_impl{*(static_cast<base_t const &>(*this)),
-                            std::addressof(libjst::coverage(*(this->low_boundary())))};
+                            to_handle(libjst::coverage(*(this->low_boundary())))};
             }
         }
 
+        //!\brief Forwards to the wrapped node, as the colour does not change along the reference.
+        constexpr bool jump_ref(detail::ref_jump_target_t<base_t> target) noexcept
+            requires detail::ref_jumpable_node<base_t>
+        {
+            return base_t::jump_ref(std::move(target));
+        }
+
     private:
 
         constexpr std::optional<node_impl> visit_next(std::optional<base_t> && base_child) const noexcept {
-            if (base_child.has_value())
+            if (base_child.has_value()) {
+                detail::count_tree_metric<&tree_metrics::coloured, &adaptor_metrics::nodes_created>();
                 return node_impl{std::move(*base_child), _host};
+            }
             return std::nullopt;
         }
 
@@ -115,11 +184,11 @@ namespace libjst
     template <typename wrapped_tree_t>
     class coloured_tree<wrapped_tree_t>::cargo_impl : public base_cargo_type {
     private:
-        [[no_unique_address]] coverage_type const * _coverage{};
+        [[no_unique_address]] coverage_handle _coverage{};
 
         friend coloured_tree;
 
-        constexpr explicit cargo_impl(base_cargo_type base_cargo, coverage_type const * coverage) :
+        constexpr explicit cargo_impl(base_cargo_type base_cargo, coverage_handle coverage) :
             base_cargo_type{std::move(base_cargo)},
             _coverage{coverage}
         {}
@@ -127,8 +196,11 @@ namespace libjst
 
         cargo_impl() = default;
 
-        constexpr coverage_type const & coverage() const noexcept {
-            return *_coverage;
+        constexpr coverage_reference coverage() const noexcept {
+            if constexpr (holds_coverage_view)
+                return _coverage;
+            else
+                return *_coverage;
         }
     };
 
@@ -136,15 +208,20 @@ namespace libjst
         struct _coloured {
 
             template <typename tree_t, typename ...args_t>
+                requires std::invocable<libjst::tag_t<libjst::root>, tree_t const &>
             constexpr auto operator()(tree_t && tree, args_t &&... args) const
-                noexcept(std::is_nothrow_constructible_v<coloured_tree<std::remove_reference_t<tree_t>>>)
+                noexcept(std::is_nothrow_constructible_v<coloured_tree<std::remove_reference_t<tree_t>>,
+                                                         tree_t, args_t...>)
                 -> coloured_tree<std::remove_reference_t<tree_t>>
             {
                 using adapted_tree_t = coloured_tree<std::remove_reference_t<tree_t>>;
                 return adapted_tree_t{(tree_t &&)tree, (args_t &&)args...};
             }
 
+            //!\brief Creates the closure, optionally with the subset of the haplotypes used as root colour.
             template <typename ...args_t>
+                requires (sizeof...(args_t) == 0 ||
+                          !std::invocable<libjst::tag_t<libjst::root>, args_t const &...>)
             constexpr auto operator()(args_t &&... args) const
                 noexcept(std::is_nothrow_invocable_v<libjst::tag_t<libjst::make_closure>, _coloured, args_t...>)
                 -> libjst::closure_result_t<_coloured, args_t...>
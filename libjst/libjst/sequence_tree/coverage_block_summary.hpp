@@ -0,0 +1,129 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::coverage_block_summary.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <libjst/coverage/concept.hpp>
+#include <libjst/variant/concept.hpp>
+
+namespace libjst
+{
+    /*!\brief Summarises the coverages of consecutive blocks of breakends of a variant map.
+     *
+     * \tparam variant_map_t The type of the summarised variant map.
+     *
+     * \details
+     *
+     * Stores the union of the coverages of every block of `block_size` consecutive breakends. A path whose coverage
+     * does not intersect the union of a block cannot branch into any variant of this block, such that
+     * libjst::prune_tree skips the alternate children of the block without computing their coverages. The first and
+     * the last entry of the variant map are the sentinels of the reference and do not contribute to the summary.
+     *
+     * The summary references the variant map; it must be rebuilt after the variant map has been modified.
+     */
+    template <std::ranges::random_access_range variant_map_t>
+    class coverage_block_summary {
+    private:
+        using variant_iterator = std::ranges::iterator_t<variant_map_t const>;
+        using variant_coverage_type = libjst::variant_coverage_t<std::iter_reference_t<variant_iterator>>;
+        using coverage_type = std::remove_cvref_t<std::invoke_result_t<libjst::tag_t<libjst::coverage_intersection>,
+                                                                       variant_coverage_type const &,
+                                                                       variant_coverage_type const &>>;
+
+        variant_iterator _first{}; //!< The first breakend of the variant map.
+        std::size_t _block_size{}; //!< The number of breakends per block.
+        std::vector<coverage_type> _block_coverages{}; //!< The union of the coverages of every block.
+
+    public:
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        coverage_block_summary() = default; //!< Default.
+
+        //!\brief Summarises the given variant map in blocks of the given number of breakends.
+        explicit coverage_block_summary(variant_map_t const & variants, std::size_t const block_size = 64) :
+            _first{std::ranges::begin(variants)},
+            _block_size{block_size}
+        {
+            if (block_size == 0)
+                throw std::invalid_argument{"The block size of the coverage summary must be greater than 0."};
+
+            std::ptrdiff_t const variant_count = std::ranges::ssize(variants);
+            if (variant_count == 0)
+                return;
+
+            // Accumulates the coverages of a block in-place, starting from the empty coverage of the domain.
+            variant_coverage_type const & reference_coverage = libjst::coverage(*_first);
+            coverage_type const none = libjst::coverage_difference(reference_coverage, reference_coverage);
+
+            std::size_t const block_count = (variant_count + block_size - 1) / block_size;
+            _block_coverages.resize(block_count, none);
+            for (std::size_t block = 0; block < block_count; ++block) {
+                std::ptrdiff_t const block_begin = std::max<std::ptrdiff_t>(block * block_size, 1);
+                std::ptrdiff_t const block_end = std::min<std::ptrdiff_t>((block + 1) * block_size, variant_count - 1);
+                for (std::ptrdiff_t idx = block_begin; idx < block_end; ++idx)
+                    detail::assign_coverage_union(_block_coverages[block],
+                                                  _block_coverages[block],
+                                                  libjst::coverage(_first[idx]));
+            }
+        }
+        //!\}
+
+        //!\brief Returns the block of the given breakend.
+        constexpr std::size_t block_of(variant_iterator const & breakend) const noexcept {
+            assert(_block_size > 0);
+            return static_cast<std::size_t>(breakend - _first) / _block_size;
+        }
+
+        //!\brief Returns whether any variant of the given block is covered by the given path coverage.
+        template <typename path_coverage_t>
+        constexpr bool supports(std::size_t const block, path_coverage_t const & path_coverage) const noexcept {
+            assert(block < block_count());
+            return libjst::coverage_intersects(path_coverage, _block_coverages[block]);
+        }
+
+        //!\brief Returns the union of the coverages of the given block.
+        constexpr coverage_type const & block_coverage(std::size_t const block) const noexcept {
+            assert(block < block_count());
+            return _block_coverages[block];
+        }
+
+        //!\brief Returns the number of blocks.
+        constexpr std::size_t block_count() const noexcept {
+            return _block_coverages.size();
+        }
+
+        //!\brief Returns the number of breakends per block.
+        constexpr std::size_t block_size() const noexcept {
+            return _block_size;
+        }
+    };
+
+    namespace detail
+    {
+        //!\brief Whether the type is a libjst::coverage_block_summary.
+        template <typename t>
+        inline constexpr bool is_coverage_block_summary_v = false;
+
+        template <typename variant_map_t>
+        inline constexpr bool is_coverage_block_summary_v<coverage_block_summary<variant_map_t>> = true;
+    } // namespace detail
+}  // namespace libjst
@@ -12,29 +12,55 @@
 
 #pragma once
 
+#include <algorithm>
 #include <concepts>
+#include <cstddef>
 #include <exception>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <span>
 #include <type_traits>
+#include <utility>
 
 #include <libjst/sequence/journaled_sequence.hpp>
+#include <libjst/sequence_tree/tree_metrics.hpp>
 #include <libjst/variant/concept.hpp>
 
 namespace libjst
 {
 
-    template <std::integral position_t, typename source_t>
+    /*!\brief The label of a sequence tree node recording the alternate path sequence in a journaled sequence.
+     *
+     * \tparam position_t The type of the label positions.
+     * \tparam source_t The type of the source sequence.
+     * \tparam allocator_t The allocator of the journaled sequence; defaults to std::allocator.
+     *
+     * \details
+     *
+     * The journaled sequence is shared copy-on-write between the copies of a label. Copying the label of the parent
+     * into a child is thus O(1), and only a child recording a variant while its journal is still shared clones the
+     * journal before modifying it. The references to the reference children, which make up the vast majority of the
+     * nodes, never copy a journal, and the memory of a traversal is proportional to the number of distinct alternate
+     * paths it keeps alive. The returned sequences stay valid as long as a copy of the label with the same journal
+     * remains unmodified.
+     */
+    template <std::integral position_t, typename source_t, typename allocator_t = std::allocator<std::byte>>
         // requires source_t is a viewable range
     class journaled_sequence_label {
     private:
 
-        using journaled_sequence_type = journaled_sequence<source_t>;
+        using journaled_sequence_type = journaled_sequence<source_t, allocator_t>;
+        using journaled_sequence_allocator_type =
+            typename std::allocator_traits<allocator_t>::template rebind_alloc<journaled_sequence_type>;
         using journaled_sequence_iterator = std::ranges::iterator_t<journaled_sequence_type const>;
         using offset_type = std::make_signed_t<position_t>;
 
-        journaled_sequence_type _journaled_source{}; //!\brief Journal structure managing alternate path sequence.
+        std::shared_ptr<journaled_sequence_type> _journaled_source{}; //!\brief Shared journal of the alternate path sequence.
         position_t _left_position{}; //!\brief Left journaled sequence position marking begin of node label.
         position_t _right_position{}; //!\brief Right journaled sequence position marking end of node label.
         offset_type _offset{}; //!\brief Offset between journaled sequence positions and corresponding source position.
+        position_t _snv_run_begin{}; //!\brief Journaled sequence position behind the last recorded size changing variant.
 
     public:
 
@@ -46,16 +72,63 @@ namespace libjst
 
         journaled_sequence_label() = default;
         journaled_sequence_label(source_t source) noexcept :
-            _journaled_source{(source_t &&) source},
+            _journaled_source{std::allocate_shared<journaled_sequence_type>(journaled_sequence_allocator_type{},
+                                                                              (source_t &&) source)},
             _left_position{0},
-            _right_position{static_cast<position_t>(std::ranges::size(_journaled_source))}
+            _right_position{static_cast<position_t>(std::ranges::size(*_journaled_source))}
         {}
 
         constexpr sequence_type sequence(size_type const first = 0, size_type const last = npos) const noexcept {
             assert(first <= last);
-            size_type max_end = std::min<size_type>(last, std::ranges::size(_journaled_source));
-            return std::ranges::subrange{std::ranges::next(_journaled_source.begin(), to_alt_position(first)),
-                                         std::ranges::next(_journaled_source.begin(), to_alt_position(max_end))};
+            if (_journaled_source == nullptr)
+                return sequence_type{};
+
+            // The begin of the source is the begin of the path, including the insertions recorded before it.
+            journaled_sequence_type const & journaled_source = *_journaled_source;
+            size_type const path_first = (first == 0) ? 0 : to_path_position(first);
+            return std::ranges::subrange{std::ranges::next(journaled_source.begin(), path_first),
+                                         std::ranges::next(journaled_source.begin(), to_path_position(last))};
+        }
+
+        /*!\brief Returns the sequence `[first, last)` of the path as contiguous memory.
+         *
+         * \param[in] first The begin position of the sequence.
+         * \param[in] last The end position of the sequence; clamped to the size of the path sequence.
+         * \param[in, out] buffer The buffer to copy the sequence into, if it is not contiguous; must be resizable.
+         *
+         * \returns A std::span over the sequence.
+         *
+         * \details
+         *
+         * If the sequence lies within a single segment of the journal, e.g. within the source between two variants or
+         * within an alternate sequence, and the segments are stored contiguously, the returned span refers directly to
+         * the memory of the segment. Otherwise the sequence is copied into the buffer and the span refers to the
+         * buffer, which hence must not be modified while the span is in use. Sequences behind the last variant
+         * changing the size of the path are copied from the source at once and patched with the replaced symbols.
+         */
+        template <typename buffer_t>
+        constexpr auto contiguous_sequence(size_type const first, size_type const last, buffer_t & buffer) const
+            -> std::span<std::ranges::range_value_t<buffer_t> const>
+        {
+            using span_type = std::span<std::ranges::range_value_t<buffer_t> const>;
+            using segment_iterator = std::ranges::iterator_t<typename journaled_sequence_type::sequence_type>;
+
+            sequence_type seq = sequence(first, last);
+            if (std::ranges::empty(seq))
+                return span_type{};
+
+            if constexpr (std::contiguous_iterator<segment_iterator>) {
+                if (_journaled_source->is_single_segment(seq.begin(), seq.end()))
+                    return span_type{std::addressof(*seq.begin()), std::ranges::size(seq)};
+
+                if (std::ranges::distance(_journaled_source->begin(), seq.begin()) >=
+                    static_cast<offset_type>(_snv_run_begin))
+                    return patched_source_sequence(seq, buffer);
+            }
+
+            buffer.resize(std::ranges::size(seq));
+            libjst::segmented_copy(*_journaled_source, seq.begin(), seq.end(), std::ranges::data(buffer));
+            return span_type{std::ranges::data(buffer), std::ranges::size(buffer)};
         }
 
         constexpr sequence_type node_sequence() const noexcept {
@@ -87,27 +160,46 @@ namespace libjst
 
         template <typename variant_t>
         constexpr void record_variant(variant_t && variant) {
+            // SNVs, the majority of the variants, replace a single symbol and do not change the offset.
+            if constexpr (requires { { variant.is_snv() } -> std::convertible_to<bool>; }) {
+                if (variant.is_snv()) {
+                    record_snv(libjst::position(variant), libjst::alt_sequence(variant));
+                    return;
+                }
+            }
+
             record_variant_impl(variant);
             update_label_positions((variant_t &&)variant);
         }
 
     protected:
 
+        // The variants along a path are recorded from left to right and thus usually appended to the journal.
         template <typename variant_t>
         constexpr void record_variant_impl(variant_t && variant) {
-            auto const alt_position = _journaled_source.begin() + to_alt_position(libjst::low_breakend(variant)); // TODO: replace with low_breakend
+            journaled_sequence_type & journaled_source = unique_journaled_source();
+            position_type const alt_position = to_alt_position(libjst::low_breakend(variant));
+            auto record = [&] (std::size_t const deletion_size, auto && segment) {
+                if (journaled_source.accepts_append(alt_position)) {
+                    journaled_source.append_replace(alt_position, alt_position + deletion_size, (decltype(segment) &&) segment);
+                } else {
+                    auto const alt_it = journaled_source.begin() + alt_position;
+                    journaled_source.replace(alt_it, alt_it + deletion_size, (decltype(segment) &&) segment);
+                }
+            };
+
             auto alt_seq = libjst::alt_sequence(variant);
             switch (libjst::alt_kind(variant)) {
                 case alternate_sequence_kind::replacement: {
                     auto alt_seq_size = std::ranges::size(alt_seq);
-                    _journaled_source.replace(alt_position, alt_position + alt_seq_size, std::move(alt_seq));
+                    record(alt_seq_size, std::move(alt_seq));
                     break;
                 } case alternate_sequence_kind::deletion: {
                     auto && breakpt = libjst::get_breakpoint(variant);
-                    _journaled_source.erase(alt_position, alt_position + libjst::breakpoint_span(breakpt));
+                    record(libjst::breakpoint_span(breakpt), typename journaled_sequence_type::sequence_type{});
                     break;
                 } case alternate_sequence_kind::insertion: {
-                    _journaled_source.insert(alt_position, std::move(alt_seq));
+                    record(0, std::move(alt_seq));
                     break;
                 } default: {
                     //no-op
@@ -115,16 +207,88 @@ namespace libjst
             }
         }
 
+        /*!\brief Copies a sequence behind the last size changing variant by patching the source.
+         *
+         * \details
+         *
+         * Behind the last recorded variant changing the size of the path, all recorded variants are SNVs or other
+         * replacements of equal size, and the path maps position by position to the source. In SNV-dense regions the
+         * sequence is hence copied from the source at once and only the replaced symbols are written over it, instead
+         * of copying the alternating source and alternate segments one by one.
+         */
+        template <typename buffer_t>
+        constexpr auto patched_source_sequence(sequence_type const & seq, buffer_t & buffer) const
+            -> std::span<std::ranges::range_value_t<buffer_t> const>
+        {
+            journaled_sequence_type const & journaled_source = *_journaled_source;
+            auto const & source = journaled_source.source();
+            auto const * const source_begin = std::ranges::data(source);
+            auto const * const source_end = source_begin + std::ranges::size(source);
+
+            offset_type const path_first = std::ranges::distance(journaled_source.begin(), seq.begin());
+            buffer.resize(std::ranges::size(seq));
+            auto * out = std::ranges::data(buffer);
+            std::copy(source_begin + (path_first - _offset), source_begin + (path_first - _offset) + buffer.size(), out);
+            for (auto && segment : journaled_source.segments(seq.begin(), seq.end())) {
+                auto const * const segment_begin = std::ranges::data(segment);
+                if (std::less<>{}(segment_begin, source_begin) || !std::less<>{}(segment_begin, source_end))
+                    std::copy(segment_begin, segment_begin + std::ranges::size(segment), out);
+                out += std::ranges::size(segment);
+            }
+            return {std::ranges::data(buffer), std::ranges::size(buffer)};
+        }
+
+        //!\brief Records the SNV without dispatching on the kind of the variant.
+        template <typename alt_sequence_t>
+        constexpr void record_snv(position_type const ref_position, alt_sequence_t && alt_sequence) {
+            assert(std::ranges::size(alt_sequence) == 1);
+            journaled_sequence_type & journaled_source = unique_journaled_source();
+            position_type const alt_position = to_alt_position(ref_position);
+            if (journaled_source.accepts_append(alt_position)) {
+                journaled_source.append_replace(alt_position, alt_position + 1, (alt_sequence_t &&) alt_sequence);
+            } else {
+                auto const alt_it = journaled_source.begin() + alt_position;
+                journaled_source.replace(alt_it, alt_it + 1, (alt_sequence_t &&) alt_sequence);
+            }
+            reset_positions(alt_position, alt_position + 1);
+        }
+
+        //!\brief Clones the journal if it is shared with another label and returns the now exclusively owned journal.
+        journaled_sequence_type & unique_journaled_source() {
+            assert(_journaled_source != nullptr);
+            if (_journaled_source.use_count() > 1) {
+                detail::count_tree_metric<&tree_metrics::labelled, &adaptor_metrics::label_copies>();
+                detail::count_tree_metric<&tree_metrics::labelled, &adaptor_metrics::label_bytes>(
+                    _journaled_source->journal_bytes());
+                _journaled_source = std::allocate_shared<journaled_sequence_type>(journaled_sequence_allocator_type{},
+                                                                                  std::as_const(*_journaled_source));
+            }
+            return *_journaled_source;
+        }
+
         constexpr position_type to_alt_position(position_type const ref_position) const noexcept {
             assert(-_offset <= static_cast<offset_type>(ref_position));
             return ref_position + _offset;
         }
 
+        // Maps the source position to the path sequence and clamps it to the path, e.g. for a left extension reaching
+        // back across a deletion at the begin of the path or for a position behind the end of the path.
+        constexpr size_type to_path_position(size_type const ref_position) const noexcept {
+            offset_type const path_size = std::ranges::ssize(*_journaled_source);
+            if (ref_position >= static_cast<size_type>(path_size - _offset))
+                return path_size;
+            return std::max<offset_type>(static_cast<offset_type>(ref_position) + _offset, 0);
+        }
+
         template <typename variant_t>
         constexpr void update_label_positions(variant_t && variant) noexcept {
             position_type const alt_position = to_alt_position(libjst::low_breakend(variant));
-            reset_positions(alt_position, alt_position + std::ranges::size(libjst::alt_sequence(variant)));
-            _offset += libjst::effective_size(variant);
+            position_type const alt_end = alt_position + std::ranges::size(libjst::alt_sequence(variant));
+            reset_positions(alt_position, alt_end);
+            if (auto const effective_size = libjst::effective_size(variant); effective_size != 0) {
+                _offset += effective_size;
+                _snv_run_begin = alt_end;
+            }
         }
     };
 }  // namespace libjst
@@ -12,19 +12,49 @@
 
 #pragma once
 
+#include <cstddef>
+#include <memory>
 #include <type_traits>
+#include <vector>
 
 #include <libjst/utility/closure_object.hpp>
 #include <libjst/utility/copyable_box.hpp>
+#include <libjst/utility/thread_scratch.hpp>
 
+#include <libjst/sequence_tree/branch_jump_table.hpp>
 #include <libjst/sequence_tree/concept.hpp>
 #include <libjst/sequence_tree/journaled_sequence_label.hpp>
+#include <libjst/sequence_tree/tree_metrics.hpp>
 #include <libjst/variant/concept.hpp>
 
 namespace libjst
 {
 
-    template <typename wrapped_tree_t>
+    /*!\brief Adds the sequence labels to the nodes of the wrapped tree.
+     *
+     * \tparam wrapped_tree_t The type of the wrapped tree.
+     * \tparam label_allocator_t The allocator of the journals recorded by the labels; defaults to std::allocator.
+     *
+     * \details
+     *
+     * \tparam contiguous_labels_v Whether the label sequences are given as contiguous memory; defaults to `false`.
+     *
+     * \details
+     *
+     * Every child copies the label of its parent before recording its variant. With a libjst::arena_allocator the
+     * copied journals are allocated from the arena of the traversing thread.
+     *
+     * By default the label sequences are ranges over the segmented journaled sequence of the path. If
+     * contiguous_labels_v is `true`, e.g. created with libjst::contiguous_labelled, the sequences are
+     * std::span instead, such that matchers can scan them with vectorised kernels. The sequences of nodes within a
+     * single segment, e.g. the reference nodes, are spans into the source or the alternate sequence; all others are
+     * copied into a buffer that is shared by all nodes of one traversal, i.e. all nodes descending from the same root.
+     * Such a span is valid until the sequence of another node of the traversal is obtained. The buffer is acquired
+     * with libjst::acquire_scratch, such that consecutive traversals on one thread reuse its memory.
+     */
+    template <typename wrapped_tree_t,
+              typename label_allocator_t = std::allocator<std::byte>,
+              bool contiguous_labels_v = false>
     class labelled_tree {
     private:
         using base_node_type = libjst::tree_node_t<wrapped_tree_t>;
@@ -38,7 +68,16 @@ namespace libjst
 
         // static_assert(std::same_as<void, sequence_type>);
 
-        using label_strategy_type = journaled_sequence_label<position_type, sequence_type>;
+        using label_strategy_type = journaled_sequence_label<position_type, sequence_type, label_allocator_t>;
+        using label_value_type = std::ranges::range_value_t<typename label_strategy_type::sequence_type>;
+        using label_buffer_type =
+            std::vector<label_value_type,
+                        typename std::allocator_traits<label_allocator_t>::template rebind_alloc<label_value_type>>;
+        using label_buffer_allocator_type =
+            typename std::allocator_traits<label_allocator_t>::template rebind_alloc<label_buffer_type>;
+        struct no_label_buffer {};
+        using label_buffer_handle_type =
+            std::conditional_t<contiguous_labels_v, std::shared_ptr<label_buffer_type>, no_label_buffer>;
         using tree_box_t = copyable_box<wrapped_tree_t>;
 
         class node_impl;
@@ -60,7 +99,11 @@ namespace libjst
             base_node_type root_base = libjst::root(_wrappee.value());
             initial_label.reset_positions(libjst::position(root_base.low_boundary()),
                                           libjst::position(root_base.high_boundary()));
-            return node_impl{std::move(root_base), std::move(initial_label)};
+            label_buffer_handle_type label_buffer{};
+            if constexpr (contiguous_labels_v)
+                label_buffer = libjst::acquire_scratch<label_buffer_type>(label_buffer_allocator_type{});
+
+            return node_impl{std::move(root_base), std::move(initial_label), std::move(label_buffer)};
         }
 
         constexpr sink_type sink() const noexcept {
@@ -72,8 +115,8 @@ namespace libjst
         }
     };
 
-    template <typename wrapped_tree_t>
-    class labelled_tree<wrapped_tree_t>::node_impl : public base_node_type {
+    template <typename wrapped_tree_t, typename label_allocator_t, bool contiguous_labels_v>
+    class labelled_tree<wrapped_tree_t, label_allocator_t, contiguous_labels_v>::node_impl : public base_node_type {
     private:
 
         friend labelled_tree;
@@ -81,10 +124,14 @@ namespace libjst
         using base_t = base_node_type;
 
         label_strategy_type _label{};
+        [[no_unique_address]] label_buffer_handle_type _label_buffer{};
 
-        explicit constexpr node_impl(base_t && base_node, label_strategy_type label) noexcept :
+        explicit constexpr node_impl(base_t && base_node,
+                                     label_strategy_type label,
+                                     label_buffer_handle_type label_buffer) noexcept :
                 base_t{std::move(base_node)},
-                _label{std::move(label)}
+                _label{std::move(label)},
+                _label_buffer{std::move(label_buffer)}
         {}
 
     public:
@@ -103,17 +150,25 @@ namespace libjst
             return cargo_impl{this};
         }
 
+        //!\brief Forwards to the wrapped node, as the label does not change along the reference.
+        constexpr bool jump_ref(detail::ref_jump_target_t<base_t> target) noexcept
+            requires detail::ref_jumpable_node<base_t>
+        {
+            return base_t::jump_ref(std::move(target));
+        }
+
     private:
 
         template <bool is_alt>
         constexpr std::optional<node_impl> visit_next(std::optional<base_t> && base_child) const noexcept {
             if (base_child.has_value()) {
+                detail::count_tree_metric<&tree_metrics::labelled, &adaptor_metrics::nodes_created>();
                 // I need to check between alt_sequence and sequence between interval!
                 label_strategy_type child_label{_label};
                 if constexpr (is_alt) {
                     child_label.record_variant(*(base_child->low_boundary()));
                 }
-                return node_impl{std::move(*base_child), std::move(child_label)};
+                return node_impl{std::move(*base_child), std::move(child_label), _label_buffer};
             }
             return std::nullopt;
         }
@@ -124,8 +179,8 @@ namespace libjst
         }
     };
 
-    template <typename wrapped_tree_t>
-    class labelled_tree<wrapped_tree_t>::cargo_impl : public base_cargo_type {
+    template <typename wrapped_tree_t, typename label_allocator_t, bool contiguous_labels_v>
+    class labelled_tree<wrapped_tree_t, label_allocator_t, contiguous_labels_v>::cargo_impl : public base_cargo_type {
     private:
         [[no_unique_address]] node_impl const * _node{};
 
@@ -155,7 +210,10 @@ namespace libjst
         constexpr auto sequence(size_type const first, size_type const last) const noexcept {
             assert(_node != nullptr);
             assert(first <= last);
-            return _node->_label.sequence(first, last);
+            if constexpr (contiguous_labels_v)
+                return _node->_label.contiguous_sequence(first, last, *_node->_label_buffer);
+            else
+                return _node->_label.sequence(first, last);
         }
     };
 
@@ -257,28 +315,57 @@ namespace libjst
     // };
 
     namespace _tree_adaptor {
-        struct _labelled {
 
-            template <typename tree_t, typename ...args_t>
-            constexpr auto operator()(tree_t && tree, args_t &&... args) const
-                noexcept(std::is_nothrow_constructible_v<labelled_tree<std::remove_reference_t<tree_t>>>)
-                -> labelled_tree<std::remove_reference_t<tree_t>>
+        template <typename allocator_t>
+        concept label_allocator = requires (allocator_t & alloc)
+        {
+            typename allocator_t::value_type;
+            { alloc.allocate(std::size_t{1}) } -> std::same_as<typename allocator_t::value_type *>;
+        };
+
+        template <bool contiguous_labels_v>
+        struct _labelled_fn {
+
+            template <typename tree_t>
+                requires (!label_allocator<std::remove_cvref_t<tree_t>>)
+            constexpr auto operator()(tree_t && tree) const
+                noexcept(std::is_nothrow_constructible_v<labelled_tree<std::remove_reference_t<tree_t>,
+                                                                       std::allocator<std::byte>,
+                                                                       contiguous_labels_v>,
+                                                         tree_t>)
+                -> labelled_tree<std::remove_reference_t<tree_t>, std::allocator<std::byte>, contiguous_labels_v>
+            {
+                return (*this)((tree_t &&)tree, std::allocator<std::byte>{});
+            }
+
+            //!\brief The allocator only selects the allocator type of the labels.
+            template <typename tree_t, label_allocator allocator_t>
+                requires (!label_allocator<std::remove_cvref_t<tree_t>>)
+            constexpr auto operator()(tree_t && tree, allocator_t const &) const
+                noexcept(std::is_nothrow_constructible_v<labelled_tree<std::remove_reference_t<tree_t>,
+                                                                       allocator_t,
+                                                                       contiguous_labels_v>,
+                                                         tree_t>)
+                -> labelled_tree<std::remove_reference_t<tree_t>, allocator_t, contiguous_labels_v>
             {
-                using adapted_tree_t = labelled_tree<std::remove_reference_t<tree_t>>;
-                return adapted_tree_t{(tree_t &&)tree, (args_t &&)args...};
+                using adapted_tree_t = labelled_tree<std::remove_reference_t<tree_t>, allocator_t, contiguous_labels_v>;
+                return adapted_tree_t{(tree_t &&)tree};
             }
 
-            template <typename ...args_t>
-            constexpr auto operator()(args_t &&... args) const
-                noexcept(std::is_nothrow_invocable_v<libjst::tag_t<libjst::make_closure>, _labelled,  args_t...>)
-                -> libjst::closure_result_t<_labelled, args_t...>
+            template <label_allocator ...allocators_t>
+                requires (sizeof...(allocators_t) <= 1)
+            constexpr auto operator()(allocators_t const &... allocs) const
+                noexcept(std::is_nothrow_invocable_v<libjst::tag_t<libjst::make_closure>, _labelled_fn, allocators_t...>)
+                -> libjst::closure_result_t<_labelled_fn, allocators_t...>
             {
-                return libjst::make_closure(_labelled{}, (args_t &&)args...);
+                return libjst::make_closure(_labelled_fn{}, allocs...);
             }
         };
 
-        inline constexpr _labelled labelled{};
+        inline constexpr _labelled_fn<false> labelled{};
+        inline constexpr _labelled_fn<true> contiguous_labelled{};
     } // namespace _tree_adaptor
 
     using _tree_adaptor::labelled;
+    using _tree_adaptor::contiguous_labelled;
 }  // namespace libjst
@@ -12,15 +12,29 @@
 
 #pragma once
 
+#include <cstddef>
+#include <type_traits>
+
 #include <libjst/utility/closure_object.hpp>
 
+#include <libjst/sequence_tree/branch_jump_table.hpp>
 #include <libjst/sequence_tree/concept.hpp>
 #include <libjst/sequence_tree/breakend_site_trimmed.hpp>
 
 namespace libjst
 {
 
-    template <typename base_tree_t>
+    /*!\brief Extends the labels of the wrapped tree by the given number of preceding symbols.
+     *
+     * \tparam base_tree_t The type of the wrapped tree.
+     * \tparam extension_t The type of the left extension; a std::integral_constant if the extension is known at
+     *                     compile time, e.g. for patterns with a static window size, see libjst::static_window_size_v.
+     *
+     * \details
+     *
+     * A static extension is not stored in the tree or its nodes and the boundary arithmetic folds the constant.
+     */
+    template <typename base_tree_t, typename extension_t = std::ptrdiff_t>
     class left_extend_tree_impl {
     private:
 
@@ -33,16 +47,17 @@ namespace libjst
         class cargo_impl;
 
         base_tree_t _wrappee{};
-        offset_type _offset{};
+        [[no_unique_address]] extension_t _offset{};
 
     public:
 
-        template <typename wrappee_t, std::integral offset_t>
+        template <typename wrappee_t, typename offset_t>
             requires (!std::same_as<std::remove_cvref_t<wrappee_t>, left_extend_tree_impl> &&
-                      std::constructible_from<base_tree_t, wrappee_t>)
+                      std::constructible_from<base_tree_t, wrappee_t> &&
+                      (std::integral<offset_t> || std::same_as<offset_t, extension_t>))
         constexpr explicit left_extend_tree_impl(wrappee_t && wrappee, offset_t offset) noexcept :
             _wrappee{(wrappee_t &&)wrappee},
-            _offset{static_cast<offset_type>(offset)}
+            _offset{static_cast<extension_t>(offset)}
         {
             assert(_offset >= 0);
         }
@@ -62,18 +77,18 @@ namespace libjst
         }
     };
 
-    template <typename base_tree_t>
-    class left_extend_tree_impl<base_tree_t>::node_impl : public base_node_type {
+    template <typename base_tree_t, typename extension_t>
+    class left_extend_tree_impl<base_tree_t, extension_t>::node_impl : public base_node_type {
     private:
         using base_low_position_type = std::remove_cvref_t<decltype(std::declval<base_node_type const &>().low_boundary())>;
         using base_high_position_type = std::remove_cvref_t<decltype(std::declval<base_node_type const &>().high_boundary())>;
 
         friend left_extend_tree_impl;
 
-        offset_type _offset{};
+        [[no_unique_address]] extension_t _offset{};
         offset_type _lowest{};
 
-        explicit constexpr node_impl(base_node_type && base_node, offset_type offset, offset_type lowest) noexcept :
+        explicit constexpr node_impl(base_node_type && base_node, extension_t offset, offset_type lowest) noexcept :
             base_node_type{std::move(base_node)},
             _offset{offset},
             _lowest{lowest}
@@ -102,10 +117,17 @@ namespace libjst
             using position_value_t = typename low_position_type::position_value_type;
             base_low_position_type base_low = base_node_type::low_boundary();
             position_value_t low_position = libjst::position(base_low);
-            low_position = std::max<offset_type>(low_position - _offset, _lowest);
+            low_position = std::max<offset_type>(low_position - static_cast<offset_type>(_offset), _lowest);
             return low_position_type{std::move(base_low), low_position};
         }
 
+        //!\brief Forwards to the wrapped node, as the left extension does not change along the reference.
+        constexpr bool jump_ref(detail::ref_jump_target_t<base_node_type> target) noexcept
+            requires detail::ref_jumpable_node<base_node_type>
+        {
+            return base_node_type::jump_ref(std::move(target));
+        }
+
     private:
 
         constexpr std::optional<node_impl> visit(auto maybe_child) const {
@@ -122,8 +144,8 @@ namespace libjst
         }
     };
 
-    template <typename base_tree_t>
-    class left_extend_tree_impl<base_tree_t>::cargo_impl : public base_cargo_type {
+    template <typename base_tree_t, typename extension_t>
+    class left_extend_tree_impl<base_tree_t, extension_t>::cargo_impl : public base_cargo_type {
     private:
 
         friend left_extend_tree_impl;
@@ -160,6 +182,26 @@ namespace libjst
                 return left_extend_tree_impl<labelled_tree_t>{(labelled_tree_t &&) tree, std::move(left_extension)};
             }
 
+            //!\brief Extends by a left extension known at compile time, which is not stored in the nodes.
+            template <typename labelled_tree_t, std::integral left_extension_t, left_extension_t left_extension>
+            constexpr auto operator()(labelled_tree_t && tree,
+                                      std::integral_constant<left_extension_t, left_extension>) const
+                -> left_extend_tree_impl<labelled_tree_t, std::integral_constant<std::ptrdiff_t, left_extension>>
+            {
+                static_assert(left_extension >= 0, "The left extension must not be negative.");
+                using extension_t = std::integral_constant<std::ptrdiff_t, left_extension>;
+                return left_extend_tree_impl<labelled_tree_t, extension_t>{(labelled_tree_t &&) tree, extension_t{}};
+            }
+
+            template <std::integral left_extension_t, left_extension_t left_extension>
+            constexpr auto operator()(std::integral_constant<left_extension_t, left_extension> extension) const
+                noexcept(std::is_nothrow_invocable_v<libjst::tag_t<libjst::make_closure>,
+                                                     std::integral_constant<left_extension_t, left_extension>>)
+                -> libjst::closure_result_t<_left_extend, std::integral_constant<left_extension_t, left_extension>>
+            {
+                return libjst::make_closure(_left_extend{}, extension);
+            }
+
             template <std::integral left_extension_t>
             constexpr auto operator()(left_extension_t const left_extension) const
                 noexcept(std::is_nothrow_invocable_v<libjst::tag_t<libjst::make_closure>, left_extension_t>)
@@ -0,0 +1,113 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides a forest over the unmasked source intervals of a store.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <ranges>
+#include <vector>
+
+#include <libjst/rcms/source_mask.hpp>
+#include <libjst/sequence_tree/partial_tree.hpp>
+
+namespace libjst
+{
+    /*!\brief The partial trees over the unmasked source intervals of a store.
+     *
+     * \tparam rcs_store_t The type of the store.
+     *
+     * \details
+     *
+     * The masked intervals, e.g. the runs of `N` of libjst::rcs_store::n_run_mask merged with the intervals masked by
+     * the user, are omitted entirely: the forest holds one libjst::partial_tree per unmasked interval, such that the
+     * reference nodes end at the mask boundaries and neither the masked source nor the variants within it are fed to
+     * the matchers. The forest is a random access range and can be traversed tree by tree or by a
+     * libjst::parallel_chunk_traverser, for which the unmasked intervals can be split into trees of a maximal size.
+     *
+     * Like for libjst::chunked_tree_impl::owned_chunk, the traversers left extend the label of the first node of a
+     * tree into the preceding source, and a tree reports exactly the hits whose last symbol lies within its interval.
+     * Hence, the hits ending in a masked interval are dropped, while a hit ending behind the mask may start within it.
+     * The variants starting within a masked interval are skipped, including deletions extending beyond it.
+     *
+     * The forest refers to the store, which must outlive it.
+     */
+    template <typename rcs_store_t>
+    class masked_forest {
+    private:
+
+        using tree_type = partial_tree<rcs_store_t>;
+        using size_type = typename tree_type::size_type;
+
+        rcs_store_t const * _rcs_store{};
+        std::vector<source_interval> _intervals{};
+        std::vector<tree_type> _trees{};
+
+    public:
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        masked_forest() = default; //!< Default.
+
+        /*!\brief Builds the partial trees of the unmasked intervals of the store.
+         *
+         * \param[in] rcs_store The store.
+         * \param[in] mask The masked source intervals.
+         * \param[in] max_tree_size The unmasked intervals are split into trees of at most this many source positions.
+         */
+        masked_forest(rcs_store_t const & rcs_store,
+                      source_mask const & mask,
+                      std::size_t const max_tree_size = std::numeric_limits<std::size_t>::max()) :
+            _rcs_store{&rcs_store},
+            _intervals{mask.unmasked(std::ranges::size(rcs_store.source()), max_tree_size)}
+        {
+            _trees.reserve(_intervals.size());
+            std::ranges::for_each(_intervals, [&] (source_interval const & interval) {
+                _trees.emplace_back(rcs_store, static_cast<size_type>(interval.begin),
+                                    static_cast<size_type>(interval.size()));
+            });
+        }
+        //!\}
+
+        constexpr tree_type const & operator[](std::ptrdiff_t const step) const noexcept {
+            return _trees[step];
+        }
+
+        constexpr auto begin() const noexcept {
+            return _trees.begin();
+        }
+
+        constexpr auto end() const noexcept {
+            return _trees.end();
+        }
+
+        constexpr std::size_t size() const noexcept {
+            return _trees.size();
+        }
+
+        //!\brief Returns the source interval of the tree with the given index.
+        constexpr source_interval const & interval(std::size_t const tree_idx) const noexcept {
+            return _intervals[tree_idx];
+        }
+
+        //!\brief Returns the tree with the given index, which has no overlap to the succeeding tree.
+        constexpr tree_type owned_chunk(std::size_t const tree_idx) const noexcept {
+            return _trees[tree_idx];
+        }
+
+        constexpr rcs_store_t const & data() const noexcept {
+            return *_rcs_store;
+        }
+    };
+}  // namespace libjst
@@ -12,25 +12,53 @@
 
 #pragma once
 
+#include <cassert>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+
 #include <libjst/utility/closure_object.hpp>
 
+#include <libjst/sequence_tree/branch_jump_table.hpp>
 #include <libjst/sequence_tree/concept.hpp>
 #include <libjst/sequence_tree/node_descriptor.hpp>
+#include <libjst/sequence_tree/tree_metrics.hpp>
 #include <libjst/variant/breakpoint.hpp>
 
 namespace libjst
 {
-    template <typename base_tree_t>
+    /*!\brief Merges the nodes of the wrapped tree into maximal branch-free nodes.
+     *
+     * \tparam base_tree_t The type of the wrapped tree.
+     * \tparam jump_table_t The type of the libjst::branch_jump_table, or `void`.
+     *
+     * \details
+     *
+     * A node is extended by its reference children until its high boundary is a low end, i.e. until the next node
+     * branches. Without a jump table, every breakend in between, e.g. the high ends of the deletions, is visited.
+     * With a libjst::branch_jump_table, e.g. `merge(table)`, a reference node moves to the next branching breakend
+     * in one step. If all wrapped nodes support it, see libjst::detail::ref_jumpable_node, the node is moved in place
+     * by every step, such that the wrapped adaptors neither create nor copy a child, e.g. the label of
+     * libjst::labelled_tree or the path coverage of libjst::prune_tree; this is the case for the adaptors of the
+     * standard search pipeline. Otherwise, or if a wrapped node declines the move, the node is replaced by its
+     * reference child.
+     */
+    template <typename base_tree_t, typename jump_table_t = void>
     class merge_tree_impl {
     private:
         using base_node_type = libjst::tree_node_t<base_tree_t>;
         using sink_type = libjst::tree_sink_t<base_tree_t>;
         using base_cargo_type = libjst::tree_label_t<base_tree_t>;
 
+        struct no_jump_table {};
+        static constexpr bool has_jump_table = !std::is_void_v<jump_table_t>;
+        using jump_table_handle_type = std::conditional_t<has_jump_table, jump_table_t const *, no_jump_table>;
+
         class node_impl;
         class cargo_impl;
 
         base_tree_t _wrappee{};
+        [[no_unique_address]] jump_table_handle_type _jump_table{};
 
     public:
         /*!\name Constructors, destructor and assignment
@@ -44,12 +72,21 @@ namespace libjst
         explicit constexpr merge_tree_impl(wrapped_tree_t && wrappee) noexcept :
             _wrappee{(wrapped_tree_t &&)wrappee}
         {}
+
+        //!\brief Extends the nodes with the given jump table, which must outlive the tree.
+        template <typename wrapped_tree_t, typename other_jump_table_t>
+            requires (std::same_as<other_jump_table_t, jump_table_t> &&
+                      std::constructible_from<base_tree_t, wrapped_tree_t>)
+        explicit constexpr merge_tree_impl(wrapped_tree_t && wrappee, other_jump_table_t const & jump_table) noexcept :
+            _wrappee{(wrapped_tree_t &&)wrappee},
+            _jump_table{std::addressof(jump_table)}
+        {}
         //!\}
 
         constexpr node_impl root() const noexcept {
             base_node_type base_root = libjst::root(_wrappee);
             auto root_low = base_root.low_boundary();
-            return node_impl{std::move(base_root), std::move(root_low)};
+            return node_impl{std::move(base_root), std::move(root_low), _jump_table};
         }
 
         constexpr sink_type sink() const noexcept {
@@ -61,8 +98,8 @@ namespace libjst
         }
    };
 
-    template <typename base_tree_t>
-    class merge_tree_impl<base_tree_t>::node_impl : public base_node_type {
+    template <typename base_tree_t, typename jump_table_t>
+    class merge_tree_impl<base_tree_t, jump_table_t>::node_impl : public base_node_type {
     public:
 
         using low_position_type = std::remove_cvref_t<decltype(std::declval<base_node_type const &>().low_boundary())>;
@@ -72,10 +109,14 @@ namespace libjst
         friend merge_tree_impl;
 
         low_position_type _low_boundary{};
+        [[no_unique_address]] jump_table_handle_type _jump_table{};
 
-        explicit constexpr node_impl(base_node_type && base_node, low_position_type cached_low) noexcept :
+        explicit constexpr node_impl(base_node_type && base_node,
+                                     low_position_type cached_low,
+                                     jump_table_handle_type jump_table) noexcept :
             base_node_type{std::move(base_node)},
-            _low_boundary{std::move(cached_low)}
+            _low_boundary{std::move(cached_low)},
+            _jump_table{jump_table}
         {}
 
     public:
@@ -112,8 +153,9 @@ namespace libjst
         template <bool is_alt_child>
         constexpr std::optional<node_impl> visit_next(auto maybe_child) const {
             if (maybe_child) {
+                detail::count_tree_metric<&tree_metrics::merge, &adaptor_metrics::nodes_created>();
                 low_position_type cached_low = maybe_child->low_boundary();
-                node_impl new_child{std::move(*maybe_child), std::move(cached_low)};
+                node_impl new_child{std::move(*maybe_child), std::move(cached_low), _jump_table};
                 new_child.extend();
                 return new_child;
             } else {
@@ -123,7 +165,14 @@ namespace libjst
 
         constexpr void extend() {
             while (!base_node_type::high_boundary().is_low_end()) {
+                if (jump_to_next_breakend()) {
+                    detail::count_tree_metric<&tree_metrics::merge, &adaptor_metrics::extend_steps>();
+                    detail::count_tree_metric<&tree_metrics::merge, &adaptor_metrics::ref_jumps>();
+                    continue;
+                }
+
                 if (auto successor = base_node_type::next_ref(); successor) {
+                    detail::count_tree_metric<&tree_metrics::merge, &adaptor_metrics::extend_steps>();
                     static_cast<base_node_type &>(*this) = std::move(*successor);
 
                 } else {
@@ -132,14 +181,31 @@ namespace libjst
             }
         }
 
+        // Moves the node in place to the next branching breakend if a jump table is given, or else to the next
+        // breakend. The wrapped nodes decline the move, e.g. for a variant node, which is then replaced by its child.
+        constexpr bool jump_to_next_breakend() noexcept {
+            if constexpr (detail::ref_jumpable_node<base_node_type>) {
+                auto high_breakend = base_node_type::high_boundary().get_breakend();
+                if constexpr (has_jump_table) {
+                    assert(_jump_table != nullptr);
+                    auto next_branch = _jump_table->next_branch(high_breakend);
+                    if (std::ranges::distance(high_breakend, next_branch) > 1)
+                        return base_node_type::jump_ref(std::move(next_branch));
+                }
+                return base_node_type::jump_ref(std::ranges::next(std::move(high_breakend)));
+            } else {
+                return false;
+            }
+        }
+
         constexpr friend bool operator==(node_impl const & lhs, sink_type const & rhs) noexcept
         {
             return static_cast<base_node_type const &>(lhs) == rhs;
         }
     };
 
-    template <typename base_tree_t>
-    class merge_tree_impl<base_tree_t>::cargo_impl : public base_cargo_type {
+    template <typename base_tree_t, typename jump_table_t>
+    class merge_tree_impl<base_tree_t, jump_table_t>::cargo_impl : public base_cargo_type {
     private:
         using position_type = typename base_node_type::position_type;
 
@@ -173,14 +239,44 @@ namespace libjst
     namespace _tree_adaptor {
         inline constexpr struct _merge
         {
-            template <typename covered_tree_t, typename ...args_t>
-            constexpr auto operator()(covered_tree_t && tree, args_t &&... args) const
-                noexcept(std::is_nothrow_constructible_v<
-                            merge_tree_impl<std::remove_reference_t<covered_tree_t>>, args_t...>)
-                -> merge_tree_impl<std::remove_reference_t<covered_tree_t>, args_t...>
+            template <typename covered_tree_t>
+                requires (!detail::is_branch_jump_table_v<std::remove_cvref_t<covered_tree_t>>)
+            constexpr auto operator()(covered_tree_t && tree) const
+                noexcept(std::is_nothrow_constructible_v<merge_tree_impl<std::remove_reference_t<covered_tree_t>>,
+                                                         covered_tree_t>)
+                -> merge_tree_impl<std::remove_reference_t<covered_tree_t>>
+            {
+                using adapted_tree_t = merge_tree_impl<std::remove_reference_t<covered_tree_t>>;
+                return adapted_tree_t{(covered_tree_t &&)tree};
+            }
+
+            //!\brief Extends the nodes with the given libjst::branch_jump_table.
+            template <typename covered_tree_t, typename jump_table_t>
+                requires detail::is_branch_jump_table_v<jump_table_t>
+            constexpr auto operator()(covered_tree_t && tree, jump_table_t const * jump_table) const noexcept
+                -> merge_tree_impl<std::remove_reference_t<covered_tree_t>, jump_table_t>
+            {
+                assert(jump_table != nullptr);
+                using adapted_tree_t = merge_tree_impl<std::remove_reference_t<covered_tree_t>, jump_table_t>;
+                return adapted_tree_t{(covered_tree_t &&)tree, *jump_table};
+            }
+
+            template <typename covered_tree_t, typename jump_table_t>
+                requires detail::is_branch_jump_table_v<std::remove_cvref_t<jump_table_t>>
+            constexpr auto operator()(covered_tree_t && tree, jump_table_t && jump_table) const noexcept
+                -> merge_tree_impl<std::remove_reference_t<covered_tree_t>, std::remove_cvref_t<jump_table_t>>
+            {
+                return (*this)((covered_tree_t &&)tree, std::addressof(jump_table));
+            }
+
+            //!\brief The closure refers to the jump table, which must outlive the adapted tree.
+            template <typename jump_table_t>
+                requires detail::is_branch_jump_table_v<std::remove_cvref_t<jump_table_t>>
+            constexpr auto operator()(jump_table_t && jump_table) const noexcept
+                -> libjst::closure_result_t<_merge, std::remove_cvref_t<jump_table_t> const *>
             {
-                using adapted_tree_t = merge_tree_impl<std::remove_reference_t<covered_tree_t>, args_t...>;
-                return adapted_tree_t{(covered_tree_t &&)tree, (args_t &&)args...};
+                std::remove_cvref_t<jump_table_t> const * jump_table_ptr = std::addressof(jump_table);
+                return libjst::make_closure(_merge{}, jump_table_ptr);
             }
 
             template <typename ...args_t>
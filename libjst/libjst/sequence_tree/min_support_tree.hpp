@@ -0,0 +1,186 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides a tree adaptor skipping the variants below a minimal support.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <optional>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+
+#include <libjst/utility/closure_object.hpp>
+
+#include <libjst/rcms/carrier_count_index.hpp>
+#include <libjst/sequence_tree/branch_jump_table.hpp>
+#include <libjst/sequence_tree/concept.hpp>
+
+namespace libjst
+{
+    /*!\brief A tree adaptor removing the alternate children of the variants carried by too few haplotypes.
+     *
+     * \tparam base_tree_t The type of the wrapped tree, e.g. libjst::volatile_tree or libjst::partial_tree.
+     *
+     * \details
+     *
+     * An alternate child is only created if its variant is carried by at least the minimal support of haplotypes,
+     * which is looked up in the libjst::carrier_count_index of the variant map, see
+     * libjst::dna_compressed_multisequence::build_carrier_count_index. The adaptor is applied directly to the tree
+     * over the store, i.e. `libjst::volatile_tree{store} | libjst::min_support(n) | libjst::labelled() | ...`, such
+     * that the rare variants are removed before any label is built or coverage is intersected by libjst::coloured_tree
+     * and libjst::prune_tree.
+     *
+     * The tree thus holds the sequences of the haplotypes with all rare variants reverted to the reference. The nodes
+     * report the skipped variant at their high boundary with `skips_high_variant()`, such that libjst::prune_tree
+     * keeps its carriers on an alternate path reaching it instead of subtracting them.
+     */
+    template <typename base_tree_t>
+    class min_support_tree_impl {
+    private:
+        using base_node_type = libjst::tree_node_t<base_tree_t>;
+        using sink_type = libjst::tree_sink_t<base_tree_t>;
+        using breakend_iterator = std::remove_cvref_t<
+                decltype(std::declval<base_node_type const &>().low_boundary().get_breakend())>;
+
+        //!\brief The state shared by all nodes to look up the carrier count of a breakend.
+        struct support_filter {
+            carrier_count_index const * carrier_counts{};
+            breakend_iterator first{};
+            std::size_t min_support{};
+
+            constexpr bool supports(breakend_iterator const & breakend) const noexcept {
+                return carrier_counts->is_supported(static_cast<std::size_t>(breakend - first), min_support);
+            }
+        };
+
+        class node_impl;
+
+        base_tree_t _wrappee{};
+        std::size_t _min_support{};
+
+    public:
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        constexpr min_support_tree_impl() = default; //!< Default.
+
+        /*!\brief Skips the variants carried by fewer than the given number of haplotypes.
+         *
+         * \throws std::invalid_argument if the carrier count index of the variant map was not built.
+         */
+        template <typename wrapped_tree_t>
+            requires (!std::same_as<std::remove_cvref_t<wrapped_tree_t>, min_support_tree_impl> &&
+                      std::constructible_from<base_tree_t, wrapped_tree_t>)
+        constexpr min_support_tree_impl(wrapped_tree_t && wrappee, std::size_t const min_support) :
+            _wrappee{(wrapped_tree_t &&)wrappee},
+            _min_support{min_support}
+        {
+            if (!data().variants().has_carrier_count_index())
+                throw std::invalid_argument{"The carrier count index of the variants must be built first!"};
+        }
+        //!\}
+
+        constexpr node_impl root() const noexcept {
+            support_filter filter{.carrier_counts = std::addressof(data().variants().carrier_counts()),
+                                  .first = std::ranges::begin(data().variants()),
+                                  .min_support = _min_support};
+            return node_impl{libjst::root(_wrappee), std::move(filter)};
+        }
+
+        constexpr sink_type sink() const noexcept {
+            return libjst::sink(_wrappee);
+        }
+
+        constexpr auto const & data() const noexcept {
+            return _wrappee.data();
+        }
+
+        constexpr std::size_t min_support() const noexcept {
+            return _min_support;
+        }
+    };
+
+    template <typename base_tree_t>
+    class min_support_tree_impl<base_tree_t>::node_impl : public base_node_type {
+    private:
+
+        friend min_support_tree_impl;
+
+        support_filter _filter{};
+
+        explicit constexpr node_impl(base_node_type && base_node, support_filter filter) noexcept :
+            base_node_type{std::move(base_node)},
+            _filter{std::move(filter)}
+        {}
+
+    public:
+
+        node_impl() = default;
+
+        constexpr std::optional<node_impl> next_alt() const noexcept {
+            if (skips_high_variant())
+                return std::nullopt;
+            if (auto maybe_child = base_node_type::next_alt(); maybe_child)
+                return node_impl{std::move(*maybe_child), _filter};
+            return std::nullopt;
+        }
+
+        constexpr std::optional<node_impl> next_ref() const noexcept {
+            if (auto maybe_child = base_node_type::next_ref(); maybe_child)
+                return node_impl{std::move(*maybe_child), _filter};
+            return std::nullopt;
+        }
+
+        //!\brief Returns whether the variant beginning at the high boundary is skipped, whose carriers stay on the path.
+        constexpr bool skips_high_variant() const noexcept {
+            return this->high_boundary().is_low_end() && !_filter.supports(this->high_boundary().get_breakend());
+        }
+
+        //!\brief Forwards to the wrapped node, as only the alternate children are filtered.
+        constexpr bool jump_ref(detail::ref_jump_target_t<base_node_type> target) noexcept
+            requires detail::ref_jumpable_node<base_node_type>
+        {
+            return base_node_type::jump_ref(std::move(target));
+        }
+
+    private:
+
+        constexpr friend bool operator==(node_impl const & lhs, sink_type const & rhs) noexcept
+        {
+            return static_cast<base_node_type const &>(lhs) == rhs;
+        }
+    };
+
+    namespace _tree_adaptor {
+        inline constexpr struct _min_support
+        {
+            template <typename base_tree_t, std::unsigned_integral min_support_t>
+            constexpr auto operator()(base_tree_t && tree, min_support_t const min_support) const
+                -> min_support_tree_impl<std::remove_cvref_t<base_tree_t>>
+            {
+                using adapted_tree_t = min_support_tree_impl<std::remove_cvref_t<base_tree_t>>;
+                return adapted_tree_t{(base_tree_t &&)tree, static_cast<std::size_t>(min_support)};
+            }
+
+            template <std::unsigned_integral min_support_t>
+            constexpr auto operator()(min_support_t const min_support) const
+                noexcept(std::is_nothrow_invocable_v<libjst::tag_t<libjst::make_closure>, min_support_t>)
+                -> libjst::closure_result_t<_min_support, min_support_t>
+            {
+                return libjst::make_closure(_min_support{}, min_support);
+            }
+        } min_support{};
+    } // namespace _tree_adaptor
+
+    using _tree_adaptor::min_support;
+}  // namespace libjst
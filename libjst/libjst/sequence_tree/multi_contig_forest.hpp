@@ -0,0 +1,229 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides a forest of the chunks of all contigs of a multi contig store.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <cassert>
+#include <compare>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <ranges>
+#include <vector>
+
+#include <libjst/sequence_tree/partial_tree.hpp>
+
+namespace libjst
+{
+    /*!\brief The chunks of all contigs of a libjst::multi_contig_store or libjst::mapped_multi_contig_store.
+     *
+     * \tparam multi_store_t The type of the multi contig container.
+     *
+     * \details
+     *
+     * Every contig is split into chunks of the same size like in libjst::chunked_tree_impl, and the chunks of all
+     * contigs form one random access range of libjst::partial_tree in the order of the contigs. Hence, a
+     * libjst::parallel_chunk_traverser schedules the chunks of all contigs from one work queue, which balances the
+     * work of a whole genome across the threads, regardless of the lengths of the individual contigs.
+     * The contig and the source interval of a chunk are returned by contig_of and chunk_begin, e.g. to locate a hit
+     * reported for a chunk index.
+     *
+     * The contig stores are accessed when the forest is constructed, which maps all contigs of a
+     * libjst::mapped_multi_contig_store. The container must outlive the forest.
+     */
+    template <typename multi_store_t>
+    class multi_contig_forest {
+    private:
+
+        using store_type = typename multi_store_t::store_type;
+        using chunk_type = partial_tree<store_type>;
+        using position_type = typename chunk_type::size_type;
+
+        //!\brief The contig index and the first source position of a chunk.
+        struct chunk_location {
+            std::size_t contig{};
+            std::size_t begin{};
+        };
+
+        class iterator;
+
+        std::vector<std::reference_wrapper<store_type const>> _contigs{};
+        std::vector<chunk_location> _chunks{};
+        std::size_t _chunk_size{};
+        std::size_t _overlap_size{};
+
+    public:
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        multi_contig_forest() = default; //!< Default.
+
+        /*!\brief Splits all contigs of the given container into chunks.
+         *
+         * \param[in] multi_store The multi contig container.
+         * \param[in] chunk_size The number of source positions of every chunk; must be greater than 0.
+         * \param[in] overlap_size The number of source positions a chunk extends beyond its end.
+         */
+        multi_contig_forest(multi_store_t const & multi_store,
+                            std::size_t const chunk_size,
+                            std::size_t const overlap_size = 0) :
+            _chunk_size{chunk_size},
+            _overlap_size{overlap_size}
+        {
+            assert(chunk_size > 0);
+            _contigs.reserve(multi_store.contig_count());
+            for (std::size_t contig_idx = 0; contig_idx < multi_store.contig_count(); ++contig_idx) {
+                store_type const & contig = multi_store.contig(contig_idx);
+                _contigs.push_back(std::cref(contig));
+                std::size_t const source_size = std::ranges::size(contig.source());
+                for (std::size_t chunk_begin = 0; chunk_begin < source_size; chunk_begin += chunk_size)
+                    _chunks.push_back(chunk_location{.contig = contig_idx, .begin = chunk_begin});
+            }
+        }
+        //!\}
+
+        constexpr chunk_type operator[](std::ptrdiff_t const step) const noexcept {
+            chunk_location const & location = _chunks[step];
+            return chunk_type{_contigs[location.contig].get(),
+                              static_cast<position_type>(location.begin),
+                              static_cast<position_type>(_chunk_size + _overlap_size)};
+        }
+
+        //!\brief Returns the chunk with the given index without the overlap, see libjst::chunked_tree_impl::owned_chunk.
+        constexpr chunk_type owned_chunk(std::size_t const chunk_idx) const noexcept {
+            chunk_location const & location = _chunks[chunk_idx];
+            return chunk_type{_contigs[location.contig].get(),
+                              static_cast<position_type>(location.begin),
+                              static_cast<position_type>(_chunk_size)};
+        }
+
+        constexpr iterator begin() const noexcept {
+            return iterator{this, 0};
+        }
+
+        constexpr iterator end() const noexcept {
+            return iterator{this, static_cast<std::ptrdiff_t>(size())};
+        }
+
+        constexpr std::size_t size() const noexcept {
+            return _chunks.size();
+        }
+
+        //!\brief Returns the index of the contig of the chunk with the given index.
+        constexpr std::size_t contig_of(std::size_t const chunk_idx) const noexcept {
+            return _chunks[chunk_idx].contig;
+        }
+
+        //!\brief Returns the first source position of the chunk with the given index on its contig.
+        constexpr std::size_t chunk_begin(std::size_t const chunk_idx) const noexcept {
+            return _chunks[chunk_idx].begin;
+        }
+
+        constexpr std::size_t chunk_size() const noexcept {
+            return _chunk_size;
+        }
+
+        constexpr std::size_t overlap_size() const noexcept {
+            return _overlap_size;
+        }
+    };
+
+    template <typename multi_store_t>
+    class multi_contig_forest<multi_store_t>::iterator {
+    private:
+
+        friend multi_contig_forest;
+
+        multi_contig_forest const * _host{};
+        std::ptrdiff_t _chunk_idx{};
+
+        constexpr iterator(multi_contig_forest const * host, std::ptrdiff_t const chunk_idx) noexcept :
+            _host{host},
+            _chunk_idx{chunk_idx}
+        {}
+
+    public:
+
+        using value_type = chunk_type;
+        using reference = chunk_type;
+        using pointer = void;
+        using difference_type = std::ptrdiff_t;
+        using iterator_category = std::random_access_iterator_tag;
+
+        iterator() = default;
+
+        constexpr reference operator*() const noexcept {
+            return (*_host)[_chunk_idx];
+        }
+
+        constexpr reference operator[](difference_type const step) const noexcept {
+            return (*_host)[_chunk_idx + step];
+        }
+
+        constexpr iterator & operator++() noexcept {
+            ++_chunk_idx;
+            return *this;
+        }
+
+        constexpr iterator operator++(int) noexcept {
+            iterator tmp{*this};
+            ++_chunk_idx;
+            return tmp;
+        }
+
+        constexpr iterator & operator+=(difference_type const step) noexcept {
+            _chunk_idx += step;
+            return *this;
+        }
+
+        constexpr iterator & operator--() noexcept {
+            --_chunk_idx;
+            return *this;
+        }
+
+        constexpr iterator operator--(int) noexcept {
+            iterator tmp{*this};
+            --_chunk_idx;
+            return tmp;
+        }
+
+        constexpr iterator & operator-=(difference_type const step) noexcept {
+            _chunk_idx -= step;
+            return *this;
+        }
+
+    private:
+
+        constexpr friend iterator operator+(iterator lhs, difference_type const step) noexcept {
+            return lhs += step;
+        }
+
+        constexpr friend iterator operator+(difference_type const step, iterator const & rhs) noexcept {
+            return rhs + step;
+        }
+
+        constexpr friend iterator operator-(iterator lhs, difference_type const step) noexcept {
+            return lhs -= step;
+        }
+
+        constexpr friend difference_type operator-(iterator const & lhs, iterator const & rhs) noexcept {
+            return lhs._chunk_idx - rhs._chunk_idx;
+        }
+
+        constexpr friend bool operator==(iterator const &, iterator const &) noexcept = default;
+
+        constexpr friend auto operator<=>(iterator const & lhs, iterator const & rhs) noexcept {
+            return lhs._chunk_idx <=> rhs._chunk_idx;
+        }
+    };
+}  // namespace libjst
@@ -12,9 +12,14 @@
 
 #pragma once
 
+#include <algorithm>
+#include <concepts>
+
 #include <libjst/utility/closure_object.hpp>
 #include <libjst/utility/copyable_box.hpp>
 
+#include <libjst/rcms/interior_breakends.hpp>
+
 #include <libjst/sequence_tree/breakend_site_min.hpp>
 #include <libjst/sequence_tree/breakend_site_partial.hpp>
 #include <libjst/sequence_tree/breakend_site_trimmed.hpp>
@@ -26,14 +31,19 @@
 
 namespace libjst
 {
-    template <typename rcs_store_t>
+    /*!\brief A sequence tree over the source interval of a store.
+     *
+     * \tparam rcs_store_t The type of the store.
+     * \tparam prefetch_distance The number of breakends the nodes prefetch ahead, see libjst::breakpoint_node.
+     */
+    template <typename rcs_store_t, std::ptrdiff_t prefetch_distance = default_prefetch_distance>
     class partial_tree {
     private:
 
         using variants_type = typename rcs_store_t::variant_map_type;
         using variant_type = std::ranges::range_value_t<variants_type>;
         using breakend_iterator = std::ranges::iterator_t<variants_type const &>;
-        using base_node_type = breakpoint_node<breakend_iterator>;
+        using base_node_type = breakpoint_node<breakend_iterator, prefetch_distance>;
         using position_type = typename base_node_type::position_type;
         using breakend_type = decltype(std::declval<position_type const &>().get_breakend());
         using partial_position_type = breakend_site_partial<breakend_type>;
@@ -68,29 +78,18 @@ namespace libjst
             // initiate low boundary
             position_value_type end_position = std::min<position_value_type>(root_position + count,
                                                                              rcs_store.source().size());
-            auto low = std::ranges::lower_bound(std::ranges::next(std::ranges::begin(data().variants())),
-                                                std::ranges::end(data().variants()),
-                                                root_position,
-                                                std::ranges::less{},
-                                                [&] (auto breakend_proxy) -> position_value_type {
-                                                     return libjst::position(std::move(breakend_proxy));
-                                                });
+            auto const interior = libjst::interior_breakends(data().variants());
+            auto low = lower_bound(interior.begin(), interior.end(), root_position);
 
             assert(root_position <= static_cast<position_value_type>(libjst::position(*low)));
 
             set_low_base(position_type{std::ranges::prev(low), breakpoint_end::low});
-            auto high_base_it = std::ranges::prev(std::ranges::end(data().variants()));
+            auto high_base_it = interior.end();
             // set low nil node:
             partial_position_type partial_root{_low_base.get_breakend(), high_base_it, breakpoint_end::low};
             set_low_nil(_low_position_type{std::move(partial_root), root_position});
 
-            auto high = std::ranges::lower_bound(low,
-                                                 high_base_it,
-                                                 end_position,
-                                                 std::ranges::less{},
-                                                 [&] (auto breakend_proxy) -> position_value_type {
-                                                      return libjst::position(std::move(breakend_proxy));
-                                                 });
+            auto high = lower_bound(low, high_base_it, end_position);
 
             assert(end_position <= static_cast<position_value_type>(libjst::position(*high)));
             partial_position_type partial_sink{high, high_base_it, breakpoint_end::high};
@@ -123,13 +122,32 @@ namespace libjst
         constexpr void set_high_nil(_high_position_type high_nil) noexcept {
             _partial_high_nil = std::move(high_nil);
         }
+
+    private:
+
+        // Returns the first breakend in [first, last) at or behind the given position. Uses the lookup of the variant
+        // map if it provides one, e.g. the search index of libjst::dna_compressed_multisequence.
+        constexpr breakend_iterator lower_bound(breakend_iterator first,
+                                                breakend_iterator last,
+                                                position_value_type const position) const noexcept {
+            if constexpr (requires (variants_type const & variants) {
+                              { variants.lower_bound(position) } -> std::same_as<breakend_iterator>;
+                          }) {
+                return std::ranges::clamp(data().variants().lower_bound(position), first, last);
+            } else {
+                return std::ranges::lower_bound(first, last, position, std::ranges::less{},
+                                                [&] (auto breakend_proxy) -> position_value_type {
+                                                    return libjst::position(std::move(breakend_proxy));
+                                                });
+            }
+        }
     };
 
     template <typename rcs_store_t, std::integral offset_t, std::integral count_t>
     partial_tree(rcs_store_t const &, offset_t, count_t) -> partial_tree<rcs_store_t>;
 
-    template <typename base_tree_t>
-    class partial_tree<base_tree_t>::node_impl : public base_node_type {
+    template <typename base_tree_t, std::ptrdiff_t prefetch_distance>
+    class partial_tree<base_tree_t, prefetch_distance>::node_impl : public base_node_type {
     private:
 
         friend partial_tree;
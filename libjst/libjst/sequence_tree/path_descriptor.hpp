@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <bit>
 #include <bitset>
@@ -19,8 +20,13 @@
 #include <cstdint>
 #include <iosfwd>
 #include <iterator>
+#include <limits>
+#include <span>
+#include <utility>
+#include <vector>
 
 #include <cereal/types/array.hpp>
+#include <cereal/types/vector.hpp>
 
 namespace libjst
 {
@@ -89,7 +95,7 @@ namespace libjst
         }
 
         template <typename archive_t>
-        void save(archive_t const & oarchive) const
+        void save(archive_t & oarchive) const
         {
             oarchive(_data);
         }
@@ -142,24 +148,37 @@ namespace libjst
     };
 
 
+    /*!\brief Describes the branch decisions of an alternate path, beginning with the alternate branch at its root.
+     *
+     * \details
+     *
+     * The most recent decisions are stored inline in a single word below a leading marker bit, which for short
+     * paths is the root decision itself. Once a path exceeds the inline word, the full word is spilled into an
+     * overflow array owned by the descriptor, such that the depth of a path is not bounded. The overflow array is
+     * only allocated for deep paths and holds its number of spilled words followed by the words from the root on.
+     * Hence the descriptor spans two words independent of the depth of the path, and copies of shallow paths do not
+     * allocate.
+     */
     class alternate_path_descriptor {
     protected:
 
-        using data_type = extended_word<uint_fast64_t>;
+        using word_type = uint_fast64_t;
 
         static constexpr bool ref_mask{0};
         static constexpr bool alt_mask{1};
+        static constexpr size_t bits_per_word = sizeof(word_type) << 3;
+        static constexpr size_t bits_per_overflow_word = bits_per_word - 1; // all bits except the marker
 
         class iterator {
         private:
 
             friend alternate_path_descriptor;
 
-            data_type const * _path{};
+            alternate_path_descriptor const * _path{};
             size_t _active_bit{};
 
-            explicit constexpr iterator(data_type const * word, size_t const active_bit) noexcept :
-                _path{word},
+            explicit constexpr iterator(alternate_path_descriptor const * path, size_t const active_bit) noexcept :
+                _path{path},
                 _active_bit{active_bit}
             {}
 
@@ -174,7 +193,7 @@ namespace libjst
 
             constexpr reference operator*() const noexcept {
                 assert(_path != nullptr);
-                return (*_path)[_active_bit - 1];
+                return _path->bit(_active_bit - 1);
             }
 
             constexpr reference operator[](difference_type const offset) const noexcept {
@@ -235,74 +254,153 @@ namespace libjst
             }
         };
 
-        data_type _word{1};
+        word_type _word{1};
+        word_type * _overflow{}; // the number of spilled words followed by the words, or nullptr if none was spilled
 
     public:
 
-        using underlying_type = data_type;
-
         constexpr alternate_path_descriptor() = default;
 
-        constexpr void next() noexcept {
-            assert(get_word().size() < get_word().max_size());
-            get_word() <<= 1;
+        constexpr alternate_path_descriptor(alternate_path_descriptor const & other) : _word{other._word}
+        {
+            if (other._overflow != nullptr) {
+                _overflow = new word_type[other.overflow_depth() + 1];
+                std::ranges::copy_n(other._overflow, other.overflow_depth() + 1, _overflow);
+            }
+        }
+
+        constexpr alternate_path_descriptor(alternate_path_descriptor && other) noexcept :
+            _word{std::exchange(other._word, 1)},
+            _overflow{std::exchange(other._overflow, nullptr)}
+        {}
+
+        constexpr alternate_path_descriptor & operator=(alternate_path_descriptor const & other) {
+            if (this != &other)
+                *this = alternate_path_descriptor{other};
+            return *this;
+        }
+
+        constexpr alternate_path_descriptor & operator=(alternate_path_descriptor && other) noexcept {
+            std::swap(_word, other._word);
+            std::swap(_overflow, other._overflow);
+            return *this;
+        }
+
+        constexpr ~alternate_path_descriptor()
+        {
+            delete[] _overflow;
+        }
+
+        constexpr void next() {
+            if (std::bit_width(_word) == bits_per_word) { // spill the full inline word
+                spill(_word);
+                _word = 1;
+            }
+            _word <<= 1;
         }
 
         constexpr size_t size() const noexcept {
-            return get_word().size();
+            return std::bit_width(_word) + overflow_depth() * bits_per_overflow_word;
         }
 
         static constexpr size_t max_size() noexcept {
-            return data_type::max_size();
+            return std::numeric_limits<size_t>::max();
         }
 
         constexpr void set_alt() noexcept {
-            get_word() |= alt_mask;
+            _word |= alt_mask;
         }
 
         constexpr void set_ref() noexcept {
-            get_word() |= ref_mask;
+            _word |= ref_mask;
         }
 
         constexpr iterator begin() const noexcept {
-            return iterator{std::addressof(get_word()), size()};
+            return iterator{this, size()};
         }
 
         constexpr iterator end() const noexcept {
-            return iterator{std::addressof(get_word()), 0};
+            return iterator{this, 0};
         }
 
         template <typename archive_t>
-        void save(archive_t const & oarchive) const
+        void save(archive_t & oarchive) const
         {
-            oarchive(get_word());
+            // The spilled words are stored from the root on, followed by the inline word.
+            std::vector<word_type> words(overflow_words().begin(), overflow_words().end());
+            words.push_back(_word);
+            oarchive(words);
         }
 
         template <typename archive_t>
-        void load(archive_t &iarchive) noexcept
+        void load(archive_t &iarchive)
         {
-            iarchive(get_word());
+            std::vector<word_type> words{};
+            iarchive(words);
+            assert(!words.empty());
+            *this = alternate_path_descriptor{};
+            for (auto word_it = words.begin(); word_it != std::ranges::prev(words.end()); ++word_it)
+                spill(*word_it);
+            _word = words.back();
         }
 
-        typename data_type::value_type const* data() const noexcept {
-            return get_word().data();
+    private:
+
+        constexpr size_t overflow_depth() const noexcept {
+            return (_overflow != nullptr) ? _overflow[0] : 0;
         }
 
-    private:
+        // Returns the spilled words from the root on.
+        constexpr std::span<word_type const> overflow_words() const noexcept {
+            return (_overflow != nullptr) ? std::span<word_type const>{_overflow + 1, overflow_depth()}
+                                          : std::span<word_type const>{};
+        }
 
-        constexpr data_type & get_word() noexcept {
-            return _word;
+        // Appends the word to the spilled words; they are spilled once per word of decisions, hence copied rarely.
+        constexpr void spill(word_type const word) {
+            size_t const depth = overflow_depth();
+            word_type * overflow = new word_type[depth + 2];
+            overflow[0] = depth + 1;
+            std::ranges::copy(overflow_words(), overflow + 1);
+            overflow[depth + 1] = word;
+            delete[] std::exchange(_overflow, overflow);
         }
 
-        constexpr data_type const & get_word() const noexcept {
-            return _word;
+        // Returns the branch decision at the given distance from the last decision of the path.
+        constexpr bool bit(size_t position) const noexcept {
+            assert(position < size());
+            if (size_t const inline_bits = std::bit_width(_word) - 1; position < inline_bits) {
+                return (_word >> position) & 1;
+            } else {
+                position -= inline_bits;
+            }
+
+            // The spilled words are visited from the last one on.
+            std::span<word_type const> const words = overflow_words();
+            if (size_t const word_offset = position / bits_per_overflow_word; word_offset < words.size())
+                return (words[words.size() - 1 - word_offset] >> (position % bits_per_overflow_word)) & 1;
+
+            // Beyond the spilled words only the marker of the first word remains, i.e. the alternate root.
+            return alt_mask;
         }
 
-        friend constexpr bool operator==(alternate_path_descriptor const &,
-                                         alternate_path_descriptor const &) noexcept = default;
+        friend constexpr bool operator==(alternate_path_descriptor const & lhs,
+                                         alternate_path_descriptor const & rhs) noexcept {
+            return lhs._word == rhs._word && std::ranges::equal(lhs.overflow_words(), rhs.overflow_words());
+        }
 
-        friend constexpr std::strong_ordering operator<=>(alternate_path_descriptor const &,
-                                                          alternate_path_descriptor const &) noexcept = default;
+        // Orders by size and then by the branch decisions from the root on.
+        friend constexpr std::strong_ordering operator<=>(alternate_path_descriptor const & lhs,
+                                                          alternate_path_descriptor const & rhs) noexcept {
+            if (auto cmp_size = lhs.size() <=> rhs.size(); cmp_size != 0)
+                return cmp_size;
+
+            // Equal sizes imply equal depths, so the spilled words are compared from the root on.
+            std::strong_ordering const cmp_overflow = std::lexicographical_compare_three_way(
+                lhs.overflow_words().begin(), lhs.overflow_words().end(),
+                rhs.overflow_words().begin(), rhs.overflow_words().end());
+            return (cmp_overflow != 0) ? cmp_overflow : lhs._word <=> rhs._word;
+        }
     };
 
     template <typename char_t, typename char_traits_t, typename alt_path_descriptor_t>
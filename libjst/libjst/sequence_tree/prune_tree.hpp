@@ -12,13 +12,50 @@
 
 #pragma once
 
+#include <cstddef>
+#include <deque>
+#include <limits>
+#include <memory>
+#include <type_traits>
+
+#include <libjst/utility/arena_allocator.hpp>
 #include <libjst/utility/closure_object.hpp>
+#include <libjst/utility/thread_scratch.hpp>
 
 #include <libjst/coverage/concept.hpp>
+#include <libjst/sequence_tree/branch_jump_table.hpp>
+#include <libjst/sequence_tree/coverage_block_summary.hpp>
+#include <libjst/sequence_tree/tree_metrics.hpp>
 
 namespace libjst
 {
-    template <typename base_tree_t>
+    /*!\brief A tree adaptor removing all nodes whose path coverage is empty.
+     *
+     * \tparam base_tree_t The type of the wrapped coloured tree.
+     * \tparam in_place_coverage_v Whether the path coverages are computed in place, see below.
+     * \tparam summary_t The type of the libjst::coverage_block_summary used to skip unsupported variants, or `void`.
+     *
+     * \details
+     *
+     * By default every node owns its path coverage, i.e. every child copies the coverage of its parent, intersected
+     * with the coverage of the variant for an alternate child. If in_place_coverage_v is `true`, e.g. created with
+     * libjst::prune_in_place, the path coverages are kept in one stack of coverages that is shared by all nodes of one
+     * traversal, i.e. all nodes descending from the same root, and every node only stores its slot on this stack.
+     * The alternate child intersects into the slot above its parent and the reference child updates the slot of its
+     * parent in place, reusing the memory of the slots instead of allocating one coverage per node.
+     *
+     * In place coverages require a depth-first traversal that expands every node at most once and generates the
+     * alternate child before the reference child, which is the order of libjst::tree_traverser_base. Generating the
+     * reference child invalidates the coverage of its parent. Branches that continue on their alternate child only
+     * occupy one additional slot, such that the stack grows with the number of such branches along a path.
+     *
+     * If a libjst::coverage_block_summary is given, e.g. `prune_unsupported(summary)`, the alternate children in a
+     * block of breakends whose coverages do not intersect the path coverage are skipped without computing their
+     * coverages. The nodes remember the last such block, which stays unsupported for all descendants, since their
+     * path coverages are subsets of the path coverage of the node. Subset queries, which start from a small path
+     * coverage, thus skip most of the tree after one test per block.
+     */
+    template <typename base_tree_t, bool in_place_coverage_v = false, typename summary_t = void>
         // requires covered tree
     class prune_tree_impl {
     private:
@@ -28,12 +65,27 @@ namespace libjst
 
         using boundary_type = typename base_node_type::position_type;
         using delta_reference = typename boundary_type::delta_reference;
-        using coverage_type = libjst::variant_coverage_t<delta_reference>;
-
+        using variant_coverage_type = libjst::variant_coverage_t<delta_reference>;
+        // The path coverage owns its bits, also if the variants only expose views onto their coverages.
+        using coverage_type = std::remove_cvref_t<std::invoke_result_t<libjst::tag_t<libjst::coverage_intersection>,
+                                                                       variant_coverage_type const &,
+                                                                       variant_coverage_type const &>>;
+
+        class owned_path_coverage;
+        class stacked_path_coverage;
+        using path_coverage_type =
+            std::conditional_t<in_place_coverage_v, stacked_path_coverage, owned_path_coverage>;
+
+        struct no_summary {};
+        static constexpr bool has_summary = !std::is_void_v<summary_t>;
+        using summary_handle_type = std::conditional_t<has_summary, summary_t const *, no_summary>;
+
+        class summary_cursor;
         class node_impl;
         class cargo_impl;
 
         base_tree_t _wrappee{};
+        [[no_unique_address]] summary_handle_type _summary{};
 
     public:
         /*!\name Constructors, destructor and assignment
@@ -47,12 +99,22 @@ namespace libjst
         explicit constexpr prune_tree_impl(wrapped_tree_t && wrappee) noexcept :
             _wrappee{(wrapped_tree_t &&)wrappee}
         {}
+
+        //!\brief Skips the variants that are unsupported according to the given summary, which must outlive the tree.
+        template <typename wrapped_tree_t, typename other_summary_t>
+            requires (std::same_as<other_summary_t, summary_t> && std::constructible_from<base_tree_t, wrapped_tree_t>)
+        explicit constexpr prune_tree_impl(wrapped_tree_t && wrappee, other_summary_t const & summary) noexcept :
+            _wrappee{(wrapped_tree_t &&)wrappee},
+            _summary{std::addressof(summary)}
+        {}
         //!\}
 
         constexpr node_impl root() const noexcept {
             base_node_type base_root = libjst::root(_wrappee);
-            auto base_coverage = (*base_root).coverage();
-            return node_impl{std::move(base_root), std::move(base_coverage)};
+            coverage_type base_coverage{(*base_root).coverage()};
+            return node_impl{std::move(base_root),
+                             path_coverage_type{std::move(base_coverage)},
+                             summary_cursor{_summary}};
         }
 
         constexpr sink_type sink() const noexcept {
@@ -64,17 +126,140 @@ namespace libjst
         }
    };
 
-    template <typename base_tree_t>
-    class prune_tree_impl<base_tree_t>::node_impl : public base_node_type {
+    //!\brief The path coverage owned by a single node.
+    template <typename base_tree_t, bool in_place_coverage_v, typename summary_t>
+    class prune_tree_impl<base_tree_t, in_place_coverage_v, summary_t>::owned_path_coverage {
+    private:
+        coverage_type _coverage{};
+
+    public:
+
+        owned_path_coverage() = default;
+
+        explicit constexpr owned_path_coverage(coverage_type coverage) noexcept : _coverage{std::move(coverage)}
+        {}
+
+        constexpr coverage_type const & get() const noexcept {
+            return _coverage;
+        }
+
+        template <typename variant_coverage_t>
+        constexpr owned_path_coverage intersect(variant_coverage_t const & variant_coverage) const {
+            return owned_path_coverage{libjst::coverage_intersection(_coverage, variant_coverage)};
+        }
+
+        template <typename variant_coverage_t>
+        constexpr owned_path_coverage subtract(variant_coverage_t const & variant_coverage) const {
+            return owned_path_coverage{libjst::coverage_difference(_coverage, variant_coverage)};
+        }
+
+        constexpr owned_path_coverage share() const {
+            return *this;
+        }
+    };
+
+    //!\brief A slot on the path coverage stack shared by all nodes of one traversal.
+    template <typename base_tree_t, bool in_place_coverage_v, typename summary_t>
+    class prune_tree_impl<base_tree_t, in_place_coverage_v, summary_t>::stacked_path_coverage {
+    private:
+        // A deque keeps the coverages referenced by the labels valid when the stack grows.
+        using slots_type = std::deque<coverage_type, arena_allocator<coverage_type>>;
+
+        std::shared_ptr<slots_type> _slots{};
+        std::size_t _slot{};
+
+        constexpr stacked_path_coverage(std::shared_ptr<slots_type> slots, std::size_t const slot) noexcept :
+            _slots{std::move(slots)},
+            _slot{slot}
+        {}
+
+    public:
+
+        stacked_path_coverage() = default;
+
+        // The slots are reused by the traversals on one thread, whose slots above the root are overwritten when entered.
+        explicit stacked_path_coverage(coverage_type coverage) : _slots{libjst::acquire_scratch<slots_type>(arena_allocator<slots_type>{})}
+        {
+            if (_slots->empty())
+                _slots->push_back(std::move(coverage));
+            else
+                _slots->front() = std::move(coverage);
+        }
+
+        constexpr coverage_type const & get() const noexcept {
+            return (*_slots)[_slot];
+        }
+
+        //!\brief Intersects into the slot above this one, which is not used by any node on the current path.
+        template <typename variant_coverage_t>
+        constexpr stacked_path_coverage intersect(variant_coverage_t const & variant_coverage) const {
+            if (_slot + 1 == _slots->size())
+                _slots->emplace_back(); // allocates only once per depth.
+
+            detail::assign_coverage_intersection((*_slots)[_slot + 1], get(), variant_coverage);
+            return stacked_path_coverage{_slots, _slot + 1};
+        }
+
+        //!\brief Subtracts in place; the coverage of the parent is not needed after its reference child was created.
+        template <typename variant_coverage_t>
+        constexpr stacked_path_coverage subtract(variant_coverage_t const & variant_coverage) const {
+            coverage_type & coverage = (*_slots)[_slot];
+            detail::assign_coverage_difference(coverage, coverage, variant_coverage);
+            return *this;
+        }
+
+        constexpr stacked_path_coverage share() const noexcept {
+            return *this;
+        }
+    };
+
+    //!\brief Tests the alternate children against the coverage summary and remembers the last unsupported block.
+    template <typename base_tree_t, bool in_place_coverage_v, typename summary_t>
+    class prune_tree_impl<base_tree_t, in_place_coverage_v, summary_t>::summary_cursor {
+    private:
+        static constexpr std::size_t no_block = std::numeric_limits<std::size_t>::max();
+
+        [[no_unique_address]] summary_handle_type _summary{};
+        std::size_t _unsupported_block{no_block};
+
+    public:
+
+        summary_cursor() = default;
+
+        explicit constexpr summary_cursor(summary_handle_type summary) noexcept : _summary{summary}
+        {}
+
+        //!\brief Returns whether the alternate child can be covered by the path; a `false` is remembered per block.
+        template <typename base_child_t>
+        constexpr bool may_support(base_child_t const & alt_child, coverage_type const & path_coverage) noexcept {
+            if constexpr (has_summary) {
+                std::size_t const block = _summary->block_of(alt_child.low_boundary().get_breakend());
+                if (block == _unsupported_block)
+                    return false;
+                if (!_summary->supports(block, path_coverage)) {
+                    _unsupported_block = block;
+                    return false;
+                }
+            }
+            return true;
+        }
+    };
+
+    template <typename base_tree_t, bool in_place_coverage_v, typename summary_t>
+    class prune_tree_impl<base_tree_t, in_place_coverage_v, summary_t>::node_impl : public base_node_type {
     private:
 
         friend prune_tree_impl;
 
-        coverage_type _path_coverage{};
+        path_coverage_type _path_coverage{};
+        mutable summary_cursor _summary_cursor{};
 
-        explicit constexpr node_impl(base_node_type && base_node, coverage_type coverage) noexcept :
+        explicit constexpr node_impl(base_node_type && base_node,
+                                     path_coverage_type coverage,
+                                     summary_cursor cursor) noexcept :
             base_node_type{std::move(base_node)},
-            _path_coverage{std::move(coverage)}
+            _path_coverage{std::move(coverage)},
+            _summary_cursor{std::move(cursor)}
         {}
 
     public:
@@ -90,7 +275,14 @@ namespace libjst
         }
 
         constexpr cargo_impl operator*() const noexcept {
-            return cargo_impl{*(static_cast<base_node_type const &>(*this)), std::addressof(_path_coverage)};
+            return cargo_impl{*(static_cast<base_node_type const &>(*this)), std::addressof(_path_coverage.get())};
+        }
+
+        //!\brief Forwards to the wrapped node, as the path coverage only changes at low ends, which are not jumped over.
+        constexpr bool jump_ref(detail::ref_jump_target_t<base_node_type> target) noexcept
+            requires detail::ref_jumpable_node<base_node_type>
+        {
+            return base_node_type::jump_ref(std::move(target));
         }
 
     private:
@@ -98,33 +290,51 @@ namespace libjst
         template <bool is_alt, typename maybe_child_t>
         constexpr std::optional<node_impl> visit(maybe_child_t maybe_child) const {
             if (maybe_child) {
-                if (auto new_cov = compute_child_coverage<is_alt>(*maybe_child); new_cov.any()) {
-                    node_impl new_child{std::move(*maybe_child), std::move(new_cov)};
+                if constexpr (is_alt) {
+                    if (!_summary_cursor.may_support(*maybe_child, _path_coverage.get())) {
+                        detail::count_tree_metric<&tree_metrics::prune, &adaptor_metrics::nodes_pruned>();
+                        return std::nullopt;
+                    }
+                }
+                if (auto new_cov = compute_child_coverage<is_alt>(*maybe_child); new_cov.get().any()) {
+                    detail::count_tree_metric<&tree_metrics::prune, &adaptor_metrics::nodes_created>();
+                    node_impl new_child{std::move(*maybe_child), std::move(new_cov), _summary_cursor};
                     return new_child;
                 }
+                detail::count_tree_metric<&tree_metrics::prune, &adaptor_metrics::nodes_pruned>();
             }
             return std::nullopt;
         }
 
         template <bool is_alt>
-        constexpr coverage_type compute_child_coverage(base_node_type const & base_child) const {
+        constexpr path_coverage_type compute_child_coverage(base_node_type const & base_child) const {
             if constexpr (is_alt) {
-                return libjst::coverage_intersection(_path_coverage, (*base_child).coverage());
-            } else if (this->on_alternate_path() && this->high_boundary().is_low_end()) {
-                    return libjst::coverage_difference(_path_coverage, libjst::coverage(*(this->high_boundary())));
+                detail::count_tree_metric<&tree_metrics::prune, &adaptor_metrics::coverage_operations>();
+                return _path_coverage.intersect((*base_child).coverage());
+            } else if (this->on_alternate_path() && this->high_boundary().is_low_end() && !skips_high_variant()) {
+                    detail::count_tree_metric<&tree_metrics::prune, &adaptor_metrics::coverage_operations>();
+                    return _path_coverage.subtract(libjst::coverage(*(this->high_boundary())));
             } else {
-                return _path_coverage;
+                return _path_coverage.share();
             }
         }
 
+        // The carriers of a variant skipped by the wrapped tree, e.g. by libjst::min_support, do not leave the path.
+        constexpr bool skips_high_variant() const noexcept {
+            if constexpr (requires (base_node_type const & node) { { node.skips_high_variant() } -> std::same_as<bool>; })
+                return base_node_type::skips_high_variant();
+            else
+                return false;
+        }
+
         constexpr friend bool operator==(node_impl const & lhs, sink_type const & rhs) noexcept
         {
             return static_cast<base_node_type const &>(lhs) == rhs;
         }
     };
 
-    template <typename base_tree_t>
-    class prune_tree_impl<base_tree_t>::cargo_impl : public base_cargo_type {
+    template <typename base_tree_t, bool in_place_coverage_v, typename summary_t>
+    class prune_tree_impl<base_tree_t, in_place_coverage_v, summary_t>::cargo_impl : public base_cargo_type {
     private:
         [[no_unique_address]] coverage_type const * _path_coverage{};
 
@@ -145,27 +355,65 @@ namespace libjst
 
 
     namespace _tree_adaptor {
-        inline constexpr struct _prune
+        template <bool in_place_coverage_v>
+        struct _prune_fn
         {
-            template <typename covered_tree_t, typename ...args_t>
-            constexpr auto operator()(covered_tree_t && tree, args_t &&... args) const
+            template <typename covered_tree_t>
+                requires (!detail::is_coverage_block_summary_v<std::remove_cvref_t<covered_tree_t>>)
+            constexpr auto operator()(covered_tree_t && tree) const
                 noexcept(std::is_nothrow_constructible_v<
-                            prune_tree_impl<std::remove_reference_t<covered_tree_t>>, args_t...>)
-                -> prune_tree_impl<std::remove_reference_t<covered_tree_t>, args_t...>
+                            prune_tree_impl<std::remove_reference_t<covered_tree_t>, in_place_coverage_v>,
+                            covered_tree_t>)
+                -> prune_tree_impl<std::remove_reference_t<covered_tree_t>, in_place_coverage_v>
             {
-                using adapted_tree_t = prune_tree_impl<std::remove_reference_t<covered_tree_t>, args_t...>;
-                return adapted_tree_t{(covered_tree_t &&)tree, (args_t &&)args...};
+                using adapted_tree_t = prune_tree_impl<std::remove_reference_t<covered_tree_t>, in_place_coverage_v>;
+                return adapted_tree_t{(covered_tree_t &&)tree};
+            }
+
+            //!\brief Skips unsupported variants with the given libjst::coverage_block_summary.
+            template <typename covered_tree_t, typename summary_t>
+                requires detail::is_coverage_block_summary_v<summary_t>
+            constexpr auto operator()(covered_tree_t && tree, summary_t const * summary) const noexcept
+                -> prune_tree_impl<std::remove_reference_t<covered_tree_t>, in_place_coverage_v, summary_t>
+            {
+                assert(summary != nullptr);
+                using adapted_tree_t = prune_tree_impl<std::remove_reference_t<covered_tree_t>, in_place_coverage_v, summary_t>;
+                return adapted_tree_t{(covered_tree_t &&)tree, *summary};
+            }
+
+            template <typename covered_tree_t, typename summary_t>
+                requires detail::is_coverage_block_summary_v<std::remove_cvref_t<summary_t>>
+            constexpr auto operator()(covered_tree_t && tree, summary_t && summary) const noexcept
+                -> prune_tree_impl<std::remove_reference_t<covered_tree_t>,
+                                   in_place_coverage_v,
+                                   std::remove_cvref_t<summary_t>>
+            {
+                return (*this)((covered_tree_t &&)tree, std::addressof(summary));
+            }
+
+            //!\brief The closure refers to the summary, which must outlive the adapted tree.
+            template <typename summary_t>
+                requires detail::is_coverage_block_summary_v<std::remove_cvref_t<summary_t>>
+            constexpr auto operator()(summary_t && summary) const noexcept
+                -> libjst::closure_result_t<_prune_fn, std::remove_cvref_t<summary_t> const *>
+            {
+                std::remove_cvref_t<summary_t> const * summary_ptr = std::addressof(summary);
+                return libjst::make_closure(_prune_fn{}, summary_ptr);
             }
 
             template <typename ...args_t>
             constexpr auto operator()(args_t &&... args) const
                 noexcept(std::is_nothrow_invocable_v<libjst::tag_t<libjst::make_closure>, args_t...>)
-                -> libjst::closure_result_t<_prune, args_t...>
+                -> libjst::closure_result_t<_prune_fn, args_t...>
             { // we need to store the type that needs to be called later!
-                return libjst::make_closure(_prune{}, (args_t &&)args...);
+                return libjst::make_closure(_prune_fn{}, (args_t &&)args...);
             }
-        } prune{};
+        };
+
+        inline constexpr _prune_fn<false> prune{};
+        inline constexpr _prune_fn<true> prune_in_place{};
     } // namespace _tree_adaptor
 
     using _tree_adaptor::prune;
+    using _tree_adaptor::prune_in_place;
 }  // namespace libjst
@@ -16,6 +16,7 @@
 #include <optional>
 #include <ranges>
 
+#include <libjst/rcms/interior_breakends.hpp>
 #include <libjst/variant/concept.hpp>
 #include <libjst/sequence_tree/node_descriptor.hpp>
 // #include <libjst/sequence_tree/breakpoint_node.hpp>
@@ -43,6 +44,7 @@ namespace libjst
         variant_iterator _left_variant{};
         variant_iterator _right_variant{};
         variant_iterator _next_variant{};
+        variant_iterator _sink{}; // the high nil breakend, which bounds every search for the next variant.
 
         // base_node_type _base{};
 
@@ -54,7 +56,8 @@ namespace libjst
                                       variant_iterator right_variant) noexcept :
             _rcs_store{rcs_store},
             _left_variant{std::move(left_variant)},
-            _right_variant{std::move(right_variant)}
+            _right_variant{std::move(right_variant)},
+            _sink{libjst::interior_breakends(rcs_store->variants()).end()}
         {
             assert(_rcs_store != nullptr);
             set_next(next_variant_after(_right_variant));
@@ -186,8 +189,12 @@ namespace libjst
 
         // for now we only consider the SNVs!
         constexpr variant_iterator next_variant_after(variant_iterator it) const noexcept {
-            return std::ranges::find_if(it, sink(), [it] (auto && variant) {
-                return libjst::left_breakpoint(*it) < libjst::left_breakpoint(variant);
+            if (it == sink())
+                return it;
+
+            auto const left_breakpoint = libjst::left_breakpoint(*it);
+            return std::ranges::find_if(std::ranges::next(it), sink(), [&] (auto && variant) {
+                return left_breakpoint < libjst::left_breakpoint(variant);
             });
         }
 
@@ -200,7 +207,7 @@ namespace libjst
         }
 
         constexpr variant_iterator sink() const noexcept {
-            return std::ranges::prev(std::ranges::end(rcs_store().variants()));
+            return _sink;
         }
 
         constexpr bool is_nil() const noexcept {
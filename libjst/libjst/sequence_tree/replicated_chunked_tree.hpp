@@ -0,0 +1,109 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides the chunks of a store replicated on every NUMA node.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <ranges>
+#include <vector>
+
+#include <libjst/rcms/store_replicas.hpp>
+#include <libjst/sequence_tree/chunked_tree.hpp>
+#include <libjst/utility/numa_topology.hpp>
+
+namespace libjst
+{
+    /*!\brief The chunks of a libjst::store_replicas, with one libjst::chunked_tree_impl per replica.
+     *
+     * \tparam store_t The type of the replicated store.
+     *
+     * \details
+     *
+     * The forest is a random access range over the chunks of the first replica, such that it can be used like a
+     * libjst::chunked_tree_impl. All replicas are split into the same chunks, and the chunks of the replica in the
+     * memory of a node are returned by replica. A libjst::parallel_chunk_traverser binds every worker to a node of
+     * the topology and traverses the chunks of the replica of that node.
+     *
+     * The replicas must outlive the forest.
+     */
+    template <typename store_t>
+    class replicated_chunked_tree : public std::ranges::view_base {
+    private:
+
+        using chunked_tree_type = chunked_tree_impl<store_t>;
+        using size_type = typename store_t::size_type;
+
+        store_replicas<store_t> const * _replicas{};
+        std::vector<chunked_tree_type> _chunked_replicas{};
+
+    public:
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        replicated_chunked_tree() = default; //!< Default.
+
+        /*!\brief Splits every replica into chunks.
+         *
+         * \param[in] replicas The replicas of the store.
+         * \param[in] chunk_size The number of source positions of every chunk; must be greater than 0.
+         * \param[in] overlap_size The number of source positions a chunk extends beyond its end.
+         */
+        replicated_chunked_tree(store_replicas<store_t> const & replicas,
+                                size_type const chunk_size,
+                                size_type const overlap_size = 0) :
+            _replicas{&replicas}
+        {
+            assert(chunk_size > 0);
+            assert(replicas.size() > 0);
+            _chunked_replicas.reserve(replicas.size());
+            for (std::size_t node = 0; node < replicas.size(); ++node)
+                _chunked_replicas.emplace_back(replicas[node], chunk_size, overlap_size);
+        }
+        //!\}
+
+        constexpr auto operator[](std::ptrdiff_t const step) const noexcept {
+            return replica(0)[step];
+        }
+
+        constexpr auto begin() const noexcept {
+            return replica(0).begin();
+        }
+
+        constexpr auto end() const noexcept {
+            return replica(0).end();
+        }
+
+        constexpr store_t const & data() const noexcept {
+            return replica(0).data();
+        }
+
+        constexpr size_type chunk_size() const noexcept {
+            return replica(0).chunk_size();
+        }
+
+        constexpr size_type overlap_size() const noexcept {
+            return replica(0).overlap_size();
+        }
+
+        //!\brief Returns the chunks of the replica in the memory of the given node.
+        constexpr chunked_tree_type const & replica(std::size_t const node) const noexcept {
+            assert(node < _chunked_replicas.size());
+            return _chunked_replicas[node];
+        }
+
+        constexpr numa_topology const & topology() const noexcept {
+            return _replicas->topology();
+        }
+    };
+}  // namespace libjst
@@ -13,6 +13,7 @@
 #pragma once
 
 #include <concepts>
+#include <functional>
 #include <iosfwd>
 
 #include <cereal/types/base_class.hpp>
@@ -27,26 +28,26 @@ namespace libjst
 
         using index_t = uint_fast64_t;
 
-        static constexpr uint32_t max_index_width_v{(sizeof(index_t) << 3) - 1};
+        static constexpr uint32_t reference_end_width_v{2};
+        static constexpr uint32_t max_index_width_v{(sizeof(index_t) << 3) - 1 - reference_end_width_v};
 
-        union {
-            breakpoint_end ref{};
-            alternate_path_descriptor alt;
-        } _descriptor{};
+        // The path of an alternate node, which is empty while a reference node is active and owns the words of a
+        // deep path; the end of a reference node is kept next to the variant index.
+        alternate_path_descriptor _alternate_path{};
 
         index_t _active_descriptor : 1;
+        index_t _reference_end : reference_end_width_v;
         index_t _variant_index : max_index_width_v;
 
     public:
 
-        constexpr seek_position() noexcept : _active_descriptor{0}, _variant_index{0}
+        constexpr seek_position() noexcept : _active_descriptor{0}, _reference_end{0}, _variant_index{0}
         {}
 
         constexpr void initiate_alternate_node(index_t const variant_index) noexcept {
             activate_alternate_node();
-            _active_descriptor = 1;
             _variant_index = variant_index;
-            alternate_node() = alternate_path_descriptor{};
+            _alternate_path = alternate_path_descriptor{};
         }
 
         constexpr void next_alternate_node(bool const is_alternate) noexcept {
@@ -61,13 +62,19 @@ namespace libjst
         constexpr void reset(index_t const variant_index, breakpoint_end const site) noexcept {
             activate_reference_node();
             _variant_index = variant_index;
-            reference_node() = site;
+            _reference_end = static_cast<index_t>(site);
+            _alternate_path = alternate_path_descriptor{};
         }
 
         constexpr index_t get_variant_index() const noexcept {
             return _variant_index;
         }
 
+        //!\brief Moves the position to another variant index, e.g. after variants were inserted before it.
+        constexpr void set_variant_index(index_t const variant_index) noexcept {
+            _variant_index = variant_index;
+        }
+
         template <typename visitor_t>
         constexpr auto visit(visitor_t && visitor) const {
             if (alternate_node_is_active()) {
@@ -80,37 +87,44 @@ namespace libjst
         template <typename archive_t>
         void save(archive_t & oarchive) const
         {
-            oarchive(_active_descriptor, _variant_index);
+            // The bit fields cannot be bound to the references taken by the archive.
+            index_t const active_descriptor = _active_descriptor;
+            index_t const variant_index = _variant_index;
+            oarchive(active_descriptor, variant_index);
             visit([&] (auto const & descriptor) { oarchive(descriptor); });
         }
 
         template <typename archive_t>
         void load(archive_t & iarchive)
         {
-            iarchive(_active_descriptor, _variant_index);
-            visit([&] (auto const & descriptor) { iarchive(descriptor); });
+            index_t active_descriptor{};
+            index_t variant_index{};
+            iarchive(active_descriptor, variant_index);
+            if (active_descriptor) {
+                initiate_alternate_node(variant_index);
+                iarchive(alternate_node());
+            } else {
+                breakpoint_end site{};
+                iarchive(site);
+                reset(variant_index, site);
+            }
         }
 
     protected:
 
         constexpr alternate_path_descriptor & alternate_node() noexcept {
             assert(alternate_node_is_active());
-            return _descriptor.alt;
+            return _alternate_path;
         }
 
         constexpr alternate_path_descriptor const & alternate_node() const noexcept {
             assert(alternate_node_is_active());
-            return _descriptor.alt;
-        }
-
-        constexpr breakpoint_end & reference_node() noexcept {
-            assert(!alternate_node_is_active());
-            return _descriptor.ref;
+            return _alternate_path;
         }
 
-        constexpr breakpoint_end const & reference_node() const noexcept {
+        constexpr breakpoint_end reference_node() const noexcept {
             assert(!alternate_node_is_active());
-            return _descriptor.ref;
+            return static_cast<breakpoint_end>(_reference_end);
         }
 
         constexpr bool alternate_node_is_active() const noexcept {
@@ -136,9 +150,9 @@ namespace libjst
                 if (auto cmp_descr = lhs.alternate_node_is_active() ^ rhs.alternate_node_is_active(); cmp_descr == 0) {
                     return lhs.visit([&] <typename descriptor_t> (descriptor_t const & lhs_descriptor) {
                         if constexpr (std::same_as<descriptor_t, breakpoint_end>) {
-                            return lhs_descriptor <=> rhs._descriptor.ref;
+                            return lhs_descriptor <=> rhs.reference_node();
                         } else {
-                            return lhs_descriptor <=> rhs._descriptor.alt;
+                            return lhs_descriptor <=> rhs.alternate_node();
                         }
                     });
                 } else {
@@ -0,0 +1,174 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides compact binary encodings of the seek positions for index payloads.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <libjst/sequence_tree/seek_position.hpp>
+
+namespace libjst
+{
+    /*!\brief Encodes libjst::seek_position compactly, e.g. for the entries of seed and k-mer indexes.
+     *
+     * \details
+     *
+     * The variable-length encoding starts with the LEB128 varint of the variant index shifted by two bits, whose low
+     * bits store the kind of the position: 0 for the low and 1 for the high end of a reference node and 2 for an
+     * alternate node. An alternate node continues with the varint of the number of its branch decisions after the
+     * alternate root, followed by the decisions packed into the least number of bytes, beginning with the bit 0 of
+     * the first byte. A reference position hence takes a single byte for variant indices below 32 and an alternate
+     * position of a shallow path three bytes, instead of the 24 bytes of the object. The variant index must be less
+     * than 2^62.
+     *
+     * Reference positions can also be encoded into a fixed 8 byte word storing the variant index shifted by one
+     * bit, whose low bit is set for the high end. The words can be stored in plain arrays and are decoded in bulk by
+     * a branch-free loop, which the compiler may vectorise.
+     */
+    class seek_position_codec {
+    private:
+
+        enum kind : uint64_t {
+            reference_low = 0,
+            reference_high = 1,
+            alternate = 2
+        };
+
+        static constexpr std::size_t kind_bits{2};
+
+    public:
+
+        //!\brief The maximal number of bytes of a variable-length encoded reference position.
+        static constexpr std::size_t max_reference_size{10};
+
+        //!\brief Appends the variable-length encoding of the position to the given buffer.
+        static void encode(seek_position const & position, std::vector<std::byte> & output) {
+            uint64_t const variant_index = position.get_variant_index();
+            assert(variant_index < (uint64_t{1} << (64 - kind_bits)));
+
+            position.visit([&] <typename descriptor_t> (descriptor_t const & descriptor) {
+                if constexpr (std::same_as<descriptor_t, breakpoint_end>) {
+                    assert(descriptor == breakpoint_end::low || descriptor == breakpoint_end::high);
+                    kind const site = (descriptor == breakpoint_end::high) ? reference_high : reference_low;
+                    emit_varint(output, (variant_index << kind_bits) | site);
+                } else {
+                    emit_varint(output, (variant_index << kind_bits) | alternate);
+                    std::size_t const decision_count = descriptor.size() - 1; // the alternate root is implicit
+                    emit_varint(output, decision_count);
+
+                    std::size_t const first_byte = output.size();
+                    output.resize(first_byte + (decision_count + 7) / 8);
+                    std::size_t decision{};
+                    for (auto it = std::ranges::next(descriptor.begin()); it != descriptor.end(); ++it, ++decision)
+                        output[first_byte + decision / 8] |= static_cast<std::byte>(*it << (decision % 8));
+                }
+            });
+        }
+
+        /*!\brief Decodes the position at the begin of the given bytes and returns the number of consumed bytes.
+         *
+         * \details
+         *
+         * Throws std::runtime_error if the bytes end within the position.
+         */
+        static std::size_t decode(std::span<std::byte const> input, seek_position & position) {
+            std::size_t in{};
+            uint64_t const header = read_varint(input, in);
+            uint64_t const variant_index = header >> kind_bits;
+            switch (header & ((1 << kind_bits) - 1)) {
+                case reference_low: position.reset(variant_index, breakpoint_end::low); break;
+                case reference_high: position.reset(variant_index, breakpoint_end::high); break;
+                case alternate: {
+                    std::size_t const decision_count = read_varint(input, in);
+                    if ((decision_count + 7) / 8 > input.size() - in)
+                        throw std::runtime_error{"The encoded seek position is corrupted."};
+
+                    position.initiate_alternate_node(variant_index);
+                    for (std::size_t decision = 0; decision < decision_count; ++decision)
+                        position.next_alternate_node(
+                            (static_cast<unsigned>(input[in + decision / 8]) >> (decision % 8)) & 1);
+                    in += (decision_count + 7) / 8;
+                    break;
+                }
+                default: throw std::runtime_error{"The encoded seek position is corrupted."};
+            }
+            return in;
+        }
+
+        /*!\brief Decodes all positions of the given bytes and appends them to the given buffer.
+         *
+         * \details
+         *
+         * Throws std::runtime_error if the bytes end within a position.
+         */
+        static void decode_all(std::span<std::byte const> input, std::vector<seek_position> & output) {
+            while (!input.empty()) {
+                seek_position & position = output.emplace_back();
+                input = input.subspan(decode(input, position));
+            }
+        }
+
+        //!\brief Returns the fixed 8 byte encoding of a reference position.
+        static constexpr uint64_t encode_reference(seek_position const & position) noexcept {
+            return position.visit([&] <typename descriptor_t> (descriptor_t const & descriptor) -> uint64_t {
+                if constexpr (std::same_as<descriptor_t, breakpoint_end>) {
+                    assert(descriptor == breakpoint_end::low || descriptor == breakpoint_end::high);
+                    return (position.get_variant_index() << 1) | (descriptor == breakpoint_end::high);
+                } else {
+                    assert(false); // only reference positions have a fixed size encoding.
+                    return 0;
+                }
+            });
+        }
+
+        //!\brief Decodes a reference position from its fixed 8 byte encoding.
+        static constexpr seek_position decode_reference(uint64_t const code) noexcept {
+            constexpr breakpoint_end sites[2]{breakpoint_end::low, breakpoint_end::high};
+            seek_position position{};
+            position.reset(code >> 1, sites[code & 1]);
+            return position;
+        }
+
+        //!\brief Decodes the reference positions from their fixed 8 byte encodings; the spans must have equal sizes.
+        static void decode_references(std::span<uint64_t const> codes, std::span<seek_position> output) noexcept {
+            assert(codes.size() == output.size());
+            for (std::size_t index = 0; index < codes.size(); ++index)
+                output[index] = decode_reference(codes[index]);
+        }
+
+    private:
+
+        static void emit_varint(std::vector<std::byte> & output, uint64_t value) {
+            for (; value >= 0x80; value >>= 7)
+                output.push_back(static_cast<std::byte>((value & 0x7f) | 0x80));
+            output.push_back(static_cast<std::byte>(value));
+        }
+
+        static uint64_t read_varint(std::span<std::byte const> input, std::size_t & in) {
+            uint64_t value{};
+            for (unsigned shift = 0; shift < 64; shift += 7) {
+                if (in == input.size())
+                    throw std::runtime_error{"The encoded seek position is corrupted."};
+                uint64_t const byte = static_cast<uint64_t>(input[in++]);
+                value |= (byte & 0x7f) << shift;
+                if ((byte & 0x80) == 0)
+                    return value;
+            }
+            throw std::runtime_error{"The encoded seek position is corrupted."};
+        }
+    };
+}  // namespace libjst
@@ -12,7 +12,15 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <optional>
+#include <span>
+#include <vector>
+
 #include <libjst/utility/closure_object.hpp>
+#include <libjst/utility/prefetch.hpp>
 
 #include <libjst/sequence_tree/concept.hpp>
 #include <libjst/sequence_tree/node_descriptor.hpp>
@@ -69,14 +77,87 @@ namespace libjst
         }
 
         constexpr node_impl seek(seek_position offset) const {
-            return offset.visit([&] (auto path_descriptor) {
+            return offset.visit([&] (auto const & path_descriptor) {
                 breakend_iterator seek_breakend = std::ranges::next(std::ranges::begin(data().variants()),
                                                                     offset.get_variant_index());
 
-                return unwind(std::move(path_descriptor), std::move(seek_breakend));
+                return unwind(path_descriptor, std::move(seek_breakend));
             });
         }
 
+        /*!\brief Seeks the nodes of all positions, sharing the work between neighbouring positions.
+         *
+         * \param[in] positions The positions to seek.
+         * \param[in] fn Invoked as `fn(index, node)` with the index of the position and the lvalue of its node.
+         *
+         * \details
+         *
+         * The positions are processed in sorted order, such that the breakend of every position is reached from the
+         * breakend of its predecessor. The nodes along the last unwound alternate path are kept, and a position of
+         * the same variant resumes the unwinding from the longest common prefix of the paths. The callback is hence
+         * invoked in the order of the positions, not in the order of their indices.
+         *
+         * The breakends of the positions libjst::default_prefetch_distance ahead in the sorted order are prefetched.
+         * The tree is not modified, i.e. several threads can seek concurrently in the same tree.
+         */
+        template <typename fn_t>
+        constexpr void seek_many(std::span<seek_position const> positions, fn_t && fn) const {
+            std::vector<std::size_t> order(positions.size());
+            std::iota(order.begin(), order.end(), 0);
+            std::ranges::stable_sort(order, [&] (std::size_t const lhs, std::size_t const rhs) {
+                return positions[lhs] < positions[rhs];
+            });
+
+            breakend_iterator seek_breakend = std::ranges::begin(data().variants());
+            difference_type seek_index{};
+            std::vector<node_impl> path{}; // the nodes of the last alternate path, beginning with its branch node
+            std::vector<bool> path_steps{};
+            std::optional<difference_type> path_index{};
+            for (std::size_t rank = 0; rank < order.size(); ++rank) {
+                // The breakends of the positions ahead are mostly not cached, since the positions are far apart.
+                if constexpr (default_prefetch_distance > 0) {
+                    if (std::size_t const ahead = rank + default_prefetch_distance; ahead < order.size())
+                        libjst::prefetch_ahead(std::ranges::begin(data().variants()),
+                                               positions[order[ahead]].get_variant_index());
+                }
+
+                std::size_t const index = order[rank];
+                seek_position const & position = positions[index];
+                difference_type const variant_index = position.get_variant_index();
+                std::ranges::advance(seek_breakend, variant_index - seek_index);
+                seek_index = variant_index;
+
+                position.visit([&] <typename descriptor_t> (descriptor_t const & descriptor) {
+                    if constexpr (std::same_as<descriptor_t, breakpoint_end>) {
+                        node_impl node = unwind(descriptor, seek_breakend);
+                        fn(index, node);
+                    } else {
+                        if (path_index != variant_index) {
+                            path.clear();
+                            path_steps.clear();
+                            path.push_back(branch_node(seek_breakend));
+                            path_index = variant_index;
+                        }
+
+                        auto step = std::ranges::begin(descriptor);
+                        std::size_t depth{};
+                        for (; step != std::ranges::end(descriptor) && depth < path_steps.size() &&
+                               path_steps[depth] == *step; ++step, ++depth)
+                        {}
+                        path.erase(std::ranges::next(path.begin(), depth + 1), path.end());
+                        path_steps.erase(std::ranges::next(path_steps.begin(), depth), path_steps.end());
+
+                        for (; step != std::ranges::end(descriptor); ++step) {
+                            node_impl child = (*step) ? *path.back().next_alt() : *path.back().next_ref();
+                            path.push_back(std::move(child));
+                            path_steps.push_back(*step);
+                        }
+                        fn(index, path.back());
+                    }
+                });
+            }
+        }
+
     private:
 
         constexpr node_impl unwind(breakpoint_end site, breakend_iterator seek_breakend) const {
@@ -89,14 +170,7 @@ namespace libjst
         }
 
         constexpr node_impl unwind(alternate_path_descriptor const & descriptor, breakend_iterator seek_breakend) const {
-            node_impl tmp = root();
-            --seek_breakend;
-            difference_type breakend_idx = std::ranges::distance(std::ranges::begin(data().variants()), seek_breakend);
-            breakpoint_end low_end = (*seek_breakend).get_breakpoint_end();
-            seek_position initial_position{};
-            initial_position.reset(breakend_idx, low_end);
-            tmp.reset(breakend_site<breakend_iterator>{std::move(seek_breakend), low_end}, std::move(initial_position));
-
+            node_impl tmp = branch_node(std::move(seek_breakend));
             for (auto it = std::ranges::begin(descriptor); it != std::ranges::end(descriptor); ++it) {
                 if (*it) {
                     tmp = *tmp.next_alt();
@@ -106,6 +180,18 @@ namespace libjst
             }
             return tmp;
         }
+
+        // Returns the reference node the alternate paths of the variant at the given breakend branch off from.
+        constexpr node_impl branch_node(breakend_iterator seek_breakend) const {
+            node_impl tmp = root();
+            --seek_breakend;
+            difference_type breakend_idx = std::ranges::distance(std::ranges::begin(data().variants()), seek_breakend);
+            breakpoint_end low_end = (*seek_breakend).get_breakpoint_end();
+            seek_position initial_position{};
+            initial_position.reset(breakend_idx, low_end);
+            tmp.reset(breakend_site<breakend_iterator>{std::move(seek_breakend), low_end}, std::move(initial_position));
+            return tmp;
+        }
     };
 
     template <typename base_tree_t>
@@ -175,7 +261,10 @@ namespace libjst
                 if (this->on_alternate_path()) {
                     child_offset.next_alternate_node(is_alt);
                 } else {
-                    difference_type next_index = variant_index() + 1;
+                    // The children begin at the high boundary, which can be several breakends away in a merged node.
+                    difference_type next_index = variant_index() +
+                                                 std::ranges::distance(this->low_boundary().get_breakend(),
+                                                                       this->high_boundary().get_breakend());
                     if constexpr (is_alt) {
                         child_offset.initiate_alternate_node(next_index);
                     } else {
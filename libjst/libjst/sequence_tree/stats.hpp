@@ -12,9 +12,13 @@
 
 #pragma once
 
+#include <algorithm>
+#include <vector>
+
 #include <libjst/utility/closure_object.hpp>
 
 #include <libjst/sequence_tree/concept.hpp>
+#include <libjst/sequence_tree/tree_metrics.hpp>
 #include <libjst/traversal/tree_traverser_base.hpp>
 
 namespace libjst
@@ -27,6 +31,7 @@ namespace libjst
         size_t symbol_count{};
         size_t max_subtree_depth{};
         std::vector<size_t> subtree_depths{};
+        tree_metrics metrics{}; //!< The metrics of the adaptors; only recorded if libjst::tree_metrics_enabled is set.
 
         constexpr void notify_push() {
         }
@@ -34,6 +39,18 @@ namespace libjst
         constexpr void notify_pop() {
             ++leaf_count;
         }
+
+        //!\brief Accumulates the stats of a disjoint tree, e.g. of another chunk, whose subtrees follow these.
+        tree_stats & operator+=(tree_stats const & other) {
+            node_count += other.node_count;
+            subtree_count += other.subtree_count;
+            leaf_count += other.leaf_count;
+            symbol_count += other.symbol_count;
+            max_subtree_depth = std::max(max_subtree_depth, other.max_subtree_depth);
+            subtree_depths.insert(subtree_depths.end(), other.subtree_depths.begin(), other.subtree_depths.end());
+            metrics += other.metrics;
+            return *this;
+        }
     };
 
     struct node_properties {
@@ -170,6 +187,11 @@ namespace libjst
                                  .symbol_count = 0};
                 stats_tree_impl<tree_t> stats_tree{(tree_t &&)tree};
 
+                // Records the metrics of this traversal separately and adds them to the thread's metrics afterwards.
+                [[maybe_unused]] tree_metrics outer_metrics{};
+                if constexpr (tree_metrics_enabled)
+                    outer_metrics = libjst::reset_tree_metrics();
+
                 tree_traverser_base path{stats_tree};
                 path.subscribe(stats);
                 for (auto it = path.begin(); it != path.end(); ++it) {
@@ -188,6 +210,11 @@ namespace libjst
                 std::ranges::for_each(stats.subtree_depths, [&] (size_t const & depth) {
                     stats.max_subtree_depth = std::max(stats.max_subtree_depth, depth);
                 });
+
+                if constexpr (tree_metrics_enabled) {
+                    stats.metrics = libjst::thread_tree_metrics();
+                    detail::thread_tree_metrics() += outer_metrics;
+                }
                 return stats;
             }
 
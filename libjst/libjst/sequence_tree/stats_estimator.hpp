@@ -0,0 +1,321 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::stats_estimator and libjst::parallel_stats.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <libjst/coverage/concept.hpp>
+#include <libjst/sequence_tree/stats.hpp>
+#include <libjst/traversal/parallel_chunk_traverser.hpp>
+#include <libjst/variant/concept.hpp>
+
+namespace libjst
+{
+    /*!\brief Estimates the libjst::tree_stats of a sequence tree from the breakend map, without building the tree.
+     *
+     * \details
+     *
+     * The estimated tree is the tree produced by `labelled() | coloured() | trim(branch_size) | prune() | merge()`.
+     * Instead of traversing the tree, the estimator walks the alternate subtree of every variant over the positions
+     * and coverages of the breakend map only: a nested variant branches off a node if it begins within the remaining
+     * branch size and shares a haplotype with the node, and the reference child of the branch is pruned if the
+     * variant covers all haplotypes of the node. No labels are built and no coverage is stored beyond the current
+     * path, such that the walk costs a fraction of the traversal. The estimate follows the label sizes of the trimmed
+     * tree, including the shifted branch ends behind indels, and is exact for every store the labelled tree supports.
+     *
+     * The accuracy can be traded for time with the sample rate: only this fraction of the subtrees is walked, evenly
+     * spread over the breakend map, and the counts of the subtrees are extrapolated to all variants. The subtree
+     * count is always exact, while the subtree depths only contain the depths of the walked subtrees, such that the
+     * maximal subtree depth is a lower bound.
+     */
+    class stats_estimator {
+    private:
+
+        //!\brief A variant of the breakend map that can branch off a node.
+        template <typename coverage_t>
+        struct branch {
+            std::size_t position{};
+            std::size_t deletion_size{};
+            std::size_t insertion_size{};
+            coverage_t coverage{};
+        };
+
+        //!\brief The counts accumulated by walking a subtree.
+        struct subtree_stats {
+            std::size_t node_count{};
+            std::size_t leaf_count{};
+            std::size_t symbol_count{};
+            std::size_t depth{};
+        };
+
+        std::size_t _branch_size{};
+        double _sample_rate{1.0};
+
+    public:
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        stats_estimator() = delete; //!< Deleted.
+
+        /*!\brief Estimates the stats of trees trimmed to the given branch size.
+         *
+         * \param[in] branch_size The branch size of the trimmed tree.
+         * \param[in] sample_rate The fraction of the subtrees that is walked; must be in `(0, 1]`.
+         *
+         * \throws std::invalid_argument if the sample rate is not in `(0, 1]`.
+         */
+        explicit stats_estimator(std::size_t const branch_size, double const sample_rate = 1.0) :
+            _branch_size{branch_size},
+            _sample_rate{sample_rate}
+        {
+            if (!(sample_rate > 0.0 && sample_rate <= 1.0))
+                throw std::invalid_argument{"The sample rate must be in (0, 1]."};
+        }
+        //!\}
+
+        //!\brief Returns the estimated stats of the tree over the given store.
+        template <typename rcs_store_t>
+        tree_stats operator()(rcs_store_t const & rcs_store) const {
+            auto const & variants = rcs_store.variants();
+            using coverage_t = libjst::variant_coverage_t<std::ranges::range_reference_t<decltype(variants)>>;
+
+            // The first and the last breakend are the sentinels of the reference.
+            std::vector<branch<coverage_t>> branches{};
+            auto last = std::ranges::prev(std::ranges::end(variants));
+            for (auto it = std::ranges::next(std::ranges::begin(variants)); it < last; ++it) {
+                auto && breakend = *it;
+                if (breakend.get_breakpoint_end() != breakpoint_end::low || !libjst::coverage(breakend).any())
+                    continue;
+
+                branches.push_back(branch<coverage_t>{
+                    .position = static_cast<std::size_t>(libjst::position(breakend)),
+                    .deletion_size = static_cast<std::size_t>(libjst::breakpoint_span(libjst::get_breakpoint(breakend))),
+                    .insertion_size = static_cast<std::size_t>(std::ranges::size(libjst::alt_sequence(breakend))),
+                    .coverage = libjst::coverage(breakend)
+                });
+            }
+
+            std::size_t const source_size = std::ranges::size(rcs_store.source());
+
+            // Every variant splits the reference path.
+            tree_stats stats{.node_count = 1 + branches.size(),
+                             .subtree_count = branches.size(),
+                             .leaf_count = 1,
+                             .symbol_count = source_size};
+
+            subtree_stats sampled{};
+            std::size_t sampled_count{};
+            for (std::size_t idx = 0; idx < branches.size(); ++idx) {
+                if (!is_sampled(idx))
+                    continue;
+
+                subtree_stats subtree = walk_subtree(branches, idx, source_size);
+                sampled.node_count += subtree.node_count;
+                sampled.leaf_count += subtree.leaf_count;
+                sampled.symbol_count += subtree.symbol_count;
+                stats.subtree_depths.push_back(subtree.depth);
+                stats.max_subtree_depth = std::max(stats.max_subtree_depth, subtree.depth);
+                ++sampled_count;
+            }
+
+            if (sampled_count > 0) {
+                double const scale = static_cast<double>(branches.size()) / static_cast<double>(sampled_count);
+                auto extrapolate = [&] (std::size_t const count) {
+                    return static_cast<std::size_t>(std::llround(static_cast<double>(count) * scale));
+                };
+                stats.node_count += extrapolate(sampled.node_count);
+                stats.leaf_count += extrapolate(sampled.leaf_count);
+                stats.symbol_count += extrapolate(sampled.symbol_count);
+            }
+            return stats;
+        }
+
+        //!\brief Returns the branch size of the estimated tree.
+        constexpr std::size_t branch_size() const noexcept {
+            return _branch_size;
+        }
+
+        //!\brief Returns the fraction of the walked subtrees.
+        constexpr double sample_rate() const noexcept {
+            return _sample_rate;
+        }
+
+    private:
+
+        //!\brief Whether the subtree with the given index is walked; spreads the samples evenly over the variants.
+        constexpr bool is_sampled(std::size_t const idx) const noexcept {
+            if (_sample_rate >= 1.0)
+                return true;
+
+            return std::floor(static_cast<double>(idx + 1) * _sample_rate) >
+                   std::floor(static_cast<double>(idx) * _sample_rate);
+        }
+
+        //!\brief Walks the alternate subtree of the given variant.
+        template <typename coverage_t>
+        subtree_stats walk_subtree(std::vector<branch<coverage_t>> const & branches,
+                                   std::size_t const idx,
+                                   std::size_t const source_size) const {
+            // The trimmed root spans the branch size behind the replaced reference, but ends with the source.
+            branch<coverage_t> const & root = branches[idx];
+            std::size_t const replaced_size = std::min(root.insertion_size, root.deletion_size);
+            subtree_stats subtree{.symbol_count = replaced_size};
+            walk(subtree,
+                 branches,
+                 idx + 1,
+                 root.position + root.deletion_size,
+                 static_cast<std::ptrdiff_t>(_branch_size + root.deletion_size - replaced_size),
+                 root.coverage,
+                 1,
+                 source_size);
+            return subtree;
+        }
+
+        /*!\brief Walks the node beginning at the given source position and its children.
+         *
+         * \param[in,out] subtree The accumulated counts of the subtree.
+         * \param[in] branches The variants that can branch off the node.
+         * \param[in] next_idx The index of the first variant that can branch off the node.
+         * \param[in] position The source position the remaining part of the node begins at.
+         * \param[in] remaining_size The remaining branch size of the node.
+         * \param[in] coverage The haplotypes of the node.
+         * \param[in] depth The depth of the node in the subtree.
+         * \param[in] source_size The size of the source.
+         */
+        template <typename coverage_t>
+        void walk(subtree_stats & subtree,
+                  std::vector<branch<coverage_t>> const & branches,
+                  std::size_t const next_idx,
+                  std::size_t const position,
+                  std::ptrdiff_t const remaining_size,
+                  coverage_t const & coverage,
+                  std::size_t const depth,
+                  std::size_t const source_size) const {
+            ++subtree.node_count;
+            subtree.depth = std::max(subtree.depth, depth);
+
+            for (std::size_t idx = next_idx; idx < branches.size(); ++idx) {
+                branch<coverage_t> const & nested = branches[idx];
+                if (nested.position < position) // begins within the deletion of the path
+                    continue;
+
+                std::ptrdiff_t const distance = static_cast<std::ptrdiff_t>(nested.position - position);
+                if (distance >= remaining_size)
+                    break;
+
+                std::ptrdiff_t const child_remaining = remaining_size - distance;
+                subtree.symbol_count += static_cast<std::size_t>(distance);
+
+                // A variant not covering the node only splits it, its alternate child is pruned.
+                if (!libjst::coverage_intersects(coverage, nested.coverage)) {
+                    walk(subtree, branches, idx + 1, nested.position, child_remaining, coverage, depth + 1, source_size);
+                    return;
+                }
+
+                // The alternate child spans the replaced reference, and its branch size shrinks by the replaced and
+                // the inserted symbols, but grows by the deleted ones.
+                std::ptrdiff_t const insertion_size = static_cast<std::ptrdiff_t>(nested.insertion_size);
+                std::ptrdiff_t const deletion_size = static_cast<std::ptrdiff_t>(nested.deletion_size);
+                std::ptrdiff_t const replaced_size = std::min(insertion_size, deletion_size);
+                subtree.symbol_count += static_cast<std::size_t>(replaced_size);
+                walk(subtree,
+                     branches,
+                     idx + 1,
+                     nested.position + nested.deletion_size,
+                     child_remaining + deletion_size - insertion_size - replaced_size,
+                     libjst::coverage_intersection(coverage, nested.coverage),
+                     depth + 1,
+                     source_size);
+
+                if (coverage_t ref_coverage = libjst::coverage_difference(coverage, nested.coverage); ref_coverage.any())
+                    walk(subtree, branches, idx + 1, nested.position, child_remaining, ref_coverage, depth + 1, source_size);
+                return;
+            }
+
+            // The leaf spans the remaining branch size, but ends with the source.
+            std::ptrdiff_t const tail_size = static_cast<std::ptrdiff_t>(source_size) -
+                                             static_cast<std::ptrdiff_t>(position);
+            subtree.symbol_count += static_cast<std::size_t>(std::max<std::ptrdiff_t>(0, std::min(remaining_size,
+                                                                                                   tail_size)));
+            ++subtree.leaf_count;
+        }
+    };
+
+    namespace detail
+    {
+        //!\brief Reports the libjst::tree_stats of a chunk as its only hit to the libjst::parallel_chunk_traverser.
+        struct chunk_stats_traverser {
+            template <typename tree_t, typename tree_adaptor_t, typename callback_t>
+            void operator()(tree_t && tree, tree_adaptor_t const & tree_adaptor, callback_t && callback) const {
+                tree_stats chunk_stats = libjst::stats((tree_t &&)tree | tree_adaptor);
+                callback(chunk_stats, tree_adaptor);
+            }
+        };
+    } // namespace detail
+
+    /*!\brief Computes the exact libjst::tree_stats of the chunks of a chunked tree concurrently.
+     *
+     * \details
+     *
+     * Every chunk is adapted with the given tree adaptor, e.g. `labelled() | coloured() | trim(w) | prune() | merge()`,
+     * and its stats are computed by a libjst::parallel_chunk_traverser. The stats of the chunks are accumulated in
+     * chunk order with libjst::tree_stats::operator+=, such that the result does not depend on the thread count.
+     *
+     * The result is the work of a search over the chunks, which differs from the stats of the whole tree at the chunk
+     * borders: the chunks are traversed without their overlap like by the libjst::parallel_chunk_traverser, but the
+     * reference nodes are cut at the chunk borders and the root of every partial tree is counted as an additional node
+     * and subtree.
+     */
+    class parallel_stats {
+    private:
+        std::size_t _thread_count{1};
+
+    public:
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        //!\brief Uses as many threads as the hardware supports.
+        parallel_stats() : parallel_stats{std::thread::hardware_concurrency()}
+        {}
+
+        //!\brief Uses the given number of threads, including the calling thread.
+        constexpr explicit parallel_stats(std::size_t const thread_count) noexcept :
+            _thread_count{std::max<std::size_t>(thread_count, 1)}
+        {}
+        //!\}
+
+        //!\brief Returns the accumulated stats of all chunks of the forest.
+        template <std::ranges::random_access_range forest_t, typename tree_adaptor_t>
+        tree_stats operator()(forest_t const & forest, tree_adaptor_t const & tree_adaptor) const {
+            tree_stats stats{};
+            parallel_chunk_traverser<detail::chunk_stats_traverser>{_thread_count}.template ordered<tree_stats>(
+                forest,
+                tree_adaptor,
+                [] (tree_stats & chunk_stats, auto &&) { return std::move(chunk_stats); },
+                [&] (tree_stats chunk_stats) { stats += chunk_stats; });
+            return stats;
+        }
+
+        constexpr std::size_t thread_count() const noexcept {
+            return _thread_count;
+        }
+    };
+}  // namespace libjst
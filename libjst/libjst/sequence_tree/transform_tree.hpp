@@ -12,7 +12,11 @@
 
 #pragma once
 
+#include <concepts>
 #include <functional>
+#include <memory>
+#include <optional>
+#include <type_traits>
 
 #include <libjst/utility/copyable_box.hpp>
 
@@ -20,6 +24,18 @@
 
 namespace libjst
 {
+    /*!\brief Transforms the labels of the wrapped tree with the given function.
+     *
+     * \tparam base_tree_t The type of the wrapped tree.
+     * \tparam fn_t The type of the label transformation.
+     *
+     * \details
+     *
+     * The function is stored once in the tree. Stateless functions, e.g. lambdas without captures, are constructed in
+     * every node without occupying memory, while the nodes of other functions, e.g. lambdas capturing lookup tables,
+     * refer to the function of the tree instead of copying it into every node. The nodes of such a function must thus
+     * not outlive the tree they were created from, like the nodes of libjst::coloured_tree.
+     */
     template <typename base_tree_t, typename fn_t>
     class transform_tree_impl {
     private:
@@ -32,6 +48,10 @@ namespace libjst
         using tree_box_t = copyable_box<base_tree_t>;
         using transform_box_t = copyable_box<fn_t>;
 
+        //!\brief Whether the function has no state, such that every node constructs its own instance for free.
+        static constexpr bool is_stateless_fn = std::is_empty_v<fn_t> && std::default_initializable<fn_t>;
+        using fn_handle_t = std::conditional_t<is_stateless_fn, fn_t, fn_t const *>;
+
         base_tree_t _wrappee{};
         transform_box_t _label_fn{};
 
@@ -46,7 +66,10 @@ namespace libjst
         {}
 
         constexpr node_impl root() const noexcept {
-            return node_impl{libjst::root(_wrappee), _label_fn};
+            if constexpr (is_stateless_fn)
+                return node_impl{libjst::root(_wrappee), fn_handle_t{}};
+            else
+                return node_impl{libjst::root(_wrappee), std::addressof(*_label_fn)};
         }
         constexpr sink_impl sink() const noexcept {
             return sink_impl{libjst::sink(_wrappee)};
@@ -59,13 +82,20 @@ namespace libjst
 
         friend transform_tree_impl;
 
-        transform_box_t _fn{};
+        [[no_unique_address]] fn_handle_t _fn{};
 
-        explicit constexpr node_impl(base_node_type && base_node, transform_box_t fn) noexcept :
+        explicit constexpr node_impl(base_node_type && base_node, fn_handle_t fn) noexcept :
             base_node_type{std::move(base_node)},
             _fn{std::move(fn)}
         {}
 
+        constexpr fn_t const & fn() const noexcept {
+            if constexpr (is_stateless_fn)
+                return _fn;
+            else
+                return *_fn;
+        }
+
     public:
 
         node_impl() = default;
@@ -75,7 +105,7 @@ namespace libjst
         node_impl & operator=(node_impl &&) = default;
 
         constexpr auto operator*() const noexcept {
-            return std::invoke(_fn, *static_cast<base_node_type const &>(*this));
+            return std::invoke(fn(), *static_cast<base_node_type const &>(*this));
         }
 
         constexpr std::optional<node_impl> next_alt() const noexcept {
@@ -0,0 +1,114 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::tree_metrics, the opt-in instrumentation of the tree adaptors.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+/*!\brief Enables the recording of the libjst::tree_metrics if defined to a non-zero value; disabled by default.
+ *
+ * \details
+ *
+ * Set by the CMake option `LIBJST_TREE_METRICS` for all targets linking libjst. When disabled, the hooks of the
+ * adaptors are discarded at compile time and the traversal does not pay for them.
+ */
+#ifndef LIBJST_TREE_METRICS
+#define LIBJST_TREE_METRICS 0
+#endif
+
+namespace libjst
+{
+    //!\brief Whether the tree adaptors record their libjst::tree_metrics.
+    inline constexpr bool tree_metrics_enabled = static_cast<bool>(LIBJST_TREE_METRICS);
+
+    //!\brief The counters of a single tree adaptor.
+    struct adaptor_metrics {
+        std::size_t nodes_created{}; //!< The children returned by the adaptor.
+        std::size_t nodes_pruned{}; //!< The children of the wrapped tree discarded by the adaptor.
+        std::size_t coverage_operations{}; //!< The coverage intersections and differences computed by the adaptor.
+        std::size_t label_copies{}; //!< The journals cloned for the labels of the alternate children.
+        std::size_t label_bytes{}; //!< The bytes of the journal records copied by the clones.
+        std::size_t extend_steps{}; //!< The steps a node was extended or jumped along the reference.
+        std::size_t ref_jumps{}; //!< The extend steps that moved the node in place instead of creating a child.
+
+        adaptor_metrics & operator+=(adaptor_metrics const & other) noexcept {
+            nodes_created += other.nodes_created;
+            nodes_pruned += other.nodes_pruned;
+            coverage_operations += other.coverage_operations;
+            label_copies += other.label_copies;
+            label_bytes += other.label_bytes;
+            extend_steps += other.extend_steps;
+            ref_jumps += other.ref_jumps;
+            return *this;
+        }
+
+        friend constexpr bool operator==(adaptor_metrics const &, adaptor_metrics const &) noexcept = default;
+    };
+
+    /*!\brief The counters of the tree adaptors recorded while traversing a tree.
+     *
+     * \details
+     *
+     * Every adaptor counts the nodes it creates, i.e. also the reference children that libjst::merge_tree_impl
+     * consumes to extend a node, such that the counts of the inner adaptors show the work hidden by the outer ones.
+     * The metrics are recorded per thread if libjst::tree_metrics_enabled is set. libjst::stats reports the metrics
+     * of its own traversal in libjst::tree_stats::metrics.
+     */
+    struct tree_metrics {
+        adaptor_metrics labelled{}; //!< The metrics of libjst::labelled.
+        adaptor_metrics coloured{}; //!< The metrics of libjst::coloured.
+        adaptor_metrics trim{}; //!< The metrics of libjst::trim.
+        adaptor_metrics prune{}; //!< The metrics of libjst::prune.
+        adaptor_metrics merge{}; //!< The metrics of libjst::merge.
+
+        tree_metrics & operator+=(tree_metrics const & other) noexcept {
+            labelled += other.labelled;
+            coloured += other.coloured;
+            trim += other.trim;
+            prune += other.prune;
+            merge += other.merge;
+            return *this;
+        }
+
+        friend constexpr bool operator==(tree_metrics const &, tree_metrics const &) noexcept = default;
+    };
+
+    namespace detail
+    {
+        //!\brief The metrics recorded by the calling thread.
+        inline tree_metrics & thread_tree_metrics() noexcept {
+            thread_local tree_metrics metrics{};
+            return metrics;
+        }
+
+        //!\brief Adds the count to the given counter of the given adaptor, if libjst::tree_metrics_enabled is set.
+        template <auto adaptor_member, auto counter_member>
+        constexpr void count_tree_metric([[maybe_unused]] std::size_t const count = 1) noexcept {
+            if constexpr (tree_metrics_enabled) {
+                if (!std::is_constant_evaluated())
+                    (thread_tree_metrics().*adaptor_member).*counter_member += count;
+            }
+        }
+    } // namespace detail
+
+    //!\brief Returns the metrics recorded by the calling thread since the last reset.
+    inline tree_metrics thread_tree_metrics() noexcept {
+        return detail::thread_tree_metrics();
+    }
+
+    //!\brief Resets the metrics of the calling thread and returns the metrics recorded before.
+    inline tree_metrics reset_tree_metrics() noexcept {
+        return std::exchange(detail::thread_tree_metrics(), tree_metrics{});
+    }
+}  // namespace libjst
@@ -14,8 +14,11 @@
 
 #include <libjst/utility/closure_object.hpp>
 
+#include <libjst/sequence_tree/branch_jump_table.hpp>
+#include <libjst/sequence_tree/breakend_site.hpp>
 #include <libjst/sequence_tree/breakend_site_trimmed.hpp>
 #include <libjst/sequence_tree/concept.hpp>
+#include <libjst/sequence_tree/tree_metrics.hpp>
 namespace libjst
 {
     template <typename base_tree_t>
@@ -78,23 +81,43 @@ namespace libjst
 
     public:
 
-        using low_position_type = base_low_position_type;
+        using low_position_type = breakend_site_trimmed<base_low_position_type>;
         using high_position_type = breakend_site_trimmed<base_high_position_type>;
 
         node_impl() = default;
 
         constexpr std::optional<node_impl> next_alt() const noexcept {
-            if (is_leaf())
+            if (is_leaf()) {
+                detail::count_tree_metric<&tree_metrics::trim, &adaptor_metrics::nodes_pruned>();
                 return std::nullopt;
+            }
             return visit<true>(base_node_type::next_alt());
         }
 
         constexpr std::optional<node_impl> next_ref() const noexcept {
-            if (is_leaf())
+            if (is_leaf()) {
+                detail::count_tree_metric<&tree_metrics::trim, &adaptor_metrics::nodes_pruned>();
                 return std::nullopt;
+            }
             return visit<false>(base_node_type::next_ref());
         }
 
+        /*!\brief Returns the low boundary, which is moved to the trimmed high boundary if the branch ends before it.
+         *
+         * \details
+         *
+         * An insertion has no extent on the source, such that the high boundary of an insertion exceeding the
+         * remaining branch is trimmed below its low boundary. The label then ends at the trimmed high boundary, from
+         * where it is extended to the left.
+         */
+        constexpr low_position_type low_boundary() const {
+            base_low_position_type base_low = base_node_type::low_boundary();
+            if (this->on_alternate_path())
+                return low_position_type{std::move(base_low), libjst::position(high_boundary())};
+            else
+                return low_position_type{std::move(base_low)};
+        }
+
         constexpr high_position_type high_boundary() const {
             base_high_position_type base_high = base_node_type::high_boundary();
             if (this->on_alternate_path()) {
@@ -113,6 +136,28 @@ namespace libjst
             return cargo_impl{this};
         }
 
+        //!\brief Jumps along the reference if the branch is not exhausted before the target breakend.
+        constexpr bool jump_ref(detail::ref_jump_target_t<base_node_type> target) noexcept
+            requires detail::ref_jumpable_node<base_node_type>
+        {
+            // A node reaching the sink has no breakend behind it and the target is not dereferenceable.
+            if (is_leaf() || static_cast<base_node_type const &>(*this) == sink_type{})
+                return false;
+            if (!this->on_alternate_path())
+                return base_node_type::jump_ref(std::move(target));
+
+            // The reference children consume the branch by the distance between their boundaries.
+            breakend_site<detail::ref_jump_target_t<base_node_type>> target_site{target, (*target).get_breakpoint_end()};
+            difference_type const child_remaining = _max_branch_size -
+                                                    (libjst::position(target_site) -
+                                                     libjst::position(base_node_type::high_boundary()));
+            if (child_remaining <= 0 || !base_node_type::jump_ref(std::move(target)))
+                return false;
+
+            _max_branch_size = child_remaining;
+            return true;
+        }
+
     private:
 
         constexpr bool is_leaf() const noexcept {
@@ -122,6 +167,7 @@ namespace libjst
         template <bool is_alt_node, typename maybe_child_t>
         constexpr std::optional<node_impl> visit(maybe_child_t maybe_child) const {
             if (maybe_child) {
+                detail::count_tree_metric<&tree_metrics::trim, &adaptor_metrics::nodes_created>();
                 if (is_alt_node && !this->on_alternate_path()) {
                     return make_alternate_subtree(std::move(*maybe_child));
                 } else if (this->on_alternate_path()) {
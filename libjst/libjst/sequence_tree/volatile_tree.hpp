@@ -12,6 +12,9 @@
 
 #pragma once
 
+#include <cassert>
+#include <iterator>
+
 #include <libjst/utility/closure_object.hpp>
 
 #include <libjst/sequence_tree/concept.hpp>
@@ -22,14 +25,19 @@
 
 namespace libjst
 {
-    template <typename rcs_store_t>
+    /*!\brief A sequence tree over the whole source of a store.
+     *
+     * \tparam rcs_store_t The type of the store.
+     * \tparam prefetch_distance The number of breakends the nodes prefetch ahead, see libjst::breakpoint_node.
+     */
+    template <typename rcs_store_t, std::ptrdiff_t prefetch_distance = default_prefetch_distance>
     class volatile_tree {
     private:
 
         using variants_type = typename rcs_store_t::variant_map_type;
         using variant_type = std::ranges::range_value_t<variants_type>;
         using breakend_iterator = std::ranges::iterator_t<variants_type const &>;
-        using node_type = breakpoint_node<breakend_iterator>;
+        using node_type = breakpoint_node<breakend_iterator, prefetch_distance>;
         using position_type = typename node_type::position_type;
 
         class node_impl;
@@ -62,8 +70,8 @@ namespace libjst
         }
     };
 
-    template <typename rcs_store_t>
-    class volatile_tree<rcs_store_t>::node_impl : public node_type {
+    template <typename rcs_store_t, std::ptrdiff_t prefetch_distance>
+    class volatile_tree<rcs_store_t, prefetch_distance>::node_impl : public node_type {
     private:
 
         friend volatile_tree;
@@ -98,6 +106,30 @@ namespace libjst
             return {};
         }
 
+        /*!\brief Moves a reference node along the reference until its high boundary is the given breakend.
+         *
+         * \details
+         *
+         * All breakends between the current high boundary and the target must be high ends, see
+         * libjst::branch_jump_table. Returns `false` and leaves the node unchanged if this is not a reference node.
+         */
+        constexpr bool jump_ref(breakend_iterator target) noexcept {
+            if (!this->from_reference() || is_leaf())
+                return false;
+
+            assert(base_t::high_boundary().get_breakend() < target);
+            breakend_iterator low_breakend = std::ranges::prev(target);
+            breakpoint_end const low_site = (*low_breakend).get_breakpoint_end();
+            breakpoint_end const high_site = (*target).get_breakpoint_end();
+            if constexpr (prefetch_distance > 0)
+                libjst::prefetch_ahead(target, prefetch_distance);
+            base_t child{position_type{std::move(low_breakend), low_site}, position_type{std::move(target), high_site}};
+            if (this->on_alternate_path())
+                child.toggle_alternate_path();
+            static_cast<base_t &>(*this) = std::move(child);
+            return true;
+        }
+
     protected:
 
         template <typename breakend_site_t>
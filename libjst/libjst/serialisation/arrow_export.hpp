@@ -0,0 +1,514 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides the export of hit batches and variant tables as record batches of the Arrow C data interface.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <libjst/coverage/concept.hpp>
+#include <libjst/coverage/coverage_members.hpp>
+#include <libjst/sequence_tree/seek_position.hpp>
+#include <libjst/sequence_tree/seek_position_codec.hpp>
+#include <libjst/variant/alternate_sequence_kind.hpp>
+#include <libjst/variant/concept.hpp>
+
+// The structures of the Arrow C data interface, which is an ABI stable across Arrow implementations and versions.
+// They are defined by the specification to be copied into producers, such that no Arrow library is required.
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+extern "C" {
+
+struct ArrowSchema {
+    // Array type description
+    const char * format;
+    const char * name;
+    const char * metadata;
+    int64_t flags;
+    int64_t n_children;
+    struct ArrowSchema ** children;
+    struct ArrowSchema * dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowSchema *);
+    // Opaque producer-specific data
+    void * private_data;
+};
+
+struct ArrowArray {
+    // Array data description
+    int64_t length;
+    int64_t null_count;
+    int64_t offset;
+    int64_t n_buffers;
+    int64_t n_children;
+    const void ** buffers;
+    struct ArrowArray ** children;
+    struct ArrowArray * dictionary;
+
+    // Release callback
+    void (*release)(struct ArrowArray *);
+    // Opaque producer-specific data
+    void * private_data;
+};
+
+}  // extern "C"
+
+#endif  // ARROW_C_DATA_INTERFACE
+
+namespace libjst
+{
+    namespace detail::arrow
+    {
+        // ----------------------------------------------------------------------------
+        // Arrays
+        // ----------------------------------------------------------------------------
+
+        // Every exported array shares the ownership of the columns, such that a child moved out of its parent by the
+        // consumer keeps its buffers alive after the parent was released.
+        struct array_private {
+            std::shared_ptr<void const> owner{};
+            std::vector<void const *> buffers{};
+            std::vector<ArrowArray *> children{};
+            ArrowArray * dictionary{};
+        };
+
+        inline void release_array(ArrowArray * array) noexcept;
+
+        // Releases a child unless the consumer has moved it, and frees the structure allocated by its parent.
+        inline void release_child(ArrowArray * child) noexcept {
+            if (child->release != nullptr)
+                child->release(child);
+            delete child;
+        }
+
+        inline void release_array(ArrowArray * array) noexcept {
+            auto * data = static_cast<array_private *>(array->private_data);
+            std::ranges::for_each(data->children, release_child);
+            if (data->dictionary != nullptr)
+                release_child(data->dictionary);
+            delete data;
+            array->release = nullptr;
+        }
+
+        struct array_deleter {
+            void operator()(ArrowArray * array) const noexcept {
+                release_child(array);
+            }
+        };
+
+        using array_ptr = std::unique_ptr<ArrowArray, array_deleter>;
+
+        // Exports the buffers, which must stay valid as long as the owner, and takes the children and the dictionary.
+        inline void make_array(ArrowArray * array,
+                               std::shared_ptr<void const> owner,
+                               std::size_t const length,
+                               std::vector<void const *> buffers,
+                               std::vector<array_ptr> children = {},
+                               array_ptr dictionary = nullptr) {
+            auto data = std::make_unique<array_private>();
+            data->owner = std::move(owner);
+            data->buffers = std::move(buffers);
+            data->children.reserve(children.size());
+            for (array_ptr & child : children)
+                data->children.push_back(child.release());
+            data->dictionary = dictionary.release();
+
+            *array = ArrowArray{.length = static_cast<int64_t>(length),
+                                .null_count = 0,
+                                .offset = 0,
+                                .n_buffers = static_cast<int64_t>(data->buffers.size()),
+                                .n_children = static_cast<int64_t>(data->children.size()),
+                                .buffers = data->buffers.data(),
+                                .children = data->children.data(),
+                                .dictionary = data->dictionary,
+                                .release = release_array,
+                                .private_data = data.get()};
+            data.release();
+        }
+
+        template <typename ...args_t>
+        array_ptr new_array(args_t && ...args) {
+            array_ptr array{new ArrowArray{}};
+            make_array(array.get(), (args_t &&) args...);
+            return array;
+        }
+
+        // ----------------------------------------------------------------------------
+        // Schemas
+        // ----------------------------------------------------------------------------
+
+        struct schema_private {
+            std::string format{};
+            std::string name{};
+            std::vector<ArrowSchema *> children{};
+            ArrowSchema * dictionary{};
+        };
+
+        inline void release_schema(ArrowSchema * schema) noexcept;
+
+        inline void release_child(ArrowSchema * child) noexcept {
+            if (child->release != nullptr)
+                child->release(child);
+            delete child;
+        }
+
+        inline void release_schema(ArrowSchema * schema) noexcept {
+            auto * data = static_cast<schema_private *>(schema->private_data);
+            std::ranges::for_each(data->children, [] (ArrowSchema * child) { release_child(child); });
+            if (data->dictionary != nullptr)
+                release_child(data->dictionary);
+            delete data;
+            schema->release = nullptr;
+        }
+
+        struct schema_deleter {
+            void operator()(ArrowSchema * schema) const noexcept {
+                release_child(schema);
+            }
+        };
+
+        using schema_ptr = std::unique_ptr<ArrowSchema, schema_deleter>;
+
+        // Describes a non-nullable field of the given format, see the format strings of the Arrow C data interface.
+        inline void make_schema(ArrowSchema * schema,
+                                std::string format,
+                                std::string name,
+                                std::vector<schema_ptr> children = {},
+                                schema_ptr dictionary = nullptr) {
+            auto data = std::make_unique<schema_private>();
+            data->format = std::move(format);
+            data->name = std::move(name);
+            data->children.reserve(children.size());
+            for (schema_ptr & child : children)
+                data->children.push_back(child.release());
+            data->dictionary = dictionary.release();
+
+            *schema = ArrowSchema{.format = data->format.c_str(),
+                                  .name = data->name.c_str(),
+                                  .metadata = nullptr,
+                                  .flags = 0,
+                                  .n_children = static_cast<int64_t>(data->children.size()),
+                                  .children = data->children.data(),
+                                  .dictionary = data->dictionary,
+                                  .release = release_schema,
+                                  .private_data = data.get()};
+            data.release();
+        }
+
+        template <typename ...args_t>
+        schema_ptr new_schema(args_t && ...args) {
+            schema_ptr schema{new ArrowSchema{}};
+            make_schema(schema.get(), (args_t &&) args...);
+            return schema;
+        }
+
+        // ----------------------------------------------------------------------------
+        // Columns
+        // ----------------------------------------------------------------------------
+
+        // The names of the alternate sequence kinds, indexed by their value.
+        inline constexpr std::array<std::string_view, 3> alt_kind_names{"insertion", "replacement", "deletion"};
+
+        // The kind names as the offsets and the characters of an utf8 column.
+        struct alt_kind_column {
+            std::array<int32_t, alt_kind_names.size() + 1> offsets{};
+            std::string symbols{};
+
+            alt_kind_column() {
+                for (std::size_t kind = 0; kind < alt_kind_names.size(); ++kind) {
+                    symbols.append(alt_kind_names[kind]);
+                    offsets[kind + 1] = static_cast<int32_t>(symbols.size());
+                }
+            }
+        };
+    } // namespace detail::arrow
+
+    /*!\brief Exports a batch of hits as a record batch of the Arrow C data interface.
+     *
+     * \param[in] batch The batch to export, e.g. a libjst::hit_buffer::batch_type moved out of the consumer.
+     * \param[out] schema Receives the schema of the record batch; must be released by the consumer.
+     * \param[out] array Receives the columns of the record batch; must be released by the consumer.
+     *
+     * \details
+     *
+     * The record batch is a struct array with one row per hit and the columns
+     *  * `seek_position`: the libjst::seek_position of the label containing the hit as large binary holding its
+     *    variable-length libjst::seek_position_codec encoding, which is decoded with libjst::seek_position_codec::decode
+     *    to seek the hit in the tree later, also by another process;
+     *  * `variant_index`: the uint64 index of the breakend the seek position starts from;
+     *  * `offset`: the uint64 offset of the last symbol of the hit within its label;
+     *  * `coverage`: the haplotypes sharing the label as dictionary of bitmaps, whose uint32 indices select a fixed
+     *    size binary value per distinct coverage. Bit `i` of the value, in the bit order of the Arrow validity
+     *    bitmaps, is set if the `i`-th haplotype of the coverage domain shares the label.
+     *
+     * The batch is moved into the exported columns: the offsets and the coverage indices are handed to the consumer
+     * without a copy, and only the encoded seek positions, the variant indices and the bitmaps of the distinct
+     * coverages are computed. The columns are freed once the consumer has released the array and all of its children.
+     */
+    template <typename batch_t>
+        requires requires (batch_t & batch) {
+            { batch.positions.data() } -> std::same_as<seek_position *>;
+            { batch.offsets.data() } -> std::same_as<std::size_t *>;
+            { batch.coverage_ids.data() } -> std::same_as<uint32_t *>;
+            { batch.coverages.data() };
+        }
+    void export_arrow_hits(batch_t batch, ArrowSchema * schema, ArrowArray * array)
+    {
+        namespace arrow = detail::arrow;
+
+        static_assert(sizeof(std::size_t) == sizeof(uint64_t), "The offsets are exported as uint64.");
+
+        struct columns_type {
+            batch_t batch;
+            std::vector<int64_t> position_offsets{};
+            std::vector<std::byte> position_bytes{};
+            std::vector<uint64_t> variant_indices{};
+            std::vector<uint64_t> bitmaps{};
+        };
+
+        auto columns = std::make_shared<columns_type>(columns_type{.batch = std::move(batch)});
+        auto const & hits = columns->batch;
+        std::size_t const hit_count = hits.positions.size();
+
+        columns->position_offsets.reserve(hit_count + 1);
+        columns->position_offsets.push_back(0);
+        columns->variant_indices.reserve(hit_count);
+        for (seek_position const & position : hits.positions) {
+            seek_position_codec::encode(position, columns->position_bytes);
+            columns->position_offsets.push_back(static_cast<int64_t>(columns->position_bytes.size()));
+            columns->variant_indices.push_back(position.get_variant_index());
+        }
+
+        // The bitmaps of all coverages are padded to the words of the largest domain.
+        std::size_t word_count{};
+        for (auto const & coverage : hits.coverages)
+            word_count = std::max<std::size_t>(word_count, (libjst::get_domain(coverage).size() + 63) / 64);
+        word_count = std::max<std::size_t>(word_count, 1);
+
+        columns->bitmaps.resize(hits.coverages.size() * word_count);
+        for (std::size_t coverage_id = 0; coverage_id < hits.coverages.size(); ++coverage_id) {
+            auto const & coverage = hits.coverages[coverage_id];
+            auto const & domain = libjst::get_domain(coverage);
+            std::size_t const domain_size = domain.size();
+            for (std::size_t word = 0; word * 64 < domain_size; ++word)
+                columns->bitmaps[coverage_id * word_count + word] =
+                    libjst::covered_bits(coverage, domain.min() + word * 64, std::min<std::size_t>(64, domain_size - word * 64));
+        }
+
+        std::shared_ptr<void const> owner = columns;
+        std::vector<arrow::array_ptr> column_arrays{};
+        column_arrays.push_back(arrow::new_array(owner, hit_count,
+                                                 std::vector<void const *>{nullptr,
+                                                                           columns->position_offsets.data(),
+                                                                           columns->position_bytes.data()}));
+        column_arrays.push_back(arrow::new_array(owner, hit_count,
+                                                 std::vector<void const *>{nullptr, columns->variant_indices.data()}));
+        column_arrays.push_back(arrow::new_array(owner, hit_count,
+                                                 std::vector<void const *>{nullptr, hits.offsets.data()}));
+        column_arrays.push_back(arrow::new_array(owner, hit_count,
+                                                 std::vector<void const *>{nullptr, hits.coverage_ids.data()},
+                                                 std::vector<arrow::array_ptr>{},
+                                                 arrow::new_array(owner, hits.coverages.size(),
+                                                                  std::vector<void const *>{nullptr,
+                                                                                            columns->bitmaps.data()})));
+
+        std::vector<arrow::schema_ptr> column_schemas{};
+        column_schemas.push_back(arrow::new_schema("Z", "seek_position"));
+        column_schemas.push_back(arrow::new_schema("L", "variant_index"));
+        column_schemas.push_back(arrow::new_schema("L", "offset"));
+        column_schemas.push_back(arrow::new_schema("I", "coverage", std::vector<arrow::schema_ptr>{},
+                                                   arrow::new_schema("w:" + std::to_string(word_count * 8), "")));
+
+        arrow::make_schema(schema, "+s", "", std::move(column_schemas));
+        try {
+            arrow::make_array(array, std::move(owner), hit_count, std::vector<void const *>{nullptr},
+                              std::move(column_arrays));
+        } catch (...) {
+            schema->release(schema);
+            throw;
+        }
+    }
+
+    /*!\brief Exports the variants of a multisequence as a record batch of the Arrow C data interface.
+     *
+     * \param[in] breakends The breakends of the multisequence, e.g. libjst::rcs_store::variants().
+     * \param[out] schema Receives the schema of the record batch; must be released by the consumer.
+     * \param[out] array Receives the columns of the record batch; must be released by the consumer.
+     * \param[in] thread_count The number of threads filling the columns; defaults to 1.
+     *
+     * \details
+     *
+     * The record batch is a struct array with one row per variant, i.e. per low breakend, in the stored order and
+     * the columns
+     *  * `position`: the uint64 position of the variant on the source;
+     *  * `kind`: the libjst::alternate_sequence_kind as dictionary with int8 indices into the utf8 names
+     *    `insertion`, `replacement` and `deletion`;
+     *  * `alt_sequence`: the alternate sequence as large utf8 string, empty for deletions;
+     *  * `carrier_count`: the uint32 number of haplotypes carrying the variant.
+     *
+     * The breakends are split into blocks of consecutive breakends, like libjst::dna_compressed_multisequence::extract.
+     * Every thread first counts the variants and the alternate symbols of its block, and after the prefix sums over
+     * the blocks writes its rows directly into the exported columns, such that no row is copied twice.
+     */
+    template <std::ranges::random_access_range breakends_t>
+    void export_arrow_variants(breakends_t const & breakends,
+                               ArrowSchema * schema,
+                               ArrowArray * array,
+                               std::size_t const thread_count = 1)
+    {
+        namespace arrow = detail::arrow;
+
+        struct columns_type {
+            std::vector<uint64_t> positions{};
+            std::vector<int8_t> kinds{};
+            std::vector<int64_t> alt_offsets{};
+            std::string alt_symbols{};
+            std::vector<uint32_t> carrier_counts{};
+            arrow::alt_kind_column kind_names{};
+        };
+
+        // The nil breakends at the begin and the end of the source are not exported.
+        std::size_t const breakend_count = std::max<std::size_t>(std::ranges::size(breakends), 2) - 2;
+        std::size_t const block_count = std::clamp<std::size_t>(thread_count, 1,
+                                                                std::max<std::size_t>(breakend_count, 1));
+        std::size_t const block_size = (breakend_count + block_count - 1) / block_count;
+
+        std::vector<std::size_t> first_rows(block_count + 1);
+        std::vector<std::size_t> first_symbols(block_count + 1);
+        std::vector<std::exception_ptr> errors(block_count);
+        auto columns = std::make_shared<columns_type>();
+
+        auto for_each_variant = [&] (std::size_t const block_id, auto && fn) {
+            std::size_t const first = 1 + std::min(block_id * block_size, breakend_count);
+            std::size_t const last = 1 + std::min(first - 1 + block_size, breakend_count);
+            auto breakend_it = std::ranges::next(std::ranges::begin(breakends), first);
+            auto breakend_end = std::ranges::next(std::ranges::begin(breakends), last);
+            for (; breakend_it != breakend_end; ++breakend_it) {
+                auto && breakend = *breakend_it;
+                if (breakend.get_breakpoint_end() == breakpoint_end::high)
+                    continue;
+                fn(breakend);
+            }
+        };
+
+        auto run_blocks = [&] (auto && block_fn) {
+            auto run_block = [&] (std::size_t const block_id) {
+                try {
+                    block_fn(block_id);
+                } catch (...) {
+                    errors[block_id] = std::current_exception();
+                }
+            };
+
+            std::vector<std::thread> workers{};
+            workers.reserve(block_count - 1);
+            for (std::size_t block_id = 1; block_id < block_count; ++block_id)
+                workers.emplace_back(run_block, block_id);
+
+            run_block(0); // the calling thread processes the first block.
+            std::ranges::for_each(workers, [] (std::thread & worker) { worker.join(); });
+
+            if (auto error = std::ranges::find_if(errors, [] (std::exception_ptr const & e) { return e != nullptr; });
+                error != errors.end())
+                std::rethrow_exception(*error);
+        };
+
+        // Counts the rows and the alternate symbols of every block.
+        run_blocks([&] (std::size_t const block_id) {
+            for_each_variant(block_id, [&] (auto && variant) {
+                ++first_rows[block_id + 1];
+                first_symbols[block_id + 1] += std::ranges::size(libjst::alt_sequence(variant));
+            });
+        });
+        for (std::size_t block_id = 0; block_id < block_count; ++block_id) {
+            first_rows[block_id + 1] += first_rows[block_id];
+            first_symbols[block_id + 1] += first_symbols[block_id];
+        }
+
+        std::size_t const variant_count = first_rows.back();
+        columns->positions.resize(variant_count);
+        columns->kinds.resize(variant_count);
+        columns->alt_offsets.resize(variant_count + 1);
+        columns->alt_symbols.resize(first_symbols.back());
+        columns->carrier_counts.resize(variant_count);
+
+        // Writes the rows of every block behind the rows of the preceding blocks.
+        run_blocks([&] (std::size_t const block_id) {
+            std::size_t row = first_rows[block_id];
+            std::size_t symbol = first_symbols[block_id];
+            for_each_variant(block_id, [&] (auto && variant) {
+                auto && coverage = libjst::coverage(variant);
+                columns->positions[row] = static_cast<uint64_t>(libjst::position(variant));
+                columns->kinds[row] = static_cast<int8_t>(libjst::alt_kind(variant));
+                columns->carrier_counts[row] =
+                    static_cast<uint32_t>(libjst::coverage_intersection_count(coverage, coverage));
+                columns->alt_offsets[row] = static_cast<int64_t>(symbol);
+                for (auto && alt_symbol : libjst::alt_sequence(variant))
+                    columns->alt_symbols[symbol++] = static_cast<char>(alt_symbol);
+                ++row;
+            });
+        });
+        columns->alt_offsets.back() = static_cast<int64_t>(columns->alt_symbols.size());
+
+        std::shared_ptr<void const> owner = columns;
+        arrow::alt_kind_column const & kind_names = columns->kind_names;
+        std::vector<arrow::array_ptr> column_arrays{};
+        column_arrays.push_back(arrow::new_array(owner, variant_count,
+                                                 std::vector<void const *>{nullptr, columns->positions.data()}));
+        column_arrays.push_back(arrow::new_array(owner, variant_count,
+                                                 std::vector<void const *>{nullptr, columns->kinds.data()},
+                                                 std::vector<arrow::array_ptr>{},
+                                                 arrow::new_array(owner, arrow::alt_kind_names.size(),
+                                                                  std::vector<void const *>{nullptr,
+                                                                                            kind_names.offsets.data(),
+                                                                                            kind_names.symbols.data()})));
+        column_arrays.push_back(arrow::new_array(owner, variant_count,
+                                                 std::vector<void const *>{nullptr,
+                                                                           columns->alt_offsets.data(),
+                                                                           columns->alt_symbols.data()}));
+        column_arrays.push_back(arrow::new_array(owner, variant_count,
+                                                 std::vector<void const *>{nullptr, columns->carrier_counts.data()}));
+
+        std::vector<arrow::schema_ptr> column_schemas{};
+        column_schemas.push_back(arrow::new_schema("L", "position"));
+        column_schemas.push_back(arrow::new_schema("c", "kind", std::vector<arrow::schema_ptr>{},
+                                                   arrow::new_schema("u", "")));
+        column_schemas.push_back(arrow::new_schema("U", "alt_sequence"));
+        column_schemas.push_back(arrow::new_schema("I", "carrier_count"));
+
+        arrow::make_schema(schema, "+s", "", std::move(column_schemas));
+        try {
+            arrow::make_array(array, std::move(owner), variant_count, std::vector<void const *>{nullptr},
+                              std::move(column_arrays));
+        } catch (...) {
+            schema->release(schema);
+            throw;
+        }
+    }
+}  // namespace libjst
@@ -34,6 +34,15 @@ namespace libjst::detail {
 
 #endif
 
+namespace libjst::detail {
+
+    template <typename archive_t>
+    concept raw_input_archive = requires { requires archive_t::is_raw_input_archive; };
+
+    template <typename archive_t>
+    concept raw_output_archive = requires { requires archive_t::is_raw_output_archive; };
+}
+
 /**
  * @defgroup serialisation Serialisation
  *
@@ -69,13 +78,24 @@ namespace libjst {
                 return libjst::tag_invoke(_cpo{}, object, iarchive);
             }
 
+            /**
+             * @brief Overload for the libjst::raw_binary_input_archive, which does not depend on cereal.
+             */
+            template <typename object_t, detail::raw_input_archive iarchive_t>
+                requires (libjst::tag_invocable<_cpo, object_t&, iarchive_t&>)
+            constexpr auto operator()(object_t& object, iarchive_t& iarchive) const
+                noexcept(libjst::is_nothrow_tag_invocable_v<_cpo, object_t&, iarchive_t &>)
+                -> libjst::tag_invoke_result_t<_cpo, object_t&, iarchive_t&> {
+                return libjst::tag_invoke(_cpo{}, object, iarchive);
+            }
+
             /**
              * @brief Default overload if cereal is not available.
              *
              * This overload will always throw a std::runtime_error.
              */
             template <typename object_t, typename iarchive_t>
-                requires (!detail::has_cereal)
+                requires (!detail::has_cereal) && (!detail::raw_input_archive<iarchive_t>)
             constexpr void operator()(object_t&, iarchive_t&) const {
                 throw std::runtime_error("libjst::load: cereal is not available");
             }
@@ -142,13 +162,24 @@ namespace libjst {
                 return libjst::tag_invoke(_cpo{}, object, oarchive);
             }
 
+            /**
+             * @brief Overload for the libjst::raw_binary_output_archive, which does not depend on cereal.
+             */
+            template <typename object_t, detail::raw_output_archive oarchive_t>
+                requires (libjst::tag_invocable<_cpo, object_t const &, oarchive_t&>)
+            constexpr auto operator()(object_t const & object, oarchive_t& oarchive) const
+                noexcept(libjst::is_nothrow_tag_invocable_v<_cpo, object_t const &, oarchive_t &>)
+                -> libjst::tag_invoke_result_t<_cpo, object_t const &, oarchive_t&> {
+                return libjst::tag_invoke(_cpo{}, object, oarchive);
+            }
+
             /**
              * @brief This overload is only enabled if cereal is not available.
              *
              * This overload will always throw a std::runtime_error.
              */
             template <typename object_t, typename oarchive_t>
-                requires (!detail::has_cereal)
+                requires (!detail::has_cereal) && (!detail::raw_output_archive<oarchive_t>)
             void operator()(object_t&, oarchive_t&) const {
                 throw std::runtime_error("libjst::save: cereal is not available");
             }
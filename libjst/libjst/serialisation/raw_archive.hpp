@@ -0,0 +1,334 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides native binary archives writing contiguous data in bulk.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <libjst/serialisation/concept.hpp>
+
+#if __has_include(<cereal/types/base_class.hpp>)
+#include <cereal/types/base_class.hpp>
+#endif
+
+namespace libjst
+{
+    /*!\brief Whether objects of the type are archived as their bytes by the libjst::raw_binary_output_archive.
+     *
+     * \details
+     *
+     * Arithmetic and enumeration types are raw serialisable, and trivially copyable classes can opt in by declaring
+     * `static constexpr bool raw_serialisable = true`. Vectors and strings of raw serialisable values are archived
+     * with a single write.
+     */
+    template <typename value_t>
+    inline constexpr bool is_raw_serialisable_v = std::is_arithmetic_v<value_t> || std::is_enum_v<value_t> ||
+                                                  (std::is_trivially_copyable_v<value_t> &&
+                                                   requires { requires value_t::raw_serialisable; });
+
+    namespace detail
+    {
+        //!\brief The magic bytes and the version beginning every raw archive.
+        struct raw_archive_header {
+            std::array<char, 8> magic{'L', 'I', 'B', 'J', 'S', 'T', 'R', 'A'};
+            uint32_t version{1};
+            uint32_t byte_order{0x01020304}; //!< Detects archives written on a machine with another byte order.
+
+            constexpr friend bool operator==(raw_archive_header const &, raw_archive_header const &) noexcept = default;
+        };
+
+        //!\brief A FNV-1a checksum over the archived bytes, hashing eight bytes at once.
+        class raw_archive_checksum {
+        private:
+            uint64_t _hash{0xcbf29ce484222325ULL};
+            uint64_t _byte_count{};
+
+            static constexpr uint64_t prime{0x100000001b3ULL};
+
+        public:
+
+            void update(void const * data, std::size_t const byte_count) noexcept {
+                unsigned char const * bytes = static_cast<unsigned char const *>(data);
+                std::size_t offset{};
+                for (; offset + sizeof(uint64_t) <= byte_count; offset += sizeof(uint64_t)) {
+                    uint64_t word{};
+                    std::memcpy(&word, bytes + offset, sizeof(uint64_t));
+                    _hash = (_hash ^ word) * prime;
+                }
+                for (; offset < byte_count; ++offset)
+                    _hash = (_hash ^ bytes[offset]) * prime;
+                _byte_count += byte_count;
+            }
+
+            constexpr uint64_t value() const noexcept {
+                return _hash;
+            }
+
+            constexpr uint64_t byte_count() const noexcept {
+                return _byte_count;
+            }
+        };
+
+        template <typename object_t>
+        struct is_cereal_base_class : std::false_type {};
+
+#if __has_include(<cereal/types/base_class.hpp>)
+        template <typename base_t>
+        struct is_cereal_base_class<cereal::base_class<base_t>> : std::true_type {};
+#endif
+
+        template <typename object_t>
+        struct is_resizable_contiguous : std::false_type {};
+
+        template <typename value_t, typename allocator_t>
+        struct is_resizable_contiguous<std::vector<value_t, allocator_t>> : std::true_type {};
+
+        template <typename char_t, typename traits_t, typename allocator_t>
+        struct is_resizable_contiguous<std::basic_string<char_t, traits_t, allocator_t>> : std::true_type {};
+
+        template <typename object_t>
+        struct is_pair : std::false_type {};
+
+        template <typename first_t, typename second_t>
+        struct is_pair<std::pair<first_t, second_t>> : std::true_type {};
+
+        template <typename object_t>
+        struct is_array : std::false_type {};
+
+        template <typename value_t, std::size_t size>
+        struct is_array<std::array<value_t, size>> : std::true_type {};
+    } // namespace detail
+
+    /*!\brief A binary output archive writing the objects in the native memory layout of the machine.
+     *
+     * \details
+     *
+     * Like a cereal archive, the archive is invoked with the objects to save, which are archived with their member
+     * serialize function or with libjst::save, i.e. their member or free save function or a tag_invoke overload.
+     * In contrast to the per element archive calls of cereal, contiguous data is written in bulk: vectors and
+     * strings of raw serialisable values, see libjst::is_raw_serialisable_v, are written as their size and a single
+     * block, e.g. the breakend keys, the coverage words and the inserted sequences of a store.
+     *
+     * The archive begins with a header and is completed with libjst::raw_binary_output_archive::finish, which
+     * writes the number of archived bytes and their checksum. The destructor finishes the archive if this has not
+     * happened yet but swallows the errors. The archive is not portable between machines with another byte order
+     * or other layouts of the raw serialisable classes.
+     *
+     * Throws std::runtime_error if writing to the stream fails.
+     */
+    class raw_binary_output_archive {
+    private:
+
+        std::ostream * _stream{};
+        detail::raw_archive_checksum _checksum{};
+        bool _finished{};
+
+    public:
+
+        static constexpr bool is_raw_output_archive = true; //!< Selects the raw overload of libjst::save.
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        raw_binary_output_archive() = delete; //!< Deleted.
+        raw_binary_output_archive(raw_binary_output_archive const &) = delete; //!< Deleted.
+        raw_binary_output_archive & operator=(raw_binary_output_archive const &) = delete; //!< Deleted.
+
+        //!\brief Constructs the archive and writes the header to the stream.
+        explicit raw_binary_output_archive(std::ostream & stream) : _stream{&stream}
+        {
+            detail::raw_archive_header const header{};
+            write(&header, sizeof(header));
+        }
+
+        //!\brief Finishes the archive if this has not happened yet.
+        ~raw_binary_output_archive() {
+            try {
+                finish();
+            } catch (...) {
+            }
+        }
+        //!\}
+
+        //!\brief Saves the objects in the given order.
+        template <typename ...objects_t>
+        raw_binary_output_archive & operator()(objects_t const & ...objects) {
+            (process(objects), ...);
+            return *this;
+        }
+
+        //!\brief Writes the given bytes without a size prefix.
+        void save_binary(void const * data, std::size_t const byte_count) {
+            _checksum.update(data, byte_count);
+            write(data, byte_count);
+        }
+
+        //!\brief Writes the trailer, after which no further objects can be saved.
+        void finish() {
+            if (std::exchange(_finished, true))
+                return;
+
+            std::array<uint64_t, 2> const trailer{_checksum.byte_count(), _checksum.value()};
+            write(trailer.data(), sizeof(trailer));
+            _stream->flush();
+            if (!*_stream)
+                throw std::runtime_error{"Could not write the raw archive."};
+        }
+
+    private:
+
+        void write(void const * data, std::size_t const byte_count) {
+            _stream->write(static_cast<char const *>(data), static_cast<std::streamsize>(byte_count));
+            if (!*_stream)
+                throw std::runtime_error{"Could not write the raw archive."};
+        }
+
+        template <typename object_t>
+        void process(object_t const & object) {
+            if constexpr (is_raw_serialisable_v<object_t>) {
+                save_binary(std::addressof(object), sizeof(object_t));
+            } else if constexpr (detail::is_cereal_base_class<object_t>::value) {
+                process(*object.base_ptr);
+            } else if constexpr (requires { object.save(*this); }) {
+                libjst::save(object, *this);
+            } else if constexpr (requires (object_t & mutable_object) { mutable_object.serialize(*this); }) {
+                const_cast<object_t &>(object).serialize(*this);
+            } else if constexpr (detail::is_resizable_contiguous<object_t>::value) {
+                uint64_t const size = object.size();
+                save_binary(&size, sizeof(size));
+                if constexpr (is_raw_serialisable_v<typename object_t::value_type>) {
+                    save_binary(object.data(), size * sizeof(typename object_t::value_type));
+                } else {
+                    for (auto const & element : object)
+                        process(element);
+                }
+            } else if constexpr (detail::is_pair<object_t>::value) {
+                process(object.first);
+                process(object.second);
+            } else if constexpr (detail::is_array<object_t>::value) {
+                for (auto const & element : object)
+                    process(element);
+            } else {
+                libjst::save(object, *this);
+            }
+        }
+    };
+
+    /*!\brief A binary input archive reading the objects written by the libjst::raw_binary_output_archive.
+     *
+     * \details
+     *
+     * The objects must be loaded in the order they were saved. The header is validated on construction and the
+     * checksum by libjst::raw_binary_input_archive::finish.
+     *
+     * Throws std::runtime_error if the header is invalid, the stream ends prematurely or the checksum does not match.
+     */
+    class raw_binary_input_archive {
+    private:
+
+        std::istream * _stream{};
+        detail::raw_archive_checksum _checksum{};
+
+    public:
+
+        static constexpr bool is_raw_input_archive = true; //!< Selects the raw overload of libjst::load.
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        raw_binary_input_archive() = delete; //!< Deleted.
+        raw_binary_input_archive(raw_binary_input_archive const &) = delete; //!< Deleted.
+        raw_binary_input_archive & operator=(raw_binary_input_archive const &) = delete; //!< Deleted.
+
+        //!\brief Constructs the archive and validates the header read from the stream.
+        explicit raw_binary_input_archive(std::istream & stream) : _stream{&stream}
+        {
+            detail::raw_archive_header header{};
+            read(&header, sizeof(header));
+            if (header.magic != detail::raw_archive_header{}.magic)
+                throw std::runtime_error{"The stream does not contain a raw archive."};
+            if (header != detail::raw_archive_header{})
+                throw std::runtime_error{"The raw archive was written with another version or byte order."};
+        }
+        //!\}
+
+        //!\brief Loads the objects in the given order.
+        template <typename ...objects_t>
+        raw_binary_input_archive & operator()(objects_t && ...objects) {
+            (process(objects), ...);
+            return *this;
+        }
+
+        //!\brief Reads the given number of bytes written by libjst::raw_binary_output_archive::save_binary.
+        void load_binary(void * data, std::size_t const byte_count) {
+            read(data, byte_count);
+            _checksum.update(data, byte_count);
+        }
+
+        //!\brief Reads the trailer and validates the checksum of the loaded objects.
+        void finish() {
+            std::array<uint64_t, 2> trailer{};
+            read(trailer.data(), sizeof(trailer));
+            if (trailer[0] != _checksum.byte_count() || trailer[1] != _checksum.value())
+                throw std::runtime_error{"The checksum of the raw archive does not match."};
+        }
+
+    private:
+
+        void read(void * data, std::size_t const byte_count) {
+            _stream->read(static_cast<char *>(data), static_cast<std::streamsize>(byte_count));
+            if (static_cast<std::size_t>(_stream->gcount()) != byte_count)
+                throw std::runtime_error{"The raw archive ended prematurely."};
+        }
+
+        template <typename object_t>
+        void process(object_t & object) {
+            if constexpr (is_raw_serialisable_v<object_t>) {
+                load_binary(std::addressof(object), sizeof(object_t));
+            } else if constexpr (detail::is_cereal_base_class<object_t>::value) {
+                process(*object.base_ptr);
+            } else if constexpr (requires { object.load(*this); }) {
+                libjst::load(object, *this);
+            } else if constexpr (requires { object.serialize(*this); }) {
+                object.serialize(*this);
+            } else if constexpr (detail::is_resizable_contiguous<object_t>::value) {
+                uint64_t size{};
+                load_binary(&size, sizeof(size));
+                object.resize(size);
+                if constexpr (is_raw_serialisable_v<typename object_t::value_type>) {
+                    load_binary(object.data(), size * sizeof(typename object_t::value_type));
+                } else {
+                    for (auto & element : object)
+                        process(element);
+                }
+            } else if constexpr (detail::is_pair<object_t>::value) {
+                process(object.first);
+                process(object.second);
+            } else if constexpr (detail::is_array<object_t>::value) {
+                for (auto & element : object)
+                    process(element);
+            } else {
+                libjst::load(object, *this);
+            }
+        }
+    };
+}  // namespace libjst
@@ -0,0 +1,191 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides the stages of a search as libjst::task, which run on a scheduler shared by all stages.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <libjst/utility/task.hpp>
+
+namespace libjst
+{
+    /*!\brief Returns a task invoking the function on the scheduler.
+     *
+     * \param[in] scheduler The scheduler running the function; must outlive the task.
+     * \param[in] fn The function, which is stored in the task.
+     * \param[in] args The arguments, which are stored in the task and passed as lvalues.
+     *
+     * \returns A task producing the result of the function.
+     *
+     * \details
+     *
+     * The task does not run before it is awaited, e.g. within libjst::when_all to overlap it with other stages.
+     */
+    template <task_scheduler scheduler_t, typename fn_t, typename ...args_t>
+        requires std::invocable<fn_t &, args_t &...>
+    task<std::invoke_result_t<fn_t &, args_t &...>> async_invoke(scheduler_t & scheduler, fn_t fn, args_t ...args)
+    {
+        co_await libjst::schedule(scheduler);
+        co_return std::invoke(fn, args...);
+    }
+
+    /*!\brief Returns a task traversing the chunks concurrently on the scheduler.
+     *
+     * \param[in] scheduler The scheduler running the traversals; must outlive the task.
+     * \param[in] chunks The chunks to traverse, e.g. the shards of a libjst::shard_planner; must outlive the task.
+     * \param[in] traverse_fn Invoked as `traverse_fn(chunk)` for every chunk on a thread of the scheduler.
+     *
+     * \details
+     *
+     * Every chunk is traversed by its own job of the scheduler, such that the chunks are traversed by as many threads
+     * as the scheduler runs concurrently. The traversal function is shared by all jobs and must be safe to invoke
+     * concurrently. The exception of the first failed chunk is rethrown after all chunks were traversed.
+     */
+    template <task_scheduler scheduler_t, std::ranges::forward_range chunks_t, typename traverse_fn_t>
+        requires std::invocable<traverse_fn_t &, std::ranges::range_reference_t<chunks_t const>>
+    task<void> async_traverse_chunks(scheduler_t & scheduler, chunks_t const & chunks, traverse_fn_t traverse_fn)
+    {
+        std::vector<task<void>> traversals{};
+        for (auto chunk_it = std::ranges::begin(chunks); chunk_it != std::ranges::end(chunks); ++chunk_it)
+            traversals.push_back(libjst::async_invoke(scheduler, [&traverse_fn, chunk_it] () {
+                std::invoke(traverse_fn, *chunk_it);
+            }));
+        co_await libjst::when_all(std::move(traversals));
+    }
+
+    namespace detail
+    {
+        // Holds a loaded region, which is constructed in place from the result of the load function.
+        template <typename loaded_t>
+        struct async_loaded_region {
+            loaded_t value;
+
+            template <typename load_fn_t, typename region_t>
+            async_loaded_region(load_fn_t & load_fn, region_t && region) :
+                value{std::invoke(load_fn, (region_t &&) region)}
+            {}
+        };
+
+        // Loads the region on the calling thread into a region that is never moved.
+        template <typename load_fn_t, typename region_t>
+        auto make_loaded_region(load_fn_t & load_fn, region_t && region)
+        {
+            using loaded_t = std::remove_cvref_t<std::invoke_result_t<load_fn_t &, region_t>>;
+            auto holder = std::make_shared<async_loaded_region<loaded_t>>(load_fn, (region_t &&) region);
+            loaded_t * loaded = std::addressof(holder->value);
+            return std::shared_ptr<loaded_t>{std::move(holder), loaded};
+        }
+    } // namespace detail
+
+    /*!\brief Returns a task loading the region on the scheduler, e.g. by libjst::load_block_compressed_region.
+     *
+     * \param[in] scheduler The scheduler running the load; must outlive the task.
+     * \param[in] load_fn Invoked as `load_fn(region)` on a thread of the scheduler; returns the loaded region.
+     * \param[in] region The region to load, which is stored in the task.
+     *
+     * \returns A task producing the loaded region, which is constructed in place on the heap and never moved, since
+     *          stores like libjst::rcs_store must stay at the address they were constructed at.
+     */
+    template <task_scheduler scheduler_t, typename load_fn_t, typename region_t>
+        requires std::invocable<load_fn_t &, region_t &>
+    auto async_load_region(scheduler_t & scheduler, load_fn_t load_fn, region_t region)
+        -> task<std::shared_ptr<std::remove_cvref_t<std::invoke_result_t<load_fn_t &, region_t &>>>>
+    {
+        co_await libjst::schedule(scheduler);
+        co_return detail::make_loaded_region(load_fn, region);
+    }
+
+    /*!\brief Returns a task flushing the sink on the scheduler, e.g. a libjst::hit_buffer or libjst::hit_queue.
+     *
+     * \param[in] scheduler The scheduler running the flush; must outlive the task.
+     * \param[in] sink The sink to flush; must outlive the task.
+     */
+    template <task_scheduler scheduler_t, typename sink_t>
+        requires requires (sink_t & sink) { sink.flush(); }
+    task<void> async_flush(scheduler_t & scheduler, sink_t & sink)
+    {
+        co_await libjst::schedule(scheduler);
+        sink.flush();
+    }
+
+    /*!\brief Returns a task loading the next region while the current region is processed, both on the scheduler.
+     *
+     * \param[in] scheduler The scheduler running the loads and the processing; must outlive the task.
+     * \param[in] regions The regions to load; must outlive the task.
+     * \param[in] load_fn Invoked as `load_fn(region)` on a thread of the scheduler; returns the loaded region.
+     * \param[in] process_fn Invoked as `process_fn(region, loaded)` with the loaded region as lvalue on a thread of
+     *                       the scheduler in the order of the regions; the loaded region is destroyed afterwards.
+     *
+     * \details
+     *
+     * The asynchronous counterpart of libjst::region_pipeline with two buffers: region `i + 1` is loaded while region
+     * `i` is processed, but instead of a dedicated loader thread, the load and the processing are jobs of the given
+     * scheduler, which may run the stages of other searches as well. The processing can itself await further tasks,
+     * e.g. by returning a libjst::task from libjst::async_traverse_chunks, which is awaited before the region is
+     * destroyed. If a stage throws, no further regions are loaded and the first exception in the order of the regions
+     * is rethrown after the running stages completed.
+     */
+    template <task_scheduler scheduler_t, std::ranges::forward_range regions_t, typename load_fn_t,
+              typename process_fn_t>
+        requires std::invocable<load_fn_t &, std::ranges::range_reference_t<regions_t const>>
+    task<void> async_region_pipeline(scheduler_t & scheduler,
+                                     regions_t const & regions,
+                                     load_fn_t load_fn,
+                                     process_fn_t process_fn)
+    {
+        using region_reference_t = std::ranges::range_reference_t<regions_t const>;
+        using loaded_t = std::remove_cvref_t<std::invoke_result_t<load_fn_t &, region_reference_t>>;
+        using loaded_ptr_t = std::shared_ptr<loaded_t>;
+        using process_result_t = std::invoke_result_t<process_fn_t &, region_reference_t, loaded_t &>;
+
+        auto load = [&] (auto const & region_it, loaded_ptr_t & loaded) -> task<void> {
+            co_await libjst::schedule(scheduler);
+            loaded = detail::make_loaded_region(load_fn, *region_it);
+        };
+
+        auto process = [&] (auto const & region_it, loaded_ptr_t & loaded) -> task<void> {
+            co_await libjst::schedule(scheduler);
+            if constexpr (std::same_as<process_result_t, task<void>>)
+                co_await std::invoke(process_fn, *region_it, *loaded);
+            else
+                std::invoke(process_fn, *region_it, *loaded);
+            loaded.reset();
+        };
+
+        auto region_it = std::ranges::begin(regions);
+        auto const regions_end = std::ranges::end(regions);
+        if (region_it == regions_end)
+            co_return;
+
+        loaded_ptr_t current{};
+        co_await load(region_it, current);
+        for (auto next_it = std::ranges::next(region_it); region_it != regions_end; region_it = next_it++) {
+            if (next_it == regions_end) {
+                co_await process(region_it, current);
+                break;
+            }
+
+            loaded_ptr_t next{};
+            std::vector<task<void>> stages{};
+            stages.push_back(process(region_it, current));
+            stages.push_back(load(next_it, next));
+            co_await libjst::when_all(std::move(stages));
+            current = std::move(next);
+        }
+    }
+}  // namespace libjst
@@ -0,0 +1,102 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides jst search reporting the best hits and pruning the branches that cannot improve them.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <queue>
+#include <type_traits>
+#include <vector>
+
+#include <libjst/matcher/concept.hpp>
+#include <libjst/sequence_tree/coloured_tree.hpp>
+#include <libjst/sequence_tree/concept.hpp>
+#include <libjst/sequence_tree/labelled_tree.hpp>
+#include <libjst/sequence_tree/merge_tree.hpp>
+#include <libjst/sequence_tree/prune_unsupported.hpp>
+#include <libjst/sequence_tree/trim_tree.hpp>
+
+namespace libjst
+{
+    /*!\brief Searches the pattern like the libjst::state_capture_traverser but reports only the best hits.
+     *
+     * \details
+     *
+     * The traverser keeps the scores of the libjst::best_hits_traverser::hit_count best hits found so far and invokes
+     * the callback with the iterator to the last symbol of the hit, its label and its score only if the hit scores
+     * less than the worst of them, i.e. the best hits of the tree are among the reported ones, but a reported hit
+     * may be displaced by a later one.
+     *
+     * Once that many hits are found, the subtree below a node on an alternate path is skipped if the
+     * libjst::score_bounded_matcher reports a lower bound that is not better than the worst kept score. The
+     * occurrences in the skipped subtree, which begin after the variant, spell a sequence of a path branching off the
+     * reference path later on, and are hence found there.
+     */
+    struct best_hits_traverser {
+
+        std::size_t hit_count{1}; //!< The number of best hits to keep.
+
+        template <typename tree_t, typename pattern_t, typename callback_t>
+            requires score_bounded_matcher<std::remove_cvref_t<pattern_t>>
+        constexpr void operator()(tree_t && tree, pattern_t && pattern, callback_t && callback) const {
+            if (libjst::window_size(pattern) == 0 || hit_count == 0)
+                return;
+
+            auto search_tree = tree | libjst::labelled()
+                                    | libjst::coloured()
+                                    | trim(libjst::window_size(pattern) - 1)
+                                    | prune_unsupported()
+                                    | merge(); // make big nodes
+
+            using node_t = libjst::tree_node_t<decltype(search_tree)>;
+            using state_t = matcher_state_t<std::remove_cvref_t<pattern_t>>;
+            using score_t = std::remove_cvref_t<decltype(pattern.score())>;
+
+            struct branch {
+                node_t node;
+                state_t state;
+            };
+
+            std::priority_queue<score_t> best_scores{}; // the worst kept score on top
+            auto is_full = [&] () { return best_scores.size() == hit_count; };
+
+            std::vector<branch> branches{};
+            branches.push_back(branch{libjst::root(search_tree), pattern.capture()});
+            while (!branches.empty()) {
+                branch current = std::move(branches.back());
+                branches.pop_back();
+
+                auto label = *current.node;
+                pattern.restore(std::move(current.state));
+                pattern(label.sequence(), [&] (auto && label_it) {
+                    score_t const score = pattern.score();
+                    if (is_full() && !(score < best_scores.top()))
+                        return;
+
+                    best_scores.push(score);
+                    if (best_scores.size() > hit_count)
+                        best_scores.pop();
+                    callback(std::move(label_it), label, score);
+                });
+
+                if (current.node.on_alternate_path() && is_full() && !(pattern.lower_bound() < best_scores.top()))
+                    continue;
+
+                state_t state = pattern.capture();
+                if (auto ref_child = current.node.next_ref(); ref_child)
+                    branches.push_back(branch{std::move(*ref_child), state});
+                if (auto alt_child = current.node.next_alt(); alt_child)
+                    branches.push_back(branch{std::move(*alt_child), std::move(state)});
+            }
+        }
+    };
+}  // namespace libjst
@@ -0,0 +1,279 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides per chunk k-mer filters to skip the chunks that can not contain a hit.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <cereal/types/vector.hpp>
+
+#include <libjst/sequence_tree/coloured_tree.hpp>
+#include <libjst/sequence_tree/labelled_tree.hpp>
+#include <libjst/sequence_tree/left_extend_tree.hpp>
+#include <libjst/sequence_tree/merge_tree.hpp>
+#include <libjst/sequence_tree/prune_unsupported.hpp>
+#include <libjst/sequence_tree/trim_tree.hpp>
+#include <libjst/traversal/kmer_index.hpp>
+#include <libjst/traversal/tree_traverser_base.hpp>
+
+namespace libjst
+{
+    /*!\brief A Bloom filter of the k-mers of every chunk of a chunked tree.
+     *
+     * \details
+     *
+     * The filter of a chunk holds every k-mer of the haplotypes that ends within a window of `window_size` symbols
+     * ending in the chunk, i.e. the k-mers of all labels a search with a pattern of this window size visits in the
+     * chunk. If a chunk misses a k-mer of a pattern, the pattern can hence not end within this chunk, given that
+     * its matches are not longer than the window size. An approximate search with `e` errors is filtered by the
+     * q-gram lemma instead, see libjst::chunk_kmer_filter::threshold, whose matches may be `e` symbols longer.
+     * As every Bloom filter, the filter may accept a chunk that does not contain a k-mer, but never rejects a chunk
+     * that does.
+     *
+     * Every chunk has its own filter of `bits_per_chunk` bits, which are set by `hash_count` hash functions per
+     * k-mer. For `n` distinct k-mers per chunk, `bits_per_chunk = 10 * n` with seven hash functions yields a false
+     * positive rate of about one percent per k-mer. The filter of the chunk with index `i` refers to
+     * `forest.owned_chunk(i)` if the forest offers the owned chunks, like libjst::chunked_tree_impl, and to `forest[i]`
+     * otherwise. The filters can be stored alongside the store by the cereal archives and are handed to
+     * libjst::parallel_chunk_traverser::set_chunk_filter by libjst::chunk_kmer_filter::predicate.
+     */
+    class chunk_kmer_filter {
+    private:
+
+        static constexpr std::size_t word_bits = 64;
+
+        std::size_t _kmer_size{};
+        std::size_t _window_size{};
+        std::size_t _words_per_chunk{};
+        std::size_t _hash_count{};
+        std::vector<uint64_t> _words{};
+
+    public:
+
+        static constexpr std::size_t max_kmer_size = 32; //!< The maximal size of the filtered k-mers.
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        chunk_kmer_filter() = default; //!< Default.
+
+        /*!\brief Builds the filters of all chunks of the given forest.
+         *
+         * \param[in] forest The chunked tree, e.g. libjst::chunked_tree_impl.
+         * \param[in] kmer_size The size of the filtered k-mers.
+         * \param[in] window_size The size of the longest match the filter is used for.
+         * \param[in] bits_per_chunk The number of bits of the filter of every chunk; rounded up to a multiple of 64.
+         * \param[in] hash_count The number of hash functions; defaults to 3.
+         *
+         * \details
+         *
+         * Every chunk is traversed once with its labels trimmed and left extended by `window_size - 1` symbols, like
+         * the labels of a search. Throws std::invalid_argument if a size or the hash count is zero or the window is
+         * shorter than a k-mer, and std::length_error if the k-mer size exceeds libjst::chunk_kmer_filter::max_kmer_size.
+         */
+        template <std::ranges::random_access_range forest_t>
+        chunk_kmer_filter(forest_t const & forest,
+                          std::size_t const kmer_size,
+                          std::size_t const window_size,
+                          std::size_t const bits_per_chunk,
+                          std::size_t const hash_count = 3) :
+            _kmer_size{kmer_size},
+            _window_size{window_size},
+            _words_per_chunk{(bits_per_chunk + word_bits - 1) / word_bits},
+            _hash_count{hash_count}
+        {
+            if (kmer_size == 0 || bits_per_chunk == 0 || hash_count == 0)
+                throw std::invalid_argument{"The k-mer size, the filter size and the hash count must not be zero."};
+            if (window_size < kmer_size)
+                throw std::invalid_argument{"The window of the filter must not be shorter than its k-mers."};
+            if (kmer_size > max_kmer_size)
+                throw std::length_error{"The chunk filter supports k-mers of at most 32 symbols."};
+
+            std::size_t const chunk_count = std::ranges::size(forest);
+            _words.resize(chunk_count * _words_per_chunk);
+            for (std::size_t chunk_idx = 0; chunk_idx < chunk_count; ++chunk_idx) {
+                if constexpr (requires { forest.owned_chunk(chunk_idx); })
+                    insert_chunk(chunk_idx, forest.owned_chunk(chunk_idx));
+                else
+                    insert_chunk(chunk_idx, std::ranges::begin(forest)[chunk_idx]);
+            }
+        }
+        //!\}
+
+        constexpr std::size_t kmer_size() const noexcept {
+            return _kmer_size;
+        }
+
+        constexpr std::size_t window_size() const noexcept {
+            return _window_size;
+        }
+
+        constexpr std::size_t hash_count() const noexcept {
+            return _hash_count;
+        }
+
+        //!\brief Returns the number of filtered chunks.
+        constexpr std::size_t chunk_count() const noexcept {
+            return (_words_per_chunk == 0) ? 0 : _words.size() / _words_per_chunk;
+        }
+
+        //!\brief Returns the number of bits of the filter of every chunk.
+        constexpr std::size_t bits_per_chunk() const noexcept {
+            return _words_per_chunk * word_bits;
+        }
+
+        /*!\brief Returns the number of the k-mers of a pattern a chunk must contain to hold a match with errors.
+         *
+         * \details
+         *
+         * By the q-gram lemma, every edit of a match destroys at most `kmer_size` of the k-mers of the pattern, such
+         * that a match with `errors` edits shares at least `kmer_count - errors * kmer_size` k-mers with the pattern.
+         * A threshold of zero accepts every chunk.
+         */
+        constexpr std::size_t threshold(std::size_t const kmer_count, std::size_t const errors) const noexcept {
+            return kmer_count - std::min(kmer_count, errors * _kmer_size);
+        }
+
+        //!\brief Returns the two bit encoded k-mers of the pattern, skipping the k-mers with other symbols than `ACGT`.
+        template <std::ranges::input_range pattern_t>
+            requires std::convertible_to<std::ranges::range_reference_t<pattern_t>, char>
+        std::vector<uint64_t> kmers(pattern_t && pattern) const {
+            std::vector<uint64_t> codes{};
+            for_each_kmer(pattern, [&] (uint64_t const code) { codes.push_back(code); });
+            return codes;
+        }
+
+        //!\brief Returns whether the filter of the given chunk may contain the given encoded k-mer.
+        constexpr bool may_contain(std::size_t const chunk_idx, uint64_t const kmer) const noexcept {
+            std::span<uint64_t const> const chunk_words{_words.data() + chunk_idx * _words_per_chunk, _words_per_chunk};
+            bool contained = true;
+            for_each_bit(kmer, [&] (std::size_t const bit) {
+                contained &= static_cast<bool>((chunk_words[bit / word_bits] >> (bit % word_bits)) & 1);
+            });
+            return contained;
+        }
+
+        /*!\brief Returns whether the given chunk may contain at least `threshold` of the given encoded k-mers.
+         *
+         * \details
+         *
+         * Every occurrence of a k-mer in the list is counted, such that the threshold of a pattern with repeated k-mers
+         * can be taken from libjst::chunk_kmer_filter::threshold.
+         */
+        constexpr bool accepts(std::size_t const chunk_idx,
+                               std::span<uint64_t const> const kmers,
+                               std::size_t const threshold) const noexcept {
+            if (threshold == 0)
+                return true;
+
+            std::size_t contained{};
+            std::size_t remaining = kmers.size();
+            for (uint64_t const kmer : kmers) {
+                contained += may_contain(chunk_idx, kmer);
+                --remaining;
+                if (contained >= threshold)
+                    return true;
+                if (contained + remaining < threshold)
+                    return false;
+            }
+            return false;
+        }
+
+        /*!\brief Returns the predicate accepting the chunks that may contain a match of the pattern.
+         *
+         * \param[in] pattern The pattern of the search; its matches must not exceed the window size.
+         * \param[in] errors The number of errors of the search; defaults to 0, which requires all k-mers.
+         *
+         * \details
+         *
+         * The returned predicate holds the encoded k-mers of the pattern and refers to this filter, which must outlive
+         * it.
+         */
+        template <std::ranges::input_range pattern_t>
+            requires std::convertible_to<std::ranges::range_reference_t<pattern_t>, char>
+        auto predicate(pattern_t && pattern, std::size_t const errors = 0) const {
+            std::vector<uint64_t> codes = kmers((pattern_t &&)pattern);
+            std::size_t const min_count = threshold(codes.size(), errors);
+            return [this, codes = std::move(codes), min_count]
+                   (std::size_t const chunk_idx) -> bool {
+                return accepts(chunk_idx, codes, min_count);
+            };
+        }
+
+        template <typename archive_t>
+        void serialize(archive_t & archive)
+        {
+            archive(_kmer_size, _window_size, _words_per_chunk, _hash_count, _words);
+        }
+
+    private:
+
+        template <typename chunk_tree_t>
+        void insert_chunk(std::size_t const chunk_idx, chunk_tree_t && chunk) {
+            std::size_t const extension = _window_size - 1;
+            auto search_tree = chunk | libjst::labelled()
+                                     | libjst::coloured()
+                                     | trim(extension)
+                                     | prune_unsupported()
+                                     | left_extend(extension)
+                                     | merge();
+
+            std::span<uint64_t> const chunk_words{_words.data() + chunk_idx * _words_per_chunk, _words_per_chunk};
+            tree_traverser_base<decltype(search_tree)> path{search_tree};
+            for (auto it = path.begin(); it != path.end(); ++it) {
+                for_each_kmer((*it).sequence(), [&] (uint64_t const kmer) {
+                    for_each_bit(kmer, [&] (std::size_t const bit) {
+                        chunk_words[bit / word_bits] |= uint64_t{1} << (bit % word_bits);
+                    });
+                });
+            }
+        }
+
+        // Invokes the function with every k-mer of the sequence consisting of the nucleotides only.
+        template <typename sequence_t, typename fn_t>
+        void for_each_kmer(sequence_t && sequence, fn_t && fn) const {
+            uint64_t const mask = (_kmer_size == max_kmer_size) ? ~uint64_t{0} : (uint64_t{1} << (2 * _kmer_size)) - 1;
+            uint64_t code{};
+            std::size_t valid{};
+            for (auto it = std::ranges::begin(sequence); it != std::ranges::end(sequence); ++it) {
+                int8_t const rank = detail::kmer_rank_table[static_cast<unsigned char>(*it)];
+                code = ((code << 2) | static_cast<uint64_t>(rank & 3)) & mask;
+                valid = (rank < 0) ? 0 : valid + 1;
+                if (valid >= _kmer_size)
+                    fn(code);
+            }
+        }
+
+        // Invokes the function with the bits of the k-mer, which are derived by double hashing.
+        template <typename fn_t>
+        constexpr void for_each_bit(uint64_t const kmer, fn_t && fn) const noexcept {
+            uint64_t const hash = mix(kmer);
+            uint64_t const step = (hash >> 32) | 1;
+            std::size_t const bit_count = bits_per_chunk();
+            for (std::size_t i = 0; i < _hash_count; ++i)
+                fn(static_cast<std::size_t>((hash + i * step) % bit_count));
+        }
+
+        // The finaliser of splitmix64, which spreads the two bit encodings over all bits.
+        static constexpr uint64_t mix(uint64_t value) noexcept {
+            value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+            return value ^ (value >> 31);
+        }
+    };
+}  // namespace libjst
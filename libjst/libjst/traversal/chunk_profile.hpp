@@ -0,0 +1,234 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::chunk_profile, the measured cost of the chunks of a parallel traversal.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <ranges>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace libjst
+{
+    //!\brief The measured quantities of a libjst::chunk_cost.
+    enum struct chunk_metric {
+        wall_time, //!< The seconds the chunk was traversed.
+        node_count, //!< The searched labels.
+        symbol_count, //!< The symbols of the searched labels.
+        max_depth, //!< The most nodes held on the branch at once.
+        hit_count //!< The reported hits.
+    };
+
+    //!\brief The measured cost of a single chunk of a libjst::parallel_chunk_traverser.
+    struct chunk_cost {
+        std::size_t begin{}; //!< The first source position of the chunk, or its index if the forest has no source.
+        std::size_t end{}; //!< One past the last source position of the chunk, or the next index.
+        double wall_time{}; //!< The seconds the chunk was traversed.
+        std::size_t node_count{}; //!< The searched labels.
+        std::size_t symbol_count{}; //!< The symbols of the searched labels.
+        std::size_t max_depth{}; //!< The most nodes held on the branch at once.
+        std::size_t hit_count{}; //!< The reported hits.
+
+        //!\brief Returns the given metric as a number.
+        constexpr double value(chunk_metric const metric) const noexcept {
+            switch (metric) {
+                case chunk_metric::wall_time: return wall_time;
+                case chunk_metric::node_count: return static_cast<double>(node_count);
+                case chunk_metric::symbol_count: return static_cast<double>(symbol_count);
+                case chunk_metric::max_depth: return static_cast<double>(max_depth);
+                default: return static_cast<double>(hit_count);
+            }
+        }
+
+        friend constexpr bool operator==(chunk_cost const &, chunk_cost const &) noexcept = default;
+    };
+
+    /*!\brief A stack subscriber counting the nodes, the symbols and the depth of the traversal of one chunk.
+     *
+     * \details
+     *
+     * The recorder models libjst::observable_stack and counts the searched labels if it is passed to the
+     * libjst::state_oblivious_traverser. It is used by the libjst::parallel_chunk_traverser to fill the
+     * libjst::chunk_cost of every chunk while a profile is recorded.
+     */
+    class chunk_cost_recorder {
+    private:
+        chunk_cost * _cost{};
+        std::size_t _depth{};
+
+    public:
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        chunk_cost_recorder() = delete; //!< Deleted.
+
+        //!\brief Records into the given cost, which must outlive the recorder.
+        explicit chunk_cost_recorder(chunk_cost & cost) noexcept : _cost{std::addressof(cost)}
+        {}
+        //!\}
+
+        void notify_push() noexcept {
+            _cost->max_depth = std::max(_cost->max_depth, ++_depth);
+        }
+
+        void notify_pop() noexcept {
+            --_depth;
+        }
+
+        template <typename label_t>
+        void notify_label(label_t const & label) noexcept {
+            ++_cost->node_count;
+            _cost->symbol_count += std::ranges::size(label.sequence());
+        }
+    };
+
+    /*!\brief The measured costs of the chunks of a traversal, which are exported as BED or bedGraph track.
+     *
+     * \details
+     *
+     * A profile is recorded by the libjst::parallel_chunk_traverser, see libjst::parallel_chunk_traverser::set_profile,
+     * and holds the costs of its chunks in ascending order of their source intervals. Exported as bedGraph, a single
+     * metric is shown as a track in a genome browser, which reveals the regions of clustered variants that dominate the
+     * runtime of a search. The BED export holds all metrics and is read back with read_bed, such that the
+     * libjst::shard_planner balances the next run by the costs measured in a previous one.
+     */
+    class chunk_profile {
+    private:
+        std::vector<chunk_cost> _chunks{};
+
+    public:
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        chunk_profile() = default; //!< Default.
+
+        //!\brief Constructs a profile from the given costs in any order.
+        explicit chunk_profile(std::vector<chunk_cost> chunks) : _chunks{std::move(chunks)}
+        {
+            std::ranges::stable_sort(_chunks, std::ranges::less{}, &chunk_cost::begin);
+        }
+        //!\}
+
+        //!\brief Adds the cost of a chunk, keeping the costs in ascending order.
+        void record(chunk_cost cost) {
+            auto it = std::ranges::upper_bound(_chunks, cost.begin, std::ranges::less{}, &chunk_cost::begin);
+            _chunks.insert(it, std::move(cost));
+        }
+
+        //!\brief Discards all costs.
+        void clear() noexcept {
+            _chunks.clear();
+        }
+
+        //!\brief Returns the costs of the chunks in ascending order of their begin.
+        std::vector<chunk_cost> const & chunks() const noexcept {
+            return _chunks;
+        }
+
+        std::size_t size() const noexcept {
+            return _chunks.size();
+        }
+
+        bool empty() const noexcept {
+            return _chunks.empty();
+        }
+
+        //!\brief Returns the summed costs of all chunks; the maximal depth is the maximum over the chunks.
+        chunk_cost total() const noexcept {
+            chunk_cost total{};
+            if (!empty()) {
+                total.begin = _chunks.front().begin;
+                total.end = std::ranges::max(_chunks, std::ranges::less{}, &chunk_cost::end).end;
+            }
+            for (chunk_cost const & cost : _chunks) {
+                total.wall_time += cost.wall_time;
+                total.node_count += cost.node_count;
+                total.symbol_count += cost.symbol_count;
+                total.max_depth = std::max(total.max_depth, cost.max_depth);
+                total.hit_count += cost.hit_count;
+            }
+            return total;
+        }
+
+        /*!\brief Writes the costs as BED records with all metrics to the given stream.
+         *
+         * \details
+         *
+         * Every chunk is written as a line `chrom begin end wall_time node_count symbol_count max_depth hit_count`
+         * separated by tabs, i.e. as a BED3+5 record, preceded by a header comment naming the columns.
+         */
+        void write_bed(std::ostream & stream, std::string_view const chrom) const {
+            stream << "#chrom\tbegin\tend\twall_time\tnode_count\tsymbol_count\tmax_depth\thit_count\n";
+            for (chunk_cost const & cost : _chunks) {
+                stream << chrom << '\t' << cost.begin << '\t' << cost.end << '\t' << cost.wall_time << '\t'
+                       << cost.node_count << '\t' << cost.symbol_count << '\t' << cost.max_depth << '\t'
+                       << cost.hit_count << '\n';
+            }
+        }
+
+        //!\brief Writes the given metric of every chunk as a bedGraph track to the given stream.
+        void write_bedgraph(std::ostream & stream, std::string_view const chrom, chunk_metric const metric) const {
+            stream << "track type=bedGraph name=\"" << metric_name(metric) << "\"\n";
+            for (chunk_cost const & cost : _chunks)
+                stream << chrom << '\t' << cost.begin << '\t' << cost.end << '\t' << cost.value(metric) << '\n';
+        }
+
+        /*!\brief Reads a profile written by write_bed.
+         *
+         * \details
+         *
+         * Empty lines and lines beginning with `#`, `track` or `browser` are skipped. The name of the chromosome is
+         * ignored.
+         *
+         * ### Exception
+         *
+         * Throws std::runtime_error if a record does not hold all columns or its interval is empty.
+         */
+        static chunk_profile read_bed(std::istream & stream) {
+            std::vector<chunk_cost> chunks{};
+            std::string line{};
+            for (std::size_t line_number = 1; std::getline(stream, line); ++line_number) {
+                if (line.empty() || line.starts_with('#') || line.starts_with("track") || line.starts_with("browser"))
+                    continue;
+
+                std::istringstream record{line};
+                std::string chrom{};
+                chunk_cost cost{};
+                if (!(record >> chrom >> cost.begin >> cost.end >> cost.wall_time >> cost.node_count
+                             >> cost.symbol_count >> cost.max_depth >> cost.hit_count) || cost.end <= cost.begin)
+                    throw std::runtime_error{"Invalid chunk profile record in line " + std::to_string(line_number)};
+                chunks.push_back(std::move(cost));
+            }
+            return chunk_profile{std::move(chunks)};
+        }
+
+    private:
+
+        static constexpr std::string_view metric_name(chunk_metric const metric) noexcept {
+            switch (metric) {
+                case chunk_metric::wall_time: return "wall_time";
+                case chunk_metric::node_count: return "node_count";
+                case chunk_metric::symbol_count: return "symbol_count";
+                case chunk_metric::max_depth: return "max_depth";
+                default: return "hit_count";
+            }
+        }
+    };
+}  // namespace libjst
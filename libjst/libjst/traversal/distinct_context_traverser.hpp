@@ -0,0 +1,187 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides jst search evaluating identical contexts of the alternate nodes only once.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <ranges>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+#include <libjst/coverage/concept.hpp>
+#include <libjst/matcher/concept.hpp>
+#include <libjst/sequence_tree/coloured_tree.hpp>
+#include <libjst/sequence_tree/concept.hpp>
+#include <libjst/sequence_tree/labelled_tree.hpp>
+#include <libjst/sequence_tree/left_extend_tree.hpp>
+#include <libjst/sequence_tree/merge_tree.hpp>
+#include <libjst/sequence_tree/prune_unsupported.hpp>
+#include <libjst/sequence_tree/trim_tree.hpp>
+
+namespace libjst
+{
+    /*!\brief Searches the pattern like the libjst::state_oblivious_traverser but only once per distinct context.
+     *
+     * \details
+     *
+     * Every label is left extended and searched on its own, such that the hits of a label depend on its sequence
+     * only. Many alternate nodes, reached through different combinations of variants whose other variants fell
+     * outside of the window, spell the same sequence. The alternate nodes are therefore collected per region, i.e.
+     * the alternate subtrees branching off the reference path at the same position, and the nodes of a region
+     * spelling the same sequence are merged into a single context, which is identified by the hash of its sequence.
+     * The pattern is invoked once per distinct context, and the callback is invoked with a
+     * libjst::distinct_context_traverser::label of the first node of the context whose coverage is the union of the
+     * coverages of the merged nodes.
+     * The labels of the reference path are searched and reported as they are.
+     *
+     * Compared to the libjst::state_oblivious_traverser, a hit in a duplicated context is hence reported once with the
+     * union of the coverages instead of once per node. The coverage type must support libjst::coverage_union.
+     */
+    struct distinct_context_traverser {
+
+        template <typename base_label_t, typename coverage_t>
+        class label;
+
+        template <typename tree_t, typename pattern_t, typename callback_t>
+        constexpr void operator()(tree_t && tree, pattern_t && pattern, callback_t && callback) const {
+            if (libjst::window_size(pattern) == 0)
+                return;
+
+            auto const extension = detail::left_extension(pattern); // static if the window size is.
+            auto search_tree = tree | libjst::labelled()
+                                    | libjst::coloured()
+                                    | trim(static_cast<std::size_t>(extension))
+                                    | prune_unsupported()
+                                    | left_extend(extension)
+                                    | merge(); // make big nodes
+
+            using node_t = libjst::tree_node_t<decltype(search_tree)>;
+            using base_label_t = libjst::tree_label_t<decltype(search_tree)>;
+            using coverage_t = std::remove_cvref_t<decltype(std::declval<base_label_t const &>().coverage())>;
+
+            struct context {
+                std::size_t node{}; // the first node of the region spelling the context
+                coverage_t coverage{};
+            };
+
+            std::deque<node_t> region_nodes{}; // the labels refer to their nodes, which must hence not move
+            std::vector<context> contexts{};
+            std::unordered_multimap<uint64_t, std::size_t> context_index{};
+
+            auto flush_region = [&] () {
+                for (context & distinct : contexts) {
+                    label<base_label_t, coverage_t> const merged{*region_nodes[distinct.node],
+                                                                 std::move(distinct.coverage)};
+                    reset_state(pattern);
+                    pattern(merged.sequence(), [&] (auto && label_it) {
+                        callback(std::move(label_it), merged);
+                    });
+                }
+                region_nodes.clear();
+                contexts.clear();
+                context_index.clear();
+            };
+
+            auto add_to_region = [&] (node_t && node) {
+                region_nodes.push_back(std::move(node));
+                base_label_t const node_label = *region_nodes.back();
+                uint64_t const hash = hash_sequence(node_label.sequence());
+                auto [first, last] = context_index.equal_range(hash);
+                for (; first != last; ++first) {
+                    context & distinct = contexts[first->second];
+                    if (std::ranges::equal((*region_nodes[distinct.node]).sequence(), node_label.sequence())) {
+                        detail::assign_coverage_union(distinct.coverage, distinct.coverage, node_label.coverage());
+                        region_nodes.pop_back(); // only the first node of the context is searched
+                        return;
+                    }
+                }
+                context_index.emplace(hash, contexts.size());
+                contexts.push_back(context{region_nodes.size() - 1, coverage_t{node_label.coverage()}});
+            };
+
+            // The alternate child is visited before the reference child, hence a region is complete when the
+            // traversal returns to the reference path beyond the position it branched off. The variants at the
+            // same position are separated by empty reference nodes, which do not end the region.
+            using boundary_t = decltype(std::declval<node_t const &>().high_boundary());
+            using position_t = std::remove_cvref_t<decltype(libjst::position(std::declval<boundary_t>()))>;
+            std::optional<position_t> region_position{};
+            std::vector<node_t> branch{libjst::root(search_tree)};
+            while (!branch.empty()) {
+                node_t node = std::move(branch.back());
+                branch.pop_back();
+                if (auto ref_child = node.next_ref(); ref_child)
+                    branch.push_back(std::move(*ref_child));
+                if (auto alt_child = node.next_alt(); alt_child)
+                    branch.push_back(std::move(*alt_child));
+
+                if (node.on_alternate_path()) {
+                    add_to_region(std::move(node));
+                } else {
+                    if (position_t const position = libjst::position(node.high_boundary());
+                        region_position != position) {
+                        flush_region();
+                        region_position = position;
+                    }
+                    auto && node_label = *node;
+                    reset_state(pattern);
+                    pattern(node_label.sequence(), [&] (auto && label_it) {
+                        callback(std::move(label_it), node_label);
+                    });
+                }
+            }
+            flush_region();
+        }
+
+    private:
+
+        template <typename pattern_t>
+        static constexpr void reset_state(pattern_t & pattern) {
+            if constexpr (requires { pattern.reset(); })
+                pattern.reset();
+        }
+
+        // FNV-1a over the symbols of the sequence.
+        template <typename sequence_t>
+        static constexpr uint64_t hash_sequence(sequence_t && sequence) noexcept {
+            uint64_t hash = 0xcbf29ce484222325ULL;
+            for (auto && symbol : sequence) {
+                hash ^= static_cast<uint64_t>(static_cast<unsigned char>(symbol));
+                hash *= 0x100000001b3ULL;
+            }
+            return hash;
+        }
+    };
+
+    //!\brief The label of a distinct context, carrying the union of the coverages of the nodes spelling it.
+    template <typename base_label_t, typename coverage_t>
+    class distinct_context_traverser::label : public base_label_t {
+    private:
+        coverage_t _coverage{};
+
+    public:
+
+        label() = default;
+        constexpr label(base_label_t base_label, coverage_t coverage) :
+            base_label_t{std::move(base_label)},
+            _coverage{std::move(coverage)}
+        {}
+
+        //!\brief Returns the union of the coverages of the nodes spelling the context.
+        constexpr coverage_t const & coverage() const noexcept {
+            return _coverage;
+        }
+    };
+}  // namespace libjst
@@ -0,0 +1,431 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides a variant aware FM index over the labels of the sequence tree.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <libjst/sequence_tree/coloured_tree.hpp>
+#include <libjst/sequence_tree/concept.hpp>
+#include <libjst/sequence_tree/labelled_tree.hpp>
+#include <libjst/sequence_tree/left_extend_tree.hpp>
+#include <libjst/sequence_tree/merge_tree.hpp>
+#include <libjst/sequence_tree/prune_unsupported.hpp>
+#include <libjst/sequence_tree/seek_position.hpp>
+#include <libjst/sequence_tree/seekable_tree.hpp>
+#include <libjst/sequence_tree/trim_tree.hpp>
+#include <libjst/traversal/stack_publisher.hpp>
+#include <libjst/traversal/tree_traverser_base.hpp>
+#include <libjst/utility/memory_usage.hpp>
+
+namespace libjst
+{
+    namespace detail
+    {
+        // Maps the nucleotides to the ranks 2 to 5 and every other symbol to 6; 0 terminates the text and 1
+        // separates the labels.
+        inline constexpr std::array<uint8_t, 256> fm_rank_table = [] () {
+            std::array<uint8_t, 256> table{};
+            table.fill(6);
+            table['A'] = table['a'] = 2;
+            table['C'] = table['c'] = 3;
+            table['G'] = table['g'] = 4;
+            table['T'] = table['t'] = 5;
+            return table;
+        }();
+
+        // Applies the adaptors of the index to the tree, such that every query is spelled by at least one label.
+        template <typename tree_t>
+        constexpr auto fm_index_tree(tree_t && tree, std::size_t const max_query_size) {
+            std::size_t const extension = max_query_size - 1;
+            return tree | libjst::labelled()
+                        | libjst::coloured()
+                        | trim(extension)
+                        | prune_unsupported()
+                        | left_extend(extension)
+                        | merge()
+                        | libjst::seek();
+        }
+    } // namespace detail
+
+    /*!\brief An FM index over the labels of a sequence tree, which finds the queries in all haplotypes it represents.
+     *
+     * \tparam coverage_t The type of the coverage of the indexed labels.
+     *
+     * \details
+     *
+     * The index is built by libjst::build_fm_index, which traverses the tree once, like libjst::kmer_index, and
+     * concatenates the labels, separated by a symbol that no query contains. The labels are left extended by
+     * `max_query_size - 1` symbols, such that every query of at most this size is spelled by a label. The text is
+     * sorted by prefix doubling into the suffix array, of which only every `sample_rate`-th text position is kept
+     * to locate the occurrences in the Burrows-Wheeler transform. The occurrences of a query are found by backward
+     * search in time linear in its size and located by at most `sample_rate - 1` steps each.
+     *
+     * An occurrence ending within the left extension of a label is spelled by the label of the parent as well, and
+     * is therefore skipped; the left extension of every node is determined during the construction from the path
+     * positions of the labels. Hence, every occurrence is reported once, with the seek position and the coverage of
+     * its node, and can be verified by seeking the node in the indexed tree, see libjst::fm_index::locate. The
+     * queries must consist of the nucleotides `ACGT`, case insensitive; other symbols of the labels never match.
+     */
+    template <typename coverage_t>
+    class fm_index {
+    public:
+
+        //!\brief An occurrence of a query.
+        struct occurrence_type {
+            uint32_t node{}; //!< The index of the node spelling the query.
+            uint32_t offset{}; //!< The offset of the first symbol of the query within the label of the node.
+
+            constexpr friend bool operator==(occurrence_type const &, occurrence_type const &) noexcept = default;
+            constexpr friend auto operator<=>(occurrence_type const &, occurrence_type const &) noexcept = default;
+        };
+
+    private:
+
+        static constexpr std::size_t sigma = 7;
+        static constexpr std::size_t block_size = 64;
+        static constexpr uint8_t terminal_rank = 0;
+        static constexpr uint8_t separator_rank = 1;
+
+        //!\brief The ranks of the symbols of the Burrows-Wheeler transform before and within a block of 64 rows.
+        struct occurrence_block {
+            std::array<uint32_t, sigma> counts{}; //!< The occurrences of every symbol before the block.
+            std::array<uint64_t, sigma> masks{}; //!< The rows of every symbol within the block.
+        };
+
+        // Follows the branch to know the path position behind the label of the parent of the active node.
+        struct branch_end_tracker {
+            std::vector<std::size_t> ends{};
+            std::size_t end{};
+
+            void notify_push() {
+                ends.push_back(end);
+            }
+
+            void notify_pop() {
+                end = ends.back();
+                ends.pop_back();
+            }
+        };
+
+        std::size_t _max_query_size{};
+        std::size_t _sample_rate{};
+        std::array<std::size_t, sigma + 1> _cumulative{}; //!< The number of symbols of the text less than every rank.
+        std::vector<occurrence_block> _blocks{};
+        std::vector<uint64_t> _sampled_rows{}; //!< The rows whose text position is sampled.
+        std::vector<uint32_t> _sampled_ranks{}; //!< The sampled rows before every word of the sampled rows.
+        std::vector<uint32_t> _samples{}; //!< The text positions of the sampled rows.
+        std::vector<uint32_t> _label_begins{}; //!< The text position of the label of every node.
+        std::vector<uint32_t> _extensions{}; //!< The size of the left extension of the label of every node.
+        std::vector<seek_position> _positions{};
+        std::vector<coverage_t> _coverages{};
+
+    public:
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        fm_index() = default; //!< Default.
+
+        /*!\brief Constructs the index of the given tree, see libjst::build_fm_index.
+         *
+         * \param[in] tree The tree to index.
+         * \param[in] max_query_size The maximal size of the queries.
+         * \param[in] sample_rate The distance between two sampled text positions.
+         *
+         * \details
+         *
+         * Throws std::invalid_argument if one of the sizes is zero and std::length_error if the concatenated labels
+         * exceed 2^32 - 1 symbols.
+         *
+         * ### Complexity
+         *
+         * `O(n log n)` time in the size of the concatenated labels.
+         */
+        template <typename tree_t>
+        fm_index(tree_t && tree, std::size_t const max_query_size, std::size_t const sample_rate) :
+            _max_query_size{max_query_size},
+            _sample_rate{sample_rate}
+        {
+            if (max_query_size == 0 || sample_rate == 0)
+                throw std::invalid_argument{"The maximal query size and the sample rate of the index must not be "
+                                            "zero."};
+
+            std::vector<uint8_t> text{};
+            auto indexed_tree = search_tree((tree_t &&)tree);
+            branch_end_tracker branch{};
+            using publisher_t = static_stack_publisher<branch_end_tracker>;
+            tree_traverser_base<decltype(indexed_tree), std::allocator<std::byte>, publisher_t>
+                path{indexed_tree, publisher_t{branch}};
+            for (auto it = path.begin(); it != path.end(); ++it) {
+                auto && label = *it;
+                auto && sequence = label.sequence();
+                std::size_t const first = static_cast<std::size_t>(std::ranges::begin(sequence).position());
+                std::size_t const last = first + std::ranges::size(sequence);
+                // The symbols before the end of the parent label are its left extension, unless the label begins
+                // behind it, e.g. at the root of a partial tree.
+                _extensions.push_back(static_cast<uint32_t>((first < branch.end) ? std::min(branch.end, last) - first
+                                                                                  : 0));
+                branch.end = last;
+
+                _label_begins.push_back(static_cast<uint32_t>(text.size()));
+                _positions.push_back(label.position());
+                _coverages.emplace_back(label.coverage());
+                for (auto && symbol : sequence)
+                    text.push_back(detail::fm_rank_table[static_cast<unsigned char>(symbol)]);
+                text.push_back(separator_rank);
+                if (text.size() >= std::numeric_limits<uint32_t>::max())
+                    throw std::length_error{"The labels of the fm index exceed 2^32 - 1 symbols."};
+            }
+            text.push_back(terminal_rank);
+
+            build(text, suffix_array(text));
+        }
+        //!\}
+
+        constexpr std::size_t max_query_size() const noexcept {
+            return _max_query_size;
+        }
+
+        constexpr std::size_t sample_rate() const noexcept {
+            return _sample_rate;
+        }
+
+        //!\brief Returns the number of symbols of the indexed text, i.e. the concatenated labels and separators.
+        constexpr std::size_t size() const noexcept {
+            return _cumulative.back();
+        }
+
+        //!\brief Returns the number of indexed nodes.
+        constexpr std::size_t node_count() const noexcept {
+            return _positions.size();
+        }
+
+        /*!\brief Returns the occurrences of the query sorted by their node and offset.
+         *
+         * \details
+         *
+         * Returns no occurrences if the query is empty, longer than the maximal query size or contains a symbol other
+         * than a nucleotide.
+         */
+        template <std::ranges::bidirectional_range query_t>
+            requires std::convertible_to<std::ranges::range_reference_t<query_t>, char>
+        std::vector<occurrence_type> find(query_t && query) const {
+            std::size_t const query_size = static_cast<std::size_t>(std::ranges::distance(query));
+            if (query_size == 0 || query_size > _max_query_size)
+                return {};
+
+            std::size_t first_row = 0;
+            std::size_t last_row = size();
+            for (auto it = std::ranges::end(query); it != std::ranges::begin(query) && first_row < last_row;) {
+                uint8_t const rank = detail::fm_rank_table[static_cast<unsigned char>(*--it)];
+                if (rank > 5)
+                    return {};
+                first_row = _cumulative[rank] + occurrences(rank, first_row);
+                last_row = _cumulative[rank] + occurrences(rank, last_row);
+            }
+
+            std::vector<occurrence_type> result{};
+            for (std::size_t row = first_row; row < last_row; ++row) {
+                std::size_t const text_position = locate_row(row);
+                auto label_it = std::ranges::upper_bound(_label_begins, text_position);
+                uint32_t const node = static_cast<uint32_t>(std::ranges::distance(_label_begins.begin(), label_it) - 1);
+                uint32_t const offset = static_cast<uint32_t>(text_position - _label_begins[node]);
+                if (offset + query_size > _extensions[node]) // otherwise spelled by the parent as well
+                    result.push_back(occurrence_type{node, offset});
+            }
+            std::ranges::sort(result);
+            return result;
+        }
+
+        //!\brief Returns the seek position of the node of the occurrence within the indexed tree.
+        constexpr seek_position const & position(occurrence_type const & occurrence) const noexcept {
+            return _positions[occurrence.node];
+        }
+
+        //!\brief Returns the coverage of the node of the occurrence, i.e. the haplotypes that contain the occurrence.
+        constexpr coverage_t const & coverage(occurrence_type const & occurrence) const noexcept {
+            return _coverages[occurrence.node];
+        }
+
+        /*!\brief Adapts the tree the index was built from to the tree the seek positions refer to.
+         *
+         * \details
+         *
+         * The returned tree applies the same adaptors as the construction of the index and is seekable.
+         */
+        template <typename tree_t>
+        constexpr auto search_tree(tree_t && tree) const {
+            return detail::fm_index_tree((tree_t &&)tree, _max_query_size);
+        }
+
+        /*!\brief Seeks the node of the occurrence in the tree returned by libjst::fm_index::search_tree.
+         *
+         * \details
+         *
+         * The query begins at `occurrence.offset` within the label of the returned node.
+         */
+        template <typename search_tree_t>
+        constexpr auto locate(search_tree_t const & search_tree, occurrence_type const & occurrence) const {
+            return search_tree.seek(position(occurrence));
+        }
+
+        //!\brief Returns the number of bytes allocated for the index, excluding the coverages.
+        std::size_t memory_usage() const noexcept {
+            return libjst::memory_usage(_blocks) + libjst::memory_usage(_sampled_rows) +
+                   libjst::memory_usage(_sampled_ranks) + libjst::memory_usage(_samples) +
+                   libjst::memory_usage(_label_begins) + libjst::memory_usage(_extensions) +
+                   libjst::memory_usage(_positions);
+        }
+
+    private:
+
+        // Sorts the suffixes of the text by prefix doubling with radix sorted rank pairs.
+        static std::vector<uint32_t> suffix_array(std::vector<uint8_t> const & text) {
+            std::size_t const size = text.size();
+            std::vector<uint32_t> suffixes(size);
+            std::vector<uint32_t> ranks(text.begin(), text.end());
+            std::vector<uint32_t> buffer(size);
+            std::vector<uint32_t> counts(std::max(size, sigma) + 1);
+
+            auto sort_by_rank = [&] (std::vector<uint32_t> const & input, std::vector<uint32_t> & output) {
+                std::ranges::fill(counts, 0);
+                for (uint32_t const suffix : input)
+                    ++counts[ranks[suffix] + 1];
+                std::partial_sum(counts.begin(), counts.end(), counts.begin());
+                for (uint32_t const suffix : input)
+                    output[counts[ranks[suffix]]++] = suffix;
+            };
+
+            std::iota(buffer.begin(), buffer.end(), uint32_t{0});
+            sort_by_rank(buffer, suffixes);
+            for (std::size_t length = 1; ; length <<= 1) {
+                // Sorts by the rank of the second half first, where the suffixes without one come first.
+                std::size_t next{};
+                for (std::size_t suffix = size - std::min(length, size); suffix < size; ++suffix)
+                    buffer[next++] = static_cast<uint32_t>(suffix);
+                for (uint32_t const suffix : suffixes)
+                    if (suffix >= length)
+                        buffer[next++] = static_cast<uint32_t>(suffix - length);
+                sort_by_rank(buffer, suffixes);
+
+                auto second_rank = [&] (std::size_t const suffix) -> int64_t {
+                    return (suffix + length < size) ? ranks[suffix + length] : -1;
+                };
+                buffer[suffixes[0]] = 0;
+                for (std::size_t row = 1; row < size; ++row) {
+                    uint32_t const suffix = suffixes[row];
+                    uint32_t const previous = suffixes[row - 1];
+                    bool const differs = ranks[suffix] != ranks[previous] ||
+                                         second_rank(suffix) != second_rank(previous);
+                    buffer[suffix] = buffer[previous] + differs;
+                }
+                ranks.swap(buffer);
+                if (ranks[suffixes[size - 1]] + 1 == size) // all suffixes are distinct
+                    break;
+            }
+            return suffixes;
+        }
+
+        void build(std::vector<uint8_t> const & text, std::vector<uint32_t> const & suffixes) {
+            std::size_t const size = text.size();
+            for (uint8_t const rank : text)
+                ++_cumulative[rank + 1];
+            std::partial_sum(_cumulative.begin(), _cumulative.end(), _cumulative.begin());
+
+            std::size_t const block_count = size / block_size + 1;
+            _blocks.resize(block_count);
+            _sampled_rows.resize(block_count);
+            _sampled_ranks.resize(block_count);
+            std::array<uint32_t, sigma> counts{};
+            uint32_t sampled{};
+            for (std::size_t row = 0; row < size; ++row) {
+                std::size_t const block = row / block_size;
+                if (row % block_size == 0) {
+                    _blocks[block].counts = counts;
+                    _sampled_ranks[block] = sampled;
+                }
+
+                uint32_t const suffix = suffixes[row];
+                uint8_t const rank = text[(suffix == 0) ? size - 1 : suffix - 1];
+                _blocks[block].masks[rank] |= uint64_t{1} << (row % block_size);
+                ++counts[rank];
+                if (suffix % _sample_rate == 0) {
+                    _sampled_rows[block] |= uint64_t{1} << (row % block_size);
+                    _samples.push_back(suffix);
+                    ++sampled;
+                }
+            }
+            if (size % block_size == 0) { // the block behind the last row
+                _blocks.back().counts = counts;
+                _sampled_ranks.back() = sampled;
+            }
+        }
+
+        // Returns the number of the given rank in the Burrows-Wheeler transform before the row.
+        constexpr std::size_t occurrences(uint8_t const rank, std::size_t const row) const noexcept {
+            occurrence_block const & block = _blocks[row / block_size];
+            uint64_t const before = (uint64_t{1} << (row % block_size)) - 1;
+            return block.counts[rank] + std::popcount(block.masks[rank] & before);
+        }
+
+        // Returns the text position of the suffix of the row by walking back to the next sampled position.
+        std::size_t locate_row(std::size_t row) const noexcept {
+            std::size_t steps{};
+            while (!(_sampled_rows[row / block_size] >> (row % block_size) & 1)) {
+                occurrence_block const & block = _blocks[row / block_size];
+                uint8_t rank{};
+                while (!(block.masks[rank] >> (row % block_size) & 1))
+                    ++rank;
+                row = _cumulative[rank] + occurrences(rank, row);
+                ++steps;
+            }
+            uint64_t const before = (uint64_t{1} << (row % block_size)) - 1;
+            std::size_t const sample = _sampled_ranks[row / block_size] +
+                                       std::popcount(_sampled_rows[row / block_size] & before);
+            return _samples[sample] + steps;
+        }
+    };
+
+    /*!\brief Builds the libjst::fm_index of the given tree in a single traversal.
+     *
+     * \param[in] tree The tree to index.
+     * \param[in] max_query_size The maximal size of the queries.
+     * \param[in] sample_rate The distance between two sampled text positions; defaults to 16.
+     *
+     * \details
+     *
+     * The tree is labelled, coloured, trimmed and left extended by `max_query_size - 1` symbols, such that every
+     * query of at most this size is spelled by a label of the haplotypes containing it. The nodes not supported by
+     * any haplotype are pruned.
+     */
+    template <typename tree_t>
+    auto build_fm_index(tree_t && tree, std::size_t const max_query_size, std::size_t const sample_rate = 16) {
+        using search_tree_t = decltype(detail::fm_index_tree((tree_t &&)tree, max_query_size));
+        using label_t = libjst::tree_label_t<search_tree_t>;
+        using coverage_t = std::remove_cvref_t<decltype(std::declval<label_t const &>().coverage())>;
+        return fm_index<coverage_t>{(tree_t &&)tree, max_query_size, sample_rate};
+    }
+}  // namespace libjst
@@ -0,0 +1,168 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::frontier_traverser_base.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <memory>
+#include <ranges>
+#include <utility>
+#include <vector>
+
+#include <libjst/sequence_tree/concept.hpp>
+
+namespace libjst
+{
+    /*!\brief Traverses a sequence tree level by level and yields the labels of every level as one batch.
+     *
+     * \tparam tree_t The type of the traversed tree.
+     * \tparam allocator_t The allocator of the frontiers; defaults to `std::allocator<std::byte>`.
+     *
+     * \details
+     *
+     * In contrast to libjst::tree_traverser_base, which visits one node after the other in depth-first order, this
+     * traverser expands all nodes of the current level, i.e. the frontier, before it descends to the next level.
+     * Dereferencing the iterator returns a view over the labels of the frontier, such that a batched matcher, e.g. a
+     * SIMD or GPU back-end, can evaluate the pattern on all of them at once. The traverser works with the same tree
+     * adaptors as the depth-first traversal and visits the same nodes with the same labels, only in a different
+     * order. The nodes of a level are ordered by their parents and the alternate child precedes the reference child.
+     *
+     * Since no node has a parent on a stack, a matcher cannot carry its state from a node to its children. The mode
+     * is therefore meant for state oblivious matchers on trees whose labels are extended to the window of the pattern,
+     * e.g. `tree | trim(w - 1) | prune_unsupported() | left_extend(w - 1) | merge()`. The frontier holds as many nodes
+     * as the widest level of the tree, which for a trimmed tree is bounded by the number of variant paths within one
+     * window.
+     */
+    template <typename tree_t, typename allocator_t = std::allocator<std::byte>>
+    class frontier_traverser_base {
+    private:
+        using node_type = libjst::tree_node_t<tree_t>;
+        using node_allocator_type = typename std::allocator_traits<allocator_t>::template rebind_alloc<node_type>;
+        using frontier_type = std::vector<node_type, node_allocator_type>;
+
+        // Projects a node of the frontier onto its label.
+        struct label_fn {
+            constexpr libjst::node_label_t<node_type> operator()(node_type const & node) const {
+                return *node;
+            }
+        };
+
+        std::reference_wrapper<tree_t const> _tree;
+        frontier_type _frontier{};
+        frontier_type _next_frontier{};
+        std::size_t _level{};
+
+        class sentinel;
+        class iterator;
+
+    public:
+
+        //!\brief The view over the labels of one level.
+        using level_type = std::ranges::transform_view<std::ranges::ref_view<frontier_type const>, label_fn>;
+
+        explicit frontier_traverser_base(tree_t const & tree) noexcept : _tree{std::cref(tree)}
+        {}
+        explicit frontier_traverser_base(tree_t && tree) noexcept = delete;
+
+        constexpr iterator begin() {
+            return iterator{*this};
+        }
+
+        constexpr sentinel end() noexcept {
+            return sentinel{};
+        }
+
+        /*!\brief Allocates both frontiers for the given number of nodes.
+         *
+         * \details
+         *
+         * The frontiers still grow beyond the reserved width if needed.
+         */
+        void reserve(std::size_t const width) {
+            _frontier.reserve(width);
+            _next_frontier.reserve(width);
+        }
+
+        //!\brief Returns the depth of the current level, where the root is at level 0.
+        constexpr std::size_t level() const noexcept {
+            return _level;
+        }
+    };
+
+    template <typename tree_t, typename allocator_t>
+    class frontier_traverser_base<tree_t, allocator_t>::iterator {
+    private:
+
+        friend frontier_traverser_base;
+
+        frontier_traverser_base * _host{};
+
+        explicit iterator(frontier_traverser_base & host) : _host{std::addressof(host)}
+        {
+            frontier().clear();
+            frontier().push_back(libjst::root(_host->_tree.get()));
+            _host->_level = 0;
+        }
+
+    public:
+
+        using value_type = level_type;
+        using reference = level_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using iterator_category = std::input_iterator_tag;
+
+        iterator() = default;
+
+        constexpr reference operator*() const noexcept {
+            return level_type{std::ranges::ref_view{std::as_const(frontier())}, label_fn{}};
+        }
+
+        //!\brief Expands every node of the current level and makes its children the next level.
+        constexpr iterator & operator++() {
+            frontier_type & next_frontier = _host->_next_frontier;
+            next_frontier.clear();
+            for (node_type const & parent : frontier()) {
+                if (auto alt_child = parent.next_alt(); alt_child.has_value())
+                    next_frontier.push_back(std::move(*alt_child));
+                if (auto ref_child = parent.next_ref(); ref_child.has_value())
+                    next_frontier.push_back(std::move(*ref_child));
+            }
+            frontier().swap(next_frontier);
+            ++_host->_level;
+            return *this;
+        }
+
+        constexpr void operator++(int) {
+            ++(*this);
+        }
+
+    private:
+
+        constexpr friend bool operator==(iterator const & lhs, sentinel const &) noexcept {
+            return lhs.frontier().empty();
+        }
+
+        constexpr frontier_type & frontier() const noexcept {
+            assert(_host != nullptr);
+            return _host->_frontier;
+        }
+    };
+
+    template <typename tree_t, typename allocator_t>
+    class frontier_traverser_base<tree_t, allocator_t>::sentinel {
+    public:
+        constexpr sentinel() = default;
+    };
+
+}  // namespace libjst
@@ -0,0 +1,275 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides a hit sink collecting the hits of a traversal in columnar batches.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <ranges>
+#include <span>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <libjst/sequence_tree/seek_position.hpp>
+
+namespace libjst
+{
+    /*!\brief A callback of the traversers accumulating the hits in preallocated batches handed to a consumer.
+     *
+     * \tparam coverage_t The coverage type of the labels.
+     *
+     * \details
+     *
+     * Invoked as `buffer(label_it, label)`, the buffer appends the seek position of the label, the offset of the hit
+     * within the label and the index of the coverage of the label to the columns of the current
+     * libjst::hit_buffer::batch_type. The coverage is copied once per label, as consecutive hits of the same label
+     * share it. The labels must hence be those of a seekable tree, e.g. `tree | libjst::seek()`.
+     *
+     * Once the batch holds the capacity of hits, it is handed to the consumer. If the buffer is asynchronous, the
+     * consumer is invoked on a separate thread while the traversal fills a second batch, such that the traversal only
+     * waits if the consumer falls behind. An exception thrown by the consumer propagates from the call handing over the
+     * batch or, if the buffer is asynchronous, from the next call to libjst::hit_buffer::flush. The destructor
+     * flushes the remaining hits but ignores the errors of the consumer. The consumer may take the columns of the
+     * batch, e.g. by moving it into libjst::export_arrow_hits, and the buffer continues with the emptied batch.
+     * To report the carriers per population of every hit, the consumer counts the distinct coverages of the batch with
+     * libjst::hit_buffer::batch_type::count_groups and a libjst::coverage_groups.
+     */
+    template <typename coverage_t>
+    class hit_buffer {
+    public:
+
+        //!\brief The columns of a batch of hits.
+        struct batch_type {
+            std::vector<seek_position> positions{}; //!< The seek positions of the labels containing the hits.
+            std::vector<std::size_t> offsets{}; //!< The offsets of the last symbols of the hits within their labels.
+            std::vector<uint32_t> coverage_ids{}; //!< The indices of the coverages of the hits.
+            std::vector<coverage_t> coverages{}; //!< The distinct coverages of the labels of the batch.
+            std::vector<std::size_t> group_counts{}; //!< The members per group of every coverage, see count_groups.
+            std::size_t group_count{}; //!< The number of groups counted by count_groups.
+
+            constexpr std::size_t size() const noexcept {
+                return positions.size();
+            }
+
+            constexpr bool empty() const noexcept {
+                return positions.empty();
+            }
+
+            //!\brief Returns the coverage of the hit with the given index.
+            constexpr coverage_t const & coverage(std::size_t const hit) const noexcept {
+                return coverages[coverage_ids[hit]];
+            }
+
+            /*!\brief Counts the members of every group, e.g. the carriers per population, of the coverages of the batch.
+             *
+             * \param[in] groups The groups of the coverage domain, e.g. a libjst::coverage_groups.
+             *
+             * \details
+             *
+             * Every distinct coverage is counted once with `groups.count_into(coverage, counts)` instead of once per hit.
+             * The counts of a hit are returned by group_counts_of until the batch is cleared.
+             */
+            template <typename groups_t>
+            void count_groups(groups_t const & groups) {
+                group_count = groups.group_count();
+                group_counts.resize(coverages.size() * group_count);
+                for (std::size_t idx = 0; idx < coverages.size(); ++idx)
+                    groups.count_into(coverages[idx],
+                                      std::span<std::size_t>{group_counts}.subspan(idx * group_count, group_count));
+            }
+
+            //!\brief Returns the members per group of the coverage of the hit with the given index; see count_groups.
+            constexpr std::span<std::size_t const> group_counts_of(std::size_t const hit) const noexcept {
+                return std::span<std::size_t const>{group_counts}.subspan(coverage_ids[hit] * group_count,
+                                                                          group_count);
+            }
+
+            void reserve(std::size_t const capacity) {
+                positions.reserve(capacity);
+                offsets.reserve(capacity);
+                coverage_ids.reserve(capacity);
+                coverages.reserve(capacity);
+            }
+
+            void clear() noexcept {
+                positions.clear();
+                offsets.clear();
+                coverage_ids.clear();
+                coverages.clear();
+                group_counts.clear();
+            }
+
+            //!\brief Appends the hit ending at the given iterator into the label.
+            template <typename label_iterator_t, typename label_t>
+            void append(label_iterator_t && label_it, label_t && label) {
+                auto && sequence = label.sequence();
+                std::size_t const offset =
+                    static_cast<std::size_t>(std::ranges::distance(std::ranges::begin(sequence), label_it));
+                seek_position const & position = label.position();
+                if (empty() || !(positions.back() == position))
+                    coverages.emplace_back(label.coverage());
+
+                positions.push_back(position);
+                offsets.push_back(offset);
+                coverage_ids.push_back(static_cast<uint32_t>(coverages.size() - 1));
+            }
+        };
+
+        using consumer_type = std::function<void(batch_type &)>; //!< The consumer of the batches.
+
+    private:
+
+        std::size_t _capacity{};
+        consumer_type _consumer{};
+        batch_type _batch{};
+        batch_type _pending{};
+        bool _has_pending{};
+        bool _stopped{};
+        std::exception_ptr _error{};
+        std::mutex _mutex{};
+        std::condition_variable _condition{};
+        std::thread _worker{};
+
+    public:
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        hit_buffer() = delete; //!< Deleted.
+        hit_buffer(hit_buffer const &) = delete; //!< Deleted.
+        hit_buffer(hit_buffer &&) = delete; //!< Deleted.
+        hit_buffer & operator=(hit_buffer const &) = delete; //!< Deleted.
+        hit_buffer & operator=(hit_buffer &&) = delete; //!< Deleted.
+
+        /*!\brief Constructs the buffer with batches of the given capacity.
+         *
+         * \param[in] capacity The number of hits of a batch; a capacity of zero is treated as one.
+         * \param[in] consumer Invoked as `consumer(batch)` with every full batch and the remaining hits on flush.
+         * \param[in] asynchronous Whether the consumer is invoked on a separate thread.
+         */
+        hit_buffer(std::size_t const capacity, consumer_type consumer, bool const asynchronous = false) :
+            _capacity{std::max<std::size_t>(capacity, 1)},
+            _consumer{std::move(consumer)}
+        {
+            _batch.reserve(_capacity);
+            _pending.reserve(_capacity);
+            if (asynchronous)
+                _worker = std::thread{[this] () { consume_pending(); }};
+        }
+
+        //!\brief Flushes the remaining hits and stops the consumer thread.
+        ~hit_buffer() {
+            try {
+                flush();
+            } catch (...) {
+            }
+            stop();
+        }
+        //!\}
+
+        constexpr std::size_t capacity() const noexcept {
+            return _capacity;
+        }
+
+        //!\brief Appends the hit ending at the given iterator into the label.
+        template <typename label_iterator_t, typename label_t>
+        void operator()(label_iterator_t && label_it, label_t && label) {
+            _batch.append((label_iterator_t &&) label_it, (label_t &&) label);
+            if (_batch.size() == _capacity)
+                hand_over();
+        }
+
+        /*!\brief Hands the remaining hits to the consumer and waits until all batches are consumed.
+         *
+         * \details
+         *
+         * Rethrows the first exception thrown by the asynchronous consumer since the last flush.
+         */
+        void flush() {
+            if (!_batch.empty())
+                hand_over();
+
+            std::exception_ptr error{};
+            if (_worker.joinable()) {
+                std::unique_lock lock{_mutex};
+                _condition.wait(lock, [&] () { return !_has_pending; });
+                error = std::exchange(_error, nullptr);
+            }
+            if (error)
+                std::rethrow_exception(error);
+        }
+
+    private:
+
+        void hand_over() {
+            if (!_worker.joinable()) {
+                try {
+                    _consumer(_batch);
+                } catch (...) {
+                    _batch.clear();
+                    throw;
+                }
+                _batch.clear();
+                return;
+            }
+
+            { // swap the full batch with the consumed one, which keeps its allocated columns
+                std::unique_lock lock{_mutex};
+                _condition.wait(lock, [&] () { return !_has_pending; });
+                std::swap(_batch, _pending);
+                _has_pending = true;
+            }
+            _condition.notify_all();
+        }
+
+        void consume_pending() {
+            std::unique_lock lock{_mutex};
+            while (true) {
+                _condition.wait(lock, [&] () { return _has_pending || _stopped; });
+                if (!_has_pending)
+                    return;
+
+                lock.unlock();
+                std::exception_ptr error{};
+                try {
+                    _consumer(_pending);
+                } catch (...) {
+                    error = std::current_exception();
+                }
+                _pending.clear();
+                lock.lock();
+                if (error && !_error)
+                    _error = std::move(error);
+                _has_pending = false;
+                _condition.notify_all();
+            }
+        }
+
+        void stop() {
+            if (!_worker.joinable())
+                return;
+
+            {
+                std::scoped_lock lock{_mutex};
+                _stopped = true;
+            }
+            _condition.notify_all();
+            _worker.join();
+        }
+    };
+}  // namespace libjst
@@ -0,0 +1,252 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::hit_queue delivering the hit batches of many workers to a single consumer.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+
+#include <libjst/traversal/hit_buffer.hpp>
+#include <libjst/utility/mpsc_queue.hpp>
+
+namespace libjst
+{
+    /*!\brief Delivers the hits of concurrent traversals in batches to a single consumer thread.
+     *
+     * \tparam coverage_t The coverage type of the labels.
+     *
+     * \details
+     *
+     * Every worker reports its hits to its own libjst::hit_queue::producer_type, which accumulates them in a
+     * libjst::hit_buffer::batch_type like the libjst::hit_buffer. A full batch is published to a bounded
+     * libjst::mpsc_queue, from which the consumer thread of the queue pops the batches and invokes the consumer. The
+     * workers hence never lock a mutex to report a hit, and contend only once per batch on the enqueue position of
+     * the queue. If the consumer falls behind and the queue is full, the publishing worker waits for a free slot,
+     * which bounds the memory of the pending hits to the depth of the queue times the batch capacity. The batches
+     * are recycled between the workers and the consumer, such that the columns are not allocated anew.
+     *
+     * The producers are copyable callbacks, e.g. for the per thread delivery of the libjst::parallel_chunk_traverser,
+     * which copies the callback once per worker. A producer publishes its remaining hits on flush and when it is
+     * destroyed, which must happen before the queue is closed. The batches of different producers are consumed in
+     * the order they were published. An exception thrown by the consumer is rethrown by close, while the remaining
+     * batches are dropped such that the producers are not blocked. The consumer may take the columns of the batch,
+     * e.g. by moving it into libjst::export_arrow_hits, which leaves an empty batch to be recycled.
+     */
+    template <typename coverage_t>
+    class hit_queue {
+    public:
+
+        using batch_type = typename hit_buffer<coverage_t>::batch_type; //!< The batches of hits.
+        using consumer_type = std::function<void(batch_type &)>; //!< The consumer of the batches.
+
+        class producer_type;
+
+    private:
+
+        std::size_t _batch_capacity{};
+        consumer_type _consumer{};
+        mpsc_queue<batch_type> _queue;
+        std::atomic<bool> _closed{false};
+        std::size_t _batch_count{};
+        std::exception_ptr _error{};
+        std::thread _worker{};
+
+    public:
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        hit_queue() = delete; //!< Deleted.
+        hit_queue(hit_queue const &) = delete; //!< Deleted.
+        hit_queue(hit_queue &&) = delete; //!< Deleted.
+        hit_queue & operator=(hit_queue const &) = delete; //!< Deleted.
+        hit_queue & operator=(hit_queue &&) = delete; //!< Deleted.
+
+        /*!\brief Starts the consumer thread.
+         *
+         * \param[in] batch_capacity The number of hits of a batch; a capacity of zero is treated as one.
+         * \param[in] queue_depth The number of published batches that can wait for the consumer; at least 2.
+         * \param[in] consumer Invoked as `consumer(batch)` on the consumer thread with every published batch.
+         */
+        hit_queue(std::size_t const batch_capacity, std::size_t const queue_depth, consumer_type consumer) :
+            _batch_capacity{std::max<std::size_t>(batch_capacity, 1)},
+            _consumer{std::move(consumer)},
+            _queue{queue_depth}
+        {
+            _worker = std::thread{[this] () { consume(); }};
+        }
+
+        //!\brief Consumes the published batches and stops the consumer thread, ignoring the errors of the consumer.
+        ~hit_queue() {
+            try {
+                close();
+            } catch (...) {
+            }
+        }
+        //!\}
+
+        //!\brief Returns a new producer publishing to this queue.
+        producer_type producer() {
+            return producer_type{*this};
+        }
+
+        constexpr std::size_t batch_capacity() const noexcept {
+            return _batch_capacity;
+        }
+
+        //!\brief Returns the number of batches that can wait for the consumer.
+        constexpr std::size_t queue_depth() const noexcept {
+            return _queue.capacity();
+        }
+
+        //!\brief Returns how often a producer waited for the consumer because the queue was full.
+        std::size_t wait_count() const noexcept {
+            return _queue.wait_count();
+        }
+
+        /*!\brief Waits until all published batches are consumed and stops the consumer thread.
+         *
+         * \details
+         *
+         * All producers must have been flushed or destroyed before. Returns the number of consumed batches and
+         * rethrows the first exception thrown by the consumer. Calling close again has no effect.
+         */
+        std::size_t close() {
+            if (_worker.joinable()) {
+                _closed.store(true, std::memory_order_release);
+                _queue.notify();
+                _worker.join();
+            }
+            if (_error)
+                std::rethrow_exception(std::exchange(_error, nullptr));
+            return _batch_count;
+        }
+
+    private:
+
+        void publish(batch_type & batch) {
+            if (_closed.load(std::memory_order_acquire))
+                throw std::logic_error{"Cannot publish hits to a closed hit queue."};
+
+            _queue.push(batch); // swaps in a consumed batch
+            batch.clear();
+            batch.reserve(_batch_capacity);
+        }
+
+        void consume() {
+            batch_type batch{};
+            while (true) {
+                uint64_t const epoch = _queue.epoch();
+                if (_queue.try_pop(batch)) {
+                    if (!_error) {
+                        try {
+                            _consumer(batch);
+                            ++_batch_count;
+                        } catch (...) {
+                            _error = std::current_exception();
+                        }
+                    }
+                    batch.clear(); // keeps the columns for the next producer of the slot
+                } else if (_closed.load(std::memory_order_acquire)) {
+                    if (_queue.epoch() == epoch) // nothing was published since the last pop
+                        return;
+                } else {
+                    _queue.wait(epoch);
+                }
+            }
+        }
+    };
+
+    /*!\brief The callback of a worker accumulating its hits and publishing them to the libjst::hit_queue.
+     *
+     * \details
+     *
+     * A copy of a producer refers to the same queue but starts with an empty batch.
+     */
+    template <typename coverage_t>
+    class hit_queue<coverage_t>::producer_type {
+    private:
+
+        friend hit_queue;
+
+        hit_queue * _queue{};
+        batch_type _batch{};
+
+        explicit producer_type(hit_queue & queue) : _queue{std::addressof(queue)}
+        {
+            _batch.reserve(_queue->_batch_capacity);
+        }
+
+    public:
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        producer_type() = default; //!< Default.
+
+        //!\brief Refers to the queue of the other producer with an empty batch.
+        producer_type(producer_type const & other) : _queue{other._queue}
+        {
+            if (_queue != nullptr)
+                _batch.reserve(_queue->_batch_capacity);
+        }
+
+        producer_type(producer_type && other) noexcept :
+            _queue{std::exchange(other._queue, nullptr)},
+            _batch{std::move(other._batch)}
+        {}
+
+        producer_type & operator=(producer_type other) noexcept {
+            if (_queue != nullptr) {
+                try {
+                    flush();
+                } catch (...) {
+                }
+            }
+            _queue = std::exchange(other._queue, nullptr);
+            _batch = std::move(other._batch);
+            return *this;
+        }
+
+        //!\brief Publishes the remaining hits, ignoring an already closed queue.
+        ~producer_type() {
+            try {
+                flush();
+            } catch (...) {
+            }
+        }
+        //!\}
+
+        //!\brief Appends the hit ending at the given iterator into the label.
+        template <typename label_iterator_t, typename label_t>
+        void operator()(label_iterator_t && label_it, label_t && label) {
+            assert(_queue != nullptr);
+            _batch.append((label_iterator_t &&) label_it, (label_t &&) label);
+            if (_batch.size() == _queue->_batch_capacity)
+                _queue->publish(_batch);
+        }
+
+        //!\brief Publishes the remaining hits; throws std::logic_error if the queue is already closed.
+        void flush() {
+            if (_queue != nullptr && !_batch.empty())
+                _queue->publish(_batch);
+        }
+    };
+}  // namespace libjst
@@ -0,0 +1,176 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides a search that re-searches only the chunks changed by an update of the store.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <ranges>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <libjst/matcher/concept.hpp>
+#include <libjst/rcms/source_mask.hpp>
+#include <libjst/traversal/parallel_chunk_traverser.hpp>
+
+namespace libjst
+{
+    /*!\brief Returns whether the chunks of the forest may hold other hits after the given regions were modified.
+     *
+     * \param[in] forest The chunked tree, e.g. libjst::chunked_tree_impl.
+     * \param[in] dirty_regions The modified source intervals, see libjst::rcs_store::dirty_regions.
+     * \param[in] window_size The window size of the pattern, i.e. the longest match.
+     *
+     * \details
+     *
+     * A chunk owns the hits ending within it, whose windows begin at most `window_size - 1` positions before the
+     * chunk. A chunk is hence dirty if a dirty region overlaps the chunk extended to the left by this many positions.
+     */
+    template <typename forest_t>
+        requires requires (forest_t const & forest) { { forest.chunk_size() } -> std::integral; }
+    std::vector<bool> dirty_chunks(forest_t const & forest,
+                                   source_mask const & dirty_regions,
+                                   std::size_t const window_size)
+    {
+        std::size_t const chunk_count = std::ranges::size(forest);
+        std::size_t const chunk_size = forest.chunk_size();
+        std::size_t const lookbehind = std::max<std::size_t>(window_size, 1) - 1;
+
+        std::vector<bool> is_dirty(chunk_count, false);
+        for (source_interval const & region : dirty_regions) {
+            std::size_t const first_chunk = region.begin / chunk_size;
+            std::size_t const last_chunk = std::min((region.end - 1 + lookbehind) / chunk_size + 1, chunk_count);
+            for (std::size_t chunk_idx = first_chunk; chunk_idx < last_chunk; ++chunk_idx)
+                is_dirty[chunk_idx] = true;
+        }
+        return is_dirty;
+    }
+
+    /*!\brief Keeps the hits of a pattern per chunk and re-searches only the chunks changed by an update of the store.
+     *
+     * \tparam hit_t The type of the projected hits, which must remain valid after the traversal of their chunk.
+     *
+     * \details
+     *
+     * The first search traverses all chunks and keeps the projected hits per chunk. After the store was modified,
+     * e.g. by adding variants or appending the rows of new samples, update re-searches only the chunks overlapping
+     * the dirty regions of the store plus the window of the pattern, see libjst::dirty_chunks, and replaces their hits,
+     * while the hits of all other chunks are kept. The chunks are searched by a libjst::parallel_chunk_traverser
+     * restricted to the dirty chunks, see libjst::parallel_chunk_traverser::set_chunk_filter.
+     *
+     * A hit kept from a clean chunk is not projected again: if the projection keeps its coverage, the coverage lacks
+     * the rows appended since, which carry no variant within this chunk. The forest must be built over the same source
+     * with the same chunk size for every search.
+     */
+    template <typename hit_t>
+    class incremental_search {
+    private:
+
+        std::vector<std::vector<hit_t>> _chunk_hits{};
+
+    public:
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        incremental_search() = default; //!< Default.
+        //!\}
+
+        /*!\brief Searches all chunks of the forest and replaces all kept hits.
+         *
+         * \param[in] traverser The traverser searching the chunks; copied to restrict it to the searched chunks.
+         * \param[in] forest The chunked tree to search.
+         * \param[in] pattern The pattern to search.
+         * \param[in] projection Invoked with `(label_it, label)` to produce the kept hit, see
+         *                       libjst::parallel_chunk_traverser::ordered.
+         */
+        template <typename traverser_t, typename forest_t, typename pattern_t, typename projection_t>
+        void search(parallel_chunk_traverser<traverser_t> const & traverser,
+                    forest_t const & forest,
+                    pattern_t const & pattern,
+                    projection_t && projection)
+        {
+            _chunk_hits.assign(std::ranges::size(forest), std::vector<hit_t>{});
+            search_chunks(traverser, forest, pattern, (projection_t &&) projection, {});
+        }
+
+        /*!\brief Re-searches the chunks overlapping the dirty regions and replaces their hits.
+         *
+         * \param[in] traverser The traverser searching the chunks; copied to restrict it to the dirty chunks.
+         * \param[in] forest The chunked tree over the modified store.
+         * \param[in] dirty_regions The modified regions since the last search, see libjst::rcs_store::dirty_regions.
+         * \param[in] pattern The pattern to search, which must be the pattern of the previous searches.
+         * \param[in] projection Invoked with `(label_it, label)` to produce the kept hit.
+         *
+         * \returns The number of re-searched chunks.
+         */
+        template <typename traverser_t, typename forest_t, typename pattern_t, typename projection_t>
+        std::size_t update(parallel_chunk_traverser<traverser_t> const & traverser,
+                           forest_t const & forest,
+                           source_mask const & dirty_regions,
+                           pattern_t const & pattern,
+                           projection_t && projection)
+        {
+            std::vector<bool> is_dirty = dirty_chunks(forest, dirty_regions, libjst::window_size(pattern));
+            _chunk_hits.resize(is_dirty.size());
+            for (std::size_t chunk_idx = 0; chunk_idx < is_dirty.size(); ++chunk_idx)
+                if (is_dirty[chunk_idx])
+                    _chunk_hits[chunk_idx].clear();
+
+            std::size_t const dirty_count = std::ranges::count(is_dirty, true);
+            search_chunks(traverser, forest, pattern, (projection_t &&) projection,
+                          [&is_dirty] (std::size_t const chunk_idx) { return static_cast<bool>(is_dirty[chunk_idx]); });
+            return dirty_count;
+        }
+
+        //!\brief Returns the number of chunks.
+        constexpr std::size_t chunk_count() const noexcept {
+            return _chunk_hits.size();
+        }
+
+        //!\brief Returns the kept hits of the given chunk in the order of its traversal.
+        constexpr std::span<hit_t const> hits(std::size_t const chunk_idx) const noexcept {
+            return _chunk_hits[chunk_idx];
+        }
+
+        //!\brief Returns all kept hits in chunk order.
+        constexpr auto hits() const noexcept {
+            return _chunk_hits | std::views::join;
+        }
+
+    private:
+
+        template <typename traverser_t, typename forest_t, typename pattern_t, typename projection_t>
+        void search_chunks(parallel_chunk_traverser<traverser_t> const & traverser,
+                           forest_t const & forest,
+                           pattern_t const & pattern,
+                           projection_t && projection,
+                           std::function<bool(std::size_t)> accepts_chunk)
+        {
+            // Tasks of chunks split at runtime begin at a source position within their chunk.
+            std::size_t const positions_per_chunk = (traverser.min_split_size() > 0) ? forest.chunk_size() : 1;
+
+            parallel_chunk_traverser<traverser_t> chunk_traverser{traverser};
+            chunk_traverser.set_chunk_filter(std::move(accepts_chunk));
+            chunk_traverser.template ordered<std::pair<std::size_t, hit_t>>(forest, pattern,
+                [&] (std::size_t const task_begin, auto && label_it, auto && label) {
+                    return std::pair<std::size_t, hit_t>{task_begin / positions_per_chunk,
+                                                         std::invoke(projection, label_it, label)};
+                },
+                [&] (std::pair<std::size_t, hit_t> hit) {
+                    _chunk_hits[hit.first].push_back(std::move(hit.second));
+                });
+        }
+    };
+}  // namespace libjst
@@ -0,0 +1,589 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides a variant aware k-mer and minimizer index over the sequence tree.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <libjst/rcms/interior_breakends.hpp>
+#include <libjst/rcms/source_mask.hpp>
+#include <libjst/sequence_tree/coloured_tree.hpp>
+#include <libjst/sequence_tree/concept.hpp>
+#include <libjst/sequence_tree/labelled_tree.hpp>
+#include <libjst/sequence_tree/left_extend_tree.hpp>
+#include <libjst/sequence_tree/merge_tree.hpp>
+#include <libjst/sequence_tree/prune_unsupported.hpp>
+#include <libjst/sequence_tree/seek_position.hpp>
+#include <libjst/sequence_tree/seekable_tree.hpp>
+#include <libjst/sequence_tree/trim_tree.hpp>
+#include <libjst/traversal/incremental_search.hpp>
+#include <libjst/traversal/tree_traverser_base.hpp>
+#include <libjst/utility/parallel_for_each_job.hpp>
+
+namespace libjst
+{
+    namespace detail
+    {
+        // Maps the nucleotides to their two bit rank and every other symbol to -1.
+        inline constexpr std::array<int8_t, 256> kmer_rank_table = [] () {
+            std::array<int8_t, 256> table{};
+            table.fill(-1);
+            table['A'] = table['a'] = 0;
+            table['C'] = table['c'] = 1;
+            table['G'] = table['g'] = 2;
+            table['T'] = table['t'] = 3;
+            return table;
+        }();
+
+        // Applies the adaptors of the index to the tree, such that every window is spelled by exactly one label.
+        template <typename tree_t>
+        constexpr auto kmer_index_tree(tree_t && tree, std::size_t const kmer_size, std::size_t const window_size) {
+            std::size_t const extension = kmer_size + window_size - 2;
+            return tree | libjst::labelled()
+                        | libjst::coloured()
+                        | trim(extension)
+                        | prune_unsupported()
+                        | left_extend(extension)
+                        | merge()
+                        | libjst::seek();
+        }
+    } // namespace detail
+
+    /*!\brief A sorted table of the k-mers or minimizers of all haplotypes represented by a sequence tree.
+     *
+     * \tparam coverage_t The type of the coverage of the indexed labels.
+     *
+     * \details
+     *
+     * The index is built by libjst::build_kmer_index, which traverses the tree once. Every entry stores the two bit
+     * encoded k-mer together with the node of the indexed tree and the offset of the k-mer within the label of this
+     * node; the seek position and the coverage are stored once per node. The entries are sorted by the k-mer, such that
+     * libjst::kmer_index::find returns all occurrences of a k-mer by a binary search. A candidate is verified by
+     * seeking its node in the indexed tree, see libjst::kmer_index::search_tree and libjst::kmer_index::locate,
+     * instead of traversing the whole tree.
+     *
+     * With a window size of one, every k-mer is indexed. Otherwise, only the minimizers are indexed, i.e. the k-mer
+     * with the smallest hash value within every window of `window_size` consecutive k-mers; the hash value is the
+     * k-mer xor-ed with a random seed to avoid indexing poly-A stretches. The k-mers must consist of the nucleotides
+     * `ACGT`, case insensitive; windows containing other symbols are skipped.
+     *
+     * An index built from a chunked tree, see libjst::build_kmer_index, indexes every owned chunk on its own, such
+     * that the chunks are indexed in parallel and libjst::kmer_index::update re-indexes only the chunks changed by an
+     * update of the store. The seek positions of its entries refer to the search tree of the owned chunk returned by
+     * libjst::kmer_index::chunk.
+     */
+    template <typename coverage_t>
+    class kmer_index {
+    public:
+
+        //!\brief An occurrence of an indexed k-mer.
+        struct entry_type {
+            uint64_t kmer{}; //!< The two bit encoded k-mer, with the first symbol in the most significant bits.
+            uint32_t node{}; //!< The index of the node spelling the k-mer.
+            uint32_t offset{}; //!< The offset of the first symbol of the k-mer within the label of the node.
+
+            constexpr friend bool operator==(entry_type const &, entry_type const &) noexcept = default;
+            constexpr friend auto operator<=>(entry_type const &, entry_type const &) noexcept = default;
+        };
+
+        static constexpr std::size_t max_kmer_size = 32; //!< The maximal size of the encoded k-mers.
+
+    private:
+
+        static constexpr uint64_t minimizer_seed = 0x8F3F73B5CF1C9ADEULL;
+
+        // The nodes and the entries of one chunk, whose node indices start at zero.
+        struct chunk_buffer {
+            std::vector<entry_type> entries{};
+            std::vector<seek_position> positions{};
+            std::vector<coverage_t> coverages{};
+        };
+
+        std::size_t _kmer_size{};
+        std::size_t _window_size{1};
+        std::size_t _chunk_count{};
+        std::vector<entry_type> _entries{};
+        std::vector<seek_position> _positions{};
+        std::vector<coverage_t> _coverages{};
+        std::vector<uint32_t> _chunks{}; // the chunk of every node if built from a chunked tree
+        std::vector<uint64_t> _chunk_roots{}; // the variant index of the root of every chunk
+
+    public:
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        kmer_index() = default; //!< Default.
+
+        /*!\brief Constructs an empty index for the given k-mer and window size.
+         *
+         * \param[in] kmer_size The size of the indexed k-mers.
+         * \param[in] window_size The number of consecutive k-mers of which the minimizer is indexed.
+         *
+         * \details
+         *
+         * Throws std::invalid_argument if one of the sizes is zero and std::length_error if the k-mer size exceeds
+         * libjst::kmer_index::max_kmer_size.
+         */
+        kmer_index(std::size_t const kmer_size, std::size_t const window_size) :
+            _kmer_size{kmer_size},
+            _window_size{window_size}
+        {
+            if (kmer_size == 0 || window_size == 0)
+                throw std::invalid_argument{"The k-mer size and the window size of the index must not be zero."};
+            if (kmer_size > max_kmer_size)
+                throw std::length_error{"The k-mer index supports k-mers of at most 32 symbols."};
+        }
+
+        /*!\brief Constructs the index of the given tree, see libjst::build_kmer_index.
+         *
+         * \param[in] tree The tree to index.
+         * \param[in] kmer_size The size of the indexed k-mers.
+         * \param[in] window_size The number of consecutive k-mers of which the minimizer is indexed.
+         */
+        template <typename tree_t>
+        kmer_index(tree_t && tree, std::size_t const kmer_size, std::size_t const window_size) :
+            kmer_index{kmer_size, window_size}
+        {
+            auto indexed_tree = search_tree((tree_t &&)tree);
+            tree_traverser_base<decltype(indexed_tree)> path{indexed_tree};
+            for (auto it = path.begin(); it != path.end(); ++it) {
+                auto && label = *it;
+                uint32_t const node = static_cast<uint32_t>(_positions.size());
+                _positions.push_back(label.position());
+                _coverages.emplace_back(label.coverage());
+                index_label(label.sequence(), node, _entries);
+            }
+            std::ranges::sort(_entries);
+        }
+
+        /*!\brief Constructs the index of the owned chunks of the forest in parallel, see libjst::build_kmer_index.
+         *
+         * \param[in] forest The chunked tree to index, e.g. libjst::chunked_tree_impl.
+         * \param[in] kmer_size The size of the indexed k-mers.
+         * \param[in] window_size The number of consecutive k-mers of which the minimizer is indexed.
+         * \param[in] thread_count The number of threads indexing the chunks.
+         */
+        template <typename forest_t>
+            requires requires (forest_t const & forest) { forest.owned_chunk(0); }
+        kmer_index(forest_t const & forest,
+                   std::size_t const kmer_size,
+                   std::size_t const window_size,
+                   std::size_t const thread_count) :
+            kmer_index{kmer_size, window_size}
+        {
+            _chunk_count = std::ranges::size(forest);
+            _chunk_roots.resize(_chunk_count);
+            std::vector<std::size_t> chunk_indices(_chunk_count);
+            std::iota(chunk_indices.begin(), chunk_indices.end(), 0);
+            append_chunks(forest, chunk_indices, thread_count);
+        }
+        //!\}
+
+        constexpr std::size_t kmer_size() const noexcept {
+            return _kmer_size;
+        }
+
+        constexpr std::size_t window_size() const noexcept {
+            return _window_size;
+        }
+
+        //!\brief Returns the number of indexed chunks, or zero if the index was not built from a chunked tree.
+        constexpr std::size_t chunk_count() const noexcept {
+            return _chunk_count;
+        }
+
+        //!\brief Returns the number of indexed occurrences.
+        constexpr std::size_t size() const noexcept {
+            return _entries.size();
+        }
+
+        //!\brief Returns all entries sorted by the k-mer.
+        std::span<entry_type const> entries() const noexcept {
+            return _entries;
+        }
+
+        //!\brief Returns the entries of the given encoded k-mer.
+        std::span<entry_type const> find(uint64_t const kmer) const noexcept {
+            auto [first, last] = std::ranges::equal_range(_entries, kmer, std::ranges::less{}, &entry_type::kmer);
+            return std::span<entry_type const>{first, last};
+        }
+
+        //!\brief Returns the entries of the given k-mer, or none if it is not a valid k-mer of the index.
+        template <std::ranges::input_range kmer_t>
+            requires std::convertible_to<std::ranges::range_reference_t<kmer_t>, char>
+        std::span<entry_type const> find(kmer_t && kmer) const noexcept {
+            if (std::optional<uint64_t> code = encode(kmer); code)
+                return find(*code);
+            return {};
+        }
+
+        //!\brief Returns the two bit encoding of the k-mer, or std::nullopt if it has another size or symbols.
+        template <std::ranges::input_range kmer_t>
+            requires std::convertible_to<std::ranges::range_reference_t<kmer_t>, char>
+        constexpr std::optional<uint64_t> encode(kmer_t && kmer) const noexcept {
+            uint64_t code{};
+            std::size_t size{};
+            for (char const symbol : kmer) {
+                int8_t const rank = detail::kmer_rank_table[static_cast<unsigned char>(symbol)];
+                if (rank < 0 || ++size > _kmer_size)
+                    return std::nullopt;
+                code = (code << 2) | static_cast<uint64_t>(rank);
+            }
+            return (size == _kmer_size) ? std::optional{code} : std::nullopt;
+        }
+
+        //!\brief Returns the seek position of the node of the entry within the indexed tree.
+        constexpr seek_position const & position(entry_type const & entry) const noexcept {
+            return _positions[entry.node];
+        }
+
+        //!\brief Returns the coverage of the node of the entry, i.e. the haplotypes that contain the occurrence.
+        constexpr coverage_t const & coverage(entry_type const & entry) const noexcept {
+            return _coverages[entry.node];
+        }
+
+        /*!\brief Returns the index of the owned chunk the node of the entry belongs to.
+         *
+         * \details
+         *
+         * The index must have been built from a chunked tree. The entry is located in the search tree of this chunk,
+         * e.g. `index.locate(index.search_tree(forest.owned_chunk(index.chunk(entry))), entry)`.
+         */
+        constexpr std::size_t chunk(entry_type const & entry) const noexcept {
+            assert(entry.node < _chunks.size());
+            return _chunks[entry.node];
+        }
+
+        /*!\brief Adapts the tree the index was built from to the tree the seek positions refer to.
+         *
+         * \details
+         *
+         * The returned tree applies the same adaptors as the construction of the index and is seekable.
+         */
+        template <typename tree_t>
+        constexpr auto search_tree(tree_t && tree) const {
+            return detail::kmer_index_tree((tree_t &&)tree, _kmer_size, _window_size);
+        }
+
+        /*!\brief Seeks the node of the entry in the tree returned by libjst::kmer_index::search_tree.
+         *
+         * \details
+         *
+         * The k-mer begins at `entry.offset` within the label of the returned node, which can be extended to verify
+         * the candidate, e.g. by a matcher continuing from this node.
+         */
+        template <typename search_tree_t>
+        constexpr auto locate(search_tree_t const & search_tree, entry_type const & entry) const {
+            return search_tree.seek(position(entry));
+        }
+
+        /*!\brief Re-indexes the chunks overlapping the dirty regions and keeps the entries of all other chunks.
+         *
+         * \param[in] forest The chunked tree of the modified store, built with the same chunk size as the index.
+         * \param[in] dirty_regions The modified source intervals, see libjst::rcs_store::dirty_regions.
+         * \param[in] thread_count The number of threads indexing the dirty chunks.
+         *
+         * \returns The number of re-indexed chunks.
+         *
+         * \details
+         *
+         * A chunk is dirty if it contains a window of `kmer_size + window_size - 1` symbols overlapping a dirty
+         * region, see libjst::dirty_chunks, or if one of its alternate branches, which continue behind the end of the
+         * chunk, may reach a dirty region. The nodes of the dirty chunks are removed and the remaining nodes are
+         * renumbered, which keeps the order of their entries, before the dirty chunks are indexed again and their
+         * sorted entries are merged into the kept ones. The seek positions of the kept nodes are moved by the number
+         * of variants added before their chunk. Afterwards, the index holds the same entries as an index built
+         * from the modified forest, though the nodes may be numbered differently. Throws std::logic_error if the index
+         * was not built from a chunked tree or the forest has a different number of chunks.
+         */
+        template <typename forest_t>
+            requires requires (forest_t const & forest) { forest.owned_chunk(0); }
+        std::size_t update(forest_t const & forest,
+                           source_mask const & dirty_regions,
+                           std::size_t const thread_count = std::thread::hardware_concurrency())
+        {
+            if (_chunks.size() != _positions.size() || _chunk_count != std::ranges::size(forest))
+                throw std::logic_error{"Only an index built from a forest with the same chunks can be updated."};
+
+            std::vector<bool> is_dirty = dirty_chunks(forest, dirty_regions, _kmer_size + _window_size - 1);
+            std::vector<std::size_t> dirty_indices{};
+            for (std::size_t chunk_idx = 0; chunk_idx < is_dirty.size(); ++chunk_idx) {
+                // The alternate branches of a chunk continue behind its end, where a dirty region changes them, too.
+                if (!is_dirty[chunk_idx]) {
+                    auto region = std::ranges::upper_bound(dirty_regions, chunk_idx * forest.chunk_size(),
+                                                           std::ranges::less{}, &source_interval::end);
+                    is_dirty[chunk_idx] = region != dirty_regions.end() &&
+                                          region->begin < chunk_reach(forest, chunk_idx);
+                }
+                if (is_dirty[chunk_idx])
+                    dirty_indices.push_back(chunk_idx);
+            }
+            if (dirty_indices.empty())
+                return 0;
+
+            // The variants of a clean chunk are unchanged, but the variants added before it shift their indices.
+            std::vector<int64_t> shifts(_chunk_count);
+            for (std::size_t chunk_idx = 0; chunk_idx < _chunk_count; ++chunk_idx) {
+                if (is_dirty[chunk_idx])
+                    continue;
+                uint64_t const root = chunk_root(forest, chunk_idx);
+                shifts[chunk_idx] = static_cast<int64_t>(root) - static_cast<int64_t>(_chunk_roots[chunk_idx]);
+                _chunk_roots[chunk_idx] = root;
+            }
+
+            // Renumbers the kept nodes in their order, such that the kept entries remain sorted.
+            constexpr uint32_t removed = std::numeric_limits<uint32_t>::max();
+            std::vector<uint32_t> new_nodes(_positions.size(), removed);
+            uint32_t kept_count{};
+            for (std::size_t node = 0; node < _positions.size(); ++node) {
+                if (is_dirty[_chunks[node]])
+                    continue;
+                new_nodes[node] = kept_count;
+                if (int64_t const shift = shifts[_chunks[node]]; shift != 0)
+                    _positions[node].set_variant_index(_positions[node].get_variant_index() + shift);
+                _positions[kept_count] = std::move(_positions[node]);
+                _coverages[kept_count] = std::move(_coverages[node]);
+                _chunks[kept_count] = _chunks[node];
+                ++kept_count;
+            }
+            _positions.resize(kept_count);
+            _coverages.erase(_coverages.begin() + kept_count, _coverages.end());
+            _chunks.resize(kept_count);
+
+            std::erase_if(_entries, [&] (entry_type const & entry) { return new_nodes[entry.node] == removed; });
+            for (entry_type & entry : _entries)
+                entry.node = new_nodes[entry.node];
+
+            append_chunks(forest, dirty_indices, thread_count);
+            return dirty_indices.size();
+        }
+
+    private:
+
+        // Indexes the given chunks in parallel, appends them in the given order and merges their entries.
+        template <typename forest_t>
+        void append_chunks(forest_t const & forest,
+                           std::span<std::size_t const> const chunk_indices,
+                           std::size_t const thread_count)
+        {
+            // Every chunk is indexed into its own buffer and its entries are sorted by the indexing thread.
+            std::vector<chunk_buffer> buffers(chunk_indices.size());
+            detail::parallel_for_each_job(chunk_indices.size(), thread_count, [&] (std::size_t const job) {
+                index_chunk(forest.owned_chunk(chunk_indices[job]), buffers[job]);
+                _chunk_roots[chunk_indices[job]] = chunk_root(forest, chunk_indices[job]);
+            });
+
+            // The kept entries and the entries of every chunk form the sorted runs, which are merged pairwise.
+            std::vector<std::size_t> run_ends{};
+            if (!_entries.empty())
+                run_ends.push_back(_entries.size());
+            for (std::size_t job = 0; job < buffers.size(); ++job) {
+                chunk_buffer & buffer = buffers[job];
+                uint32_t const first_node = static_cast<uint32_t>(_positions.size());
+                std::ranges::move(buffer.positions, std::back_inserter(_positions));
+                std::ranges::move(buffer.coverages, std::back_inserter(_coverages));
+                _chunks.insert(_chunks.end(), buffer.positions.size(), static_cast<uint32_t>(chunk_indices[job]));
+                std::ranges::transform(buffer.entries, std::back_inserter(_entries), [&] (entry_type entry) {
+                    entry.node += first_node;
+                    return entry;
+                });
+                buffer = chunk_buffer{};
+                if (_entries.size() > (run_ends.empty() ? 0 : run_ends.back()))
+                    run_ends.push_back(_entries.size());
+            }
+            merge_runs(std::move(run_ends), thread_count);
+        }
+
+        // Returns the end of the source positions the alternate branches beginning within the chunk can reach. A branch
+        // spells at most `kmer_size + window_size - 2` symbols, but skips the symbols a variant deletes in excess of
+        // its insertion.
+        template <typename forest_t>
+        std::size_t chunk_reach(forest_t const & forest, std::size_t const chunk_idx) const {
+            std::size_t const extension = _kmer_size + _window_size - 2;
+            std::size_t const chunk_begin = chunk_idx * forest.chunk_size();
+            std::size_t reach = chunk_begin + forest.chunk_size() + extension;
+
+            auto const interior = libjst::interior_breakends(forest.data().variants());
+            auto breakend_position = [] (auto breakend) -> std::size_t {
+                return libjst::position(std::move(breakend));
+            };
+            auto it = std::ranges::lower_bound(interior, chunk_begin, std::ranges::less{}, breakend_position);
+            for (; it != interior.end() && breakend_position(*it) < reach; ++it) {
+                if ((*it).get_breakpoint_end() != breakpoint_end::low)
+                    continue;
+                std::size_t const deletion = libjst::breakpoint_span(libjst::get_breakpoint(*it));
+                std::size_t const insertion = std::ranges::size(libjst::alt_sequence(*it));
+                if (deletion > insertion)
+                    reach = std::max(reach, breakend_position(*it) + extension + deletion - insertion);
+            }
+            return reach;
+        }
+
+        template <typename forest_t>
+        uint64_t chunk_root(forest_t const & forest, std::size_t const chunk_idx) const {
+            return (*search_tree(forest.owned_chunk(chunk_idx)).root()).position().get_variant_index();
+        }
+
+        template <typename chunk_tree_t>
+        void index_chunk(chunk_tree_t && chunk, chunk_buffer & buffer) const {
+            auto indexed_tree = search_tree((chunk_tree_t &&)chunk);
+            tree_traverser_base<decltype(indexed_tree)> path{indexed_tree};
+            for (auto it = path.begin(); it != path.end(); ++it) {
+                auto && label = *it;
+                uint32_t const node = static_cast<uint32_t>(buffer.positions.size());
+                buffer.positions.push_back(label.position());
+                buffer.coverages.emplace_back(label.coverage());
+                index_label(label.sequence(), node, buffer.entries);
+            }
+            std::ranges::sort(buffer.entries);
+        }
+
+        // Merges the consecutive sorted runs of the entries ending at the given positions in rounds of pairwise merges.
+        void merge_runs(std::vector<std::size_t> run_ends, std::size_t const thread_count) {
+            while (run_ends.size() > 1) {
+                std::size_t const pair_count = run_ends.size() / 2;
+                detail::parallel_for_each_job(pair_count, thread_count, [&] (std::size_t const pair) {
+                    std::size_t const first = (pair == 0) ? 0 : run_ends[2 * pair - 1];
+                    std::inplace_merge(_entries.begin() + first,
+                                       _entries.begin() + run_ends[2 * pair],
+                                       _entries.begin() + run_ends[2 * pair + 1]);
+                });
+
+                std::vector<std::size_t> merged_ends{};
+                for (std::size_t run = 1; run < run_ends.size(); run += 2)
+                    merged_ends.push_back(run_ends[run]);
+                if (run_ends.size() % 2 == 1)
+                    merged_ends.push_back(run_ends.back());
+                run_ends = std::move(merged_ends);
+            }
+        }
+
+        constexpr uint64_t kmer_mask() const noexcept {
+            return (_kmer_size == max_kmer_size) ? ~uint64_t{0} : (uint64_t{1} << (2 * _kmer_size)) - 1;
+        }
+
+        // Adds the k-mers or the minimizers spelled by the label of the given node.
+        template <typename sequence_t>
+        void index_label(sequence_t && sequence, uint32_t const node, std::vector<entry_type> & entries) const {
+            uint64_t const mask = kmer_mask();
+            uint64_t code{};
+            std::size_t valid{}; // the number of consecutive nucleotides ending at the current symbol
+            std::size_t end{};
+            // The valid k-mers of the current window with increasing hash values.
+            std::deque<std::pair<uint64_t, std::size_t>> candidates{};
+            std::optional<std::size_t> last_offset{};
+            for (auto it = std::ranges::begin(sequence); it != std::ranges::end(sequence); ++it, ++end) {
+                int8_t const rank = detail::kmer_rank_table[static_cast<unsigned char>(*it)];
+                code = ((code << 2) | static_cast<uint64_t>(rank & 3)) & mask;
+                valid = (rank < 0) ? 0 : valid + 1;
+                if (end + 1 < _kmer_size)
+                    continue;
+
+                std::size_t const offset = end + 1 - _kmer_size;
+                if (_window_size == 1) {
+                    if (valid >= _kmer_size)
+                        entries.push_back(entry_type{code, node, static_cast<uint32_t>(offset)});
+                    continue;
+                }
+
+                if (valid >= _kmer_size) {
+                    uint64_t const hash = code ^ (minimizer_seed & mask);
+                    while (!candidates.empty() && candidates.back().first > hash)
+                        candidates.pop_back();
+                    candidates.emplace_back(hash, offset);
+                }
+                if (offset + 1 < _window_size) // the first window is not complete yet
+                    continue;
+
+                std::size_t const window_begin = offset + 1 - _window_size;
+                while (!candidates.empty() && candidates.front().second < window_begin)
+                    candidates.pop_front();
+                if (candidates.empty() || last_offset == candidates.front().second)
+                    continue;
+
+                last_offset = candidates.front().second;
+                entries.push_back(entry_type{candidates.front().first ^ (minimizer_seed & mask),
+                                             node,
+                                             static_cast<uint32_t>(*last_offset)});
+            }
+        }
+    };
+
+    /*!\brief Builds the libjst::kmer_index of the given tree in a single traversal.
+     *
+     * \param[in] tree The tree to index.
+     * \param[in] kmer_size The size of the indexed k-mers.
+     * \param[in] window_size The number of consecutive k-mers of which the minimizer is indexed; defaults to one,
+     *                        which indexes every k-mer.
+     *
+     * \details
+     *
+     * The tree is labelled, coloured, trimmed and left extended by `kmer_size + window_size - 2` symbols, such that
+     * every window of the haplotypes is spelled by exactly one label and every label is searched on its own. The
+     * nodes not supported by any haplotype are pruned. Hence, an occurrence is indexed once, no matter how many
+     * haplotypes share it, and its coverage tells which haplotypes these are. A minimizer shared by the windows of the
+     * extension and of the own symbols of a node can be indexed for the node and for its parent.
+     */
+    template <typename tree_t>
+        requires (!requires (tree_t const & forest) { forest.owned_chunk(0); })
+    auto build_kmer_index(tree_t && tree, std::size_t const kmer_size, std::size_t const window_size = 1) {
+        using search_tree_t = decltype(detail::kmer_index_tree((tree_t &&)tree, kmer_size, window_size));
+        using label_t = libjst::tree_label_t<search_tree_t>;
+        using coverage_t = std::remove_cvref_t<decltype(std::declval<label_t const &>().coverage())>;
+        return kmer_index<coverage_t>{(tree_t &&)tree, kmer_size, window_size};
+    }
+
+    /*!\brief Builds the libjst::kmer_index of the owned chunks of the given forest in parallel.
+     *
+     * \param[in] forest The chunked tree to index, e.g. libjst::chunked_tree_impl.
+     * \param[in] kmer_size The size of the indexed k-mers.
+     * \param[in] window_size The number of consecutive k-mers of which the minimizer is indexed.
+     * \param[in] thread_count The number of threads indexing the chunks; defaults to the hardware concurrency.
+     *
+     * \details
+     *
+     * The threads take the chunks one by one and index every chunk into its own buffer, whose entries are sorted by
+     * the indexing thread. The buffers are appended in the order of the chunks and their sorted runs are merged in
+     * rounds of pairwise merges, which run in parallel as well. The index is hence the same for every number of
+     * threads. Every k-mer of the haplotypes is found in the index, though a k-mer spelled by an alternate branch
+     * continuing behind the end of its chunk may be indexed for this and for the next chunk. The index can be updated
+     * after the store was modified, see libjst::kmer_index::update.
+     */
+    template <typename forest_t>
+        requires requires (forest_t const & forest) { forest.owned_chunk(0); }
+    auto build_kmer_index(forest_t const & forest,
+                          std::size_t const kmer_size,
+                          std::size_t const window_size,
+                          std::size_t const thread_count = std::thread::hardware_concurrency()) {
+        using search_tree_t = decltype(detail::kmer_index_tree(forest.owned_chunk(0), kmer_size, window_size));
+        using label_t = libjst::tree_label_t<search_tree_t>;
+        using coverage_t = std::remove_cvref_t<decltype(std::declval<label_t const &>().coverage())>;
+        return kmer_index<coverage_t>{forest, kmer_size, window_size, thread_count};
+    }
+}  // namespace libjst
@@ -0,0 +1,114 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::label_batch.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <utility>
+#include <vector>
+
+namespace libjst
+{
+    /*!\brief Stores the sequences of several labels back to back in one contiguous buffer.
+     *
+     * \tparam symbol_t The type of the stored symbols.
+     *
+     * \details
+     *
+     * The batch is the unit transferred to a matching back-end, e.g. a device, that cannot follow the journals of the
+     * labels: it consists of the concatenated symbols and the offsets of the labels within them. The label `i` spans
+     * the symbols `[offsets()[i], offsets()[i + 1])`, and locate() maps an offset into the buffer back to the label and
+     * the position within the label.
+     */
+    template <typename symbol_t = char>
+    class label_batch {
+    private:
+
+        std::vector<symbol_t> _symbols{};
+        std::vector<std::size_t> _offsets{0};
+
+    public:
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        label_batch() = default; //!< Default.
+        //!\}
+
+        //!\brief Appends the given sequence as the next label of the batch.
+        template <std::ranges::input_range sequence_t>
+            requires std::convertible_to<std::ranges::range_reference_t<sequence_t>, symbol_t>
+        void append(sequence_t && sequence) {
+            if constexpr (std::ranges::sized_range<sequence_t>)
+                _symbols.reserve(_symbols.size() + std::ranges::size(sequence));
+            std::ranges::copy(sequence, std::back_inserter(_symbols));
+            _offsets.push_back(_symbols.size());
+        }
+
+        //!\brief Removes all labels but keeps the allocated buffers.
+        void clear() noexcept {
+            _symbols.clear();
+            _offsets.resize(1);
+        }
+
+        //!\brief Allocates the buffers for the given number of labels and symbols.
+        void reserve(std::size_t const label_count, std::size_t const symbol_count) {
+            _offsets.reserve(label_count + 1);
+            _symbols.reserve(symbol_count);
+        }
+
+        //!\brief Returns the number of labels.
+        constexpr std::size_t size() const noexcept {
+            return _offsets.size() - 1;
+        }
+
+        constexpr bool empty() const noexcept {
+            return size() == 0;
+        }
+
+        //!\brief Returns the symbols of the given label.
+        constexpr std::span<symbol_t const> operator[](std::size_t const label) const noexcept {
+            assert(label < size());
+            return symbols().subspan(_offsets[label], _offsets[label + 1] - _offsets[label]);
+        }
+
+        //!\brief Returns the concatenated symbols of all labels.
+        constexpr std::span<symbol_t const> symbols() const noexcept {
+            return _symbols;
+        }
+
+        //!\brief Returns the offsets of the labels followed by the total number of symbols.
+        constexpr std::span<std::size_t const> offsets() const noexcept {
+            return _offsets;
+        }
+
+        /*!\brief Maps an offset into the concatenated symbols to the label and the position within the label.
+         *
+         * \param[in] symbol_offset The offset of a symbol; must be less than `symbols().size()`.
+         *
+         * ### Complexity
+         *
+         * Logarithmic in the number of labels.
+         */
+        constexpr std::pair<std::size_t, std::size_t> locate(std::size_t const symbol_offset) const noexcept {
+            assert(symbol_offset < _symbols.size());
+            auto label_end = std::ranges::upper_bound(_offsets, symbol_offset);
+            std::size_t const label = static_cast<std::size_t>(std::ranges::distance(_offsets.begin(), label_end)) - 1;
+            return {label, symbol_offset - _offsets[label]};
+        }
+    };
+}  // namespace libjst
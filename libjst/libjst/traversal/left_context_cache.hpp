@@ -0,0 +1,147 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::left_context_cache.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+#include <libjst/utility/arena_allocator.hpp>
+
+namespace libjst
+{
+    /*!\brief Caches the last symbols of the active branch of a traversal, which precede the labels of its nodes.
+     *
+     * \tparam symbol_t The trivially copyable type of the symbols.
+     *
+     * \details
+     *
+     * The labels of a left extended tree, see libjst::left_extend, begin with up to `extension` positions that
+     * precede the node on its branch. Those symbols have mostly just been read from the label of the parent. The
+     * cache keeps the symbols of the branch in a ring buffer indexed by their position in the path sequence of the
+     * labels, such that only the symbols behind the end of the parent label are read from the next label, see
+     * haystack(). The symbols of a variant, e.g. an insertion that is part of the left extension of the first node
+     * behind it, are hence still read from the label. The cache subscribes to the branch stack of the traversal: a
+     * push records the end of the branch, at which the pending reference child continues after the pop.
+     *
+     * The ring buffer holds four times the extension. A branch that consumed more symbols before it is continued
+     * may have overwritten the context of the continuation, which is then read from the label again. Since the
+     * alternate branches are trimmed to the extension, this happens rarely, if at all.
+     */
+    template <typename symbol_t>
+        requires std::is_trivially_copyable_v<symbol_t>
+    class left_context_cache {
+    private:
+
+        std::vector<symbol_t, arena_allocator<symbol_t>> _ring{}; //!< The last symbols of the branch.
+        std::vector<symbol_t, arena_allocator<symbol_t>> _haystack{}; //!< The symbols of the active label.
+        std::vector<std::size_t, arena_allocator<std::size_t>> _branch_ends{}; //!< The branch ends to continue at.
+        std::size_t _end{}; //!< The path position behind the last consumed label of the branch.
+        std::size_t _valid_from{}; //!< The first path position not yet overwritten in the ring buffer.
+        std::size_t _cached_symbols{}; //!< The number of label symbols taken from the ring buffer.
+
+    public:
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        left_context_cache() = default; //!< Default.
+
+        //!\brief Constructs the cache for labels extended by the given number of symbols.
+        explicit left_context_cache(std::size_t const extension) :
+            _ring(std::bit_ceil(std::max<std::size_t>(4 * extension, 1)))
+        {
+            _haystack.reserve(2 * extension);
+        }
+        //!\}
+
+        /*!\brief Returns the label sequence as one contiguous buffer and consumes it.
+         *
+         * \param[in] label_sequence The sequence of the left extended label of the active node.
+         * \param[in] first The position of the label sequence within the path sequence of the label.
+         *
+         * \details
+         *
+         * The symbols preceding the end of the previous label on the branch are taken from the cache, the remaining
+         * ones are copied from the label. The returned buffer is valid until the next call.
+         */
+        template <std::ranges::random_access_range sequence_t>
+            requires std::ranges::sized_range<sequence_t>
+        std::span<symbol_t const> haystack(sequence_t && label_sequence, std::size_t const first) {
+            auto label_it = std::ranges::begin(label_sequence);
+            std::size_t const last = first + std::ranges::size(label_sequence);
+            if (first > _end) // the symbols in between were never consumed, e.g. before the root of a partial tree.
+                _valid_from = std::max(_valid_from, first);
+            std::size_t const cached_last = (first < _valid_from) ? first : std::clamp(_end, first, last);
+
+            _haystack.resize(last - first);
+            copy_from_ring(first, cached_last);
+            std::ranges::advance(label_it, cached_last - first);
+            std::ranges::copy(label_it, std::ranges::end(label_sequence), _haystack.begin() + (cached_last - first));
+            assert(std::ranges::equal(_haystack, label_sequence));
+
+            copy_to_ring(std::max(cached_last, last - std::min(last, _ring.size())), last, first);
+            if (last > _ring.size()) // the written slots held the symbols one ring before.
+                _valid_from = std::max(_valid_from, last - _ring.size());
+            _cached_symbols += cached_last - first;
+            _end = last;
+            return _haystack;
+        }
+
+        //!\brief Returns the number of label symbols that were taken from the cache instead of the labels.
+        constexpr std::size_t cached_symbols() const noexcept {
+            return _cached_symbols;
+        }
+
+        //!\brief Records the end of the branch the pending node continues.
+        void notify_push() {
+            _branch_ends.push_back(_end);
+        }
+
+        //!\brief Continues the branch at the end recorded by the matching push.
+        void notify_pop() {
+            assert(!_branch_ends.empty());
+            _end = _branch_ends.back();
+            _branch_ends.pop_back();
+        }
+
+    private:
+
+        constexpr std::size_t ring_mask() const noexcept {
+            return _ring.size() - 1;
+        }
+
+        // Copies the symbols at the positions [from, to) of the ring buffer to the begin of the haystack.
+        void copy_from_ring(std::size_t const from, std::size_t const to) noexcept {
+            std::size_t const slot = from & ring_mask();
+            std::size_t const head = std::min(to - from, _ring.size() - slot); // until the ring wraps around
+            std::copy_n(_ring.begin() + slot, head, _haystack.begin());
+            std::copy_n(_ring.begin(), to - from - head, _haystack.begin() + head);
+        }
+
+        // Copies the haystack symbols at the positions [from, to) to the ring buffer; the haystack begins at first.
+        void copy_to_ring(std::size_t const from, std::size_t const to, std::size_t const first) noexcept {
+            std::size_t const slot = from & ring_mask();
+            std::size_t const head = std::min(to - from, _ring.size() - slot);
+            auto symbols = _haystack.begin() + (from - first);
+            std::copy_n(symbols, head, _ring.begin() + slot);
+            std::copy_n(symbols + head, to - from - head, _ring.begin());
+        }
+    };
+}  // namespace libjst
@@ -0,0 +1,147 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides jst traversal evaluating the pattern on several branches in lockstep.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include <libjst/matcher/concept.hpp>
+#include <libjst/sequence_tree/concept.hpp>
+#include <libjst/sequence_tree/coloured_tree.hpp>
+#include <libjst/sequence_tree/labelled_tree.hpp>
+#include <libjst/sequence_tree/merge_tree.hpp>
+#include <libjst/sequence_tree/prune_unsupported.hpp>
+#include <libjst/sequence_tree/trim_tree.hpp>
+
+namespace libjst
+{
+    /*!\brief A state capturing matcher that can search several haystacks at once, one lane per haystack.
+     *
+     * \details
+     *
+     * `matcher.search_lanes(states, haystacks, callback)` continues the search of every haystack from the state of its
+     * lane and stores the final state back into the lane. The callback is invoked with the lane and the iterator to
+     * the last symbol of the hit. The matcher's own state is not changed.
+     */
+    template <typename matcher_t, typename haystack_t>
+    concept lockstep_matcher = state_capturing_matcher<matcher_t> &&
+        requires (matcher_t const & matcher,
+                  std::span<matcher_state_t<matcher_t>> states,
+                  std::span<haystack_t const> haystacks) {
+            matcher.search_lanes(states, haystacks, [] (std::size_t, auto &&) {});
+    };
+
+    /*!\brief Searches the pattern on several branches of the tree at once.
+     *
+     * \details
+     *
+     * The tree is prepared as for the libjst::state_capture_traverser. Instead of visiting one node after another,
+     * up to libjst::lockstep_traverser::lane_count pending nodes are taken from the frontier, typically siblings and
+     * cousins below the same variant, and their labels are searched together: every node starts from the matcher
+     * state captured at the end of its parent. The children of a node inherit the final state of the node's lane.
+     * The reported hits equal the ones of the libjst::state_capture_traverser, albeit in a different order.
+     *
+     * If the matcher models libjst::lockstep_matcher, the lanes are evaluated by its `search_lanes` member, which can
+     * process the symbols of all lanes with SIMD instructions, e.g. libjst::shift_or_matcher. Otherwise, the lanes are
+     * searched one after another by restoring and capturing the matcher state.
+     */
+    struct lockstep_traverser {
+
+        std::size_t lane_count{8}; //!< The maximal number of nodes searched together.
+
+        template <typename tree_t, typename pattern_t, typename callback_t>
+            requires state_capturing_matcher<std::remove_cvref_t<pattern_t>>
+        constexpr void operator()(tree_t && tree, pattern_t && pattern, callback_t && callback) const {
+            if (libjst::window_size(pattern) == 0)
+                return;
+
+            auto search_tree = tree | libjst::labelled()
+                                    | libjst::coloured()
+                                    | trim(libjst::window_size(pattern) - 1)
+                                    | prune_unsupported()
+                                    | merge(); // make big nodes
+
+            using node_t = libjst::tree_node_t<decltype(search_tree)>;
+            using state_t = matcher_state_t<std::remove_cvref_t<pattern_t>>;
+
+            std::size_t const lanes = std::max<std::size_t>(lane_count, 1);
+            std::vector<node_t> frontier{libjst::root(search_tree)};
+            std::vector<state_t> frontier_states{pattern.capture()};
+            std::vector<node_t> nodes{};
+            std::vector<state_t> states{};
+
+            while (!frontier.empty()) {
+                // Take the most recently discovered nodes, which are the closest relatives on the frontier.
+                std::size_t const batch_size = std::min(lanes, frontier.size());
+                auto const batch_begin = frontier.size() - batch_size;
+                nodes.assign(std::make_move_iterator(frontier.begin() + batch_begin),
+                             std::make_move_iterator(frontier.end()));
+                states.assign(std::make_move_iterator(frontier_states.begin() + batch_begin),
+                              std::make_move_iterator(frontier_states.end()));
+                frontier.resize(batch_begin);
+                frontier_states.resize(batch_begin);
+
+                search_batch(pattern, nodes, states, callback);
+
+                for (std::size_t lane = 0; lane < batch_size; ++lane) {
+                    if (auto ref_child = nodes[lane].next_ref(); ref_child) {
+                        frontier.push_back(std::move(*ref_child));
+                        frontier_states.push_back(states[lane]);
+                    }
+                    if (auto alt_child = nodes[lane].next_alt(); alt_child) {
+                        frontier.push_back(std::move(*alt_child));
+                        frontier_states.push_back(states[lane]);
+                    }
+                }
+            }
+        }
+
+    private:
+
+        template <typename pattern_t, typename node_t, typename state_t, typename callback_t>
+        static constexpr void search_batch(pattern_t & pattern,
+                                           std::vector<node_t> const & nodes,
+                                           std::vector<state_t> & states,
+                                           callback_t & callback) {
+            using label_t = std::remove_cvref_t<decltype(*nodes[0])>;
+            using haystack_t = std::remove_cvref_t<decltype(std::declval<label_t const &>().sequence())>;
+
+            std::vector<label_t> labels{};
+            labels.reserve(nodes.size());
+            for (node_t const & node : nodes)
+                labels.push_back(*node);
+
+            if constexpr (lockstep_matcher<std::remove_cvref_t<pattern_t>, haystack_t>) {
+                std::vector<haystack_t> haystacks{};
+                haystacks.reserve(labels.size());
+                for (label_t const & label : labels)
+                    haystacks.push_back(label.sequence());
+
+                pattern.search_lanes(std::span{states}, std::span<haystack_t const>{haystacks},
+                                     [&] (std::size_t const lane, auto && label_it) {
+                    callback(std::move(label_it), labels[lane]);
+                });
+            } else {
+                for (std::size_t lane = 0; lane < labels.size(); ++lane) {
+                    pattern.restore(states[lane]);
+                    pattern(labels[lane].sequence(), [&] (auto && label_it) {
+                        callback(std::move(label_it), labels[lane]);
+                    });
+                    states[lane] = pattern.capture();
+                }
+            }
+        }
+    };
+}  // namespace libjst
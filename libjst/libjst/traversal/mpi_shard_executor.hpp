@@ -0,0 +1,346 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::mpi_shard_executor distributing the shards of a search over the ranks of a cluster.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <libjst/sequence_tree/stats.hpp>
+
+/*!\brief Enables the distribution over MPI ranks by libjst::mpi_shard_executor if defined to a non-zero value.
+ *
+ * \details
+ *
+ * Set by the CMake option `LIBJST_WITH_MPI`, which also links MPI to all targets linking libjst. Disabled by default,
+ * in which case the executor runs all shards in the calling process.
+ */
+#ifndef LIBJST_HAS_MPI
+#define LIBJST_HAS_MPI 0
+#endif
+
+#if LIBJST_HAS_MPI
+#include <mpi.h>
+#endif
+
+namespace libjst
+{
+    //!\brief Whether libjst was built with MPI and the libjst::mpi_shard_executor distributes the shards over ranks.
+    inline constexpr bool mpi_enabled = static_cast<bool>(LIBJST_HAS_MPI);
+
+    /*!\brief The hits and statistics of the shards gathered on the root rank, see libjst::mpi_shard_executor::run.
+     *
+     * \tparam hit_t The type of the hits.
+     */
+    template <typename hit_t>
+    struct distributed_result {
+        std::vector<std::vector<hit_t>> shard_hits{}; //!< The hits of every shard in the order they were reported.
+        tree_stats stats{}; //!< The statistics of all shards accumulated in shard order.
+
+        //!\brief Returns the hits of all shards in shard order.
+        auto hits() const noexcept {
+            return shard_hits | std::views::join;
+        }
+    };
+
+    namespace detail
+    {
+        // The byte buffer exchanged for a searched shard: the shard index, the hits and the statistics.
+        class shard_message {
+        private:
+            std::vector<std::byte> _bytes{};
+            std::size_t _read_offset{};
+
+        public:
+            shard_message() = default;
+
+            explicit shard_message(std::vector<std::byte> bytes) noexcept : _bytes{std::move(bytes)}
+            {}
+
+            std::vector<std::byte> & bytes() noexcept {
+                return _bytes;
+            }
+
+            template <typename value_t>
+                requires std::is_trivially_copyable_v<value_t>
+            void write(std::span<value_t const> values) {
+                write_value(static_cast<uint64_t>(values.size()));
+                std::size_t const offset = _bytes.size();
+                _bytes.resize(offset + values.size_bytes());
+                if (!values.empty())
+                    std::memcpy(_bytes.data() + offset, values.data(), values.size_bytes());
+            }
+
+            template <typename value_t>
+                requires std::is_trivially_copyable_v<value_t>
+            void write_value(value_t const & value) {
+                std::size_t const offset = _bytes.size();
+                _bytes.resize(offset + sizeof(value_t));
+                std::memcpy(_bytes.data() + offset, &value, sizeof(value_t));
+            }
+
+            template <typename value_t>
+                requires std::is_trivially_copyable_v<value_t>
+            std::vector<value_t> read() {
+                std::vector<value_t> values(read_value<uint64_t>());
+                std::size_t const size = values.size() * sizeof(value_t);
+                check_remaining(size);
+                if (size > 0)
+                    std::memcpy(values.data(), _bytes.data() + _read_offset, size);
+                _read_offset += size;
+                return values;
+            }
+
+            template <typename value_t>
+                requires std::is_trivially_copyable_v<value_t>
+            value_t read_value() {
+                check_remaining(sizeof(value_t));
+                value_t value{};
+                std::memcpy(&value, _bytes.data() + _read_offset, sizeof(value_t));
+                _read_offset += sizeof(value_t);
+                return value;
+            }
+
+            void write_stats(tree_stats const & stats) {
+                write_value(static_cast<uint64_t>(stats.node_count));
+                write_value(static_cast<uint64_t>(stats.subtree_count));
+                write_value(static_cast<uint64_t>(stats.leaf_count));
+                write_value(static_cast<uint64_t>(stats.symbol_count));
+                write_value(static_cast<uint64_t>(stats.max_subtree_depth));
+                write(std::span<std::size_t const>{stats.subtree_depths});
+                write_value(stats.metrics);
+            }
+
+            tree_stats read_stats() {
+                tree_stats stats{};
+                stats.node_count = read_value<uint64_t>();
+                stats.subtree_count = read_value<uint64_t>();
+                stats.leaf_count = read_value<uint64_t>();
+                stats.symbol_count = read_value<uint64_t>();
+                stats.max_subtree_depth = read_value<uint64_t>();
+                stats.subtree_depths = read<std::size_t>();
+                stats.metrics = read_value<tree_metrics>();
+                return stats;
+            }
+
+        private:
+            void check_remaining(std::size_t const size) const {
+                if (_bytes.size() - _read_offset < size)
+                    throw std::runtime_error{"The shard message is truncated."};
+            }
+        };
+    } // namespace detail
+
+    /*!\brief Distributes the shards of a search over the ranks of an MPI communicator and gathers the results.
+     *
+     * \details
+     *
+     * The shards are given by their indices, e.g. into the libjst::tree_shard list of a libjst::shard_planner or the
+     * chunks of a libjst::chunked_tree_impl, and are searched by a function the caller provides on every rank. The
+     * rank 0 coordinates the search: every other rank requests a shard, searches it and sends its hits and
+     * libjst::tree_stats back together with the request for the next shard, until all shards are searched. The shards
+     * are hence distributed dynamically, such that the ranks searching cheap shards search more of them. The planned
+     * shards should be searched in the order of their decreasing cost to balance the last shards.
+     *
+     * Every rank builds the partial tree of a shard over its own copy of the store. If the store maps a file, e.g. a
+     * libjst::mapped_compressed_multisequence, a rank only reads the pages of the shards it searches.
+     *
+     * The hits are copied bytewise and must hence be trivially copyable, e.g. the positions of the hits rather than
+     * the label iterators. Without `LIBJST_WITH_MPI`, or on a communicator of a single rank, the calling process
+     * searches all shards in order, which keeps the code of a search the same for a single node.
+     */
+    class mpi_shard_executor {
+    private:
+
+        static constexpr int result_tag{0x1b57};
+        static constexpr int task_tag{0x1b58};
+        static constexpr int64_t no_shard{-1};
+
+#if LIBJST_HAS_MPI
+        MPI_Comm _communicator{MPI_COMM_WORLD};
+#endif
+        int _rank{};
+        int _size{1};
+
+    public:
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        /*!\brief Distributes over the ranks of `MPI_COMM_WORLD`; the caller must have initialised MPI.
+         *
+         * \details
+         *
+         * Without `LIBJST_WITH_MPI` the executor consists of the calling process as rank 0.
+         */
+        mpi_shard_executor()
+        {
+#if LIBJST_HAS_MPI
+            MPI_Comm_rank(_communicator, &_rank);
+            MPI_Comm_size(_communicator, &_size);
+#endif
+        }
+
+#if LIBJST_HAS_MPI
+        //!\brief Distributes over the ranks of the given communicator, which must outlive the executor.
+        explicit mpi_shard_executor(MPI_Comm communicator) : _communicator{communicator}
+        {
+            MPI_Comm_rank(_communicator, &_rank);
+            MPI_Comm_size(_communicator, &_size);
+        }
+#endif
+        //!\}
+
+        //!\brief Returns the rank of the calling process.
+        constexpr int rank() const noexcept {
+            return _rank;
+        }
+
+        //!\brief Returns the number of ranks.
+        constexpr int size() const noexcept {
+            return _size;
+        }
+
+        //!\brief Returns whether the calling process gathers the results.
+        constexpr bool is_root() const noexcept {
+            return _rank == 0;
+        }
+
+        /*!\brief Searches the shards on all ranks and hands the results to the sink on rank 0 as they arrive.
+         *
+         * \param[in] shard_count The number of shards.
+         * \param[in] search Invoked as `search(shard_idx, hits, stats)` with an empty `std::vector<hit_t> &` and
+         *                   `libjst::tree_stats &` to fill.
+         * \param[in] sink Invoked on rank 0 as `sink(shard_idx, std::vector<hit_t> &&, libjst::tree_stats &&)` once per
+         *                 shard, in the order the shards complete.
+         *
+         * \details
+         *
+         * Must be called collectively by all ranks of the communicator. With more than one rank, rank 0 only
+         * coordinates and does not search. Throws std::runtime_error on rank 0 if a message is malformed.
+         */
+        template <typename hit_t, typename search_t, typename sink_t>
+            requires std::is_trivially_copyable_v<hit_t> &&
+                     std::invocable<search_t &, std::size_t, std::vector<hit_t> &, tree_stats &> &&
+                     std::invocable<sink_t &, std::size_t, std::vector<hit_t> &&, tree_stats &&>
+        void run_unordered(std::size_t const shard_count, search_t && search, sink_t && sink) const {
+            if (_size <= 1) {
+                for (std::size_t shard_idx = 0; shard_idx < shard_count; ++shard_idx) {
+                    std::vector<hit_t> hits{};
+                    tree_stats stats{};
+                    std::invoke(search, shard_idx, hits, stats);
+                    std::invoke(sink, shard_idx, std::move(hits), std::move(stats));
+                }
+                return;
+            }
+#if LIBJST_HAS_MPI
+            if (is_root())
+                coordinate<hit_t>(shard_count, sink);
+            else
+                work<hit_t>(search);
+#endif
+        }
+
+        /*!\brief Searches the shards on all ranks and returns the results gathered on rank 0 in shard order.
+         *
+         * \details
+         *
+         * See run_unordered. The result of the other ranks is empty.
+         */
+        template <typename hit_t, typename search_t>
+            requires std::is_trivially_copyable_v<hit_t> &&
+                     std::invocable<search_t &, std::size_t, std::vector<hit_t> &, tree_stats &>
+        distributed_result<hit_t> run(std::size_t const shard_count, search_t && search) const {
+            distributed_result<hit_t> result{};
+            std::vector<tree_stats> shard_stats{};
+            if (is_root()) {
+                result.shard_hits.resize(shard_count);
+                shard_stats.resize(shard_count);
+            }
+            run_unordered<hit_t>(shard_count, search,
+                                 [&] (std::size_t const shard_idx, std::vector<hit_t> && hits, tree_stats && stats) {
+                result.shard_hits[shard_idx] = std::move(hits);
+                shard_stats[shard_idx] = std::move(stats);
+            });
+            for (tree_stats const & stats : shard_stats)
+                result.stats += stats;
+            return result;
+        }
+
+    private:
+#if LIBJST_HAS_MPI
+        // Hands out the shards to the requesting ranks until every rank was sent the end of the shards.
+        template <typename hit_t, typename sink_t>
+        void coordinate(std::size_t const shard_count, sink_t & sink) const {
+            std::size_t next_shard{};
+            int active_workers = _size - 1;
+            while (active_workers > 0) {
+                MPI_Status status{};
+                MPI_Probe(MPI_ANY_SOURCE, result_tag, _communicator, &status);
+                int byte_count{};
+                MPI_Get_count(&status, MPI_BYTE, &byte_count);
+                detail::shard_message message{std::vector<std::byte>(static_cast<std::size_t>(byte_count))};
+                MPI_Recv(message.bytes().data(), byte_count, MPI_BYTE, status.MPI_SOURCE, result_tag, _communicator,
+                         MPI_STATUS_IGNORE);
+
+                int64_t task = no_shard;
+                if (next_shard < shard_count)
+                    task = static_cast<int64_t>(next_shard++);
+                else
+                    --active_workers;
+                MPI_Send(&task, 1, MPI_INT64_T, status.MPI_SOURCE, task_tag, _communicator);
+
+                int64_t const searched_shard = message.read_value<int64_t>();
+                if (searched_shard == no_shard)
+                    continue;
+                if (searched_shard < 0 || static_cast<std::size_t>(searched_shard) >= shard_count)
+                    throw std::runtime_error{"Received the result of an unknown shard."};
+                std::vector<hit_t> hits = message.read<hit_t>();
+                tree_stats stats = message.read_stats();
+                std::invoke(sink, static_cast<std::size_t>(searched_shard), std::move(hits), std::move(stats));
+            }
+        }
+
+        // Sends the result of the previous shard with the request for the next one until no shard is left.
+        template <typename hit_t, typename search_t>
+        void work(search_t & search) const {
+            detail::shard_message message{};
+            message.write_value(no_shard);
+            while (true) {
+                std::vector<std::byte> & bytes = message.bytes();
+                MPI_Send(bytes.data(), static_cast<int>(bytes.size()), MPI_BYTE, 0, result_tag, _communicator);
+
+                int64_t task{};
+                MPI_Recv(&task, 1, MPI_INT64_T, 0, task_tag, _communicator, MPI_STATUS_IGNORE);
+                if (task == no_shard)
+                    return;
+
+                std::vector<hit_t> hits{};
+                tree_stats stats{};
+                std::invoke(search, static_cast<std::size_t>(task), hits, stats);
+                message = detail::shard_message{};
+                message.write_value(task);
+                message.write(std::span<hit_t const>{hits});
+                message.write_stats(stats);
+            }
+        }
+#endif
+    };
+}  // namespace libjst
@@ -0,0 +1,153 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides jst traversal handing the labels of every tree level as one batch to a matching back-end.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <ranges>
+#include <span>
+#include <vector>
+
+#include <libjst/matcher/concept.hpp>
+#include <libjst/sequence_tree/concept.hpp>
+#include <libjst/sequence_tree/coloured_tree.hpp>
+#include <libjst/sequence_tree/labelled_tree.hpp>
+#include <libjst/sequence_tree/left_extend_tree.hpp>
+#include <libjst/sequence_tree/merge_tree.hpp>
+#include <libjst/sequence_tree/prune_unsupported.hpp>
+#include <libjst/sequence_tree/trim_tree.hpp>
+#include <libjst/traversal/frontier_traverser_base.hpp>
+#include <libjst/traversal/label_batch.hpp>
+#include <libjst/traversal/lockstep_traverser.hpp>
+#include <libjst/utility/arena_allocator.hpp>
+
+namespace libjst
+{
+    /*!\brief A back-end that searches the pattern in every label of a libjst::label_batch.
+     *
+     * \details
+     *
+     * `backend(pattern, batch, callback)` searches every label of the batch on its own and invokes the callback with
+     * the index of the label and the position of the hit within the label, where the position corresponds to the
+     * iterator the pattern reports for the hit. A back-end for an accelerator copies the symbols and the offsets of
+     * the batch to the device, evaluates the pattern there and reports the hits after copying them back.
+     */
+    template <typename backend_t, typename pattern_t, typename symbol_t>
+    concept batch_backend = requires (backend_t const & backend,
+                                      pattern_t & pattern,
+                                      label_batch<symbol_t> const & batch) {
+        backend(pattern, batch, [] (std::size_t, std::size_t) {});
+    };
+
+    /*!\brief The default libjst::batch_backend searching the batch on the host.
+     *
+     * \details
+     *
+     * If the pattern models libjst::lockstep_matcher, the labels of the batch are searched as lanes by its
+     * `search_lanes` member, e.g. with the SIMD kernel of libjst::shift_or_matcher; otherwise, one after another.
+     * Every label starts from the reset state of the pattern.
+     */
+    struct host_batch_backend {
+        template <typename pattern_t, typename symbol_t, typename callback_t>
+        constexpr void operator()(pattern_t & pattern,
+                                  label_batch<symbol_t> const & batch,
+                                  callback_t && callback) const {
+            using haystack_t = std::span<symbol_t const>;
+
+            if constexpr (lockstep_matcher<pattern_t, haystack_t>) {
+                reset_state(pattern);
+                std::vector<matcher_state_t<pattern_t>> states(batch.size(), pattern.capture());
+                std::vector<haystack_t> haystacks{};
+                haystacks.reserve(batch.size());
+                for (std::size_t label = 0; label < batch.size(); ++label)
+                    haystacks.push_back(batch[label]);
+
+                pattern.search_lanes(std::span{states}, std::span<haystack_t const>{haystacks},
+                                     [&] (std::size_t const lane, auto && hit_it) {
+                    callback(lane, static_cast<std::size_t>(hit_it - haystacks[lane].begin()));
+                });
+            } else {
+                for (std::size_t label = 0; label < batch.size(); ++label) {
+                    haystack_t haystack = batch[label];
+                    reset_state(pattern);
+                    pattern(haystack, [&] (auto && hit_it) {
+                        callback(label, static_cast<std::size_t>(hit_it - haystack.begin()));
+                    });
+                }
+            }
+        }
+
+    private:
+
+        template <typename pattern_t>
+        static constexpr void reset_state(pattern_t & pattern) {
+            if constexpr (requires { pattern.reset(); })
+                pattern.reset();
+        }
+    };
+
+    /*!\brief Searches the pattern along the standard adaptor pipeline and evaluates it per tree level on a back-end.
+     *
+     * \tparam backend_t The type of the back-end modelling libjst::batch_backend; defaults to
+     *                   libjst::host_batch_backend.
+     *
+     * \details
+     *
+     * The tree is prepared as for the libjst::state_oblivious_traverser and expanded on the host level by level with
+     * the libjst::frontier_traverser_base. The sequences of the labels of a level are copied into one
+     * libjst::label_batch, which the back-end searches at once. The hits are mapped back to the labels, such that the
+     * callback is invoked with the iterator to the hit in the label and the label itself, as for the
+     * libjst::state_oblivious_traverser. The reported hits are the same, albeit in a different order.
+     */
+    template <typename backend_t = host_batch_backend>
+    struct offload_traverser {
+
+        backend_t backend{}; //!< The back-end searching the batches.
+
+        template <typename tree_t, typename pattern_t, typename callback_t>
+            requires window_matcher<std::remove_cvref_t<pattern_t>>
+        constexpr void operator()(tree_t && tree, pattern_t && pattern, callback_t && callback) const {
+            if (libjst::window_size(pattern) == 0)
+                return;
+
+            auto const extension = detail::left_extension(pattern); // static if the window size is.
+            // The labels and the frontiers allocate from the arena of the calling thread, if there is one.
+            auto search_tree = tree | libjst::labelled(arena_allocator<std::byte>{})
+                                    | libjst::coloured()
+                                    | trim(static_cast<std::size_t>(extension))
+                                    | prune_unsupported()
+                                    | left_extend(extension)
+                                    | merge(); // make big nodes
+
+            using traverser_t = frontier_traverser_base<decltype(search_tree), arena_allocator<std::byte>>;
+            using label_t = std::ranges::range_value_t<typename traverser_t::level_type>;
+            using symbol_t = std::ranges::range_value_t<decltype(std::declval<label_t const &>().sequence())>;
+            static_assert(batch_backend<backend_t, std::remove_reference_t<pattern_t>, symbol_t>,
+                          "The back-end must search a batch of the label symbols with the given pattern.");
+
+            traverser_t level_path{search_tree};
+            label_batch<symbol_t> batch{};
+            for (auto it = level_path.begin(); it != level_path.end(); ++it) {
+                auto level = *it;
+                batch.clear();
+                for (auto && label : level)
+                    batch.append(label.sequence());
+
+                backend(pattern, batch, [&] (std::size_t const label_idx, std::size_t const position) {
+                    auto label = level[label_idx];
+                    auto label_it = std::ranges::next(std::ranges::begin(label.sequence()), position);
+                    callback(std::move(label_it), label);
+                });
+            }
+        }
+    };
+}  // namespace libjst
@@ -0,0 +1,848 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides a parallel traverser over the chunks of a chunked tree.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include <libjst/matcher/concept.hpp>
+#include <libjst/rcms/interior_breakends.hpp>
+#include <libjst/sequence_tree/partial_tree.hpp>
+#include <libjst/traversal/chunk_profile.hpp>
+#include <libjst/traversal/state_oblivious_traverser.hpp>
+#include <libjst/traversal/traversal_budget.hpp>
+#include <libjst/traversal/work_stealing_scheduler.hpp>
+#include <libjst/utility/arena_allocator.hpp>
+#include <libjst/utility/numa_topology.hpp>
+#include <libjst/variant/breakpoint.hpp>
+#include <libjst/variant/concept.hpp>
+
+namespace libjst
+{
+    /*!\brief Traverses the chunks of a libjst::chunked_tree_impl concurrently.
+     *
+     * \tparam traverser_t The traverser that is applied to every single chunk; defaults to
+     *                     libjst::state_oblivious_traverser, which runs the standard adaptor pipeline
+     *                     (labelled | coloured | trim | prune_unsupported | left_extend | merge) per chunk.
+     *
+     * \details
+     *
+     * The chunks are handed out dynamically to a fixed number of worker threads, such that threads finishing cheap
+     * chunks early pick up the remaining ones. The calling thread participates as one of the workers.
+     * Every chunk is searched with its own copy of the pattern, so the pattern only needs to be copyable but not
+     * thread-safe.
+     * Every hit is owned by the chunk in which the match ends, i.e. the chunk holding the node the hit is reported in.
+     * If the forest offers `owned_chunk(chunk_idx)`, like libjst::chunked_tree_impl and libjst::multi_contig_forest, the
+     * chunks are traversed without their overlap: the labels are left extended by the trimmed window of the pattern,
+     * such that matches spanning the boundary between two chunks are still found by the chunk they end in, while the
+     * matches ending within the overlap are left to the next chunk. Every hit is hence delivered exactly once and no
+     * deduplication of the hits is needed.
+     *
+     * The results can be delivered in two ways:
+     *  * per thread: every worker invokes its own copy of the callback, which are returned to the caller after the
+     *    traversal, e.g. to reduce thread local results.
+     *  * ordered: every hit is first projected by the worker into a self-contained value, which is buffered per chunk.
+     *    The buffered hits are then handed to the callback in the order of the chunks, i.e. in ascending order of the
+     *    chunk positions on the source, and the callback is never invoked concurrently. The hits within a chunk are
+     *    delivered in the order of its traversal, hence the output is the same for every run and thread count.
+     *    A reorder window bounds the number of chunks that are traversed ahead of the first undelivered chunk, and
+     *    thereby the buffered hits, see set_reorder_window.
+     *
+     * If the traverser is constructed with a minimal split size and the forest is a chunked tree, the chunks are
+     * executed by the libjst::work_stealing_scheduler instead. A chunk is then split at runtime into partial trees
+     * over consecutive source intervals whenever a worker runs dry, as long as the intervals are not shorter than the
+     * minimal split size. This balances chunks with clustered variant density, whose costs differ widely. A partial
+     * tree rooted within the window of the pattern around an indel does not report the hits crossing its root like the
+     * tree of the whole chunk, hence a task is split at the position closest to its middle that lies outside these
+     * windows, and is not split if there is none that leaves both parts at least the minimal split size.
+     *
+     * If the chunk arena is enabled, every task is traversed inside its own libjst::scoped_arena, from which the labels
+     * and the branch stack of the traversal are allocated and which is released at once when the task finishes.
+     * The callback and the projected hits must then not keep a copy of a label, or anything else allocated by a
+     * libjst::arena_allocator, beyond the task.
+     *
+     * The callback of the per thread delivery and the projection of the ordered delivery may also accept the index of
+     * the task as first argument, i.e. `(task_idx, label_it, label)`. For statically scheduled chunks this is the chunk
+     * index, which for example locates the contig of a hit in a libjst::multi_contig_forest; for split chunks it is the
+     * first source position of the task.
+     *
+     * If the forest is a libjst::replicated_chunked_tree, every worker is bound to a node of its topology, see
+     * libjst::numa_topology::node_of_worker, and traverses the chunks of the replica in the memory of that node. The
+     * workers are spread evenly over the nodes, and the calling thread, which is the first worker, is bound to the
+     * first node and restored to its previous affinity after the traversal.
+     *
+     * If a worker throws, no further chunks are scheduled and the first exception is rethrown on the calling thread
+     * after all workers have joined.
+     *
+     * A libjst::traversal_budget bounds the runtime of the search: once it expires, the workers skip the remaining
+     * tasks, and the traverser of every running task is stopped as well if it offers `set_budget(budget)`, like the
+     * libjst::state_oblivious_traverser. The skipped and interrupted tasks are recorded in a
+     * libjst::parallel_checkpoint, from which a later search resumes, see resume_from. The per thread delivery keeps
+     * the hits an interrupted task reported before it was stopped, which are hence reported again when the task is
+     * resumed; the ordered delivery only delivers the hits of finished tasks.
+     *
+     * A chunk filter restricts the search to the chunks that may contain a hit, e.g. the chunks accepted by a
+     * libjst::chunk_kmer_filter for the pattern, see set_chunk_filter. The rejected chunks are skipped before they are
+     * scheduled, such that a screen for the presence of a pattern only probes the filters of most chunks.
+     *
+     * In the profiling mode, the traverser records the libjst::chunk_cost of every finished task in a
+     * libjst::chunk_profile, see set_profile: its wall time and hits, and its searched labels, symbols and deepest
+     * branch if the traverser accepts a libjst::chunk_cost_recorder as subscriber, like the
+     * libjst::state_oblivious_traverser. The costs are recorded for the source interval of the task if the forest
+     * has one, i.e. for a chunked tree, a libjst::shard_forest and for split chunks, and for its chunk indices
+     * otherwise. The libjst::shard_planner balances the shards of the next run by such a profile.
+     */
+    template <typename traverser_t = state_oblivious_traverser>
+    class parallel_chunk_traverser {
+    private:
+
+        //!\brief A source interval of a chunk, which owns the hits ending within it.
+        struct chunk_task {
+            std::size_t begin{};
+            std::size_t end{};
+        };
+
+        //!\brief Records the tasks that were not finished within the budget of one search.
+        class budget_tracker {
+        private:
+            traversal_budget const * _budget{};
+            parallel_checkpoint * _checkpoint{};
+            std::mutex _checkpoint_mutex{};
+
+        public:
+            budget_tracker(traversal_budget const * budget, parallel_checkpoint * checkpoint) noexcept :
+                _budget{budget},
+                _checkpoint{checkpoint}
+            {
+                if (_checkpoint != nullptr)
+                    _checkpoint->tasks.clear();
+            }
+
+            ~budget_tracker() {
+                if (_checkpoint != nullptr)
+                    std::ranges::sort(_checkpoint->tasks);
+            }
+
+            //!\brief Returns whether the task can be started; records it as unfinished otherwise.
+            bool start(std::size_t const task_begin, std::size_t const task_end) {
+                return !record_if_expired(task_begin, task_end);
+            }
+
+            //!\brief Returns whether the task was finished within the budget; records it as unfinished otherwise.
+            bool finish(std::size_t const task_begin, std::size_t const task_end) {
+                return !record_if_expired(task_begin, task_end);
+            }
+
+        private:
+            bool record_if_expired(std::size_t const task_begin, std::size_t const task_end) {
+                if (_budget == nullptr || !_budget->expired())
+                    return false;
+
+                if (_checkpoint != nullptr) {
+                    std::scoped_lock checkpoint_lock{_checkpoint_mutex};
+                    _checkpoint->tasks.push_back(parallel_checkpoint::task{.begin = task_begin, .end = task_end});
+                }
+                return true;
+            }
+        };
+
+        //!\brief Records the costs of the finished tasks of one search.
+        class profile_tracker {
+        private:
+            chunk_profile * _profile{};
+            std::mutex _profile_mutex{};
+
+        public:
+            explicit profile_tracker(chunk_profile * profile) noexcept : _profile{profile}
+            {
+                if (_profile != nullptr)
+                    _profile->clear();
+            }
+
+            //!\brief Whether the costs of the tasks are measured.
+            bool enabled() const noexcept {
+                return _profile != nullptr;
+            }
+
+            void record(chunk_cost cost) {
+                if (_profile != nullptr) {
+                    std::scoped_lock profile_lock{_profile_mutex};
+                    _profile->record(std::move(cost));
+                }
+            }
+        };
+
+        [[no_unique_address]] traverser_t _traverser{};
+        std::size_t _thread_count{1};
+        std::size_t _min_split_size{};
+        bool _uses_chunk_arena{false};
+        std::size_t _reorder_window{};
+        traversal_budget const * _budget{};
+        parallel_checkpoint * _checkpoint{};
+        std::vector<parallel_checkpoint::task> _resume_tasks{};
+        std::function<bool(std::size_t)> _chunk_filter{};
+        chunk_profile * _profile{};
+
+    public:
+
+        /*!\name Constructors, destructor, and assignment
+         * \{
+         */
+        parallel_chunk_traverser() : parallel_chunk_traverser{std::thread::hardware_concurrency()}
+        {}
+
+        constexpr explicit parallel_chunk_traverser(std::size_t const thread_count, traverser_t traverser = {}) noexcept :
+            parallel_chunk_traverser{thread_count, 0, std::move(traverser)}
+        {}
+
+        constexpr parallel_chunk_traverser(std::size_t const thread_count,
+                                           std::size_t const min_split_size,
+                                           traverser_t traverser = {}) noexcept :
+            _traverser{std::move(traverser)},
+            _thread_count{std::max<std::size_t>(thread_count, 1)},
+            _min_split_size{min_split_size}
+        {}
+        //!\}
+
+        constexpr std::size_t thread_count() const noexcept {
+            return _thread_count;
+        }
+
+        constexpr std::size_t min_split_size() const noexcept {
+            return _min_split_size;
+        }
+
+        //!\brief Enables or disables the traversal of every task inside its own libjst::scoped_arena.
+        constexpr void use_chunk_arena(bool const enable) noexcept {
+            _uses_chunk_arena = enable;
+        }
+
+        constexpr bool uses_chunk_arena() const noexcept {
+            return _uses_chunk_arena;
+        }
+
+        /*!\brief Bounds the number of chunks the ordered delivery traverses ahead of the first undelivered chunk.
+         *
+         * \details
+         *
+         * A worker waits before it starts a chunk that lies `window` or more chunks past the first undelivered chunk,
+         * such that the hits of at most `window - 1` chunks finished out of order are buffered. A small window bounds
+         * the memory of the ordered delivery, while a window of zero, the default, never lets a worker wait and
+         * maximises the throughput. The window does not apply to chunks split at runtime, whose tasks are not
+         * handed out in the order of the source.
+         */
+        constexpr void set_reorder_window(std::size_t const window) noexcept {
+            _reorder_window = window;
+        }
+
+        constexpr std::size_t reorder_window() const noexcept {
+            return _reorder_window;
+        }
+
+        /*!\brief Stops the search once the given budget expires and records the unfinished tasks in the checkpoint.
+         *
+         * \details
+         *
+         * The checkpoint is cleared at the beginning of every search. Both must outlive the searches.
+         */
+        void set_budget(traversal_budget const & budget, parallel_checkpoint & checkpoint) noexcept {
+            _budget = std::addressof(budget);
+            _checkpoint = std::addressof(checkpoint);
+        }
+
+        /*!\brief Searches only the tasks of the given checkpoint in the next searches.
+         *
+         * \details
+         *
+         * The forest and the configuration of the traverser must be the same as for the interrupted search. An empty
+         * checkpoint searches all tasks again.
+         */
+        void resume_from(parallel_checkpoint checkpoint) {
+            _resume_tasks = std::move(checkpoint.tasks);
+            std::ranges::sort(_resume_tasks);
+        }
+
+        /*!\brief Searches only the chunks accepted by the given predicate in the next searches.
+         *
+         * \details
+         *
+         * The predicate is invoked with the index of every chunk before it is scheduled, e.g. with the predicate of a
+         * libjst::chunk_kmer_filter, which rejects the chunks that can not contain a hit of the pattern. Chunks split
+         * at runtime are filtered by the chunk their task begins in. The rejected chunks are neither searched nor
+         * recorded in the checkpoint of a budget. An empty predicate searches all chunks again.
+         */
+        void set_chunk_filter(std::function<bool(std::size_t)> accepts_chunk) noexcept {
+            _chunk_filter = std::move(accepts_chunk);
+        }
+
+        /*!\brief Records the costs of the tasks finished by the next searches in the given profile.
+         *
+         * \details
+         *
+         * The profile is cleared at the beginning of every search and must outlive the searches. Tasks that are not
+         * finished within the budget are not recorded.
+         */
+        void set_profile(chunk_profile & profile) noexcept {
+            _profile = std::addressof(profile);
+        }
+
+        //!\brief Stops recording the costs of the tasks.
+        void reset_profile() noexcept {
+            _profile = nullptr;
+        }
+
+        /*!\brief Searches all chunks and delivers the hits to thread local copies of the callback.
+         *
+         * \param[in] forest The chunked tree to search.
+         * \param[in] pattern The pattern to search; copied for every chunk.
+         * \param[in] callback The callback invoked with `(label_it, label)` for every hit; copied for every worker.
+         *
+         * \returns A vector with the callback copy of every worker.
+         */
+        template <std::ranges::random_access_range forest_t, typename pattern_t, typename callback_t>
+            requires std::copy_constructible<std::remove_cvref_t<pattern_t>> &&
+                     std::copy_constructible<std::remove_cvref_t<callback_t>>
+        auto operator()(forest_t const & forest, pattern_t const & pattern, callback_t const & callback) const
+            -> std::vector<std::remove_cvref_t<callback_t>>
+        {
+            using local_callback_t = std::remove_cvref_t<callback_t>;
+
+            std::vector<local_callback_t> local_callbacks(worker_count(forest), callback);
+
+            budget_tracker tracker{_budget, _checkpoint};
+            profile_tracker profiler{_profile};
+            for_each_task(forest, split_window_size(pattern), [&] (std::size_t const worker_id,
+                                                                  std::size_t const task_begin,
+                                                                  std::size_t const task_end,
+                                                                  auto && tree) {
+                if (!tracker.start(task_begin, task_end))
+                    return;
+
+                std::remove_cvref_t<pattern_t> chunk_pattern{pattern};
+                chunk_cost cost = profile_task(profiler, forest, task_begin, task_end, (decltype(tree) &&) tree,
+                                               chunk_pattern, [&] (auto && label_it, auto && label) {
+                    invoke_with_task(local_callbacks[worker_id], task_begin, label_it, label);
+                });
+                if (tracker.finish(task_begin, task_end))
+                    profiler.record(std::move(cost));
+            });
+
+            return local_callbacks;
+        }
+
+        /*!\brief Searches all chunks and delivers the hits in chunk order.
+         *
+         * \tparam hit_t The type of the projected hits that are buffered per chunk.
+         * \param[in] forest The chunked tree to search.
+         * \param[in] pattern The pattern to search; copied for every chunk.
+         * \param[in] projection Invoked by the workers with `(label_it, label)` to produce a hit value that remains
+         *                       valid after the traversal of the chunk.
+         * \param[in] callback Invoked with every projected hit in chunk order; never invoked concurrently.
+         *
+         * \details
+         *
+         * The hits of a chunk are delivered as soon as all preceding chunks have been delivered, such that only the
+         * hits of chunks finished out of order need to be buffered, at most those of the reorder window. Chunks that
+         * were split at runtime are delivered in the order of their source intervals.
+         */
+        template <typename hit_t,
+                  std::ranges::random_access_range forest_t,
+                  typename pattern_t,
+                  typename projection_t,
+                  typename callback_t>
+            requires std::copy_constructible<std::remove_cvref_t<pattern_t>> &&
+                     std::invocable<callback_t &, hit_t>
+        void ordered(forest_t const & forest,
+                     pattern_t const & pattern,
+                     projection_t && projection,
+                     callback_t && callback) const
+        {
+            using hit_buffer_t = std::vector<hit_t>;
+            using finished_task_t = std::pair<std::size_t, hit_buffer_t>; // the task end and its hits
+
+            std::map<std::size_t, finished_task_t> finished_tasks{};
+            // A resumed search starts with the first unfinished task, and a filtered search with the first accepted one.
+            std::size_t next_delivered_task{next_searched_task(forest, 0)};
+            std::mutex delivery_mutex{};
+            std::condition_variable window_changed{};
+            bool failed{false};
+            std::size_t const reorder_window = splits_chunks<forest_t>() ? 0 : _reorder_window;
+
+            auto deliver = [&] (auto it) {
+                std::ranges::for_each(it->second.second, [&] (hit_t & hit) {
+                    callback(std::move(hit));
+                });
+                next_delivered_task = next_searched_task(forest, it->second.first);
+            };
+
+            // Tasks that fail or are not finished within the budget are never delivered, so no worker may wait for them.
+            auto within_window = [&] (std::size_t const task_begin) {
+                return task_begin < next_delivered_task + reorder_window || failed ||
+                       (_budget != nullptr && _budget->expired());
+            };
+
+            auto release_waiting = [&] () {
+                std::scoped_lock delivery_lock{delivery_mutex};
+                window_changed.notify_all();
+            };
+
+            budget_tracker tracker{_budget, _checkpoint};
+            profile_tracker profiler{_profile};
+            for_each_task(forest, split_window_size(pattern), [&] (std::size_t,
+                                                                  std::size_t const task_begin,
+                                                                  std::size_t const task_end,
+                                                                  auto && tree) {
+                try {
+                    if (reorder_window > 0) {
+                        std::unique_lock delivery_lock{delivery_mutex};
+                        window_changed.wait(delivery_lock, [&] () { return within_window(task_begin); });
+                    }
+
+                    if (!tracker.start(task_begin, task_end)) {
+                        release_waiting();
+                        return;
+                    }
+
+                    std::remove_cvref_t<pattern_t> chunk_pattern{pattern};
+                    hit_buffer_t hits{};
+                    chunk_cost cost = profile_task(profiler, forest, task_begin, task_end, (decltype(tree) &&) tree,
+                                                   chunk_pattern, [&] (auto && label_it, auto && label) {
+                        hits.push_back(invoke_with_task(projection, task_begin, label_it, label));
+                    });
+                    if (!tracker.finish(task_begin, task_end)) {
+                        release_waiting();
+                        return;
+                    }
+                    profiler.record(std::move(cost));
+
+                    // Deliver the contiguous prefix of finished tasks.
+                    std::scoped_lock delivery_lock{delivery_mutex};
+                    finished_tasks.emplace(task_begin, finished_task_t{task_end, std::move(hits)});
+                    for (auto it = finished_tasks.begin();
+                         it != finished_tasks.end() && it->first == next_delivered_task;
+                         it = finished_tasks.erase(it)) {
+                        deliver(it);
+                    }
+                    window_changed.notify_all();
+                } catch (...) {
+                    {
+                        std::scoped_lock delivery_lock{delivery_mutex};
+                        failed = true;
+                    }
+                    window_changed.notify_all();
+                    throw;
+                }
+            });
+
+            // The tasks behind an unfinished or not resumed task are delivered in order after the search.
+            for (auto it = finished_tasks.begin(); it != finished_tasks.end(); it = finished_tasks.erase(it))
+                deliver(it);
+        }
+
+    private:
+
+        //!\brief Returns the first position at or behind the given one that is searched, skipping the finished tasks.
+        std::size_t next_task_begin(std::size_t const position) const noexcept {
+            if (_resume_tasks.empty())
+                return position;
+
+            auto it = std::ranges::upper_bound(_resume_tasks, position, std::less<>{}, &parallel_checkpoint::task::end);
+            return (it == _resume_tasks.end()) ? position : std::max(it->begin, position);
+        }
+
+        //!\brief Returns the first position at or behind the given one that is searched, skipping the rejected chunks.
+        template <typename forest_t>
+        std::size_t next_searched_task(forest_t const & forest, std::size_t position) const {
+            position = next_task_begin(position);
+            if (!_chunk_filter)
+                return position;
+
+            std::size_t positions_per_chunk{1};
+            std::size_t position_count = std::ranges::size(forest);
+            if constexpr (is_splittable_v<forest_t>) {
+                if (splits_chunks<forest_t>()) {
+                    positions_per_chunk = forest.chunk_size();
+                    position_count = std::ranges::size(forest.data().source());
+                }
+            }
+            while (position < position_count && !_chunk_filter(position / positions_per_chunk))
+                position = next_task_begin((position / positions_per_chunk + 1) * positions_per_chunk);
+            return position;
+        }
+
+        /*!\brief Searches the tree of a task and returns its measured cost if the profiling mode is enabled.
+         *
+         * \details
+         *
+         * The hits are counted on their way to the callback, and the labels by a libjst::chunk_cost_recorder if the
+         * traverser accepts subscribers.
+         */
+        template <typename forest_t, typename tree_t, typename pattern_t, typename callback_t>
+        chunk_cost profile_task(profile_tracker const & profiler,
+                                forest_t const & forest,
+                                std::size_t const task_begin,
+                                std::size_t const task_end,
+                                tree_t && tree,
+                                pattern_t & pattern,
+                                callback_t && callback) const {
+            if (!profiler.enabled()) {
+                search_task((tree_t &&) tree, pattern, (callback_t &&) callback);
+                return {};
+            }
+
+            chunk_cost cost = task_interval(forest, task_begin, task_end);
+            auto counting_callback = [&] (auto && label_it, auto && label) {
+                ++cost.hit_count;
+                callback((decltype(label_it) &&) label_it, (decltype(label) &&) label);
+            };
+            auto const start = std::chrono::steady_clock::now();
+            if constexpr (requires (traverser_t const & traverser, chunk_cost_recorder & recorder) {
+                              traverser((tree_t &&) tree, pattern, counting_callback, recorder);
+                          }) {
+                chunk_cost_recorder recorder{cost};
+                search_task((tree_t &&) tree, pattern, counting_callback, recorder);
+            } else {
+                search_task((tree_t &&) tree, pattern, counting_callback);
+            }
+            cost.wall_time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            return cost;
+        }
+
+        //!\brief Searches the tree of a task with the traverser, which is stopped by the budget if it supports one.
+        template <typename tree_t, typename pattern_t, typename callback_t, typename ...subscriber_ts>
+        void search_task(tree_t && tree,
+                         pattern_t & pattern,
+                         callback_t && callback,
+                         subscriber_ts & ...subscribers) const {
+            if constexpr (requires (traverser_t & traverser, traversal_budget const & budget) {
+                              traverser.set_budget(budget);
+                          }) {
+                if (_budget != nullptr) {
+                    traverser_t task_traverser{_traverser};
+                    task_traverser.set_budget(*_budget);
+                    task_traverser((tree_t &&) tree, pattern, (callback_t &&) callback, subscribers...);
+                    return;
+                }
+            }
+            _traverser((tree_t &&) tree, pattern, (callback_t &&) callback, subscribers...);
+        }
+
+        //!\brief Returns the source interval of a task, or its chunk indices if the forest has no source intervals.
+        template <typename forest_t>
+        chunk_cost task_interval(forest_t const & forest,
+                                 std::size_t const task_begin,
+                                 std::size_t const task_end) const {
+            if constexpr (is_splittable_v<forest_t>) {
+                if (splits_chunks<forest_t>())
+                    return chunk_cost{.begin = task_begin, .end = task_end};
+
+                std::size_t const chunk_size = forest.chunk_size();
+                std::size_t const source_size = std::ranges::size(forest.data().source());
+                return chunk_cost{.begin = task_begin * chunk_size,
+                                  .end = std::min(task_end * chunk_size, source_size)};
+            } else if constexpr (requires { { forest.shard(task_begin).begin } -> std::convertible_to<std::size_t>; }) {
+                return chunk_cost{.begin = forest.shard(task_begin).begin, .end = forest.shard(task_end - 1).end};
+            } else {
+                return chunk_cost{.begin = task_begin, .end = task_end};
+            }
+        }
+
+        //!\brief Invokes the given function with the task index if it accepts it and with the hit only otherwise.
+        template <typename fn_t, typename label_it_t, typename label_t>
+        static constexpr decltype(auto) invoke_with_task(fn_t && fn,
+                                                         std::size_t const task_begin,
+                                                         label_it_t && label_it,
+                                                         label_t && label) {
+            if constexpr (std::invocable<fn_t, std::size_t, label_it_t, label_t>)
+                return std::invoke((fn_t &&) fn, task_begin, (label_it_t &&) label_it, (label_t &&) label);
+            else
+                return std::invoke((fn_t &&) fn, (label_it_t &&) label_it, (label_t &&) label);
+        }
+
+        template <typename forest_t>
+        static constexpr bool is_splittable_v = requires (forest_t const & forest) {
+            { forest.data() };
+            { forest.chunk_size() } -> std::integral;
+            { forest.overlap_size() } -> std::integral;
+        };
+
+        template <typename forest_t>
+        static constexpr bool has_owned_chunks_v = requires (forest_t const & forest) {
+            { forest.owned_chunk(std::size_t{}) };
+        };
+
+        template <typename forest_t>
+        static constexpr bool is_replicated_v = requires (forest_t const & forest) {
+            { forest.topology() } -> std::same_as<numa_topology const &>;
+            { forest.replica(std::size_t{}) };
+        };
+
+        //!\brief Returns the replica of the node of the given worker, or the forest itself if it is not replicated.
+        template <typename forest_t>
+        constexpr decltype(auto) local_forest(forest_t const & forest, std::size_t const worker_id) const noexcept {
+            if constexpr (is_replicated_v<forest_t>)
+                return forest.replica(forest.topology().node_of_worker(worker_id, worker_count(forest)));
+            else
+                return (forest);
+        }
+
+        template <typename forest_t>
+        constexpr bool splits_chunks() const noexcept {
+            if constexpr (is_splittable_v<forest_t>)
+                return _min_split_size > 0;
+            else
+                return false;
+        }
+
+        template <typename forest_t>
+        constexpr std::size_t worker_count(forest_t const & forest) const noexcept {
+            if (splits_chunks<forest_t>())
+                return _thread_count;
+            else
+                return std::max<std::size_t>(std::min<std::size_t>(_thread_count, std::ranges::size(forest)), 1);
+        }
+
+        /*!\brief Invokes `task_fn(worker_id, task_begin, task_end, tree)` for every task.
+         *
+         * \details
+         *
+         * The tasks are identified by the half open interval `[task_begin, task_end)`, which is the chunk index for
+         * statically scheduled chunks and the source interval for split chunks. In both cases the intervals of all
+         * tasks partition the range starting at 0. The window size of the pattern determines where chunks are split.
+         */
+        template <typename forest_t, typename task_fn_t>
+        void for_each_task(forest_t const & forest, std::size_t const window_size, task_fn_t && task_fn) const {
+            if constexpr (is_replicated_v<forest_t>) {
+                // Every worker binds itself before its first task; only the binding of the calling thread is undone.
+                numa_topology const & topology = forest.topology();
+                std::vector<std::optional<numa_binding>> worker_bindings(worker_count(forest));
+                for_each_arena_task(forest, window_size, [&] (std::size_t const worker_id,
+                                                              std::size_t const task_begin,
+                                                              std::size_t const task_end,
+                                                              auto && tree) {
+                    if (!worker_bindings[worker_id])
+                        worker_bindings[worker_id].emplace(
+                            topology.bind_current_thread(topology.node_of_worker(worker_id, worker_bindings.size())));
+                    task_fn(worker_id, task_begin, task_end, (decltype(tree) &&) tree);
+                });
+            } else {
+                for_each_arena_task(forest, window_size, task_fn);
+            }
+        }
+
+        template <typename forest_t, typename task_fn_t>
+        void for_each_arena_task(forest_t const & forest, std::size_t const window_size, task_fn_t && task_fn) const {
+            if (_uses_chunk_arena) {
+                for_each_task_impl(forest, window_size, [&] (std::size_t const worker_id,
+                                                             std::size_t const task_begin,
+                                                             std::size_t const task_end,
+                                                             auto && tree) {
+                    scoped_arena chunk_arena{};
+                    task_fn(worker_id, task_begin, task_end, (decltype(tree) &&) tree);
+                });
+            } else {
+                for_each_task_impl(forest, window_size, task_fn);
+            }
+        }
+
+        template <typename forest_t, typename task_fn_t>
+        void for_each_task_impl(forest_t const & forest, std::size_t const window_size, task_fn_t && task_fn) const {
+            if constexpr (is_splittable_v<forest_t>) {
+                if (splits_chunks<forest_t>()) {
+                    execute_split(forest, window_size, task_fn);
+                    return;
+                }
+            }
+
+            // A resumed search visits only the chunks of the unfinished tasks, and a filtered search the accepted ones.
+            bool const selects_chunks = !_resume_tasks.empty() || static_cast<bool>(_chunk_filter);
+            std::vector<std::size_t> selected_chunks{};
+            auto select_chunk = [&] (std::size_t const chunk_idx) {
+                if (!_chunk_filter || _chunk_filter(chunk_idx))
+                    selected_chunks.push_back(chunk_idx);
+            };
+            if (_resume_tasks.empty()) {
+                if (selects_chunks)
+                    for (std::size_t chunk_idx = 0; chunk_idx < std::ranges::size(forest); ++chunk_idx)
+                        select_chunk(chunk_idx);
+            } else {
+                for (parallel_checkpoint::task const & task : _resume_tasks)
+                    for (std::size_t chunk_idx = task.begin; chunk_idx < task.end; ++chunk_idx)
+                        select_chunk(chunk_idx);
+            }
+
+            std::size_t const chunk_count = selects_chunks ? selected_chunks.size() : std::ranges::size(forest);
+            execute(worker_count(forest), chunk_count, [&] (std::size_t const worker_id, std::size_t chunk_idx) {
+                if (selects_chunks)
+                    chunk_idx = selected_chunks[chunk_idx];
+                auto && chunks = local_forest(forest, worker_id);
+                if constexpr (has_owned_chunks_v<std::remove_cvref_t<decltype(chunks)>>)
+                    task_fn(worker_id, chunk_idx, chunk_idx + 1, chunks.owned_chunk(chunk_idx));
+                else
+                    task_fn(worker_id, chunk_idx, chunk_idx + 1, std::ranges::begin(chunks)[chunk_idx]);
+            });
+        }
+
+        template <typename forest_t, typename task_fn_t>
+        void execute_split(forest_t const & forest, std::size_t const window_size, task_fn_t && task_fn) const {
+            auto const & rcs_store = forest.data();
+            std::size_t const source_size = std::ranges::size(rcs_store.source());
+            std::size_t const chunk_size = forest.chunk_size();
+
+            std::vector<chunk_task> initial_tasks{};
+            initial_tasks.reserve(std::ranges::size(forest));
+            if (_resume_tasks.empty()) {
+                for (std::size_t chunk_begin = 0; chunk_begin < source_size; chunk_begin += chunk_size)
+                    initial_tasks.push_back(chunk_task{.begin = chunk_begin,
+                                                       .end = std::min(chunk_begin + chunk_size, source_size)});
+            } else {
+                for (parallel_checkpoint::task const & task : _resume_tasks)
+                    initial_tasks.push_back(chunk_task{.begin = task.begin, .end = task.end});
+            }
+            if (_chunk_filter)
+                std::erase_if(initial_tasks, [&] (chunk_task const & task) {
+                    return !_chunk_filter(task.begin / chunk_size);
+                });
+
+            std::vector<chunk_task> const blocked = indel_windows(rcs_store, window_size);
+            auto split_fn = [&] (chunk_task & task) -> std::optional<chunk_task> {
+                std::size_t const task_size = task.end - task.begin;
+                if (task_size < 2 * _min_split_size)
+                    return std::nullopt;
+
+                // Moves a split within the window around an indel to the closer position before or behind the window.
+                std::size_t const lowest = task.begin + _min_split_size;
+                std::size_t const highest = task.end - _min_split_size;
+                std::size_t split_position = task.begin + task_size / 2;
+                auto window = std::ranges::upper_bound(blocked, split_position, std::ranges::less{}, &chunk_task::end);
+                if (window != blocked.end() && window->begin <= split_position) {
+                    bool const fits_before = window->begin > lowest;
+                    bool const fits_behind = window->end <= highest;
+                    if (fits_before && (!fits_behind || split_position + 1 - window->begin <= window->end - split_position))
+                        split_position = window->begin - 1;
+                    else if (fits_behind)
+                        split_position = window->end;
+                    else
+                        return std::nullopt;
+                }
+
+                chunk_task upper_task{.begin = split_position, .end = task.end};
+                task.end = split_position;
+                return upper_task;
+            };
+
+            using tree_t = partial_tree<std::remove_cvref_t<decltype(rcs_store)>>;
+            using tree_size_t = typename tree_t::size_type;
+            work_stealing_scheduler{_thread_count}(std::move(initial_tasks), split_fn,
+                                                   [&] (std::size_t const worker_id, chunk_task & task) {
+                auto const & local_store = local_forest(forest, worker_id).data();
+                task_fn(worker_id, task.begin, task.end, tree_t{local_store,
+                                                                static_cast<tree_size_t>(task.begin),
+                                                                static_cast<tree_size_t>(task.end - task.begin)});
+            });
+        }
+
+        // Returns the window size of the pattern, or 0 if it has none, e.g. for the tree adaptors traversed by
+        // libjst::parallel_stats, whose chunks are split without regard to the indels.
+        template <typename pattern_t>
+        static constexpr std::size_t split_window_size(pattern_t const & pattern) {
+            if constexpr (requires { libjst::window_size(pattern); })
+                return libjst::window_size(pattern);
+            else
+                return 0;
+        }
+
+        /*!\brief Returns the source intervals in which no task is split, in ascending order.
+         *
+         * \details
+         *
+         * These are the positions from which a window of the given size reaches an indel, up to the last position
+         * of the window behind it. Overlapping intervals are merged. Without a window, i.e. for a window size of 0,
+         * no interval is returned.
+         */
+        template <typename rcs_store_t>
+        static std::vector<chunk_task> indel_windows(rcs_store_t const & rcs_store, std::size_t const window_size) {
+            std::vector<chunk_task> windows{};
+            if (window_size == 0)
+                return windows;
+
+            std::size_t const trimmed_window = window_size - 1;
+            for (auto && breakend : libjst::interior_breakends(rcs_store.variants())) {
+                if (breakend.get_breakpoint_end() != breakpoint_end::low || libjst::effective_size(breakend) == 0)
+                    continue;
+
+                auto const breakpoint = libjst::get_breakpoint(breakend);
+                std::size_t const low = static_cast<std::size_t>(libjst::low_breakend(breakpoint));
+                chunk_task const window{.begin = low - std::min(low, trimmed_window),
+                                        .end = static_cast<std::size_t>(libjst::high_breakend(breakpoint)) +
+                                               trimmed_window};
+                if (!windows.empty() && window.begin <= windows.back().end)
+                    windows.back().end = std::max(windows.back().end, window.end);
+                else
+                    windows.push_back(window);
+            }
+            return windows;
+        }
+
+        template <typename chunk_fn_t>
+        static void execute(std::size_t const worker_count, std::size_t const chunk_count, chunk_fn_t && chunk_fn) {
+            std::atomic<std::size_t> next_chunk{0};
+            std::atomic<bool> cancelled{false};
+            std::exception_ptr first_error{};
+            std::mutex error_mutex{};
+
+            auto work = [&] (std::size_t const worker_id) {
+                try {
+                    for (std::size_t chunk_idx = next_chunk.fetch_add(1, std::memory_order_relaxed);
+                         chunk_idx < chunk_count && !cancelled.load(std::memory_order_relaxed);
+                         chunk_idx = next_chunk.fetch_add(1, std::memory_order_relaxed)) {
+                        chunk_fn(worker_id, chunk_idx);
+                    }
+                } catch (...) {
+                    cancelled.store(true, std::memory_order_relaxed);
+                    std::scoped_lock error_lock{error_mutex};
+                    if (!first_error)
+                        first_error = std::current_exception();
+                }
+            };
+
+            std::vector<std::thread> workers{};
+            workers.reserve(worker_count - 1);
+            for (std::size_t worker_id = 1; worker_id < worker_count; ++worker_id)
+                workers.emplace_back(work, worker_id);
+
+            work(0); // the calling thread participates in the work.
+            std::ranges::for_each(workers, [] (std::thread & worker) { worker.join(); });
+
+            if (first_error)
+                std::rethrow_exception(first_error);
+        }
+    };
+
+    template <std::integral thread_count_t>
+    parallel_chunk_traverser(thread_count_t) -> parallel_chunk_traverser<>;
+
+    template <std::integral thread_count_t, std::integral min_split_size_t>
+    parallel_chunk_traverser(thread_count_t, min_split_size_t) -> parallel_chunk_traverser<>;
+}  // namespace libjst
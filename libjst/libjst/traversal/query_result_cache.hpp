@@ -0,0 +1,254 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::query_result_cache to answer repeated queries without traversing the tree again.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <memory>
+#include <ranges>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace libjst
+{
+    /*!\brief Identifies the result of a query in a libjst::query_result_cache.
+     *
+     * \details
+     *
+     * The parameters of the matcher, e.g. the error count, and the searched subset of samples enter the key as
+     * fingerprints computed by libjst::query_cache_key::fingerprint. The pattern is stored as a copy, such that a
+     * collision of the hashes never returns the hits of another pattern.
+     */
+    struct query_cache_key {
+        uint64_t epoch{}; //!< The version of the searched store, e.g. libjst::store_snapshot::epoch.
+        std::string pattern{}; //!< The searched pattern.
+        uint64_t parameters{}; //!< The fingerprint of the matcher parameters.
+        uint64_t samples{}; //!< The fingerprint of the searched samples; 0 for all samples.
+
+        //!\brief Returns a fingerprint of the given values, e.g. the matcher parameters or the ids of the samples.
+        template <std::ranges::input_range values_t>
+            requires std::integral<std::ranges::range_value_t<values_t>>
+        static constexpr uint64_t fingerprint(values_t && values) noexcept {
+            uint64_t hash{0xcbf29ce484222325ull}; // FNV-1a over the 64 bit values.
+            for (auto && value : values)
+                hash = (hash ^ static_cast<uint64_t>(value)) * 0x100000001b3ull;
+            return hash;
+        }
+
+        constexpr friend bool operator==(query_cache_key const &, query_cache_key const &) noexcept = default;
+    };
+
+    /*!\brief A cache of the hit lists of recent queries, evicting the least recently used ones beyond a memory budget.
+     *
+     * \tparam hit_t The type of the cached hits, e.g. a compact seek position with the haplotype of the hit.
+     *
+     * \details
+     *
+     * A service answering the same queries over and over, e.g. common guides or the primers of a panel, looks up
+     * the hits of a query before it traverses the tree, see fetch. Every cached hit list is accounted with the size
+     * of its hits and its pattern against the memory budget; when an insertion exceeds the budget, the least recently
+     * used hit lists are evicted until it fits, and a hit list exceeding the entire budget is not cached at all.
+     * The hit lists are shared with the callers, such that an evicted list remains valid while a caller holds it.
+     *
+     * The cache follows the epoch of the searched store: a key of a newer epoch invalidates all hit lists of the older
+     * epochs, such that hits of an outdated version of a libjst::versioned_store are never returned, and a key of an
+     * older epoch is neither answered nor cached. Like a libjst::search_session, the cache must only be used by one
+     * thread at a time; a service keeps one cache per session, next to libjst::thread_search_session.
+     */
+    template <typename hit_t>
+    class query_result_cache {
+    public:
+
+        using hit_list_type = std::vector<hit_t>;
+        using hit_list_pointer = std::shared_ptr<hit_list_type const>;
+
+    private:
+
+        struct key_hash {
+            std::size_t operator()(query_cache_key const & key) const noexcept {
+                std::size_t hash = std::hash<std::string>{}(key.pattern);
+                for (uint64_t const value : {key.epoch, key.parameters, key.samples})
+                    hash ^= std::hash<uint64_t>{}(value) + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+                return hash;
+            }
+        };
+
+        struct entry {
+            query_cache_key key;
+            hit_list_pointer hits;
+            std::size_t bytes;
+        };
+
+        using lru_list_type = std::list<entry>; // the most recently used entry first.
+
+        lru_list_type _entries{};
+        std::unordered_map<query_cache_key, typename lru_list_type::iterator, key_hash> _lookup{};
+        std::size_t _memory_budget{};
+        std::size_t _memory_usage{};
+        uint64_t _epoch{};
+        std::size_t _hit_count{};
+        std::size_t _miss_count{};
+        std::size_t _eviction_count{};
+
+    public:
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        query_result_cache() = default; //!< Default; caches nothing.
+
+        //!\brief Constructs an empty cache holding hit lists of at most the given number of bytes.
+        explicit query_result_cache(std::size_t const memory_budget) noexcept : _memory_budget{memory_budget}
+        {}
+        //!\}
+
+        /*!\brief Returns the cached hits of the query, or `nullptr` if they are not cached.
+         *
+         * \details
+         *
+         * A found hit list becomes the most recently used one.
+         */
+        hit_list_pointer find(query_cache_key const & key) {
+            advance_epoch(key.epoch);
+            if (auto it = _lookup.find(key); it != _lookup.end()) {
+                ++_hit_count;
+                _entries.splice(_entries.begin(), _entries, it->second);
+                return it->second->hits;
+            }
+            ++_miss_count;
+            return nullptr;
+        }
+
+        /*!\brief Caches the hits of the query as the most recently used hit list.
+         *
+         * \returns The cached hits, which are also returned if they could not be cached.
+         *
+         * \details
+         *
+         * The hits replace the cached hits of the same query, and are not cached if the key belongs to an older epoch
+         * than the cache or if they exceed the memory budget.
+         */
+        hit_list_pointer insert(query_cache_key key, hit_list_type hits) {
+            auto cached = std::make_shared<hit_list_type const>(std::move(hits));
+            advance_epoch(key.epoch);
+            if (key.epoch < _epoch)
+                return cached;
+
+            erase(key);
+            std::size_t const bytes = entry_bytes(key, *cached);
+            if (bytes > _memory_budget)
+                return cached;
+
+            while (_memory_usage + bytes > _memory_budget) {
+                ++_eviction_count;
+                erase(_entries.back().key);
+            }
+            _entries.push_front(entry{std::move(key), cached, bytes});
+            _lookup.emplace(_entries.front().key, _entries.begin());
+            _memory_usage += bytes;
+            return cached;
+        }
+
+        /*!\brief Returns the cached hits of the query, or searches and caches them.
+         *
+         * \param[in] key The key of the query.
+         * \param[in] search Invoked without arguments on a miss to return the hits as `hit_list_type`, e.g. by
+         *                   running the traversal in a libjst::search_session.
+         */
+        template <std::invocable search_t>
+            requires std::convertible_to<std::invoke_result_t<search_t>, hit_list_type>
+        hit_list_pointer fetch(query_cache_key const & key, search_t && search) {
+            if (hit_list_pointer cached = find(key); cached != nullptr)
+                return cached;
+            return insert(key, std::invoke((search_t &&) search));
+        }
+
+        //!\brief Removes all cached hit lists of epochs before the given one, which becomes the epoch of the cache.
+        void advance_epoch(uint64_t const epoch) {
+            if (epoch <= _epoch)
+                return;
+
+            _epoch = epoch;
+            for (auto it = _entries.begin(); it != _entries.end();) {
+                auto next = std::ranges::next(it);
+                if (it->key.epoch < epoch)
+                    erase(it->key);
+                it = next;
+            }
+        }
+
+        //!\brief Removes all cached hit lists.
+        void clear() noexcept {
+            _lookup.clear();
+            _entries.clear();
+            _memory_usage = 0;
+        }
+
+        //!\brief Returns the number of cached hit lists.
+        std::size_t size() const noexcept {
+            return _entries.size();
+        }
+
+        //!\brief Returns the bytes accounted for the cached hit lists.
+        std::size_t memory_usage() const noexcept {
+            return _memory_usage;
+        }
+
+        std::size_t memory_budget() const noexcept {
+            return _memory_budget;
+        }
+
+        //!\brief Returns the latest epoch seen by the cache.
+        uint64_t epoch() const noexcept {
+            return _epoch;
+        }
+
+        //!\brief Returns the number of queries answered by the cache so far.
+        std::size_t hit_count() const noexcept {
+            return _hit_count;
+        }
+
+        //!\brief Returns the number of queries not answered by the cache so far.
+        std::size_t miss_count() const noexcept {
+            return _miss_count;
+        }
+
+        //!\brief Returns the number of hit lists evicted to fit the memory budget so far.
+        std::size_t eviction_count() const noexcept {
+            return _eviction_count;
+        }
+
+    private:
+
+        void erase(query_cache_key const & key) {
+            if (auto it = _lookup.find(key); it != _lookup.end()) {
+                auto entry_it = it->second;
+                _lookup.erase(it);
+                _memory_usage -= entry_it->bytes;
+                _entries.erase(entry_it);
+            }
+        }
+
+        static std::size_t entry_bytes(query_cache_key const & key, hit_list_type const & hits) noexcept {
+            // The pattern is held by the entry and by the lookup table.
+            return sizeof(entry) + 2 * key.pattern.size() + hits.size() * sizeof(hit_t);
+        }
+    };
+}  // namespace libjst
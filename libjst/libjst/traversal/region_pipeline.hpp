@@ -0,0 +1,177 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::region_pipeline to load the next region of a store while the current one is traversed.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ranges>
+#include <thread>
+#include <type_traits>
+#include <utility>
+
+namespace libjst
+{
+    /*!\brief Loads the regions of a disk resident store ahead while the loaded regions are processed.
+     *
+     * \details
+     *
+     * Searching a store region by region, e.g. with libjst::load_region or libjst::load_block_compressed_region,
+     * alternates between reading a region from disk and traversing it. The pipeline overlaps both: a loader thread
+     * loads the next regions while the calling thread processes the loaded ones in the order of the regions. The
+     * number of loaded regions that are alive at the same time is bounded by the buffer count, which includes the
+     * region being processed; the default of two buffers loads region `i + 1` while region `i` is processed. The
+     * loader reads the pages of a memory mapped layout on its own thread, such that their page faults and the reads
+     * from a cold page cache or a network file system are hidden behind the traversal of the preceding region.
+     *
+     * The loaded regions are never moved, since stores like libjst::rcs_store must stay at the address they were
+     * constructed at. The regions are iterated by both threads and must hence be a forward range that can be iterated
+     * concurrently, e.g. a `std::vector`.
+     *
+     * With a single buffer the regions are loaded and processed one after another on the calling thread.
+     * If the loader or the processing throws, no further regions are loaded and the first exception is rethrown on
+     * the calling thread after the loader has joined; the regions loaded so far are processed before a load error is
+     * rethrown.
+     */
+    class region_pipeline {
+    private:
+
+        //!\brief Holds a loaded region, which is constructed in place from the result of the load function.
+        template <typename loaded_t>
+        struct loaded_region {
+            loaded_t value;
+
+            template <typename load_fn_t, typename region_t>
+            loaded_region(load_fn_t & load_fn, region_t && region) :
+                value{std::invoke(load_fn, (region_t &&) region)}
+            {}
+        };
+
+        std::size_t _buffer_count{2};
+
+    public:
+
+        /*!\name Constructors, destructor, and assignment
+         * \{
+         */
+        constexpr region_pipeline() = default; //!< Default.
+
+        //!\brief Bounds the number of loaded regions alive at the same time; at least one.
+        constexpr explicit region_pipeline(std::size_t const buffer_count) noexcept :
+            _buffer_count{std::max<std::size_t>(buffer_count, 1)}
+        {}
+        //!\}
+
+        constexpr std::size_t buffer_count() const noexcept {
+            return _buffer_count;
+        }
+
+        /*!\brief Loads and processes all regions.
+         *
+         * \param[in] regions The regions to load, e.g. the source intervals of a libjst::shard_planner.
+         * \param[in] load_fn Invoked as `load_fn(region)` on the loader thread; returns the loaded region.
+         * \param[in] process_fn Invoked as `process_fn(region, loaded)` with the loaded region as lvalue on the calling
+         *                       thread in the order of the regions; the loaded region is destroyed afterwards.
+         */
+        template <std::ranges::forward_range regions_t, typename load_fn_t, typename process_fn_t>
+            requires std::invocable<load_fn_t &, std::ranges::range_reference_t<regions_t>>
+        void operator()(regions_t && regions, load_fn_t && load_fn, process_fn_t && process_fn) const {
+            using loaded_t = std::remove_cvref_t<std::invoke_result_t<load_fn_t &,
+                                                                      std::ranges::range_reference_t<regions_t>>>;
+            using loaded_ptr_t = std::unique_ptr<loaded_region<loaded_t>>;
+
+            if (_buffer_count == 1) {
+                for (auto && region : regions) {
+                    loaded_region<loaded_t> loaded{load_fn, region};
+                    std::invoke(process_fn, region, loaded.value);
+                }
+                return;
+            }
+
+            std::mutex mutex{};
+            std::condition_variable loaded_condition{}; // signalled by the loader after a region was loaded.
+            std::condition_variable released_condition{}; // signalled by the caller after a region was processed.
+            std::deque<loaded_ptr_t> loaded_regions{};
+            std::size_t alive_count{}; // the loaded regions that were not yet destroyed.
+            bool loader_done{false};
+            bool cancelled{false};
+            std::exception_ptr load_error{};
+
+            std::thread loader{[&] () {
+                try {
+                    for (auto && region : regions) {
+                        {
+                            std::unique_lock lock{mutex};
+                            released_condition.wait(lock, [&] { return cancelled || alive_count < _buffer_count; });
+                            if (cancelled)
+                                break;
+                            ++alive_count;
+                        }
+
+                        loaded_ptr_t loaded = std::make_unique<loaded_region<loaded_t>>(load_fn, region);
+                        std::scoped_lock lock{mutex};
+                        loaded_regions.push_back(std::move(loaded));
+                        loaded_condition.notify_one();
+                    }
+                } catch (...) {
+                    std::scoped_lock lock{mutex};
+                    load_error = std::current_exception();
+                }
+                std::scoped_lock lock{mutex};
+                loader_done = true;
+                loaded_condition.notify_one();
+            }};
+
+            auto release = [&] () {
+                std::scoped_lock lock{mutex};
+                --alive_count;
+                released_condition.notify_one();
+            };
+
+            std::exception_ptr process_error{};
+            try {
+                for (auto && region : regions) {
+                    loaded_ptr_t loaded{};
+                    {
+                        std::unique_lock lock{mutex};
+                        loaded_condition.wait(lock, [&] { return !loaded_regions.empty() || loader_done; });
+                        if (loaded_regions.empty())
+                            break; // the loader failed before this region.
+                        loaded = std::move(loaded_regions.front());
+                        loaded_regions.pop_front();
+                    }
+
+                    std::invoke(process_fn, region, loaded->value);
+                    loaded.reset();
+                    release();
+                }
+            } catch (...) {
+                process_error = std::current_exception();
+                std::scoped_lock lock{mutex};
+                cancelled = true;
+                released_condition.notify_one();
+            }
+            loader.join();
+
+            if (process_error)
+                std::rethrow_exception(process_error);
+            if (load_error)
+                std::rethrow_exception(load_error);
+        }
+    };
+}  // namespace libjst
@@ -0,0 +1,179 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::search_session to run many queries without allocating their buffers anew.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <type_traits>
+#include <utility>
+
+#include <libjst/traversal/stack_publisher.hpp>
+#include <libjst/traversal/state_oblivious_traverser.hpp>
+#include <libjst/utility/arena_allocator.hpp>
+
+namespace libjst
+{
+    /*!\brief Runs successive queries on one thread in an arena that keeps its memory between the queries.
+     *
+     * \details
+     *
+     * Every traverser rebuilds its adaptor pipeline per query, and with it the branch stack, the label buffers, the
+     * path coverages and the stack of the captured matcher states. All of them are allocated by a
+     * libjst::arena_allocator, which during a query of the session allocates from the pool of the session instead of
+     * the global heap. The pool recycles the freed blocks and keeps them after the query, such that once the pool
+     * has grown to the peak memory of the queries, short queries do not allocate at all and their latency is not
+     * dominated by the setup of the traversal. The memory is only returned by release or when the session is
+     * destroyed.
+     *
+     * A session must only be used by one thread at a time, and the queries of one session must not be nested. A
+     * service runs one session per worker thread, e.g. the one returned by libjst::thread_search_session. The
+     * callback must not keep a copy of a label, or anything else allocated by a libjst::arena_allocator, beyond the
+     * query. Note that the coverages of the store are only copied into the pool if their allocator is a
+     * libjst::arena_allocator, e.g. `bit_coverage<uint32_t, arena_allocator<uint64_t>>`.
+     */
+    class search_session {
+    private:
+
+        //!\brief Forwards to the global heap and counts the allocations the pool could not serve.
+        class upstream_resource : public std::pmr::memory_resource {
+        public:
+            std::size_t allocation_count{};
+            std::size_t allocated_bytes{};
+
+        private:
+            void * do_allocate(std::size_t const bytes, std::size_t const alignment) override {
+                ++allocation_count;
+                allocated_bytes += bytes;
+                return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+            }
+
+            void do_deallocate(void * pointer, std::size_t const bytes, std::size_t const alignment) override {
+                allocated_bytes -= bytes;
+                std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+            }
+
+            bool do_is_equal(std::pmr::memory_resource const & other) const noexcept override {
+                return this == &other;
+            }
+        };
+
+        std::unique_ptr<upstream_resource> _upstream{std::make_unique<upstream_resource>()};
+        std::unique_ptr<std::pmr::unsynchronized_pool_resource> _pool{};
+        std::size_t _query_count{};
+        bool _in_query{false};
+
+    public:
+
+        //!\brief The largest block served from the pool; larger blocks, e.g. huge coverages, use the global heap.
+        static constexpr std::size_t largest_pooled_block{std::size_t{1} << 20};
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        //!\brief Creates a session with an empty pool.
+        search_session() :
+            _pool{std::make_unique<std::pmr::unsynchronized_pool_resource>(
+                std::pmr::pool_options{.max_blocks_per_chunk = 0, .largest_required_pool_block = largest_pooled_block},
+                _upstream.get())}
+        {}
+
+        search_session(search_session const &) = delete; //!< Deleted.
+        search_session(search_session &&) noexcept = default; //!< Defaulted.
+        search_session & operator=(search_session const &) = delete; //!< Deleted.
+        search_session & operator=(search_session &&) noexcept = default; //!< Defaulted.
+        ~search_session() = default; //!< Defaulted.
+        //!\}
+
+        /*!\brief Searches the pattern in the tree with the given traverser.
+         *
+         * \param[in] traverser The traverser to apply, e.g. libjst::state_capture_traverser.
+         * \param[in] tree The tree to search.
+         * \param[in] pattern The matcher to search.
+         * \param[in] callback The callback invoked with every hit.
+         * \param[in] subscribers Further subscribers of the traversal, see libjst::observable_stack.
+         */
+        template <typename traverser_t, typename tree_t, typename pattern_t, typename callback_t,
+                  observable_stack ...subscriber_ts>
+        void operator()(traverser_t && traverser,
+                        tree_t && tree,
+                        pattern_t && pattern,
+                        callback_t && callback,
+                        subscriber_ts & ...subscribers) {
+            run([&] {
+                std::invoke((traverser_t &&) traverser, (tree_t &&) tree, (pattern_t &&) pattern,
+                            (callback_t &&) callback, subscribers...);
+            });
+        }
+
+        //!\brief Searches the pattern in the tree with the libjst::state_oblivious_traverser.
+        template <typename tree_t, typename pattern_t, typename callback_t>
+            requires std::invocable<state_oblivious_traverser const &, tree_t, pattern_t, callback_t>
+        void operator()(tree_t && tree, pattern_t && pattern, callback_t && callback) {
+            (*this)(state_oblivious_traverser{}, (tree_t &&) tree, (pattern_t &&) pattern, (callback_t &&) callback);
+        }
+
+        /*!\brief Invokes the query with the pool of the session as the arena of the calling thread.
+         *
+         * \param[in] query The query to run, e.g. a custom traversal, invoked without arguments.
+         * \returns The result of the query.
+         */
+        template <std::invocable query_t>
+        decltype(auto) run(query_t && query) {
+            assert(!_in_query); // the queries of a session must not be nested.
+            _in_query = true;
+            ++_query_count;
+            struct query_guard {
+                bool & in_query;
+                ~query_guard() { in_query = false; }
+            } guard{_in_query};
+            detail::arena_guard arena{_pool.get()};
+            return std::invoke((query_t &&) query);
+        }
+
+        //!\brief Returns the number of queries run so far.
+        std::size_t query_count() const noexcept {
+            return _query_count;
+        }
+
+        //!\brief Returns the number of allocations the pool made from the global heap so far.
+        std::size_t upstream_allocation_count() const noexcept {
+            return _upstream->allocation_count;
+        }
+
+        //!\brief Returns the bytes the pool currently holds from the global heap.
+        std::size_t upstream_bytes() const noexcept {
+            return _upstream->allocated_bytes;
+        }
+
+        //!\brief Returns all memory of the pool to the global heap; must not be called during a query.
+        void release() {
+            assert(!_in_query);
+            _pool->release();
+        }
+    };
+
+    /*!\brief Returns the libjst::search_session of the calling thread.
+     *
+     * \details
+     *
+     * The session lives as long as its thread, such that every thread of a service keeps its buffers between the
+     * queries it runs.
+     */
+    inline search_session & thread_search_session() {
+        thread_local search_session session{};
+        return session;
+    }
+}  // namespace libjst
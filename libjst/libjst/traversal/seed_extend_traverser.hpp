@@ -0,0 +1,166 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides jst traversal verifying seed hits by extending them from their seek positions.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <ranges>
+#include <span>
+#include <vector>
+
+#include <libjst/matcher/concept.hpp>
+#include <libjst/sequence_tree/coloured_tree.hpp>
+#include <libjst/sequence_tree/concept.hpp>
+#include <libjst/sequence_tree/labelled_tree.hpp>
+#include <libjst/sequence_tree/merge_tree.hpp>
+#include <libjst/sequence_tree/prune_unsupported.hpp>
+#include <libjst/sequence_tree/seek_position.hpp>
+#include <libjst/sequence_tree/seekable_tree.hpp>
+#include <libjst/sequence_tree/trim_tree.hpp>
+
+namespace libjst
+{
+    //!\brief A seed hit to be extended, given by the node of the seekable tree and the offset within its label.
+    struct seed_candidate {
+        seek_position position{}; //!< The seek position of the node containing the first symbol of the extension.
+        std::size_t offset{}; //!< The offset of the first symbol of the extension within the label of the node.
+    };
+
+    /*!\brief Verifies seed hits by searching the pattern from their positions instead of traversing the whole tree.
+     *
+     * \details
+     *
+     * Every candidate is resumed from its node in the seekable tree returned by
+     * libjst::seed_extend_traverser::search_tree: the pattern is shown the symbols beginning at the offset of the
+     * candidate and continues into the children of the node, each branch from the state captured at the end of its
+     * parent, until the window of the pattern has been consumed. Hence, an exact matcher anchored at the candidate
+     * reports a hit if the pattern is spelled by one of the branches following the seed. The callback is invoked with
+     * the index of the candidate, the iterator to the last symbol of the hit and the label containing it, whose
+     * coverage gives the haplotypes of the branch.
+     *
+     * The candidates are processed in the order of their seek positions, i.e. sorted by the variant index, and
+     * in batches of libjst::seed_extend_traverser::batch_size: all nodes of a batch are sought before they are
+     * extended, such that consecutive seeks and extensions touch neighbouring variants.
+     *
+     * The extension to the left runs the same traversal on the tree of a libjst::rcs_store_reversed with the reversed
+     * prefix of the query, where the candidates refer to the seek positions of the reversed tree. Within the forward
+     * tree, the left context of a node is the one of its path and does not branch into the preceding variants.
+     */
+    struct seed_extend_traverser {
+
+        std::size_t batch_size{256}; //!< The number of candidates sought before they are extended.
+
+        //!\brief Returns the seekable tree the candidates of a pattern with the given window size refer to.
+        template <typename tree_t>
+        static constexpr auto search_tree(tree_t && tree, std::size_t const window_size) {
+            return tree | libjst::labelled()
+                        | libjst::coloured()
+                        | trim(std::max<std::size_t>(window_size, 1) - 1)
+                        | prune_unsupported()
+                        | merge() // make big nodes
+                        | libjst::seek();
+        }
+
+        template <typename tree_t, typename pattern_t, typename callback_t>
+            requires state_capturing_matcher<std::remove_cvref_t<pattern_t>>
+        constexpr void operator()(tree_t && tree,
+                                  std::span<seed_candidate const> candidates,
+                                  pattern_t && pattern,
+                                  callback_t && callback) const {
+            std::size_t const window = libjst::window_size(pattern);
+            if (window == 0 || candidates.empty())
+                return;
+
+            auto seekable = search_tree((tree_t &&)tree, window);
+            using node_t = libjst::tree_node_t<decltype(seekable)>;
+            using state_t = matcher_state_t<std::remove_cvref_t<pattern_t>>;
+
+            std::vector<std::size_t> order(candidates.size());
+            std::iota(order.begin(), order.end(), 0);
+            std::ranges::stable_sort(order, [&] (std::size_t const lhs, std::size_t const rhs) {
+                return candidates[lhs].position < candidates[rhs].position;
+            });
+
+            state_t const initial_state = pattern.capture();
+            std::size_t const batch = std::max<std::size_t>(batch_size, 1);
+            std::vector<node_t> nodes{};
+            nodes.reserve(std::min(batch, order.size()));
+            for (std::size_t batch_begin = 0; batch_begin < order.size(); batch_begin += batch) {
+                std::size_t const count = std::min(batch, order.size() - batch_begin);
+                auto const batch_order = std::span<std::size_t const>{order}.subspan(batch_begin, count);
+                nodes.clear();
+                for (std::size_t const index : batch_order)
+                    nodes.push_back(seekable.seek(candidates[index].position));
+
+                for (std::size_t i = 0; i < batch_order.size(); ++i) {
+                    std::size_t const index = batch_order[i];
+                    pattern.restore(initial_state);
+                    extend(std::move(nodes[i]), candidates[index].offset, window, pattern, [&] (auto && label_it,
+                                                                                               auto && label) {
+                        callback(index, std::move(label_it), label);
+                    });
+                }
+            }
+            pattern.restore(initial_state);
+        }
+
+    private:
+
+        // Searches at most window symbols beginning at the offset of the node along every branch of its subtree.
+        template <typename node_t, typename pattern_t, typename callback_t>
+        static constexpr void extend(node_t && seed_node,
+                                     std::size_t const offset,
+                                     std::size_t const window,
+                                     pattern_t & pattern,
+                                     callback_t && callback) {
+            using state_t = matcher_state_t<std::remove_cvref_t<pattern_t>>;
+
+            struct branch {
+                std::remove_cvref_t<node_t> node;
+                state_t state;
+                std::size_t offset;
+                std::size_t remaining;
+            };
+
+            std::vector<branch> branches{};
+            branches.push_back(branch{(node_t &&)seed_node, pattern.capture(), offset, window});
+            while (!branches.empty()) {
+                branch current = std::move(branches.back());
+                branches.pop_back();
+
+                auto label = *current.node;
+                auto && sequence = label.sequence();
+                auto const sequence_end = std::ranges::end(sequence);
+                auto const first = std::ranges::next(std::ranges::begin(sequence), current.offset, sequence_end);
+                auto const last = std::ranges::next(first, current.remaining, sequence_end);
+
+                pattern.restore(std::move(current.state));
+                pattern(std::ranges::subrange{first, last}, [&] (auto && label_it) {
+                    callback(std::move(label_it), label);
+                });
+
+                std::size_t const consumed = static_cast<std::size_t>(std::ranges::distance(first, last));
+                if (consumed == current.remaining)
+                    continue;
+
+                state_t state = pattern.capture();
+                std::size_t const remaining = current.remaining - consumed;
+                if (auto ref_child = current.node.next_ref(); ref_child)
+                    branches.push_back(branch{std::move(*ref_child), state, 0, remaining});
+                if (auto alt_child = current.node.next_alt(); alt_child)
+                    branches.push_back(branch{std::move(*alt_child), std::move(state), 0, remaining});
+            }
+        }
+    };
+}  // namespace libjst
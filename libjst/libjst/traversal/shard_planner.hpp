@@ -0,0 +1,495 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::shard_planner.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <libjst/coverage/concept.hpp>
+#include <libjst/sequence_tree/partial_tree.hpp>
+#include <libjst/sequence_tree/stats.hpp>
+#include <libjst/traversal/chunk_profile.hpp>
+#include <libjst/variant/concept.hpp>
+
+namespace libjst
+{
+    /*!\brief A source interval of a libjst::shard_planner, from which every node of a cluster builds its partial tree.
+     *
+     * \details
+     *
+     * The shard reports the hits beginning in `[begin, end)`. Its partial tree extends beyond the end by the overlap,
+     * such that hits spanning the boundary to the next shard are found as well. The shard is serialisable with cereal.
+     */
+    struct tree_shard {
+        std::size_t begin{}; //!< The first source position of the shard.
+        std::size_t end{}; //!< The source position behind the last one of the shard.
+        std::size_t overlap{}; //!< The number of source positions the partial tree extends beyond the end.
+        double cost{}; //!< The estimated work of the shard.
+
+        //!\brief Returns the partial tree over the shard.
+        template <typename rcs_store_t>
+        partial_tree<rcs_store_t> make_tree(rcs_store_t const & rcs_store) const noexcept {
+            using size_type = typename partial_tree<rcs_store_t>::size_type;
+            return partial_tree<rcs_store_t>{rcs_store,
+                                             static_cast<size_type>(begin),
+                                             static_cast<size_type>(end - begin + overlap)};
+        }
+
+        template <typename archive_t>
+        void serialize(archive_t & archive)
+        {
+            archive(begin, end, overlap, cost);
+        }
+
+        friend constexpr bool operator==(tree_shard const &, tree_shard const &) noexcept = default;
+    };
+
+    /*!\brief Splits the source of a sequence tree into shards of balanced work for a distributed search.
+     *
+     * \details
+     *
+     * Unlike libjst::chunked_tree_impl, which splits the source into chunks of equal length, the planner estimates the
+     * work of every source interval from the variants of the store. Every reference position costs one symbol. Every
+     * variant costs the symbols of its alternate subtree: its alternate sequence, the trimmed window behind it and the
+     * left extension of the alternate node, plus the left extension of the reference node behind the variant. The
+     * subtrees of the variants beginning within the window that share a haplotype with the variant are nested into
+     * its subtree, weighted by the part of the window that remains for them. The planner then cuts the source at the
+     * positions where the accumulated cost crosses equal shares of the total cost.
+     *
+     * The estimate can be calibrated with the libjst::tree_stats of a previous run of the same pattern width over the
+     * whole tree: the estimated variant costs are then scaled such that the estimated total matches the measured
+     * symbol count, which accounts for the branches that are pruned or merged in the actual traversal.
+     *
+     * A libjst::chunk_profile recorded by a previous run, see libjst::parallel_chunk_traverser::set_profile, calibrates
+     * the estimate per region instead: the measured cost of every profiled chunk is converted into symbols, and the
+     * estimated variant costs within the chunk are scaled such that the chunk costs as many symbols as measured. The
+     * profile thereby captures the costs the estimate cannot foresee, e.g. the hits of a pattern or the wall time of
+     * regions with deep subtrees, while the estimate still places the cuts within the chunks.
+     *
+     * A variant is never split between two shards, hence a single variant whose cost exceeds the share of a shard
+     * can produce fewer shards than requested; empty shards are omitted.
+     *
+     * Instead of a fixed number of shards, tune chooses the number for a given thread count, see tune. The tuned
+     * shards are searched in parallel by handing a libjst::shard_forest to the libjst::parallel_chunk_traverser.
+     */
+    class shard_planner {
+    private:
+
+        //!\brief The accumulated cost of the variants beginning at a source position.
+        struct variant_cost {
+            std::size_t position{};
+            double cost{};
+        };
+
+        std::size_t _window_size{};
+
+    public:
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        shard_planner() = delete; //!< Deleted.
+
+        //!\brief Plans the shards for patterns of the given window size.
+        explicit shard_planner(std::size_t const window_size) noexcept : _window_size{window_size}
+        {}
+        //!\}
+
+        //!\brief Returns the given number of shards of balanced estimated work.
+        template <typename rcs_store_t>
+        std::vector<tree_shard> operator()(rcs_store_t const & rcs_store, std::size_t const shard_count) const {
+            return plan(rcs_store, shard_count, estimate(rcs_store));
+        }
+
+        //!\brief Returns the given number of shards, whose estimated work is calibrated with the measured statistics.
+        template <typename rcs_store_t>
+        std::vector<tree_shard> operator()(rcs_store_t const & rcs_store,
+                                           std::size_t const shard_count,
+                                           tree_stats const & stats) const {
+            return plan(rcs_store, shard_count, calibrate(rcs_store, estimate(rcs_store), stats));
+        }
+
+        /*!\brief Returns the given number of shards, whose work is balanced by the costs of a previous run.
+         *
+         * \param[in] rcs_store The store to split.
+         * \param[in] shard_count The number of shards.
+         * \param[in] profile The costs of the chunks of a previous run over the same store; the chunks must be source
+         *                    intervals.
+         * \param[in] metric The measured cost that is balanced; defaults to the wall time.
+         */
+        template <typename rcs_store_t>
+        std::vector<tree_shard> operator()(rcs_store_t const & rcs_store,
+                                           std::size_t const shard_count,
+                                           chunk_profile const & profile,
+                                           chunk_metric const metric = chunk_metric::wall_time) const {
+            return plan(rcs_store, shard_count, calibrate(rcs_store, estimate(rcs_store), profile, metric));
+        }
+
+        /*!\brief Returns shards of balanced estimated work, whose number is tuned for the given thread count.
+         *
+         * \details
+         *
+         * Every shard adds the work of its boundary to the search: the first node of its partial tree is left extended
+         * by the trimmed window and its root is visited in addition. More shards hence increase the total work, while
+         * fewer shards leave threads idle when the last shards are searched. With `S` shards of equal work on `T`
+         * threads, a total work of `W` symbols and a boundary work of `w` symbols, i.e. the window size, the search
+         * takes about `(W + S * w) / T + W / S`, which is minimal for `S = sqrt(W * T / w)`. The count is at least
+         * the thread count and at most the number of shards that are not shorter than the window.
+         * The shards have variable length, since their work is balanced by the variant density.
+         */
+        template <typename rcs_store_t>
+        std::vector<tree_shard> tune(rcs_store_t const & rcs_store, std::size_t const thread_count) const {
+            std::vector<variant_cost> variant_costs = estimate(rcs_store);
+            std::size_t const shard_count = tuned_shard_count(rcs_store, variant_costs, thread_count);
+            return plan(rcs_store, shard_count, std::move(variant_costs));
+        }
+
+        //!\brief Returns tuned shards, whose estimated work is calibrated with the measured statistics.
+        template <typename rcs_store_t>
+        std::vector<tree_shard> tune(rcs_store_t const & rcs_store,
+                                     std::size_t const thread_count,
+                                     tree_stats const & stats) const {
+            std::vector<variant_cost> variant_costs = calibrate(rcs_store, estimate(rcs_store), stats);
+            std::size_t const shard_count = tuned_shard_count(rcs_store, variant_costs, thread_count);
+            return plan(rcs_store, shard_count, std::move(variant_costs));
+        }
+
+        //!\brief Returns tuned shards, whose work is balanced by the costs of a previous run.
+        template <typename rcs_store_t>
+        std::vector<tree_shard> tune(rcs_store_t const & rcs_store,
+                                     std::size_t const thread_count,
+                                     chunk_profile const & profile,
+                                     chunk_metric const metric = chunk_metric::wall_time) const {
+            std::vector<variant_cost> variant_costs = calibrate(rcs_store, estimate(rcs_store), profile, metric);
+            std::size_t const shard_count = tuned_shard_count(rcs_store, variant_costs, thread_count);
+            return plan(rcs_store, shard_count, std::move(variant_costs));
+        }
+
+        //!\brief Returns the window size the shards are planned for.
+        constexpr std::size_t window_size() const noexcept {
+            return _window_size;
+        }
+
+    private:
+
+        constexpr std::size_t overlap_size() const noexcept {
+            return (_window_size > 0) ? _window_size - 1 : 0;
+        }
+
+        //!\brief Returns the estimated work of the whole tree.
+        template <typename rcs_store_t>
+        static double total_cost(rcs_store_t const & rcs_store, std::vector<variant_cost> const & variant_costs) {
+            double cost = static_cast<double>(std::ranges::size(rcs_store.source()));
+            std::ranges::for_each(variant_costs, [&] (variant_cost const & entry) { cost += entry.cost; });
+            return cost;
+        }
+
+        //!\brief Scales the estimated variant costs such that the estimated total matches the measured symbol count.
+        template <typename rcs_store_t>
+        static std::vector<variant_cost> calibrate(rcs_store_t const & rcs_store,
+                                                   std::vector<variant_cost> variant_costs,
+                                                   tree_stats const & stats) {
+            double const reference_cost = static_cast<double>(std::ranges::size(rcs_store.source()));
+            double const estimated_cost = total_cost(rcs_store, variant_costs) - reference_cost;
+            double const measured_cost = static_cast<double>(stats.symbol_count) - reference_cost;
+            if (estimated_cost > 0 && measured_cost > 0) {
+                double const scale = measured_cost / estimated_cost;
+                std::ranges::for_each(variant_costs, [&] (variant_cost & entry) { entry.cost *= scale; });
+            }
+            return variant_costs;
+        }
+
+        /*!\brief Scales the estimated variant costs of every profiled chunk such that it costs as measured.
+         *
+         * \details
+         *
+         * The measured costs are converted into symbols by the measured symbol count of the profile, or by the
+         * estimated cost of the profiled chunks if the profile holds no symbol counts. A chunk whose variants are
+         * estimated to cost nothing gets its measured cost beyond the reference assigned to its first position.
+         */
+        template <typename rcs_store_t>
+        static std::vector<variant_cost> calibrate(rcs_store_t const & rcs_store,
+                                                   std::vector<variant_cost> variant_costs,
+                                                   chunk_profile const & profile,
+                                                   chunk_metric const metric) {
+            std::size_t const source_size = std::ranges::size(rcs_store.source());
+            auto variants_of = [&] (chunk_cost const & chunk) {
+                auto first = std::ranges::lower_bound(variant_costs, chunk.begin, std::ranges::less{},
+                                                      &variant_cost::position);
+                auto last = std::ranges::lower_bound(first, variant_costs.end(), std::min(chunk.end, source_size),
+                                                     std::ranges::less{}, &variant_cost::position);
+                return std::ranges::subrange{first, last};
+            };
+            auto reference_cost_of = [&] (chunk_cost const & chunk) {
+                return static_cast<double>(std::min(chunk.end, source_size) - std::min(chunk.begin, source_size));
+            };
+
+            std::vector<double> estimated_costs{};
+            estimated_costs.reserve(profile.size());
+            double estimated_cost{};
+            double measured_cost{};
+            double measured_symbols{};
+            for (chunk_cost const & chunk : profile.chunks()) {
+                double variant_cost_sum{};
+                std::ranges::for_each(variants_of(chunk), [&] (variant_cost const & entry) {
+                    variant_cost_sum += entry.cost;
+                });
+                estimated_costs.push_back(variant_cost_sum);
+                estimated_cost += reference_cost_of(chunk) + variant_cost_sum;
+                measured_cost += chunk.value(metric);
+                measured_symbols += static_cast<double>(chunk.symbol_count);
+            }
+            if (measured_cost <= 0)
+                return variant_costs;
+
+            double const symbols_per_cost = ((measured_symbols > 0) ? measured_symbols : estimated_cost) /
+                                            measured_cost;
+            std::vector<variant_cost> added_costs{};
+            for (std::size_t chunk_idx = 0; chunk_idx < profile.size(); ++chunk_idx) {
+                chunk_cost const & chunk = profile.chunks()[chunk_idx];
+                if (chunk.begin >= source_size)
+                    continue;
+
+                double const target_cost = std::max(chunk.value(metric) * symbols_per_cost - reference_cost_of(chunk),
+                                                    0.0);
+                if (estimated_costs[chunk_idx] > 0) {
+                    double const scale = target_cost / estimated_costs[chunk_idx];
+                    std::ranges::for_each(variants_of(chunk), [&] (variant_cost & entry) { entry.cost *= scale; });
+                } else if (target_cost > 0) {
+                    added_costs.push_back(variant_cost{.position = chunk.begin, .cost = target_cost});
+                }
+            }
+            if (!added_costs.empty()) {
+                variant_costs.insert(variant_costs.end(), added_costs.begin(), added_costs.end());
+                std::ranges::stable_sort(variant_costs, std::ranges::less{}, &variant_cost::position);
+            }
+            return variant_costs;
+        }
+
+        template <typename rcs_store_t>
+        std::size_t tuned_shard_count(rcs_store_t const & rcs_store,
+                                      std::vector<variant_cost> const & variant_costs,
+                                      std::size_t const thread_count) const {
+            std::size_t const boundary_cost = std::max<std::size_t>(_window_size, 1);
+            std::size_t const max_shard_count = std::max<std::size_t>(std::ranges::size(rcs_store.source()) /
+                                                                      boundary_cost, 1);
+            if (thread_count <= 1)
+                return 1;
+
+            double const optimal_count = std::sqrt(total_cost(rcs_store, variant_costs) *
+                                                   static_cast<double>(thread_count) /
+                                                   static_cast<double>(boundary_cost));
+            return std::clamp<std::size_t>(static_cast<std::size_t>(std::llround(optimal_count)),
+                                           std::min(thread_count, max_shard_count),
+                                           max_shard_count);
+        }
+
+        //!\brief Returns the estimated costs of the variants, accumulated per source position in ascending order.
+        template <typename rcs_store_t>
+        std::vector<variant_cost> estimate(rcs_store_t const & rcs_store) const {
+            auto const & variants = rcs_store.variants();
+            std::size_t const trimmed_window = overlap_size();
+
+            // The first and the last breakend are the sentinels of the reference.
+            using breakend_iterator = std::ranges::iterator_t<decltype(variants)>;
+            std::vector<breakend_iterator> branches{};
+            auto last = std::ranges::prev(std::ranges::end(variants));
+            for (auto it = std::ranges::next(std::ranges::begin(variants)); it < last; ++it) {
+                if ((*it).get_breakpoint_end() == breakpoint_end::low)
+                    branches.push_back(it);
+            }
+
+            // The subtree of a variant contains the subtrees of the variants beginning within its window that share
+            // a haplotype with it, whose size shrinks with the remaining window. Each of them also splits the
+            // alternate path, whose next node is left extended.
+            auto position_of = [&] (std::size_t const idx) -> std::size_t {
+                return static_cast<std::size_t>(libjst::position(*branches[idx]));
+            };
+            std::vector<double> subtree_costs(branches.size());
+            for (std::size_t idx = branches.size(); idx > 0; --idx) {
+                std::size_t const branch = idx - 1;
+                std::size_t const position = position_of(branch);
+                double subtree_cost = static_cast<double>(std::ranges::size(libjst::alt_sequence(*branches[branch])) +
+                                                          2 * trimmed_window);
+                for (std::size_t nested = branch + 1;
+                     nested < branches.size() && position_of(nested) < position + trimmed_window;
+                     ++nested) {
+                    if (!libjst::coverage_intersects(libjst::coverage(*branches[branch]),
+                                                     libjst::coverage(*branches[nested])))
+                        continue;
+
+                    double const remaining_window = static_cast<double>(position + trimmed_window - position_of(nested));
+                    subtree_cost += subtree_costs[nested] * remaining_window / static_cast<double>(trimmed_window) +
+                                    static_cast<double>(trimmed_window);
+                }
+                subtree_costs[branch] = subtree_cost;
+            }
+
+            // Every variant also splits the reference, whose next node is extended by the trimmed window.
+            std::vector<variant_cost> variant_costs{};
+            for (std::size_t branch = 0; branch < branches.size(); ++branch) {
+                std::size_t const position = position_of(branch);
+                double const cost = subtree_costs[branch] + static_cast<double>(trimmed_window);
+                if (!variant_costs.empty() && variant_costs.back().position == position)
+                    variant_costs.back().cost += cost;
+                else
+                    variant_costs.push_back(variant_cost{.position = position, .cost = cost});
+            }
+            return variant_costs;
+        }
+
+        template <typename rcs_store_t>
+        std::vector<tree_shard> plan(rcs_store_t const & rcs_store,
+                                     std::size_t const shard_count,
+                                     std::vector<variant_cost> variant_costs) const {
+            if (shard_count == 0)
+                throw std::invalid_argument{"The number of shards must be greater than 0."};
+
+            std::size_t const source_size = std::ranges::size(rcs_store.source());
+            double const tree_cost = total_cost(rcs_store, variant_costs);
+
+            // Walks along the source and cuts once the accumulated cost crosses the next share.
+            std::vector<std::size_t> cuts{0};
+            std::vector<double> cut_costs{0.0};
+            double const share = tree_cost / static_cast<double>(shard_count);
+            double accumulated_cost{};
+            std::size_t position{};
+            auto next_variant = variant_costs.begin();
+            for (std::size_t shard = 1; shard < shard_count; ++shard) {
+                double const target_cost = share * static_cast<double>(shard);
+                while (true) {
+                    std::size_t const segment_end = (next_variant != variant_costs.end()) ? next_variant->position
+                                                                                        : source_size;
+                    double const segment_cost = static_cast<double>(segment_end - position);
+                    if (accumulated_cost + segment_cost >= target_cost) { // cut within the reference segment
+                        std::size_t const step = std::min(segment_end - position,
+                                                          static_cast<std::size_t>(target_cost - accumulated_cost));
+                        position += step;
+                        accumulated_cost += static_cast<double>(step);
+                        break;
+                    }
+
+                    accumulated_cost += segment_cost;
+                    position = segment_end;
+                    if (next_variant == variant_costs.end())
+                        break;
+
+                    double const variant_end_cost = accumulated_cost + next_variant->cost;
+                    if (variant_end_cost < target_cost) {
+                        accumulated_cost = variant_end_cost;
+                        ++next_variant;
+                        continue;
+                    }
+
+                    // Cut before or behind the variant, whichever deviates less from the target.
+                    if (variant_end_cost - target_cost < target_cost - accumulated_cost) {
+                        accumulated_cost = variant_end_cost + 1; // including the reference position of the variant
+                        ++position;
+                        ++next_variant;
+                    }
+                    break;
+                }
+                cuts.push_back(std::min(position, source_size));
+                cut_costs.push_back(accumulated_cost);
+            }
+            cuts.push_back(source_size);
+            cut_costs.push_back(tree_cost);
+
+            std::vector<tree_shard> shards{};
+            for (std::size_t shard = 1; shard < cuts.size(); ++shard) {
+                if (cuts[shard - 1] < cuts[shard])
+                    shards.push_back(tree_shard{.begin = cuts[shard - 1],
+                                                .end = cuts[shard],
+                                                .overlap = overlap_size(),
+                                                .cost = cut_costs[shard] - cut_costs[shard - 1]});
+            }
+            return shards;
+        }
+    };
+
+    /*!\brief The partial trees of the shards of a libjst::shard_planner, searched by a libjst::parallel_chunk_traverser.
+     *
+     * \tparam rcs_store_t The type of the store.
+     *
+     * \details
+     *
+     * The forest is a random access range over the partial trees of the shards including their overlap, like
+     * libjst::chunked_tree_impl, and offers the shards without their overlap by owned_chunk. The traverser hence
+     * reports every hit exactly once, and the task index of a hit is the index of its shard.
+     * The store must outlive the forest.
+     */
+    template <typename rcs_store_t>
+    class shard_forest {
+    private:
+
+        using tree_type = partial_tree<rcs_store_t>;
+        using size_type = typename tree_type::size_type;
+
+        rcs_store_t const * _rcs_store{};
+        std::vector<tree_shard> _shards{};
+        std::vector<tree_type> _trees{};
+
+    public:
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        shard_forest() = default; //!< Default.
+
+        //!\brief Builds the partial trees of the given shards of the store.
+        shard_forest(rcs_store_t const & rcs_store, std::vector<tree_shard> shards) :
+            _rcs_store{&rcs_store},
+            _shards{std::move(shards)}
+        {
+            _trees.reserve(_shards.size());
+            std::ranges::for_each(_shards, [&] (tree_shard const & shard) {
+                _trees.push_back(shard.make_tree(rcs_store));
+            });
+        }
+        //!\}
+
+        constexpr tree_type const & operator[](std::ptrdiff_t const step) const noexcept {
+            return _trees[step];
+        }
+
+        constexpr auto begin() const noexcept {
+            return _trees.begin();
+        }
+
+        constexpr auto end() const noexcept {
+            return _trees.end();
+        }
+
+        constexpr std::size_t size() const noexcept {
+            return _trees.size();
+        }
+
+        //!\brief Returns the shard with the given index.
+        constexpr tree_shard const & shard(std::size_t const shard_idx) const noexcept {
+            return _shards[shard_idx];
+        }
+
+        //!\brief Returns the partial tree of the shard without the overlap, see libjst::chunked_tree_impl::owned_chunk.
+        constexpr tree_type owned_chunk(std::size_t const shard_idx) const noexcept {
+            tree_shard const & owned = _shards[shard_idx];
+            return tree_type{*_rcs_store,
+                             static_cast<size_type>(owned.begin),
+                             static_cast<size_type>(owned.end - owned.begin)};
+        }
+    };
+}  // namespace libjst
@@ -13,8 +13,10 @@
 #pragma once
 
 #include <algorithm>
+#include <cstddef>
 #include <memory>
 #include <ranges>
+#include <tuple>
 #include <typeinfo>
 #include <vector>
 
@@ -118,4 +120,88 @@ namespace libjst
         };
     };
 
+    /*!\brief A stack notification registry with a fixed set of subscribers known at compile time.
+     *
+     * \tparam subscriber_ts The types of the subscribers; must model libjst::observable_stack.
+     *
+     * \details
+     *
+     * In contrast to libjst::stack_publisher, the subscribers are bound during construction and notified without any
+     * indirection, such that the notifications inline into the traversal loop. Use libjst::stack_publisher instead if
+     * the subscribers are only known at runtime, e.g. for plug-ins.
+     * The attached subscribers must outlive the registry.
+     */
+    template <observable_stack ...subscriber_ts>
+    class static_stack_publisher
+    {
+    private:
+
+        std::tuple<subscriber_ts *...> _subscribers{}; //!< The attached subscribers.
+
+    public:
+        /*!\name Constructors, destructor, and assignment
+         * \{
+         */
+        static_stack_publisher() = default; //!< Default.
+
+        //!\brief Attaches the given subscribers.
+        explicit static_stack_publisher(subscriber_ts & ...subscribers) noexcept
+            requires (sizeof...(subscriber_ts) > 0) :
+            _subscribers{std::addressof(subscribers)...}
+        {}
+        //!\}
+
+        void notify_push() const
+        {
+            std::apply([] (auto * ...subscribers) { (subscribers->notify_push(), ...); }, _subscribers);
+        }
+
+        void notify_pop() const
+        {
+            std::apply([] (auto * ...subscribers) { (subscribers->notify_pop(), ...); }, _subscribers);
+        }
+    };
+
+    template <observable_stack ...subscriber_ts>
+    static_stack_publisher(subscriber_ts & ...) -> static_stack_publisher<subscriber_ts...>;
+
+    /*!\brief A subscriber tracking the current and the peak number of nodes on the branch of a traversal.
+     *
+     * \details
+     *
+     * The peak depth times the size of the tree nodes bounds the memory of the branch stack, e.g. to size the arena of
+     * a traversal thread. The monitor can be reused for several traversals and then reports the peak over all of them.
+     */
+    class stack_depth_monitor
+    {
+    private:
+
+        std::size_t _depth{}; //!< The number of nodes currently on the branch.
+        std::size_t _peak_depth{}; //!< The maximal number of nodes on the branch.
+
+    public:
+
+        void notify_push() noexcept
+        {
+            _peak_depth = std::max(_peak_depth, ++_depth);
+        }
+
+        void notify_pop() noexcept
+        {
+            --_depth;
+        }
+
+        //!\brief Returns the number of nodes currently on the branch.
+        constexpr std::size_t depth() const noexcept
+        {
+            return _depth;
+        }
+
+        //!\brief Returns the maximal number of nodes on the branch since construction.
+        constexpr std::size_t peak_depth() const noexcept
+        {
+            return _peak_depth;
+        }
+    };
+
 } // namespace libjst
@@ -15,15 +15,20 @@
 #include <bitset>
 #include <concepts>
 #include <iostream>
-#include <stack>
+#include <type_traits>
 
+#include <libjst/matcher/concept.hpp>
 #include <libjst/sequence_tree/concept.hpp>
+#include <libjst/sequence_tree/coloured_tree.hpp>
+#include <libjst/sequence_tree/labelled_tree.hpp>
 #include <libjst/sequence_tree/left_extend_tree.hpp>
 #include <libjst/sequence_tree/merge_tree.hpp>
 #include <libjst/sequence_tree/prune_tree.hpp>
 #include <libjst/sequence_tree/prune_unsupported.hpp>
 #include <libjst/sequence_tree/trim_tree.hpp>
+#include <libjst/traversal/state_stack.hpp>
 #include <libjst/traversal/tree_traverser_base.hpp>
+#include <libjst/utility/arena_allocator.hpp>
 
 namespace libjst
 {
@@ -33,20 +38,28 @@ namespace libjst
         template <typename state_t>
         class state_manager;
 
-        template <typename tree_t, typename pattern_t, typename callback_t>
-        constexpr void operator()(tree_t && tree, pattern_t && pattern, callback_t && callback) const {
+        template <typename tree_t, typename pattern_t, typename callback_t, observable_stack ...subscriber_ts>
+        constexpr void operator()(tree_t && tree,
+                                  pattern_t && pattern,
+                                  callback_t && callback,
+                                  subscriber_ts & ...subscribers) const {
             if (libjst::window_size(pattern) == 0)
                 return;
 
-            auto search_tree = tree | libjst::labelled()
+            // The labels and the branch stack allocate from the arena of the calling thread, if there is one.
+            auto search_tree = tree | libjst::labelled(arena_allocator<std::byte>{})
                                     | libjst::coloured()
                                     | trim(libjst::window_size(pattern) - 1)
                                     | prune_unsupported()
                                     | merge(); // make big nodes
 
-            state_manager<pattern_t> listening_pattern{(pattern_t &&) pattern};
-            tree_traverser_base traversal_path{search_tree};
-            traversal_path.subscribe(listening_pattern);
+            // The branch depth is bounded by the trimmed window, hence the state stack rarely grows beyond it.
+            std::size_t const max_depth = libjst::window_size(pattern);
+            state_manager<pattern_t> listening_pattern{(pattern_t &&) pattern, max_depth};
+            using publisher_t = static_stack_publisher<state_manager<pattern_t>, subscriber_ts...>;
+            tree_traverser_base<decltype(search_tree), arena_allocator<std::byte>, publisher_t>
+                traversal_path{search_tree, publisher_t{listening_pattern, subscribers...}};
+            traversal_path.reserve(max_depth);
             // we need to add another stack but extern of the algorithm.
             for (auto it = traversal_path.begin(); it != traversal_path.end(); ++it) {
                 auto && label = *it;
@@ -57,21 +70,49 @@ namespace libjst
         }
     };
 
+    namespace detail
+    {
+        //!\brief A matcher whose states shall be stored as deltas by the libjst::state_capture_traverser.
+        template <typename matcher_t>
+        concept delta_encoded_matcher = std::remove_cvref_t<matcher_t>::delta_encoded_state &&
+                                        delta_encodable_state<std::remove_cvref_t<matcher_state_t<matcher_t>>>;
+
+        //!\brief Selects the state stack without naming libjst::delta_state_stack for states it cannot store.
+        template <typename matcher_t, typename state_t>
+        struct state_stack_for {
+            using type = state_stack<state_t>;
+        };
+
+        template <typename matcher_t, typename state_t>
+            requires delta_encoded_matcher<matcher_t>
+        struct state_stack_for<matcher_t, state_t> {
+            using type = delta_state_stack<state_t>;
+        };
+    } // namespace detail
+
+    /*!\brief Captures the matcher state on every branch push and restores it on the corresponding pop.
+     *
+     * \details
+     *
+     * The states are kept in a libjst::state_stack preallocated to the maximal branch depth. Matchers with multi-word
+     * states can opt into libjst::delta_state_stack, which stores only the words that changed between consecutive
+     * branches, by declaring `static constexpr bool delta_encoded_state = true`.
+     */
     template <typename matcher_t>
     class state_capture_traverser::state_manager {
     private:
 
-        using state_t = libjst::matcher_state_t<matcher_t>;
-        using state_stack_t = std::stack<state_t>;
+        using state_t = std::remove_cvref_t<libjst::matcher_state_t<matcher_t>>;
+        using state_stack_t = typename detail::state_stack_for<matcher_t, state_t>::type;
 
         matcher_t _matcher;
         state_stack_t _states{};
 
     public:
 
-        constexpr explicit state_manager(matcher_t matcher) noexcept :
+        constexpr explicit state_manager(matcher_t matcher, std::size_t const capacity = 0) :
             _matcher{(matcher_t &&) matcher},
-            _states{}
+            _states{capacity}
         {}
 
         template <typename ...args_t>
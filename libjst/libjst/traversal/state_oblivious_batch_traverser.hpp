@@ -0,0 +1,101 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides standard jst search for a batch of patterns.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <ranges>
+#include <vector>
+
+#include <libjst/matcher/concept.hpp>
+#include <libjst/sequence_tree/concept.hpp>
+#include <libjst/sequence_tree/coloured_tree.hpp>
+#include <libjst/sequence_tree/labelled_tree.hpp>
+#include <libjst/sequence_tree/left_extend_tree.hpp>
+#include <libjst/sequence_tree/merge_tree.hpp>
+#include <libjst/sequence_tree/prune_unsupported.hpp>
+#include <libjst/sequence_tree/trim_tree.hpp>
+#include <libjst/traversal/tree_traverser_base.hpp>
+#include <libjst/utility/arena_allocator.hpp>
+
+namespace libjst
+{
+    /*!\brief Searches a batch of patterns with a single tree walk per distinct window size.
+     *
+     * \details
+     *
+     * The patterns are grouped by their window size. For each group the tree is trimmed and left extended to the
+     * window of the group and traversed once; every pattern of the group is then evaluated on the label of every
+     * visited node. The node generation and the label construction are hence shared by all patterns of a group,
+     * while the reported hits are exactly the ones of running the libjst::state_oblivious_traverser per pattern.
+     * Patterns with different window sizes cannot share a walk, since a shorter pattern would report its hits in the
+     * left extension of a node and after the end of a variant twice.
+     *
+     * The callback is invoked with the index of the pattern in the batch, the iterator to the end of the hit in the
+     * label and the label itself.
+     */
+    struct state_oblivious_batch_traverser {
+        template <typename tree_t, std::ranges::random_access_range patterns_t, typename callback_t>
+            requires window_matcher<std::ranges::range_reference_t<patterns_t>>
+        constexpr void operator()(tree_t && tree, patterns_t && patterns, callback_t && callback) const {
+            std::vector<std::size_t> pattern_order(std::ranges::size(patterns));
+            std::iota(pattern_order.begin(), pattern_order.end(), 0);
+            auto pattern_window = [&] (std::size_t const idx) -> std::size_t {
+                return libjst::window_size(std::ranges::begin(patterns)[idx]);
+            };
+            std::ranges::stable_sort(pattern_order, std::ranges::less{}, pattern_window);
+
+            auto group_begin = std::ranges::find_if(pattern_order, [&] (std::size_t idx) {
+                return pattern_window(idx) > 0;
+            });
+            while (group_begin != pattern_order.end()) {
+                std::size_t const window = pattern_window(*group_begin);
+                auto group_end = std::ranges::find_if(group_begin, pattern_order.end(), [&] (std::size_t idx) {
+                    return pattern_window(idx) != window;
+                });
+                search_group(tree, patterns, std::ranges::subrange{group_begin, group_end}, window, callback);
+                group_begin = group_end;
+            }
+        }
+
+    private:
+
+        template <typename tree_t, typename patterns_t, typename group_t, typename callback_t>
+        static constexpr void search_group(tree_t && tree,
+                                           patterns_t && patterns,
+                                           group_t && group,
+                                           std::size_t const window,
+                                           callback_t && callback) {
+            // The labels and the branch stack allocate from the arena of the calling thread, if there is one.
+            auto search_tree = tree | libjst::labelled(arena_allocator<std::byte>{})
+                                    | libjst::coloured()
+                                    | trim(window - 1)
+                                    | prune_unsupported()
+                                    | left_extend(window - 1)
+                                    | merge(); // make big nodes
+
+            tree_traverser_base<decltype(search_tree), arena_allocator<std::byte>, static_stack_publisher<>>
+                oblivious_path{search_tree};
+            oblivious_path.reserve(window);
+            for (auto it = oblivious_path.begin(); it != oblivious_path.end(); ++it) {
+                auto && label = *it;
+                for (std::size_t const idx : group) {
+                    std::ranges::begin(patterns)[idx](label.sequence(), [&] (auto && label_it) {
+                        callback(idx, std::move(label_it), label);
+                    });
+                }
+            }
+        }
+    };
+}  // namespace libjst
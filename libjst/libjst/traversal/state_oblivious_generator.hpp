@@ -0,0 +1,132 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides a jst search producing the hits lazily.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <ranges>
+#include <stop_token>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <libjst/matcher/concept.hpp>
+#include <libjst/sequence_tree/concept.hpp>
+#include <libjst/sequence_tree/coloured_tree.hpp>
+#include <libjst/sequence_tree/labelled_tree.hpp>
+#include <libjst/sequence_tree/left_extend_tree.hpp>
+#include <libjst/sequence_tree/merge_tree.hpp>
+#include <libjst/sequence_tree/prune_unsupported.hpp>
+#include <libjst/sequence_tree/trim_tree.hpp>
+#include <libjst/traversal/stack_publisher.hpp>
+#include <libjst/traversal/tree_traverser_base.hpp>
+#include <libjst/utility/generator.hpp>
+
+namespace libjst
+{
+    /*!\brief A hit reported by the libjst::state_oblivious_generator.
+     *
+     * \tparam label_t The type of the label of the node containing the hit.
+     * \tparam position_t The type of the iterator pointing into the sequence of the label.
+     */
+    template <typename label_t, typename position_t>
+    struct search_hit {
+        position_t position{}; //!< The iterator to the end of the hit, as reported by the matcher.
+        label_t label{}; //!< The label of the node containing the hit.
+    };
+
+    /*!\brief Searches a pattern in a tree and produces the hits lazily.
+     *
+     * \details
+     *
+     * Visits the same nodes and reports the same hits in the same order as the libjst::state_oblivious_traverser, but
+     * instead of invoking a callback the hits are returned as a libjst::generator. The tree is only traversed while the
+     * consumer asks for the next hit, such that the consumer can stop or pause the search at any hit, e.g. to stream
+     * the first hits of a query. The search stops after the given maximal number of hits or once a stop is requested
+     * on the given stop token, which is checked before every node and every hit.
+     *
+     * The hits of a node are collected when the node is visited and then yielded one by one. The position and the
+     * label of a hit are only valid until the generator is resumed. The tree and the pattern are copied into the
+     * generator, while the sequences of the tree must outlive it. The branch stack and the labels use the default
+     * allocator, since the generator can be resumed outside of the arena of the creating thread.
+     */
+    struct state_oblivious_generator {
+    private:
+
+        template <typename tree_t>
+        using search_tree_t = decltype(std::declval<tree_t>() | libjst::labelled()
+                                                              | libjst::coloured()
+                                                              | libjst::trim(std::size_t{})
+                                                              | libjst::prune_unsupported()
+                                                              | libjst::left_extend(std::size_t{})
+                                                              | libjst::merge());
+
+        template <typename tree_t>
+        using label_t = libjst::node_label_t<libjst::tree_node_t<search_tree_t<tree_t>>>;
+
+        template <typename tree_t>
+        using position_t = std::ranges::iterator_t<decltype(std::declval<label_t<tree_t> const &>().sequence())>;
+
+    public:
+
+        //!\brief The type of the hits reported for the given tree.
+        template <typename tree_t>
+        using hit_type = search_hit<label_t<std::remove_cvref_t<tree_t>>, position_t<std::remove_cvref_t<tree_t>>>;
+
+        template <typename tree_t, typename pattern_t>
+        auto operator()(tree_t tree,
+                        pattern_t pattern,
+                        std::size_t const max_hits = std::numeric_limits<std::size_t>::max(),
+                        std::stop_token stop_token = {}) const
+            -> generator<hit_type<tree_t>>
+        {
+            std::size_t const window_size = libjst::window_size(pattern);
+            if (window_size == 0 || max_hits == 0)
+                co_return;
+
+            auto search_tree = std::move(tree) | libjst::labelled()
+                                               | libjst::coloured()
+                                               | libjst::trim(window_size - 1)
+                                               | libjst::prune_unsupported()
+                                               | libjst::left_extend(window_size - 1)
+                                               | libjst::merge(); // make big nodes
+
+            tree_traverser_base<decltype(search_tree), std::allocator<std::byte>, static_stack_publisher<>>
+                oblivious_path{search_tree};
+            oblivious_path.reserve(window_size);
+
+            std::vector<position_t<tree_t>> node_hits{};
+            std::size_t hit_count{};
+            for (auto it = oblivious_path.begin(); it != oblivious_path.end(); ++it) {
+                if (stop_token.stop_requested())
+                    co_return;
+
+                label_t<tree_t> label = *it;
+                node_hits.clear();
+                pattern(label.sequence(), [&] (auto && label_it) {
+                    node_hits.push_back(std::move(label_it));
+                });
+
+                for (auto & position : node_hits) {
+                    if (stop_token.stop_requested())
+                        co_return;
+
+                    co_yield hit_type<tree_t>{std::move(position), label};
+
+                    if (++hit_count == max_hits)
+                        co_return;
+                }
+            }
+        }
+    };
+}  // namespace libjst
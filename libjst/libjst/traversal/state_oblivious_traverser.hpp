@@ -12,6 +12,15 @@
 
 #pragma once
 
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <ranges>
+#include <span>
+#include <type_traits>
+#include <utility>
+
+#include <libjst/matcher/concept.hpp>
 #include <libjst/sequence_tree/concept.hpp>
 #include <libjst/sequence_tree/coloured_tree.hpp>
 #include <libjst/sequence_tree/labelled_tree.hpp>
@@ -19,31 +28,216 @@
 #include <libjst/sequence_tree/merge_tree.hpp>
 #include <libjst/sequence_tree/prune_tree.hpp>
 #include <libjst/sequence_tree/prune_unsupported.hpp>
+#include <libjst/sequence_tree/seekable_tree.hpp>
 #include <libjst/sequence_tree/trim_tree.hpp>
+#include <libjst/traversal/left_context_cache.hpp>
+#include <libjst/traversal/traversal_budget.hpp>
+#include <libjst/traversal/traversal_checkpoint.hpp>
 #include <libjst/traversal/tree_traverser_base.hpp>
+#include <libjst/utility/arena_allocator.hpp>
 
 namespace libjst
 {
+    /*!\brief Searches the pattern along the standard adaptor pipeline of a sequence tree.
+     *
+     * \details
+     *
+     * The traversal can be observed by additional subscribers modelling libjst::observable_stack, which are notified
+     * about every pushed and popped node. A subscriber that offers `notify_label(label)` is also notified about
+     * every label before the pattern is searched in it. Patterns keeping a state between two invocations, i.e. which
+     * offer `reset()`, are reset before every label.
+     *
+     * A memory budget bounds the nodes held on the branch, see libjst::tree_traverser_base::set_memory_budget. With
+     * a budget, the tree is additionally made seekable, such that the nodes beyond the budget are spilled and sought
+     * again on demand instead of exhausting the memory in subtrees of clustered variants.
+     *
+     * A libjst::traversal_budget stops the search once it expires. The search then returns the checkpoint of the
+     * interrupted traversal, and the hits reported so far are the partial result; a search that visited all nodes
+     * returns an empty checkpoint. A traverser resuming from the checkpoint, see resume_from, reports the remaining
+     * hits of the same tree and pattern. With a budget or a resume point, the tree is made seekable as well. Trees
+     * that cannot be made seekable are searched without a budget.
+     *
+     * Every label repeats up to `window_size - 1` symbols of its branch to the left of the node. With
+     * cache_left_context enabled and neither a budget nor a resume point set, the traverser keeps these symbols in a
+     * libjst::left_context_cache and reads only the symbols behind the parent label from the labels. The pattern then
+     * searches a contiguous buffer of the label, whose hits are reported as iterators into the label sequence as
+     * before. This pays off for long windows over dense variants, whose labels consist mostly of context.
+     */
     struct state_oblivious_traverser {
-        template <typename tree_t, typename pattern_t, typename callback_t>
-        constexpr void operator()(tree_t && tree, pattern_t && pattern, callback_t && callback) const {
+    private:
+
+        std::size_t _memory_budget{0};
+        traversal_budget const * _budget{};
+        traversal_checkpoint<> _resume_point{};
+        bool _caches_left_context{false};
+
+    public:
+
+        //!\brief Sets the number of bytes the nodes held on the branch may occupy; 0, the default, means unlimited.
+        constexpr void memory_budget(std::size_t const bytes) noexcept {
+            _memory_budget = bytes;
+        }
+
+        //!\brief Returns the memory budget of the branch in bytes; 0 means unlimited.
+        constexpr std::size_t memory_budget() const noexcept {
+            return _memory_budget;
+        }
+
+        //!\brief Stops the search once the given budget expires; the budget must outlive the searches.
+        constexpr void set_budget(traversal_budget const & budget) noexcept {
+            _budget = std::addressof(budget);
+        }
+
+        //!\brief Enables or disables caching the left context of the labels; disabled by default.
+        constexpr void cache_left_context(bool const enable) noexcept {
+            _caches_left_context = enable;
+        }
+
+        //!\brief Whether the left context of the labels is cached.
+        constexpr bool caches_left_context() const noexcept {
+            return _caches_left_context;
+        }
+
+        //!\brief Resumes the next search from the checkpoint returned by an interrupted search.
+        void resume_from(traversal_checkpoint<> checkpoint) noexcept {
+            _resume_point = std::move(checkpoint);
+        }
+
+        template <typename tree_t, typename pattern_t, typename callback_t, observable_stack ...subscriber_ts>
+        constexpr traversal_checkpoint<> operator()(tree_t && tree,
+                                                    pattern_t && pattern,
+                                                    callback_t && callback,
+                                                    subscriber_ts & ...subscribers) const {
             if (libjst::window_size(pattern) == 0)
-                return;
+                return {};
 
-            auto search_tree = tree | libjst::labelled()
+            auto const extension = detail::left_extension(pattern); // static if the window size is.
+            // The labels and the branch stack allocate from the arena of the calling thread, if there is one.
+            auto search_tree = tree | libjst::labelled(arena_allocator<std::byte>{})
                                     | libjst::coloured()
-                                    | trim(libjst::window_size(pattern) - 1)
+                                    | trim(static_cast<std::size_t>(extension))
                                     | prune_unsupported()
-                                    | left_extend(libjst::window_size(pattern) - 1)
+                                    | left_extend(extension)
                                     | merge(); // make big nodes
 
-            tree_traverser_base oblivious_path{search_tree};
+            if constexpr (requires { std::move(search_tree) | libjst::seek(); }) {
+                if (_memory_budget != 0 || _budget != nullptr || !_resume_point.empty()) {
+                    auto seekable_tree = std::move(search_tree) | libjst::seek();
+                    return search(seekable_tree, pattern, callback, subscribers...);
+                }
+            }
+            if constexpr (is_cacheable_label<libjst::tree_label_t<decltype(search_tree)>>) {
+                if (_caches_left_context && _resume_point.empty()) {
+                    search_cached(search_tree, pattern, callback, static_cast<std::size_t>(extension), subscribers...);
+                    return {};
+                }
+            }
+            return search(search_tree, pattern, callback, subscribers...);
+        }
+
+    private:
+
+        //!\brief Whether the label is a non-contiguous sequence within its path sequence, whose symbols can be cached.
+        template <typename label_t>
+        static constexpr bool is_cacheable_label = [] () {
+            using sequence_t = decltype(std::declval<label_t const &>().sequence());
+            if constexpr (std::ranges::random_access_range<sequence_t> && std::ranges::sized_range<sequence_t> &&
+                          !std::ranges::contiguous_range<sequence_t>) {
+                using iterator_t = std::ranges::iterator_t<sequence_t>;
+                if constexpr (requires (iterator_t it) { { it.position() } -> std::integral; } ||
+                              requires (label_t const & label) { label.path_sequence(); })
+                    return std::is_trivially_copyable_v<std::ranges::range_value_t<sequence_t>>;
+            }
+            return false;
+        }();
+
+        //!\brief Returns the position of the label sequence within the path sequence of the label.
+        template <typename label_t, typename sequence_t>
+        static constexpr std::size_t path_position(label_t const & label, sequence_t const & label_sequence) {
+            auto label_it = std::ranges::begin(label_sequence);
+            if constexpr (requires { { label_it.position() } -> std::integral; })
+                return static_cast<std::size_t>(label_it.position()); // constant time for journaled sequences
+            else
+                return static_cast<std::size_t>(label_it - std::ranges::begin(label.path_sequence()));
+        }
+
+        template <typename search_tree_t, typename pattern_t, typename callback_t, typename ...subscriber_ts>
+        static constexpr void search_cached(search_tree_t const & search_tree,
+                                            pattern_t & pattern,
+                                            callback_t & callback,
+                                            std::size_t const extension,
+                                            subscriber_ts & ...subscribers) {
+            using label_t = libjst::tree_label_t<search_tree_t>;
+            using symbol_t = std::ranges::range_value_t<decltype(std::declval<label_t const &>().sequence())>;
+            using cache_t = left_context_cache<symbol_t>;
+            using publisher_t = static_stack_publisher<cache_t, subscriber_ts...>;
+
+            cache_t context_cache{extension};
+            tree_traverser_base<search_tree_t, arena_allocator<std::byte>, publisher_t>
+                oblivious_path{search_tree, publisher_t{context_cache, subscribers...}};
+            oblivious_path.reserve(extension + 1);
             for (auto it = oblivious_path.begin(); it != oblivious_path.end(); ++it) {
                 auto && label = *it;
+                (notify_label(subscribers, label), ...);
+                reset_state(pattern); // every label is left extended and searched on its own
+                auto const label_sequence = label.sequence();
+                std::span<symbol_t const> haystack =
+                    context_cache.haystack(label_sequence, path_position(label, label_sequence));
+                pattern(haystack, [&] (auto && hit) {
+                    std::ptrdiff_t offset{};
+                    if constexpr (std::integral<std::remove_cvref_t<decltype(hit)>>)
+                        offset = static_cast<std::ptrdiff_t>(hit);
+                    else
+                        offset = hit - haystack.begin();
+                    callback(std::ranges::begin(label_sequence) + offset, label);
+                });
+            }
+        }
+
+        template <typename search_tree_t, typename pattern_t, typename callback_t, typename ...subscriber_ts>
+        constexpr traversal_checkpoint<> search(search_tree_t const & search_tree,
+                                                pattern_t & pattern,
+                                                callback_t & callback,
+                                                subscriber_ts & ...subscribers) const {
+            using publisher_t = static_stack_publisher<subscriber_ts...>;
+            tree_traverser_base<search_tree_t, arena_allocator<std::byte>, publisher_t>
+                oblivious_path{search_tree, publisher_t{subscribers...}};
+            oblivious_path.reserve(libjst::window_size(pattern));
+            constexpr bool is_seekable = requires { oblivious_path.set_memory_budget(std::size_t{}); };
+            if constexpr (is_seekable) {
+                if (_memory_budget != 0)
+                    oblivious_path.set_memory_budget(_memory_budget);
+                if (_budget != nullptr)
+                    oblivious_path.set_budget(*_budget);
+                if (!_resume_point.empty())
+                    oblivious_path.resume(_resume_point);
+            }
+            for (auto it = oblivious_path.begin(); it != oblivious_path.end(); ++it) {
+                auto && label = *it;
+                (notify_label(subscribers, label), ...);
+                reset_state(pattern); // every label is left extended and searched on its own
                 pattern(label.sequence(), [&] (auto && label_it) {
                     callback(std::move(label_it), label); // either cargo offers access to node context or not!
                 });
             }
+
+            if constexpr (is_seekable) {
+                if (oblivious_path.interrupted())
+                    return oblivious_path.checkpoint();
+            }
+            return {};
+        }
+
+        template <typename pattern_t>
+        static constexpr void reset_state(pattern_t & pattern) {
+            if constexpr (requires { pattern.reset(); })
+                pattern.reset();
+        }
+
+        template <typename subscriber_t, typename label_t>
+        static constexpr void notify_label(subscriber_t & subscriber, label_t const & label) {
+            if constexpr (requires { subscriber.notify_label(label); })
+                subscriber.notify_label(label);
         }
     };
 }  // namespace libjst
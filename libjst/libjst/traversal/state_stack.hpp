@@ -0,0 +1,178 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides the stacks storing the captured matcher states of a traversal.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <libjst/utility/arena_allocator.hpp>
+
+namespace libjst
+{
+    //!\brief A state that is a sized range of trivially copyable words and can be stored as the changed words only.
+    template <typename state_t>
+    concept delta_encodable_state = std::ranges::random_access_range<state_t> &&
+                                    std::ranges::sized_range<state_t> &&
+                                    std::is_trivially_copyable_v<std::ranges::range_value_t<state_t>> &&
+                                    std::equality_comparable<std::ranges::range_value_t<state_t>> &&
+                                    std::copyable<state_t>;
+
+    /*!\brief A stack of matcher states stored in preallocated slots.
+     *
+     * \tparam state_t The type of the stored states.
+     *
+     * \details
+     *
+     * All states are kept in one contiguous buffer whose slots are reused after they have been popped, such that a
+     * traversal whose branch depth stays within the already used slots never allocates. States owning memory, e.g.
+     * the words of a bit-parallel matcher, are copy-assigned into the reused slot and keep their buffer as well.
+     * The number of slots grows on demand. The slots are allocated from the libjst::arena_allocator of the calling
+     * thread.
+     */
+    template <std::copyable state_t>
+    class state_stack {
+    private:
+        std::vector<state_t, arena_allocator<state_t>> _slots{}; //!< The slots of the states.
+        std::size_t _size{}; //!< The number of stored states.
+
+    public:
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        state_stack() = default; //!< Default.
+
+        //!\brief Reserves the given number of slots.
+        explicit state_stack(std::size_t const capacity)
+        {
+            _slots.reserve(capacity);
+        }
+        //!\}
+
+        template <typename other_state_t>
+            requires std::assignable_from<state_t &, other_state_t>
+        void push(other_state_t && state) {
+            if (_size < _slots.size())
+                _slots[_size] = (other_state_t &&) state;
+            else
+                _slots.emplace_back((other_state_t &&) state);
+            ++_size;
+        }
+
+        void pop() noexcept {
+            assert(!empty());
+            --_size; // keeps the slot for the next push.
+        }
+
+        state_t const & top() const noexcept {
+            assert(!empty());
+            return _slots[_size - 1];
+        }
+
+        bool empty() const noexcept {
+            return _size == 0;
+        }
+
+        std::size_t size() const noexcept {
+            return _size;
+        }
+
+        //!\brief Returns the number of states that can be stored without allocating.
+        std::size_t capacity() const noexcept {
+            return _slots.capacity();
+        }
+    };
+
+    /*!\brief A stack of matcher states storing only the words that changed between consecutive states.
+     *
+     * \tparam state_t The type of the stored states; must model libjst::delta_encodable_state.
+     *
+     * \details
+     *
+     * Only the top state is kept in full. Pushing a state records the words of the previous top that differ from the
+     * new state, and popping writes these words back. For bit-parallel matchers with multi-word states, of which
+     * usually only a few words change between two branches, this reduces the memory traffic per push and pop to the
+     * changed words. All states pushed onto one stack must have the same size.
+     */
+    template <delta_encodable_state state_t>
+    class delta_state_stack {
+    private:
+        using word_type = std::ranges::range_value_t<state_t>;
+
+        //!\brief A word of the state that preceded the current top: the word index and its previous value.
+        struct change_type {
+            std::size_t index{};
+            word_type word{};
+        };
+
+        state_t _top{}; //!< The top state.
+        std::vector<change_type, arena_allocator<change_type>> _changes{}; //!< The words to restore per stored state.
+        std::vector<std::size_t, arena_allocator<std::size_t>> _change_offsets{}; //!< The first change of every stored state.
+
+    public:
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        delta_state_stack() = default; //!< Default.
+
+        //!\brief Preallocates the stack for the given number of states.
+        explicit delta_state_stack(std::size_t const capacity)
+        {
+            _change_offsets.reserve(capacity);
+            _changes.reserve(capacity);
+        }
+        //!\}
+
+        void push(state_t const & state) {
+            std::size_t const first_change = _changes.size();
+            if (empty()) {
+                _top = state;
+            } else {
+                assert(std::ranges::size(state) == std::ranges::size(_top));
+                for (std::size_t index = 0; index < std::ranges::size(_top); ++index) {
+                    if (!(_top[index] == state[index])) {
+                        _changes.push_back(change_type{.index = index, .word = _top[index]});
+                        _top[index] = state[index];
+                    }
+                }
+            }
+            _change_offsets.push_back(first_change);
+        }
+
+        void pop() noexcept {
+            assert(!empty());
+            std::size_t const first_change = _change_offsets.back();
+            _change_offsets.pop_back();
+            for (std::size_t change = first_change; change < _changes.size(); ++change)
+                _top[_changes[change].index] = _changes[change].word;
+            _changes.resize(first_change);
+        }
+
+        state_t const & top() const noexcept {
+            assert(!empty());
+            return _top;
+        }
+
+        bool empty() const noexcept {
+            return _change_offsets.empty();
+        }
+
+        std::size_t size() const noexcept {
+            return _change_offsets.size();
+        }
+    };
+}  // namespace libjst
@@ -0,0 +1,354 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::trace_session to record and export the events of tree traversals.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <ranges>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <libjst/traversal/state_oblivious_traverser.hpp>
+
+namespace libjst
+{
+    //!\brief The kind of a libjst::trace_event.
+    enum class trace_event_kind : std::uint8_t {
+        push, //!< A node was pushed on the branch.
+        pop, //!< A node was popped from the branch.
+        label, //!< The label of the active node was searched.
+        task_begin, //!< The traversal of a chunk began.
+        task_end //!< The traversal of a chunk ended.
+    };
+
+    //!\brief An event recorded by a libjst::trace_recorder.
+    struct trace_event {
+        std::uint64_t timestamp{}; //!< The nanoseconds since the start of the libjst::trace_session.
+        std::uint64_t chunk{}; //!< The source position the traversed chunk begins at.
+        std::uint32_t depth{}; //!< The number of nodes on the branch after the event.
+        std::uint32_t size{}; //!< The size of the searched label; 0 for all other events.
+        trace_event_kind kind{}; //!< The kind of the event.
+
+        friend constexpr bool operator==(trace_event const &, trace_event const &) noexcept = default;
+    };
+
+    /*!\brief A ring buffer of a fixed capacity holding the latest events of a single thread.
+     *
+     * \details
+     *
+     * The buffer allocates its capacity once during construction. If the buffer is full, the oldest event is
+     * overwritten, such that the buffer always holds the events last recorded before the traversal stopped or stalled.
+     * The buffer is not thread-safe; it must be written by a single thread and read after the writer has finished.
+     */
+    class trace_buffer {
+    private:
+        std::vector<trace_event> _events{};
+        std::size_t _recorded_count{};
+        std::uint32_t _thread_id{};
+
+    public:
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        trace_buffer() = delete; //!< Deleted.
+
+        //!\brief Constructs a buffer for the given number of events of the thread with the given id.
+        explicit trace_buffer(std::size_t const capacity, std::uint32_t const thread_id = 0) :
+            _events(capacity),
+            _thread_id{thread_id}
+        {
+            if (capacity == 0)
+                throw std::invalid_argument{"The capacity of a trace buffer must be greater than 0."};
+        }
+        //!\}
+
+        //!\brief Records the given event, overwriting the oldest one if the buffer is full.
+        void record(trace_event const & event) noexcept {
+            _events[_recorded_count % _events.size()] = event;
+            ++_recorded_count;
+        }
+
+        //!\brief Returns the held events from the oldest to the latest one.
+        std::vector<trace_event> events() const {
+            std::vector<trace_event> ordered{};
+            ordered.reserve(size());
+            for (std::size_t idx = dropped_count(); idx < _recorded_count; ++idx)
+                ordered.push_back(_events[idx % _events.size()]);
+            return ordered;
+        }
+
+        //!\brief Returns the number of held events.
+        std::size_t size() const noexcept {
+            return _recorded_count - dropped_count();
+        }
+
+        //!\brief Returns the maximal number of held events.
+        std::size_t capacity() const noexcept {
+            return _events.size();
+        }
+
+        //!\brief Returns the number of events that were overwritten.
+        std::size_t dropped_count() const noexcept {
+            return (_recorded_count > _events.size()) ? _recorded_count - _events.size() : 0;
+        }
+
+        //!\brief Returns the id of the recording thread.
+        std::uint32_t thread_id() const noexcept {
+            return _thread_id;
+        }
+
+        //!\brief Discards all events.
+        void clear() noexcept {
+            _recorded_count = 0;
+        }
+    };
+
+    /*!\brief A stack subscriber recording the events of a single traversal into a libjst::trace_buffer.
+     *
+     * \details
+     *
+     * The recorder models libjst::observable_stack and can hence be attached to any libjst::stack_publisher or
+     * libjst::static_stack_publisher. It also records the searched labels if it is passed to the
+     * libjst::state_oblivious_traverser. The timestamps are measured with the steady clock relative to the given epoch.
+     */
+    class trace_recorder {
+    private:
+        using clock_type = std::chrono::steady_clock;
+
+        trace_buffer * _buffer{};
+        clock_type::time_point _epoch{};
+        std::uint64_t _chunk{};
+        std::uint32_t _depth{};
+
+    public:
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        trace_recorder() = delete; //!< Deleted.
+
+        //!\brief Records into the given buffer, which must outlive the recorder.
+        explicit trace_recorder(trace_buffer & buffer, clock_type::time_point const epoch = clock_type::now()) noexcept :
+            _buffer{std::addressof(buffer)},
+            _epoch{epoch}
+        {}
+        //!\}
+
+        //!\brief Records the begin of the traversal of the chunk beginning at the given source position.
+        void begin_task(std::uint64_t const chunk) noexcept {
+            _chunk = chunk;
+            _depth = 0;
+            record(trace_event_kind::task_begin);
+        }
+
+        //!\brief Records the end of the traversal of the current chunk.
+        void end_task() noexcept {
+            record(trace_event_kind::task_end);
+        }
+
+        void notify_push() noexcept {
+            ++_depth;
+            record(trace_event_kind::push);
+        }
+
+        void notify_pop() noexcept {
+            --_depth;
+            record(trace_event_kind::pop);
+        }
+
+        template <typename label_t>
+        void notify_label(label_t const & label) noexcept {
+            record(trace_event_kind::label, static_cast<std::uint32_t>(std::ranges::size(label.sequence())));
+        }
+
+        //!\brief Returns the number of nodes on the observed branch.
+        std::uint32_t depth() const noexcept {
+            return _depth;
+        }
+
+    private:
+
+        void record(trace_event_kind const kind, std::uint32_t const size = 0) noexcept {
+            auto const elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now() - _epoch);
+            _buffer->record(trace_event{.timestamp = static_cast<std::uint64_t>(elapsed.count()),
+                                        .chunk = _chunk,
+                                        .depth = _depth,
+                                        .size = size,
+                                        .kind = kind});
+        }
+    };
+
+    /*!\brief Collects the trace buffers of all threads traversing the trees of a run and exports them.
+     *
+     * \details
+     *
+     * Every thread obtains its own libjst::trace_buffer with local_buffer(), which is preallocated with the capacity
+     * of the session on the first call of the thread and reused afterwards. The buffers are exported with
+     * write_chrome_trace() in the Chrome trace event format, which is read by chrome://tracing and Perfetto: every
+     * thread is shown as its own track, on which the chunks and the nested pushed nodes are drawn as slices and the
+     * searched labels as instant events. The last slice of each track hence shows which chunk and which branch a
+     * stalled worker was stuck in.
+     *
+     * The buffers must only be exported after all recording threads have finished or stopped.
+     */
+    class trace_session {
+    private:
+        using clock_type = std::chrono::steady_clock;
+
+        std::deque<trace_buffer> _buffers{};
+        std::map<std::thread::id, std::size_t> _thread_buffers{};
+        mutable std::mutex _mutex{};
+        std::size_t _capacity{};
+        clock_type::time_point _epoch{clock_type::now()};
+
+    public:
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        trace_session() = delete; //!< Deleted.
+
+        //!\brief Constructs a session holding up to the given number of events per thread.
+        explicit trace_session(std::size_t const capacity) : _capacity{capacity}
+        {
+            if (capacity == 0)
+                throw std::invalid_argument{"The capacity of a trace session must be greater than 0."};
+        }
+        //!\}
+
+        //!\brief Returns the buffer of the calling thread; thread-safe.
+        trace_buffer & local_buffer() {
+            std::scoped_lock lock{_mutex};
+            auto [it, inserted] = _thread_buffers.try_emplace(std::this_thread::get_id(), _buffers.size());
+            if (inserted)
+                _buffers.emplace_back(_capacity, static_cast<std::uint32_t>(it->second));
+            return _buffers[it->second];
+        }
+
+        //!\brief Returns a recorder writing into the buffer of the calling thread; thread-safe.
+        trace_recorder local_recorder() {
+            return trace_recorder{local_buffer(), _epoch};
+        }
+
+        //!\brief Returns the buffers of all threads in the order the threads joined the session.
+        std::deque<trace_buffer> const & buffers() const noexcept {
+            return _buffers;
+        }
+
+        //!\brief Returns the number of events that were overwritten in all buffers.
+        std::size_t dropped_count() const noexcept {
+            std::size_t dropped{};
+            for (trace_buffer const & buffer : _buffers)
+                dropped += buffer.dropped_count();
+            return dropped;
+        }
+
+        /*!\brief Writes all buffers in the Chrome trace event format to the given stream.
+         *
+         * \details
+         *
+         * The chunks are written as complete slices named by their begin position, the pushed nodes as nested
+         * begin and end events and the labels as thread scoped instant events, with the chunk, the depth and the
+         * label size as arguments. If the oldest events of a buffer were overwritten, the trace can contain end events
+         * without a matching begin event, which the viewers ignore.
+         */
+        void write_chrome_trace(std::ostream & stream) const {
+            stream << "{\"traceEvents\":[";
+            bool first = true;
+            for (trace_buffer const & buffer : _buffers) {
+                for (trace_event const & event : buffer.events()) {
+                    stream << (first ? "\n" : ",\n");
+                    first = false;
+                    write_event(stream, buffer.thread_id(), event);
+                }
+            }
+            stream << "\n],\"displayTimeUnit\":\"ns\",\"otherData\":{\"dropped_events\":" << dropped_count() << "}}\n";
+        }
+
+    private:
+
+        static void write_event(std::ostream & stream, std::uint32_t const thread_id, trace_event const & event) {
+            auto phase_and_name = [&] () -> std::pair<char const *, char const *> {
+                switch (event.kind) {
+                    case trace_event_kind::push: return {"B", "node"};
+                    case trace_event_kind::pop: return {"E", "node"};
+                    case trace_event_kind::label: return {"i", "label"};
+                    case trace_event_kind::task_begin: return {"B", "chunk"};
+                    default: return {"E", "chunk"};
+                }
+            };
+            auto [phase, name] = phase_and_name();
+
+            // The timestamps are given in microseconds.
+            stream << "{\"name\":\"" << name << "\",\"ph\":\"" << phase << "\",\"pid\":0,\"tid\":" << thread_id
+                   << ",\"ts\":" << event.timestamp / 1000 << '.';
+            std::uint64_t const fraction = event.timestamp % 1000;
+            stream << static_cast<char>('0' + fraction / 100)
+                   << static_cast<char>('0' + fraction / 10 % 10)
+                   << static_cast<char>('0' + fraction % 10);
+            if (event.kind == trace_event_kind::label)
+                stream << ",\"s\":\"t\"";
+            stream << ",\"args\":{\"chunk\":" << event.chunk << ",\"depth\":" << event.depth;
+            if (event.kind == trace_event_kind::label)
+                stream << ",\"size\":" << event.size;
+            stream << "}}";
+        }
+    };
+
+    /*!\brief Runs the libjst::state_oblivious_traverser while recording its events into a libjst::trace_session.
+     *
+     * \details
+     *
+     * Can be used as the traverser of the libjst::parallel_chunk_traverser to trace a chunked search. Every
+     * traversal records into the buffer of the calling thread and identifies its chunk by the source position of the
+     * root of the traversed tree. The session must outlive the traverser.
+     */
+    class traced_traverser {
+    private:
+        trace_session * _session{};
+
+    public:
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        traced_traverser() = default; //!< Default; must not be invoked.
+
+        //!\brief Records into the given session.
+        explicit traced_traverser(trace_session & session) noexcept : _session{std::addressof(session)}
+        {}
+        //!\}
+
+        template <typename tree_t, typename pattern_t, typename callback_t>
+        void operator()(tree_t && tree, pattern_t && pattern, callback_t && callback) const {
+            trace_recorder recorder = _session->local_recorder();
+            recorder.begin_task(chunk_of(tree));
+            state_oblivious_traverser{}((tree_t &&) tree, pattern, callback, recorder);
+            recorder.end_task();
+        }
+
+    private:
+
+        template <typename tree_t>
+        static std::uint64_t chunk_of(tree_t const & tree) noexcept {
+            if constexpr (requires { libjst::position(tree.root().low_boundary()); })
+                return static_cast<std::uint64_t>(libjst::position(tree.root().low_boundary()));
+            else
+                return 0;
+        }
+    };
+}  // namespace libjst
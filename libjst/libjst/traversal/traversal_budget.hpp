@@ -0,0 +1,149 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::traversal_budget to cancel a query cooperatively or after a deadline.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <stop_token>
+#include <utility>
+#include <vector>
+
+#include <cereal/types/vector.hpp>
+
+namespace libjst
+{
+    /*!\brief Bounds the runtime of a query by a stop token and a deadline.
+     *
+     * \details
+     *
+     * The traversals check the budget every libjst::traversal_budget::check_interval nodes, such that the clock is
+     * not read for every node. Once the budget is expired, it stays expired. The budget is checked concurrently by
+     * the workers of a parallel traversal, which are hence stopped together. A default constructed budget never
+     * expires.
+     */
+    class traversal_budget {
+    public:
+
+        //!\brief The clock of the deadline.
+        using clock_type = std::chrono::steady_clock;
+
+        //!\brief The default number of nodes visited between two checks.
+        static constexpr std::size_t default_check_interval{1024};
+
+    private:
+
+        std::stop_token _stop_token{};
+        clock_type::time_point _deadline{clock_type::time_point::max()};
+        std::size_t _check_interval{default_check_interval};
+        mutable std::atomic<bool> _expired{false};
+
+    public:
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        traversal_budget() = default; //!< Default.
+
+        /*!\brief Creates a budget that expires once a stop is requested on the given token.
+         *
+         * \param[in] stop_token The token of the caller, e.g. of the request or of a std::jthread.
+         * \param[in] check_interval The number of nodes between two checks; at least 1.
+         */
+        explicit traversal_budget(std::stop_token stop_token,
+                                  std::size_t const check_interval = default_check_interval) noexcept :
+            _stop_token{std::move(stop_token)},
+            _check_interval{std::max<std::size_t>(check_interval, 1)}
+        {}
+
+        /*!\brief Creates a budget that expires after the given time or once a stop is requested on the given token.
+         *
+         * \param[in] time_limit The maximal runtime of the query, counted from the construction of the budget.
+         * \param[in] stop_token The token of the caller; defaults to a token on which a stop is never requested.
+         * \param[in] check_interval The number of nodes between two checks; at least 1.
+         */
+        explicit traversal_budget(clock_type::duration const time_limit,
+                                  std::stop_token stop_token = {},
+                                  std::size_t const check_interval = default_check_interval) noexcept :
+            traversal_budget{std::move(stop_token), check_interval}
+        {
+            _deadline = clock_type::now() + time_limit;
+        }
+
+        traversal_budget(traversal_budget const &) = delete; //!< Deleted.
+        traversal_budget & operator=(traversal_budget const &) = delete; //!< Deleted.
+        ~traversal_budget() = default; //!< Defaulted.
+        //!\}
+
+        //!\brief Returns the number of nodes visited between two checks.
+        constexpr std::size_t check_interval() const noexcept {
+            return _check_interval;
+        }
+
+        //!\brief Returns the deadline of the query; `time_point::max()` if the budget has no time limit.
+        constexpr clock_type::time_point deadline() const noexcept {
+            return _deadline;
+        }
+
+        //!\brief Returns whether a stop was requested or the deadline has passed; safe to call concurrently.
+        bool expired() const noexcept {
+            if (_expired.load(std::memory_order_relaxed))
+                return true;
+
+            if (_stop_token.stop_requested() ||
+                (_deadline != clock_type::time_point::max() && clock_type::now() >= _deadline)) {
+                _expired.store(true, std::memory_order_relaxed);
+                return true;
+            }
+            return false;
+        }
+    };
+
+    /*!\brief The tasks of a parallel traversal that were not finished within the libjst::traversal_budget.
+     *
+     * \details
+     *
+     * A task is the half open interval `[begin, end)` of a chunk index or of a source interval, as handed to the
+     * callback of the libjst::parallel_chunk_traverser. Resuming from the checkpoint searches the listed tasks again.
+     */
+    struct parallel_checkpoint {
+        //!\brief An unfinished task.
+        struct task {
+            std::size_t begin{}; //!< The first chunk index or source position of the task.
+            std::size_t end{}; //!< One past the last chunk index or source position of the task.
+
+            friend constexpr bool operator==(task const &, task const &) noexcept = default;
+            friend constexpr auto operator<=>(task const &, task const &) noexcept = default;
+
+            template <typename archive_t>
+            void serialize(archive_t & archive)
+            {
+                archive(begin, end);
+            }
+        };
+
+        std::vector<task> tasks{}; //!< The unfinished tasks in ascending order.
+
+        //!\brief Returns whether all tasks were finished.
+        constexpr bool empty() const noexcept {
+            return tasks.empty();
+        }
+
+        template <typename archive_t>
+        void serialize(archive_t & archive)
+        {
+            archive(tasks);
+        }
+    };
+}  // namespace libjst
@@ -0,0 +1,65 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::traversal_checkpoint.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <vector>
+
+#include <cereal/types/vector.hpp>
+
+#include <libjst/sequence_tree/seek_position.hpp>
+
+namespace libjst
+{
+    //!\brief The matcher state of a libjst::traversal_checkpoint that does not store one.
+    struct no_matcher_state {
+        template <typename archive_t>
+        void serialize(archive_t &) const noexcept
+        {}
+
+        friend constexpr bool operator==(no_matcher_state const &, no_matcher_state const &) noexcept = default;
+    };
+
+    /*!\brief A snapshot of a traversal of a seekable tree from which the traversal can be resumed.
+     *
+     * \tparam matcher_state_t The type of the captured matcher state; defaults to libjst::no_matcher_state.
+     *
+     * \details
+     *
+     * The frontier stores the seek positions of the nodes on the branch stack of a libjst::tree_traverser_base, from
+     * the bottom to the active node. Together with the state of the matcher captured at the same time, this is all
+     * that is needed to continue the traversal on another process, since the nodes are reconstructed from the
+     * seek positions by the seekable tree. The checkpoint is serialisable with cereal.
+     */
+    template <typename matcher_state_t = no_matcher_state>
+    struct traversal_checkpoint {
+        std::vector<seek_position> frontier{}; //!< The seek positions of the branch, from the bottom to the top.
+        matcher_state_t matcher_state{}; //!< The captured matcher state.
+
+        //!\brief Returns whether the checkpoint was taken after the traversal was finished.
+        constexpr bool empty() const noexcept {
+            return frontier.empty();
+        }
+
+        template <typename archive_t>
+        void save(archive_t & oarchive) const
+        {
+            oarchive(frontier, matcher_state);
+        }
+
+        template <typename archive_t>
+        void load(archive_t & iarchive)
+        {
+            iarchive(frontier, matcher_state);
+        }
+    };
+}  // namespace libjst
@@ -0,0 +1,359 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::traversal_planner choosing the traverser of a search from a cost model.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <ostream>
+#include <ranges>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <libjst/coverage/concept.hpp>
+#include <libjst/matcher/concept.hpp>
+#include <libjst/rcms/interior_breakends.hpp>
+#include <libjst/sequence_tree/stats.hpp>
+#include <libjst/sequence_tree/stats_estimator.hpp>
+#include <libjst/traversal/state_capture_traverser.hpp>
+#include <libjst/traversal/state_oblivious_traverser.hpp>
+#include <libjst/utility/memory_usage.hpp>
+#include <libjst/variant/concept.hpp>
+
+namespace libjst
+{
+    //!\brief The traversers a libjst::traversal_planner chooses from.
+    enum class traverser_kind : uint8_t {
+        state_oblivious, //!< libjst::state_oblivious_traverser, which rescans the left extension of every node.
+        state_capture //!< libjst::state_capture_traverser, which captures and restores the matcher state per branch.
+    };
+
+    //!\brief How the unsupported variants are pruned, see libjst::prune_unsupported.
+    enum class coverage_strategy : uint8_t {
+        intersect, //!< Intersects the coverage of every variant with the path coverage.
+        block_summary //!< Skips the blocks of a libjst::coverage_block_summary not sharing a haplotype with the path.
+    };
+
+    template <typename char_t, typename char_traits_t = std::char_traits<char_t>>
+    inline std::basic_ostream<char_t, char_traits_t> & operator<<(std::basic_ostream<char_t, char_traits_t> & stream,
+                                                                traverser_kind const kind) {
+        using namespace std::literals;
+        return stream << ((kind == traverser_kind::state_capture) ? "state_capture"sv : "state_oblivious"sv);
+    }
+
+    template <typename char_t, typename char_traits_t = std::char_traits<char_t>>
+    inline std::basic_ostream<char_t, char_traits_t> & operator<<(std::basic_ostream<char_t, char_traits_t> & stream,
+                                                                coverage_strategy const strategy) {
+        using namespace std::literals;
+        return stream << ((strategy == coverage_strategy::block_summary) ? "block_summary"sv : "intersect"sv);
+    }
+
+    /*!\brief The statistics of a store the cost model of the libjst::traversal_planner is based on.
+     *
+     * \details
+     *
+     * The counts are taken from the low breakends between the sentinels. The tree stats are estimated with the
+     * libjst::stats_estimator for the tree trimmed to the window of the matcher, which is the tree both traversers
+     * search, and are sampled by default to keep the profiling cheap compared to the search.
+     */
+    struct store_profile {
+        //!\brief The default fraction of the subtrees walked by the libjst::stats_estimator.
+        static constexpr double default_sample_rate{0.1};
+
+        std::size_t source_size{}; //!< The number of source symbols.
+        std::size_t haplotype_count{}; //!< The number of haplotypes.
+        std::size_t variant_count{}; //!< The number of variants.
+        std::size_t indel_count{}; //!< The number of variants changing the length of the haplotypes.
+        double mean_carrier_fraction{}; //!< The mean fraction of the haplotypes carrying a variant.
+        tree_stats tree{}; //!< The estimated stats of the tree trimmed to the window.
+
+        //!\brief Returns the number of variants per source symbol.
+        double density() const noexcept {
+            return (source_size > 0) ? static_cast<double>(variant_count) / static_cast<double>(source_size) : 0.0;
+        }
+
+        //!\brief Returns the fraction of the variants that change the length of the haplotypes.
+        double indel_fraction() const noexcept {
+            return (variant_count > 0) ? static_cast<double>(indel_count) / static_cast<double>(variant_count) : 0.0;
+        }
+
+        //!\brief Returns the mean depth of the estimated alternate subtrees.
+        double mean_subtree_depth() const noexcept {
+            if (tree.subtree_depths.empty())
+                return 0.0;
+
+            return std::accumulate(tree.subtree_depths.begin(), tree.subtree_depths.end(), 0.0) /
+                   static_cast<double>(tree.subtree_depths.size());
+        }
+
+        //!\brief Profiles the store for matchers of the given window size.
+        template <typename rcs_store_t>
+        static store_profile of(rcs_store_t const & rcs_store,
+                                std::size_t const window_size,
+                                double const sample_rate = default_sample_rate) {
+            store_profile profile{.source_size = std::ranges::size(rcs_store.source()),
+                                  .haplotype_count = static_cast<std::size_t>(rcs_store.size())};
+
+            double carrier_sum{};
+            for (auto && breakend : libjst::interior_breakends(rcs_store.variants())) {
+                if (breakend.get_breakpoint_end() != breakpoint_end::low)
+                    continue;
+
+                ++profile.variant_count;
+                profile.indel_count += libjst::breakpoint_span(libjst::get_breakpoint(breakend)) !=
+                                       std::ranges::size(libjst::alt_sequence(breakend));
+                auto const & coverage = libjst::coverage(breakend);
+                carrier_sum += static_cast<double>(libjst::coverage_intersection_count(coverage, coverage));
+            }
+
+            if (profile.variant_count > 0 && profile.haplotype_count > 0)
+                profile.mean_carrier_fraction = carrier_sum / static_cast<double>(profile.variant_count) /
+                                                static_cast<double>(profile.haplotype_count);
+
+            profile.tree = stats_estimator{std::max<std::size_t>(window_size, 1) - 1, sample_rate}(rcs_store);
+            return profile;
+        }
+    };
+
+    //!\brief The traits of a matcher the cost model of the libjst::traversal_planner is based on.
+    struct matcher_profile {
+        std::size_t window_size{}; //!< The window size of the matcher.
+        std::size_t state_size{}; //!< The bytes of a captured state, including the memory it owns.
+        bool captures_state{}; //!< Whether the matcher can be searched by the libjst::state_capture_traverser.
+
+        //!\brief Profiles the matcher; the state size is measured on the state captured from the matcher.
+        template <window_matcher matcher_t>
+        static matcher_profile of(matcher_t const & matcher) {
+            matcher_profile profile{.window_size = static_cast<std::size_t>(libjst::window_size(matcher))};
+            if constexpr (state_capturing_matcher<matcher_t>) {
+                auto const state = matcher.capture();
+                profile.captures_state = true;
+                profile.state_size = sizeof(state) + libjst::memory_usage(state);
+            }
+            return profile;
+        }
+    };
+
+    /*!\brief The traverser, coverage strategy and chunking chosen by the libjst::traversal_planner.
+     *
+     * \details
+     *
+     * The plan keeps the estimated costs in scanned symbols and the reasons for every choice, which explain returns
+     * as text. The traverser is applied with libjst::planned_traverser, e.g. as the traverser of a
+     * libjst::parallel_chunk_traverser over a libjst::chunked_tree with the planned chunk size. The coverage strategy
+     * is a recommendation for custom adaptor stacks, e.g. `prune_unsupported(summary)` with a
+     * libjst::coverage_block_summary, since both traversers build their own stack.
+     */
+    struct traversal_plan {
+        traverser_kind traverser{traverser_kind::state_oblivious}; //!< The chosen traverser.
+        coverage_strategy coverage{coverage_strategy::intersect}; //!< The recommended coverage strategy.
+        std::size_t chunk_count{1}; //!< The number of chunks searched in parallel.
+        std::size_t chunk_size{}; //!< The number of source positions per chunk.
+        double oblivious_cost{}; //!< The estimated symbols scanned by the libjst::state_oblivious_traverser.
+        double capture_cost{}; //!< The estimated cost of the libjst::state_capture_traverser in scanned symbols.
+        std::vector<std::string> reasons{}; //!< Why the traverser, the coverage strategy and the chunks were chosen.
+
+        //!\brief Returns the choices and their reasons, one per line.
+        std::string explain() const {
+            std::ostringstream stream{};
+            stream << "traverser: " << traverser << '\n'
+                   << "coverage: " << coverage << '\n'
+                   << "chunks: " << chunk_count << " of " << chunk_size << " positions\n";
+            for (std::string const & reason : reasons)
+                stream << "  - " << reason << '\n';
+            return std::move(stream).str();
+        }
+    };
+
+    /*!\brief Chooses the traverser, the coverage strategy and the chunking of a search from a cost model.
+     *
+     * \details
+     *
+     * The cost model counts the scanned symbols of the estimated tree, see libjst::store_profile, with `N` nodes and
+     * `S` label symbols for a window of `w` symbols:
+     *
+     *  * The libjst::state_oblivious_traverser scans every label after a left extension of `w - 1` symbols, i.e.
+     *    `S + N * (w - 1)` symbols.
+     *  * The libjst::state_capture_traverser scans every label once, but captures the matcher state when a node is
+     *    pushed and restores it when it is popped, i.e. `S + 2 * N * state_size / state_bytes_per_symbol`, where
+     *    copying state_bytes_per_symbol bytes is about as expensive as scanning one symbol. It is only chosen for
+     *    matchers that capture their state.
+     *
+     * Hence small windows and large states favour the oblivious traverser, e.g. the bit-parallel matchers of short
+     * patterns, while long windows with small states favour the capture traverser, especially in dense stores with
+     * many nodes.
+     *
+     * The chunk count balances the boundary work of a chunk, i.e. one window, against the idle threads when the last
+     * chunks are searched, like libjst::shard_planner::tune: `sqrt(W * T / w)` chunks for the estimated work `W` on
+     * `T` threads, at least `T` and at most one chunk per window of the source. A single thread searches one chunk.
+     *
+     * The libjst::coverage_block_summary is recommended if the variants are rare, such that the union of the
+     * coverages of a block of block_summary_size variants is expected to cover less than max_block_fraction of the
+     * haplotypes, and the subtrees nest several variants, which can then be skipped by block.
+     */
+    class traversal_planner {
+    private:
+
+        std::size_t _thread_count{1};
+
+    public:
+
+        //!\brief The bytes of a matcher state copied in the time a symbol is scanned.
+        static constexpr double state_bytes_per_symbol{16.0};
+        //!\brief The number of breakends per block of the recommended libjst::coverage_block_summary.
+        static constexpr std::size_t block_summary_size{64};
+        //!\brief The largest fraction of the haplotypes covered by a block for which the summary is recommended.
+        static constexpr double max_block_fraction{0.5};
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        traversal_planner() = default; //!< Default.
+
+        //!\brief Plans the search on the given number of threads.
+        explicit traversal_planner(std::size_t const thread_count) noexcept :
+            _thread_count{std::max<std::size_t>(thread_count, 1)}
+        {}
+        //!\}
+
+        //!\brief Returns the plan for the profiled store and matcher.
+        traversal_plan operator()(store_profile const & store, matcher_profile const & matcher) const {
+            traversal_plan plan{};
+            std::size_t const window_size = std::max<std::size_t>(matcher.window_size, 1);
+            double const node_count = static_cast<double>(std::max<std::size_t>(store.tree.node_count, 1));
+            double const symbol_count = static_cast<double>(store.tree.symbol_count);
+
+            plan.oblivious_cost = symbol_count + node_count * static_cast<double>(window_size - 1);
+            plan.capture_cost = symbol_count +
+                                2.0 * node_count * static_cast<double>(matcher.state_size) / state_bytes_per_symbol;
+            choose_traverser(plan, store, matcher);
+            choose_coverage(plan, store);
+            choose_chunks(plan, store, window_size);
+            return plan;
+        }
+
+        //!\brief Profiles the store and the matcher and returns the plan.
+        template <typename rcs_store_t, window_matcher matcher_t>
+        traversal_plan operator()(rcs_store_t const & rcs_store, matcher_t const & matcher) const {
+            matcher_profile const profiled_matcher = matcher_profile::of(matcher);
+            return (*this)(store_profile::of(rcs_store, profiled_matcher.window_size), profiled_matcher);
+        }
+
+        //!\brief Returns the number of threads the search is planned for.
+        constexpr std::size_t thread_count() const noexcept {
+            return _thread_count;
+        }
+
+    private:
+
+        static void choose_traverser(traversal_plan & plan, store_profile const & store, matcher_profile const & matcher) {
+            std::ostringstream reason{};
+            reason << "estimated cost " << plan.oblivious_cost << " symbols for state_oblivious (window "
+                   << matcher.window_size << ", " << store.tree.node_count << " nodes)";
+            if (!matcher.captures_state) {
+                plan.traverser = traverser_kind::state_oblivious;
+                reason << "; the matcher cannot capture its state";
+            } else {
+                plan.traverser = (plan.capture_cost < plan.oblivious_cost) ? traverser_kind::state_capture
+                                                                           : traverser_kind::state_oblivious;
+                reason << " vs. " << plan.capture_cost << " for state_capture (state of " << matcher.state_size
+                       << " bytes)";
+            }
+            plan.reasons.push_back(std::move(reason).str());
+        }
+
+        static void choose_coverage(traversal_plan & plan, store_profile const & store) {
+            // The expected fraction of the haplotypes covered by the union of a block of independent variants.
+            double const block_fraction = 1.0 - std::pow(1.0 - store.mean_carrier_fraction,
+                                                         static_cast<double>(block_summary_size));
+            double const subtree_depth = store.mean_subtree_depth();
+            bool const use_summary = block_fraction < max_block_fraction && subtree_depth > 1.0;
+            plan.coverage = use_summary ? coverage_strategy::block_summary : coverage_strategy::intersect;
+
+            std::ostringstream reason{};
+            reason << "a block of " << block_summary_size << " variants covers about " << 100.0 * block_fraction
+                   << "% of the haplotypes and the subtrees have a mean depth of " << subtree_depth
+                   << (use_summary ? ", such that most blocks are skipped" : ", such that few blocks are skipped");
+            plan.reasons.push_back(std::move(reason).str());
+        }
+
+        void choose_chunks(traversal_plan & plan, store_profile const & store, std::size_t const window_size) const {
+            double const work = (plan.traverser == traverser_kind::state_capture) ? plan.capture_cost
+                                                                                  : plan.oblivious_cost;
+            std::size_t const max_chunks = std::max<std::size_t>(store.source_size / window_size, 1);
+            std::size_t chunk_count{1};
+            if (_thread_count > 1) {
+                double const tuned = std::sqrt(work * static_cast<double>(_thread_count) /
+                                               static_cast<double>(window_size));
+                chunk_count = std::max(static_cast<std::size_t>(std::llround(tuned)), _thread_count);
+            }
+            plan.chunk_count = std::min(chunk_count, max_chunks);
+            plan.chunk_size = (store.source_size + plan.chunk_count - 1) / plan.chunk_count;
+
+            std::ostringstream reason{};
+            reason << plan.chunk_count << " chunks balance the boundary work of " << window_size
+                   << " symbols per chunk against idle threads for " << work << " symbols on " << _thread_count
+                   << " threads";
+            plan.reasons.push_back(std::move(reason).str());
+        }
+    };
+
+    /*!\brief Applies the traverser chosen by a libjst::traversal_plan.
+     *
+     * \details
+     *
+     * Dispatches every search to the libjst::state_capture_traverser or the libjst::state_oblivious_traverser, such
+     * that it can replace the traverser of a libjst::parallel_chunk_traverser. Matchers that cannot capture their
+     * state are always searched by the libjst::state_oblivious_traverser.
+     */
+    class planned_traverser {
+    private:
+
+        traverser_kind _kind{traverser_kind::state_oblivious};
+
+    public:
+
+        planned_traverser() = default; //!< Default.
+
+        //!\brief Applies the traverser of the given plan.
+        explicit planned_traverser(traversal_plan const & plan) noexcept : _kind{plan.traverser}
+        {}
+
+        template <typename tree_t, typename pattern_t, typename callback_t, observable_stack ...subscriber_ts>
+        constexpr void operator()(tree_t && tree,
+                                  pattern_t && pattern,
+                                  callback_t && callback,
+                                  subscriber_ts & ...subscribers) const {
+            if constexpr (state_capturing_matcher<std::remove_cvref_t<pattern_t>>) {
+                if (_kind == traverser_kind::state_capture) {
+                    state_capture_traverser{}((tree_t &&) tree, (pattern_t &&) pattern, (callback_t &&) callback,
+                                              subscribers...);
+                    return;
+                }
+            }
+            state_oblivious_traverser{}((tree_t &&) tree, (pattern_t &&) pattern, (callback_t &&) callback,
+                                        subscribers...);
+        }
+
+        //!\brief Returns the applied traverser.
+        constexpr traverser_kind kind() const noexcept {
+            return _kind;
+        }
+    };
+}  // namespace libjst
@@ -0,0 +1,301 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::tree_skeleton caching the searched labels of a tree for a fixed window size.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <cereal/types/vector.hpp>
+
+#include <libjst/matcher/concept.hpp>
+#include <libjst/sequence_tree/coloured_tree.hpp>
+#include <libjst/sequence_tree/concept.hpp>
+#include <libjst/sequence_tree/labelled_tree.hpp>
+#include <libjst/sequence_tree/left_extend_tree.hpp>
+#include <libjst/sequence_tree/merge_tree.hpp>
+#include <libjst/sequence_tree/prune_unsupported.hpp>
+#include <libjst/sequence_tree/seek_position.hpp>
+#include <libjst/sequence_tree/seekable_tree.hpp>
+#include <libjst/sequence_tree/trim_tree.hpp>
+#include <libjst/traversal/tree_traverser_base.hpp>
+
+namespace libjst
+{
+    namespace detail
+    {
+        // Applies the adaptors of the libjst::state_oblivious_traverser and makes the nodes seekable.
+        template <typename tree_t>
+        constexpr auto skeleton_tree(tree_t && tree, std::size_t const window_size) {
+            return tree | libjst::labelled()
+                        | libjst::coloured()
+                        | trim(window_size - 1)
+                        | prune_unsupported()
+                        | left_extend(window_size - 1)
+                        | merge()
+                        | libjst::seek();
+        }
+    } // namespace detail
+
+    /*!\brief The labels the libjst::state_oblivious_traverser searches for a fixed window size, stored as an array.
+     *
+     * \tparam symbol_t The type of the symbols of the labels.
+     * \tparam coverage_t The type of the coverage of the labels.
+     *
+     * \details
+     *
+     * The trimmed, pruned, left extended and merged tree depends on the window size of the matcher, but not on the
+     * pattern. The skeleton is built by libjst::build_tree_skeleton, which traverses this tree once and appends every
+     * label to one symbol array. A node stores the range of its label within the array, its coverage and its seek
+     * position, such that a node can still be located in the tree, e.g. to extend a hit beyond the label, see
+     * libjst::tree_skeleton::search_tree. The coverages of consecutive nodes with the same coverage are stored once.
+     *
+     * Searching the skeleton with libjst::skeleton_traverser scans the labels in the order of the traversal, which
+     * replaces the adaptor pipeline and the branch stack of every search by a linear scan over the array, and
+     * reports the same hits as the libjst::state_oblivious_traverser for every matcher with the window size of the
+     * skeleton. The left extensions are stored with every label, hence the skeleton holds `S + N * (w - 1)` symbols
+     * for `N` nodes with `S` label symbols and a window of `w` symbols. The skeleton can be serialised to build it
+     * once per store and window size.
+     */
+    template <typename symbol_t, typename coverage_t>
+    class tree_skeleton {
+    public:
+
+        //!\brief A node of the skeleton.
+        struct node_type {
+            uint64_t first{}; //!< The first symbol of the label within the symbol array.
+            uint32_t size{}; //!< The number of symbols of the label, including the left extension.
+            uint32_t coverage{}; //!< The index of the coverage of the node.
+
+            constexpr friend bool operator==(node_type const &, node_type const &) noexcept = default;
+
+            template <typename archive_t>
+            void serialize(archive_t & archive) {
+                archive(first, size, coverage);
+            }
+        };
+
+        class label_type;
+
+    private:
+
+        std::size_t _window_size{1};
+        std::vector<symbol_t> _symbols{};
+        std::vector<node_type> _nodes{};
+        std::vector<seek_position> _positions{};
+        std::vector<coverage_t> _coverages{};
+
+    public:
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        tree_skeleton() = default; //!< Default.
+
+        /*!\brief Constructs the skeleton of the given tree, see libjst::build_tree_skeleton.
+         *
+         * \param[in] tree The tree to build the skeleton of.
+         * \param[in] window_size The window size of the matchers searching the skeleton.
+         *
+         * \details
+         *
+         * Throws std::invalid_argument if the window size is zero.
+         */
+        template <typename tree_t>
+        tree_skeleton(tree_t && tree, std::size_t const window_size) : _window_size{window_size}
+        {
+            if (window_size == 0)
+                throw std::invalid_argument{"The window size of a tree skeleton must not be zero."};
+
+            auto skeleton_tree = search_tree((tree_t &&)tree);
+            tree_traverser_base<decltype(skeleton_tree)> path{skeleton_tree};
+            path.reserve(window_size);
+            for (auto it = path.begin(); it != path.end(); ++it) {
+                auto && label = *it;
+                auto && sequence = label.sequence();
+                node_type node{.first = _symbols.size(), .size = static_cast<uint32_t>(std::ranges::size(sequence))};
+                _symbols.insert(_symbols.end(), std::ranges::begin(sequence), std::ranges::end(sequence));
+
+                if (_coverages.empty() || !(_coverages.back() == label.coverage()))
+                    _coverages.emplace_back(label.coverage());
+                node.coverage = static_cast<uint32_t>(_coverages.size() - 1);
+                _nodes.push_back(node);
+                _positions.push_back(label.position());
+            }
+        }
+        //!\}
+
+        //!\brief Returns the window size the skeleton was built for.
+        constexpr std::size_t window_size() const noexcept {
+            return _window_size;
+        }
+
+        //!\brief Returns the number of nodes.
+        constexpr std::size_t size() const noexcept {
+            return _nodes.size();
+        }
+
+        //!\brief Returns the number of stored symbols.
+        constexpr std::size_t symbol_count() const noexcept {
+            return _symbols.size();
+        }
+
+        //!\brief Returns the number of stored coverages.
+        constexpr std::size_t coverage_count() const noexcept {
+            return _coverages.size();
+        }
+
+        //!\brief Returns the nodes in the order of the traversal.
+        std::span<node_type const> nodes() const noexcept {
+            return _nodes;
+        }
+
+        //!\brief Returns the label of the node with the given index.
+        label_type label(std::size_t const node) const noexcept {
+            assert(node < size());
+            return label_type{this, node};
+        }
+
+        /*!\brief Adapts the tree the skeleton was built from to the tree the seek positions refer to.
+         *
+         * \details
+         *
+         * The returned tree applies the same adaptors as the construction of the skeleton and is seekable.
+         */
+        template <typename tree_t>
+        constexpr auto search_tree(tree_t && tree) const {
+            return detail::skeleton_tree((tree_t &&)tree, _window_size);
+        }
+
+        // ----------------------------------------------------------------------------
+        // Serialisation
+        // ----------------------------------------------------------------------------
+
+        template <typename archive_t>
+        void load(archive_t & iarchive)
+        {
+            iarchive(_window_size, _symbols, _nodes, _positions, _coverages);
+        }
+
+        template <typename archive_t>
+        void save(archive_t & oarchive) const
+        {
+            oarchive(_window_size, _symbols, _nodes, _positions, _coverages);
+        }
+    };
+
+    /*!\brief The label of a node of a libjst::tree_skeleton.
+     *
+     * \details
+     *
+     * Offers the sequence, the coverage and the seek position of the node, like the labels of the trees searched by
+     * the libjst::state_oblivious_traverser. The label refers to the skeleton, which must outlive it.
+     */
+    template <typename symbol_t, typename coverage_t>
+    class tree_skeleton<symbol_t, coverage_t>::label_type {
+    private:
+
+        friend tree_skeleton;
+
+        tree_skeleton const * _skeleton{};
+        std::size_t _node{};
+
+        constexpr label_type(tree_skeleton const * skeleton, std::size_t const node) noexcept :
+            _skeleton{skeleton},
+            _node{node}
+        {}
+
+    public:
+
+        label_type() = default; //!< Default.
+
+        //!\brief Returns the symbols of the label, including the left extension.
+        std::span<symbol_t const> sequence() const noexcept {
+            node_type const & node = _skeleton->_nodes[_node];
+            return std::span<symbol_t const>{_skeleton->_symbols}.subspan(node.first, node.size);
+        }
+
+        //!\brief Returns the haplotypes sharing the label.
+        constexpr coverage_t const & coverage() const noexcept {
+            return _skeleton->_coverages[_skeleton->_nodes[_node].coverage];
+        }
+
+        //!\brief Returns the seek position of the node, see libjst::tree_skeleton::search_tree.
+        constexpr seek_position const & position() const noexcept {
+            return _skeleton->_positions[_node];
+        }
+
+        //!\brief Returns the index of the node within the skeleton.
+        constexpr std::size_t node() const noexcept {
+            return _node;
+        }
+    };
+
+    /*!\brief Builds the libjst::tree_skeleton of the given tree in a single traversal.
+     *
+     * \param[in] tree The tree to build the skeleton of, e.g. a libjst::volatile_tree of a store or a chunk.
+     * \param[in] window_size The window size of the matchers searching the skeleton.
+     */
+    template <typename tree_t>
+    auto build_tree_skeleton(tree_t && tree, std::size_t const window_size) {
+        using skeleton_tree_t = decltype(detail::skeleton_tree((tree_t &&)tree, window_size));
+        using label_t = libjst::tree_label_t<skeleton_tree_t>;
+        using symbol_t = std::ranges::range_value_t<decltype(std::declval<label_t const &>().sequence())>;
+        using coverage_t = std::remove_cvref_t<decltype(std::declval<label_t const &>().coverage())>;
+        return tree_skeleton<symbol_t, coverage_t>{(tree_t &&)tree, window_size};
+    }
+
+    /*!\brief Searches the pattern in the labels of a libjst::tree_skeleton.
+     *
+     * \details
+     *
+     * Every label is searched on its own, like by the libjst::state_oblivious_traverser, and the callback is invoked
+     * with the hit and the libjst::tree_skeleton::label_type of the node. Patterns offering `reset()` are reset before
+     * every label. Throws std::invalid_argument if the window size of the pattern differs from the window size of the
+     * skeleton, since the left extensions and the trimmed branches of the skeleton only fit this window size.
+     */
+    struct skeleton_traverser {
+        template <typename symbol_t, typename coverage_t, window_matcher pattern_t, typename callback_t>
+        constexpr void operator()(tree_skeleton<symbol_t, coverage_t> const & skeleton,
+                                  pattern_t && pattern,
+                                  callback_t && callback) const {
+            if (skeleton.size() == 0)
+                return;
+            if (static_cast<std::size_t>(libjst::window_size(pattern)) != skeleton.window_size())
+                throw std::invalid_argument{"The window size of the pattern must match the window size of the "
+                                            "tree skeleton."};
+
+            for (std::size_t node = 0; node < skeleton.size(); ++node) {
+                auto const label = skeleton.label(node);
+                reset_state(pattern);
+                pattern(label.sequence(), [&] (auto && label_it) {
+                    callback(std::move(label_it), label);
+                });
+            }
+        }
+
+    private:
+
+        template <typename pattern_t>
+        static constexpr void reset_state(pattern_t & pattern) {
+            if constexpr (requires { pattern.reset(); })
+                pattern.reset();
+        }
+    };
+}  // namespace libjst
@@ -12,29 +12,71 @@
 
 #pragma once
 
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <ranges>
 #include <stack>
+#include <utility>
+#include <vector>
 
+#include <libjst/matcher/concept.hpp>
+#include <libjst/sequence_tree/seek_position.hpp>
 #include <libjst/traversal/stack_publisher.hpp>
+#include <libjst/traversal/traversal_budget.hpp>
+#include <libjst/traversal/traversal_checkpoint.hpp>
 namespace libjst
 {
     // Can we add subscription to the tree directly!?
-    template <typename tree_t>
-    class tree_traverser_base : public stack_publisher {
+    // The allocator_t allocates the stack of the nodes on the current branch.
+    // The publisher_t notifies the subscribers about the pushed and popped nodes; a libjst::static_stack_publisher
+    // inlines the notifications into the traversal.
+    // The branch is a stack over a contiguous buffer, whose slots are reused by the nodes pushed after a pop. It
+    // grows on demand, but reserve() allocates it once for the expected depth, e.g. the window of a trimmed tree.
+    // For seekable trees, set_memory_budget() bounds the nodes held on the branch; the pending nodes beyond the
+    // budget are spilled as seek positions and sought again when the traversal backtracks to them.
+    // set_budget() stops the traversal once a libjst::traversal_budget expires, see interrupted().
+    template <typename tree_t, typename allocator_t = std::allocator<std::byte>, typename publisher_t = stack_publisher>
+    class tree_traverser_base : public publisher_t {
     private:
         using node_type = libjst::tree_node_t<tree_t>;
-        using branch_type = std::stack<node_type>;
+        using node_allocator_type = typename std::allocator_traits<allocator_t>::template rebind_alloc<node_type>;
+        using branch_base_type = std::stack<node_type, std::vector<node_type, node_allocator_type>>;
+
+        // Exposes the nodes of the branch to take a checkpoint.
+        struct branch_type : public branch_base_type {
+            using branch_base_type::c;
+        };
 
         std::reference_wrapper<tree_t const> _tree;
         branch_type _branch{};
+        std::vector<seek_position> _spilled{}; // the bottom of the branch, spilled by the memory budget
+        std::size_t _memory_budget{std::numeric_limits<std::size_t>::max()};
+        std::size_t _node_cost{};
+        std::size_t _spill_count{};
+        traversal_budget const * _budget{};
+        std::size_t _unchecked_nodes{};
+        bool _interrupted{false};
+        bool _resumed{false};
 
         class sentinel;
         class iterator;
 
+        static constexpr bool is_seekable_v = requires (node_type const & node, tree_t const & tree) {
+            { (*node).position() } -> std::convertible_to<seek_position>;
+            { tree.seek((*node).position()) } -> std::convertible_to<node_type>;
+        };
+
     public:
         explicit tree_traverser_base(tree_t const & tree) noexcept : _tree{std::cref(tree)}
         {}
         explicit tree_traverser_base(tree_t && tree) noexcept = delete;
 
+        tree_traverser_base(tree_t const & tree, publisher_t publisher) noexcept :
+            publisher_t{std::move(publisher)},
+            _tree{std::cref(tree)}
+        {}
+
         constexpr iterator begin() noexcept {
             return iterator{*this};
         }
@@ -42,10 +84,186 @@ namespace libjst
         sentinel end() noexcept {
             return sentinel{*this};
         }
+
+        /*!\brief Allocates the branch stack for the given number of nodes.
+         *
+         * \details
+         *
+         * The branch holds the active node and the pending reference children of the alternate nodes above it,
+         * whose number is in the order of the window size for a tree trimmed to the window of a pattern. The stack
+         * still grows beyond the reserved depth if needed.
+         */
+        void reserve(std::size_t const depth) {
+            _branch.c.reserve(depth);
+        }
+
+        //!\brief Returns the number of bytes allocated for the branch stack, which bounds its peak size.
+        std::size_t memory_usage() const noexcept {
+            return _branch.c.capacity() * sizeof(node_type) + _spilled.capacity() * sizeof(seek_position);
+        }
+
+        /*!\name Memory budget
+         * \brief Bounds the memory of the branch of a seekable tree, e.g. `tree | libjst::seek()`.
+         *
+         * \details
+         *
+         * Clusters of overlapping variants can make the branch of a subtree very deep, and every node on the branch
+         * holds its label buffer and its coverage. If the nodes held on the branch exceed the budget, the lower half
+         * of the pending nodes is replaced by their seek positions. When the traversal backtracks to a spilled node,
+         * the node is sought again in the tree, which recomputes its label and coverage. The subscribers are not
+         * notified about spilling, since the spilled nodes remain on the branch. The cost of a node is estimated
+         * from the first node of the traversal as its size plus one bit per haplotype of its coverage. The active
+         * node is always held, hence the budget is a soft bound for budgets below the cost of two nodes.
+         * \{
+         */
+        //!\brief Sets the number of bytes the nodes held on the branch may occupy; unlimited by default.
+        void set_memory_budget(std::size_t const bytes) noexcept requires is_seekable_v {
+            _memory_budget = bytes;
+        }
+
+        //!\brief Returns the memory budget of the branch in bytes.
+        std::size_t memory_budget() const noexcept {
+            return _memory_budget;
+        }
+
+        //!\brief Returns the number of nodes spilled so far.
+        std::size_t spill_count() const noexcept {
+            return _spill_count;
+        }
+        //!\}
+
+        /*!\name Time budget
+         * \{
+         */
+        /*!\brief Stops the traversal once the given budget expires.
+         *
+         * \details
+         *
+         * The budget is checked after every libjst::traversal_budget::check_interval advanced nodes. Once it has
+         * expired, the iterator compares equal to the sentinel and interrupted() returns true. The active node has
+         * not been reported then, hence the checkpoint of a seekable tree resumes the traversal with the next node.
+         * The budget must outlive the traversal.
+         */
+        void set_budget(traversal_budget const & budget) noexcept {
+            _budget = std::addressof(budget);
+        }
+
+        //!\brief Returns whether the traversal was stopped by the budget before all nodes were visited.
+        bool interrupted() const noexcept {
+            return _interrupted;
+        }
+        //!\}
+
+        /*!\name Checkpoints
+         * \brief Snapshots and resumes the traversal of a seekable tree, e.g. `tree | libjst::seek()`.
+         *
+         * \details
+         *
+         * A checkpoint stores the seek positions of the current branch, whose top is the active node. After resuming
+         * from the checkpoint, begin() returns an iterator to the active node of the checkpoint, which is hence
+         * visited again; a checkpoint taken before the active node is processed resumes the traversal without
+         * reporting any node twice. Resuming reconstructs every node by seeking it in the tree and notifies the
+         * subscribers about the pushed nodes. The matcher state can be captured and restored along with the branch.
+         * \{
+         */
+        //!\brief Returns the checkpoint of the current branch.
+        traversal_checkpoint<> checkpoint() const requires is_seekable_v {
+            traversal_checkpoint<> snapshot{};
+            snapshot.frontier.reserve(_spilled.size() + _branch.size());
+            snapshot.frontier.insert(snapshot.frontier.end(), _spilled.begin(), _spilled.end());
+            for (node_type const & node : _branch.c)
+                snapshot.frontier.push_back((*node).position());
+            return snapshot;
+        }
+
+        //!\brief Returns the checkpoint of the current branch and the captured state of the given matcher.
+        template <typename matcher_t>
+            requires is_seekable_v && state_capturing_matcher<matcher_t>
+        auto checkpoint(matcher_t const & matcher) const -> traversal_checkpoint<matcher_state_t<matcher_t>> {
+            traversal_checkpoint<matcher_state_t<matcher_t>> snapshot{};
+            snapshot.frontier = checkpoint().frontier;
+            snapshot.matcher_state = matcher.capture();
+            return snapshot;
+        }
+
+        //!\brief Replaces the current branch with the one of the given checkpoint.
+        template <typename matcher_state_t>
+            requires is_seekable_v
+        void resume(traversal_checkpoint<matcher_state_t> const & snapshot) {
+            _interrupted = false;
+            for (; !_spilled.empty(); _spilled.pop_back())
+                this->notify_pop();
+            while (!_branch.empty()) {
+                _branch.pop();
+                this->notify_pop();
+            }
+
+            for (seek_position const & position : snapshot.frontier) {
+                _branch.push(_tree.get().seek(position));
+                this->notify_push();
+            }
+            _resumed = true;
+        }
+
+        //!\brief Replaces the current branch with the one of the given checkpoint and restores the matcher state.
+        template <typename matcher_t>
+            requires is_seekable_v && state_capturing_matcher<matcher_t>
+        void resume(traversal_checkpoint<matcher_state_t<matcher_t>> const & snapshot, matcher_t & matcher) {
+            resume(snapshot);
+            matcher.restore(snapshot.matcher_state);
+        }
+        //!\}
+
+    private:
+
+        // Checks the budget after every check interval of advanced nodes.
+        void check_budget() noexcept {
+            if (_budget == nullptr || _branch.empty() || ++_unchecked_nodes < _budget->check_interval())
+                return;
+
+            _unchecked_nodes = 0;
+            _interrupted = _budget->expired();
+        }
+
+        // Spills the lower half of the pending nodes if the held nodes exceed the budget.
+        void spill_if_needed() {
+            if constexpr (is_seekable_v) {
+                if (_memory_budget == std::numeric_limits<std::size_t>::max())
+                    return;
+                if (_node_cost == 0)
+                    _node_cost = node_cost(_branch.top());
+                if (_branch.size() < 2 || _branch.size() * _node_cost <= _memory_budget)
+                    return;
+
+                std::size_t const spill_size = _branch.size() / 2; // the active node stays
+                for (auto node = _branch.c.begin(); node != _branch.c.begin() + spill_size; ++node)
+                    _spilled.push_back((**node).position());
+                _branch.c.erase(_branch.c.begin(), _branch.c.begin() + spill_size);
+                _spill_count += spill_size;
+            }
+        }
+
+        // Seeks the last spilled node again after the held nodes have been popped.
+        void restore_spilled() {
+            if constexpr (is_seekable_v) {
+                if (!_branch.empty() || _spilled.empty())
+                    return;
+
+                _branch.push(_tree.get().seek(_spilled.back()));
+                _spilled.pop_back();
+            }
+        }
+
+        static std::size_t node_cost(node_type const & node) {
+            std::size_t cost = sizeof(node_type);
+            if constexpr (requires { { std::ranges::size((*node).coverage()) } -> std::convertible_to<std::size_t>; })
+                cost += (std::ranges::size((*node).coverage()) + 7) / 8;
+            return cost;
+        }
     };
 
-    template <typename tree_t>
-    class tree_traverser_base<tree_t>::iterator {
+    template <typename tree_t, typename allocator_t, typename publisher_t>
+    class tree_traverser_base<tree_t, allocator_t, publisher_t>::iterator {
     private:
 
         friend tree_traverser_base;
@@ -54,7 +272,8 @@ namespace libjst
 
         explicit iterator(tree_traverser_base & host) : _host{std::addressof(host)}
         {
-            visit_next(libjst::root(_host->_tree.get()));
+            if (!std::exchange(_host->_resumed, false))
+                visit_next(libjst::root(_host->_tree.get()));
         }
     public:
 
@@ -89,13 +308,14 @@ namespace libjst
             } else {
                 backtrack();
             }
+            _host->check_budget();
             return *this;
         }
 
     private:
 
         constexpr friend bool operator==(iterator const & lhs, sentinel const &) noexcept {
-            return lhs.branch().empty();
+            return lhs.branch().empty() || lhs._host->interrupted();
         }
 
         constexpr node_type const & active_node() const noexcept {
@@ -108,15 +328,17 @@ namespace libjst
             return branch().top();
         }
 
-        constexpr void visit_next(node_type && new_node) noexcept {
-            branch().push(std::move(new_node));
+        constexpr void visit_next(node_type && new_node) {
+            branch().emplace(std::move(new_node));
             _host->notify_push();
+            _host->spill_if_needed();
         }
 
-        constexpr void backtrack() noexcept {
+        constexpr void backtrack() {
             assert(!branch().empty());
             branch().pop();
             _host->notify_pop();
+            _host->restore_spilled();
         }
 
         constexpr branch_type & branch() const noexcept {
@@ -125,8 +347,8 @@ namespace libjst
         }
     };
 
-    template <typename tree_t>
-    class tree_traverser_base<tree_t>::sentinel {
+    template <typename tree_t, typename allocator_t, typename publisher_t>
+    class tree_traverser_base<tree_t, allocator_t, publisher_t>::sentinel {
     private:
         friend tree_traverser_base;
 
@@ -0,0 +1,114 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides jst search of a pattern on both strands with a single tree walk.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+
+#include <libjst/matcher/concept.hpp>
+#include <libjst/sequence_tree/concept.hpp>
+#include <libjst/sequence_tree/coloured_tree.hpp>
+#include <libjst/sequence_tree/labelled_tree.hpp>
+#include <libjst/sequence_tree/left_extend_tree.hpp>
+#include <libjst/sequence_tree/merge_tree.hpp>
+#include <libjst/sequence_tree/prune_unsupported.hpp>
+#include <libjst/sequence_tree/trim_tree.hpp>
+#include <libjst/traversal/tree_traverser_base.hpp>
+#include <libjst/utility/arena_allocator.hpp>
+
+namespace libjst
+{
+    //!\brief The strand on which a hit of the libjst::two_strand_traverser was found.
+    enum struct strand : bool {
+        forward, //!< The hit of the pattern on the forward strand.
+        reverse  //!< The hit of the pattern on the reverse complement strand.
+    };
+
+    /*!\brief Searches a pattern on the forward and the reverse complement strand with a single tree walk.
+     *
+     * \details
+     *
+     * An occurrence of the pattern on the reverse complement strand is an occurrence of the reverse complement of the
+     * pattern on the forward strand. Instead of walking a second tree over the reversed store, e.g.
+     * libjst::rcs_store_reversed, and complementing every symbol of its labels, the traverser expects the matcher of
+     * the pattern and the matcher of its reverse complement, see libjst::reverse_complement, and searches both in the
+     * label of every node of the forward tree. The tree is prepared as for the libjst::state_oblivious_traverser, such
+     * that the node generation and the label construction are shared by both strands.
+     *
+     * The callback is invoked with the libjst::strand of the hit, the iterator the respective matcher reports for
+     * the hit and the label. The hits of the reverse strand are hence reported in forward coordinates, i.e. the hit
+     * iterator of a reverse strand hit refers to the same end of the occurrence in the forward label that the matcher
+     * reports for a forward hit. Since a pattern and its reverse complement have the same length, both matchers must
+     * have the same window size.
+     */
+    struct two_strand_traverser {
+        /*!\brief Searches the given pattern on both strands.
+         *
+         * \param[in] tree The tree to search.
+         * \param[in] forward_pattern The matcher of the pattern.
+         * \param[in] reverse_pattern The matcher of the reverse complement of the pattern.
+         * \param[in] callback The callback invoked with the strand, the hit iterator and the label of every hit.
+         *
+         * ### Exception
+         *
+         * Throws std::invalid_argument if the window sizes of the matchers differ.
+         */
+        template <typename tree_t, typename forward_pattern_t, typename reverse_pattern_t, typename callback_t>
+            requires window_matcher<std::remove_cvref_t<forward_pattern_t>> &&
+                     window_matcher<std::remove_cvref_t<reverse_pattern_t>>
+        constexpr void operator()(tree_t && tree,
+                                  forward_pattern_t && forward_pattern,
+                                  reverse_pattern_t && reverse_pattern,
+                                  callback_t && callback) const {
+            std::size_t const window_size = libjst::window_size(forward_pattern);
+            if (window_size != libjst::window_size(reverse_pattern))
+                throw std::invalid_argument{"The matchers of both strands must have the same window size!"};
+
+            if (window_size == 0)
+                return;
+
+            auto const extension = detail::left_extension(forward_pattern); // static if the window size is.
+            // The labels and the branch stack allocate from the arena of the calling thread, if there is one.
+            auto search_tree = tree | libjst::labelled(arena_allocator<std::byte>{})
+                                    | libjst::coloured()
+                                    | trim(static_cast<std::size_t>(extension))
+                                    | prune_unsupported()
+                                    | left_extend(extension)
+                                    | merge(); // make big nodes
+
+            tree_traverser_base<decltype(search_tree), arena_allocator<std::byte>, static_stack_publisher<>>
+                oblivious_path{search_tree};
+            oblivious_path.reserve(window_size);
+            for (auto it = oblivious_path.begin(); it != oblivious_path.end(); ++it) {
+                auto && label = *it;
+                search(forward_pattern, label, strand::forward, callback);
+                search(reverse_pattern, label, strand::reverse, callback);
+            }
+        }
+
+    private:
+
+        template <typename pattern_t, typename label_t, typename callback_t>
+        static constexpr void search(pattern_t & pattern,
+                                     label_t const & label,
+                                     strand const hit_strand,
+                                     callback_t & callback) {
+            if constexpr (requires { pattern.reset(); })
+                pattern.reset(); // every label is left extended and searched on its own
+
+            pattern(label.sequence(), [&] (auto && label_it) {
+                callback(hit_strand, std::move(label_it), label);
+            });
+        }
+    };
+}  // namespace libjst
@@ -0,0 +1,200 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides a work-stealing scheduler for splittable tasks.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace libjst
+{
+    /*!\brief Executes splittable tasks on a fixed number of worker threads with work stealing.
+     *
+     * \details
+     *
+     * Every worker owns a double ended task queue. The initial tasks are dealt round-robin to the workers.
+     * A worker takes its tasks from the back of its own queue and, once its queue runs dry, steals tasks from the
+     * front of the queues of the other workers. Before executing a task, the worker splits it as long as its own queue
+     * is empty and the task can be split further (lazy binary splitting): the split off part is pushed to its own queue,
+     * where it is available to idle workers. Expensive tasks are thereby subdivided exactly when there is demand for
+     * more work, while cheap tasks are executed without any splitting overhead. A worker that finds no task to steal
+     * waits until a task is split off or all tasks are finished, such that idle workers do not occupy their cores
+     * while a single long task runs.
+     *
+     * The calling thread participates as the first worker. If a task throws, no further tasks are started and the
+     * first exception is rethrown on the calling thread after all workers have joined.
+     */
+    class work_stealing_scheduler {
+    private:
+
+        std::size_t _thread_count{1};
+
+    public:
+
+        /*!\name Constructors, destructor, and assignment
+         * \{
+         */
+        work_stealing_scheduler() : work_stealing_scheduler{std::thread::hardware_concurrency()}
+        {}
+
+        constexpr explicit work_stealing_scheduler(std::size_t const thread_count) noexcept :
+            _thread_count{std::max<std::size_t>(thread_count, 1)}
+        {}
+        //!\}
+
+        constexpr std::size_t thread_count() const noexcept {
+            return _thread_count;
+        }
+
+        /*!\brief Executes all tasks.
+         *
+         * \param[in] initial_tasks The tasks to start with.
+         * \param[in] split_fn Invoked as `split_fn(task)`; returns a `std::optional<task_t>` with the part split off
+         *                     from the given task, which is shrunk accordingly, or `std::nullopt` if it can not be split.
+         * \param[in] task_fn Invoked as `task_fn(worker_id, task)` for every task that is not split any further.
+         */
+        template <std::ranges::input_range tasks_t, typename split_fn_t, typename task_fn_t>
+            requires std::invocable<task_fn_t &, std::size_t, std::ranges::range_value_t<tasks_t> &>
+        void operator()(tasks_t && initial_tasks, split_fn_t && split_fn, task_fn_t && task_fn) const {
+            using task_t = std::ranges::range_value_t<tasks_t>;
+            using queue_t = std::deque<task_t>;
+
+            struct worker_queue {
+                std::mutex mutex{};
+                queue_t tasks{};
+            };
+
+            std::vector<worker_queue> queues(_thread_count);
+            std::atomic<std::size_t> pending_tasks{0};
+            std::atomic<bool> cancelled{false};
+            std::exception_ptr first_error{};
+            std::mutex error_mutex{};
+
+            // Counts the split off tasks and the end of the work, on which the idle workers wait.
+            std::mutex idle_mutex{};
+            std::condition_variable work_changed{};
+            std::size_t work_version{};
+            auto notify_idle = [&] (bool const all) {
+                {
+                    std::scoped_lock idle_lock{idle_mutex};
+                    ++work_version;
+                }
+                if (all)
+                    work_changed.notify_all();
+                else
+                    work_changed.notify_one();
+            };
+            auto current_version = [&] () {
+                std::scoped_lock idle_lock{idle_mutex};
+                return work_version;
+            };
+
+            std::size_t worker_id{};
+            for (auto && task : initial_tasks) {
+                queues[worker_id].tasks.push_back((decltype(task) &&) task);
+                pending_tasks.fetch_add(1, std::memory_order_relaxed);
+                worker_id = (worker_id + 1) % _thread_count;
+            }
+
+            auto pop_own = [&] (std::size_t const id) -> std::optional<task_t> {
+                std::scoped_lock queue_lock{queues[id].mutex};
+                if (queues[id].tasks.empty())
+                    return std::nullopt;
+                task_t task = std::move(queues[id].tasks.back());
+                queues[id].tasks.pop_back();
+                return task;
+            };
+
+            auto steal = [&] (std::size_t const id) -> std::optional<task_t> {
+                for (std::size_t offset = 1; offset < _thread_count; ++offset) {
+                    worker_queue & victim = queues[(id + offset) % _thread_count];
+                    std::scoped_lock queue_lock{victim.mutex};
+                    if (!victim.tasks.empty()) {
+                        task_t task = std::move(victim.tasks.front());
+                        victim.tasks.pop_front();
+                        return task;
+                    }
+                }
+                return std::nullopt;
+            };
+
+            auto own_queue_empty = [&] (std::size_t const id) -> bool {
+                std::scoped_lock queue_lock{queues[id].mutex};
+                return queues[id].tasks.empty();
+            };
+
+            auto work = [&] (std::size_t const id) {
+                while (true) {
+                    // Tasks split off after the version was read wake the worker up again.
+                    std::size_t const seen_version = current_version();
+                    if (pending_tasks.load(std::memory_order_acquire) == 0 || cancelled.load(std::memory_order_relaxed))
+                        break;
+
+                    std::optional<task_t> task = pop_own(id);
+                    if (!task)
+                        task = steal(id);
+                    if (!task) {
+                        std::unique_lock idle_lock{idle_mutex};
+                        work_changed.wait(idle_lock, [&] () { return work_version != seen_version; });
+                        continue;
+                    }
+
+                    try {
+                        while (own_queue_empty(id)) {
+                            std::optional<task_t> split_task = split_fn(*task);
+                            if (!split_task)
+                                break;
+
+                            pending_tasks.fetch_add(1, std::memory_order_relaxed);
+                            {
+                                std::scoped_lock queue_lock{queues[id].mutex};
+                                queues[id].tasks.push_back(std::move(*split_task));
+                            }
+                            notify_idle(false);
+                        }
+                        task_fn(id, *task);
+                    } catch (...) {
+                        cancelled.store(true, std::memory_order_relaxed);
+                        {
+                            std::scoped_lock error_lock{error_mutex};
+                            if (!first_error)
+                                first_error = std::current_exception();
+                        }
+                        notify_idle(true);
+                    }
+                    if (pending_tasks.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                        notify_idle(true);
+                }
+            };
+
+            std::vector<std::thread> workers{};
+            workers.reserve(_thread_count - 1);
+            for (std::size_t id = 1; id < _thread_count; ++id)
+                workers.emplace_back(work, id);
+
+            work(0); // the calling thread participates in the work.
+            std::ranges::for_each(workers, [] (std::thread & worker) { worker.join(); });
+
+            if (first_error)
+                std::rethrow_exception(first_error);
+        }
+    };
+}  // namespace libjst
@@ -0,0 +1,163 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::arena_allocator and libjst::scoped_arena.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <utility>
+
+namespace libjst
+{
+    namespace detail
+    {
+        //!\brief Returns the memory resource of the innermost libjst::scoped_arena of the calling thread.
+        inline std::pmr::memory_resource * & thread_arena_resource() noexcept {
+            thread_local std::pmr::memory_resource * resource = std::pmr::new_delete_resource();
+            return resource;
+        }
+
+        //!\brief Activates a memory resource as the arena of the calling thread and reactivates the enclosing one.
+        class arena_guard {
+        private:
+            std::pmr::memory_resource * _enclosing{};
+
+        public:
+            explicit arena_guard(std::pmr::memory_resource * resource) noexcept :
+                _enclosing{std::exchange(thread_arena_resource(), resource)}
+            {}
+
+            arena_guard(arena_guard const &) = delete;
+            arena_guard & operator=(arena_guard const &) = delete;
+
+            ~arena_guard() {
+                thread_arena_resource() = _enclosing;
+            }
+        };
+    } // namespace detail
+
+    //!\brief Returns the memory resource used by default constructed libjst::arena_allocator on the calling thread.
+    inline std::pmr::memory_resource * active_arena() noexcept {
+        return detail::thread_arena_resource();
+    }
+
+    /*!\brief A polymorphic allocator bound to the arena of the calling thread.
+     *
+     * \tparam value_t The type of the allocated values.
+     *
+     * \details
+     *
+     * Behaves like std::pmr::polymorphic_allocator, but a default constructed allocator, as well as the allocator of
+     * a copy constructed container, uses the memory resource of the innermost libjst::scoped_arena that is active on
+     * the calling thread, or std::pmr::new_delete_resource if there is none. Thus, the containers copied while
+     * traversing a tree, e.g. the labels and coverages of the nodes, are allocated from the arena of the traversing
+     * thread without threading a resource through the tree adaptors.
+     *
+     * Memory allocated from an arena is released when the arena goes out of scope. Values holding arena memory must
+     * hence not outlive the arena of their thread.
+     */
+    template <typename value_t>
+    class arena_allocator {
+    private:
+
+        template <typename>
+        friend class arena_allocator;
+
+        std::pmr::memory_resource * _resource{};
+
+    public:
+
+        using value_type = value_t;
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        //!\brief Binds the allocator to the active arena of the calling thread.
+        arena_allocator() noexcept : _resource{active_arena()}
+        {}
+
+        //!\brief Binds the allocator to the given memory resource.
+        explicit arena_allocator(std::pmr::memory_resource * resource) noexcept : _resource{resource}
+        {}
+
+        //!\brief Rebinds the allocator of another value type to the same memory resource.
+        template <typename other_value_t>
+        arena_allocator(arena_allocator<other_value_t> const & other) noexcept : _resource{other._resource}
+        {}
+        //!\}
+
+        value_t * allocate(std::size_t const count) {
+            return static_cast<value_t *>(_resource->allocate(count * sizeof(value_t), alignof(value_t)));
+        }
+
+        void deallocate(value_t * pointer, std::size_t const count) noexcept {
+            _resource->deallocate(pointer, count * sizeof(value_t), alignof(value_t));
+        }
+
+        //!\brief Copies of a container allocate from the active arena of the copying thread.
+        arena_allocator select_on_container_copy_construction() const noexcept {
+            return arena_allocator{};
+        }
+
+        std::pmr::memory_resource * resource() const noexcept {
+            return _resource;
+        }
+
+    private:
+
+        template <typename other_value_t>
+        friend bool operator==(arena_allocator const & lhs, arena_allocator<other_value_t> const & rhs) noexcept {
+            return lhs.resource() == rhs.resource() || lhs.resource()->is_equal(*rhs.resource());
+        }
+    };
+
+    /*!\brief Installs a release-at-once arena for the libjst::arena_allocator of the calling thread.
+     *
+     * \details
+     *
+     * While the object is alive, default constructed libjst::arena_allocator on the constructing thread allocate from
+     * the arena. Freed blocks are recycled by a pool and all memory, including the pool, is released in one shot when
+     * the arena is destroyed. Arenas can be nested; destroying an arena reactivates the enclosing one. An arena must
+     * be destroyed on the thread that constructed it.
+     */
+    class scoped_arena {
+    private:
+        std::pmr::monotonic_buffer_resource _buffer;
+        std::pmr::unsynchronized_pool_resource _pool;
+        detail::arena_guard _guard;
+
+    public:
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        //!\brief Activates a new arena whose first buffer has the given size in bytes.
+        explicit scoped_arena(std::size_t const initial_size = 1 << 16) :
+            _buffer{initial_size, active_arena()},
+            _pool{std::addressof(_buffer)},
+            _guard{std::addressof(_pool)}
+        {}
+
+        scoped_arena(scoped_arena const &) = delete; //!< Deleted.
+        scoped_arena & operator=(scoped_arena const &) = delete; //!< Deleted.
+
+        //!\brief Reactivates the enclosing arena and releases all memory.
+        ~scoped_arena() = default;
+        //!\}
+
+        //!\brief Returns the memory resource of the arena.
+        std::pmr::memory_resource * resource() noexcept {
+            return std::addressof(_pool);
+        }
+    };
+}  // namespace libjst
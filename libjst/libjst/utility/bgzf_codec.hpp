@@ -0,0 +1,134 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::bgzf_codec compressing blocks of the BGZF format read by bgzip, samtools and htslib.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/*!\brief Enables the libjst::bgzf_codec if defined to a non-zero value; disabled by default.
+ *
+ * \details
+ *
+ * Set by the CMake option `LIBJST_WITH_ZLIB`, which also links zlib to all targets linking libjst.
+ */
+#ifndef LIBJST_HAS_ZLIB
+#define LIBJST_HAS_ZLIB 0
+#endif
+
+#if LIBJST_HAS_ZLIB
+#include <zlib.h>
+#endif
+
+namespace libjst
+{
+    //!\brief Whether libjst was built with zlib and the libjst::bgzf_codec can compress blocks.
+    inline constexpr bool bgzf_enabled = static_cast<bool>(LIBJST_HAS_ZLIB);
+
+    /*!\brief Compresses independent blocks of the blocked gzip format (BGZF).
+     *
+     * \details
+     *
+     * A BGZF file is a series of gzip members, each compressing at most 64 KiB and storing its compressed size in
+     * an extra field, followed by an empty end-of-file member. The members are independent of each other, such that
+     * the blocks of a stream can be compressed concurrently and concatenated in order. The output is a valid gzip
+     * file for every gzip reader and is indexable by the tools of htslib.
+     *
+     * Requires libjst to be built with `LIBJST_WITH_ZLIB`; otherwise compress throws std::logic_error.
+     */
+    class bgzf_codec {
+    public:
+
+        //!\brief The maximal number of bytes of a block, which guarantees the compressed block to fit into 64 KiB.
+        static constexpr std::size_t max_block_size{0xff00};
+
+        //!\brief The end-of-file member closing every BGZF file.
+        static constexpr std::array<uint8_t, 28> eof_block{0x1f, 0x8b, 0x08, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff,
+                                                           0x06, 0x00, 0x42, 0x43, 0x02, 0x00, 0x1b, 0x00, 0x03, 0x00,
+                                                           0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+
+        /*!\brief Appends the BGZF member compressing the given block to the output.
+         *
+         * \param[in] input The bytes to compress; at most libjst::bgzf_codec::max_block_size.
+         * \param[in,out] output The buffer the member is appended to.
+         * \param[in] level The zlib compression level; defaults to the default level of zlib.
+         *
+         * \details
+         *
+         * Throws std::invalid_argument if the block is too large and std::runtime_error if zlib fails.
+         */
+        static void compress(std::span<char const> input, std::vector<char> & output, int const level = -1) {
+#if LIBJST_HAS_ZLIB
+            if (input.size() > max_block_size)
+                throw std::invalid_argument{"A BGZF block must not exceed " + std::to_string(max_block_size) +
+                                            " bytes."};
+
+            constexpr std::size_t header_size{18};
+            constexpr std::size_t footer_size{8};
+            std::size_t const member_begin = output.size();
+            std::size_t const bound = compressBound(static_cast<uLong>(input.size()));
+            output.resize(member_begin + header_size + bound + footer_size);
+            char * member = output.data() + member_begin;
+
+            // The gzip header with the extra field `BC` holding the size of the member minus one.
+            constexpr std::array<uint8_t, 16> header{0x1f, 0x8b, 0x08, 0x04, 0x00, 0x00, 0x00, 0x00,
+                                                     0x00, 0xff, 0x06, 0x00, 0x42, 0x43, 0x02, 0x00};
+            std::ranges::copy(header, reinterpret_cast<uint8_t *>(member));
+
+            z_stream stream{};
+            if (deflateInit2(&stream, level, Z_DEFLATED, -15, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+                throw std::runtime_error{"Could not initialise the zlib stream."};
+
+            stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(input.data()));
+            stream.avail_in = static_cast<uInt>(input.size());
+            stream.next_out = reinterpret_cast<Bytef *>(member + header_size);
+            stream.avail_out = static_cast<uInt>(bound);
+            int const status = deflate(&stream, Z_FINISH);
+            std::size_t const compressed_size = stream.total_out;
+            deflateEnd(&stream);
+            if (status != Z_STREAM_END)
+                throw std::runtime_error{"Could not compress the BGZF block."};
+
+            std::size_t const member_size = header_size + compressed_size + footer_size;
+            write_le(member + 16, member_size - 1, 2);
+            uLong const crc = crc32(crc32(0L, Z_NULL, 0), reinterpret_cast<Bytef const *>(input.data()),
+                                    static_cast<uInt>(input.size()));
+            write_le(member + header_size + compressed_size, crc, 4);
+            write_le(member + header_size + compressed_size + 4, input.size(), 4);
+            output.resize(member_begin + member_size);
+#else
+            (void) input;
+            (void) output;
+            (void) level;
+            throw std::logic_error{"libjst was built without zlib; enable LIBJST_WITH_ZLIB to write BGZF blocks."};
+#endif
+        }
+
+        //!\brief Appends the end-of-file member to the output.
+        static void finish(std::vector<char> & output) {
+            output.insert(output.end(), eof_block.begin(), eof_block.end());
+        }
+
+    private:
+
+        static void write_le(char * target, uint64_t value, std::size_t const byte_count) noexcept {
+            for (std::size_t byte = 0; byte < byte_count; ++byte, value >>= 8)
+                target[byte] = static_cast<char>(value & 0xff);
+        }
+    };
+}  // namespace libjst
@@ -0,0 +1,93 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides the transposition of bit matrices between variant-major and sample-major order.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include <libjst/utility/bit_vector_kernels.hpp>
+
+namespace libjst
+{
+    //!\brief The number of rows and columns of the blocks transposed by libjst::transpose_bit_blocks.
+    inline constexpr std::size_t bit_block_size{64};
+
+    /*!\brief Transposes consecutive 64×64 bit blocks in place.
+     *
+     * \param[in,out] blocks The blocks of 64 words each, storing the column `c` of the row `r` at the bit `c` of the
+     *                       word `r`.
+     *
+     * \details
+     *
+     * Every block is transposed by six rounds of masked swaps of its off-diagonal sub-blocks, which the SIMD kernels
+     * apply to several rows at once, see libjst::detail::bit_kernels::transpose_blocks. A bit-by-bit conversion
+     * touches every bit individually, while a block takes six passes over its 64 words.
+     */
+    constexpr void transpose_bit_blocks(std::span<uint64_t> blocks) noexcept {
+        assert(blocks.size() % bit_block_size == 0);
+        detail::transpose_bit_blocks(blocks.data(), blocks.size() / bit_block_size);
+    }
+
+    /*!\brief Transposes a bit matrix given as one bit vector per row.
+     *
+     * \param[in] rows The rows of the matrix, e.g. the coverages of the variants.
+     * \param[in] column_count The number of columns, e.g. the number of haplotypes.
+     *
+     * \returns One bit vector of `std::ranges::size(rows)` bits for every column, e.g. the variants of every haplotype.
+     *
+     * \details
+     *
+     * The matrix is tiled into blocks of 64 rows and 64 columns, whose words are copied from the rows, transposed
+     * with libjst::transpose_bit_blocks and copied into the columns. The tiles of a group of 64 rows are transposed
+     * at once.
+     *
+     * ### Exception
+     *
+     * Throws std::invalid_argument if a row has fewer than `column_count` bits.
+     */
+    template <std::ranges::random_access_range rows_t>
+        requires std::ranges::sized_range<rows_t>
+    auto transpose_bits(rows_t const & rows, std::size_t const column_count)
+    {
+        using bit_vector_t = std::remove_cvref_t<std::ranges::range_value_t<rows_t>>;
+
+        std::size_t const row_count = std::ranges::size(rows);
+        if (std::ranges::any_of(rows, [&] (auto const & row) { return std::ranges::size(row) < column_count; }))
+            throw std::invalid_argument{"The rows must have at least as many bits as columns are transposed!"};
+
+        std::vector<bit_vector_t> columns(column_count, bit_vector_t(row_count, false));
+        std::size_t const column_words = (column_count + bit_block_size - 1) / bit_block_size;
+        std::vector<uint64_t> tiles(column_words * bit_block_size);
+        for (std::size_t row_word = 0; row_word * bit_block_size < row_count; ++row_word) {
+            std::size_t const first_row = row_word * bit_block_size;
+            std::size_t const tile_rows = std::min(bit_block_size, row_count - first_row);
+            std::ranges::fill(tiles, 0);
+            for (std::size_t row = 0; row < tile_rows; ++row) {
+                uint64_t const * row_data = std::ranges::begin(rows)[first_row + row].data();
+                for (std::size_t word = 0; word < column_words; ++word)
+                    tiles[word * bit_block_size + row] = row_data[word];
+            }
+
+            libjst::transpose_bit_blocks(tiles);
+            for (std::size_t column = 0; column < column_count; ++column)
+                columns[column].data()[row_word] = tiles[column];
+        }
+        return columns;
+    }
+}  // namespace libjst
@@ -21,6 +21,8 @@
 
 #include <cereal/types/base_class.hpp>
 
+#include <libjst/utility/bit_vector_kernels.hpp>
+
 namespace libjst
 {
 
@@ -84,6 +86,11 @@ private:
     //!\brief The number of chunks to roll out in a SIMD operation.
     static constexpr std::ptrdiff_t _unroll_factor{32};
 
+    //!\brief Selects a binary kernel of libjst::detail::bit_kernels.
+    using binary_kernel_member_type = detail::bit_kernels::binary_kernel_type detail::bit_kernels::*;
+    //!\brief Selects a predicate kernel of libjst::detail::bit_kernels.
+    using predicate_kernel_member_type = detail::bit_kernels::predicate_kernel_type detail::bit_kernels::*;
+
     // ----------------------------------------------------------------------------
     // member variables
     // ----------------------------------------------------------------------------
@@ -302,6 +309,12 @@ public:
         return base_t::capacity() * chunk_size;
     }
 
+    //!\brief Returns the number of bytes allocated for the chunks.
+    constexpr size_type memory_usage() const noexcept
+    {
+        return base_t::capacity() * sizeof(chunk_type);
+    }
+
     /*!\brief Reserves storage.
      *
      * \param[in] new_capacity The new capacity of the bit vector.
@@ -384,7 +397,7 @@ public:
     {
         assert(rhs.size() == size());
 
-        binary_transform_impl(*this, *this, rhs, [] (auto const a, auto const b) { return a & b; });
+        binary_transform_impl(*this, *this, rhs, &detail::bit_kernels::and_words);
 
         return *this;
     }
@@ -394,7 +407,7 @@ public:
     {
         assert(rhs.size() == size());
 
-        binary_transform_impl(*this, *this, rhs, [] (auto const a, auto const b) { return a | b; });
+        binary_transform_impl(*this, *this, rhs, &detail::bit_kernels::or_words);
 
         return *this;
     }
@@ -404,7 +417,7 @@ public:
     {
         assert(rhs.size() == size());
 
-        binary_transform_impl(*this, *this, rhs, [] (auto const a, auto const b) { return a ^ b; });
+        binary_transform_impl(*this, *this, rhs, &detail::bit_kernels::xor_words);
 
         return *this;
     }
@@ -423,7 +436,7 @@ public:
     {
         bit_vector tmp{};
         tmp.resize(lhs.size());
-        binary_transform_impl(tmp, lhs, rhs, [](auto const a, auto const b) { return a & b; });
+        binary_transform_impl(tmp, lhs, rhs, &detail::bit_kernels::and_words);
         return tmp;
     }
 
@@ -432,7 +445,7 @@ public:
     {
         bit_vector tmp{};
         tmp.resize(lhs.size());
-        binary_transform_impl(tmp, lhs, rhs, [](auto const a, auto const b) { return a | b; });
+        binary_transform_impl(tmp, lhs, rhs, &detail::bit_kernels::or_words);
         return tmp;
     }
 
@@ -443,7 +456,7 @@ public:
         bit_vector tmp{};
         tmp.resize(lhs.size());
 
-        binary_transform_impl(tmp, lhs, rhs, [](auto const a, auto const b) { return a ^ b; });
+        binary_transform_impl(tmp, lhs, rhs, &detail::bit_kernels::xor_words);
         return tmp;
     }
 
@@ -452,31 +465,19 @@ public:
     {
         assert(rhs.size() == size());
 
-        binary_transform_impl(*this, *this, rhs, [] (auto const a, auto const b) { return a & ~b; });
+        binary_transform_impl(*this, *this, rhs, &detail::bit_kernels::and_not_words);
 
         return *this;
     }
 
     constexpr bool all() const noexcept
     {
-        size_t data_size = base_t::size(); // number of words
-        for (size_t i = 0; i < data_size; ++i)
-        {
-            if (~base_t::data()[i] != 0)
-                return false;
-        }
-        return true;
+        return predicate_impl(&detail::bit_kernels::all_words);
     }
 
     constexpr bool any() const noexcept
     {
-        size_t data_size = base_t::size(); // number of words
-        for (size_t i = 0; i < data_size; ++i)
-        {
-            if (base_t::data()[i] > 0)
-                return true;
-        }
-        return false;
+        return predicate_impl(&detail::bit_kernels::any_words);
     }
 
     constexpr bool none() const noexcept
@@ -484,6 +485,81 @@ public:
         return !any();
     }
 
+    //!\brief Returns the number of set bits.
+    constexpr size_type count() const noexcept
+    {
+        size_type const full_chunks = size() >> division_mask;
+        size_type bit_count = count_impl(base_t::data(), full_chunks);
+        if (size_type const tail_size = to_local_chunk_position(size()); tail_size > 0) // ignore the padding bits.
+            bit_count += std::popcount(base_t::data()[full_chunks] & ((chunk_type{1} << tail_size) - 1));
+
+        return bit_count;
+    }
+
+    //!\brief Returns whether `*this & rhs` has any bit set without materialising the intersection.
+    constexpr bool intersects(bit_vector const & rhs) const noexcept
+    {
+        assert(rhs.size() == size());
+
+        return detail::intersects_bits(base_t::data(), rhs.as_base()->data(), size());
+    }
+
+    //!\brief Returns the number of bits set in `*this & rhs` without materialising the intersection.
+    constexpr size_type intersection_count(bit_vector const & rhs) const noexcept
+    {
+        assert(rhs.size() == size());
+
+        return detail::intersection_count_bits(base_t::data(), rhs.as_base()->data(), size());
+    }
+
+    /*!\brief Assigns `lhs & rhs` to `this`.
+     *
+     * \details
+     *
+     * Reuses the memory of `this` if its capacity suffices. `lhs` and `rhs` may alias `this`.
+     */
+    constexpr bit_vector & assign_and(bit_vector const & lhs, bit_vector const & rhs)
+    {
+        assert(lhs.size() == rhs.size());
+
+        resize(lhs.size());
+        binary_transform_impl(*this, lhs, rhs, &detail::bit_kernels::and_words);
+
+        return *this;
+    }
+
+    /*!\brief Assigns `lhs | rhs` to `this`.
+     *
+     * \details
+     *
+     * Reuses the memory of `this` if its capacity suffices. `lhs` and `rhs` may alias `this`.
+     */
+    constexpr bit_vector & assign_or(bit_vector const & lhs, bit_vector const & rhs)
+    {
+        assert(lhs.size() == rhs.size());
+
+        resize(lhs.size());
+        binary_transform_impl(*this, lhs, rhs, &detail::bit_kernels::or_words);
+
+        return *this;
+    }
+
+    /*!\brief Assigns `lhs & ~rhs` to `this`.
+     *
+     * \details
+     *
+     * Reuses the memory of `this` if its capacity suffices. `lhs` and `rhs` may alias `this`.
+     */
+    constexpr bit_vector & assign_and_not(bit_vector const & lhs, bit_vector const & rhs)
+    {
+        assert(lhs.size() == rhs.size());
+
+        resize(lhs.size());
+        binary_transform_impl(*this, lhs, rhs, &detail::bit_kernels::and_not_words);
+
+        return *this;
+    }
+
     //!\brief Flips all bits in-place.
     constexpr bit_vector & flip() noexcept
     {
@@ -581,32 +657,47 @@ public:
     //!\}
 
 private:
-    //!\brief Performs the binary bitwise-operation on the underlying chunks.
-    template <typename binary_operator_t>
+    /*!\brief Performs the binary bitwise-operation on the underlying chunks.
+     *
+     * \details
+     *
+     * Uses the given kernel of the kernels selected for the executing CPU, see libjst::detail::active_bit_kernels,
+     * and the portable implementation during constant evaluation.
+     */
     static constexpr void binary_transform_impl(bit_vector & res,
                                                 bit_vector const & lhs,
                                                 bit_vector const & rhs,
-                                                binary_operator_t && op) noexcept
+                                                binary_kernel_member_type kernel) noexcept
     {
         assert(lhs.size() == rhs.size());
         assert(res.size() == lhs.size());
 
-        size_t unroll_offset = _unroll_factor;
+        chunk_type * res_data = res.as_base()->data();
+        chunk_type const * lhs_data = lhs.as_base()->data();
+        chunk_type const * rhs_data = rhs.as_base()->data();
         size_t data_size = lhs.as_base()->size(); // number of words
+        if (std::is_constant_evaluated())
+            (detail::scalar_bit_kernels.*kernel)(res_data, lhs_data, rhs_data, data_size);
+        else
+            (detail::active_bit_kernels().*kernel)(res_data, lhs_data, rhs_data, data_size);
+    }
 
-        for (; unroll_offset < data_size; unroll_offset += _unroll_factor)
-        {
-            auto start = unroll_offset - _unroll_factor;
-            for (size_t i = 0; i < _unroll_factor; ++i)
-            {
-                res.as_base()->data()[start + i] = op(lhs.as_base()->data()[start + i], rhs.as_base()->data()[start + i]);
-            }
-        }
+    //!\brief Evaluates the predicate kernel on the underlying chunks.
+    constexpr bool predicate_impl(predicate_kernel_member_type kernel) const noexcept
+    {
+        if (std::is_constant_evaluated())
+            return (detail::scalar_bit_kernels.*kernel)(base_t::data(), base_t::size());
+        else
+            return (detail::active_bit_kernels().*kernel)(base_t::data(), base_t::size());
+    }
 
-        for (size_t i = unroll_offset - _unroll_factor; i < data_size; ++i)
-        {
-            res.as_base()->data()[i] = op(lhs.as_base()->data()[i], rhs.as_base()->data()[i]);
-        }
+    //!\brief Counts the set bits of the given chunks.
+    static constexpr size_type count_impl(chunk_type const * chunks, size_type const chunk_count) noexcept
+    {
+        if (std::is_constant_evaluated())
+            return detail::scalar_count_words(chunks, chunk_count);
+        else
+            return detail::active_bit_kernels().count_words(chunks, chunk_count);
     }
 
     //!\brief Performs the binary bitwise-operation on the underlying chunks.
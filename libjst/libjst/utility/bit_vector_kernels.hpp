@@ -0,0 +1,841 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides SIMD kernels for the word-wise operations of libjst::bit_vector with runtime dispatch.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define LIBJST_BIT_KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define LIBJST_BIT_KERNELS_NEON 1
+#include <arm_neon.h>
+#endif
+
+namespace libjst::detail
+{
+    //!\brief The instruction sets a bit vector kernel can be implemented with.
+    enum class bit_kernel_target : uint8_t {
+        scalar, //!< Portable implementation operating on single words.
+        avx2, //!< 256 bit vectors on x86-64.
+        avx512, //!< 512 bit vectors on x86-64.
+        neon //!< 128 bit vectors on AArch64.
+    };
+
+    /*!\brief The table of word-wise kernels used by libjst::bit_vector.
+     *
+     * \details
+     *
+     * All kernels operate on `count` many 64 bit words. The result of a binary kernel may alias one of its operands.
+     * The transpose kernel operates on `count` many blocks of 64 words, each storing a 64×64 bit matrix with the
+     * column `c` of the row `r` at the bit `c` of the word `r`.
+     */
+    struct bit_kernels {
+        using word_type = uint64_t;
+        using binary_kernel_type = void (*)(word_type *, word_type const *, word_type const *, std::size_t) noexcept;
+        using predicate_kernel_type = bool (*)(word_type const *, std::size_t) noexcept;
+        using count_kernel_type = std::size_t (*)(word_type const *, std::size_t) noexcept;
+        using binary_predicate_kernel_type = bool (*)(word_type const *, word_type const *, std::size_t) noexcept;
+        using binary_count_kernel_type = std::size_t (*)(word_type const *, word_type const *, std::size_t) noexcept;
+        using transpose_kernel_type = void (*)(word_type *, std::size_t) noexcept;
+
+        bit_kernel_target target; //!< The instruction set of the kernels.
+        binary_kernel_type and_words; //!< `res = lhs & rhs`.
+        binary_kernel_type or_words; //!< `res = lhs | rhs`.
+        binary_kernel_type xor_words; //!< `res = lhs ^ rhs`.
+        binary_kernel_type and_not_words; //!< `res = lhs & ~rhs`.
+        predicate_kernel_type any_words; //!< Whether any word is not zero.
+        predicate_kernel_type all_words; //!< Whether all words have all bits set.
+        count_kernel_type count_words; //!< The number of set bits.
+        binary_predicate_kernel_type intersects_words; //!< Whether any word of `lhs & rhs` is not zero.
+        binary_count_kernel_type and_count_words; //!< The number of set bits of `lhs & rhs`.
+        transpose_kernel_type transpose_blocks; //!< Transposes every 64×64 bit block in place.
+    };
+
+    // ----------------------------------------------------------------------------
+    // Word operations
+    // ----------------------------------------------------------------------------
+
+    struct bit_and_op {
+        static constexpr uint64_t apply(uint64_t const a, uint64_t const b) noexcept { return a & b; }
+#if LIBJST_BIT_KERNELS_X86
+        __attribute__((target("avx2"))) static __m256i apply(__m256i const a, __m256i const b) noexcept {
+            return _mm256_and_si256(a, b);
+        }
+        __attribute__((target("avx512f"))) static __m512i apply(__m512i const a, __m512i const b) noexcept {
+            return _mm512_and_si512(a, b);
+        }
+#endif
+#if LIBJST_BIT_KERNELS_NEON
+        static uint64x2_t apply(uint64x2_t const a, uint64x2_t const b) noexcept { return vandq_u64(a, b); }
+#endif
+    };
+
+    struct bit_or_op {
+        static constexpr uint64_t apply(uint64_t const a, uint64_t const b) noexcept { return a | b; }
+#if LIBJST_BIT_KERNELS_X86
+        __attribute__((target("avx2"))) static __m256i apply(__m256i const a, __m256i const b) noexcept {
+            return _mm256_or_si256(a, b);
+        }
+        __attribute__((target("avx512f"))) static __m512i apply(__m512i const a, __m512i const b) noexcept {
+            return _mm512_or_si512(a, b);
+        }
+#endif
+#if LIBJST_BIT_KERNELS_NEON
+        static uint64x2_t apply(uint64x2_t const a, uint64x2_t const b) noexcept { return vorrq_u64(a, b); }
+#endif
+    };
+
+    struct bit_xor_op {
+        static constexpr uint64_t apply(uint64_t const a, uint64_t const b) noexcept { return a ^ b; }
+#if LIBJST_BIT_KERNELS_X86
+        __attribute__((target("avx2"))) static __m256i apply(__m256i const a, __m256i const b) noexcept {
+            return _mm256_xor_si256(a, b);
+        }
+        __attribute__((target("avx512f"))) static __m512i apply(__m512i const a, __m512i const b) noexcept {
+            return _mm512_xor_si512(a, b);
+        }
+#endif
+#if LIBJST_BIT_KERNELS_NEON
+        static uint64x2_t apply(uint64x2_t const a, uint64x2_t const b) noexcept { return veorq_u64(a, b); }
+#endif
+    };
+
+    struct bit_and_not_op {
+        static constexpr uint64_t apply(uint64_t const a, uint64_t const b) noexcept { return a & ~b; }
+#if LIBJST_BIT_KERNELS_X86
+        __attribute__((target("avx2"))) static __m256i apply(__m256i const a, __m256i const b) noexcept {
+            return _mm256_andnot_si256(b, a);
+        }
+        __attribute__((target("avx512f"))) static __m512i apply(__m512i const a, __m512i const b) noexcept {
+            return _mm512_maskz_andnot_epi64(0xff, b, a); // the unmasked intrinsic warns spuriously with GCC 12.
+        }
+#endif
+#if LIBJST_BIT_KERNELS_NEON
+        static uint64x2_t apply(uint64x2_t const a, uint64x2_t const b) noexcept { return vbicq_u64(a, b); }
+#endif
+    };
+
+    // ----------------------------------------------------------------------------
+    // Scalar kernels
+    // ----------------------------------------------------------------------------
+
+    //!\brief The number of words processed per block, which the compiler may vectorise.
+    inline constexpr std::size_t bit_kernel_unroll_factor{32};
+
+    template <typename op_t>
+    constexpr void scalar_transform_words(uint64_t * res,
+                                          uint64_t const * lhs,
+                                          uint64_t const * rhs,
+                                          std::size_t const count) noexcept {
+        std::size_t i = 0;
+        for (; i + bit_kernel_unroll_factor <= count; i += bit_kernel_unroll_factor)
+            for (std::size_t j = i; j < i + bit_kernel_unroll_factor; ++j)
+                res[j] = op_t::apply(lhs[j], rhs[j]);
+
+        for (; i < count; ++i)
+            res[i] = op_t::apply(lhs[i], rhs[i]);
+    }
+
+    constexpr bool scalar_any_words(uint64_t const * words, std::size_t const count) noexcept {
+        for (std::size_t i = 0; i < count; ++i)
+            if (words[i] != 0)
+                return true;
+
+        return false;
+    }
+
+    constexpr bool scalar_all_words(uint64_t const * words, std::size_t const count) noexcept {
+        for (std::size_t i = 0; i < count; ++i)
+            if (~words[i] != 0)
+                return false;
+
+        return true;
+    }
+
+    constexpr std::size_t scalar_count_words(uint64_t const * words, std::size_t const count) noexcept {
+        std::size_t bit_count{};
+        for (std::size_t i = 0; i < count; ++i)
+            bit_count += std::popcount(words[i]);
+
+        return bit_count;
+    }
+
+    constexpr bool scalar_intersects_words(uint64_t const * lhs,
+                                           uint64_t const * rhs,
+                                           std::size_t const count) noexcept {
+        for (std::size_t i = 0; i < count; ++i)
+            if ((lhs[i] & rhs[i]) != 0)
+                return true;
+
+        return false;
+    }
+
+    constexpr std::size_t scalar_and_count_words(uint64_t const * lhs,
+                                                 uint64_t const * rhs,
+                                                 std::size_t const count) noexcept {
+        std::size_t bit_count{};
+        for (std::size_t i = 0; i < count; ++i)
+            bit_count += std::popcount(lhs[i] & rhs[i]);
+
+        return bit_count;
+    }
+
+    /*!\brief The masks of the columns kept by the rows `k` with `k & j == 0` in the rounds `j = 32, 16, ..., 1`.
+     *
+     * \details
+     *
+     * A block is transposed by swapping its off-diagonal `j × j` sub-blocks for every `j`: the round `j` exchanges the
+     * columns `c` with `c & j != 0` of the row `k` with the columns `c - j` of the row `k + j`. The rounds commute, such
+     * that the SIMD kernels run the rounds spanning several vectors first and those within one vector last.
+     */
+    inline constexpr uint64_t transpose_masks[] = {0x0000'0000'ffff'ffff, 0x0000'ffff'0000'ffff, 0x00ff'00ff'00ff'00ff,
+                                                   0x0f0f'0f0f'0f0f'0f0f, 0x3333'3333'3333'3333, 0x5555'5555'5555'5555};
+
+    //!\brief Returns the mask of the round `j`, see libjst::detail::transpose_masks.
+    constexpr uint64_t transpose_mask(std::size_t const j) noexcept {
+        return transpose_masks[5 - std::countr_zero(j)];
+    }
+
+    constexpr void scalar_transpose_block(uint64_t * block) noexcept {
+        for (std::size_t j = 32; j != 0; j >>= 1) {
+            uint64_t const mask = transpose_mask(j);
+            for (std::size_t k = 0; k < 64; k = (k + j + 1) & ~j) { // visits the rows with k & j == 0.
+                uint64_t const swapped = ((block[k] >> j) ^ block[k + j]) & mask;
+                block[k + j] ^= swapped;
+                block[k] ^= swapped << j;
+            }
+        }
+    }
+
+    constexpr void scalar_transpose_blocks(uint64_t * blocks, std::size_t const count) noexcept {
+        for (std::size_t i = 0; i < count; ++i)
+            scalar_transpose_block(blocks + i * 64);
+    }
+
+    inline constexpr bit_kernels scalar_bit_kernels{
+        .target = bit_kernel_target::scalar,
+        .and_words = scalar_transform_words<bit_and_op>,
+        .or_words = scalar_transform_words<bit_or_op>,
+        .xor_words = scalar_transform_words<bit_xor_op>,
+        .and_not_words = scalar_transform_words<bit_and_not_op>,
+        .any_words = scalar_any_words,
+        .all_words = scalar_all_words,
+        .count_words = scalar_count_words,
+        .intersects_words = scalar_intersects_words,
+        .and_count_words = scalar_and_count_words,
+        .transpose_blocks = scalar_transpose_blocks
+    };
+
+#if LIBJST_BIT_KERNELS_X86
+    // ----------------------------------------------------------------------------
+    // AVX2 kernels
+    // ----------------------------------------------------------------------------
+
+    template <typename op_t>
+    __attribute__((target("avx2")))
+    inline void avx2_transform_words(uint64_t * res,
+                                     uint64_t const * lhs,
+                                     uint64_t const * rhs,
+                                     std::size_t const count) noexcept {
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m256i const a = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(lhs + i));
+            __m256i const b = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(rhs + i));
+            _mm256_storeu_si256(reinterpret_cast<__m256i *>(res + i), op_t::apply(a, b));
+        }
+
+        for (; i < count; ++i)
+            res[i] = op_t::apply(lhs[i], rhs[i]);
+    }
+
+    __attribute__((target("avx2")))
+    inline bool avx2_any_words(uint64_t const * words, std::size_t const count) noexcept {
+        std::size_t i = 0;
+        for (; i + 16 <= count; i += 16) { // test four vectors at once to amortise the branch.
+            __m256i block = _mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<__m256i const *>(words + i)),
+                                            _mm256_loadu_si256(reinterpret_cast<__m256i const *>(words + i + 4)));
+            block = _mm256_or_si256(block, _mm256_loadu_si256(reinterpret_cast<__m256i const *>(words + i + 8)));
+            block = _mm256_or_si256(block, _mm256_loadu_si256(reinterpret_cast<__m256i const *>(words + i + 12)));
+            if (!_mm256_testz_si256(block, block))
+                return true;
+        }
+
+        for (; i + 4 <= count; i += 4) {
+            __m256i const block = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(words + i));
+            if (!_mm256_testz_si256(block, block))
+                return true;
+        }
+
+        return scalar_any_words(words + i, count - i);
+    }
+
+    __attribute__((target("avx2")))
+    inline bool avx2_all_words(uint64_t const * words, std::size_t const count) noexcept {
+        __m256i const ones = _mm256_set1_epi64x(-1);
+        std::size_t i = 0;
+        for (; i + 16 <= count; i += 16) {
+            __m256i block = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<__m256i const *>(words + i)),
+                                             _mm256_loadu_si256(reinterpret_cast<__m256i const *>(words + i + 4)));
+            block = _mm256_and_si256(block, _mm256_loadu_si256(reinterpret_cast<__m256i const *>(words + i + 8)));
+            block = _mm256_and_si256(block, _mm256_loadu_si256(reinterpret_cast<__m256i const *>(words + i + 12)));
+            if (!_mm256_testc_si256(block, ones))
+                return false;
+        }
+
+        for (; i + 4 <= count; i += 4) {
+            __m256i const block = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(words + i));
+            if (!_mm256_testc_si256(block, ones))
+                return false;
+        }
+
+        return scalar_all_words(words + i, count - i);
+    }
+
+    //!\brief Counts the set bits with a nibble lookup table and sums the byte counts per 64 bit lane.
+    __attribute__((target("avx2")))
+    inline __m256i avx2_popcount_lanes(__m256i const block) noexcept {
+        __m256i const lookup = _mm256_setr_epi8(0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4,
+                                                0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4);
+        __m256i const low_mask = _mm256_set1_epi8(0x0f);
+        __m256i const low = _mm256_and_si256(block, low_mask);
+        __m256i const high = _mm256_and_si256(_mm256_srli_epi16(block, 4), low_mask);
+        __m256i const byte_counts = _mm256_add_epi8(_mm256_shuffle_epi8(lookup, low),
+                                                    _mm256_shuffle_epi8(lookup, high));
+        return _mm256_sad_epu8(byte_counts, _mm256_setzero_si256());
+    }
+
+    __attribute__((target("avx2")))
+    inline std::size_t avx2_sum_lanes(__m256i const accumulator) noexcept {
+        return static_cast<std::size_t>(_mm256_extract_epi64(accumulator, 0)) +
+               static_cast<std::size_t>(_mm256_extract_epi64(accumulator, 1)) +
+               static_cast<std::size_t>(_mm256_extract_epi64(accumulator, 2)) +
+               static_cast<std::size_t>(_mm256_extract_epi64(accumulator, 3));
+    }
+
+    __attribute__((target("avx2")))
+    inline std::size_t avx2_count_words(uint64_t const * words, std::size_t const count) noexcept {
+        __m256i accumulator = _mm256_setzero_si256();
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m256i const block = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(words + i));
+            accumulator = _mm256_add_epi64(accumulator, avx2_popcount_lanes(block));
+        }
+
+        return avx2_sum_lanes(accumulator) + scalar_count_words(words + i, count - i);
+    }
+
+    __attribute__((target("avx2")))
+    inline bool avx2_intersects_words(uint64_t const * lhs, uint64_t const * rhs, std::size_t const count) noexcept {
+        std::size_t i = 0;
+        for (; i + 16 <= count; i += 16) { // test four vectors at once to amortise the branch.
+            __m256i block{_mm256_setzero_si256()};
+            for (std::size_t j = i; j < i + 16; j += 4)
+                block = _mm256_or_si256(block, _mm256_and_si256(
+                                               _mm256_loadu_si256(reinterpret_cast<__m256i const *>(lhs + j)),
+                                               _mm256_loadu_si256(reinterpret_cast<__m256i const *>(rhs + j))));
+            if (!_mm256_testz_si256(block, block))
+                return true;
+        }
+
+        for (; i + 4 <= count; i += 4) {
+            __m256i const a = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(lhs + i));
+            __m256i const b = _mm256_loadu_si256(reinterpret_cast<__m256i const *>(rhs + i));
+            if (!_mm256_testz_si256(a, b))
+                return true;
+        }
+
+        return scalar_intersects_words(lhs + i, rhs + i, count - i);
+    }
+
+    __attribute__((target("avx2")))
+    inline std::size_t avx2_and_count_words(uint64_t const * lhs,
+                                            uint64_t const * rhs,
+                                            std::size_t const count) noexcept {
+        __m256i accumulator = _mm256_setzero_si256();
+        std::size_t i = 0;
+        for (; i + 4 <= count; i += 4) {
+            __m256i const block = _mm256_and_si256(_mm256_loadu_si256(reinterpret_cast<__m256i const *>(lhs + i)),
+                                                   _mm256_loadu_si256(reinterpret_cast<__m256i const *>(rhs + i)));
+            accumulator = _mm256_add_epi64(accumulator, avx2_popcount_lanes(block));
+        }
+
+        return avx2_sum_lanes(accumulator) + scalar_and_count_words(lhs + i, rhs + i, count - i);
+    }
+
+    // Runs the rounds `j >= 4` on four rows `k` and `k + j` at once.
+    __attribute__((target("avx2")))
+    inline void avx2_transpose_rounds(uint64_t * block) noexcept {
+        for (std::size_t j = 32; j >= 4; j >>= 1) {
+            __m256i const mask = _mm256_set1_epi64x(static_cast<long long>(transpose_mask(j)));
+            __m128i const shift = _mm_cvtsi64_si128(static_cast<long long>(j));
+            for (std::size_t k = 0; k < 64; k = (k + j + 4) & ~j) {
+                __m256i * low = reinterpret_cast<__m256i *>(block + k);
+                __m256i * high = reinterpret_cast<__m256i *>(block + k + j);
+                __m256i const a = _mm256_loadu_si256(low);
+                __m256i const b = _mm256_loadu_si256(high);
+                __m256i const swapped = _mm256_and_si256(_mm256_xor_si256(_mm256_srl_epi64(a, shift), b), mask);
+                _mm256_storeu_si256(high, _mm256_xor_si256(b, swapped));
+                _mm256_storeu_si256(low, _mm256_xor_si256(a, _mm256_sll_epi64(swapped, shift)));
+            }
+        }
+    }
+
+    // Runs the round j < 4 within every vector, whose lanes `l` and `l ^ j` are exchanged by a permutation.
+    template <int j>
+    __attribute__((target("avx2")))
+    inline __m256i avx2_transpose_in_vector(__m256i const rows) noexcept {
+        constexpr int permutation = (j == 2) ? 0b01'00'11'10 : 0b10'11'00'01;
+        constexpr int low_lanes = (j == 2) ? 0b0000'1111 : 0b0011'0011; // the 32 bit lanes of the rows l & j == 0.
+        __m256i const mask = _mm256_set1_epi64x(static_cast<long long>(transpose_mask(j)));
+        __m256i const partners = _mm256_permute4x64_epi64(rows, permutation);
+        __m256i swapped = _mm256_and_si256(_mm256_xor_si256(_mm256_srli_epi64(rows, j), partners), mask);
+        swapped = _mm256_blend_epi32(_mm256_setzero_si256(), swapped, low_lanes);
+        return _mm256_xor_si256(rows, _mm256_or_si256(_mm256_slli_epi64(swapped, j),
+                                                      _mm256_permute4x64_epi64(swapped, permutation)));
+    }
+
+    __attribute__((target("avx2")))
+    inline void avx2_transpose_blocks(uint64_t * blocks, std::size_t const count) noexcept {
+        for (uint64_t * block = blocks; block != blocks + count * 64; block += 64) {
+            avx2_transpose_rounds(block);
+            for (std::size_t k = 0; k < 64; k += 4) {
+                __m256i * rows = reinterpret_cast<__m256i *>(block + k);
+                _mm256_storeu_si256(rows, avx2_transpose_in_vector<1>(
+                                          avx2_transpose_in_vector<2>(_mm256_loadu_si256(rows))));
+            }
+        }
+    }
+
+    inline constexpr bit_kernels avx2_bit_kernels{
+        .target = bit_kernel_target::avx2,
+        .and_words = avx2_transform_words<bit_and_op>,
+        .or_words = avx2_transform_words<bit_or_op>,
+        .xor_words = avx2_transform_words<bit_xor_op>,
+        .and_not_words = avx2_transform_words<bit_and_not_op>,
+        .any_words = avx2_any_words,
+        .all_words = avx2_all_words,
+        .count_words = avx2_count_words,
+        .intersects_words = avx2_intersects_words,
+        .and_count_words = avx2_and_count_words,
+        .transpose_blocks = avx2_transpose_blocks
+    };
+
+    // ----------------------------------------------------------------------------
+    // AVX-512 kernels
+    // ----------------------------------------------------------------------------
+
+    template <typename op_t>
+    __attribute__((target("avx512f")))
+    inline void avx512_transform_words(uint64_t * res,
+                                       uint64_t const * lhs,
+                                       uint64_t const * rhs,
+                                       std::size_t const count) noexcept {
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+            _mm512_storeu_si512(res + i, op_t::apply(_mm512_loadu_si512(lhs + i), _mm512_loadu_si512(rhs + i)));
+
+        if (i < count) { // the remaining words are processed with a masked operation.
+            __mmask8 const tail = static_cast<__mmask8>((1u << (count - i)) - 1);
+            __m512i const a = _mm512_maskz_loadu_epi64(tail, lhs + i);
+            __m512i const b = _mm512_maskz_loadu_epi64(tail, rhs + i);
+            _mm512_mask_storeu_epi64(res + i, tail, op_t::apply(a, b));
+        }
+    }
+
+    __attribute__((target("avx512f")))
+    inline bool avx512_any_words(uint64_t const * words, std::size_t const count) noexcept {
+        std::size_t i = 0;
+        for (; i + 32 <= count; i += 32) {
+            __m512i block = _mm512_or_si512(_mm512_loadu_si512(words + i), _mm512_loadu_si512(words + i + 8));
+            block = _mm512_or_si512(block, _mm512_loadu_si512(words + i + 16));
+            block = _mm512_or_si512(block, _mm512_loadu_si512(words + i + 24));
+            if (_mm512_test_epi64_mask(block, block) != 0)
+                return true;
+        }
+
+        for (; i < count; i += 8) {
+            __mmask8 const tail = (count - i >= 8) ? __mmask8{0xff} : static_cast<__mmask8>((1u << (count - i)) - 1);
+            __m512i const block = _mm512_maskz_loadu_epi64(tail, words + i);
+            if (_mm512_test_epi64_mask(block, block) != 0)
+                return true;
+        }
+
+        return false;
+    }
+
+    __attribute__((target("avx512f")))
+    inline bool avx512_all_words(uint64_t const * words, std::size_t const count) noexcept {
+        __m512i const ones = _mm512_set1_epi64(-1);
+        std::size_t i = 0;
+        for (; i + 32 <= count; i += 32) {
+            __m512i block = _mm512_and_si512(_mm512_loadu_si512(words + i), _mm512_loadu_si512(words + i + 8));
+            block = _mm512_and_si512(block, _mm512_loadu_si512(words + i + 16));
+            block = _mm512_and_si512(block, _mm512_loadu_si512(words + i + 24));
+            if (_mm512_cmpneq_epi64_mask(block, ones) != 0)
+                return false;
+        }
+
+        for (; i < count; i += 8) {
+            __mmask8 const tail = (count - i >= 8) ? __mmask8{0xff} : static_cast<__mmask8>((1u << (count - i)) - 1);
+            __m512i const block = _mm512_mask_loadu_epi64(ones, tail, words + i); // masked out lanes count as set.
+            if (_mm512_cmpneq_epi64_mask(block, ones) != 0)
+                return false;
+        }
+
+        return true;
+    }
+
+    __attribute__((target("avx512f")))
+    inline bool avx512_intersects_words(uint64_t const * lhs, uint64_t const * rhs, std::size_t const count) noexcept {
+        std::size_t i = 0;
+        for (; i + 32 <= count; i += 32) {
+            __m512i block{_mm512_setzero_si512()};
+            for (std::size_t j = i; j < i + 32; j += 8)
+                block = _mm512_or_si512(block,
+                                        _mm512_and_si512(_mm512_loadu_si512(lhs + j), _mm512_loadu_si512(rhs + j)));
+            if (_mm512_test_epi64_mask(block, block) != 0)
+                return true;
+        }
+
+        for (; i < count; i += 8) {
+            __mmask8 const tail = (count - i >= 8) ? __mmask8{0xff} : static_cast<__mmask8>((1u << (count - i)) - 1);
+            __m512i const a = _mm512_maskz_loadu_epi64(tail, lhs + i);
+            __m512i const b = _mm512_maskz_loadu_epi64(tail, rhs + i);
+            if (_mm512_test_epi64_mask(a, b) != 0)
+                return true;
+        }
+
+        return false;
+    }
+
+    __attribute__((target("avx512f")))
+    inline std::size_t avx512_sum_lanes(__m512i const accumulator) noexcept {
+        alignas(64) uint64_t lane_counts[8]; // _mm512_reduce_add_epi64 warns spuriously with GCC 12.
+        _mm512_store_si512(lane_counts, accumulator);
+        std::size_t bit_count{};
+        for (uint64_t const lane_count : lane_counts)
+            bit_count += lane_count;
+
+        return bit_count;
+    }
+
+    __attribute__((target("avx512f,avx512vpopcntdq")))
+    inline std::size_t avx512_count_words(uint64_t const * words, std::size_t const count) noexcept {
+        __m512i accumulator = _mm512_setzero_si512();
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8)
+            accumulator = _mm512_add_epi64(accumulator, _mm512_popcnt_epi64(_mm512_loadu_si512(words + i)));
+
+        if (i < count) {
+            __mmask8 const tail = static_cast<__mmask8>((1u << (count - i)) - 1);
+            __m512i const block = _mm512_maskz_loadu_epi64(tail, words + i);
+            accumulator = _mm512_add_epi64(accumulator, _mm512_popcnt_epi64(block));
+        }
+
+        return avx512_sum_lanes(accumulator);
+    }
+
+    __attribute__((target("avx512f,avx512vpopcntdq")))
+    inline std::size_t avx512_and_count_words(uint64_t const * lhs,
+                                              uint64_t const * rhs,
+                                              std::size_t const count) noexcept {
+        __m512i accumulator = _mm512_setzero_si512();
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            __m512i const block = _mm512_and_si512(_mm512_loadu_si512(lhs + i), _mm512_loadu_si512(rhs + i));
+            accumulator = _mm512_add_epi64(accumulator, _mm512_popcnt_epi64(block));
+        }
+
+        if (i < count) {
+            __mmask8 const tail = static_cast<__mmask8>((1u << (count - i)) - 1);
+            __m512i const block = _mm512_maskz_and_epi64(tail,
+                                                         _mm512_maskz_loadu_epi64(tail, lhs + i),
+                                                         _mm512_maskz_loadu_epi64(tail, rhs + i));
+            accumulator = _mm512_add_epi64(accumulator, _mm512_popcnt_epi64(block));
+        }
+
+        return avx512_sum_lanes(accumulator);
+    }
+
+    // The unmasked AVX-512 shifts and permutations pass an undefined source to their builtins, for which GCC 12 reports
+    // -Wmaybe-uninitialized once inlined. Their zero-masked forms are used with all lanes selected instead.
+    inline constexpr __mmask8 avx512_all_lanes = 0b1111'1111;
+
+    // Runs the round `j >= 8` on eight rows `k` and `k + j` at once.
+    template <int j>
+    __attribute__((target("avx512f")))
+    inline void avx512_transpose_round(uint64_t * block) noexcept {
+        __m512i const mask = _mm512_set1_epi64(static_cast<long long>(transpose_mask(j)));
+        for (std::size_t k = 0; k < 64; k = (k + j + 8) & ~static_cast<std::size_t>(j)) {
+            __m512i const a = _mm512_loadu_si512(block + k);
+            __m512i const b = _mm512_loadu_si512(block + k + j);
+            __m512i const shifted = _mm512_maskz_srli_epi64(avx512_all_lanes, a, j);
+            __m512i const swapped = _mm512_and_si512(_mm512_xor_si512(shifted, b), mask);
+            _mm512_storeu_si512(block + k + j, _mm512_xor_si512(b, swapped));
+            _mm512_storeu_si512(block + k, _mm512_xor_si512(a, _mm512_maskz_slli_epi64(avx512_all_lanes, swapped, j)));
+        }
+    }
+
+    // Runs the round j < 8 within every vector, whose lanes `l` and `l ^ j` are exchanged by a permutation.
+    template <int j>
+    __attribute__((target("avx512f")))
+    inline __m512i avx512_transpose_in_vector(__m512i const rows) noexcept {
+        constexpr __mmask8 low_lanes = (j == 4) ? 0b0000'1111 : (j == 2) ? 0b0011'0011 : 0b0101'0101;
+        __m512i const permutation = _mm512_set_epi64(7 ^ j, 6 ^ j, 5 ^ j, 4 ^ j, 3 ^ j, 2 ^ j, 1 ^ j, 0 ^ j);
+        __m512i const mask = _mm512_set1_epi64(static_cast<long long>(transpose_mask(j)));
+        __m512i const partners = _mm512_maskz_permutexvar_epi64(avx512_all_lanes, permutation, rows);
+        __m512i const shifted = _mm512_maskz_srli_epi64(avx512_all_lanes, rows, j);
+        __m512i const swapped = _mm512_maskz_and_epi64(low_lanes, _mm512_xor_si512(shifted, partners), mask);
+        return _mm512_xor_si512(rows, _mm512_or_si512(_mm512_maskz_slli_epi64(avx512_all_lanes, swapped, j),
+                                                      _mm512_maskz_permutexvar_epi64(avx512_all_lanes, permutation,
+                                                                                     swapped)));
+    }
+
+    __attribute__((target("avx512f")))
+    inline void avx512_transpose_blocks(uint64_t * blocks, std::size_t const count) noexcept {
+        for (uint64_t * block = blocks; block != blocks + count * 64; block += 64) {
+            avx512_transpose_round<32>(block);
+            avx512_transpose_round<16>(block);
+            avx512_transpose_round<8>(block);
+            for (std::size_t k = 0; k < 64; k += 8) {
+                __m512i rows = _mm512_loadu_si512(block + k);
+                rows = avx512_transpose_in_vector<4>(rows);
+                rows = avx512_transpose_in_vector<2>(rows);
+                _mm512_storeu_si512(block + k, avx512_transpose_in_vector<1>(rows));
+            }
+        }
+    }
+
+    inline constexpr bit_kernels avx512_bit_kernels{
+        .target = bit_kernel_target::avx512,
+        .and_words = avx512_transform_words<bit_and_op>,
+        .or_words = avx512_transform_words<bit_or_op>,
+        .xor_words = avx512_transform_words<bit_xor_op>,
+        .and_not_words = avx512_transform_words<bit_and_not_op>,
+        .any_words = avx512_any_words,
+        .all_words = avx512_all_words,
+        .count_words = avx2_count_words, // replaced if VPOPCNTDQ is available, see select_bit_kernels.
+        .intersects_words = avx512_intersects_words,
+        .and_count_words = avx2_and_count_words, // replaced if VPOPCNTDQ is available, see select_bit_kernels.
+        .transpose_blocks = avx512_transpose_blocks
+    };
+#endif // LIBJST_BIT_KERNELS_X86
+
+#if LIBJST_BIT_KERNELS_NEON
+    // ----------------------------------------------------------------------------
+    // NEON kernels
+    // ----------------------------------------------------------------------------
+
+    template <typename op_t>
+    inline void neon_transform_words(uint64_t * res,
+                                     uint64_t const * lhs,
+                                     uint64_t const * rhs,
+                                     std::size_t const count) noexcept {
+        std::size_t i = 0;
+        for (; i + 2 <= count; i += 2)
+            vst1q_u64(res + i, op_t::apply(vld1q_u64(lhs + i), vld1q_u64(rhs + i)));
+
+        for (; i < count; ++i)
+            res[i] = op_t::apply(lhs[i], rhs[i]);
+    }
+
+    inline bool neon_any_words(uint64_t const * words, std::size_t const count) noexcept {
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            uint64x2_t block = vorrq_u64(vld1q_u64(words + i), vld1q_u64(words + i + 2));
+            block = vorrq_u64(block, vorrq_u64(vld1q_u64(words + i + 4), vld1q_u64(words + i + 6)));
+            if ((vgetq_lane_u64(block, 0) | vgetq_lane_u64(block, 1)) != 0)
+                return true;
+        }
+
+        return scalar_any_words(words + i, count - i);
+    }
+
+    inline bool neon_all_words(uint64_t const * words, std::size_t const count) noexcept {
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            uint64x2_t block = vandq_u64(vld1q_u64(words + i), vld1q_u64(words + i + 2));
+            block = vandq_u64(block, vandq_u64(vld1q_u64(words + i + 4), vld1q_u64(words + i + 6)));
+            if (~(vgetq_lane_u64(block, 0) & vgetq_lane_u64(block, 1)) != 0)
+                return false;
+        }
+
+        return scalar_all_words(words + i, count - i);
+    }
+
+    inline std::size_t neon_count_words(uint64_t const * words, std::size_t const count) noexcept {
+        std::size_t bit_count{};
+        std::size_t i = 0;
+        for (; i + 2 <= count; i += 2) // at most 128 bits per vector, which fits into the summed bytes.
+            bit_count += vaddvq_u8(vcntq_u8(vreinterpretq_u8_u64(vld1q_u64(words + i))));
+
+        return bit_count + scalar_count_words(words + i, count - i);
+    }
+
+    inline bool neon_intersects_words(uint64_t const * lhs, uint64_t const * rhs, std::size_t const count) noexcept {
+        std::size_t i = 0;
+        for (; i + 8 <= count; i += 8) {
+            uint64x2_t block = vandq_u64(vld1q_u64(lhs + i), vld1q_u64(rhs + i));
+            for (std::size_t j = i + 2; j < i + 8; j += 2)
+                block = vorrq_u64(block, vandq_u64(vld1q_u64(lhs + j), vld1q_u64(rhs + j)));
+            if ((vgetq_lane_u64(block, 0) | vgetq_lane_u64(block, 1)) != 0)
+                return true;
+        }
+
+        return scalar_intersects_words(lhs + i, rhs + i, count - i);
+    }
+
+    inline std::size_t neon_and_count_words(uint64_t const * lhs,
+                                            uint64_t const * rhs,
+                                            std::size_t const count) noexcept {
+        std::size_t bit_count{};
+        std::size_t i = 0;
+        for (; i + 2 <= count; i += 2)
+            bit_count += vaddvq_u8(vcntq_u8(vreinterpretq_u8_u64(vandq_u64(vld1q_u64(lhs + i), vld1q_u64(rhs + i)))));
+
+        return bit_count + scalar_and_count_words(lhs + i, rhs + i, count - i);
+    }
+
+    inline constexpr bit_kernels neon_bit_kernels{
+        .target = bit_kernel_target::neon,
+        .and_words = neon_transform_words<bit_and_op>,
+        .or_words = neon_transform_words<bit_or_op>,
+        .xor_words = neon_transform_words<bit_xor_op>,
+        .and_not_words = neon_transform_words<bit_and_not_op>,
+        .any_words = neon_any_words,
+        .all_words = neon_all_words,
+        .count_words = neon_count_words,
+        .intersects_words = neon_intersects_words,
+        .and_count_words = neon_and_count_words,
+        .transpose_blocks = scalar_transpose_blocks // the rounds j >= 2 are vectorised by the compiler.
+    };
+#endif // LIBJST_BIT_KERNELS_NEON
+
+    // ----------------------------------------------------------------------------
+    // Dispatch
+    // ----------------------------------------------------------------------------
+
+    //!\brief Returns whether the executing CPU supports the given target.
+    inline bool supports_bit_kernel_target(bit_kernel_target const target) noexcept {
+        switch (target) {
+            case bit_kernel_target::scalar: return true;
+#if LIBJST_BIT_KERNELS_X86
+            case bit_kernel_target::avx2: __builtin_cpu_init(); return __builtin_cpu_supports("avx2");
+            case bit_kernel_target::avx512: __builtin_cpu_init(); return __builtin_cpu_supports("avx512f");
+#endif
+#if LIBJST_BIT_KERNELS_NEON
+            case bit_kernel_target::neon: return true;
+#endif
+            default: return false;
+        }
+    }
+
+    /*!\brief Returns the kernels of the given target.
+     *
+     * \details
+     *
+     * Falls back to the scalar kernels if the given target is not supported by the executing CPU.
+     */
+    inline bit_kernels select_bit_kernels(bit_kernel_target const target) noexcept {
+        if (!supports_bit_kernel_target(target))
+            return scalar_bit_kernels;
+
+        switch (target) {
+#if LIBJST_BIT_KERNELS_X86
+            case bit_kernel_target::avx2: return avx2_bit_kernels;
+            case bit_kernel_target::avx512: {
+                bit_kernels kernels = avx512_bit_kernels;
+                if (__builtin_cpu_supports("avx512vpopcntdq")) {
+                    kernels.count_words = avx512_count_words;
+                    kernels.and_count_words = avx512_and_count_words;
+                }
+                return kernels;
+            }
+#endif
+#if LIBJST_BIT_KERNELS_NEON
+            case bit_kernel_target::neon: return neon_bit_kernels;
+#endif
+            default: return scalar_bit_kernels;
+        }
+    }
+
+    //!\brief Returns the kernels of the widest target supported by the executing CPU, which is selected once.
+    inline bit_kernels const & active_bit_kernels() noexcept {
+        static bit_kernels const kernels = [] () {
+            for (bit_kernel_target target : {bit_kernel_target::avx512,
+                                             bit_kernel_target::avx2,
+                                             bit_kernel_target::neon})
+                if (supports_bit_kernel_target(target))
+                    return select_bit_kernels(target);
+
+            return scalar_bit_kernels;
+        }();
+        return kernels;
+    }
+
+    // ----------------------------------------------------------------------------
+    // Fused bit operations
+    // ----------------------------------------------------------------------------
+
+    /*!\brief Returns whether `lhs & rhs` has any of its first `bit_count` bits set.
+     *
+     * \details
+     *
+     * Scans the words with the active kernels, see libjst::detail::active_bit_kernels, and stops at the first
+     * intersecting word. The padding bits of the last word are ignored and no result is materialised.
+     */
+    constexpr bool intersects_bits(uint64_t const * lhs, uint64_t const * rhs, std::size_t const bit_count) noexcept {
+        std::size_t const full_words = bit_count / 64;
+        uint64_t const tail_mask = (uint64_t{1} << (bit_count % 64)) - 1;
+        if (tail_mask != 0 && (lhs[full_words] & rhs[full_words] & tail_mask) != 0)
+            return true;
+
+        if (std::is_constant_evaluated())
+            return scalar_intersects_words(lhs, rhs, full_words);
+        else
+            return active_bit_kernels().intersects_words(lhs, rhs, full_words);
+    }
+
+    //!\brief Returns the number of set bits among the first `bit_count` bits of `lhs & rhs`.
+    constexpr std::size_t intersection_count_bits(uint64_t const * lhs,
+                                                  uint64_t const * rhs,
+                                                  std::size_t const bit_count) noexcept {
+        std::size_t const full_words = bit_count / 64;
+        uint64_t const tail_mask = (uint64_t{1} << (bit_count % 64)) - 1;
+        std::size_t tail_count{};
+        if (tail_mask != 0)
+            tail_count = std::popcount(lhs[full_words] & rhs[full_words] & tail_mask);
+
+        if (std::is_constant_evaluated())
+            return scalar_and_count_words(lhs, rhs, full_words) + tail_count;
+        else
+            return active_bit_kernels().and_count_words(lhs, rhs, full_words) + tail_count;
+    }
+
+    //!\brief Transposes `count` consecutive 64×64 bit blocks in place with the active kernels.
+    constexpr void transpose_bit_blocks(uint64_t * blocks, std::size_t const count) noexcept {
+        if (std::is_constant_evaluated())
+            scalar_transpose_blocks(blocks, count);
+        else
+            active_bit_kernels().transpose_blocks(blocks, count);
+    }
+}  // namespace libjst::detail
+
+#undef LIBJST_BIT_KERNELS_X86
+#undef LIBJST_BIT_KERNELS_NEON
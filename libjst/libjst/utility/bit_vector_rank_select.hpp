@@ -0,0 +1,231 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::bit_vector_rank_select.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <cereal/types/vector.hpp>
+
+#include <libjst/utility/bit_vector.hpp>
+
+namespace libjst
+{
+
+/*!\brief A rank and select support structure for a libjst::bit_vector.
+ *
+ * \tparam bit_vector_t The type of the supported bit vector.
+ *
+ * \details
+ *
+ * Stores the number of set bits preceding every superblock of eight words side-by-side with the referenced bit
+ * vector, which costs one 64 bit counter per 512 bits. libjst::bit_vector_rank_select::rank adds the popcount of at
+ * most eight words to the counter of the superblock and runs in constant time; libjst::bit_vector_rank_select::select
+ * binary searches the superblock counters and scans at most eight words.
+ *
+ * The structure references the bit vector and does not observe its modifications. After the bits changed, e.g. by
+ * libjst::bit_vector::operator&=, the counters must be recomputed with libjst::bit_vector_rank_select::rebuild, which
+ * is a single linear popcount pass over the words. Only the counters are serialised; after loading, the structure
+ * must be bound to the bit vector it has been built for with libjst::bit_vector_rank_select::set_vector.
+ */
+template <typename bit_vector_t = bit_vector<>>
+class bit_vector_rank_select
+{
+private:
+    //!\brief The type of the underlying chunk of bits.
+    using chunk_type = uint64_t;
+
+    //!\brief The number of bits represented in one chunk, e.g. 64.
+    static constexpr size_t chunk_size = sizeof(chunk_type) * 8;
+    //!\brief The number of chunks covered by one superblock counter.
+    static constexpr size_t superblock_chunks = 8;
+
+    bit_vector_t const * _bits{}; //!< The supported bit vector.
+    std::vector<uint64_t> _superblock_ranks{}; //!< The set bits preceding every superblock plus the total count.
+
+public:
+    //!\brief The size_type.
+    using size_type = size_t;
+
+    /*!\name Constructors, destructor and assignment
+     * \{
+     */
+    bit_vector_rank_select() = default; //!< Default.
+
+    //!\brief Builds the support structure for the given bit vector.
+    explicit bit_vector_rank_select(bit_vector_t const & bits)
+    {
+        rebuild(bits);
+    }
+    //!\}
+
+    /*!\name Modifiers
+     * \{
+     */
+    //!\brief Recomputes the counters after the referenced bit vector has been modified.
+    void rebuild()
+    {
+        assert(_bits != nullptr);
+
+        chunk_type const * chunks = _bits->data();
+        size_type const chunk_count = _bits->size() / chunk_size;
+        size_type const superblock_count = (chunk_count + superblock_chunks) / superblock_chunks;
+        _superblock_ranks.resize(superblock_count + 1);
+
+        uint64_t rank{};
+        for (size_type superblock = 0; superblock < superblock_count; ++superblock) {
+            _superblock_ranks[superblock] = rank;
+            size_type const first = superblock * superblock_chunks;
+            size_type const last = std::min(first + superblock_chunks, chunk_count);
+            for (size_type chunk = first; chunk < last; ++chunk)
+                rank += std::popcount(chunks[chunk]);
+        }
+        rank += std::popcount(tail_chunk()); // ignore the padding bits.
+        _superblock_ranks.back() = rank;
+    }
+
+    //!\brief Binds the structure to the given bit vector and recomputes the counters.
+    void rebuild(bit_vector_t const & bits)
+    {
+        _bits = std::addressof(bits);
+        rebuild();
+    }
+
+    /*!\brief Binds the structure to the given bit vector without recomputing the counters.
+     *
+     * \details
+     *
+     * Used after loading the counters or after the supported bit vector has been moved. The bits must be the ones the
+     * counters have been computed for.
+     */
+    void set_vector(bit_vector_t const & bits) noexcept
+    {
+        _bits = std::addressof(bits);
+    }
+    //!\}
+
+    /*!\name Queries
+     * \{
+     */
+    //!\brief Returns the number of set bits in `[0, position)`; requires `position <= size()`.
+    size_type rank(size_type const position) const noexcept
+    {
+        assert(_bits != nullptr);
+        assert(position <= _bits->size());
+
+        chunk_type const * chunks = _bits->data();
+        size_type const chunk = position / chunk_size;
+        size_type rank = _superblock_ranks[chunk / superblock_chunks];
+        for (size_type i = chunk - (chunk % superblock_chunks); i < chunk; ++i)
+            rank += std::popcount(chunks[i]);
+
+        if (size_type const offset = position % chunk_size; offset > 0)
+            rank += std::popcount(chunks[chunk] & ((chunk_type{1} << offset) - 1));
+
+        return rank;
+    }
+
+    //!\brief Returns the position of the `k`-th set bit, counting from 0; requires `k < count()`.
+    size_type select(size_type const k) const noexcept
+    {
+        assert(_bits != nullptr);
+        assert(k < count());
+
+        auto superblock_it = std::ranges::upper_bound(_superblock_ranks, k);
+        size_type const superblock = std::ranges::distance(_superblock_ranks.begin(), superblock_it) - 1;
+        size_type remaining = k - _superblock_ranks[superblock];
+
+        chunk_type const * chunks = _bits->data();
+        size_type chunk = superblock * superblock_chunks;
+        for (size_type ones = std::popcount(chunks[chunk]); remaining >= ones; ones = std::popcount(chunks[++chunk]))
+            remaining -= ones;
+
+        return chunk * chunk_size + select_in_chunk(chunks[chunk], remaining);
+    }
+
+    //!\brief Returns the number of set bits.
+    size_type count() const noexcept
+    {
+        return _superblock_ranks.empty() ? 0 : _superblock_ranks.back();
+    }
+
+    //!\brief Returns the number of bytes occupied by the counters.
+    size_type memory_usage() const noexcept
+    {
+        return _superblock_ranks.size() * sizeof(uint64_t);
+    }
+    //!\}
+
+    /*!\name Serialisation
+     * \{
+     */
+    /*!\brief Saves the counters to the given output archive.
+     *
+     * \tparam output_archive_t The type of the output_archive; must model typename.
+     *
+     * \param[in, out] archive The archive to serialise this object to.
+     */
+    template <typename output_archive_t>
+    void save(output_archive_t & archive) const
+    {
+        archive(_superblock_ranks);
+    }
+
+    /*!\brief Loads the counters from the given input archive.
+     *
+     * \tparam input_archive_t The type of the input_archive; must model typename.
+     *
+     * \param[in, out] archive The archive to serialise this object from.
+     */
+    template <typename input_archive_t>
+    void load(input_archive_t & archive)
+    {
+        archive(_superblock_ranks);
+    }
+    //!\}
+
+private:
+    //!\brief Returns the partially filled last chunk with the padding bits cleared, or 0 if there is none.
+    chunk_type tail_chunk() const noexcept
+    {
+        size_type const tail_size = _bits->size() % chunk_size;
+        if (tail_size == 0)
+            return 0;
+
+        return _bits->data()[_bits->size() / chunk_size] & ((chunk_type{1} << tail_size) - 1);
+    }
+
+    //!\brief Returns the position of the `k`-th set bit within the chunk; requires `k < std::popcount(chunk)`.
+    static constexpr size_type select_in_chunk(chunk_type chunk, size_type k) noexcept
+    {
+        assert(k < static_cast<size_type>(std::popcount(chunk)));
+
+        size_type offset{};
+        for (size_type ones = std::popcount(chunk & 0xff); k >= ones; ones = std::popcount(chunk & 0xff)) {
+            k -= ones; // skip whole bytes first.
+            chunk >>= 8;
+            offset += 8;
+        }
+
+        for (; k > 0; --k)
+            chunk &= chunk - 1; // clear the lowest set bit.
+
+        return offset + std::countr_zero(chunk);
+    }
+};
+
+} // namespace libjst
@@ -0,0 +1,284 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::elias_fano_sequence.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <bit>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <stdexcept>
+#include <vector>
+
+#include <libjst/utility/memory_usage.hpp>
+
+namespace libjst
+{
+    /*!\brief A compressed, immutable sequence of sorted unsigned integers in the Elias-Fano encoding.
+     *
+     * \details
+     *
+     * Every value smaller than the universe `u` of the sequence is split into its `l = floor(log2(u / n))` low bits,
+     * which are stored bit packed, and its high bits, which are stored in unary: the `i`-th value sets the bit at
+     * `(value >> l) + i` of the high bit vector. The sequence of `n` values hence occupies at most
+     * `n * (2 + l)` bits, e.g. six instead of 32 bits per value if every 16th position of the universe is stored.
+     *
+     * The positions of every 256th set and cleared bit of the high bits are sampled, such that the `i`-th value and
+     * the bucket of values sharing the same high bits are found by scanning a few words behind the closest sample.
+     * libjst::elias_fano_sequence::lower_bound therefore locates the bucket of the searched value in constant time and
+     * only compares the values within this bucket, which are on average fewer than two.
+     */
+    class elias_fano_sequence {
+    private:
+
+        //!\brief The number of set, respectively cleared, bits between two samples of the high bits.
+        static constexpr std::size_t sample_rate{256};
+        static constexpr std::size_t word_size{64};
+
+        std::vector<uint64_t> _low_bits{}; //!< The bit packed low bits of the values.
+        std::vector<uint64_t> _high_bits{}; //!< The unary coded high bits of the values.
+        std::vector<std::size_t> _one_samples{}; //!< The position of every sample_rate-th set bit.
+        std::vector<std::size_t> _zero_samples{}; //!< The position of every sample_rate-th cleared bit.
+        std::size_t _size{};
+        std::size_t _low_width{};
+        std::size_t _bucket_count{}; //!< The number of cleared bits of the high bits, one per bucket.
+        uint64_t _universe{};
+
+    public:
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        elias_fano_sequence() = default; //!< Default.
+
+        /*!\brief Encodes the given sorted values.
+         *
+         * \param[in] sorted_values The values to encode in non-decreasing order; must be less than the universe.
+         * \param[in] universe The exclusive upper bound of the values.
+         *
+         * ### Exception
+         *
+         * Throws std::invalid_argument if the values are not sorted or not less than the universe.
+         *
+         * ### Complexity
+         *
+         * Linear in the number of values plus the universe divided by the number of values.
+         */
+        template <std::ranges::forward_range values_t>
+            requires std::ranges::sized_range<values_t> &&
+                     std::convertible_to<std::ranges::range_reference_t<values_t>, uint64_t>
+        elias_fano_sequence(values_t && sorted_values, uint64_t const universe) :
+            _size{std::ranges::size(sorted_values)},
+            _universe{universe}
+        {
+            if (_size > 0 && universe > _size)
+                _low_width = std::bit_width(universe / _size) - 1;
+
+            _bucket_count = static_cast<std::size_t>(universe >> _low_width) + 1;
+            _low_bits.resize(word_count(_size * _low_width));
+            _high_bits.resize(word_count(_size + _bucket_count));
+
+            uint64_t previous{};
+            std::size_t index{};
+            for (auto && element : sorted_values) {
+                uint64_t const value = static_cast<uint64_t>(element);
+                if (value < previous || value >= universe)
+                    throw std::invalid_argument{"The values of the Elias-Fano sequence must be sorted and less than "
+                                                "the universe!"};
+
+                set_low(index, value);
+                std::size_t const high_position = static_cast<std::size_t>(value >> _low_width) + index;
+                _high_bits[high_position / word_size] |= uint64_t{1} << (high_position % word_size);
+                previous = value;
+                ++index;
+            }
+
+            build_samples();
+        }
+        //!\}
+
+        /*!\name Element access
+         * \{
+         */
+        //!\brief Returns the value at the given index; requires `index < size()`.
+        uint64_t operator[](std::size_t const index) const noexcept {
+            assert(index < size());
+            uint64_t const high = select(index, _one_samples, false) - index;
+            return (high << _low_width) | get_low(index);
+        }
+        //!\}
+
+        /*!\name Search
+         * \{
+         */
+        /*!\brief Returns the index of the first value that is not less than the given value.
+         *
+         * \param[in] value The value to search.
+         *
+         * \returns The index of the lower bound, or size() if all values are less than the given value.
+         *
+         * ### Complexity
+         *
+         * Constant on average; linear in the number of values sharing the high bits of the given value.
+         */
+        std::size_t lower_bound(uint64_t const value) const noexcept {
+            if (value >= _universe)
+                return _size;
+
+            std::size_t const bucket = static_cast<std::size_t>(value >> _low_width);
+            uint64_t const low = value & low_mask();
+            // The bucket begins behind the cleared bit ending the previous bucket.
+            std::size_t position = (bucket == 0) ? 0 : select(bucket - 1, _zero_samples, true) + 1;
+            std::size_t index = position - bucket;
+            for (; test_high(position) && get_low(index) < low; ++position, ++index)
+            {}
+            return index;
+        }
+
+        /*!\brief Returns the index of the first value that is greater than the given value.
+         *
+         * \param[in] value The value to search.
+         *
+         * \returns The index of the upper bound, or size() if no value is greater than the given value.
+         *
+         * ### Complexity
+         *
+         * See libjst::elias_fano_sequence::lower_bound.
+         */
+        std::size_t upper_bound(uint64_t const value) const noexcept {
+            return (value >= _universe) ? _size : lower_bound(value + 1);
+        }
+        //!\}
+
+        /*!\name Capacity
+         * \{
+         */
+        //!\brief Returns the number of values.
+        constexpr std::size_t size() const noexcept {
+            return _size;
+        }
+
+        //!\brief Returns whether the sequence is empty.
+        constexpr bool empty() const noexcept {
+            return _size == 0;
+        }
+
+        //!\brief Returns the exclusive upper bound of the values.
+        constexpr uint64_t universe() const noexcept {
+            return _universe;
+        }
+
+        //!\brief Returns the number of low bits stored per value.
+        constexpr std::size_t low_width() const noexcept {
+            return _low_width;
+        }
+
+        //!\brief Returns the number of bytes allocated for the low bits, the high bits and the samples.
+        std::size_t memory_usage() const noexcept {
+            return libjst::memory_usage(_low_bits) + libjst::memory_usage(_high_bits) +
+                   libjst::memory_usage(_one_samples) + libjst::memory_usage(_zero_samples);
+        }
+        //!\}
+
+    private:
+
+        static constexpr std::size_t word_count(std::size_t const bit_count) noexcept {
+            return (bit_count + word_size - 1) / word_size;
+        }
+
+        constexpr uint64_t low_mask() const noexcept {
+            return (_low_width == 0) ? 0 : (~uint64_t{0} >> (word_size - _low_width));
+        }
+
+        void set_low(std::size_t const index, uint64_t const value) noexcept {
+            if (_low_width == 0)
+                return;
+
+            std::size_t const bit = index * _low_width;
+            std::size_t const offset = bit % word_size;
+            uint64_t const low = value & low_mask();
+            _low_bits[bit / word_size] |= low << offset;
+            if (offset + _low_width > word_size)
+                _low_bits[bit / word_size + 1] |= low >> (word_size - offset);
+        }
+
+        uint64_t get_low(std::size_t const index) const noexcept {
+            if (_low_width == 0)
+                return 0;
+
+            std::size_t const bit = index * _low_width;
+            std::size_t const offset = bit % word_size;
+            uint64_t low = _low_bits[bit / word_size] >> offset;
+            if (offset + _low_width > word_size)
+                low |= _low_bits[bit / word_size + 1] << (word_size - offset);
+            return low & low_mask();
+        }
+
+        bool test_high(std::size_t const position) const noexcept {
+            return position < _size + _bucket_count &&
+                   ((_high_bits[position / word_size] >> (position % word_size)) & 1);
+        }
+
+        // Returns the high bits word at the given index, inverted when searching the cleared bits.
+        uint64_t high_word(std::size_t const index, bool const cleared) const noexcept {
+            return cleared ? ~_high_bits[index] : _high_bits[index];
+        }
+
+        void build_samples() {
+            std::size_t ones{};
+            std::size_t zeros{};
+            for (std::size_t position = 0; position < _size + _bucket_count; ++position) {
+                if (test_high(position)) {
+                    if (ones++ % sample_rate == 0)
+                        _one_samples.push_back(position);
+                } else if (zeros++ % sample_rate == 0) {
+                    _zero_samples.push_back(position);
+                }
+            }
+        }
+
+        // Returns the position of the k-th set or cleared bit of the high bits, which must exist.
+        std::size_t select(std::size_t const k, std::vector<std::size_t> const & samples, bool const cleared)
+            const noexcept
+        {
+            std::size_t const sample_position = samples[k / sample_rate];
+            std::size_t remaining = k % sample_rate;
+            std::size_t word_index = sample_position / word_size;
+            // Clears the bits preceding the sample, which is the first counted bit.
+            uint64_t word = high_word(word_index, cleared) & (~uint64_t{0} << (sample_position % word_size));
+            for (std::size_t count = std::popcount(word); remaining >= count; count = std::popcount(word)) {
+                remaining -= count;
+                word = high_word(++word_index, cleared);
+            }
+            return word_index * word_size + select_in_word(word, remaining);
+        }
+
+        //!\brief Returns the position of the `k`-th set bit within the word; requires `k < std::popcount(word)`.
+        static constexpr std::size_t select_in_word(uint64_t word, std::size_t k) noexcept {
+            assert(k < static_cast<std::size_t>(std::popcount(word)));
+
+            std::size_t offset{};
+            for (std::size_t ones = std::popcount(word & 0xff); k >= ones; ones = std::popcount(word & 0xff)) {
+                k -= ones; // skip whole bytes first.
+                word >>= 8;
+                offset += 8;
+            }
+
+            for (; k > 0; --k)
+                word &= word - 1; // clear the lowest set bit.
+
+            return offset + std::countr_zero(word);
+        }
+    };
+}  // namespace libjst
@@ -0,0 +1,139 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::eytzinger_index.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <ranges>
+#include <vector>
+
+#include <libjst/utility/memory_usage.hpp>
+
+namespace libjst
+{
+    /*!\brief A search index over a sorted sequence storing a copy of the values in Eytzinger layout.
+     *
+     * \tparam value_t The type of the indexed values.
+     * \tparam compare_t The strict weak order the values are sorted by; defaults to `std::less<value_t>`.
+     *
+     * \details
+     *
+     * The values are arranged in the breadth first order of the implicit binary search tree over the sorted sequence,
+     * i.e. the children of the node at index `k` are stored at `2k` and `2k + 1`. A lower bound search descends
+     * from the root without branching on the comparison, and the first levels of the tree share the same cachelines
+     * for all searches. The descendants of a node that fill one cacheline a few levels below it are contiguous and
+     * prefetched in every step, which hides most of the memory latency a binary search over a large sorted array
+     * incurs.
+     * The rank of every node in the sorted sequence is stored alongside, such that a search returns the offset of
+     * the lower bound in the indexed sequence.
+     *
+     * The index is a snapshot of the sequence it was built from and must be rebuilt after the sequence changed.
+     */
+    template <std::semiregular value_t, typename compare_t = std::less<value_t>>
+    class eytzinger_index {
+    private:
+
+        //!\brief The number of values in a cacheline; at least one.
+        static constexpr std::size_t values_per_cacheline{std::max<std::size_t>(64 / sizeof(value_t), 1)};
+
+        std::vector<value_t> _layout{}; //!< The values in Eytzinger layout, beginning at index 1.
+        std::vector<std::size_t> _ranks{}; //!< The rank of every value in the sorted sequence.
+
+    public:
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        eytzinger_index() = default; //!< Default.
+
+        /*!\brief Builds the index over the given sorted values.
+         *
+         * \param[in] sorted_values The values to index; must be sorted by `compare_t`.
+         *
+         * ### Complexity
+         *
+         * Linear in the number of values.
+         */
+        template <std::ranges::random_access_range values_t>
+            requires std::ranges::sized_range<values_t> &&
+                     std::constructible_from<value_t, std::ranges::range_reference_t<values_t>>
+        explicit eytzinger_index(values_t && sorted_values) :
+            _layout(std::ranges::size(sorted_values) + 1),
+            _ranks(std::ranges::size(sorted_values) + 1)
+        {
+            std::size_t rank{};
+            build(sorted_values, rank, 1);
+        }
+        //!\}
+
+        /*!\brief Returns the offset of the first value that is not less than the given key.
+         *
+         * \param[in] key The key to search.
+         *
+         * \returns The offset in the indexed sequence, or its size if all values are less than the key.
+         *
+         * ### Complexity
+         *
+         * Logarithmic in the number of values.
+         */
+        template <typename key_t>
+        std::size_t lower_bound(key_t const & key) const noexcept {
+            compare_t compare{};
+            std::size_t const count = size();
+            value_t const * layout = _layout.data();
+
+            std::size_t node{1};
+            while (node <= count) {
+#if defined(__GNUC__) || defined(__clang__)
+                __builtin_prefetch(layout + std::min(node * values_per_cacheline, count));
+#endif
+                node = 2 * node + static_cast<std::size_t>(compare(layout[node], key));
+            }
+            // Removes the right turns taken after the last left turn, which descended from the lower bound.
+            node >>= std::countr_one(node) + 1;
+            return (node == 0) ? count : _ranks[node];
+        }
+
+        //!\brief Returns the number of indexed values.
+        constexpr std::size_t size() const noexcept {
+            return _layout.empty() ? 0 : _layout.size() - 1;
+        }
+
+        //!\brief Returns whether no values are indexed.
+        constexpr bool empty() const noexcept {
+            return size() == 0;
+        }
+
+        //!\brief Returns the number of bytes allocated for the layout and the ranks.
+        std::size_t memory_usage() const noexcept {
+            return libjst::memory_usage(_layout) + libjst::memory_usage(_ranks);
+        }
+
+    private:
+
+        //!\brief Assigns the values in order to the subtree rooted at the given node.
+        template <typename values_t>
+        void build(values_t & sorted_values, std::size_t & rank, std::size_t const node) {
+            if (node > size())
+                return;
+
+            build(sorted_values, rank, 2 * node);
+            _layout[node] = value_t(std::ranges::begin(sorted_values)[rank]);
+            _ranks[node] = rank++;
+            build(sorted_values, rank, 2 * node + 1);
+        }
+    };
+}  // namespace libjst
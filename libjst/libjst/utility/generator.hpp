@@ -0,0 +1,197 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::generator.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <cassert>
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <utility>
+
+namespace libjst
+{
+    /*!\brief A lazily evaluated input range whose elements are produced by a coroutine.
+     *
+     * \tparam value_t The type of the yielded values.
+     *
+     * \details
+     *
+     * The coroutine is suspended at every `co_yield` and only resumed when the iterator is incremented, such that the
+     * consumer controls the pace of the producer. The yielded value is referenced and not copied; it is valid until
+     * the iterator is incremented the next time. Destroying the generator destroys a suspended coroutine, which
+     * terminates the production early. An exception thrown by the coroutine is rethrown by the operation of the
+     * iterator that resumed it.
+     *
+     * The generator can be iterated only once: begin() starts the coroutine and must be called at most once. The
+     * iteration can be paused by keeping the iterator and continued later by incrementing it again.
+     */
+    template <typename value_t>
+    class generator : public std::ranges::view_interface<generator<value_t>> {
+    public:
+        class promise_type;
+
+    private:
+        using handle_type = std::coroutine_handle<promise_type>;
+
+        class iterator;
+
+        handle_type _handle{};
+
+        explicit generator(handle_type handle) noexcept : _handle{handle}
+        {}
+
+    public:
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        generator() = default; //!< Default.
+        generator(generator const &) = delete; //!< Deleted.
+        generator(generator && other) noexcept : _handle{std::exchange(other._handle, nullptr)} //!< Move.
+        {}
+        generator & operator=(generator const &) = delete; //!< Deleted.
+        generator & operator=(generator && other) noexcept //!< Move.
+        {
+            std::swap(_handle, other._handle);
+            return *this;
+        }
+
+        //!\brief Destroys the coroutine, if it is suspended.
+        ~generator()
+        {
+            if (_handle)
+                _handle.destroy();
+        }
+        //!\}
+
+        /*!\name Iterators
+         * \{
+         */
+        //!\brief Starts the coroutine and returns an iterator to the first yielded value.
+        iterator begin() {
+            assert(_handle);
+            assert(!_handle.promise()._started);
+            _handle.promise()._started = true;
+            _handle.resume();
+            _handle.promise().rethrow_if_failed();
+            return iterator{_handle};
+        }
+
+        //!\brief Returns the sentinel.
+        std::default_sentinel_t end() const noexcept {
+            return std::default_sentinel;
+        }
+        //!\}
+    };
+
+    template <typename value_t>
+    class generator<value_t>::promise_type {
+    private:
+
+        friend generator;
+
+        value_t const * _current{};
+        std::exception_ptr _exception{};
+        bool _started{false};
+
+    public:
+
+        generator get_return_object() noexcept {
+            return generator{handle_type::from_promise(*this)};
+        }
+
+        std::suspend_always initial_suspend() const noexcept {
+            return {};
+        }
+
+        std::suspend_always final_suspend() const noexcept {
+            return {};
+        }
+
+        // A yielded temporary lives until the coroutine is resumed.
+        std::suspend_always yield_value(value_t const & value) noexcept {
+            _current = std::addressof(value);
+            return {};
+        }
+
+        void return_void() const noexcept
+        {}
+
+        void unhandled_exception() noexcept {
+            _exception = std::current_exception();
+        }
+
+        // The values are produced synchronously.
+        template <typename awaitable_t>
+        void await_transform(awaitable_t &&) = delete;
+
+        void rethrow_if_failed() {
+            if (_exception)
+                std::rethrow_exception(std::exchange(_exception, nullptr));
+        }
+
+        value_t const & current() const noexcept {
+            assert(_current != nullptr);
+            return *_current;
+        }
+    };
+
+    template <typename value_t>
+    class generator<value_t>::iterator {
+    private:
+
+        friend generator;
+
+        handle_type _handle{};
+
+        explicit iterator(handle_type handle) noexcept : _handle{handle}
+        {}
+
+    public:
+
+        using value_type = value_t;
+        using reference = value_t const &;
+        using difference_type = std::ptrdiff_t;
+        using iterator_concept = std::input_iterator_tag;
+
+        iterator() = default;
+        iterator(iterator const &) = delete;
+        iterator(iterator &&) = default;
+        iterator & operator=(iterator const &) = delete;
+        iterator & operator=(iterator &&) = default;
+
+        reference operator*() const noexcept {
+            assert(_handle && !_handle.done());
+            return _handle.promise().current();
+        }
+
+        iterator & operator++() {
+            assert(_handle && !_handle.done());
+            _handle.resume();
+            _handle.promise().rethrow_if_failed();
+            return *this;
+        }
+
+        void operator++(int) {
+            ++(*this);
+        }
+
+    private:
+
+        friend bool operator==(iterator const & lhs, std::default_sentinel_t const &) noexcept {
+            return !lhs._handle || lhs._handle.done();
+        }
+    };
+}  // namespace libjst
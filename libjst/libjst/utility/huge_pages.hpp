@@ -0,0 +1,195 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::advise_huge_pages and libjst::huge_page_allocator to back large arrays by huge pages.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+
+#include <sys/mman.h>
+
+#include <libjst/utility/memory_usage.hpp>
+
+namespace libjst
+{
+    //!\brief The size of a huge page, i.e. of a page mapped by a single TLB entry of the second level.
+    inline constexpr std::size_t huge_page_size{std::size_t{1} << 21};
+
+    /*!\brief Advises the kernel to back the whole huge pages within the given memory by transparent huge pages.
+     *
+     * \param[in] data The first byte of the memory.
+     * \param[in] size The number of bytes of the memory.
+     *
+     * \returns The number of bytes that were advised, which is 0 if the memory spans no whole huge page or the
+     *          platform does not support transparent huge pages.
+     *
+     * \details
+     *
+     * Pages that are already in use are collapsed into huge pages right away if the kernel supports it, and otherwise
+     * later in the background. The memory is neither moved nor modified.
+     */
+    inline std::size_t advise_huge_pages(void const * data, std::size_t const size) noexcept
+    {
+#if defined(MADV_HUGEPAGE)
+        std::uintptr_t const first = (reinterpret_cast<std::uintptr_t>(data) + huge_page_size - 1) &
+                                     ~(huge_page_size - 1);
+        std::uintptr_t const last = (reinterpret_cast<std::uintptr_t>(data) + size) & ~(huge_page_size - 1);
+        if (data == nullptr || first >= last)
+            return 0;
+
+        void * huge_pages = reinterpret_cast<void *>(first);
+        std::size_t const huge_pages_size = last - first;
+        if (::madvise(huge_pages, huge_pages_size, MADV_HUGEPAGE) != 0)
+            return 0;
+#if defined(MADV_COLLAPSE)
+        ::madvise(huge_pages, huge_pages_size, MADV_COLLAPSE); // best effort, otherwise collapsed in the background.
+#endif
+        return huge_pages_size;
+#else
+        (void) data;
+        (void) size;
+        return 0;
+#endif
+    }
+
+    /*!\brief Advises the kernel to back the memory allocated by the given object by transparent huge pages.
+     *
+     * \param[in] object The object whose memory is advised.
+     *
+     * \returns The number of bytes that were advised.
+     *
+     * \details
+     *
+     * Objects with a member function `advise_huge_pages()` return its result. Vectors and strings advise the memory
+     * of their elements. All other objects are assumed to allocate nothing.
+     */
+    template <typename object_t>
+    std::size_t advise_huge_pages(object_t const & object) noexcept
+    {
+        if constexpr (requires { { object.advise_huge_pages() } -> std::convertible_to<std::size_t>; }) {
+            return object.advise_huge_pages();
+        } else if constexpr (detail::is_std_vector<object_t>::value || detail::is_std_string<object_t>::value) {
+            return libjst::advise_huge_pages(object.data(), object.capacity() * sizeof(typename object_t::value_type));
+        } else {
+            return 0;
+        }
+    }
+
+    //!\brief How the libjst::huge_page_allocator obtains huge pages.
+    enum struct huge_page_policy {
+        transparent, //!< Transparent huge pages, which are used whenever the kernel can assemble them.
+        hugetlb //!< Pages reserved by the administrator, falling back to transparent huge pages if none are free.
+    };
+
+    /*!\brief An allocator placing large arrays on huge pages.
+     *
+     * \tparam value_t The type of the allocated values.
+     *
+     * \details
+     *
+     * Allocations of at least libjst::huge_page_size bytes are mapped anonymously and aligned to a huge page, such
+     * that the array is covered by the fewest TLB entries, e.g. the source sequence of a store in a
+     * `std::vector<char, libjst::huge_page_allocator<char>>`. Their size is rounded up to whole huge pages. Smaller
+     * allocations are taken from the global heap. Arrays allocated with std::allocator, e.g. by a store loaded
+     * from an archive, can be advised afterwards with libjst::advise_huge_pages instead.
+     */
+    template <typename value_t>
+    class huge_page_allocator {
+    private:
+
+        template <typename>
+        friend class huge_page_allocator;
+
+        huge_page_policy _policy{huge_page_policy::transparent};
+
+    public:
+
+        using value_type = value_t;
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        constexpr huge_page_allocator() = default; //!< Default.
+
+        //!\brief Constructs the allocator with the given policy.
+        constexpr explicit huge_page_allocator(huge_page_policy const policy) noexcept : _policy{policy}
+        {}
+
+        //!\brief Rebinds the allocator of another value type.
+        template <typename other_value_t>
+        constexpr huge_page_allocator(huge_page_allocator<other_value_t> const & other) noexcept :
+            _policy{other._policy}
+        {}
+        //!\}
+
+        constexpr huge_page_policy policy() const noexcept {
+            return _policy;
+        }
+
+        //!\brief Allocates n values; throws std::bad_alloc if the memory can not be obtained.
+        value_t * allocate(std::size_t const n) {
+            std::size_t const bytes = n * sizeof(value_t);
+            if (bytes < huge_page_size)
+                return std::allocator<value_t>{}.allocate(n);
+
+            std::size_t const mapped_bytes = round_to_huge_pages(bytes);
+#if defined(MAP_HUGETLB)
+            if (_policy == huge_page_policy::hugetlb) {
+                void * data = ::mmap(nullptr, mapped_bytes, PROT_READ | PROT_WRITE,
+                                     MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+                if (data != MAP_FAILED)
+                    return static_cast<value_t *>(data);
+            }
+#endif
+            // Maps one more huge page and unmaps the unaligned head and tail.
+            void * data = ::mmap(nullptr, mapped_bytes + huge_page_size, PROT_READ | PROT_WRITE,
+                                 MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (data == MAP_FAILED)
+                throw std::bad_alloc{};
+
+            std::uintptr_t const first = reinterpret_cast<std::uintptr_t>(data);
+            std::uintptr_t const aligned_first = (first + huge_page_size - 1) & ~(huge_page_size - 1);
+            if (aligned_first > first)
+                ::munmap(data, aligned_first - first);
+            if (std::size_t const tail_size = first + huge_page_size - aligned_first; tail_size > 0)
+                ::munmap(reinterpret_cast<void *>(aligned_first + mapped_bytes), tail_size);
+
+            libjst::advise_huge_pages(reinterpret_cast<void const *>(aligned_first), mapped_bytes);
+            return reinterpret_cast<value_t *>(aligned_first);
+        }
+
+        //!\brief Releases n values allocated by an equal allocator.
+        void deallocate(value_t * data, std::size_t const n) noexcept {
+            std::size_t const bytes = n * sizeof(value_t);
+            if (bytes < huge_page_size)
+                std::allocator<value_t>{}.deallocate(data, n);
+            else
+                ::munmap(data, round_to_huge_pages(bytes));
+        }
+
+        //!\brief All allocators are equal, since every allocation can be released by every allocator.
+        template <typename other_value_t>
+        constexpr friend bool operator==(huge_page_allocator const &,
+                                         huge_page_allocator<other_value_t> const &) noexcept {
+            return true;
+        }
+
+    private:
+
+        static constexpr std::size_t round_to_huge_pages(std::size_t const bytes) noexcept {
+            return (bytes + huge_page_size - 1) & ~(huge_page_size - 1);
+        }
+    };
+}  // namespace libjst
@@ -0,0 +1,168 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides a fast LZ77 codec for independently compressed blocks.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace libjst
+{
+    /*!\brief Compresses blocks of bytes with a greedy LZ77 scheme in the spirit of LZ4.
+     *
+     * \details
+     *
+     * A compressed block is a sequence of commands, each consisting of a token byte, whose high and low nibble store
+     * the number of literals and the match length minus four, the literals, and a two byte offset of the match.
+     * Nibbles of 15 are continued with bytes adding up to 255 each. The last command consists of literals only.
+     * Matches are found through a hash table of the last position of every four byte sequence and may overlap the
+     * bytes they produce, such that runs, e.g. the empty words of sparse coverages, are encoded by a single command.
+     *
+     * The decompressed size is not part of the block and must be stored by the caller.
+     */
+    class lz_block_codec {
+    private:
+
+        static constexpr std::size_t min_match{4};
+        static constexpr std::size_t max_offset{65535};
+        static constexpr std::size_t hash_bits{14};
+
+    public:
+
+        //!\brief Appends the compressed bytes to the given buffer.
+        static void compress(std::span<std::byte const> input, std::vector<std::byte> & output) {
+            std::array<uint32_t, std::size_t{1} << hash_bits> last_position{}; // stores position + 1
+            std::byte const * const data = input.data();
+            std::size_t const size = input.size();
+            output.reserve(output.size() + size / 2 + 16);
+
+            std::size_t literal_begin{};
+            std::size_t position{};
+            while (position + min_match <= size) {
+                uint32_t & slot = last_position[hash(data + position)];
+                std::size_t const candidate = slot;
+                slot = static_cast<uint32_t>(position + 1);
+                if (candidate == 0 || position - (candidate - 1) > max_offset ||
+                    std::memcmp(data + candidate - 1, data + position, min_match) != 0) {
+                    ++position;
+                    continue;
+                }
+
+                std::size_t const match = candidate - 1;
+                std::size_t length{min_match};
+                while (position + length < size && data[match + length] == data[position + length])
+                    ++length;
+
+                emit(output, input.subspan(literal_begin, position - literal_begin), position - match, length);
+                position += length;
+                literal_begin = position;
+                if (position >= 2 && position + min_match <= size) // keeps the tail of the match findable
+                    last_position[hash(data + position - 2)] = static_cast<uint32_t>(position - 1);
+            }
+            emit(output, input.subspan(literal_begin), 0, 0);
+        }
+
+        /*!\brief Decompresses the block into the given buffer, whose size must be the decompressed size.
+         *
+         * \details
+         *
+         * Throws std::runtime_error if the block is corrupted or does not decompress to exactly the given size.
+         */
+        static void decompress(std::span<std::byte const> input, std::span<std::byte> output) {
+            std::size_t in{};
+            std::size_t out{};
+            auto read_length = [&] (std::size_t length) {
+                if (length != 15)
+                    return length;
+                std::byte extension{};
+                do {
+                    if (in == input.size())
+                        throw std::runtime_error{"The compressed block is corrupted."};
+                    extension = input[in++];
+                    length += static_cast<std::size_t>(extension);
+                } while (extension == std::byte{255});
+                return length;
+            };
+
+            while (true) {
+                if (in == input.size())
+                    throw std::runtime_error{"The compressed block is corrupted."};
+                unsigned const token = static_cast<unsigned>(input[in++]);
+
+                std::size_t const literal_count = read_length(token >> 4);
+                if (literal_count > input.size() - in || literal_count > output.size() - out)
+                    throw std::runtime_error{"The compressed block is corrupted."};
+                std::memcpy(output.data() + out, input.data() + in, literal_count);
+                in += literal_count;
+                out += literal_count;
+                if (in == input.size())
+                    break; // the last command has no match.
+
+                if (input.size() - in < 2)
+                    throw std::runtime_error{"The compressed block is corrupted."};
+                std::size_t const offset = static_cast<std::size_t>(input[in]) |
+                                           (static_cast<std::size_t>(input[in + 1]) << 8);
+                in += 2;
+                std::size_t const length = read_length(token & 0xf) + min_match;
+                if (offset == 0 || offset > out || length > output.size() - out)
+                    throw std::runtime_error{"The compressed block is corrupted."};
+                for (std::byte * target = output.data() + out; target != output.data() + out + length; ++target)
+                    *target = *(target - offset); // byte-wise, as the match may overlap its output.
+                out += length;
+            }
+
+            if (out != output.size())
+                throw std::runtime_error{"The compressed block is corrupted."};
+        }
+
+    private:
+
+        static std::size_t hash(std::byte const * data) noexcept {
+            uint32_t sequence{};
+            std::memcpy(&sequence, data, sizeof(sequence));
+            return (sequence * 2654435761u) >> (32 - hash_bits);
+        }
+
+        static void emit_length(std::vector<std::byte> & output, std::size_t length) {
+            for (; length >= 255; length -= 255)
+                output.push_back(std::byte{255});
+            output.push_back(static_cast<std::byte>(length));
+        }
+
+        // Emits the literals followed by a match, or only the literals if the length is zero.
+        static void emit(std::vector<std::byte> & output,
+                         std::span<std::byte const> literals,
+                         std::size_t const offset,
+                         std::size_t const length) {
+            std::size_t const match_code = (length == 0) ? 0 : length - min_match;
+            unsigned const token = static_cast<unsigned>((std::min<std::size_t>(literals.size(), 15) << 4) |
+                                                         std::min<std::size_t>(match_code, 15));
+            output.push_back(static_cast<std::byte>(token));
+            if (literals.size() >= 15)
+                emit_length(output, literals.size() - 15);
+            output.insert(output.end(), literals.begin(), literals.end());
+            if (length == 0)
+                return;
+
+            output.push_back(static_cast<std::byte>(offset & 0xff));
+            output.push_back(static_cast<std::byte>(offset >> 8));
+            if (match_code >= 15)
+                emit_length(output, match_code - 15);
+        }
+    };
+}  // namespace libjst
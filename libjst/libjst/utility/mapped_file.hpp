@@ -0,0 +1,131 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides a read-only memory mapping of a file.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <system_error>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <libjst/utility/huge_pages.hpp>
+
+namespace libjst
+{
+    /*!\brief Maps a file read-only into memory.
+     *
+     * \details
+     *
+     * The file is mapped as shared mapping, such that all processes mapping the same file share the pages of the
+     * page cache. Mapping a file takes constant time; the pages are only read on their first access.
+     * The mapping is released on destruction.
+     */
+    class mapped_file {
+    private:
+
+        std::byte const * _data{};
+        std::size_t _size{};
+
+    public:
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        mapped_file() = default; //!< Default.
+        mapped_file(mapped_file const &) = delete; //!< Deleted.
+        mapped_file & operator=(mapped_file const &) = delete; //!< Deleted.
+
+        mapped_file(mapped_file && other) noexcept :
+            _data{std::exchange(other._data, nullptr)},
+            _size{std::exchange(other._size, 0)}
+        {}
+
+        mapped_file & operator=(mapped_file && other) noexcept {
+            if (this != &other) {
+                unmap();
+                _data = std::exchange(other._data, nullptr);
+                _size = std::exchange(other._size, 0);
+            }
+            return *this;
+        }
+
+        ~mapped_file() {
+            unmap();
+        }
+
+        /*!\brief Maps the file at the given path.
+         *
+         * \param[in] path The path of the file to map.
+         * \param[in] huge_pages Whether to advise the kernel to back the mapping by transparent huge pages, see
+         *                       libjst::advise_huge_pages; defaults to false.
+         *
+         * \details
+         *
+         * The page cache of a file is only backed by huge pages if the kernel supports it for the file system of the
+         * file, and the advice is ignored otherwise.
+         * Throws std::system_error if the file can not be opened or mapped.
+         */
+        explicit mapped_file(std::filesystem::path const & path, bool const huge_pages = false) {
+            int const file_descriptor = ::open(path.c_str(), O_RDONLY);
+            if (file_descriptor == -1)
+                throw std::system_error{errno, std::generic_category(), "Could not open the file " + path.string()};
+
+            struct ::stat file_status{};
+            if (::fstat(file_descriptor, &file_status) == -1) {
+                int const error = errno;
+                ::close(file_descriptor);
+                throw std::system_error{error, std::generic_category(), "Could not read the size of " + path.string()};
+            }
+
+            _size = static_cast<std::size_t>(file_status.st_size);
+            if (_size > 0) {
+                void * data = ::mmap(nullptr, _size, PROT_READ, MAP_SHARED, file_descriptor, 0);
+                if (data == MAP_FAILED) {
+                    int const error = errno;
+                    ::close(file_descriptor);
+                    throw std::system_error{error, std::generic_category(), "Could not map the file " + path.string()};
+                }
+                _data = static_cast<std::byte const *>(data);
+                if (huge_pages)
+                    libjst::advise_huge_pages(_data, _size);
+            }
+            ::close(file_descriptor); // the mapping stays valid after closing the file.
+        }
+        //!\}
+
+        //!\brief Returns the mapped bytes.
+        std::span<std::byte const> bytes() const noexcept {
+            return {_data, _size};
+        }
+
+        std::size_t size() const noexcept {
+            return _size;
+        }
+
+    private:
+
+        void unmap() noexcept {
+            if (_data != nullptr)
+                ::munmap(const_cast<std::byte *>(_data), _size);
+            _data = nullptr;
+            _size = 0;
+        }
+    };
+}  // namespace libjst
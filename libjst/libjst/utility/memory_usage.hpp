@@ -0,0 +1,111 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::memory_usage and libjst::store_memory_usage to report the memory of the data structures.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace libjst
+{
+    //!\brief The memory allocated by a store broken down by its components, in bytes.
+    struct store_memory_usage {
+        std::size_t source{}; //!< The source sequence, if it is owned by the store.
+        std::size_t breakend_keys{}; //!< The sorted breakend keys including their search index.
+        std::size_t coverages{}; //!< The coverages of the breakends.
+        std::size_t alt_sequences{}; //!< The pool of the inserted sequences.
+        std::size_t indel_map{}; //!< The map from the indel breakends to their mates and inserted sequences.
+        std::size_t position_index{}; //!< The optional index of the breakend positions.
+        std::size_t variant_classes{}; //!< The optional bitmaps of the breakend classes.
+        std::size_t carrier_counts{}; //!< The optional carrier counts of the breakends.
+        std::size_t source_masks{}; //!< The intervals of the source masks, e.g. the runs of `N` and the dirty regions.
+
+        //!\brief Returns the memory of all components.
+        constexpr std::size_t total() const noexcept {
+            return source + breakend_keys + coverages + alt_sequences + indel_map + position_index + variant_classes +
+                   carrier_counts + source_masks;
+        }
+
+        //!\brief Adds the memory of the components of another store, e.g. of another contig.
+        constexpr store_memory_usage & operator+=(store_memory_usage const & other) noexcept {
+            source += other.source;
+            breakend_keys += other.breakend_keys;
+            coverages += other.coverages;
+            alt_sequences += other.alt_sequences;
+            indel_map += other.indel_map;
+            position_index += other.position_index;
+            variant_classes += other.variant_classes;
+            carrier_counts += other.carrier_counts;
+            source_masks += other.source_masks;
+            return *this;
+        }
+
+        friend constexpr bool operator==(store_memory_usage const &, store_memory_usage const &) noexcept = default;
+    };
+
+    namespace detail {
+        template <typename object_t>
+        struct is_std_vector : std::false_type {};
+
+        template <typename value_t, typename allocator_t>
+        struct is_std_vector<std::vector<value_t, allocator_t>> : std::true_type {};
+
+        template <typename object_t>
+        struct is_std_string : std::false_type {};
+
+        template <typename char_t, typename traits_t, typename allocator_t>
+        struct is_std_string<std::basic_string<char_t, traits_t, allocator_t>> : std::true_type {};
+    } // namespace detail
+
+    /*!\brief Returns the number of bytes allocated on the heap by the given object.
+     *
+     * \param[in] object The object to get the memory for.
+     *
+     * \details
+     *
+     * The bytes of the object itself, i.e. `sizeof(object)`, are not counted. Objects reporting their memory with a
+     * member function `memory_usage()` return its result, or the total of it if it is a breakdown like
+     * libjst::store_memory_usage. Vectors count their capacity and the memory of their elements, and strings their
+     * capacity unless the characters are stored within the string itself. All other objects, e.g. views or
+     * references to memory owned elsewhere, are assumed to allocate nothing.
+     */
+    template <typename object_t>
+    std::size_t memory_usage(object_t const & object) noexcept
+    {
+        if constexpr (requires { { object.memory_usage() } -> std::convertible_to<std::size_t>; }) {
+            return object.memory_usage();
+        } else if constexpr (requires { { object.memory_usage().total() } -> std::convertible_to<std::size_t>; }) {
+            return object.memory_usage().total();
+        } else if constexpr (detail::is_std_vector<object_t>::value) {
+            using value_t = typename object_t::value_type;
+            std::size_t bytes = object.capacity() * sizeof(value_t);
+            if constexpr (!std::is_trivially_copyable_v<value_t> || requires (value_t const & value) {
+                                                                        value.memory_usage();
+                                                                    }) {
+                for (value_t const & value : object)
+                    bytes += libjst::memory_usage(value);
+            }
+            return bytes;
+        } else if constexpr (detail::is_std_string<object_t>::value) {
+            auto const * data = reinterpret_cast<std::byte const *>(object.data());
+            auto const * first = reinterpret_cast<std::byte const *>(std::addressof(object));
+            bool const is_inlined = first <= data && data < first + sizeof(object_t);
+            return is_inlined ? 0 : (object.capacity() + 1) * sizeof(typename object_t::value_type);
+        } else {
+            return 0;
+        }
+    }
+}  // namespace libjst
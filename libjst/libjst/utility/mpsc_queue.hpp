@@ -0,0 +1,195 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::mpsc_queue, a bounded lock-free queue of many producers and a single consumer.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+namespace libjst
+{
+    /*!\brief A bounded lock-free queue of many producers and a single consumer.
+     *
+     * \tparam value_t The type of the queued values; must be default constructible and swappable.
+     *
+     * \details
+     *
+     * The queue is a ring of slots, each with a sequence number telling whether the slot is free for the producer
+     * of the current round or filled for the consumer. A producer claims a slot by advancing the shared enqueue
+     * position with a compare-and-swap and publishes it by storing its sequence number; the single consumer reads
+     * the slots in order without any atomic read-modify-write. Hence producers only contend on the enqueue position
+     * and never block each other while writing their values. The queue has at least two slots, as the sequence
+     * number of a filled slot would otherwise equal the one of the free slot of the next round.
+     *
+     * Values are exchanged by swapping: a producer swaps its value with the one in the slot, and the consumer swaps
+     * the value it has consumed back into the slot. For containers like the batches of a libjst::hit_buffer, the
+     * producers hence receive the already allocated buffers of consumed values instead of allocating new ones.
+     *
+     * A full queue rejects try_push, while push waits until the consumer has freed a slot, which throttles the
+     * producers to the pace of the consumer. The waiting producers and the waiting consumer block on the
+     * counters of consumed and published values with std::atomic::wait, and are notified once per value.
+     */
+    template <typename value_t>
+    class mpsc_queue {
+    private:
+
+        // The positions and counters written by different threads are kept on separate cache lines.
+        static constexpr std::size_t cache_line_size{64};
+
+        struct alignas(cache_line_size) slot_type {
+            std::atomic<std::size_t> sequence{};
+            value_t value{};
+        };
+
+        std::unique_ptr<slot_type[]> _slots{};
+        std::size_t _mask{};
+        alignas(cache_line_size) std::atomic<std::size_t> _enqueue_position{};
+        alignas(cache_line_size) std::size_t _dequeue_position{};
+        alignas(cache_line_size) std::atomic<uint64_t> _published{};
+        alignas(cache_line_size) std::atomic<uint64_t> _consumed{};
+        std::atomic<std::size_t> _wait_count{};
+
+    public:
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        mpsc_queue() : mpsc_queue{2} //!< Creates a queue of two slots.
+        {}
+
+        //!\brief Creates a queue with at least the given number of slots, rounded up to the next power of two.
+        explicit mpsc_queue(std::size_t const capacity) :
+            _slots{std::make_unique<slot_type[]>(std::bit_ceil(std::max<std::size_t>(capacity, 2)))},
+            _mask{std::bit_ceil(std::max<std::size_t>(capacity, 2)) - 1}
+        {
+            for (std::size_t slot = 0; slot <= _mask; ++slot)
+                _slots[slot].sequence.store(slot, std::memory_order_relaxed);
+        }
+
+        mpsc_queue(mpsc_queue const &) = delete; //!< Deleted.
+        mpsc_queue(mpsc_queue &&) = delete; //!< Deleted.
+        mpsc_queue & operator=(mpsc_queue const &) = delete; //!< Deleted.
+        mpsc_queue & operator=(mpsc_queue &&) = delete; //!< Deleted.
+        ~mpsc_queue() = default; //!< Defaulted.
+        //!\}
+
+        //!\brief Returns the number of slots.
+        constexpr std::size_t capacity() const noexcept {
+            return _mask + 1;
+        }
+
+        //!\brief Returns how often a producer had to wait for a free slot, i.e. how often the queue pushed back.
+        std::size_t wait_count() const noexcept {
+            return _wait_count.load(std::memory_order_relaxed);
+        }
+
+        /*!\name Producer
+         * \brief Safe to call concurrently from any number of threads.
+         * \{
+         */
+        /*!\brief Swaps the value into a free slot; returns false and leaves the value untouched if the queue is full.
+         *
+         * \details
+         *
+         * On success, the value holds the value previously stored in the slot, i.e. a consumed value.
+         */
+        bool try_push(value_t & value) {
+            std::size_t position = _enqueue_position.load(std::memory_order_relaxed);
+            while (true) {
+                slot_type & slot = _slots[position & _mask];
+                std::size_t const sequence = slot.sequence.load(std::memory_order_acquire);
+                std::ptrdiff_t const distance = static_cast<std::ptrdiff_t>(sequence - position);
+                if (distance == 0) {
+                    if (_enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+                        using std::swap;
+                        swap(slot.value, value);
+                        slot.sequence.store(position + 1, std::memory_order_release);
+                        _published.fetch_add(1, std::memory_order_release);
+                        _published.notify_one();
+                        return true;
+                    }
+                } else if (distance < 0) { // the slot of this round was not yet consumed
+                    return false;
+                } else {
+                    position = _enqueue_position.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        //!\brief Swaps the value into a free slot and waits for the consumer while the queue is full.
+        void push(value_t & value) {
+            while (true) {
+                uint64_t const consumed = _consumed.load(std::memory_order_acquire);
+                if (try_push(value))
+                    return;
+
+                _wait_count.fetch_add(1, std::memory_order_relaxed);
+                _consumed.wait(consumed, std::memory_order_acquire);
+            }
+        }
+        //!\}
+
+        /*!\name Consumer
+         * \brief Must only be called by one thread at a time.
+         * \{
+         */
+        /*!\brief Swaps the oldest value out of the queue; returns false if the queue is empty.
+         *
+         * \details
+         *
+         * The given value is swapped into the freed slot, such that the next producer of this slot receives it.
+         */
+        bool try_pop(value_t & value) {
+            slot_type & slot = _slots[_dequeue_position & _mask];
+            std::size_t const sequence = slot.sequence.load(std::memory_order_acquire);
+            if (sequence != _dequeue_position + 1)
+                return false;
+
+            using std::swap;
+            swap(slot.value, value);
+            slot.sequence.store(_dequeue_position + capacity(), std::memory_order_release);
+            ++_dequeue_position;
+            _consumed.fetch_add(1, std::memory_order_release);
+            _consumed.notify_all();
+            return true;
+        }
+
+        /*!\brief Waits until the epoch differs from the given one, i.e. until a value was published or notify called.
+         *
+         * \details
+         *
+         * The consumer reads the epoch before an unsuccessful try_pop and waits with the read epoch, such that a
+         * value published in between is not missed.
+         */
+        void wait(uint64_t const epoch) const noexcept {
+            _published.wait(epoch, std::memory_order_acquire);
+        }
+
+        //!\brief Returns the counter advanced by every published value and by every call to notify.
+        uint64_t epoch() const noexcept {
+            return _published.load(std::memory_order_acquire);
+        }
+
+        //!\brief Wakes up the consumer waiting in wait, e.g. to let it observe that the producers have finished.
+        void notify() noexcept {
+            _published.fetch_add(1, std::memory_order_release);
+            _published.notify_all();
+        }
+        //!\}
+    };
+}  // namespace libjst
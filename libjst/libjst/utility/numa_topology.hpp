@@ -0,0 +1,217 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::numa_topology to bind threads to the CPUs of a NUMA node.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <charconv>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace libjst
+{
+    /*!\brief Binds the calling thread to a set of CPUs and restores its previous affinity when destroyed.
+     *
+     * \details
+     *
+     * The previous affinity is only restored if the binding is destroyed on the thread it was created on, such that
+     * the bindings of worker threads can be destroyed by the thread joining them.
+     */
+    class numa_binding {
+    private:
+
+        friend class numa_topology;
+
+#if defined(__linux__)
+        pthread_t _thread{};
+        cpu_set_t _previous_cpus{};
+#endif
+        bool _is_bound{false};
+
+        explicit numa_binding(std::span<unsigned const> cpus) noexcept {
+#if defined(__linux__)
+            if (cpus.empty())
+                return;
+
+            _thread = pthread_self();
+            if (pthread_getaffinity_np(_thread, sizeof(cpu_set_t), &_previous_cpus) != 0)
+                return;
+
+            cpu_set_t node_cpus;
+            CPU_ZERO(&node_cpus);
+            std::ranges::for_each(cpus, [&] (unsigned const cpu) {
+                if (cpu < CPU_SETSIZE)
+                    CPU_SET(cpu, &node_cpus);
+            });
+            _is_bound = pthread_setaffinity_np(_thread, sizeof(cpu_set_t), &node_cpus) == 0;
+#else
+            (void) cpus;
+#endif
+        }
+
+    public:
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        numa_binding() = default; //!< Default.
+        numa_binding(numa_binding const &) = delete; //!< Deleted.
+        numa_binding(numa_binding && other) noexcept { swap(other); } //!< Transfers the binding.
+        numa_binding & operator=(numa_binding const &) = delete; //!< Deleted.
+        numa_binding & operator=(numa_binding && other) noexcept { //!< Transfers the binding.
+            numa_binding{std::move(other)}.swap(*this);
+            return *this;
+        }
+
+        //!\brief Restores the previous affinity if destroyed on the bound thread.
+        ~numa_binding() {
+#if defined(__linux__)
+            if (_is_bound && pthread_equal(_thread, pthread_self()))
+                pthread_setaffinity_np(_thread, sizeof(cpu_set_t), &_previous_cpus);
+#endif
+        }
+        //!\}
+
+        //!\brief Whether the thread was bound, which fails if the platform does not support thread affinities.
+        constexpr bool is_bound() const noexcept {
+            return _is_bound;
+        }
+
+    private:
+
+        void swap(numa_binding & other) noexcept {
+#if defined(__linux__)
+            std::swap(_thread, other._thread);
+            std::swap(_previous_cpus, other._previous_cpus);
+#endif
+            std::swap(_is_bound, other._is_bound);
+        }
+    };
+
+    /*!\brief The CPUs of every NUMA node of the machine.
+     *
+     * \details
+     *
+     * The topology of the running machine is read with libjst::numa_topology::system from the node directories in
+     * `/sys/devices/system/node`. A default constructed topology, which is also returned if the nodes cannot be
+     * read, consists of a single node without CPUs, to which binding is a no-op.
+     *
+     * The workers of a parallel traversal are spread in contiguous blocks over the nodes, see
+     * libjst::numa_topology::node_of_worker, such that every node gets the same number of workers up to one.
+     */
+    class numa_topology {
+    private:
+
+        std::vector<std::vector<unsigned>> _node_cpus{};
+
+    public:
+
+        using size_type = std::size_t;
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        numa_topology() : _node_cpus(1) //!< A single node without CPUs.
+        {}
+
+        //!\brief Constructs the topology from the CPUs of every node; must contain at least one node.
+        explicit numa_topology(std::vector<std::vector<unsigned>> node_cpus) : _node_cpus{std::move(node_cpus)}
+        {
+            assert(!_node_cpus.empty());
+        }
+        //!\}
+
+        //!\brief Returns the topology of the running machine.
+        static numa_topology system() {
+            namespace fs = std::filesystem;
+
+            std::vector<std::pair<unsigned, std::vector<unsigned>>> nodes{};
+            std::error_code error{};
+            for (fs::directory_iterator it{"/sys/devices/system/node", error}, last{}; !error && it != last;
+                 it.increment(error)) {
+                std::string const name = it->path().filename().string();
+                unsigned node_id{};
+                if (!name.starts_with("node") ||
+                    std::from_chars(name.data() + 4, name.data() + name.size(), node_id).ec != std::errc{})
+                    continue;
+
+                std::ifstream cpu_list_file{it->path() / "cpulist"};
+                std::string cpu_list{};
+                if (std::getline(cpu_list_file, cpu_list))
+                    nodes.emplace_back(node_id, parse_cpu_list(cpu_list));
+            }
+
+            if (error || nodes.empty())
+                return numa_topology{};
+
+            std::ranges::sort(nodes, std::less<>{}, [] (auto const & node) { return node.first; });
+            std::vector<std::vector<unsigned>> node_cpus{};
+            node_cpus.reserve(nodes.size());
+            std::ranges::for_each(nodes, [&] (auto & node) { node_cpus.push_back(std::move(node.second)); });
+            return numa_topology{std::move(node_cpus)};
+        }
+
+        constexpr size_type node_count() const noexcept {
+            return _node_cpus.size();
+        }
+
+        std::span<unsigned const> cpus(size_type const node) const noexcept {
+            assert(node < node_count());
+            return _node_cpus[node];
+        }
+
+        //!\brief Returns the node of the worker with the given index among the given number of workers.
+        constexpr size_type node_of_worker(size_type const worker_id, size_type const worker_count) const noexcept {
+            assert(worker_id < worker_count);
+            return worker_id * node_count() / worker_count;
+        }
+
+        //!\brief Binds the calling thread to the CPUs of the given node until the returned binding is destroyed.
+        numa_binding bind_current_thread(size_type const node) const noexcept {
+            return numa_binding{cpus(node)};
+        }
+
+        //!\brief Parses a CPU list like `0-3,8,10-11` as used by the Linux kernel.
+        static std::vector<unsigned> parse_cpu_list(std::string_view cpu_list) {
+            std::vector<unsigned> cpus{};
+            while (!cpu_list.empty()) {
+                std::string_view const range = cpu_list.substr(0, cpu_list.find(','));
+                cpu_list.remove_prefix(std::min(range.size() + 1, cpu_list.size()));
+
+                unsigned first{};
+                auto [last_ptr, ec] = std::from_chars(range.data(), range.data() + range.size(), first);
+                if (ec != std::errc{})
+                    continue;
+
+                unsigned last{first};
+                if (last_ptr != range.data() + range.size() && *last_ptr == '-')
+                    std::from_chars(last_ptr + 1, range.data() + range.size(), last);
+
+                for (unsigned cpu = first; cpu <= last; ++cpu)
+                    cpus.push_back(cpu);
+            }
+            return cpus;
+        }
+    };
+}  // namespace libjst
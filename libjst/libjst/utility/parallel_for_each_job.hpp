@@ -0,0 +1,52 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides a parallel loop over independent jobs.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace libjst::detail
+{
+    // Invokes fn(job) for all jobs on the given number of threads and rethrows the first error.
+    template <typename fn_t>
+    void parallel_for_each_job(std::size_t const job_count, std::size_t const thread_count, fn_t && fn) {
+        std::atomic<std::size_t> next_job{0};
+        std::vector<std::exception_ptr> errors(job_count);
+        auto work = [&] () {
+            for (std::size_t job = next_job++; job < job_count; job = next_job++) {
+                try {
+                    fn(job);
+                } catch (...) {
+                    errors[job] = std::current_exception();
+                }
+            }
+        };
+
+        std::size_t const worker_count = std::min(std::max<std::size_t>(thread_count, 1), job_count);
+        std::vector<std::thread> workers{};
+        workers.reserve(worker_count);
+        for (std::size_t worker = 1; worker < worker_count; ++worker)
+            workers.emplace_back(work);
+
+        work(); // the calling thread processes jobs as well.
+        std::ranges::for_each(workers, [] (std::thread & worker) { worker.join(); });
+
+        if (auto error = std::ranges::find_if(errors, [] (std::exception_ptr const & e) { return e != nullptr; });
+            error != errors.end())
+            std::rethrow_exception(*error);
+    }
+} // namespace libjst::detail
@@ -0,0 +1,195 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::pointer_random_access_iterator, the raw pointer counterpart of the stable iterator.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <compare>
+#include <concepts>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <ranges>
+#include <type_traits>
+
+#include <libjst/utility/prefetch.hpp>
+#include <libjst/utility/stable_random_access_iterator.hpp>
+
+/*!\brief Makes the const iterators of contiguous containers raw pointers if defined to a non-zero value; disabled by
+ *        default.
+ *
+ * \details
+ *
+ * Set by the CMake option `LIBJST_POINTER_ITERATORS` for all targets linking libjst. When enabled, the const
+ * iterators of libjst::sorted_vector and libjst::contiguous_multimap, and thus the breakend iterators of the trees,
+ * are libjst::pointer_random_access_iterator instead of libjst::stable_random_access_iterator. They are invalidated
+ * by every insertion into the container, which is safe for stores that are fully built before they are traversed.
+ */
+#ifndef LIBJST_POINTER_ITERATORS
+#define LIBJST_POINTER_ITERATORS 0
+#endif
+
+namespace libjst
+{
+    /*!\brief A random access iterator over a contiguous container holding a pointer to the current element.
+     *
+     * \tparam container_t The type of the container; must model std::ranges::contiguous_range.
+     *
+     * \details
+     *
+     * Unlike libjst::stable_random_access_iterator, which stores the container and an offset and recomputes the
+     * address of the element on every access, the iterator dereferences its pointer directly. It is hence invalidated
+     * when the container reallocates. It can be constructed from a stable iterator over the same container, such that
+     * both can be used as iterator and const iterator of the same container.
+     */
+    template <std::ranges::contiguous_range container_t>
+    class pointer_random_access_iterator {
+
+        using element_pointer = decltype(std::ranges::data(std::declval<container_t &>()));
+
+    public:
+
+        using value_type = std::ranges::range_value_t<container_t>;
+        using reference = std::ranges::range_reference_t<container_t>;
+        using difference_type = std::ranges::range_difference_t<container_t>;
+        using pointer = element_pointer;
+        using iterator_category = std::random_access_iterator_tag;
+        using iterator_concept = std::contiguous_iterator_tag;
+
+        constexpr pointer_random_access_iterator() = default;
+        constexpr explicit pointer_random_access_iterator(container_t * base, difference_type position) noexcept :
+            _element{std::ranges::data(*base) + position}
+        {}
+
+        //!\brief Constructs the iterator from a stable iterator over the same, possibly non-const, container.
+        template <typename other_container_t>
+            requires std::same_as<std::remove_const_t<other_container_t>, std::remove_const_t<container_t>>
+        constexpr pointer_random_access_iterator(stable_random_access_iterator<other_container_t> const & other)
+            noexcept :
+            _element{std::to_address(other.base())}
+        {}
+
+        constexpr pointer base() const noexcept {
+            return _element;
+        }
+
+        constexpr reference operator*() const noexcept {
+            return *_element;
+        }
+
+        constexpr pointer operator->() const noexcept {
+            return _element;
+        }
+
+        constexpr reference operator[](difference_type const step) const noexcept {
+            return _element[step];
+        }
+
+        constexpr pointer_random_access_iterator & operator++() noexcept {
+            ++_element;
+            return *this;
+        }
+
+        constexpr pointer_random_access_iterator operator++(int) noexcept {
+            pointer_random_access_iterator tmp{*this};
+            this->operator++();
+            return tmp;
+        }
+
+        constexpr pointer_random_access_iterator & operator+=(difference_type const step) noexcept {
+            _element += step;
+            return *this;
+        }
+
+        constexpr pointer_random_access_iterator & operator--() noexcept {
+            --_element;
+            return *this;
+        }
+
+        constexpr pointer_random_access_iterator operator--(int) noexcept {
+            pointer_random_access_iterator tmp{*this};
+            this->operator--();
+            return tmp;
+        }
+
+        constexpr pointer_random_access_iterator & operator-=(difference_type const step) noexcept {
+            _element -= step;
+            return *this;
+        }
+
+        //!\brief Prefetches the element the given number of steps ahead, which does not need to exist.
+        [[gnu::always_inline]] void prefetch(difference_type const distance) const noexcept {
+            // Computed on the address, since a pointer past the end of the container must not be formed.
+            libjst::prefetch(reinterpret_cast<void const *>(reinterpret_cast<std::uintptr_t>(_element) +
+                                                            distance * sizeof(value_type)));
+        }
+
+    private:
+
+        constexpr friend pointer_random_access_iterator
+        operator+(pointer_random_access_iterator const & lhs, difference_type const step) noexcept {
+            pointer_random_access_iterator tmp{lhs};
+            return tmp += step;
+        }
+
+        constexpr friend pointer_random_access_iterator
+        operator+(difference_type const step, pointer_random_access_iterator const & rhs) noexcept {
+            return rhs + step;
+        }
+
+        constexpr friend pointer_random_access_iterator
+        operator-(pointer_random_access_iterator const & lhs, difference_type const step) noexcept {
+            pointer_random_access_iterator tmp{lhs};
+            return tmp -= step;
+        }
+
+        constexpr friend difference_type
+        operator-(pointer_random_access_iterator const & lhs, pointer_random_access_iterator const & rhs) noexcept {
+            return lhs._element - rhs._element;
+        }
+
+        constexpr friend bool
+        operator==(pointer_random_access_iterator const & lhs, pointer_random_access_iterator const & rhs) noexcept {
+            return lhs._element == rhs._element;
+        }
+
+        constexpr friend std::strong_ordering
+        operator<=>(pointer_random_access_iterator const & lhs, pointer_random_access_iterator const & rhs) noexcept {
+            return lhs._element <=> rhs._element;
+        }
+
+        element_pointer _element{};
+    };
+
+    namespace detail
+    {
+        template <typename container_t>
+        struct const_random_access_iterator {
+            using type = stable_random_access_iterator<container_t const>;
+        };
+
+        template <typename container_t>
+            requires (static_cast<bool>(LIBJST_POINTER_ITERATORS) && std::ranges::contiguous_range<container_t const>)
+        struct const_random_access_iterator<container_t> {
+            using type = pointer_random_access_iterator<container_t const>;
+        };
+    } // namespace detail
+
+    /*!\brief The const iterator of a container wrapped by libjst::sorted_vector or libjst::contiguous_multimap.
+     *
+     * \details
+     *
+     * A libjst::pointer_random_access_iterator if LIBJST_POINTER_ITERATORS is enabled and the container is contiguous,
+     * and a libjst::stable_random_access_iterator otherwise.
+     */
+    template <std::ranges::random_access_range container_t>
+    using const_random_access_iterator_t = typename detail::const_random_access_iterator<container_t>::type;
+}  // namespace libjst
@@ -12,9 +12,14 @@
 
 #pragma once
 
+#include <algorithm>
 #include <compare>
 #include <concepts>
+#include <cstddef>
+#include <functional>
 #include <memory_resource>
+#include <ranges>
+#include <stdexcept>
 #include <vector>
 
 namespace libjst
@@ -26,9 +31,12 @@ class position_map
 {
     using keys_t = std::vector<key_t>;
     using mapped_values_t = std::vector<mapped_t>;
-public:
-    keys_t _keys; //!< The container holding the elements.
-    mapped_values_t _values;
+
+    //!\brief The number of keys below which the lookup scans the remaining keys instead of halving them.
+    static constexpr std::size_t linear_scan_threshold{32};
+
+    keys_t _keys; //!< The sorted keys.
+    mapped_values_t _values; //!< The mapped values in the order of their keys.
 
     template <bool is_const>
     class map_proxy;
@@ -52,6 +60,54 @@ public:
     position_map & operator=(position_map &&) noexcept = default;
     ~position_map() = default;
 
+    /*!\brief Constructs the map from the given keys and the values mapped to them.
+     *
+     * \param[in] sorted_keys The keys in strictly increasing order of `compare_t`.
+     * \param[in] values The mapped values in the order of their keys.
+     *
+     * \details
+     *
+     * Builds the map in one pass by appending the keys and the values to the storage, which is allocated once if
+     * the ranges are sized.
+     *
+     * ### Exception
+     *
+     * Throws std::invalid_argument if the number of keys and values differ or if the keys are not in strictly
+     * increasing order.
+     *
+     * ### Complexity
+     *
+     * Linear in the number of keys.
+     */
+    template <std::ranges::input_range sorted_keys_t, std::ranges::input_range values_t>
+        requires std::convertible_to<std::ranges::range_reference_t<sorted_keys_t>, key_t> &&
+                 std::constructible_from<mapped_t, std::ranges::range_reference_t<values_t>>
+    position_map(sorted_keys_t && sorted_keys, values_t && values)
+    {
+        if constexpr (std::ranges::sized_range<sorted_keys_t> && std::ranges::sized_range<values_t>) {
+            if (std::ranges::size(sorted_keys) != std::ranges::size(values))
+                throw std::invalid_argument{"The number of keys and values of the position map differ!"};
+
+            reserve(std::ranges::size(sorted_keys));
+        }
+
+        compare_t compare{};
+        auto value_it = std::ranges::begin(values);
+        for (auto && key : sorted_keys) {
+            if (value_it == std::ranges::end(values))
+                throw std::invalid_argument{"The number of keys and values of the position map differ!"};
+            if (!_keys.empty() && !compare(_keys.back(), key))
+                throw std::invalid_argument{"The keys of the position map are not in strictly increasing order!"};
+
+            _keys.push_back(static_cast<key_t>(key));
+            _values.emplace_back(*value_it);
+            ++value_it;
+        }
+
+        if (value_it != std::ranges::end(values))
+            throw std::invalid_argument{"The number of keys and values of the position map differ!"};
+    }
+
     /*!\name Iterators
      * \{
      */
@@ -93,6 +149,19 @@ public:
     {
         return _keys.max_size();
     }
+
+    //!\brief Allocates the storage for at least the given number of elements.
+    void reserve(size_type const new_capacity)
+    {
+        _keys.reserve(new_capacity);
+        _values.reserve(new_capacity);
+    }
+
+    //!\brief Returns the number of elements that can be held without allocating new storage.
+    constexpr size_type capacity() const noexcept
+    {
+        return std::min(_keys.capacity(), _values.capacity());
+    }
     //!\}
 
     /*!\name Modifiers
@@ -109,8 +178,8 @@ public:
         // std::cout << "Insert at " << value.first << "\n";
         // find insert position
 
-        if (auto it = std::ranges::lower_bound(_keys, value.first); it == std::ranges::end(_keys) || *it != value.first) {
-            auto insert_position = std::ranges::distance(std::ranges::begin(_keys), it);
+        if (size_type insert_position = lower_bound_offset(value.first);
+            insert_position == size() || _keys[insert_position] != value.first) {
             // std::cout << "insert position = " << insert_position << "\n";
             _keys.emplace(std::ranges::next(std::ranges::begin(_keys), insert_position), value.first);
             _values.emplace(std::ranges::next(std::ranges::begin(_values), insert_position), std::move(value.second));
@@ -363,8 +432,46 @@ private:
     static auto lower_bound_impl(map_t & me, key_t key) {
         using iterator_t = std::conditional_t<std::is_const_v<map_t>, const_iterator, iterator>;
 
-        return iterator_t{&me, std::ranges::distance(std::ranges::begin(me._keys),
-                                                     std::ranges::lower_bound(me._keys, key))};
+        return iterator_t{&me, me.lower_bound_offset(key)};
+    }
+
+    /*!\brief Returns the number of keys preceding the given key.
+     *
+     * \details
+     *
+     * Halves the keys without branching on the comparison until at most linear_scan_threshold keys remain, which
+     * are then counted by a scan without early exit that the compiler vectorises for the integral keys.
+     */
+    size_type lower_bound_offset(key_t const key) const noexcept
+    {
+        return partition_offset([key] (key_t const stored_key) { return compare_t{}(stored_key, key); });
+    }
+
+    //!\brief Returns the number of keys not succeeding the given key.
+    size_type upper_bound_offset(key_t const key) const noexcept
+    {
+        return partition_offset([key] (key_t const stored_key) { return !compare_t{}(key, stored_key); });
+    }
+
+    //!\brief Returns the offset of the first key not satisfying the predicate, which partitions the keys.
+    template <typename predicate_t>
+    size_type partition_offset(predicate_t && predicate) const noexcept
+    {
+        key_t const * first = _keys.data();
+        key_t const * base = first;
+        size_type count = _keys.size();
+
+        while (count > linear_scan_threshold) {
+            size_type const half = count / 2;
+            base += static_cast<size_type>(predicate(base[half - 1])) * half;
+            count -= half;
+        }
+
+        size_type offset = static_cast<size_type>(base - first);
+        for (size_type i = 0; i < count; ++i)
+            offset += static_cast<size_type>(predicate(base[i]));
+
+        return offset;
     }
 
     // template <typename comparable_key_t>
@@ -377,8 +484,7 @@ private:
     static auto upper_bound_impl(map_t & me, key_t key) {
         using iterator_t = std::conditional_t<std::is_const_v<map_t>, const_iterator, iterator>;
 
-        return iterator_t{&me, std::ranges::distance(std::ranges::begin(me._keys),
-                                                     std::ranges::upper_bound(me._keys, key))};
+        return iterator_t{&me, me.upper_bound_offset(key)};
     }
 
     // template <typename comparable_key_t>
@@ -0,0 +1,79 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::prefetch_ahead to hint the loads of the elements a forward scan accesses next.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <ranges>
+
+/*!\brief The default number of elements a forward scan prefetches ahead; 8 if not defined otherwise.
+ *
+ * \details
+ *
+ * A distance of 0 disables the prefetches of the trees and the bulk seek at compile time.
+ */
+#ifndef LIBJST_PREFETCH_DISTANCE
+#define LIBJST_PREFETCH_DISTANCE 8
+#endif
+
+namespace libjst
+{
+    //!\brief The number of breakends the sequence trees prefetch ahead of the breakend they move to.
+    inline constexpr std::ptrdiff_t default_prefetch_distance{LIBJST_PREFETCH_DISTANCE};
+
+    //!\brief Hints the processor to load the cache line of the given address for reading.
+    [[gnu::always_inline]] inline void prefetch(void const * address) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(address, 0, 3);
+#else
+        (void) address;
+#endif
+    }
+
+    /*!\brief Prefetches the element at the given position of a range if the position is within the range.
+     *
+     * \details
+     *
+     * Ranges with a member function `prefetch(position)`, e.g. libjst::bit_coverage_pool, prefetch the memory the
+     * element refers to. Contiguous ranges prefetch the element itself. All other ranges ignore the hint.
+     */
+    template <typename range_t>
+    [[gnu::always_inline]] inline void prefetch_element(range_t const & range, std::ptrdiff_t const position) noexcept
+    {
+        if constexpr (requires { range.prefetch(position); }) {
+            range.prefetch(position);
+        } else if constexpr (std::ranges::contiguous_range<range_t const> && std::ranges::sized_range<range_t const>) {
+            if (position >= 0 && position < std::ranges::ssize(range))
+                libjst::prefetch(std::ranges::data(range) + position);
+        }
+    }
+
+    /*!\brief Prefetches the element the given number of steps ahead of the iterator.
+     *
+     * \details
+     *
+     * Iterators with a member function `prefetch(distance)`, e.g. the iterators of libjst::contiguous_multimap, prefetch
+     * the keys and the mapped values ahead. All other iterators ignore the hint. The element ahead does not need to
+     * exist.
+     */
+    template <typename iterator_t>
+    [[gnu::always_inline]] inline void prefetch_ahead(iterator_t const & it, std::iter_difference_t<iterator_t> const distance) noexcept
+    {
+        if constexpr (requires { it.prefetch(distance); }) {
+            if (distance > 0)
+                it.prefetch(distance);
+        }
+    }
+}  // namespace libjst
@@ -12,14 +12,22 @@
 
 #pragma once
 
+#include <algorithm>
 #include <compare>
 #include <concepts>
+#include <initializer_list>
+#include <iterator>
 #include <memory_resource>
 #include <ranges>
+#include <utility>
 #include <vector>
 
 #include <cereal/types/vector.hpp>
 
+#include <libjst/utility/eytzinger_index.hpp>
+#include <libjst/utility/huge_pages.hpp>
+#include <libjst/utility/memory_usage.hpp>
+#include <libjst/utility/pointer_random_access_iterator.hpp>
 #include <libjst/utility/stable_random_access_iterator.hpp>
 
 namespace libjst
@@ -34,6 +42,7 @@ class sorted_vector
     using container_t = std::vector<key_t>;
 
     container_t _elements; //!< The container holding the elements.
+    eytzinger_index<key_t, compare_t> _search_index{}; //!< The optional search index; empty if not built.
 
     template <bool is_const>
     class bi_iterator;
@@ -42,7 +51,7 @@ public:
 
     using value_type = std::ranges::range_value_t<container_t>;
     using iterator = stable_random_access_iterator<container_t>;
-    using const_iterator = stable_random_access_iterator<container_t const>;
+    using const_iterator = const_random_access_iterator_t<container_t>; //!< A raw pointer if LIBJST_POINTER_ITERATORS.
     using size_type = size_t;
     using key_compare = compare_t;
 
@@ -77,7 +86,9 @@ public:
     }
     //!\}
 
+    //!\brief Returns the elements, which may be modified, and drops the search index.
     constexpr container_t & data() noexcept {
+        drop_search_index();
         return _elements;
     }
 
@@ -107,6 +118,18 @@ public:
     {
         _elements.reserve(new_capacity);
     }
+
+    //!\brief Returns the number of bytes allocated for the elements and the search index.
+    size_type memory_usage() const noexcept
+    {
+        return libjst::memory_usage(_elements) + _search_index.memory_usage();
+    }
+
+    //!\brief Advises the kernel to back the elements by transparent huge pages, see libjst::advise_huge_pages.
+    size_type advise_huge_pages() const noexcept
+    {
+        return libjst::advise_huge_pages(_elements);
+    }
     //!\}
 
     /*!\name Modifiers
@@ -114,6 +137,7 @@ public:
      */
     constexpr auto clear() noexcept
     {
+        drop_search_index();
         _elements.clear();
     }
 
@@ -137,6 +161,42 @@ public:
         return insert_impl(hint, std::move(value));
     }
 
+    /*!\brief Inserts all elements of the given range.
+     *
+     * \param[in] range The elements to insert in any order.
+     *
+     * \details
+     *
+     * The elements are appended, sorted if they are not given in order, and merged with the stored elements in a
+     * single pass. Elements equal to stored ones are inserted behind the stored elements, and equal elements of the
+     * range keep their relative order, as if they were inserted one by one.
+     *
+     * ### Complexity
+     *
+     * Linear in the size of the container and the range if the range is sorted, otherwise \f$O(m \log m)\f$ in the
+     * size of the range for sorting it first.
+     */
+    template <std::ranges::input_range range_t>
+        requires (!std::same_as<std::remove_cvref_t<range_t>, value_type>) &&
+                 std::constructible_from<value_type, std::ranges::range_reference_t<range_t>>
+    void insert(range_t && range)
+    {
+        size_type const stored_size = size();
+        if constexpr (std::ranges::sized_range<range_t>)
+            _elements.reserve(stored_size + std::ranges::size(range));
+
+        drop_search_index();
+        for (auto && value : range)
+            _elements.emplace_back((decltype(value) &&) value);
+
+        merge_tail(stored_size, true);
+    }
+
+    void insert(std::initializer_list<value_type> values)
+    {
+        insert(std::views::all(values));
+    }
+
     template <typename ...args_t>
     iterator emplace(args_t && ...args)
     {
@@ -151,24 +211,29 @@ public:
 
     iterator erase(iterator pos)
     {
+        drop_search_index();
         return iterator{std::addressof(_elements),
                         std::ranges::distance(_elements.begin(), _elements.erase(pos.base()))};
     }
 
     iterator erase(const_iterator pos)
     {
+        drop_search_index();
         return iterator{std::addressof(_elements),
-                        std::ranges::distance(_elements.begin(), _elements.erase(pos.base()))};
+                        std::ranges::distance(_elements.begin(), _elements.erase(to_container_iterator(pos)))};
     }
 
     iterator erase(const_iterator first, const_iterator last)
     {
+        drop_search_index();
         return iterator{std::addressof(_elements),
-                        std::ranges::distance(_elements.begin(), _elements.erase(first.base(), last.base()))};
+                        std::ranges::distance(_elements.begin(), _elements.erase(to_container_iterator(first),
+                                                                                     to_container_iterator(last)))};
     }
 
     size_type erase(key_t const & key)
     {
+        drop_search_index();
         auto [first, last] = equal_range_impl(key);
         size_t erased_elements = std::ranges::distance(first, last);
         _elements.erase(first.base(), last.base());
@@ -176,7 +241,38 @@ public:
     }
     // constexpr void swap();
     // constexpr void extract();
-    // constexpr void merge();
+
+    /*!\brief Moves all elements of the given container into this container with a single merge pass.
+     *
+     * \param[in,out] source The container to merge; is empty afterwards.
+     *
+     * \details
+     *
+     * Elements equal to stored ones are inserted behind the stored elements.
+     *
+     * ### Complexity
+     *
+     * Linear in the size of both containers.
+     */
+    void merge(sorted_vector & source)
+    {
+        if (std::addressof(source) == this)
+            return;
+
+        drop_search_index();
+        source.drop_search_index();
+        size_type const stored_size = size();
+        _elements.reserve(stored_size + source.size());
+        std::ranges::move(source._elements, std::back_inserter(_elements));
+        source.clear();
+        merge_tail(stored_size, false);
+    }
+
+    //!\overload
+    void merge(sorted_vector && source)
+    {
+        merge(source);
+    }
     //!\}
 
     /*!\name Lookup
@@ -295,11 +391,41 @@ public:
     }
     //!\}
 
+    /*!\name Search index
+     * \{
+     */
+    /*!\brief Builds a libjst::eytzinger_index over the elements, which is used by lower_bound and find.
+     *
+     * \details
+     *
+     * The index stores a copy of the elements in a cache friendly layout and speeds up the lookups in large
+     * containers that are searched many times after they were built. Every modification of the container drops the
+     * index, such that the lookups fall back to the binary search over the elements until the index is rebuilt.
+     */
+    void build_search_index()
+    {
+        _search_index = eytzinger_index<key_t, compare_t>{_elements};
+    }
+
+    //!\brief Returns whether a search index over the current elements is built.
+    constexpr bool has_search_index() const noexcept
+    {
+        return !_search_index.empty();
+    }
+    //!\}
+
     /*!\name Comparison
      * \{
      */
-    bool operator==(sorted_vector const & other) const = default;
-    std::strong_ordering operator<=>(sorted_vector const & other) const = default;
+    constexpr bool operator==(sorted_vector const & other) const
+    {
+        return _elements == other._elements;
+    }
+
+    constexpr std::strong_ordering operator<=>(sorted_vector const & other) const
+    {
+        return _elements <=> other._elements;
+    }
     //!\}
 
     // ----------------------------------------------------------------------------
@@ -309,6 +435,7 @@ public:
     template <typename archive_t>
     void load(archive_t & iarchive)
     {
+        drop_search_index();
         iarchive(_elements);
     }
 
@@ -320,29 +447,66 @@ public:
 
 private:
 
+    constexpr void drop_search_index() noexcept
+    {
+        _search_index = eytzinger_index<key_t, compare_t>{};
+    }
+
+    // Returns the iterator of the underlying container, since a const iterator may be a raw pointer.
+    constexpr typename container_t::const_iterator to_container_iterator(const_iterator it) const noexcept
+    {
+        return std::ranges::next(_elements.cbegin(), it - begin());
+    }
+
+    // Returns the offset of the first element not less than the key, using the search index if it is built.
+    template <typename comparable_key_t>
+    std::ptrdiff_t lower_bound_offset(comparable_key_t const & key) const
+    {
+        if (has_search_index())
+            return static_cast<std::ptrdiff_t>(_search_index.lower_bound(key));
+
+        return std::ranges::distance(_elements.begin(), std::ranges::lower_bound(_elements, key, compare_t{}));
+    }
+
+    // Merges the appended elements beginning at the given offset with the elements in front of them.
+    void merge_tail(size_type const tail_offset, bool const sort_tail)
+    {
+        auto tail_begin = std::ranges::next(_elements.begin(), tail_offset);
+        if (sort_tail && !std::ranges::is_sorted(tail_begin, _elements.end(), compare_t{}))
+            std::ranges::stable_sort(tail_begin, _elements.end(), compare_t{});
+
+        // Nothing to merge if the appended elements are not less than the last stored element.
+        if (tail_begin == _elements.begin() || tail_begin == _elements.end() ||
+            !compare_t{}(*tail_begin, *std::ranges::prev(tail_begin)))
+            return;
+
+        std::ranges::inplace_merge(_elements.begin(), tail_begin, _elements.end(), compare_t{});
+    }
+
     template <typename comparable_key_t>
     iterator find_impl(comparable_key_t && key)
     {
-        auto base_it = std::ranges::lower_bound(_elements, key, compare_t{});
-        if (base_it == _elements.end() || compare_t{}(key, *base_it)) // not identical
+        std::ptrdiff_t const pos = lower_bound_offset(key);
+        if (pos == std::ranges::ssize(_elements) || compare_t{}(key, _elements[pos])) // not identical
             return iterator{std::addressof(_elements), std::ranges::ssize(_elements)};
 
-        return iterator{std::addressof(_elements), std::ranges::distance(_elements.begin(), base_it)};
+        return iterator{std::addressof(_elements), pos};
     }
 
     template <typename comparable_key_t>
     const_iterator find_impl(comparable_key_t && key) const
     {
-        auto base_it = std::ranges::lower_bound(_elements, key, compare_t{});
-        if (base_it == _elements.end() || compare_t{}(key, *base_it)) // not identical
+        std::ptrdiff_t const pos = lower_bound_offset(key);
+        if (pos == std::ranges::ssize(_elements) || compare_t{}(key, _elements[pos])) // not identical
             return const_iterator{std::addressof(_elements), std::ranges::ssize(_elements)};
 
-        return const_iterator{std::addressof(_elements), std::ranges::distance(_elements.begin(), base_it)};
+        return const_iterator{std::addressof(_elements), pos};
     }
 
     template <typename value_t>
     iterator insert_impl(const_iterator hint, value_t && value)
     {
+        drop_search_index();
         // We want to insert before the hint but only if it is ok to insert here.
         if (_elements.empty())
         {
@@ -352,7 +516,7 @@ private:
 
         compare_t compare{};
 
-        auto hint_base =  hint.base();
+        auto hint_base = to_container_iterator(hint);
         bool const at_end = hint_base == _elements.end();
         // (at_end or value < value at hint) && value >= value directly before hint
         hint_base = ((at_end || compare(value, *hint_base)) && (hint_base == _elements.begin() || !compare(value, *(std::ranges::prev(hint_base)))))
@@ -387,15 +551,13 @@ private:
     template <typename comparable_key_t>
     iterator lower_bound_impl(comparable_key_t const & key)
     {
-        auto pos = std::ranges::distance(_elements.begin(), std::ranges::lower_bound(_elements, key, compare_t{}));
-        return iterator{std::addressof(_elements), pos};
+        return iterator{std::addressof(_elements), lower_bound_offset(key)};
     }
 
     template <typename comparable_key_t>
     const_iterator lower_bound_impl(comparable_key_t const & key) const
     {
-        auto pos = std::ranges::distance(_elements.begin(), std::ranges::lower_bound(_elements, key, compare_t{}));
-        return const_iterator{std::addressof(_elements), pos};
+        return const_iterator{std::addressof(_elements), lower_bound_offset(key)};
     }
 
     template <typename comparable_key_t>
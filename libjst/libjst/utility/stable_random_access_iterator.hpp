@@ -14,6 +14,8 @@
 
 #include <ranges>
 
+#include <libjst/utility/prefetch.hpp>
+
 namespace libjst
 {
 
@@ -96,6 +98,11 @@ namespace libjst
             return *this;
         }
 
+        //!\brief Prefetches the element the given number of steps ahead, see libjst::prefetch_element.
+        [[gnu::always_inline]] void prefetch(difference_type const distance) const noexcept {
+            libjst::prefetch_element(*_base, _position + distance);
+        }
+
     private:
 
         constexpr friend stable_random_access_iterator
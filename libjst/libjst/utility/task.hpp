@@ -0,0 +1,623 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::task, a lazily started coroutine, and the operations to schedule and compose tasks.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <latch>
+#include <mutex>
+#include <optional>
+#include <ranges>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace libjst
+{
+    template <typename value_t = void>
+    class task;
+
+    namespace detail
+    {
+        //!\brief The job handed to a scheduler, which resumes a coroutine when invoked.
+        struct resume_job {
+            std::coroutine_handle<> handle{};
+
+            void operator()() const {
+                handle.resume();
+            }
+        };
+    } // namespace detail
+
+    /*!\brief A scheduler executing the jobs it is given, e.g. on the threads of a pool shared by all stages.
+     *
+     * \details
+     *
+     * A scheduler provides a member function `execute(job)`, which invokes the copyable job `job()` exactly once,
+     * either on one of its threads or on the calling thread. The job resumes a suspended task and may run for as long
+     * as the task runs until its next suspension.
+     */
+    template <typename scheduler_t>
+    concept task_scheduler = requires (scheduler_t & scheduler, detail::resume_job job)
+    {
+        scheduler.execute(std::move(job));
+    };
+
+    //!\brief A libjst::task_scheduler executing every job on the calling thread.
+    struct inline_scheduler {
+        template <typename job_t>
+        void execute(job_t && job) const {
+            job();
+        }
+    };
+
+    /*!\brief A libjst::task_scheduler executing the jobs in the order of their submission on a fixed set of threads.
+     *
+     * \details
+     *
+     * A single pool is meant to be shared by all stages of a search and by concurrent searches. The destructor runs
+     * the pending jobs and joins the threads; jobs must not be submitted after the destruction began.
+     */
+    class static_thread_pool {
+    private:
+
+        std::mutex _mutex{};
+        std::condition_variable _job_condition{};
+        std::deque<std::function<void()>> _jobs{};
+        bool _stopped{false};
+        std::vector<std::thread> _threads{};
+
+    public:
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        //!\brief Starts the given number of threads; at least one.
+        explicit static_thread_pool(std::size_t const thread_count = std::thread::hardware_concurrency())
+        {
+            _threads.reserve(std::max<std::size_t>(thread_count, 1));
+            for (std::size_t idx = 0; idx < std::max<std::size_t>(thread_count, 1); ++idx)
+                _threads.emplace_back([this] () { work(); });
+        }
+
+        static_thread_pool(static_thread_pool const &) = delete; //!< Deleted.
+        static_thread_pool & operator=(static_thread_pool const &) = delete; //!< Deleted.
+
+        //!\brief Runs the pending jobs and joins the threads.
+        ~static_thread_pool()
+        {
+            {
+                std::scoped_lock lock{_mutex};
+                _stopped = true;
+            }
+            _job_condition.notify_all();
+            for (std::thread & thread : _threads)
+                thread.join();
+        }
+        //!\}
+
+        //!\brief Returns the number of threads.
+        std::size_t thread_count() const noexcept {
+            return _threads.size();
+        }
+
+        //!\brief Enqueues the job, which is invoked on one of the threads.
+        template <typename job_t>
+        void execute(job_t && job) {
+            {
+                std::scoped_lock lock{_mutex};
+                _jobs.emplace_back((job_t &&) job);
+            }
+            _job_condition.notify_one();
+        }
+
+    private:
+
+        void work() {
+            while (true) {
+                std::function<void()> job{};
+                {
+                    std::unique_lock lock{_mutex};
+                    _job_condition.wait(lock, [&] { return _stopped || !_jobs.empty(); });
+                    if (_jobs.empty())
+                        return;
+                    job = std::move(_jobs.front());
+                    _jobs.pop_front();
+                }
+                job();
+            }
+        }
+    };
+
+    namespace detail
+    {
+        //!\brief The state shared by the promises of all tasks.
+        class task_promise_base {
+        private:
+
+            // Resumes the awaiting coroutine, if any, when the task completes.
+            struct final_awaiter {
+                constexpr bool await_ready() const noexcept {
+                    return false;
+                }
+
+                template <typename promise_t>
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_t> handle) const noexcept {
+                    std::coroutine_handle<> continuation = handle.promise()._continuation;
+                    return continuation ? continuation : std::noop_coroutine();
+                }
+
+                constexpr void await_resume() const noexcept
+                {}
+            };
+
+        protected:
+
+            std::exception_ptr _exception{};
+
+        public:
+
+            std::coroutine_handle<> _continuation{};
+
+            std::suspend_always initial_suspend() const noexcept {
+                return {};
+            }
+
+            final_awaiter final_suspend() const noexcept {
+                return {};
+            }
+
+            void unhandled_exception() noexcept {
+                _exception = std::current_exception();
+            }
+        };
+
+        template <typename value_t>
+        class task_promise : public task_promise_base {
+        private:
+
+            std::optional<value_t> _value{};
+
+        public:
+
+            task<value_t> get_return_object() noexcept;
+
+            template <typename result_t>
+                requires std::constructible_from<value_t, result_t>
+            void return_value(result_t && result) {
+                _value.emplace((result_t &&) result);
+            }
+
+            value_t result() {
+                if (_exception)
+                    std::rethrow_exception(_exception);
+                assert(_value.has_value());
+                return std::move(*_value);
+            }
+        };
+
+        template <>
+        class task_promise<void> : public task_promise_base {
+        public:
+
+            task<void> get_return_object() noexcept;
+
+            constexpr void return_void() const noexcept
+            {}
+
+            void result() {
+                if (_exception)
+                    std::rethrow_exception(_exception);
+            }
+        };
+    } // namespace detail
+
+    /*!\brief A coroutine producing a single value, which is started when it is awaited.
+     *
+     * \tparam value_t The type of the produced value; `void` if the task produces none.
+     *
+     * \details
+     *
+     * The task is lazy: its body starts when the task is awaited by another coroutine with `co_await`, or by
+     * libjst::sync_wait from a regular function, and runs on the thread of the awaiter until it suspends itself. A task
+     * moves to the threads of a scheduler by awaiting libjst::schedule, such that the stages of a search, e.g. loading
+     * a region, traversing its chunks and flushing the hits, share a single scheduler instead of owning a thread pool
+     * each. When the task completes, the awaiting coroutine is resumed on the thread that completed it.
+     *
+     * An exception escaping the body is rethrown by the `co_await` awaiting the task. A task can be awaited once.
+     * Destroying a task that was never awaited destroys its coroutine without running its body.
+     */
+    template <typename value_t>
+    class task {
+    public:
+        using promise_type = detail::task_promise<value_t>;
+
+    private:
+        using handle_type = std::coroutine_handle<promise_type>;
+
+        friend promise_type;
+
+        handle_type _handle{};
+
+        explicit task(handle_type handle) noexcept : _handle{handle}
+        {}
+
+        struct awaiter {
+            handle_type _handle{};
+
+            bool await_ready() const noexcept {
+                return !_handle || _handle.done();
+            }
+
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) const noexcept {
+                _handle.promise()._continuation = awaiting;
+                return _handle;
+            }
+
+            value_t await_resume() const {
+                assert(_handle);
+                return _handle.promise().result();
+            }
+        };
+
+    public:
+
+        using value_type = value_t;
+
+        /*!\name Constructors, destructor and assignment
+         * \{
+         */
+        task() = default; //!< Default.
+        task(task const &) = delete; //!< Deleted.
+        task(task && other) noexcept : _handle{std::exchange(other._handle, nullptr)} //!< Move.
+        {}
+        task & operator=(task const &) = delete; //!< Deleted.
+        task & operator=(task && other) noexcept //!< Move.
+        {
+            std::swap(_handle, other._handle);
+            return *this;
+        }
+
+        //!\brief Destroys the coroutine, which must not be running.
+        ~task()
+        {
+            if (_handle)
+                _handle.destroy();
+        }
+        //!\}
+
+        //!\brief Starts the task and suspends the awaiting coroutine until the task completed.
+        awaiter operator co_await() const & noexcept {
+            return awaiter{_handle};
+        }
+
+        //!\brief Returns whether the task holds a coroutine.
+        explicit operator bool() const noexcept {
+            return static_cast<bool>(_handle);
+        }
+    };
+
+    template <typename value_t>
+    task<value_t> detail::task_promise<value_t>::get_return_object() noexcept {
+        return task<value_t>{std::coroutine_handle<task_promise>::from_promise(*this)};
+    }
+
+    inline task<void> detail::task_promise<void>::get_return_object() noexcept {
+        return task<void>{std::coroutine_handle<task_promise>::from_promise(*this)};
+    }
+
+    /*!\brief Returns an awaitable that resumes the awaiting coroutine through the given scheduler.
+     *
+     * \param[in] scheduler The scheduler, which must outlive the suspension.
+     */
+    template <task_scheduler scheduler_t>
+    auto schedule(scheduler_t & scheduler) noexcept {
+        struct schedule_awaiter {
+            scheduler_t & _scheduler;
+
+            constexpr bool await_ready() const noexcept {
+                return false;
+            }
+
+            void await_suspend(std::coroutine_handle<> awaiting) const {
+                _scheduler.execute(detail::resume_job{awaiting});
+            }
+
+            constexpr void await_resume() const noexcept
+            {}
+        };
+        return schedule_awaiter{scheduler};
+    }
+
+    namespace detail
+    {
+        // Counts the completed children of libjst::when_all and the awaiting parent, which is resumed by the last.
+        struct when_all_counter {
+            std::atomic<std::size_t> _count{};
+            std::coroutine_handle<> _parent{};
+
+            bool arrive() noexcept {
+                return _count.fetch_sub(1, std::memory_order_acq_rel) == 1;
+            }
+        };
+
+        // Awaits a single task of libjst::when_all and signals the counter when it completed.
+        class when_all_child {
+        public:
+            struct promise_type {
+                when_all_counter * _counter{};
+
+                struct final_awaiter {
+                    constexpr bool await_ready() const noexcept {
+                        return false;
+                    }
+
+                    std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> handle) const noexcept {
+                        when_all_counter & counter = *handle.promise()._counter;
+                        return counter.arrive() ? counter._parent : std::noop_coroutine();
+                    }
+
+                    constexpr void await_resume() const noexcept
+                    {}
+                };
+
+                when_all_child get_return_object() noexcept {
+                    return when_all_child{std::coroutine_handle<promise_type>::from_promise(*this)};
+                }
+
+                std::suspend_always initial_suspend() const noexcept {
+                    return {};
+                }
+
+                final_awaiter final_suspend() const noexcept {
+                    return {};
+                }
+
+                constexpr void return_void() const noexcept
+                {}
+
+                // The child stores the exception of its task.
+                [[noreturn]] void unhandled_exception() const noexcept {
+                    std::terminate();
+                }
+            };
+
+        private:
+
+            std::coroutine_handle<promise_type> _handle{};
+
+            explicit when_all_child(std::coroutine_handle<promise_type> handle) noexcept : _handle{handle}
+            {}
+
+        public:
+
+            when_all_child(when_all_child && other) noexcept : _handle{std::exchange(other._handle, nullptr)}
+            {}
+
+            when_all_child & operator=(when_all_child && other) noexcept
+            {
+                std::swap(_handle, other._handle);
+                return *this;
+            }
+
+            ~when_all_child()
+            {
+                if (_handle)
+                    _handle.destroy();
+            }
+
+            void start(when_all_counter & counter) const {
+                _handle.promise()._counter = std::addressof(counter);
+                _handle.resume();
+            }
+        };
+
+        template <typename value_t>
+        using when_all_slot_t = std::optional<std::conditional_t<std::is_void_v<value_t>, std::monostate, value_t>>;
+
+        template <typename value_t>
+        when_all_child make_when_all_child(task<value_t> const & child,
+                                           when_all_slot_t<value_t> & slot,
+                                           std::exception_ptr & error)
+        {
+            try {
+                if constexpr (std::is_void_v<value_t>) {
+                    co_await child;
+                    slot.emplace();
+                } else {
+                    slot.emplace(co_await child);
+                }
+            } catch (...) {
+                error = std::current_exception();
+            }
+        }
+
+        // Starts all children and suspends the parent unless all children completed before it could suspend.
+        struct when_all_awaiter {
+            std::vector<when_all_child> const & _children;
+            when_all_counter & _counter;
+
+            bool await_ready() const noexcept {
+                return _children.empty();
+            }
+
+            bool await_suspend(std::coroutine_handle<> parent) const {
+                _counter._parent = parent;
+                _counter._count.store(_children.size() + 1, std::memory_order_relaxed);
+                for (when_all_child const & child : _children)
+                    child.start(_counter);
+                return !_counter.arrive();
+            }
+
+            constexpr void await_resume() const noexcept
+            {}
+        };
+    } // namespace detail
+
+    /*!\brief Returns a task awaiting all given tasks, which run concurrently if they await a libjst::schedule.
+     *
+     * \param[in] tasks The tasks to await.
+     *
+     * \returns A task producing the values of the tasks in the order of the tasks; `void` for tasks of `void`.
+     *
+     * \details
+     *
+     * The tasks are started one after another on the thread awaiting the returned task. A task runs on this thread
+     * until it suspends, e.g. by awaiting libjst::schedule, which moves it to the threads of the scheduler such that
+     * the next task starts. The awaiting coroutine is resumed by the thread completing the last task. If tasks throw,
+     * the exception of the first of them in the order of the tasks is rethrown after all tasks completed.
+     */
+    template <typename value_t>
+    task<std::conditional_t<std::is_void_v<value_t>, void, std::vector<value_t>>>
+    when_all(std::vector<task<value_t>> tasks)
+    {
+        std::vector<detail::when_all_slot_t<value_t>> slots(tasks.size());
+        std::vector<std::exception_ptr> errors(tasks.size());
+        std::vector<detail::when_all_child> children{};
+        children.reserve(tasks.size());
+        for (std::size_t idx = 0; idx < tasks.size(); ++idx)
+            children.push_back(detail::make_when_all_child(tasks[idx], slots[idx], errors[idx]));
+
+        detail::when_all_counter counter{};
+        co_await detail::when_all_awaiter{children, counter};
+
+        for (std::exception_ptr const & error : errors)
+            if (error)
+                std::rethrow_exception(error);
+
+        if constexpr (!std::is_void_v<value_t>) {
+            std::vector<value_t> values{};
+            values.reserve(slots.size());
+            for (auto & slot : slots)
+                values.push_back(std::move(*slot));
+            co_return values;
+        }
+    }
+
+    namespace detail
+    {
+        // Awaits the task of libjst::sync_wait and counts the latch down once the coroutine is suspended for good.
+        class sync_wait_driver {
+        public:
+            struct promise_type {
+                std::latch * _done{};
+
+                struct final_awaiter {
+                    constexpr bool await_ready() const noexcept {
+                        return false;
+                    }
+
+                    void await_suspend(std::coroutine_handle<promise_type> handle) const noexcept {
+                        handle.promise()._done->count_down();
+                    }
+
+                    constexpr void await_resume() const noexcept
+                    {}
+                };
+
+                sync_wait_driver get_return_object() noexcept {
+                    return sync_wait_driver{std::coroutine_handle<promise_type>::from_promise(*this)};
+                }
+
+                std::suspend_always initial_suspend() const noexcept {
+                    return {};
+                }
+
+                final_awaiter final_suspend() const noexcept {
+                    return {};
+                }
+
+                constexpr void return_void() const noexcept
+                {}
+
+                [[noreturn]] void unhandled_exception() const noexcept {
+                    std::terminate();
+                }
+            };
+
+        private:
+
+            std::coroutine_handle<promise_type> _handle{};
+
+            explicit sync_wait_driver(std::coroutine_handle<promise_type> handle) noexcept : _handle{handle}
+            {}
+
+        public:
+
+            sync_wait_driver(sync_wait_driver const &) = delete;
+            sync_wait_driver & operator=(sync_wait_driver const &) = delete;
+
+            ~sync_wait_driver()
+            {
+                _handle.destroy();
+            }
+
+            void run(std::latch & done) const {
+                _handle.promise()._done = std::addressof(done);
+                _handle.resume();
+                done.wait();
+            }
+        };
+
+        template <typename value_t>
+        sync_wait_driver make_sync_wait_driver(task<value_t> const & awaited,
+                                               when_all_slot_t<value_t> & slot,
+                                               std::exception_ptr & error)
+        {
+            try {
+                if constexpr (std::is_void_v<value_t>) {
+                    co_await awaited;
+                    slot.emplace();
+                } else {
+                    slot.emplace(co_await awaited);
+                }
+            } catch (...) {
+                error = std::current_exception();
+            }
+        }
+    } // namespace detail
+
+    /*!\brief Runs the task and blocks the calling thread until it completed.
+     *
+     * \param[in] awaited The task to run, which starts on the calling thread.
+     *
+     * \returns The value produced by the task.
+     *
+     * \details
+     *
+     * The exception thrown by the task is rethrown on the calling thread.
+     */
+    template <typename value_t>
+    value_t sync_wait(task<value_t> awaited)
+    {
+        detail::when_all_slot_t<value_t> slot{};
+        std::exception_ptr error{};
+        {
+            std::latch done{1};
+            detail::make_sync_wait_driver(awaited, slot, error).run(done);
+        }
+        if (error)
+            std::rethrow_exception(error);
+        if constexpr (!std::is_void_v<value_t>)
+            return std::move(*slot);
+    }
+}  // namespace libjst
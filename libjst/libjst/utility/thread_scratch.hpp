@@ -0,0 +1,87 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+/*!\file
+ * \brief Provides libjst::acquire_scratch to reuse scratch objects per thread.
+ * \author Rene Rahn <rene.rahn AT fu-berlin.de>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+#include <libjst/utility/arena_allocator.hpp>
+
+namespace libjst
+{
+    namespace detail
+    {
+        //!\brief The scratch objects of one type owned by the calling thread.
+        template <typename value_t>
+        struct thread_scratch_pool {
+            static constexpr std::size_t max_size{8};
+
+            std::vector<std::shared_ptr<value_t>> objects{};
+        };
+
+        template <typename value_t>
+        thread_scratch_pool<value_t> & thread_scratch() noexcept {
+            thread_local thread_scratch_pool<value_t> pool{};
+            return pool;
+        }
+    } // namespace detail
+
+    /*!\brief Returns a scratch object of the calling thread, which is reused once all its copies are released.
+     *
+     * \tparam value_t The type of the scratch object; must be default initialisable.
+     * \param[in] allocator The allocator for a scratch object that is not pooled; defaults to std::allocator.
+     *
+     * \details
+     *
+     * Every thread owns a small pool of scratch objects per type, e.g. the label buffers of libjst::labelled_tree or
+     * the coverage stack of libjst::prune_tree, which are shared by all nodes of one traversal. A returned object is
+     * free again when the last copy of the returned pointer is released, and keeps the memory it has grown to, such
+     * that traversing many trees on one thread, e.g. the chunks of a parallel traversal, allocates the scratch memory
+     * only once per thread instead of once per tree. The object is returned in the state it was released in and must
+     * be reset by the caller.
+     *
+     * Objects acquired while a libjst::scoped_arena is active on the calling thread may allocate from the arena and
+     * are hence never pooled; they are allocated with the given allocator instead. Conversely, a pooled object must
+     * not keep memory allocated from an arena that was activated after the object was acquired. If all pooled
+     * objects are in use, a new object is pooled up to a fixed number per thread and type, beyond which the objects
+     * are not pooled either.
+     *
+     * The pool is only accessed by its owning thread and the returned pointers may be released on any thread.
+     */
+    template <std::default_initializable value_t, typename allocator_t = std::allocator<value_t>>
+    std::shared_ptr<value_t> acquire_scratch(allocator_t const & allocator = allocator_t{})
+    {
+        if (active_arena() != std::pmr::new_delete_resource())
+            return std::allocate_shared<value_t>(allocator);
+
+        auto & objects = detail::thread_scratch<value_t>().objects;
+        auto free_it = std::ranges::find_if(objects, [] (std::shared_ptr<value_t> const & object) {
+            return object.use_count() == 1;
+        });
+        if (free_it != objects.end()) {
+            // Synchronises with the release of the last copy on another thread before the object is reused.
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return *free_it;
+        }
+
+        if (objects.size() == detail::thread_scratch_pool<value_t>::max_size)
+            return std::allocate_shared<value_t>(allocator);
+
+        return objects.emplace_back(std::make_shared<value_t>());
+    }
+}  // namespace libjst
@@ -0,0 +1,136 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <ranges>
+#include <sstream>
+#include <vector>
+
+#include <cereal/archives/json.hpp>
+#include <cereal/types/vector.hpp>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/coverage/bit_coverage_pool.hpp>
+#include <libjst/coverage/bit_coverage_view.hpp>
+#include <libjst/coverage/concept.hpp>
+
+struct bit_coverage_pool_test : public ::testing::Test {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using coverage_domain_type = libjst::coverage_domain_t<coverage_type>;
+    using view_type = libjst::bit_coverage_view<uint32_t>;
+    using pool_type = libjst::bit_coverage_pool<uint32_t>;
+
+    // Spans more than one word per coverage.
+    coverage_domain_type domain{0, 130};
+    coverage_type cov1{{0, 63, 64, 129}, domain};
+    coverage_type cov2{{1, 64, 100}, domain};
+    coverage_type cov3{{2, 65}, domain};
+};
+
+TEST_F(bit_coverage_pool_test, concept) {
+    EXPECT_TRUE(std::ranges::random_access_range<pool_type>);
+    EXPECT_TRUE(std::ranges::random_access_range<view_type>);
+    EXPECT_TRUE((std::same_as<std::ranges::range_value_t<pool_type>, coverage_type>));
+    EXPECT_TRUE((std::same_as<std::ranges::range_reference_t<pool_type>, view_type>));
+}
+
+TEST_F(bit_coverage_pool_test, view) {
+    view_type view{cov1};
+
+    EXPECT_EQ(view.size(), 130u);
+    EXPECT_EQ(view.words().size(), 3u);
+    EXPECT_TRUE(view.get_domain() == domain);
+    EXPECT_TRUE(view.any());
+    EXPECT_FALSE(view.empty());
+    for (uint32_t i = 0; i < 130; ++i)
+        EXPECT_EQ(view[i], cov1[i]) << i;
+
+    EXPECT_TRUE(std::ranges::equal(view, cov1));
+    EXPECT_TRUE(view == cov1);
+    EXPECT_FALSE(view == cov2);
+    EXPECT_TRUE(coverage_type{view} == cov1);
+    EXPECT_TRUE(view_type{coverage_type{domain}}.empty());
+}
+
+TEST_F(bit_coverage_pool_test, insert) {
+    pool_type pool{};
+    EXPECT_TRUE(pool.empty());
+
+    auto it = pool.insert(pool.end(), cov2);
+    EXPECT_TRUE(*it == cov2);
+    it = pool.insert(pool.begin(), cov1);
+    EXPECT_TRUE(*it == cov1);
+    it = pool.insert(pool.end(), cov3);
+    EXPECT_TRUE(*it == cov3);
+
+    EXPECT_EQ(pool.size(), 3u);
+    EXPECT_EQ(pool.stride(), 3u);
+    EXPECT_TRUE(pool.get_domain() == domain);
+    EXPECT_TRUE(pool[0] == cov1);
+    EXPECT_TRUE(pool[1] == cov2);
+    EXPECT_TRUE(pool[2] == cov3);
+    EXPECT_EQ(pool.end() - pool.begin(), 3);
+
+    // The words of consecutive coverages are adjacent.
+    EXPECT_EQ(pool[1].words().data(), pool[0].words().data() + pool.stride());
+    EXPECT_EQ(pool[2].words().data(), pool[1].words().data() + pool.stride());
+
+    EXPECT_THROW(pool.insert(pool.end(), coverage_type{{0}, coverage_domain_type{0, 5}}), std::domain_error);
+    EXPECT_EQ(pool.size(), 3u);
+
+    pool.clear();
+    EXPECT_TRUE(pool.empty());
+}
+
+TEST_F(bit_coverage_pool_test, intersection) {
+    pool_type pool{domain};
+    pool.insert(pool.end(), cov1);
+    pool.insert(pool.end(), cov2);
+
+    coverage_type expected{{64}, domain};
+    EXPECT_TRUE(libjst::coverage_intersection(pool[0], pool[1]) == expected);
+    EXPECT_TRUE(libjst::coverage_intersection(cov1, pool[1]) == expected);
+    EXPECT_TRUE(libjst::coverage_intersection(pool[0], cov2) == expected);
+    EXPECT_TRUE(libjst::coverage_intersection(pool[0], cov3).empty());
+}
+
+TEST_F(bit_coverage_pool_test, difference) {
+    pool_type pool{domain};
+    pool.insert(pool.end(), cov1);
+    pool.insert(pool.end(), cov2);
+
+    coverage_type expected{{0, 63, 129}, domain};
+    EXPECT_TRUE(libjst::coverage_difference(pool[0], pool[1]) == expected);
+    EXPECT_TRUE(libjst::coverage_difference(cov1, pool[1]) == expected);
+    EXPECT_TRUE(libjst::coverage_difference(pool[0], cov3) == cov1);
+}
+
+TEST_F(bit_coverage_pool_test, serialise) {
+    pool_type pool_out{};
+    pool_out.insert(pool_out.end(), cov1);
+    pool_out.insert(pool_out.end(), cov2);
+    pool_out.insert(pool_out.end(), cov3);
+
+    std::stringstream buffer{};
+    { // writing to output string stream
+        cereal::JSONOutputArchive oarch{buffer};
+        pool_out.save(oarch);
+    }
+
+    pool_type pool_in{};
+    { // reading from input string stream
+        cereal::JSONInputArchive iarch{buffer};
+        pool_in.load(iarch);
+    }
+
+    ASSERT_EQ(pool_in.size(), 3u);
+    EXPECT_TRUE(pool_in.get_domain() == domain);
+    EXPECT_TRUE(pool_in[0] == cov1);
+    EXPECT_TRUE(pool_in[1] == cov2);
+    EXPECT_TRUE(pool_in[2] == cov3);
+}
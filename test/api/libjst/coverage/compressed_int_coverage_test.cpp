@@ -0,0 +1,204 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <ranges>
+#include <sstream>
+#include <vector>
+
+#include <cereal/archives/json.hpp>
+#include <cereal/types/vector.hpp>
+
+#include <libjst/coverage/compressed_int_coverage.hpp>
+#include <libjst/coverage/concept.hpp>
+#include <libjst/coverage/int_coverage.hpp>
+
+struct compressed_int_coverage_test : public ::testing::Test {
+    using coverage_type = libjst::compressed_int_coverage<uint32_t>;
+    using coverage_domain_type = libjst::coverage_domain_t<coverage_type>;
+    using ids_type = std::vector<uint32_t>;
+
+    coverage_domain_type domain{0, 100'000};
+
+    static ids_type elements(coverage_type const & coverage) {
+        ids_type ids{};
+        std::ranges::copy(coverage, std::back_inserter(ids));
+        return ids;
+    }
+
+    static ids_type iota(uint32_t const first, uint32_t const last) {
+        ids_type ids(last - first);
+        std::iota(ids.begin(), ids.end(), first);
+        return ids;
+    }
+
+    // Every id is a member with the given probability in parts per thousand.
+    static ids_type random_ids(unsigned const seed, unsigned const density_ppt) {
+        std::mt19937 generator{seed};
+        ids_type ids{};
+        for (uint32_t id = 0; id < 100'000; ++id)
+            if (generator() % 1000 < density_ppt)
+                ids.push_back(id);
+        return ids;
+    }
+
+    // Coverages of one or many blocks with small and large gaps.
+    std::vector<ids_type> operands() const {
+        return {ids_type{3, 17, 500, 99'999}, ids_type{17, 18, 450}, iota(0, 200), iota(150, 5000),
+                random_ids(42, 1), random_ids(7, 1), random_ids(3, 300), random_ids(11, 900), ids_type{}};
+    }
+};
+
+TEST_F(compressed_int_coverage_test, concept) {
+    EXPECT_TRUE(std::ranges::forward_range<coverage_type>);
+    EXPECT_TRUE((std::same_as<std::ranges::range_value_t<coverage_type>, uint32_t>));
+    EXPECT_TRUE((std::same_as<libjst::coverage_domain_t<coverage_type>, coverage_domain_type>));
+}
+
+TEST_F(compressed_int_coverage_test, construction) {
+    coverage_type empty{domain};
+    EXPECT_TRUE(empty.empty());
+    EXPECT_FALSE(empty.any());
+    EXPECT_EQ(empty.size(), 0u);
+    EXPECT_EQ(empty.max_size(), 100'000u);
+    EXPECT_TRUE(empty.begin() == empty.end());
+
+    coverage_type coverage{{99'999, 3, 500, 17, 3}, domain};
+    EXPECT_EQ(elements(coverage), (ids_type{3, 17, 500, 99'999}));
+    EXPECT_EQ(coverage.size(), 4u);
+    EXPECT_EQ(coverage.front(), 3u);
+    EXPECT_EQ(coverage.back(), 99'999u);
+
+    for (ids_type const & ids : operands()) {
+        coverage_type const from_range{ids, domain};
+        EXPECT_EQ(elements(from_range), ids);
+        EXPECT_EQ(from_range.size(), ids.size());
+        if (!ids.empty()) {
+            EXPECT_EQ(from_range.back(), ids.back());
+        }
+    }
+
+    EXPECT_THROW((coverage_type{ids_type{5, 100'001}, domain}), std::domain_error);
+}
+
+TEST_F(compressed_int_coverage_test, contains) {
+    for (ids_type const & ids : operands()) {
+        coverage_type coverage{ids, domain};
+        for (uint32_t id = 0; id < 100'001; id += 7)
+            EXPECT_EQ(coverage.contains(id), std::ranges::binary_search(ids, id)) << id;
+        for (uint32_t id : ids)
+            EXPECT_TRUE(coverage.contains(id)) << id;
+    }
+}
+
+TEST_F(compressed_int_coverage_test, insert) {
+    coverage_type coverage{domain};
+    coverage.insert(7);
+    coverage.insert(3);
+    coverage.insert(7);
+    EXPECT_EQ(elements(coverage), (ids_type{3, 7}));
+    EXPECT_THROW(coverage.insert(100'001), std::domain_error);
+
+    ids_type expected{3, 7};
+    for (uint32_t id = 1000; id > 8; id -= 9) { // inserts before the last id across several blocks.
+        coverage.insert(id);
+        expected.push_back(id);
+    }
+    std::ranges::sort(expected);
+    EXPECT_EQ(elements(coverage), expected);
+    EXPECT_TRUE(coverage == (coverage_type{expected, domain}));
+
+    coverage.clear();
+    EXPECT_TRUE(coverage.empty());
+}
+
+TEST_F(compressed_int_coverage_test, compression) {
+    ids_type const ids = random_ids(42, 1); // one in a thousand samples.
+    coverage_type const coverage{ids, domain};
+    libjst::int_coverage<uint32_t> const int_coverage{ids, domain};
+
+    EXPECT_LT(coverage.memory_usage() * 3, int_coverage.memory_usage() * 2);
+}
+
+TEST_F(compressed_int_coverage_test, seek) {
+    ids_type const ids = random_ids(3, 300);
+    coverage_type const coverage{ids, domain};
+
+    auto it = coverage.begin();
+    for (uint32_t target = 0; target < 100'001; target += 997) {
+        it.seek(target);
+        auto expected = std::ranges::lower_bound(ids, target);
+        if (expected == ids.end()) {
+            EXPECT_TRUE(it == coverage.end());
+        } else {
+            ASSERT_FALSE(it == coverage.end());
+            EXPECT_EQ(*it, *expected);
+        }
+    }
+}
+
+TEST_F(compressed_int_coverage_test, set_operations) {
+    std::vector<ids_type> const ids = operands();
+    for (std::size_t lhs_index = 0; lhs_index < ids.size(); ++lhs_index) {
+        for (std::size_t rhs_index = 0; rhs_index < ids.size(); ++rhs_index) {
+            ids_type const & lhs_ids = ids[lhs_index];
+            ids_type const & rhs_ids = ids[rhs_index];
+            coverage_type const lhs{lhs_ids, domain};
+            coverage_type const rhs{rhs_ids, domain};
+
+            ids_type expected_intersection{};
+            std::ranges::set_intersection(lhs_ids, rhs_ids, std::back_inserter(expected_intersection));
+            ids_type expected_difference{};
+            std::ranges::set_difference(lhs_ids, rhs_ids, std::back_inserter(expected_difference));
+            ids_type expected_union{};
+            std::ranges::set_union(lhs_ids, rhs_ids, std::back_inserter(expected_union));
+
+            auto const operands = ::testing::PrintToString(std::pair{lhs_index, rhs_index});
+            coverage_type const intersection = libjst::coverage_intersection(lhs, rhs);
+            EXPECT_EQ(elements(intersection), expected_intersection) << operands;
+            EXPECT_TRUE(intersection == (coverage_type{expected_intersection, domain})) << operands;
+            EXPECT_TRUE(intersection.get_domain() == domain);
+
+            coverage_type const difference = libjst::coverage_difference(lhs, rhs);
+            EXPECT_EQ(elements(difference), expected_difference) << operands;
+            EXPECT_TRUE(difference == (coverage_type{expected_difference, domain})) << operands;
+
+            EXPECT_EQ(elements(libjst::coverage_union(lhs, rhs)), expected_union) << operands;
+            EXPECT_EQ(libjst::coverage_intersects(lhs, rhs), !expected_intersection.empty()) << operands;
+            EXPECT_EQ(libjst::coverage_intersection_count(lhs, rhs), expected_intersection.size()) << operands;
+
+            coverage_type target{rhs};
+            libjst::coverage_intersect_into(target, lhs, target);
+            EXPECT_TRUE(target == intersection) << operands;
+            libjst::coverage_difference_into(target, lhs, rhs);
+            EXPECT_TRUE(target == difference) << operands;
+        }
+    }
+}
+
+TEST_F(compressed_int_coverage_test, serialisation) {
+    for (ids_type const & ids : operands()) {
+        coverage_type const expected{ids, domain};
+        std::stringstream archive_stream{};
+        {
+            cereal::JSONOutputArchive output_archive(archive_stream);
+            output_archive(expected);
+        }
+
+        coverage_type actual{};
+        {
+            cereal::JSONInputArchive input_archive(archive_stream);
+            input_archive(actual);
+        }
+        EXPECT_TRUE(actual == expected);
+    }
+}
@@ -0,0 +1,117 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/coverage/bit_coverage_view.hpp>
+#include <libjst/coverage/coverage_groups.hpp>
+#include <libjst/coverage/hybrid_coverage.hpp>
+#include <libjst/coverage/int_coverage.hpp>
+#include <libjst/rcms/sample_permutation.hpp>
+
+struct coverage_groups_test : public ::testing::Test {
+    static constexpr uint32_t member_count{300};
+    libjst::range_domain<uint32_t> domain{0, member_count};
+
+    // The members of the coverage in every group, counted member by member.
+    static std::vector<std::size_t> expected_counts(std::vector<uint32_t> const & ids,
+                                                    std::vector<uint32_t> const & group_of,
+                                                    std::size_t const group_count) {
+        std::vector<std::size_t> counts(group_count);
+        for (uint32_t const id : ids)
+            ++counts[group_of[id]];
+        return counts;
+    }
+
+    static std::vector<uint32_t> random_ids(uint64_t const seed) {
+        std::mt19937_64 generator{seed};
+        std::vector<uint32_t> ids{};
+        for (uint32_t id = 0; id < member_count; ++id)
+            if (generator() % 3 == 0)
+                ids.push_back(id);
+        return ids;
+    }
+};
+
+TEST_F(coverage_groups_test, contiguous_groups) {
+    // Three groups spanning whole words and two groups sharing the words around their borders.
+    std::vector<uint32_t> group_of(member_count);
+    for (uint32_t id = 0; id < member_count; ++id)
+        group_of[id] = (id < 128) ? 0 : (id < 150) ? 1 : (id < 170) ? 2 : (id < 256) ? 3 : 4;
+
+    libjst::coverage_groups const groups{group_of, 5};
+    EXPECT_EQ(groups.size(), member_count);
+    EXPECT_EQ(groups.group_count(), 5u);
+    EXPECT_EQ(groups.group_of(140), 1u);
+    EXPECT_EQ(groups.mask_count(), 6u); // [0, 128), three groups in [128, 192), [192, 256) and the partial last word.
+
+    for (uint64_t const seed : {1, 2, 3}) {
+        std::vector<uint32_t> const ids = random_ids(seed);
+        std::vector<std::size_t> const expected = expected_counts(ids, group_of, 5);
+        libjst::bit_coverage<uint32_t> const coverage{ids, domain};
+        EXPECT_EQ(groups.count(coverage), expected) << seed;
+        EXPECT_EQ(groups.count(libjst::bit_coverage_view<uint32_t>{coverage}), expected) << seed;
+        EXPECT_EQ(groups.count(libjst::int_coverage<uint32_t>{ids, domain}), expected) << seed;
+        EXPECT_EQ(groups.count(libjst::hybrid_coverage<uint32_t>{ids, domain}), expected) << seed;
+    }
+
+    EXPECT_EQ(groups.count(libjst::bit_coverage<uint32_t>{domain}), (std::vector<std::size_t>(5, 0)));
+}
+
+TEST_F(coverage_groups_test, interleaved_groups) {
+    std::vector<uint32_t> group_of(member_count);
+    for (uint32_t id = 0; id < member_count; ++id)
+        group_of[id] = id % 26;
+
+    libjst::coverage_groups const groups{group_of, 26};
+    std::vector<uint32_t> const ids = random_ids(7);
+    std::vector<std::size_t> counts(26, 42); // overwritten
+    groups.count_into(libjst::bit_coverage<uint32_t>{ids, domain}, counts);
+    EXPECT_EQ(counts, expected_counts(ids, group_of, 26));
+}
+
+TEST_F(coverage_groups_test, permuted) {
+    std::vector<uint32_t> group_of(member_count);
+    for (uint32_t id = 0; id < member_count; ++id)
+        group_of[id] = id % 3;
+    libjst::coverage_groups const groups{group_of, 3};
+
+    // Sorts the members by their group, such that every group is contiguous in the permuted domain.
+    std::vector<std::size_t> original_samples{};
+    for (uint32_t group = 0; group < 3; ++group)
+        for (uint32_t id = group; id < member_count; id += 3)
+            original_samples.push_back(id);
+    libjst::sample_permutation const permutation{original_samples};
+
+    libjst::coverage_groups const permuted = groups.permuted(permutation);
+    EXPECT_EQ(permuted.group_of(0), 0u);
+    EXPECT_EQ(permuted.group_of(member_count - 1), 2u);
+    EXPECT_LT(permuted.mask_count(), groups.mask_count());
+
+    std::vector<uint32_t> const ids = random_ids(11);
+    std::vector<uint32_t> rows{};
+    for (uint32_t row = 0; row < member_count; ++row)
+        if (std::ranges::binary_search(ids, permutation.original_sample(row)))
+            rows.push_back(row);
+
+    EXPECT_EQ(permuted.count(libjst::bit_coverage<uint32_t>{rows, domain}),
+              groups.count(libjst::bit_coverage<uint32_t>{ids, domain}));
+
+    EXPECT_THROW(groups.permuted(libjst::sample_permutation{{1, 0}}), std::invalid_argument);
+}
+
+TEST_F(coverage_groups_test, invalid_group) {
+    EXPECT_THROW((libjst::coverage_groups{std::vector<int>{0, 1, 2}, 2}), std::invalid_argument);
+    EXPECT_THROW((libjst::coverage_groups{std::vector<int>{0, -1}, 2}), std::invalid_argument);
+    EXPECT_NO_THROW((libjst::coverage_groups{std::vector<int>{}, 0}));
+}
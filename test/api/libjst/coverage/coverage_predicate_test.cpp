@@ -0,0 +1,215 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <ranges>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/coverage/bit_coverage_view.hpp>
+#include <libjst/coverage/compressed_int_coverage.hpp>
+#include <libjst/coverage/concept.hpp>
+#include <libjst/coverage/hybrid_coverage.hpp>
+#include <libjst/coverage/int_coverage.hpp>
+
+template <typename coverage_t>
+struct coverage_predicate_test : public ::testing::Test {
+    using coverage_type = coverage_t;
+    using coverage_domain_type = libjst::coverage_domain_t<coverage_type>;
+
+    // Spans more than one word for the bit coverage.
+    coverage_domain_type domain{0, 130};
+    coverage_type cov1{{0, 63, 64, 100, 129}, domain};
+    coverage_type cov2{{1, 64, 100, 128}, domain};
+    coverage_type cov3{{2, 65, 127}, domain};
+    coverage_type empty{domain};
+
+    static std::vector<uint32_t> elements(coverage_type const & coverage) {
+        std::vector<uint32_t> result{};
+        if constexpr (std::same_as<coverage_type, libjst::bit_coverage<uint32_t>>) {
+            for (uint32_t i = 0; i < coverage.size(); ++i)
+                if (coverage[i])
+                    result.push_back(i);
+        } else {
+            std::ranges::copy(coverage, std::back_inserter(result));
+        }
+        return result;
+    }
+};
+
+using coverage_types = ::testing::Types<libjst::bit_coverage<uint32_t>,
+                                        libjst::int_coverage<uint32_t>,
+                                        libjst::hybrid_coverage<uint32_t>,
+                                        libjst::compressed_int_coverage<uint32_t>>;
+TYPED_TEST_SUITE(coverage_predicate_test, coverage_types);
+
+TYPED_TEST(coverage_predicate_test, intersects) {
+    EXPECT_TRUE(libjst::coverage_intersects(this->cov1, this->cov2));
+    EXPECT_TRUE(libjst::coverage_intersects(this->cov2, this->cov1));
+    EXPECT_TRUE(libjst::coverage_intersects(this->cov1, this->cov1));
+    EXPECT_FALSE(libjst::coverage_intersects(this->cov1, this->cov3));
+    EXPECT_FALSE(libjst::coverage_intersects(this->cov2, this->cov3));
+    EXPECT_FALSE(libjst::coverage_intersects(this->cov1, this->empty));
+    EXPECT_FALSE(libjst::coverage_intersects(this->empty, this->empty));
+
+    for (auto const & [first, second] : {std::pair{this->cov1, this->cov2},
+                                         std::pair{this->cov1, this->cov3},
+                                         std::pair{this->cov3, this->empty}}) {
+        EXPECT_EQ(libjst::coverage_intersects(first, second), !libjst::coverage_intersection(first, second).empty());
+    }
+}
+
+TYPED_TEST(coverage_predicate_test, intersection_count) {
+    EXPECT_EQ(libjst::coverage_intersection_count(this->cov1, this->cov2), 2u);
+    EXPECT_EQ(libjst::coverage_intersection_count(this->cov2, this->cov1), 2u);
+    EXPECT_EQ(libjst::coverage_intersection_count(this->cov1, this->cov1), 5u);
+    EXPECT_EQ(libjst::coverage_intersection_count(this->cov1, this->cov3), 0u);
+    EXPECT_EQ(libjst::coverage_intersection_count(this->cov1, this->empty), 0u);
+}
+
+TYPED_TEST(coverage_predicate_test, intersect_into) {
+    using coverage_t = TypeParam;
+
+    coverage_t target{this->domain};
+    EXPECT_EQ(&libjst::coverage_intersect_into(target, this->cov1, this->cov2), &target);
+    EXPECT_EQ(this->elements(target), (std::vector<uint32_t>{64, 100}));
+
+    libjst::coverage_intersect_into(target, this->cov1, this->cov3); // overwrites the previous result.
+    EXPECT_TRUE(target.empty());
+
+    coverage_t default_target{};
+    libjst::coverage_intersect_into(default_target, this->cov2, this->cov1);
+    EXPECT_EQ(this->elements(default_target), (std::vector<uint32_t>{64, 100}));
+    EXPECT_TRUE(default_target.get_domain() == this->domain);
+}
+
+TYPED_TEST(coverage_predicate_test, intersect_into_aliased) {
+    using coverage_t = TypeParam;
+
+    coverage_t target = this->cov1;
+    libjst::coverage_intersect_into(target, target, this->cov2);
+    EXPECT_EQ(this->elements(target), (std::vector<uint32_t>{64, 100}));
+
+    target = this->cov2;
+    libjst::coverage_intersect_into(target, this->cov1, target);
+    EXPECT_EQ(this->elements(target), (std::vector<uint32_t>{64, 100}));
+
+    target = this->cov2;
+    libjst::coverage_intersect_into(target, target, target);
+    EXPECT_TRUE(target == this->cov2);
+}
+
+TYPED_TEST(coverage_predicate_test, difference_into) {
+    using coverage_t = TypeParam;
+
+    coverage_t target{this->domain};
+    EXPECT_EQ(&libjst::coverage_difference_into(target, this->cov1, this->cov2), &target);
+    EXPECT_EQ(this->elements(target), (std::vector<uint32_t>{0, 63, 129}));
+
+    libjst::coverage_difference_into(target, this->cov1, this->cov1); // overwrites the previous result.
+    EXPECT_TRUE(target.empty());
+
+    coverage_t default_target{};
+    libjst::coverage_difference_into(default_target, this->cov2, this->cov1);
+    EXPECT_EQ(this->elements(default_target), (std::vector<uint32_t>{1, 128}));
+    EXPECT_TRUE(default_target.get_domain() == this->domain);
+}
+
+TYPED_TEST(coverage_predicate_test, difference_into_aliased) {
+    using coverage_t = TypeParam;
+
+    coverage_t target = this->cov1;
+    libjst::coverage_difference_into(target, target, this->cov2);
+    EXPECT_EQ(this->elements(target), (std::vector<uint32_t>{0, 63, 129}));
+
+    target = this->cov2;
+    libjst::coverage_difference_into(target, this->cov1, target);
+    EXPECT_EQ(this->elements(target), (std::vector<uint32_t>{0, 63, 129}));
+
+    target = this->cov2;
+    libjst::coverage_difference_into(target, target, target);
+    EXPECT_TRUE(target.empty());
+}
+
+TYPED_TEST(coverage_predicate_test, union_into) {
+    using coverage_t = TypeParam;
+
+    EXPECT_EQ(this->elements(libjst::coverage_union(this->cov1, this->cov3)),
+              (std::vector<uint32_t>{0, 2, 63, 64, 65, 100, 127, 129}));
+
+    coverage_t target{this->domain};
+    EXPECT_EQ(&libjst::coverage_union_into(target, this->cov1, this->cov2), &target);
+    EXPECT_EQ(this->elements(target), (std::vector<uint32_t>{0, 1, 63, 64, 100, 128, 129}));
+
+    libjst::coverage_union_into(target, this->cov3, this->empty); // overwrites the previous result.
+    EXPECT_EQ(this->elements(target), (std::vector<uint32_t>{2, 65, 127}));
+
+    coverage_t default_target{};
+    libjst::coverage_union_into(default_target, this->cov2, this->cov1);
+    EXPECT_EQ(this->elements(default_target), (std::vector<uint32_t>{0, 1, 63, 64, 100, 128, 129}));
+    EXPECT_TRUE(default_target.get_domain() == this->domain);
+}
+
+TYPED_TEST(coverage_predicate_test, union_into_aliased) {
+    using coverage_t = TypeParam;
+
+    coverage_t target = this->cov1;
+    libjst::coverage_union_into(target, target, this->cov2);
+    EXPECT_EQ(this->elements(target), (std::vector<uint32_t>{0, 1, 63, 64, 100, 128, 129}));
+
+    target = this->cov2;
+    libjst::coverage_union_into(target, this->cov3, target);
+    EXPECT_EQ(this->elements(target), (std::vector<uint32_t>{1, 2, 64, 65, 100, 127, 128}));
+
+    target = this->cov2;
+    libjst::coverage_union_into(target, target, target);
+    EXPECT_TRUE(target == this->cov2);
+
+    // accumulates the union like the coverage summaries.
+    target = this->empty;
+    for (coverage_t const * coverage : {&this->cov1, &this->cov2, &this->cov3, &this->empty})
+        libjst::detail::assign_coverage_union(target, target, *coverage);
+    EXPECT_EQ(this->elements(target), (std::vector<uint32_t>{0, 1, 2, 63, 64, 65, 100, 127, 128, 129}));
+}
+
+TEST(bit_coverage_view_predicate_test, fused_predicates) {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using view_type = libjst::bit_coverage_view<uint32_t>;
+
+    libjst::range_domain<uint32_t> domain{0, 130};
+    coverage_type cov1{{0, 63, 64, 100, 129}, domain};
+    coverage_type cov2{{1, 64, 100, 128}, domain};
+    coverage_type cov3{{2, 65, 127}, domain};
+
+    EXPECT_TRUE(libjst::coverage_intersects(view_type{cov1}, view_type{cov2}));
+    EXPECT_FALSE(libjst::coverage_intersects(view_type{cov1}, view_type{cov3}));
+    EXPECT_TRUE(libjst::coverage_intersects(cov1, view_type{cov2}));
+    EXPECT_EQ(libjst::coverage_intersection_count(view_type{cov1}, view_type{cov2}), 2u);
+    EXPECT_EQ(libjst::coverage_intersection_count(view_type{cov1}, cov3), 0u);
+
+    coverage_type target{};
+    libjst::coverage_intersect_into(target, view_type{cov1}, view_type{cov2});
+    EXPECT_TRUE(target == libjst::coverage_intersection(cov1, cov2));
+
+    libjst::coverage_intersect_into(target, view_type{target}, view_type{cov3});
+    EXPECT_TRUE(target.empty());
+
+    libjst::coverage_difference_into(target, view_type{cov1}, view_type{cov2});
+    EXPECT_TRUE(target == libjst::coverage_difference(cov1, cov2));
+
+    libjst::coverage_difference_into(target, view_type{target}, view_type{cov1});
+    EXPECT_TRUE(target.empty());
+
+    EXPECT_TRUE(libjst::coverage_union(view_type{cov1}, view_type{cov2}) == libjst::coverage_union(cov1, cov2));
+
+    libjst::coverage_union_into(target, view_type{cov1}, view_type{cov2});
+    EXPECT_TRUE(target == libjst::coverage_union(cov1, cov2));
+
+    libjst::coverage_union_into(target, view_type{target}, view_type{cov3});
+    EXPECT_TRUE(target == libjst::coverage_union(libjst::coverage_union(cov1, cov2), cov3));
+}
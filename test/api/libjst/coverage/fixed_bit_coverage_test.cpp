@@ -0,0 +1,151 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <cereal/archives/binary.hpp>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/coverage/coverage_members.hpp>
+#include <libjst/coverage/fixed_bit_coverage.hpp>
+
+template <typename coverage_t>
+struct fixed_bit_coverage_test : public ::testing::Test {
+    using coverage_type = coverage_t;
+    using coverage_domain_type = libjst::coverage_domain_t<coverage_type>;
+    using reference_type = libjst::bit_coverage<uint32_t>;
+
+    static constexpr uint32_t domain_size = coverage_t{}.get_domain().max();
+    coverage_domain_type domain{0, domain_size};
+
+    static std::vector<uint32_t> members(auto const & coverage) {
+        std::vector<uint32_t> ids{};
+        libjst::for_each_covered(coverage, 0, coverage.size(), [&] (std::size_t const id) { ids.push_back(id); });
+        return ids;
+    }
+
+    std::vector<uint32_t> random_ids(unsigned const seed) const {
+        std::mt19937 generator{seed};
+        std::vector<uint32_t> ids{};
+        for (uint32_t id = 0; id < domain_size; ++id)
+            if (generator() % 3 == 0)
+                ids.push_back(id);
+        return ids;
+    }
+};
+
+using coverage_types = ::testing::Types<libjst::fixed_bit_coverage<uint32_t, 2>,
+                                        libjst::fixed_bit_coverage<uint32_t, 64>,
+                                        libjst::fixed_bit_coverage<uint32_t, 100>>;
+TYPED_TEST_SUITE(fixed_bit_coverage_test, coverage_types);
+
+TYPED_TEST(fixed_bit_coverage_test, construct)
+{
+    using coverage_t = typename TestFixture::coverage_type;
+
+    coverage_t empty{this->domain};
+    EXPECT_TRUE(empty.empty());
+    EXPECT_FALSE(empty.any());
+    EXPECT_EQ(empty.size(), this->domain_size);
+    EXPECT_EQ(empty.memory_usage(), 0u);
+
+    coverage_t full{std::views::iota(0u, this->domain_size), this->domain};
+    EXPECT_EQ(full.count(), this->domain_size);
+    EXPECT_TRUE(full[0]);
+    EXPECT_TRUE(full.contains(this->domain_size - 1));
+    EXPECT_FALSE(full.contains(this->domain_size));
+
+    coverage_t single{{this->domain_size - 1}, this->domain};
+    EXPECT_EQ(TestFixture::members(single), (std::vector<uint32_t>{this->domain_size - 1}));
+
+    EXPECT_THROW((coverage_t{{this->domain_size}, this->domain}), std::domain_error);
+    EXPECT_THROW((coverage_t{typename TestFixture::coverage_domain_type{0, this->domain_size + 1}}), std::length_error);
+}
+
+TYPED_TEST(fixed_bit_coverage_test, set_operations)
+{
+    using coverage_t = typename TestFixture::coverage_type;
+    using reference_t = typename TestFixture::reference_type;
+
+    for (unsigned seed = 0; seed < 8; ++seed) {
+        auto ids1 = this->random_ids(seed);
+        auto ids2 = this->random_ids(seed + 100);
+        coverage_t c1{ids1, this->domain};
+        coverage_t c2{ids2, this->domain};
+        reference_t r1{ids1, {0, this->domain_size}};
+        reference_t r2{ids2, {0, this->domain_size}};
+
+        EXPECT_EQ(TestFixture::members(c1), ids1);
+        EXPECT_EQ(TestFixture::members(libjst::coverage_intersection(c1, c2)),
+                  TestFixture::members(libjst::coverage_intersection(r1, r2)));
+        EXPECT_EQ(TestFixture::members(libjst::coverage_difference(c1, c2)),
+                  TestFixture::members(libjst::coverage_difference(r1, r2)));
+        EXPECT_EQ(TestFixture::members(libjst::coverage_union(c1, c2)),
+                  TestFixture::members(libjst::coverage_union(r1, r2)));
+        EXPECT_EQ(libjst::coverage_intersects(c1, c2), libjst::coverage_intersects(r1, r2));
+        EXPECT_EQ(libjst::coverage_intersection_count(c1, c2), libjst::coverage_intersection_count(r1, r2));
+
+        coverage_t target{this->domain};
+        libjst::coverage_intersect_into(target, c1, c2);
+        EXPECT_EQ(target, libjst::coverage_intersection(c1, c2));
+        libjst::coverage_difference_into(c1, c1, c2);
+        EXPECT_EQ(TestFixture::members(c1), TestFixture::members(libjst::coverage_difference(r1, r2)));
+    }
+}
+
+TYPED_TEST(fixed_bit_coverage_test, range)
+{
+    using coverage_t = typename TestFixture::coverage_type;
+
+    auto ids = this->random_ids(3);
+    coverage_t coverage{ids, this->domain};
+    std::vector<uint32_t> visited{};
+    uint32_t id = 0;
+    for (bool const is_covered : coverage) {
+        if (is_covered)
+            visited.push_back(id);
+        ++id;
+    }
+    EXPECT_EQ(id, this->domain_size);
+    EXPECT_EQ(visited, ids);
+
+    coverage.clear();
+    EXPECT_TRUE(coverage.empty());
+}
+
+TYPED_TEST(fixed_bit_coverage_test, inline_storage)
+{
+    using coverage_t = typename TestFixture::coverage_type;
+
+    EXPECT_TRUE(std::is_trivially_copyable_v<coverage_t>);
+    EXPECT_LE(sizeof(coverage_t), (this->domain_size + 63) / 64 * sizeof(uint64_t) + 2 * sizeof(uint32_t));
+}
+
+TYPED_TEST(fixed_bit_coverage_test, serialise)
+{
+    using coverage_t = typename TestFixture::coverage_type;
+
+    coverage_t expected{this->random_ids(5), this->domain};
+    std::stringstream archive_stream{};
+    {
+        cereal::BinaryOutputArchive output_archive{archive_stream};
+        output_archive(expected);
+    }
+
+    coverage_t actual{};
+    {
+        cereal::BinaryInputArchive input_archive{archive_stream};
+        input_archive(actual);
+    }
+    EXPECT_EQ(actual, expected);
+}
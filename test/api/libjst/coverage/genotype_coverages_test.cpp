@@ -0,0 +1,112 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/coverage/genotype_coverages.hpp>
+
+// A random genotype matrix with the given number of variants and samples.
+static std::vector<std::vector<bool>> random_genotypes(std::size_t const variant_count, std::size_t const sample_count)
+{
+    std::mt19937_64 generator{42};
+    std::vector<std::vector<bool>> genotypes(variant_count, std::vector<bool>(sample_count));
+    for (auto & variant : genotypes)
+        for (std::size_t sample = 0; sample < sample_count; ++sample)
+            variant[sample] = generator() % 3 == 0;
+    return genotypes;
+}
+
+// Packs the rows of the matrix, or of its transpose, into words.
+static std::vector<uint64_t> pack(std::vector<std::vector<bool>> const & genotypes, bool const transpose)
+{
+    std::size_t const variant_count = genotypes.size();
+    std::size_t const sample_count = genotypes.empty() ? 0 : genotypes.front().size();
+    std::size_t const row_count = transpose ? sample_count : variant_count;
+    std::size_t const column_count = transpose ? variant_count : sample_count;
+    std::size_t const row_words = (column_count + 63) / 64;
+
+    std::vector<uint64_t> words(row_count * row_words);
+    for (std::size_t row = 0; row < row_count; ++row)
+        for (std::size_t column = 0; column < column_count; ++column)
+            if (transpose ? genotypes[column][row] : genotypes[row][column])
+                words[row * row_words + column / 64] |= uint64_t{1} << (column % 64);
+    // Sets the unused bits of the last words, which must be ignored.
+    if (column_count % 64 != 0)
+        for (std::size_t row = 0; row < row_count; ++row)
+            words[row * row_words + row_words - 1] |= ~uint64_t{0} << (column_count % 64);
+    return words;
+}
+
+static std::vector<libjst::bit_coverage<uint32_t>> expected_coverages(std::vector<std::vector<bool>> const & genotypes,
+                                                                      std::size_t const sample_count)
+{
+    std::vector<libjst::bit_coverage<uint32_t>> coverages{};
+    for (auto const & variant : genotypes) {
+        std::vector<uint32_t> samples{};
+        for (uint32_t sample = 0; sample < sample_count; ++sample)
+            if (variant[sample])
+                samples.push_back(sample);
+        coverages.emplace_back(samples, libjst::range_domain<uint32_t>{0, static_cast<uint32_t>(sample_count)});
+    }
+    return coverages;
+}
+
+TEST(genotype_coverages_test, from_words)
+{
+    std::vector<uint64_t> const words{0b1011, ~uint64_t{0}};
+    auto coverage = libjst::bit_coverage<uint32_t>::from_words(words, libjst::range_domain<uint32_t>{0, 70});
+    EXPECT_EQ(coverage, (libjst::bit_coverage<uint32_t>{{0, 1, 3, 64, 65, 66, 67, 68, 69},
+                                                         libjst::range_domain<uint32_t>{0, 70}}));
+
+    EXPECT_THROW((libjst::bit_coverage<uint32_t>::from_words(std::span{words}.first(1),
+                                                             libjst::range_domain<uint32_t>{0, 70})),
+                 std::invalid_argument);
+}
+
+TEST(genotype_coverages_test, variant_major)
+{
+    for (auto [variant_count, sample_count] : {std::pair{1u, 1u}, std::pair{100u, 70u}, std::pair{200u, 128u}}) {
+        auto genotypes = random_genotypes(variant_count, sample_count);
+        auto words = pack(genotypes, false);
+        for (std::size_t thread_count : {1u, 3u}) {
+            EXPECT_EQ(libjst::genotype_coverages(words, variant_count, sample_count,
+                                                 libjst::genotype_order::variant_major, thread_count),
+                      expected_coverages(genotypes, sample_count));
+        }
+    }
+}
+
+TEST(genotype_coverages_test, sample_major)
+{
+    for (auto [variant_count, sample_count] : {std::pair{1u, 1u}, std::pair{100u, 70u}, std::pair{200u, 130u}}) {
+        auto genotypes = random_genotypes(variant_count, sample_count);
+        auto words = pack(genotypes, true);
+        for (std::size_t thread_count : {1u, 3u}) {
+            EXPECT_EQ(libjst::genotype_coverages(words, variant_count, sample_count,
+                                                 libjst::genotype_order::sample_major, thread_count),
+                      expected_coverages(genotypes, sample_count));
+        }
+    }
+}
+
+TEST(genotype_coverages_test, too_few_words)
+{
+    std::vector<uint64_t> const words(3);
+    EXPECT_THROW(libjst::genotype_coverages(words, 4, 10, libjst::genotype_order::variant_major),
+                 std::invalid_argument);
+    EXPECT_THROW(libjst::genotype_coverages(words, 70, 4, libjst::genotype_order::sample_major),
+                 std::invalid_argument);
+    EXPECT_TRUE(libjst::genotype_coverages(words, 3, 10, libjst::genotype_order::variant_major).size() == 3);
+}
@@ -0,0 +1,218 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <iterator>
+#include <numeric>
+#include <random>
+#include <ranges>
+#include <sstream>
+#include <vector>
+
+#include <cereal/archives/json.hpp>
+#include <cereal/types/vector.hpp>
+
+#include <libjst/coverage/concept.hpp>
+#include <libjst/coverage/hybrid_coverage.hpp>
+
+struct hybrid_coverage_test : public ::testing::Test {
+    using coverage_type = libjst::hybrid_coverage<uint32_t>;
+    using coverage_domain_type = libjst::coverage_domain_t<coverage_type>;
+    using ids_type = std::vector<uint32_t>;
+    using kind = libjst::hybrid_coverage_kind;
+
+    coverage_domain_type domain{0, 1000};
+
+    static ids_type elements(coverage_type const & coverage) {
+        ids_type ids{};
+        std::ranges::copy(coverage, std::back_inserter(ids));
+        return ids;
+    }
+
+    static ids_type iota(uint32_t const first, uint32_t const last) {
+        ids_type ids(last - first);
+        std::iota(ids.begin(), ids.end(), first);
+        return ids;
+    }
+
+    static ids_type random_ids(unsigned const seed) {
+        std::mt19937 generator{seed};
+        ids_type ids{};
+        for (uint32_t id = 0; id < 1000; ++id)
+            if (generator() % 2)
+                ids.push_back(id);
+        return ids;
+    }
+
+    // Two coverages of every representation.
+    std::vector<ids_type> operands() const {
+        ids_type runs1 = iota(0, 100);
+        std::ranges::copy(iota(400, 600), std::back_inserter(runs1));
+        return {ids_type{3, 17, 500, 999}, ids_type{17, 18, 450}, runs1, iota(50, 450), random_ids(42), random_ids(7),
+                ids_type{}};
+    }
+};
+
+TEST_F(hybrid_coverage_test, concept) {
+    EXPECT_TRUE(std::ranges::forward_range<coverage_type>);
+    EXPECT_TRUE((std::same_as<std::ranges::range_value_t<coverage_type>, uint32_t>));
+    EXPECT_TRUE((std::same_as<libjst::coverage_domain_t<coverage_type>, coverage_domain_type>));
+}
+
+TEST_F(hybrid_coverage_test, construction) {
+    coverage_type empty{domain};
+    EXPECT_TRUE(empty.empty());
+    EXPECT_FALSE(empty.any());
+    EXPECT_EQ(empty.size(), 0u);
+    EXPECT_EQ(empty.max_size(), 1000u);
+    EXPECT_TRUE(empty.begin() == empty.end());
+
+    coverage_type sparse{{999, 3, 500, 17, 3}, domain};
+    EXPECT_EQ(sparse.kind(), kind::sparse);
+    EXPECT_EQ(elements(sparse), (ids_type{3, 17, 500, 999}));
+    EXPECT_EQ(sparse.size(), 4u);
+    EXPECT_EQ(sparse.front(), 3u);
+    EXPECT_EQ(sparse.back(), 999u);
+    EXPECT_EQ(sparse.memory_usage(), 4 * sizeof(uint32_t));
+
+    coverage_type full{std::views::iota(domain.min(), domain.max()), domain};
+    EXPECT_EQ(full.kind(), kind::runs);
+    EXPECT_EQ(full.size(), 1000u);
+    EXPECT_EQ(full.front(), 0u);
+    EXPECT_EQ(full.back(), 999u);
+    EXPECT_EQ(elements(full), iota(0, 1000));
+
+    coverage_type dense{random_ids(42), domain};
+    EXPECT_EQ(dense.kind(), kind::dense);
+    EXPECT_EQ(elements(dense), random_ids(42));
+    EXPECT_EQ(dense.size(), random_ids(42).size());
+    EXPECT_EQ(dense.front(), random_ids(42).front());
+    EXPECT_EQ(dense.back(), random_ids(42).back());
+    EXPECT_EQ(dense.memory_usage(), 16 * sizeof(uint64_t));
+
+    EXPECT_THROW((coverage_type{{1000}, domain}), std::domain_error);
+    EXPECT_THROW((coverage_type{ids_type{5, 1001}, domain}), std::domain_error);
+}
+
+TEST_F(hybrid_coverage_test, contains) {
+    for (ids_type const & ids : operands()) {
+        coverage_type coverage{ids, domain};
+        for (uint32_t id = 0; id < 1001; ++id)
+            EXPECT_EQ(coverage.contains(id), std::ranges::binary_search(ids, id)) << id;
+    }
+}
+
+TEST_F(hybrid_coverage_test, insert) {
+    coverage_type coverage{domain};
+    coverage.insert(7);
+    coverage.insert(3);
+    coverage.insert(7);
+    EXPECT_EQ(coverage.kind(), kind::sparse);
+    EXPECT_EQ(elements(coverage), (ids_type{3, 7}));
+    EXPECT_THROW(coverage.insert(1000), std::domain_error);
+
+    for (uint32_t id = 0; id < 1000; id += 2) // outgrows the bitmap.
+        coverage.insert(id);
+    EXPECT_EQ(coverage.kind(), kind::dense);
+    EXPECT_EQ(coverage.size(), 502u);
+    EXPECT_TRUE(coverage.contains(7));
+    EXPECT_FALSE(coverage.contains(9));
+
+    coverage_type runs{iota(10, 20), domain};
+    ASSERT_EQ(runs.kind(), kind::runs);
+    runs.insert(20);
+    runs.insert(9);
+    runs.insert(30);
+    runs.insert(15);
+    EXPECT_EQ(runs.kind(), kind::runs);
+    ids_type expected = iota(9, 21);
+    expected.push_back(30);
+    EXPECT_EQ(elements(runs), expected);
+
+    runs.clear();
+    EXPECT_TRUE(runs.empty());
+}
+
+TEST_F(hybrid_coverage_test, optimise) {
+    coverage_type coverage{domain};
+    for (uint32_t id = 100; id < 400; ++id)
+        coverage.insert(id);
+
+    EXPECT_EQ(coverage.kind(), kind::dense);
+    EXPECT_EQ(coverage.optimise().kind(), kind::runs);
+    EXPECT_EQ(coverage.memory_usage(), 2 * sizeof(uint32_t));
+    EXPECT_EQ(elements(coverage), iota(100, 400));
+}
+
+TEST_F(hybrid_coverage_test, set_operations) {
+    std::vector<ids_type> const ids = operands();
+    for (ids_type const & lhs_ids : ids) {
+        for (ids_type const & rhs_ids : ids) {
+            coverage_type const lhs{lhs_ids, domain};
+            coverage_type const rhs{rhs_ids, domain};
+
+            ids_type expected_intersection{};
+            std::ranges::set_intersection(lhs_ids, rhs_ids, std::back_inserter(expected_intersection));
+            ids_type expected_difference{};
+            std::ranges::set_difference(lhs_ids, rhs_ids, std::back_inserter(expected_difference));
+            ids_type expected_union{};
+            std::ranges::set_union(lhs_ids, rhs_ids, std::back_inserter(expected_union));
+
+            auto const kinds = ::testing::PrintToString(std::pair{static_cast<int>(lhs.kind()),
+                                                                  static_cast<int>(rhs.kind())});
+            coverage_type const intersection = libjst::coverage_intersection(lhs, rhs);
+            EXPECT_EQ(elements(intersection), expected_intersection) << kinds;
+            EXPECT_TRUE(intersection == (coverage_type{expected_intersection, domain})) << kinds;
+            EXPECT_TRUE(intersection.get_domain() == domain);
+
+            coverage_type const difference = libjst::coverage_difference(lhs, rhs);
+            EXPECT_EQ(elements(difference), expected_difference) << kinds;
+            EXPECT_TRUE(difference == (coverage_type{expected_difference, domain})) << kinds;
+
+            coverage_type const unified = libjst::coverage_union(lhs, rhs);
+            EXPECT_EQ(elements(unified), expected_union) << kinds;
+            EXPECT_TRUE(unified == (coverage_type{expected_union, domain})) << kinds;
+
+            EXPECT_EQ(libjst::coverage_intersects(lhs, rhs), !expected_intersection.empty()) << kinds;
+            EXPECT_EQ(libjst::coverage_intersection_count(lhs, rhs), expected_intersection.size()) << kinds;
+        }
+    }
+}
+
+TEST_F(hybrid_coverage_test, equality) {
+    coverage_type dense{domain};
+    for (uint32_t id = 0; id < 1000; ++id)
+        dense.insert(id);
+    coverage_type runs{iota(0, 1000), domain};
+
+    ASSERT_EQ(dense.kind(), kind::dense);
+    ASSERT_EQ(runs.kind(), kind::runs);
+    EXPECT_TRUE(dense == runs);
+    EXPECT_FALSE(dense == (coverage_type{iota(0, 999), domain}));
+    EXPECT_FALSE(runs == (coverage_type{iota(0, 1000), coverage_domain_type{0, 2000}}));
+}
+
+TEST_F(hybrid_coverage_test, serialisation) {
+    for (ids_type const & ids : operands()) {
+        coverage_type const expected{ids, domain};
+        std::stringstream archive_stream{};
+        {
+            cereal::JSONOutputArchive output_archive(archive_stream);
+            output_archive(expected);
+        }
+
+        coverage_type actual{};
+        {
+            cereal::JSONInputArchive input_archive(archive_stream);
+            input_archive(actual);
+        }
+        EXPECT_EQ(actual.kind(), expected.kind());
+        EXPECT_TRUE(actual == expected);
+    }
+}
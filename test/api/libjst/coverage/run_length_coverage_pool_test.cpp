@@ -0,0 +1,229 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <iterator>
+#include <random>
+#include <ranges>
+#include <sstream>
+#include <vector>
+
+#include <cereal/archives/json.hpp>
+#include <cereal/types/vector.hpp>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/coverage/concept.hpp>
+#include <libjst/coverage/run_length_coverage_pool.hpp>
+#include <libjst/coverage/run_length_coverage_view.hpp>
+
+struct run_length_coverage_pool_test : public ::testing::Test {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using coverage_domain_type = libjst::coverage_domain_t<coverage_type>;
+    using view_type = libjst::run_length_coverage_view<uint32_t>;
+    using pool_type = libjst::run_length_coverage_pool<uint32_t>;
+    using ids_type = std::vector<uint32_t>;
+
+    // Spans more than one word per coverage.
+    coverage_domain_type domain{0, 130};
+    coverage_type cov1{{0, 1, 2, 63, 64, 65, 129}, domain};
+    coverage_type cov2{{1, 64, 100, 101, 102}, domain};
+    coverage_type cov3{{3, 66, 127}, domain};
+
+    static ids_type elements(coverage_type const & coverage) {
+        ids_type ids{};
+        for (uint32_t i = 0; i < coverage.size(); ++i)
+            if (coverage[i])
+                ids.push_back(i);
+        return ids;
+    }
+
+    // Coverages made of runs of random length.
+    static std::vector<coverage_type> random_coverages(coverage_domain_type const & domain) {
+        std::mt19937 generator{42};
+        std::vector<coverage_type> coverages{coverage_type{domain}};
+        coverages.emplace_back(std::views::iota(domain.min(), domain.max()), domain);
+        for (size_t i = 0; i < 8; ++i) {
+            ids_type ids{};
+            bool bit = generator() % 2;
+            for (uint32_t id = 0; id < domain.size();) {
+                uint32_t const run_length = 1 + generator() % (i * 20 + 1);
+                for (uint32_t last = std::min<uint32_t>(id + run_length, domain.size()); id < last; ++id)
+                    if (bit)
+                        ids.push_back(id);
+                bit = !bit;
+            }
+            coverages.emplace_back(ids, domain);
+        }
+        return coverages;
+    }
+};
+
+TEST_F(run_length_coverage_pool_test, concept) {
+    EXPECT_TRUE(std::ranges::random_access_range<pool_type>);
+    EXPECT_TRUE(std::ranges::forward_range<view_type>);
+    EXPECT_TRUE((std::same_as<std::ranges::range_value_t<pool_type>, coverage_type>));
+    EXPECT_TRUE((std::same_as<std::ranges::range_reference_t<pool_type>, view_type>));
+    EXPECT_TRUE((std::same_as<std::ranges::range_value_t<view_type>, uint32_t>));
+}
+
+TEST_F(run_length_coverage_pool_test, view) {
+    pool_type pool{};
+    pool.insert(pool.end(), cov1);
+    pool.insert(pool.end(), coverage_type{domain});
+    view_type view = pool[0];
+
+    EXPECT_EQ(view.size(), 7u);
+    EXPECT_EQ(view.max_size(), 130u);
+    EXPECT_EQ(view.runs().size(), 3u);
+    EXPECT_TRUE(view.get_domain() == domain);
+    EXPECT_TRUE(view.any());
+    EXPECT_EQ(view.front(), 0u);
+    EXPECT_EQ(view.back(), 129u);
+    EXPECT_TRUE(std::ranges::equal(view, elements(cov1)));
+
+    EXPECT_TRUE(view == cov1);
+    EXPECT_FALSE(view == cov2);
+    EXPECT_FALSE(view == coverage_type{domain});
+    EXPECT_TRUE(coverage_type{view} == cov1);
+
+    view_type empty = pool[1];
+    EXPECT_TRUE(empty.empty());
+    EXPECT_EQ(empty.size(), 0u);
+    EXPECT_TRUE(empty.begin() == empty.end());
+    EXPECT_TRUE(empty == coverage_type{domain});
+    EXPECT_FALSE(empty == view);
+}
+
+TEST_F(run_length_coverage_pool_test, rank_select) {
+    pool_type pool{};
+    for (coverage_type const & coverage : random_coverages(domain))
+        pool.insert(pool.end(), coverage);
+
+    for (view_type const view : pool) {
+        ids_type const ids{view.begin(), view.end()};
+        for (uint32_t id = 0; id < 131; ++id) {
+            EXPECT_EQ(view.contains(id), std::ranges::binary_search(ids, id)) << id;
+            EXPECT_EQ(view.rank(id), static_cast<size_t>(std::ranges::lower_bound(ids, id) - ids.begin())) << id;
+        }
+        for (size_t k = 0; k < ids.size(); ++k)
+            EXPECT_EQ(view.select(k), ids[k]) << k;
+        EXPECT_EQ(view.size(), ids.size());
+    }
+}
+
+TEST_F(run_length_coverage_pool_test, insert) {
+    pool_type pool{};
+    EXPECT_TRUE(pool.empty());
+
+    auto it = pool.insert(pool.end(), cov2);
+    EXPECT_TRUE(*it == cov2);
+    it = pool.insert(pool.begin(), cov1);
+    EXPECT_TRUE(*it == cov1);
+    it = pool.insert(std::ranges::next(pool.begin()), cov3);
+    EXPECT_TRUE(*it == cov3);
+
+    EXPECT_EQ(pool.size(), 3u);
+    EXPECT_EQ(pool.run_count(), 9u);
+    EXPECT_TRUE(pool.get_domain() == domain);
+    EXPECT_TRUE(pool[0] == cov1);
+    EXPECT_TRUE(pool[1] == cov3);
+    EXPECT_TRUE(pool[2] == cov2);
+    EXPECT_EQ(pool.end() - pool.begin(), 3);
+
+    EXPECT_THROW(pool.insert(pool.end(), coverage_type{{0}, coverage_domain_type{0, 5}}), std::domain_error);
+    EXPECT_EQ(pool.size(), 3u);
+
+    pool.clear();
+    EXPECT_TRUE(pool.empty());
+    EXPECT_EQ(pool.run_count(), 0u);
+}
+
+TEST_F(run_length_coverage_pool_test, memory_usage) {
+    coverage_domain_type large_domain{0, 100'000};
+    pool_type pool{};
+    pool.insert(pool.end(), coverage_type{std::views::iota(large_domain.min(), large_domain.max()), large_domain});
+    pool.insert(pool.end(), coverage_type{{17, 50'000}, large_domain});
+
+    EXPECT_EQ(pool.run_count(), 3u);
+    EXPECT_LT(pool.memory_usage(), 100u);
+    EXPECT_EQ(pool[0].size(), 100'000u);
+    EXPECT_EQ(pool[1].select(1), 50'000u);
+}
+
+TEST_F(run_length_coverage_pool_test, set_operations) {
+    std::vector<coverage_type> const coverages = random_coverages(domain);
+    pool_type pool{};
+    for (coverage_type const & coverage : coverages)
+        pool.insert(pool.end(), coverage);
+
+    for (size_t i = 0; i < coverages.size(); ++i) {
+        for (size_t j = 0; j < coverages.size(); ++j) {
+            coverage_type const & lhs = coverages[i];
+            coverage_type const & rhs = coverages[j];
+            coverage_type const intersection = libjst::coverage_intersection(lhs, rhs);
+            coverage_type const difference = libjst::coverage_difference(lhs, rhs);
+            size_t const count = elements(intersection).size();
+
+            EXPECT_TRUE(libjst::coverage_intersection(pool[i], pool[j]) == intersection) << i << ' ' << j;
+            EXPECT_TRUE(libjst::coverage_intersection(lhs, pool[j]) == intersection) << i << ' ' << j;
+            EXPECT_TRUE(libjst::coverage_intersection(pool[i], rhs) == intersection) << i << ' ' << j;
+
+            EXPECT_TRUE(libjst::coverage_difference(pool[i], pool[j]) == difference) << i << ' ' << j;
+            EXPECT_TRUE(libjst::coverage_difference(lhs, pool[j]) == difference) << i << ' ' << j;
+            EXPECT_TRUE(libjst::coverage_difference(pool[i], rhs) == difference) << i << ' ' << j;
+
+            EXPECT_EQ(libjst::coverage_intersects(pool[i], pool[j]), count > 0) << i << ' ' << j;
+            EXPECT_EQ(libjst::coverage_intersects(lhs, pool[j]), count > 0) << i << ' ' << j;
+            EXPECT_EQ(libjst::coverage_intersects(pool[i], rhs), count > 0) << i << ' ' << j;
+
+            EXPECT_EQ(libjst::coverage_intersection_count(pool[i], pool[j]), count) << i << ' ' << j;
+            EXPECT_EQ(libjst::coverage_intersection_count(lhs, pool[j]), count) << i << ' ' << j;
+            EXPECT_EQ(libjst::coverage_intersection_count(pool[i], rhs), count) << i << ' ' << j;
+
+            coverage_type target{};
+            EXPECT_TRUE(libjst::coverage_intersect_into(target, lhs, pool[j]) == intersection) << i << ' ' << j;
+            EXPECT_TRUE(libjst::coverage_intersect_into(target, pool[i], rhs) == intersection) << i << ' ' << j;
+            EXPECT_TRUE(libjst::coverage_intersect_into(target, pool[i], pool[j]) == intersection) << i << ' ' << j;
+
+            target = lhs; // aliases the owning operand.
+            libjst::coverage_intersect_into(target, target, pool[j]);
+            EXPECT_TRUE(target == intersection) << i << ' ' << j;
+
+            EXPECT_TRUE(libjst::coverage_difference_into(target, lhs, pool[j]) == difference) << i << ' ' << j;
+            target = lhs;
+            libjst::coverage_difference_into(target, target, pool[j]);
+            EXPECT_TRUE(target == difference) << i << ' ' << j;
+        }
+    }
+}
+
+TEST_F(run_length_coverage_pool_test, serialise) {
+    pool_type pool_out{};
+    pool_out.insert(pool_out.end(), cov1);
+    pool_out.insert(pool_out.end(), cov2);
+    pool_out.insert(pool_out.end(), cov3);
+
+    std::stringstream buffer{};
+    { // writing to output string stream
+        cereal::JSONOutputArchive oarch{buffer};
+        pool_out.save(oarch);
+    }
+
+    pool_type pool_in{};
+    { // reading from input string stream
+        cereal::JSONInputArchive iarch{buffer};
+        pool_in.load(iarch);
+    }
+
+    ASSERT_EQ(pool_in.size(), 3u);
+    EXPECT_TRUE(pool_in.get_domain() == domain);
+    EXPECT_TRUE(pool_in[0] == cov1);
+    EXPECT_TRUE(pool_in[1] == cov2);
+    EXPECT_TRUE(pool_in[2] == cov3);
+}
@@ -6,7 +6,9 @@
 // -----------------------------------------------------------------------------------------------------
 
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/generators/catch_generators_all.hpp>
 
+#include <algorithm>
 #include <span>
 #include <string>
 #include <vector>
@@ -55,3 +57,55 @@ SCENARIO("any_sequence can be constructed for types that are convertible to std:
         }
     }
 }
+
+SCENARIO("any_sequence stores short and long sequences", "[any_sequence][storage]")  {
+    GIVEN("an any_sequence over a std::span<char const>") {
+        using any_sequence_t = libjst::any_sequence<std::span<char const>>;
+        std::string source = GENERATE(std::string{"A"}, std::string(1000, 'C'));
+
+        WHEN("initialized with a std::string") {
+            any_sequence_t seq{source};
+
+            THEN("seq does not refer to the original string") {
+                REQUIRE(std::ranges::equal(seq.value(), source));
+                REQUIRE(seq.value().data() != source.data());
+            }
+        }
+
+        WHEN("initialized with a std::vector of chars") {
+            std::vector<char> vector_source{source.begin(), source.end()};
+            any_sequence_t seq{vector_source};
+
+            THEN("seq does contain the vector") {
+                REQUIRE(std::ranges::equal(seq.value(), vector_source));
+            }
+        }
+
+        WHEN("moving the any_sequence") {
+            any_sequence_t seq{source};
+            any_sequence_t moved_seq{std::move(seq)};
+
+            THEN("the value is moved to the target") {
+                REQUIRE(moved_seq.has_value());
+                REQUIRE(std::ranges::equal(moved_seq.value(), source));
+                REQUIRE_FALSE(seq.has_value());
+            } AND_THEN("the value can be move assigned") {
+                any_sequence_t other_seq{std::string{"GT"}};
+                other_seq = std::move(moved_seq);
+                REQUIRE(std::ranges::equal(other_seq.value(), source));
+                REQUIRE_FALSE(moved_seq.has_value());
+            }
+        }
+
+        WHEN("storing many any_sequences in a growing vector") {
+            std::vector<any_sequence_t> sequences{};
+            for (int i = 0; i < 100; ++i)
+                sequences.emplace_back(source + std::to_string(i));
+
+            THEN("the values are preserved by the reallocations") {
+                for (int i = 0; i < 100; ++i)
+                    REQUIRE(std::ranges::equal(sequences[i].value(), source + std::to_string(i)));
+            }
+        }
+    }
+}
@@ -0,0 +1,164 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <random>
+#include <ranges>
+#include <span>
+#include <vector>
+
+#include <libjst/journal/balanced_sequence_journal.hpp>
+#include <libjst/sequence/journaled_sequence.hpp>
+
+SCENARIO("A balanced sequence journal can be initialized", "[journal][balanced_sequence_journal]")
+{
+    using journal_t = libjst::balanced_sequence_journal<std::vector<char>>;
+
+    GIVEN("A default initialized journal")
+    {
+        journal_t journal{};
+        THEN("The journal is empty and begin is the sentinel")
+        {
+            CHECK(journal.empty());
+            REQUIRE(journal.size() == 0u);
+            REQUIRE(journal.begin() == journal.end());
+            REQUIRE(journal.end()->position() == 0u);
+        }
+    }
+    GIVEN("A journal initialized with a source")
+    {
+        std::vector<char> source{'A', 'C', 'G', 'T', 'A', 'C', 'G', 'T'};
+        journal_t journal{source};
+        THEN("The journal holds a single record covering the source")
+        {
+            REQUIRE(journal.size() == 1u);
+            REQUIRE(journal.begin()->position() == 0u);
+            REQUIRE(std::ranges::equal(journal.begin()->sequence(), source));
+            REQUIRE(journal.end()->position() == source.size());
+            REQUIRE(std::ranges::next(journal.begin()) == journal.end());
+        }
+        AND_THEN("The journal models std::ranges::bidirectional_range")
+        {
+            REQUIRE(std::ranges::bidirectional_range<journal_t>);
+            REQUIRE(std::ranges::bidirectional_range<journal_t const>);
+        }
+    }
+}
+
+SCENARIO("Looking up records in a balanced sequence journal", "[journal][balanced_sequence_journal]")
+{
+    GIVEN("A journal with a replaced infix")
+    {
+        using journal_t = libjst::balanced_sequence_journal<std::vector<char>>;
+        using breakend_t = typename journal_t::breakend_type;
+
+        std::vector<char> replacement{'C', 'C', 'C'};
+        journal_t journal{std::vector<char>(10, 'A')};
+        auto first = journal.begin();
+        auto record_it = journal.record({breakend_t{first, std::ranges::next(first->sequence().begin(), 4)},
+                                         breakend_t{first, std::ranges::next(first->sequence().begin(), 6)}},
+                                        replacement);
+        THEN("The journal holds the prefix, the replacement and the suffix")
+        {
+            REQUIRE(journal.size() == 3u);
+            REQUIRE(record_it->position() == 4u);
+            REQUIRE(std::ranges::equal(record_it->sequence(), replacement));
+            REQUIRE(journal.end()->position() == 11u);
+        }
+        AND_THEN("The records are found by their positions")
+        {
+            REQUIRE(journal.lower_bound(0u) == journal.begin());
+            REQUIRE(journal.lower_bound(4u) == record_it);
+            REQUIRE(journal.lower_bound(5u)->position() == 7u);
+            REQUIRE(journal.upper_bound(4u)->position() == 7u);
+            REQUIRE(journal.upper_bound(11u) == journal.end());
+            REQUIRE(journal.find(5u) == record_it);
+            REQUIRE(journal.find(3u) == journal.begin());
+            REQUIRE(journal.find(11u) == journal.end());
+        }
+        AND_THEN("The records are visited in both directions")
+        {
+            std::vector<std::size_t> positions{};
+            for (auto it = journal.end(); it != journal.begin();)
+                positions.push_back((--it)->position());
+            REQUIRE(positions == std::vector<std::size_t>{7, 4, 0});
+        }
+    }
+}
+
+SCENARIO("A balanced journaled sequence records many variants", "[journal][balanced_sequence_journal]")
+{
+    GIVEN("A source sequence and random edits")
+    {
+        std::mt19937 generator{42};
+        std::vector<char> source(2000);
+        std::ranges::generate(source, [&] () { return "ACGT"[generator() % 4]; });
+        std::vector<char> alternates{'A', 'C', 'G', 'T', 'T', 'G', 'C', 'A'};
+
+        libjst::journaled_sequence inline_sequence{source};
+        libjst::balanced_journaled_sequence<std::vector<char>> balanced_sequence{source};
+        std::vector<char> expected{source};
+
+        WHEN("Replacing, inserting and erasing at random positions")
+        {
+            for (int edit = 0; edit < 2000; ++edit) {
+                std::size_t const position = generator() % (expected.size() + 1);
+                std::size_t const deletion = std::min<std::size_t>(generator() % 4, expected.size() - position);
+                std::size_t const insertion = generator() % 4;
+                std::span<char const> segment{alternates.data() + generator() % 4, insertion};
+
+                auto inline_it = inline_sequence.replace(inline_sequence.begin() + position,
+                                                         inline_sequence.begin() + (position + deletion),
+                                                         segment);
+                auto balanced_it = balanced_sequence.replace(balanced_sequence.begin() + position,
+                                                             balanced_sequence.begin() + (position + deletion),
+                                                             segment);
+                expected.erase(expected.begin() + position, expected.begin() + (position + deletion));
+                expected.insert(expected.begin() + position, segment.begin(), segment.end());
+
+                REQUIRE(inline_it - inline_sequence.begin() == balanced_it - balanced_sequence.begin());
+            }
+            THEN("The balanced journal spells the same sequence as the inline journal")
+            {
+                REQUIRE(balanced_sequence.size() == expected.size());
+                REQUIRE(std::ranges::equal(balanced_sequence, expected));
+                REQUIRE(std::ranges::equal(inline_sequence, expected));
+            }
+            AND_THEN("Random access finds the same symbols")
+            {
+                for (std::size_t position = 0; position < expected.size(); position += 7)
+                    REQUIRE(balanced_sequence.begin()[position] == expected[position]);
+                REQUIRE(balanced_sequence.begin() + expected.size() == balanced_sequence.end());
+            }
+            AND_THEN("The reversed sequence is the same")
+            {
+                REQUIRE(std::ranges::equal(balanced_sequence | std::views::reverse, expected | std::views::reverse));
+            }
+            AND_THEN("A copy is independent of the modified sequence")
+            {
+                auto copy = balanced_sequence;
+                balanced_sequence.erase(balanced_sequence.begin(), balanced_sequence.begin() + 10);
+                REQUIRE(std::ranges::equal(copy, expected));
+                REQUIRE(std::ranges::equal(balanced_sequence, expected | std::views::drop(10)));
+            }
+        }
+        WHEN("Clearing the modified sequence")
+        {
+            balanced_sequence.erase(balanced_sequence.begin() + 10, balanced_sequence.begin() + 20);
+            balanced_sequence.clear();
+            inline_sequence.erase(inline_sequence.begin() + 10, inline_sequence.begin() + 20);
+            inline_sequence.clear();
+            THEN("As for the inline journal, all edits are discarded")
+            {
+                REQUIRE(std::ranges::equal(balanced_sequence, inline_sequence));
+                REQUIRE(std::ranges::equal(balanced_sequence, source));
+            }
+        }
+    }
+}
@@ -214,3 +214,49 @@ SCENARIO("Fuzzy testing of recording variants", "[breakpoint_multijournal][fuzzy
         }
     }
 }
+
+SCENARIO("Constructing a breakpoint_multijournal from a range of records", "[breakpoint_multijournal][bulk]")
+{
+    using namespace std::string_literals;
+
+    GIVEN("A std::string source and records in arbitrary order") {
+        std::string source{"AAAACCCCGGGGTTTT"};
+        using breakpoint_t = libjst::sequence_breakpoint_t<std::string>;
+        auto to_breakpoint = [&] (size_t low, size_t high) {
+            return libjst::to_breakpoint(source, source.begin() + low, source.begin() + high);
+        };
+
+        std::vector<std::pair<breakpoint_t, std::string>> records{{to_breakpoint(8, 8), "xx"s},
+                                                                  {to_breakpoint(2, 4), ""s},
+                                                                  {to_breakpoint(12, 13), "y"s},
+                                                                  {to_breakpoint(8, 8), "xxx"s},
+                                                                  {to_breakpoint(0, 1), "z"s}};
+
+        WHEN("Constructing the journal from the records") {
+            libjst::breakpoint_multijournal bulk_journal{source, records};
+
+            THEN("it equals the journal obtained by recording the records one by one") {
+                libjst::breakpoint_multijournal journal{source};
+                for (auto && [breakpoint, sequence] : records)
+                    journal.record(breakpoint, sequence);
+
+                REQUIRE(bulk_journal.size() == journal.size());
+                for (auto bulk_it = bulk_journal.begin(), it = journal.begin(); it != journal.end(); ++it, ++bulk_it) {
+                    REQUIRE(libjst::low_breakend(*bulk_it) == libjst::low_breakend(*it));
+                    REQUIRE(libjst::high_breakend(*bulk_it) == libjst::high_breakend(*it));
+                    REQUIRE(std::ranges::equal(bulk_it->sequence(), it->sequence()));
+                }
+            } AND_THEN("the records are sorted by their breakpoints") {
+                REQUIRE(std::ranges::is_sorted(bulk_journal, std::ranges::less{}, [] (auto const & record) {
+                    return libjst::low_breakend(record);
+                }));
+            } AND_THEN("the lookup finds the records at a breakend") {
+                auto first = bulk_journal.lower_bound(libjst::low_breakend(to_breakpoint(8, 8)));
+                auto last = bulk_journal.upper_bound(libjst::low_breakend(to_breakpoint(8, 8)));
+                REQUIRE(std::ranges::distance(first, last) == 2);
+                REQUIRE(std::ranges::equal(first->sequence(), "xxx"s));
+                REQUIRE(std::ranges::equal(std::ranges::next(first)->sequence(), "xx"s));
+            }
+        }
+    }
+}
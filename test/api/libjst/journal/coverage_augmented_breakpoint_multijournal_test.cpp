@@ -11,7 +11,9 @@
 
 #include <algorithm>
 #include <random>
+#include <stdexcept>
 #include <string>
+#include <tuple>
 #include <vector>
 
 #include <libjst/journal/coverage_augmented_breakpoint_multijournal.hpp>
@@ -157,3 +159,57 @@ SCENARIO("Successfully recording various sequence modifications with their cover
     }
 }
 
+
+SCENARIO("Constructing a coverage_augmented_breakpoint_multijournal from a range of records") {
+    using namespace std::literals;
+
+    GIVEN("Unsorted records with their coverages") {
+        std::string source{"AAAACCCCGGGGTTTT"};
+        using journal_type = libjst::coverage_augmented_breakpoint_multijournal<std::string>;
+        using coverage_type = typename journal_type::coverage_type;
+        using coverage_domain_type = libjst::coverage_domain_t<coverage_type>;
+        using breakpoint_type = typename journal_type::breakpoint_type;
+
+        auto to_breakpoint = [&] (std::ptrdiff_t const low, std::ptrdiff_t const high) {
+            return libjst::to_breakpoint(source, source.begin() + low, source.begin() + high);
+        };
+        std::vector<std::tuple<breakpoint_type, std::string, coverage_type>> records{
+            {to_breakpoint(12, 13), "T"s, coverage_type{{0, 3}, coverage_domain_type{0, 4}}},
+            {to_breakpoint(0, 4), "ACGT"s, coverage_type{{1, 3}, coverage_domain_type{0, 4}}},
+            {to_breakpoint(8, 8), "ACGTACGT"s, coverage_type{{2, 3}, coverage_domain_type{0, 4}}},
+            {to_breakpoint(2, 12), ""s, coverage_type{{0}, coverage_domain_type{0, 4}}}
+        };
+
+        WHEN("I construct the journal from the records") {
+            journal_type journal{source, records};
+
+            THEN("The records should be sorted by their breakpoints together with their coverages") {
+                REQUIRE(journal.size() == records.size());
+                REQUIRE(journal.coverage_domain() == coverage_domain_type{0, 4});
+                std::vector expected_order{1, 3, 2, 0};
+                auto it = journal.begin();
+                for (int const idx : expected_order) {
+                    auto const & [breakpoint, sequence, coverage] = records[idx];
+                    REQUIRE(libjst::low_breakend(*it) == libjst::low_breakend(breakpoint));
+                    REQUIRE(std::ranges::equal((*it).sequence(), sequence));
+                    REQUIRE((*it).coverage() == coverage);
+                    ++it;
+                }
+            }
+
+            THEN("Recording further sequences should keep the coverages of the records") {
+                coverage_type coverage{{2}, coverage_domain_type{0, 4}};
+                auto it = journal.record(to_breakpoint(4, 5), "A"s, coverage);
+                REQUIRE((*it).coverage() == coverage);
+                REQUIRE((*std::ranges::prev(it)).coverage() == std::get<2>(records[3]));
+                REQUIRE((*std::ranges::next(it)).coverage() == std::get<2>(records[2]));
+            }
+
+            THEN("Recording a coverage from another domain should fail") {
+                REQUIRE_THROWS_AS(journal.record(to_breakpoint(4, 5), "A"s,
+                                                 coverage_type{{2}, coverage_domain_type{0, 8}}),
+                                  std::domain_error);
+            }
+        }
+    }
+}
@@ -0,0 +1,165 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/matcher/aho_corasick_matcher.hpp>
+#include <libjst/matcher/shift_or_matcher.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/sequence_tree/volatile_tree.hpp>
+#include <libjst/traversal/state_capture_traverser.hpp>
+#include <libjst/traversal/state_oblivious_traverser.hpp>
+
+using namespace std::literals;
+
+struct aho_corasick_matcher_test : public ::testing::Test {
+    using hit_type = std::tuple<std::size_t, uint32_t>; // the position of the last symbol and the pattern
+
+    static std::vector<hit_type> naive_hits(std::string_view const haystack,
+                                            std::vector<std::string> const & patterns) {
+        std::vector<hit_type> hits{};
+        for (uint32_t pattern = 0; pattern < patterns.size(); ++pattern) {
+            std::size_t const size = patterns[pattern].size();
+            for (std::size_t end = size; end <= haystack.size(); ++end)
+                if (haystack.substr(end - size, size) == patterns[pattern])
+                    hits.emplace_back(end - 1, pattern);
+        }
+        std::ranges::sort(hits);
+        return hits;
+    }
+
+    static std::vector<hit_type> hits(libjst::aho_corasick_matcher & matcher, std::string_view const haystack) {
+        std::vector<hit_type> positions{};
+        matcher(haystack, [&] (auto it) {
+            EXPECT_FALSE(matcher.matched_patterns().empty());
+            for (uint32_t const pattern : matcher.matched_patterns())
+                positions.emplace_back(std::ranges::distance(haystack.begin(), it), pattern);
+        });
+        std::ranges::sort(positions);
+        return positions;
+    }
+
+    static std::string haystack(std::size_t const size) {
+        std::string sequence{};
+        for (std::size_t i = 0; i < size; ++i)
+            sequence.push_back("ACGT"[(i * 7 + i / 5 + i / 11) % 4]);
+        return sequence;
+    }
+};
+
+TEST_F(aho_corasick_matcher_test, concept) {
+    EXPECT_TRUE(libjst::window_matcher<libjst::aho_corasick_matcher>);
+    EXPECT_TRUE(libjst::state_capturing_matcher<libjst::aho_corasick_matcher>);
+    EXPECT_TRUE((std::same_as<libjst::matcher_state_t<libjst::aho_corasick_matcher>, uint32_t>));
+}
+
+TEST_F(aho_corasick_matcher_test, construct) {
+    libjst::aho_corasick_matcher const matcher{std::vector{"ACGT"s, "ACGA"s, "TTTT"s}};
+    EXPECT_EQ(matcher.window_size(), 4u);
+    EXPECT_EQ(matcher.pattern_count(), 3u);
+    EXPECT_EQ(matcher.node_count(), 10u);
+    EXPECT_GT(matcher.memory_usage(), 0u);
+
+    EXPECT_EQ(libjst::aho_corasick_matcher{std::vector<std::string>{}}.window_size(), 0u);
+    EXPECT_THROW((libjst::aho_corasick_matcher{std::vector{"ACGT"s, "ACG"s}}), std::invalid_argument);
+}
+
+TEST_F(aho_corasick_matcher_test, search) {
+    std::string const sequence = haystack(600);
+    for (std::size_t const length : {1, 5, 20, 23, 70}) {
+        std::vector<std::string> patterns{};
+        for (std::size_t begin = 0; begin + length <= sequence.size(); begin += 37)
+            patterns.push_back(sequence.substr(begin, length));
+        patterns.push_back(patterns.front()); // a duplicate is reported with both indices
+        patterns.push_back(std::string(length, 'N')); // a symbol not in the haystack
+        patterns.back().front() = 'A';
+
+        libjst::aho_corasick_matcher matcher{patterns};
+        EXPECT_EQ(hits(matcher, sequence), naive_hits(sequence, patterns)) << length;
+    }
+}
+
+TEST_F(aho_corasick_matcher_test, unrelated_symbols) {
+    std::vector<std::string> const patterns{"ACA"s, "CAC"s, "AAA"s};
+    std::string const sequence = "ACACxACAAAAyCAC"s;
+    libjst::aho_corasick_matcher matcher{patterns};
+    EXPECT_EQ(hits(matcher, sequence), naive_hits(sequence, patterns));
+}
+
+TEST_F(aho_corasick_matcher_test, capture_and_restore) {
+    std::string const sequence = haystack(200);
+    std::vector<std::string> const patterns{sequence.substr(90, 20), sequence.substr(95, 20), sequence.substr(3, 20)};
+    libjst::aho_corasick_matcher matcher{patterns};
+
+    std::size_t count{};
+    auto count_hits = [&] (auto &&) { count += matcher.matched_patterns().size(); };
+    matcher(std::string_view{sequence}.substr(0, 100), count_hits);
+    auto state = matcher.capture();
+    std::size_t const before_branch = count;
+    matcher(std::string(50, 'N'), count_hits); // a diverging branch
+    EXPECT_EQ(count, before_branch);
+
+    matcher.restore(state);
+    matcher(std::string_view{sequence}.substr(100), count_hits);
+    EXPECT_EQ(count, naive_hits(sequence, patterns).size());
+
+    matcher.reset();
+    EXPECT_TRUE(matcher.matched_patterns().empty());
+}
+
+TEST_F(aho_corasick_matcher_test, traversers) {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using cms_t = libjst::dna_compressed_multisequence<std::string, coverage_type>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+    using rcs_store_t = libjst::rcs_store<std::string, cms_t>;
+
+    //                      0123456789012345
+    rcs_store_t store{"AAAAGGGGAAAAGGGG"s, 4};
+    auto domain = store.variants().coverage_domain();
+    store.add(cms_value_t{libjst::breakpoint{1, 1}, "G"s, coverage_type{{0, 1}, domain}});
+    store.add(cms_value_t{libjst::breakpoint{6, 1}, "A"s, coverage_type{{0, 2}, domain}});
+    store.add(cms_value_t{libjst::breakpoint{11, 1}, "G"s, coverage_type{{3}, domain}});
+
+    std::vector<std::string> const patterns{"GAGA"s, "AAGG"s, "GGAA"s, "AGAA"s};
+    auto count_single = [&] (auto traverser) {
+        std::vector<std::size_t> counts{};
+        for (std::string const & pattern : patterns) {
+            std::size_t count{};
+            traverser(libjst::volatile_tree{store}, libjst::shift_or_matcher{pattern},
+                      [&] (auto &&, auto && label) { count += label.coverage().size(); });
+            counts.push_back(count);
+        }
+        return counts;
+    };
+    auto count_all = [&] (auto traverser) {
+        std::vector<std::size_t> counts(patterns.size());
+        libjst::aho_corasick_matcher matcher{patterns};
+        // The traversers take the matcher by reference, such that the callback can query the matched patterns.
+        traverser(libjst::volatile_tree{store}, matcher, [&] (auto &&, auto && label) {
+            for (uint32_t const pattern : matcher.matched_patterns())
+                counts[pattern] += label.coverage().size();
+        });
+        return counts;
+    };
+
+    std::vector<std::size_t> const expected = count_single(libjst::state_oblivious_traverser{});
+    EXPECT_TRUE(std::ranges::all_of(expected, [] (std::size_t count) { return count > 0; }));
+    EXPECT_EQ(count_all(libjst::state_oblivious_traverser{}), expected);
+    EXPECT_EQ(count_all(libjst::state_capture_traverser{}), count_single(libjst::state_capture_traverser{}));
+}
@@ -0,0 +1,229 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <ranges>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/matcher/blocked_myers_matcher.hpp>
+#include <libjst/matcher/myers_matcher.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/sequence_tree/volatile_tree.hpp>
+#include <libjst/traversal/state_capture_traverser.hpp>
+
+using namespace std::literals;
+using libjst::detail::bit_kernel_target;
+
+struct blocked_myers_matcher_test : public ::testing::TestWithParam<bit_kernel_target> {
+    using hits_type = std::vector<std::pair<std::size_t, std::size_t>>;
+
+    void SetUp() override {
+        if (!libjst::detail::supports_bit_kernel_target(GetParam()))
+            GTEST_SKIP() << "The target is not supported by this CPU.";
+    }
+
+    libjst::blocked_myers_matcher make_matcher(std::string const & needle, std::size_t const max_errors) const {
+        return libjst::blocked_myers_matcher{needle, max_errors, GetParam()};
+    }
+
+    // Returns the end positions and edit distances of the best occurrences of the needle within the error bound.
+    static hits_type naive_hits(std::string const & haystack, std::string const & needle, std::size_t const max_errors) {
+        std::vector<std::size_t> column(needle.size() + 1);
+        std::iota(column.begin(), column.end(), 0);
+        hits_type hits{};
+        for (std::size_t end = 0; end < haystack.size(); ++end) {
+            std::size_t diagonal = column[0]; // the first row is zero
+            for (std::size_t i = 1; i <= needle.size(); ++i) {
+                std::size_t const score = std::min({diagonal + (needle[i - 1] != haystack[end]),
+                                                    column[i] + 1,
+                                                    column[i - 1] + 1});
+                diagonal = std::exchange(column[i], score);
+            }
+            if (column.back() <= max_errors)
+                hits.emplace_back(end, column.back());
+        }
+        return hits;
+    }
+
+    static hits_type hits(libjst::blocked_myers_matcher & matcher, std::string const & haystack) {
+        hits_type positions{};
+        matcher(haystack, [&] (auto it) {
+            positions.emplace_back(std::ranges::distance(haystack.begin(), it), matcher.score());
+        });
+        return positions;
+    }
+
+    static std::string random_sequence(std::size_t const size, unsigned const seed) {
+        std::mt19937 generator{seed};
+        std::string sequence{};
+        for (std::size_t i = 0; i < size; ++i)
+            sequence.push_back("ACGT"[generator() % 4]);
+        return sequence;
+    }
+
+    // Applies some substitutions, insertions and deletions to the sequence.
+    static std::string mutate(std::string sequence, std::size_t const edits, unsigned const seed) {
+        std::mt19937 generator{seed};
+        for (std::size_t i = 0; i < edits; ++i) {
+            std::size_t const position = generator() % sequence.size();
+            switch (generator() % 3) {
+                case 0: sequence[position] = "ACGT"[(generator() % 3 + 1 + sequence[position]) % 4]; break;
+                case 1: sequence.insert(position, 1, "ACGT"[generator() % 4]); break;
+                default: sequence.erase(position, 1);
+            }
+        }
+        return sequence;
+    }
+};
+
+TEST_P(blocked_myers_matcher_test, concept) {
+    EXPECT_TRUE(libjst::window_matcher<libjst::blocked_myers_matcher>);
+    EXPECT_TRUE(libjst::state_capturing_matcher<libjst::blocked_myers_matcher>);
+    EXPECT_TRUE((std::same_as<libjst::matcher_state_t<libjst::blocked_myers_matcher>, std::vector<uint64_t>>));
+}
+
+TEST_P(blocked_myers_matcher_test, construct) {
+    libjst::blocked_myers_matcher matcher = make_matcher(std::string(150, 'A'), 5);
+    EXPECT_EQ(matcher.window_size(), 155u);
+    EXPECT_EQ(matcher.max_errors(), 5u);
+    EXPECT_EQ(matcher.active_blocks(), 1u);
+    EXPECT_EQ(make_matcher(std::string(150, 'A'), 70).active_blocks(), 2u);
+    EXPECT_EQ(make_matcher(std::string(150, 'A'), 200).active_blocks(), 3u);
+    EXPECT_EQ(libjst::blocked_myers_matcher{}.window_size(), 0u);
+}
+
+TEST_P(blocked_myers_matcher_test, search) {
+    std::string const reference = random_sequence(2000, 42);
+    for (std::size_t const length : {20, 64, 65, 128, 150, 300, 600}) {
+        for (std::size_t const begin : {0, 333, 1000}) {
+            std::string const needle = mutate(reference.substr(begin, length), 3, static_cast<unsigned>(length + begin));
+            for (std::size_t const max_errors : {0, 2, 5, 70}) {
+                libjst::blocked_myers_matcher matcher = make_matcher(needle, max_errors);
+                EXPECT_EQ(hits(matcher, reference), naive_hits(reference, needle, max_errors))
+                    << length << " " << begin << " " << max_errors;
+            }
+        }
+    }
+}
+
+TEST_P(blocked_myers_matcher_test, short_patterns_equal_myers_matcher) {
+    std::string const reference = random_sequence(1000, 7);
+    for (std::size_t const length : {1, 10, 64}) {
+        std::string const needle = reference.substr(500, length);
+        libjst::blocked_myers_matcher matcher = make_matcher(needle, 2);
+        libjst::myers_matcher expected{needle, 2};
+        hits_type expected_hits{};
+        expected(reference, [&] (auto it) {
+            expected_hits.emplace_back(std::ranges::distance(reference.begin(), it), expected.score());
+        });
+        EXPECT_EQ(hits(matcher, reference), expected_hits) << length;
+    }
+}
+
+TEST_P(blocked_myers_matcher_test, capture_and_restore) {
+    std::string const reference = random_sequence(1000, 13);
+    std::string const needle = mutate(reference.substr(400, 150), 4, 1);
+    libjst::blocked_myers_matcher matcher = make_matcher(needle, 6);
+
+    std::size_t count{};
+    auto count_hits = [&] (auto &&) { ++count; };
+    matcher(std::string_view{reference}.substr(0, 500), count_hits);
+    auto state = matcher.capture();
+    EXPECT_EQ(state.size(), 1 + 3 * matcher.active_blocks());
+    matcher(random_sequence(300, 99), count_hits); // a diverging branch
+    count = 0;
+
+    matcher.restore(state);
+    matcher(std::string_view{reference}.substr(500), count_hits);
+    hits_type const expected = naive_hits(reference, needle, 6);
+    EXPECT_EQ(count, static_cast<std::size_t>(std::ranges::count_if(expected, [] (auto const & hit) {
+        return hit.first >= 500;
+    })));
+    EXPECT_GT(count, 0u);
+}
+
+TEST_P(blocked_myers_matcher_test, state_capture_traverser) {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using cms_t = libjst::dna_compressed_multisequence<std::string, coverage_type>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+    using rcs_store_t = libjst::rcs_store<std::string, cms_t>;
+
+    std::string const reference = random_sequence(600, 5);
+    rcs_store_t store{reference, 4};
+    auto domain = store.variants().coverage_domain();
+    for (std::size_t position : {100, 180, 230, 290, 420}) {
+        std::string alt{"ACGT"[(reference[position] + 1) % 4]};
+        store.add(cms_value_t{libjst::breakpoint{static_cast<uint32_t>(position), 1}, alt,
+                              coverage_type{{static_cast<uint32_t>(position % 4)}, domain}});
+    }
+
+    for (std::size_t const max_errors : {0, 3, 8}) {
+        std::string const needle = reference.substr(150, 150);
+        std::size_t expected{};
+        libjst::state_capture_traverser{}(libjst::volatile_tree{store},
+                                          libjst::blocked_myers_matcher{needle, max_errors,
+                                                                        bit_kernel_target::scalar},
+                                          [&] (auto &&, auto &&) { ++expected; });
+        std::size_t actual{};
+        libjst::state_capture_traverser{}(libjst::volatile_tree{store}, make_matcher(needle, max_errors),
+                                          [&] (auto &&, auto &&) { ++actual; });
+        EXPECT_EQ(actual, expected) << max_errors;
+        if (max_errors >= 3) {
+            EXPECT_GT(actual, 0u) << max_errors;
+        }
+    }
+}
+
+TEST_P(blocked_myers_matcher_test, column_kernel) {
+    libjst::detail::myers_kernels const kernels = libjst::detail::select_myers_kernels(GetParam());
+    ASSERT_EQ(kernels.target, GetParam());
+
+    std::mt19937_64 generator{42};
+    for (std::size_t const count : {1, 3, 4, 5, 7, 8, 9, 16, 17, 33}) {
+        std::vector<uint64_t> eq(count);
+        std::vector<uint64_t> vp(count);
+        std::vector<uint64_t> vn(count);
+        std::vector<uint64_t> rows(count);
+        std::vector<uint64_t> scores(count, 100);
+        for (std::size_t i = 0; i < count; ++i) {
+            eq[i] = generator();
+            vp[i] = (i % 3 == 0) ? ~uint64_t{0} : generator(); // long carry chains
+            vn[i] = generator() & ~vp[i];
+            rows[i] = uint64_t{1} << (generator() % 64);
+        }
+
+        std::vector<uint64_t> expected_vp{vp};
+        std::vector<uint64_t> expected_vn{vn};
+        std::vector<uint64_t> expected_scores{scores};
+        libjst::detail::scalar_myers_kernels.column(expected_vp.data(), expected_vn.data(), expected_scores.data(),
+                                                    eq.data(), rows.data(), count);
+        kernels.column(vp.data(), vn.data(), scores.data(), eq.data(), rows.data(), count);
+        EXPECT_EQ(vp, expected_vp) << count;
+        EXPECT_EQ(vn, expected_vn) << count;
+        EXPECT_EQ(scores, expected_scores) << count;
+    }
+}
+
+TEST(myers_kernels_dispatch, active_kernels) {
+    libjst::detail::myers_kernels const & active = libjst::detail::active_myers_kernels();
+    EXPECT_TRUE(libjst::detail::supports_bit_kernel_target(active.target));
+    EXPECT_EQ(&active, &libjst::detail::active_myers_kernels());
+}
+
+INSTANTIATE_TEST_SUITE_P(targets, blocked_myers_matcher_test, testing::Values(bit_kernel_target::scalar,
+                                                                              bit_kernel_target::avx2,
+                                                                              bit_kernel_target::avx512));
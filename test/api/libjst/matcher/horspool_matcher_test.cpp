@@ -0,0 +1,96 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <ranges>
+#include <string>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/matcher/horspool_matcher.hpp>
+#include <libjst/matcher/shift_or_matcher.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/sequence_tree/volatile_tree.hpp>
+#include <libjst/traversal/state_oblivious_traverser.hpp>
+
+using namespace std::literals;
+
+struct horspool_matcher_test : public ::testing::Test {
+    // Returns the positions of the last symbols of all occurrences of the needle.
+    static std::vector<std::size_t> naive_hits(std::string const & haystack, std::string const & needle) {
+        std::vector<std::size_t> hits{};
+        for (std::size_t end = needle.size(); end <= haystack.size(); ++end)
+            if (haystack.compare(end - needle.size(), needle.size(), needle) == 0)
+                hits.push_back(end - 1);
+        return hits;
+    }
+
+    static std::vector<std::size_t> hits(libjst::horspool_matcher const & matcher, std::string const & haystack) {
+        std::vector<std::size_t> positions{};
+        matcher(haystack, [&] (auto it) { positions.push_back(std::ranges::distance(haystack.begin(), it)); });
+        return positions;
+    }
+
+    static std::string haystack(std::size_t const size) {
+        std::string sequence{};
+        for (std::size_t i = 0; i < size; ++i)
+            sequence.push_back("ACGT"[(i * 7 + i / 5 + i / 11) % 4]);
+        return sequence;
+    }
+};
+
+TEST_F(horspool_matcher_test, concept) {
+    EXPECT_TRUE(libjst::window_matcher<libjst::horspool_matcher>);
+    EXPECT_FALSE(libjst::state_capturing_matcher<libjst::horspool_matcher>);
+}
+
+TEST_F(horspool_matcher_test, construct) {
+    EXPECT_EQ(libjst::horspool_matcher{"ACGT"s}.window_size(), 4u);
+    EXPECT_EQ(libjst::horspool_matcher{std::string(200, 'A')}.window_size(), 200u);
+    EXPECT_EQ(libjst::horspool_matcher{}.window_size(), 0u);
+}
+
+TEST_F(horspool_matcher_test, search) {
+    std::string const sequence = haystack(1000);
+    for (std::size_t const length : {1, 2, 7, 64, 150}) {
+        for (std::size_t const begin : {0, 17, 500, 1000 - 150}) {
+            std::string const needle = sequence.substr(begin, length);
+            EXPECT_EQ(hits(libjst::horspool_matcher{needle}, sequence), naive_hits(sequence, needle)) << needle;
+        }
+    }
+
+    EXPECT_EQ(hits(libjst::horspool_matcher{"AAA"s}, "AAAAA"s), (std::vector<std::size_t>{2, 3, 4}));
+    EXPECT_TRUE(hits(libjst::horspool_matcher{"ACGTACGT"s}, "ACGT"s).empty());
+}
+
+TEST_F(horspool_matcher_test, state_oblivious_traverser) {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using cms_t = libjst::dna_compressed_multisequence<std::string, coverage_type>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+    using rcs_store_t = libjst::rcs_store<std::string, cms_t>;
+
+    //                      0123456789012345
+    rcs_store_t store{"AAAAGGGGAAAAGGGG"s, 4};
+    auto domain = store.variants().coverage_domain();
+    store.add(cms_value_t{libjst::breakpoint{1, 1}, "G"s, coverage_type{{0, 1}, domain}});
+    store.add(cms_value_t{libjst::breakpoint{6, 1}, "A"s, coverage_type{{0, 2}, domain}});
+    store.add(cms_value_t{libjst::breakpoint{11, 1}, "G"s, coverage_type{{3}, domain}});
+
+    for (std::string const & needle : {"AG"s, "GAGA"s, "AAGG"s, "GAAGGAG"s}) {
+        std::size_t expected{};
+        libjst::state_oblivious_traverser{}(libjst::volatile_tree{store}, libjst::shift_or_matcher{needle},
+                                            [&] (auto &&, auto &&) { ++expected; });
+        std::size_t actual{};
+        libjst::state_oblivious_traverser{}(libjst::volatile_tree{store}, libjst::horspool_matcher{needle},
+                                            [&] (auto &&, auto &&) { ++actual; });
+        EXPECT_EQ(actual, expected) << needle;
+        EXPECT_GT(actual, 0u) << needle;
+    }
+}
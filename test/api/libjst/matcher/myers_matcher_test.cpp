@@ -0,0 +1,180 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <ranges>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/matcher/myers_matcher.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/sequence_tree/volatile_tree.hpp>
+#include <libjst/traversal/state_capture_traverser.hpp>
+
+using namespace std::literals;
+
+// Returns the edit distance of the best occurrence of the needle ending at every position of the haystack.
+static std::vector<std::size_t> naive_scores(std::string_view haystack, std::string_view needle) {
+    std::vector<std::size_t> column(needle.size() + 1);
+    std::iota(column.begin(), column.end(), 0);
+    std::vector<std::size_t> scores{};
+    for (char const symbol : haystack) {
+        std::size_t diagonal = column[0]; // the first row is zero
+        for (std::size_t i = 1; i <= needle.size(); ++i) {
+            std::size_t const score = std::min({diagonal + (needle[i - 1] != symbol), column[i] + 1, column[i - 1] + 1});
+            diagonal = std::exchange(column[i], score);
+        }
+        scores.push_back(column.back());
+    }
+    return scores;
+}
+
+// Recomputes the scores of the last window of the path to find the hits spanning several labels.
+struct window_matcher {
+    std::string needle{};
+    std::size_t max_errors{};
+    std::string window{};
+
+    constexpr std::size_t window_size() const noexcept {
+        return needle.size() + max_errors;
+    }
+
+    template <typename haystack_t, typename callback_t>
+    constexpr void operator()(haystack_t && haystack, callback_t && callback) {
+        for (auto it = std::ranges::begin(haystack); it != std::ranges::end(haystack); ++it) {
+            window.push_back(*it);
+            if (window.size() > window_size())
+                window.erase(window.begin());
+            if (naive_scores(window, needle).back() <= max_errors)
+                callback(it);
+        }
+    }
+
+    std::string capture() const {
+        return window;
+    }
+
+    void restore(std::string state) {
+        window = std::move(state);
+    }
+};
+
+struct myers_matcher_test : public ::testing::Test {
+    static std::vector<std::pair<std::size_t, std::size_t>> naive_hits(std::string const & haystack,
+                                                                       std::string const & needle,
+                                                                       std::size_t const max_errors) {
+        std::vector<std::pair<std::size_t, std::size_t>> hits{};
+        std::vector<std::size_t> const scores = naive_scores(haystack, needle);
+        for (std::size_t end = 0; end < scores.size(); ++end)
+            if (scores[end] <= max_errors)
+                hits.emplace_back(end, scores[end]);
+        return hits;
+    }
+
+    static std::vector<std::pair<std::size_t, std::size_t>> hits(libjst::myers_matcher & matcher,
+                                                                 std::string const & haystack) {
+        std::vector<std::pair<std::size_t, std::size_t>> positions{};
+        matcher(haystack, [&] (auto it) {
+            positions.emplace_back(std::ranges::distance(haystack.begin(), it), matcher.score());
+        });
+        return positions;
+    }
+
+    static std::string haystack(std::size_t const size) {
+        std::string sequence{};
+        for (std::size_t i = 0; i < size; ++i)
+            sequence.push_back("ACGT"[(i * 7 + i / 5 + i / 11) % 4]);
+        return sequence;
+    }
+};
+
+TEST_F(myers_matcher_test, concept) {
+    EXPECT_TRUE(libjst::window_matcher<libjst::myers_matcher>);
+    EXPECT_TRUE(libjst::state_capturing_matcher<libjst::myers_matcher>);
+    EXPECT_TRUE((std::same_as<libjst::matcher_state_t<libjst::myers_matcher>, libjst::myers_matcher::state_type>));
+    EXPECT_TRUE(std::is_trivially_copyable_v<libjst::myers_matcher::state_type>);
+}
+
+TEST_F(myers_matcher_test, construct) {
+    libjst::myers_matcher matcher{"ACGT"s, 2};
+    EXPECT_EQ(matcher.window_size(), 6u);
+    EXPECT_EQ(matcher.max_errors(), 2u);
+    EXPECT_EQ(matcher.score(), 4u);
+    EXPECT_EQ((libjst::myers_matcher{std::string(64, 'A'), 0}.window_size()), 64u);
+    EXPECT_THROW((libjst::myers_matcher{std::string(65, 'A'), 1}), std::length_error);
+}
+
+TEST_F(myers_matcher_test, search) {
+    std::string sequence = haystack(500);
+    sequence[40] = 'T';
+    sequence.insert(260, "GG");
+    for (std::size_t const length : {1, 5, 12, 33, 64}) {
+        for (std::size_t const begin : {0, 30, 250, 400}) {
+            std::string const needle = sequence.substr(begin, length);
+            for (std::size_t const max_errors : {0, 1, 3}) {
+                libjst::myers_matcher matcher{needle, max_errors};
+                EXPECT_EQ(hits(matcher, sequence), naive_hits(sequence, needle, max_errors)) << needle;
+            }
+        }
+    }
+}
+
+TEST_F(myers_matcher_test, capture_and_restore) {
+    std::string const sequence = haystack(200);
+    std::string const needle = sequence.substr(90, 20);
+    libjst::myers_matcher matcher{needle, 2};
+
+    std::size_t count{};
+    auto count_hits = [&] (auto &&) { ++count; };
+    matcher(std::string_view{sequence}.substr(0, 100), count_hits);
+    auto state = matcher.capture();
+    std::size_t const prefix_count = count;
+    matcher(std::string(50, 'N'), count_hits); // a diverging branch
+    EXPECT_EQ(count, prefix_count);
+
+    matcher.restore(state);
+    matcher(std::string_view{sequence}.substr(100), count_hits);
+    EXPECT_EQ(count, naive_hits(sequence, needle, 2).size());
+
+    matcher.reset();
+    EXPECT_EQ(matcher.score(), needle.size());
+}
+
+TEST_F(myers_matcher_test, state_capture_traverser) {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using cms_t = libjst::dna_compressed_multisequence<std::string, coverage_type>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+    using rcs_store_t = libjst::rcs_store<std::string, cms_t>;
+
+    //                      01234567890123456789
+    rcs_store_t store{"AAAACCCCGGGGTTTTACGT"s, 4};
+    auto domain = store.variants().coverage_domain();
+    store.add(cms_value_t{libjst::breakpoint{2, 1}, "G"s, coverage_type{{0, 1}, domain}});
+    store.add(cms_value_t{libjst::breakpoint{9, 1}, "C"s, coverage_type{{0, 2}, domain}});
+    store.add(cms_value_t{libjst::breakpoint{14, 1}, "A"s, coverage_type{{3}, domain}});
+
+    for (std::string const & needle : {"ACCC"s, "CCGG"s, "GTTA"s, "CCCCGGGG"s}) {
+        for (std::size_t const max_errors : {0, 1, 2}) {
+            std::size_t expected{};
+            libjst::state_capture_traverser{}(libjst::volatile_tree{store}, window_matcher{needle, max_errors},
+                                              [&] (auto &&, auto &&) { ++expected; });
+            std::size_t actual{};
+            libjst::state_capture_traverser{}(libjst::volatile_tree{store}, libjst::myers_matcher{needle, max_errors},
+                                              [&] (auto &&, auto &&) { ++actual; });
+            EXPECT_EQ(actual, expected) << needle << " " << max_errors;
+            EXPECT_GT(actual, 0u) << needle << " " << max_errors;
+        }
+    }
+}
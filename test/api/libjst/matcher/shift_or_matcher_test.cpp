@@ -0,0 +1,217 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <ranges>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/matcher/shift_or_matcher.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/sequence/packed_dna_sequence.hpp>
+#include <libjst/sequence_tree/volatile_tree.hpp>
+#include <libjst/traversal/state_capture_traverser.hpp>
+#include <libjst/traversal/state_oblivious_traverser.hpp>
+
+using namespace std::literals;
+
+// Compares the needle with every window of the label.
+struct naive_matcher {
+    std::string needle{};
+
+    constexpr std::size_t window_size() const noexcept {
+        return needle.size();
+    }
+
+    template <typename haystack_t, typename callback_t>
+    constexpr void operator()(haystack_t && haystack, callback_t && callback) const {
+        auto it = std::ranges::begin(haystack);
+        for (; std::ranges::distance(it, std::ranges::end(haystack)) >= std::ranges::ssize(needle); ++it) {
+            auto last = std::ranges::next(it, needle.size() - 1);
+            if (std::ranges::equal(std::ranges::subrange{it, std::ranges::next(last)}, needle))
+                callback(last);
+        }
+    }
+};
+
+// Remembers the last symbols of the path to find the needles spanning several labels.
+struct window_matcher {
+    std::string needle{};
+    std::string window{};
+
+    constexpr std::size_t window_size() const noexcept {
+        return needle.size();
+    }
+
+    template <typename haystack_t, typename callback_t>
+    constexpr void operator()(haystack_t && haystack, callback_t && callback) {
+        for (auto it = std::ranges::begin(haystack); it != std::ranges::end(haystack); ++it) {
+            window.push_back(*it);
+            if (window.size() > needle.size())
+                window.erase(window.begin());
+            if (window == needle)
+                callback(it);
+        }
+    }
+
+    std::string capture() const {
+        return window;
+    }
+
+    void restore(std::string state) {
+        window = std::move(state);
+    }
+};
+
+struct shift_or_matcher_test : public ::testing::Test {
+    // Returns the positions of the last symbols of all occurrences of the needle.
+    static std::vector<std::size_t> naive_hits(std::string const & haystack, std::string const & needle) {
+        std::vector<std::size_t> hits{};
+        for (std::size_t end = needle.size(); end <= haystack.size(); ++end)
+            if (haystack.compare(end - needle.size(), needle.size(), needle) == 0)
+                hits.push_back(end - 1);
+        return hits;
+    }
+
+    static std::vector<std::size_t> hits(libjst::shift_or_matcher & matcher, std::string const & haystack) {
+        std::vector<std::size_t> positions{};
+        matcher(haystack, [&] (auto it) { positions.push_back(std::ranges::distance(haystack.begin(), it)); });
+        return positions;
+    }
+
+    static std::string haystack(std::size_t const size) {
+        std::string sequence{};
+        for (std::size_t i = 0; i < size; ++i)
+            sequence.push_back("ACGT"[(i * 7 + i / 5 + i / 11) % 4]);
+        return sequence;
+    }
+};
+
+TEST_F(shift_or_matcher_test, concept) {
+    EXPECT_TRUE(libjst::window_matcher<libjst::shift_or_matcher>);
+    EXPECT_TRUE(libjst::state_capturing_matcher<libjst::shift_or_matcher>);
+    EXPECT_TRUE((libjst::packed_matcher<libjst::shift_or_matcher, libjst::packed_dna_sequence>));
+    EXPECT_TRUE((std::same_as<libjst::matcher_state_t<libjst::shift_or_matcher>, uint64_t>));
+}
+
+TEST_F(shift_or_matcher_test, construct) {
+    EXPECT_EQ(libjst::shift_or_matcher{"ACGT"s}.window_size(), 4u);
+    EXPECT_EQ(libjst::shift_or_matcher{std::string(64, 'A')}.window_size(), 64u);
+    EXPECT_THROW(libjst::shift_or_matcher{std::string(65, 'A')}, std::length_error);
+}
+
+TEST_F(shift_or_matcher_test, search) {
+    std::string const sequence = haystack(500);
+    for (std::size_t const length : {1, 3, 8, 31, 64}) {
+        for (std::size_t const begin : {0, 17, 250, 500 - 64}) {
+            std::string const needle = sequence.substr(begin, length);
+            libjst::shift_or_matcher matcher{needle};
+            EXPECT_EQ(hits(matcher, sequence), naive_hits(sequence, needle)) << needle;
+        }
+    }
+}
+
+TEST_F(shift_or_matcher_test, search_packed) {
+    std::string sequence = haystack(300);
+    sequence.replace(100, 3, "NNN");
+    sequence[200] = 'a';
+    libjst::packed_dna_sequence const packed{sequence};
+
+    for (std::size_t const length : {1, 4, 33, 64}) {
+        for (std::size_t const begin : {0, 90, 150, 300 - 64}) {
+            std::string needle = sequence.substr(begin, length);
+            std::ranges::replace(needle, 'N', 'A');
+            std::ranges::replace(needle, 'a', 'A');
+            libjst::shift_or_matcher matcher{needle};
+            std::vector<std::size_t> positions{};
+            matcher(packed, [&] (std::size_t const position) { positions.push_back(position); });
+            EXPECT_EQ(positions, naive_hits(sequence, needle)) << needle;
+        }
+    }
+}
+
+TEST_F(shift_or_matcher_test, capture_and_restore) {
+    std::string const sequence = haystack(200);
+    std::string const needle = sequence.substr(90, 20);
+    libjst::shift_or_matcher matcher{needle};
+
+    std::size_t count{};
+    auto count_hits = [&] (auto &&) { ++count; };
+    matcher(std::string_view{sequence}.substr(0, 100), count_hits);
+    auto state = matcher.capture();
+    matcher(std::string(50, 'N'), count_hits); // a diverging branch
+    EXPECT_EQ(count, 0u);
+
+    matcher.restore(state);
+    matcher(std::string_view{sequence}.substr(100), count_hits);
+    EXPECT_EQ(count, naive_hits(sequence, needle).size());
+}
+
+TEST_F(shift_or_matcher_test, search_lanes) {
+    std::string const sequence = haystack(300);
+    std::string const needle = sequence.substr(120, 6);
+    std::vector<std::string_view> haystacks{};
+    for (std::size_t lane = 0; lane < 11; ++lane) // more lanes than one block
+        haystacks.push_back(std::string_view{sequence}.substr(lane * 23, lane * 7));
+
+    libjst::shift_or_matcher matcher{needle};
+    std::vector<uint64_t> states(haystacks.size(), matcher.capture());
+    std::vector<std::vector<std::size_t>> lane_hits(haystacks.size());
+    matcher.search_lanes(std::span{states}, haystacks, [&] (std::size_t const lane, auto it) {
+        lane_hits[lane].push_back(std::ranges::distance(haystacks[lane].begin(), it));
+    });
+
+    for (std::size_t lane = 0; lane < haystacks.size(); ++lane) {
+        libjst::shift_or_matcher expected{needle};
+        std::vector<std::size_t> expected_hits{};
+        expected(haystacks[lane], [&] (auto it) {
+            expected_hits.push_back(std::ranges::distance(haystacks[lane].begin(), it));
+        });
+        EXPECT_EQ(lane_hits[lane], expected_hits) << lane;
+        EXPECT_EQ(states[lane], expected.capture()) << lane;
+    }
+}
+
+TEST_F(shift_or_matcher_test, traversers) {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using cms_t = libjst::dna_compressed_multisequence<std::string, coverage_type>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+    using rcs_store_t = libjst::rcs_store<std::string, cms_t>;
+
+    //                      0123456789012345
+    rcs_store_t store{"AAAAGGGGAAAAGGGG"s, 4};
+    auto domain = store.variants().coverage_domain();
+    store.add(cms_value_t{libjst::breakpoint{1, 1}, "G"s, coverage_type{{0, 1}, domain}});
+    store.add(cms_value_t{libjst::breakpoint{6, 1}, "A"s, coverage_type{{0, 2}, domain}});
+    store.add(cms_value_t{libjst::breakpoint{11, 1}, "G"s, coverage_type{{3}, domain}});
+
+    for (std::string const & needle : {"AG"s, "GAGA"s, "AAGG"s, "GAAGGAG"s}) {
+        std::size_t expected{};
+        libjst::state_oblivious_traverser{}(libjst::volatile_tree{store}, naive_matcher{needle},
+                                            [&] (auto &&, auto &&) { ++expected; });
+        std::size_t actual{};
+        libjst::state_oblivious_traverser{}(libjst::volatile_tree{store}, libjst::shift_or_matcher{needle},
+                                            [&] (auto &&, auto &&) { ++actual; });
+        EXPECT_EQ(actual, expected) << needle;
+        EXPECT_GT(actual, 0u) << needle;
+
+        std::size_t expected_captured{};
+        libjst::state_capture_traverser{}(libjst::volatile_tree{store}, window_matcher{needle},
+                                          [&] (auto &&, auto &&) { ++expected_captured; });
+        std::size_t actual_captured{};
+        libjst::state_capture_traverser{}(libjst::volatile_tree{store}, libjst::shift_or_matcher{needle},
+                                          [&] (auto &&, auto &&) { ++actual_captured; });
+        EXPECT_EQ(actual_captured, expected_captured) << needle;
+    }
+}
@@ -0,0 +1,85 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/matcher/shift_or_matcher.hpp>
+#include <libjst/matcher/static_window_matcher.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/sequence_tree/volatile_tree.hpp>
+#include <libjst/traversal/distinct_context_traverser.hpp>
+#include <libjst/traversal/state_oblivious_traverser.hpp>
+
+using namespace std::literals;
+
+template <std::size_t window_size_v>
+using static_shift_or_matcher = libjst::static_window_matcher<libjst::shift_or_matcher, window_size_v>;
+
+TEST(static_window_matcher, concept) {
+    EXPECT_TRUE(libjst::window_matcher<static_shift_or_matcher<4>>);
+    EXPECT_TRUE(libjst::state_capturing_matcher<static_shift_or_matcher<4>>);
+    EXPECT_EQ(libjst::static_window_size_v<static_shift_or_matcher<4>>, 4u);
+    EXPECT_EQ(libjst::static_window_size_v<static_shift_or_matcher<4> const &>, 4u);
+    EXPECT_EQ(libjst::static_window_size_v<libjst::shift_or_matcher>, 0u);
+}
+
+TEST(static_window_matcher, construct) {
+    static_shift_or_matcher<4> matcher{"ACGT"s};
+    EXPECT_EQ(libjst::window_size(matcher), 4u);
+    EXPECT_THROW((static_shift_or_matcher<4>{"ACG"s}), std::invalid_argument);
+}
+
+TEST(static_window_matcher, left_extension) {
+    using extension_t = decltype(libjst::detail::left_extension(static_shift_or_matcher<23>{}));
+    EXPECT_TRUE((std::same_as<extension_t, std::integral_constant<std::size_t, 22>>));
+    EXPECT_EQ(libjst::detail::left_extension(libjst::shift_or_matcher{"ACGT"s}), 3u);
+}
+
+TEST(static_window_matcher, traversers) {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using cms_t = libjst::dna_compressed_multisequence<std::string, coverage_type>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+    using rcs_store_t = libjst::rcs_store<std::string, cms_t>;
+
+    //                      0123456789012345
+    rcs_store_t store{"AAAAGGGGAAAAGGGG"s, 4};
+    auto domain = store.variants().coverage_domain();
+    store.add(cms_value_t{libjst::breakpoint{1, 1}, "G"s, coverage_type{{0, 1}, domain}});
+    store.add(cms_value_t{libjst::breakpoint{6, 1}, "A"s, coverage_type{{0, 2}, domain}});
+    store.add(cms_value_t{libjst::breakpoint{11, 1}, "G"s, coverage_type{{3}, domain}});
+
+    auto search = [&] (auto traverser, auto matcher) {
+        std::vector<std::size_t> hits{};
+        traverser(libjst::volatile_tree{store}, std::move(matcher), [&] (auto && hit, auto && label) {
+            hits.push_back(label.coverage().size() * 100 + static_cast<std::size_t>(hit - label.sequence().begin()));
+        });
+        return hits;
+    };
+
+    std::string const needle = "GAAGGAG"s;
+    EXPECT_EQ(search(libjst::state_oblivious_traverser{}, static_shift_or_matcher<7>{needle}),
+              search(libjst::state_oblivious_traverser{}, libjst::shift_or_matcher{needle}));
+    EXPECT_FALSE(search(libjst::state_oblivious_traverser{}, static_shift_or_matcher<7>{needle}).empty());
+
+    std::size_t expected{};
+    libjst::distinct_context_traverser{}(libjst::volatile_tree{store}, libjst::shift_or_matcher{needle},
+                                         [&] (auto &&, auto &&) { ++expected; });
+    std::size_t actual{};
+    libjst::distinct_context_traverser{}(libjst::volatile_tree{store}, static_shift_or_matcher<7>{needle},
+                                         [&] (auto &&, auto &&) { ++actual; });
+    EXPECT_EQ(actual, expected);
+}
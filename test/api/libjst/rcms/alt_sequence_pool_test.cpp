@@ -0,0 +1,82 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+
+#include <cereal/archives/binary.hpp>
+
+#include <libjst/rcms/alt_sequence_pool.hpp>
+
+using namespace std::literals;
+
+struct alt_sequence_pool_test : public ::testing::Test {
+    using test_type = libjst::alt_sequence_pool<char>;
+};
+
+TEST_F(alt_sequence_pool_test, construct) {
+    test_type pool{};
+    EXPECT_TRUE(pool.empty());
+    EXPECT_EQ(pool.size(), 0u);
+    EXPECT_TRUE(pool.data().empty());
+}
+
+TEST_F(alt_sequence_pool_test, intern) {
+    test_type pool{};
+    auto acgt = pool.intern("ACGT"s);
+    auto cc = pool.intern("CC"s);
+    auto empty = pool.intern(""s);
+
+    EXPECT_EQ(pool.size(), 3u);
+    EXPECT_TRUE(std::ranges::equal(pool[acgt], "ACGT"s));
+    EXPECT_TRUE(std::ranges::equal(pool[cc], "CC"s));
+    EXPECT_TRUE(pool[empty].empty());
+    EXPECT_TRUE(std::ranges::equal(pool.data(), "ACGTCC"s));
+}
+
+TEST_F(alt_sequence_pool_test, intern_existing) {
+    test_type pool{};
+    auto first = pool.intern("ACGT"s);
+    pool.intern("GG"s);
+    auto second = pool.intern("ACGT"s);
+
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(pool.size(), 2u);
+    EXPECT_EQ(pool.data().size(), 6u);
+
+    // A prefix of a stored sequence is stored separately.
+    auto prefix = pool.intern("AC"s);
+    EXPECT_NE(prefix, first);
+    EXPECT_TRUE(std::ranges::equal(pool[prefix], "AC"s));
+}
+
+TEST_F(alt_sequence_pool_test, serialise) {
+    test_type pool_out{};
+    auto acgt = pool_out.intern("ACGT"s);
+    auto cc = pool_out.intern("CC"s);
+
+    std::stringstream buffer{};
+    {
+        cereal::BinaryOutputArchive oarch{buffer};
+        pool_out.save(oarch);
+    }
+
+    test_type pool_in{};
+    {
+        cereal::BinaryInputArchive iarch{buffer};
+        pool_in.load(iarch);
+    }
+
+    EXPECT_EQ(pool_in.size(), 2u);
+    EXPECT_TRUE(std::ranges::equal(pool_in[acgt], "ACGT"s));
+    EXPECT_TRUE(std::ranges::equal(pool_in[cc], "CC"s));
+    EXPECT_EQ(pool_in.intern("ACGT"s), acgt); // lookup is rebuilt
+    EXPECT_EQ(pool_in.size(), 2u);
+}
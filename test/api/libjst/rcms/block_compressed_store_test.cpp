@@ -0,0 +1,254 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <ranges>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <unistd.h>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/rcms/block_compressed_store.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/mapped_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+
+namespace jst::test::block_compressed_store {
+
+using source_t = std::string;
+
+struct test : public ::testing::Test {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using coverage_domain_type = libjst::coverage_domain_t<coverage_type>;
+
+    using cms_t = libjst::dna_compressed_multisequence<source_t, coverage_type>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+    using rcs_store_t = libjst::rcs_store<source_t, cms_t>;
+
+    static constexpr uint32_t haplotype_count{1000};
+
+    rcs_store_t _store;
+
+    // SNVs, insertions and deletions carried by few haplotypes each, i.e. with sparse coverages.
+    void SetUp() override {
+        std::mt19937 generator{42};
+        source_t source{};
+        for (std::size_t idx = 0; idx < 3000; ++idx)
+            source.push_back("ACGT"[generator() % 4]);
+
+        _store = rcs_store_t{source, haplotype_count};
+        coverage_domain_type domain = _store.variants().coverage_domain();
+        for (uint32_t position = 2; position + 4 < source.size(); position += 3) {
+            std::vector<uint32_t> haplotypes{};
+            for (std::size_t carrier = generator() % 4 + 1; carrier > 0; --carrier)
+                haplotypes.push_back(generator() % haplotype_count);
+            std::ranges::sort(haplotypes);
+            auto [first, last] = std::ranges::unique(haplotypes);
+            haplotypes.erase(first, last);
+
+            libjst::breakpoint breakpoint{position, 1u};
+            source_t alt{};
+            switch (position % 4) {
+                case 0: alt.push_back((source[position] == 'A') ? 'C' : 'A'); break;
+                case 1: breakpoint = libjst::breakpoint{position, 0u}; alt = "GTA"; break;
+                case 2: breakpoint = libjst::breakpoint{position, 0u}; alt = "GTAC"; break;
+                default: breakpoint = libjst::breakpoint{position, 2u}; break;
+            }
+            _store.add(cms_value_t{breakpoint, alt, coverage_type{haplotypes, domain}});
+        }
+    }
+
+    std::string save(std::size_t const block_size = 4096, std::size_t const thread_count = 4) const {
+        std::ostringstream stream{};
+        libjst::save_block_compressed(stream, _store, libjst::block_compression_options{block_size, thread_count});
+        return stream.str();
+    }
+
+    std::string save_layout() const {
+        std::ostringstream stream{};
+        libjst::save_mapped(stream, _store);
+        return stream.str();
+    }
+
+    // Reads the ranges of an archive held in memory like an object store and counts the requests.
+    struct memory_range_reader {
+        std::string const * archive{};
+        std::atomic<std::size_t> * request_count{};
+
+        void operator()(uint64_t const offset, std::span<std::byte> bytes) const {
+            if (offset > archive->size() || bytes.size() > archive->size() - offset)
+                throw std::out_of_range{"The requested range exceeds the archive."};
+            std::memcpy(bytes.data(), archive->data() + offset, bytes.size());
+            ++*request_count;
+        }
+    };
+
+    template <typename store_t>
+    static void expect_equal_variants(store_t const & actual, store_t const & expected) {
+        EXPECT_TRUE(std::ranges::equal(actual.source(), expected.source()));
+        ASSERT_EQ(std::ranges::size(actual.variants()), std::ranges::size(expected.variants()));
+
+        auto actual_it = actual.variants().begin();
+        for (auto && expected_delta : expected.variants()) {
+            EXPECT_EQ(libjst::get_breakpoint(*actual_it), libjst::get_breakpoint(expected_delta));
+            EXPECT_TRUE(std::ranges::equal(libjst::alt_sequence(*actual_it), libjst::alt_sequence(expected_delta)));
+            EXPECT_EQ(libjst::coverage(*actual_it), libjst::coverage(expected_delta));
+            ++actual_it;
+        }
+    }
+};
+
+} // namespace jst::test::block_compressed_store
+
+using block_compressed_store_test = jst::test::block_compressed_store::test;
+
+// ----------------------------------------------------------------------------
+// Test case definitions
+// ----------------------------------------------------------------------------
+
+TEST_F(block_compressed_store_test, round_trip) {
+    for (std::size_t const thread_count : {1u, 4u}) {
+        for (std::size_t const block_size : {64u, 4096u, 1u << 20}) {
+            std::istringstream stream{save(block_size, thread_count)};
+            auto loaded = libjst::load_block_compressed(stream, thread_count);
+            EXPECT_EQ(loaded.size(), _store.size());
+            expect_equal_variants(loaded, _store);
+        }
+    }
+}
+
+TEST_F(block_compressed_store_test, compresses_coverages) {
+    std::string const archive = save();
+    std::string const layout = save_layout();
+    EXPECT_LT(archive.size() * 2, layout.size());
+
+    std::istringstream stream{archive};
+    libjst::block_compressed_layout compressed{stream, 2};
+    EXPECT_EQ(compressed.layout_size(), layout.size());
+    EXPECT_EQ(compressed.block_count(), (layout.size() + 4095) / 4096);
+    compressed.decompress();
+    EXPECT_EQ(std::memcmp(compressed.bytes().data(), layout.data(), layout.size()), 0);
+}
+
+TEST_F(block_compressed_store_test, load_region) {
+    std::string const layout = save_layout();
+    std::vector<uint64_t> layout_words((layout.size() + 7) / 8);
+    std::memcpy(layout_words.data(), layout.data(), layout.size());
+    libjst::mapped_compressed_multisequence<> mapped{std::as_bytes(std::span{layout_words})};
+
+    std::istringstream stream{save(1024)};
+    libjst::block_compressed_layout compressed{stream, 4};
+    for (auto [first, last] : {std::pair{1200u, 1500u}, std::pair{0u, 20u}, std::pair{2900u, 3000u},
+                               std::pair{700u, 700u}}) {
+        auto region_store = libjst::load_block_compressed_region(compressed, first, last);
+        expect_equal_variants(region_store, libjst::load_region(mapped, first, last));
+    }
+
+    std::size_t decompressed_count{};
+    for (std::size_t block = 0; block < compressed.block_count(); ++block)
+        decompressed_count += compressed.is_decompressed(block);
+    EXPECT_LT(decompressed_count, compressed.block_count());
+}
+
+TEST_F(block_compressed_store_test, corrupted_block) {
+    std::string archive = save();
+    archive[archive.size() - 10] ^= 0x21;
+    std::istringstream stream{archive};
+    EXPECT_THROW(libjst::load_block_compressed(stream), std::runtime_error);
+}
+
+TEST_F(block_compressed_store_test, invalid_archive) {
+    std::string archive = save();
+    { // truncated
+        std::istringstream stream{archive.substr(0, archive.size() - 1)};
+        EXPECT_THROW(libjst::load_block_compressed(stream), std::runtime_error);
+    }
+    { // no archive
+        archive[0] = 'X';
+        std::istringstream stream{archive};
+        EXPECT_THROW(libjst::block_compressed_layout{stream}, std::runtime_error);
+    }
+    { // invalid block size
+        std::ostringstream stream{};
+        EXPECT_THROW(libjst::save_block_compressed(stream, _store, libjst::block_compression_options{12, 1}),
+                     std::invalid_argument);
+    }
+}
+
+TEST_F(block_compressed_store_test, range_reader) {
+    std::string const archive = save(1024);
+    std::string const layout = save_layout();
+    std::vector<uint64_t> layout_words((layout.size() + 7) / 8);
+    std::memcpy(layout_words.data(), layout.data(), layout.size());
+    libjst::mapped_compressed_multisequence<> mapped{std::as_bytes(std::span{layout_words})};
+
+    std::atomic<std::size_t> request_count{};
+    libjst::block_compressed_layout remote{memory_range_reader{&archive, &request_count}, 4};
+    EXPECT_EQ(request_count.load(), 2u); // the header and the block index
+    EXPECT_EQ(remote.fetched_bytes(), 0u);
+
+    auto region_store = libjst::load_block_compressed_region(remote, 1200, 1500);
+    expect_equal_variants(region_store, libjst::load_region(mapped, 1200, 1500));
+    EXPECT_GT(remote.fetched_bytes(), 0u);
+    EXPECT_LT(remote.fetched_bytes(), archive.size());
+
+    // Decompressed blocks are not fetched again.
+    std::size_t const fetched_bytes = remote.fetched_bytes();
+    libjst::load_block_compressed_region(remote, 1300, 1400);
+    EXPECT_EQ(remote.fetched_bytes(), fetched_bytes);
+
+    remote.decompress();
+    EXPECT_EQ(std::memcmp(remote.bytes().data(), layout.data(), layout.size()), 0);
+
+    std::string const truncated = archive.substr(0, archive.size() - 1);
+    libjst::block_compressed_layout truncated_layout{memory_range_reader{&truncated, &request_count}, 2};
+    EXPECT_THROW(truncated_layout.decompress(), std::out_of_range);
+}
+
+TEST_F(block_compressed_store_test, block_cache) {
+    std::string const archive = save(1024);
+    std::filesystem::path const cache_directory = std::filesystem::temp_directory_path() /
+                                                  ("libjst_block_cache_test_" + std::to_string(::getpid()));
+    std::filesystem::remove_all(cache_directory);
+
+    std::atomic<std::size_t> request_count{};
+    libjst::block_compressed_layout cold{memory_range_reader{&archive, &request_count}, 4};
+    cold.set_block_cache(cache_directory);
+    auto cold_store = libjst::load_block_compressed_region(cold, 100, 900);
+    EXPECT_GT(cold.fetched_bytes(), 0u);
+
+    // A later layout reads the blocks of the region from the cache.
+    libjst::block_compressed_layout warm{memory_range_reader{&archive, &request_count}, 4};
+    warm.set_block_cache(cache_directory);
+    expect_equal_variants(libjst::load_block_compressed_region(warm, 100, 900), cold_store);
+    EXPECT_EQ(warm.fetched_bytes(), 0u);
+
+    // A corrupted cached block is fetched again.
+    for (auto const & entry : std::filesystem::directory_iterator{cache_directory}) {
+        std::ofstream corrupted{entry.path(), std::ios::binary | std::ios::in | std::ios::out};
+        corrupted.put('\x7f');
+    }
+    libjst::block_compressed_layout repaired{memory_range_reader{&archive, &request_count}, 4};
+    repaired.set_block_cache(cache_directory);
+    expect_equal_variants(libjst::load_block_compressed_region(repaired, 100, 900), cold_store);
+    EXPECT_GT(repaired.fetched_bytes(), 0u);
+
+    std::filesystem::remove_all(cache_directory);
+}
@@ -0,0 +1,104 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+
+#include <libjst/coverage/concept.hpp>
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/compressed_multisequence_compact.hpp>
+
+using namespace std::literals;
+
+struct compressed_multisequence_compact_test : public ::testing::Test {
+    using source_type = std::string;
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using coverage_domain_type = libjst::coverage_domain_t<coverage_type>;
+
+    using wrapped_test_type = libjst::dna_compressed_multisequence<source_type, coverage_type>;
+    using value_type = std::ranges::range_value_t<wrapped_test_type>;
+    using test_type = libjst::compressed_multisequence_compact<wrapped_test_type>;
+
+    source_type src{"AAAAAAAAAAAAAAA"s};
+    coverage_domain_type domain{0, 10};
+    wrapped_test_type rcms{src, domain};
+
+    void SetUp() override {
+        coverage_type test_coverage{{0, 1, 2}, rcms.coverage_domain()};
+        rcms.insert(value_type{libjst::breakpoint{9, 1}, "T"s, test_coverage});
+        rcms.insert(value_type{libjst::breakpoint{5, 1}, "C"s, test_coverage});
+        rcms.insert(value_type{libjst::breakpoint{2, 0}, "GG"s, test_coverage});
+        rcms.insert(value_type{libjst::breakpoint{3, 4}, ""s, test_coverage});
+    }
+};
+
+TEST_F(compressed_multisequence_compact_test, range_concept) {
+    EXPECT_TRUE(std::ranges::random_access_range<test_type>);
+    EXPECT_LT(sizeof(std::ranges::iterator_t<test_type const &>),
+              sizeof(std::ranges::iterator_t<wrapped_test_type const &>));
+}
+
+TEST_F(compressed_multisequence_compact_test, construct) {
+    test_type compact_rcms{rcms};
+    EXPECT_TRUE(std::ranges::equal(compact_rcms.source(), src));
+    EXPECT_TRUE(compact_rcms.coverage_domain() == domain);
+    EXPECT_EQ(compact_rcms.size(), rcms.size());
+
+    // The breakends exceed the index type.
+    wrapped_test_type large_rcms{std::string(600, 'A'), domain};
+    for (uint32_t position = 0; position < 300; ++position)
+        large_rcms.insert(value_type{libjst::breakpoint{position * 2, 1}, "C"s, coverage_type{{0}, domain}});
+    using small_test_type = libjst::compressed_multisequence_compact<wrapped_test_type, uint8_t>;
+    EXPECT_THROW(small_test_type{large_rcms}, std::length_error);
+}
+
+TEST_F(compressed_multisequence_compact_test, iterate) {
+    test_type compact_rcms{rcms};
+
+    EXPECT_EQ(std::ranges::ssize(compact_rcms), std::ranges::ssize(rcms));
+    auto wrapped_it = rcms.begin();
+    for (auto it = compact_rcms.begin(); it != compact_rcms.end(); ++it, ++wrapped_it) {
+        EXPECT_EQ(libjst::position(*it), libjst::position(*wrapped_it));
+        EXPECT_EQ(libjst::low_breakend(*it), libjst::low_breakend(*wrapped_it));
+        EXPECT_EQ(libjst::high_breakend(*it), libjst::high_breakend(*wrapped_it));
+        EXPECT_TRUE(std::ranges::equal(libjst::alt_sequence(*it), libjst::alt_sequence(*wrapped_it)));
+        EXPECT_EQ(libjst::coverage(*it), libjst::coverage(*wrapped_it));
+        EXPECT_EQ((*it).get_breakpoint_end(), (*wrapped_it).get_breakpoint_end());
+        EXPECT_EQ((*it).get_key(), (*wrapped_it).get_key());
+    }
+    EXPECT_TRUE(wrapped_it == rcms.end());
+    EXPECT_EQ(compact_rcms.end() - compact_rcms.begin(), rcms.end() - rcms.begin());
+}
+
+TEST_F(compressed_multisequence_compact_test, jump_to_mate) {
+    test_type compact_rcms{rcms};
+
+    std::size_t deletion_count{};
+    for (auto it = compact_rcms.begin(); it != compact_rcms.end(); ++it) {
+        auto mate = (*it).jump_to_mate();
+        auto wrapped_mate = (*(rcms.begin() + (it - compact_rcms.begin()))).jump_to_mate();
+        ASSERT_EQ(mate.has_value(), wrapped_mate.has_value());
+        if (mate.has_value()) {
+            ++deletion_count;
+            EXPECT_EQ(*mate - compact_rcms.begin(), *wrapped_mate - rcms.begin());
+        }
+    }
+    EXPECT_EQ(deletion_count, 2u);
+}
+
+TEST_F(compressed_multisequence_compact_test, lower_bound) {
+    test_type compact_rcms{rcms};
+
+    for (uint32_t position = 0; position <= src.size(); ++position)
+        EXPECT_EQ(compact_rcms.lower_bound(position) - compact_rcms.begin(), rcms.lower_bound(position) - rcms.begin());
+}
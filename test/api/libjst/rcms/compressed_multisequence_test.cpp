@@ -11,13 +11,18 @@
 #include <ranges>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include <cereal/archives/json.hpp>
 #include <cereal/types/vector.hpp>
 
 #include <libjst/coverage/concept.hpp>
 #include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/coverage/bit_coverage_pool.hpp>
+#include <libjst/coverage/hybrid_coverage.hpp>
+#include <libjst/coverage/run_length_coverage_pool.hpp>
 #include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
 
 using namespace std::literals;
 
@@ -42,6 +47,470 @@ TEST_F(compressed_multisequence_test, construct) {
     EXPECT_TRUE(multisequence.coverage_domain() == domain);
 }
 
+TEST_F(compressed_multisequence_test, construct_from_deltas) {
+    using value_type = std::ranges::range_value_t<test_type>;
+
+    source_type src{"AAAAAAAAAAAAAAA"s};
+    coverage_domain_type domain{0, 10};
+    coverage_type cov1{{0, 1, 2}, domain};
+    coverage_type cov2{{3, 4}, domain};
+    coverage_type cov3{{5, 9}, domain};
+
+    std::vector<value_type> deltas{value_type{libjst::breakpoint{1, 1}, "T"s, cov1},
+                                   value_type{libjst::breakpoint{2, 4}, ""s, cov2},
+                                   value_type{libjst::breakpoint{4, 0}, "CC"s, cov1},
+                                   value_type{libjst::breakpoint{4, 1}, "G"s, cov3},
+                                   value_type{libjst::breakpoint{8, 3}, ""s, cov3},
+                                   value_type{libjst::breakpoint{12, 1}, "C"s, cov2}};
+
+    coverage_type full_coverage{{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}, domain};
+    std::vector<value_type> expected{value_type{libjst::breakpoint{0, 0}, ""s, full_coverage},
+                                     value_type{libjst::breakpoint{1, 1}, "T"s, cov1},
+                                     value_type{libjst::breakpoint{2, 4}, ""s, cov2},
+                                     value_type{libjst::breakpoint{4, 0}, "CC"s, cov1},
+                                     value_type{libjst::breakpoint{4, 1}, "G"s, cov3},
+                                     value_type{libjst::breakpoint{2, 4}, ""s, cov2}, // high end of deletion
+                                     value_type{libjst::breakpoint{8, 3}, ""s, cov3},
+                                     value_type{libjst::breakpoint{8, 3}, ""s, cov3}, // high end of deletion
+                                     value_type{libjst::breakpoint{12, 1}, "C"s, cov2},
+                                     value_type{libjst::breakpoint{15, 0}, ""s, full_coverage}};
+
+    auto check = [&] (test_type const & actual) {
+        EXPECT_EQ(actual.size(), expected.size());
+        EXPECT_TRUE(actual.coverage_domain() == domain);
+        auto actual_it = actual.begin();
+        for (value_type const & expected_delta : expected) {
+            EXPECT_EQ(libjst::low_breakend(*actual_it), libjst::low_breakend(expected_delta));
+            EXPECT_EQ(libjst::high_breakend(*actual_it), libjst::high_breakend(expected_delta));
+            EXPECT_TRUE(std::ranges::equal(libjst::alt_sequence(*actual_it), libjst::alt_sequence(expected_delta)));
+            EXPECT_EQ(libjst::coverage(*actual_it), libjst::coverage(expected_delta));
+            ++actual_it;
+        }
+    };
+
+    { // sorted
+        check(test_type{src, domain, deltas});
+    }
+
+    { // unsorted
+        std::ranges::reverse(deltas);
+        check(test_type{src, domain, deltas});
+    }
+
+    { // input range
+        check(test_type{src, domain, deltas | std::views::transform([] (value_type const & delta) { return delta; })});
+    }
+
+    { // different coverage domain
+        std::vector<value_type> invalid{value_type{libjst::breakpoint{1, 1}, "T"s, coverage_type{{0}, coverage_domain_type{0, 5}}}};
+        EXPECT_THROW((test_type{src, domain, invalid}), std::domain_error);
+    }
+}
+
+TEST_F(compressed_multisequence_test, construct_from_shards) {
+    using value_type = std::ranges::range_value_t<test_type>;
+
+    source_type src{"AAAAAAAAAAAAAAA"s};
+    coverage_domain_type domain{0, 10};
+    coverage_type cov1{{0, 1, 2}, domain};
+    coverage_type cov2{{3, 4}, domain};
+
+    std::vector<value_type> first_deltas{value_type{libjst::breakpoint{1, 1}, "T"s, cov1},
+                                         value_type{libjst::breakpoint{3, 6}, ""s, cov2}};
+    std::vector<value_type> second_deltas{value_type{libjst::breakpoint{7, 0}, "CC"s, cov1},
+                                          value_type{libjst::breakpoint{12, 1}, "G"s, cov2}};
+    std::vector<value_type> all_deltas{first_deltas};
+    all_deltas.insert(all_deltas.end(), second_deltas.begin(), second_deltas.end());
+
+    std::vector<test_type> shards{};
+    shards.emplace_back(src, domain, first_deltas);
+    shards.emplace_back(src, domain, second_deltas);
+
+    test_type expected{src, domain, all_deltas};
+    test_type actual{shards};
+
+    EXPECT_TRUE(std::ranges::equal(actual.source(), src));
+    ASSERT_EQ(actual.size(), expected.size());
+    auto actual_it = actual.begin();
+    for (auto && expected_delta : expected) {
+        EXPECT_EQ(libjst::low_breakend(*actual_it), libjst::low_breakend(expected_delta));
+        EXPECT_EQ(libjst::high_breakend(*actual_it), libjst::high_breakend(expected_delta));
+        EXPECT_TRUE(std::ranges::equal(libjst::alt_sequence(*actual_it), libjst::alt_sequence(expected_delta)));
+        EXPECT_EQ(libjst::coverage(*actual_it), libjst::coverage(expected_delta));
+        ++actual_it;
+    }
+
+    { // no shards
+        EXPECT_TRUE(std::ranges::empty(test_type{std::vector<test_type>{}}));
+    }
+
+    { // different coverage domain
+        shards.emplace_back(src, coverage_domain_type{0, 5});
+        EXPECT_THROW((test_type{shards}), std::domain_error);
+    }
+
+    { // different source
+        shards.back() = test_type{"AAAA"s, domain};
+        EXPECT_THROW((test_type{shards}), std::invalid_argument);
+    }
+}
+
+TEST_F(compressed_multisequence_test, extend) {
+    using value_type = std::ranges::range_value_t<test_type>;
+
+    source_type src{"AAAAAAAAAAAAAAA"s};
+    coverage_domain_type domain{0, 4};
+    coverage_domain_type extended_domain{0, 7};
+
+    test_type multisequence{src, domain, std::vector<value_type>{
+        value_type{libjst::breakpoint{1, 1}, "T"s, coverage_type{{0, 1}, domain}},
+        value_type{libjst::breakpoint{2, 4}, ""s, coverage_type{{2}, domain}},
+        value_type{libjst::breakpoint{4, 0}, "CC"s, coverage_type{{0}, domain}},
+        value_type{libjst::breakpoint{8, 1}, "G"s, coverage_type{{3}, domain}}}};
+
+    // unsorted, with deltas equal to stored ones
+    std::vector<value_type> new_deltas{
+        value_type{libjst::breakpoint{12, 1}, "C"s, coverage_type{{6}, extended_domain}},
+        value_type{libjst::breakpoint{1, 1}, "T"s, coverage_type{{4}, extended_domain}},
+        value_type{libjst::breakpoint{1, 1}, "G"s, coverage_type{{5}, extended_domain}},
+        value_type{libjst::breakpoint{2, 4}, ""s, coverage_type{{4, 6}, extended_domain}},
+        value_type{libjst::breakpoint{4, 0}, "GG"s, coverage_type{{5}, extended_domain}},
+        value_type{libjst::breakpoint{9, 2}, ""s, coverage_type{{4}, extended_domain}},
+        value_type{libjst::breakpoint{9, 0}, "TT"s, coverage_type{{4}, extended_domain}}};
+
+    test_type expected{src, extended_domain, std::vector<value_type>{
+        value_type{libjst::breakpoint{1, 1}, "T"s, coverage_type{{0, 1, 4}, extended_domain}},
+        value_type{libjst::breakpoint{1, 1}, "G"s, coverage_type{{5}, extended_domain}},
+        value_type{libjst::breakpoint{2, 4}, ""s, coverage_type{{2, 4, 6}, extended_domain}},
+        value_type{libjst::breakpoint{4, 0}, "CC"s, coverage_type{{0}, extended_domain}},
+        value_type{libjst::breakpoint{4, 0}, "GG"s, coverage_type{{5}, extended_domain}},
+        value_type{libjst::breakpoint{8, 1}, "G"s, coverage_type{{3}, extended_domain}},
+        value_type{libjst::breakpoint{9, 0}, "TT"s, coverage_type{{4}, extended_domain}},
+        value_type{libjst::breakpoint{9, 2}, ""s, coverage_type{{4}, extended_domain}},
+        value_type{libjst::breakpoint{12, 1}, "C"s, coverage_type{{6}, extended_domain}}}};
+
+    auto check = [&] (test_type const & actual) {
+        EXPECT_TRUE(actual.coverage_domain() == extended_domain);
+        ASSERT_EQ(actual.size(), expected.size());
+        auto actual_it = actual.begin();
+        for (auto && expected_delta : expected) {
+            EXPECT_EQ(libjst::low_breakend(*actual_it), libjst::low_breakend(expected_delta));
+            EXPECT_EQ(libjst::high_breakend(*actual_it), libjst::high_breakend(expected_delta));
+            EXPECT_TRUE(std::ranges::equal(libjst::alt_sequence(*actual_it), libjst::alt_sequence(expected_delta)));
+            EXPECT_EQ(libjst::coverage(*actual_it), libjst::coverage(expected_delta));
+            ++actual_it;
+        }
+    };
+
+    { // invalid extensions leave the multisequence unchanged
+        EXPECT_THROW(multisequence.extend(coverage_domain_type{0, 3}, std::vector<value_type>{}), std::domain_error);
+        EXPECT_THROW(multisequence.extend(coverage_domain_type{1, 7}, std::vector<value_type>{}), std::domain_error);
+        EXPECT_THROW(multisequence.extend(extended_domain, std::vector<value_type>{
+                         value_type{libjst::breakpoint{1, 1}, "T"s, coverage_type{{1}, domain}}}),
+                     std::domain_error);
+        EXPECT_THROW(multisequence.extend(extended_domain, std::vector<value_type>{
+                         value_type{libjst::breakpoint{3, 1}, "N"s, coverage_type{{5}, extended_domain}}}),
+                     std::invalid_argument);
+        EXPECT_TRUE(multisequence.coverage_domain() == domain);
+        EXPECT_EQ(multisequence.size(), 7u);
+    }
+
+    multisequence.extend(extended_domain, new_deltas);
+    check(multisequence);
+
+    { // without new deltas only the domain is extended
+        test_type copy{src, domain, std::vector<value_type>{
+            value_type{libjst::breakpoint{3, 2}, ""s, coverage_type{{1}, domain}}}};
+        copy.extend(extended_domain, std::vector<value_type>{});
+        ASSERT_EQ(copy.size(), 4u);
+        EXPECT_EQ(libjst::coverage(*std::ranges::next(copy.begin())), (coverage_type{{1}, extended_domain}));
+        EXPECT_EQ(libjst::high_breakend(*std::ranges::next(copy.begin(), 2)), 5u);
+    }
+}
+
+TEST_F(compressed_multisequence_test, extract) {
+    using value_type = std::ranges::range_value_t<test_type>;
+    using rcs_store_t = libjst::rcs_store<source_type, test_type>;
+
+    source_type src{"AAAAAAAAAAAAAAA"s};
+    coverage_domain_type domain{0, 6};
+    coverage_domain_type extracted_domain{0, 3};
+
+    std::vector<value_type> deltas{value_type{libjst::breakpoint{1, 1}, "T"s, coverage_type{{0, 3}, domain}},
+                                   value_type{libjst::breakpoint{2, 4}, ""s, coverage_type{{1}, domain}},
+                                   value_type{libjst::breakpoint{4, 0}, "CC"s, coverage_type{{4, 5}, domain}},
+                                   value_type{libjst::breakpoint{8, 1}, "G"s, coverage_type{{1, 5}, domain}},
+                                   value_type{libjst::breakpoint{10, 0}, "A"s, coverage_type{{2}, domain}}};
+    test_type multisequence{src, domain, deltas};
+    coverage_type const samples{{1, 4, 5}, domain};
+
+    // The samples 1, 4 and 5 become the haplotypes 0, 1 and 2.
+    test_type expected{src, extracted_domain, std::vector<value_type>{
+        value_type{libjst::breakpoint{2, 4}, ""s, coverage_type{{0}, extracted_domain}},
+        value_type{libjst::breakpoint{4, 0}, "CC"s, coverage_type{{1, 2}, extracted_domain}},
+        value_type{libjst::breakpoint{8, 1}, "G"s, coverage_type{{0, 2}, extracted_domain}}}};
+
+    auto check = [&] (test_type const & actual) {
+        EXPECT_TRUE(actual.coverage_domain() == extracted_domain);
+        EXPECT_TRUE(std::ranges::equal(actual.source(), src));
+        ASSERT_EQ(actual.size(), expected.size());
+        auto actual_it = actual.begin();
+        for (auto && expected_delta : expected) {
+            EXPECT_EQ(libjst::low_breakend(*actual_it), libjst::low_breakend(expected_delta));
+            EXPECT_EQ(libjst::high_breakend(*actual_it), libjst::high_breakend(expected_delta));
+            EXPECT_TRUE(std::ranges::equal(libjst::alt_sequence(*actual_it), libjst::alt_sequence(expected_delta)));
+            EXPECT_EQ(libjst::coverage(*actual_it), libjst::coverage(expected_delta));
+            ++actual_it;
+        }
+    };
+
+    for (std::size_t const thread_count : {1u, 2u, 16u})
+        check(multisequence.extract(samples, thread_count));
+
+    EXPECT_EQ(multisequence.size(), 8u); // the multisequence is not modified
+    EXPECT_THROW(multisequence.extract(coverage_type{{1}, extracted_domain}), std::domain_error);
+
+    test_type const empty = multisequence.extract(coverage_type{{}, domain}, 4);
+    EXPECT_EQ(empty.size(), 2u);
+    EXPECT_EQ(empty.coverage_domain().size(), 0u);
+
+    rcs_store_t const store{src, 6, deltas};
+    rcs_store_t const extracted_store = store.extract(samples, 2);
+    EXPECT_EQ(extracted_store.size(), 3u);
+    check(extracted_store.variants());
+}
+
+TEST_F(compressed_multisequence_test, search_index) {
+    using value_type = std::ranges::range_value_t<test_type>;
+
+    source_type src{"AAAAAAAAAAAAAAA"s};
+    coverage_domain_type domain{0, 4};
+    test_type multisequence{src, domain, std::vector<value_type>{
+        value_type{libjst::breakpoint{1, 1}, "T"s, coverage_type{{0, 1}, domain}},
+        value_type{libjst::breakpoint{2, 4}, ""s, coverage_type{{2}, domain}},
+        value_type{libjst::breakpoint{4, 0}, "CC"s, coverage_type{{0}, domain}},
+        value_type{libjst::breakpoint{6, 1}, "G"s, coverage_type{{3}, domain}},
+        value_type{libjst::breakpoint{15, 0}, "G"s, coverage_type{{3}, domain}}}};
+
+    std::vector<std::ptrdiff_t> expected_offsets{};
+    for (uint32_t position = 0; position <= 15; ++position)
+        expected_offsets.push_back(multisequence.lower_bound(position) - multisequence.begin());
+
+    EXPECT_FALSE(multisequence.has_search_index());
+    multisequence.build_search_index();
+    EXPECT_TRUE(multisequence.has_search_index());
+    for (uint32_t position = 0; position <= 15; ++position) {
+        auto breakend_it = multisequence.lower_bound(position);
+        EXPECT_EQ(breakend_it - multisequence.begin(), expected_offsets[position]);
+        EXPECT_GE(libjst::position(*breakend_it), position);
+        EXPECT_TRUE(breakend_it == multisequence.begin() ||
+                    libjst::position(*std::ranges::prev(breakend_it)) < position);
+    }
+    EXPECT_EQ(multisequence.lower_bound(6u) - multisequence.begin(), 4); // the high breakend of the deletion
+    EXPECT_TRUE(multisequence.has_conflicts(value_type{libjst::breakpoint{4, 1}, "G"s, coverage_type{{0}, domain}}));
+    EXPECT_FALSE(multisequence.has_conflicts(value_type{libjst::breakpoint{4, 1}, "G"s, coverage_type{{1}, domain}}));
+
+    for (std::size_t const sample_distance : {1u, 4u, 8u, 32u}) {
+        multisequence.build_position_index(sample_distance);
+        EXPECT_TRUE(multisequence.has_position_index());
+        for (uint32_t position = 0; position <= 15; ++position)
+            EXPECT_EQ(multisequence.lower_bound(position) - multisequence.begin(), expected_offsets[position]);
+        EXPECT_TRUE(multisequence.lower_bound(100u) == multisequence.end());
+    }
+    EXPECT_THROW(multisequence.build_position_index(6), std::invalid_argument);
+
+    multisequence.insert(value_type{libjst::breakpoint{3, 1}, "G"s, coverage_type{{1}, domain}});
+    EXPECT_FALSE(multisequence.has_search_index());
+    EXPECT_FALSE(multisequence.has_position_index());
+    EXPECT_EQ(multisequence.lower_bound(4u) - multisequence.begin(), 4);
+}
+
+TEST_F(compressed_multisequence_test, wide_breakend_position) {
+    using wide_type = libjst::dna_compressed_multisequence<source_type, coverage_type, uint64_t>;
+    using value_type = std::ranges::range_value_t<wide_type>;
+
+    source_type src{"AAAAAAAAAAAAAAA"s};
+    coverage_domain_type domain{0, 10};
+    coverage_type test_coverage{{0, 1, 2}, domain};
+
+    wide_type multisequence{src, domain};
+    multisequence.insert(value_type{libjst::breakpoint{3, 4}, ""s, test_coverage});
+    auto it = multisequence.insert(value_type{libjst::breakpoint{9, 1}, "T"s, test_coverage});
+
+    EXPECT_EQ(multisequence.size(), 5u);
+    EXPECT_EQ(libjst::low_breakend(*it), 9u);
+    EXPECT_EQ(libjst::high_breakend(*it), 10u);
+    EXPECT_TRUE(std::ranges::equal(libjst::alt_sequence(*it), "T"s));
+    EXPECT_EQ(libjst::high_breakend(*std::ranges::next(multisequence.begin())), 7u);
+}
+
+TEST_F(compressed_multisequence_test, pooled_coverages) {
+    using pooled_type = libjst::dna_compressed_multisequence<source_type, coverage_type, uint32_t,
+                                                             libjst::bit_coverage_pool<uint32_t>>;
+    using value_type = std::ranges::range_value_t<test_type>;
+
+    source_type src{"AAAAAAAAAAAAAAA"s};
+    coverage_domain_type domain{0, 100};
+    coverage_type cov1{{0, 1, 70}, domain};
+    coverage_type cov2{{3, 4, 99}, domain};
+
+    std::vector<value_type> deltas{value_type{libjst::breakpoint{1, 1}, "T"s, cov1},
+                                   value_type{libjst::breakpoint{2, 5}, ""s, cov2},
+                                   value_type{libjst::breakpoint{4, 0}, "CC"s, cov1},
+                                   value_type{libjst::breakpoint{11, 2}, ""s, cov1}};
+    test_type expected{src, domain, deltas};
+    pooled_type actual{src, domain, deltas};
+
+    auto expect_equal = [&] (pooled_type const & pooled) {
+        ASSERT_EQ(pooled.size(), expected.size());
+        auto pooled_it = pooled.begin();
+        for (auto && expected_delta : expected) {
+            EXPECT_EQ(libjst::low_breakend(*pooled_it), libjst::low_breakend(expected_delta));
+            EXPECT_EQ(libjst::high_breakend(*pooled_it), libjst::high_breakend(expected_delta));
+            EXPECT_TRUE(std::ranges::equal(libjst::alt_sequence(*pooled_it), libjst::alt_sequence(expected_delta)));
+            EXPECT_TRUE(libjst::coverage(*pooled_it) == libjst::coverage(expected_delta));
+            ++pooled_it;
+        }
+    };
+
+    expect_equal(actual);
+    EXPECT_TRUE(actual.has_conflicts(value_type{libjst::breakpoint{1, 1}, "G"s, coverage_type{{70}, domain}}));
+    EXPECT_FALSE(actual.has_conflicts(value_type{libjst::breakpoint{1, 1}, "G"s, coverage_type{{71}, domain}}));
+
+    value_type converted = *std::ranges::next(actual.begin());
+    EXPECT_TRUE(libjst::coverage(converted) == cov1);
+
+    { // incremental insertion
+        pooled_type incremental{src, domain};
+        incremental.insert(value_type{libjst::breakpoint{4, 0}, "CC"s, cov1});
+        incremental.insert(value_type{libjst::breakpoint{1, 1}, "T"s, cov1});
+        EXPECT_EQ(incremental.size(), 4u);
+        EXPECT_TRUE(libjst::coverage(*std::ranges::next(incremental.begin())) == cov1);
+        EXPECT_TRUE(std::ranges::equal(libjst::alt_sequence(*std::ranges::next(incremental.begin(), 2)), "CC"s));
+    }
+
+    { // serialisation
+        std::stringstream buffer{};
+        {
+            cereal::JSONOutputArchive oarch{buffer};
+            actual.save(oarch);
+        }
+
+        pooled_type pooled_in{};
+        {
+            cereal::JSONInputArchive iarch{buffer};
+            pooled_in.load(iarch);
+        }
+        expect_equal(pooled_in);
+    }
+}
+
+TEST_F(compressed_multisequence_test, run_length_coverages) {
+    using encoded_type = libjst::dna_compressed_multisequence<source_type, coverage_type, uint32_t,
+                                                              libjst::run_length_coverage_pool<uint32_t>>;
+    using value_type = std::ranges::range_value_t<test_type>;
+
+    source_type src{"AAAAAAAAAAAAAAA"s};
+    coverage_domain_type domain{0, 100};
+    coverage_type cov1{{0, 1, 70}, domain};
+    coverage_type cov2{std::views::iota(10u, 90u), domain};
+
+    std::vector<value_type> deltas{value_type{libjst::breakpoint{1, 1}, "T"s, cov1},
+                                   value_type{libjst::breakpoint{2, 5}, ""s, cov2},
+                                   value_type{libjst::breakpoint{4, 0}, "CC"s, cov1},
+                                   value_type{libjst::breakpoint{11, 2}, ""s, cov1}};
+    test_type expected{src, domain, deltas};
+    encoded_type actual{src, domain, deltas};
+
+    auto expect_equal = [&] (encoded_type const & encoded) {
+        ASSERT_EQ(encoded.size(), expected.size());
+        auto encoded_it = encoded.begin();
+        for (auto && expected_delta : expected) {
+            EXPECT_EQ(libjst::low_breakend(*encoded_it), libjst::low_breakend(expected_delta));
+            EXPECT_EQ(libjst::high_breakend(*encoded_it), libjst::high_breakend(expected_delta));
+            EXPECT_TRUE(std::ranges::equal(libjst::alt_sequence(*encoded_it), libjst::alt_sequence(expected_delta)));
+            EXPECT_TRUE(libjst::coverage(*encoded_it) == libjst::coverage(expected_delta));
+            ++encoded_it;
+        }
+    };
+
+    expect_equal(actual);
+    EXPECT_TRUE(actual.has_conflicts(value_type{libjst::breakpoint{1, 1}, "G"s, coverage_type{{70}, domain}}));
+    EXPECT_FALSE(actual.has_conflicts(value_type{libjst::breakpoint{1, 1}, "G"s, coverage_type{{71}, domain}}));
+
+    auto column = libjst::coverage(*std::ranges::next(actual.begin(), 2));
+    EXPECT_EQ(column.size(), 80u);
+    EXPECT_EQ(column.rank(50), 40u);
+    EXPECT_EQ(column.select(0), 10u);
+
+    value_type converted = *std::ranges::next(actual.begin());
+    EXPECT_TRUE(libjst::coverage(converted) == cov1);
+
+    { // serialisation
+        std::stringstream buffer{};
+        {
+            cereal::JSONOutputArchive oarch{buffer};
+            actual.save(oarch);
+        }
+
+        encoded_type encoded_in{};
+        {
+            cereal::JSONInputArchive iarch{buffer};
+            encoded_in.load(iarch);
+        }
+        expect_equal(encoded_in);
+    }
+}
+
+TEST_F(compressed_multisequence_test, hybrid_coverages) {
+    using hybrid_coverage_type = libjst::hybrid_coverage<uint32_t>;
+    using hybrid_type = libjst::dna_compressed_multisequence<source_type, hybrid_coverage_type>;
+    using value_type = std::ranges::range_value_t<test_type>;
+    using hybrid_value_type = std::ranges::range_value_t<hybrid_type>;
+
+    source_type src{"AAAAAAAAAAAAAAA"s};
+    coverage_domain_type domain{0, 100};
+    std::vector<std::vector<uint32_t>> ids{{0, 1, 70}, {3, 4, 99}};
+    std::vector<uint32_t> dense_ids{};
+    for (uint32_t id = 0; id < 100; id += 3)
+        dense_ids.push_back(id);
+    ids.push_back(dense_ids);
+
+    std::vector<std::pair<libjst::breakpoint, source_type>> alts{{libjst::breakpoint{1, 1}, "T"s},
+                                                                 {libjst::breakpoint{2, 5}, ""s},
+                                                                 {libjst::breakpoint{4, 0}, "CC"s},
+                                                                 {libjst::breakpoint{11, 2}, ""s}};
+    std::vector<value_type> deltas{};
+    std::vector<hybrid_value_type> hybrid_deltas{};
+    for (size_t i = 0; i < alts.size(); ++i) {
+        std::vector<uint32_t> const & delta_ids = ids[i % ids.size()];
+        deltas.emplace_back(alts[i].first, alts[i].second, coverage_type{delta_ids, domain});
+        hybrid_deltas.emplace_back(alts[i].first, alts[i].second, hybrid_coverage_type{delta_ids, domain});
+    }
+
+    test_type expected{src, domain, deltas};
+    hybrid_type actual{src, domain, hybrid_deltas};
+
+    ASSERT_EQ(actual.size(), expected.size());
+    auto actual_it = actual.begin();
+    for (auto && expected_delta : expected) {
+        EXPECT_EQ(libjst::low_breakend(*actual_it), libjst::low_breakend(expected_delta));
+        EXPECT_EQ(libjst::high_breakend(*actual_it), libjst::high_breakend(expected_delta));
+        EXPECT_TRUE(std::ranges::equal(libjst::alt_sequence(*actual_it), libjst::alt_sequence(expected_delta)));
+        auto const & expected_coverage = libjst::coverage(expected_delta);
+        for (uint32_t id = 0; id < 100; ++id)
+            EXPECT_EQ(libjst::coverage(*actual_it).contains(id), expected_coverage[id]) << id;
+        ++actual_it;
+    }
+
+    EXPECT_EQ(libjst::coverage(*actual.begin()).kind(), libjst::hybrid_coverage_kind::runs);
+    EXPECT_EQ(libjst::coverage(*std::ranges::next(actual.begin())).kind(), libjst::hybrid_coverage_kind::sparse);
+    EXPECT_TRUE(actual.has_conflicts(hybrid_value_type{libjst::breakpoint{1, 1}, "G"s,
+                                                       hybrid_coverage_type{{70}, domain}}));
+    EXPECT_FALSE(actual.has_conflicts(hybrid_value_type{libjst::breakpoint{1, 1}, "G"s,
+                                                        hybrid_coverage_type{{71}, domain}}));
+}
+
 TEST_F(compressed_multisequence_test, insert_snv) {
     source_type src{"AAAAAAAAAAAAAAA"s};
 
@@ -72,6 +541,40 @@ TEST_F(compressed_multisequence_test, insert_insertion) {
     EXPECT_EQ(libjst::coverage(*it), test_coverage);
 }
 
+TEST_F(compressed_multisequence_test, shared_insertions) {
+    using value_type = std::ranges::range_value_t<test_type>;
+
+    source_type src{"AAAAAAAAAAAAAAA"s};
+    coverage_domain_type domain{0, 10};
+    coverage_type cov1{{0, 1, 2}, domain};
+    coverage_type cov2{{3, 4}, domain};
+
+    std::vector<value_type> deltas{value_type{libjst::breakpoint{2, 0}, "TCGT"s, cov1},
+                                   value_type{libjst::breakpoint{5, 0}, "GG"s, cov2},
+                                   value_type{libjst::breakpoint{9, 0}, "TCGT"s, cov2}};
+
+    auto check = [] (test_type const & multisequence) {
+        auto first = libjst::alt_sequence(*std::ranges::next(multisequence.begin(), 1));
+        auto second = libjst::alt_sequence(*std::ranges::next(multisequence.begin(), 2));
+        auto third = libjst::alt_sequence(*std::ranges::next(multisequence.begin(), 3));
+        EXPECT_TRUE(std::ranges::equal(first, "TCGT"s));
+        EXPECT_TRUE(std::ranges::equal(second, "GG"s));
+        EXPECT_TRUE(std::ranges::equal(third, "TCGT"s));
+        EXPECT_EQ(first.data(), third.data());
+    };
+
+    { // bulk construction
+        check(test_type{src, domain, deltas});
+    }
+
+    { // insertion
+        test_type multisequence{src, domain};
+        for (value_type const & delta : deltas)
+            multisequence.insert(delta);
+        check(multisequence);
+    }
+}
+
 TEST_F(compressed_multisequence_test, insert_deletion) {
     source_type src{"AAAAAAAAAAAAAAA"s};
 
@@ -87,6 +590,43 @@ TEST_F(compressed_multisequence_test, insert_deletion) {
     EXPECT_EQ(libjst::coverage(*it), test_coverage);
 }
 
+TEST_F(compressed_multisequence_test, insert_before_deletion) {
+    source_type src{"AAAAAAAAAAAAAAA"s};
+
+    test_type multisequence{src, coverage_domain_type{0, 10}};
+
+    using value_type = std::ranges::range_value_t<test_type>;
+    coverage_type test_coverage{{0, 1, 2}, multisequence.coverage_domain()};
+
+    // Every later breakend is inserted before or between the mates of the first deletion.
+    multisequence.insert(value_type{libjst::breakpoint{6, 4}, ""s, test_coverage});
+    multisequence.insert(value_type{libjst::breakpoint{8, 1}, "C"s, test_coverage});
+    multisequence.insert(value_type{libjst::breakpoint{1, 2}, ""s, test_coverage});
+    multisequence.insert(value_type{libjst::breakpoint{0, 0}, "GG"s, test_coverage});
+
+    auto expect_mates = [] (test_type const & rcms) {
+        std::vector<std::pair<uint32_t, uint32_t>> deletions{};
+        for (auto it = rcms.begin(); it != rcms.end(); ++it) {
+            auto delta = *it;
+            if (libjst::alt_kind(delta) != libjst::alternate_sequence_kind::deletion)
+                continue;
+
+            auto mate = delta.jump_to_mate();
+            ASSERT_TRUE(mate.has_value());
+            EXPECT_EQ(libjst::get_breakpoint(**mate), libjst::get_breakpoint(delta));
+            EXPECT_EQ((**mate).jump_to_mate(), it);
+            deletions.emplace_back(libjst::low_breakend(delta), libjst::high_breakend(delta));
+        }
+        using deletion_t = std::pair<uint32_t, uint32_t>;
+        EXPECT_EQ(deletions, (std::vector<deletion_t>{{1, 3}, {1, 3}, {6, 10}, {6, 10}}));
+    };
+
+    expect_mates(multisequence);
+
+    test_type copied_multisequence{multisequence};
+    expect_mates(copied_multisequence);
+}
+
 TEST_F(compressed_multisequence_test, iterate) {
     source_type src{"AAAAAAAAAAAAAAA"s};
     using value_type = std::ranges::range_value_t<test_type>;
@@ -288,3 +828,40 @@ TEST_F(compressed_multisequence_test, serialise) {
     ++it;
     EXPECT_TRUE(it == rcms_in.end());
 }
+
+TEST_F(compressed_multisequence_test, serialise_indels) {
+    using value_type = std::ranges::range_value_t<test_type>;
+
+    source_type src{"AAAAAAAAAAAAAAA"s};
+    coverage_domain_type domain{0, 10};
+    coverage_type cov1{{0, 1, 2}, domain};
+    coverage_type cov2{{3, 4}, domain};
+
+    std::vector<value_type> deltas{value_type{libjst::breakpoint{1, 1}, "T"s, cov1},
+                                   value_type{libjst::breakpoint{2, 5}, ""s, cov2},
+                                   value_type{libjst::breakpoint{4, 0}, "CC"s, cov1},
+                                   value_type{libjst::breakpoint{11, 2}, ""s, cov1}};
+    test_type rcms_out{src, domain, deltas};
+
+    std::stringstream buffer{};
+    { // writing to output string stream
+        cereal::JSONOutputArchive oarch{buffer};
+        rcms_out.save(oarch);
+    }
+
+    test_type rcms_in{};
+    { // reading from input string stream
+        cereal::JSONInputArchive iarch{buffer};
+        rcms_in.load(iarch);
+    }
+
+    ASSERT_EQ(rcms_in.size(), rcms_out.size());
+    auto in_it = rcms_in.begin();
+    for (auto && expected : rcms_out) {
+        EXPECT_EQ(libjst::low_breakend(*in_it), libjst::low_breakend(expected));
+        EXPECT_EQ(libjst::high_breakend(*in_it), libjst::high_breakend(expected));
+        EXPECT_TRUE(std::ranges::equal(libjst::alt_sequence(*in_it), libjst::alt_sequence(expected)));
+        EXPECT_EQ(libjst::coverage(*in_it), libjst::coverage(expected));
+        ++in_it;
+    }
+}
@@ -0,0 +1,141 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+// Reads one const store from many threads at once; run in the Tsan build to check the concurrent read contract.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <stack>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/haplotype_viewer.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/sequence_tree/coloured_tree.hpp>
+#include <libjst/sequence_tree/labelled_tree.hpp>
+#include <libjst/sequence_tree/prune_tree.hpp>
+#include <libjst/sequence_tree/volatile_tree.hpp>
+
+using namespace std::literals;
+
+struct concurrent_read_test : public ::testing::Test {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using cms_type = libjst::dna_compressed_multisequence<std::string, coverage_type>;
+    using store_type = libjst::rcs_store<std::string, cms_type>;
+    using value_type = std::ranges::range_value_t<cms_type>;
+
+    static constexpr uint32_t haplotype_count{16};
+    static constexpr std::size_t thread_count{8};
+
+    store_type _store{};
+
+    void SetUp() override {
+        std::mt19937_64 generator{42};
+        std::string source(2000, 'A');
+        std::ranges::generate(source, [&] () { return "ACGT"[generator() % 4]; });
+
+        _store = store_type{source, haplotype_count};
+        auto domain = _store.variants().coverage_domain();
+        for (uint32_t position = 10; position + 10 < source.size(); position += 7 + generator() % 20) {
+            std::vector<uint32_t> haplotypes{static_cast<uint32_t>(generator() % haplotype_count)};
+            haplotypes.push_back((haplotypes.front() + 1 + generator() % (haplotype_count - 1)) % haplotype_count);
+            std::ranges::sort(haplotypes);
+
+            value_type variant = (generator() % 10 == 0) ?
+                value_type{libjst::breakpoint{position, 2u}, ""s, coverage_type{haplotypes, domain}} :
+                value_type{libjst::breakpoint{position, 1u}, std::string(1, source[position] == 'A' ? 'C' : 'A'),
+                           coverage_type{haplotypes, domain}};
+            if (!_store.variants().has_conflicts(variant))
+                _store.add(std::move(variant));
+        }
+        _store.build_position_index();
+        _store.build_variant_class_index();
+    }
+
+    // Spells the path sequences of all nodes of the pruned tree with contiguous labels.
+    std::string traverse(store_type const & store) const {
+        auto tree = libjst::volatile_tree{store} | libjst::coloured() | libjst::prune_in_place()
+                                                 | libjst::contiguous_labelled();
+        using node_t = libjst::tree_node_t<decltype(tree)>;
+
+        std::string spelled{};
+        std::stack<node_t> path{};
+        path.push(libjst::root(tree));
+        while (!path.empty()) {
+            node_t node = std::move(path.top());
+            path.pop();
+            std::span<char const> label = (*node).sequence();
+            spelled.append(label.begin(), label.end());
+
+            if (auto child = node.next_ref(); child.has_value())
+                path.push(std::move(*child));
+            if (auto child = node.next_alt(); child.has_value())
+                path.push(std::move(*child));
+        }
+        return spelled;
+    }
+
+    // Runs the function on all threads at once and returns the result of every thread.
+    template <typename fn_t>
+    auto run_concurrently(fn_t && fn) const {
+        std::vector<std::invoke_result_t<fn_t &>> results(thread_count);
+        std::vector<std::thread> threads{};
+        for (std::size_t idx = 0; idx < thread_count; ++idx)
+            threads.emplace_back([&, idx] () { results[idx] = fn(); });
+        for (std::thread & thread : threads)
+            thread.join();
+        return results;
+    }
+};
+
+TEST_F(concurrent_read_test, haplotypes) {
+    store_type const & store = _store;
+    libjst::haplotype_viewer viewer{store};
+    auto const expected = viewer.materialise_all();
+
+    auto results = run_concurrently([&] () {
+        auto haplotypes = viewer.materialise_all();
+        for (uint32_t haplotype = 0; haplotype < haplotype_count; ++haplotype) {
+            auto && sequence = viewer[haplotype];
+            if (!std::ranges::equal(sequence, haplotypes[haplotype]))
+                haplotypes[haplotype].clear();
+        }
+        return haplotypes;
+    });
+    for (auto const & haplotypes : results)
+        EXPECT_EQ(haplotypes, expected);
+}
+
+TEST_F(concurrent_read_test, lookups) {
+    store_type const & store = _store;
+    auto lookup_all = [&] () {
+        std::vector<std::size_t> indices{};
+        for (uint32_t position = 0; position < std::ranges::size(store.source()); position += 13)
+            indices.push_back(store.variants().lower_bound(position) - store.variants().begin());
+        indices.push_back(libjst::memory_usage(store));
+        return indices;
+    };
+    auto const expected = lookup_all();
+
+    for (auto const & indices : run_concurrently(lookup_all))
+        EXPECT_EQ(indices, expected);
+}
+
+TEST_F(concurrent_read_test, traversal) {
+    store_type const & store = _store;
+    std::string const expected = traverse(store);
+    EXPECT_FALSE(expected.empty());
+
+    for (auto const & spelled : run_concurrently([&] () { return traverse(store) + traverse(store); }))
+        EXPECT_EQ(spelled, expected + expected);
+}
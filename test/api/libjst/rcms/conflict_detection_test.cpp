@@ -0,0 +1,169 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/rcms/conflict_detection.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+
+using namespace std::literals;
+
+struct conflict_detection_test : public ::testing::Test {
+    using source_t = std::string;
+    using coverage_t = libjst::bit_coverage<uint32_t>;
+    using coverage_domain_t = libjst::coverage_domain_t<coverage_t>;
+    using cms_t = libjst::dna_compressed_multisequence<source_t, coverage_t>;
+    using value_t = std::ranges::range_value_t<cms_t>;
+
+    static constexpr uint32_t haplotype_count{90};
+    coverage_domain_t domain{0, haplotype_count};
+    source_t source{};
+
+    void SetUp() override {
+        std::mt19937 generator{3};
+        for (std::size_t idx = 0; idx < 2000; ++idx)
+            source.push_back("ACGT"[generator() % 4]);
+    }
+
+    // Random SNVs, insertions and deletions of up to 12 bases; the haplotypes are drawn with the given odds.
+    std::vector<value_t> random_variants(std::mt19937 & generator, std::size_t const count, unsigned const odds) const {
+        std::vector<value_t> variants{};
+        for (std::size_t idx = 0; idx < count; ++idx) {
+            uint32_t const position = generator() % (source.size() - 20) + 1;
+            std::vector<uint32_t> haplotypes{};
+            for (uint32_t haplotype = 0; haplotype < haplotype_count; ++haplotype)
+                if (generator() % odds == 0)
+                    haplotypes.push_back(haplotype);
+            if (haplotypes.empty())
+                haplotypes.push_back(generator() % haplotype_count);
+
+            switch (generator() % 3) {
+                case 0: variants.push_back(value_t{libjst::breakpoint{position, 1u},
+                                                   source_t{(source[position] == 'A') ? 'C' : 'A'},
+                                                   coverage_t{haplotypes, domain}});
+                        break;
+                case 1: variants.push_back(value_t{libjst::breakpoint{position, 0u}, "TT"s,
+                                                   coverage_t{haplotypes, domain}});
+                        break;
+                default: variants.push_back(value_t{libjst::breakpoint{position, 1 + generator() % 12u}, ""s,
+                                                    coverage_t{haplotypes, domain}});
+                         break;
+            }
+        }
+        std::ranges::stable_sort(variants, std::ranges::less{}, [] (value_t const & variant) {
+            return libjst::low_breakend(variant);
+        });
+        return variants;
+    }
+
+    static bool overlap(value_t const & lhs, value_t const & rhs) {
+        auto [first, second] = std::minmax(lhs, rhs, [] (value_t const & a, value_t const & b) {
+            return libjst::low_breakend(a) < libjst::low_breakend(b);
+        });
+        return libjst::low_breakend(first) == libjst::low_breakend(second) ||
+               libjst::low_breakend(second) < libjst::high_breakend(first);
+    }
+
+    // The conflicting haplotypes of every variant of the batch by comparing all pairs.
+    static std::set<std::pair<std::size_t, std::size_t>> expected_conflicts(std::vector<value_t> const & stored,
+                                                                            std::vector<value_t> const & batch) {
+        std::set<std::pair<std::size_t, std::size_t>> conflicts{};
+        auto add = [&] (std::size_t const index, value_t const & other) {
+            if (!overlap(batch[index], other))
+                return;
+            for (uint32_t haplotype = 0; haplotype < haplotype_count; ++haplotype)
+                if (libjst::covers(libjst::coverage(batch[index]), haplotype) &&
+                    libjst::covers(libjst::coverage(other), haplotype))
+                    conflicts.emplace(index, haplotype);
+        };
+        for (std::size_t index = 0; index < batch.size(); ++index) {
+            std::ranges::for_each(stored, [&] (value_t const & other) { add(index, other); });
+            for (std::size_t other = 0; other < batch.size(); ++other)
+                if (other != index)
+                    add(index, batch[other]);
+        }
+        return conflicts;
+    }
+};
+
+TEST_F(conflict_detection_test, snv_within_deletion) {
+    cms_t variants{source, domain};
+    variants.insert(value_t{libjst::breakpoint{10u, 20u}, ""s, coverage_t{{1, 2}, domain}});
+    variants.insert(value_t{libjst::breakpoint{50u, 1u}, "A"s, coverage_t{{3}, domain}});
+
+    std::vector<value_t> batch{
+        value_t{libjst::breakpoint{5u, 6u}, ""s, coverage_t{{3}, domain}}, // ends before the deletion
+        value_t{libjst::breakpoint{15u, 1u}, "C"s, coverage_t{{2, 4}, domain}}, // SNV within the stored deletion
+        value_t{libjst::breakpoint{30u, 1u}, "C"s, coverage_t{{1}, domain}}, // SNV behind the stored deletion
+        value_t{libjst::breakpoint{45u, 10u}, ""s, coverage_t{{3, 5}, domain}}, // deletion spanning the stored SNV
+        value_t{libjst::breakpoint{54u, 0u}, "GG"s, coverage_t{{5}, domain}}, // insertion within the batch deletion
+    };
+    EXPECT_FALSE(variants.has_conflicts(batch[1])); // does not share the position
+
+    std::vector<libjst::variant_conflict> conflicts = libjst::find_conflicts(variants, batch);
+    std::vector<libjst::variant_conflict> expected{
+        {.batch_index = 1, .haplotype = 2, .other_index = 1, .other_in_batch = false},
+        {.batch_index = 3, .haplotype = 3, .other_index = 3, .other_in_batch = false},
+        {.batch_index = 3, .haplotype = 5, .other_index = 4, .other_in_batch = true},
+        {.batch_index = 4, .haplotype = 5, .other_index = 3, .other_in_batch = true},
+    };
+    EXPECT_EQ(conflicts, expected);
+}
+
+TEST_F(conflict_detection_test, same_position) {
+    cms_t variants{source, domain};
+    variants.insert(value_t{libjst::breakpoint{4u, 1u}, "G"s, coverage_t{{0}, domain}});
+
+    std::vector<value_t> batch{value_t{libjst::breakpoint{4u, 1u}, "C"s, coverage_t{{0, 1}, domain}},
+                               value_t{libjst::breakpoint{4u, 0u}, "T"s, coverage_t{{1}, domain}}};
+    std::vector<libjst::variant_conflict> conflicts = libjst::find_conflicts(variants, batch);
+    ASSERT_EQ(conflicts.size(), 3u);
+    EXPECT_EQ(conflicts[0], (libjst::variant_conflict{0, 0, 1, false}));
+    EXPECT_EQ(conflicts[1], (libjst::variant_conflict{0, 1, 1, true})); // both variants of the batch are reported
+    EXPECT_EQ(conflicts[2], (libjst::variant_conflict{1, 1, 0, true}));
+}
+
+TEST_F(conflict_detection_test, random) {
+    std::mt19937 generator{17};
+    for (std::size_t round = 0; round < 10; ++round) {
+        // Stored variants of rare haplotypes, which may conflict among each other, and a batch of common ones.
+        std::vector<value_t> stored = random_variants(generator, 80, 30);
+        std::vector<value_t> batch = random_variants(generator, 60, 10);
+        cms_t variants{source, domain, stored};
+
+        std::set<std::pair<std::size_t, std::size_t>> actual{};
+        for (libjst::variant_conflict const & conflict : libjst::find_conflicts(variants, batch)) {
+            actual.emplace(conflict.batch_index, conflict.haplotype);
+            if (conflict.other_in_batch) {
+                EXPECT_TRUE(overlap(batch[conflict.batch_index], batch[conflict.other_index]));
+            }
+        }
+        EXPECT_EQ(actual, expected_conflicts(stored, batch)) << "round " << round;
+    }
+}
+
+TEST_F(conflict_detection_test, invalid_batch) {
+    cms_t variants{source, domain};
+    std::vector<value_t> unsorted{value_t{libjst::breakpoint{9u, 1u}, "C"s, coverage_t{{0}, domain}},
+                                  value_t{libjst::breakpoint{4u, 1u}, "C"s, coverage_t{{1}, domain}}};
+    EXPECT_THROW(libjst::find_conflicts(variants, unsorted), std::invalid_argument);
+
+    std::vector<value_t> other_domain{value_t{libjst::breakpoint{4u, 1u}, "C"s,
+                                              coverage_t{{0}, coverage_domain_t{0, haplotype_count + 1}}}};
+    EXPECT_THROW(libjst::find_conflicts(variants, other_domain), std::domain_error);
+    EXPECT_TRUE(libjst::find_conflicts(variants, std::vector<value_t>{}).empty());
+}
@@ -7,6 +7,8 @@
 
 #include <gtest/gtest.h>
 
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/coverage/bit_coverage_pool.hpp>
 #include <libjst/rcms/contiguous_multimap.hpp>
 
 struct contiguous_multimap_test : public ::testing::Test {
@@ -103,3 +105,40 @@ TEST_F(contiguous_multimap_test, size) {
     map.insert(value_type{4, 3});
     EXPECT_EQ(std::ranges::size(map), 3u);
 }
+
+TEST_F(contiguous_multimap_test, coverage_pool) {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using coverage_domain_type = libjst::coverage_domain_t<coverage_type>;
+    using pooled_map_type = libjst::contiguous_multimap<key_type, coverage_type, libjst::bit_coverage_pool<uint32_t>>;
+    using pooled_value_type = std::ranges::range_value_t<pooled_map_type>;
+
+    EXPECT_TRUE(std::ranges::random_access_range<pooled_map_type>);
+
+    coverage_domain_type domain{0, 70};
+    coverage_type cov0{{0, 69}, domain};
+    coverage_type cov1{{1}, domain};
+    coverage_type cov2{{2, 64}, domain};
+
+    pooled_map_type map{};
+    auto it = map.insert(pooled_value_type{10, cov0});
+    EXPECT_EQ(it->first, 10u);
+    EXPECT_TRUE(it->second == cov0);
+    map.insert(pooled_value_type{25, cov1});
+    map.emplace_hint(map.begin(), 3, cov2);
+
+    it = map.begin();
+    EXPECT_EQ(it->first, 3u);
+    EXPECT_TRUE(it->second == cov2);
+    ++it;
+    EXPECT_EQ(it->first, 10u);
+    EXPECT_TRUE(it->second == cov0);
+    ++it;
+    EXPECT_EQ(it->first, 25u);
+    EXPECT_TRUE(it->second == cov1);
+    ++it;
+    EXPECT_TRUE(it == map.end());
+
+    pooled_value_type value = *map.begin();
+    EXPECT_EQ(value.first, 3u);
+    EXPECT_TRUE(value.second == cov2);
+}
@@ -0,0 +1,87 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/elias_fano_key_store.hpp>
+#include <libjst/rcms/mapped_compressed_multisequence.hpp>
+
+using namespace std::literals;
+
+struct elias_fano_key_store_test : public ::testing::Test {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using coverage_domain_type = libjst::coverage_domain_t<coverage_type>;
+    using cms_type = libjst::dna_compressed_multisequence<std::string, coverage_type>;
+    using value_type = std::ranges::range_value_t<cms_type>;
+    using test_type = libjst::elias_fano_key_store<>;
+
+    coverage_domain_type domain{0, 10};
+    cms_type multisequence{"AAAAAAAAAAAAAAA"s, domain,
+                           std::vector<value_type>{
+                                value_type{libjst::breakpoint{1, 1}, "T"s, coverage_type{{0, 1, 2}, domain}},
+                                value_type{libjst::breakpoint{2, 4}, ""s, coverage_type{{3, 4}, domain}},
+                                value_type{libjst::breakpoint{4, 0}, "CC"s, coverage_type{{0, 1, 2}, domain}},
+                                value_type{libjst::breakpoint{4, 1}, "G"s, coverage_type{{5, 9}, domain}},
+                                value_type{libjst::breakpoint{8, 3}, ""s, coverage_type{{5, 9}, domain}},
+                                value_type{libjst::breakpoint{10, 0}, "GTA"s, coverage_type{{6}, domain}},
+                                value_type{libjst::breakpoint{12, 1}, "C"s, coverage_type{{3, 4}, domain}}}};
+
+    template <typename multisequence_t>
+    static void check(test_type const & keys, multisequence_t const & expected) {
+        ASSERT_EQ(keys.size(), std::ranges::size(expected));
+        auto expected_it = expected.begin();
+        for (std::size_t offset = 0; offset < keys.size(); ++offset, ++expected_it) {
+            EXPECT_EQ(keys[offset], (*expected_it).get_key()) << offset;
+            EXPECT_EQ(keys.position(offset), (*expected_it).get_key().position()) << offset;
+        }
+
+        for (std::size_t position = 0; position <= std::ranges::size(expected.source()) + 1; ++position) {
+            std::size_t lower{};
+            std::size_t upper{};
+            for (auto && breakend : expected) {
+                lower += breakend.get_key().position() < position;
+                upper += breakend.get_key().position() <= position;
+            }
+            EXPECT_EQ(keys.lower_bound(position), lower) << position;
+            EXPECT_EQ(keys.upper_bound(position), upper) << position;
+        }
+    }
+};
+
+TEST_F(elias_fano_key_store_test, default_construction) {
+    test_type keys{};
+    EXPECT_TRUE(keys.empty());
+    EXPECT_EQ(keys.size(), 0u);
+}
+
+TEST_F(elias_fano_key_store_test, from_multisequence) {
+    check(test_type{multisequence}, multisequence);
+}
+
+TEST_F(elias_fano_key_store_test, from_frozen_multisequence) {
+    auto frozen = libjst::freeze(multisequence);
+    check(test_type{frozen}, frozen);
+}
+
+TEST_F(elias_fano_key_store_test, memory_usage) {
+    std::vector<value_type> deltas{};
+    std::string source(1 << 16, 'A');
+    coverage_type coverage{{1}, domain};
+    for (uint32_t position = 0; position < source.size(); position += 16)
+        deltas.emplace_back(libjst::breakpoint{position, 1}, "ACGT"s.substr(position % 4, 1), coverage);
+    cms_type dense{source, domain, deltas};
+    test_type keys{dense};
+
+    check(keys, dense);
+    EXPECT_LT(keys.memory_usage() * 8, keys.size() * 11); // about ten bits per key
+}
@@ -0,0 +1,172 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <stack>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/federated_store.hpp>
+#include <libjst/rcms/haplotype_viewer.hpp>
+#include <libjst/rcms/interior_breakends.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/sequence_tree/coloured_tree.hpp>
+#include <libjst/sequence_tree/prune_tree.hpp>
+#include <libjst/sequence_tree/volatile_tree.hpp>
+
+using namespace std::literals;
+
+struct federated_store_test : public ::testing::Test {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using cms_type = libjst::dna_compressed_multisequence<std::string, coverage_type>;
+    using store_type = libjst::rcs_store<std::string, cms_type>;
+    using value_type = std::ranges::range_value_t<cms_type>;
+    using federation_type = libjst::federated_store<std::string, cms_type>;
+
+    static constexpr uint32_t shared_position{5};
+
+    std::string source{};
+    std::vector<store_type> cohorts{};
+
+    void SetUp() override {
+        std::mt19937_64 generator{42};
+        source.resize(500);
+        std::ranges::generate(source, [&] () { return "ACGT"[generator() % 4]; });
+
+        for (uint32_t const haplotype_count : {3u, 8u, 5u}) {
+            store_type & cohort = cohorts.emplace_back(source, haplotype_count);
+            auto domain = cohort.variants().coverage_domain();
+            // The same SNV is carried by the first haplotype of every cohort.
+            cohort.add(value_type{libjst::breakpoint{shared_position, 1u},
+                                  std::string(1, source[shared_position] == 'A' ? 'C' : 'A'),
+                                  coverage_type{{0u}, domain}});
+            for (uint32_t position = 20; position + 10 < source.size(); position += 9 + generator() % 30) {
+                std::vector<uint32_t> haplotypes{static_cast<uint32_t>(generator() % haplotype_count)};
+                value_type variant = (generator() % 8 == 0) ?
+                    value_type{libjst::breakpoint{position, 3u}, ""s, coverage_type{haplotypes, domain}} :
+                    value_type{libjst::breakpoint{position, 1u}, std::string(1, source[position] == 'A' ? 'G' : 'A'),
+                               coverage_type{haplotypes, domain}};
+                if (!cohort.variants().has_conflicts(variant))
+                    cohort.add(std::move(variant));
+            }
+        }
+    }
+
+    // The low breakends of the variants, i.e. one per variant.
+    static std::size_t variant_count(store_type const & store) {
+        return std::ranges::count_if(libjst::interior_breakends(store.variants()), [] (auto && breakend) {
+            return breakend.get_breakpoint_end() == libjst::breakpoint_end::low;
+        });
+    }
+
+    static std::vector<uint32_t> members(coverage_type const & coverage) {
+        std::vector<uint32_t> ids{};
+        libjst::for_each_covered(coverage, 0, coverage.size(), [&] (std::size_t const id) { ids.push_back(id); });
+        return ids;
+    }
+};
+
+TEST_F(federated_store_test, rows)
+{
+    federation_type federation{source, cohorts};
+
+    EXPECT_EQ(federation.cohort_count(), 3u);
+    EXPECT_EQ(federation.store().size(), 16u);
+    EXPECT_EQ(federation.cohort_rows(0).min(), 0u);
+    EXPECT_EQ(federation.cohort_rows(1).min(), 3u);
+    EXPECT_EQ(federation.cohort_rows(2).min(), 11u);
+    EXPECT_EQ(federation.cohort_rows(2).max(), 16u);
+    EXPECT_EQ(federation.cohort_of(0), 0u);
+    EXPECT_EQ(federation.cohort_of(2), 0u);
+    EXPECT_EQ(federation.cohort_of(3), 1u);
+    EXPECT_EQ(federation.cohort_of(10), 1u);
+    EXPECT_EQ(federation.cohort_of(15), 2u);
+}
+
+TEST_F(federated_store_test, haplotypes)
+{
+    federation_type federation{source, cohorts};
+
+    std::vector<std::vector<char>> expected{};
+    for (store_type const & cohort : cohorts)
+        std::ranges::copy(libjst::haplotype_viewer{cohort}.materialise_all(), std::back_inserter(expected));
+
+    EXPECT_EQ(libjst::haplotype_viewer{federation.store()}.materialise_all(), expected);
+}
+
+TEST_F(federated_store_test, shared_variants)
+{
+    federation_type federation{source, cohorts};
+
+    std::size_t cohort_variant_count{};
+    for (store_type const & cohort : cohorts)
+        cohort_variant_count += variant_count(cohort);
+    // The shared SNV is stored once instead of once per cohort; other variants may coincide by chance.
+    EXPECT_LE(variant_count(federation.store()), cohort_variant_count - 2);
+
+    auto interior = libjst::interior_breakends(federation.store().variants());
+    auto shared = std::ranges::find_if(interior, [] (auto && breakend) {
+        return libjst::position(breakend) == shared_position;
+    });
+    ASSERT_NE(shared, interior.end());
+    value_type shared_variant = *shared;
+    EXPECT_EQ(members(libjst::coverage(shared_variant)), (std::vector<uint32_t>{0, 3, 11}));
+    for (std::size_t cohort_id = 0; cohort_id < federation.cohort_count(); ++cohort_id) {
+        coverage_type cohort_coverage = federation.cohort_coverage(libjst::coverage(shared_variant), cohort_id);
+        EXPECT_EQ(members(cohort_coverage), (std::vector<uint32_t>{0}));
+        EXPECT_EQ(cohort_coverage.get_domain(), cohorts[cohort_id].variants().coverage_domain());
+        EXPECT_TRUE(federation.covers_cohort(libjst::coverage(shared_variant), cohort_id));
+    }
+}
+
+TEST_F(federated_store_test, coloured_traversal)
+{
+    federation_type federation{source, cohorts};
+
+    auto tree = libjst::volatile_tree{federation.store()} | libjst::coloured() | libjst::prune();
+    using node_t = libjst::tree_node_t<decltype(tree)>;
+
+    std::stack<node_t> path{};
+    path.push(libjst::root(tree));
+    std::size_t node_count{};
+    while (!path.empty()) {
+        node_t node = std::move(path.top());
+        path.pop();
+        ++node_count;
+
+        auto const & coverage = (*node).coverage();
+        std::size_t covered_rows{};
+        for (std::size_t cohort_id = 0; cohort_id < federation.cohort_count(); ++cohort_id) {
+            coverage_type cohort_coverage = federation.cohort_coverage(coverage, cohort_id);
+            EXPECT_EQ(cohort_coverage.any(), federation.covers_cohort(coverage, cohort_id));
+            covered_rows += members(cohort_coverage).size();
+        }
+        EXPECT_EQ(covered_rows, members(coverage).size());
+
+        if (auto child = node.next_ref(); child.has_value())
+            path.push(std::move(*child));
+        if (auto child = node.next_alt(); child.has_value())
+            path.push(std::move(*child));
+    }
+    EXPECT_GT(node_count, 1u);
+}
+
+TEST_F(federated_store_test, different_source)
+{
+    std::string other_source = source;
+    other_source[0] = other_source[0] == 'A' ? 'C' : 'A';
+    cohorts.emplace_back(other_source, 2u);
+
+    EXPECT_THROW((federation_type{source, cohorts}), std::invalid_argument);
+}
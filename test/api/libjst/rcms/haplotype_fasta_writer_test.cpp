@@ -0,0 +1,229 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/haplotype_fasta_writer.hpp>
+#include <libjst/rcms/haplotype_viewer.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/rcms/region_viewer.hpp>
+
+namespace jst::test::haplotype_fasta_writer {
+
+using source_t = std::string;
+
+struct test : public ::testing::Test {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using coverage_domain_type = libjst::coverage_domain_t<coverage_type>;
+
+    using cms_t = libjst::dna_compressed_multisequence<source_t, coverage_type>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+    using rcs_store_t = libjst::rcs_store<source_t, cms_t>;
+    using writer_t = libjst::haplotype_fasta_writer<rcs_store_t>;
+
+    static constexpr uint32_t haplotype_count{150};
+
+    source_t _source{};
+    rcs_store_t _store;
+    std::vector<std::vector<char>> _haplotypes{};
+
+    void SetUp() override {
+        std::mt19937 generator{31};
+        for (std::size_t idx = 0; idx < 3000; ++idx)
+            _source.push_back("ACGT"[generator() % 4]);
+
+        _store = rcs_store_t{_source, haplotype_count};
+        coverage_domain_type domain = _store.variants().coverage_domain();
+        for (uint32_t position = 2; position + 4 < _source.size(); position += 5) {
+            std::vector<uint32_t> haplotypes{};
+            for (uint32_t haplotype = 0; haplotype < haplotype_count; ++haplotype)
+                if (generator() % 4 == 0)
+                    haplotypes.push_back(haplotype);
+            if (haplotypes.empty())
+                continue;
+
+            switch (position % 3) {
+                case 0: _store.add(cms_value_t{libjst::breakpoint{position, 1u},
+                                               source_t{(_source[position] == 'A') ? 'C' : 'A'},
+                                               coverage_type{haplotypes, domain}});
+                        break;
+                case 1: _store.add(cms_value_t{libjst::breakpoint{position, 0u}, "GT",
+                                               coverage_type{haplotypes, domain}});
+                        break;
+                default: _store.add(cms_value_t{libjst::breakpoint{position, 2u}, "",
+                                                coverage_type{haplotypes, domain}});
+                         break;
+            }
+        }
+        _haplotypes = libjst::haplotype_viewer{_store}.materialise_all();
+    }
+
+    static std::string fasta(std::string const & name, std::vector<char> const & sequence, std::size_t line_width) {
+        std::string record = ">" + name + "\n";
+        for (std::size_t idx = 0; idx < sequence.size(); ++idx) {
+            record.push_back(sequence[idx]);
+            if ((line_width != 0 && (idx + 1) % line_width == 0) || idx + 1 == sequence.size())
+                record.push_back('\n');
+        }
+        return record;
+    }
+
+    std::string expected(std::vector<std::size_t> const & ids, std::size_t line_width = 60) const {
+        std::string records{};
+        for (std::size_t id : ids)
+            records += fasta("haplotype_" + std::to_string(id), _haplotypes[id], line_width);
+        return records;
+    }
+};
+
+} // namespace jst::test::haplotype_fasta_writer
+
+using haplotype_fasta_writer_test = jst::test::haplotype_fasta_writer::test;
+
+TEST_F(haplotype_fasta_writer_test, write_all) {
+    std::vector<std::size_t> ids(haplotype_count);
+    std::iota(ids.begin(), ids.end(), 0);
+
+    for (std::size_t thread_count : {1u, 4u}) {
+        for (std::size_t batch_size : {1u, 7u, 64u, 1000u}) {
+            std::ostringstream stream{};
+            writer_t writer{_store, stream, {.thread_count = thread_count, .batch_size = batch_size}};
+            writer.write(ids);
+            writer.close();
+            EXPECT_EQ(stream.str(), expected(ids)) << thread_count << " threads, batch size " << batch_size;
+        }
+    }
+}
+
+TEST_F(haplotype_fasta_writer_test, scattered_ids) {
+    // Repeated ids and batches spanning too many ids for a single sweep.
+    std::vector<std::size_t> ids{149, 0, 75, 3, 3, 4, 5, 6, 140, 2, 2};
+    for (std::size_t batch_size : {2u, 3u, 16u}) {
+        std::ostringstream stream{};
+        writer_t writer{_store, stream, {.thread_count = 3, .batch_size = batch_size}};
+        writer.write(ids);
+        writer.close();
+        EXPECT_EQ(stream.str(), expected(ids)) << "batch size " << batch_size;
+    }
+}
+
+TEST_F(haplotype_fasta_writer_test, line_width_and_names) {
+    std::vector<std::size_t> ids{10, 11, 12};
+    for (std::size_t line_width : {0u, 1u, 80u}) {
+        std::ostringstream stream{};
+        writer_t writer{_store, stream, {.line_width = line_width},
+                        [] (std::size_t id) { return "sample" + std::to_string(id / 2) + "_" + std::to_string(id % 2); }};
+        writer.write(ids);
+        writer.close();
+
+        std::string records{};
+        for (std::size_t id : ids)
+            records += fasta("sample" + std::to_string(id / 2) + "_" + std::to_string(id % 2), _haplotypes[id],
+                             line_width);
+        EXPECT_EQ(stream.str(), records) << "line width " << line_width;
+    }
+}
+
+TEST_F(haplotype_fasta_writer_test, write_region) {
+    libjst::region_viewer viewer{_store};
+    std::vector<std::size_t> ids{0, 5, 149, 5, 77};
+    for (auto [first, last] : {std::pair{0u, 100u}, {1234u, 1500u}, {2950u, 4000u}, {700u, 700u}}) {
+        std::ostringstream stream{};
+        writer_t writer{_store, stream, {.line_width = 50, .thread_count = 2, .batch_size = 2}};
+        writer.write_region(ids, first, last);
+        writer.close();
+
+        std::size_t const clamped_last = std::min<std::size_t>(last, _source.size());
+        std::vector<std::vector<char>> sequences(haplotype_count);
+        for (auto const & group : viewer(first, last))
+            for (uint32_t id = 0; id < haplotype_count; ++id)
+                if (libjst::covers(group.coverage, id))
+                    sequences[id] = group.sequence;
+
+        std::string records{};
+        for (std::size_t id : ids)
+            records += fasta("haplotype_" + std::to_string(id) + ":" + std::to_string(first) + "-" +
+                             std::to_string(clamped_last), sequences[id], 50);
+        EXPECT_EQ(stream.str(), records) << "region [" << first << ", " << last << ")";
+    }
+}
+
+TEST_F(haplotype_fasta_writer_test, invalid) {
+    std::ostringstream stream{};
+    writer_t writer{_store, stream};
+    std::vector<std::size_t> ids{0, haplotype_count};
+    EXPECT_THROW(writer.write(ids), std::out_of_range);
+    EXPECT_THROW(writer.write_region(ids, 0, 10), std::out_of_range);
+    EXPECT_THROW(writer.write_region(std::vector<std::size_t>{0}, 20, 10), std::out_of_range);
+
+    writer.close();
+    EXPECT_NO_THROW(writer.close());
+    EXPECT_THROW(writer.write(std::vector<std::size_t>{0}), std::logic_error);
+}
+
+#if LIBJST_HAS_ZLIB
+#include <zlib.h>
+
+TEST_F(haplotype_fasta_writer_test, bgzip) {
+    std::vector<std::size_t> ids(haplotype_count);
+    std::iota(ids.begin(), ids.end(), 0);
+
+    std::ostringstream stream{};
+    {
+        writer_t writer{_store, stream, {.thread_count = 4, .batch_size = 16, .bgzip = true}};
+        writer.write(ids);
+    } // closed by the destructor
+    std::string const compressed = stream.str();
+    ASSERT_GE(compressed.size(), libjst::bgzf_codec::eof_block.size());
+    EXPECT_TRUE(std::ranges::equal(std::string_view{compressed}.substr(compressed.size() - 28),
+                                   libjst::bgzf_codec::eof_block,
+                                   [] (char lhs, uint8_t rhs) { return static_cast<uint8_t>(lhs) == rhs; }));
+
+    // Every member is a complete gzip stream of at most 64 KiB announcing its size in the BC extra field.
+    std::string inflated{};
+    std::size_t member_begin{};
+    while (member_begin < compressed.size()) {
+        ASSERT_EQ(compressed[member_begin + 12], 'B');
+        ASSERT_EQ(compressed[member_begin + 13], 'C');
+        std::size_t const member_size = static_cast<uint8_t>(compressed[member_begin + 16]) +
+                                        (static_cast<std::size_t>(static_cast<uint8_t>(compressed[member_begin + 17])) << 8) + 1;
+
+        z_stream zs{};
+        ASSERT_EQ(inflateInit2(&zs, 31), Z_OK);
+        std::vector<char> buffer(0x10000);
+        zs.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(compressed.data() + member_begin));
+        zs.avail_in = static_cast<uInt>(member_size);
+        zs.next_out = reinterpret_cast<Bytef *>(buffer.data());
+        zs.avail_out = static_cast<uInt>(buffer.size());
+        EXPECT_EQ(inflate(&zs, Z_FINISH), Z_STREAM_END);
+        EXPECT_EQ(zs.avail_in, 0u);
+        inflated.append(buffer.data(), zs.total_out);
+        inflateEnd(&zs);
+        member_begin += member_size;
+    }
+    EXPECT_EQ(member_begin, compressed.size());
+    EXPECT_EQ(inflated, expected(ids));
+}
+#else
+TEST_F(haplotype_fasta_writer_test, bgzip_without_zlib) {
+    std::ostringstream stream{};
+    EXPECT_THROW((writer_t{_store, stream, {.bgzip = true}}), std::logic_error);
+}
+#endif
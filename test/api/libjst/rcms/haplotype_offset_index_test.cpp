@@ -0,0 +1,173 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/haplotype_offset_index.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+
+namespace jst::test::haplotype_offset_index {
+
+using source_t = std::string;
+
+struct test : public ::testing::Test {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using coverage_domain_type = libjst::coverage_domain_t<coverage_type>;
+
+    using cms_t = libjst::dna_compressed_multisequence<source_t, coverage_type>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+    using rcs_store_t = libjst::rcs_store<source_t, cms_t>;
+
+    struct applied_variant {
+        libjst::breakpoint breakpoint{};
+        source_t alt{};
+        coverage_type coverage{};
+        std::vector<std::size_t> positions{}; // the position of the alternate sequence within every haplotype
+    };
+
+    static constexpr uint32_t haplotype_count{70};
+
+    source_t _source{};
+    rcs_store_t _store;
+    std::vector<applied_variant> _variants{};
+    std::vector<std::vector<std::optional<std::size_t>>> _expected{}; // the haplotype position of every source symbol
+
+    // Non-overlapping SNVs, insertions and deletions spaced such that every haplotype can contain all of them.
+    void SetUp() override {
+        std::mt19937 generator{42};
+        for (std::size_t idx = 0; idx < 400; ++idx)
+            _source.push_back("ACGT"[generator() % 4]);
+
+        _store = rcs_store_t{_source, haplotype_count};
+        coverage_domain_type domain = _store.variants().coverage_domain();
+
+        for (uint32_t position = 2; position + 4 < _source.size(); position += 5) {
+            std::vector<uint32_t> haplotypes{};
+            for (uint32_t haplotype = 0; haplotype < haplotype_count; ++haplotype)
+                if (generator() % 3 == 0)
+                    haplotypes.push_back(haplotype);
+            if (haplotypes.empty())
+                continue;
+
+            libjst::breakpoint breakpoint{position, 1u};
+            source_t alt{};
+            switch (position % 3) {
+                case 0: alt.push_back((_source[position] == 'A') ? 'C' : 'A'); break;
+                case 1: breakpoint = libjst::breakpoint{position, 0u}; alt = "GTA"; break;
+                default: breakpoint = libjst::breakpoint{position, 3u}; break;
+            }
+            coverage_type coverage{haplotypes, domain};
+            _store.add(cms_value_t{breakpoint, alt, coverage});
+            _variants.push_back(applied_variant{breakpoint, alt, std::move(coverage), {}});
+        }
+
+        _expected.assign(haplotype_count, std::vector<std::optional<std::size_t>>(_source.size()));
+        for (auto & variant : _variants)
+            variant.positions.resize(haplotype_count);
+        for (uint32_t haplotype = 0; haplotype < haplotype_count; ++haplotype) {
+            std::size_t haplotype_position{};
+            std::size_t source_position{};
+            for (auto & variant : _variants) {
+                if (!variant.coverage[haplotype])
+                    continue;
+                for (; source_position < libjst::low_breakend(variant.breakpoint); ++source_position)
+                    _expected[haplotype][source_position] = haplotype_position++;
+                variant.positions[haplotype] = haplotype_position;
+                haplotype_position += variant.alt.size();
+                source_position = libjst::high_breakend(variant.breakpoint);
+            }
+            for (; source_position < _source.size(); ++source_position)
+                _expected[haplotype][source_position] = haplotype_position++;
+        }
+    }
+};
+
+} // namespace jst::test::haplotype_offset_index
+
+using haplotype_offset_index_test = jst::test::haplotype_offset_index::test;
+
+TEST_F(haplotype_offset_index_test, construct) {
+    libjst::haplotype_offset_index index{_store};
+    EXPECT_EQ(index.size(), haplotype_count);
+    EXPECT_EQ(index.sample_interval(), 64u);
+
+    for (uint32_t haplotype = 0; haplotype < haplotype_count; ++haplotype) {
+        std::size_t const expected_count = std::ranges::count_if(_variants, [&] (auto const & variant) {
+            return static_cast<bool>(variant.coverage[haplotype]);
+        });
+        EXPECT_EQ(index.variant_count(haplotype), expected_count) << "haplotype " << haplotype;
+    }
+
+    EXPECT_THROW((libjst::haplotype_offset_index{_store, 0}), std::invalid_argument);
+}
+
+TEST_F(haplotype_offset_index_test, source_position) {
+    for (std::size_t sample_interval : {1u, 3u, 16u, 64u}) {
+        libjst::haplotype_offset_index index{_store, sample_interval};
+        for (uint32_t haplotype = 0; haplotype < haplotype_count; ++haplotype)
+            for (std::size_t position = 0; position < _source.size(); ++position)
+                EXPECT_EQ(index.to_haplotype(haplotype, position), _expected[haplotype][position])
+                    << sample_interval << " " << haplotype << " " << position;
+    }
+}
+
+TEST_F(haplotype_offset_index_test, alt_position) {
+    for (std::size_t sample_interval : {1u, 5u, 64u}) {
+        libjst::haplotype_offset_index index{_store, sample_interval};
+        for (auto const & variant : _variants) {
+            for (uint32_t haplotype = 0; haplotype < haplotype_count; ++haplotype) {
+                if (!variant.coverage[haplotype])
+                    continue;
+                for (std::size_t offset = 0; offset < variant.alt.size(); ++offset)
+                    EXPECT_EQ(index.to_haplotype(haplotype, variant.breakpoint, offset),
+                              variant.positions[haplotype] + offset) << sample_interval << " " << haplotype;
+            }
+        }
+    }
+}
+
+TEST_F(haplotype_offset_index_test, for_each_position) {
+    libjst::haplotype_offset_index index{_store, 4};
+    coverage_type all_haplotypes{std::views::iota(0u, haplotype_count), _store.variants().coverage_domain()};
+    for (std::size_t position = 0; position < _source.size(); position += 7) {
+        std::vector<std::pair<std::size_t, std::size_t>> expected{};
+        for (uint32_t haplotype = 0; haplotype < haplotype_count; ++haplotype)
+            if (_expected[haplotype][position])
+                expected.emplace_back(haplotype, *_expected[haplotype][position]);
+
+        std::vector<std::pair<std::size_t, std::size_t>> actual{};
+        index.for_each_position(all_haplotypes, position, [&] (std::size_t const haplotype, std::size_t const pos) {
+            actual.emplace_back(haplotype, pos);
+        });
+        EXPECT_EQ(actual, expected) << position;
+    }
+
+    for (auto const & variant : _variants) {
+        std::vector<std::pair<std::size_t, std::size_t>> expected{};
+        for (uint32_t haplotype = 0; haplotype < haplotype_count; ++haplotype)
+            if (variant.coverage[haplotype])
+                expected.emplace_back(haplotype, variant.positions[haplotype]);
+
+        std::vector<std::pair<std::size_t, std::size_t>> actual{};
+        index.for_each_position(variant.coverage, variant.breakpoint, 0, [&] (std::size_t const haplotype,
+                                                                               std::size_t const pos) {
+            actual.emplace_back(haplotype, pos);
+        });
+        EXPECT_EQ(actual, expected);
+    }
+}
@@ -0,0 +1,168 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/haplotype_viewer.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+
+namespace jst::test::haplotype_viewer {
+
+using source_t = std::string;
+
+struct test : public ::testing::Test {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using coverage_domain_type = libjst::coverage_domain_t<coverage_type>;
+
+    using cms_t = libjst::dna_compressed_multisequence<source_t, coverage_type>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+    using rcs_store_t = libjst::rcs_store<source_t, cms_t>;
+
+    static constexpr uint32_t haplotype_count{150};
+
+    source_t _source{};
+    rcs_store_t _store;
+    std::vector<std::vector<char>> _expected{};
+
+    // Non-overlapping SNVs, insertions and deletions spaced such that every haplotype can contain all of them.
+    void SetUp() override {
+        std::mt19937 generator{23};
+        for (std::size_t idx = 0; idx < 600; ++idx)
+            _source.push_back("ACGT"[generator() % 4]);
+
+        _store = rcs_store_t{_source, haplotype_count};
+        coverage_domain_type domain = _store.variants().coverage_domain();
+
+        std::vector<std::vector<std::pair<libjst::breakpoint, source_t>>> applied(haplotype_count);
+        for (uint32_t position = 2; position + 4 < _source.size(); position += 5) {
+            std::vector<uint32_t> haplotypes{};
+            for (uint32_t haplotype = 0; haplotype < haplotype_count; ++haplotype)
+                if (generator() % 4 == 0)
+                    haplotypes.push_back(haplotype);
+            if (haplotypes.empty())
+                continue;
+
+            libjst::breakpoint breakpoint{position, 1u};
+            source_t alt{};
+            switch (position % 3) {
+                case 0: alt.push_back((_source[position] == 'A') ? 'C' : 'A'); break;
+                case 1: breakpoint = libjst::breakpoint{position, 0u}; alt = "GT"; break;
+                default: breakpoint = libjst::breakpoint{position, 2u}; break;
+            }
+            _store.add(cms_value_t{breakpoint, alt, coverage_type{haplotypes, domain}});
+            for (uint32_t haplotype : haplotypes)
+                applied[haplotype].emplace_back(breakpoint, alt);
+        }
+
+        for (auto const & variants : applied) {
+            source_t haplotype{};
+            std::size_t source_position{};
+            for (auto const & [breakpoint, alt] : variants) {
+                haplotype.append(_source, source_position, libjst::low_breakend(breakpoint) - source_position);
+                haplotype.append(alt);
+                source_position = libjst::high_breakend(breakpoint);
+            }
+            haplotype.append(_source, source_position);
+            _expected.emplace_back(haplotype.begin(), haplotype.end());
+        }
+    }
+};
+
+} // namespace jst::test::haplotype_viewer
+
+using haplotype_viewer_test = jst::test::haplotype_viewer::test;
+
+TEST_F(haplotype_viewer_test, materialise_all) {
+    libjst::haplotype_viewer viewer{_store};
+    EXPECT_EQ(viewer.size(), haplotype_count);
+
+    std::vector<std::vector<char>> haplotypes = viewer.materialise_all();
+    ASSERT_EQ(haplotypes.size(), haplotype_count);
+    for (uint32_t haplotype = 0; haplotype < haplotype_count; ++haplotype)
+        EXPECT_EQ(haplotypes[haplotype], _expected[haplotype]) << "haplotype " << haplotype;
+}
+
+TEST_F(haplotype_viewer_test, materialise_block) {
+    libjst::haplotype_viewer viewer{_store};
+
+    // Blocks beginning and ending within a coverage word.
+    for (auto [first, count] : {std::pair{0u, 1u}, {3u, 60u}, {63u, 2u}, {70u, 80u}, {149u, 1u}, {20u, 0u}}) {
+        std::vector<std::vector<char>> haplotypes = viewer.materialise(first, count);
+        ASSERT_EQ(haplotypes.size(), count);
+        for (uint32_t idx = 0; idx < count; ++idx)
+            EXPECT_EQ(haplotypes[idx], _expected[first + idx]) << "haplotype " << first + idx;
+    }
+}
+
+TEST_F(haplotype_viewer_test, materialise_parallel) {
+    libjst::haplotype_viewer viewer{_store};
+
+    for (std::size_t thread_count : {1u, 2u, 3u, 8u}) {
+        EXPECT_EQ(viewer.materialise_all(thread_count), _expected);
+        std::vector<std::vector<char>> haplotypes = viewer.materialise(10, 130, thread_count);
+        EXPECT_TRUE(std::ranges::equal(haplotypes, _expected | std::views::drop(10) | std::views::take(130)));
+    }
+}
+
+TEST_F(haplotype_viewer_test, invalid_block) {
+    libjst::haplotype_viewer viewer{_store};
+
+    EXPECT_THROW(viewer.materialise(0, haplotype_count + 1), std::out_of_range);
+    EXPECT_THROW(viewer.materialise(haplotype_count + 1, 0), std::out_of_range);
+    EXPECT_THROW(viewer.materialise(100, 60, 4), std::out_of_range);
+    EXPECT_NO_THROW(viewer.materialise(haplotype_count, 0));
+}
+
+TEST_F(haplotype_viewer_test, carried_variants) {
+    libjst::haplotype_viewer viewer{_store};
+
+    std::vector<coverage_type> coverages{};
+    for (auto && variant : libjst::interior_breakends(_store.variants()))
+        if (variant.get_breakpoint_end() == libjst::breakpoint_end::low)
+            coverages.push_back(libjst::coverage(variant));
+    ASSERT_GT(coverages.size(), 64u); // spans more than one block of variants.
+
+    for (auto [first, count] : {std::pair{0u, haplotype_count}, std::pair{10u, 130u}, std::pair{70u, 3u},
+                                std::pair{haplotype_count, 0u}}) {
+        auto haplotypes = viewer.carried_variants(first, count);
+        ASSERT_EQ(haplotypes.size(), count);
+        for (uint32_t idx = 0; idx < count; ++idx) {
+            ASSERT_EQ(haplotypes[idx].size(), coverages.size());
+            for (std::size_t variant = 0; variant < coverages.size(); ++variant)
+                EXPECT_EQ(haplotypes[idx][variant], coverages[variant][first + idx])
+                    << "haplotype " << first + idx << " variant " << variant;
+        }
+    }
+
+    EXPECT_THROW(viewer.carried_variants(100, 60), std::out_of_range);
+}
+
+TEST_F(haplotype_viewer_test, proxy) {
+    libjst::haplotype_viewer viewer{_store};
+    for (uint32_t haplotype = 0; haplotype < haplotype_count; ++haplotype) {
+        auto && sequence = viewer[haplotype];
+        EXPECT_TRUE(std::ranges::equal(sequence, _expected[haplotype])) << "haplotype " << haplotype;
+    }
+}
+
+TEST_F(haplotype_viewer_test, proxy_with_variant_class_index) {
+    _store.build_variant_class_index();
+    libjst::haplotype_viewer viewer{_store};
+    for (uint32_t haplotype = 0; haplotype < haplotype_count; ++haplotype) {
+        auto && sequence = viewer[haplotype];
+        EXPECT_TRUE(std::ranges::equal(sequence, _expected[haplotype])) << "haplotype " << haplotype;
+    }
+}
@@ -0,0 +1,84 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <utility>
+
+#include <libjst/rcms/indel_index.hpp>
+
+using namespace std::literals;
+
+struct indel_index_test : public ::testing::Test {
+    using key_type = std::pair<uint32_t, uint32_t>;
+    using test_type = libjst::indel_index<key_type, std::string>;
+};
+
+TEST_F(indel_index_test, construct) {
+    test_type index{};
+    EXPECT_TRUE(index.empty());
+    EXPECT_EQ(index.size(), 0u);
+    EXPECT_EQ(index.find(key_type{0, 0}), nullptr);
+}
+
+TEST_F(indel_index_test, emplace_ordered) {
+    test_type index{};
+    EXPECT_TRUE(index.emplace(key_type{1, 0}, "A"s));
+    EXPECT_TRUE(index.emplace(key_type{1, 3}, "C"s));
+    EXPECT_TRUE(index.emplace(key_type{4, 2}, "G"s));
+
+    EXPECT_EQ(index.size(), 3u);
+    EXPECT_EQ(index.at(key_type{1, 0}), "A"s);
+    EXPECT_EQ(index.at(key_type{1, 3}), "C"s);
+    EXPECT_EQ(index.at(key_type{4, 2}), "G"s);
+}
+
+TEST_F(indel_index_test, emplace_unordered) {
+    test_type index{};
+    EXPECT_TRUE(index.emplace(key_type{4, 2}, "G"s));
+    EXPECT_TRUE(index.emplace(key_type{1, 3}, "C"s));
+    EXPECT_TRUE(index.emplace(key_type{1, 0}, "A"s));
+    EXPECT_TRUE(index.emplace(key_type{7, 0}, "T"s));
+
+    EXPECT_TRUE(std::ranges::is_sorted(index.keys()));
+    EXPECT_EQ(index.indels(), (std::vector{"A"s, "C"s, "G"s, "T"s}));
+}
+
+TEST_F(indel_index_test, emplace_existing) {
+    test_type index{};
+    EXPECT_TRUE(index.emplace(key_type{1, 0}, "A"s));
+    EXPECT_TRUE(index.emplace(key_type{3, 0}, "C"s));
+    EXPECT_FALSE(index.emplace(key_type{1, 0}, "T"s));
+    EXPECT_FALSE(index.emplace(key_type{3, 0}, "T"s));
+
+    EXPECT_EQ(index.size(), 2u);
+    EXPECT_EQ(index.at(key_type{1, 0}), "A"s);
+    EXPECT_EQ(index.at(key_type{3, 0}), "C"s);
+}
+
+TEST_F(indel_index_test, find) {
+    test_type index{};
+    index.emplace(key_type{1, 0}, "A"s);
+    index.emplace(key_type{4, 2}, "G"s);
+
+    EXPECT_TRUE(index.contains(key_type{1, 0}));
+    EXPECT_TRUE(index.contains(key_type{4, 2}));
+    EXPECT_FALSE(index.contains(key_type{1, 1}));
+    EXPECT_FALSE(index.contains(key_type{0, 0}));
+    EXPECT_FALSE(index.contains(key_type{5, 0}));
+    EXPECT_EQ(*index.find(key_type{4, 2}), "G"s);
+}
+
+TEST_F(indel_index_test, clear) {
+    test_type index{};
+    index.emplace(key_type{1, 0}, "A"s);
+    index.clear();
+
+    EXPECT_TRUE(index.empty());
+    EXPECT_FALSE(index.contains(key_type{1, 0}));
+}
@@ -0,0 +1,51 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/interior_breakends.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+
+using namespace std::literals;
+
+struct interior_breakends_test : public ::testing::Test {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using cms_type = libjst::dna_compressed_multisequence<std::string, coverage_type>;
+    using store_type = libjst::rcs_store<std::string, cms_type>;
+    using value_type = std::ranges::range_value_t<cms_type>;
+
+    std::string source{"AAAAAAAAAAAAAAA"s};
+};
+
+TEST_F(interior_breakends_test, empty) {
+    store_type store{source, 4};
+    auto interior = libjst::interior_breakends(store.variants());
+    EXPECT_TRUE(interior.empty());
+    EXPECT_EQ(interior.begin(), std::ranges::next(store.variants().begin()));
+    EXPECT_EQ(interior.end(), std::ranges::prev(store.variants().end()));
+}
+
+TEST_F(interior_breakends_test, variants) {
+    store_type store{source, 4};
+    auto domain = store.variants().coverage_domain();
+    store.add(value_type{libjst::breakpoint{0u, 1u}, "C"s, coverage_type{{0, 1}, domain}});
+    store.add(value_type{libjst::breakpoint{4u, 2u}, ""s, coverage_type{{2}, domain}});
+    store.add(value_type{libjst::breakpoint{14u, 1u}, "G"s, coverage_type{{3}, domain}});
+
+    std::vector<uint32_t> positions{};
+    for (auto && breakend : libjst::interior_breakends(store.variants()))
+        positions.push_back(libjst::position(breakend));
+
+    // The snv at the begin and the end of the source are kept, only the nil breakends are skipped.
+    EXPECT_EQ(positions, (std::vector<uint32_t>{0, 4, 6, 14}));
+    EXPECT_EQ(std::ranges::ssize(libjst::interior_breakends(store.variants())), store.variants().size() - 2);
+}
@@ -0,0 +1,289 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <ranges>
+#include <sstream>
+#include <stack>
+#include <string>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/coverage/concept.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/mapped_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/sequence_tree/labelled_tree.hpp>
+#include <libjst/sequence_tree/partial_tree.hpp>
+#include <libjst/sequence_tree/volatile_tree.hpp>
+
+using namespace std::literals;
+
+struct mapped_compressed_multisequence_test : public ::testing::Test {
+    using source_type = std::string;
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using coverage_domain_type = libjst::coverage_domain_t<coverage_type>;
+
+    using cms_type = libjst::dna_compressed_multisequence<source_type, coverage_type>;
+    using value_type = std::ranges::range_value_t<cms_type>;
+    using test_type = libjst::mapped_compressed_multisequence<>;
+
+    coverage_domain_type domain{0, 10};
+    cms_type multisequence{"AAAAAAAAAAAAAAA"s, domain,
+                           std::vector<value_type>{
+                                value_type{libjst::breakpoint{1, 1}, "T"s, coverage_type{{0, 1, 2}, domain}},
+                                value_type{libjst::breakpoint{2, 4}, ""s, coverage_type{{3, 4}, domain}},
+                                value_type{libjst::breakpoint{4, 0}, "CC"s, coverage_type{{0, 1, 2}, domain}},
+                                value_type{libjst::breakpoint{4, 1}, "G"s, coverage_type{{5, 9}, domain}},
+                                value_type{libjst::breakpoint{8, 3}, ""s, coverage_type{{5, 9}, domain}},
+                                value_type{libjst::breakpoint{10, 0}, "GTA"s, coverage_type{{6}, domain}},
+                                value_type{libjst::breakpoint{12, 1}, "C"s, coverage_type{{3, 4}, domain}}}};
+
+    // Returns the layout in a buffer aligned to eight bytes.
+    static std::vector<uint64_t> to_layout(std::string const & bytes) {
+        std::vector<uint64_t> layout((bytes.size() + 7) / 8);
+        std::memcpy(layout.data(), bytes.data(), bytes.size());
+        return layout;
+    }
+
+    static std::span<std::byte const> as_bytes(std::vector<uint64_t> const & layout) {
+        return std::as_bytes(std::span{layout});
+    }
+
+    std::string save() const {
+        std::ostringstream ostream{};
+        libjst::save_mapped(ostream, multisequence);
+        return ostream.str();
+    }
+
+    void check(test_type const & actual) const {
+        EXPECT_EQ(actual.size(), multisequence.size());
+        EXPECT_TRUE(actual.coverage_domain() == multisequence.coverage_domain());
+        EXPECT_TRUE(std::ranges::equal(actual.source(), multisequence.source()));
+
+        auto actual_it = actual.begin();
+        for (auto expected_it = multisequence.begin(); expected_it != multisequence.end(); ++expected_it, ++actual_it) {
+            auto && expected_delta = *expected_it;
+            auto && actual_delta = *actual_it;
+            EXPECT_EQ(libjst::low_breakend(actual_delta), libjst::low_breakend(expected_delta));
+            EXPECT_EQ(libjst::high_breakend(actual_delta), libjst::high_breakend(expected_delta));
+            EXPECT_EQ(libjst::alt_kind(actual_delta), libjst::alt_kind(expected_delta));
+            EXPECT_EQ(libjst::effective_size(actual_delta), libjst::effective_size(expected_delta));
+            EXPECT_EQ(actual_delta.get_breakpoint_end(), expected_delta.get_breakpoint_end());
+            EXPECT_TRUE(std::ranges::equal(libjst::alt_sequence(actual_delta), libjst::alt_sequence(expected_delta)));
+            EXPECT_EQ(coverage_type{libjst::coverage(actual_delta)}, libjst::coverage(expected_delta));
+
+            auto expected_mate = expected_delta.jump_to_mate();
+            auto actual_mate = actual_delta.jump_to_mate();
+            ASSERT_EQ(actual_mate.has_value(), expected_mate.has_value());
+            if (actual_mate.has_value()) {
+                EXPECT_EQ(*actual_mate - actual.begin(), *expected_mate - multisequence.begin());
+            }
+        }
+    }
+};
+
+TEST_F(mapped_compressed_multisequence_test, range_concept) {
+    EXPECT_TRUE(std::ranges::random_access_range<test_type>);
+    EXPECT_TRUE(std::ranges::sized_range<test_type>);
+}
+
+TEST_F(mapped_compressed_multisequence_test, from_memory) {
+    std::vector<uint64_t> layout = to_layout(save());
+    EXPECT_EQ(layout.size() * 8, libjst::mapped_multisequence_header{
+        *reinterpret_cast<libjst::mapped_multisequence_header const *>(layout.data())}.layout_size());
+
+    check(test_type{as_bytes(layout)});
+}
+
+TEST_F(mapped_compressed_multisequence_test, from_file) {
+    std::filesystem::path path = std::filesystem::temp_directory_path() / "libjst_mapped_multisequence_test.bin";
+    {
+        std::ofstream ofstream{path, std::ios::binary};
+        libjst::save_mapped(ofstream, multisequence);
+    }
+
+    test_type mapped{path};
+    check(mapped);
+
+    test_type moved{std::move(mapped)};
+    check(moved);
+    std::filesystem::remove(path);
+}
+
+TEST_F(mapped_compressed_multisequence_test, freeze) {
+    test_type frozen = libjst::freeze(multisequence);
+    check(frozen);
+
+    test_type copy{frozen}; // shares the layout
+    frozen = libjst::freeze(cms_type{"AAAA"s, domain});
+    EXPECT_EQ(frozen.size(), 2u);
+    check(copy);
+}
+
+TEST_F(mapped_compressed_multisequence_test, freeze_outlives_multisequence) {
+    std::optional<cms_type> original{multisequence};
+    test_type frozen = libjst::freeze(*original);
+    original.reset();
+    check(frozen);
+}
+
+TEST_F(mapped_compressed_multisequence_test, value_type) {
+    std::vector<uint64_t> layout = to_layout(save());
+    test_type mapped{as_bytes(layout)};
+
+    auto expected_it = multisequence.begin();
+    for (std::ranges::range_value_t<test_type> actual : mapped) {
+        value_type expected = *expected_it++;
+        EXPECT_EQ(libjst::get_breakpoint(actual), libjst::get_breakpoint(expected));
+        EXPECT_EQ(libjst::alt_sequence(actual), libjst::alt_sequence(expected));
+        EXPECT_EQ(libjst::coverage(actual), libjst::coverage(expected));
+    }
+}
+
+TEST_F(mapped_compressed_multisequence_test, invalid_layout) {
+    std::vector<uint64_t> layout = to_layout(save());
+
+    { // truncated
+        EXPECT_THROW(test_type{as_bytes(layout).first(layout.size() * 8 - 8)}, std::runtime_error);
+    }
+
+    { // misaligned
+        EXPECT_THROW(test_type{as_bytes(layout).subspan(1)}, std::runtime_error);
+    }
+
+    { // different key width
+        using wide_type = libjst::mapped_compressed_multisequence<uint64_t>;
+        EXPECT_THROW(wide_type{as_bytes(layout)}, std::runtime_error);
+    }
+
+    { // no layout
+        reinterpret_cast<char *>(layout.data())[0] = 'X';
+        EXPECT_THROW(test_type{as_bytes(layout)}, std::runtime_error);
+    }
+
+    { // missing file
+        EXPECT_THROW(test_type{std::filesystem::path{"libjst_missing_mapped_multisequence.bin"}}, std::system_error);
+    }
+}
+
+TEST_F(mapped_compressed_multisequence_test, volatile_tree) {
+    using store_type = libjst::rcs_store<source_type, cms_type>;
+    using mapped_store_type = libjst::mapped_rcs_store<>;
+
+    // The labelled trees are only tested for substitutions so far.
+    store_type store{"AAAAAAAAAAAAAAA"s, 4, std::vector<value_type>{
+        value_type{libjst::breakpoint{1, 1}, "T"s, coverage_type{{0, 1}, coverage_domain_type{0, 4}}},
+        value_type{libjst::breakpoint{4, 1}, "G"s, coverage_type{{2}, coverage_domain_type{0, 4}}},
+        value_type{libjst::breakpoint{7, 1}, "C"s, coverage_type{{1, 3}, coverage_domain_type{0, 4}}},
+        value_type{libjst::breakpoint{12, 1}, "C"s, coverage_type{{0, 2}, coverage_domain_type{0, 4}}}}};
+    std::ostringstream ostream{};
+    libjst::save_mapped(ostream, store);
+    std::vector<uint64_t> layout = to_layout(ostream.str());
+    mapped_store_type mapped_store{test_type{as_bytes(layout)}};
+
+    EXPECT_EQ(mapped_store.size(), store.size());
+
+    auto collect_labels = [] (auto const & rcs_store) {
+        auto tree = libjst::volatile_tree{rcs_store} | libjst::labelled();
+        std::vector<std::string> labels{};
+        std::stack<libjst::tree_node_t<decltype(tree)>> path{};
+        path.push(libjst::root(tree));
+        while (!path.empty()) {
+            auto node = std::move(path.top());
+            path.pop();
+            auto label = (*node).sequence();
+            labels.emplace_back(label.begin(), label.end());
+
+            if (auto child = node.next_ref(); child.has_value())
+                path.push(std::move(*child));
+            if (auto child = node.next_alt(); child.has_value())
+                path.push(std::move(*child));
+        }
+        return labels;
+    };
+
+    EXPECT_EQ(collect_labels(mapped_store), collect_labels(store));
+    EXPECT_EQ(collect_labels(libjst::freeze(store)), collect_labels(store));
+}
+
+TEST_F(mapped_compressed_multisequence_test, load_region) {
+    std::vector<uint64_t> layout = to_layout(save());
+    test_type mapped{as_bytes(layout)};
+
+    auto region_store = libjst::load_region(mapped, 4, 10);
+    EXPECT_EQ(region_store.size(), 10u);
+    EXPECT_TRUE(std::ranges::equal(region_store.source(), multisequence.source()));
+
+    // The deletion [2, 6) begins before the region, the deletion [8, 11) is loaded entirely and the insertion at 10
+    // is behind the region.
+    std::vector<value_type> expected{value_type{libjst::breakpoint{0, 0}, ""s, coverage_type{{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}, domain}},
+                                     value_type{libjst::breakpoint{4, 0}, "CC"s, coverage_type{{0, 1, 2}, domain}},
+                                     value_type{libjst::breakpoint{4, 1}, "G"s, coverage_type{{5, 9}, domain}},
+                                     value_type{libjst::breakpoint{8, 3}, ""s, coverage_type{{5, 9}, domain}},
+                                     value_type{libjst::breakpoint{8, 3}, ""s, coverage_type{{5, 9}, domain}},
+                                     value_type{libjst::breakpoint{15, 0}, ""s, coverage_type{{0, 1, 2, 3, 4, 5, 6, 7, 8, 9}, domain}}};
+
+    ASSERT_EQ(std::ranges::size(region_store.variants()), expected.size());
+    auto actual_it = region_store.variants().begin();
+    for (value_type const & expected_delta : expected) {
+        EXPECT_EQ(libjst::get_breakpoint(*actual_it), libjst::get_breakpoint(expected_delta));
+        EXPECT_TRUE(std::ranges::equal(libjst::alt_sequence(*actual_it), libjst::alt_sequence(expected_delta)));
+        EXPECT_EQ(libjst::coverage(*actual_it), libjst::coverage(expected_delta));
+        ++actual_it;
+    }
+
+    { // empty region
+        auto empty_store = libjst::load_region(mapped, 5, 5);
+        EXPECT_EQ(std::ranges::size(empty_store.variants()), 2u);
+    }
+}
+
+TEST_F(mapped_compressed_multisequence_test, load_region_partial_tree) {
+    using store_type = libjst::rcs_store<source_type, cms_type>;
+
+    coverage_domain_type small_domain{0, 4};
+    store_type store{"AAAAAAAAAAAAAAA"s, 4, std::vector<value_type>{
+        value_type{libjst::breakpoint{1, 1}, "T"s, coverage_type{{0, 1}, small_domain}},
+        value_type{libjst::breakpoint{4, 1}, "G"s, coverage_type{{2}, small_domain}},
+        value_type{libjst::breakpoint{7, 1}, "C"s, coverage_type{{1, 3}, small_domain}},
+        value_type{libjst::breakpoint{12, 1}, "C"s, coverage_type{{0, 2}, small_domain}}}};
+    std::ostringstream ostream{};
+    libjst::save_mapped(ostream, store);
+    std::vector<uint64_t> layout = to_layout(ostream.str());
+    test_type mapped{as_bytes(layout)};
+    // The partial tree of the bin [3, 9) extends the paths beyond the bin, such that the region must include them.
+    auto region_store = libjst::load_region(mapped, 3, 15);
+    EXPECT_EQ(std::ranges::size(region_store.variants()), std::ranges::size(store.variants()) - 1);
+
+    auto collect_labels = [] (auto const & rcs_store) {
+        auto tree = libjst::partial_tree{rcs_store, 3, 6} | libjst::labelled();
+        std::vector<std::string> labels{};
+        std::stack<libjst::tree_node_t<decltype(tree)>> path{};
+        path.push(libjst::root(tree));
+        while (!path.empty()) {
+            auto node = std::move(path.top());
+            path.pop();
+            auto label = (*node).sequence();
+            labels.emplace_back(label.begin(), label.end());
+
+            if (auto child = node.next_ref(); child.has_value())
+                path.push(std::move(*child));
+            if (auto child = node.next_alt(); child.has_value())
+                path.push(std::move(*child));
+        }
+        return labels;
+    };
+
+    EXPECT_EQ(collect_labels(region_store), collect_labels(store));
+}
@@ -0,0 +1,216 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <ranges>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/multi_contig_store.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/sequence_tree/chunked_tree.hpp>
+#include <libjst/sequence_tree/multi_contig_forest.hpp>
+#include <libjst/traversal/parallel_chunk_traverser.hpp>
+
+using namespace std::literals;
+
+namespace jst::test::multi_contig_store {
+
+using source_t = std::string;
+
+struct naive_matcher {
+    source_t needle{};
+
+    constexpr std::size_t window_size() const noexcept {
+        return needle.size();
+    }
+
+    template <typename haystack_t, typename callback_t>
+    constexpr void operator()(haystack_t && haystack, callback_t && callback) const {
+        auto it = std::ranges::begin(haystack);
+        auto last = std::ranges::end(haystack);
+        for (; std::ranges::distance(it, last) >= std::ranges::ssize(needle); ++it) {
+            if (std::ranges::equal(std::ranges::subrange{it, std::ranges::next(it, needle.size())}, needle))
+                callback(it);
+        }
+    }
+};
+
+struct test : public ::testing::Test {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using coverage_domain_type = libjst::coverage_domain_t<coverage_type>;
+
+    using cms_t = libjst::dna_compressed_multisequence<source_t, coverage_type>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+    using rcs_store_t = libjst::rcs_store<source_t, cms_t>;
+    using multi_store_t = libjst::multi_contig_store<rcs_store_t>;
+    using hit_t = std::pair<std::size_t, std::string>; // the contig and the label of a hit
+
+    static constexpr uint32_t haplotype_count{4};
+
+    coverage_domain_type domain{0, haplotype_count};
+    multi_store_t _multi_store{haplotype_count};
+
+    void SetUp() override {
+        _multi_store.emplace_contig("chr1", "ACGTACGTACGTACGTACGT"s, haplotype_count, std::vector<cms_value_t>{
+            cms_value_t{libjst::breakpoint{2, 1}, "T"s, coverage_type{{0, 1}, domain}},
+            cms_value_t{libjst::breakpoint{5, 0}, "GTA"s, coverage_type{{2}, domain}},
+            cms_value_t{libjst::breakpoint{9, 3}, ""s, coverage_type{{1, 3}, domain}},
+            cms_value_t{libjst::breakpoint{15, 1}, "A"s, coverage_type{{0, 3}, domain}}});
+        _multi_store.emplace_contig("chr2", "GTACG"s, haplotype_count, std::vector<cms_value_t>{
+            cms_value_t{libjst::breakpoint{1, 1}, "G"s, coverage_type{{2, 3}, domain}}});
+        _multi_store.emplace_contig("chrM", "ACGTTTTTACGTAAAACGTACGTCCCCCCCCCCCACGT"s, haplotype_count,
+                                    std::vector<cms_value_t>{
+            cms_value_t{libjst::breakpoint{6, 4}, ""s, coverage_type{{0}, domain}},
+            cms_value_t{libjst::breakpoint{12, 0}, "CGT"s, coverage_type{{1, 2}, domain}},
+            cms_value_t{libjst::breakpoint{30, 1}, "A"s, coverage_type{{3}, domain}}});
+    }
+
+    std::string save() const {
+        std::ostringstream stream{};
+        libjst::save_multi_contig(stream, _multi_store);
+        return stream.str();
+    }
+
+    // Returns the layout in a buffer aligned to eight bytes.
+    static std::vector<uint64_t> to_layout(std::string const & bytes) {
+        std::vector<uint64_t> layout((bytes.size() + 7) / 8);
+        std::memcpy(layout.data(), bytes.data(), bytes.size());
+        return layout;
+    }
+
+    template <typename forest_t>
+    static std::vector<hit_t> search(forest_t const & forest, std::size_t const thread_count) {
+        auto to_hit = [&] (std::size_t const chunk_idx, auto &&, auto && label) {
+            std::string sequence{};
+            for (char c : label.sequence())
+                sequence.push_back(c);
+            return hit_t{forest.contig_of(chunk_idx), std::move(sequence)};
+        };
+
+        std::vector<hit_t> hits{};
+        libjst::parallel_chunk_traverser{thread_count}.template ordered<hit_t>(forest, naive_matcher{"ACG"s}, to_hit,
+            [&] (hit_t hit) { hits.push_back(std::move(hit)); });
+        return hits;
+    }
+
+    template <typename store_t>
+    static void expect_equal_variants(store_t const & actual, rcs_store_t const & expected) {
+        EXPECT_EQ(actual.size(), expected.size());
+        EXPECT_TRUE(std::ranges::equal(actual.source(), expected.source()));
+        ASSERT_EQ(std::ranges::size(actual.variants()), std::ranges::size(expected.variants()));
+
+        auto actual_it = actual.variants().begin();
+        for (auto && expected_delta : expected.variants()) {
+            EXPECT_EQ(libjst::get_breakpoint(*actual_it), libjst::get_breakpoint(expected_delta));
+            EXPECT_TRUE(std::ranges::equal(libjst::alt_sequence(*actual_it), libjst::alt_sequence(expected_delta)));
+            EXPECT_EQ(coverage_type{libjst::coverage(*actual_it)}, libjst::coverage(expected_delta));
+            ++actual_it;
+        }
+    }
+};
+
+} // namespace jst::test::multi_contig_store
+
+using multi_contig_store_test = jst::test::multi_contig_store::test;
+using naive_matcher = jst::test::multi_contig_store::naive_matcher;
+
+// ----------------------------------------------------------------------------
+// Test case definitions
+// ----------------------------------------------------------------------------
+
+TEST_F(multi_contig_store_test, contigs) {
+    EXPECT_EQ(_multi_store.contig_count(), 3u);
+    EXPECT_EQ(_multi_store.size(), haplotype_count);
+    EXPECT_EQ(_multi_store.name(1), "chr2");
+    EXPECT_EQ(_multi_store.index_of("chrM"), 2u);
+    EXPECT_FALSE(_multi_store.find("chrX").has_value());
+    EXPECT_THROW(_multi_store.index_of("chrX"), std::out_of_range);
+    EXPECT_TRUE(std::ranges::equal(_multi_store.contig("chr2").source(), "GTACG"s));
+    EXPECT_EQ(&_multi_store.contig("chr1"), &_multi_store.contig(0));
+}
+
+TEST_F(multi_contig_store_test, invalid_contig) {
+    EXPECT_THROW(_multi_store.emplace_contig("chr2", "AC"s, haplotype_count), std::invalid_argument);
+    EXPECT_THROW(_multi_store.emplace_contig("chr3", "AC"s, haplotype_count + 1), std::invalid_argument);
+    EXPECT_EQ(_multi_store.contig_count(), 3u);
+    EXPECT_EQ(_multi_store.emplace_contig("chr3", "AC"s, haplotype_count), 3u);
+}
+
+TEST_F(multi_contig_store_test, mapped) {
+    std::vector<uint64_t> const layout = to_layout(save());
+    libjst::mapped_multi_contig_store<> const mapped{std::as_bytes(std::span{layout})};
+
+    EXPECT_EQ(mapped.contig_count(), _multi_store.contig_count());
+    EXPECT_EQ(mapped.size(), haplotype_count);
+    EXPECT_EQ(mapped.index_of("chrM"), 2u);
+    EXPECT_THROW(mapped.index_of("chrX"), std::out_of_range);
+
+    EXPECT_FALSE(mapped.is_mapped(1));
+    expect_equal_variants(mapped.contig("chr2"), _multi_store.contig(1));
+    EXPECT_TRUE(mapped.is_mapped(1));
+    EXPECT_FALSE(mapped.is_mapped(0));
+    EXPECT_FALSE(mapped.is_mapped(2));
+
+    for (std::size_t contig_idx = 0; contig_idx < mapped.contig_count(); ++contig_idx) {
+        EXPECT_EQ(mapped.name(contig_idx), _multi_store.name(contig_idx));
+        expect_equal_variants(mapped.contig(contig_idx), _multi_store.contig(contig_idx));
+        expect_equal_variants(mapped.load_contig(contig_idx), _multi_store.contig(contig_idx));
+    }
+}
+
+TEST_F(multi_contig_store_test, invalid_layout) {
+    std::string bytes = save();
+    { // truncated
+        std::vector<uint64_t> const layout = to_layout(bytes.substr(0, 100));
+        EXPECT_THROW(libjst::mapped_multi_contig_store<>{std::as_bytes(std::span{layout})}, std::runtime_error);
+    }
+    { // no multi contig store
+        bytes[0] = 'X';
+        std::vector<uint64_t> const layout = to_layout(bytes);
+        EXPECT_THROW(libjst::mapped_multi_contig_store<>{std::as_bytes(std::span{layout})}, std::runtime_error);
+    }
+}
+
+TEST_F(multi_contig_store_test, forest) {
+    libjst::multi_contig_forest forest{_multi_store, 8u, 2u};
+    EXPECT_EQ(std::ranges::size(forest), 3u + 1u + 5u);
+    EXPECT_EQ(forest.contig_of(3), 1u);
+    EXPECT_EQ(forest.contig_of(4), 2u);
+    EXPECT_EQ(forest.chunk_begin(8), 32u);
+
+    // The hits are the same as of the chunks of every contig searched one after the other.
+    std::vector<hit_t> expected_hits{};
+    for (std::size_t contig_idx = 0; contig_idx < _multi_store.contig_count(); ++contig_idx) {
+        auto contig_forest = _multi_store.contig(contig_idx) | libjst::chunk(8u, 2u);
+        libjst::parallel_chunk_traverser{1}.ordered<hit_t>(contig_forest, naive_matcher{"ACG"s},
+            [&] (auto &&, auto && label) {
+                std::string sequence{};
+                for (char c : label.sequence())
+                    sequence.push_back(c);
+                return hit_t{contig_idx, std::move(sequence)};
+            },
+            [&] (hit_t hit) { expected_hits.push_back(std::move(hit)); });
+    }
+    EXPECT_FALSE(expected_hits.empty());
+    EXPECT_EQ(search(forest, 1), expected_hits);
+    EXPECT_EQ(search(forest, 4), expected_hits);
+
+    std::vector<uint64_t> const layout = to_layout(save());
+    libjst::mapped_multi_contig_store<> const mapped{std::as_bytes(std::span{layout})};
+    EXPECT_EQ(search(libjst::multi_contig_forest{mapped, 8u, 2u}, 4), expected_hits);
+}
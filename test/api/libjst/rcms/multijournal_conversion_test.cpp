@@ -0,0 +1,123 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/journal/coverage_augmented_breakpoint_multijournal.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/haplotype_viewer.hpp>
+#include <libjst/rcms/interior_breakends.hpp>
+#include <libjst/rcms/multijournal_conversion.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+
+using namespace std::literals;
+
+struct multijournal_conversion_test : public ::testing::Test {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using cms_type = libjst::dna_compressed_multisequence<std::string, coverage_type>;
+    using store_type = libjst::rcs_store<std::string, cms_type>;
+    using value_type = std::ranges::range_value_t<cms_type>;
+    using journal_type = libjst::coverage_augmented_breakpoint_multijournal<std::string>;
+    using journal_coverage_type = typename journal_type::coverage_type;
+    using journal_domain_type = libjst::coverage_domain_t<journal_coverage_type>;
+
+    static constexpr uint32_t haplotype_count{4};
+
+    std::string source{"AAAACCCCGGGGTTTTACGTACGT"};
+
+    void record(journal_type & journal, uint32_t low, uint32_t high, std::string sequence,
+                std::vector<uint32_t> const & haplotypes) const {
+        auto breakpoint = libjst::to_breakpoint(journal.source(),
+                                                journal.source().begin() + low,
+                                                journal.source().begin() + high);
+        journal.record(breakpoint, std::move(sequence),
+                       journal_coverage_type{haplotypes, journal_domain_type{0, haplotype_count}});
+    }
+
+    // The variants of the store as tuples of position, deletion, insertion and the covered haplotypes.
+    static auto variants(store_type const & store) {
+        std::vector<std::tuple<uint32_t, uint32_t, std::string, std::vector<uint32_t>>> result{};
+        for (auto && breakend : libjst::interior_breakends(store.variants())) {
+            if (breakend.get_breakpoint_end() != libjst::breakpoint_end::low)
+                continue;
+
+            value_type variant = breakend;
+            std::vector<uint32_t> haplotypes{};
+            libjst::for_each_covered(libjst::coverage(variant), 0, store.size(), [&] (std::size_t const id) {
+                haplotypes.push_back(id);
+            });
+            auto alt = libjst::alt_sequence(variant);
+            auto breakpoint = libjst::get_breakpoint(variant);
+            result.emplace_back(libjst::low_breakend(breakpoint), libjst::breakpoint_span(breakpoint),
+                                std::string{alt.begin(), alt.end()}, std::move(haplotypes));
+        }
+        std::ranges::sort(result);
+        return result;
+    }
+};
+
+TEST_F(multijournal_conversion_test, groups_records)
+{
+    journal_type journal{source};
+    record(journal, 2, 3, "C"s, {0});
+    record(journal, 2, 3, "G"s, {1});
+    record(journal, 2, 3, "C"s, {3});
+    record(journal, 6, 9, ""s, {1, 2});
+    record(journal, 12, 12, "AC"s, {0});
+    record(journal, 12, 12, "AC"s, {0, 2});
+    record(journal, 16, 16, ""s, {3}); // neither replaces nor inserts a symbol.
+
+    store_type store = libjst::to_rcs_store<cms_type>(journal, haplotype_count);
+
+    EXPECT_EQ(store.size(), haplotype_count);
+    EXPECT_TRUE(std::ranges::equal(store.source(), source));
+    using variant_t = std::tuple<uint32_t, uint32_t, std::string, std::vector<uint32_t>>;
+    EXPECT_EQ(variants(store), (std::vector<variant_t>{
+        variant_t{2, 1, "C"s, {0, 3}},
+        variant_t{2, 1, "G"s, {1}},
+        variant_t{6, 3, ""s, {1, 2}},
+        variant_t{12, 0, "AC"s, {0, 2}}
+    }));
+}
+
+TEST_F(multijournal_conversion_test, equals_added_store)
+{
+    std::mt19937_64 generator{42};
+    source.resize(400);
+    std::ranges::generate(source, [&] () { return "ACGT"[generator() % 4]; });
+
+    journal_type journal{source};
+    store_type expected{source, haplotype_count};
+    auto domain = expected.variants().coverage_domain();
+    for (uint32_t position = 10; position + 10 < source.size(); position += 5 + generator() % 15) {
+        bool const is_deletion = generator() % 8 == 0;
+        std::string alt = is_deletion ? ""s : std::string(1, source[position] == 'A' ? 'C' : 'A');
+        uint32_t const span = is_deletion ? 3 : 1;
+        std::vector<uint32_t> haplotypes{};
+        for (uint32_t haplotype = 0; haplotype < haplotype_count; ++haplotype) {
+            if (generator() % 2 == 0) {
+                haplotypes.push_back(haplotype);
+                record(journal, position, position + span, alt, {haplotype}); // one record per haplotype.
+            }
+        }
+        if (!haplotypes.empty())
+            expected.add(value_type{libjst::breakpoint{position, span}, alt, coverage_type{haplotypes, domain}});
+    }
+
+    store_type store = libjst::to_rcs_store<cms_type>(journal, haplotype_count);
+
+    EXPECT_EQ(variants(store), variants(expected));
+    EXPECT_EQ(libjst::haplotype_viewer{store}.materialise_all(), libjst::haplotype_viewer{expected}.materialise_all());
+}
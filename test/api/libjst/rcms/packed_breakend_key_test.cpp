@@ -121,3 +121,26 @@ TEST_F(packed_breakend_key, less) {
               (test_type{static_cast<uint8_t>(0), 3000}));
 
 }
+
+TEST_F(packed_breakend_key, wide_key) {
+    using wide_type = libjst::packed_breakend_key<uint64_t>;
+    EXPECT_EQ(sizeof(test_type), sizeof(uint32_t));
+    EXPECT_EQ(sizeof(wide_type), sizeof(uint64_t));
+    EXPECT_EQ(test_type::max_position, (1u << 29) - 1);
+    EXPECT_EQ(wide_type::max_position, (1ull << 61) - 1);
+
+    uint64_t large_position = (1ull << 32) + 17;
+    wide_type test_snv{static_cast<uint8_t>(2), large_position};
+    EXPECT_FALSE(test_snv.is_indel());
+    EXPECT_EQ(test_snv.snv_value(), 2u);
+    EXPECT_EQ(test_snv.position(), large_position);
+
+    wide_type test_del{libjst::indel_breakend_kind::deletion_low, wide_type::max_position};
+    EXPECT_TRUE(test_del.is_indel());
+    EXPECT_EQ(test_del.indel_kind(), libjst::indel_breakend_kind::deletion_low);
+    EXPECT_EQ(test_del.position(), wide_type::max_position);
+
+    EXPECT_LT(test_snv, test_del);
+    EXPECT_LT((wide_type{libjst::indel_breakend_kind::deletion_high, large_position}), test_snv);
+    EXPECT_NE(std::hash<wide_type>{}(test_snv), std::hash<wide_type>{}(wide_type{static_cast<uint8_t>(1), large_position}));
+}
@@ -0,0 +1,126 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <ranges>
+#include <string>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/haplotype_viewer.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/rcms/rcs_store_reversed.hpp>
+#include <libjst/sequence_tree/volatile_tree.hpp>
+#include <libjst/traversal/state_oblivious_traverser.hpp>
+
+namespace jst::test::rcs_store_reversed {
+
+using source_t = std::string;
+
+struct naive_matcher {
+    source_t needle{};
+
+    constexpr std::size_t window_size() const noexcept {
+        return needle.size();
+    }
+
+    template <typename haystack_t, typename callback_t>
+    constexpr void operator()(haystack_t && haystack, callback_t && callback) const {
+        auto it = std::ranges::begin(haystack);
+        auto last = std::ranges::end(haystack);
+        for (; std::ranges::distance(it, last) >= std::ranges::ssize(needle); ++it) {
+            if (std::ranges::equal(std::ranges::subrange{it, std::ranges::next(it, needle.size())}, needle))
+                callback(it);
+        }
+    }
+};
+
+struct test : public ::testing::Test {
+    using coverage_t = libjst::bit_coverage<uint32_t>;
+    using coverage_domain_t = libjst::coverage_domain_t<coverage_t>;
+    using cms_t = libjst::dna_compressed_multisequence<source_t, coverage_t>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+    using rcs_store_t = libjst::rcs_store<source_t, cms_t>;
+
+    static constexpr uint32_t haplotype_count{8};
+
+    rcs_store_t _store;
+
+    // SNVs, insertions and deletions, some of which overlap.
+    void SetUp() override {
+        std::mt19937 random_engine{23};
+        source_t source(600, 'A');
+        std::ranges::generate(source, [&] { return "ACGT"[random_engine() % 4]; });
+        _store = rcs_store_t{source, haplotype_count};
+        coverage_domain_t const domain{0, haplotype_count};
+        for (uint32_t position = 5; position < source.size() - 20; position += 11) {
+            uint32_t const row = position % haplotype_count;
+            switch (position % 3) {
+                case 0: _store.add(cms_value_t{libjst::breakpoint{position, 1}, "T", coverage_t{{row}, domain}});
+                        break;
+                case 1: _store.add(cms_value_t{libjst::breakpoint{position, 0}, "GAC", coverage_t{{row}, domain}});
+                        break;
+                default: _store.add(cms_value_t{libjst::breakpoint{position, 7}, "", coverage_t{{row}, domain}});
+            }
+        }
+    }
+};
+
+} // namespace jst::test::rcs_store_reversed
+
+using namespace std::literals;
+
+using rcs_store_reversed_test = jst::test::rcs_store_reversed::test;
+using jst::test::rcs_store_reversed::naive_matcher;
+using jst::test::rcs_store_reversed::source_t;
+
+TEST_F(rcs_store_reversed_test, materialised_haplotypes) {
+    rcs_store_t const reversed = libjst::materialise_reversed(_store);
+    EXPECT_EQ(reversed.size(), _store.size());
+    EXPECT_EQ(std::ranges::size(reversed.variants()), std::ranges::size(_store.variants()));
+    EXPECT_TRUE(std::ranges::equal(reversed.source(), _store.source() | std::views::reverse));
+
+    auto const forward_haplotypes = libjst::haplotype_viewer{_store}.materialise_all();
+    auto const reversed_haplotypes = libjst::haplotype_viewer{reversed}.materialise_all();
+    ASSERT_EQ(reversed_haplotypes.size(), forward_haplotypes.size());
+    for (std::size_t row = 0; row < forward_haplotypes.size(); ++row)
+        EXPECT_TRUE(std::ranges::equal(reversed_haplotypes[row], forward_haplotypes[row] | std::views::reverse))
+            << "row " << row;
+}
+
+TEST_F(rcs_store_reversed_test, materialised_traversal) {
+    // The trees over the wrapped reversed store support SNVs only.
+    rcs_store_t snv_store{source_t{_store.source().begin(), _store.source().end()}, haplotype_count};
+    for (uint32_t position = 3; position < std::ranges::size(_store.source()); position += 7)
+        snv_store.add(cms_value_t{libjst::breakpoint{position, 1}, (position % 2) ? "T" : "C",
+                                  coverage_t{{position % haplotype_count}, coverage_domain_t{0, haplotype_count}}});
+
+    libjst::rcs_store_reversed<cms_t> const wrapped{snv_store.variants()};
+    rcs_store_t const materialised = libjst::materialise_reversed(snv_store);
+
+    auto collect = [] (auto const & store) {
+        std::size_t hit_count{};
+        libjst::state_oblivious_traverser{}(libjst::volatile_tree{store}, naive_matcher{"TCAG"s},
+                                            [&] (auto &&, auto &&) { ++hit_count; });
+        return hit_count;
+    };
+    std::size_t const expected = collect(wrapped);
+    EXPECT_GT(expected, 0u);
+    EXPECT_EQ(collect(materialised), expected);
+}
+
+TEST_F(rcs_store_reversed_test, materialised_twice_is_identity) {
+    rcs_store_t const twice = libjst::materialise_reversed(libjst::materialise_reversed(_store));
+    EXPECT_TRUE(std::ranges::equal(twice.source(), _store.source()));
+    EXPECT_TRUE(std::ranges::equal(libjst::haplotype_viewer{twice}.materialise_all(),
+                                   libjst::haplotype_viewer{_store}.materialise_all()));
+}
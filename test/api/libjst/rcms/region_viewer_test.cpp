@@ -0,0 +1,194 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/rcms/region_viewer.hpp>
+
+namespace jst::test::region_viewer {
+
+using source_t = std::string;
+
+struct test : public ::testing::Test {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using coverage_domain_type = libjst::coverage_domain_t<coverage_type>;
+
+    using cms_t = libjst::dna_compressed_multisequence<source_t, coverage_type>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+    using rcs_store_t = libjst::rcs_store<source_t, cms_t>;
+
+    using sequence_t = std::vector<char>;
+    using tagged_haplotype_t = std::vector<std::pair<char, std::size_t>>; // symbols with their source position
+
+    static constexpr uint32_t haplotype_count{100};
+
+    source_t _source{};
+    std::optional<rcs_store_t> _store{}; // constructed in place, as the deletions refer into its breakend map
+    std::vector<tagged_haplotype_t> _haplotypes{};
+
+    // Non-overlapping SNVs, insertions, short deletions and a few long deletions.
+    void SetUp() override {
+        std::mt19937 generator{5};
+        for (std::size_t idx = 0; idx < 800; ++idx)
+            _source.push_back("ACGT"[generator() % 4]);
+
+        coverage_domain_type domain{0, haplotype_count};
+        std::vector<cms_value_t> variants{};
+        std::vector<std::vector<std::pair<libjst::breakpoint, source_t>>> applied(haplotype_count);
+        auto add = [&] (libjst::breakpoint breakpoint, source_t alt, std::vector<uint32_t> const & haplotypes) {
+            variants.push_back(cms_value_t{breakpoint, alt, coverage_type{haplotypes, domain}});
+            for (uint32_t haplotype : haplotypes)
+                applied[haplotype].emplace_back(breakpoint, alt);
+        };
+
+        // Haplotypes 0 to 9 carry long deletions and no other variants.
+        add(libjst::breakpoint{100u, 150u}, "", {0, 1, 2});
+        add(libjst::breakpoint{400u, 80u}, "", {3, 4});
+        add(libjst::breakpoint{600u, 0u}, "TTTT", {5, 6, 7});
+
+        for (uint32_t position = 3; position + 4 < _source.size(); position += 7) {
+            std::vector<uint32_t> haplotypes{};
+            for (uint32_t haplotype = 10; haplotype < haplotype_count; ++haplotype)
+                if (generator() % 5 == 0)
+                    haplotypes.push_back(haplotype);
+            if (haplotypes.empty())
+                continue;
+
+            switch (position % 3) {
+                case 0: add(libjst::breakpoint{position, 1u}, source_t{(_source[position] == 'A') ? 'C' : 'A'},
+                            haplotypes);
+                        break;
+                case 1: add(libjst::breakpoint{position, 0u}, "GA", haplotypes); break;
+                default: add(libjst::breakpoint{position, 3u}, "", haplotypes); break;
+            }
+        }
+
+        std::ranges::stable_sort(variants, std::ranges::less{}, [] (auto const & variant) {
+            return libjst::low_breakend(variant);
+        });
+        _store.emplace(_source, haplotype_count, variants);
+
+        for (auto & variants : applied) {
+            std::ranges::sort(variants, std::ranges::less{}, [] (auto const & variant) {
+                return libjst::low_breakend(variant.first);
+            });
+            tagged_haplotype_t haplotype{};
+            std::size_t source_position{};
+            for (auto const & [breakpoint, alt] : variants) {
+                for (; source_position < libjst::low_breakend(breakpoint); ++source_position)
+                    haplotype.emplace_back(_source[source_position], source_position);
+                for (char symbol : alt)
+                    haplotype.emplace_back(symbol, libjst::low_breakend(breakpoint));
+                source_position = libjst::high_breakend(breakpoint);
+            }
+            for (; source_position < _source.size(); ++source_position)
+                haplotype.emplace_back(_source[source_position], source_position);
+            _haplotypes.push_back(std::move(haplotype));
+        }
+    }
+
+    std::map<sequence_t, std::vector<uint32_t>> expected_region(std::size_t first, std::size_t last) const {
+        std::map<sequence_t, std::vector<uint32_t>> groups{};
+        for (uint32_t haplotype = 0; haplotype < haplotype_count; ++haplotype) {
+            sequence_t region{};
+            for (auto const & [symbol, position] : _haplotypes[haplotype])
+                if (first <= position && position < last)
+                    region.push_back(symbol);
+            groups[region].push_back(haplotype);
+        }
+        return groups;
+    }
+
+    template <typename haplotypes_t>
+    static std::map<sequence_t, std::vector<uint32_t>> as_groups(haplotypes_t const & haplotypes) {
+        std::map<sequence_t, std::vector<uint32_t>> groups{};
+        for (auto const & haplotype : haplotypes) {
+            auto & ids = groups[haplotype.sequence];
+            EXPECT_TRUE(ids.empty()) << "The sequences are not distinct.";
+            for (uint32_t id = 0; id < haplotype_count; ++id)
+                if (libjst::covers(haplotype.coverage, id))
+                    ids.push_back(id);
+        }
+        return groups;
+    }
+};
+
+} // namespace jst::test::region_viewer
+
+using region_viewer_test = jst::test::region_viewer::test;
+
+TEST_F(region_viewer_test, max_deletion_size) {
+    libjst::region_viewer viewer{*_store};
+    EXPECT_EQ(viewer.max_deletion_size(), 150u);
+}
+
+TEST_F(region_viewer_test, regions) {
+    libjst::region_viewer viewer{*_store};
+
+    for (std::size_t first = 0; first < _source.size(); first += 37) {
+        for (std::size_t size : {1u, 10u, 50u, 200u}) {
+            std::size_t const last = std::min(first + size, _source.size());
+            EXPECT_EQ(as_groups(viewer(first, last)), expected_region(first, last))
+                << "region [" << first << ", " << last << ")";
+        }
+    }
+}
+
+TEST_F(region_viewer_test, regions_with_position_index) {
+    _store->build_position_index(16); // the regions are located through the samples of every 16 positions.
+    ASSERT_TRUE(_store->variants().has_position_index());
+    libjst::region_viewer viewer{*_store};
+
+    for (std::size_t first = 0; first < _source.size(); first += 37) {
+        for (std::size_t size : {1u, 10u, 50u, 200u}) {
+            std::size_t const last = std::min(first + size, _source.size());
+            EXPECT_EQ(as_groups(viewer(first, last)), expected_region(first, last))
+                << "region [" << first << ", " << last << ")";
+        }
+    }
+}
+
+TEST_F(region_viewer_test, spanning_deletion) {
+    libjst::region_viewer viewer{*_store};
+
+    // The region lies within the long deletion of the haplotypes 0 to 2.
+    auto haplotypes = viewer(150, 200);
+    auto groups = as_groups(haplotypes);
+    ASSERT_TRUE(groups.contains(sequence_t{}));
+    EXPECT_EQ(groups[sequence_t{}], (std::vector<uint32_t>{0, 1, 2}));
+    EXPECT_EQ(groups, expected_region(150, 200));
+}
+
+TEST_F(region_viewer_test, whole_source) {
+    libjst::region_viewer viewer{*_store};
+    EXPECT_EQ(as_groups(viewer(0, _source.size() + 100)), expected_region(0, _source.size()));
+}
+
+TEST_F(region_viewer_test, empty_region) {
+    libjst::region_viewer viewer{*_store};
+
+    auto haplotypes = viewer(300, 300);
+    ASSERT_EQ(haplotypes.size(), 1u);
+    EXPECT_TRUE(haplotypes[0].sequence.empty());
+    EXPECT_EQ(haplotypes[0].coverage.size(), haplotype_count);
+
+    EXPECT_THROW(viewer(301, 300), std::out_of_range);
+    EXPECT_THROW(viewer(_source.size() + 1, _source.size() + 5), std::out_of_range);
+}
@@ -0,0 +1,202 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/haplotype_viewer.hpp>
+#include <libjst/rcms/interior_breakends.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/rcms/sample_partitioned_store.hpp>
+#include <libjst/sequence_tree/volatile_tree.hpp>
+#include <libjst/traversal/kmer_index.hpp>
+
+using namespace std::literals;
+
+struct sample_partitioned_store_test : public ::testing::Test {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using cms_type = libjst::dna_compressed_multisequence<std::string, coverage_type>;
+    using store_type = libjst::rcs_store<std::string, cms_type>;
+    using value_type = std::ranges::range_value_t<cms_type>;
+    using partitioned_type = libjst::sample_partitioned_store<std::string, cms_type>;
+
+    static constexpr uint32_t haplotype_count{10};
+
+    std::string source{};
+    store_type store{};
+
+    void SetUp() override {
+        std::mt19937_64 generator{42};
+        source.resize(300);
+        std::ranges::generate(source, [&] () { return "ACGT"[generator() % 4]; });
+
+        store = store_type{source, haplotype_count};
+        auto domain = store.variants().coverage_domain();
+        // Carried by the first haplotype only, i.e. only by the first partition.
+        store.add(value_type{libjst::breakpoint{5u, 1u}, std::string(1, source[5] == 'A' ? 'C' : 'A'),
+                             coverage_type{{0u}, domain}});
+        for (uint32_t position = 20; position + 10 < source.size(); position += 7 + generator() % 20) {
+            std::vector<uint32_t> haplotypes{};
+            for (uint32_t haplotype = 0; haplotype < haplotype_count; ++haplotype)
+                if (generator() % 3 == 0)
+                    haplotypes.push_back(haplotype);
+            if (haplotypes.empty())
+                continue;
+
+            value_type variant = (generator() % 8 == 0) ?
+                value_type{libjst::breakpoint{position, 3u}, ""s, coverage_type{haplotypes, domain}} :
+                value_type{libjst::breakpoint{position, 1u}, std::string(1, source[position] == 'A' ? 'G' : 'A'),
+                           coverage_type{haplotypes, domain}};
+            if (!store.variants().has_conflicts(variant))
+                store.add(std::move(variant));
+        }
+    }
+
+    // The low breakends of the variants, i.e. one per variant.
+    static std::size_t variant_count(store_type const & store) {
+        return std::ranges::count_if(libjst::interior_breakends(store.variants()), [] (auto && breakend) {
+            return breakend.get_breakpoint_end() == libjst::breakpoint_end::low;
+        });
+    }
+
+    static std::vector<uint32_t> members(coverage_type const & coverage) {
+        std::vector<uint32_t> ids{};
+        libjst::for_each_covered(coverage, 0, coverage.size(), [&] (std::size_t const id) { ids.push_back(id); });
+        return ids;
+    }
+
+    // Every indexed k-mer with the coverage of the node spelling it.
+    static void index_kmers(store_type const & store, std::vector<std::pair<uint64_t, coverage_type>> & hits) {
+        auto index = libjst::build_kmer_index(libjst::volatile_tree{store}, 6);
+        for (auto const & entry : index.entries())
+            hits.emplace_back(entry.kmer, index.coverage(entry));
+    }
+};
+
+TEST_F(sample_partitioned_store_test, rows)
+{
+    partitioned_type partitioned{store, 3};
+
+    EXPECT_EQ(partitioned.partition_count(), 3u);
+    EXPECT_EQ(partitioned.size(), haplotype_count);
+    EXPECT_EQ(partitioned.partition_rows(0).min(), 0u);
+    EXPECT_EQ(partitioned.partition_rows(1).min(), 3u);
+    EXPECT_EQ(partitioned.partition_rows(2).min(), 6u);
+    EXPECT_EQ(partitioned.partition_rows(2).max(), 10u);
+    EXPECT_EQ(partitioned.partition(0).size(), 3u);
+    EXPECT_EQ(partitioned.partition(2).size(), 4u);
+    EXPECT_EQ(partitioned.partition_of(0), 0u);
+    EXPECT_EQ(partitioned.partition_of(2), 0u);
+    EXPECT_EQ(partitioned.partition_of(3), 1u);
+    EXPECT_EQ(partitioned.partition_of(9), 2u);
+
+    EXPECT_THROW((partitioned_type{store, 0}), std::invalid_argument);
+    EXPECT_THROW((partitioned_type{store, haplotype_count + 1}), std::invalid_argument);
+}
+
+TEST_F(sample_partitioned_store_test, haplotypes)
+{
+    for (std::size_t partition_count : {1u, 3u, 10u}) {
+        partitioned_type partitioned{store, partition_count};
+
+        std::vector<std::vector<char>> haplotypes{};
+        for (std::size_t partition_id = 0; partition_id < partitioned.partition_count(); ++partition_id) {
+            std::ranges::copy(libjst::haplotype_viewer{partitioned.partition(partition_id)}.materialise_all(),
+                              std::back_inserter(haplotypes));
+        }
+        EXPECT_EQ(haplotypes, libjst::haplotype_viewer{store}.materialise_all()) << partition_count;
+    }
+}
+
+TEST_F(sample_partitioned_store_test, carried_variants)
+{
+    partitioned_type partitioned{store, 3};
+
+    std::size_t partition_variant_count{};
+    for (std::size_t partition_id = 0; partition_id < partitioned.partition_count(); ++partition_id) {
+        store_type const & partition = partitioned.partition(partition_id);
+        EXPECT_EQ(partition.variants().coverage_domain().size(), partitioned.partition_rows(partition_id).size());
+        for (auto && breakend : libjst::interior_breakends(partition.variants())) {
+            value_type variant = breakend;
+            EXPECT_TRUE(libjst::coverage(variant).any());
+        }
+        partition_variant_count += variant_count(partition);
+    }
+    // The SNV of the first haplotype is only stored by the first partition.
+    auto at_snv = [] (auto && breakend) { return libjst::position(breakend) == 5u; };
+    EXPECT_EQ(std::ranges::count_if(libjst::interior_breakends(partitioned.partition(0).variants()), at_snv), 1);
+    EXPECT_EQ(std::ranges::count_if(libjst::interior_breakends(partitioned.partition(1).variants()), at_snv), 0);
+    EXPECT_LT(partition_variant_count, variant_count(store) * partitioned.partition_count());
+}
+
+TEST_F(sample_partitioned_store_test, store_coverage)
+{
+    partitioned_type partitioned{store, 3};
+
+    coverage_type coverage{{0u, 2u}, partitioned.partition(1).variants().coverage_domain()};
+    coverage_type lifted = partitioned.store_coverage(coverage, 1);
+    EXPECT_EQ(members(lifted), (std::vector<uint32_t>{3, 5}));
+    EXPECT_EQ(lifted.get_domain(), store.variants().coverage_domain());
+}
+
+TEST_F(sample_partitioned_store_test, search)
+{
+    std::vector<std::pair<uint64_t, coverage_type>> store_hits{};
+    index_kmers(store, store_hits);
+    std::ranges::stable_sort(store_hits, std::ranges::less{}, &std::pair<uint64_t, coverage_type>::first);
+    std::vector<std::pair<uint64_t, std::vector<uint32_t>>> expected{};
+    for (auto const & [kmer, coverage] : store_hits) {
+        if (expected.empty() || expected.back().first != kmer)
+            expected.emplace_back(kmer, std::vector<uint32_t>{});
+        std::vector<uint32_t> rows = members(coverage);
+        std::vector<uint32_t> & covered = expected.back().second;
+        covered.insert(covered.end(), rows.begin(), rows.end());
+        std::ranges::sort(covered);
+        covered.erase(std::ranges::unique(covered).begin(), covered.end());
+    }
+
+    for (std::size_t partition_count : {1u, 3u, 10u}) {
+        partitioned_type partitioned{store, partition_count};
+        auto hits = partitioned.search<uint64_t>([] (std::size_t, store_type const & partition, auto & partition_hits) {
+            index_kmers(partition, partition_hits);
+        }, 2);
+
+        std::vector<std::pair<uint64_t, std::vector<uint32_t>>> actual{};
+        for (auto const & [kmer, coverage] : hits)
+            actual.emplace_back(kmer, members(coverage));
+        EXPECT_EQ(actual, expected) << partition_count;
+    }
+}
+
+TEST_F(sample_partitioned_store_test, merge_hits)
+{
+    partitioned_type partitioned{store, 2};
+
+    coverage_type first{{0u}, partitioned.partition(0).variants().coverage_domain()};
+    coverage_type second{{1u}, partitioned.partition(1).variants().coverage_domain()};
+    auto hits = partitioned.merge_hits(std::vector<std::vector<std::pair<int, coverage_type>>>{
+        {{7, first}, {3, first}},
+        {{7, second}}
+    });
+    ASSERT_EQ(hits.size(), 2u);
+    EXPECT_EQ(hits[0].first, 3);
+    EXPECT_EQ(members(hits[0].second), (std::vector<uint32_t>{0}));
+    EXPECT_EQ(hits[1].first, 7);
+    EXPECT_EQ(members(hits[1].second), (std::vector<uint32_t>{0, 6}));
+
+    EXPECT_THROW(partitioned.merge_hits(std::vector<std::vector<std::pair<int, coverage_type>>>(3)),
+                 std::invalid_argument);
+}
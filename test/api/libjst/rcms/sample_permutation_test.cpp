@@ -0,0 +1,135 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/coverage/concept.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/rcms/sample_permutation.hpp>
+
+using namespace std::literals;
+
+struct sample_permutation_test : public ::testing::Test {
+    using source_type = std::string;
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using coverage_domain_type = libjst::coverage_domain_t<coverage_type>;
+    using cms_type = libjst::dna_compressed_multisequence<source_type, coverage_type>;
+    using value_type = std::ranges::range_value_t<cms_type>;
+    using rcs_store_t = libjst::rcs_store<source_type, cms_type>;
+
+    static constexpr std::size_t sample_count{8};
+
+    source_type src{"AAAAAAAAAAAAAAAAAAAA"s};
+    coverage_domain_type domain{0, sample_count};
+
+    // The even samples share the first two variants and the odd samples the last two.
+    std::vector<value_type> deltas{value_type{libjst::breakpoint{1, 1}, "T"s, coverage_type{{0, 2, 4, 6}, domain}},
+                                   value_type{libjst::breakpoint{4, 2}, ""s, coverage_type{{0, 2, 4}, domain}},
+                                   value_type{libjst::breakpoint{9, 0}, "CC"s, coverage_type{{1, 3, 5, 7}, domain}},
+                                   value_type{libjst::breakpoint{14, 1}, "G"s, coverage_type{{3, 5}, domain}}};
+
+    // Counts the runs of set bits of all coverages, which the permutation is meant to reduce.
+    static std::size_t count_runs(cms_type const & variants) {
+        std::size_t run_count{};
+        for (auto && breakend : variants) {
+            bool previous{false};
+            for (bool const covered : libjst::coverage(breakend)) {
+                run_count += covered && !previous;
+                previous = covered;
+            }
+        }
+        return run_count;
+    }
+};
+
+TEST_F(sample_permutation_test, construct) {
+    libjst::sample_permutation const permutation{std::vector<std::size_t>{2, 0, 3, 1}};
+
+    EXPECT_EQ(permutation.size(), 4u);
+    EXPECT_FALSE(permutation.empty());
+    EXPECT_EQ(permutation.original_sample(0), 2u);
+    EXPECT_EQ(permutation.original_sample(3), 1u);
+    EXPECT_EQ(permutation.row_of(2), 0u);
+    EXPECT_EQ(permutation.row_of(1), 3u);
+    EXPECT_EQ(permutation.original_samples(), (std::vector<std::size_t>{2, 0, 3, 1}));
+
+    EXPECT_TRUE(libjst::sample_permutation{}.empty());
+    EXPECT_THROW((libjst::sample_permutation{std::vector<std::size_t>{0, 0, 1}}), std::invalid_argument);
+    EXPECT_THROW((libjst::sample_permutation{std::vector<std::size_t>{0, 3}}), std::invalid_argument);
+}
+
+TEST_F(sample_permutation_test, by_similarity) {
+    cms_type const multisequence{src, domain, deltas};
+    libjst::sample_permutation const permutation = libjst::sample_permutation::by_similarity(multisequence);
+
+    // The carriers of the most common variant come first, ties keep the input order.
+    EXPECT_EQ(permutation.original_samples(), (std::vector<std::size_t>{0, 2, 4, 6, 3, 5, 1, 7}));
+
+    // With a signature of one variant only the carriers of the first variant are grouped.
+    libjst::sample_permutation const first_only = libjst::sample_permutation::by_similarity(multisequence, 1);
+    EXPECT_EQ(first_only.original_samples(), (std::vector<std::size_t>{0, 2, 4, 6, 1, 3, 5, 7}));
+
+    cms_type const empty{src, coverage_domain_type{0, 0}};
+    EXPECT_TRUE(libjst::sample_permutation::by_similarity(empty).empty());
+}
+
+TEST_F(sample_permutation_test, reorder_samples) {
+    cms_type const multisequence{src, domain, deltas};
+    libjst::sample_permutation const permutation = libjst::sample_permutation::by_similarity(multisequence);
+
+    for (std::size_t const thread_count : {1u, 2u, 16u}) {
+        cms_type const reordered = multisequence.reorder_samples(permutation, thread_count);
+
+        EXPECT_TRUE(reordered.coverage_domain() == domain);
+        EXPECT_LT(count_runs(reordered), count_runs(multisequence));
+        ASSERT_EQ(reordered.size(), multisequence.size());
+        auto expected_it = multisequence.begin();
+        for (auto && actual : reordered) {
+            EXPECT_EQ(libjst::low_breakend(actual), libjst::low_breakend(*expected_it));
+            EXPECT_EQ(libjst::high_breakend(actual), libjst::high_breakend(*expected_it));
+            EXPECT_TRUE(std::ranges::equal(libjst::alt_sequence(actual), libjst::alt_sequence(*expected_it)));
+
+            // Every row maps back to the sample it stores.
+            auto const & actual_coverage = libjst::coverage(actual);
+            auto const & expected_coverage = libjst::coverage(*expected_it);
+            for (std::size_t row = 0; row < sample_count; ++row)
+                EXPECT_EQ(actual_coverage[row], expected_coverage[permutation.original_sample(row)]);
+            ++expected_it;
+        }
+    }
+
+    EXPECT_THROW(multisequence.reorder_samples(libjst::sample_permutation{std::vector<std::size_t>{1, 0}}),
+                 std::domain_error);
+}
+
+TEST_F(sample_permutation_test, reorder_store) {
+    rcs_store_t const store{src, sample_count, deltas};
+    libjst::sample_permutation const permutation = libjst::sample_permutation::by_similarity(store.variants());
+    rcs_store_t const reordered = store.reorder_samples(permutation, 2);
+
+    EXPECT_EQ(reordered.size(), sample_count);
+    EXPECT_TRUE(std::ranges::equal(reordered.source(), src));
+    EXPECT_EQ(count_runs(reordered.variants()), 7u); // one run per breakend, including the sentinels
+
+    // The identity permutation reproduces the store.
+    std::vector<std::size_t> identity(sample_count);
+    std::ranges::generate(identity, [row = std::size_t{0}] () mutable { return row++; });
+    rcs_store_t const unchanged = store.reorder_samples(libjst::sample_permutation{std::move(identity)});
+    ASSERT_EQ(unchanged.variants().size(), store.variants().size());
+    EXPECT_TRUE(std::ranges::equal(unchanged.variants(), store.variants(), [] (auto && lhs, auto && rhs) {
+        return libjst::coverage(lhs) == libjst::coverage(rhs);
+    }));
+}
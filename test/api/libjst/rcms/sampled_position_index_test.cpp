@@ -0,0 +1,79 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <libjst/rcms/sampled_position_index.hpp>
+
+namespace jst::test::sampled_position_index {
+
+struct test : public ::testing::Test {
+    using index_t = libjst::sampled_position_index<>;
+
+    // The breakend positions including the sentinels at 0 and at the source size.
+    std::vector<uint32_t> positions{0, 1, 1, 2, 7, 8, 8, 8, 9, 15, 16, 33, 33, 40, 40};
+    std::size_t source_size{40};
+
+    void expect_lower_bounds(index_t const & index) const {
+        for (std::size_t position = 0; position <= source_size + 10; ++position) {
+            auto [first, last] = index.candidates(position);
+            ASSERT_LE(first, last);
+            auto block_begin = std::ranges::next(positions.begin(), first);
+            auto block_end = std::ranges::next(positions.begin(), last);
+            std::size_t const actual = std::ranges::lower_bound(block_begin, block_end, position) - positions.begin();
+            std::size_t const expected = std::ranges::lower_bound(positions, position) - positions.begin();
+            EXPECT_EQ(actual, expected) << "position: " << position;
+        }
+    }
+};
+
+} // namespace jst::test::sampled_position_index
+
+using sampled_position_index_test = jst::test::sampled_position_index::test;
+
+// ----------------------------------------------------------------------------
+// Test case definitions
+// ----------------------------------------------------------------------------
+
+TEST_F(sampled_position_index_test, default_construction) {
+    index_t index{};
+    EXPECT_TRUE(index.empty());
+}
+
+TEST_F(sampled_position_index_test, lower_bound) {
+    for (std::size_t const sample_distance : {1u, 2u, 8u, 16u, 64u, 4096u}) {
+        index_t const index{positions, source_size, sample_distance};
+        EXPECT_FALSE(index.empty());
+        EXPECT_EQ(index.sample_distance(), sample_distance);
+        expect_lower_bounds(index);
+    }
+}
+
+TEST_F(sampled_position_index_test, candidates) {
+    index_t const index{positions, source_size, 8};
+    EXPECT_EQ(index.candidates(3), (std::pair<std::size_t, std::size_t>{0, 5}));
+    EXPECT_EQ(index.candidates(8), (std::pair<std::size_t, std::size_t>{5, 10}));
+    EXPECT_EQ(index.candidates(20), (std::pair<std::size_t, std::size_t>{10, 11}));
+    EXPECT_EQ(index.candidates(40), (std::pair<std::size_t, std::size_t>{13, 15}));
+    EXPECT_EQ(index.candidates(1000), (std::pair<std::size_t, std::size_t>{13, 15}));
+}
+
+TEST_F(sampled_position_index_test, invalid_sample_distance) {
+    EXPECT_THROW((index_t{positions, source_size, 0}), std::invalid_argument);
+    EXPECT_THROW((index_t{positions, source_size, 12}), std::invalid_argument);
+}
+
+TEST_F(sampled_position_index_test, offset_overflow) {
+    std::vector<uint32_t> many_positions(300, 1);
+    EXPECT_THROW((libjst::sampled_position_index<uint8_t>{many_positions, 2, 1}), std::length_error);
+}
@@ -0,0 +1,89 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <ranges>
+#include <string>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/sharded_rcs_builder.hpp>
+
+using namespace std::literals;
+
+struct sharded_rcs_builder_test : public ::testing::TestWithParam<std::size_t> {
+    using source_type = std::string;
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using coverage_domain_type = libjst::coverage_domain_t<coverage_type>;
+
+    using cms_type = libjst::dna_compressed_multisequence<source_type, coverage_type>;
+    using value_type = std::ranges::range_value_t<cms_type>;
+    using builder_type = libjst::sharded_rcs_builder<source_type, cms_type>;
+
+    source_type source{"AAAAAAAAAAAAAAAAAAAAAAAA"s};
+    coverage_domain_type domain{0, 8};
+
+    std::vector<value_type> make_deltas() const {
+        coverage_type cov1{{0, 1, 2}, domain};
+        coverage_type cov2{{3, 4}, domain};
+        coverage_type cov3{{5, 7}, domain};
+        return {value_type{libjst::breakpoint{1, 1}, "T"s, cov1},
+                value_type{libjst::breakpoint{2, 9}, ""s, cov2}, // spans into the following shards
+                value_type{libjst::breakpoint{4, 0}, "CC"s, cov1},
+                value_type{libjst::breakpoint{6, 1}, "G"s, cov3},
+                value_type{libjst::breakpoint{11, 1}, "C"s, cov1},
+                value_type{libjst::breakpoint{12, 3}, ""s, cov3},
+                value_type{libjst::breakpoint{17, 0}, "GT"s, cov2},
+                value_type{libjst::breakpoint{23, 1}, "C"s, cov2}};
+    }
+};
+
+TEST_P(sharded_rcs_builder_test, construct) {
+    builder_type builder{source, 8u, GetParam()};
+    EXPECT_EQ(builder.shard_count(), std::max<std::size_t>(GetParam(), 1));
+}
+
+TEST_P(sharded_rcs_builder_test, build) {
+    std::vector<value_type> deltas = make_deltas();
+    cms_type expected{source, domain, deltas};
+
+    auto store = builder_type{source, 8u, GetParam()}(deltas);
+    cms_type const & actual = store.variants();
+
+    EXPECT_EQ(store.size(), 8u);
+    EXPECT_TRUE(std::ranges::equal(store.source(), source));
+    EXPECT_TRUE(actual.coverage_domain() == domain);
+    ASSERT_EQ(actual.size(), expected.size());
+    auto actual_it = actual.begin();
+    for (auto && expected_delta : expected) {
+        EXPECT_EQ(libjst::low_breakend(*actual_it), libjst::low_breakend(expected_delta));
+        EXPECT_EQ(libjst::high_breakend(*actual_it), libjst::high_breakend(expected_delta));
+        EXPECT_TRUE(std::ranges::equal(libjst::alt_sequence(*actual_it), libjst::alt_sequence(expected_delta)));
+        EXPECT_EQ(libjst::coverage(*actual_it), libjst::coverage(expected_delta));
+        ++actual_it;
+    }
+}
+
+TEST_P(sharded_rcs_builder_test, build_empty) {
+    auto store = builder_type{source, 8u, GetParam()}(std::vector<value_type>{});
+
+    EXPECT_EQ(store.variants().size(), 2u);
+    EXPECT_EQ(libjst::low_breakend(*store.variants().begin()), 0u);
+    EXPECT_EQ(libjst::low_breakend(*std::ranges::prev(store.variants().end())), source.size());
+}
+
+TEST_P(sharded_rcs_builder_test, propagate_exception) {
+    std::vector<value_type> deltas = make_deltas();
+    deltas.push_back(value_type{libjst::breakpoint{20, 1}, "N"s, coverage_type{{0}, domain}});
+
+    EXPECT_THROW(builder_type(source, 8u, GetParam())(deltas), std::invalid_argument);
+}
+
+INSTANTIATE_TEST_SUITE_P(shard_counts, sharded_rcs_builder_test, testing::Values(0u, 1u, 2u, 3u, 4u, 8u, 30u));
@@ -0,0 +1,95 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/rcms/source_mask.hpp>
+
+using namespace std::literals;
+
+using intervals_t = std::vector<libjst::source_interval>;
+
+TEST(source_mask_test, empty) {
+    libjst::source_mask mask{};
+    EXPECT_TRUE(mask.empty());
+    EXPECT_EQ(mask.masked_size(), 0u);
+    EXPECT_FALSE(mask.contains(0));
+    EXPECT_EQ(mask.unmasked(10), (intervals_t{{0, 10}}));
+    EXPECT_EQ(mask.unmasked(0), intervals_t{});
+}
+
+TEST(source_mask_test, normalise) {
+    libjst::source_mask mask{intervals_t{{20, 25}, {3, 5}, {7, 7}, {4, 9}, {9, 12}, {30, 31}}};
+    EXPECT_EQ((intervals_t{mask.begin(), mask.end()}), (intervals_t{{3, 12}, {20, 25}, {30, 31}}));
+    EXPECT_EQ(mask.masked_size(), 15u);
+    EXPECT_FALSE(mask.contains(2));
+    EXPECT_TRUE(mask.contains(3));
+    EXPECT_TRUE(mask.contains(11));
+    EXPECT_FALSE(mask.contains(12));
+    EXPECT_TRUE(mask.contains(30));
+    EXPECT_FALSE(mask.contains(31));
+}
+
+TEST(source_mask_test, unmasked) {
+    libjst::source_mask mask{intervals_t{{0, 2}, {10, 12}, {30, 40}}};
+    EXPECT_EQ(mask.unmasked(35), (intervals_t{{2, 10}, {12, 30}}));
+    EXPECT_EQ(mask.unmasked(45), (intervals_t{{2, 10}, {12, 30}, {40, 45}}));
+    EXPECT_EQ(mask.unmasked(11), (intervals_t{{2, 10}}));
+    EXPECT_EQ(mask.unmasked(35, 7), (intervals_t{{2, 9}, {9, 10}, {12, 19}, {19, 26}, {26, 30}}));
+}
+
+TEST(source_mask_test, unknown_runs) {
+    std::string const source{"NNACGTnNNNACNAGTNNN"};
+    EXPECT_EQ(libjst::source_mask::unknown_runs(source, 1),
+              (libjst::source_mask{intervals_t{{0, 2}, {6, 10}, {12, 13}, {16, 19}}}));
+    EXPECT_EQ(libjst::source_mask::unknown_runs(source, 3), (libjst::source_mask{intervals_t{{6, 10}, {16, 19}}}));
+    EXPECT_TRUE(libjst::source_mask::unknown_runs("ACGT"s, 1).empty());
+}
+
+TEST(source_mask_test, merge) {
+    libjst::source_mask mask = libjst::source_mask::unknown_runs("ACNNNNGTACGT"s, 2);
+    mask.merge(libjst::source_mask{intervals_t{{5, 8}, {10, 11}}});
+    EXPECT_EQ((intervals_t{mask.begin(), mask.end()}), (intervals_t{{2, 8}, {10, 11}}));
+}
+
+TEST(source_mask_test, insert) {
+    libjst::source_mask mask{};
+    mask.insert({10, 12}).insert({2, 4}).insert({20, 25}).insert({5, 5});
+    EXPECT_EQ((intervals_t{mask.begin(), mask.end()}), (intervals_t{{2, 4}, {10, 12}, {20, 25}}));
+
+    mask.insert({4, 6}); // adjacent to the first interval
+    EXPECT_EQ((intervals_t{mask.begin(), mask.end()}), (intervals_t{{2, 6}, {10, 12}, {20, 25}}));
+
+    mask.insert({11, 21}); // spans the last two intervals
+    EXPECT_EQ((intervals_t{mask.begin(), mask.end()}), (intervals_t{{2, 6}, {10, 25}}));
+
+    mask.insert({0, 30});
+    EXPECT_EQ((intervals_t{mask.begin(), mask.end()}), (intervals_t{{0, 30}}));
+    EXPECT_GE(mask.memory_usage(), sizeof(libjst::source_interval));
+}
+
+TEST(source_mask_test, rcs_store) {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using cms_type = libjst::dna_compressed_multisequence<std::string, coverage_type>;
+    using store_type = libjst::rcs_store<std::string, cms_type>;
+
+    store_type store{"ACGTNNNNACGTNNACGT"s, 4};
+    EXPECT_FALSE(store.has_n_run_mask());
+
+    store.build_n_run_mask(3);
+    EXPECT_TRUE(store.has_n_run_mask());
+    EXPECT_EQ(store.n_run_mask(), (libjst::source_mask{intervals_t{{4, 8}}}));
+
+    store.build_n_run_mask(1);
+    EXPECT_EQ(store.n_run_mask(), (libjst::source_mask{intervals_t{{4, 8}, {12, 14}}}));
+}
@@ -0,0 +1,161 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/interior_breakends.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/rcms/store_diff.hpp>
+
+namespace jst::test::store_diff {
+
+using source_t = std::string;
+
+struct test : public ::testing::Test {
+    using coverage_t = libjst::bit_coverage<uint32_t>;
+    using coverage_domain_t = libjst::coverage_domain_t<coverage_t>;
+    using cms_t = libjst::dna_compressed_multisequence<source_t, coverage_t>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+    using rcs_store_t = libjst::rcs_store<source_t, cms_t>;
+
+    static constexpr uint32_t haplotype_count{50};
+
+    source_t _source{};
+    std::vector<cms_value_t> _variants{};
+    coverage_domain_t _domain{0, haplotype_count};
+
+    void SetUp() override {
+        std::mt19937 generator{7};
+        for (std::size_t idx = 0; idx < 1000; ++idx)
+            _source.push_back("ACGT"[generator() % 4]);
+
+        for (uint32_t position = 5; position + 8 < _source.size(); position += 9) {
+            coverage_t coverage{{position % haplotype_count, (position * 7) % haplotype_count}, _domain};
+            switch (position % 3) {
+                case 0: _variants.push_back(cms_value_t{libjst::breakpoint{position, 1u},
+                                                        source_t{(_source[position] == 'A') ? 'C' : 'A'},
+                                                        coverage});
+                        break;
+                case 1: _variants.push_back(cms_value_t{libjst::breakpoint{position, 0u}, "GAT", coverage});
+                        break;
+                default: _variants.push_back(cms_value_t{libjst::breakpoint{position, 4u}, "", coverage});
+                         break;
+            }
+        }
+    }
+
+    // Returns the deltas of the store ordered by libjst::delta_order.
+    static std::vector<cms_value_t> deltas(rcs_store_t const & store) {
+        std::vector<cms_value_t> values{};
+        for (auto && breakend : libjst::interior_breakends(store.variants()))
+            if (breakend.get_breakpoint_end() != libjst::breakpoint_end::high)
+                values.push_back(breakend);
+        std::ranges::sort(values, libjst::delta_order{});
+        return values;
+    }
+
+    static bool same_deltas(rcs_store_t const & lhs, rcs_store_t const & rhs) {
+        std::vector<cms_value_t> const lhs_deltas = deltas(lhs);
+        std::vector<cms_value_t> const rhs_deltas = deltas(rhs);
+        return std::ranges::equal(lhs_deltas, rhs_deltas, [] (cms_value_t const & a, cms_value_t const & b) {
+            libjst::delta_order const less{};
+            return !less(a, b) && !less(b, a) && libjst::coverage(a) == libjst::coverage(b);
+        });
+    }
+};
+
+} // namespace jst::test::store_diff
+
+using store_diff_test = jst::test::store_diff::test;
+using jst::test::store_diff::source_t;
+
+TEST_F(store_diff_test, identical) {
+    rcs_store_t lhs{_source, haplotype_count, _variants};
+    rcs_store_t rhs{_source, haplotype_count, _variants};
+    auto delta = libjst::diff(lhs, rhs);
+    EXPECT_TRUE(delta.empty());
+    EXPECT_TRUE(same_deltas(libjst::patch(lhs, delta), rhs));
+
+    rcs_store_t empty{_source, haplotype_count};
+    EXPECT_TRUE(libjst::diff(empty, empty).empty());
+}
+
+TEST_F(store_diff_test, added_removed_changed) {
+    rcs_store_t lhs{_source, haplotype_count, _variants};
+
+    std::vector<cms_value_t> rhs_variants = _variants;
+    cms_value_t const removed = rhs_variants[3];
+    rhs_variants.erase(rhs_variants.begin() + 3);
+    libjst::coverage(rhs_variants[10]) = coverage_t{{1, 2, 3}, _domain};
+    // An insertion at the position of a stored insertion with another sequence and a SNV at a new position.
+    uint32_t const insertion_position = libjst::low_breakend(rhs_variants[20]);
+    cms_value_t const added_insertion{libjst::breakpoint{insertion_position, 0u}, "CC", coverage_t{{4}, _domain}};
+    cms_value_t const added_snv{libjst::breakpoint{999u, 1u}, source_t{(_source[999] == 'A') ? 'T' : 'A'},
+                                coverage_t{{5}, _domain}};
+    rhs_variants.push_back(added_insertion);
+    rhs_variants.push_back(added_snv);
+    rcs_store_t rhs{_source, haplotype_count, rhs_variants};
+
+    auto delta = libjst::diff(lhs, rhs);
+    ASSERT_EQ(delta.removed.size(), 1u);
+    EXPECT_EQ(libjst::low_breakend(delta.removed[0]), libjst::low_breakend(removed));
+    ASSERT_EQ(delta.changed.size(), 1u);
+    EXPECT_TRUE(libjst::coverage(delta.changed[0]) == (coverage_t{{1, 2, 3}, _domain}));
+    ASSERT_EQ(delta.added.size(), 2u);
+    EXPECT_EQ(libjst::low_breakend(delta.added[0]), insertion_position);
+    EXPECT_EQ(libjst::low_breakend(delta.added[1]), 999u);
+
+    rcs_store_t patched = libjst::patch(lhs, delta);
+    EXPECT_TRUE(same_deltas(patched, rhs));
+    EXPECT_TRUE(patched.validate().valid());
+    EXPECT_TRUE(libjst::diff(patched, rhs).empty());
+    EXPECT_TRUE(same_deltas(libjst::patch(patched, delta), rhs)); // applying the delta twice has no effect
+
+    auto inverse = libjst::diff(rhs, lhs);
+    EXPECT_EQ(inverse.added.size(), delta.removed.size());
+    EXPECT_EQ(inverse.removed.size(), delta.added.size());
+    EXPECT_TRUE(same_deltas(libjst::patch(rhs, inverse), lhs));
+}
+
+TEST_F(store_diff_test, from_empty) {
+    rcs_store_t empty{_source, haplotype_count};
+    rcs_store_t full{_source, haplotype_count, _variants};
+
+    auto delta = libjst::diff(empty, full);
+    EXPECT_EQ(delta.added.size(), _variants.size());
+    EXPECT_TRUE(delta.removed.empty());
+    EXPECT_TRUE(same_deltas(libjst::patch(empty, delta), full));
+
+    auto inverse = libjst::diff(full, empty);
+    EXPECT_EQ(inverse.removed.size(), _variants.size());
+    EXPECT_TRUE(same_deltas(libjst::patch(full, inverse), empty));
+}
+
+TEST_F(store_diff_test, mismatch) {
+    rcs_store_t lhs{_source, haplotype_count, _variants};
+    rcs_store_t wider{_source, haplotype_count + 1};
+    EXPECT_THROW(libjst::diff(lhs, wider), std::domain_error);
+
+    source_t other_source = _source;
+    other_source[10] = (other_source[10] == 'A') ? 'C' : 'A';
+    rcs_store_t other{other_source, haplotype_count};
+    EXPECT_THROW(libjst::diff(lhs, other), std::invalid_argument);
+
+    libjst::store_delta<cms_value_t> foreign{};
+    foreign.added.push_back(cms_value_t{libjst::breakpoint{3u, 0u}, "A",
+                                        coverage_t{{0}, coverage_domain_t{0, haplotype_count + 1}}});
+    EXPECT_THROW(libjst::patch(lhs, foreign), std::domain_error);
+}
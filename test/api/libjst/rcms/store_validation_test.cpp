@@ -0,0 +1,228 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <any>
+#include <cstdint>
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <type_traits>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/rcms/store_validation.hpp>
+
+namespace jst::test::store_validation {
+
+using source_t = std::string;
+
+// Records the archived members and loads them back after they were modified by a hook, which corrupts the
+// multisequence in ways its interface does not allow.
+struct recording_archive {
+    std::vector<std::any> members{};
+
+    template <typename ...members_t>
+    void operator()(members_t && ...members_) {
+        (members.emplace_back(std::decay_t<members_t>{members_}), ...);
+    }
+};
+
+template <typename hook_t>
+struct replaying_archive {
+    std::vector<std::any> & members;
+    hook_t hook;
+
+    template <typename ...members_t>
+    void operator()(members_t & ...members_) {
+        std::size_t index{};
+        ((members_ = std::any_cast<members_t>(members[index++])), ...);
+        hook(members_...);
+    }
+};
+
+struct test : public ::testing::Test {
+    using coverage_t = libjst::bit_coverage<uint32_t>;
+    using coverage_domain_t = libjst::coverage_domain_t<coverage_t>;
+    using cms_t = libjst::dna_compressed_multisequence<source_t, coverage_t>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+    using rcs_store_t = libjst::rcs_store<source_t, cms_t>;
+
+    static constexpr uint32_t haplotype_count{200};
+
+    source_t _source{};
+    std::vector<cms_value_t> _variants{};
+
+    void SetUp() override {
+        std::mt19937 generator{13};
+        for (std::size_t idx = 0; idx < 4000; ++idx)
+            _source.push_back("ACGT"[generator() % 4]);
+
+        coverage_domain_t domain{0, haplotype_count};
+        for (uint32_t position = 3; position + 8 < _source.size(); position += 7) {
+            std::vector<uint32_t> haplotypes{};
+            for (uint32_t haplotype = 0; haplotype < haplotype_count; ++haplotype)
+                if (generator() % 6 == 0)
+                    haplotypes.push_back(haplotype);
+
+            switch (position % 3) {
+                case 0: _variants.push_back(cms_value_t{libjst::breakpoint{position, 1u},
+                                                        source_t{(_source[position] == 'A') ? 'C' : 'A'},
+                                                        coverage_t{haplotypes, domain}});
+                        break;
+                case 1: _variants.push_back(cms_value_t{libjst::breakpoint{position, 0u}, "GAT",
+                                                        coverage_t{haplotypes, domain}});
+                        break;
+                default: _variants.push_back(cms_value_t{libjst::breakpoint{position, 5u}, "",
+                                                         coverage_t{haplotypes, domain}});
+                         break;
+            }
+        }
+    }
+
+    cms_t build() const {
+        return cms_t{_source, coverage_domain_t{0, haplotype_count}, _variants};
+    }
+
+    template <typename hook_t>
+    static cms_t corrupt(cms_t const & variants, hook_t hook) {
+        recording_archive recorder{};
+        variants.save(recorder);
+        cms_t corrupted{};
+        replaying_archive<hook_t> replayer{recorder.members, std::move(hook)};
+        corrupted.load(replayer);
+        return corrupted;
+    }
+
+    static bool has_violation(libjst::store_validation_report const & report, libjst::store_invariant invariant) {
+        return std::ranges::any_of(report.violations, [&] (libjst::store_violation const & violation) {
+            return violation.invariant == invariant;
+        });
+    }
+};
+
+} // namespace jst::test::store_validation
+
+using store_validation_test = jst::test::store_validation::test;
+
+TEST_F(store_validation_test, valid) {
+    rcs_store_t store{_source, haplotype_count, _variants};
+    for (std::size_t thread_count : {1u, 2u, 7u}) {
+        libjst::store_validation_report report = store.validate(thread_count);
+        EXPECT_TRUE(report.valid()) << report.violations.front().message;
+        EXPECT_FALSE(report.truncated);
+        EXPECT_NO_THROW(report.throw_if_invalid());
+    }
+
+    rcs_store_t empty_store{_source, haplotype_count};
+    EXPECT_TRUE(empty_store.validate(4).valid());
+
+    rcs_store_t added_store{_source, haplotype_count};
+    for (auto const & variant : _variants)
+        added_store.add(variant);
+    EXPECT_TRUE(added_store.validate(3).valid());
+}
+
+TEST_F(store_validation_test, haplotype_conflict) {
+    // Haplotype 7 carries a SNV within a deletion, and haplotype 9 two SNVs at the same position. The bulk
+    // construction does not check the variants for conflicts.
+    coverage_domain_t domain{0, haplotype_count};
+    _variants.push_back(cms_value_t{libjst::breakpoint{2000u, 40u}, "", coverage_t{{7}, domain}});
+    _variants.push_back(cms_value_t{libjst::breakpoint{2030u, 1u}, "A", coverage_t{{7, 8}, domain}});
+    _variants.push_back(cms_value_t{libjst::breakpoint{3001u, 1u}, "A", coverage_t{{9}, domain}});
+    _variants.push_back(cms_value_t{libjst::breakpoint{3001u, 1u}, "C", coverage_t{{9}, domain}});
+    // Adjacent variants do not conflict.
+    _variants.push_back(cms_value_t{libjst::breakpoint{3500u, 10u}, "", coverage_t{{11}, domain}});
+    _variants.push_back(cms_value_t{libjst::breakpoint{3510u, 1u}, "A", coverage_t{{11}, domain}});
+    cms_t variants = build();
+
+    // The conflicts are found regardless of the block boundaries.
+    for (std::size_t thread_count : {1u, 2u, 5u, 64u}) {
+        libjst::store_validation_report report = variants.validate(thread_count);
+        ASSERT_EQ(report.violations.size(), 2u) << thread_count << " threads";
+        for (libjst::store_violation const & violation : report.violations)
+            EXPECT_EQ(violation.invariant, libjst::store_invariant::haplotype_conflict);
+        EXPECT_NE(report.violations[0].message.find("haplotype 7"), std::string::npos);
+        EXPECT_NE(report.violations[1].message.find("haplotype 9"), std::string::npos);
+        EXPECT_LT(report.violations[0].breakend_index, report.violations[1].breakend_index);
+        EXPECT_THROW(report.throw_if_invalid(), std::runtime_error);
+    }
+}
+
+TEST_F(store_validation_test, loaded_unchanged) {
+    cms_t variants = corrupt(build(), [] (auto && ...) {});
+    EXPECT_TRUE(variants.validate(3).valid());
+}
+
+TEST_F(store_validation_test, deletion_mate) {
+    cms_t variants = corrupt(build(), [] (auto &, auto &, auto & indel_records, auto &, auto &) {
+        auto deletion = std::ranges::find_if(indel_records, [] (auto const & record) { return record.is_deletion; });
+        ASSERT_NE(deletion, indel_records.end());
+        deletion->mate_position += 2;
+    });
+
+    libjst::store_validation_report report = variants.validate(4);
+    EXPECT_FALSE(report.valid());
+    EXPECT_TRUE(has_violation(report, libjst::store_invariant::deletion_mate));
+    EXPECT_FALSE(has_violation(report, libjst::store_invariant::indel_entry));
+}
+
+TEST_F(store_validation_test, indel_entry) {
+    cms_t variants = corrupt(build(), [] (auto &, auto &, auto & indel_records, auto &, auto &) {
+        auto insertion = std::ranges::find_if(indel_records, [] (auto const & record) { return !record.is_deletion; });
+        ASSERT_NE(insertion, indel_records.end());
+        indel_records.erase(insertion);
+    });
+
+    libjst::store_validation_report report = variants.validate(2);
+    ASSERT_TRUE(has_violation(report, libjst::store_invariant::indel_entry));
+    EXPECT_EQ(report.violations.back().breakend_index, variants.size()); // the count of the indel map
+}
+
+TEST_F(store_validation_test, alt_sequence) {
+    cms_t variants = corrupt(build(), [] (auto &, auto &, auto & indel_records, auto &, auto &) {
+        auto insertion = std::ranges::find_if(indel_records, [] (auto const & record) { return !record.is_deletion; });
+        ASSERT_NE(insertion, indel_records.end());
+        insertion->insertion.offset += 1000000;
+    });
+
+    libjst::store_validation_report report = variants.validate(3);
+    ASSERT_EQ(report.violations.size(), 1u);
+    EXPECT_EQ(report.violations.front().invariant, libjst::store_invariant::alt_sequence);
+}
+
+TEST_F(store_validation_test, coverage_domain_and_truncation) {
+    cms_t variants = corrupt(build(), [] (auto &, auto &, auto &, auto & coverage_domain, auto &) {
+        coverage_domain = coverage_domain_t{0, haplotype_count + 1};
+    });
+
+    libjst::store_validation_report report = variants.validate(4);
+    EXPECT_TRUE(has_violation(report, libjst::store_invariant::coverage_domain));
+    EXPECT_EQ(report.violations.size(), libjst::store_validation_report::max_violations);
+    EXPECT_TRUE(report.truncated);
+    EXPECT_TRUE(std::ranges::is_sorted(report.violations, std::ranges::less{}, &libjst::store_violation::breakend_index));
+}
+
+TEST_F(store_validation_test, sentinels) {
+    cms_t variants = corrupt(build(), [] (auto & packed_source, auto &, auto &, auto &, auto &) {
+        std::string source{};
+        packed_source.unpack(std::back_inserter(source));
+        source.resize(source.size() / 2);
+        packed_source = std::remove_cvref_t<decltype(packed_source)>{source};
+    });
+
+    libjst::store_validation_report report = variants.validate(2);
+    ASSERT_FALSE(report.valid());
+    EXPECT_EQ(report.violations.front().invariant, libjst::store_invariant::sentinels);
+    EXPECT_TRUE(has_violation(report, libjst::store_invariant::breakend_order));
+    EXPECT_THROW(report.throw_if_invalid(), std::runtime_error);
+}
@@ -0,0 +1,102 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/packed_breakend_key.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/rcms/variant_class_index.hpp>
+
+using namespace std::literals;
+
+using key_type = libjst::packed_breakend_key<uint32_t>;
+
+TEST(variant_class_index_test, empty) {
+    libjst::variant_class_index index{};
+    EXPECT_TRUE(index.empty());
+    EXPECT_EQ(index.size(), 0u);
+    EXPECT_EQ(index.snv_run_length(0), 0u);
+    EXPECT_EQ(index.memory_usage(), 0u);
+}
+
+TEST(variant_class_index_test, classes) {
+    std::vector<key_type> keys{key_type{libjst::indel_breakend_kind::nil, 0},
+                               key_type{uint8_t{1}, 1},
+                               key_type{libjst::indel_breakend_kind::deletion_low, 2},
+                               key_type{libjst::indel_breakend_kind::insertion_low, 3},
+                               key_type{libjst::indel_breakend_kind::deletion_high, 4},
+                               key_type{libjst::indel_breakend_kind::nil, 5}};
+    libjst::variant_class_index index{keys};
+    ASSERT_EQ(index.size(), keys.size());
+
+    EXPECT_EQ((std::vector<bool>{index.is_snv(0), index.is_snv(1), index.is_snv(2),
+                                 index.is_snv(3), index.is_snv(4), index.is_snv(5)}),
+              (std::vector<bool>{false, true, false, false, false, false}));
+    EXPECT_EQ((std::vector<bool>{index.is_indel_low(0), index.is_indel_low(1), index.is_indel_low(2),
+                                 index.is_indel_low(3), index.is_indel_low(4), index.is_indel_low(5)}),
+              (std::vector<bool>{false, false, true, true, false, false}));
+    EXPECT_EQ((std::vector<bool>{index.is_indel_high(0), index.is_indel_high(1), index.is_indel_high(2),
+                                 index.is_indel_high(3), index.is_indel_high(4), index.is_indel_high(5)}),
+              (std::vector<bool>{false, false, false, false, true, false}));
+}
+
+TEST(variant_class_index_test, snv_run_length) {
+    // A run of 150 SNVs spanning three words, followed by an insertion and a single SNV.
+    std::vector<key_type> keys{key_type{libjst::indel_breakend_kind::nil, 0}};
+    for (uint32_t position = 1; position <= 150; ++position)
+        keys.emplace_back(uint8_t{2}, position);
+    keys.emplace_back(libjst::indel_breakend_kind::insertion_low, 151);
+    keys.emplace_back(uint8_t{3}, 152);
+    libjst::variant_class_index index{keys};
+
+    EXPECT_EQ(index.snv_run_length(0), 0u);
+    EXPECT_EQ(index.snv_run_length(1), 150u);
+    EXPECT_EQ(index.snv_run_length(63), 88u);
+    EXPECT_EQ(index.snv_run_length(64), 87u);
+    EXPECT_EQ(index.snv_run_length(150), 1u);
+    EXPECT_EQ(index.snv_run_length(151), 0u);
+    EXPECT_EQ(index.snv_run_length(152), 1u); // the unused bits of the last word are not counted
+    EXPECT_EQ(index.snv_run_length(153), 0u);
+}
+
+TEST(variant_class_index_test, multisequence) {
+    using coverage_t = libjst::bit_coverage<uint32_t>;
+    using cms_t = libjst::dna_compressed_multisequence<std::string, coverage_t>;
+    using store_t = libjst::rcs_store<std::string, cms_t>;
+    using value_t = std::ranges::range_value_t<cms_t>;
+
+    std::string const source(20, 'A');
+    store_t store{source, 4};
+    auto domain = store.variants().coverage_domain();
+    store.add(value_t{libjst::breakpoint{2u, 1u}, "C"s, coverage_t{{0, 1}, domain}});
+    store.add(value_t{libjst::breakpoint{5u, 3u}, ""s, coverage_t{{2}, domain}});
+    store.add(value_t{libjst::breakpoint{12u, 0u}, "GG"s, coverage_t{{3}, domain}});
+    EXPECT_FALSE(store.variants().has_variant_class_index());
+
+    store.build_variant_class_index();
+    ASSERT_TRUE(store.variants().has_variant_class_index());
+    libjst::variant_class_index const & classes = store.variants().variant_classes();
+    ASSERT_EQ(classes.size(), static_cast<size_t>(store.variants().size()));
+
+    std::size_t index{};
+    for (auto && variant : store.variants()) {
+        EXPECT_EQ(classes.is_snv(index), variant.is_snv()) << index;
+        EXPECT_EQ(classes.is_indel_low(index),
+                  !variant.is_snv() && variant.get_breakpoint_end() == libjst::breakpoint_end::low &&
+                  libjst::alt_kind(variant) != libjst::alternate_sequence_kind::unknown) << index;
+        ++index;
+    }
+
+    // The index is dropped by every modification.
+    store.add(value_t{libjst::breakpoint{15u, 1u}, "T"s, coverage_t{{1}, domain}});
+    EXPECT_FALSE(store.variants().has_variant_class_index());
+}
@@ -0,0 +1,204 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <fstream>
+#include <ranges>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/rcms/vcf_importer.hpp>
+
+using namespace std::literals;
+
+namespace jst::test::vcf_importer {
+
+using source_t = std::string;
+
+struct test : public ::testing::Test {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using coverage_domain_type = libjst::coverage_domain_t<coverage_type>;
+
+    using cms_t = libjst::dna_compressed_multisequence<source_t, coverage_type>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+    using rcs_store_t = libjst::rcs_store<source_t, cms_t>;
+    using importer_t = libjst::vcf_importer<source_t, cms_t>;
+
+    //                       0123456789012345678901234567890
+    source_t const source{"ACGTACGTACGTTTGCAAACCCGGGTTTACG"s};
+
+    // Three diploid samples with SNVs, a multi-allelic site, indels, substitutions, a symbolic allele and another
+    // contig, using phased, unphased, missing and haploid genotypes.
+    std::string const vcf{
+        "##fileformat=VCFv4.2\n"
+        "##contig=<ID=chr1,length=31>\n"
+        "#CHROM\tPOS\tID\tREF\tALT\tQUAL\tFILTER\tINFO\tFORMAT\tS0\tS1\tS2\n"
+        "chr1\t2\t.\tC\tG,T\t.\tPASS\t.\tGT\t1|0\t0|2\t2|2\n"
+        "chr1\t5\t.\tA\tAGG\t.\tPASS\t.\tGT:DP\t0/1:3\t0|0:4\t.|1:5\n"
+        "\n"
+        "chr1\t8\t.\tTACG\tT\t.\tPASS\t.\tGT\t0|0\t1|1\t0|1\n"
+        "chr1\t15\tmnp\tGCAA\tGTTA\t.\tPASS\t.\tGT\t1|0\t0|0\t0|0\n"
+        "chr1\t20\t.\tC\t<DEL>,a\t.\tPASS\t.\tGT\t1|2\t1|1\t0|0\n"
+        "chr2\t3\t.\tG\tA\t.\tPASS\t.\tGT\t1|1\t1|1\t1|1\r\n"
+        "chr1\t23\tcomplex\tGG\tT\t.\tPASS\t.\tGT\t0|0\t0|0\t1|0\n"
+        "chr1\t25\t.\tG\tA\t.\tPASS\t.\tGT\t0|0\t0|0\t0|0\n"
+        "chr1\t29\t.\tA\tT\t.\tPASS\t.\tGT\t1\t0|1\t1|1\n"};
+
+    rcs_store_t expected_store() const {
+        coverage_domain_type domain{0, 6};
+        return rcs_store_t{source, 6, std::vector<cms_value_t>{
+            cms_value_t{libjst::breakpoint{1, 1}, "G"s, coverage_type{{0}, domain}},
+            cms_value_t{libjst::breakpoint{1, 1}, "T"s, coverage_type{{3, 4, 5}, domain}},
+            cms_value_t{libjst::breakpoint{5, 0}, "GG"s, coverage_type{{1, 5}, domain}},
+            cms_value_t{libjst::breakpoint{8, 3}, ""s, coverage_type{{2, 3, 5}, domain}},
+            cms_value_t{libjst::breakpoint{15, 1}, "T"s, coverage_type{{0}, domain}},
+            cms_value_t{libjst::breakpoint{16, 1}, "T"s, coverage_type{{0}, domain}},
+            cms_value_t{libjst::breakpoint{19, 1}, "A"s, coverage_type{{1}, domain}},
+            cms_value_t{libjst::breakpoint{22, 2}, ""s, coverage_type{{4}, domain}},
+            cms_value_t{libjst::breakpoint{22, 0}, "T"s, coverage_type{{4}, domain}},
+            cms_value_t{libjst::breakpoint{28, 1}, "T"s, coverage_type{{0, 3, 4, 5}, domain}}}};
+    }
+
+    rcs_store_t import(std::string const & text, libjst::vcf_import_options options = {}) const {
+        std::istringstream stream{text};
+        return importer_t{source, std::move(options)}(stream);
+    }
+
+    template <typename store_t>
+    static void expect_equal_variants(store_t const & actual, store_t const & expected) {
+        EXPECT_EQ(actual.size(), expected.size());
+        EXPECT_TRUE(std::ranges::equal(actual.source(), expected.source()));
+        ASSERT_EQ(std::ranges::size(actual.variants()), std::ranges::size(expected.variants()));
+
+        auto actual_it = actual.variants().begin();
+        for (auto && expected_delta : expected.variants()) {
+            EXPECT_EQ(libjst::get_breakpoint(*actual_it), libjst::get_breakpoint(expected_delta));
+            EXPECT_TRUE(std::ranges::equal(libjst::alt_sequence(*actual_it), libjst::alt_sequence(expected_delta)));
+            EXPECT_EQ(libjst::coverage(*actual_it), libjst::coverage(expected_delta));
+            ++actual_it;
+        }
+    }
+};
+
+} // namespace jst::test::vcf_importer
+
+using vcf_importer_test = jst::test::vcf_importer::test;
+
+// ----------------------------------------------------------------------------
+// Test case definitions
+// ----------------------------------------------------------------------------
+
+TEST_F(vcf_importer_test, import) {
+    expect_equal_variants(import(vcf), expected_store());
+}
+
+TEST_F(vcf_importer_test, chunked) {
+    for (std::size_t const thread_count : {1u, 3u}) {
+        for (std::size_t const chunk_size : {1u, 2u, 100u}) {
+            libjst::vcf_import_options options{.chunk_size = chunk_size,
+                                               .thread_count = thread_count,
+                                               .max_pending_chunks = 1};
+            expect_equal_variants(import(vcf, options), expected_store());
+        }
+    }
+}
+
+TEST_F(vcf_importer_test, other_contig) {
+    libjst::vcf_import_options options{.contig = "chr2", .check_reference = false};
+    rcs_store_t const store = import(vcf, options);
+    EXPECT_EQ(store.size(), 6u);
+    ASSERT_EQ(std::ranges::size(store.variants()), 3u); // the sentinels and the SNV
+    EXPECT_EQ(libjst::get_breakpoint(*std::ranges::next(store.variants().begin())), (libjst::breakpoint{2, 1}));
+}
+
+TEST_F(vcf_importer_test, no_records) {
+    rcs_store_t const store = import("##fileformat=VCFv4.2\n"
+                                     "#CHROM\tPOS\tID\tREF\tALT\tQUAL\tFILTER\tINFO\tFORMAT\tS0\n");
+    EXPECT_EQ(store.size(), 2u);
+    EXPECT_EQ(std::ranges::size(store.variants()), 2u);
+}
+
+TEST_F(vcf_importer_test, invalid_records) {
+    std::string const header{"#CHROM\tPOS\tID\tREF\tALT\tQUAL\tFILTER\tINFO\tFORMAT\tS0\n"};
+    for (std::size_t const thread_count : {1u, 2u}) {
+        libjst::vcf_import_options options{.chunk_size = 1, .thread_count = thread_count};
+        EXPECT_THROW(import("chr1\t2\t.\tC\tG\t.\tPASS\t.\tGT\t1|0\n", options), std::runtime_error); // no header
+        EXPECT_THROW(import(header + "chr1\t2\t.\tC\tG\t.\tPASS\t.\tGT\t1|a\n", options), std::runtime_error);
+        EXPECT_THROW(import(header + "chr1\t2\t.\tC\tG\t.\tPASS\t.\tGT\t1|2\n", options), std::runtime_error);
+        EXPECT_THROW(import(header + "chr1\t2\t.\tC\tG\t.\tPASS\t.\tGT\t1|0|1\n", options), std::runtime_error);
+        EXPECT_THROW(import(header + "chr1\t2\t.\tC\tG\t.\tPASS\t.\tDP:GT\t3:1|0\n", options), std::runtime_error);
+        EXPECT_THROW(import(header + "chr1\tx\t.\tC\tG\t.\tPASS\t.\tGT\t1|0\n", options), std::runtime_error);
+        EXPECT_THROW(import(header + "chr1\t2\t.\tC\tG\t.\tPASS\t.\tGT\n", options), std::runtime_error);
+        EXPECT_THROW(import(header + "chr1\t2\t.\tG\tC\t.\tPASS\t.\tGT\t1|0\n", options), std::runtime_error);
+        EXPECT_THROW(import(header + "chr1\t30\t.\tGCA\tC\t.\tPASS\t.\tGT\t1|0\n", options), std::runtime_error);
+
+        // The error is found in a later chunk.
+        std::string records{};
+        for (std::size_t idx = 0; idx < 50; ++idx)
+            records += "chr1\t2\t.\tC\tG\t.\tPASS\t.\tGT\t1|0\n";
+        EXPECT_THROW(import(header + records + "chr1\t2\t.\tC\tG\t.\tPASS\t.\tGT\t1|4\n" + records, options),
+                     std::runtime_error);
+    }
+
+    try {
+        import(header + "chr1\t2\t.\tC\tG\t.\tPASS\t.\tGT\t1|0\n" + "chr1\t2\t.\tC\tG\t.\tPASS\t.\tGT\t1|a\n");
+        FAIL();
+    } catch (std::runtime_error const & error) {
+        EXPECT_NE(std::string{error.what()}.find("line 3"), std::string::npos);
+    }
+}
+
+TEST_F(vcf_importer_test, simulated_data) {
+    std::ifstream vcf_file{DATADIR"sim_ref_10Kb_SNP_INDELs.vcf"};
+    ASSERT_TRUE(vcf_file.good());
+    std::stringstream buffer{};
+    buffer << vcf_file.rdbuf();
+    std::string const text = buffer.str();
+
+    // Every alternate allele with at least one carrier becomes a delta.
+    std::size_t expected_count{};
+    std::istringstream lines{text};
+    for (std::string line{}; std::getline(lines, line);) {
+        if (line.starts_with("#"))
+            continue;
+        std::vector<std::string> fields{};
+        std::istringstream columns{line};
+        for (std::string field{}; std::getline(columns, field, '\t');)
+            fields.push_back(field);
+
+        std::size_t const alt_count = std::ranges::count(fields[4], ',') + 1;
+        for (std::size_t allele = 1; allele <= alt_count; ++allele)
+            expected_count += std::ranges::any_of(fields | std::views::drop(9), [&] (std::string const & genotype) {
+                std::string const allele_code = std::to_string(allele);
+                return genotype.substr(0, genotype.find('|')) == allele_code ||
+                       genotype.substr(genotype.find('|') + 1) == allele_code;
+            });
+    }
+
+    std::string const random_source(10000, 'A'); // the reference is not checked
+    libjst::vcf_import_options const serial{.chunk_size = 1000, .thread_count = 1, .check_reference = false};
+    libjst::vcf_import_options const parallel{.chunk_size = 7, .thread_count = 4, .check_reference = false};
+
+    std::istringstream serial_stream{text};
+    rcs_store_t const serial_store = importer_t{random_source, serial}(serial_stream);
+    std::istringstream parallel_stream{text};
+    rcs_store_t const parallel_store = importer_t{random_source, parallel}(parallel_stream);
+
+    EXPECT_EQ(serial_store.size(), 100u);
+    std::size_t low_count{};
+    for (auto && delta : serial_store.variants())
+        low_count += delta.get_breakpoint_end() == libjst::breakpoint_end::low;
+    EXPECT_EQ(low_count, expected_count + 1); // the first sentinel
+    expect_equal_variants(parallel_store, serial_store);
+}
@@ -0,0 +1,116 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/rcms/versioned_store.hpp>
+
+namespace jst::test::versioned_store {
+
+using source_t = std::string;
+
+struct test : public ::testing::Test {
+    using coverage_t = libjst::bit_coverage<uint32_t>;
+    using coverage_domain_t = libjst::coverage_domain_t<coverage_t>;
+    using cms_t = libjst::dna_compressed_multisequence<source_t, coverage_t>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+    using rcs_store_t = libjst::rcs_store<source_t, cms_t>;
+
+    static constexpr uint32_t haplotype_count{8};
+
+    source_t _source{std::string(400, 'A')};
+
+    // Adds a SNV at the given position, which adds a single breakend.
+    static void add_snv(rcs_store_t & store, uint32_t const position) {
+        store.add(cms_value_t{libjst::breakpoint{position, 1u}, "C",
+                              coverage_t{{position % haplotype_count}, coverage_domain_t{0, haplotype_count}}});
+    }
+};
+
+} // namespace jst::test::versioned_store
+
+using versioned_store_test = jst::test::versioned_store::test;
+
+TEST_F(versioned_store_test, snapshot_is_stable) {
+    libjst::versioned_store<rcs_store_t> versions{rcs_store_t{_source, haplotype_count}};
+    EXPECT_EQ(versions.epoch(), 0u);
+
+    auto pinned = versions.snapshot();
+    ASSERT_TRUE(pinned);
+    auto const pinned_begin = std::ranges::begin(pinned->variants());
+    EXPECT_EQ(std::ranges::size(pinned->variants()), 2u); // the sentinels
+
+    auto updated = versions.update([] (rcs_store_t & store) { add_snv(store, 10); });
+    EXPECT_EQ(updated.epoch(), 1u);
+    EXPECT_EQ(versions.epoch(), 1u);
+    EXPECT_EQ(std::ranges::size(updated->variants()), 3u);
+
+    // The pinned version is neither modified nor released by the update.
+    EXPECT_EQ(pinned.epoch(), 0u);
+    EXPECT_EQ(std::ranges::size(pinned->variants()), 2u);
+    EXPECT_TRUE(pinned_begin == std::ranges::begin(pinned->variants()));
+    EXPECT_EQ(versions.snapshot().epoch(), 1u);
+}
+
+TEST_F(versioned_store_test, failed_update_publishes_nothing) {
+    libjst::versioned_store<rcs_store_t> versions{rcs_store_t{_source, haplotype_count}};
+    EXPECT_THROW(versions.update([] (rcs_store_t & store) {
+        add_snv(store, 10);
+        throw std::runtime_error{"update failed"};
+    }), std::runtime_error);
+    EXPECT_EQ(versions.epoch(), 0u);
+    EXPECT_EQ(std::ranges::size(versions.snapshot()->variants()), 2u);
+
+    rcs_store_t rebuilt{_source, haplotype_count};
+    add_snv(rebuilt, 20);
+    add_snv(rebuilt, 30);
+    auto published = versions.publish(std::move(rebuilt));
+    EXPECT_EQ(published.epoch(), 1u);
+    EXPECT_EQ(std::ranges::size(versions.snapshot()->variants()), 4u);
+}
+
+TEST_F(versioned_store_test, readers_during_updates) {
+    static constexpr uint32_t update_count{100};
+    libjst::versioned_store<rcs_store_t> versions{rcs_store_t{_source, haplotype_count}};
+
+    std::atomic<bool> done{false};
+    std::atomic<std::size_t> mismatches{};
+    std::vector<std::thread> readers{};
+    for (std::size_t reader = 0; reader < 4; ++reader) {
+        readers.emplace_back([&] () {
+            while (!done.load(std::memory_order_acquire)) {
+                auto snapshot = versions.snapshot();
+                // Every version holds the sentinels and one SNV per epoch, which are all visited by the reader.
+                std::size_t const visited = std::ranges::distance(snapshot->variants());
+                if (visited != 2 + snapshot.epoch())
+                    mismatches.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    for (uint32_t epoch = 1; epoch <= update_count; ++epoch)
+        versions.update([&] (rcs_store_t & store) { add_snv(store, 3 * epoch); });
+
+    done.store(true, std::memory_order_release);
+    for (std::thread & reader : readers)
+        reader.join();
+
+    EXPECT_EQ(mismatches.load(), 0u);
+    EXPECT_EQ(versions.epoch(), update_count);
+    EXPECT_EQ(std::ranges::size(versions.snapshot()->variants()), 2u + update_count);
+}
@@ -0,0 +1,111 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/reference_sequence/mapped_reference_sequence.hpp>
+#include <libjst/reference_sequence/reference_sequence_concept.hpp>
+#include <libjst/sequence/journaled_sequence.hpp>
+
+using namespace std::literals;
+
+static_assert(libjst::preserving_reference_sequence<libjst::mapped_reference_sequence>);
+static_assert(std::ranges::contiguous_range<libjst::mapped_reference_sequence const>);
+
+struct mapped_reference_sequence_test : public ::testing::Test {
+    std::filesystem::path directory{std::filesystem::temp_directory_path() / "libjst_mapped_reference_test"};
+    std::filesystem::path fasta_path{directory / "reference.fa"};
+    std::filesystem::path packed_path{directory / "chr2.raw"};
+
+    std::string chr1{"ACGTACGTAC"};
+    std::string chr2{"GGGGCCCCAAAATTTTGA"};
+
+    void SetUp() override {
+        std::filesystem::create_directories(directory);
+        std::ofstream fasta{fasta_path, std::ios::binary};
+        std::ofstream index{fasta_path.string() + ".fai"};
+        std::size_t offset{};
+        auto write_record = [&] (std::string const & name, std::string const & sequence, std::size_t line_bases) {
+            std::string const header = ">" + name + " description\n";
+            fasta << header;
+            offset += header.size();
+            index << name << '\t' << sequence.size() << '\t' << offset << '\t' << line_bases << '\t'
+                  << line_bases + 1 << '\n';
+            for (std::size_t position = 0; position < sequence.size(); position += line_bases) {
+                std::string const line = sequence.substr(position, line_bases) + "\n";
+                fasta << line;
+                offset += line.size();
+            }
+        };
+        write_record("chr1", chr1, 60);
+        write_record("chr2", chr2, 5);
+    }
+
+    void TearDown() override {
+        std::filesystem::remove_all(directory);
+    }
+};
+
+TEST_F(mapped_reference_sequence_test, single_line_record_in_place) {
+    auto sequence = libjst::mapped_reference_sequence::from_fasta(fasta_path, "chr1", packed_path);
+    EXPECT_TRUE(std::ranges::equal(sequence, chr1));
+    EXPECT_EQ(sequence.size(), chr1.size());
+    EXPECT_EQ(sequence.memory_usage(), 0u);
+    EXPECT_FALSE(std::filesystem::exists(packed_path));
+}
+
+TEST_F(mapped_reference_sequence_test, wrapped_record_packed) {
+    auto sequence = libjst::mapped_reference_sequence::from_fasta(fasta_path, "chr2", packed_path);
+    EXPECT_TRUE(std::ranges::equal(sequence, chr2));
+    EXPECT_EQ(std::filesystem::file_size(packed_path), chr2.size());
+
+    // The packed file is reused and the copies share the mapping.
+    auto reopened = libjst::mapped_reference_sequence::from_fasta(fasta_path, "chr2", packed_path);
+    libjst::mapped_reference_sequence copy{reopened};
+    EXPECT_TRUE(std::ranges::equal(copy, chr2));
+    EXPECT_EQ(copy.data(), reopened.data());
+}
+
+TEST_F(mapped_reference_sequence_test, missing_record) {
+    EXPECT_THROW(libjst::mapped_reference_sequence::from_fasta(fasta_path, "chr3", packed_path), std::runtime_error);
+    EXPECT_THROW(libjst::mapped_reference_sequence::from_fasta(directory / "none.fa", "chr1", packed_path),
+                 std::runtime_error);
+}
+
+TEST_F(mapped_reference_sequence_test, breakpoint_slice) {
+    auto sequence = libjst::mapped_reference_sequence::from_fasta(fasta_path, "chr2", packed_path);
+    auto slice = libjst::breakpoint_slice(sequence, libjst::to_breakpoint(sequence, sequence.begin() + 4,
+                                                                                    sequence.begin() + 8));
+    EXPECT_TRUE(std::ranges::equal(slice, "CCCC"sv));
+}
+
+TEST_F(mapped_reference_sequence_test, journaled_sequence) {
+    auto sequence = libjst::mapped_reference_sequence::from_fasta(fasta_path, "chr2", packed_path);
+    libjst::journaled_sequence<libjst::mapped_reference_sequence> journaled{sequence};
+    journaled.append_replace(4, 8, "TT"sv);
+    EXPECT_TRUE(std::ranges::equal(journaled, "GGGGTTAAAATTTTGA"sv));
+}
+
+TEST_F(mapped_reference_sequence_test, store_source) {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using cms_type = libjst::dna_compressed_multisequence<libjst::mapped_reference_sequence, coverage_type>;
+
+    auto sequence = libjst::mapped_reference_sequence::from_fasta(fasta_path, "chr2", packed_path);
+    libjst::rcs_store<libjst::mapped_reference_sequence, cms_type> store{sequence, 4};
+    EXPECT_EQ(store.source().data(), sequence.data());
+    EXPECT_TRUE(std::ranges::equal(store.source(), chr2));
+}
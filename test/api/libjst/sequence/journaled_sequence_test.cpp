@@ -7,7 +7,10 @@
 
 #include <catch2/catch_test_macros.hpp>
 
+#include <algorithm>
 #include <iostream>
+#include <iterator>
+#include <ranges>
 #include <string>
 #include <vector>
 
@@ -303,3 +306,179 @@ SCENARIO("Iterating over a journaled sequence", "[sequence][journaled_sequence]"
         }
     }
 }
+
+TEMPLATE_TEST_CASE("Appending ordered edits to a journaled sequence", "[sequence][journaled_sequence]",
+                   libjst::journaled_sequence<std::vector<char>>,
+                   libjst::balanced_journaled_sequence<std::vector<char>>)
+{
+    std::vector sequence{'A', 'A', 'A', 'A', 'G', 'G', 'G', 'G'};
+    std::vector substitution{'C'};
+    std::vector insertion{'T', 'T'};
+
+    GIVEN("A journaled sequence initialized with 'AAAAGGGG'")
+    {
+        TestType journaled_sequence{sequence};
+        THEN("Every position accepts an appended edit")
+        {
+            REQUIRE(journaled_sequence.accepts_append(0u));
+            REQUIRE(journaled_sequence.accepts_append(sequence.size()));
+            REQUIRE_FALSE(journaled_sequence.accepts_append(sequence.size() + 1));
+        }
+        WHEN("Appending a substitution, an insertion and a deletion from left to right")
+        {
+            auto substitution_it = journaled_sequence.append_replace(1u, 2u, substitution);
+            REQUIRE(substitution_it == journaled_sequence.begin() + 1);
+            REQUIRE_FALSE(journaled_sequence.accepts_append(0u));
+            REQUIRE(journaled_sequence.accepts_append(2u));
+
+            auto insertion_it = journaled_sequence.append_replace(4u, 4u, insertion);
+            REQUIRE(insertion_it == journaled_sequence.begin() + 4);
+
+            auto deletion_it = journaled_sequence.append_replace(7u, 9u, {});
+            REQUIRE(deletion_it == journaled_sequence.begin() + 7);
+            THEN("The journaled sequence is 'ACAATTGG'")
+            {
+                std::vector expected_sequence{'A', 'C', 'A', 'A', 'T', 'T', 'G', 'G'};
+                REQUIRE(journaled_sequence.size() == expected_sequence.size());
+                REQUIRE(std::ranges::equal(journaled_sequence, expected_sequence));
+            }
+            AND_THEN("The sequence equals the one of the general replace")
+            {
+                TestType replaced_sequence{sequence};
+                replaced_sequence.replace(replaced_sequence.begin() + 1, replaced_sequence.begin() + 2, substitution);
+                replaced_sequence.insert(replaced_sequence.begin() + 4, insertion);
+                replaced_sequence.erase(replaced_sequence.begin() + 7, replaced_sequence.begin() + 9);
+                REQUIRE(std::ranges::equal(journaled_sequence, replaced_sequence));
+            }
+        }
+        WHEN("Appending behind the end of the sequence")
+        {
+            journaled_sequence.append_replace(sequence.size(), sequence.size(), insertion);
+            journaled_sequence.append_replace(sequence.size() + insertion.size(), sequence.size() + insertion.size(),
+                                              substitution);
+            THEN("The journaled sequence is extended")
+            {
+                std::vector expected_sequence{'A', 'A', 'A', 'A', 'G', 'G', 'G', 'G', 'T', 'T', 'C'};
+                REQUIRE(std::ranges::equal(journaled_sequence, expected_sequence));
+            }
+        }
+        WHEN("Replacing the whole sequence")
+        {
+            auto it = journaled_sequence.append_replace(0u, sequence.size(), {});
+            THEN("The journaled sequence is empty")
+            {
+                REQUIRE(journaled_sequence.empty());
+                REQUIRE(it == journaled_sequence.end());
+                REQUIRE(journaled_sequence.accepts_append(0u));
+            }
+        }
+    }
+    GIVEN("A default initialized journaled sequence")
+    {
+        TestType journaled_sequence{};
+        WHEN("Appending insertions")
+        {
+            journaled_sequence.append_replace(0u, 0u, insertion);
+            journaled_sequence.append_replace(2u, 2u, substitution);
+            THEN("The journaled sequence spells the insertions")
+            {
+                REQUIRE(std::ranges::equal(journaled_sequence, std::vector{'T', 'T', 'C'}));
+            }
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE("Iterating over the segments of a journaled sequence", "[sequence][journaled_sequence]",
+                   libjst::journaled_sequence<std::vector<char>>,
+                   libjst::balanced_journaled_sequence<std::vector<char>>)
+{
+    std::vector sequence{'A', 'A', 'A', 'A', 'G', 'G', 'G', 'G'};
+    std::vector insertion{'T', 'T'};
+
+    GIVEN("A journaled sequence with an insertion")
+    {
+        TestType journaled_sequence{sequence};
+        journaled_sequence.insert(journaled_sequence.begin() + 4, insertion);
+
+        THEN("The segments are the source prefix, the insertion and the source suffix")
+        {
+            auto segments = journaled_sequence.segments();
+            REQUIRE(std::ranges::distance(segments) == 3);
+
+            auto segment_it = std::ranges::begin(segments);
+            REQUIRE(std::ranges::equal(*segment_it, std::vector{'A', 'A', 'A', 'A'}));
+            REQUIRE(std::ranges::data(*segment_it) == journaled_sequence.source().data());
+            REQUIRE(std::ranges::equal(*++segment_it, insertion));
+            REQUIRE(std::ranges::data(*segment_it) == insertion.data());
+            REQUIRE(std::ranges::equal(*++segment_it, std::vector{'G', 'G', 'G', 'G'}));
+        }
+        AND_THEN("The segments of an infix are trimmed to the infix")
+        {
+            auto segments = journaled_sequence.segments(journaled_sequence.begin() + 2, journaled_sequence.begin() + 5);
+            REQUIRE(std::ranges::distance(segments) == 2);
+            REQUIRE(std::ranges::equal(*std::ranges::begin(segments), std::vector{'A', 'A'}));
+            REQUIRE(std::ranges::equal(*std::ranges::next(std::ranges::begin(segments)), std::vector{'T'}));
+
+            auto inner = journaled_sequence.segments(journaled_sequence.begin() + 5, journaled_sequence.begin() + 8);
+            REQUIRE(std::ranges::distance(inner) == 2);
+            REQUIRE(std::ranges::equal(*std::ranges::begin(inner), std::vector{'T'}));
+
+            auto single = journaled_sequence.segments(journaled_sequence.begin() + 7, journaled_sequence.begin() + 9);
+            REQUIRE(std::ranges::distance(single) == 1);
+            REQUIRE(std::ranges::equal(*std::ranges::begin(single), std::vector{'G', 'G'}));
+
+            REQUIRE(std::ranges::empty(journaled_sequence.segments(journaled_sequence.begin() + 4,
+                                                                   journaled_sequence.begin() + 4)));
+            REQUIRE(std::ranges::empty(journaled_sequence.segments(journaled_sequence.end(), journaled_sequence.end())));
+        }
+        AND_THEN("The segmented copy equals the symbol-wise copy")
+        {
+            std::vector<char> expected{};
+            std::ranges::copy(journaled_sequence, std::back_inserter(expected));
+
+            std::vector<char> copied(journaled_sequence.size());
+            REQUIRE(libjst::segmented_copy(journaled_sequence, copied.data()) == copied.data() + copied.size());
+            REQUIRE(copied == expected);
+
+            std::vector<char> infix{};
+            libjst::segmented_copy(journaled_sequence, journaled_sequence.begin() + 3, journaled_sequence.end() - 1,
+                                   std::back_inserter(infix));
+            REQUIRE(std::ranges::equal(infix, expected | std::views::drop(3) | std::views::take(6)));
+        }
+    }
+}
+
+TEMPLATE_TEST_CASE("Jumping over many records of a journaled sequence", "[sequence][journaled_sequence]",
+                   libjst::journaled_sequence<std::vector<char>>,
+                   libjst::balanced_journaled_sequence<std::vector<char>>)
+{
+    std::vector<char> sequence(64, 'A');
+    std::vector substitution{'C'};
+    std::vector insertion{'T', 'T'};
+
+    GIVEN("A journaled sequence with an edit every few positions")
+    {
+        TestType journaled_sequence{sequence};
+        for (std::size_t position = 1; position + 1 < sequence.size(); position += 5) {
+            journaled_sequence.append_replace(position, position + 1, substitution);
+            journaled_sequence.append_replace(position + 3, position + 3, insertion);
+        }
+
+        std::vector<char> expected{};
+        std::ranges::copy(journaled_sequence, std::back_inserter(expected));
+        std::ptrdiff_t const size = std::ranges::ssize(expected);
+
+        THEN("Every jump from every position lands on the same symbol as in the spelled sequence")
+        {
+            for (std::ptrdiff_t from = 0; from < size; ++from) {
+                for (std::ptrdiff_t to = 0; to < size; ++to) {
+                    auto it = journaled_sequence.begin() + from;
+                    it += to - from;
+                    REQUIRE(it.position() == to);
+                    REQUIRE(*it == expected[to]);
+                }
+                REQUIRE(journaled_sequence.begin() + from + (size - from) == journaled_sequence.end());
+            }
+        }
+    }
+}
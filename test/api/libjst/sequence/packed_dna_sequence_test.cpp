@@ -0,0 +1,93 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <iterator>
+#include <sstream>
+#include <string>
+
+#include <cereal/archives/binary.hpp>
+
+#include <libjst/sequence/packed_dna_sequence.hpp>
+
+SCENARIO("Packing a dna sequence", "[sequence][packed_dna_sequence]")
+{
+    GIVEN("A dna sequence with runs of other symbols")
+    {
+        std::string sequence{};
+        for (size_t i = 0; i < 100; ++i)
+            sequence.push_back("ACGT"[(i * 7 + i / 3) % 4]);
+        sequence.replace(10, 5, "NNNNN");
+        sequence[40] = 'a';
+        sequence.replace(95, 5, "NNNNN");
+
+        libjst::packed_dna_sequence packed{sequence};
+
+        THEN("the packed sequence has the size of the sequence and uses two bits per base")
+        {
+            REQUIRE(packed.size() == sequence.size());
+            REQUIRE(packed.words().size() == 4u);
+        }
+        AND_THEN("the other symbols are recorded as runs")
+        {
+            REQUIRE(packed.runs().size() == 3u);
+            REQUIRE(packed.runs()[0] == libjst::packed_symbol_run{.position = 10, .length = 5, .symbol = 'N'});
+            REQUIRE(packed.runs()[1] == libjst::packed_symbol_run{.position = 40, .length = 1, .symbol = 'a'});
+            REQUIRE(packed.runs()[2] == libjst::packed_symbol_run{.position = 95, .length = 5, .symbol = 'N'});
+        }
+        AND_THEN("every symbol can be accessed")
+        {
+            for (size_t i = 0; i < sequence.size(); ++i)
+                REQUIRE(packed[i] == sequence[i]);
+        }
+        AND_THEN("unpacking restores the sequence")
+        {
+            std::string unpacked{};
+            packed.unpack(std::back_inserter(unpacked));
+            REQUIRE(unpacked == sequence);
+        }
+        AND_THEN("a word holds the ranks of the 32 bases beginning at any position")
+        {
+            for (size_t position = 0; position < sequence.size(); ++position) {
+                uint64_t word = packed.word_at(position);
+                for (size_t i = 0; i < 32; ++i) {
+                    uint8_t expected = (position + i < sequence.size()) ? packed.rank_at(position + i) : 0;
+                    REQUIRE(((word >> (2 * i)) & 0b11) == expected);
+                }
+            }
+        }
+        AND_THEN("the packed sequence can be serialised")
+        {
+            std::stringstream buffer{};
+            {
+                cereal::BinaryOutputArchive oarch{buffer};
+                oarch(packed);
+            }
+            libjst::packed_dna_sequence loaded{};
+            {
+                cereal::BinaryInputArchive iarch{buffer};
+                iarch(loaded);
+            }
+            std::string unpacked{};
+            loaded.unpack(std::back_inserter(unpacked));
+            REQUIRE(unpacked == sequence);
+        }
+    }
+
+    GIVEN("An empty sequence")
+    {
+        libjst::packed_dna_sequence packed{std::string{}};
+
+        THEN("the packed sequence is empty")
+        {
+            REQUIRE(packed.empty());
+            REQUIRE(packed.words().empty());
+            REQUIRE(packed.word_at(0) == 0u);
+        }
+    }
+}
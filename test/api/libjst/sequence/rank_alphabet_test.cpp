@@ -0,0 +1,96 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <libjst/matcher/shift_or_matcher.hpp>
+#include <libjst/sequence/packed_dna_sequence.hpp>
+#include <libjst/sequence/rank_alphabet.hpp>
+
+namespace
+{
+    // Mimics the member interface of the seqan3 nucleotide alphabets.
+    template <std::size_t size>
+    struct test_nucleotide {
+        static constexpr uint8_t alphabet_size = size;
+        uint8_t rank{};
+
+        constexpr uint8_t to_rank() const noexcept { return rank; }
+        constexpr char to_char() const noexcept { return "ACGTN"[rank]; }
+        constexpr test_nucleotide & assign_rank(uint8_t const r) noexcept { rank = r; return *this; }
+
+        static std::vector<test_nucleotide> from(std::string_view const sequence) {
+            std::vector<test_nucleotide> result{};
+            for (char const symbol : sequence)
+                result.push_back(test_nucleotide{}.assign_rank(std::string_view{"ACGTN"}.find(symbol)));
+            return result;
+        }
+    };
+
+    using test_dna4 = test_nucleotide<4>;
+    using test_dna5 = test_nucleotide<5>;
+} // namespace
+
+static_assert(libjst::dna_rank_alphabet<test_dna4>);
+static_assert(libjst::rank_alphabet<test_dna5> && !libjst::dna_rank_alphabet<test_dna5>);
+static_assert(!libjst::rank_alphabet<char>);
+
+SCENARIO("Using sequences over rank alphabets", "[sequence][rank_alphabet]")
+{
+    std::string sequence{};
+    for (size_t i = 0; i < 100; ++i)
+        sequence.push_back("ACGT"[(i * 7 + i / 3) % 4]);
+
+    GIVEN("A sequence over a dna alphabet")
+    {
+        std::vector<test_dna4> const dna = test_dna4::from(sequence);
+
+        THEN("the characters can be viewed without a copy")
+        {
+            auto chars = libjst::as_chars(dna);
+            REQUIRE(std::ranges::size(chars) == sequence.size());
+            REQUIRE(std::ranges::equal(chars, sequence));
+        }
+        AND_THEN("the ranks are packed like the characters")
+        {
+            libjst::packed_dna_sequence packed{dna};
+            libjst::packed_dna_sequence expected{sequence};
+            REQUIRE(packed.size() == expected.size());
+            REQUIRE(std::ranges::equal(packed.words(), expected.words()));
+            REQUIRE(packed.runs().empty());
+        }
+        AND_THEN("a query over the alphabet can be searched directly")
+        {
+            std::vector<test_dna4> const query = test_dna4::from(sequence.substr(40, 12));
+            libjst::shift_or_matcher matcher{libjst::as_chars(query)};
+
+            std::vector<std::size_t> hits{};
+            matcher(libjst::packed_dna_sequence{dna}, [&] (std::size_t position) { hits.push_back(position); });
+            REQUIRE(std::ranges::find(hits, 51u) != hits.end());
+        }
+    }
+
+    GIVEN("A sequence over a dna alphabet with the symbol 'N'")
+    {
+        sequence.replace(10, 5, "NNNNN");
+        std::vector<test_dna5> const dna = test_dna5::from(sequence);
+
+        THEN("the symbols are packed by their characters")
+        {
+            libjst::packed_dna_sequence packed{dna};
+            REQUIRE(packed.runs().size() == 1u);
+            REQUIRE(packed.runs()[0] == libjst::packed_symbol_run{.position = 10, .length = 5, .symbol = 'N'});
+            for (size_t i = 0; i < sequence.size(); ++i)
+                REQUIRE(packed[i] == sequence[i]);
+        }
+    }
+}
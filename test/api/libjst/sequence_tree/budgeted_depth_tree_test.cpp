@@ -0,0 +1,205 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/sequence_tree/budgeted_depth_tree.hpp>
+#include <libjst/sequence_tree/partial_tree.hpp>
+#include <libjst/sequence_tree/volatile_tree.hpp>
+#include <libjst/traversal/state_oblivious_traverser.hpp>
+
+namespace jst::test::budgeted_depth_tree {
+
+using source_t = std::string;
+using coverage_type = libjst::bit_coverage<uint32_t>;
+using cms_type = libjst::dna_compressed_multisequence<source_t, coverage_type>;
+using store_type = libjst::rcs_store<source_t, cms_type>;
+using value_type = std::ranges::range_value_t<cms_type>;
+
+struct naive_matcher {
+    source_t needle{};
+
+    constexpr std::size_t window_size() const noexcept {
+        return needle.size();
+    }
+
+    template <typename haystack_t, typename callback_t>
+    constexpr void operator()(haystack_t && haystack, callback_t && callback) const {
+        auto it = std::ranges::begin(haystack);
+        auto last = std::ranges::end(haystack);
+        for (; std::ranges::distance(it, last) >= std::ranges::ssize(needle); ++it) {
+            if (std::ranges::equal(std::ranges::subrange{it, std::ranges::next(it, needle.size())}, needle))
+                callback(it);
+        }
+    }
+};
+
+//!\brief The number of hits and the number of haplotypes covering them.
+struct hit_summary {
+    std::size_t hits{};
+    std::size_t carriers{};
+
+    friend bool operator==(hit_summary const &, hit_summary const &) = default;
+
+    template <typename stream_t>
+    friend stream_t & operator<<(stream_t & stream, hit_summary const & summary) {
+        stream << "{hits: " << summary.hits << ", carriers: " << summary.carriers << "}";
+        return stream;
+    }
+};
+
+// Dense variants of a small cohort, such that the alternate paths of the common variants reach rare variants.
+struct test : public ::testing::Test {
+    static constexpr uint32_t haplotype_count{32};
+
+    source_t source{};
+    std::vector<value_type> variants{};
+    std::vector<std::size_t> carrier_counts{};
+
+    void SetUp() override {
+        std::mt19937 random_engine{11};
+        std::uniform_int_distribution<int> symbol_distribution{0, 3};
+        std::uniform_int_distribution<uint32_t> step_distribution{3, 4};
+        std::uniform_int_distribution<uint32_t> carrier_distribution{1, haplotype_count};
+        constexpr std::string_view dna{"ACGT"};
+        source.resize(2000);
+        std::ranges::generate(source, [&] { return dna[symbol_distribution(random_engine)]; });
+
+        libjst::coverage_domain_t<coverage_type> domain{0, haplotype_count};
+        std::vector<uint32_t> haplotypes(haplotype_count);
+        std::iota(haplotypes.begin(), haplotypes.end(), 0u);
+        std::size_t variant_idx{};
+        for (uint32_t position = 2; position + 3 < source.size(); position += step_distribution(random_engine)) {
+            std::ranges::shuffle(haplotypes, random_engine);
+            std::vector<uint32_t> carriers(haplotypes.begin(), haplotypes.begin() + carrier_distribution(random_engine));
+            std::ranges::sort(carriers);
+            carrier_counts.push_back(carriers.size());
+
+            switch (variant_idx++ % 8) {
+                case 3: variants.push_back(value_type{libjst::breakpoint{position, 0}, source_t{"GA"},
+                                                      coverage_type{carriers, domain}}); break;
+                case 6: variants.push_back(value_type{libjst::breakpoint{position, 2}, source_t{},
+                                                      coverage_type{carriers, domain}}); break;
+                default: variants.push_back(value_type{libjst::breakpoint{position, 1},
+                                                       source_t{dna[(dna.find(source[position]) + 1) % 4]},
+                                                       coverage_type{carriers, domain}});
+            }
+        }
+    }
+
+    template <typename tree_t>
+    static hit_summary summarise(tree_t const & tree, source_t const & needle) {
+        hit_summary summary{};
+        libjst::state_oblivious_traverser{}(tree, naive_matcher{needle}, [&] (auto &&, auto && label) {
+            ++summary.hits;
+            summary.carriers += libjst::coverage_intersection_count(label.coverage(), label.coverage());
+        });
+        return summary;
+    }
+
+    // The number of nodes of the subtree of the given node.
+    template <typename node_t>
+    static std::size_t subtree_size(node_t const & node) {
+        std::size_t size{1};
+        if (auto child = node.next_alt(); child)
+            size += subtree_size(*child);
+        if (auto child = node.next_ref(); child)
+            size += subtree_size(*child);
+        return size;
+    }
+
+    // The largest number of nodes of the subtrees below the alternate children of the reference path.
+    template <typename tree_t>
+    static std::size_t max_region_size(tree_t const & tree) {
+        std::size_t max_size{};
+        for (std::optional node = libjst::root(tree); node; node = node->next_ref())
+            if (auto region = node->next_alt(); region)
+                max_size = std::max(max_size, subtree_size(*region));
+        return max_size;
+    }
+};
+
+} // namespace jst::test::budgeted_depth_tree
+
+using namespace std::literals;
+
+using store_type = jst::test::budgeted_depth_tree::store_type;
+using source_t = jst::test::budgeted_depth_tree::source_t;
+
+struct budgeted_depth_tree_test : public jst::test::budgeted_depth_tree::test
+{};
+
+// ----------------------------------------------------------------------------
+// Test case definitions
+// ----------------------------------------------------------------------------
+
+TEST_F(budgeted_depth_tree_test, carrier_counts_required) {
+    store_type store{source, haplotype_count, variants};
+    EXPECT_THROW((libjst::volatile_tree{store} | libjst::depth_budget(16u)), std::invalid_argument);
+}
+
+TEST_F(budgeted_depth_tree_test, unlimited_budget) {
+    store_type store{source, haplotype_count, variants};
+    store.build_carrier_count_index();
+
+    libjst::depth_budget_report report{};
+    auto tree = libjst::volatile_tree{store} | libjst::depth_budget(std::numeric_limits<std::size_t>::max() / 64,
+                                                                    &report);
+    for (source_t needle : {"ACG"s, "GATC"s, "CAGATCA"s})
+        EXPECT_EQ(summarise(tree, needle), summarise(libjst::volatile_tree{store}, needle)) << needle;
+
+    EXPECT_EQ(report.cut_alternates.load(), 0u);
+    EXPECT_EQ(report.cut_continuations.load(), 0u);
+}
+
+TEST_F(budgeted_depth_tree_test, bounded_regions) {
+    store_type store{source, haplotype_count, variants};
+    store.build_carrier_count_index();
+
+    for (std::size_t budget : {1u, 4u, 16u, 64u}) {
+        libjst::depth_budget_report report{};
+        auto tree = libjst::volatile_tree{store} | libjst::depth_budget(budget, &report);
+        std::size_t const region_size = max_region_size(tree);
+        EXPECT_GE(region_size, 1u) << budget;
+        EXPECT_LE(region_size, budget) << budget;
+        EXPECT_GT(report.cut_continuations.load(), 0u) << budget;
+        if (budget > 1) {
+            EXPECT_GT(report.cut_alternates.load(), 0u) << budget;
+            EXPECT_GE(report.cut_carriers.load(), report.cut_alternates.load()) << budget;
+        }
+    }
+
+    EXPECT_EQ(max_region_size(libjst::volatile_tree{store} | libjst::depth_budget(0u)), 0u);
+}
+
+TEST_F(budgeted_depth_tree_test, larger_budget_finds_more) {
+    store_type store{source, haplotype_count, variants};
+    store.build_carrier_count_index();
+
+    for (source_t needle : {"GATC"s, "TGAC"s, "CAGATCA"s}) {
+        std::size_t previous_hits{};
+        for (std::size_t budget : {0u, 4u, 16u, 256u}) {
+            std::size_t const hits = summarise(libjst::volatile_tree{store} | libjst::depth_budget(budget), needle).hits;
+            EXPECT_GE(hits, previous_hits) << needle << " " << budget;
+            previous_hits = hits;
+        }
+        EXPECT_LE(previous_hits, summarise(libjst::volatile_tree{store}, needle).hits) << needle;
+    }
+}
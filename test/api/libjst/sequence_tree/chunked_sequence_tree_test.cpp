@@ -173,6 +173,36 @@ TEST_P(chunked_sequence_tree_test, traverse) {
     EXPECT_EQ(chunk_idx, std::ranges::size(GetParam().expected_labels));
 }
 
+TEST_P(chunked_sequence_tree_test, traverse_with_search_index) {
+    _mock.build_search_index(); // the chunks are located through the search index of the breakend map.
+    ASSERT_TRUE(_mock.variants().has_search_index());
+    auto forest = make_forest();
+
+    size_t chunk_idx{};
+    for (auto && tree : forest) {
+        std::string tracepoint = "Failed in chunk: " + std::to_string(chunk_idx);
+        SCOPED_TRACE(tracepoint);
+        run_test(std::move(tree), chunk_idx);
+        ++chunk_idx;
+    }
+    EXPECT_EQ(chunk_idx, std::ranges::size(GetParam().expected_labels));
+}
+
+TEST_P(chunked_sequence_tree_test, traverse_with_position_index) {
+    _mock.build_position_index(4); // the chunks are located through the samples of every 4 source positions.
+    ASSERT_TRUE(_mock.variants().has_position_index());
+    auto forest = make_forest();
+
+    size_t chunk_idx{};
+    for (auto && tree : forest) {
+        std::string tracepoint = "Failed in chunk: " + std::to_string(chunk_idx);
+        SCOPED_TRACE(tracepoint);
+        run_test(std::move(tree), chunk_idx);
+        ++chunk_idx;
+    }
+    EXPECT_EQ(chunk_idx, std::ranges::size(GetParam().expected_labels));
+}
+
 // ----------------------------------------------------------------------------
 // Test values
 // ----------------------------------------------------------------------------
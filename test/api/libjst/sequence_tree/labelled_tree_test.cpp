@@ -9,6 +9,7 @@
 
 #include <concepts>
 #include <algorithm>
+#include <span>
 #include <stack>
 #include <string>
 
@@ -132,6 +133,99 @@ TEST_P(labelled_tree_test, root_sink) {
         EXPECT_EQ(to_string(GetParam().expected_labels[i]), actual_labels[i]) << i;
 }
 
+TEST_P(labelled_tree_test, shared_path_labels) {
+    auto tree = make_tree();
+
+    using tree_t = decltype(tree);
+    using node_t = libjst::tree_node_t<tree_t>;
+
+    auto to_string = [] (auto seq) -> std::string {
+        std::string str;
+        for (char c : seq)
+            str.push_back(c);
+        return str;
+    };
+
+    // Keeps every visited node alive, such that the children share the journals of their parents.
+    std::vector<std::pair<node_t, std::string>> visited{};
+    std::stack<node_t> path{};
+    path.push(libjst::root(tree));
+    while (!path.empty()) {
+        node_t p = std::move(path.top());
+        path.pop();
+
+        if (auto c_ref = p.next_ref(); c_ref.has_value())
+            path.push(std::move(*c_ref));
+        if (auto c_alt = p.next_alt(); c_alt.has_value())
+            path.push(std::move(*c_alt));
+
+        std::string path_label = to_string((*p).path_sequence());
+        visited.emplace_back(std::move(p), std::move(path_label));
+    }
+
+    // Recording the variants of the alternate children must not modify the labels of the other nodes.
+    for (auto const & [node, path_label] : visited)
+        EXPECT_EQ(to_string((*node).path_sequence()), path_label);
+}
+
+TEST_P(labelled_tree_test, contiguous_labels) {
+    auto const & rcs_mock = get_mock();
+    auto tree = libjst::volatile_tree{rcs_mock} | libjst::contiguous_labelled();
+
+    using tree_t = decltype(tree);
+    using node_t = libjst::tree_node_t<tree_t>;
+
+    EXPECT_TRUE((std::same_as<decltype((*libjst::root(tree)).sequence()), std::span<char const>>));
+
+    std::vector<std::string> actual_labels{};
+    std::stack<node_t> path{};
+    path.push(libjst::root(tree));
+    while (!path.empty()) {
+        node_t p = std::move(path.top());
+        path.pop();
+        std::span<char const> label = (*p).sequence();
+        actual_labels.emplace_back(label.begin(), label.end());
+
+        if (auto c_ref = p.next_ref(); c_ref.has_value())
+            path.push(std::move(*c_ref));
+        if (auto c_alt = p.next_alt(); c_alt.has_value())
+            path.push(std::move(*c_alt));
+    }
+
+    std::vector<std::string> expected_labels{GetParam().expected_labels.begin(), GetParam().expected_labels.end()};
+    EXPECT_EQ(actual_labels, expected_labels);
+
+    // The root covers a single segment of the source and refers to it directly.
+    std::span<char const> root_label = (*libjst::root(tree)).sequence();
+    if (!root_label.empty()) {
+        EXPECT_EQ(root_label.data(), rcs_mock.source().data());
+    }
+}
+
+TEST_P(labelled_tree_test, contiguous_path_labels) {
+    auto const & rcs_mock = get_mock();
+    auto tree = libjst::volatile_tree{rcs_mock} | libjst::labelled();
+    auto contiguous_tree = libjst::volatile_tree{rcs_mock} | libjst::contiguous_labelled();
+
+    using node_t = libjst::tree_node_t<decltype(tree)>;
+    using contiguous_node_t = libjst::tree_node_t<decltype(contiguous_tree)>;
+
+    // The contiguous path sequences, which are patched behind the last indel, spell the segmented path sequences.
+    std::stack<std::pair<node_t, contiguous_node_t>> path{};
+    path.emplace(libjst::root(tree), libjst::root(contiguous_tree));
+    while (!path.empty()) {
+        auto [p, contiguous_p] = std::move(path.top());
+        path.pop();
+        std::span<char const> contiguous_label = (*contiguous_p).path_sequence();
+        EXPECT_TRUE(std::ranges::equal((*p).path_sequence(), contiguous_label));
+
+        if (auto c_ref = p.next_ref(); c_ref.has_value())
+            path.emplace(std::move(*c_ref), std::move(*contiguous_p.next_ref()));
+        if (auto c_alt = p.next_alt(); c_alt.has_value())
+            path.emplace(std::move(*c_alt), std::move(*contiguous_p.next_alt()));
+    }
+}
+
 // ----------------------------------------------------------------------------
 // Test values
 // ----------------------------------------------------------------------------
@@ -201,3 +295,16 @@ INSTANTIATE_TEST_SUITE_P(snv4_snv4, labelled_tree_test, testing::Values(fixture{
                                   ""s, "T"s, "GGG"s,
                                   "GGGG"s}
 }));
+
+INSTANTIATE_TEST_SUITE_P(deletion_snvs, labelled_tree_test, testing::Values(fixture{
+    .source{"AAAAGGGGCCCCTTTT"s},
+    .variants{
+        variant_t{.position{2}, .insertion{""s}, .deletion{2}, .coverage{0, 1}},
+        variant_t{.position{6}, .insertion{"A"s}, .deletion{1}, .coverage{0}},
+        variant_t{.position{9}, .insertion{"G"s}, .deletion{1}, .coverage{0, 1}}
+    },
+    .expected_labels{"AA"s, "AA"s, "GG"s, "A"s, "GC"s, "G"s, "CCTTTT"s, "CCCTTTT"s,
+                                                "GGC"s, "G"s, "CCTTTT"s, "CCCTTTT"s,
+                            "AA"s, "GG"s, "A"s, "GC"s, "G"s, "CCTTTT"s, "CCCTTTT"s,
+                                                "GGC"s, "G"s, "CCTTTT"s, "CCCTTTT"s}
+}));
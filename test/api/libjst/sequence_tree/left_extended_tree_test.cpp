@@ -11,6 +11,7 @@
 #include <algorithm>
 #include <stack>
 #include <string>
+#include <type_traits>
 
 
 
@@ -134,6 +135,38 @@ TEST_P(left_extended_tree, root_sink) {
         EXPECT_EQ(to_string(GetParam().expected_labels[i]), actual_labels[i]) << i;
 }
 
+TEST_P(left_extended_tree, static_extension) {
+    ASSERT_EQ(GetParam().extend_size, 3u);
+
+    auto tree = make_tree();
+    auto static_tree = libjst::volatile_tree{get_mock()} | libjst::labelled()
+                                                        | libjst::left_extend(std::integral_constant<uint32_t, 3>{});
+
+    using node_t = libjst::tree_node_t<decltype(tree)>;
+    using static_node_t = libjst::tree_node_t<decltype(static_tree)>;
+    EXPECT_LT(sizeof(static_node_t), sizeof(node_t)); // the extension is not stored in the nodes.
+
+    auto collect_labels = [] (auto const & any_tree) {
+        std::vector<std::string> labels{};
+        std::stack<libjst::tree_node_t<decltype(any_tree)>> path{};
+        path.push(libjst::root(any_tree));
+        while (!path.empty()) {
+            auto p = std::move(path.top());
+            path.pop();
+            auto label = *p;
+            labels.emplace_back(std::ranges::begin(label.sequence()), std::ranges::end(label.sequence()));
+
+            if (auto c_ref = p.next_ref(); c_ref.has_value())
+                path.push(std::move(*c_ref));
+            if (auto c_alt = p.next_alt(); c_alt.has_value())
+                path.push(std::move(*c_alt));
+        }
+        return labels;
+    };
+
+    EXPECT_EQ(collect_labels(static_tree), collect_labels(tree));
+}
+
 // ----------------------------------------------------------------------------
 // Test values
 // ----------------------------------------------------------------------------
@@ -173,6 +206,15 @@ INSTANTIATE_TEST_SUITE_P(snv4, left_extended_tree, testing::Values(fixture{
     .expected_labels{"AAAA"s, "AAAC"s, "AACGGG"s, "AAAGGGG"s}
 }));
 
+INSTANTIATE_TEST_SUITE_P(del1, left_extended_tree, testing::Values(fixture{
+    .source{"ACGTACGT"s},
+    .extend_size{3},
+    .variants{
+        variant_t{.position{1}, .insertion{""s}, .deletion{1}, .coverage{0}}
+    },
+    .expected_labels{"A"s, "A"s, "AGTACGT"s, "AC"s, "ACGTACGT"s}
+}));
+
 INSTANTIATE_TEST_SUITE_P(snv4_snv6, left_extended_tree, testing::Values(fixture{
     .source{"AAAAGGGG"s},
     .extend_size{3},
@@ -140,6 +140,45 @@ TEST_P(left_ext_trimmed_merged_test, root_sink) {
         EXPECT_EQ(to_string(GetParam().expected_labels[i]), actual_labels[i]) << i;
 }
 
+TEST_P(left_ext_trimmed_merged_test, contiguous_labels) {
+    auto const & rcs_mock = get_mock();
+    auto tree = make_tree();
+    auto contiguous_tree = libjst::volatile_tree{rcs_mock} | libjst::contiguous_labelled()
+                                                           | libjst::trim(GetParam().trim_size)
+                                                           | libjst::left_extend(GetParam().extend_size)
+                                                           | libjst::merge();
+
+    auto to_string = [] (auto seq) -> std::string {
+        return std::string{seq.begin(), seq.end()};
+    };
+
+    // Traverses both trees in lockstep; the merged and extended labels span several segments of the journal.
+    using node_t = libjst::tree_node_t<decltype(tree)>;
+    using contiguous_node_t = libjst::tree_node_t<decltype(contiguous_tree)>;
+    std::stack<std::pair<node_t, contiguous_node_t>> path{};
+    path.emplace(libjst::root(tree), libjst::root(contiguous_tree));
+    std::size_t node_count{};
+    while (!path.empty()) {
+        auto [p, cp] = std::move(path.top());
+        path.pop();
+        ++node_count;
+        EXPECT_EQ(to_string((*cp).sequence()), to_string((*p).sequence()));
+
+        auto c_ref = p.next_ref();
+        auto cc_ref = cp.next_ref();
+        ASSERT_EQ(c_ref.has_value(), cc_ref.has_value());
+        if (c_ref.has_value())
+            path.emplace(std::move(*c_ref), std::move(*cc_ref));
+
+        auto c_alt = p.next_alt();
+        auto cc_alt = cp.next_alt();
+        ASSERT_EQ(c_alt.has_value(), cc_alt.has_value());
+        if (c_alt.has_value())
+            path.emplace(std::move(*c_alt), std::move(*cc_alt));
+    }
+    EXPECT_EQ(node_count, GetParam().expected_labels.size());
+}
+
 // ----------------------------------------------------------------------------
 // Test values
 // ----------------------------------------------------------------------------
@@ -223,3 +262,31 @@ INSTANTIATE_TEST_SUITE_P(snv4_snv4, left_ext_trimmed_merged_test, testing::Value
                                   "AAA"s, "AAATGG"s,
                                   "AAAGGGG"s}
 }));
+
+INSTANTIATE_TEST_SUITE_P(del1_snv3, left_ext_trimmed_merged_test, testing::Values(fixture{
+    .source{"ACGTACGT"s},
+    .extend_size{3},
+    .trim_size{3},
+    .variants{
+        variant_t{.position{1}, .insertion{""s}, .deletion{1}, .coverage{0}},
+        variant_t{.position{3}, .insertion{"A"s}, .deletion{1}, .coverage{0, 1}}
+    },
+    .expected_labels{"A"s, "AG"s, "AGAA"s,
+                                  "AGTA"s,
+                       "ACG"s, "ACGAACG"s,
+                               "ACGTACGT"s}
+}));
+
+INSTANTIATE_TEST_SUITE_P(snv8_ins9_exceeding_branch, left_ext_trimmed_merged_test, testing::Values(fixture{
+    .source{"AAAAAAAAGGGGGGGG"s},
+    .extend_size{3},
+    .trim_size{2},
+    .variants{
+        variant_t{.position{8}, .insertion{"C"s}, .deletion{1}, .coverage{0}},
+        variant_t{.position{9}, .insertion{"TTTTTT"s}, .deletion{0}, .coverage{0, 1}}
+    },
+    .expected_labels{"AAAAAAAA"s, "AAAC"s, "CTT"s, // the insertion exceeds the branch
+                                           "AACGG"s,
+                                  "AAAG"s, "TTTGG"s,
+                                           "AAGGGGGGGG"s}
+}));
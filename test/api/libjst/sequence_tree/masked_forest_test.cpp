@@ -0,0 +1,194 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <ranges>
+#include <string>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/rcms/source_mask.hpp>
+#include <libjst/sequence_tree/masked_forest.hpp>
+#include <libjst/sequence_tree/partial_tree.hpp>
+#include <libjst/sequence_tree/volatile_tree.hpp>
+#include <libjst/traversal/parallel_chunk_traverser.hpp>
+#include <libjst/traversal/state_oblivious_traverser.hpp>
+
+namespace jst::test::masked_forest {
+
+using source_t = std::string;
+using coverage_type = libjst::bit_coverage<uint32_t>;
+using cms_type = libjst::dna_compressed_multisequence<source_t, coverage_type>;
+using store_type = libjst::rcs_store<source_t, cms_type>;
+
+struct naive_matcher {
+    source_t needle{};
+
+    constexpr std::size_t window_size() const noexcept {
+        return needle.size();
+    }
+
+    template <typename haystack_t, typename callback_t>
+    constexpr void operator()(haystack_t && haystack, callback_t && callback) const {
+        auto it = std::ranges::begin(haystack);
+        auto last = std::ranges::end(haystack);
+        for (; std::ranges::distance(it, last) >= std::ranges::ssize(needle); ++it) {
+            if (std::ranges::equal(std::ranges::subrange{it, std::ranges::next(it, needle.size())}, needle))
+                callback(it);
+        }
+    }
+};
+
+struct hit_counter {
+    std::size_t count{};
+
+    template <typename label_it_t, typename label_t>
+    void operator()(label_it_t &&, label_t &&) {
+        ++count;
+    }
+};
+
+// A random source with runs of N and SNVs outside of the runs, some of them next to the run boundaries.
+struct test : public ::testing::Test {
+    using value_type = std::ranges::range_value_t<cms_type>;
+
+    source_t source{};
+    std::vector<libjst::source_interval> n_runs{{0, 100}, {900, 1500}, {2300, 2301}, {3000, 3200}, {3900, 4000}};
+    store_type store{};
+
+    void SetUp() override {
+        std::mt19937 random_engine{42};
+        std::uniform_int_distribution<int> symbol_distribution{0, 3};
+        constexpr std::string_view dna{"ACGT"};
+        source.resize(4000);
+        std::ranges::generate(source, [&] { return dna[symbol_distribution(random_engine)]; });
+        std::ranges::for_each(n_runs, [&] (libjst::source_interval const & run) {
+            std::ranges::fill(source.begin() + run.begin, source.begin() + run.end, 'N');
+        });
+
+        libjst::coverage_domain_t<coverage_type> domain{0, 4};
+        std::vector<value_type> snvs{};
+        for (uint32_t position = 1; position < source.size(); position += 7) {
+            if (source[position] == 'N' || source[position - 1] == 'N') {
+                if (source[position] != 'N') // the first position behind a run.
+                    snvs.push_back(make_snv(position, position % 4, domain));
+                continue;
+            }
+            snvs.push_back(make_snv(position, position % 4, domain));
+        }
+        store = store_type{source, 4, snvs};
+    }
+
+    value_type make_snv(uint32_t const position,
+                        uint32_t const haplotype,
+                        libjst::coverage_domain_t<coverage_type> const & domain) const {
+        constexpr std::string_view dna{"ACGT"};
+        return value_type{libjst::breakpoint{position, 1},
+                          source_t{dna[(dna.find(source[position]) + 1) % 4]},
+                          coverage_type{{haplotype}, domain}};
+    }
+
+    template <typename tree_t>
+    static std::size_t count_hits(tree_t const & tree, source_t const & needle) {
+        std::size_t count{};
+        libjst::state_oblivious_traverser{}(tree, naive_matcher{needle}, [&] (auto &&, auto &&) { ++count; });
+        return count;
+    }
+
+    template <typename forest_t>
+    static std::size_t count_hits(forest_t const & forest, source_t const & needle, std::size_t) {
+        std::size_t count{};
+        std::ranges::for_each(forest, [&] (auto const & tree) { count += count_hits(tree, needle); });
+        return count;
+    }
+};
+
+} // namespace jst::test::masked_forest
+
+using namespace std::literals;
+
+using naive_matcher = jst::test::masked_forest::naive_matcher;
+using hit_counter = jst::test::masked_forest::hit_counter;
+using source_t = jst::test::masked_forest::source_t;
+using intervals_t = std::vector<libjst::source_interval>;
+
+struct masked_forest_test : public jst::test::masked_forest::test
+{};
+
+// ----------------------------------------------------------------------------
+// Test case definitions
+// ----------------------------------------------------------------------------
+
+TEST_F(masked_forest_test, unmasked_intervals) {
+    store.build_n_run_mask(1);
+    EXPECT_EQ(store.n_run_mask(), libjst::source_mask{n_runs});
+
+    libjst::masked_forest forest{store, store.n_run_mask()};
+    ASSERT_EQ(forest.size(), 4u);
+    EXPECT_EQ(forest.interval(0), (libjst::source_interval{100, 900}));
+    EXPECT_EQ(forest.interval(3), (libjst::source_interval{3200, 3900}));
+    EXPECT_EQ(&forest.data(), &store);
+
+    libjst::masked_forest split_forest{store, store.n_run_mask(), 300};
+    EXPECT_EQ(split_forest.size(), 12u);
+    EXPECT_EQ(split_forest.interval(0), (libjst::source_interval{100, 400}));
+    EXPECT_EQ(split_forest.interval(2), (libjst::source_interval{700, 900}));
+}
+
+TEST_F(masked_forest_test, skips_n_runs) {
+    store.build_n_run_mask(1);
+    libjst::masked_forest forest{store, store.n_run_mask()};
+
+    // No label of the forest contains a masked symbol.
+    EXPECT_GT(count_hits(libjst::volatile_tree{store}, "N"s), 0u);
+    EXPECT_EQ(count_hits(forest, "N"s, 0), 0u);
+
+    // The patterns without N are found exactly like in the whole tree.
+    for (source_t needle : {"ACG"s, "GTTA"s, "CA"s, "TGCAT"s}) {
+        std::size_t const expected_hits = count_hits(libjst::volatile_tree{store}, needle);
+        EXPECT_EQ(count_hits(forest, needle, 0), expected_hits) << needle;
+        EXPECT_EQ(count_hits(libjst::masked_forest{store, store.n_run_mask(), 128}, needle, 0), expected_hits)
+            << needle;
+    }
+}
+
+TEST_F(masked_forest_test, user_mask) {
+    // The hits of the forest and of the masked intervals partition the hits of the whole tree.
+    libjst::source_mask mask = libjst::source_mask::unknown_runs(source, 1);
+    mask.merge(libjst::source_mask{intervals_t{{300, 450}, {1700, 1750}, {3500, 3505}}});
+    libjst::masked_forest forest{store, mask};
+
+    for (source_t needle : {"ACG"s, "GTTA"s, "CA"s}) {
+        std::size_t masked_hits{};
+        std::ranges::for_each(mask, [&] (libjst::source_interval const & masked) {
+            masked_hits += count_hits(libjst::partial_tree{store, static_cast<uint32_t>(masked.begin),
+                                                           static_cast<uint32_t>(masked.size())}, needle);
+        });
+        EXPECT_GT(masked_hits, 0u);
+        EXPECT_EQ(count_hits(forest, needle, 0) + masked_hits, count_hits(libjst::volatile_tree{store}, needle))
+            << needle;
+    }
+}
+
+TEST_F(masked_forest_test, parallel_chunk_traverser) {
+    store.build_n_run_mask();
+    libjst::masked_forest forest{store, store.n_run_mask(), 100};
+    std::size_t const expected_hits = count_hits(libjst::volatile_tree{store}, "ACG"s);
+
+    auto counters = libjst::parallel_chunk_traverser{4}(forest, naive_matcher{"ACG"s}, hit_counter{});
+    std::size_t total = std::accumulate(counters.begin(), counters.end(), std::size_t{0},
+                                        [] (std::size_t count, hit_counter const & counter) {
+        return count + counter.count;
+    });
+    EXPECT_EQ(total, expected_hits);
+}
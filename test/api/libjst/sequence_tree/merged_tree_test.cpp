@@ -9,16 +9,22 @@
 
 #include <concepts>
 #include <algorithm>
+#include <array>
 #include <stack>
 #include <string>
 
 
 
+#include <libjst/sequence_tree/branch_jump_table.hpp>
+#include <libjst/sequence_tree/coloured_tree.hpp>
 #include <libjst/sequence_tree/volatile_tree.hpp>
 #include <libjst/sequence_tree/labelled_tree.hpp>
 #include <libjst/sequence_tree/merge_tree.hpp>
+#include <libjst/sequence_tree/prune_tree.hpp>
+#include <libjst/sequence_tree/trim_tree.hpp>
 #include <libjst/rcms/dna_compressed_multisequence.hpp>
 #include <libjst/rcms/rcs_store.hpp>
+#include <libjst/rcms/rcs_store_compact.hpp>
 
 #include "../mock/rcs_store_mock.hpp"
 
@@ -133,6 +139,44 @@ TEST_P(merged_tree_test, root_sink) {
         EXPECT_EQ(to_string(GetParam().expected_labels[i]), actual_labels[i]) << i;
 }
 
+TEST_P(merged_tree_test, compact_store) {
+    libjst::rcs_store_compact<typename rcs_store_t::variant_map_type> compact_mock{get_mock().variants()};
+    auto tree = make_tree();
+    auto compact_tree = libjst::volatile_tree{compact_mock} | libjst::labelled() | libjst::merge();
+
+    auto to_string = [] (auto seq) -> std::string {
+        return std::string{seq.begin(), seq.end()};
+    };
+
+    using node_t = libjst::tree_node_t<decltype(tree)>;
+    using compact_node_t = libjst::tree_node_t<decltype(compact_tree)>;
+    EXPECT_LT(sizeof(compact_node_t), sizeof(node_t));
+
+    // Traverses both trees in lockstep; the compact nodes must visit the same labels.
+    std::stack<std::pair<node_t, compact_node_t>> path{};
+    path.emplace(libjst::root(tree), libjst::root(compact_tree));
+    std::size_t node_count{};
+    while (!path.empty()) {
+        auto [p, cp] = std::move(path.top());
+        path.pop();
+        ++node_count;
+        EXPECT_EQ(to_string((*cp).sequence()), to_string((*p).sequence()));
+
+        auto c_ref = p.next_ref();
+        auto cc_ref = cp.next_ref();
+        ASSERT_EQ(c_ref.has_value(), cc_ref.has_value());
+        if (c_ref.has_value())
+            path.emplace(std::move(*c_ref), std::move(*cc_ref));
+
+        auto c_alt = p.next_alt();
+        auto cc_alt = cp.next_alt();
+        ASSERT_EQ(c_alt.has_value(), cc_alt.has_value());
+        if (c_alt.has_value())
+            path.emplace(std::move(*c_alt), std::move(*cc_alt));
+    }
+    EXPECT_EQ(node_count, GetParam().expected_labels.size());
+}
+
 // ----------------------------------------------------------------------------
 // Test values
 // ----------------------------------------------------------------------------
@@ -202,3 +246,102 @@ INSTANTIATE_TEST_SUITE_P(snv4_snv4, merged_tree_test, testing::Values(fixture{
                                   ""s, "TGGG"s,
                                   "GGGG"s}
 }));
+
+// ----------------------------------------------------------------------------
+// Jump table
+// ----------------------------------------------------------------------------
+
+namespace jst::test::merged_tree {
+
+// Nested deletions, whose high ends are followed by more high ends before the next variant begins.
+inline test::rcs_store_t make_deletion_store(std::vector<variant_t> const & variants) {
+    //                              0123456789012345
+    test::rcs_store_t store{source_t{"AAAAGGGGAAAAGGGG"}, 4};
+    auto domain = store.variants().coverage_domain();
+    std::ranges::for_each(variants, [&] (auto var) {
+        store.add(test::cms_value_t{libjst::breakpoint{var.position, var.deletion},
+                                    var.insertion,
+                                    test::coverage_type{var.coverage, domain}});
+    });
+    return store;
+}
+
+inline std::vector<variant_t> const nested_deletions{
+    variant_t{.position{2}, .insertion{""s}, .deletion{4}, .coverage{0}},
+    variant_t{.position{3}, .insertion{""s}, .deletion{2}, .coverage{1}},
+    variant_t{.position{12}, .insertion{"C"s}, .deletion{1}, .coverage{0, 1}}
+};
+
+inline std::vector<variant_t> const overlapping_deletions{
+    variant_t{.position{2}, .insertion{""s}, .deletion{2}, .coverage{0}},
+    variant_t{.position{3}, .insertion{""s}, .deletion{3}, .coverage{1}},
+    variant_t{.position{5}, .insertion{""s}, .deletion{2}, .coverage{2, 3}},
+    variant_t{.position{9}, .insertion{"CC"s}, .deletion{0}, .coverage{2}},
+    variant_t{.position{12}, .insertion{"C"s}, .deletion{1}, .coverage{0, 1}},
+    variant_t{.position{13}, .insertion{""s}, .deletion{1}, .coverage{3}}
+};
+
+// The boundaries of the nodes in depth-first order, visiting the alternate child first.
+template <typename tree_t>
+std::vector<std::array<uint32_t, 3>> traversed_nodes(tree_t const & tree) {
+    using node_t = libjst::tree_node_t<tree_t>;
+    std::vector<std::array<uint32_t, 3>> nodes{};
+    std::stack<node_t> path{};
+    path.push(libjst::root(tree));
+    while (!path.empty()) {
+        node_t node = std::move(path.top());
+        path.pop();
+        nodes.push_back({static_cast<uint32_t>(libjst::position(node.low_boundary())),
+                         static_cast<uint32_t>(libjst::position(node.high_boundary())),
+                         node.from_reference()});
+        if (auto ref_child = node.next_ref(); ref_child.has_value())
+            path.push(std::move(*ref_child));
+        if (auto alt_child = node.next_alt(); alt_child.has_value())
+            path.push(std::move(*alt_child));
+    }
+    return nodes;
+}
+
+} // namespace jst::test::merged_tree
+
+TEST(merged_tree_jump_test, next_branch) {
+    auto store = jst::test::merged_tree::make_deletion_store(jst::test::merged_tree::overlapping_deletions);
+    auto const & variants = store.variants();
+    libjst::branch_jump_table table{variants};
+    ASSERT_EQ(table.size(), std::ranges::size(variants));
+
+    auto sink = std::ranges::prev(std::ranges::end(variants));
+    EXPECT_EQ(table.next_branch(sink), sink);
+    bool jumps_over_breakends = false;
+    for (auto it = std::ranges::begin(variants); it != sink; ++it) {
+        auto expected = std::ranges::find_if(std::ranges::next(it), sink, [] (auto && breakend) {
+            return breakend.get_breakpoint_end() == libjst::breakpoint_end::low;
+        });
+        EXPECT_EQ(table.next_branch(it), expected);
+        jumps_over_breakends |= std::ranges::distance(it, expected) > 1;
+    }
+    EXPECT_TRUE(jumps_over_breakends);
+}
+
+TEST(merged_tree_jump_test, same_nodes) {
+    auto store = jst::test::merged_tree::make_deletion_store(jst::test::merged_tree::overlapping_deletions);
+    libjst::branch_jump_table table{store.variants()};
+
+    auto pruned_tree = libjst::volatile_tree{store} | libjst::coloured() | libjst::prune();
+    EXPECT_EQ(jst::test::merged_tree::traversed_nodes(pruned_tree | libjst::merge(table)),
+              jst::test::merged_tree::traversed_nodes(pruned_tree | libjst::merge()));
+}
+
+TEST(merged_tree_jump_test, same_trimmed_nodes) {
+    auto store = jst::test::merged_tree::make_deletion_store(jst::test::merged_tree::nested_deletions);
+    libjst::branch_jump_table table{store.variants()};
+
+    for (uint32_t window : {1u, 2u, 4u}) {
+        auto search_tree = libjst::volatile_tree{store} | libjst::labelled()
+                                                        | libjst::coloured()
+                                                        | libjst::trim(window)
+                                                        | libjst::prune();
+        EXPECT_EQ(jst::test::merged_tree::traversed_nodes(search_tree | libjst::merge(table)),
+                  jst::test::merged_tree::traversed_nodes(search_tree | libjst::merge())) << "window " << window;
+    }
+}
@@ -0,0 +1,191 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/sequence_tree/min_support_tree.hpp>
+#include <libjst/sequence_tree/partial_tree.hpp>
+#include <libjst/sequence_tree/volatile_tree.hpp>
+#include <libjst/traversal/state_oblivious_traverser.hpp>
+
+namespace jst::test::min_support_tree {
+
+using source_t = std::string;
+using coverage_type = libjst::bit_coverage<uint32_t>;
+using cms_type = libjst::dna_compressed_multisequence<source_t, coverage_type>;
+using store_type = libjst::rcs_store<source_t, cms_type>;
+using value_type = std::ranges::range_value_t<cms_type>;
+
+struct naive_matcher {
+    source_t needle{};
+
+    constexpr std::size_t window_size() const noexcept {
+        return needle.size();
+    }
+
+    template <typename haystack_t, typename callback_t>
+    constexpr void operator()(haystack_t && haystack, callback_t && callback) const {
+        auto it = std::ranges::begin(haystack);
+        auto last = std::ranges::end(haystack);
+        for (; std::ranges::distance(it, last) >= std::ranges::ssize(needle); ++it) {
+            if (std::ranges::equal(std::ranges::subrange{it, std::ranges::next(it, needle.size())}, needle))
+                callback(it);
+        }
+    }
+};
+
+//!\brief The number of hits and the number of haplotypes covering them.
+struct hit_summary {
+    std::size_t hits{};
+    std::size_t carriers{};
+
+    friend bool operator==(hit_summary const &, hit_summary const &) = default;
+
+    template <typename stream_t>
+    friend stream_t & operator<<(stream_t & stream, hit_summary const & summary) {
+        stream << "{hits: " << summary.hits << ", carriers: " << summary.carriers << "}";
+        return stream;
+    }
+};
+
+// Dense variants of a small cohort, such that the alternate paths of the common variants reach rare variants.
+struct test : public ::testing::Test {
+    static constexpr uint32_t haplotype_count{32};
+
+    source_t source{};
+    std::vector<value_type> variants{};
+    std::vector<std::size_t> carrier_counts{};
+
+    void SetUp() override {
+        std::mt19937 random_engine{11};
+        std::uniform_int_distribution<int> symbol_distribution{0, 3};
+        std::uniform_int_distribution<uint32_t> step_distribution{3, 4};
+        std::uniform_int_distribution<uint32_t> carrier_distribution{1, haplotype_count};
+        constexpr std::string_view dna{"ACGT"};
+        source.resize(2000);
+        std::ranges::generate(source, [&] { return dna[symbol_distribution(random_engine)]; });
+
+        libjst::coverage_domain_t<coverage_type> domain{0, haplotype_count};
+        std::vector<uint32_t> haplotypes(haplotype_count);
+        std::iota(haplotypes.begin(), haplotypes.end(), 0u);
+        std::size_t variant_idx{};
+        for (uint32_t position = 2; position + 3 < source.size(); position += step_distribution(random_engine)) {
+            std::ranges::shuffle(haplotypes, random_engine);
+            std::vector<uint32_t> carriers(haplotypes.begin(), haplotypes.begin() + carrier_distribution(random_engine));
+            std::ranges::sort(carriers);
+            carrier_counts.push_back(carriers.size());
+
+            switch (variant_idx++ % 8) {
+                case 3: variants.push_back(value_type{libjst::breakpoint{position, 0}, source_t{"GA"},
+                                                      coverage_type{carriers, domain}}); break;
+                case 6: variants.push_back(value_type{libjst::breakpoint{position, 2}, source_t{},
+                                                      coverage_type{carriers, domain}}); break;
+                default: variants.push_back(value_type{libjst::breakpoint{position, 1},
+                                                       source_t{dna[(dna.find(source[position]) + 1) % 4]},
+                                                       coverage_type{carriers, domain}});
+            }
+        }
+    }
+
+    // The store of the variants with at least the given number of carriers.
+    store_type supported_store(std::size_t const min_support) const {
+        std::vector<value_type> supported{};
+        for (std::size_t idx = 0; idx < variants.size(); ++idx)
+            if (carrier_counts[idx] >= min_support)
+                supported.push_back(variants[idx]);
+        return store_type{source, haplotype_count, supported};
+    }
+
+    template <typename tree_t>
+    static hit_summary summarise(tree_t const & tree, source_t const & needle) {
+        hit_summary summary{};
+        libjst::state_oblivious_traverser{}(tree, naive_matcher{needle}, [&] (auto &&, auto && label) {
+            ++summary.hits;
+            summary.carriers += libjst::coverage_intersection_count(label.coverage(), label.coverage());
+        });
+        return summary;
+    }
+
+};
+
+} // namespace jst::test::min_support_tree
+
+using namespace std::literals;
+
+using store_type = jst::test::min_support_tree::store_type;
+using source_t = jst::test::min_support_tree::source_t;
+using hit_summary = jst::test::min_support_tree::hit_summary;
+
+struct min_support_tree_test : public jst::test::min_support_tree::test
+{};
+
+// ----------------------------------------------------------------------------
+// Test case definitions
+// ----------------------------------------------------------------------------
+
+TEST_F(min_support_tree_test, carrier_counts) {
+    store_type store{source, haplotype_count, variants};
+    EXPECT_FALSE(store.variants().has_carrier_count_index());
+    EXPECT_THROW((libjst::volatile_tree{store} | libjst::min_support(2u)), std::invalid_argument);
+
+    store.build_carrier_count_index();
+    ASSERT_TRUE(store.variants().has_carrier_count_index());
+    libjst::carrier_count_index const & counts = store.variants().carrier_counts();
+    ASSERT_EQ(counts.size(), static_cast<std::size_t>(std::ranges::distance(store.variants())));
+
+    std::vector<std::size_t> low_end_counts{};
+    for (auto it = std::ranges::begin(store.variants()); it != std::ranges::end(store.variants()); ++it) {
+        std::size_t const count = counts[static_cast<std::size_t>(it - std::ranges::begin(store.variants()))];
+        EXPECT_EQ(count, libjst::coverage_intersection_count(libjst::coverage(*it), libjst::coverage(*it)));
+        if ((*it).get_breakpoint_end() == libjst::breakpoint_end::low && it != std::ranges::begin(store.variants()))
+            low_end_counts.push_back(count);
+    }
+    EXPECT_EQ(counts[0], haplotype_count); // the reference sentinel covers all haplotypes.
+    std::vector<std::size_t> expected_counts = carrier_counts;
+    std::ranges::sort(expected_counts);
+    std::ranges::sort(low_end_counts);
+    EXPECT_EQ(low_end_counts, expected_counts);
+
+    store.add(variants.front()); // a modification drops the index.
+    EXPECT_FALSE(store.variants().has_carrier_count_index());
+}
+
+TEST_F(min_support_tree_test, common_variants) {
+    store_type store{source, haplotype_count, variants};
+    store.build_carrier_count_index();
+
+    for (std::size_t min_support : {1u, 8u, 16u, 28u}) {
+        store_type const supported = supported_store(min_support);
+        for (source_t needle : {"ACG"s, "GATC"s, "TGAC"s, "CAGATCA"s}) {
+            EXPECT_EQ(summarise(libjst::volatile_tree{store} | libjst::min_support(min_support), needle),
+                      summarise(libjst::volatile_tree{supported}, needle))
+                << needle << " " << min_support;
+        }
+    }
+}
+
+TEST_F(min_support_tree_test, partial_tree) {
+    store_type store{source, haplotype_count, variants};
+    store.build_carrier_count_index();
+    store_type const supported = supported_store(16);
+
+    for (uint32_t begin : {0u, 500u, 1300u}) {
+        EXPECT_EQ(summarise(libjst::partial_tree{store, begin, 400u} | libjst::min_support(16u), "GATC"s),
+                  summarise(libjst::partial_tree{supported, begin, 400u}, "GATC"s)) << begin;
+    }
+}
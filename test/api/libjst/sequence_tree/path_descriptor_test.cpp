@@ -7,6 +7,9 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <vector>
+
 #include <libjst/sequence_tree/path_descriptor.hpp>
 
 struct path_descriptor_test : public ::testing::Test {
@@ -15,9 +18,9 @@ struct path_descriptor_test : public ::testing::Test {
 TEST(path_descriptor_test, use_case) {
     libjst::alternate_path_descriptor descr{};
 
+    size_t const depth = 300; // exceeds several inline words
     EXPECT_EQ(descr.size(), 1);
-    EXPECT_EQ(descr.max_size(), 256);
-    for (unsigned i = 1; i < descr.max_size(); ++i) {
+    for (unsigned i = 1; i < depth; ++i) {
         descr.next();
         bool is_ref = (i & 1);
         if (is_ref) {
@@ -27,10 +30,10 @@ TEST(path_descriptor_test, use_case) {
         }
         EXPECT_EQ(descr.size(), i + 1);
     }
-    EXPECT_EQ(descr.size(), descr.max_size());
+    EXPECT_EQ(descr.size(), depth);
 
     std::vector<bool> expected_path{};
-    expected_path.resize(descr.max_size());
+    expected_path.resize(depth);
     bool v{true};
     for (auto && elem : expected_path) {
         elem = v;
@@ -40,4 +43,62 @@ TEST(path_descriptor_test, use_case) {
     EXPECT_TRUE(std::ranges::equal(descr, expected_path));
 }
 
+TEST(path_descriptor_test, small_footprint) {
+    EXPECT_EQ(sizeof(libjst::alternate_path_descriptor), 2 * sizeof(uint_fast64_t));
+}
+
+TEST(path_descriptor_test, copies_own_spilled_words) {
+    libjst::alternate_path_descriptor descr{};
+    for (unsigned i = 1; i < 200; ++i) {
+        descr.next();
+        descr.set_alt();
+    }
+
+    libjst::alternate_path_descriptor copy{descr};
+    libjst::alternate_path_descriptor assigned{};
+    assigned = descr;
+    for (unsigned i = 0; i < 100; ++i) {
+        descr.next();
+        descr.set_ref();
+    }
+
+    EXPECT_EQ(copy.size(), 200u);
+    EXPECT_EQ(copy, assigned);
+    EXPECT_TRUE(std::ranges::all_of(copy, [] (bool const decision) { return decision; }));
+    EXPECT_NE(copy, descr);
+
+    libjst::alternate_path_descriptor moved{std::move(copy)};
+    EXPECT_EQ(moved, assigned);
+    assigned = std::move(descr);
+    EXPECT_EQ(assigned.size(), 300u);
+    EXPECT_FALSE(*std::ranges::prev(assigned.end()));
+}
+
+TEST(path_descriptor_test, compare_deep_paths) {
+    auto make_path = [] (std::vector<bool> const & steps) {
+        libjst::alternate_path_descriptor descr{};
+        for (bool step : steps) {
+            descr.next();
+            if (step)
+                descr.set_alt();
+            else
+                descr.set_ref();
+        }
+        return descr;
+    };
+
+    std::vector<bool> steps(150, false);
+    std::vector<bool> diverging_steps{steps};
+    diverging_steps[10] = true;
+
+    libjst::alternate_path_descriptor const descr = make_path(steps);
+    EXPECT_EQ(descr, make_path(steps));
+    EXPECT_NE(descr, make_path(diverging_steps));
+    EXPECT_LT(descr, make_path(diverging_steps)); // differs in the first spilled word only
+    EXPECT_LT(make_path(std::vector<bool>(140, true)), descr);
+
+    libjst::alternate_path_descriptor const copy{descr};
+    EXPECT_TRUE(std::ranges::equal(copy, descr));
+}
+
 // TEST(path_descriptor_test, )
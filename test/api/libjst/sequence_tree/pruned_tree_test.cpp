@@ -16,9 +16,15 @@
 
 #include <libjst/sequence_tree/volatile_tree.hpp>
 #include <libjst/sequence_tree/coloured_tree.hpp>
+#include <libjst/sequence_tree/coverage_block_summary.hpp>
 #include <libjst/sequence_tree/prune_tree.hpp>
+#include <libjst/coverage/bit_coverage_pool.hpp>
+#include <libjst/coverage/compressed_int_coverage.hpp>
+#include <libjst/coverage/fixed_bit_coverage.hpp>
+#include <libjst/coverage/run_length_coverage_pool.hpp>
 #include <libjst/rcms/dna_compressed_multisequence.hpp>
 #include <libjst/rcms/rcs_store.hpp>
+#include <libjst/traversal/tree_traverser_base.hpp>
 
 #include "../mock/rcs_store_mock.hpp"
 
@@ -82,6 +88,34 @@ struct pruned_tree_test : public jst::test::labelled_tree::test
         auto const & rcs_mock = get_mock();
         return libjst::volatile_tree{rcs_mock} | libjst::coloured() | libjst::prune();
     }
+
+    // The path coverages in the depth-first order of the traverser.
+    template <typename tree_t>
+    static std::vector<std::vector<uint32_t>> traversed_coverages(tree_t const & tree) {
+        std::vector<std::vector<uint32_t>> coverages{};
+        libjst::tree_traverser_base path{tree};
+        for (auto it = path.begin(); it != path.end(); ++it) {
+            auto const & coverage = (*it).coverage();
+            std::vector<uint32_t> & ints = coverages.emplace_back();
+            for (uint32_t i = 0; i < coverage.size(); ++i) {
+                if (coverage[i])
+                    ints.push_back(i);
+            }
+        }
+        return coverages;
+    }
+
+    template <typename store_t>
+    void fill_store(store_t & store) const {
+        using value_t = std::ranges::range_value_t<typename store_t::variant_map_type>;
+        using coverage_t = jst::test::labelled_tree::test::coverage_type;
+        auto domain = store.variants().coverage_domain();
+        std::ranges::for_each(GetParam().variants, [&] (auto var) {
+            store.add(value_t{libjst::breakpoint{var.position, var.deletion},
+                              var.insertion,
+                              coverage_t{var.coverage, domain}});
+        });
+    }
 };
 
 // ----------------------------------------------------------------------------
@@ -143,6 +177,279 @@ TEST_P(pruned_tree_test, root_sink) {
         EXPECT_EQ(GetParam().expected_coverages[i], actual_coverages[i]) << i;
 }
 
+TEST_P(pruned_tree_test, pooled_coverages) {
+    using coverage_type = jst::test::labelled_tree::test::coverage_type;
+    using pooled_cms_t = libjst::dna_compressed_multisequence<std::string, coverage_type, uint32_t,
+                                                              libjst::bit_coverage_pool<uint32_t>>;
+    using pooled_value_t = std::ranges::range_value_t<pooled_cms_t>;
+    using pooled_store_t = libjst::rcs_store<std::string, pooled_cms_t>;
+
+    pooled_store_t pooled_store{GetParam().source, GetParam().coverage_size};
+    auto domain = pooled_store.variants().coverage_domain();
+    std::ranges::for_each(GetParam().variants, [&] (auto var) {
+        pooled_store.add(pooled_value_t{libjst::breakpoint{var.position, var.deletion},
+                                        var.insertion,
+                                        coverage_type{var.coverage, domain}});
+    });
+
+    auto tree = libjst::volatile_tree{pooled_store} | libjst::coloured() | libjst::prune();
+    using node_t = libjst::tree_node_t<decltype(tree)>;
+
+    auto to_ints = [] (auto const & cov) -> std::vector<uint32_t> {
+        std::vector<uint32_t> ints{};
+        for (uint32_t i = 0; i < cov.size(); ++i) {
+            if (cov[i])
+                ints.push_back(i);
+        }
+        return ints;
+    };
+
+    std::vector<std::vector<uint32_t>> actual_coverages{};
+    std::stack<node_t> path{};
+    path.push(libjst::root(tree));
+    while (!path.empty()) {
+        node_t p = std::move(path.top());
+        path.pop();
+        actual_coverages.push_back(to_ints((*p).coverage()));
+
+        if (auto c_ref = p.next_ref(); c_ref.has_value()) {
+            path.push(std::move(*c_ref));
+        }
+        if (auto c_alt = p.next_alt(); c_alt.has_value()) {
+            path.push(std::move(*c_alt));
+        }
+    }
+
+    EXPECT_EQ(actual_coverages, GetParam().expected_coverages);
+}
+
+TEST_P(pruned_tree_test, run_length_coverages) {
+    using coverage_type = jst::test::labelled_tree::test::coverage_type;
+    using encoded_cms_t = libjst::dna_compressed_multisequence<std::string, coverage_type, uint32_t,
+                                                               libjst::run_length_coverage_pool<uint32_t>>;
+    using encoded_value_t = std::ranges::range_value_t<encoded_cms_t>;
+    using encoded_store_t = libjst::rcs_store<std::string, encoded_cms_t>;
+
+    encoded_store_t encoded_store{GetParam().source, GetParam().coverage_size};
+    auto domain = encoded_store.variants().coverage_domain();
+    std::ranges::for_each(GetParam().variants, [&] (auto var) {
+        encoded_store.add(encoded_value_t{libjst::breakpoint{var.position, var.deletion},
+                                          var.insertion,
+                                          coverage_type{var.coverage, domain}});
+    });
+
+    auto tree = libjst::volatile_tree{encoded_store} | libjst::coloured() | libjst::prune();
+    using node_t = libjst::tree_node_t<decltype(tree)>;
+
+    auto to_ints = [] (auto const & cov) -> std::vector<uint32_t> {
+        std::vector<uint32_t> ints{};
+        for (uint32_t i = 0; i < cov.size(); ++i) {
+            if (cov[i])
+                ints.push_back(i);
+        }
+        return ints;
+    };
+
+    std::vector<std::vector<uint32_t>> actual_coverages{};
+    std::stack<node_t> path{};
+    path.push(libjst::root(tree));
+    while (!path.empty()) {
+        node_t p = std::move(path.top());
+        path.pop();
+        actual_coverages.push_back(to_ints((*p).coverage()));
+
+        if (auto c_ref = p.next_ref(); c_ref.has_value()) {
+            path.push(std::move(*c_ref));
+        }
+        if (auto c_alt = p.next_alt(); c_alt.has_value()) {
+            path.push(std::move(*c_alt));
+        }
+    }
+
+    EXPECT_EQ(actual_coverages, GetParam().expected_coverages);
+}
+
+TEST_P(pruned_tree_test, fixed_coverages) {
+    using fixed_coverage_t = libjst::fixed_bit_coverage<uint32_t, 64>;
+    using fixed_cms_t = libjst::dna_compressed_multisequence<std::string, fixed_coverage_t>;
+    using fixed_value_t = std::ranges::range_value_t<fixed_cms_t>;
+    using fixed_store_t = libjst::rcs_store<std::string, fixed_cms_t>;
+
+    fixed_store_t fixed_store{GetParam().source, GetParam().coverage_size};
+    auto domain = fixed_store.variants().coverage_domain();
+    std::ranges::for_each(GetParam().variants, [&] (auto var) {
+        fixed_store.add(fixed_value_t{libjst::breakpoint{var.position, var.deletion},
+                                      var.insertion,
+                                      fixed_coverage_t{var.coverage, domain}});
+    });
+
+    auto tree = libjst::volatile_tree{fixed_store} | libjst::coloured() | libjst::prune();
+    using node_t = libjst::tree_node_t<decltype(tree)>;
+
+    auto to_ints = [] (auto const & cov) -> std::vector<uint32_t> {
+        std::vector<uint32_t> ints{};
+        for (uint32_t i = 0; i < cov.size(); ++i) {
+            if (cov[i])
+                ints.push_back(i);
+        }
+        return ints;
+    };
+
+    std::vector<std::vector<uint32_t>> actual_coverages{};
+    std::stack<node_t> path{};
+    path.push(libjst::root(tree));
+    while (!path.empty()) {
+        node_t p = std::move(path.top());
+        path.pop();
+        actual_coverages.push_back(to_ints((*p).coverage()));
+
+        if (auto c_ref = p.next_ref(); c_ref.has_value()) {
+            path.push(std::move(*c_ref));
+        }
+        if (auto c_alt = p.next_alt(); c_alt.has_value()) {
+            path.push(std::move(*c_alt));
+        }
+    }
+
+    EXPECT_EQ(actual_coverages, GetParam().expected_coverages);
+}
+
+TEST_P(pruned_tree_test, compressed_int_coverages) {
+    using compressed_coverage_t = libjst::compressed_int_coverage<uint32_t>;
+    using compressed_cms_t = libjst::dna_compressed_multisequence<std::string, compressed_coverage_t>;
+    using compressed_value_t = std::ranges::range_value_t<compressed_cms_t>;
+
+    libjst::rcs_store<std::string, compressed_cms_t> compressed_store{GetParam().source, GetParam().coverage_size};
+    auto domain = compressed_store.variants().coverage_domain();
+    std::ranges::for_each(GetParam().variants, [&] (auto var) {
+        compressed_store.add(compressed_value_t{libjst::breakpoint{var.position, var.deletion},
+                                                var.insertion,
+                                                compressed_coverage_t{var.coverage, domain}});
+    });
+
+    auto to_ints = [] (auto const & tree) {
+        std::vector<std::vector<uint32_t>> coverages{};
+        libjst::tree_traverser_base path{tree};
+        for (auto it = path.begin(); it != path.end(); ++it) {
+            auto const & coverage = (*it).coverage();
+            coverages.emplace_back(coverage.begin(), coverage.end());
+        }
+        return coverages;
+    };
+
+    std::vector<std::vector<uint32_t>> const expected = traversed_coverages(make_tree());
+    EXPECT_EQ(to_ints(libjst::volatile_tree{compressed_store} | libjst::coloured() | libjst::prune()), expected);
+    EXPECT_EQ(to_ints(libjst::volatile_tree{compressed_store} | libjst::coloured() | libjst::prune_in_place()),
+              expected);
+}
+
+TEST_P(pruned_tree_test, in_place_coverages) {
+    auto expected_tree = make_tree();
+    auto in_place_tree = libjst::volatile_tree{get_mock()} | libjst::coloured() | libjst::prune_in_place();
+
+    std::vector<std::vector<uint32_t>> const expected = traversed_coverages(expected_tree);
+    EXPECT_EQ(expected.size(), GetParam().expected_coverages.size());
+    EXPECT_EQ(traversed_coverages(in_place_tree), expected);
+}
+
+TEST_P(pruned_tree_test, in_place_pooled_and_run_length_coverages) {
+    using coverage_type = jst::test::labelled_tree::test::coverage_type;
+    using pooled_cms_t = libjst::dna_compressed_multisequence<std::string, coverage_type, uint32_t,
+                                                              libjst::bit_coverage_pool<uint32_t>>;
+    using encoded_cms_t = libjst::dna_compressed_multisequence<std::string, coverage_type, uint32_t,
+                                                               libjst::run_length_coverage_pool<uint32_t>>;
+
+    libjst::rcs_store<std::string, pooled_cms_t> pooled_store{GetParam().source, GetParam().coverage_size};
+    fill_store(pooled_store);
+    libjst::rcs_store<std::string, encoded_cms_t> encoded_store{GetParam().source, GetParam().coverage_size};
+    fill_store(encoded_store);
+
+    std::vector<std::vector<uint32_t>> const expected = traversed_coverages(make_tree());
+    EXPECT_EQ(traversed_coverages(libjst::volatile_tree{pooled_store} | libjst::coloured() | libjst::prune_in_place()),
+              expected);
+    EXPECT_EQ(traversed_coverages(libjst::volatile_tree{encoded_store} | libjst::coloured() | libjst::prune_in_place()),
+              expected);
+}
+
+TEST_P(pruned_tree_test, block_summary) {
+    auto const & variants = get_mock().variants();
+    std::vector<std::vector<uint32_t>> const expected = traversed_coverages(make_tree());
+    for (std::size_t block_size : {1u, 2u, 3u, 64u}) {
+        libjst::coverage_block_summary summary{variants, block_size};
+        EXPECT_EQ(summary.block_count(), (std::ranges::size(variants) + block_size - 1) / block_size);
+
+        auto tree = libjst::volatile_tree{get_mock()} | libjst::coloured() | libjst::prune(summary);
+        EXPECT_EQ(traversed_coverages(tree), expected) << "block size " << block_size;
+        auto in_place_tree = libjst::volatile_tree{get_mock()} | libjst::coloured() | libjst::prune_in_place(summary);
+        EXPECT_EQ(traversed_coverages(in_place_tree), expected) << "block size " << block_size;
+    }
+}
+
+TEST_P(pruned_tree_test, block_summary_coverages) {
+    auto const & variants = get_mock().variants();
+    libjst::coverage_block_summary summary{variants, 2};
+    auto domain = variants.coverage_domain();
+    for (std::size_t block = 0; block < summary.block_count(); ++block) {
+        std::vector<uint32_t> expected_union{};
+        for (std::size_t idx = std::max<std::size_t>(block * 2, 1);
+             idx < std::min<std::size_t>((block + 1) * 2, std::ranges::size(variants) - 1);
+             ++idx) {
+            auto const & coverage = libjst::coverage(std::ranges::begin(variants)[idx]);
+            for (uint32_t i = 0; i < GetParam().coverage_size; ++i) {
+                if (coverage[i])
+                    expected_union.push_back(i);
+            }
+        }
+        std::ranges::sort(expected_union);
+        auto [first, last] = std::ranges::unique(expected_union);
+        expected_union.erase(first, last);
+
+        auto const & block_coverage = summary.block_coverage(block);
+        std::vector<uint32_t> actual_union{};
+        for (uint32_t i = 0; i < GetParam().coverage_size; ++i) {
+            if (block_coverage[i])
+                actual_union.push_back(i);
+        }
+        EXPECT_EQ(actual_union, expected_union);
+        EXPECT_EQ(summary.supports(block, jst::test::labelled_tree::test::coverage_type{{}, domain}), false);
+    }
+    EXPECT_EQ(summary.block_of(std::ranges::begin(variants)), 0u);
+}
+
+TEST_P(pruned_tree_test, subset_root_colour) {
+    using coverage_type = jst::test::labelled_tree::test::coverage_type;
+    auto domain = get_mock().variants().coverage_domain();
+    std::vector<std::vector<uint32_t>> const all_coverages = traversed_coverages(make_tree());
+
+    for (std::vector<uint32_t> subset : {std::vector<uint32_t>{0}, {1, 3}, {0, 1, 2, 3}, {}}) {
+        // The pruned subset tree visits the root and the nodes of the full tree that are covered by the subset.
+        std::vector<std::vector<uint32_t>> expected{};
+        for (auto const & coverage : all_coverages) {
+            std::vector<uint32_t> restricted{};
+            std::ranges::set_intersection(coverage, subset, std::back_inserter(restricted));
+            if (expected.empty() || !restricted.empty())
+                expected.push_back(std::move(restricted));
+        }
+
+        auto tree = libjst::volatile_tree{get_mock()} | libjst::coloured(coverage_type{subset, domain})
+                                                      | libjst::prune();
+        EXPECT_EQ(traversed_coverages(tree), expected);
+    }
+}
+
+TEST_P(pruned_tree_test, subset_root_colour_from_other_domain) {
+    using coverage_type = jst::test::labelled_tree::test::coverage_type;
+    libjst::coverage_domain_t<coverage_type> other_domain{0, GetParam().coverage_size + 1};
+    EXPECT_THROW((libjst::volatile_tree{get_mock()} | libjst::coloured(coverage_type{{0}, other_domain})),
+                 std::domain_error);
+}
+
+TEST(coverage_block_summary_test, invalid_block_size) {
+    using test_t = jst::test::labelled_tree::test;
+    test_t::rcs_store_t store{"AAAA"s, 2};
+    EXPECT_THROW((libjst::coverage_block_summary{store.variants(), 0}), std::invalid_argument);
+}
+
 // ----------------------------------------------------------------------------
 // Test values
 // ----------------------------------------------------------------------------
@@ -210,3 +517,15 @@ INSTANTIATE_TEST_SUITE_P(snv4_snv4, pruned_tree_test, testing::Values(fixture{
                                       {0, 1, 2, 3}, {1, 2}, {1, 2},
                                                     {0, 1, 2, 3}}
 }));
+
+INSTANTIATE_TEST_SUITE_P(snv2_all_snv5, pruned_tree_test, testing::Values(fixture{
+    .source{"AAAAGGGG"s},
+    .variants{
+        variant_t{.position{2}, .insertion{"C"s}, .deletion{1}, .coverage{0, 1, 2, 3}},
+        variant_t{.position{5}, .insertion{"T"s}, .deletion{1}, .coverage{1}}
+    },
+    .expected_coverages{{0, 1, 2, 3}, {0, 1, 2, 3}, {0, 1, 2, 3}, {1}, {1},
+                                                    {0, 2, 3},
+                        {0, 1, 2, 3}, {1}, {1},
+                        {0, 1, 2, 3}}
+}));
@@ -0,0 +1,96 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include <libjst/sequence_tree/seek_position_codec.hpp>
+
+namespace {
+
+libjst::seek_position reference_position(uint64_t const variant_index, libjst::breakpoint_end const site) {
+    libjst::seek_position position{};
+    position.reset(variant_index, site);
+    return position;
+}
+
+libjst::seek_position alternate_position(uint64_t const variant_index, std::size_t const depth) {
+    libjst::seek_position position{};
+    position.initiate_alternate_node(variant_index);
+    for (std::size_t step = 0; step < depth; ++step)
+        position.next_alternate_node(step % 3 == 0);
+    return position;
+}
+
+} // namespace
+
+TEST(seek_position_codec_test, reference_size) {
+    std::vector<std::byte> bytes{};
+    libjst::seek_position_codec::encode(reference_position(31, libjst::breakpoint_end::high), bytes);
+    EXPECT_EQ(bytes.size(), 1u);
+    libjst::seek_position_codec::encode(reference_position(32, libjst::breakpoint_end::low), bytes);
+    EXPECT_EQ(bytes.size(), 3u);
+}
+
+TEST(seek_position_codec_test, alternate_size) {
+    std::vector<std::byte> bytes{};
+    libjst::seek_position_codec::encode(alternate_position(3, 0), bytes);
+    EXPECT_EQ(bytes.size(), 2u);
+    bytes.clear();
+    libjst::seek_position_codec::encode(alternate_position(3, 12), bytes);
+    EXPECT_EQ(bytes.size(), 4u);
+}
+
+TEST(seek_position_codec_test, round_trip) {
+    std::vector<libjst::seek_position> positions{
+        reference_position(0, libjst::breakpoint_end::low),
+        reference_position(1, libjst::breakpoint_end::high),
+        reference_position(uint64_t{1} << 40, libjst::breakpoint_end::high),
+        alternate_position(0, 0),
+        alternate_position(7, 5),
+        alternate_position(1000, 63),
+        alternate_position(123456, 300)
+    };
+
+    std::vector<std::byte> bytes{};
+    for (libjst::seek_position const & position : positions)
+        libjst::seek_position_codec::encode(position, bytes);
+
+    std::vector<libjst::seek_position> decoded{};
+    libjst::seek_position_codec::decode_all(bytes, decoded);
+    EXPECT_EQ(decoded, positions);
+}
+
+TEST(seek_position_codec_test, corrupted) {
+    std::vector<std::byte> bytes{};
+    libjst::seek_position_codec::encode(alternate_position(1000, 20), bytes);
+    bytes.pop_back();
+
+    libjst::seek_position position{};
+    EXPECT_THROW(libjst::seek_position_codec::decode(bytes, position), std::runtime_error);
+    EXPECT_THROW(libjst::seek_position_codec::decode(std::span{bytes}.first(1), position), std::runtime_error);
+}
+
+TEST(seek_position_codec_test, fixed_reference) {
+    std::vector<libjst::seek_position> positions{};
+    std::vector<uint64_t> codes{};
+    for (uint64_t variant_index : {uint64_t{0}, uint64_t{5}, uint64_t{1} << 62}) {
+        for (libjst::breakpoint_end site : {libjst::breakpoint_end::low, libjst::breakpoint_end::high}) {
+            positions.push_back(reference_position(variant_index, site));
+            codes.push_back(libjst::seek_position_codec::encode_reference(positions.back()));
+            EXPECT_EQ(libjst::seek_position_codec::decode_reference(codes.back()), positions.back());
+        }
+    }
+
+    std::vector<libjst::seek_position> decoded(codes.size());
+    libjst::seek_position_codec::decode_references(codes, decoded);
+    EXPECT_EQ(decoded, positions);
+}
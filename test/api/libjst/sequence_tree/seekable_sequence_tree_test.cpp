@@ -135,6 +135,57 @@ TEST_P(seekable_sequence_tree_test, seek) {
     std::cout << "\n";
 }
 
+TEST_P(seekable_sequence_tree_test, seek_many) {
+    auto tree = make_tree() | libjst::seek();
+
+    using tree_t = decltype(tree);
+    using node_t = libjst::tree_node_t<tree_t>;
+
+    auto to_string = [] (auto seq) -> std::string {
+        std::string str;
+        for (char c : seq)
+            str.push_back(c);
+        return str;
+    };
+
+    std::vector<libjst::seek_position> positions{};
+    std::vector<std::string> expected_labels{};
+    std::stack<node_t> path{};
+    path.push(libjst::root(tree));
+    while (!path.empty()) {
+        node_t p = std::move(path.top());
+        path.pop();
+        auto label = *p;
+        positions.push_back(label.position());
+        expected_labels.push_back(to_string(label.sequence()));
+
+        if (auto c_ref = p.next_ref(); c_ref.has_value()) {
+            path.push(std::move(*c_ref));
+        }
+        if (auto c_alt = p.next_alt(); c_alt.has_value()) {
+            path.push(std::move(*c_alt));
+        }
+    }
+
+    // Seek every position twice and in reversed order.
+    std::vector<libjst::seek_position> requests{positions.rbegin(), positions.rend()};
+    requests.insert(requests.end(), positions.begin(), positions.end());
+    std::vector<std::size_t> seen(requests.size());
+    tree.seek_many(requests, [&] (std::size_t const index, node_t const & node) {
+        ++seen[index];
+        auto label = *node;
+        std::size_t const expected = (index < positions.size()) ? positions.size() - 1 - index
+                                                                : index - positions.size();
+        EXPECT_EQ(to_string(label.sequence()), expected_labels[expected]) << index;
+        EXPECT_EQ(label.position(), requests[index]) << index;
+    });
+    EXPECT_TRUE(std::ranges::all_of(seen, [] (std::size_t const count) { return count == 1; }));
+
+    std::size_t calls{};
+    tree.seek_many(std::span<libjst::seek_position const>{}, [&] (auto &&...) { ++calls; });
+    EXPECT_EQ(calls, 0u);
+}
+
 // ----------------------------------------------------------------------------
 // Test values
 // ----------------------------------------------------------------------------
@@ -157,3 +208,15 @@ INSTANTIATE_TEST_SUITE_P(two_variants, seekable_sequence_tree_test, testing::Val
     .window_size{4}
 }));
 
+
+INSTANTIATE_TEST_SUITE_P(nested_variants, seekable_sequence_tree_test, testing::Values(fixture{
+         //  0123456789012345
+    .source{"AAAAGGGGAAAAGGGG"s},
+    .variants{variant_t{.position{1}, .insertion{"C"s}, .deletion{1}, .coverage{0, 1}},
+              variant_t{.position{2}, .insertion{"T"s}, .deletion{1}, .coverage{0, 2}},
+              variant_t{.position{3}, .insertion{"G"s}, .deletion{1}, .coverage{1, 2}},
+              variant_t{.position{3}, .insertion{"C"s}, .deletion{1}, .coverage{3}},
+              variant_t{.position{9}, .insertion{"T"s}, .deletion{1}, .coverage{0, 3}}},
+    .coverage_size{4},
+    .window_size{4}
+}));
@@ -0,0 +1,193 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/sequence_tree/chunked_tree.hpp>
+#include <libjst/sequence_tree/coloured_tree.hpp>
+#include <libjst/sequence_tree/labelled_tree.hpp>
+#include <libjst/sequence_tree/merge_tree.hpp>
+#include <libjst/sequence_tree/prune_tree.hpp>
+#include <libjst/sequence_tree/stats.hpp>
+#include <libjst/sequence_tree/stats_estimator.hpp>
+#include <libjst/sequence_tree/trim_tree.hpp>
+#include <libjst/sequence_tree/volatile_tree.hpp>
+
+namespace jst::test::sequence_tree_stats_estimator {
+
+using source_t = std::string;
+
+struct test : public ::testing::Test {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using coverage_domain_type = libjst::coverage_domain_t<coverage_type>;
+
+    using cms_t = libjst::dna_compressed_multisequence<source_t, coverage_type>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+    using rcs_store_t = libjst::rcs_store<source_t, cms_t>;
+
+    static constexpr uint32_t branch_size{6};
+    static constexpr uint32_t haplotype_count{16};
+
+    rcs_store_t _store;
+
+    // Dense SNVs in the first half of the source and sparse deletions and insertions in the second half, which the
+    // labelled tree does not support within the branch of another indel.
+    void SetUp() override {
+        std::mt19937 generator{42};
+        source_t source{};
+        for (std::size_t idx = 0; idx < 6000; ++idx)
+            source.push_back("ACGT"[generator() % 4]);
+
+        _store = rcs_store_t{source, haplotype_count};
+        coverage_domain_type domain = _store.variants().coverage_domain();
+        auto random_coverage = [&] () {
+            std::vector<uint32_t> haplotypes{};
+            for (uint32_t haplotype = 0; haplotype < haplotype_count; ++haplotype)
+                if (generator() % 3 == 0)
+                    haplotypes.push_back(haplotype);
+            if (haplotypes.empty())
+                haplotypes.push_back(generator() % haplotype_count);
+            return coverage_type{haplotypes, domain};
+        };
+
+        for (uint32_t position = 5; position < 3000; position += 1 + generator() % 3) {
+            char snv = "ACGT"[generator() % 4];
+            if (snv == source[position])
+                snv = (snv == 'A') ? 'C' : 'A';
+            _store.add(cms_value_t{libjst::breakpoint{position, 1u}, source_t{snv}, random_coverage()});
+        }
+
+        for (uint32_t position = 3000; position < 5990; position += 3 * branch_size) {
+            if (generator() % 2 == 0)
+                _store.add(cms_value_t{libjst::breakpoint{position, 0u}, source_t{"AC"}, random_coverage()});
+            else
+                _store.add(cms_value_t{libjst::breakpoint{position, 1u + generator() % 3}, source_t{}, random_coverage()});
+        }
+    }
+
+    static auto tree_adaptor() noexcept {
+        return libjst::labelled() | libjst::coloured() | libjst::trim(branch_size) | libjst::prune() | libjst::merge();
+    }
+
+    libjst::tree_stats traversed_stats() const {
+        return libjst::stats(libjst::make_volatile(_store) | tree_adaptor());
+    }
+
+    static double relative_error(std::size_t const estimate, std::size_t const expected) noexcept {
+        return std::abs(static_cast<double>(estimate) - static_cast<double>(expected)) / static_cast<double>(expected);
+    }
+};
+
+} // namespace jst::test::sequence_tree_stats_estimator
+
+using source_t = jst::test::sequence_tree_stats_estimator::source_t;
+using sequence_tree_stats_estimator = jst::test::sequence_tree_stats_estimator::test;
+
+TEST_F(sequence_tree_stats_estimator, empty_store) {
+    rcs_store_t store{source_t{"AAAAGGGG"}, 4};
+    libjst::tree_stats estimate = libjst::stats_estimator{4}(store);
+
+    EXPECT_EQ(estimate.node_count, 1u);
+    EXPECT_EQ(estimate.subtree_count, 0u);
+    EXPECT_EQ(estimate.leaf_count, 1u);
+    EXPECT_EQ(estimate.symbol_count, 8u);
+    EXPECT_EQ(estimate.max_subtree_depth, 0u);
+    EXPECT_TRUE(estimate.subtree_depths.empty());
+}
+
+TEST_F(sequence_tree_stats_estimator, overlapping_variants) {
+    rcs_store_t store{source_t{"AAAAGGGG"}, 4};
+    coverage_domain_type domain = store.variants().coverage_domain();
+    store.add(cms_value_t{libjst::breakpoint{1u, 1u}, source_t{"C"}, coverage_type{{0, 1}, domain}});
+    store.add(cms_value_t{libjst::breakpoint{4u, 1u}, source_t{"T"}, coverage_type{{0, 2}, domain}});
+    libjst::tree_stats estimate = libjst::stats_estimator{4}(store);
+
+    EXPECT_EQ(estimate.node_count, 7u);
+    EXPECT_EQ(estimate.subtree_count, 2u);
+    EXPECT_EQ(estimate.leaf_count, 4u);
+    EXPECT_EQ(estimate.symbol_count, 8u + (5u + 2u) + 4u);
+    EXPECT_EQ(estimate.max_subtree_depth, 2u);
+    EXPECT_EQ(estimate.subtree_depths, (std::vector<std::size_t>{2, 1}));
+}
+
+TEST_F(sequence_tree_stats_estimator, exact_estimate) {
+    libjst::tree_stats expected = traversed_stats();
+    libjst::tree_stats estimate = libjst::stats_estimator{branch_size}(_store);
+
+    EXPECT_EQ(estimate.node_count, expected.node_count);
+    EXPECT_EQ(estimate.subtree_count, expected.subtree_count);
+    EXPECT_EQ(estimate.leaf_count, expected.leaf_count);
+    EXPECT_EQ(estimate.symbol_count, expected.symbol_count);
+    EXPECT_EQ(estimate.max_subtree_depth, expected.max_subtree_depth);
+    EXPECT_EQ(estimate.subtree_depths, expected.subtree_depths);
+}
+
+TEST_F(sequence_tree_stats_estimator, sampled_estimate) {
+    libjst::tree_stats expected = traversed_stats();
+    libjst::tree_stats estimate = libjst::stats_estimator{branch_size, 0.1}(_store);
+
+    EXPECT_EQ(estimate.subtree_count, expected.subtree_count);
+    EXPECT_LT(relative_error(estimate.node_count, expected.node_count), 0.1);
+    EXPECT_LT(relative_error(estimate.leaf_count, expected.leaf_count), 0.1);
+    EXPECT_LT(relative_error(estimate.symbol_count, expected.symbol_count), 0.1);
+    EXPECT_LE(estimate.max_subtree_depth, expected.max_subtree_depth);
+    EXPECT_NEAR(static_cast<double>(estimate.subtree_depths.size()),
+                static_cast<double>(expected.subtree_count) * 0.1,
+                1.0);
+}
+
+TEST_F(sequence_tree_stats_estimator, invalid_sample_rate) {
+    EXPECT_THROW(libjst::stats_estimator(branch_size, 0.0), std::invalid_argument);
+    EXPECT_THROW(libjst::stats_estimator(branch_size, 1.5), std::invalid_argument);
+    EXPECT_NO_THROW(libjst::stats_estimator(branch_size, 1.0));
+}
+
+TEST_F(sequence_tree_stats_estimator, parallel_single_chunk) {
+    libjst::tree_stats expected = traversed_stats();
+    auto forest = libjst::chunk(_store, std::ranges::size(_store.source()));
+    libjst::tree_stats actual = libjst::parallel_stats{4}(forest, tree_adaptor());
+
+    // The root of the partial tree is counted as an additional subtree.
+    EXPECT_EQ(actual.node_count, expected.node_count + 1);
+    EXPECT_EQ(actual.subtree_count, expected.subtree_count + 1);
+    EXPECT_EQ(actual.leaf_count, expected.leaf_count);
+    EXPECT_EQ(actual.symbol_count, expected.symbol_count);
+    EXPECT_EQ(actual.max_subtree_depth, expected.max_subtree_depth);
+}
+
+TEST_F(sequence_tree_stats_estimator, parallel_chunks) {
+    auto forest = libjst::chunk(_store, 500u, branch_size - 1);
+
+    // The chunks are traversed without their overlap, which is owned by the next chunk.
+    libjst::tree_stats expected{};
+    for (std::size_t chunk_idx = 0; chunk_idx < std::ranges::size(forest); ++chunk_idx)
+        expected += libjst::stats(forest.owned_chunk(chunk_idx) | tree_adaptor());
+
+    for (std::size_t thread_count : {1u, 3u, 8u}) {
+        libjst::tree_stats actual = libjst::parallel_stats{thread_count}(forest, tree_adaptor());
+
+        EXPECT_EQ(actual.node_count, expected.node_count);
+        EXPECT_EQ(actual.subtree_count, expected.subtree_count);
+        EXPECT_EQ(actual.leaf_count, expected.leaf_count);
+        EXPECT_EQ(actual.symbol_count, expected.symbol_count);
+        EXPECT_EQ(actual.max_subtree_depth, expected.max_subtree_depth);
+        EXPECT_EQ(actual.subtree_depths, expected.subtree_depths);
+    }
+
+    // The partial trees add nodes and symbols at the chunk borders.
+    EXPECT_GE(expected.symbol_count, traversed_stats().symbol_count);
+}
@@ -0,0 +1,89 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <functional>
+#include <ranges>
+#include <string>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/sequence_tree/labelled_tree.hpp>
+#include <libjst/sequence_tree/transform_tree.hpp>
+#include <libjst/sequence_tree/volatile_tree.hpp>
+
+struct transform_tree_test : public ::testing::Test {
+    using source_t = std::string;
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using cms_t = libjst::dna_compressed_multisequence<source_t, coverage_type>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+    using rcs_store_t = libjst::rcs_store<source_t, cms_t>;
+
+    rcs_store_t store{"AAAACCCCGGGGTTTT", 4};
+
+    void SetUp() override {
+        auto domain = store.variants().coverage_domain();
+        store.add(cms_value_t{libjst::breakpoint{2u, 1u}, source_t{"G"}, coverage_type{{0, 1}, domain}});
+        store.add(cms_value_t{libjst::breakpoint{9u, 2u}, source_t{}, coverage_type{{2}, domain}});
+    }
+
+    // Collects the projected labels in depth-first order, visiting the alternate child first.
+    template <typename tree_t, typename projection_t = std::identity>
+    static std::vector<std::size_t> collect(tree_t const & tree, projection_t projection = {}) {
+        using node_t = libjst::tree_node_t<tree_t>;
+        std::vector<std::size_t> labels{};
+        std::vector<node_t> path{libjst::root(tree)};
+        while (!path.empty()) {
+            node_t node = std::move(path.back());
+            path.pop_back();
+            labels.push_back(projection(*node));
+            if (auto ref_child = node.next_ref(); ref_child.has_value())
+                path.push_back(std::move(*ref_child));
+            if (auto alt_child = node.next_alt(); alt_child.has_value())
+                path.push_back(std::move(*alt_child));
+        }
+        return labels;
+    }
+};
+
+TEST_F(transform_tree_test, stateless_fn) {
+    auto labelled = libjst::volatile_tree{store} | libjst::labelled();
+    auto tree = labelled | libjst::transform([] (auto const & label) {
+        return std::ranges::size(label.sequence());
+    });
+
+    std::vector<std::size_t> const expected = collect(labelled, [] (auto const & label) {
+        return std::ranges::size(label.sequence());
+    });
+    EXPECT_GT(expected.size(), 1u);
+    EXPECT_EQ(collect(tree), expected);
+    // The node constructs the function instead of storing it.
+    EXPECT_EQ(sizeof(libjst::tree_node_t<decltype(tree)>), sizeof(libjst::tree_node_t<decltype(labelled)>));
+}
+
+TEST_F(transform_tree_test, stateful_fn) {
+    auto labelled = libjst::volatile_tree{store} | libjst::labelled();
+    std::vector<std::size_t> const weights(256, 3);
+    auto tree = labelled | libjst::transform([weights] (auto const & label) {
+        std::size_t weight{};
+        for (char const symbol : label.sequence())
+            weight += weights[static_cast<unsigned char>(symbol)];
+        return weight;
+    });
+
+    std::vector<std::size_t> const expected = collect(labelled, [] (auto const & label) {
+        return 3 * std::ranges::size(label.sequence());
+    });
+    EXPECT_EQ(collect(tree), expected);
+    // The node refers to the function of the tree instead of copying the captured table.
+    EXPECT_LE(sizeof(libjst::tree_node_t<decltype(tree)>),
+              sizeof(libjst::tree_node_t<decltype(labelled)>) + sizeof(void const *));
+}
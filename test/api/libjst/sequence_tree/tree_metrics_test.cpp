@@ -0,0 +1,167 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#define LIBJST_TREE_METRICS 1
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/sequence_tree/coloured_tree.hpp>
+#include <libjst/sequence_tree/labelled_tree.hpp>
+#include <libjst/sequence_tree/merge_tree.hpp>
+#include <libjst/sequence_tree/prune_tree.hpp>
+#include <libjst/sequence_tree/stats.hpp>
+#include <libjst/sequence_tree/tree_metrics.hpp>
+#include <libjst/sequence_tree/trim_tree.hpp>
+#include <libjst/sequence_tree/volatile_tree.hpp>
+
+namespace jst::test::tree_metrics {
+
+using source_t = std::string;
+
+struct test : public ::testing::Test {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using coverage_domain_type = libjst::coverage_domain_t<coverage_type>;
+
+    using cms_t = libjst::dna_compressed_multisequence<source_t, coverage_type>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+    using rcs_store_t = libjst::rcs_store<source_t, cms_t>;
+
+    static constexpr uint32_t branch_size{6};
+    static constexpr uint32_t haplotype_count{16};
+
+    rcs_store_t _store;
+
+    // Dense SNVs followed by sparse deletions, whose high ends are merged into the reference nodes.
+    void SetUp() override {
+        std::mt19937 generator{7};
+        source_t source{};
+        for (std::size_t idx = 0; idx < 2000; ++idx)
+            source.push_back("ACGT"[generator() % 4]);
+
+        _store = rcs_store_t{source, haplotype_count};
+        coverage_domain_type domain = _store.variants().coverage_domain();
+        auto random_coverage = [&] () {
+            std::vector<uint32_t> haplotypes{};
+            for (uint32_t haplotype = 0; haplotype < haplotype_count; ++haplotype)
+                if (generator() % 3 == 0)
+                    haplotypes.push_back(haplotype);
+            if (haplotypes.empty())
+                haplotypes.push_back(generator() % haplotype_count);
+            return coverage_type{haplotypes, domain};
+        };
+
+        for (uint32_t position = 5; position < 1000; position += 1 + generator() % 3) {
+            char snv = "ACGT"[generator() % 4];
+            if (snv == source[position])
+                snv = (snv == 'A') ? 'C' : 'A';
+            _store.add(cms_value_t{libjst::breakpoint{position, 1u}, source_t{snv}, random_coverage()});
+        }
+
+        for (uint32_t position = 1000; position < 1990; position += 3 * branch_size)
+            _store.add(cms_value_t{libjst::breakpoint{position, 2u}, source_t{}, random_coverage()});
+    }
+
+    libjst::tree_stats traversed_stats() const {
+        return libjst::stats(libjst::make_volatile(_store) | libjst::labelled()
+                                                           | libjst::coloured()
+                                                           | libjst::trim(branch_size)
+                                                           | libjst::prune()
+                                                           | libjst::merge());
+    }
+};
+
+} // namespace jst::test::tree_metrics
+
+using tree_metrics_test = jst::test::tree_metrics::test;
+
+TEST_F(tree_metrics_test, enabled) {
+    EXPECT_TRUE(libjst::tree_metrics_enabled);
+}
+
+TEST_F(tree_metrics_test, nodes_created) {
+    libjst::tree_stats stats = traversed_stats();
+    libjst::tree_metrics const & metrics = stats.metrics;
+
+    // Every node but the root is a child created by the outermost adaptor.
+    EXPECT_EQ(metrics.merge.nodes_created + 1, stats.node_count);
+
+    // The inner adaptors also create the reference children the nodes are merged with, unless the merge moves the
+    // node in place.
+    EXPECT_EQ(metrics.prune.nodes_created,
+              metrics.merge.nodes_created + metrics.merge.extend_steps - metrics.merge.ref_jumps);
+    EXPECT_EQ(metrics.trim.nodes_created, metrics.prune.nodes_created + metrics.prune.nodes_pruned);
+    EXPECT_EQ(metrics.coloured.nodes_created, metrics.trim.nodes_created);
+    EXPECT_EQ(metrics.labelled.nodes_created, metrics.coloured.nodes_created);
+}
+
+TEST_F(tree_metrics_test, pruned_and_extended) {
+    libjst::tree_metrics metrics = traversed_stats().metrics;
+
+    EXPECT_GT(metrics.trim.nodes_pruned, 0u);
+    EXPECT_GT(metrics.prune.nodes_pruned, 0u);
+    EXPECT_GT(metrics.prune.coverage_operations, 0u);
+    EXPECT_GT(metrics.merge.extend_steps, 0u);
+    EXPECT_GT(metrics.merge.ref_jumps, 0u);
+    EXPECT_LE(metrics.merge.ref_jumps, metrics.merge.extend_steps);
+    EXPECT_EQ(metrics.coloured.nodes_pruned, 0u);
+    EXPECT_EQ(metrics.merge.coverage_operations, 0u);
+}
+
+TEST_F(tree_metrics_test, label_copies) {
+    libjst::tree_metrics metrics = traversed_stats().metrics;
+
+    EXPECT_GT(metrics.labelled.label_copies, 0u);
+    EXPECT_GT(metrics.labelled.label_bytes, metrics.labelled.label_copies);
+    EXPECT_LE(metrics.labelled.label_copies, metrics.labelled.nodes_created);
+}
+
+TEST_F(tree_metrics_test, stats_are_deterministic) {
+    libjst::reset_tree_metrics();
+    libjst::tree_stats first = traversed_stats();
+    libjst::tree_stats second = traversed_stats();
+
+    EXPECT_EQ(first.metrics, second.metrics);
+
+    // The traversals are added to the metrics of the thread.
+    libjst::tree_metrics expected = first.metrics;
+    expected += second.metrics;
+    EXPECT_EQ(libjst::thread_tree_metrics(), expected);
+    EXPECT_EQ(libjst::reset_tree_metrics(), expected);
+    EXPECT_EQ(libjst::thread_tree_metrics(), libjst::tree_metrics{});
+}
+
+TEST_F(tree_metrics_test, per_thread) {
+    libjst::reset_tree_metrics();
+    libjst::tree_stats stats{};
+    std::thread worker{[&] () {
+        stats = traversed_stats();
+        EXPECT_EQ(libjst::thread_tree_metrics(), stats.metrics);
+    }};
+    worker.join();
+
+    EXPECT_NE(stats.metrics, libjst::tree_metrics{});
+    EXPECT_EQ(libjst::thread_tree_metrics(), libjst::tree_metrics{});
+}
+
+TEST_F(tree_metrics_test, accumulate_stats) {
+    libjst::tree_stats stats = traversed_stats();
+    libjst::tree_stats accumulated{};
+    accumulated += stats;
+    accumulated += stats;
+
+    EXPECT_EQ(accumulated.metrics.merge.nodes_created, 2 * stats.metrics.merge.nodes_created);
+    EXPECT_EQ(accumulated.metrics.labelled.label_bytes, 2 * stats.metrics.labelled.label_bytes);
+}
@@ -134,6 +134,26 @@ TEST_P(trimmed_tree_test, root_sink) {
         EXPECT_EQ(to_string(GetParam().expected_labels[i]), actual_labels[i]) << i;
 }
 
+TEST_P(trimmed_tree_test, ordered_boundaries) {
+    auto tree = make_tree();
+
+    using node_t = libjst::tree_node_t<decltype(tree)>;
+
+    std::stack<node_t> path{};
+    path.push(libjst::root(tree));
+    while (!path.empty()) {
+        node_t p = std::move(path.top());
+        path.pop();
+        // The label of a node ends at its trimmed high boundary, also if an insertion exceeds the branch.
+        EXPECT_LE(libjst::position(p.low_boundary()), libjst::position(p.high_boundary()));
+
+        if (auto c_ref = p.next_ref(); c_ref.has_value())
+            path.push(std::move(*c_ref));
+        if (auto c_alt = p.next_alt(); c_alt.has_value())
+            path.push(std::move(*c_alt));
+    }
+}
+
 // ----------------------------------------------------------------------------
 // Test values
 // ----------------------------------------------------------------------------
@@ -210,3 +230,17 @@ INSTANTIATE_TEST_SUITE_P(snv4_snv4, trimmed_tree_test, testing::Values(fixture{
                                   ""s, "T"s, "GGG"s,
                                   "GGGG"s}
 }));
+
+INSTANTIATE_TEST_SUITE_P(snv8_ins9_exceeding_branch, trimmed_tree_test, testing::Values(fixture{
+    .source{"AAAAAAAAGGGGGGGG"s},
+    .trim_size{2},
+    .variants{
+        variant_t{.position{8}, .insertion{"C"s}, .deletion{1}, .coverage{0}},
+        variant_t{.position{9}, .insertion{"TTTTTT"s}, .deletion{0}, .coverage{0, 1}}
+    },
+    // The insertion exceeds the branch and its label ends empty at the trimmed high boundary; its symbols within the
+    // branch are reached by the left extension of the label, see left_extended_trimmed_merged_tree_test.
+    .expected_labels{"AAAAAAAA"s, "C"s, ""s, ""s, "GG"s,
+                                  "G"s, ""s, "GG"s,
+                                        "GGGGGGG"s}
+}));
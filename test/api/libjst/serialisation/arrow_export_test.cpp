@@ -0,0 +1,252 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <ranges>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/sequence_tree/seek_position_codec.hpp>
+#include <libjst/serialisation/arrow_export.hpp>
+#include <libjst/traversal/hit_buffer.hpp>
+
+namespace jst::test::arrow_export {
+
+using source_t = std::string;
+
+struct test : public ::testing::Test {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using coverage_domain_type = libjst::coverage_domain_t<coverage_type>;
+
+    using cms_t = libjst::dna_compressed_multisequence<source_t, coverage_type>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+    using rcs_store_t = libjst::rcs_store<source_t, cms_t>;
+    using batch_type = libjst::hit_buffer<coverage_type>::batch_type;
+
+    static constexpr uint32_t haplotype_count{70};
+
+    rcs_store_t _store;
+
+    // SNVs, insertions and deletions.
+    void SetUp() override {
+        std::mt19937 generator{42};
+        source_t source{};
+        for (std::size_t idx = 0; idx < 600; ++idx)
+            source.push_back("ACGT"[generator() % 4]);
+
+        _store = rcs_store_t{source, haplotype_count};
+        coverage_domain_type domain = _store.variants().coverage_domain();
+        for (uint32_t position = 2; position + 4 < source.size(); position += 3) {
+            std::vector<uint32_t> haplotypes{};
+            for (uint32_t haplotype = 0; haplotype < haplotype_count; ++haplotype)
+                if (generator() % 3 == 0)
+                    haplotypes.push_back(haplotype);
+
+            libjst::breakpoint breakpoint{position, 1u};
+            source_t alt{};
+            switch (position % 4) {
+                case 0: alt.push_back((source[position] == 'A') ? 'C' : 'A'); break;
+                case 1: breakpoint = libjst::breakpoint{position, 0u}; alt = "GTA"; break;
+                case 2: breakpoint = libjst::breakpoint{position, 0u}; alt = "GTAC"; break;
+                default: breakpoint = libjst::breakpoint{position, 2u}; break;
+            }
+            _store.add(cms_value_t{breakpoint, alt, coverage_type{haplotypes, domain}});
+        }
+    }
+
+    batch_type make_batch() const {
+        coverage_domain_type domain{0, haplotype_count};
+        batch_type batch{};
+        for (std::size_t hit = 0; hit < 10; ++hit) {
+            libjst::seek_position position{};
+            position.reset(hit / 3, libjst::breakpoint_end::low);
+            if (hit % 4 == 1) { // an alternate path spanning several words
+                position.initiate_alternate_node(hit / 3);
+                for (std::size_t step = 0; step < 70 * hit; ++step)
+                    position.next_alternate_node(step % 3 == 0);
+            }
+            if (hit % 3 == 0)
+                batch.coverages.emplace_back(std::vector<uint32_t>{static_cast<uint32_t>(hit), 65u}, domain);
+            batch.positions.push_back(position);
+            batch.offsets.push_back(hit * 2);
+            batch.coverage_ids.push_back(static_cast<uint32_t>(batch.coverages.size() - 1));
+        }
+        return batch;
+    }
+
+    template <typename value_t>
+    static value_t const * buffer(ArrowArray const & array, std::size_t const idx) {
+        return static_cast<value_t const *>(array.buffers[idx]);
+    }
+
+    static libjst::seek_position position_value(ArrowArray const & array, std::size_t const row) {
+        auto offsets = buffer<int64_t>(array, 1);
+        std::span<std::byte const> bytes{buffer<std::byte>(array, 2) + offsets[row],
+                                         static_cast<std::size_t>(offsets[row + 1] - offsets[row])};
+        libjst::seek_position position{};
+        EXPECT_EQ(libjst::seek_position_codec::decode(bytes, position), bytes.size());
+        return position;
+    }
+
+    static std::string_view string_value(ArrowArray const & array, std::size_t const row) {
+        auto offsets = buffer<int32_t>(array, 1);
+        return std::string_view{buffer<char>(array, 2) + offsets[row], buffer<char>(array, 2) + offsets[row + 1]};
+    }
+};
+
+} // namespace jst::test::arrow_export
+
+using namespace std::literals;
+
+struct arrow_export_test : public jst::test::arrow_export::test
+{};
+
+// ----------------------------------------------------------------------------
+// Test case definitions
+// ----------------------------------------------------------------------------
+
+TEST_F(arrow_export_test, hits) {
+    batch_type batch = make_batch();
+    batch_type const expected = batch;
+    void const * const offsets = batch.offsets.data();
+
+    ArrowSchema schema{};
+    ArrowArray array{};
+    libjst::export_arrow_hits(std::move(batch), &schema, &array);
+
+    EXPECT_EQ(schema.format, "+s"sv);
+    ASSERT_EQ(schema.n_children, 4);
+    EXPECT_EQ(schema.children[0]->name, "seek_position"sv);
+    EXPECT_EQ(schema.children[0]->format, "Z"sv);
+    EXPECT_EQ(schema.children[1]->name, "variant_index"sv);
+    EXPECT_EQ(schema.children[1]->format, "L"sv);
+    EXPECT_EQ(schema.children[2]->name, "offset"sv);
+    EXPECT_EQ(schema.children[2]->format, "L"sv);
+    EXPECT_EQ(schema.children[3]->name, "coverage"sv);
+    EXPECT_EQ(schema.children[3]->format, "I"sv);
+    ASSERT_NE(schema.children[3]->dictionary, nullptr);
+    EXPECT_EQ(schema.children[3]->dictionary->format, "w:16"sv);
+
+    ASSERT_EQ(array.length, 10);
+    ASSERT_EQ(array.n_children, 4);
+    EXPECT_EQ(array.null_count, 0);
+
+    // The offsets are not copied.
+    EXPECT_EQ(array.children[2]->buffers[1], offsets);
+
+    ArrowArray const & coverage = *array.children[3];
+    ASSERT_NE(coverage.dictionary, nullptr);
+    EXPECT_EQ(coverage.dictionary->length, 4);
+    for (std::size_t hit = 0; hit < 10; ++hit) {
+        EXPECT_EQ(position_value(*array.children[0], hit), expected.positions[hit]);
+        EXPECT_EQ(buffer<uint64_t>(*array.children[1], 1)[hit], hit / 3);
+        EXPECT_EQ(buffer<uint64_t>(*array.children[2], 1)[hit], hit * 2);
+
+        uint32_t const coverage_id = buffer<uint32_t>(coverage, 1)[hit];
+        EXPECT_EQ(coverage_id, expected.coverage_ids[hit]);
+        auto bitmap = buffer<uint8_t>(*coverage.dictionary, 1) + coverage_id * 16;
+        for (uint32_t haplotype = 0; haplotype < haplotype_count; ++haplotype)
+            EXPECT_EQ(static_cast<bool>(bitmap[haplotype / 8] & (1u << (haplotype % 8))),
+                      libjst::covers(expected.coverage(hit), haplotype)) << hit << " " << haplotype;
+    }
+
+    schema.release(&schema);
+    array.release(&array);
+    EXPECT_EQ(schema.release, nullptr);
+    EXPECT_EQ(array.release, nullptr);
+}
+
+TEST_F(arrow_export_test, moved_child) {
+    ArrowSchema schema{};
+    ArrowArray array{};
+    libjst::export_arrow_hits(make_batch(), &schema, &array);
+
+    // A child moved out by the consumer outlives its parent.
+    ArrowArray offsets = *array.children[2];
+    array.children[2]->release = nullptr;
+    array.release(&array);
+    schema.release(&schema);
+
+    ASSERT_NE(offsets.release, nullptr);
+    EXPECT_EQ(offsets.length, 10);
+    EXPECT_EQ(buffer<uint64_t>(offsets, 1)[9], 18u);
+    offsets.release(&offsets);
+    EXPECT_EQ(offsets.release, nullptr);
+}
+
+TEST_F(arrow_export_test, empty_hits) {
+    ArrowSchema schema{};
+    ArrowArray array{};
+    libjst::export_arrow_hits(batch_type{}, &schema, &array);
+    EXPECT_EQ(array.length, 0);
+    EXPECT_EQ(array.children[3]->dictionary->length, 0);
+    schema.release(&schema);
+    array.release(&array);
+}
+
+TEST_F(arrow_export_test, variants) {
+    // The expected rows in the stored order of the low breakends.
+    std::vector<std::tuple<uint64_t, libjst::alternate_sequence_kind, std::string, uint32_t>> expected{};
+    auto const & variants = _store.variants();
+    for (auto it = std::ranges::next(variants.begin()); it != std::ranges::prev(variants.end()); ++it) {
+        auto && variant = *it;
+        if (variant.get_breakpoint_end() == libjst::breakpoint_end::high)
+            continue;
+
+        auto && alt = libjst::alt_sequence(variant);
+        auto && coverage = libjst::coverage(variant);
+        expected.emplace_back(libjst::position(variant), libjst::alt_kind(variant),
+                              std::string{std::ranges::begin(alt), std::ranges::end(alt)},
+                              libjst::coverage_intersection_count(coverage, coverage));
+    }
+    ASSERT_FALSE(expected.empty());
+
+    for (std::size_t const thread_count : {1u, 3u, 1000u}) {
+        ArrowSchema schema{};
+        ArrowArray array{};
+        libjst::export_arrow_variants(variants, &schema, &array, thread_count);
+
+        ASSERT_EQ(schema.n_children, 4);
+        EXPECT_EQ(schema.children[0]->name, "position"sv);
+        EXPECT_EQ(schema.children[1]->name, "kind"sv);
+        EXPECT_EQ(schema.children[1]->format, "c"sv);
+        EXPECT_EQ(schema.children[1]->dictionary->format, "u"sv);
+        EXPECT_EQ(schema.children[2]->name, "alt_sequence"sv);
+        EXPECT_EQ(schema.children[2]->format, "U"sv);
+        EXPECT_EQ(schema.children[3]->name, "carrier_count"sv);
+
+        ASSERT_EQ(array.length, static_cast<int64_t>(expected.size())) << thread_count;
+        ArrowArray const & kinds = *array.children[1];
+        EXPECT_EQ(string_value(*kinds.dictionary, 0), "insertion"sv);
+        EXPECT_EQ(string_value(*kinds.dictionary, 1), "replacement"sv);
+        EXPECT_EQ(string_value(*kinds.dictionary, 2), "deletion"sv);
+
+        ArrowArray const & alts = *array.children[2];
+        for (std::size_t row = 0; row < expected.size(); ++row) {
+            auto const & [position, kind, alt, carrier_count] = expected[row];
+            EXPECT_EQ(buffer<uint64_t>(*array.children[0], 1)[row], position) << row;
+            EXPECT_EQ(buffer<int8_t>(kinds, 1)[row], static_cast<int8_t>(kind)) << row;
+            auto alt_offsets = buffer<int64_t>(alts, 1);
+            EXPECT_EQ(std::string(buffer<char>(alts, 2) + alt_offsets[row], buffer<char>(alts, 2) + alt_offsets[row + 1]),
+                      alt) << row;
+            EXPECT_EQ(buffer<uint32_t>(*array.children[3], 1)[row], carrier_count) << row;
+        }
+
+        schema.release(&schema);
+        array.release(&array);
+    }
+}
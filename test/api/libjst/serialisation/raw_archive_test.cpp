@@ -0,0 +1,182 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <random>
+#include <ranges>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/coverage/bit_coverage_pool.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/serialisation/raw_archive.hpp>
+
+namespace jst::test::raw_archive {
+
+using source_t = std::string;
+
+struct test : public ::testing::Test {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using coverage_domain_type = libjst::coverage_domain_t<coverage_type>;
+
+    using cms_t = libjst::dna_compressed_multisequence<source_t, coverage_type>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+    using rcs_store_t = libjst::rcs_store<source_t, cms_t>;
+
+    static constexpr uint32_t haplotype_count{70};
+
+    rcs_store_t _store;
+
+    // SNVs, insertions and deletions, some of them at the same position.
+    void SetUp() override {
+        std::mt19937 generator{42};
+        source_t source{};
+        for (std::size_t idx = 0; idx < 600; ++idx)
+            source.push_back("ACGTN"[generator() % 5]);
+
+        _store = rcs_store_t{source, haplotype_count};
+        coverage_domain_type domain = _store.variants().coverage_domain();
+        for (uint32_t position = 2; position + 4 < source.size(); position += 3) {
+            std::vector<uint32_t> haplotypes{};
+            for (uint32_t haplotype = 0; haplotype < haplotype_count; ++haplotype)
+                if (generator() % 3 == 0)
+                    haplotypes.push_back(haplotype);
+
+            libjst::breakpoint breakpoint{position, 1u};
+            source_t alt{};
+            switch (position % 4) {
+                case 0: alt.push_back((source[position] == 'A') ? 'C' : 'A'); break;
+                case 1: breakpoint = libjst::breakpoint{position, 0u}; alt = "GTA"; break;
+                case 2: breakpoint = libjst::breakpoint{position, 0u}; alt = "GTAC"; break;
+                default: breakpoint = libjst::breakpoint{position, 2u}; break;
+            }
+            _store.add(cms_value_t{breakpoint, alt, coverage_type{haplotypes, domain}});
+        }
+    }
+
+    std::string save_store() const {
+        std::stringstream stream{};
+        libjst::raw_binary_output_archive oarchive{stream};
+        libjst::save(_store, oarchive);
+        oarchive.finish();
+        return stream.str();
+    }
+
+    static rcs_store_t load_store(std::string const & buffer) {
+        std::stringstream stream{buffer};
+        rcs_store_t store{};
+        libjst::raw_binary_input_archive iarchive{stream};
+        libjst::load(store, iarchive);
+        iarchive.finish();
+        return store;
+    }
+
+    void expect_equal_store(rcs_store_t const & store) const {
+        EXPECT_TRUE(std::ranges::equal(store.source(), _store.source()));
+        EXPECT_EQ(store.size(), _store.size());
+        ASSERT_EQ(std::ranges::distance(store.variants()), std::ranges::distance(_store.variants()));
+
+        auto it = store.variants().begin();
+        for (auto && expected : _store.variants()) {
+            auto && actual = *it;
+            EXPECT_EQ(libjst::get_breakpoint(actual), libjst::get_breakpoint(expected));
+            EXPECT_EQ(actual.get_breakpoint_end(), expected.get_breakpoint_end());
+            EXPECT_TRUE(std::ranges::equal(libjst::alt_sequence(actual), libjst::alt_sequence(expected)));
+            EXPECT_EQ(libjst::coverage(actual), libjst::coverage(expected));
+            ++it;
+        }
+    }
+};
+
+} // namespace jst::test::raw_archive
+
+using raw_archive_test = jst::test::raw_archive::test;
+
+// ----------------------------------------------------------------------------
+// Test case definitions
+// ----------------------------------------------------------------------------
+
+TEST_F(raw_archive_test, round_trip_store) {
+    expect_equal_store(load_store(save_store()));
+}
+
+TEST_F(raw_archive_test, round_trip_values) {
+    std::vector<uint16_t> const numbers{1, 2, 3, 65535};
+    std::vector<std::string> const words{"", "raw", "archive"};
+    std::pair<int32_t, double> const pair{-7, 0.5};
+    std::array<uint8_t, 3> const bytes{4, 5, 6};
+
+    std::stringstream stream{};
+    {
+        libjst::raw_binary_output_archive oarchive{stream};
+        oarchive(numbers, words, pair, bytes);
+    } // the destructor finishes the archive
+
+    std::vector<uint16_t> loaded_numbers{9};
+    std::vector<std::string> loaded_words{};
+    std::pair<int32_t, double> loaded_pair{};
+    std::array<uint8_t, 3> loaded_bytes{};
+    libjst::raw_binary_input_archive iarchive{stream};
+    iarchive(loaded_numbers, loaded_words, loaded_pair, loaded_bytes);
+    EXPECT_NO_THROW(iarchive.finish());
+
+    EXPECT_EQ(loaded_numbers, numbers);
+    EXPECT_EQ(loaded_words, words);
+    EXPECT_EQ(loaded_pair, pair);
+    EXPECT_EQ(loaded_bytes, bytes);
+}
+
+TEST_F(raw_archive_test, round_trip_coverage_pool) {
+    coverage_domain_type domain = _store.variants().coverage_domain();
+    libjst::bit_coverage_pool<uint32_t> pool{domain};
+    for (auto && variant : _store.variants())
+        pool.insert(pool.end(), coverage_type{libjst::coverage(variant)});
+
+    std::stringstream stream{};
+    {
+        libjst::raw_binary_output_archive oarchive{stream};
+        libjst::save(pool, oarchive);
+    }
+
+    libjst::bit_coverage_pool<uint32_t> loaded_pool{};
+    {
+        libjst::raw_binary_input_archive iarchive{stream};
+        libjst::load(loaded_pool, iarchive);
+        iarchive.finish();
+    }
+
+    ASSERT_EQ(loaded_pool.size(), pool.size());
+    for (std::size_t idx = 0; idx < pool.size(); ++idx)
+        EXPECT_TRUE(std::ranges::equal(loaded_pool[idx].words(), pool[idx].words()));
+}
+
+TEST_F(raw_archive_test, corrupted_archive) {
+    std::string buffer = save_store();
+    buffer[buffer.size() / 2] ^= 0x10;
+    EXPECT_THROW(load_store(buffer), std::runtime_error);
+}
+
+TEST_F(raw_archive_test, truncated_archive) {
+    std::string const buffer = save_store();
+    EXPECT_THROW(load_store(buffer.substr(0, buffer.size() - 1)), std::runtime_error);
+    EXPECT_THROW(load_store(buffer.substr(0, 10)), std::runtime_error);
+}
+
+TEST_F(raw_archive_test, invalid_header) {
+    std::string buffer = save_store();
+    buffer[0] = 'X';
+    EXPECT_THROW(load_store(buffer), std::runtime_error);
+    EXPECT_THROW(load_store(std::string{}), std::runtime_error);
+}
@@ -0,0 +1,220 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/sequence_tree/volatile_tree.hpp>
+#include <libjst/traversal/async_stages.hpp>
+#include <libjst/traversal/shard_planner.hpp>
+#include <libjst/traversal/state_oblivious_traverser.hpp>
+
+namespace jst::test::async_stages {
+
+using source_t = std::string;
+
+struct naive_matcher {
+    source_t needle{};
+
+    constexpr std::size_t window_size() const noexcept {
+        return needle.size();
+    }
+
+    template <typename haystack_t, typename callback_t>
+    constexpr void operator()(haystack_t && haystack, callback_t && callback) const {
+        auto it = std::ranges::begin(haystack);
+        auto last = std::ranges::end(haystack);
+        for (; std::ranges::distance(it, last) >= std::ranges::ssize(needle); ++it) {
+            if (std::ranges::equal(std::ranges::subrange{it, std::ranges::next(it, needle.size())}, needle))
+                callback(it);
+        }
+    }
+};
+
+// Counts the hits and the number of flushes.
+struct counting_sink {
+    std::atomic<std::size_t> hit_count{};
+    std::size_t flush_count{};
+
+    void flush() {
+        ++flush_count;
+    }
+};
+
+struct test : public ::testing::Test {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using coverage_domain_type = libjst::coverage_domain_t<coverage_type>;
+    using cms_t = libjst::dna_compressed_multisequence<source_t, coverage_type>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+    using rcs_store_t = libjst::rcs_store<source_t, cms_t>;
+
+    static constexpr uint32_t haplotype_count{8};
+
+    rcs_store_t _store;
+
+    void SetUp() override {
+        std::mt19937 random_engine{17};
+        source_t source(4000, 'A');
+        std::ranges::generate(source, [&] { return "ACGT"[random_engine() % 4]; });
+        _store = rcs_store_t{source, haplotype_count};
+        coverage_domain_type domain = _store.variants().coverage_domain();
+        for (uint32_t position = 10; position < source.size() - 10; position += 19) {
+            char const alt = (source[position] == 'A') ? 'C' : 'A';
+            _store.add(cms_value_t{libjst::breakpoint{position, 1}, source_t{alt},
+                                   coverage_type{{position % haplotype_count}, domain}});
+        }
+    }
+};
+
+} // namespace jst::test::async_stages
+
+using namespace std::literals;
+
+using async_stages_test = jst::test::async_stages::test;
+using jst::test::async_stages::counting_sink;
+using jst::test::async_stages::naive_matcher;
+
+TEST_F(async_stages_test, traverse_chunks_and_flush) {
+    std::size_t expected_hits{};
+    libjst::state_oblivious_traverser{}(libjst::volatile_tree{_store}, naive_matcher{"ACGTA"s}, [&] (auto &&, auto &&) {
+        ++expected_hits;
+    });
+    ASSERT_GT(expected_hits, 0u);
+
+    libjst::static_thread_pool pool{4};
+    std::vector<libjst::tree_shard> const shards = libjst::shard_planner{5}(_store, 8);
+    counting_sink sink{};
+    auto search = [&] () -> libjst::task<void> {
+        co_await libjst::async_traverse_chunks(pool, shards, [&] (libjst::tree_shard const & shard) {
+            libjst::state_oblivious_traverser{}(shard.make_tree(_store), naive_matcher{"ACGTA"s},
+                                                [&] (auto &&, auto &&) { ++sink.hit_count; });
+        });
+        co_await libjst::async_flush(pool, sink);
+    };
+    libjst::sync_wait(search());
+
+    EXPECT_EQ(sink.hit_count.load(), expected_hits);
+    EXPECT_EQ(sink.flush_count, 1u);
+}
+
+TEST_F(async_stages_test, invoke_and_load_region) {
+    libjst::static_thread_pool pool{2};
+    EXPECT_EQ(libjst::sync_wait(libjst::async_invoke(pool, [] (int lhs, int rhs) { return lhs + rhs; }, 3, 4)), 7);
+
+    auto loaded = libjst::sync_wait(libjst::async_load_region(pool, [] (std::size_t const size) {
+        return std::vector<int>(size, 1);
+    }, std::size_t{5}));
+    ASSERT_NE(loaded, nullptr);
+    EXPECT_EQ(loaded->size(), 5u);
+}
+
+TEST_F(async_stages_test, region_pipeline_order) {
+    libjst::static_thread_pool pool{3};
+    std::vector<std::size_t> const regions{0, 1, 2, 3, 4, 5};
+    std::mutex mutex{};
+    std::vector<std::size_t> processed{};
+    std::atomic<std::size_t> alive{};
+    std::atomic<std::size_t> max_alive{};
+
+    struct loaded_region {
+        std::size_t id;
+        std::atomic<std::size_t> & alive;
+
+        loaded_region(std::size_t const id, std::atomic<std::size_t> & alive) : id{id}, alive{alive} {
+            ++alive;
+        }
+        loaded_region(loaded_region const &) = delete;
+        ~loaded_region() {
+            --alive;
+        }
+    };
+
+    libjst::sync_wait(libjst::async_region_pipeline(pool, regions,
+        [&] (std::size_t const region) { return loaded_region{region, alive}; },
+        [&] (std::size_t const region, loaded_region & loaded) {
+            EXPECT_EQ(region, loaded.id);
+            std::size_t observed = alive.load();
+            std::size_t expected = max_alive.load();
+            while (observed > expected && !max_alive.compare_exchange_weak(expected, observed))
+            {}
+            std::scoped_lock lock{mutex};
+            processed.push_back(region);
+        }));
+
+    EXPECT_EQ(processed, regions);
+    EXPECT_EQ(alive.load(), 0u);
+    EXPECT_LE(max_alive.load(), 2u);
+}
+
+TEST_F(async_stages_test, region_pipeline_overlaps_load) {
+    libjst::static_thread_pool pool{2};
+    std::vector<std::size_t> const regions{0, 1};
+    std::mutex mutex{};
+    std::condition_variable condition{};
+    bool second_loaded{false};
+    bool overlapped{false};
+
+    libjst::sync_wait(libjst::async_region_pipeline(pool, regions,
+        [&] (std::size_t const region) {
+            if (region == 1) {
+                std::scoped_lock lock{mutex};
+                second_loaded = true;
+                condition.notify_all();
+            }
+            return region;
+        },
+        [&] (std::size_t const region, std::size_t &) {
+            if (region == 0) { // the second region is loaded while the first is processed.
+                std::unique_lock lock{mutex};
+                overlapped = condition.wait_for(lock, 10s, [&] { return second_loaded; });
+            }
+        }));
+    EXPECT_TRUE(overlapped);
+}
+
+TEST_F(async_stages_test, region_pipeline_error) {
+    libjst::static_thread_pool pool{2};
+    std::vector<std::size_t> const regions{0, 1, 2, 3};
+    std::vector<std::size_t> processed{};
+    auto pipeline = libjst::async_region_pipeline(pool, regions,
+        [&] (std::size_t const region) {
+            if (region == 2)
+                throw std::runtime_error{"load failed"};
+            return region;
+        },
+        [&] (std::size_t const region, std::size_t &) { processed.push_back(region); });
+    EXPECT_THROW(libjst::sync_wait(std::move(pipeline)), std::runtime_error);
+    EXPECT_EQ(processed, (std::vector<std::size_t>{0, 1}));
+}
+
+TEST_F(async_stages_test, region_pipeline_awaits_processing_task) {
+    libjst::static_thread_pool pool{4};
+    std::vector<libjst::tree_shard> const shards = libjst::shard_planner{5}(_store, 4);
+    std::vector<std::size_t> const regions{0, 1};
+    std::atomic<std::size_t> traversed{};
+
+    libjst::sync_wait(libjst::async_region_pipeline(pool, regions,
+        [&] (std::size_t const region) { return region; },
+        [&] (std::size_t const, std::size_t &) {
+            return libjst::async_traverse_chunks(pool, shards, [&] (libjst::tree_shard const &) { ++traversed; });
+        }));
+    EXPECT_EQ(traversed.load(), 2 * shards.size());
+}
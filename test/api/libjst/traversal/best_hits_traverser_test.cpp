@@ -0,0 +1,200 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <ranges>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/matcher/blocked_myers_matcher.hpp>
+#include <libjst/matcher/myers_matcher.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/sequence_tree/volatile_tree.hpp>
+#include <libjst/traversal/best_hits_traverser.hpp>
+#include <libjst/traversal/state_capture_traverser.hpp>
+
+namespace jst::test::best_hits_traverser {
+
+using source_t = std::string;
+
+struct variant {
+    uint32_t position{};
+    source_t insertion{};
+    uint32_t deletion{};
+    std::vector<uint32_t> coverage{};
+};
+
+struct fixture {
+    source_t source{};
+    std::vector<variant> variants{};
+    uint32_t coverage_size{};
+    std::vector<source_t> needles{};
+    std::size_t max_errors{};
+
+    template <typename stream_t, typename this_t>
+        requires std::same_as<std::remove_cvref_t<this_t>, fixture>
+    friend stream_t & operator<<(stream_t & stream, this_t &&) {
+        stream << "fixture";
+        return stream;
+    }
+};
+
+struct test : public ::testing::TestWithParam<fixture> {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using cms_t = libjst::dna_compressed_multisequence<source_t, coverage_type>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+    using rcs_store_t = libjst::rcs_store<source_t, cms_t>;
+    using hit_type = std::pair<source_t, std::size_t>;
+    rcs_store_t _store;
+
+    void SetUp() override {
+        _store = rcs_store_t{GetParam().source, GetParam().coverage_size};
+        auto domain = _store.variants().coverage_domain();
+        for (variant const & var : GetParam().variants)
+            _store.add(cms_value_t{libjst::breakpoint{var.position, var.deletion},
+                                   var.insertion,
+                                   coverage_type{var.coverage, domain}});
+    }
+
+    // Returns the prefix of the label up to every hit together with its score.
+    template <typename matcher_t>
+    std::vector<hit_type> all_hits(matcher_t matcher) const {
+        std::vector<hit_type> found{};
+        libjst::state_capture_traverser{}(libjst::volatile_tree{_store}, matcher, [&] (auto && label_it,
+                                                                                      auto && label) {
+            auto && sequence = label.sequence();
+            found.emplace_back(source_t{std::ranges::begin(sequence), std::ranges::next(label_it)}, matcher.score());
+        });
+        return found;
+    }
+
+    template <typename matcher_t>
+    std::vector<hit_type> best_hits(std::size_t const hit_count, matcher_t matcher) const {
+        std::vector<hit_type> found{};
+        libjst::best_hits_traverser{hit_count}(libjst::volatile_tree{_store}, std::move(matcher),
+                                               [&] (auto && label_it, auto && label, std::size_t const score) {
+            auto && sequence = label.sequence();
+            found.emplace_back(source_t{std::ranges::begin(sequence), std::ranges::next(label_it)}, score);
+        });
+        return found;
+    }
+
+    static std::size_t min_score(std::vector<hit_type> const & hits) {
+        return std::ranges::min(hits | std::views::values);
+    }
+
+    template <typename matcher_t>
+    void check(matcher_t const & matcher) const {
+        std::vector<hit_type> const expected = all_hits(matcher);
+        std::set<hit_type> const expected_set{expected.begin(), expected.end()};
+        for (std::size_t const hit_count : {1, 2, 5}) {
+            std::vector<hit_type> const found = best_hits(hit_count, matcher);
+            ASSERT_EQ(found.empty(), expected.empty()) << hit_count;
+            if (found.empty())
+                continue;
+
+            EXPECT_EQ(min_score(found), min_score(expected)) << hit_count;
+            EXPECT_LE(found.size(), expected.size()) << hit_count;
+            for (hit_type const & hit : found)
+                EXPECT_TRUE(expected_set.contains(hit)) << hit_count << " " << hit.first << " " << hit.second;
+        }
+
+        // Without a full set of best hits nothing is pruned.
+        std::vector<hit_type> found = best_hits(expected.size() + 1, matcher);
+        std::vector<hit_type> sorted_expected = expected;
+        std::ranges::sort(found);
+        std::ranges::sort(sorted_expected);
+        EXPECT_EQ(found, sorted_expected);
+    }
+};
+
+} // namespace jst::test::best_hits_traverser
+
+using namespace std::literals;
+
+using fixture = jst::test::best_hits_traverser::fixture;
+using variant = jst::test::best_hits_traverser::variant;
+using source_t = jst::test::best_hits_traverser::source_t;
+
+struct best_hits_traverser_test : public jst::test::best_hits_traverser::test
+{};
+
+// ----------------------------------------------------------------------------
+// Test case definitions
+// ----------------------------------------------------------------------------
+
+TEST_P(best_hits_traverser_test, myers) {
+    for (source_t const & needle : GetParam().needles)
+        check(libjst::myers_matcher{needle, GetParam().max_errors});
+}
+
+TEST_P(best_hits_traverser_test, blocked_myers) {
+    for (source_t const & needle : GetParam().needles)
+        check(libjst::blocked_myers_matcher{needle, GetParam().max_errors});
+}
+
+TEST(best_hits_traverser_bound, lower_bound) {
+    libjst::myers_matcher matcher{"ACGT"s, 2};
+    libjst::blocked_myers_matcher blocked_matcher{"ACGT"s, 2};
+    EXPECT_EQ(matcher.lower_bound(), 1u);
+    EXPECT_EQ(blocked_matcher.lower_bound(), 1u);
+
+    auto ignore = [] (auto &&) {};
+    matcher("AC"s, ignore);
+    blocked_matcher("AC"s, ignore);
+    EXPECT_EQ(matcher.lower_bound(), 0u); // the prefix "AC" matches
+    EXPECT_EQ(blocked_matcher.lower_bound(), 0u);
+
+    matcher("TTTT"s, ignore);
+    blocked_matcher("TTTT"s, ignore);
+    EXPECT_GE(matcher.lower_bound(), 1u);
+    EXPECT_EQ(blocked_matcher.lower_bound(), matcher.lower_bound());
+}
+
+// ----------------------------------------------------------------------------
+// Test values
+// ----------------------------------------------------------------------------
+
+INSTANTIATE_TEST_SUITE_P(no_variant, best_hits_traverser_test, testing::Values(fixture{
+    .source{"AAAAGGGGAAAAGGGG"s},
+    .variants{},
+    .coverage_size{2},
+    .needles{"AAGG"s, "AGAG"s},
+    .max_errors{1}
+}));
+
+INSTANTIATE_TEST_SUITE_P(snvs, best_hits_traverser_test, testing::Values(fixture{
+         //  0123456789012345
+    .source{"AAAAGGGGAAAAGGGG"s},
+    .variants{variant{.position{1}, .insertion{"G"s}, .deletion{1}, .coverage{0, 1}},
+              variant{.position{6}, .insertion{"A"s}, .deletion{1}, .coverage{0, 2}},
+              variant{.position{11}, .insertion{"G"s}, .deletion{1}, .coverage{3}}},
+    .coverage_size{4},
+    .needles{"AG"s, "GAGA"s, "AAGG"s, "GTAGG"s},
+    .max_errors{1}
+}));
+
+INSTANTIATE_TEST_SUITE_P(dense_snvs, best_hits_traverser_test, testing::Values(fixture{
+         //  0123456789012345678901234567890
+    .source{"ACGTACGTACGTACGTACGTACGTACGTACG"s},
+    .variants{variant{.position{3}, .insertion{"A"s}, .deletion{1}, .coverage{0}},
+              variant{.position{4}, .insertion{"T"s}, .deletion{1}, .coverage{1}},
+              variant{.position{5}, .insertion{"G"s}, .deletion{1}, .coverage{2}},
+              variant{.position{6}, .insertion{"C"s}, .deletion{1}, .coverage{3}},
+              variant{.position{7}, .insertion{"A"s}, .deletion{1}, .coverage{4}},
+              variant{.position{20}, .insertion{"T"s}, .deletion{1}, .coverage{0, 4}}},
+    .coverage_size{5},
+    .needles{"ACGT"s, "GTACTTAC"s, "TATGCAA"s},
+    .max_errors{2}
+}));
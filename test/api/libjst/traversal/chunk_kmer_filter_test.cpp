@@ -0,0 +1,201 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/sequence_tree/chunked_tree.hpp>
+#include <libjst/traversal/chunk_kmer_filter.hpp>
+#include <libjst/traversal/parallel_chunk_traverser.hpp>
+
+namespace jst::test::chunk_kmer_filter {
+
+using source_t = std::string;
+
+struct naive_matcher {
+    source_t needle{};
+
+    constexpr std::size_t window_size() const noexcept {
+        return needle.size();
+    }
+
+    template <typename haystack_t, typename callback_t>
+    constexpr void operator()(haystack_t && haystack, callback_t && callback) const {
+        auto it = std::ranges::begin(haystack);
+        auto last = std::ranges::end(haystack);
+        for (; std::ranges::distance(it, last) >= std::ranges::ssize(needle); ++it) {
+            if (std::ranges::equal(std::ranges::subrange{it, std::ranges::next(it, needle.size())}, needle))
+                callback(it);
+        }
+    }
+};
+
+struct test : public ::testing::Test {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using cms_t = libjst::dna_compressed_multisequence<source_t, coverage_type>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+    using rcs_store_t = libjst::rcs_store<source_t, cms_t>;
+
+    static constexpr uint32_t chunk_size = 32;
+    rcs_store_t _store;
+
+    void SetUp() override {
+        source_t source{};
+        uint64_t state = 42;
+        for (std::size_t i = 0; i < 256; ++i) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+            source.push_back("ACG"[(state >> 33) % 3]); // no 'T', such that the variants add the only ones
+        }
+
+        _store = rcs_store_t{std::move(source), 4};
+        auto domain = _store.variants().coverage_domain();
+        _store.add(cms_value_t{libjst::breakpoint{40u, 0u}, "TTAT", coverage_type{{0, 2}, domain}});
+        _store.add(cms_value_t{libjst::breakpoint{100u, 1u}, "T", coverage_type{{1}, domain}});
+        _store.add(cms_value_t{libjst::breakpoint{200u, 4u}, "", coverage_type{{3}, domain}});
+    }
+
+    source_t source_slice(std::size_t const position, std::size_t const count) const {
+        return source_t{_store.source().subspan(position, count).begin(), _store.source().subspan(position, count).end()};
+    }
+
+    // A needle ending within the first insertion.
+    source_t insertion_needle() const {
+        return source_slice(37, 3) + "TTA";
+    }
+
+    auto make_forest() const noexcept {
+        return _store | libjst::chunk(chunk_size);
+    }
+
+    // Returns the chunks that hold a hit of the needle, i.e. in which a hit ends.
+    std::vector<std::size_t> chunks_with_hits(source_t const & needle) const {
+        auto forest = make_forest();
+        std::vector<std::size_t> chunks{};
+        for (std::size_t chunk_idx = 0; chunk_idx < std::ranges::size(forest); ++chunk_idx) {
+            bool has_hit = false;
+            libjst::state_oblivious_traverser{}(forest.owned_chunk(chunk_idx), naive_matcher{needle},
+                                                [&] (auto &&, auto &&) { has_hit = true; });
+            if (has_hit)
+                chunks.push_back(chunk_idx);
+        }
+        return chunks;
+    }
+};
+
+} // namespace jst::test::chunk_kmer_filter
+
+struct chunk_kmer_filter_test : public jst::test::chunk_kmer_filter::test
+{};
+
+using namespace std::literals;
+
+using source_t = jst::test::chunk_kmer_filter::source_t;
+using naive_matcher = jst::test::chunk_kmer_filter::naive_matcher;
+
+// ----------------------------------------------------------------------------
+// Test case definitions
+// ----------------------------------------------------------------------------
+
+TEST_F(chunk_kmer_filter_test, construct) {
+    libjst::chunk_kmer_filter filter{make_forest(), 4, 8, 1000};
+    EXPECT_EQ(filter.kmer_size(), 4u);
+    EXPECT_EQ(filter.window_size(), 8u);
+    EXPECT_EQ(filter.hash_count(), 3u);
+    EXPECT_EQ(filter.chunk_count(), 8u);
+    EXPECT_EQ(filter.bits_per_chunk(), 1024u);
+
+    EXPECT_THROW((libjst::chunk_kmer_filter{make_forest(), 0, 8, 1000}), std::invalid_argument);
+    EXPECT_THROW((libjst::chunk_kmer_filter{make_forest(), 4, 3, 1000}), std::invalid_argument);
+    EXPECT_THROW((libjst::chunk_kmer_filter{make_forest(), 4, 8, 0}), std::invalid_argument);
+    EXPECT_THROW((libjst::chunk_kmer_filter{make_forest(), 33, 40, 1000}), std::length_error);
+}
+
+TEST_F(chunk_kmer_filter_test, accepts_the_chunks_with_hits) {
+    libjst::chunk_kmer_filter filter{make_forest(), 4, 8, 4096, 4};
+
+    for (source_t needle : {insertion_needle(), source_slice(38, 2) + "TTATA", source_slice(62, 8), source_slice(198, 7)}) {
+        auto accepts_chunk = filter.predicate(needle);
+        for (std::size_t chunk_idx : chunks_with_hits(needle))
+            EXPECT_TRUE(accepts_chunk(chunk_idx)) << needle << " in chunk " << chunk_idx;
+    }
+}
+
+TEST_F(chunk_kmer_filter_test, rejects_absent_kmers) {
+    libjst::chunk_kmer_filter filter{make_forest(), 4, 8, 4096, 4};
+
+    // Only the haplotypes with the first insertion contain 'TTAT', which is inserted into the second chunk.
+    auto accepts_chunk = filter.predicate("TTAT"s);
+    for (std::size_t chunk_idx = 0; chunk_idx < filter.chunk_count(); ++chunk_idx)
+        EXPECT_EQ(accepts_chunk(chunk_idx), chunk_idx == 1) << chunk_idx;
+
+    auto accepts_absent = filter.predicate("TTTTTT"s);
+    for (std::size_t chunk_idx = 0; chunk_idx < filter.chunk_count(); ++chunk_idx)
+        EXPECT_FALSE(accepts_absent(chunk_idx)) << chunk_idx;
+}
+
+TEST_F(chunk_kmer_filter_test, threshold) {
+    libjst::chunk_kmer_filter filter{make_forest(), 4, 8, 4096, 4};
+    EXPECT_EQ(filter.threshold(5, 0), 5u);
+    EXPECT_EQ(filter.threshold(5, 1), 1u);
+    EXPECT_EQ(filter.threshold(5, 2), 0u);
+
+    // Two of the three k-mers of 'ATTTAT' are absent, which is tolerated by a single error.
+    std::vector<uint64_t> const kmers = filter.kmers("ATTTAT"s);
+    ASSERT_EQ(kmers.size(), 3u);
+    EXPECT_FALSE(filter.accepts(1, kmers, filter.threshold(kmers.size(), 0)));
+    EXPECT_TRUE(filter.accepts(1, kmers, 1));
+    EXPECT_TRUE(filter.predicate("ATTTAT"s, 1)(1));
+    EXPECT_TRUE(filter.kmers("ACNGTA"s).empty());
+}
+
+TEST_F(chunk_kmer_filter_test, parallel_traverser_skips_rejected_chunks) {
+    libjst::chunk_kmer_filter filter{make_forest(), 4, 8, 4096, 4};
+    auto forest = make_forest();
+
+    for (source_t needle : {insertion_needle(), source_slice(62, 8), "TTTTTT"s}) {
+        libjst::parallel_chunk_traverser traverser{4};
+        std::vector<std::size_t> expected{};
+        traverser.ordered<std::size_t>(forest, naive_matcher{needle}, [] (std::size_t task, auto &&, auto &&) {
+            return task;
+        }, [&] (std::size_t task) { expected.push_back(task); });
+
+        traverser.set_chunk_filter(filter.predicate(needle));
+        traverser.set_reorder_window(1);
+        std::vector<std::size_t> filtered{};
+        traverser.ordered<std::size_t>(forest, naive_matcher{needle}, [] (std::size_t task, auto &&, auto &&) {
+            return task;
+        }, [&] (std::size_t task) { filtered.push_back(task); });
+        EXPECT_EQ(filtered, expected) << needle;
+    }
+}
+
+TEST_F(chunk_kmer_filter_test, filtered_split_chunks) {
+    libjst::chunk_kmer_filter filter{make_forest(), 4, 6, 4096, 4};
+    auto forest = make_forest();
+
+    libjst::parallel_chunk_traverser traverser{2, 8};
+    auto search = [&] () {
+        std::vector<std::size_t> tasks{};
+        traverser.ordered<std::size_t>(forest, naive_matcher{insertion_needle()}, [] (std::size_t task, auto &&, auto &&) {
+            return task;
+        }, [&] (std::size_t task) { tasks.push_back(task); });
+        return tasks;
+    };
+
+    std::vector<std::size_t> const expected = search();
+    traverser.set_chunk_filter(filter.predicate(insertion_needle()));
+    EXPECT_EQ(search(), expected);
+}
@@ -0,0 +1,108 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <libjst/traversal/chunk_profile.hpp>
+
+namespace jst::test::chunk_profile {
+
+struct label {
+    std::string symbols{};
+
+    std::string const & sequence() const noexcept {
+        return symbols;
+    }
+};
+
+inline libjst::chunk_profile make_profile() {
+    return libjst::chunk_profile{{
+        libjst::chunk_cost{.begin = 100, .end = 200, .wall_time = 0.5, .node_count = 7, .symbol_count = 140,
+                           .max_depth = 3, .hit_count = 2},
+        libjst::chunk_cost{.begin = 0, .end = 100, .wall_time = 0.25, .node_count = 4, .symbol_count = 110,
+                           .max_depth = 5, .hit_count = 1}
+    }};
+}
+
+} // namespace jst::test::chunk_profile
+
+using label = jst::test::chunk_profile::label;
+using jst::test::chunk_profile::make_profile;
+
+TEST(chunk_profile_test, sorted_chunks) {
+    libjst::chunk_profile profile = make_profile();
+    ASSERT_EQ(profile.size(), 2u);
+    EXPECT_EQ(profile.chunks()[0].begin, 0u);
+    EXPECT_EQ(profile.chunks()[1].begin, 100u);
+
+    profile.record(libjst::chunk_cost{.begin = 50, .end = 60});
+    ASSERT_EQ(profile.size(), 3u);
+    EXPECT_EQ(profile.chunks()[1].begin, 50u);
+
+    profile.clear();
+    EXPECT_TRUE(profile.empty());
+}
+
+TEST(chunk_profile_test, total) {
+    libjst::chunk_cost const total = make_profile().total();
+    EXPECT_EQ(total.begin, 0u);
+    EXPECT_EQ(total.end, 200u);
+    EXPECT_DOUBLE_EQ(total.wall_time, 0.75);
+    EXPECT_EQ(total.node_count, 11u);
+    EXPECT_EQ(total.symbol_count, 250u);
+    EXPECT_EQ(total.max_depth, 5u);
+    EXPECT_EQ(total.hit_count, 3u);
+    EXPECT_DOUBLE_EQ(total.value(libjst::chunk_metric::symbol_count), 250.0);
+}
+
+TEST(chunk_profile_test, bed) {
+    libjst::chunk_profile const profile = make_profile();
+    std::stringstream stream{};
+    profile.write_bed(stream, "chr1");
+    EXPECT_EQ(stream.str(), "#chrom\tbegin\tend\twall_time\tnode_count\tsymbol_count\tmax_depth\thit_count\n"
+                            "chr1\t0\t100\t0.25\t4\t110\t5\t1\n"
+                            "chr1\t100\t200\t0.5\t7\t140\t3\t2\n");
+
+    libjst::chunk_profile const loaded = libjst::chunk_profile::read_bed(stream);
+    EXPECT_EQ(loaded.chunks(), profile.chunks());
+
+    std::istringstream invalid{"chr1\t0\t100\t0.25\t4\n"};
+    EXPECT_THROW(libjst::chunk_profile::read_bed(invalid), std::runtime_error);
+    std::istringstream empty_interval{"chr1\t100\t100\t0.25\t4\t110\t5\t1\n"};
+    EXPECT_THROW(libjst::chunk_profile::read_bed(empty_interval), std::runtime_error);
+}
+
+TEST(chunk_profile_test, bedgraph) {
+    std::stringstream stream{};
+    make_profile().write_bedgraph(stream, "chr1", libjst::chunk_metric::node_count);
+    EXPECT_EQ(stream.str(), "track type=bedGraph name=\"node_count\"\n"
+                            "chr1\t0\t100\t4\n"
+                            "chr1\t100\t200\t7\n");
+}
+
+TEST(chunk_profile_test, recorder) {
+    libjst::chunk_cost cost{};
+    libjst::chunk_cost_recorder recorder{cost};
+    recorder.notify_push();
+    recorder.notify_label(label{"ACGT"});
+    recorder.notify_push();
+    recorder.notify_label(label{"AC"});
+    recorder.notify_pop();
+    recorder.notify_push();
+    recorder.notify_label(label{"G"});
+    recorder.notify_pop();
+    recorder.notify_pop();
+
+    EXPECT_EQ(cost.node_count, 3u);
+    EXPECT_EQ(cost.symbol_count, 7u);
+    EXPECT_EQ(cost.max_depth, 2u);
+}
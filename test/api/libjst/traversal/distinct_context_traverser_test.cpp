@@ -0,0 +1,176 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <map>
+#include <ranges>
+#include <string>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/coverage/int_coverage.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/sequence_tree/volatile_tree.hpp>
+#include <libjst/traversal/distinct_context_traverser.hpp>
+#include <libjst/traversal/state_oblivious_traverser.hpp>
+
+namespace jst::test::distinct_context_traverser {
+
+using source_t = std::string;
+
+struct variant {
+    uint32_t position{};
+    source_t insertion{};
+    uint32_t deletion{};
+    std::vector<uint32_t> coverage{};
+};
+
+// Reports every occurrence of the needle within the haystack.
+struct naive_matcher {
+    source_t needle{};
+    std::size_t * invocations{};
+
+    constexpr std::size_t window_size() const noexcept {
+        return needle.size();
+    }
+
+    template <typename haystack_t, typename callback_t>
+    constexpr void operator()(haystack_t && haystack, callback_t && callback) const {
+        ++*invocations;
+        auto it = std::ranges::begin(haystack);
+        for (auto end = std::ranges::end(haystack); it != end; ++it) {
+            if (std::ranges::distance(it, end) < std::ranges::ssize(needle))
+                break;
+            if (std::ranges::equal(std::ranges::subrange{it, std::ranges::next(it, needle.size())}, needle))
+                callback(std::ranges::next(it, needle.size() - 1));
+        }
+    }
+};
+
+struct fixture {
+    source_t source{};
+    std::vector<variant> variants{};
+    uint32_t coverage_size{};
+    std::vector<source_t> needles{};
+    bool has_duplicates{};
+
+    template <typename stream_t, typename this_t>
+        requires std::same_as<std::remove_cvref_t<this_t>, fixture>
+    friend stream_t & operator<<(stream_t & stream, this_t &&) {
+        stream << "fixture";
+        return stream;
+    }
+};
+
+struct test : public ::testing::TestWithParam<fixture> {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using cms_t = libjst::dna_compressed_multisequence<source_t, coverage_type>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+    using rcs_store_t = libjst::rcs_store<source_t, cms_t>;
+    using hits_type = std::map<source_t, std::vector<bool>>;
+    rcs_store_t _store;
+
+    void SetUp() override {
+        _store = rcs_store_t{GetParam().source, GetParam().coverage_size};
+        auto domain = _store.variants().coverage_domain();
+        for (variant const & var : GetParam().variants)
+            _store.add(cms_value_t{libjst::breakpoint{var.position, var.deletion},
+                                   var.insertion,
+                                   coverage_type{var.coverage, domain}});
+    }
+
+    // Maps the prefix of the label up to every hit to the union of the coverages of the labels reporting it.
+    template <typename traverser_t>
+    hits_type hits(traverser_t const & traverser, source_t const & needle, std::size_t & invocations) const {
+        hits_type found{};
+        traverser(libjst::volatile_tree{_store}, naive_matcher{needle, &invocations}, [&] (auto && label_it,
+                                                                                           auto && label) {
+            auto && sequence = label.sequence();
+            std::vector<bool> & covered = found[source_t{std::ranges::begin(sequence), std::ranges::next(label_it)}];
+            covered.resize(GetParam().coverage_size);
+            for (uint32_t id = 0; id < GetParam().coverage_size; ++id)
+                covered[id] = covered[id] || static_cast<bool>(label.coverage()[id]);
+        });
+        return found;
+    }
+};
+
+} // namespace jst::test::distinct_context_traverser
+
+using namespace std::literals;
+
+using fixture = jst::test::distinct_context_traverser::fixture;
+using variant = jst::test::distinct_context_traverser::variant;
+using source_t = jst::test::distinct_context_traverser::source_t;
+
+struct distinct_context_traverser_test : public jst::test::distinct_context_traverser::test
+{};
+
+// ----------------------------------------------------------------------------
+// Test case definitions
+// ----------------------------------------------------------------------------
+
+TEST_P(distinct_context_traverser_test, equals_oblivious) {
+    for (source_t const & needle : GetParam().needles) {
+        std::size_t oblivious_invocations{};
+        std::size_t distinct_invocations{};
+        hits_type expected = hits(libjst::state_oblivious_traverser{}, needle, oblivious_invocations);
+        EXPECT_EQ(hits(libjst::distinct_context_traverser{}, needle, distinct_invocations), expected) << needle;
+        if (GetParam().has_duplicates) {
+            EXPECT_LT(distinct_invocations, oblivious_invocations) << needle;
+        } else {
+            EXPECT_EQ(distinct_invocations, oblivious_invocations) << needle;
+        }
+    }
+}
+
+TEST(distinct_context_traverser_coverage, union) {
+    libjst::range_domain<uint32_t> domain{0, 6};
+    libjst::bit_coverage<uint32_t> first{{0, 2}, domain};
+    libjst::bit_coverage<uint32_t> second{{2, 5}, domain};
+    EXPECT_EQ(libjst::coverage_union(first, second), (libjst::bit_coverage<uint32_t>{{0, 2, 5}, domain}));
+
+    libjst::int_coverage<uint32_t> int_first{{0, 2}, domain};
+    libjst::int_coverage<uint32_t> int_second{{2, 5}, domain};
+    EXPECT_EQ(libjst::coverage_union(int_first, int_second), (libjst::int_coverage<uint32_t>{{0, 2, 5}, domain}));
+}
+
+// ----------------------------------------------------------------------------
+// Test values
+// ----------------------------------------------------------------------------
+
+INSTANTIATE_TEST_SUITE_P(no_variant, distinct_context_traverser_test, testing::Values(fixture{
+    .source{"AAAAGGGGAAAAGGGG"s},
+    .variants{},
+    .coverage_size{2},
+    .needles{"AAGG"s, "G"s}
+}));
+
+INSTANTIATE_TEST_SUITE_P(snvs, distinct_context_traverser_test, testing::Values(fixture{
+         //  0123456789012345
+    .source{"AAAAGGGGAAAAGGGG"s},
+    .variants{variant{.position{1}, .insertion{"G"s}, .deletion{1}, .coverage{0, 1}},
+              variant{.position{6}, .insertion{"A"s}, .deletion{1}, .coverage{0, 2}},
+              variant{.position{11}, .insertion{"G"s}, .deletion{1}, .coverage{3}}},
+    .coverage_size{4},
+    .needles{"AG"s, "GAGA"s, "AAGG"s}
+}));
+
+INSTANTIATE_TEST_SUITE_P(duplicate_snvs, distinct_context_traverser_test, testing::Values(fixture{
+         //  0123456789012345
+    .source{"AAAAGGGGAAAAGGGG"s},
+    .variants{variant{.position{5}, .insertion{"A"s}, .deletion{1}, .coverage{0}},
+              variant{.position{5}, .insertion{"A"s}, .deletion{1}, .coverage{2, 3}},
+              variant{.position{10}, .insertion{"C"s}, .deletion{1}, .coverage{1}},
+              variant{.position{10}, .insertion{"C"s}, .deletion{1}, .coverage{2}}},
+    .coverage_size{4},
+    .needles{"GAG"s, "ACA"s, "GAGGA"s},
+    .has_duplicates{true}
+}));
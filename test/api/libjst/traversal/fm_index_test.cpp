@@ -0,0 +1,263 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <ranges>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/sequence_tree/volatile_tree.hpp>
+#include <libjst/traversal/fm_index.hpp>
+#include <libjst/traversal/state_oblivious_traverser.hpp>
+
+namespace jst::test::fm_index {
+
+using source_t = std::string;
+
+struct variant {
+    uint32_t position{};
+    source_t insertion{};
+    uint32_t deletion{};
+    std::vector<uint32_t> coverage{};
+};
+
+struct fixture {
+    source_t source{};
+    std::vector<variant> variants{};
+    uint32_t coverage_size{};
+
+    template <typename stream_t, typename this_t>
+        requires std::same_as<std::remove_cvref_t<this_t>, fixture>
+    friend stream_t & operator<<(stream_t & stream, this_t &&) {
+        stream << "fixture";
+        return stream;
+    }
+};
+
+struct test : public ::testing::TestWithParam<fixture> {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using cms_t = libjst::dna_compressed_multisequence<source_t, coverage_type>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+    using rcs_store_t = libjst::rcs_store<source_t, cms_t>;
+    rcs_store_t _store;
+
+    void SetUp() override {
+        _store = rcs_store_t{GetParam().source, GetParam().coverage_size};
+        auto domain = _store.variants().coverage_domain();
+        for (variant const & var : GetParam().variants)
+            _store.add(cms_value_t{libjst::breakpoint{var.position, var.deletion},
+                                   var.insertion,
+                                   coverage_type{var.coverage, domain}});
+    }
+
+    // Applies the variants of the haplotype to the source; the variants of the fixtures do not overlap.
+    source_t haplotype(uint32_t const id) const {
+        source_t sequence{};
+        std::size_t next{};
+        for (variant const & var : GetParam().variants) {
+            if (std::ranges::find(var.coverage, id) == var.coverage.end())
+                continue;
+            sequence.append(GetParam().source, next, var.position - next);
+            sequence.append(var.insertion);
+            next = var.position + var.deletion;
+        }
+        sequence.append(GetParam().source, next);
+        return sequence;
+    }
+
+    static std::size_t count(source_t const & sequence, source_t const & query) {
+        std::size_t count{};
+        for (std::size_t begin = 0; begin + query.size() <= sequence.size(); ++begin)
+            count += sequence.compare(begin, query.size(), query) == 0;
+        return count;
+    }
+};
+
+// Compares the needle with every window of the label.
+struct naive_matcher {
+    source_t needle{};
+
+    constexpr std::size_t window_size() const noexcept {
+        return needle.size();
+    }
+
+    template <typename haystack_t, typename callback_t>
+    constexpr void operator()(haystack_t && haystack, callback_t && callback) const {
+        auto it = std::ranges::begin(haystack);
+        for (; std::ranges::distance(it, std::ranges::end(haystack)) >= std::ranges::ssize(needle); ++it) {
+            auto last = std::ranges::next(it, needle.size() - 1);
+            if (std::ranges::equal(std::ranges::subrange{it, std::ranges::next(last)}, needle))
+                callback(last);
+        }
+    }
+};
+
+} // namespace jst::test::fm_index
+
+using namespace std::literals;
+
+using fixture = jst::test::fm_index::fixture;
+using variant = jst::test::fm_index::variant;
+using source_t = jst::test::fm_index::source_t;
+using naive_matcher = jst::test::fm_index::naive_matcher;
+
+struct fm_index_test : public jst::test::fm_index::test
+{};
+
+// ----------------------------------------------------------------------------
+// Test case definitions
+// ----------------------------------------------------------------------------
+
+TEST_P(fm_index_test, construct) {
+    auto index = libjst::build_fm_index(libjst::volatile_tree{_store}, 6, 4);
+    EXPECT_EQ(index.max_query_size(), 6u);
+    EXPECT_EQ(index.sample_rate(), 4u);
+    EXPECT_GT(index.node_count(), 0u);
+    EXPECT_GE(index.size(), GetParam().source.size() + 2);
+    EXPECT_GT(index.memory_usage(), 0u);
+
+    EXPECT_TRUE(index.find(""s).empty());
+    EXPECT_TRUE(index.find("AANA"s).empty());
+    EXPECT_TRUE(index.find("AAAAAAA"s).empty()); // longer than the maximal query size
+
+    EXPECT_THROW((libjst::build_fm_index(libjst::volatile_tree{_store}, 0)), std::invalid_argument);
+    EXPECT_THROW((libjst::build_fm_index(libjst::volatile_tree{_store}, 4, 0)), std::invalid_argument);
+}
+
+TEST_P(fm_index_test, find) {
+    for (std::size_t const sample_rate : {1, 3, 16}) {
+        auto index = libjst::build_fm_index(libjst::volatile_tree{_store}, 6, sample_rate);
+        for (std::size_t const query_size : {1, 2, 4, 6}) {
+            std::set<source_t> queries{};
+            for (uint32_t id = 0; id < GetParam().coverage_size; ++id)
+                for (std::size_t begin = 0; begin + query_size <= haplotype(id).size(); ++begin)
+                    queries.insert(haplotype(id).substr(begin, query_size));
+
+            // Every occurrence in every haplotype is found with the haplotype in its coverage.
+            for (source_t const & query : queries) {
+                auto occurrences = index.find(query);
+                EXPECT_TRUE(std::ranges::is_sorted(occurrences));
+                for (uint32_t id = 0; id < GetParam().coverage_size; ++id) {
+                    std::size_t const covering = std::ranges::count_if(occurrences, [&] (auto const & occurrence) {
+                        return static_cast<bool>(index.coverage(occurrence)[id]);
+                    });
+                    EXPECT_GE(covering, count(haplotype(id), query)) << sample_rate << " " << query << " " << id;
+                }
+            }
+        }
+        EXPECT_TRUE(index.find("CCCCCC"s).empty());
+    }
+}
+
+TEST_P(fm_index_test, same_hits_as_traversal) {
+    // Queries of the maximal size are searched in the same tree as by the state oblivious traverser, which reports
+    // the occurrences within the context of a deletion twice.
+    auto index = libjst::build_fm_index(libjst::volatile_tree{_store}, 4);
+    for (std::size_t begin = 0; begin + 4 <= GetParam().source.size(); begin += 3) {
+        source_t const query = GetParam().source.substr(begin, 4);
+        std::vector<std::vector<uint32_t>> expected{};
+        libjst::state_oblivious_traverser{}(libjst::volatile_tree{_store}, naive_matcher{query},
+                                            [&] (auto &&, auto && label) {
+            auto && coverage = label.coverage();
+            expected.emplace_back(coverage.begin(), coverage.end());
+        });
+
+        std::vector<std::vector<uint32_t>> actual{};
+        for (auto const & occurrence : index.find(query)) {
+            auto && coverage = index.coverage(occurrence);
+            actual.emplace_back(coverage.begin(), coverage.end());
+        }
+        std::ranges::sort(expected);
+        std::ranges::sort(actual);
+        EXPECT_TRUE(std::ranges::includes(expected, actual)) << query;
+        if (std::ranges::none_of(GetParam().variants, [] (variant const & var) { return var.deletion > 1; })) {
+            EXPECT_EQ(actual, expected) << query;
+        }
+    }
+
+    // The query spanning a deletion is spelled by its branch only, and the query behind it by the reference only,
+    // although the state oblivious traverser reports it in the branch as well.
+    auto domain = _store.variants().coverage_domain();
+    for (variant const & var : GetParam().variants) {
+        if (var.deletion <= 1 || !var.insertion.empty())
+            continue;
+
+        source_t const spanning = GetParam().source.substr(var.position - 2, 2) +
+                                  GetParam().source.substr(var.position + var.deletion, 2);
+        auto occurrences = index.find(spanning);
+        ASSERT_EQ(occurrences.size(), 1u) << spanning;
+        EXPECT_EQ(index.coverage(occurrences.front()), (coverage_type{var.coverage, domain})) << spanning;
+
+        source_t const behind = GetParam().source.substr(var.position + var.deletion, 4);
+        EXPECT_EQ(index.find(behind).size(), count(GetParam().source, behind)) << behind;
+    }
+}
+
+TEST_P(fm_index_test, locate) {
+    auto index = libjst::build_fm_index(libjst::volatile_tree{_store}, 5, 2);
+    auto search_tree = index.search_tree(libjst::volatile_tree{_store});
+    for (source_t const & query : {"AAG"s, "GGAA"s, "A"s, "CGTAC"s, "GAGA"s}) {
+        for (auto const & occurrence : index.find(query)) {
+            auto node = index.locate(search_tree, occurrence);
+            auto label = *node;
+            auto && sequence = label.sequence();
+            ASSERT_LE(occurrence.offset + query.size(), std::ranges::size(sequence));
+            auto query_begin = std::ranges::next(std::ranges::begin(sequence), occurrence.offset);
+            EXPECT_EQ((source_t{query_begin, std::ranges::next(query_begin, query.size())}), query);
+            EXPECT_EQ(index.coverage(occurrence), label.coverage());
+            EXPECT_EQ(label.position(), index.position(occurrence));
+        }
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Test values
+// ----------------------------------------------------------------------------
+
+INSTANTIATE_TEST_SUITE_P(no_variant, fm_index_test, testing::Values(fixture{
+    .source{"AAAAGGGGAAAAGGGG"s},
+    .variants{},
+    .coverage_size{2}
+}));
+
+INSTANTIATE_TEST_SUITE_P(snvs, fm_index_test, testing::Values(fixture{
+         //  0123456789012345
+    .source{"AAAAGGGGAAAAGGGG"s},
+    .variants{variant{.position{1}, .insertion{"G"s}, .deletion{1}, .coverage{0, 1}},
+              variant{.position{6}, .insertion{"A"s}, .deletion{1}, .coverage{0, 2}},
+              variant{.position{11}, .insertion{"G"s}, .deletion{1}, .coverage{3}}},
+    .coverage_size{4}
+}));
+
+INSTANTIATE_TEST_SUITE_P(indels, fm_index_test, testing::Values(fixture{
+         //  0123456789012345678901234567890123456789012345
+    .source{"ACGTACGTACGTACGTACGTACGTACGTACGTACGTACGTACGTAC"s},
+    .variants{variant{.position{5}, .insertion{"CAT"s}, .deletion{0}, .coverage{1}},
+              variant{.position{16}, .insertion{""s}, .deletion{3}, .coverage{1, 2}},
+              variant{.position{30}, .insertion{""s}, .deletion{2}, .coverage{0, 2}}},
+    .coverage_size{3}
+}));
+
+INSTANTIATE_TEST_SUITE_P(dense_snvs, fm_index_test, testing::Values(fixture{
+         //  0123456789012345678901234567890
+    .source{"ACGTACGTACGTACGTACGTACGTACGTACG"s},
+    .variants{variant{.position{3}, .insertion{"A"s}, .deletion{1}, .coverage{0}},
+              variant{.position{4}, .insertion{"T"s}, .deletion{1}, .coverage{1}},
+              variant{.position{5}, .insertion{"G"s}, .deletion{1}, .coverage{2}},
+              variant{.position{6}, .insertion{"C"s}, .deletion{1}, .coverage{3}},
+              variant{.position{7}, .insertion{"A"s}, .deletion{1}, .coverage{4}},
+              variant{.position{20}, .insertion{"T"s}, .deletion{1}, .coverage{0, 4}}},
+    .coverage_size{5}
+}));
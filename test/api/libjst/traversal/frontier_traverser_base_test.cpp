@@ -0,0 +1,213 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <ranges>
+#include <string>
+#include <vector>
+
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/sequence_tree/coloured_tree.hpp>
+#include <libjst/sequence_tree/labelled_tree.hpp>
+#include <libjst/sequence_tree/left_extend_tree.hpp>
+#include <libjst/sequence_tree/merge_tree.hpp>
+#include <libjst/sequence_tree/prune_unsupported.hpp>
+#include <libjst/sequence_tree/trim_tree.hpp>
+#include <libjst/sequence_tree/volatile_tree.hpp>
+#include <libjst/traversal/frontier_traverser_base.hpp>
+#include <libjst/traversal/state_oblivious_traverser.hpp>
+#include <libjst/traversal/tree_traverser_base.hpp>
+
+#include "../mock/rcs_store_mock.hpp"
+
+namespace jst::test::frontier_traverser_base {
+
+using source_t = std::string;
+using variant_t = jst::test::variant<uint32_t, source_t, uint32_t, std::vector<uint32_t>>;
+
+struct naive_matcher {
+    source_t needle{};
+
+    constexpr std::size_t window_size() const noexcept {
+        return needle.size();
+    }
+
+    template <typename haystack_t, typename callback_t>
+    constexpr void operator()(haystack_t && haystack, callback_t && callback) const {
+        auto it = std::ranges::begin(haystack);
+        auto last = std::ranges::end(haystack);
+        for (; std::ranges::distance(it, last) >= std::ranges::ssize(needle); ++it) {
+            if (std::ranges::equal(std::ranges::subrange{it, std::ranges::next(it, needle.size())}, needle))
+                callback(it);
+        }
+    }
+};
+
+struct fixture {
+    source_t source{};
+    std::vector<variant_t> variants{};
+    uint32_t coverage_size{};
+    std::vector<source_t> needles{};
+
+    template <typename stream_t, typename this_t>
+        requires std::same_as<std::remove_cvref_t<this_t>, fixture>
+    friend stream_t & operator<<(stream_t & stream, this_t &&) {
+        stream << "fixture";
+        return stream;
+    }
+};
+
+struct test : public ::testing::TestWithParam<fixture> {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using coverage_domain_type = libjst::coverage_domain_t<coverage_type>;
+
+    using cms_t = libjst::dna_compressed_multisequence<source_t, coverage_type>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+    using rcs_store_t = libjst::rcs_store<source_t, cms_t>;
+    rcs_store_t _mock;
+
+    void SetUp() override {
+        _mock = rcs_store_t{GetParam().source, GetParam().coverage_size};
+        coverage_domain_type domain = _mock.variants().coverage_domain();
+
+        std::ranges::for_each(GetParam().variants, [&] (auto var) {
+            _mock.add(cms_value_t{libjst::breakpoint{var.position, var.deletion},
+                                  var.insertion,
+                                  coverage_type{var.coverage, domain}});
+        });
+    }
+
+    rcs_store_t const & get_mock() const noexcept{
+        return _mock;
+    }
+};
+
+} // namespace jst::test::frontier_traverser_base
+
+using namespace std::literals;
+
+using source_t = jst::test::frontier_traverser_base::source_t;
+using fixture = jst::test::frontier_traverser_base::fixture;
+using variant_t = jst::test::frontier_traverser_base::variant_t;
+using naive_matcher = jst::test::frontier_traverser_base::naive_matcher;
+
+struct frontier_traverser_base_test : public jst::test::frontier_traverser_base::test
+{
+    using jst::test::frontier_traverser_base::test::get_mock;
+    using jst::test::frontier_traverser_base::test::GetParam;
+
+    auto make_tree(std::size_t const window_size) const noexcept {
+        return libjst::volatile_tree{get_mock()} | libjst::labelled()
+                                                 | libjst::coloured()
+                                                 | libjst::trim(window_size - 1)
+                                                 | libjst::prune_unsupported()
+                                                 | libjst::left_extend(window_size - 1)
+                                                 | libjst::merge();
+    }
+
+    template <typename label_t>
+    static source_t to_string(label_t const & label) {
+        source_t str{};
+        std::ranges::copy(label.sequence(), std::back_inserter(str));
+        return str;
+    }
+
+    // The hits of the pattern found by the depth-first traversal.
+    std::vector<source_t> expected_hits(naive_matcher const & pattern) const {
+        std::vector<source_t> hits{};
+        libjst::state_oblivious_traverser{}(libjst::volatile_tree{get_mock()}, pattern, [&] (auto && label_it,
+                                                                                             auto && label) {
+            hits.emplace_back(std::ranges::begin(label.sequence()), label_it);
+        });
+        std::ranges::sort(hits);
+        return hits;
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Test case definitions
+// ----------------------------------------------------------------------------
+
+TEST_P(frontier_traverser_base_test, labels) {
+    for (source_t const & needle : GetParam().needles) {
+        auto tree = make_tree(needle.size());
+        std::vector<source_t> expected_labels{};
+        libjst::tree_traverser_base depth_first_path{tree};
+        for (auto && label : depth_first_path)
+            expected_labels.push_back(to_string(label));
+
+        std::vector<source_t> labels{};
+        libjst::frontier_traverser_base level_path{tree};
+        std::size_t level{};
+        for (auto it = level_path.begin(); it != level_path.end(); ++it, ++level) {
+            EXPECT_EQ(level_path.level(), level);
+            if (level == 0) {
+                EXPECT_EQ(std::ranges::size(*it), 1u);
+            }
+            for (auto && label : *it)
+                labels.push_back(to_string(label));
+        }
+
+        std::ranges::sort(expected_labels);
+        std::ranges::sort(labels);
+        EXPECT_EQ(labels, expected_labels) << needle;
+    }
+}
+
+TEST_P(frontier_traverser_base_test, batched_hits) {
+    for (source_t const & needle : GetParam().needles) {
+        naive_matcher pattern{needle};
+        auto tree = make_tree(needle.size());
+        libjst::frontier_traverser_base level_path{tree};
+        level_path.reserve(4);
+
+        std::vector<source_t> hits{};
+        for (auto it = level_path.begin(); it != level_path.end(); ++it) {
+            for (auto && label : *it) {
+                pattern(label.sequence(), [&] (auto && label_it) {
+                    hits.emplace_back(std::ranges::begin(label.sequence()), label_it);
+                });
+            }
+        }
+        std::ranges::sort(hits);
+        EXPECT_EQ(hits, expected_hits(pattern)) << needle;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Test values
+// ----------------------------------------------------------------------------
+
+INSTANTIATE_TEST_SUITE_P(no_variant, frontier_traverser_base_test, testing::Values(fixture{
+    .source{"AAAAGGGGAAAAGGGG"s},
+    .variants{},
+    .coverage_size{2},
+    .needles{"AAGG"s, "AG"s, "GGGG"s, "GA"s}
+}));
+
+INSTANTIATE_TEST_SUITE_P(snvs, frontier_traverser_base_test, testing::Values(fixture{
+         //  0123456789012345
+    .source{"AAAAGGGGAAAAGGGG"s},
+    .variants{variant_t{.position{1}, .insertion{"G"s}, .deletion{1}, .coverage{0, 1}},
+              variant_t{.position{6}, .insertion{"A"s}, .deletion{1}, .coverage{0, 2}},
+              variant_t{.position{11}, .insertion{"G"s}, .deletion{1}, .coverage{3}}},
+    .coverage_size{4},
+    .needles{"AG"s, "GAG"s, "GA"s, "AGGA"s, "G"s}
+}));
+
+INSTANTIATE_TEST_SUITE_P(indels, frontier_traverser_base_test, testing::Values(fixture{
+         //  0123456789012345
+    .source{"AAAAGGGGAAAAGGGG"s},
+    .variants{variant_t{.position{2}, .insertion{"CC"s}, .deletion{0}, .coverage{0, 1}},
+              variant_t{.position{7}, .insertion{""s}, .deletion{2}, .coverage{1, 2}},
+              variant_t{.position{12}, .insertion{"T"s}, .deletion{1}, .coverage{2}}},
+    .coverage_size{3},
+    .needles{"GA"s, "ACC"s, "GGAA"s, "CG"s, "AT"s}
+}));
@@ -0,0 +1,265 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/coverage/coverage_groups.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/sequence_tree/volatile_tree.hpp>
+#include <libjst/traversal/hit_buffer.hpp>
+#include <libjst/traversal/hit_queue.hpp>
+#include <libjst/traversal/seed_extend_traverser.hpp>
+#include <libjst/traversal/tree_traverser_base.hpp>
+
+namespace jst::test::hit_buffer {
+
+using source_t = std::string;
+
+struct variant {
+    uint32_t position{};
+    source_t insertion{};
+    uint32_t deletion{};
+    std::vector<uint32_t> coverage{};
+};
+
+struct fixture {
+    source_t source{};
+    std::vector<variant> variants{};
+    uint32_t coverage_size{};
+    std::vector<source_t> needles{};
+
+    template <typename stream_t, typename this_t>
+        requires std::same_as<std::remove_cvref_t<this_t>, fixture>
+    friend stream_t & operator<<(stream_t & stream, this_t &&) {
+        stream << "fixture";
+        return stream;
+    }
+};
+
+struct test : public ::testing::TestWithParam<fixture> {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using cms_t = libjst::dna_compressed_multisequence<source_t, coverage_type>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+    using rcs_store_t = libjst::rcs_store<source_t, cms_t>;
+    using buffer_t = libjst::hit_buffer<coverage_type>;
+    using queue_t = libjst::hit_queue<coverage_type>;
+    using hit_type = std::tuple<libjst::seek_position, std::size_t, coverage_type>;
+    rcs_store_t _store;
+
+    void SetUp() override {
+        _store = rcs_store_t{GetParam().source, GetParam().coverage_size};
+        auto domain = _store.variants().coverage_domain();
+        for (variant const & var : GetParam().variants)
+            _store.add(cms_value_t{libjst::breakpoint{var.position, var.deletion},
+                                   var.insertion,
+                                   coverage_type{var.coverage, domain}});
+    }
+
+    // Invokes the callback for every occurrence of the needle within a label of the seekable tree.
+    template <typename callback_t>
+    void search(source_t const & needle, callback_t && callback) const {
+        auto seekable = libjst::seed_extend_traverser::search_tree(libjst::volatile_tree{_store}, needle.size());
+        libjst::tree_traverser_base path{seekable};
+        for (auto it = path.begin(); it != path.end(); ++it) {
+            auto && label = *it;
+            auto && sequence = label.sequence();
+            for (auto first = std::ranges::begin(sequence); first != std::ranges::end(sequence); ++first) {
+                if (std::ranges::distance(first, std::ranges::end(sequence)) < std::ranges::ssize(needle))
+                    break;
+                auto last = std::ranges::next(first, needle.size());
+                if (std::ranges::equal(std::ranges::subrange{first, last}, needle))
+                    callback(std::ranges::prev(last), label);
+            }
+        }
+    }
+
+    std::vector<hit_type> expected_hits(source_t const & needle) const {
+        std::vector<hit_type> found{};
+        search(needle, [&] (auto && label_it, auto && label) {
+            auto && sequence = label.sequence();
+            found.emplace_back(label.position(),
+                               static_cast<std::size_t>(std::ranges::distance(std::ranges::begin(sequence), label_it)),
+                               label.coverage());
+        });
+        return found;
+    }
+
+    std::vector<hit_type> buffered_hits(source_t const & needle,
+                                        std::size_t const capacity,
+                                        bool const asynchronous,
+                                        std::size_t & batch_count) const {
+        std::vector<hit_type> found{};
+        buffer_t buffer{capacity, [&] (buffer_t::batch_type const & batch) {
+            ++batch_count;
+            EXPECT_LE(batch.size(), std::max<std::size_t>(capacity, 1));
+            EXPECT_LE(batch.coverages.size(), batch.size());
+            for (std::size_t hit = 0; hit < batch.size(); ++hit)
+                found.emplace_back(batch.positions[hit], batch.offsets[hit], batch.coverage(hit));
+        }, asynchronous};
+        search(needle, buffer);
+        buffer.flush();
+        return found;
+    }
+
+    // Every worker searches the needle and reports every n-th hit to its own producer of the queue.
+    std::vector<hit_type> queued_hits(source_t const & needle,
+                                      std::size_t const capacity,
+                                      std::size_t const queue_depth,
+                                      std::size_t const worker_count) const {
+        std::vector<hit_type> found{};
+        queue_t queue{capacity, queue_depth, [&] (queue_t::batch_type const & batch) {
+            EXPECT_LE(batch.size(), queue.batch_capacity());
+            for (std::size_t hit = 0; hit < batch.size(); ++hit)
+                found.emplace_back(batch.positions[hit], batch.offsets[hit], batch.coverage(hit));
+        }};
+
+        std::vector<std::thread> workers{};
+        for (std::size_t worker = 0; worker < worker_count; ++worker) {
+            workers.emplace_back([&, worker, producer = queue.producer()] () mutable {
+                std::size_t hit{};
+                search(needle, [&] (auto && label_it, auto && label) {
+                    if (hit++ % worker_count == worker)
+                        producer(label_it, label);
+                });
+                producer.flush();
+            });
+        }
+        for (std::thread & worker : workers)
+            worker.join();
+
+        queue.close();
+        return found;
+    }
+};
+
+} // namespace jst::test::hit_buffer
+
+using namespace std::literals;
+
+using fixture = jst::test::hit_buffer::fixture;
+using variant = jst::test::hit_buffer::variant;
+using source_t = jst::test::hit_buffer::source_t;
+
+struct hit_buffer_test : public jst::test::hit_buffer::test
+{};
+
+// ----------------------------------------------------------------------------
+// Test case definitions
+// ----------------------------------------------------------------------------
+
+TEST_P(hit_buffer_test, synchronous) {
+    for (source_t const & needle : GetParam().needles) {
+        std::vector<hit_type> const expected = expected_hits(needle);
+        for (std::size_t const capacity : {0, 1, 3, 1000}) {
+            std::size_t batch_count{};
+            EXPECT_EQ(buffered_hits(needle, capacity, false, batch_count), expected) << needle << " " << capacity;
+            std::size_t const batch_size = std::max<std::size_t>(capacity, 1);
+            EXPECT_EQ(batch_count, (expected.size() + batch_size - 1) / batch_size) << needle << " " << capacity;
+        }
+    }
+}
+
+TEST_P(hit_buffer_test, asynchronous) {
+    for (source_t const & needle : GetParam().needles) {
+        std::vector<hit_type> const expected = expected_hits(needle);
+        for (std::size_t const capacity : {1, 3, 1000}) {
+            std::size_t batch_count{};
+            EXPECT_EQ(buffered_hits(needle, capacity, true, batch_count), expected) << needle << " " << capacity;
+        }
+    }
+}
+
+TEST_P(hit_buffer_test, consumer_error) {
+    for (bool const asynchronous : {false, true}) {
+        buffer_t buffer{1, [] (buffer_t::batch_type const &) { throw std::runtime_error{"consumer"}; }, asynchronous};
+        EXPECT_THROW((search("A"s, buffer), buffer.flush()), std::runtime_error) << asynchronous;
+        EXPECT_NO_THROW(buffer.flush()) << asynchronous;
+    }
+}
+
+TEST_P(hit_buffer_test, count_groups) {
+    std::vector<uint32_t> group_of(GetParam().coverage_size);
+    for (uint32_t id = 0; id < group_of.size(); ++id)
+        group_of[id] = id % 2;
+    libjst::coverage_groups const groups{group_of, 2};
+
+    for (source_t const & needle : GetParam().needles) {
+        std::size_t hit_count{};
+        buffer_t buffer{3, [&] (buffer_t::batch_type & batch) {
+            batch.count_groups(groups);
+            for (std::size_t hit = 0; hit < batch.size(); ++hit, ++hit_count) {
+                std::vector<std::size_t> expected(2);
+                for (uint32_t id = 0; id < group_of.size(); ++id)
+                    expected[group_of[id]] += batch.coverage(hit)[id];
+                EXPECT_TRUE(std::ranges::equal(batch.group_counts_of(hit), expected)) << needle << " " << hit;
+            }
+        }};
+        search(needle, buffer);
+        buffer.flush();
+        EXPECT_EQ(hit_count, expected_hits(needle).size()) << needle;
+    }
+}
+
+TEST_P(hit_buffer_test, queue) {
+    for (source_t const & needle : GetParam().needles) {
+        std::vector<hit_type> const expected = expected_hits(needle);
+        for (auto [capacity, queue_depth] : {std::pair{1u, 1u}, std::pair{3u, 2u}, std::pair{1000u, 8u}}) {
+            for (std::size_t const worker_count : {1u, 4u}) {
+                std::vector<hit_type> const found = queued_hits(needle, capacity, queue_depth, worker_count);
+                EXPECT_EQ(found.size(), expected.size()) << needle << " " << capacity << " " << worker_count;
+                EXPECT_TRUE(std::ranges::is_permutation(found, expected)) << needle << " " << capacity;
+            }
+        }
+    }
+}
+
+TEST_P(hit_buffer_test, queue_consumer_error) {
+    queue_t queue{1, 1, [] (queue_t::batch_type const &) { throw std::runtime_error{"consumer"}; }};
+    {
+        auto producer = queue.producer();
+        search("A"s, producer);
+    }
+    EXPECT_THROW(queue.close(), std::runtime_error);
+    EXPECT_NO_THROW(queue.close());
+
+    // Publishing to the closed queue is an error.
+    auto producer = queue.producer();
+    EXPECT_THROW(search("A"s, producer), std::logic_error);
+}
+
+// ----------------------------------------------------------------------------
+// Test values
+// ----------------------------------------------------------------------------
+
+INSTANTIATE_TEST_SUITE_P(no_variant, hit_buffer_test, testing::Values(fixture{
+    .source{"AAAAGGGGAAAAGGGG"s},
+    .variants{},
+    .coverage_size{2},
+    .needles{"AAGG"s, "G"s}
+}));
+
+INSTANTIATE_TEST_SUITE_P(snvs, hit_buffer_test, testing::Values(fixture{
+         //  0123456789012345
+    .source{"AAAAGGGGAAAAGGGG"s},
+    .variants{variant{.position{1}, .insertion{"G"s}, .deletion{1}, .coverage{0, 1}},
+              variant{.position{6}, .insertion{"A"s}, .deletion{1}, .coverage{0, 2}},
+              variant{.position{11}, .insertion{"G"s}, .deletion{1}, .coverage{3}}},
+    .coverage_size{4},
+    .needles{"AG"s, "GAGA"s, "A"s}
+}));
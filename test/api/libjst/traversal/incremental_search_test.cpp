@@ -0,0 +1,161 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <ranges>
+#include <string>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/sequence_tree/chunked_tree.hpp>
+#include <libjst/traversal/incremental_search.hpp>
+
+namespace jst::test::incremental_search {
+
+using source_t = std::string;
+
+struct naive_matcher {
+    source_t needle{};
+
+    constexpr std::size_t window_size() const noexcept {
+        return needle.size();
+    }
+
+    template <typename haystack_t, typename callback_t>
+    constexpr void operator()(haystack_t && haystack, callback_t && callback) const {
+        auto it = std::ranges::begin(haystack);
+        auto last = std::ranges::end(haystack);
+        for (; std::ranges::distance(it, last) >= std::ranges::ssize(needle); ++it) {
+            if (std::ranges::equal(std::ranges::subrange{it, std::ranges::next(it, needle.size())}, needle))
+                callback(it);
+        }
+    }
+};
+
+struct test : public ::testing::Test {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using cms_t = libjst::dna_compressed_multisequence<source_t, coverage_type>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+    using rcs_store_t = libjst::rcs_store<source_t, cms_t>;
+
+    static constexpr uint32_t chunk_size = 16;
+    rcs_store_t _store;
+
+    void SetUp() override {
+        source_t source{};
+        for (std::size_t i = 0; i < 128; ++i)
+            source.push_back("ACG"[(i * 7 + i / 5) % 3]);
+        source.replace(20, 4, "TTTT");
+
+        _store = rcs_store_t{std::move(source), 4};
+        add({70u, 0u}, "TTTT", {1, 2}); // spells 'TTTA' with the following source symbol
+    }
+
+    void add(libjst::breakpoint breakpoint, source_t insertion, std::vector<uint32_t> rows) {
+        _store.add(cms_value_t{breakpoint, std::move(insertion),
+                               coverage_type{std::move(rows), _store.variants().coverage_domain()}});
+    }
+
+    // The hits are identified by their chunk and the position of their last symbol in the label.
+    static constexpr auto projection = [] (auto && label_it, auto && label) -> std::ptrdiff_t {
+        return label_it - std::ranges::begin(label.sequence());
+    };
+
+    template <typename forest_t>
+    static std::vector<std::vector<std::ptrdiff_t>> full_search(forest_t const & forest, source_t const & needle) {
+        libjst::incremental_search<std::ptrdiff_t> search{};
+        search.search(libjst::parallel_chunk_traverser{1}, forest, naive_matcher{needle}, projection);
+        std::vector<std::vector<std::ptrdiff_t>> chunk_hits{};
+        for (std::size_t chunk_idx = 0; chunk_idx < search.chunk_count(); ++chunk_idx)
+            chunk_hits.emplace_back(search.hits(chunk_idx).begin(), search.hits(chunk_idx).end());
+        return chunk_hits;
+    }
+};
+
+} // namespace jst::test::incremental_search
+
+struct incremental_search_test : public jst::test::incremental_search::test
+{};
+
+using naive_matcher = jst::test::incremental_search::naive_matcher;
+using source_t = jst::test::incremental_search::source_t;
+
+// ----------------------------------------------------------------------------
+// Test case definitions
+// ----------------------------------------------------------------------------
+
+TEST_F(incremental_search_test, store_tracks_dirty_regions) {
+    EXPECT_EQ(_store.dirty_regions(), (libjst::source_mask{{libjst::source_interval{70, 71}}}));
+
+    _store.clear_dirty_regions();
+    EXPECT_TRUE(_store.dirty_regions().empty());
+
+    add({100u, 5u}, "", {0});
+    add({102u, 0u}, "TT", {3});
+    add({40u, 1u}, "T", {2});
+    EXPECT_EQ(_store.dirty_regions(), (libjst::source_mask{{libjst::source_interval{40, 41},
+                                                            libjst::source_interval{100, 105}}}));
+}
+
+TEST_F(incremental_search_test, dirty_chunks) {
+    auto forest = _store | libjst::chunk(chunk_size);
+    libjst::source_mask const dirty{{libjst::source_interval{40, 41}, libjst::source_interval{95, 97}}};
+
+    std::vector<bool> expected(8, false);
+    expected[2] = true;
+    expected[5] = expected[6] = true;
+    EXPECT_EQ(libjst::dirty_chunks(forest, dirty, 1), expected);
+
+    expected[3] = true; // the windows ending in the next chunk cover the position 40
+    EXPECT_EQ(libjst::dirty_chunks(forest, dirty, 10), expected);
+}
+
+TEST_F(incremental_search_test, update_matches_full_search) {
+    source_t const needle{"TTTA"};
+    auto forest = _store | libjst::chunk(chunk_size);
+    libjst::parallel_chunk_traverser traverser{2};
+
+    libjst::incremental_search<std::ptrdiff_t> search{};
+    search.search(traverser, forest, naive_matcher{needle}, projection);
+    EXPECT_EQ(std::ranges::distance(search.hits()), 1);
+    _store.clear_dirty_regions();
+
+    add({40u, 0u}, "TTT", {0});
+    add({103u, 0u}, "TTT", {3});
+    EXPECT_EQ(search.update(traverser, forest, _store.dirty_regions(), naive_matcher{needle}, projection), 2u);
+
+    std::vector<std::vector<std::ptrdiff_t>> const expected = full_search(forest, needle);
+    ASSERT_EQ(search.chunk_count(), expected.size());
+    for (std::size_t chunk_idx = 0; chunk_idx < expected.size(); ++chunk_idx)
+        EXPECT_TRUE(std::ranges::equal(search.hits(chunk_idx), expected[chunk_idx])) << chunk_idx;
+    EXPECT_EQ(std::ranges::distance(search.hits()), 3);
+}
+
+TEST_F(incremental_search_test, update_split_chunks) {
+    source_t const needle{"TTTA"};
+    auto forest = _store | libjst::chunk(chunk_size);
+    libjst::parallel_chunk_traverser traverser{2, 4};
+
+    libjst::incremental_search<std::ptrdiff_t> search{};
+    search.search(traverser, forest, naive_matcher{needle}, projection);
+    _store.clear_dirty_regions();
+
+    add({43u, 0u}, "TTT", {0}); // the tasks are not split at this position
+    search.update(traverser, forest, _store.dirty_regions(), naive_matcher{needle}, projection);
+
+    libjst::incremental_search<std::ptrdiff_t> expected{};
+    expected.search(traverser, forest, naive_matcher{needle}, projection);
+    // The offsets within the labels depend on the runtime splits, hence only the hits per chunk are compared.
+    for (std::size_t chunk_idx = 0; chunk_idx < expected.chunk_count(); ++chunk_idx)
+        EXPECT_EQ(search.hits(chunk_idx).size(), expected.hits(chunk_idx).size()) << chunk_idx;
+    EXPECT_EQ(std::ranges::distance(search.hits()), 2);
+}
@@ -0,0 +1,308 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <ranges>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/sequence_tree/chunked_tree.hpp>
+#include <libjst/sequence_tree/volatile_tree.hpp>
+#include <libjst/traversal/kmer_index.hpp>
+
+namespace jst::test::kmer_index {
+
+using source_t = std::string;
+
+struct variant {
+    uint32_t position{};
+    source_t insertion{};
+    uint32_t deletion{};
+    std::vector<uint32_t> coverage{};
+};
+
+struct fixture {
+    source_t source{};
+    std::vector<variant> variants{};
+    uint32_t coverage_size{};
+
+    template <typename stream_t, typename this_t>
+        requires std::same_as<std::remove_cvref_t<this_t>, fixture>
+    friend stream_t & operator<<(stream_t & stream, this_t &&) {
+        stream << "fixture";
+        return stream;
+    }
+};
+
+struct test : public ::testing::TestWithParam<fixture> {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using cms_t = libjst::dna_compressed_multisequence<source_t, coverage_type>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+    using rcs_store_t = libjst::rcs_store<source_t, cms_t>;
+    rcs_store_t _store;
+
+    void SetUp() override {
+        _store = rcs_store_t{GetParam().source, GetParam().coverage_size};
+        auto domain = _store.variants().coverage_domain();
+        for (variant const & var : GetParam().variants)
+            _store.add(cms_value_t{libjst::breakpoint{var.position, var.deletion},
+                                   var.insertion,
+                                   coverage_type{var.coverage, domain}});
+    }
+
+    // Applies the variants of the haplotype to the source; the variants of the fixtures do not overlap.
+    source_t haplotype(uint32_t const id) const {
+        source_t sequence{};
+        std::size_t next{};
+        for (variant const & var : GetParam().variants) {
+            if (std::ranges::find(var.coverage, id) == var.coverage.end())
+                continue;
+            sequence.append(GetParam().source, next, var.position - next);
+            sequence.append(var.insertion);
+            next = var.position + var.deletion;
+        }
+        sequence.append(GetParam().source, next);
+        return sequence;
+    }
+
+    static std::vector<source_t> kmers(source_t const & sequence, std::size_t const kmer_size) {
+        std::vector<source_t> kmers{};
+        for (std::size_t begin = 0; begin + kmer_size <= sequence.size(); ++begin)
+            kmers.push_back(sequence.substr(begin, kmer_size));
+        return kmers;
+    }
+
+    static source_t decode(uint64_t code, std::size_t const kmer_size) {
+        source_t kmer(kmer_size, 'A');
+        for (std::size_t i = kmer_size; i > 0; --i, code >>= 2)
+            kmer[i - 1] = "ACGT"[code & 3];
+        return kmer;
+    }
+
+    // Checks whether one of the occurrences of the k-mer is covered by the haplotype.
+    template <typename index_t>
+    static bool contains(index_t const & index, source_t const & kmer, uint32_t const id) {
+        return std::ranges::any_of(index.find(kmer), [&] (auto const & entry) {
+            return static_cast<bool>(index.coverage(entry)[id]);
+        });
+    }
+
+    // Returns the entries of a chunked index independent of the numbering of the nodes.
+    template <typename index_t>
+    static auto chunk_entries(index_t const & index) {
+        std::vector<std::tuple<uint64_t, std::size_t, uint32_t, libjst::seek_position, coverage_type>> entries{};
+        for (auto const & entry : index.entries())
+            entries.emplace_back(entry.kmer, index.chunk(entry), entry.offset, index.position(entry),
+                                 index.coverage(entry));
+        std::ranges::sort(entries, std::less<>{}, [] (auto const & entry) {
+            return std::tuple{std::get<0>(entry), std::get<1>(entry), std::get<2>(entry), std::get<3>(entry)};
+        });
+        return entries;
+    }
+};
+
+} // namespace jst::test::kmer_index
+
+using namespace std::literals;
+
+using fixture = jst::test::kmer_index::fixture;
+using variant = jst::test::kmer_index::variant;
+using source_t = jst::test::kmer_index::source_t;
+
+struct kmer_index_test : public jst::test::kmer_index::test
+{};
+
+// ----------------------------------------------------------------------------
+// Test case definitions
+// ----------------------------------------------------------------------------
+
+TEST_P(kmer_index_test, construct) {
+    auto index = libjst::build_kmer_index(libjst::volatile_tree{_store}, 4);
+    EXPECT_EQ(index.kmer_size(), 4u);
+    EXPECT_EQ(index.window_size(), 1u);
+    EXPECT_TRUE(std::ranges::is_sorted(index.entries()));
+    EXPECT_EQ(index.encode("ACGT"s), std::optional<uint64_t>{0b00011011});
+    EXPECT_EQ(index.encode("ACG"s), std::nullopt);
+    EXPECT_EQ(index.encode("ACNT"s), std::nullopt);
+    EXPECT_TRUE(index.find("ACNT"s).empty());
+
+    EXPECT_THROW((libjst::build_kmer_index(libjst::volatile_tree{_store}, 0)), std::invalid_argument);
+    EXPECT_THROW((libjst::build_kmer_index(libjst::volatile_tree{_store}, 4, 0)), std::invalid_argument);
+    EXPECT_THROW((libjst::build_kmer_index(libjst::volatile_tree{_store}, 33)), std::length_error);
+}
+
+TEST_P(kmer_index_test, kmers) {
+    for (std::size_t const kmer_size : {2, 3, 5}) {
+        auto index = libjst::build_kmer_index(libjst::volatile_tree{_store}, kmer_size);
+
+        // Every occurrence is indexed once.
+        EXPECT_EQ(std::ranges::adjacent_find(index.entries()), index.entries().end()) << kmer_size;
+
+        std::set<source_t> expected{};
+        for (source_t const & kmer : kmers(GetParam().source, kmer_size))
+            expected.insert(kmer);
+        for (uint32_t id = 0; id < GetParam().coverage_size; ++id) {
+            for (source_t const & kmer : kmers(haplotype(id), kmer_size)) {
+                EXPECT_TRUE(contains(index, kmer, id)) << kmer_size << " " << id << " " << kmer;
+                expected.insert(kmer);
+            }
+        }
+
+        std::set<source_t> actual{};
+        for (auto const & entry : index.entries())
+            actual.insert(decode(entry.kmer, kmer_size));
+        EXPECT_TRUE(std::ranges::includes(expected, actual)) << kmer_size;
+    }
+}
+
+TEST_P(kmer_index_test, minimizers) {
+    for (std::size_t const kmer_size : {2, 3}) {
+        for (std::size_t const window_size : {2, 4}) {
+            auto index = libjst::build_kmer_index(libjst::volatile_tree{_store}, kmer_size, window_size);
+            auto all_kmers = libjst::build_kmer_index(libjst::volatile_tree{_store}, kmer_size);
+            EXPECT_EQ(index.window_size(), window_size);
+            EXPECT_LE(index.size(), all_kmers.size());
+
+            // Every window of every haplotype contains an indexed k-mer covering the haplotype.
+            for (uint32_t id = 0; id < GetParam().coverage_size; ++id) {
+                std::vector<source_t> const haplotype_kmers = kmers(haplotype(id), kmer_size);
+                for (std::size_t begin = 0; begin + window_size <= haplotype_kmers.size(); ++begin) {
+                    EXPECT_TRUE(std::ranges::any_of(haplotype_kmers.begin() + begin,
+                                                    haplotype_kmers.begin() + begin + window_size,
+                                                    [&] (source_t const & kmer) {
+                        return contains(index, kmer, id);
+                    })) << kmer_size << " " << window_size << " " << id << " " << begin;
+                }
+            }
+        }
+    }
+}
+
+TEST_P(kmer_index_test, locate) {
+    for (std::size_t const window_size : {1, 3}) {
+        auto index = libjst::build_kmer_index(libjst::volatile_tree{_store}, 3, window_size);
+        auto search_tree = index.search_tree(libjst::volatile_tree{_store});
+        for (auto const & entry : index.entries()) {
+            auto node = index.locate(search_tree, entry);
+            auto label = *node;
+            auto && sequence = label.sequence();
+            ASSERT_LE(entry.offset + 3u, std::ranges::size(sequence));
+            source_t const kmer{std::ranges::next(std::ranges::begin(sequence), entry.offset),
+                                std::ranges::next(std::ranges::begin(sequence), entry.offset + 3)};
+            EXPECT_EQ(kmer, decode(entry.kmer, 3)) << window_size;
+            EXPECT_EQ(index.coverage(entry), label.coverage()) << window_size;
+            EXPECT_EQ(label.position(), index.position(entry)) << window_size;
+        }
+    }
+}
+
+TEST_P(kmer_index_test, chunked) {
+    for (std::size_t const chunk_size : {4u, 7u}) {
+        auto forest = _store | libjst::chunk(chunk_size);
+        auto index = libjst::build_kmer_index(forest, 3, 1, 1);
+        EXPECT_EQ(index.chunk_count(), std::ranges::size(forest));
+        EXPECT_TRUE(std::ranges::is_sorted(index.entries())) << chunk_size;
+
+        // Every k-mer of every haplotype is indexed by the chunk it ends in.
+        for (uint32_t id = 0; id < GetParam().coverage_size; ++id)
+            for (source_t const & kmer : kmers(haplotype(id), 3))
+                EXPECT_TRUE(contains(index, kmer, id)) << chunk_size << " " << id << " " << kmer;
+
+        for (auto const & entry : index.entries()) {
+            auto search_tree = index.search_tree(forest.owned_chunk(index.chunk(entry)));
+            auto node = index.locate(search_tree, entry);
+            auto label = *node;
+            auto && sequence = label.sequence();
+            ASSERT_LE(entry.offset + 3u, std::ranges::size(sequence));
+            source_t const kmer{std::ranges::next(std::ranges::begin(sequence), entry.offset),
+                                std::ranges::next(std::ranges::begin(sequence), entry.offset + 3)};
+            EXPECT_EQ(kmer, decode(entry.kmer, 3)) << chunk_size;
+            EXPECT_EQ(index.coverage(entry), label.coverage()) << chunk_size;
+        }
+
+        // The index does not depend on the number of threads.
+        for (std::size_t const window_size : {1u, 3u}) {
+            auto serial = libjst::build_kmer_index(forest, 3, window_size, 1);
+            auto parallel = libjst::build_kmer_index(forest, 3, window_size, 3);
+            EXPECT_TRUE(std::ranges::equal(serial.entries(), parallel.entries())) << chunk_size;
+            EXPECT_EQ(chunk_entries(serial), chunk_entries(parallel)) << chunk_size;
+        }
+    }
+}
+
+TEST_P(kmer_index_test, update) {
+    for (std::size_t const chunk_size : {4u, 5u}) {
+        SetUp();
+        auto forest = _store | libjst::chunk(chunk_size);
+        auto index = libjst::build_kmer_index(forest, 3, 2, 2);
+        _store.clear_dirty_regions();
+        EXPECT_EQ(index.update(forest, _store.dirty_regions()), 0u);
+
+        // Adds variants into the first and the last chunk; the chunks in between are only renumbered.
+        auto domain = _store.variants().coverage_domain();
+        _store.add(cms_value_t{libjst::breakpoint{14, 1}, "T"s, coverage_type{{0}, domain}});
+        _store.add(cms_value_t{libjst::breakpoint{0, 0}, "CC"s, coverage_type{{1}, domain}});
+
+        std::size_t const updated = index.update(forest, _store.dirty_regions(), 2);
+        EXPECT_GT(updated, 0u);
+        EXPECT_LT(updated, index.chunk_count());
+        EXPECT_TRUE(std::ranges::is_sorted(index.entries())) << chunk_size;
+        EXPECT_EQ(chunk_entries(index), chunk_entries(libjst::build_kmer_index(forest, 3, 2, 1))) << chunk_size;
+    }
+
+    auto index = libjst::build_kmer_index(libjst::volatile_tree{_store}, 3);
+    EXPECT_THROW(index.update(_store | libjst::chunk(4u), _store.dirty_regions()), std::logic_error);
+}
+
+// ----------------------------------------------------------------------------
+// Test values
+// ----------------------------------------------------------------------------
+
+INSTANTIATE_TEST_SUITE_P(no_variant, kmer_index_test, testing::Values(fixture{
+    .source{"AAAAGGGGAAAAGGGG"s},
+    .variants{},
+    .coverage_size{2}
+}));
+
+INSTANTIATE_TEST_SUITE_P(snvs, kmer_index_test, testing::Values(fixture{
+         //  0123456789012345
+    .source{"AAAAGGGGAAAAGGGG"s},
+    .variants{variant{.position{1}, .insertion{"G"s}, .deletion{1}, .coverage{0, 1}},
+              variant{.position{6}, .insertion{"A"s}, .deletion{1}, .coverage{0, 2}},
+              variant{.position{11}, .insertion{"G"s}, .deletion{1}, .coverage{3}}},
+    .coverage_size{4}
+}));
+
+INSTANTIATE_TEST_SUITE_P(multiallelic_snvs, kmer_index_test, testing::Values(fixture{
+         //  0123456789012345
+    .source{"AAAAGGGGAAAAGGGG"s},
+    .variants{variant{.position{4}, .insertion{"C"s}, .deletion{1}, .coverage{0}},
+              variant{.position{4}, .insertion{"T"s}, .deletion{1}, .coverage{1, 2}},
+              variant{.position{9}, .insertion{"C"s}, .deletion{1}, .coverage{2}}},
+    .coverage_size{3}
+}));
+
+INSTANTIATE_TEST_SUITE_P(dense_snvs, kmer_index_test, testing::Values(fixture{
+         //  0123456789012345678901234567890
+    .source{"ACGTACGTACGTACGTACGTACGTACGTACG"s},
+    .variants{variant{.position{3}, .insertion{"A"s}, .deletion{1}, .coverage{0}},
+              variant{.position{4}, .insertion{"T"s}, .deletion{1}, .coverage{1}},
+              variant{.position{5}, .insertion{"G"s}, .deletion{1}, .coverage{2}},
+              variant{.position{6}, .insertion{"C"s}, .deletion{1}, .coverage{3}},
+              variant{.position{7}, .insertion{"A"s}, .deletion{1}, .coverage{4}},
+              variant{.position{20}, .insertion{"T"s}, .deletion{1}, .coverage{0, 4}}},
+    .coverage_size{5}
+}));
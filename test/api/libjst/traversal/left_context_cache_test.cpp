@@ -0,0 +1,136 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/sequence_tree/volatile_tree.hpp>
+#include <libjst/traversal/left_context_cache.hpp>
+#include <libjst/traversal/state_oblivious_traverser.hpp>
+
+using namespace std::literals;
+
+// Compares the needle with every window of the label.
+struct naive_matcher {
+    std::string needle{};
+
+    constexpr std::size_t window_size() const noexcept {
+        return needle.size();
+    }
+
+    template <typename haystack_t, typename callback_t>
+    constexpr void operator()(haystack_t && haystack, callback_t && callback) const {
+        auto it = std::ranges::begin(haystack);
+        for (; std::ranges::distance(it, std::ranges::end(haystack)) >= std::ranges::ssize(needle); ++it) {
+            auto last = std::ranges::next(it, needle.size() - 1);
+            if (std::ranges::equal(std::ranges::subrange{it, std::ranges::next(last)}, needle))
+                callback(last);
+        }
+    }
+};
+
+TEST(left_context_cache, haystack) {
+    std::string_view const path = "ACGTACGTTTGCA"sv;
+    libjst::left_context_cache<char> cache{2};
+    cache.notify_push();
+
+    auto label = [&] (std::size_t first, std::size_t last) { return path.substr(first, last - first); };
+    EXPECT_TRUE(std::ranges::equal(cache.haystack(label(0, 4), 0), "ACGT"sv));
+    EXPECT_EQ(cache.cached_symbols(), 0u);
+
+    cache.notify_push(); // branch at position 4
+    EXPECT_TRUE(std::ranges::equal(cache.haystack(label(2, 7), 2), "GTACG"sv));
+    EXPECT_EQ(cache.cached_symbols(), 2u);
+    EXPECT_TRUE(std::ranges::equal(cache.haystack(label(5, 13), 5), "CGTTTGCA"sv));
+    EXPECT_EQ(cache.cached_symbols(), 4u);
+
+    cache.notify_pop(); // continue at position 4; the ring of 8 symbols was overwritten up to position 13
+    EXPECT_TRUE(std::ranges::equal(cache.haystack(label(2, 6), 2), "GTAC"sv));
+    EXPECT_EQ(cache.cached_symbols(), 4u);
+    cache.notify_pop();
+}
+
+TEST(left_context_cache, partial_root) {
+    std::string_view const path = "ACGTACGTTTGCA"sv;
+    libjst::left_context_cache<char> cache{2};
+    cache.notify_push();
+
+    EXPECT_TRUE(std::ranges::equal(cache.haystack(path.substr(5, 3), 5), "CGT"sv));
+    cache.notify_push(); // the alternate label reaches before the root of the partial tree.
+    EXPECT_TRUE(std::ranges::equal(cache.haystack(path.substr(4, 5), 4), "ACGTT"sv));
+    EXPECT_EQ(cache.cached_symbols(), 0u);
+    cache.notify_pop();
+    EXPECT_TRUE(std::ranges::equal(cache.haystack(path.substr(6, 4), 6), "GTTT"sv));
+    EXPECT_EQ(cache.cached_symbols(), 2u);
+    cache.notify_pop();
+}
+
+TEST(left_context_cache, traverser) {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using cms_t = libjst::dna_compressed_multisequence<std::string, coverage_type>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+    using rcs_store_t = libjst::rcs_store<std::string, cms_t>;
+
+    std::mt19937 random{42};
+    std::string source(2000, 'A');
+    std::ranges::generate(source, [&] () { return "ACGT"[random() % 4]; });
+
+    uint32_t const sample_count = 16;
+    rcs_store_t store{source, sample_count};
+    auto domain = store.variants().coverage_domain();
+    for (uint32_t position = 5; position + 10 < source.size(); position += 3 + random() % 5) { // snv dense
+        std::vector<uint32_t> samples{};
+        for (uint32_t sample = 0; sample < sample_count; ++sample)
+            if (random() % 3 == 0)
+                samples.push_back(sample);
+        if (samples.empty())
+            continue;
+
+        coverage_type coverage{samples, domain};
+        switch (random() % 4) {
+            case 0: store.add(cms_value_t{libjst::breakpoint{position, 0}, "GA"s, std::move(coverage)}); break;
+            case 1: store.add(cms_value_t{libjst::breakpoint{position, 2}, ""s, std::move(coverage)}); break;
+            default: store.add(cms_value_t{libjst::breakpoint{position, 1}, std::string(1, "ACGT"[random() % 4]),
+                                           std::move(coverage)});
+        }
+    }
+
+    for (std::size_t const begin : {100, 733, 1500}) {
+        for (std::size_t const length : {2, 7, 20}) {
+            naive_matcher const matcher{source.substr(begin, length)};
+            auto search = [&] (bool const cached) {
+                libjst::state_oblivious_traverser traverser{};
+                traverser.cache_left_context(cached);
+                EXPECT_EQ(traverser.caches_left_context(), cached);
+                std::vector<std::tuple<std::size_t, std::vector<uint32_t>>> hits{};
+                traverser(libjst::volatile_tree{store}, matcher, [&] (auto && hit, auto && label) {
+                    auto coverage = label.coverage();
+                    hits.emplace_back(static_cast<std::size_t>(hit - label.sequence().begin()),
+                                      std::vector<uint32_t>(coverage.begin(), coverage.end()));
+                });
+                std::ranges::sort(hits);
+                return hits;
+            };
+
+            auto const expected = search(false);
+            EXPECT_FALSE(expected.empty()) << begin << " " << length;
+            EXPECT_EQ(search(true), expected) << begin << " " << length;
+        }
+    }
+}
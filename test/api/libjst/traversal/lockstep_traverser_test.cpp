@@ -0,0 +1,193 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <ranges>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/matcher/myers_matcher.hpp>
+#include <libjst/matcher/shift_or_matcher.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/sequence_tree/volatile_tree.hpp>
+#include <libjst/traversal/lockstep_traverser.hpp>
+#include <libjst/traversal/state_capture_traverser.hpp>
+
+namespace jst::test::lockstep_traverser {
+
+using source_t = std::string;
+
+struct variant {
+    uint32_t position{};
+    source_t insertion{};
+    uint32_t deletion{};
+    std::vector<uint32_t> coverage{};
+};
+
+// Remembers the last symbols of the path to find the needles spanning several nodes.
+struct window_matcher {
+    source_t needle{};
+    source_t window{};
+
+    constexpr std::size_t window_size() const noexcept {
+        return needle.size();
+    }
+
+    template <typename haystack_t, typename callback_t>
+    constexpr void operator()(haystack_t && haystack, callback_t && callback) {
+        for (auto it = std::ranges::begin(haystack); it != std::ranges::end(haystack); ++it) {
+            window.push_back(*it);
+            if (window.size() > needle.size())
+                window.erase(window.begin());
+            if (window == needle)
+                callback(it);
+        }
+    }
+
+    source_t capture() const {
+        return window;
+    }
+
+    void restore(source_t state) {
+        window = std::move(state);
+    }
+};
+
+struct fixture {
+    source_t source{};
+    std::vector<variant> variants{};
+    uint32_t coverage_size{};
+    std::vector<source_t> needles{};
+
+    template <typename stream_t, typename this_t>
+        requires std::same_as<std::remove_cvref_t<this_t>, fixture>
+    friend stream_t & operator<<(stream_t & stream, this_t &&) {
+        stream << "fixture";
+        return stream;
+    }
+};
+
+struct test : public ::testing::TestWithParam<fixture> {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using cms_t = libjst::dna_compressed_multisequence<source_t, coverage_type>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+    using rcs_store_t = libjst::rcs_store<source_t, cms_t>;
+    rcs_store_t _store;
+
+    void SetUp() override {
+        _store = rcs_store_t{GetParam().source, GetParam().coverage_size};
+        auto domain = _store.variants().coverage_domain();
+        for (variant const & var : GetParam().variants)
+            _store.add(cms_value_t{libjst::breakpoint{var.position, var.deletion},
+                                   var.insertion,
+                                   coverage_type{var.coverage, domain}});
+    }
+
+    // Returns the prefix of the label up to every hit, sorted to compare traversals visiting the nodes in any order.
+    template <typename traverser_t, typename matcher_t>
+    std::vector<std::string> hits(traverser_t const & traverser, matcher_t matcher) const {
+        std::vector<std::string> found{};
+        traverser(libjst::volatile_tree{_store}, std::move(matcher), [&] (auto && label_it, auto && label) {
+            auto && sequence = label.sequence();
+            found.emplace_back(std::ranges::begin(sequence), std::ranges::next(label_it));
+        });
+        std::ranges::sort(found);
+        return found;
+    }
+};
+
+} // namespace jst::test::lockstep_traverser
+
+using namespace std::literals;
+
+using fixture = jst::test::lockstep_traverser::fixture;
+using variant = jst::test::lockstep_traverser::variant;
+using window_matcher = jst::test::lockstep_traverser::window_matcher;
+using source_t = jst::test::lockstep_traverser::source_t;
+
+struct lockstep_traverser_test : public jst::test::lockstep_traverser::test
+{};
+
+// ----------------------------------------------------------------------------
+// Test case definitions
+// ----------------------------------------------------------------------------
+
+TEST_P(lockstep_traverser_test, concept) {
+    using haystack_t = std::span<char const>;
+    EXPECT_TRUE((libjst::lockstep_matcher<libjst::shift_or_matcher, haystack_t>));
+    EXPECT_FALSE((libjst::lockstep_matcher<libjst::myers_matcher, haystack_t>));
+    EXPECT_FALSE((libjst::lockstep_matcher<window_matcher, haystack_t>));
+}
+
+TEST_P(lockstep_traverser_test, lanes) {
+    for (source_t const & needle : GetParam().needles) {
+        auto expected = hits(libjst::state_capture_traverser{}, window_matcher{needle});
+        for (std::size_t const lane_count : {1, 2, 8, 13}) {
+            EXPECT_EQ(hits(libjst::lockstep_traverser{lane_count}, libjst::shift_or_matcher{needle}), expected)
+                << needle << " " << lane_count;
+            EXPECT_EQ(hits(libjst::lockstep_traverser{lane_count}, window_matcher{needle}), expected)
+                << needle << " " << lane_count;
+        }
+    }
+}
+
+TEST_P(lockstep_traverser_test, approximate) {
+    for (source_t const & needle : GetParam().needles) {
+        EXPECT_EQ(hits(libjst::lockstep_traverser{}, libjst::myers_matcher{needle, 1}),
+                  hits(libjst::state_capture_traverser{}, libjst::myers_matcher{needle, 1})) << needle;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Test values
+// ----------------------------------------------------------------------------
+
+INSTANTIATE_TEST_SUITE_P(no_variant, lockstep_traverser_test, testing::Values(fixture{
+    .source{"AAAAGGGGAAAAGGGG"s},
+    .variants{},
+    .coverage_size{2},
+    .needles{"AAGG"s, "G"s}
+}));
+
+INSTANTIATE_TEST_SUITE_P(snvs, lockstep_traverser_test, testing::Values(fixture{
+         //  0123456789012345
+    .source{"AAAAGGGGAAAAGGGG"s},
+    .variants{variant{.position{1}, .insertion{"G"s}, .deletion{1}, .coverage{0, 1}},
+              variant{.position{6}, .insertion{"A"s}, .deletion{1}, .coverage{0, 2}},
+              variant{.position{11}, .insertion{"G"s}, .deletion{1}, .coverage{3}}},
+    .coverage_size{4},
+    .needles{"AG"s, "GAGA"s, "AAGG"s}
+}));
+
+INSTANTIATE_TEST_SUITE_P(indels, lockstep_traverser_test, testing::Values(fixture{
+         //  0123456789012345
+    .source{"AAAAGGGGAAAAGGGG"s},
+    .variants{variant{.position{2}, .insertion{"CC"s}, .deletion{0}, .coverage{0, 1}},
+              variant{.position{7}, .insertion{""s}, .deletion{2}, .coverage{1, 2}},
+              variant{.position{12}, .insertion{"T"s}, .deletion{1}, .coverage{2}}},
+    .coverage_size{3},
+    .needles{"GA"s, "ACCA"s, "GGAA"s}
+}));
+
+INSTANTIATE_TEST_SUITE_P(dense_snvs, lockstep_traverser_test, testing::Values(fixture{
+         //  0123456789012345678901234567890
+    .source{"ACGTACGTACGTACGTACGTACGTACGTACG"s},
+    .variants{variant{.position{3}, .insertion{"A"s}, .deletion{1}, .coverage{0}},
+              variant{.position{4}, .insertion{"T"s}, .deletion{1}, .coverage{1}},
+              variant{.position{5}, .insertion{"G"s}, .deletion{1}, .coverage{2}},
+              variant{.position{6}, .insertion{"C"s}, .deletion{1}, .coverage{3}},
+              variant{.position{7}, .insertion{"A"s}, .deletion{1}, .coverage{4}},
+              variant{.position{20}, .insertion{"T"s}, .deletion{1}, .coverage{0, 4}}},
+    .coverage_size{5},
+    .needles{"ACGT"s, "GTAC"s, "TACGTA"s}
+}));
@@ -0,0 +1,167 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/sequence_tree/volatile_tree.hpp>
+#include <libjst/traversal/mpi_shard_executor.hpp>
+#include <libjst/traversal/shard_planner.hpp>
+#include <libjst/traversal/state_oblivious_traverser.hpp>
+
+namespace jst::test::mpi_shard_executor {
+
+using source_t = std::string;
+
+struct naive_matcher {
+    source_t needle{};
+
+    constexpr std::size_t window_size() const noexcept {
+        return needle.size();
+    }
+
+    template <typename haystack_t, typename callback_t>
+    constexpr void operator()(haystack_t && haystack, callback_t && callback) const {
+        auto it = std::ranges::begin(haystack);
+        auto last = std::ranges::end(haystack);
+        for (; std::ranges::distance(it, last) >= std::ranges::ssize(needle); ++it) {
+            if (std::ranges::equal(std::ranges::subrange{it, std::ranges::next(it, needle.size())}, needle))
+                callback(it);
+        }
+    }
+};
+
+// A trivially copyable hit, which can be sent between ranks.
+struct shard_hit {
+    uint32_t shard{};
+    uint32_t ordinal{};
+
+    friend constexpr bool operator==(shard_hit const &, shard_hit const &) noexcept = default;
+};
+
+struct test : public ::testing::Test {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using coverage_domain_type = libjst::coverage_domain_t<coverage_type>;
+    using cms_t = libjst::dna_compressed_multisequence<source_t, coverage_type>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+    using rcs_store_t = libjst::rcs_store<source_t, cms_t>;
+
+    static constexpr uint32_t haplotype_count{8};
+
+    rcs_store_t _store;
+
+    void SetUp() override {
+        std::mt19937 random_engine{11};
+        source_t source(4000, 'A');
+        std::ranges::generate(source, [&] { return "ACGT"[random_engine() % 4]; });
+        _store = rcs_store_t{source, haplotype_count};
+        coverage_domain_type domain = _store.variants().coverage_domain();
+        for (uint32_t position = 10; position < source.size() - 10; position += 23) {
+            char const alt = (source[position] == 'A') ? 'C' : 'A';
+            _store.add(cms_value_t{libjst::breakpoint{position, 1}, source_t{alt},
+                                   coverage_type{{position % haplotype_count}, domain}});
+        }
+    }
+};
+
+} // namespace jst::test::mpi_shard_executor
+
+using namespace std::literals;
+
+using mpi_shard_executor_test = jst::test::mpi_shard_executor::test;
+using jst::test::mpi_shard_executor::naive_matcher;
+using jst::test::mpi_shard_executor::shard_hit;
+
+TEST_F(mpi_shard_executor_test, local_run) {
+    libjst::mpi_shard_executor executor{};
+    if (libjst::mpi_enabled && executor.size() > 1)
+        GTEST_SKIP() << "The test searches all shards in the calling process.";
+    EXPECT_TRUE(executor.is_root());
+
+    std::size_t expected_hits{};
+    libjst::state_oblivious_traverser{}(libjst::volatile_tree{_store}, naive_matcher{"ACGTA"s}, [&] (auto &&, auto &&) {
+        ++expected_hits;
+    });
+    ASSERT_GT(expected_hits, 0u);
+
+    std::vector<libjst::tree_shard> const shards = libjst::shard_planner{5}(_store, 6);
+    auto result = executor.run<shard_hit>(shards.size(),
+        [&] (std::size_t const shard_idx, std::vector<shard_hit> & hits, libjst::tree_stats & stats) {
+            libjst::state_oblivious_traverser{}(shards[shard_idx].make_tree(_store), naive_matcher{"ACGTA"s},
+                                                [&] (auto &&, auto &&) {
+                hits.push_back(shard_hit{static_cast<uint32_t>(shard_idx), static_cast<uint32_t>(hits.size())});
+            });
+            stats.node_count = 1;
+            stats.symbol_count = shards[shard_idx].end - shards[shard_idx].begin;
+            stats.subtree_depths.push_back(shard_idx);
+        });
+
+    ASSERT_EQ(result.shard_hits.size(), shards.size());
+    EXPECT_EQ(static_cast<std::size_t>(std::ranges::distance(result.hits())), expected_hits);
+    for (std::size_t shard_idx = 0; shard_idx < shards.size(); ++shard_idx)
+        EXPECT_TRUE(std::ranges::all_of(result.shard_hits[shard_idx], [&] (shard_hit const & hit) {
+            return hit.shard == shard_idx;
+        }));
+
+    EXPECT_EQ(result.stats.node_count, shards.size());
+    EXPECT_EQ(result.stats.symbol_count, std::ranges::size(_store.source()));
+    EXPECT_TRUE(std::ranges::equal(result.stats.subtree_depths, std::views::iota(std::size_t{0}, shards.size())));
+}
+
+TEST_F(mpi_shard_executor_test, unordered_sink) {
+    libjst::mpi_shard_executor executor{};
+    if (libjst::mpi_enabled && executor.size() > 1)
+        GTEST_SKIP() << "The test searches all shards in the calling process.";
+
+    std::vector<std::size_t> delivered{};
+    executor.run_unordered<shard_hit>(4,
+        [] (std::size_t const shard_idx, std::vector<shard_hit> & hits, libjst::tree_stats &) {
+            hits.assign(shard_idx, shard_hit{static_cast<uint32_t>(shard_idx), 0});
+        },
+        [&] (std::size_t const shard_idx, std::vector<shard_hit> && hits, libjst::tree_stats &&) {
+            EXPECT_EQ(hits.size(), shard_idx);
+            delivered.push_back(shard_idx);
+        });
+    std::ranges::sort(delivered);
+    EXPECT_TRUE(std::ranges::equal(delivered, std::views::iota(std::size_t{0}, std::size_t{4})));
+}
+
+TEST_F(mpi_shard_executor_test, shard_message) {
+    std::vector<shard_hit> const hits{{3, 0}, {3, 1}, {3, 2}};
+    libjst::tree_stats stats{.node_count = 5, .subtree_count = 2, .leaf_count = 3, .symbol_count = 40};
+    stats.max_subtree_depth = 4;
+    stats.subtree_depths = {4, 1};
+    stats.metrics.trim.nodes_created = 7;
+
+    libjst::detail::shard_message message{};
+    message.write_value(int64_t{3});
+    message.write(std::span<shard_hit const>{hits});
+    message.write_stats(stats);
+
+    libjst::detail::shard_message received{message.bytes()};
+    EXPECT_EQ(received.read_value<int64_t>(), 3);
+    EXPECT_EQ(received.read<shard_hit>(), hits);
+    libjst::tree_stats const received_stats = received.read_stats();
+    EXPECT_EQ(received_stats.node_count, 5u);
+    EXPECT_EQ(received_stats.subtree_count, 2u);
+    EXPECT_EQ(received_stats.leaf_count, 3u);
+    EXPECT_EQ(received_stats.symbol_count, 40u);
+    EXPECT_EQ(received_stats.max_subtree_depth, 4u);
+    EXPECT_EQ(received_stats.subtree_depths, (std::vector<std::size_t>{4, 1}));
+    EXPECT_EQ(received_stats.metrics.trim.nodes_created, 7u);
+    EXPECT_THROW(received.read_value<int64_t>(), std::runtime_error);
+}
@@ -0,0 +1,204 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <ranges>
+#include <string>
+#include <vector>
+
+#include <libjst/matcher/shift_or_matcher.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/sequence_tree/volatile_tree.hpp>
+#include <libjst/traversal/label_batch.hpp>
+#include <libjst/traversal/offload_traverser.hpp>
+#include <libjst/traversal/state_oblivious_traverser.hpp>
+
+#include "../mock/rcs_store_mock.hpp"
+
+namespace jst::test::offload_traverser {
+
+using source_t = std::string;
+using variant_t = jst::test::variant<uint32_t, source_t, uint32_t, std::vector<uint32_t>>;
+
+struct naive_matcher {
+    source_t needle{};
+
+    constexpr std::size_t window_size() const noexcept {
+        return needle.size();
+    }
+
+    template <typename haystack_t, typename callback_t>
+    constexpr void operator()(haystack_t && haystack, callback_t && callback) const {
+        auto it = std::ranges::begin(haystack);
+        auto last = std::ranges::end(haystack);
+        for (; std::ranges::distance(it, last) >= std::ranges::ssize(needle); ++it) {
+            if (std::ranges::equal(std::ranges::subrange{it, std::ranges::next(it, needle.size())}, needle))
+                callback(it);
+        }
+    }
+};
+
+struct fixture {
+    source_t source{};
+    std::vector<variant_t> variants{};
+    uint32_t coverage_size{};
+    std::vector<source_t> needles{};
+
+    template <typename stream_t, typename this_t>
+        requires std::same_as<std::remove_cvref_t<this_t>, fixture>
+    friend stream_t & operator<<(stream_t & stream, this_t &&) {
+        stream << "fixture";
+        return stream;
+    }
+};
+
+struct test : public ::testing::TestWithParam<fixture> {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using coverage_domain_type = libjst::coverage_domain_t<coverage_type>;
+
+    using cms_t = libjst::dna_compressed_multisequence<source_t, coverage_type>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+    using rcs_store_t = libjst::rcs_store<source_t, cms_t>;
+    rcs_store_t _mock;
+
+    void SetUp() override {
+        _mock = rcs_store_t{GetParam().source, GetParam().coverage_size};
+        coverage_domain_type domain = _mock.variants().coverage_domain();
+
+        std::ranges::for_each(GetParam().variants, [&] (auto var) {
+            _mock.add(cms_value_t{libjst::breakpoint{var.position, var.deletion},
+                                  var.insertion,
+                                  coverage_type{var.coverage, domain}});
+        });
+    }
+
+    rcs_store_t const & get_mock() const noexcept{
+        return _mock;
+    }
+};
+
+} // namespace jst::test::offload_traverser
+
+using namespace std::literals;
+
+using source_t = jst::test::offload_traverser::source_t;
+using fixture = jst::test::offload_traverser::fixture;
+using variant_t = jst::test::offload_traverser::variant_t;
+using naive_matcher = jst::test::offload_traverser::naive_matcher;
+
+struct offload_traverser_test : public jst::test::offload_traverser::test
+{
+    using jst::test::offload_traverser::test::get_mock;
+    using jst::test::offload_traverser::test::GetParam;
+
+    template <typename pattern_t, typename traverser_t>
+    std::vector<source_t> hits(pattern_t pattern, traverser_t const & traverser) const {
+        std::vector<source_t> pattern_hits{};
+        traverser(libjst::volatile_tree{get_mock()}, pattern, [&] (auto && label_it, auto && label) {
+            pattern_hits.emplace_back(std::ranges::begin(label.sequence()), label_it);
+        });
+        std::ranges::sort(pattern_hits);
+        return pattern_hits;
+    }
+};
+
+// Counts the searched batches and forwards them to the host back-end.
+struct counting_backend {
+    std::size_t * batch_count{};
+
+    template <typename pattern_t, typename symbol_t, typename callback_t>
+    void operator()(pattern_t & pattern, libjst::label_batch<symbol_t> const & batch, callback_t && callback) const {
+        ++*batch_count;
+        libjst::host_batch_backend{}(pattern, batch, callback);
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Test case definitions
+// ----------------------------------------------------------------------------
+
+TEST(label_batch_test, append_and_locate) {
+    libjst::label_batch<char> batch{};
+    EXPECT_TRUE(batch.empty());
+
+    batch.append("ACG"s);
+    batch.append(""s);
+    batch.append("TT"s);
+    ASSERT_EQ(batch.size(), 3u);
+    EXPECT_TRUE(std::ranges::equal(batch.symbols(), "ACGTT"s));
+    EXPECT_TRUE(std::ranges::equal(batch.offsets(), std::vector<std::size_t>{0, 3, 3, 5}));
+    EXPECT_TRUE(std::ranges::equal(batch[0], "ACG"s));
+    EXPECT_TRUE(batch[1].empty());
+    EXPECT_TRUE(std::ranges::equal(batch[2], "TT"s));
+
+    EXPECT_EQ(batch.locate(0), (std::pair<std::size_t, std::size_t>{0, 0}));
+    EXPECT_EQ(batch.locate(2), (std::pair<std::size_t, std::size_t>{0, 2}));
+    EXPECT_EQ(batch.locate(3), (std::pair<std::size_t, std::size_t>{2, 0}));
+    EXPECT_EQ(batch.locate(4), (std::pair<std::size_t, std::size_t>{2, 1}));
+
+    batch.clear();
+    EXPECT_TRUE(batch.empty());
+    EXPECT_TRUE(batch.symbols().empty());
+}
+
+TEST_P(offload_traverser_test, host_backend) {
+    for (source_t const & needle : GetParam().needles) {
+        EXPECT_EQ(hits(naive_matcher{needle}, libjst::offload_traverser{}),
+                  hits(naive_matcher{needle}, libjst::state_oblivious_traverser{})) << needle;
+    }
+}
+
+TEST_P(offload_traverser_test, lockstep_backend) {
+    for (source_t const & needle : GetParam().needles) {
+        EXPECT_EQ(hits(libjst::shift_or_matcher{needle}, libjst::offload_traverser{}),
+                  hits(libjst::shift_or_matcher{needle}, libjst::state_oblivious_traverser{})) << needle;
+    }
+}
+
+TEST_P(offload_traverser_test, custom_backend) {
+    std::size_t batch_count{};
+    libjst::offload_traverser<counting_backend> traverser{.backend{&batch_count}};
+    for (source_t const & needle : GetParam().needles) {
+        EXPECT_EQ(hits(naive_matcher{needle}, traverser),
+                  hits(naive_matcher{needle}, libjst::state_oblivious_traverser{})) << needle;
+    }
+    EXPECT_GT(batch_count, 0u);
+}
+
+// ----------------------------------------------------------------------------
+// Test values
+// ----------------------------------------------------------------------------
+
+INSTANTIATE_TEST_SUITE_P(no_variant, offload_traverser_test, testing::Values(fixture{
+    .source{"AAAAGGGGAAAAGGGG"s},
+    .variants{},
+    .coverage_size{2},
+    .needles{"AAGG"s, "AG"s, ""s, "GGGG"s, "GA"s}
+}));
+
+INSTANTIATE_TEST_SUITE_P(snvs, offload_traverser_test, testing::Values(fixture{
+         //  0123456789012345
+    .source{"AAAAGGGGAAAAGGGG"s},
+    .variants{variant_t{.position{1}, .insertion{"G"s}, .deletion{1}, .coverage{0, 1}},
+              variant_t{.position{6}, .insertion{"A"s}, .deletion{1}, .coverage{0, 2}},
+              variant_t{.position{11}, .insertion{"G"s}, .deletion{1}, .coverage{3}}},
+    .coverage_size{4},
+    .needles{"AG"s, "GAG"s, "GA"s, "AGGA"s, "G"s}
+}));
+
+INSTANTIATE_TEST_SUITE_P(indels, offload_traverser_test, testing::Values(fixture{
+         //  0123456789012345
+    .source{"AAAAGGGGAAAAGGGG"s},
+    .variants{variant_t{.position{2}, .insertion{"CC"s}, .deletion{0}, .coverage{0, 1}},
+              variant_t{.position{7}, .insertion{""s}, .deletion{2}, .coverage{1, 2}},
+              variant_t{.position{12}, .insertion{"T"s}, .deletion{1}, .coverage{2}}},
+    .coverage_size{3},
+    .needles{"GA"s, "ACC"s, "GGAA"s, "CG"s, "AT"s}
+}));
@@ -0,0 +1,505 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <numeric>
+#include <ranges>
+#include <stdexcept>
+#include <stop_token>
+#include <string>
+
+#include <libjst/sequence_tree/chunked_tree.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/rcms/store_replicas.hpp>
+#include <libjst/sequence_tree/replicated_chunked_tree.hpp>
+#include <libjst/traversal/chunk_profile.hpp>
+#include <libjst/traversal/parallel_chunk_traverser.hpp>
+#include <libjst/traversal/traversal_budget.hpp>
+
+#include "../mock/rcs_store_mock.hpp"
+
+namespace jst::test::parallel_chunk_traverser {
+
+using source_t = std::string;
+using variant_t = jst::test::variant<uint32_t, source_t, uint32_t, std::vector<uint32_t>>;
+
+struct naive_matcher {
+    source_t needle{};
+
+    constexpr std::size_t window_size() const noexcept {
+        return needle.size();
+    }
+
+    template <typename haystack_t, typename callback_t>
+    constexpr void operator()(haystack_t && haystack, callback_t && callback) const {
+        auto it = std::ranges::begin(haystack);
+        auto last = std::ranges::end(haystack);
+        for (; std::ranges::distance(it, last) >= std::ranges::ssize(needle); ++it) {
+            if (std::ranges::equal(std::ranges::subrange{it, std::ranges::next(it, needle.size())}, needle))
+                callback(it);
+        }
+    }
+};
+
+struct fixture {
+    source_t source{};
+    std::vector<variant_t> variants{};
+    uint32_t coverage_size{};
+    uint32_t chunk_size{};
+    source_t needle{};
+
+    template <typename stream_t, typename this_t>
+        requires std::same_as<std::remove_cvref_t<this_t>, fixture>
+    friend stream_t & operator<<(stream_t & stream, this_t &&) {
+        stream << "fixture";
+        return stream;
+    }
+};
+
+struct test : public ::testing::TestWithParam<fixture> {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using coverage_domain_type = libjst::coverage_domain_t<coverage_type>;
+
+    using cms_t = libjst::dna_compressed_multisequence<source_t, coverage_type>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+    using rcs_store_t = libjst::rcs_store<source_t, cms_t>;
+    rcs_store_t _mock;
+
+    void SetUp() override {
+        _mock = rcs_store_t{GetParam().source, GetParam().coverage_size};
+        coverage_domain_type domain = _mock.variants().coverage_domain();
+
+        std::ranges::for_each(GetParam().variants, [&] (auto var) {
+            _mock.add(cms_value_t{libjst::breakpoint{var.position, var.deletion},
+                                  var.insertion,
+                                  coverage_type{var.coverage, domain}});
+        });
+    }
+
+    rcs_store_t const & get_mock() const noexcept{
+        return _mock;
+    }
+
+    // The reference value is computed by traversing the whole store as a single chunk on a single thread.
+    std::size_t expected_hits() const {
+        auto single_chunk = get_mock() | libjst::chunk(static_cast<uint32_t>(GetParam().source.size()));
+        std::size_t count{};
+        libjst::state_oblivious_traverser{}(single_chunk[0], naive_matcher{GetParam().needle}, [&] (auto &&, auto &&) {
+            ++count;
+        });
+        return count;
+    }
+};
+
+struct hit_counter {
+    std::size_t count{};
+
+    template <typename label_it_t, typename label_t>
+    void operator()(label_it_t &&, label_t &&) {
+        ++count;
+    }
+};
+
+} // namespace jst::test::parallel_chunk_traverser
+
+using namespace std::literals;
+
+using fixture = jst::test::parallel_chunk_traverser::fixture;
+using variant_t = jst::test::parallel_chunk_traverser::variant_t;
+using naive_matcher = jst::test::parallel_chunk_traverser::naive_matcher;
+using hit_counter = jst::test::parallel_chunk_traverser::hit_counter;
+struct parallel_chunk_traverser_test : public jst::test::parallel_chunk_traverser::test
+{
+    using jst::test::parallel_chunk_traverser::test::get_mock;
+    using jst::test::parallel_chunk_traverser::test::GetParam;
+
+    auto make_forest() const noexcept {
+        return get_mock() | libjst::chunk(GetParam().chunk_size);
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Test case definitions
+// ----------------------------------------------------------------------------
+
+TEST_P(parallel_chunk_traverser_test, single_thread) {
+    auto forest = make_forest();
+    libjst::parallel_chunk_traverser traverser{1};
+    auto counters = traverser(forest, naive_matcher{GetParam().needle}, hit_counter{});
+
+    EXPECT_EQ(counters.size(), 1u);
+    EXPECT_EQ(counters[0].count, expected_hits());
+}
+
+TEST_P(parallel_chunk_traverser_test, per_thread) {
+    auto forest = make_forest();
+    libjst::parallel_chunk_traverser traverser{4};
+    auto counters = traverser(forest, naive_matcher{GetParam().needle}, hit_counter{});
+
+    EXPECT_LE(counters.size(), 4u);
+    EXPECT_EQ(std::ranges::size(forest) < 4 ? std::ranges::size(forest) : 4u, counters.size());
+    std::size_t total = std::accumulate(counters.begin(), counters.end(), std::size_t{0},
+                                        [] (std::size_t count, hit_counter const & counter) {
+        return count + counter.count;
+    });
+    EXPECT_EQ(total, expected_hits());
+}
+
+TEST_P(parallel_chunk_traverser_test, ordered) {
+    auto forest = make_forest();
+    libjst::parallel_chunk_traverser traverser{4};
+
+    auto to_label_string = [] (auto &&, auto && label) {
+        std::string str{};
+        for (char c : label.sequence())
+            str.push_back(c);
+        return str;
+    };
+
+    std::vector<std::string> sequential_hits{};
+    libjst::parallel_chunk_traverser{1}.ordered<std::string>(forest, naive_matcher{GetParam().needle}, to_label_string,
+        [&] (std::string hit) { sequential_hits.push_back(std::move(hit)); });
+
+    std::vector<std::string> parallel_hits{};
+    traverser.ordered<std::string>(forest, naive_matcher{GetParam().needle}, to_label_string,
+        [&] (std::string hit) { parallel_hits.push_back(std::move(hit)); });
+
+    EXPECT_EQ(parallel_hits, sequential_hits);
+    EXPECT_EQ(parallel_hits.size(), expected_hits());
+}
+
+TEST_P(parallel_chunk_traverser_test, reorder_window) {
+    auto forest = make_forest();
+    auto to_label_string = [] (auto &&, auto && label) {
+        std::string str{};
+        for (char c : label.sequence())
+            str.push_back(c);
+        return str;
+    };
+
+    std::vector<std::string> sequential_hits{};
+    libjst::parallel_chunk_traverser{1}.ordered<std::string>(forest, naive_matcher{GetParam().needle}, to_label_string,
+        [&] (std::string hit) { sequential_hits.push_back(std::move(hit)); });
+
+    for (std::size_t const window : {1u, 2u, 3u, 0u}) {
+        libjst::parallel_chunk_traverser traverser{4};
+        traverser.set_reorder_window(window);
+        EXPECT_EQ(traverser.reorder_window(), window);
+
+        std::vector<std::string> parallel_hits{};
+        traverser.ordered<std::string>(forest, naive_matcher{GetParam().needle}, to_label_string,
+            [&] (std::string hit) { parallel_hits.push_back(std::move(hit)); });
+        EXPECT_EQ(parallel_hits, sequential_hits) << window;
+    }
+
+    // A failing chunk releases the workers waiting for its delivery.
+    if (expected_hits() > 0) {
+        libjst::parallel_chunk_traverser traverser{4};
+        traverser.set_reorder_window(1);
+        EXPECT_THROW(traverser.ordered<std::string>(forest, naive_matcher{GetParam().needle},
+            [] (auto &&, auto &&) -> std::string { throw std::runtime_error{"hit"}; },
+            [] (std::string) {}), std::runtime_error);
+    }
+}
+
+TEST_P(parallel_chunk_traverser_test, split_chunks) {
+    auto forest = make_forest();
+    libjst::parallel_chunk_traverser traverser{4, 1};
+    auto counters = traverser(forest, naive_matcher{GetParam().needle}, hit_counter{});
+
+    EXPECT_EQ(counters.size(), 4u);
+    std::size_t total = std::accumulate(counters.begin(), counters.end(), std::size_t{0},
+                                        [] (std::size_t count, hit_counter const & counter) {
+        return count + counter.count;
+    });
+    EXPECT_EQ(total, expected_hits());
+}
+
+TEST_P(parallel_chunk_traverser_test, split_chunks_ordered) {
+    auto forest = make_forest();
+
+    std::vector<std::size_t> hits_per_label{};
+    libjst::parallel_chunk_traverser{4, 1}.ordered<std::size_t>(forest, naive_matcher{GetParam().needle},
+        [] (auto &&, auto &&) { return std::size_t{1}; },
+        [&] (std::size_t hit) { hits_per_label.push_back(hit); });
+
+    EXPECT_EQ(hits_per_label.size(), expected_hits());
+}
+
+TEST_P(parallel_chunk_traverser_test, chunk_arena) {
+    auto forest = make_forest();
+    libjst::parallel_chunk_traverser traverser{4};
+    EXPECT_FALSE(traverser.uses_chunk_arena());
+    traverser.use_chunk_arena(true);
+    EXPECT_TRUE(traverser.uses_chunk_arena());
+
+    auto to_label_string = [] (auto &&, auto && label) {
+        std::string str{};
+        for (char c : label.sequence())
+            str.push_back(c);
+        return str;
+    };
+
+    std::vector<std::string> sequential_hits{};
+    libjst::parallel_chunk_traverser{1}.ordered<std::string>(forest, naive_matcher{GetParam().needle}, to_label_string,
+        [&] (std::string hit) { sequential_hits.push_back(std::move(hit)); });
+
+    std::vector<std::string> arena_hits{};
+    traverser.ordered<std::string>(forest, naive_matcher{GetParam().needle}, to_label_string,
+        [&] (std::string hit) { arena_hits.push_back(std::move(hit)); });
+
+    EXPECT_EQ(arena_hits, sequential_hits);
+
+    auto counters = traverser(forest, naive_matcher{GetParam().needle}, hit_counter{});
+    std::size_t total = std::accumulate(counters.begin(), counters.end(), std::size_t{0},
+                                        [] (std::size_t count, hit_counter const & counter) {
+        return count + counter.count;
+    });
+    EXPECT_EQ(total, expected_hits());
+}
+
+TEST_P(parallel_chunk_traverser_test, replicated) {
+    // Two nodes without CPUs, to which the workers are assigned but not bound.
+    libjst::store_replicas replicas{get_mock(), libjst::numa_topology{std::vector<std::vector<unsigned>>(2)}};
+    ASSERT_EQ(replicas.size(), 2u);
+    EXPECT_NE(&replicas[0], &replicas[1]);
+    EXPECT_TRUE(std::ranges::equal(replicas[1].source(), get_mock().source()));
+
+    libjst::replicated_chunked_tree forest{replicas, GetParam().chunk_size};
+    EXPECT_EQ(std::ranges::size(forest), std::ranges::size(make_forest()));
+    EXPECT_EQ(&forest.replica(1).data(), &replicas[1]);
+
+    auto to_label_string = [] (auto &&, auto && label) {
+        std::string str{};
+        for (char c : label.sequence())
+            str.push_back(c);
+        return str;
+    };
+
+    std::vector<std::string> sequential_hits{};
+    libjst::parallel_chunk_traverser{1}.ordered<std::string>(make_forest(), naive_matcher{GetParam().needle},
+        to_label_string, [&] (std::string hit) { sequential_hits.push_back(std::move(hit)); });
+
+    std::vector<std::string> replicated_hits{};
+    libjst::parallel_chunk_traverser{4}.ordered<std::string>(forest, naive_matcher{GetParam().needle},
+        to_label_string, [&] (std::string hit) { replicated_hits.push_back(std::move(hit)); });
+    EXPECT_EQ(replicated_hits, sequential_hits);
+
+    auto counters = libjst::parallel_chunk_traverser{4, 1}(forest, naive_matcher{GetParam().needle}, hit_counter{});
+    std::size_t total = std::accumulate(counters.begin(), counters.end(), std::size_t{0},
+                                        [] (std::size_t count, hit_counter const & counter) {
+        return count + counter.count;
+    });
+    EXPECT_EQ(total, expected_hits());
+}
+
+TEST_P(parallel_chunk_traverser_test, overlapping_chunks) {
+    // The hits within the overlap are owned by the next chunk and must not be reported twice.
+    auto forest = get_mock() | libjst::chunk(GetParam().chunk_size, GetParam().chunk_size);
+
+    auto counters = libjst::parallel_chunk_traverser{4}(forest, naive_matcher{GetParam().needle}, hit_counter{});
+    std::size_t total = std::accumulate(counters.begin(), counters.end(), std::size_t{0},
+                                        [] (std::size_t count, hit_counter const & counter) {
+        return count + counter.count;
+    });
+    EXPECT_EQ(total, expected_hits());
+
+    auto to_label_string = [] (auto &&, auto && label) {
+        std::string str{};
+        for (char c : label.sequence())
+            str.push_back(c);
+        return str;
+    };
+
+    std::vector<std::string> sequential_hits{};
+    libjst::parallel_chunk_traverser{1}.ordered<std::string>(make_forest(), naive_matcher{GetParam().needle},
+        to_label_string, [&] (std::string hit) { sequential_hits.push_back(std::move(hit)); });
+
+    std::vector<std::string> overlapping_hits{};
+    libjst::parallel_chunk_traverser{4}.ordered<std::string>(forest, naive_matcher{GetParam().needle},
+        to_label_string, [&] (std::string hit) { overlapping_hits.push_back(std::move(hit)); });
+    EXPECT_EQ(overlapping_hits, sequential_hits);
+
+    counters = libjst::parallel_chunk_traverser{4, 1}(forest, naive_matcher{GetParam().needle}, hit_counter{});
+    total = std::accumulate(counters.begin(), counters.end(), std::size_t{0},
+                            [] (std::size_t count, hit_counter const & counter) {
+        return count + counter.count;
+    });
+    EXPECT_EQ(total, expected_hits());
+}
+
+TEST_P(parallel_chunk_traverser_test, propagate_exception) {
+    auto forest = make_forest();
+    libjst::parallel_chunk_traverser traverser{4};
+
+    auto throwing_callback = [] (auto &&, auto &&) { throw std::runtime_error{"hit"}; };
+    if (expected_hits() > 0) {
+        EXPECT_THROW(traverser(forest, naive_matcher{GetParam().needle}, throwing_callback), std::runtime_error);
+    }
+}
+
+TEST_P(parallel_chunk_traverser_test, time_budget) {
+    auto forest = make_forest();
+    auto to_label_string = [] (auto &&, auto && label) {
+        std::string str{};
+        for (char c : label.sequence())
+            str.push_back(c);
+        return str;
+    };
+
+    std::vector<std::string> sequential_hits{};
+    libjst::parallel_chunk_traverser{1}.ordered<std::string>(forest, naive_matcher{GetParam().needle}, to_label_string,
+        [&] (std::string hit) { sequential_hits.push_back(std::move(hit)); });
+    std::ranges::sort(sequential_hits);
+
+    // An expired budget skips all chunks.
+    std::stop_source expired_source{};
+    expired_source.request_stop();
+    libjst::traversal_budget const expired_budget{expired_source.get_token()};
+    libjst::parallel_checkpoint checkpoint{};
+    libjst::parallel_chunk_traverser traverser{4};
+    traverser.set_budget(expired_budget, checkpoint);
+    auto counters = traverser(forest, naive_matcher{GetParam().needle}, hit_counter{});
+    EXPECT_TRUE(std::ranges::all_of(counters, [] (hit_counter const & counter) { return counter.count == 0; }));
+    ASSERT_EQ(checkpoint.tasks.size(), std::ranges::size(forest));
+    for (std::size_t chunk_idx = 0; chunk_idx < checkpoint.tasks.size(); ++chunk_idx)
+        EXPECT_EQ(checkpoint.tasks[chunk_idx], (libjst::parallel_checkpoint::task{chunk_idx, chunk_idx + 1}));
+
+    // A search stopped after the first hit is completed by resuming from its checkpoint.
+    std::stop_source stop_source{};
+    libjst::traversal_budget const budget{stop_source.get_token(), 1};
+    libjst::parallel_chunk_traverser interrupted{4};
+    interrupted.set_budget(budget, checkpoint);
+    std::vector<std::string> hits{};
+    interrupted.ordered<std::string>(forest, naive_matcher{GetParam().needle},
+        [&] (auto && label_it, auto && label) {
+            stop_source.request_stop();
+            return to_label_string(label_it, label);
+        },
+        [&] (std::string hit) { hits.push_back(std::move(hit)); });
+    EXPECT_EQ(checkpoint.empty(), sequential_hits.empty());
+    EXPECT_LE(hits.size(), sequential_hits.size());
+
+    libjst::parallel_chunk_traverser resumed{4};
+    resumed.resume_from(checkpoint);
+    resumed.ordered<std::string>(forest, naive_matcher{GetParam().needle}, to_label_string,
+        [&] (std::string hit) { hits.push_back(std::move(hit)); });
+    std::ranges::sort(hits);
+    EXPECT_EQ(hits, sequential_hits);
+}
+
+TEST_P(parallel_chunk_traverser_test, profile) {
+    auto forest = make_forest();
+    std::size_t const source_size = GetParam().source.size();
+    auto expect_partition = [&] (libjst::chunk_profile const & profile) {
+        ASSERT_FALSE(profile.empty());
+        EXPECT_EQ(profile.chunks().front().begin, 0u);
+        EXPECT_EQ(profile.chunks().back().end, source_size);
+        for (std::size_t idx = 1; idx < profile.size(); ++idx)
+            EXPECT_EQ(profile.chunks()[idx - 1].end, profile.chunks()[idx].begin);
+        for (libjst::chunk_cost const & cost : profile.chunks()) {
+            EXPECT_GT(cost.node_count, 0u);
+            EXPECT_GE(cost.symbol_count, cost.end - cost.begin);
+            EXPECT_GT(cost.max_depth, 0u);
+            EXPECT_GE(cost.wall_time, 0.0);
+        }
+        EXPECT_EQ(profile.total().hit_count, expected_hits());
+    };
+
+    libjst::chunk_profile profile{};
+    libjst::parallel_chunk_traverser traverser{4};
+    traverser.set_profile(profile);
+    traverser(forest, naive_matcher{GetParam().needle}, hit_counter{});
+    EXPECT_EQ(profile.size(), std::ranges::size(forest));
+    expect_partition(profile);
+
+    // The ordered delivery records the same costs, and the profile is cleared before every search.
+    libjst::chunk_profile ordered_profile{};
+    traverser.set_profile(ordered_profile);
+    for (int run = 0; run < 2; ++run)
+        traverser.ordered<std::size_t>(forest, naive_matcher{GetParam().needle},
+            [] (auto &&, auto &&) { return std::size_t{1}; },
+            [] (std::size_t) {});
+    ASSERT_EQ(ordered_profile.size(), profile.size());
+    for (std::size_t idx = 0; idx < profile.size(); ++idx) {
+        EXPECT_EQ(ordered_profile.chunks()[idx].node_count, profile.chunks()[idx].node_count);
+        EXPECT_EQ(ordered_profile.chunks()[idx].symbol_count, profile.chunks()[idx].symbol_count);
+        EXPECT_EQ(ordered_profile.chunks()[idx].hit_count, profile.chunks()[idx].hit_count);
+    }
+
+    // Tasks skipped by an expired budget are not recorded.
+    std::stop_source expired_source{};
+    expired_source.request_stop();
+    libjst::traversal_budget const expired_budget{expired_source.get_token()};
+    libjst::parallel_checkpoint checkpoint{};
+    traverser.set_budget(expired_budget, checkpoint);
+    traverser(forest, naive_matcher{GetParam().needle}, hit_counter{});
+    EXPECT_TRUE(ordered_profile.empty());
+
+    libjst::chunk_profile split_profile{};
+    libjst::parallel_chunk_traverser split_traverser{4, 1};
+    split_traverser.set_profile(split_profile);
+    split_traverser(forest, naive_matcher{GetParam().needle}, hit_counter{});
+    expect_partition(split_profile);
+}
+
+// ----------------------------------------------------------------------------
+// Test values
+// ----------------------------------------------------------------------------
+
+INSTANTIATE_TEST_SUITE_P(no_variant_single_chunk, parallel_chunk_traverser_test, testing::Values(fixture{
+    .source{"AAAAGGGG"s},
+    .variants{},
+    .coverage_size{4},
+    .chunk_size{8},
+    .needle{"AG"s}
+}));
+
+INSTANTIATE_TEST_SUITE_P(no_variant_many_chunks, parallel_chunk_traverser_test, testing::Values(fixture{
+    .source{"AAAAGGGGAAAAGGGG"s},
+    .variants{},
+    .coverage_size{2},
+    .chunk_size{3},
+    .needle{"AAGG"s}
+}));
+
+INSTANTIATE_TEST_SUITE_P(snvs_many_chunks, parallel_chunk_traverser_test, testing::Values(fixture{
+         //  0123456789012345
+    .source{"AAAAGGGGAAAAGGGG"s},
+    .variants{variant_t{.position{1}, .insertion{"G"s}, .deletion{1}, .coverage{0, 1}},
+              variant_t{.position{6}, .insertion{"A"s}, .deletion{1}, .coverage{0, 2}},
+              variant_t{.position{11}, .insertion{"G"s}, .deletion{1}, .coverage{3}}},
+    .coverage_size{4},
+    .chunk_size{4},
+    .needle{"AG"s}
+}));
+
+INSTANTIATE_TEST_SUITE_P(indels_many_chunks, parallel_chunk_traverser_test, testing::Values(fixture{
+         //  0123456789012345
+    .source{"AAAAGGGGAAAAGGGG"s},
+    .variants{variant_t{.position{2}, .insertion{"CC"s}, .deletion{0}, .coverage{0, 1}},
+              variant_t{.position{7}, .insertion{""s}, .deletion{2}, .coverage{1, 2}},
+              variant_t{.position{12}, .insertion{"T"s}, .deletion{1}, .coverage{2}}},
+    .coverage_size{3},
+    .chunk_size{5},
+    .needle{"GA"s}
+}));
+
+INSTANTIATE_TEST_SUITE_P(deletions_wide_chunks, parallel_chunk_traverser_test, testing::Values(fixture{
+         //  01234567890123456789012345678901
+    .source{"ACGTACGTACGTACGTACGTACGTACGTACGT"s},
+    .variants{variant_t{.position{4}, .insertion{""s}, .deletion{1}, .coverage{1}},
+              variant_t{.position{8}, .insertion{""s}, .deletion{2}, .coverage{0, 2}},
+              variant_t{.position{19}, .insertion{"A"s}, .deletion{1}, .coverage{0, 1}},
+              variant_t{.position{24}, .insertion{""s}, .deletion{2}, .coverage{1, 2}}},
+    .coverage_size{3},
+    .chunk_size{16},
+    .needle{"TGTA"s}
+}));
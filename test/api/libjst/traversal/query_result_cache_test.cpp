@@ -0,0 +1,153 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/matcher/shift_or_matcher.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/sequence_tree/volatile_tree.hpp>
+#include <libjst/traversal/query_result_cache.hpp>
+#include <libjst/traversal/search_session.hpp>
+
+using namespace std::literals;
+
+using cache_t = libjst::query_result_cache<uint32_t>;
+
+TEST(query_result_cache_test, find_and_insert)
+{
+    cache_t cache{1 << 16};
+    libjst::query_cache_key key{0, "ACGT"s, 1, 0};
+
+    EXPECT_EQ(cache.find(key), nullptr);
+    cache.insert(key, {3, 1, 4});
+    ASSERT_NE(cache.find(key), nullptr);
+    EXPECT_EQ(*cache.find(key), (std::vector<uint32_t>{3, 1, 4}));
+    EXPECT_EQ(cache.size(), 1u);
+    EXPECT_EQ(cache.hit_count(), 2u);
+    EXPECT_EQ(cache.miss_count(), 1u);
+
+    // Every component of the key distinguishes the queries.
+    EXPECT_EQ(cache.find(libjst::query_cache_key{0, "ACGA"s, 1, 0}), nullptr);
+    EXPECT_EQ(cache.find(libjst::query_cache_key{0, "ACGT"s, 2, 0}), nullptr);
+    EXPECT_EQ(cache.find(libjst::query_cache_key{0, "ACGT"s, 1, 7}), nullptr);
+
+    // Inserting the same query replaces its hits.
+    cache.insert(key, {5});
+    EXPECT_EQ(*cache.find(key), (std::vector<uint32_t>{5}));
+    EXPECT_EQ(cache.size(), 1u);
+
+    cache.clear();
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT_EQ(cache.memory_usage(), 0u);
+}
+
+TEST(query_result_cache_test, lru_eviction)
+{
+    std::vector<uint32_t> const hits(100, 1u);
+    cache_t probe{1 << 20};
+    probe.insert(libjst::query_cache_key{0, "AAAA"s, 0, 0}, hits);
+    std::size_t const entry_bytes = probe.memory_usage();
+
+    cache_t cache{3 * entry_bytes};
+    auto key = [] (std::string pattern) { return libjst::query_cache_key{0, std::move(pattern), 0, 0}; };
+    cache.insert(key("AAAA"), hits);
+    cache.insert(key("CCCC"), hits);
+    cache.insert(key("GGGG"), hits);
+    EXPECT_EQ(cache.size(), 3u);
+
+    // Using the first two queries makes the third one the least recently used.
+    EXPECT_NE(cache.find(key("CCCC")), nullptr);
+    EXPECT_NE(cache.find(key("AAAA")), nullptr);
+    cache.insert(key("TTTT"), hits);
+    EXPECT_EQ(cache.size(), 3u);
+    EXPECT_EQ(cache.eviction_count(), 1u);
+    EXPECT_EQ(cache.find(key("GGGG")), nullptr);
+    EXPECT_NE(cache.find(key("CCCC")), nullptr);
+    EXPECT_LE(cache.memory_usage(), cache.memory_budget());
+
+    // A hit list exceeding the budget is returned but not cached.
+    auto large = cache.insert(key("ACGT"), std::vector<uint32_t>(10000, 2u));
+    EXPECT_EQ(large->size(), 10000u);
+    EXPECT_EQ(cache.find(key("ACGT")), nullptr);
+    EXPECT_EQ(cache.size(), 3u);
+}
+
+TEST(query_result_cache_test, epochs)
+{
+    cache_t cache{1 << 16};
+    cache.insert(libjst::query_cache_key{1, "ACGT"s, 0, 0}, {1});
+    cache.insert(libjst::query_cache_key{1, "CCGT"s, 0, 0}, {2});
+    EXPECT_EQ(cache.epoch(), 1u);
+
+    // A newer epoch invalidates the hits of the older ones.
+    EXPECT_EQ(cache.find(libjst::query_cache_key{2, "ACGT"s, 0, 0}), nullptr);
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT_EQ(cache.memory_usage(), 0u);
+
+    // Hits of an older epoch are not cached.
+    cache.insert(libjst::query_cache_key{1, "ACGT"s, 0, 0}, {1});
+    EXPECT_EQ(cache.size(), 0u);
+    EXPECT_EQ(cache.epoch(), 2u);
+}
+
+TEST(query_result_cache_test, fingerprint)
+{
+    std::vector<uint32_t> const samples{1, 5, 7};
+    EXPECT_EQ(libjst::query_cache_key::fingerprint(samples), libjst::query_cache_key::fingerprint(samples));
+    EXPECT_NE(libjst::query_cache_key::fingerprint(samples),
+              libjst::query_cache_key::fingerprint(std::vector<uint32_t>{1, 5}));
+    EXPECT_NE(libjst::query_cache_key::fingerprint(std::vector<uint32_t>{1, 2}),
+              libjst::query_cache_key::fingerprint(std::vector<uint32_t>{2, 1}));
+}
+
+TEST(query_result_cache_test, fetch_search)
+{
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using cms_type = libjst::dna_compressed_multisequence<std::string, coverage_type>;
+    using store_type = libjst::rcs_store<std::string, cms_type>;
+    using value_type = std::ranges::range_value_t<cms_type>;
+
+    std::mt19937_64 generator{42};
+    std::string source(2000, 'A');
+    std::ranges::generate(source, [&] () { return "ACGT"[generator() % 4]; });
+    store_type store{source, 8};
+    auto domain = store.variants().coverage_domain();
+    for (uint32_t position = 10; position + 10 < source.size(); position += 7)
+        store.add(value_type{libjst::breakpoint{position, 1u}, std::string(1, source[position] == 'A' ? 'C' : 'A'),
+                             coverage_type{{static_cast<uint32_t>(generator() % 8)}, domain}});
+
+    libjst::search_session session{};
+    cache_t cache{1 << 20};
+    auto const tree = libjst::volatile_tree{store};
+    auto search = [&] (std::string const & needle) {
+        std::vector<uint32_t> hits{};
+        session(tree, libjst::shift_or_matcher{needle}, [&] (auto && it, auto && label) {
+            hits.push_back(static_cast<uint32_t>(std::ranges::distance(std::ranges::begin(label.sequence()), it)));
+        });
+        std::ranges::sort(hits);
+        return hits;
+    };
+
+    for (int repetition = 0; repetition < 3; ++repetition) {
+        for (std::string const & needle : {"ACGTA"s, "GATTACA"s}) {
+            auto hits = cache.fetch(libjst::query_cache_key{0, needle, 0, 0}, [&] { return search(needle); });
+            EXPECT_EQ(*hits, search(needle));
+        }
+    }
+    // Only the first repetition traversed the tree, the others were answered by the cache.
+    EXPECT_EQ(cache.miss_count(), 2u);
+    EXPECT_EQ(cache.hit_count(), 4u);
+    EXPECT_EQ(session.query_count(), 2u + 6u);
+}
@@ -0,0 +1,205 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <ranges>
+#include <span>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/mapped_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/sequence_tree/partial_tree.hpp>
+#include <libjst/sequence_tree/volatile_tree.hpp>
+#include <libjst/traversal/region_pipeline.hpp>
+#include <libjst/traversal/state_oblivious_traverser.hpp>
+
+namespace jst::test::region_pipeline {
+
+using source_t = std::string;
+
+struct naive_matcher {
+    source_t needle{};
+
+    constexpr std::size_t window_size() const noexcept {
+        return needle.size();
+    }
+
+    template <typename haystack_t, typename callback_t>
+    constexpr void operator()(haystack_t && haystack, callback_t && callback) const {
+        auto it = std::ranges::begin(haystack);
+        auto last = std::ranges::end(haystack);
+        for (; std::ranges::distance(it, last) >= std::ranges::ssize(needle); ++it) {
+            if (std::ranges::equal(std::ranges::subrange{it, std::ranges::next(it, needle.size())}, needle))
+                callback(it);
+        }
+    }
+};
+
+// A loaded region that can not be moved and counts the instances alive at the same time.
+struct pinned_region {
+    inline static std::atomic<std::size_t> alive_count{};
+    inline static std::atomic<std::size_t> max_alive_count{};
+
+    std::size_t region{};
+    std::thread::id loader_id{std::this_thread::get_id()};
+
+    explicit pinned_region(std::size_t const region) : region{region} {
+        std::size_t const count = ++alive_count;
+        std::size_t max_count = max_alive_count.load();
+        while (count > max_count && !max_alive_count.compare_exchange_weak(max_count, count))
+        {}
+    }
+
+    pinned_region(pinned_region &&) = delete;
+
+    ~pinned_region() {
+        --alive_count;
+    }
+
+    static void reset() {
+        alive_count = 0;
+        max_alive_count = 0;
+    }
+};
+
+} // namespace jst::test::region_pipeline
+
+using namespace std::literals;
+
+using naive_matcher = jst::test::region_pipeline::naive_matcher;
+using pinned_region = jst::test::region_pipeline::pinned_region;
+using source_t = jst::test::region_pipeline::source_t;
+
+// ----------------------------------------------------------------------------
+// Test case definitions
+// ----------------------------------------------------------------------------
+
+TEST(region_pipeline_test, buffer_count) {
+    EXPECT_EQ(libjst::region_pipeline{}.buffer_count(), 2u);
+    EXPECT_EQ(libjst::region_pipeline{0}.buffer_count(), 1u);
+    EXPECT_EQ(libjst::region_pipeline{4}.buffer_count(), 4u);
+}
+
+TEST(region_pipeline_test, ordered_and_bounded) {
+    std::vector<std::size_t> const regions{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+
+    for (std::size_t buffer_count : {1u, 2u, 3u}) {
+        pinned_region::reset();
+        std::vector<std::size_t> processed{};
+        bool loaded_ahead{false};
+        libjst::region_pipeline{buffer_count}(regions,
+            [] (std::size_t const region) {
+                std::this_thread::sleep_for(std::chrono::microseconds{100});
+                return pinned_region{region};
+            },
+            [&] (std::size_t const region, pinned_region & loaded) {
+                EXPECT_EQ(loaded.region, region);
+                EXPECT_EQ(loaded.loader_id == std::this_thread::get_id(), buffer_count == 1);
+                std::this_thread::sleep_for(std::chrono::microseconds{200});
+                loaded_ahead |= pinned_region::alive_count > 1;
+                processed.push_back(region);
+            });
+
+        EXPECT_EQ(processed, regions);
+        EXPECT_LE(pinned_region::max_alive_count, buffer_count);
+        EXPECT_EQ(pinned_region::alive_count, 0u);
+        EXPECT_EQ(loaded_ahead, buffer_count > 1);
+    }
+}
+
+TEST(region_pipeline_test, load_error) {
+    std::vector<std::size_t> const regions{0, 1, 2, 3, 4, 5};
+    std::vector<std::size_t> processed{};
+    auto load = [] (std::size_t const region) -> std::size_t {
+        if (region == 3)
+            throw std::runtime_error{"load"};
+        return region;
+    };
+
+    for (std::size_t buffer_count : {1u, 2u}) {
+        processed.clear();
+        EXPECT_THROW(libjst::region_pipeline{buffer_count}(regions, load, [&] (std::size_t region, std::size_t) {
+            processed.push_back(region);
+        }), std::runtime_error);
+        EXPECT_EQ(processed, (std::vector<std::size_t>{0, 1, 2}));
+    }
+}
+
+TEST(region_pipeline_test, process_error) {
+    std::vector<std::size_t> const regions(100, 0);
+    std::atomic<std::size_t> load_count{};
+    EXPECT_THROW(libjst::region_pipeline{2}(regions,
+        [&] (std::size_t const region) { ++load_count; return region; },
+        [] (std::size_t, std::size_t) { throw std::logic_error{"process"}; }), std::logic_error);
+    EXPECT_LE(load_count, 2u);
+}
+
+TEST(region_pipeline_test, mapped_regions) {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using cms_type = libjst::dna_compressed_multisequence<source_t, coverage_type>;
+    using value_type = std::ranges::range_value_t<cms_type>;
+    using store_type = libjst::rcs_store<source_t, cms_type>;
+
+    std::mt19937 random_engine{7};
+    std::uniform_int_distribution<int> symbol_distribution{0, 3};
+    constexpr std::string_view dna{"ACGT"};
+    source_t source(4000, 'A');
+    std::ranges::generate(source, [&] { return dna[symbol_distribution(random_engine)]; });
+
+    libjst::coverage_domain_t<coverage_type> domain{0, 4};
+    std::vector<value_type> snvs{};
+    for (uint32_t position = 5; position < source.size() - 5; position += 23)
+        snvs.push_back(value_type{libjst::breakpoint{position, 1},
+                                  source_t{dna[(dna.find(source[position]) + 1) % 4]},
+                                  coverage_type{{position % 4}, domain}});
+    store_type store{source, 4, snvs};
+
+    std::ostringstream ostream{};
+    libjst::save_mapped(ostream, store);
+    std::string const bytes = ostream.str();
+    std::vector<uint64_t> layout((bytes.size() + 7) / 8);
+    std::memcpy(layout.data(), bytes.data(), bytes.size());
+    libjst::mapped_compressed_multisequence<> mapped{std::as_bytes(std::span{layout})};
+
+    naive_matcher const matcher{"ACGTA"s};
+    std::size_t expected_hits{};
+    libjst::state_oblivious_traverser{}(libjst::volatile_tree{store}, matcher, [&] (auto &&, auto &&) {
+        ++expected_hits;
+    });
+    ASSERT_GT(expected_hits, 0u);
+
+    // The loaded region covers the paths extending beyond the end of the searched bin.
+    std::vector<std::pair<std::size_t, std::size_t>> bins{};
+    for (std::size_t begin = 0; begin < source.size(); begin += 500)
+        bins.emplace_back(begin, std::min(begin + 500, source.size()));
+
+    std::size_t actual_hits{};
+    libjst::region_pipeline{}(bins,
+        [&] (std::pair<std::size_t, std::size_t> const & bin) {
+            return libjst::load_region(mapped, bin.first, std::min(bin.second + matcher.window_size(), source.size()));
+        },
+        [&] (std::pair<std::size_t, std::size_t> const & bin, auto const & region_store) {
+            libjst::partial_tree tree{region_store, static_cast<uint32_t>(bin.first),
+                                      static_cast<uint32_t>(bin.second - bin.first)};
+            libjst::state_oblivious_traverser{}(tree, matcher, [&] (auto &&, auto &&) { ++actual_hits; });
+        });
+    EXPECT_EQ(actual_hits, expected_hits);
+}
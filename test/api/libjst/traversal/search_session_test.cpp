@@ -0,0 +1,181 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory_resource>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/matcher/shift_or_matcher.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/sequence_tree/volatile_tree.hpp>
+#include <libjst/traversal/search_session.hpp>
+#include <libjst/traversal/stack_publisher.hpp>
+#include <libjst/traversal/state_capture_traverser.hpp>
+#include <libjst/traversal/state_oblivious_traverser.hpp>
+
+namespace jst::test::search_session {
+
+using source_t = std::string;
+
+struct test : public ::testing::Test {
+    // The coverages are copied into the pool of the session as well.
+    using coverage_type = libjst::bit_coverage<uint32_t, libjst::arena_allocator<uint64_t>>;
+    using coverage_domain_type = libjst::coverage_domain_t<coverage_type>;
+
+    using cms_t = libjst::dna_compressed_multisequence<source_t, coverage_type>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+    using rcs_store_t = libjst::rcs_store<source_t, cms_t>;
+
+    static constexpr uint32_t haplotype_count{16};
+
+    rcs_store_t _store;
+
+    void SetUp() override {
+        std::mt19937 random_engine{42};
+        std::uniform_int_distribution<int> symbol_distribution{0, 3};
+        constexpr std::string_view dna{"ACGT"};
+
+        source_t source(3000, 'A');
+        std::ranges::generate(source, [&] { return dna[symbol_distribution(random_engine)]; });
+        _store = rcs_store_t{source, haplotype_count};
+        coverage_domain_type domain = _store.variants().coverage_domain();
+
+        std::bernoulli_distribution coverage_distribution{0.3};
+        for (uint32_t position = 10; position < source.size() - 10; position += 5) {
+            std::vector<uint32_t> haplotypes{};
+            for (uint32_t haplotype = 0; haplotype < haplotype_count; ++haplotype)
+                if (coverage_distribution(random_engine))
+                    haplotypes.push_back(haplotype);
+            if (haplotypes.empty())
+                haplotypes.push_back(0);
+
+            char const alt = dna[(dna.find(source[position]) + 1) % 4];
+            _store.add(cms_value_t{libjst::breakpoint{position, 1}, source_t{alt}, coverage_type{haplotypes, domain}});
+        }
+    }
+
+    rcs_store_t const & store() const noexcept {
+        return _store;
+    }
+
+    template <typename traverser_t>
+    std::vector<source_t> expected_hits(traverser_t const & traverser, source_t const & needle) const {
+        std::vector<source_t> hits{};
+        traverser(libjst::volatile_tree{store()}, libjst::shift_or_matcher{needle}, [&] (auto && it, auto && label) {
+            hits.emplace_back(std::ranges::begin(label.sequence()), it);
+        });
+        std::ranges::sort(hits);
+        return hits;
+    }
+};
+
+} // namespace jst::test::search_session
+
+using namespace std::literals;
+
+using source_t = jst::test::search_session::source_t;
+
+struct search_session_test : public jst::test::search_session::test
+{};
+
+// ----------------------------------------------------------------------------
+// Test case definitions
+// ----------------------------------------------------------------------------
+
+TEST_F(search_session_test, hits) {
+    libjst::search_session session{};
+    auto const tree = libjst::volatile_tree{store()};
+
+    for (source_t const & needle : {"ACGTA"s, "CCGATT"s, "GATTACA"s}) {
+        std::vector<source_t> oblivious_hits{};
+        session(tree, libjst::shift_or_matcher{needle}, [&] (auto && it, auto && label) {
+            oblivious_hits.emplace_back(std::ranges::begin(label.sequence()), it);
+        });
+        std::ranges::sort(oblivious_hits);
+        EXPECT_EQ(oblivious_hits, expected_hits(libjst::state_oblivious_traverser{}, needle));
+
+        std::vector<source_t> capture_hits{};
+        session(libjst::state_capture_traverser{}, tree, libjst::shift_or_matcher{needle},
+                [&] (auto && it, auto && label) {
+            capture_hits.emplace_back(std::ranges::begin(label.sequence()), it);
+        });
+        std::ranges::sort(capture_hits);
+        EXPECT_EQ(capture_hits, expected_hits(libjst::state_capture_traverser{}, needle));
+    }
+    EXPECT_EQ(session.query_count(), 6u);
+}
+
+TEST_F(search_session_test, reuses_buffers) {
+    libjst::search_session session{};
+    auto const tree = libjst::volatile_tree{store()};
+    std::size_t hit_count{};
+    auto query = [&] {
+        session(libjst::state_capture_traverser{}, tree, libjst::shift_or_matcher{"ACGTA"s},
+                [&] (auto &&, auto &&) { ++hit_count; });
+        session(tree, libjst::shift_or_matcher{"ACGTA"s}, [&] (auto &&, auto &&) { ++hit_count; });
+    };
+
+    query();
+    std::size_t const warm_allocation_count = session.upstream_allocation_count();
+    std::size_t const warm_bytes = session.upstream_bytes();
+    EXPECT_GT(warm_allocation_count, 0u);
+
+    for (int repetition = 0; repetition < 10; ++repetition)
+        query();
+    EXPECT_EQ(session.upstream_allocation_count(), warm_allocation_count);
+    EXPECT_EQ(session.upstream_bytes(), warm_bytes);
+    EXPECT_EQ(hit_count % 11, 0u);
+
+    session.release();
+    EXPECT_EQ(session.upstream_bytes(), 0u);
+}
+
+TEST_F(search_session_test, subscribers) {
+    libjst::search_session session{};
+    libjst::stack_depth_monitor monitor{};
+    std::size_t hit_count{};
+    session(libjst::state_capture_traverser{}, libjst::volatile_tree{store()}, libjst::shift_or_matcher{"ACGTA"s},
+            [&] (auto &&, auto &&) { ++hit_count; }, monitor);
+
+    EXPECT_EQ(hit_count, expected_hits(libjst::state_capture_traverser{}, "ACGTA"s).size());
+    EXPECT_EQ(monitor.depth(), 0u);
+    EXPECT_GE(monitor.peak_depth(), 1u);
+}
+
+TEST_F(search_session_test, run) {
+    libjst::search_session session{};
+    std::pmr::memory_resource * const enclosing = libjst::active_arena();
+
+    std::pmr::memory_resource * const query_arena = session.run([&] { return libjst::active_arena(); });
+    EXPECT_NE(query_arena, enclosing);
+    EXPECT_EQ(libjst::active_arena(), enclosing);
+    EXPECT_EQ(session.run([&] { return libjst::active_arena(); }), query_arena);
+
+    // The arena is reactivated if the query throws.
+    EXPECT_THROW(session.run([] { throw std::runtime_error{"query failed"}; }), std::runtime_error);
+    EXPECT_EQ(libjst::active_arena(), enclosing);
+    EXPECT_EQ(session.query_count(), 3u);
+    EXPECT_EQ(session.run([] { return 42; }), 42);
+}
+
+TEST_F(search_session_test, thread_search_session) {
+    libjst::search_session & session = libjst::thread_search_session();
+    EXPECT_EQ(&session, &libjst::thread_search_session());
+
+    libjst::search_session * other_session{};
+    std::thread{[&] { other_session = &libjst::thread_search_session(); }}.join();
+    EXPECT_NE(&session, other_session);
+}
@@ -0,0 +1,253 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <ranges>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/matcher/shift_or_matcher.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/rcms/rcs_store_reversed.hpp>
+#include <libjst/sequence_tree/volatile_tree.hpp>
+#include <libjst/traversal/seed_extend_traverser.hpp>
+#include <libjst/traversal/state_capture_traverser.hpp>
+#include <libjst/traversal/tree_traverser_base.hpp>
+
+namespace jst::test::seed_extend_traverser {
+
+using source_t = std::string;
+
+struct variant {
+    uint32_t position{};
+    source_t insertion{};
+    uint32_t deletion{};
+    std::vector<uint32_t> coverage{};
+};
+
+// Remembers the last symbols of the path to find the needles spanning several nodes.
+struct window_matcher {
+    source_t needle{};
+    source_t window{};
+
+    constexpr std::size_t window_size() const noexcept {
+        return needle.size();
+    }
+
+    template <typename haystack_t, typename callback_t>
+    constexpr void operator()(haystack_t && haystack, callback_t && callback) {
+        for (auto it = std::ranges::begin(haystack); it != std::ranges::end(haystack); ++it) {
+            window.push_back(*it);
+            if (window.size() > needle.size())
+                window.erase(window.begin());
+            if (window == needle)
+                callback(it);
+        }
+    }
+
+    source_t capture() const {
+        return window;
+    }
+
+    void restore(source_t state) {
+        window = std::move(state);
+    }
+};
+
+struct fixture {
+    source_t source{};
+    std::vector<variant> variants{};
+    uint32_t coverage_size{};
+    std::vector<source_t> needles{};
+
+    template <typename stream_t, typename this_t>
+        requires std::same_as<std::remove_cvref_t<this_t>, fixture>
+    friend stream_t & operator<<(stream_t & stream, this_t &&) {
+        stream << "fixture";
+        return stream;
+    }
+};
+
+struct test : public ::testing::TestWithParam<fixture> {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using cms_t = libjst::dna_compressed_multisequence<source_t, coverage_type>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+    using rcs_store_t = libjst::rcs_store<source_t, cms_t>;
+    using rcs_store_reverse_t = libjst::rcs_store_reversed<cms_t>;
+    rcs_store_t _store;
+    std::unique_ptr<rcs_store_reverse_t> _reverse_store{};
+
+    void SetUp() override {
+        _store = rcs_store_t{GetParam().source, GetParam().coverage_size};
+        auto domain = _store.variants().coverage_domain();
+        for (variant const & var : GetParam().variants)
+            _store.add(cms_value_t{libjst::breakpoint{var.position, var.deletion},
+                                   var.insertion,
+                                   coverage_type{var.coverage, domain}});
+        _reverse_store = std::make_unique<rcs_store_reverse_t>(_store.variants());
+    }
+
+    // Returns every position of the seekable tree as a candidate.
+    template <typename tree_t>
+    static std::vector<libjst::seed_candidate> all_candidates(tree_t const & tree, std::size_t const window_size) {
+        auto seekable = libjst::seed_extend_traverser::search_tree(tree, window_size);
+        std::vector<libjst::seed_candidate> candidates{};
+        libjst::tree_traverser_base path{seekable};
+        for (auto it = path.begin(); it != path.end(); ++it) {
+            auto && label = *it;
+            for (std::size_t offset = 0; offset < std::ranges::size(label.sequence()); ++offset)
+                candidates.push_back(libjst::seed_candidate{label.position(), offset});
+        }
+        return candidates;
+    }
+
+    // Returns the prefix of the label up to every hit, sorted to compare traversals visiting the nodes in any order.
+    template <typename tree_t, typename matcher_t>
+    static std::vector<source_t> expected_hits(tree_t const & tree, matcher_t matcher) {
+        std::vector<source_t> found{};
+        libjst::state_capture_traverser{}(tree, std::move(matcher), [&] (auto && label_it, auto && label) {
+            auto && sequence = label.sequence();
+            found.emplace_back(std::ranges::begin(sequence), std::ranges::next(label_it));
+        });
+        std::ranges::sort(found);
+        return found;
+    }
+
+    template <typename tree_t, typename matcher_t>
+    static std::vector<std::pair<std::size_t, source_t>> extended_hits(libjst::seed_extend_traverser const & traverser,
+                                                                       tree_t const & tree,
+                                                                       std::span<libjst::seed_candidate const> seeds,
+                                                                       matcher_t matcher) {
+        std::vector<std::pair<std::size_t, source_t>> found{};
+        traverser(tree, seeds, std::move(matcher), [&] (std::size_t const index, auto && label_it, auto && label) {
+            auto && sequence = label.sequence();
+            found.emplace_back(index, source_t{std::ranges::begin(sequence), std::ranges::next(label_it)});
+        });
+        std::ranges::sort(found);
+        return found;
+    }
+
+    static std::vector<source_t> labels_of(std::vector<std::pair<std::size_t, source_t>> const & hits) {
+        std::vector<source_t> labels{};
+        for (auto const & hit : hits)
+            labels.push_back(hit.second);
+        std::ranges::sort(labels);
+        return labels;
+    }
+};
+
+} // namespace jst::test::seed_extend_traverser
+
+using namespace std::literals;
+
+using fixture = jst::test::seed_extend_traverser::fixture;
+using variant = jst::test::seed_extend_traverser::variant;
+using window_matcher = jst::test::seed_extend_traverser::window_matcher;
+using source_t = jst::test::seed_extend_traverser::source_t;
+
+struct seed_extend_traverser_test : public jst::test::seed_extend_traverser::test
+{};
+
+// ----------------------------------------------------------------------------
+// Test case definitions
+// ----------------------------------------------------------------------------
+
+TEST_P(seed_extend_traverser_test, extend_right) {
+    libjst::volatile_tree tree{_store};
+    for (source_t const & needle : GetParam().needles) {
+        std::vector<libjst::seed_candidate> const seeds = all_candidates(tree, needle.size());
+        auto expected = expected_hits(tree, window_matcher{needle});
+        EXPECT_EQ(labels_of(extended_hits({}, tree, seeds, window_matcher{needle})), expected) << needle;
+        EXPECT_EQ(labels_of(extended_hits({}, tree, seeds, libjst::shift_or_matcher{needle})), expected) << needle;
+    }
+}
+
+TEST_P(seed_extend_traverser_test, extend_left) {
+    auto tree = libjst::make_volatile(*_reverse_store);
+    for (source_t needle : GetParam().needles) {
+        std::ranges::reverse(needle);
+        std::vector<libjst::seed_candidate> const seeds = all_candidates(tree, needle.size());
+        EXPECT_EQ(labels_of(extended_hits({}, tree, seeds, window_matcher{needle})),
+                  expected_hits(tree, window_matcher{needle})) << needle;
+    }
+}
+
+TEST_P(seed_extend_traverser_test, batches) {
+    libjst::volatile_tree tree{_store};
+    for (source_t const & needle : GetParam().needles) {
+        std::vector<libjst::seed_candidate> seeds = all_candidates(tree, needle.size());
+        std::ranges::reverse(seeds); // the traverser sorts the candidates by their seek position
+        auto expected = extended_hits({}, tree, seeds, window_matcher{needle});
+        for (std::size_t const batch_size : {0, 1, 3, 1000}) {
+            EXPECT_EQ(extended_hits(libjst::seed_extend_traverser{batch_size}, tree, seeds, window_matcher{needle}),
+                      expected) << needle << " " << batch_size;
+        }
+    }
+}
+
+TEST_P(seed_extend_traverser_test, anchored) {
+    libjst::volatile_tree tree{_store};
+    for (source_t const & needle : GetParam().needles) {
+        std::vector<libjst::seed_candidate> const seeds = all_candidates(tree, needle.size());
+        auto seekable = libjst::seed_extend_traverser::search_tree(tree, needle.size());
+        // A hit of the exact matcher begins at the symbol of its candidate.
+        libjst::seed_extend_traverser{}(tree, seeds, window_matcher{needle}, [&] (std::size_t const index,
+                                                                                 auto &&,
+                                                                                 auto &&) {
+            auto node = seekable.seek(seeds[index].position);
+            auto label = *node;
+            auto && sequence = label.sequence();
+            EXPECT_EQ(*std::ranges::next(std::ranges::begin(sequence), seeds[index].offset), needle.front());
+        });
+    }
+
+    std::size_t count{};
+    libjst::seed_extend_traverser{}(tree, std::span<libjst::seed_candidate const>{}, window_matcher{"A"s},
+                                    [&] (auto &&...) { ++count; });
+    EXPECT_EQ(count, 0u);
+}
+
+// ----------------------------------------------------------------------------
+// Test values
+// ----------------------------------------------------------------------------
+
+INSTANTIATE_TEST_SUITE_P(no_variant, seed_extend_traverser_test, testing::Values(fixture{
+    .source{"AAAAGGGGAAAAGGGG"s},
+    .variants{},
+    .coverage_size{2},
+    .needles{"AAGG"s, "G"s}
+}));
+
+INSTANTIATE_TEST_SUITE_P(snvs, seed_extend_traverser_test, testing::Values(fixture{
+         //  0123456789012345
+    .source{"AAAAGGGGAAAAGGGG"s},
+    .variants{variant{.position{1}, .insertion{"G"s}, .deletion{1}, .coverage{0, 1}},
+              variant{.position{6}, .insertion{"A"s}, .deletion{1}, .coverage{0, 2}},
+              variant{.position{11}, .insertion{"G"s}, .deletion{1}, .coverage{3}}},
+    .coverage_size{4},
+    .needles{"AG"s, "GAGA"s, "AAGG"s, "GAAGGAG"s}
+}));
+
+INSTANTIATE_TEST_SUITE_P(dense_snvs, seed_extend_traverser_test, testing::Values(fixture{
+         //  0123456789012345678901234567890
+    .source{"ACGTACGTACGTACGTACGTACGTACGTACG"s},
+    .variants{variant{.position{3}, .insertion{"A"s}, .deletion{1}, .coverage{0}},
+              variant{.position{4}, .insertion{"T"s}, .deletion{1}, .coverage{1}},
+              variant{.position{5}, .insertion{"G"s}, .deletion{1}, .coverage{2}},
+              variant{.position{6}, .insertion{"C"s}, .deletion{1}, .coverage{3}},
+              variant{.position{7}, .insertion{"A"s}, .deletion{1}, .coverage{4}},
+              variant{.position{20}, .insertion{"T"s}, .deletion{1}, .coverage{0, 4}}},
+    .coverage_size{5},
+    .needles{"ACGT"s, "GTAC"s, "TACGTA"s}
+}));
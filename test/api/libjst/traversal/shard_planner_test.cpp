@@ -0,0 +1,320 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <cereal/archives/binary.hpp>
+#include <cereal/types/vector.hpp>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/sequence_tree/chunked_tree.hpp>
+#include <libjst/sequence_tree/volatile_tree.hpp>
+#include <libjst/traversal/chunk_profile.hpp>
+#include <libjst/traversal/parallel_chunk_traverser.hpp>
+#include <libjst/traversal/shard_planner.hpp>
+#include <libjst/traversal/state_oblivious_traverser.hpp>
+
+namespace jst::test::shard_planner {
+
+using source_t = std::string;
+
+struct naive_matcher {
+    source_t needle{};
+
+    constexpr std::size_t window_size() const noexcept {
+        return needle.size();
+    }
+
+    template <typename haystack_t, typename callback_t>
+    constexpr void operator()(haystack_t && haystack, callback_t && callback) const {
+        auto it = std::ranges::begin(haystack);
+        auto last = std::ranges::end(haystack);
+        for (; std::ranges::distance(it, last) >= std::ranges::ssize(needle); ++it) {
+            if (std::ranges::equal(std::ranges::subrange{it, std::ranges::next(it, needle.size())}, needle))
+                callback(it);
+        }
+    }
+};
+
+// Counts the symbols of all visited labels, which is the work of the traversal.
+struct symbol_counter {
+    std::size_t size{};
+    std::size_t * symbol_count{};
+
+    constexpr std::size_t window_size() const noexcept {
+        return size;
+    }
+
+    template <typename haystack_t, typename callback_t>
+    constexpr void operator()(haystack_t && haystack, callback_t &&) const {
+        *symbol_count += std::ranges::size(haystack);
+    }
+};
+
+struct test : public ::testing::Test {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using coverage_domain_type = libjst::coverage_domain_t<coverage_type>;
+
+    using cms_t = libjst::dna_compressed_multisequence<source_t, coverage_type>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+    using rcs_store_t = libjst::rcs_store<source_t, cms_t>;
+
+    static constexpr std::size_t window_size{8};
+    static constexpr uint32_t haplotype_count{16};
+
+    rcs_store_t _store;
+
+    // A source whose first tenth carries most of the variants. The deletions are kept apart by more than a window,
+    // since the labels of paths over several deletions are not supported yet.
+    void SetUp() override {
+        std::mt19937 random_engine{42};
+        std::uniform_int_distribution<int> symbol_distribution{0, 3};
+        constexpr std::string_view dna{"ACGT"};
+
+        source_t source(20000, 'A');
+        std::ranges::generate(source, [&] { return dna[symbol_distribution(random_engine)]; });
+        _store = rcs_store_t{source, haplotype_count};
+        coverage_domain_type domain = _store.variants().coverage_domain();
+
+        std::bernoulli_distribution coverage_distribution{0.3};
+        std::uniform_int_distribution<int> kind_distribution{0, 9};
+        auto add_variant = [&] (uint32_t const position) {
+            std::vector<uint32_t> haplotypes{};
+            for (uint32_t haplotype = 0; haplotype < haplotype_count; ++haplotype)
+                if (coverage_distribution(random_engine))
+                    haplotypes.push_back(haplotype);
+            if (haplotypes.empty())
+                haplotypes.push_back(0);
+
+            coverage_type coverage{haplotypes, domain};
+            int const kind = kind_distribution(random_engine);
+            if (kind < 8 || position < 2000) { // snv
+                char const alt = dna[(dna.find(source[position]) + 1) % 4];
+                _store.add(cms_value_t{libjst::breakpoint{position, 1}, source_t{alt}, std::move(coverage)});
+            } else if (kind == 8 || position < 2000) { // insertion; deletions only outside of the dense region
+                _store.add(cms_value_t{libjst::breakpoint{position, 0}, source_t{"CGTA"}, std::move(coverage)});
+            } else { // deletion
+                _store.add(cms_value_t{libjst::breakpoint{position, 2}, source_t{}, std::move(coverage)});
+            }
+        };
+
+        for (uint32_t position = 10; position < 2000; position += 3)
+            add_variant(position);
+        for (uint32_t position = 2000; position < source.size() - 10; position += 97)
+            add_variant(position);
+    }
+
+    rcs_store_t const & store() const noexcept {
+        return _store;
+    }
+
+    template <typename tree_t>
+    static std::size_t measure(tree_t && tree) {
+        std::size_t symbol_count{};
+        libjst::state_oblivious_traverser{}((tree_t &&) tree, symbol_counter{window_size, &symbol_count},
+                                            [] (auto &&, auto &&) {});
+        return symbol_count;
+    }
+
+    // Returns the largest relative deviation of the given work from the mean.
+    static double max_deviation(std::vector<std::size_t> const & work) {
+        double const mean = std::accumulate(work.begin(), work.end(), 0.0) / static_cast<double>(work.size());
+        return static_cast<double>(std::ranges::max(work)) / mean - 1.0;
+    }
+};
+
+} // namespace jst::test::shard_planner
+
+using namespace std::literals;
+
+using naive_matcher = jst::test::shard_planner::naive_matcher;
+
+struct shard_planner_test : public jst::test::shard_planner::test
+{};
+
+// ----------------------------------------------------------------------------
+// Test case definitions
+// ----------------------------------------------------------------------------
+
+TEST_F(shard_planner_test, partition) {
+    std::vector<libjst::tree_shard> const shards = libjst::shard_planner{window_size}(store(), 8);
+    ASSERT_EQ(shards.size(), 8u);
+    EXPECT_EQ(shards.front().begin, 0u);
+    EXPECT_EQ(shards.back().end, std::ranges::size(store().source()));
+    for (std::size_t idx = 0; idx < shards.size(); ++idx) {
+        EXPECT_LT(shards[idx].begin, shards[idx].end);
+        EXPECT_EQ(shards[idx].overlap, window_size - 1);
+        if (idx > 0) {
+            EXPECT_EQ(shards[idx - 1].end, shards[idx].begin);
+        }
+    }
+}
+
+TEST_F(shard_planner_test, hits) {
+    std::size_t expected_hits{};
+    libjst::state_oblivious_traverser{}(libjst::volatile_tree{store()}, naive_matcher{"ACGTAC"s}, [&] (auto &&, auto &&) {
+        ++expected_hits;
+    });
+    ASSERT_GT(expected_hits, 0u);
+
+    std::size_t actual_hits{};
+    for (libjst::tree_shard const & shard : libjst::shard_planner{6}(store(), 5)) {
+        libjst::state_oblivious_traverser{}(shard.make_tree(store()), naive_matcher{"ACGTAC"s}, [&] (auto &&, auto &&) {
+            ++actual_hits;
+        });
+    }
+    EXPECT_EQ(actual_hits, expected_hits);
+}
+
+TEST_F(shard_planner_test, balanced_work) {
+    constexpr std::size_t shard_count{8};
+    std::vector<std::size_t> shard_work{};
+    for (libjst::tree_shard const & shard : libjst::shard_planner{window_size}(store(), shard_count))
+        shard_work.push_back(measure(shard.make_tree(store())));
+    ASSERT_EQ(shard_work.size(), shard_count);
+
+    std::vector<std::size_t> chunk_work{};
+    std::size_t const chunk_size = (std::ranges::size(store().source()) + shard_count - 1) / shard_count;
+    for (auto && chunk : libjst::chunk(store(), chunk_size, window_size - 1))
+        chunk_work.push_back(measure(chunk));
+
+    EXPECT_LE(max_deviation(shard_work), 0.1);
+    EXPECT_GT(max_deviation(chunk_work), max_deviation(shard_work));
+}
+
+TEST_F(shard_planner_test, calibrated_work) {
+    constexpr std::size_t shard_count{8};
+    libjst::tree_stats stats{};
+    stats.symbol_count = measure(libjst::volatile_tree{store()});
+
+    std::vector<libjst::tree_shard> const shards = libjst::shard_planner{window_size}(store(), shard_count, stats);
+    std::vector<std::size_t> shard_work{};
+    double estimated_cost{};
+    for (libjst::tree_shard const & shard : shards) {
+        shard_work.push_back(measure(shard.make_tree(store())));
+        estimated_cost += shard.cost;
+    }
+    ASSERT_EQ(shard_work.size(), shard_count);
+    EXPECT_NEAR(estimated_cost, static_cast<double>(stats.symbol_count), 1.0);
+    EXPECT_LE(max_deviation(shard_work), 0.1);
+}
+
+TEST_F(shard_planner_test, profiled_work) {
+    constexpr std::size_t shard_count{8};
+    std::size_t const chunk_size = std::ranges::size(store().source()) / 40;
+    libjst::chunk_profile profile{};
+    libjst::parallel_chunk_traverser traverser{4};
+    traverser.set_profile(profile);
+    traverser(libjst::chunk(store(), chunk_size, window_size - 1),
+              naive_matcher{"ACGTACGT"s}, [] (auto &&, auto &&) {});
+    ASSERT_EQ(profile.size(), 40u);
+
+    libjst::shard_planner const planner{window_size};
+    std::vector<libjst::tree_shard> const shards = planner(store(), shard_count, profile,
+                                                           libjst::chunk_metric::symbol_count);
+    std::vector<std::size_t> shard_work{};
+    double estimated_cost{};
+    for (libjst::tree_shard const & shard : shards) {
+        shard_work.push_back(measure(shard.make_tree(store())));
+        estimated_cost += shard.cost;
+    }
+    ASSERT_EQ(shard_work.size(), shard_count);
+    EXPECT_NEAR(estimated_cost, static_cast<double>(profile.total().symbol_count), 1.0);
+    EXPECT_LE(max_deviation(shard_work), 0.1);
+
+    // A previous run that spent most of its time in the last tenth of the source moves the shards there.
+    std::vector<libjst::chunk_cost> costs = profile.chunks();
+    for (std::size_t idx = 0; idx < costs.size(); ++idx)
+        costs[idx].wall_time = (idx < 36) ? 1.0 : 20.0;
+    std::vector<libjst::tree_shard> const timed_shards = planner(store(), shard_count, libjst::chunk_profile{costs});
+    ASSERT_EQ(timed_shards.size(), shard_count);
+    EXPECT_GE(timed_shards[shard_count / 2].begin, costs[36].begin);
+    EXPECT_EQ(timed_shards.back().end, std::ranges::size(store().source()));
+    EXPECT_GE(planner.tune(store(), 8, libjst::chunk_profile{costs}).size(), 8u);
+}
+
+TEST_F(shard_planner_test, serialise) {
+    std::vector<libjst::tree_shard> const shards = libjst::shard_planner{window_size}(store(), 4);
+
+    std::stringstream archive_stream{};
+    {
+        cereal::BinaryOutputArchive output_archive{archive_stream};
+        output_archive(shards);
+    }
+
+    std::vector<libjst::tree_shard> loaded_shards{};
+    {
+        cereal::BinaryInputArchive input_archive{archive_stream};
+        input_archive(loaded_shards);
+    }
+    EXPECT_EQ(loaded_shards, shards);
+}
+
+TEST_F(shard_planner_test, single_shard) {
+    std::vector<libjst::tree_shard> const shards = libjst::shard_planner{window_size}(store(), 1);
+    ASSERT_EQ(shards.size(), 1u);
+    EXPECT_EQ(shards[0].begin, 0u);
+    EXPECT_EQ(shards[0].end, std::ranges::size(store().source()));
+}
+
+TEST_F(shard_planner_test, invalid_shard_count) {
+    EXPECT_THROW(libjst::shard_planner{window_size}(store(), 0), std::invalid_argument);
+}
+
+TEST_F(shard_planner_test, tune) {
+    libjst::shard_planner const planner{window_size};
+    EXPECT_EQ(planner.tune(store(), 1).size(), 1u);
+
+    std::size_t previous_count{1};
+    for (std::size_t thread_count : {2u, 8u, 32u}) {
+        std::vector<libjst::tree_shard> const shards = planner.tune(store(), thread_count);
+        EXPECT_GE(shards.size(), thread_count);
+        EXPECT_GT(shards.size(), previous_count);
+        EXPECT_EQ(shards.front().begin, 0u);
+        EXPECT_EQ(shards.back().end, std::ranges::size(store().source()));
+        for (std::size_t idx = 1; idx < shards.size(); ++idx)
+            EXPECT_EQ(shards[idx - 1].end, shards[idx].begin);
+        previous_count = shards.size();
+    }
+
+    // The dense region of the variants is covered by shorter shards.
+    std::vector<libjst::tree_shard> const shards = planner.tune(store(), 8);
+    EXPECT_LT(shards.front().end - shards.front().begin, shards.back().end - shards.back().begin);
+
+    // A tiny source is not split into shards shorter than the window.
+    rcs_store_t const tiny_store{std::string(3 * window_size, 'A'), haplotype_count};
+    EXPECT_EQ(planner.tune(tiny_store, 8).size(), 3u);
+}
+
+TEST_F(shard_planner_test, shard_forest) {
+    std::size_t expected_hits{};
+    libjst::state_oblivious_traverser{}(libjst::volatile_tree{store()}, naive_matcher{"ACGTAC"s}, [&] (auto &&, auto &&) {
+        ++expected_hits;
+    });
+    ASSERT_GT(expected_hits, 0u);
+
+    libjst::shard_forest const forest{store(), libjst::shard_planner{6}.tune(store(), 4)};
+    ASSERT_GE(std::ranges::size(forest), 4u);
+    EXPECT_EQ(forest.shard(0).begin, 0u);
+
+    std::vector<std::size_t> hits(std::ranges::size(forest));
+    libjst::parallel_chunk_traverser{4}.ordered<std::size_t>(forest, naive_matcher{"ACGTAC"s},
+        [] (std::size_t const shard_idx, auto &&, auto &&) { return shard_idx; },
+        [&] (std::size_t const shard_idx) { ++hits[shard_idx]; });
+    EXPECT_EQ(std::accumulate(hits.begin(), hits.end(), std::size_t{0}), expected_hits);
+}
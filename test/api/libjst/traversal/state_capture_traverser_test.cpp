@@ -0,0 +1,295 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <ranges>
+#include <string>
+#include <vector>
+
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/sequence_tree/volatile_tree.hpp>
+#include <libjst/traversal/stack_publisher.hpp>
+#include <libjst/traversal/state_capture_traverser.hpp>
+#include <libjst/traversal/state_oblivious_traverser.hpp>
+
+#include "../mock/rcs_store_mock.hpp"
+
+namespace jst::test::state_capture_traverser {
+
+using source_t = std::string;
+using variant_t = jst::test::variant<uint32_t, source_t, uint32_t, std::vector<uint32_t>>;
+
+struct naive_matcher {
+    source_t needle{};
+
+    constexpr std::size_t window_size() const noexcept {
+        return needle.size();
+    }
+
+    template <typename haystack_t, typename callback_t>
+    constexpr void operator()(haystack_t && haystack, callback_t && callback) const {
+        auto it = std::ranges::begin(haystack);
+        auto last = std::ranges::end(haystack);
+        for (; std::ranges::distance(it, last) >= std::ranges::ssize(needle); ++it) {
+            if (std::ranges::equal(std::ranges::subrange{it, std::ranges::next(it, needle.size())}, needle))
+                callback(it);
+        }
+    }
+};
+
+// Remembers the last symbols of the path to find the needles spanning several nodes.
+struct window_matcher {
+    source_t needle{};
+    source_t window{};
+
+    constexpr std::size_t window_size() const noexcept {
+        return needle.size();
+    }
+
+    template <typename haystack_t, typename callback_t>
+    constexpr void operator()(haystack_t && haystack, callback_t && callback) {
+        for (auto it = std::ranges::begin(haystack); it != std::ranges::end(haystack); ++it) {
+            window.push_back(*it);
+            if (window.size() > needle.size())
+                window.erase(window.begin());
+            if (window == needle)
+                callback(it);
+        }
+    }
+
+    source_t capture() const {
+        return window;
+    }
+
+    void restore(source_t state) {
+        window = std::move(state);
+    }
+};
+
+// A multi-word shift-and matcher whose states are stored as deltas.
+struct shift_and_matcher {
+    static constexpr bool delta_encoded_state = true;
+
+    source_t needle{};
+    std::array<std::vector<uint64_t>, 256> masks{};
+    std::vector<uint64_t> state{};
+
+    explicit shift_and_matcher(source_t pattern) : needle{std::move(pattern)}
+    {
+        std::size_t const word_count = (needle.size() + 63) / 64;
+        std::ranges::for_each(masks, [&] (auto & mask) { mask.resize(word_count, 0); });
+        for (std::size_t i = 0; i < needle.size(); ++i)
+            masks[static_cast<unsigned char>(needle[i])][i / 64] |= uint64_t{1} << (i % 64);
+        state.resize(word_count, 0);
+    }
+
+    constexpr std::size_t window_size() const noexcept {
+        return needle.size();
+    }
+
+    template <typename haystack_t, typename callback_t>
+    constexpr void operator()(haystack_t && haystack, callback_t && callback) {
+        std::size_t const last_bit = needle.size() - 1;
+        for (auto it = std::ranges::begin(haystack); it != std::ranges::end(haystack); ++it) {
+            auto const & mask = masks[static_cast<unsigned char>(*it)];
+            uint64_t carry = 1;
+            for (std::size_t word = 0; word < state.size(); ++word) {
+                uint64_t const next_carry = state[word] >> 63;
+                state[word] = ((state[word] << 1) | carry) & mask[word];
+                carry = next_carry;
+            }
+            if ((state[last_bit / 64] >> (last_bit % 64)) & 1)
+                callback(it);
+        }
+    }
+
+    std::vector<uint64_t> const & capture() const noexcept {
+        return state;
+    }
+
+    void restore(std::vector<uint64_t> const & captured) {
+        state = captured;
+    }
+};
+
+struct counting_subscriber {
+    std::size_t push_count{};
+    std::size_t pop_count{};
+
+    void notify_push() noexcept {
+        ++push_count;
+    }
+
+    void notify_pop() noexcept {
+        ++pop_count;
+    }
+};
+
+struct fixture {
+    source_t source{};
+    std::vector<variant_t> variants{};
+    uint32_t coverage_size{};
+    source_t needle{};
+
+    template <typename stream_t, typename this_t>
+        requires std::same_as<std::remove_cvref_t<this_t>, fixture>
+    friend stream_t & operator<<(stream_t & stream, this_t &&) {
+        stream << "fixture";
+        return stream;
+    }
+};
+
+struct test : public ::testing::TestWithParam<fixture> {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using coverage_domain_type = libjst::coverage_domain_t<coverage_type>;
+
+    using cms_t = libjst::dna_compressed_multisequence<source_t, coverage_type>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+    using rcs_store_t = libjst::rcs_store<source_t, cms_t>;
+    rcs_store_t _mock;
+
+    void SetUp() override {
+        _mock = rcs_store_t{GetParam().source, GetParam().coverage_size};
+        coverage_domain_type domain = _mock.variants().coverage_domain();
+
+        std::ranges::for_each(GetParam().variants, [&] (auto var) {
+            _mock.add(cms_value_t{libjst::breakpoint{var.position, var.deletion},
+                                  var.insertion,
+                                  coverage_type{var.coverage, domain}});
+        });
+    }
+
+    rcs_store_t const & get_mock() const noexcept{
+        return _mock;
+    }
+};
+
+} // namespace jst::test::state_capture_traverser
+
+using namespace std::literals;
+
+using fixture = jst::test::state_capture_traverser::fixture;
+using variant_t = jst::test::state_capture_traverser::variant_t;
+using naive_matcher = jst::test::state_capture_traverser::naive_matcher;
+using window_matcher = jst::test::state_capture_traverser::window_matcher;
+using shift_and_matcher = jst::test::state_capture_traverser::shift_and_matcher;
+using counting_subscriber = jst::test::state_capture_traverser::counting_subscriber;
+
+struct state_capture_traverser_test : public jst::test::state_capture_traverser::test
+{
+    using jst::test::state_capture_traverser::test::get_mock;
+    using jst::test::state_capture_traverser::test::GetParam;
+
+    std::size_t expected_hits() const {
+        std::size_t count{};
+        libjst::state_oblivious_traverser{}(libjst::volatile_tree{get_mock()}, naive_matcher{GetParam().needle}, [&] (auto &&, auto &&) {
+            ++count;
+        });
+        return count;
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Test case definitions
+// ----------------------------------------------------------------------------
+
+TEST_P(state_capture_traverser_test, hits) {
+    std::size_t count{};
+    libjst::state_capture_traverser{}(libjst::volatile_tree{get_mock()}, window_matcher{GetParam().needle}, [&] (auto &&, auto &&) {
+        ++count;
+    });
+    EXPECT_EQ(count, expected_hits());
+}
+
+TEST_P(state_capture_traverser_test, delta_encoded_states) {
+    std::size_t count{};
+    libjst::state_capture_traverser{}(libjst::volatile_tree{get_mock()}, shift_and_matcher{GetParam().needle}, [&] (auto &&, auto &&) {
+        ++count;
+    });
+    EXPECT_EQ(count, expected_hits());
+}
+
+TEST_P(state_capture_traverser_test, static_publisher) {
+    auto search_tree = libjst::volatile_tree{get_mock()} | libjst::labelled()
+                                                         | libjst::coloured()
+                                                         | libjst::trim(1u)
+                                                         | libjst::prune_unsupported()
+                                                         | libjst::merge();
+
+    counting_subscriber dynamic_subscriber{};
+    libjst::tree_traverser_base dynamic_path{search_tree};
+    dynamic_path.subscribe(dynamic_subscriber);
+    std::size_t dynamic_node_count{};
+    for (auto it = dynamic_path.begin(); it != dynamic_path.end(); ++it)
+        ++dynamic_node_count;
+
+    counting_subscriber first{};
+    counting_subscriber second{};
+    libjst::tree_traverser_base static_path{search_tree, libjst::static_stack_publisher{first, second}};
+    std::size_t static_node_count{};
+    for (auto it = static_path.begin(); it != static_path.end(); ++it)
+        ++static_node_count;
+
+    EXPECT_EQ(static_node_count, dynamic_node_count);
+    EXPECT_GT(first.push_count, 0u);
+    EXPECT_EQ(first.push_count, dynamic_subscriber.push_count);
+    EXPECT_EQ(first.pop_count, dynamic_subscriber.pop_count);
+    EXPECT_EQ(first.push_count, first.pop_count);
+    EXPECT_EQ(second.push_count, first.push_count);
+    EXPECT_EQ(second.pop_count, first.pop_count);
+}
+
+TEST_P(state_capture_traverser_test, subscribers) {
+    counting_subscriber counter{};
+    libjst::stack_depth_monitor monitor{};
+    std::size_t count{};
+    libjst::state_capture_traverser{}(libjst::volatile_tree{get_mock()}, window_matcher{GetParam().needle},
+                                      [&] (auto &&, auto &&) { ++count; }, counter, monitor);
+
+    EXPECT_EQ(count, expected_hits());
+    EXPECT_GT(counter.push_count, 0u);
+    EXPECT_EQ(counter.push_count, counter.pop_count);
+    EXPECT_EQ(monitor.depth(), 0u);
+    EXPECT_GE(monitor.peak_depth(), 1u);
+    EXPECT_LE(monitor.peak_depth(), counter.push_count);
+}
+
+// ----------------------------------------------------------------------------
+// Test values
+// ----------------------------------------------------------------------------
+
+INSTANTIATE_TEST_SUITE_P(no_variant, state_capture_traverser_test, testing::Values(fixture{
+    .source{"AAAAGGGGAAAAGGGG"s},
+    .variants{},
+    .coverage_size{2},
+    .needle{"AAGG"s}
+}));
+
+INSTANTIATE_TEST_SUITE_P(snvs, state_capture_traverser_test, testing::Values(fixture{
+         //  0123456789012345
+    .source{"AAAAGGGGAAAAGGGG"s},
+    .variants{variant_t{.position{1}, .insertion{"G"s}, .deletion{1}, .coverage{0, 1}},
+              variant_t{.position{6}, .insertion{"A"s}, .deletion{1}, .coverage{0, 2}},
+              variant_t{.position{11}, .insertion{"G"s}, .deletion{1}, .coverage{3}}},
+    .coverage_size{4},
+    .needle{"AG"s}
+}));
+
+INSTANTIATE_TEST_SUITE_P(indels, state_capture_traverser_test, testing::Values(fixture{
+         //  0123456789012345
+    .source{"AAAAGGGGAAAAGGGG"s},
+    .variants{variant_t{.position{2}, .insertion{"CC"s}, .deletion{0}, .coverage{0, 1}},
+              variant_t{.position{7}, .insertion{""s}, .deletion{2}, .coverage{1, 2}},
+              variant_t{.position{12}, .insertion{"T"s}, .deletion{1}, .coverage{2}}},
+    .coverage_size{3},
+    .needle{"GA"s}
+}));
@@ -0,0 +1,173 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <ranges>
+#include <string>
+#include <vector>
+
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/sequence_tree/volatile_tree.hpp>
+#include <libjst/traversal/state_oblivious_batch_traverser.hpp>
+#include <libjst/traversal/state_oblivious_traverser.hpp>
+
+#include "../mock/rcs_store_mock.hpp"
+
+namespace jst::test::state_oblivious_batch_traverser {
+
+using source_t = std::string;
+using variant_t = jst::test::variant<uint32_t, source_t, uint32_t, std::vector<uint32_t>>;
+
+struct naive_matcher {
+    source_t needle{};
+
+    constexpr std::size_t window_size() const noexcept {
+        return needle.size();
+    }
+
+    template <typename haystack_t, typename callback_t>
+    constexpr void operator()(haystack_t && haystack, callback_t && callback) const {
+        auto it = std::ranges::begin(haystack);
+        auto last = std::ranges::end(haystack);
+        for (; std::ranges::distance(it, last) >= std::ranges::ssize(needle); ++it) {
+            if (std::ranges::equal(std::ranges::subrange{it, std::ranges::next(it, needle.size())}, needle))
+                callback(it);
+        }
+    }
+};
+
+struct fixture {
+    source_t source{};
+    std::vector<variant_t> variants{};
+    uint32_t coverage_size{};
+    std::vector<source_t> needles{};
+
+    template <typename stream_t, typename this_t>
+        requires std::same_as<std::remove_cvref_t<this_t>, fixture>
+    friend stream_t & operator<<(stream_t & stream, this_t &&) {
+        stream << "fixture";
+        return stream;
+    }
+};
+
+struct test : public ::testing::TestWithParam<fixture> {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using coverage_domain_type = libjst::coverage_domain_t<coverage_type>;
+
+    using cms_t = libjst::dna_compressed_multisequence<source_t, coverage_type>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+    using rcs_store_t = libjst::rcs_store<source_t, cms_t>;
+    rcs_store_t _mock;
+
+    void SetUp() override {
+        _mock = rcs_store_t{GetParam().source, GetParam().coverage_size};
+        coverage_domain_type domain = _mock.variants().coverage_domain();
+
+        std::ranges::for_each(GetParam().variants, [&] (auto var) {
+            _mock.add(cms_value_t{libjst::breakpoint{var.position, var.deletion},
+                                  var.insertion,
+                                  coverage_type{var.coverage, domain}});
+        });
+    }
+
+    rcs_store_t const & get_mock() const noexcept{
+        return _mock;
+    }
+};
+
+} // namespace jst::test::state_oblivious_batch_traverser
+
+using namespace std::literals;
+
+using source_t = jst::test::state_oblivious_batch_traverser::source_t;
+using fixture = jst::test::state_oblivious_batch_traverser::fixture;
+using variant_t = jst::test::state_oblivious_batch_traverser::variant_t;
+using naive_matcher = jst::test::state_oblivious_batch_traverser::naive_matcher;
+
+struct state_oblivious_batch_traverser_test : public jst::test::state_oblivious_batch_traverser::test
+{
+    using jst::test::state_oblivious_batch_traverser::test::get_mock;
+    using jst::test::state_oblivious_batch_traverser::test::GetParam;
+
+    std::vector<naive_matcher> patterns() const {
+        std::vector<naive_matcher> matchers{};
+        std::ranges::for_each(GetParam().needles, [&] (source_t const & needle) {
+            matchers.push_back(naive_matcher{needle});
+        });
+        return matchers;
+    }
+
+    // The hits of every pattern found by a separate traversal.
+    std::vector<std::vector<source_t>> expected_hits() const {
+        std::vector<std::vector<source_t>> hits{};
+        for (naive_matcher const & pattern : patterns()) {
+            auto & pattern_hits = hits.emplace_back();
+            libjst::state_oblivious_traverser{}(libjst::volatile_tree{get_mock()}, pattern, [&] (auto && label_it, auto && label) {
+                pattern_hits.emplace_back(std::ranges::begin(label.sequence()), label_it);
+            });
+            std::ranges::sort(pattern_hits);
+        }
+        return hits;
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Test case definitions
+// ----------------------------------------------------------------------------
+
+TEST_P(state_oblivious_batch_traverser_test, hits) {
+    std::vector<std::vector<source_t>> hits(GetParam().needles.size());
+    libjst::state_oblivious_batch_traverser{}(libjst::volatile_tree{get_mock()}, patterns(),
+                                              [&] (std::size_t idx, auto && label_it, auto && label) {
+        ASSERT_LT(idx, hits.size());
+        hits[idx].emplace_back(std::ranges::begin(label.sequence()), label_it);
+    });
+    std::ranges::for_each(hits, [] (auto & pattern_hits) { std::ranges::sort(pattern_hits); });
+
+    EXPECT_EQ(hits, expected_hits());
+}
+
+TEST_P(state_oblivious_batch_traverser_test, empty_batch) {
+    std::size_t count{};
+    libjst::state_oblivious_batch_traverser{}(libjst::volatile_tree{get_mock()}, std::vector<naive_matcher>{},
+                                              [&] (std::size_t, auto &&, auto &&) { ++count; });
+    EXPECT_EQ(count, 0u);
+}
+
+// ----------------------------------------------------------------------------
+// Test values
+// ----------------------------------------------------------------------------
+
+INSTANTIATE_TEST_SUITE_P(no_variant, state_oblivious_batch_traverser_test, testing::Values(fixture{
+    .source{"AAAAGGGGAAAAGGGG"s},
+    .variants{},
+    .coverage_size{2},
+    .needles{"AAGG"s, "AG"s, ""s, "GGGG"s, "GA"s}
+}));
+
+INSTANTIATE_TEST_SUITE_P(snvs, state_oblivious_batch_traverser_test, testing::Values(fixture{
+         //  0123456789012345
+    .source{"AAAAGGGGAAAAGGGG"s},
+    .variants{variant_t{.position{1}, .insertion{"G"s}, .deletion{1}, .coverage{0, 1}},
+              variant_t{.position{6}, .insertion{"A"s}, .deletion{1}, .coverage{0, 2}},
+              variant_t{.position{11}, .insertion{"G"s}, .deletion{1}, .coverage{3}}},
+    .coverage_size{4},
+    .needles{"AG"s, "GAG"s, "GA"s, "AGGA"s, "G"s}
+}));
+
+INSTANTIATE_TEST_SUITE_P(indels, state_oblivious_batch_traverser_test, testing::Values(fixture{
+         //  0123456789012345
+    .source{"AAAAGGGGAAAAGGGG"s},
+    .variants{variant_t{.position{2}, .insertion{"CC"s}, .deletion{0}, .coverage{0, 1}},
+              variant_t{.position{7}, .insertion{""s}, .deletion{2}, .coverage{1, 2}},
+              variant_t{.position{12}, .insertion{"T"s}, .deletion{1}, .coverage{2}}},
+    .coverage_size{3},
+    .needles{"GA"s, "ACC"s, "GGAA"s, "CG"s, "AT"s}
+}));
@@ -0,0 +1,238 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <ranges>
+#include <stdexcept>
+#include <stop_token>
+#include <string>
+#include <vector>
+
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/sequence_tree/volatile_tree.hpp>
+#include <libjst/traversal/state_oblivious_generator.hpp>
+#include <libjst/traversal/state_oblivious_traverser.hpp>
+
+#include "../mock/rcs_store_mock.hpp"
+
+namespace jst::test::state_oblivious_generator {
+
+using source_t = std::string;
+using variant_t = jst::test::variant<uint32_t, source_t, uint32_t, std::vector<uint32_t>>;
+
+struct naive_matcher {
+    source_t needle{};
+
+    constexpr std::size_t window_size() const noexcept {
+        return needle.size();
+    }
+
+    template <typename haystack_t, typename callback_t>
+    constexpr void operator()(haystack_t && haystack, callback_t && callback) const {
+        auto it = std::ranges::begin(haystack);
+        auto last = std::ranges::end(haystack);
+        for (; std::ranges::distance(it, last) >= std::ranges::ssize(needle); ++it) {
+            if (std::ranges::equal(std::ranges::subrange{it, std::ranges::next(it, needle.size())}, needle))
+                callback(it);
+        }
+    }
+};
+
+struct throwing_matcher : public naive_matcher {
+    template <typename haystack_t, typename callback_t>
+    constexpr void operator()(haystack_t &&, callback_t &&) const {
+        throw std::runtime_error{"matcher failed"};
+    }
+};
+
+// A hit is identified by the sequence from the beginning of the label up to the hit.
+using hit_t = std::string;
+
+template <typename label_t, typename label_it_t>
+hit_t to_hit(label_t const & label, label_it_t const & label_it) {
+    auto sequence = label.sequence();
+    hit_t hit{};
+    std::ranges::copy(std::ranges::subrange{std::ranges::begin(sequence), label_it}, std::back_inserter(hit));
+    return hit;
+}
+
+struct fixture {
+    source_t source{};
+    std::vector<variant_t> variants{};
+    uint32_t coverage_size{};
+    source_t needle{};
+
+    template <typename stream_t, typename this_t>
+        requires std::same_as<std::remove_cvref_t<this_t>, fixture>
+    friend stream_t & operator<<(stream_t & stream, this_t &&) {
+        stream << "fixture";
+        return stream;
+    }
+};
+
+struct test : public ::testing::TestWithParam<fixture> {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using coverage_domain_type = libjst::coverage_domain_t<coverage_type>;
+
+    using cms_t = libjst::dna_compressed_multisequence<source_t, coverage_type>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+    using rcs_store_t = libjst::rcs_store<source_t, cms_t>;
+    rcs_store_t _mock;
+
+    void SetUp() override {
+        _mock = rcs_store_t{GetParam().source, GetParam().coverage_size};
+        coverage_domain_type domain = _mock.variants().coverage_domain();
+
+        std::ranges::for_each(GetParam().variants, [&] (auto var) {
+            _mock.add(cms_value_t{libjst::breakpoint{var.position, var.deletion},
+                                  var.insertion,
+                                  coverage_type{var.coverage, domain}});
+        });
+    }
+
+    rcs_store_t const & get_mock() const noexcept{
+        return _mock;
+    }
+
+    std::vector<hit_t> expected_hits() const {
+        std::vector<hit_t> hits{};
+        libjst::state_oblivious_traverser{}(libjst::volatile_tree{get_mock()}, naive_matcher{GetParam().needle},
+                                            [&] (auto && label_it, auto && label) {
+            hits.push_back(to_hit(label, label_it));
+        });
+        return hits;
+    }
+};
+
+} // namespace jst::test::state_oblivious_generator
+
+using namespace std::literals;
+
+using fixture = jst::test::state_oblivious_generator::fixture;
+using variant_t = jst::test::state_oblivious_generator::variant_t;
+using naive_matcher = jst::test::state_oblivious_generator::naive_matcher;
+using throwing_matcher = jst::test::state_oblivious_generator::throwing_matcher;
+using hit_t = jst::test::state_oblivious_generator::hit_t;
+
+struct state_oblivious_generator_test : public jst::test::state_oblivious_generator::test
+{
+    using jst::test::state_oblivious_generator::test::get_mock;
+    using jst::test::state_oblivious_generator::test::GetParam;
+
+    template <typename hits_t>
+    static std::vector<hit_t> collect(hits_t && hits) {
+        std::vector<hit_t> collected{};
+        for (auto const & hit : hits)
+            collected.push_back(jst::test::state_oblivious_generator::to_hit(hit.label, hit.position));
+        return collected;
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Test case definitions
+// ----------------------------------------------------------------------------
+
+TEST_P(state_oblivious_generator_test, hits) {
+    auto hits = libjst::state_oblivious_generator{}(libjst::volatile_tree{get_mock()},
+                                                    naive_matcher{GetParam().needle});
+    EXPECT_EQ(collect(hits), expected_hits());
+}
+
+TEST_P(state_oblivious_generator_test, max_hits) {
+    std::vector<hit_t> const all_hits = expected_hits();
+    for (std::size_t max_hits = 0; max_hits <= all_hits.size() + 1; ++max_hits) {
+        auto hits = libjst::state_oblivious_generator{}(libjst::volatile_tree{get_mock()},
+                                                        naive_matcher{GetParam().needle},
+                                                        max_hits);
+        std::size_t const expected_count = std::min(max_hits, all_hits.size());
+        EXPECT_EQ(collect(hits), (std::vector<hit_t>{all_hits.begin(), all_hits.begin() + expected_count}));
+    }
+}
+
+TEST_P(state_oblivious_generator_test, stop_request) {
+    std::vector<hit_t> const all_hits = expected_hits();
+    std::stop_source stop_source{};
+    auto hits = libjst::state_oblivious_generator{}(libjst::volatile_tree{get_mock()},
+                                                    naive_matcher{GetParam().needle},
+                                                    std::numeric_limits<std::size_t>::max(),
+                                                    stop_source.get_token());
+    std::vector<hit_t> collected{};
+    for (auto const & hit : hits) {
+        collected.push_back(jst::test::state_oblivious_generator::to_hit(hit.label, hit.position));
+        stop_source.request_stop();
+    }
+    EXPECT_EQ(collected, (std::vector<hit_t>{all_hits.begin(), all_hits.begin() + std::min<std::size_t>(1, all_hits.size())}));
+
+    auto stopped = libjst::state_oblivious_generator{}(libjst::volatile_tree{get_mock()},
+                                                       naive_matcher{GetParam().needle},
+                                                       std::numeric_limits<std::size_t>::max(),
+                                                       stop_source.get_token());
+    EXPECT_TRUE(stopped.begin() == stopped.end());
+}
+
+TEST_P(state_oblivious_generator_test, resume) {
+    auto hits = libjst::state_oblivious_generator{}(libjst::volatile_tree{get_mock()},
+                                                    naive_matcher{GetParam().needle});
+    std::vector<hit_t> collected{};
+    auto it = hits.begin();
+    // Consume the hits in chunks of two, pausing the search in between.
+    while (it != hits.end()) {
+        for (std::size_t count = 0; count < 2 && it != hits.end(); ++count, ++it)
+            collected.push_back(jst::test::state_oblivious_generator::to_hit((*it).label, (*it).position));
+    }
+    EXPECT_EQ(collected, expected_hits());
+}
+
+TEST_P(state_oblivious_generator_test, matcher_exception) {
+    auto hits = libjst::state_oblivious_generator{}(libjst::volatile_tree{get_mock()},
+                                                    throwing_matcher{{GetParam().needle}});
+    EXPECT_THROW(hits.begin(), std::runtime_error);
+}
+
+// ----------------------------------------------------------------------------
+// Test values
+// ----------------------------------------------------------------------------
+
+INSTANTIATE_TEST_SUITE_P(no_variant, state_oblivious_generator_test, testing::Values(fixture{
+    .source{"AAAAGGGGAAAAGGGG"s},
+    .variants{},
+    .coverage_size{2},
+    .needle{"AAGG"s}
+}));
+
+INSTANTIATE_TEST_SUITE_P(snvs, state_oblivious_generator_test, testing::Values(fixture{
+         //  0123456789012345
+    .source{"AAAAGGGGAAAAGGGG"s},
+    .variants{variant_t{.position{1}, .insertion{"G"s}, .deletion{1}, .coverage{0, 1}},
+              variant_t{.position{6}, .insertion{"A"s}, .deletion{1}, .coverage{0, 2}},
+              variant_t{.position{11}, .insertion{"G"s}, .deletion{1}, .coverage{3}}},
+    .coverage_size{4},
+    .needle{"AG"s}
+}));
+
+INSTANTIATE_TEST_SUITE_P(indels, state_oblivious_generator_test, testing::Values(fixture{
+         //  0123456789012345
+    .source{"AAAAGGGGAAAAGGGG"s},
+    .variants{variant_t{.position{2}, .insertion{"CC"s}, .deletion{0}, .coverage{0, 1}},
+              variant_t{.position{7}, .insertion{""s}, .deletion{2}, .coverage{1, 2}},
+              variant_t{.position{12}, .insertion{"T"s}, .deletion{1}, .coverage{2}}},
+    .coverage_size{3},
+    .needle{"GA"s}
+}));
+
+INSTANTIATE_TEST_SUITE_P(no_hits, state_oblivious_generator_test, testing::Values(fixture{
+    .source{"AAAAGGGGAAAAGGGG"s},
+    .variants{variant_t{.position{6}, .insertion{"A"s}, .deletion{1}, .coverage{0}}},
+    .coverage_size{2},
+    .needle{"TT"s}
+}));
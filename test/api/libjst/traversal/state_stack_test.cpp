@@ -0,0 +1,104 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <libjst/traversal/state_stack.hpp>
+
+using state_t = std::vector<uint64_t>;
+
+TEST(state_stack_test, push_pop)
+{
+    libjst::state_stack<std::string> stack{2};
+    EXPECT_TRUE(stack.empty());
+    EXPECT_GE(stack.capacity(), 2u);
+
+    stack.push("first");
+    stack.push(std::string{"second"});
+    EXPECT_EQ(stack.size(), 2u);
+    EXPECT_EQ(stack.top(), "second");
+
+    stack.pop();
+    EXPECT_EQ(stack.top(), "first");
+    stack.push("third"); // reuses the slot of "second".
+    EXPECT_EQ(stack.top(), "third");
+    stack.pop();
+    stack.pop();
+    EXPECT_TRUE(stack.empty());
+}
+
+TEST(state_stack_test, grow_beyond_capacity)
+{
+    libjst::state_stack<int> stack{1};
+    for (int i = 0; i < 100; ++i)
+        stack.push(i);
+
+    EXPECT_EQ(stack.size(), 100u);
+    for (int i = 99; i >= 0; --i) {
+        EXPECT_EQ(stack.top(), i);
+        stack.pop();
+    }
+    EXPECT_TRUE(stack.empty());
+}
+
+TEST(delta_state_stack_test, push_pop)
+{
+    libjst::delta_state_stack<state_t> stack{4};
+    EXPECT_TRUE(stack.empty());
+
+    stack.push(state_t{1, 2, 3, 4});
+    stack.push(state_t{1, 5, 3, 4});
+    stack.push(state_t{1, 5, 3, 4});
+    stack.push(state_t{7, 8, 9, 10});
+    EXPECT_EQ(stack.size(), 4u);
+    EXPECT_EQ(stack.top(), (state_t{7, 8, 9, 10}));
+
+    stack.pop();
+    EXPECT_EQ(stack.top(), (state_t{1, 5, 3, 4}));
+    stack.pop();
+    EXPECT_EQ(stack.top(), (state_t{1, 5, 3, 4}));
+    stack.pop();
+    EXPECT_EQ(stack.top(), (state_t{1, 2, 3, 4}));
+    stack.pop();
+    EXPECT_TRUE(stack.empty());
+
+    stack.push(state_t{0, 0, 0, 0}); // stored in full after the stack ran empty.
+    EXPECT_EQ(stack.top(), (state_t{0, 0, 0, 0}));
+}
+
+TEST(delta_state_stack_test, interleaved)
+{
+    // Replays a depth-first traversal and compares against the full copies of the states.
+    std::vector<state_t> expected{};
+    libjst::delta_state_stack<state_t> stack{};
+    uint64_t seed = 7;
+    auto next_state = [&] () {
+        state_t state = expected.empty() ? state_t(8, 0) : expected.back();
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        state[(seed >> 33) % state.size()] = seed;
+        return state;
+    };
+
+    for (std::size_t step = 0; step < 1000; ++step) {
+        if (expected.empty() || (step * 7) % 3 != 0) {
+            expected.push_back(next_state());
+            stack.push(expected.back());
+        } else {
+            expected.pop_back();
+            stack.pop();
+        }
+
+        ASSERT_EQ(stack.size(), expected.size());
+        if (!expected.empty()) {
+            EXPECT_EQ(stack.top(), expected.back()) << step;
+        }
+    }
+}
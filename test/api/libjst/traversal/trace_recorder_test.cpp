@@ -0,0 +1,245 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <set>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/sequence_tree/chunked_tree.hpp>
+#include <libjst/traversal/parallel_chunk_traverser.hpp>
+#include <libjst/traversal/trace_recorder.hpp>
+
+namespace jst::test::trace_recorder {
+
+using source_t = std::string;
+
+struct naive_matcher {
+    source_t needle{};
+
+    constexpr std::size_t window_size() const noexcept {
+        return needle.size();
+    }
+
+    template <typename haystack_t, typename callback_t>
+    constexpr void operator()(haystack_t && haystack, callback_t && callback) const {
+        auto it = std::ranges::begin(haystack);
+        auto last = std::ranges::end(haystack);
+        for (; std::ranges::distance(it, last) >= std::ranges::ssize(needle); ++it) {
+            if (std::ranges::equal(std::ranges::subrange{it, std::ranges::next(it, needle.size())}, needle))
+                callback(it);
+        }
+    }
+};
+
+// Throws in the third searched label, which stands in for a stalled worker.
+struct throwing_matcher : public naive_matcher {
+    template <typename haystack_t, typename callback_t>
+    void operator()(haystack_t && haystack, callback_t && callback) const {
+        naive_matcher::operator()(haystack, callback);
+        if (++*count == 3)
+            throw std::runtime_error{"stalled"};
+    }
+
+    std::shared_ptr<std::size_t> count{std::make_shared<std::size_t>()};
+};
+
+struct hit_counter {
+    std::size_t count{};
+
+    template <typename label_it_t, typename label_t>
+    void operator()(label_it_t &&, label_t &&) {
+        ++count;
+    }
+};
+
+struct test : public ::testing::Test {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using coverage_domain_type = libjst::coverage_domain_t<coverage_type>;
+
+    using cms_t = libjst::dna_compressed_multisequence<source_t, coverage_type>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+    using rcs_store_t = libjst::rcs_store<source_t, cms_t>;
+
+    static constexpr uint32_t chunk_size{100};
+    static constexpr uint32_t haplotype_count{8};
+
+    rcs_store_t _store;
+
+    void SetUp() override {
+        std::mt19937 generator{11};
+        source_t source{};
+        for (std::size_t idx = 0; idx < 1000; ++idx)
+            source.push_back("ACGT"[generator() % 4]);
+
+        _store = rcs_store_t{source, haplotype_count};
+        coverage_domain_type domain = _store.variants().coverage_domain();
+        for (uint32_t position = 3; position < 1000; position += 7) {
+            char snv = (source[position] == 'A') ? 'C' : 'A';
+            _store.add(cms_value_t{libjst::breakpoint{position, 1u},
+                                   source_t{snv},
+                                   coverage_type{{static_cast<uint32_t>(generator() % haplotype_count)}, domain}});
+        }
+    }
+
+    static std::size_t total_hits(std::vector<hit_counter> const & counters) {
+        return std::accumulate(counters.begin(), counters.end(), std::size_t{0},
+                               [] (std::size_t count, hit_counter const & counter) { return count + counter.count; });
+    }
+
+    static std::size_t count_kind(std::vector<libjst::trace_event> const & events, libjst::trace_event_kind kind) {
+        return std::ranges::count(events, kind, &libjst::trace_event::kind);
+    }
+};
+
+} // namespace jst::test::trace_recorder
+
+using trace_recorder_test = jst::test::trace_recorder::test;
+using naive_matcher = jst::test::trace_recorder::naive_matcher;
+using hit_counter = jst::test::trace_recorder::hit_counter;
+using throwing_matcher = jst::test::trace_recorder::throwing_matcher;
+
+TEST_F(trace_recorder_test, ring_buffer) {
+    libjst::trace_buffer buffer{3};
+    EXPECT_EQ(buffer.capacity(), 3u);
+    EXPECT_EQ(buffer.size(), 0u);
+
+    for (uint64_t timestamp = 0; timestamp < 5; ++timestamp)
+        buffer.record(libjst::trace_event{.timestamp = timestamp});
+
+    EXPECT_EQ(buffer.size(), 3u);
+    EXPECT_EQ(buffer.dropped_count(), 2u);
+    std::vector<libjst::trace_event> events = buffer.events();
+    ASSERT_EQ(events.size(), 3u);
+    EXPECT_EQ(events[0].timestamp, 2u);
+    EXPECT_EQ(events[1].timestamp, 3u);
+    EXPECT_EQ(events[2].timestamp, 4u);
+
+    buffer.clear();
+    EXPECT_EQ(buffer.size(), 0u);
+    EXPECT_TRUE(buffer.events().empty());
+}
+
+TEST_F(trace_recorder_test, invalid_capacity) {
+    EXPECT_THROW(libjst::trace_buffer{0}, std::invalid_argument);
+    EXPECT_THROW(libjst::trace_session{0}, std::invalid_argument);
+}
+
+TEST_F(trace_recorder_test, recorder) {
+    libjst::trace_buffer buffer{16};
+    libjst::trace_recorder recorder{buffer};
+    libjst::stack_publisher publisher{};
+    publisher.subscribe(recorder);
+
+    recorder.begin_task(42);
+    publisher.notify_push();
+    publisher.notify_push();
+    EXPECT_EQ(recorder.depth(), 2u);
+    publisher.notify_pop();
+    publisher.notify_pop();
+    recorder.end_task();
+
+    std::vector<libjst::trace_event> events = buffer.events();
+    ASSERT_EQ(events.size(), 6u);
+    EXPECT_EQ(events[0].kind, libjst::trace_event_kind::task_begin);
+    EXPECT_EQ(events[1].kind, libjst::trace_event_kind::push);
+    EXPECT_EQ(events[1].depth, 1u);
+    EXPECT_EQ(events[2].depth, 2u);
+    EXPECT_EQ(events[3].kind, libjst::trace_event_kind::pop);
+    EXPECT_EQ(events[4].depth, 0u);
+    EXPECT_EQ(events[5].kind, libjst::trace_event_kind::task_end);
+    EXPECT_TRUE(std::ranges::all_of(events, [] (auto const & event) { return event.chunk == 42u; }));
+    EXPECT_TRUE(std::ranges::is_sorted(events, std::ranges::less{}, &libjst::trace_event::timestamp));
+}
+
+TEST_F(trace_recorder_test, traced_chunks) {
+    auto forest = _store | libjst::chunk(chunk_size);
+    naive_matcher pattern{"AC"};
+    std::size_t expected_hits = total_hits(libjst::parallel_chunk_traverser{1}(forest, pattern, hit_counter{}));
+
+    libjst::trace_session session{1u << 16};
+    libjst::parallel_chunk_traverser<libjst::traced_traverser> traverser{4, libjst::traced_traverser{session}};
+    EXPECT_EQ(total_hits(traverser(forest, pattern, hit_counter{})), expected_hits);
+    EXPECT_EQ(session.dropped_count(), 0u);
+    EXPECT_LE(session.buffers().size(), 4u);
+
+    std::set<uint64_t> chunks{};
+    std::size_t label_size{};
+    for (libjst::trace_buffer const & buffer : session.buffers()) {
+        std::vector<libjst::trace_event> events = buffer.events();
+        EXPECT_EQ(count_kind(events, libjst::trace_event_kind::task_begin),
+                  count_kind(events, libjst::trace_event_kind::task_end));
+        EXPECT_EQ(count_kind(events, libjst::trace_event_kind::push),
+                  count_kind(events, libjst::trace_event_kind::pop));
+        EXPECT_GT(count_kind(events, libjst::trace_event_kind::label), 0u);
+
+        for (libjst::trace_event const & event : events) {
+            if (event.kind == libjst::trace_event_kind::task_begin)
+                chunks.insert(event.chunk);
+            if (event.kind == libjst::trace_event_kind::label)
+                label_size += event.size;
+        }
+    }
+    EXPECT_GE(label_size, std::ranges::size(_store.source()));
+
+    std::set<uint64_t> expected_chunks{};
+    for (uint64_t chunk = 0; chunk < std::ranges::size(_store.source()); chunk += chunk_size)
+        expected_chunks.insert(chunk);
+    EXPECT_EQ(chunks, expected_chunks);
+}
+
+TEST_F(trace_recorder_test, stalled_chunk) {
+    auto forest = _store | libjst::chunk(chunk_size);
+
+    libjst::trace_session session{8};
+    libjst::parallel_chunk_traverser<libjst::traced_traverser> traverser{1, libjst::traced_traverser{session}};
+    EXPECT_THROW(traverser(forest, throwing_matcher{{"AC"}}, hit_counter{}), std::runtime_error);
+
+    // The latest events show the label the traversal stopped in.
+    ASSERT_EQ(session.buffers().size(), 1u);
+    std::vector<libjst::trace_event> events = session.buffers()[0].events();
+    ASSERT_FALSE(events.empty());
+    EXPECT_EQ(events.back().kind, libjst::trace_event_kind::label);
+    EXPECT_EQ(events.back().chunk, 0u);
+    EXPECT_GT(events.back().depth, 0u);
+}
+
+TEST_F(trace_recorder_test, chrome_trace) {
+    auto forest = _store | libjst::chunk(chunk_size);
+    libjst::trace_session session{1u << 16};
+    libjst::parallel_chunk_traverser<libjst::traced_traverser> traverser{2, libjst::traced_traverser{session}};
+    traverser(forest, naive_matcher{"AC"}, hit_counter{});
+
+    std::ostringstream stream{};
+    session.write_chrome_trace(stream);
+    std::string trace = stream.str();
+
+    EXPECT_TRUE(trace.starts_with("{\"traceEvents\":["));
+    EXPECT_TRUE(trace.ends_with("\"otherData\":{\"dropped_events\":0}}\n"));
+    EXPECT_NE(trace.find("{\"name\":\"chunk\",\"ph\":\"B\",\"pid\":0,\"tid\":"), std::string::npos);
+    EXPECT_NE(trace.find("\"args\":{\"chunk\":900,\"depth\":0}"), std::string::npos);
+    EXPECT_NE(trace.find("\"ph\":\"i\""), std::string::npos);
+    EXPECT_NE(trace.find(",\"s\":\"t\",\"args\":{\"chunk\":"), std::string::npos);
+
+    // One line per event.
+    std::size_t event_count{};
+    for (libjst::trace_buffer const & buffer : session.buffers())
+        event_count += buffer.size();
+    EXPECT_EQ(static_cast<std::size_t>(std::ranges::count(trace, '\n')), event_count + 2);
+    EXPECT_EQ(std::ranges::count(trace, '{'), std::ranges::count(trace, '}'));
+}
@@ -0,0 +1,380 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <sstream>
+#include <stop_token>
+#include <string>
+#include <vector>
+
+#include <cereal/archives/binary.hpp>
+
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/sequence_tree/coloured_tree.hpp>
+#include <libjst/sequence_tree/labelled_tree.hpp>
+#include <libjst/sequence_tree/merge_tree.hpp>
+#include <libjst/sequence_tree/prune_unsupported.hpp>
+#include <libjst/sequence_tree/seekable_tree.hpp>
+#include <libjst/sequence_tree/trim_tree.hpp>
+#include <libjst/sequence_tree/volatile_tree.hpp>
+#include <libjst/traversal/state_oblivious_traverser.hpp>
+#include <libjst/traversal/traversal_budget.hpp>
+#include <libjst/traversal/traversal_checkpoint.hpp>
+#include <libjst/traversal/tree_traverser_base.hpp>
+
+#include "../mock/rcs_store_mock.hpp"
+
+namespace jst::test::traversal_checkpoint {
+
+using source_t = std::string;
+using variant_t = jst::test::variant<uint32_t, source_t, uint32_t, std::vector<uint32_t>>;
+
+// Remembers the last symbols of the path.
+struct window_matcher {
+    std::size_t size{};
+    source_t window{};
+
+    constexpr std::size_t window_size() const noexcept {
+        return size;
+    }
+
+    source_t capture() const {
+        return window;
+    }
+
+    void restore(source_t state) {
+        window = std::move(state);
+    }
+};
+
+// Collects the searched labels and requests a stop after the given number of labels.
+struct label_collector {
+    std::size_t size{};
+    std::vector<source_t> * labels{};
+    std::stop_source * stop_source{};
+    std::size_t stop_after{};
+
+    constexpr std::size_t window_size() const noexcept {
+        return size;
+    }
+
+    template <typename haystack_t, typename callback_t>
+    void operator()(haystack_t && haystack, callback_t &&) const {
+        labels->emplace_back(std::ranges::begin(haystack), std::ranges::end(haystack));
+        if (stop_source != nullptr && labels->size() == stop_after)
+            stop_source->request_stop();
+    }
+};
+
+struct fixture {
+    source_t source{};
+    std::vector<variant_t> variants{};
+    uint32_t coverage_size{};
+    uint32_t window_size{};
+
+    template <typename stream_t, typename this_t>
+        requires std::same_as<std::remove_cvref_t<this_t>, fixture>
+    friend stream_t & operator<<(stream_t & stream, this_t &&) {
+        stream << "fixture";
+        return stream;
+    }
+};
+
+struct test : public ::testing::TestWithParam<fixture> {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using coverage_domain_type = libjst::coverage_domain_t<coverage_type>;
+
+    using cms_t = libjst::dna_compressed_multisequence<source_t, coverage_type>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+    using rcs_store_t = libjst::rcs_store<source_t, cms_t>;
+    rcs_store_t _mock;
+
+    void SetUp() override {
+        _mock = rcs_store_t{GetParam().source, GetParam().coverage_size};
+        coverage_domain_type domain = _mock.variants().coverage_domain();
+
+        std::ranges::for_each(GetParam().variants, [&] (auto var) {
+            _mock.add(cms_value_t{libjst::breakpoint{var.position, var.deletion},
+                                  var.insertion,
+                                  coverage_type{var.coverage, domain}});
+        });
+    }
+
+    rcs_store_t const & get_mock() const noexcept{
+        return _mock;
+    }
+};
+
+} // namespace jst::test::traversal_checkpoint
+
+using namespace std::literals;
+
+using fixture = jst::test::traversal_checkpoint::fixture;
+using variant_t = jst::test::traversal_checkpoint::variant_t;
+using window_matcher = jst::test::traversal_checkpoint::window_matcher;
+using label_collector = jst::test::traversal_checkpoint::label_collector;
+
+struct traversal_checkpoint_test : public jst::test::traversal_checkpoint::test
+{
+    using jst::test::traversal_checkpoint::test::get_mock;
+    using jst::test::traversal_checkpoint::test::GetParam;
+
+    auto make_tree() const noexcept {
+        return libjst::volatile_tree{get_mock()} | libjst::labelled()
+                                                 | libjst::coloured()
+                                                 | libjst::trim(GetParam().window_size - 1)
+                                                 | libjst::prune_unsupported()
+                                                 | libjst::merge()
+                                                 | libjst::seek();
+    }
+
+    template <typename label_t>
+    static std::string to_string(label_t const & label) {
+        std::string str{};
+        std::ranges::copy(label.sequence(), std::back_inserter(str));
+        return str;
+    }
+
+    // Visits the nodes of the traversal until the given number of nodes has been reached.
+    template <typename traverser_t>
+    static std::vector<std::string> visit(traverser_t & traverser,
+                                          std::size_t const max_count = std::numeric_limits<std::size_t>::max()) {
+        std::vector<std::string> labels{};
+        for (auto it = traverser.begin(); it != traverser.end() && labels.size() < max_count; ++it)
+            labels.push_back(to_string(*it));
+        return labels;
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Test case definitions
+// ----------------------------------------------------------------------------
+
+TEST_P(traversal_checkpoint_test, resume) {
+    auto tree = make_tree();
+    libjst::tree_traverser_base full_path{tree};
+    std::vector<std::string> const expected_labels = visit(full_path);
+    ASSERT_FALSE(expected_labels.empty());
+
+    for (std::size_t node_count = 0; node_count <= expected_labels.size(); ++node_count) {
+        libjst::tree_traverser_base interrupted_path{tree};
+        libjst::traversal_checkpoint<> checkpoint{};
+        std::size_t visited{};
+        for (auto it = interrupted_path.begin(); it != interrupted_path.end(); ++it, ++visited) {
+            if (visited == node_count)
+                break;
+        }
+        checkpoint = interrupted_path.checkpoint();
+        EXPECT_EQ(checkpoint.empty(), node_count == expected_labels.size());
+
+        libjst::tree_traverser_base resumed_path{tree};
+        resumed_path.resume(checkpoint);
+        std::vector<std::string> const resumed_labels = visit(resumed_path);
+        EXPECT_EQ(resumed_labels, (std::vector<std::string>{expected_labels.begin() + node_count,
+                                                            expected_labels.end()})) << node_count;
+    }
+}
+
+TEST_P(traversal_checkpoint_test, serialise) {
+    auto tree = make_tree();
+    libjst::tree_traverser_base full_path{tree};
+    std::vector<std::string> const expected_labels = visit(full_path);
+
+    window_matcher matcher{.size = GetParam().window_size, .window = "ACGT"s};
+    for (std::size_t node_count = 0; node_count < expected_labels.size(); ++node_count) {
+        libjst::tree_traverser_base interrupted_path{tree};
+        auto it = interrupted_path.begin();
+        for (std::size_t visited = 0; visited < node_count; ++visited)
+            ++it;
+
+        std::stringstream archive_stream{};
+        {
+            cereal::BinaryOutputArchive output_archive{archive_stream};
+            output_archive(interrupted_path.checkpoint(matcher));
+        }
+
+        libjst::traversal_checkpoint<std::string> checkpoint{};
+        {
+            cereal::BinaryInputArchive input_archive{archive_stream};
+            input_archive(checkpoint);
+        }
+        EXPECT_EQ(checkpoint.frontier, interrupted_path.checkpoint().frontier);
+        EXPECT_EQ(checkpoint.matcher_state, "ACGT"s);
+
+        window_matcher resumed_matcher{.size = GetParam().window_size};
+        libjst::tree_traverser_base resumed_path{tree};
+        resumed_path.resume(checkpoint, resumed_matcher);
+        EXPECT_EQ(resumed_matcher.window, "ACGT"s);
+        EXPECT_EQ(visit(resumed_path), (std::vector<std::string>{expected_labels.begin() + node_count,
+                                                                 expected_labels.end()})) << node_count;
+    }
+}
+
+TEST_P(traversal_checkpoint_test, reserved_branch) {
+    auto tree = make_tree();
+    libjst::tree_traverser_base full_path{tree};
+    std::vector<std::string> const expected_labels = visit(full_path);
+
+    // The branch grows beyond the reserved depth if needed.
+    for (std::size_t depth : {std::size_t{1}, std::size_t{GetParam().window_size}}) {
+        libjst::tree_traverser_base reserved_path{tree};
+        reserved_path.reserve(depth);
+        EXPECT_EQ(visit(reserved_path), expected_labels) << depth;
+    }
+}
+
+TEST_P(traversal_checkpoint_test, memory_budget) {
+    auto tree = make_tree();
+    libjst::tree_traverser_base full_path{tree};
+    std::vector<std::string> const expected_labels = visit(full_path);
+    EXPECT_EQ(full_path.spill_count(), 0u);
+
+    // A budget below two nodes spills every pending node, which is sought again on backtracking.
+    libjst::tree_traverser_base bounded_path{tree};
+    bounded_path.set_memory_budget(1);
+    EXPECT_EQ(bounded_path.memory_budget(), 1u);
+    EXPECT_EQ(visit(bounded_path), expected_labels);
+    EXPECT_EQ(bounded_path.spill_count() > 0, !GetParam().variants.empty());
+
+    // The checkpoint of a spilled branch includes the spilled nodes.
+    for (std::size_t node_count = 0; node_count < expected_labels.size(); ++node_count) {
+        libjst::tree_traverser_base interrupted_path{tree};
+        interrupted_path.set_memory_budget(1);
+        auto it = interrupted_path.begin();
+        for (std::size_t visited = 0; visited < node_count; ++visited)
+            ++it;
+
+        libjst::tree_traverser_base resumed_path{tree};
+        resumed_path.resume(interrupted_path.checkpoint());
+        EXPECT_EQ(visit(resumed_path), (std::vector<std::string>{expected_labels.begin() + node_count,
+                                                                 expected_labels.end()})) << node_count;
+    }
+}
+
+TEST_P(traversal_checkpoint_test, memory_budget_traverser) {
+    std::vector<std::string> expected_labels{};
+    libjst::state_oblivious_traverser{}(libjst::volatile_tree{get_mock()},
+                                        label_collector{GetParam().window_size, &expected_labels},
+                                        [] (auto &&, auto &&) {});
+
+    libjst::state_oblivious_traverser bounded{};
+    EXPECT_EQ(bounded.memory_budget(), 0u);
+    bounded.memory_budget(1);
+    EXPECT_EQ(bounded.memory_budget(), 1u);
+    std::vector<std::string> labels{};
+    bounded(libjst::volatile_tree{get_mock()}, label_collector{GetParam().window_size, &labels},
+            [] (auto &&, auto &&) {});
+    EXPECT_EQ(labels, expected_labels);
+}
+
+TEST_P(traversal_checkpoint_test, time_budget) {
+    auto tree = make_tree();
+    libjst::tree_traverser_base full_path{tree};
+    std::vector<std::string> const expected_labels = visit(full_path);
+
+    for (std::size_t node_count = 1; node_count < expected_labels.size(); ++node_count) {
+        std::stop_source stop_source{};
+        libjst::traversal_budget const budget{stop_source.get_token(), 1};
+        libjst::tree_traverser_base interrupted_path{tree};
+        interrupted_path.set_budget(budget);
+        std::vector<std::string> labels{};
+        for (auto it = interrupted_path.begin(); it != interrupted_path.end(); ++it) {
+            labels.push_back(to_string(*it));
+            if (labels.size() == node_count)
+                stop_source.request_stop();
+        }
+        EXPECT_TRUE(interrupted_path.interrupted());
+        EXPECT_EQ(labels, (std::vector<std::string>{expected_labels.begin(), expected_labels.begin() + node_count}));
+
+        libjst::tree_traverser_base resumed_path{tree};
+        resumed_path.resume(interrupted_path.checkpoint());
+        EXPECT_EQ(visit(resumed_path), (std::vector<std::string>{expected_labels.begin() + node_count,
+                                                                 expected_labels.end()})) << node_count;
+    }
+
+    // A passed deadline stops the traversal at the first check.
+    libjst::traversal_budget const expired_budget{std::chrono::nanoseconds{0}, std::stop_token{}, 1};
+    EXPECT_TRUE(expired_budget.expired());
+    libjst::tree_traverser_base expired_path{tree};
+    expired_path.set_budget(expired_budget);
+    EXPECT_EQ(visit(expired_path).size(), std::min<std::size_t>(1, expected_labels.size()));
+    EXPECT_EQ(expired_path.interrupted(), expected_labels.size() > 1);
+
+    // A budget without a stop token and deadline never expires.
+    libjst::traversal_budget const unlimited_budget{};
+    libjst::tree_traverser_base unlimited_path{tree};
+    unlimited_path.set_budget(unlimited_budget);
+    EXPECT_EQ(visit(unlimited_path), expected_labels);
+    EXPECT_FALSE(unlimited_path.interrupted());
+}
+
+TEST_P(traversal_checkpoint_test, time_budget_traverser) {
+    std::vector<std::string> expected_labels{};
+    libjst::traversal_checkpoint<> const completed =
+        libjst::state_oblivious_traverser{}(libjst::volatile_tree{get_mock()},
+                                            label_collector{GetParam().window_size, &expected_labels},
+                                            [] (auto &&, auto &&) {});
+    EXPECT_TRUE(completed.empty());
+
+    for (std::size_t label_count = 1; label_count < expected_labels.size(); ++label_count) {
+        std::stop_source stop_source{};
+        libjst::traversal_budget const budget{stop_source.get_token(), 1};
+        libjst::state_oblivious_traverser interrupted{};
+        interrupted.set_budget(budget);
+        std::vector<std::string> labels{};
+        libjst::traversal_checkpoint<> const checkpoint =
+            interrupted(libjst::volatile_tree{get_mock()},
+                        label_collector{GetParam().window_size, &labels, &stop_source, label_count},
+                        [] (auto &&, auto &&) {});
+        EXPECT_FALSE(checkpoint.empty());
+        EXPECT_EQ(labels.size(), label_count);
+
+        libjst::state_oblivious_traverser resumed{};
+        resumed.resume_from(checkpoint);
+        EXPECT_TRUE(resumed(libjst::volatile_tree{get_mock()}, label_collector{GetParam().window_size, &labels},
+                            [] (auto &&, auto &&) {}).empty());
+        EXPECT_EQ(labels, expected_labels) << label_count;
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Test values
+// ----------------------------------------------------------------------------
+
+INSTANTIATE_TEST_SUITE_P(no_variant, traversal_checkpoint_test, testing::Values(fixture{
+    .source{"AAAAGGGGAAAAGGGG"s},
+    .variants{},
+    .coverage_size{2},
+    .window_size{4}
+}));
+
+INSTANTIATE_TEST_SUITE_P(snvs, traversal_checkpoint_test, testing::Values(fixture{
+         //  0123456789012345
+    .source{"AAAAGGGGAAAAGGGG"s},
+    .variants{variant_t{.position{1}, .insertion{"G"s}, .deletion{1}, .coverage{0, 1}},
+              variant_t{.position{3}, .insertion{"C"s}, .deletion{1}, .coverage{1, 2}},
+              variant_t{.position{6}, .insertion{"A"s}, .deletion{1}, .coverage{0, 2}},
+              variant_t{.position{11}, .insertion{"G"s}, .deletion{1}, .coverage{3}}},
+    .coverage_size{4},
+    .window_size{4}
+}));
+
+INSTANTIATE_TEST_SUITE_P(indels, traversal_checkpoint_test, testing::Values(fixture{
+         //  0123456789012345
+    .source{"AAAAGGGGAAAAGGGG"s},
+    .variants{variant_t{.position{2}, .insertion{"CC"s}, .deletion{0}, .coverage{0, 1}},
+              variant_t{.position{4}, .insertion{"T"s}, .deletion{1}, .coverage{0, 2}},
+              variant_t{.position{7}, .insertion{""s}, .deletion{2}, .coverage{1, 2}},
+              variant_t{.position{12}, .insertion{"T"s}, .deletion{1}, .coverage{2}}},
+    .coverage_size{3},
+    .window_size{3}
+}));
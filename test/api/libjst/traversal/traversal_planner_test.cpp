@@ -0,0 +1,243 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/matcher/shift_or_matcher.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/sequence_tree/volatile_tree.hpp>
+#include <libjst/traversal/state_oblivious_traverser.hpp>
+#include <libjst/traversal/traversal_planner.hpp>
+
+namespace jst::test::traversal_planner {
+
+using source_t = std::string;
+
+struct naive_matcher {
+    source_t needle{};
+
+    constexpr std::size_t window_size() const noexcept {
+        return needle.size();
+    }
+
+    template <typename haystack_t, typename callback_t>
+    constexpr void operator()(haystack_t && haystack, callback_t && callback) const {
+        auto it = std::ranges::begin(haystack);
+        auto last = std::ranges::end(haystack);
+        for (; std::ranges::distance(it, last) >= std::ranges::ssize(needle); ++it) {
+            if (std::ranges::equal(std::ranges::subrange{it, std::ranges::next(it, needle.size())}, needle))
+                callback(it);
+        }
+    }
+};
+
+struct test : public ::testing::Test {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using coverage_domain_type = libjst::coverage_domain_t<coverage_type>;
+
+    using cms_t = libjst::dna_compressed_multisequence<source_t, coverage_type>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+    using rcs_store_t = libjst::rcs_store<source_t, cms_t>;
+
+    static constexpr uint32_t haplotype_count{16};
+
+    rcs_store_t _store;
+    std::size_t _indel_count{};
+
+    // A random source with an snv every 7 positions and an insertion every 10th variant.
+    void SetUp() override {
+        std::mt19937 random_engine{42};
+        std::uniform_int_distribution<int> symbol_distribution{0, 3};
+        constexpr std::string_view dna{"ACGT"};
+
+        source_t source(4000, 'A');
+        std::ranges::generate(source, [&] { return dna[symbol_distribution(random_engine)]; });
+        _store = rcs_store_t{source, haplotype_count};
+        coverage_domain_type domain = _store.variants().coverage_domain();
+
+        std::bernoulli_distribution coverage_distribution{0.25};
+        for (uint32_t position = 10, idx = 0; position < source.size() - 10; position += 7, ++idx) {
+            std::vector<uint32_t> haplotypes{};
+            for (uint32_t haplotype = 0; haplotype < haplotype_count; ++haplotype)
+                if (coverage_distribution(random_engine))
+                    haplotypes.push_back(haplotype);
+            if (haplotypes.empty())
+                haplotypes.push_back(0);
+
+            coverage_type coverage{haplotypes, domain};
+            if (idx % 10 == 9) {
+                _store.add(cms_value_t{libjst::breakpoint{position, 0}, source_t{"CGTA"}, std::move(coverage)});
+                ++_indel_count;
+            } else {
+                char const alt = dna[(dna.find(source[position]) + 1) % 4];
+                _store.add(cms_value_t{libjst::breakpoint{position, 1}, source_t{alt}, std::move(coverage)});
+            }
+        }
+    }
+
+    rcs_store_t const & store() const noexcept {
+        return _store;
+    }
+
+    // A store profile of a tree with the given number of nodes, each with a label of 10 symbols.
+    static libjst::store_profile synthetic_store(std::size_t const node_count,
+                                                 double const carrier_fraction = 0.3,
+                                                 std::vector<std::size_t> subtree_depths = {1, 1}) {
+        libjst::store_profile profile{.source_size = 100000,
+                                      .haplotype_count = 1000,
+                                      .variant_count = node_count / 2,
+                                      .mean_carrier_fraction = carrier_fraction};
+        profile.tree.node_count = node_count;
+        profile.tree.symbol_count = 10 * node_count;
+        profile.tree.subtree_depths = std::move(subtree_depths);
+        return profile;
+    }
+
+    template <typename traverser_t, typename matcher_t>
+    std::vector<source_t> hits(traverser_t const & traverser, matcher_t && matcher) const {
+        std::vector<source_t> found{};
+        traverser(libjst::volatile_tree{store()}, (matcher_t &&) matcher, [&] (auto && label_it, auto && label) {
+            found.emplace_back(std::ranges::begin(label.sequence()), label_it);
+        });
+        std::ranges::sort(found);
+        return found;
+    }
+};
+
+} // namespace jst::test::traversal_planner
+
+using namespace std::literals;
+
+using source_t = jst::test::traversal_planner::source_t;
+using naive_matcher = jst::test::traversal_planner::naive_matcher;
+
+struct traversal_planner_test : public jst::test::traversal_planner::test
+{};
+
+// ----------------------------------------------------------------------------
+// Test case definitions
+// ----------------------------------------------------------------------------
+
+TEST_F(traversal_planner_test, short_window_large_state) {
+    libjst::matcher_profile const matcher{.window_size = 4, .state_size = 1024, .captures_state = true};
+    libjst::traversal_plan const plan = libjst::traversal_planner{}(synthetic_store(1000), matcher);
+
+    EXPECT_EQ(plan.traverser, libjst::traverser_kind::state_oblivious);
+    EXPECT_DOUBLE_EQ(plan.oblivious_cost, 10000.0 + 1000.0 * 3);
+    EXPECT_DOUBLE_EQ(plan.capture_cost, 10000.0 + 2000.0 * 1024 / 16);
+}
+
+TEST_F(traversal_planner_test, long_window_small_state) {
+    libjst::matcher_profile const matcher{.window_size = 64, .state_size = 8, .captures_state = true};
+    libjst::traversal_plan const plan = libjst::traversal_planner{}(synthetic_store(1000), matcher);
+
+    EXPECT_EQ(plan.traverser, libjst::traverser_kind::state_capture);
+    EXPECT_LT(plan.capture_cost, plan.oblivious_cost);
+}
+
+TEST_F(traversal_planner_test, state_oblivious_matcher) {
+    libjst::matcher_profile const matcher{.window_size = 64, .state_size = 0, .captures_state = false};
+    libjst::traversal_plan const plan = libjst::traversal_planner{}(synthetic_store(1000), matcher);
+
+    EXPECT_EQ(plan.traverser, libjst::traverser_kind::state_oblivious);
+    EXPECT_LT(plan.capture_cost, plan.oblivious_cost);
+}
+
+TEST_F(traversal_planner_test, coverage_strategy) {
+    libjst::matcher_profile const matcher{.window_size = 8};
+
+    // Rare variants nested in deep subtrees are skipped by block.
+    libjst::traversal_plan const rare = libjst::traversal_planner{}(synthetic_store(1000, 0.001, {3, 5}), matcher);
+    EXPECT_EQ(rare.coverage, libjst::coverage_strategy::block_summary);
+
+    // A block of common variants covers almost every haplotype.
+    libjst::traversal_plan const common = libjst::traversal_planner{}(synthetic_store(1000, 0.3, {3, 5}), matcher);
+    EXPECT_EQ(common.coverage, libjst::coverage_strategy::intersect);
+
+    // Subtrees of single variants have no blocks to skip.
+    libjst::traversal_plan const flat = libjst::traversal_planner{}(synthetic_store(1000, 0.001, {1, 1}), matcher);
+    EXPECT_EQ(flat.coverage, libjst::coverage_strategy::intersect);
+}
+
+TEST_F(traversal_planner_test, chunks) {
+    libjst::matcher_profile const matcher{.window_size = 100};
+    libjst::store_profile const profile = synthetic_store(10000);
+
+    libjst::traversal_plan const single = libjst::traversal_planner{}(profile, matcher);
+    EXPECT_EQ(single.chunk_count, 1u);
+    EXPECT_EQ(single.chunk_size, profile.source_size);
+
+    libjst::traversal_plan const parallel = libjst::traversal_planner{4}(profile, matcher);
+    EXPECT_GE(parallel.chunk_count, 4u);
+    EXPECT_LE(parallel.chunk_count, profile.source_size / matcher.window_size);
+    EXPECT_GE(parallel.chunk_count * parallel.chunk_size, profile.source_size);
+
+    // A source of few windows is not split further.
+    libjst::store_profile small = profile;
+    small.source_size = 250;
+    EXPECT_EQ(libjst::traversal_planner{8}(small, matcher).chunk_count, 2u);
+}
+
+TEST_F(traversal_planner_test, explain) {
+    libjst::matcher_profile const matcher{.window_size = 64, .state_size = 8, .captures_state = true};
+    libjst::traversal_plan const plan = libjst::traversal_planner{2}(synthetic_store(1000), matcher);
+    std::string const explanation = plan.explain();
+
+    EXPECT_NE(explanation.find("traverser: state_capture\n"), std::string::npos);
+    EXPECT_NE(explanation.find("coverage: intersect\n"), std::string::npos);
+    EXPECT_NE(explanation.find("chunks: "s + std::to_string(plan.chunk_count)), std::string::npos);
+    EXPECT_EQ(plan.reasons.size(), 3u);
+    for (std::string const & reason : plan.reasons)
+        EXPECT_NE(explanation.find("  - " + reason + "\n"), std::string::npos);
+
+    std::ostringstream stream{};
+    stream << libjst::traverser_kind::state_oblivious << ' ' << libjst::coverage_strategy::block_summary;
+    EXPECT_EQ(stream.str(), "state_oblivious block_summary");
+}
+
+TEST_F(traversal_planner_test, store_profile) {
+    libjst::store_profile const profile = libjst::store_profile::of(store(), 8, 1.0);
+
+    std::size_t const variant_count = (std::ranges::size(store().source()) - 20 + 6) / 7;
+    EXPECT_EQ(profile.source_size, std::ranges::size(store().source()));
+    EXPECT_EQ(profile.haplotype_count, haplotype_count);
+    EXPECT_EQ(profile.variant_count, variant_count);
+    EXPECT_EQ(profile.indel_count, _indel_count);
+    EXPECT_NEAR(profile.indel_fraction(), 0.1, 0.01);
+    EXPECT_NEAR(profile.density(), 1.0 / 7, 0.01);
+    EXPECT_GT(profile.mean_carrier_fraction, 0.15);
+    EXPECT_LT(profile.mean_carrier_fraction, 0.35);
+    EXPECT_GT(profile.tree.node_count, profile.variant_count);
+    EXPECT_GE(profile.tree.symbol_count, profile.source_size);
+}
+
+TEST_F(traversal_planner_test, planned_traverser) {
+    source_t const needle{"ACGTACGTACGT"};
+    std::vector<source_t> const expected = hits(libjst::state_oblivious_traverser{}, naive_matcher{needle});
+
+    libjst::traversal_plan const plan = libjst::traversal_planner{}(store(), libjst::shift_or_matcher{needle});
+    EXPECT_EQ(plan.traverser, libjst::traverser_kind::state_capture);
+    libjst::planned_traverser const traverser{plan};
+    EXPECT_EQ(traverser.kind(), libjst::traverser_kind::state_capture);
+    EXPECT_EQ(hits(traverser, libjst::shift_or_matcher{needle}), expected);
+
+    // Matchers without a state are searched with the state oblivious traverser regardless of the plan.
+    EXPECT_EQ(hits(traverser, naive_matcher{needle}), expected);
+
+    libjst::traversal_plan const oblivious = libjst::traversal_planner{}(store(), naive_matcher{needle});
+    EXPECT_EQ(oblivious.traverser, libjst::traverser_kind::state_oblivious);
+    EXPECT_EQ(hits(libjst::planned_traverser{oblivious}, libjst::shift_or_matcher{needle}), expected);
+}
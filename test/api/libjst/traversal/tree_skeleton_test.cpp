@@ -0,0 +1,228 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <cereal/archives/binary.hpp>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/matcher/shift_or_matcher.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/sequence_tree/volatile_tree.hpp>
+#include <libjst/traversal/state_oblivious_traverser.hpp>
+#include <libjst/traversal/tree_skeleton.hpp>
+
+namespace jst::test::tree_skeleton {
+
+using source_t = std::string;
+
+struct naive_matcher {
+    source_t needle{};
+
+    constexpr std::size_t window_size() const noexcept {
+        return needle.size();
+    }
+
+    template <typename haystack_t, typename callback_t>
+    constexpr void operator()(haystack_t && haystack, callback_t && callback) const {
+        auto it = std::ranges::begin(haystack);
+        auto last = std::ranges::end(haystack);
+        for (; std::ranges::distance(it, last) >= std::ranges::ssize(needle); ++it) {
+            if (std::ranges::equal(std::ranges::subrange{it, std::ranges::next(it, needle.size())}, needle))
+                callback(it);
+        }
+    }
+};
+
+struct test : public ::testing::Test {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using coverage_domain_type = libjst::coverage_domain_t<coverage_type>;
+
+    using cms_t = libjst::dna_compressed_multisequence<source_t, coverage_type>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+    using rcs_store_t = libjst::rcs_store<source_t, cms_t>;
+
+    // A hit given by the label, the position reported within the label and the haplotypes sharing the label.
+    using hit_type = std::tuple<source_t, std::ptrdiff_t, std::vector<bool>>;
+
+    static constexpr uint32_t haplotype_count{16};
+
+    rcs_store_t _store;
+
+    // A random source with an snv every 7 positions and an insertion every 10th variant.
+    void SetUp() override {
+        std::mt19937 random_engine{42};
+        std::uniform_int_distribution<int> symbol_distribution{0, 3};
+        constexpr std::string_view dna{"ACGT"};
+
+        source_t source(3000, 'A');
+        std::ranges::generate(source, [&] { return dna[symbol_distribution(random_engine)]; });
+        _store = rcs_store_t{source, haplotype_count};
+        coverage_domain_type domain = _store.variants().coverage_domain();
+
+        std::bernoulli_distribution coverage_distribution{0.3};
+        for (uint32_t position = 10, idx = 0; position < source.size() - 10; position += 7, ++idx) {
+            std::vector<uint32_t> haplotypes{};
+            for (uint32_t haplotype = 0; haplotype < haplotype_count; ++haplotype)
+                if (coverage_distribution(random_engine))
+                    haplotypes.push_back(haplotype);
+            if (haplotypes.empty())
+                haplotypes.push_back(0);
+
+            coverage_type coverage{haplotypes, domain};
+            if (idx % 10 == 9) {
+                _store.add(cms_value_t{libjst::breakpoint{position, 0}, source_t{"CGTA"}, std::move(coverage)});
+            } else {
+                char const alt = dna[(dna.find(source[position]) + 1) % 4];
+                _store.add(cms_value_t{libjst::breakpoint{position, 1}, source_t{alt}, std::move(coverage)});
+            }
+        }
+    }
+
+    rcs_store_t const & store() const noexcept {
+        return _store;
+    }
+
+    template <typename search_fn_t>
+    static std::vector<hit_type> collect(search_fn_t && search) {
+        std::vector<hit_type> hits{};
+        search([&] (auto && label_it, auto && label) {
+            auto && sequence = label.sequence();
+            auto && coverage = label.coverage();
+            hits.emplace_back(source_t{std::ranges::begin(sequence), std::ranges::end(sequence)},
+                              std::ranges::distance(std::ranges::begin(sequence), label_it),
+                              std::vector<bool>(coverage.begin(), coverage.end()));
+        });
+        std::ranges::sort(hits);
+        return hits;
+    }
+};
+
+} // namespace jst::test::tree_skeleton
+
+using namespace std::literals;
+
+using source_t = jst::test::tree_skeleton::source_t;
+using naive_matcher = jst::test::tree_skeleton::naive_matcher;
+
+struct tree_skeleton_test : public jst::test::tree_skeleton::test
+{};
+
+// ----------------------------------------------------------------------------
+// Test case definitions
+// ----------------------------------------------------------------------------
+
+TEST_F(tree_skeleton_test, build) {
+    auto const skeleton = libjst::build_tree_skeleton(libjst::volatile_tree{store()}, 8);
+
+    EXPECT_EQ(skeleton.window_size(), 8u);
+    EXPECT_GT(skeleton.size(), store().variants().size() / 2);
+    EXPECT_GE(skeleton.symbol_count(), std::ranges::size(store().source()));
+    EXPECT_LE(skeleton.coverage_count(), skeleton.size());
+
+    // The labels are stored consecutively in the order of the traversal.
+    std::size_t first{};
+    for (auto const & node : skeleton.nodes()) {
+        EXPECT_EQ(node.first, first);
+        first += node.size;
+    }
+    EXPECT_EQ(first, skeleton.symbol_count());
+
+    // The labels and coverages equal the ones searched by the state oblivious traverser.
+    std::size_t node{};
+    auto search_tree = skeleton.search_tree(libjst::volatile_tree{store()});
+    libjst::tree_traverser_base path{search_tree};
+    for (auto it = path.begin(); it != path.end(); ++it, ++node) {
+        ASSERT_LT(node, skeleton.size());
+        auto && label = *it;
+        auto const skeleton_label = skeleton.label(node);
+        EXPECT_TRUE(std::ranges::equal(skeleton_label.sequence(), label.sequence())) << node;
+        EXPECT_TRUE(skeleton_label.coverage() == label.coverage()) << node;
+        EXPECT_EQ(skeleton_label.position(), label.position()) << node;
+        EXPECT_EQ(skeleton_label.node(), node);
+    }
+    EXPECT_EQ(node, skeleton.size());
+
+    EXPECT_THROW(libjst::build_tree_skeleton(libjst::volatile_tree{store()}, 0), std::invalid_argument);
+}
+
+TEST_F(tree_skeleton_test, search) {
+    for (std::size_t const window_size : {4u, 6u, 12u}) {
+        auto const skeleton = libjst::build_tree_skeleton(libjst::volatile_tree{store()}, window_size);
+
+        // Runs several patterns of the same window size over one skeleton.
+        for (source_t needle : {"ACGTACGTACGT"s, "CGTACGTAAAAA"s, "TTTTGCAGCATG"s}) {
+            needle.resize(window_size);
+            auto naive_hits = collect([&] (auto && callback) {
+                libjst::skeleton_traverser{}(skeleton, naive_matcher{needle}, callback);
+            });
+            EXPECT_EQ(naive_hits, collect([&] (auto && callback) {
+                libjst::state_oblivious_traverser{}(libjst::volatile_tree{store()}, naive_matcher{needle}, callback);
+            })) << needle;
+
+            auto shift_or_hits = collect([&] (auto && callback) {
+                libjst::skeleton_traverser{}(skeleton, libjst::shift_or_matcher{needle}, callback);
+            });
+            EXPECT_EQ(shift_or_hits, collect([&] (auto && callback) {
+                libjst::state_oblivious_traverser{}(libjst::volatile_tree{store()}, libjst::shift_or_matcher{needle},
+                                                    callback);
+            })) << needle;
+            EXPECT_EQ(shift_or_hits.size(), naive_hits.size()) << needle;
+        }
+    }
+}
+
+TEST_F(tree_skeleton_test, window_size_mismatch) {
+    auto const skeleton = libjst::build_tree_skeleton(libjst::volatile_tree{store()}, 6);
+    EXPECT_THROW(libjst::skeleton_traverser{}(skeleton, naive_matcher{"ACGT"s}, [] (auto &&, auto &&) {}),
+                 std::invalid_argument);
+
+    // An empty skeleton reports nothing.
+    std::remove_cvref_t<decltype(skeleton)> const empty{};
+    std::size_t hit_count{};
+    libjst::skeleton_traverser{}(empty, naive_matcher{"ACGT"s}, [&] (auto &&, auto &&) { ++hit_count; });
+    EXPECT_EQ(hit_count, 0u);
+}
+
+TEST_F(tree_skeleton_test, serialise) {
+    auto const skeleton = libjst::build_tree_skeleton(libjst::volatile_tree{store()}, 6);
+    std::remove_cvref_t<decltype(skeleton)> skeleton_in{};
+
+    std::stringstream archive_stream{};
+    {
+        cereal::BinaryOutputArchive output_archive{archive_stream};
+        skeleton.save(output_archive);
+    }
+    {
+        cereal::BinaryInputArchive input_archive{archive_stream};
+        skeleton_in.load(input_archive);
+    }
+
+    EXPECT_EQ(skeleton_in.window_size(), skeleton.window_size());
+    EXPECT_EQ(skeleton_in.size(), skeleton.size());
+    EXPECT_TRUE(std::ranges::equal(skeleton_in.nodes(), skeleton.nodes()));
+
+    auto expected = collect([&] (auto && callback) {
+        libjst::skeleton_traverser{}(skeleton, naive_matcher{"ACGTAC"s}, callback);
+    });
+    auto actual = collect([&] (auto && callback) {
+        libjst::skeleton_traverser{}(skeleton_in, naive_matcher{"ACGTAC"s}, callback);
+    });
+    EXPECT_EQ(actual, expected);
+}
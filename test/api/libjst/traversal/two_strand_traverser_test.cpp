@@ -0,0 +1,211 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <ranges>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <libjst/matcher/shift_or_matcher.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/sequence/dna_complement.hpp>
+#include <libjst/sequence_tree/volatile_tree.hpp>
+#include <libjst/traversal/two_strand_traverser.hpp>
+#include <libjst/traversal/state_oblivious_traverser.hpp>
+
+#include "../mock/rcs_store_mock.hpp"
+
+namespace jst::test::two_strand_traverser {
+
+using source_t = std::string;
+using variant_t = jst::test::variant<uint32_t, source_t, uint32_t, std::vector<uint32_t>>;
+
+struct naive_matcher {
+    source_t needle{};
+
+    constexpr std::size_t window_size() const noexcept {
+        return needle.size();
+    }
+
+    template <typename haystack_t, typename callback_t>
+    constexpr void operator()(haystack_t && haystack, callback_t && callback) const {
+        auto it = std::ranges::begin(haystack);
+        auto last = std::ranges::end(haystack);
+        for (; std::ranges::distance(it, last) >= std::ranges::ssize(needle); ++it) {
+            if (std::ranges::equal(std::ranges::subrange{it, std::ranges::next(it, needle.size())}, needle))
+                callback(it);
+        }
+    }
+};
+
+struct fixture {
+    source_t source{};
+    std::vector<variant_t> variants{};
+    uint32_t coverage_size{};
+    std::vector<source_t> needles{};
+
+    template <typename stream_t, typename this_t>
+        requires std::same_as<std::remove_cvref_t<this_t>, fixture>
+    friend stream_t & operator<<(stream_t & stream, this_t &&) {
+        stream << "fixture";
+        return stream;
+    }
+};
+
+struct test : public ::testing::TestWithParam<fixture> {
+    using coverage_type = libjst::bit_coverage<uint32_t>;
+    using coverage_domain_type = libjst::coverage_domain_t<coverage_type>;
+
+    using cms_t = libjst::dna_compressed_multisequence<source_t, coverage_type>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+    using rcs_store_t = libjst::rcs_store<source_t, cms_t>;
+    rcs_store_t _mock;
+
+    void SetUp() override {
+        _mock = rcs_store_t{GetParam().source, GetParam().coverage_size};
+        coverage_domain_type domain = _mock.variants().coverage_domain();
+
+        std::ranges::for_each(GetParam().variants, [&] (auto var) {
+            _mock.add(cms_value_t{libjst::breakpoint{var.position, var.deletion},
+                                  var.insertion,
+                                  coverage_type{var.coverage, domain}});
+        });
+    }
+
+    rcs_store_t const & get_mock() const noexcept{
+        return _mock;
+    }
+};
+
+} // namespace jst::test::two_strand_traverser
+
+using namespace std::literals;
+
+using source_t = jst::test::two_strand_traverser::source_t;
+using fixture = jst::test::two_strand_traverser::fixture;
+using variant_t = jst::test::two_strand_traverser::variant_t;
+using naive_matcher = jst::test::two_strand_traverser::naive_matcher;
+
+struct two_strand_traverser_test : public jst::test::two_strand_traverser::test
+{
+    using jst::test::two_strand_traverser::test::get_mock;
+    using jst::test::two_strand_traverser::test::GetParam;
+
+    using strand_hits_t = std::pair<std::vector<source_t>, std::vector<source_t>>;
+
+    static source_t reverse_complement(source_t const & needle) {
+        source_t reversed{};
+        std::ranges::copy(libjst::reverse_complement(needle), std::back_inserter(reversed));
+        return reversed;
+    }
+
+    template <typename pattern_t>
+    strand_hits_t two_strand_hits(pattern_t forward_pattern, pattern_t reverse_pattern) const {
+        strand_hits_t hits{};
+        libjst::two_strand_traverser{}(libjst::volatile_tree{get_mock()}, forward_pattern, reverse_pattern,
+                                       [&] (libjst::strand hit_strand, auto && label_it, auto && label) {
+            auto & strand_hits = (hit_strand == libjst::strand::forward) ? hits.first : hits.second;
+            strand_hits.emplace_back(std::ranges::begin(label.sequence()), label_it);
+        });
+        std::ranges::sort(hits.first);
+        std::ranges::sort(hits.second);
+        return hits;
+    }
+
+    // The hits of both strands found by a separate traversal per strand.
+    template <typename pattern_t>
+    strand_hits_t expected_hits(pattern_t forward_pattern, pattern_t reverse_pattern) const {
+        auto hits_of = [&] (pattern_t & pattern) {
+            std::vector<source_t> pattern_hits{};
+            libjst::state_oblivious_traverser{}(libjst::volatile_tree{get_mock()}, pattern, [&] (auto && label_it,
+                                                                                                 auto && label) {
+                pattern_hits.emplace_back(std::ranges::begin(label.sequence()), label_it);
+            });
+            std::ranges::sort(pattern_hits);
+            return pattern_hits;
+        };
+        return {hits_of(forward_pattern), hits_of(reverse_pattern)};
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Test case definitions
+// ----------------------------------------------------------------------------
+
+TEST(dna_complement_test, reverse_complement) {
+    EXPECT_EQ(libjst::dna_complement('A'), 'T');
+    EXPECT_EQ(libjst::dna_complement('c'), 'g');
+    EXPECT_EQ(libjst::dna_complement('N'), 'N');
+    EXPECT_EQ(libjst::dna_complement('R'), 'Y');
+    EXPECT_EQ(libjst::dna_complement('-'), '-');
+    EXPECT_EQ(two_strand_traverser_test::reverse_complement("AACGTt"s), "aACGTT"s);
+    EXPECT_EQ(two_strand_traverser_test::reverse_complement(""s), ""s);
+}
+
+TEST_P(two_strand_traverser_test, hits) {
+    for (source_t const & needle : GetParam().needles) {
+        naive_matcher forward_pattern{needle};
+        naive_matcher reverse_pattern{reverse_complement(needle)};
+        EXPECT_EQ(two_strand_hits(forward_pattern, reverse_pattern),
+                  expected_hits(forward_pattern, reverse_pattern)) << needle;
+    }
+}
+
+TEST_P(two_strand_traverser_test, shift_or_hits) {
+    for (source_t const & needle : GetParam().needles) {
+        libjst::shift_or_matcher forward_pattern{needle};
+        libjst::shift_or_matcher reverse_pattern{reverse_complement(needle)};
+        EXPECT_EQ(two_strand_hits(forward_pattern, reverse_pattern),
+                  expected_hits(forward_pattern, reverse_pattern)) << needle;
+    }
+}
+
+TEST_P(two_strand_traverser_test, reverse_strand_hits) {
+    // The occurrences of AAGG are the reverse strand occurrences of its reverse complement CCTT.
+    strand_hits_t const hits = two_strand_hits(naive_matcher{"CCTT"s}, naive_matcher{reverse_complement("CCTT"s)});
+    EXPECT_FALSE(hits.second.empty());
+    EXPECT_EQ(hits.second, two_strand_hits(naive_matcher{"AAGG"s}, naive_matcher{"CCTT"s}).first);
+}
+
+TEST_P(two_strand_traverser_test, different_window_size) {
+    EXPECT_THROW(two_strand_hits(naive_matcher{"AC"s}, naive_matcher{"ACG"s}), std::invalid_argument);
+}
+
+// ----------------------------------------------------------------------------
+// Test values
+// ----------------------------------------------------------------------------
+
+INSTANTIATE_TEST_SUITE_P(no_variant, two_strand_traverser_test, testing::Values(fixture{
+    .source{"AAAAGGGGAAAAGGGG"s},
+    .variants{},
+    .coverage_size{2},
+    .needles{"AAGG"s, "AG"s, ""s, "GGGG"s, "GA"s}
+}));
+
+INSTANTIATE_TEST_SUITE_P(snvs, two_strand_traverser_test, testing::Values(fixture{
+         //  0123456789012345
+    .source{"AAAAGGGGAAAAGGGG"s},
+    .variants{variant_t{.position{1}, .insertion{"G"s}, .deletion{1}, .coverage{0, 1}},
+              variant_t{.position{6}, .insertion{"A"s}, .deletion{1}, .coverage{0, 2}},
+              variant_t{.position{11}, .insertion{"G"s}, .deletion{1}, .coverage{3}}},
+    .coverage_size{4},
+    .needles{"AG"s, "GAG"s, "GA"s, "AGGA"s, "G"s}
+}));
+
+INSTANTIATE_TEST_SUITE_P(indels, two_strand_traverser_test, testing::Values(fixture{
+         //  0123456789012345
+    .source{"AAAAGGGGAAAAGGGG"s},
+    .variants{variant_t{.position{2}, .insertion{"CC"s}, .deletion{0}, .coverage{0, 1}},
+              variant_t{.position{7}, .insertion{""s}, .deletion{2}, .coverage{1, 2}},
+              variant_t{.position{12}, .insertion{"T"s}, .deletion{1}, .coverage{2}}},
+    .coverage_size{3},
+    .needles{"GA"s, "ACC"s, "GGAA"s, "CG"s, "AT"s}
+}));
@@ -0,0 +1,109 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include <libjst/traversal/work_stealing_scheduler.hpp>
+
+struct interval {
+    std::size_t begin{};
+    std::size_t end{};
+};
+
+struct split_interval {
+    std::size_t min_size{1};
+
+    std::optional<interval> operator()(interval & task) const noexcept {
+        if (task.end - task.begin < 2 * min_size)
+            return std::nullopt;
+
+        std::size_t middle = task.begin + (task.end - task.begin) / 2;
+        interval upper{middle, task.end};
+        task.end = middle;
+        return upper;
+    }
+};
+
+auto no_split = [] (interval &) -> std::optional<interval> { return std::nullopt; };
+
+TEST(work_stealing_scheduler_test, construction) {
+    EXPECT_GE(libjst::work_stealing_scheduler{}.thread_count(), 1u);
+    EXPECT_EQ(libjst::work_stealing_scheduler{0}.thread_count(), 1u);
+    EXPECT_EQ(libjst::work_stealing_scheduler{3}.thread_count(), 3u);
+}
+
+TEST(work_stealing_scheduler_test, execute_all_tasks) {
+    std::vector<interval> tasks{};
+    for (std::size_t i = 0; i < 100; ++i)
+        tasks.push_back(interval{i, i + 1});
+
+    std::mutex mutex{};
+    std::vector<std::size_t> executed{};
+    libjst::work_stealing_scheduler{4}(tasks, no_split, [&] (std::size_t const worker_id, interval & task) {
+        EXPECT_LT(worker_id, 4u);
+        std::scoped_lock lock{mutex};
+        executed.push_back(task.begin);
+    });
+
+    std::ranges::sort(executed);
+    ASSERT_EQ(executed.size(), 100u);
+    for (std::size_t i = 0; i < 100; ++i)
+        EXPECT_EQ(executed[i], i);
+}
+
+TEST(work_stealing_scheduler_test, split_tasks_partition_input) {
+    // One expensive task and few cheap ones.
+    std::vector<interval> tasks{interval{0, 1000}, interval{1000, 1001}, interval{1001, 1002}};
+
+    std::mutex mutex{};
+    std::vector<interval> executed{};
+    libjst::work_stealing_scheduler{4}(tasks, split_interval{10}, [&] (std::size_t, interval & task) {
+        std::scoped_lock lock{mutex};
+        executed.push_back(task);
+    });
+
+    std::ranges::sort(executed, std::ranges::less{}, &interval::begin);
+    ASSERT_FALSE(executed.empty());
+    EXPECT_GT(executed.size(), tasks.size());
+    EXPECT_EQ(executed.front().begin, 0u);
+    EXPECT_EQ(executed.back().end, 1002u);
+    for (std::size_t i = 1; i < executed.size(); ++i)
+        EXPECT_EQ(executed[i - 1].end, executed[i].begin);
+}
+
+TEST(work_stealing_scheduler_test, single_thread) {
+    std::vector<interval> tasks{interval{0, 64}};
+
+    std::size_t covered{};
+    libjst::work_stealing_scheduler{1}(tasks, split_interval{4}, [&] (std::size_t const worker_id, interval & task) {
+        EXPECT_EQ(worker_id, 0u);
+        covered += task.end - task.begin;
+    });
+    EXPECT_EQ(covered, 64u);
+}
+
+TEST(work_stealing_scheduler_test, empty_tasks) {
+    std::size_t executed{};
+    libjst::work_stealing_scheduler{4}(std::vector<interval>{}, no_split, [&] (std::size_t, interval &) {
+        ++executed;
+    });
+    EXPECT_EQ(executed, 0u);
+}
+
+TEST(work_stealing_scheduler_test, propagate_exception) {
+    std::vector<interval> tasks{interval{0, 100}};
+    EXPECT_THROW(libjst::work_stealing_scheduler{4}(tasks, split_interval{1}, [] (std::size_t, interval & task) {
+        if (task.begin == 0)
+            throw std::runtime_error{"first task"};
+    }), std::runtime_error);
+}
@@ -0,0 +1,142 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory_resource>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/coverage/concept.hpp>
+#include <libjst/utility/arena_allocator.hpp>
+
+// Counts the bytes that are currently allocated from the upstream resource.
+struct counting_resource : public std::pmr::memory_resource
+{
+    std::size_t allocated{};
+
+    void * do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        allocated += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void * pointer, std::size_t bytes, std::size_t alignment) override
+    {
+        allocated -= bytes;
+        std::pmr::new_delete_resource()->deallocate(pointer, bytes, alignment);
+    }
+
+    bool do_is_equal(std::pmr::memory_resource const & other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+
+template <typename value_t>
+using arena_vector = std::vector<value_t, libjst::arena_allocator<value_t>>;
+
+TEST(arena_allocator_test, no_arena)
+{
+    EXPECT_EQ(libjst::active_arena(), std::pmr::new_delete_resource());
+    EXPECT_EQ(libjst::arena_allocator<int>{}.resource(), std::pmr::new_delete_resource());
+
+    arena_vector<int> values{1, 2, 3};
+    EXPECT_EQ(values.get_allocator().resource(), std::pmr::new_delete_resource());
+}
+
+TEST(arena_allocator_test, scoped_arena)
+{
+    {
+        libjst::scoped_arena arena{};
+        EXPECT_EQ(libjst::active_arena(), arena.resource());
+
+        arena_vector<int> values(100, 7);
+        EXPECT_EQ(values.get_allocator().resource(), arena.resource());
+        EXPECT_EQ(values[99], 7);
+    }
+    EXPECT_EQ(libjst::active_arena(), std::pmr::new_delete_resource());
+}
+
+TEST(arena_allocator_test, nested_arenas)
+{
+    libjst::scoped_arena outer{};
+    {
+        libjst::scoped_arena inner{};
+        EXPECT_EQ(libjst::active_arena(), inner.resource());
+    }
+    EXPECT_EQ(libjst::active_arena(), outer.resource());
+}
+
+TEST(arena_allocator_test, release_at_once)
+{
+    counting_resource upstream{};
+    libjst::detail::thread_arena_resource() = &upstream;
+    {
+        libjst::scoped_arena arena{1024};
+        arena_vector<uint64_t> values(1000, 1);
+        values.resize(5000, 2);
+        EXPECT_GT(upstream.allocated, 5000 * sizeof(uint64_t));
+    }
+    EXPECT_EQ(upstream.allocated, 0u);
+    libjst::detail::thread_arena_resource() = std::pmr::new_delete_resource();
+}
+
+TEST(arena_allocator_test, copy_binds_to_active_arena)
+{
+    arena_vector<int> values{1, 2, 3};
+    libjst::scoped_arena arena{};
+
+    arena_vector<int> copy{values};
+    EXPECT_EQ(copy, values);
+    EXPECT_EQ(copy.get_allocator().resource(), arena.resource());
+    EXPECT_EQ(values.get_allocator().resource(), std::pmr::new_delete_resource());
+
+    arena_vector<int> moved{std::move(copy)};
+    EXPECT_EQ(moved.get_allocator().resource(), arena.resource());
+}
+
+TEST(arena_allocator_test, thread_local_arena)
+{
+    libjst::scoped_arena arena{};
+    std::optional<std::pmr::memory_resource *> other_thread_arena{};
+    std::thread worker{[&] () { other_thread_arena = libjst::active_arena(); }};
+    worker.join();
+
+    EXPECT_EQ(other_thread_arena, std::pmr::new_delete_resource());
+    EXPECT_EQ(libjst::active_arena(), arena.resource());
+}
+
+TEST(arena_allocator_test, equality)
+{
+    libjst::scoped_arena arena{};
+    libjst::arena_allocator<int> arena_alloc{};
+    libjst::arena_allocator<int> default_alloc{std::pmr::new_delete_resource()};
+
+    EXPECT_TRUE(arena_alloc == libjst::arena_allocator<double>{arena_alloc});
+    EXPECT_FALSE(arena_alloc == default_alloc);
+}
+
+TEST(arena_allocator_test, bit_coverage)
+{
+    using coverage_t = libjst::bit_coverage<uint32_t, libjst::arena_allocator<uint64_t>>;
+    using domain_t = libjst::coverage_domain_t<coverage_t>;
+
+    libjst::scoped_arena arena{};
+    domain_t domain{0, 100};
+    coverage_t first{{0, 1, 64, 99}, domain};
+    coverage_t second{{1, 2, 64}, domain};
+
+    coverage_t intersection = libjst::coverage_intersection(first, second);
+    EXPECT_TRUE(intersection == (coverage_t{{1, 64}, domain}));
+    EXPECT_TRUE(libjst::coverage_difference(first, second) == (coverage_t{{0, 99}, domain}));
+    EXPECT_TRUE(libjst::coverage_intersects(first, second));
+    EXPECT_EQ(libjst::coverage_intersection_count(first, second), 2u);
+}
@@ -0,0 +1,74 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <libjst/utility/bit_matrix_transpose.hpp>
+#include <libjst/utility/bit_vector.hpp>
+
+struct bit_matrix_transpose_test : public ::testing::Test {
+    using bit_vector_t = libjst::bit_vector<>;
+
+    static std::vector<bit_vector_t> random_matrix(std::size_t const row_count,
+                                                   std::size_t const column_count,
+                                                   unsigned const seed) {
+        std::mt19937 generator{seed};
+        std::vector<bit_vector_t> rows(row_count, bit_vector_t(column_count, false));
+        for (bit_vector_t & row : rows)
+            for (std::size_t column = 0; column < column_count; ++column)
+                row[column] = generator() % 3 == 0;
+        return rows;
+    }
+};
+
+TEST_F(bit_matrix_transpose_test, block) {
+    std::vector<uint64_t> blocks(2 * libjst::bit_block_size);
+    for (std::size_t row = 0; row < libjst::bit_block_size; ++row) {
+        blocks[row] = uint64_t{1} << row; // the identity is its own transpose.
+        blocks[libjst::bit_block_size + row] = (row == 5) ? ~uint64_t{0} : 0; // a single row becomes a column.
+    }
+
+    libjst::transpose_bit_blocks(blocks);
+    for (std::size_t row = 0; row < libjst::bit_block_size; ++row) {
+        EXPECT_EQ(blocks[row], uint64_t{1} << row);
+        EXPECT_EQ(blocks[libjst::bit_block_size + row], uint64_t{1} << 5);
+    }
+}
+
+TEST_F(bit_matrix_transpose_test, matrix) {
+    for (auto [row_count, column_count] : {std::pair{0u, 5u}, std::pair{1u, 1u}, std::pair{64u, 64u},
+                                           std::pair{130u, 77u}, std::pair{33u, 200u}}) {
+        std::vector<bit_vector_t> const rows = random_matrix(row_count, column_count, row_count + column_count);
+        std::vector<bit_vector_t> const columns = libjst::transpose_bits(rows, column_count);
+
+        ASSERT_EQ(columns.size(), column_count);
+        for (std::size_t column = 0; column < column_count; ++column) {
+            ASSERT_EQ(columns[column].size(), row_count);
+            for (std::size_t row = 0; row < row_count; ++row)
+                EXPECT_EQ(columns[column][row], rows[row][column]) << row << " " << column;
+        }
+
+        EXPECT_EQ(libjst::transpose_bits(columns, row_count), rows); // round trip.
+    }
+}
+
+TEST_F(bit_matrix_transpose_test, leading_columns) {
+    std::vector<bit_vector_t> const rows = random_matrix(10, 100, 3);
+    std::vector<bit_vector_t> const columns = libjst::transpose_bits(rows, 70);
+
+    ASSERT_EQ(columns.size(), 70u);
+    for (std::size_t column = 0; column < 70; ++column)
+        for (std::size_t row = 0; row < 10; ++row)
+            EXPECT_EQ(columns[column][row], rows[row][column]);
+
+    EXPECT_THROW(libjst::transpose_bits(rows, 101), std::invalid_argument);
+}
@@ -0,0 +1,152 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <libjst/utility/bit_vector_kernels.hpp>
+
+using libjst::detail::bit_kernel_target;
+using libjst::detail::bit_kernels;
+
+struct bit_vector_kernels_test : public ::testing::TestWithParam<bit_kernel_target> {
+    using words_type = std::vector<uint64_t>;
+
+    // Covers the scalar tails as well as several full blocks of every target.
+    static constexpr std::size_t word_counts[] = {0, 1, 3, 4, 7, 8, 15, 16, 17, 31, 32, 33, 63, 64, 65, 250};
+
+    bit_kernels kernels{};
+    bit_kernels const & expected = libjst::detail::scalar_bit_kernels;
+
+    void SetUp() override {
+        if (!libjst::detail::supports_bit_kernel_target(GetParam()))
+            GTEST_SKIP() << "The target is not supported by this CPU.";
+
+        kernels = libjst::detail::select_bit_kernels(GetParam());
+        ASSERT_EQ(kernels.target, GetParam());
+    }
+
+    static words_type random_words(std::size_t const count, unsigned const seed) {
+        std::mt19937_64 generator{seed};
+        words_type words(count);
+        for (uint64_t & word : words)
+            word = generator();
+        return words;
+    }
+};
+
+TEST_P(bit_vector_kernels_test, binary_kernels) {
+    for (auto kernel : {&bit_kernels::and_words, &bit_kernels::or_words,
+                        &bit_kernels::xor_words, &bit_kernels::and_not_words}) {
+        for (std::size_t count : word_counts) {
+            words_type lhs = random_words(count, 42);
+            words_type rhs = random_words(count, 7);
+            words_type expected_result(count);
+            words_type actual_result(count);
+
+            (expected.*kernel)(expected_result.data(), lhs.data(), rhs.data(), count);
+            (kernels.*kernel)(actual_result.data(), lhs.data(), rhs.data(), count);
+            EXPECT_EQ(actual_result, expected_result) << count;
+
+            (kernels.*kernel)(lhs.data(), lhs.data(), rhs.data(), count); // in-place
+            EXPECT_EQ(lhs, expected_result) << count;
+        }
+    }
+}
+
+TEST_P(bit_vector_kernels_test, any) {
+    for (std::size_t count : word_counts) {
+        words_type words(count, 0);
+        EXPECT_FALSE(kernels.any_words(words.data(), count)) << count;
+
+        for (std::size_t position = 0; position < count; ++position) {
+            words[position] = uint64_t{1} << (position % 64);
+            EXPECT_TRUE(kernels.any_words(words.data(), count)) << count << " " << position;
+            words[position] = 0;
+        }
+    }
+}
+
+TEST_P(bit_vector_kernels_test, all) {
+    for (std::size_t count : word_counts) {
+        words_type words(count, ~uint64_t{0});
+        EXPECT_TRUE(kernels.all_words(words.data(), count)) << count;
+
+        for (std::size_t position = 0; position < count; ++position) {
+            words[position] = ~(uint64_t{1} << (position % 64));
+            EXPECT_FALSE(kernels.all_words(words.data(), count)) << count << " " << position;
+            words[position] = ~uint64_t{0};
+        }
+    }
+}
+
+TEST_P(bit_vector_kernels_test, count) {
+    for (std::size_t count : word_counts) {
+        words_type words = random_words(count, 13);
+        EXPECT_EQ(kernels.count_words(words.data(), count), expected.count_words(words.data(), count)) << count;
+
+        words.assign(count, ~uint64_t{0});
+        EXPECT_EQ(kernels.count_words(words.data(), count), count * 64) << count;
+    }
+}
+
+TEST_P(bit_vector_kernels_test, intersects) {
+    for (std::size_t count : word_counts) {
+        words_type lhs(count, 0x5555'5555'5555'5555);
+        words_type rhs(count, 0xaaaa'aaaa'aaaa'aaaa);
+        EXPECT_FALSE(kernels.intersects_words(lhs.data(), rhs.data(), count)) << count;
+
+        for (std::size_t position = 0; position < count; ++position) {
+            rhs[position] |= uint64_t{1} << ((2 * position) % 64);
+            EXPECT_TRUE(kernels.intersects_words(lhs.data(), rhs.data(), count)) << count << " " << position;
+            rhs[position] = 0xaaaa'aaaa'aaaa'aaaa;
+        }
+    }
+}
+
+TEST_P(bit_vector_kernels_test, and_count) {
+    for (std::size_t count : word_counts) {
+        words_type lhs = random_words(count, 21);
+        words_type rhs = random_words(count, 5);
+        EXPECT_EQ(kernels.and_count_words(lhs.data(), rhs.data(), count),
+                  expected.and_count_words(lhs.data(), rhs.data(), count)) << count;
+        EXPECT_EQ(kernels.and_count_words(lhs.data(), lhs.data(), count),
+                  expected.count_words(lhs.data(), count)) << count;
+    }
+}
+
+TEST_P(bit_vector_kernels_test, transpose) {
+    for (std::size_t block_count : {0u, 1u, 3u}) {
+        words_type const blocks = random_words(block_count * 64, 17);
+        words_type transposed{blocks};
+        kernels.transpose_blocks(transposed.data(), block_count);
+
+        for (std::size_t block = 0; block < block_count; ++block)
+            for (std::size_t row = 0; row < 64; ++row)
+                for (std::size_t column = 0; column < 64; ++column)
+                    ASSERT_EQ((transposed[block * 64 + column] >> row) & 1, (blocks[block * 64 + row] >> column) & 1)
+                        << block << " " << row << " " << column;
+
+        kernels.transpose_blocks(transposed.data(), block_count);
+        EXPECT_EQ(transposed, blocks) << block_count;
+    }
+}
+
+TEST(bit_vector_kernels_dispatch, active_kernels) {
+    bit_kernels const & active = libjst::detail::active_bit_kernels();
+    EXPECT_TRUE(libjst::detail::supports_bit_kernel_target(active.target));
+    EXPECT_EQ(&active, &libjst::detail::active_bit_kernels());
+}
+
+INSTANTIATE_TEST_SUITE_P(targets, bit_vector_kernels_test, testing::Values(bit_kernel_target::scalar,
+                                                                           bit_kernel_target::avx2,
+                                                                           bit_kernel_target::avx512,
+                                                                           bit_kernel_target::neon));
@@ -0,0 +1,141 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <sstream>
+#include <vector>
+
+#include <cereal/archives/json.hpp>
+
+#include <libjst/utility/bit_vector.hpp>
+#include <libjst/utility/bit_vector_rank_select.hpp>
+
+struct bit_vector_rank_select_test : public ::testing::Test
+{
+    using bit_vector_type = libjst::bit_vector<>;
+    using rank_select_type = libjst::bit_vector_rank_select<bit_vector_type>;
+
+    static bit_vector_type random_bits(size_t const size, unsigned const density, unsigned const seed)
+    {
+        std::mt19937 generator{seed};
+        bit_vector_type bits(size, false);
+        for (size_t i = 0; i < size; ++i)
+            bits[i] = generator() % 100 < density;
+        return bits;
+    }
+
+    // Checks rank and select against a linear scan over the bits.
+    static void expect_consistent(bit_vector_type const & bits, rank_select_type const & rank_select)
+    {
+        std::vector<size_t> positions{};
+        for (size_t i = 0; i < bits.size(); ++i) {
+            EXPECT_EQ(rank_select.rank(i), positions.size()) << i;
+            if (bits[i])
+                positions.push_back(i);
+        }
+        EXPECT_EQ(rank_select.rank(bits.size()), positions.size());
+        EXPECT_EQ(rank_select.count(), positions.size());
+        EXPECT_EQ(rank_select.count(), bits.count());
+
+        for (size_t k = 0; k < positions.size(); ++k)
+            EXPECT_EQ(rank_select.select(k), positions[k]) << k;
+    }
+};
+
+TEST_F(bit_vector_rank_select_test, empty)
+{
+    bit_vector_type bits{};
+    rank_select_type rank_select{bits};
+
+    EXPECT_EQ(rank_select.count(), 0u);
+    EXPECT_EQ(rank_select.rank(0), 0u);
+    EXPECT_EQ(rank_select_type{}.count(), 0u);
+}
+
+TEST_F(bit_vector_rank_select_test, small)
+{
+    bit_vector_type bits{false, true, true, false, true};
+    rank_select_type rank_select{bits};
+
+    EXPECT_EQ(rank_select.rank(0), 0u);
+    EXPECT_EQ(rank_select.rank(2), 1u);
+    EXPECT_EQ(rank_select.rank(5), 3u);
+    EXPECT_EQ(rank_select.select(0), 1u);
+    EXPECT_EQ(rank_select.select(1), 2u);
+    EXPECT_EQ(rank_select.select(2), 4u);
+}
+
+TEST_F(bit_vector_rank_select_test, random)
+{
+    // Sizes around the word and superblock boundaries with sparse, balanced and dense bits.
+    for (size_t const size : {63u, 64u, 65u, 511u, 512u, 513u, 1024u, 3001u})
+        for (unsigned const density : {1u, 50u, 99u}) {
+            bit_vector_type const bits = random_bits(size, density, size + density);
+            expect_consistent(bits, rank_select_type{bits});
+        }
+}
+
+TEST_F(bit_vector_rank_select_test, empty_superblocks)
+{
+    bit_vector_type bits(4096, false);
+    bits[3] = true;
+    bits[2048] = true;
+    bits[4095] = true;
+    rank_select_type rank_select{bits};
+
+    expect_consistent(bits, rank_select);
+}
+
+TEST_F(bit_vector_rank_select_test, padding)
+{
+    bit_vector_type bits(66, true);
+    bits.data()[1] = ~uint64_t{0}; // sets the padding bits beyond the size.
+    rank_select_type rank_select{bits};
+
+    EXPECT_EQ(rank_select.count(), 66u);
+    EXPECT_EQ(rank_select.rank(66), 66u);
+    EXPECT_EQ(rank_select.select(65), 65u);
+}
+
+TEST_F(bit_vector_rank_select_test, rebuild)
+{
+    bit_vector_type bits = random_bits(2000, 50, 1);
+    rank_select_type rank_select{bits};
+    expect_consistent(bits, rank_select);
+
+    bits &= random_bits(2000, 50, 2);
+    rank_select.rebuild();
+    expect_consistent(bits, rank_select);
+
+    bit_vector_type other = random_bits(700, 20, 3);
+    rank_select.rebuild(other);
+    expect_consistent(other, rank_select);
+}
+
+TEST_F(bit_vector_rank_select_test, serialisation)
+{
+    bit_vector_type const bits = random_bits(1500, 30, 4);
+    rank_select_type const expected{bits};
+
+    std::stringstream archive_stream{};
+    {
+        cereal::JSONOutputArchive output_archive(archive_stream);
+        output_archive(expected);
+    }
+
+    rank_select_type actual{};
+    {
+        cereal::JSONInputArchive input_archive(archive_stream);
+        input_archive(actual);
+    }
+    actual.set_vector(bits);
+
+    EXPECT_EQ(actual.memory_usage(), expected.memory_usage());
+    expect_consistent(bits, actual);
+}
@@ -369,6 +369,106 @@ TYPED_TEST(bit_vector_test, none)
     }
 }
 
+TYPED_TEST(bit_vector_test, count)
+{
+    { // empty vector
+        TypeParam test_vector{};
+        EXPECT_EQ(test_vector.count(), 0u);
+    }
+
+    {
+        TypeParam test_vector(250, true);
+        EXPECT_EQ(test_vector.count(), 250u);
+
+        test_vector[249] = false;
+        test_vector[0] = false;
+        EXPECT_EQ(test_vector.count(), 248u);
+
+        test_vector.resize(70);
+        EXPECT_EQ(test_vector.count(), 69u);
+    }
+}
+
+TYPED_TEST(bit_vector_test, intersects)
+{
+    EXPECT_FALSE(TypeParam{}.intersects(TypeParam{}));
+
+    TypeParam lhs(250, false);
+    TypeParam rhs(250, true);
+    EXPECT_FALSE(lhs.intersects(rhs));
+    EXPECT_EQ(lhs.intersection_count(rhs), 0u);
+
+    lhs[249] = true;
+    EXPECT_TRUE(lhs.intersects(rhs));
+    EXPECT_TRUE(rhs.intersects(lhs));
+    EXPECT_EQ(lhs.intersection_count(rhs), 1u);
+
+    lhs[3] = true;
+    lhs[64] = true;
+    rhs[64] = false;
+    EXPECT_EQ(lhs.intersection_count(rhs), 2u);
+    EXPECT_EQ(rhs.intersection_count(rhs), 249u);
+
+    rhs.flip(); // sets the padding bits of the last word.
+    lhs.flip();
+    lhs[64] = true;
+    EXPECT_TRUE(lhs.intersects(rhs));
+    rhs[64] = false;
+    EXPECT_FALSE(lhs.intersects(rhs)); // only the padding bits are set in both.
+    EXPECT_EQ(lhs.intersection_count(rhs), 0u);
+}
+
+TYPED_TEST(bit_vector_test, assign_and)
+{
+    TypeParam lhs{true, true, false, true, false};
+    TypeParam rhs{true, false, false, true, true};
+    TypeParam expected{true, false, false, true, false};
+
+    TypeParam target{};
+    target.assign_and(lhs, rhs);
+    EXPECT_EQ(target, expected);
+
+    target.assign_and(target, TypeParam{false, false, false, true, false}); // aliased operand
+    EXPECT_EQ(target, (TypeParam{false, false, false, true, false}));
+
+    lhs.assign_and(lhs, rhs);
+    EXPECT_EQ(lhs, expected);
+}
+
+TYPED_TEST(bit_vector_test, assign_or)
+{
+    TypeParam lhs{true, true, false, false, false};
+    TypeParam rhs{true, false, false, true, false};
+    TypeParam expected{true, true, false, true, false};
+
+    TypeParam target{};
+    target.assign_or(lhs, rhs);
+    EXPECT_EQ(target, expected);
+
+    target.assign_or(target, TypeParam{false, false, false, false, true}); // aliased operand
+    EXPECT_EQ(target, (TypeParam{true, true, false, true, true}));
+
+    lhs.assign_or(lhs, rhs);
+    EXPECT_EQ(lhs, expected);
+}
+
+TYPED_TEST(bit_vector_test, assign_and_not)
+{
+    TypeParam lhs{true, true, false, true, false};
+    TypeParam rhs{true, false, false, true, true};
+    TypeParam expected{false, true, false, false, false};
+
+    TypeParam target{};
+    target.assign_and_not(lhs, rhs);
+    EXPECT_EQ(target, expected);
+
+    target.assign_and_not(target, TypeParam{false, true, false, false, false}); // aliased operand
+    EXPECT_EQ(target, (TypeParam{false, false, false, false, false}));
+
+    lhs.assign_and_not(lhs, rhs);
+    EXPECT_EQ(lhs, expected);
+}
+
 // ----------------------------------------------------------------------------
 // Modifiers
 // ----------------------------------------------------------------------------
@@ -0,0 +1,81 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include <libjst/utility/elias_fano_sequence.hpp>
+
+TEST(elias_fano_sequence_test, default_construction) {
+    libjst::elias_fano_sequence sequence{};
+    EXPECT_TRUE(sequence.empty());
+    EXPECT_EQ(sequence.size(), 0u);
+    EXPECT_EQ(sequence.lower_bound(0), 0u);
+    EXPECT_EQ(sequence.upper_bound(10), 0u);
+}
+
+TEST(elias_fano_sequence_test, access) {
+    std::vector<uint64_t> values{0, 0, 3, 7, 7, 7, 8, 15, 42, 99};
+    libjst::elias_fano_sequence sequence{values, 100};
+
+    EXPECT_EQ(sequence.size(), values.size());
+    EXPECT_EQ(sequence.universe(), 100u);
+    EXPECT_EQ(sequence.low_width(), 3u);
+    for (std::size_t index = 0; index < values.size(); ++index)
+        EXPECT_EQ(sequence[index], values[index]) << index;
+}
+
+TEST(elias_fano_sequence_test, lower_and_upper_bound) {
+    std::vector<uint64_t> values{0, 0, 3, 7, 7, 7, 8, 15, 42, 99};
+    libjst::elias_fano_sequence sequence{values, 100};
+
+    for (uint64_t value = 0; value < 110; ++value) {
+        EXPECT_EQ(sequence.lower_bound(value), std::ranges::lower_bound(values, value) - values.begin()) << value;
+        EXPECT_EQ(sequence.upper_bound(value), std::ranges::upper_bound(values, value) - values.begin()) << value;
+    }
+}
+
+TEST(elias_fano_sequence_test, random) {
+    std::mt19937_64 generator{42};
+    for (uint64_t universe : {1ull, 64ull, 1000ull, 1ull << 20, 1ull << 40}) {
+        for (std::size_t count : {1ull, 10ull, 1000ull, 5000ull}) {
+            std::uniform_int_distribution<uint64_t> distribution{0, universe - 1};
+            std::vector<uint64_t> values(count);
+            std::ranges::generate(values, [&] () { return distribution(generator); });
+            std::ranges::sort(values);
+            libjst::elias_fano_sequence sequence{values, universe};
+
+            ASSERT_EQ(sequence.size(), count);
+            for (std::size_t index = 0; index < count; ++index)
+                ASSERT_EQ(sequence[index], values[index]) << universe << " " << count << " " << index;
+            for (std::size_t query = 0; query < 1000; ++query) {
+                uint64_t const value = distribution(generator);
+                ASSERT_EQ(sequence.lower_bound(value), std::ranges::lower_bound(values, value) - values.begin());
+                ASSERT_EQ(sequence.upper_bound(value), std::ranges::upper_bound(values, value) - values.begin());
+            }
+        }
+    }
+}
+
+TEST(elias_fano_sequence_test, compression) {
+    std::vector<uint64_t> values{};
+    for (uint64_t value = 0; value < (1ull << 20); value += 16)
+        values.push_back(value);
+    libjst::elias_fano_sequence sequence{values, 1ull << 20};
+
+    EXPECT_LT(sequence.memory_usage() * 8, values.size() * 7); // less than seven bits per value
+}
+
+TEST(elias_fano_sequence_test, invalid_values) {
+    EXPECT_THROW((libjst::elias_fano_sequence{std::vector<uint64_t>{3, 2}, 10}), std::invalid_argument);
+    EXPECT_THROW((libjst::elias_fano_sequence{std::vector<uint64_t>{3, 10}, 10}), std::invalid_argument);
+}
@@ -0,0 +1,70 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <random>
+#include <vector>
+
+#include <libjst/utility/eytzinger_index.hpp>
+
+struct eytzinger_index_test : public testing::Test
+{
+    using index_t = libjst::eytzinger_index<uint32_t>;
+
+    static void expect_lower_bounds(std::vector<uint32_t> const & sorted_values) {
+        index_t const index{sorted_values};
+        EXPECT_EQ(index.size(), sorted_values.size());
+
+        uint32_t const max_value = sorted_values.empty() ? 0 : sorted_values.back();
+        for (uint32_t key = 0; key <= max_value + 1; ++key) {
+            std::size_t const expected = std::ranges::distance(sorted_values.begin(),
+                                                               std::ranges::lower_bound(sorted_values, key));
+            EXPECT_EQ(index.lower_bound(key), expected) << "key: " << key << ", size: " << sorted_values.size();
+        }
+    }
+};
+
+TEST_F(eytzinger_index_test, empty)
+{
+    index_t const index{};
+    EXPECT_TRUE(index.empty());
+    EXPECT_EQ(index.lower_bound(5u), 0u);
+    expect_lower_bounds({});
+}
+
+TEST_F(eytzinger_index_test, lower_bound)
+{
+    expect_lower_bounds({3});
+    expect_lower_bounds({1, 3, 5, 7, 9, 11, 13});
+    expect_lower_bounds({0, 0, 1, 1, 1, 4, 4, 8, 8, 8, 8, 9});
+}
+
+TEST_F(eytzinger_index_test, all_sizes)
+{
+    std::mt19937 generator{42};
+    std::uniform_int_distribution<uint32_t> distribution{0, 300};
+    for (std::size_t size = 1; size <= 130; ++size) {
+        std::vector<uint32_t> values(size);
+        std::ranges::generate(values, [&] () { return distribution(generator); });
+        std::ranges::sort(values);
+        expect_lower_bounds(values);
+    }
+}
+
+TEST_F(eytzinger_index_test, compare)
+{
+    std::vector<uint32_t> const values{9, 7, 7, 4, 1};
+    libjst::eytzinger_index<uint32_t, std::greater<>> const index{values};
+    EXPECT_EQ(index.lower_bound(10u), 0u);
+    EXPECT_EQ(index.lower_bound(7u), 1u);
+    EXPECT_EQ(index.lower_bound(5u), 3u);
+    EXPECT_EQ(index.lower_bound(0u), 5u);
+}
@@ -0,0 +1,105 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <iterator>
+#include <ranges>
+#include <stdexcept>
+#include <vector>
+
+#include <libjst/utility/generator.hpp>
+
+namespace jst::test::generator {
+
+inline libjst::generator<int> iota(int const count, int & resumed) {
+    for (int value = 0; value < count; ++value) {
+        ++resumed;
+        co_yield value;
+    }
+}
+
+inline libjst::generator<int> throwing(int const count) {
+    for (int value = 0; value < count; ++value)
+        co_yield value;
+    throw std::runtime_error{"exhausted"};
+}
+
+} // namespace jst::test::generator
+
+TEST(generator_test, concept)
+{
+    EXPECT_TRUE(std::ranges::input_range<libjst::generator<int>>);
+    EXPECT_TRUE(std::ranges::view<libjst::generator<int>>);
+    EXPECT_FALSE(std::ranges::forward_range<libjst::generator<int>>);
+}
+
+TEST(generator_test, values)
+{
+    int resumed{};
+    std::vector<int> values{};
+    for (int value : jst::test::generator::iota(4, resumed))
+        values.push_back(value);
+
+    EXPECT_EQ(values, (std::vector<int>{0, 1, 2, 3}));
+    EXPECT_EQ(resumed, 4);
+}
+
+TEST(generator_test, empty)
+{
+    int resumed{};
+    auto values = jst::test::generator::iota(0, resumed);
+    EXPECT_TRUE(values.begin() == values.end());
+    EXPECT_EQ(resumed, 0);
+}
+
+TEST(generator_test, lazy)
+{
+    int resumed{};
+    {
+        auto values = jst::test::generator::iota(100, resumed);
+        EXPECT_EQ(resumed, 0);
+
+        auto it = values.begin();
+        EXPECT_EQ(*it, 0);
+        EXPECT_EQ(resumed, 1);
+        ++it;
+        EXPECT_EQ(*it, 1);
+        EXPECT_EQ(resumed, 2);
+    } // destroys the suspended coroutine
+    EXPECT_EQ(resumed, 2);
+}
+
+TEST(generator_test, resume)
+{
+    int resumed{};
+    auto values = jst::test::generator::iota(4, resumed);
+    auto it = values.begin();
+    EXPECT_EQ(*it, 0);
+
+    auto moved = std::move(values);
+    ++it;
+    EXPECT_EQ(*it, 1);
+    ++it; ++it;
+    EXPECT_EQ(*it, 3);
+    ++it;
+    EXPECT_TRUE(it == moved.end());
+}
+
+TEST(generator_test, exception)
+{
+    auto values = jst::test::generator::throwing(2);
+    auto it = values.begin();
+    EXPECT_EQ(*it, 0);
+    ++it;
+    EXPECT_EQ(*it, 1);
+    EXPECT_THROW(++it, std::runtime_error);
+    EXPECT_TRUE(it == values.end());
+
+    auto failing = jst::test::generator::throwing(0);
+    EXPECT_THROW(failing.begin(), std::runtime_error);
+}
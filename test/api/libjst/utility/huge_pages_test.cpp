@@ -0,0 +1,79 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/utility/huge_pages.hpp>
+
+TEST(huge_pages_test, advise_small)
+{
+    std::vector<uint32_t> values(100, 7);
+    EXPECT_EQ(libjst::advise_huge_pages(values), 0u);
+    EXPECT_EQ(libjst::advise_huge_pages(uint32_t{7}), 0u);
+    EXPECT_EQ(libjst::advise_huge_pages(nullptr, libjst::huge_page_size), 0u);
+}
+
+TEST(huge_pages_test, advise_large)
+{
+    std::vector<uint64_t> values(3 * libjst::huge_page_size / sizeof(uint64_t), 7);
+    std::size_t const advised = libjst::advise_huge_pages(values);
+    EXPECT_LE(advised, values.capacity() * sizeof(uint64_t));
+    EXPECT_EQ(advised % libjst::huge_page_size, 0u);
+    EXPECT_TRUE(std::ranges::all_of(values, [] (uint64_t const value) { return value == 7; }));
+}
+
+TEST(huge_pages_test, allocator)
+{
+    using allocator_t = libjst::huge_page_allocator<uint32_t>;
+
+    std::vector<uint32_t, allocator_t> small_values(100, 7);
+    EXPECT_TRUE(std::ranges::all_of(small_values, [] (uint32_t const value) { return value == 7; }));
+
+    std::vector<uint32_t, allocator_t> large_values(libjst::huge_page_size, 3);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(large_values.data()) % libjst::huge_page_size, 0u);
+    EXPECT_TRUE(std::ranges::all_of(large_values, [] (uint32_t const value) { return value == 3; }));
+
+    // Grows by reallocation into a new mapping.
+    large_values.resize(3 * libjst::huge_page_size, 5);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(large_values.data()) % libjst::huge_page_size, 0u);
+    EXPECT_EQ(large_values[libjst::huge_page_size - 1], 3u);
+    EXPECT_EQ(large_values.back(), 5u);
+
+    // Falls back to transparent huge pages if no reserved huge pages are free.
+    std::vector<char, libjst::huge_page_allocator<char>> reserved(
+        libjst::huge_page_size, 'A', libjst::huge_page_allocator<char>{libjst::huge_page_policy::hugetlb});
+    EXPECT_EQ(reserved.get_allocator().policy(), libjst::huge_page_policy::hugetlb);
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(reserved.data()) % libjst::huge_page_size, 0u);
+    EXPECT_EQ(reserved.back(), 'A');
+}
+
+TEST(huge_pages_test, store)
+{
+    using coverage_t = libjst::bit_coverage<uint32_t>;
+    using cms_t = libjst::dna_compressed_multisequence<std::string, coverage_t>;
+    using rcs_store_t = libjst::rcs_store<std::string, cms_t>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+
+    std::string const source(3 * libjst::huge_page_size, 'A');
+    rcs_store_t store{source, 64};
+    auto const domain = store.variants().coverage_domain();
+    store.add(cms_value_t{libjst::breakpoint{10u, 1u}, "C", coverage_t{{0, 3}, domain}});
+
+    // The source spans at least one whole huge page unless the platform does not support them.
+    std::size_t const advised = store.advise_huge_pages();
+    EXPECT_LE(advised, store.memory_usage().total());
+    EXPECT_EQ(advised % libjst::huge_page_size, 0u);
+    EXPECT_EQ(store.source()[10], 'A');
+}
@@ -0,0 +1,92 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <libjst/utility/lz_block_codec.hpp>
+
+namespace {
+
+std::vector<std::byte> round_trip(std::vector<std::byte> const & input, std::size_t & compressed_size) {
+    std::vector<std::byte> compressed{};
+    libjst::lz_block_codec::compress(input, compressed);
+    compressed_size = compressed.size();
+    std::vector<std::byte> output(input.size());
+    libjst::lz_block_codec::decompress(compressed, output);
+    return output;
+}
+
+std::vector<std::byte> to_bytes(std::string const & text) {
+    std::vector<std::byte> bytes(text.size());
+    std::ranges::transform(text, bytes.begin(), [] (char const symbol) { return static_cast<std::byte>(symbol); });
+    return bytes;
+}
+
+} // namespace
+
+TEST(lz_block_codec_test, empty) {
+    std::size_t compressed_size{};
+    EXPECT_TRUE(round_trip({}, compressed_size).empty());
+    EXPECT_EQ(compressed_size, 1u);
+}
+
+TEST(lz_block_codec_test, short_input) {
+    std::size_t compressed_size{};
+    for (std::string const text : {"A", "ACG", "ACGT", "ACGTA"})
+        EXPECT_EQ(round_trip(to_bytes(text), compressed_size), to_bytes(text));
+}
+
+TEST(lz_block_codec_test, runs) {
+    std::vector<std::byte> input(100000, std::byte{0});
+    input[5000] = std::byte{1};
+    input[70000] = std::byte{255};
+    std::size_t compressed_size{};
+    EXPECT_EQ(round_trip(input, compressed_size), input);
+    EXPECT_LT(compressed_size, 1000u);
+}
+
+TEST(lz_block_codec_test, random) {
+    std::mt19937 generator{7};
+    for (std::size_t const size : {15u, 16u, 255u, 1000u, 100000u}) {
+        std::vector<std::byte> input(size);
+        for (std::byte & value : input)
+            value = static_cast<std::byte>("ACGT"[generator() % 4]);
+        // repeats beyond and within the window
+        for (std::size_t idx = size / 2; idx < size; ++idx)
+            if (generator() % 4 != 0)
+                input[idx] = input[idx - size / 2];
+
+        std::size_t compressed_size{};
+        EXPECT_EQ(round_trip(input, compressed_size), input);
+    }
+}
+
+TEST(lz_block_codec_test, corrupted) {
+    std::vector<std::byte> const input = to_bytes("ACGTACGTACGTACGTACGTACGTACGTTTTTTTTTTTTTTTTTTT");
+    std::vector<std::byte> compressed{};
+    libjst::lz_block_codec::compress(input, compressed);
+
+    std::vector<std::byte> output(input.size());
+    EXPECT_THROW(libjst::lz_block_codec::decompress(std::span{compressed}.first(compressed.size() - 1), output),
+                 std::runtime_error);
+
+    std::vector<std::byte> too_small(input.size() - 1);
+    EXPECT_THROW(libjst::lz_block_codec::decompress(compressed, too_small), std::runtime_error);
+
+    std::vector<std::byte> too_large(input.size() + 1);
+    EXPECT_THROW(libjst::lz_block_codec::decompress(compressed, too_large), std::runtime_error);
+
+    EXPECT_THROW(libjst::lz_block_codec::decompress({}, output), std::runtime_error);
+}
@@ -0,0 +1,112 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/utility/bit_vector.hpp>
+#include <libjst/utility/memory_usage.hpp>
+#include <libjst/utility/sorted_vector.hpp>
+
+using namespace std::literals;
+
+TEST(memory_usage_test, vector)
+{
+    std::vector<uint32_t> values{};
+    EXPECT_EQ(libjst::memory_usage(values), 0u);
+
+    values.reserve(10);
+    EXPECT_EQ(libjst::memory_usage(values), values.capacity() * sizeof(uint32_t));
+
+    // The memory of the elements is added to the memory of the buffer.
+    std::vector<std::vector<uint32_t>> nested{values, values};
+    EXPECT_EQ(libjst::memory_usage(nested), nested.capacity() * sizeof(std::vector<uint32_t>) +
+                                            nested[0].capacity() * sizeof(uint32_t) +
+                                            nested[1].capacity() * sizeof(uint32_t));
+}
+
+TEST(memory_usage_test, string)
+{
+    std::string short_string{"ACGT"};
+    EXPECT_EQ(libjst::memory_usage(short_string), 0u); // stored within the string
+
+    std::string long_string(100, 'A');
+    EXPECT_EQ(libjst::memory_usage(long_string), long_string.capacity() + 1);
+}
+
+TEST(memory_usage_test, views)
+{
+    std::string const source(100, 'A');
+    EXPECT_EQ(libjst::memory_usage(std::span{source}), 0u);
+    EXPECT_EQ(libjst::memory_usage(uint32_t{7}), 0u);
+}
+
+TEST(memory_usage_test, member)
+{
+    libjst::bit_vector<> bits(1000, true);
+    EXPECT_GE(libjst::memory_usage(bits), 1000u / 8);
+    EXPECT_EQ(libjst::memory_usage(bits), bits.memory_usage());
+
+    libjst::sorted_vector<uint32_t> sorted{};
+    sorted.insert(3u);
+    sorted.insert(1u);
+    std::size_t const without_index = sorted.memory_usage();
+    EXPECT_GE(without_index, 2 * sizeof(uint32_t));
+    sorted.build_search_index();
+    EXPECT_GT(sorted.memory_usage(), without_index);
+}
+
+TEST(memory_usage_test, store)
+{
+    using coverage_t = libjst::bit_coverage<uint32_t>;
+    using cms_t = libjst::dna_compressed_multisequence<std::string, coverage_t>;
+    using rcs_store_t = libjst::rcs_store<std::string, cms_t>;
+    using cms_value_t = std::ranges::range_value_t<cms_t>;
+
+    std::string const source(1000, 'A');
+    rcs_store_t store{source, 64};
+    libjst::store_memory_usage const empty_usage = store.memory_usage();
+    EXPECT_EQ(empty_usage.source, source.capacity() + 1);
+    EXPECT_GT(empty_usage.breakend_keys, 0u); // the sentinel breakends
+    EXPECT_GT(empty_usage.coverages, 0u);
+    EXPECT_EQ(empty_usage.indel_map, 0u);
+    EXPECT_EQ(empty_usage.source_masks, 0u);
+
+    auto domain = store.variants().coverage_domain();
+    store.add(cms_value_t{libjst::breakpoint{10u, 1u}, "C"s, coverage_t{{0, 1}, domain}});
+    store.add(cms_value_t{libjst::breakpoint{20u, 0u}, "GGGG"s, coverage_t{{2}, domain}});
+    store.add(cms_value_t{libjst::breakpoint{30u, 5u}, ""s, coverage_t{{3}, domain}});
+
+    libjst::store_memory_usage const usage = store.memory_usage();
+    EXPECT_GT(usage.breakend_keys, empty_usage.breakend_keys);
+    EXPECT_GT(usage.coverages, empty_usage.coverages);
+    EXPECT_GE(usage.alt_sequences, 4u);
+    EXPECT_GT(usage.indel_map, 0u);
+    EXPECT_GE(usage.source_masks, 3 * sizeof(libjst::source_interval)); // the dirty regions
+    EXPECT_EQ(usage.total(), usage.source + usage.breakend_keys + usage.coverages + usage.alt_sequences +
+                             usage.indel_map + usage.position_index + usage.variant_classes + usage.carrier_counts +
+                             usage.source_masks);
+    EXPECT_EQ(libjst::memory_usage(store), usage.total());
+    EXPECT_EQ(usage.variant_classes, 0u);
+
+    store.build_variant_class_index();
+    EXPECT_GT(store.memory_usage().variant_classes, 0u);
+    store.build_carrier_count_index();
+    EXPECT_GT(store.memory_usage().carrier_counts, 0u);
+
+    libjst::store_memory_usage sum{};
+    sum += usage;
+    sum += empty_usage;
+    EXPECT_EQ(sum.total(), usage.total() + empty_usage.total());
+}
@@ -0,0 +1,111 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <libjst/utility/mpsc_queue.hpp>
+
+TEST(mpsc_queue_test, capacity)
+{
+    EXPECT_EQ(libjst::mpsc_queue<int>{}.capacity(), 2u);
+    EXPECT_EQ(libjst::mpsc_queue<int>{0}.capacity(), 2u);
+    EXPECT_EQ(libjst::mpsc_queue<int>{1}.capacity(), 2u);
+    EXPECT_EQ(libjst::mpsc_queue<int>{4}.capacity(), 4u);
+    EXPECT_EQ(libjst::mpsc_queue<int>{5}.capacity(), 8u);
+}
+
+TEST(mpsc_queue_test, full_and_empty)
+{
+    libjst::mpsc_queue<int> queue{2};
+    int value{};
+    EXPECT_FALSE(queue.try_pop(value));
+
+    value = 1;
+    EXPECT_TRUE(queue.try_push(value));
+    value = 2;
+    EXPECT_TRUE(queue.try_push(value));
+    value = 3;
+    EXPECT_FALSE(queue.try_push(value));
+    EXPECT_EQ(value, 3);
+
+    EXPECT_TRUE(queue.try_pop(value));
+    EXPECT_EQ(value, 1);
+    value = 4;
+    EXPECT_TRUE(queue.try_push(value));
+
+    EXPECT_TRUE(queue.try_pop(value));
+    EXPECT_EQ(value, 2);
+    EXPECT_TRUE(queue.try_pop(value));
+    EXPECT_EQ(value, 4);
+    EXPECT_FALSE(queue.try_pop(value));
+}
+
+TEST(mpsc_queue_test, recycle_values)
+{
+    libjst::mpsc_queue<std::vector<int>> queue{2};
+    std::vector<int> produced{1, 2, 3};
+    EXPECT_TRUE(queue.try_push(produced));
+    EXPECT_TRUE(produced.empty());
+    produced = {4};
+    EXPECT_TRUE(queue.try_push(produced));
+
+    std::vector<int> consumed{};
+    consumed.reserve(100);
+    int const * const buffer = consumed.data();
+    EXPECT_TRUE(queue.try_pop(consumed));
+    EXPECT_EQ(consumed, (std::vector<int>{1, 2, 3}));
+
+    // The next producer of the slot receives the buffer handed back by the consumer.
+    EXPECT_TRUE(queue.try_push(produced));
+    EXPECT_EQ(produced.data(), buffer);
+}
+
+TEST(mpsc_queue_test, many_producers)
+{
+    constexpr std::size_t producer_count{8};
+    constexpr std::size_t value_count{20000};
+
+    libjst::mpsc_queue<std::pair<std::size_t, std::size_t>> queue{4};
+    std::vector<std::thread> producers{};
+    for (std::size_t producer = 0; producer < producer_count; ++producer) {
+        producers.emplace_back([&, producer] () {
+            for (std::size_t value = 0; value < value_count; ++value) {
+                std::pair<std::size_t, std::size_t> entry{producer, value};
+                queue.push(entry);
+            }
+        });
+    }
+
+    // The values of every producer arrive in the order they were pushed.
+    std::vector<std::size_t> next(producer_count, 0);
+    std::size_t received{};
+    std::pair<std::size_t, std::size_t> entry{};
+    while (received < producer_count * value_count) {
+        uint64_t const epoch = queue.epoch();
+        if (queue.try_pop(entry)) {
+            ASSERT_LT(entry.first, producer_count);
+            EXPECT_EQ(entry.second, next[entry.first]);
+            ++next[entry.first];
+            ++received;
+        } else {
+            queue.wait(epoch);
+        }
+    }
+
+    for (std::thread & producer : producers)
+        producer.join();
+
+    EXPECT_FALSE(queue.try_pop(entry));
+    for (std::size_t const count : next)
+        EXPECT_EQ(count, value_count);
+}
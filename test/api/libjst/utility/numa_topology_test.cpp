@@ -0,0 +1,61 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include <libjst/utility/numa_topology.hpp>
+
+TEST(numa_topology, default_construction) {
+    libjst::numa_topology topology{};
+    EXPECT_EQ(topology.node_count(), 1u);
+    EXPECT_TRUE(topology.cpus(0).empty());
+    EXPECT_FALSE(topology.bind_current_thread(0).is_bound());
+}
+
+TEST(numa_topology, parse_cpu_list) {
+    using cpus_t = std::vector<unsigned>;
+    EXPECT_EQ(libjst::numa_topology::parse_cpu_list(""), cpus_t{});
+    EXPECT_EQ(libjst::numa_topology::parse_cpu_list("0"), (cpus_t{0}));
+    EXPECT_EQ(libjst::numa_topology::parse_cpu_list("0-3"), (cpus_t{0, 1, 2, 3}));
+    EXPECT_EQ(libjst::numa_topology::parse_cpu_list("0-1,8,10-11"), (cpus_t{0, 1, 8, 10, 11}));
+}
+
+TEST(numa_topology, node_of_worker) {
+    libjst::numa_topology topology{std::vector<std::vector<unsigned>>(4)};
+    EXPECT_EQ(topology.node_count(), 4u);
+
+    std::vector<std::size_t> workers_per_node(4);
+    for (std::size_t worker_id = 0; worker_id < 10; ++worker_id)
+        ++workers_per_node[topology.node_of_worker(worker_id, 10)];
+    EXPECT_EQ(workers_per_node, (std::vector<std::size_t>{3, 2, 3, 2}));
+
+    EXPECT_EQ(topology.node_of_worker(0, 1), 0u);
+    EXPECT_EQ(topology.node_of_worker(1, 2), 2u);
+}
+
+TEST(numa_topology, system) {
+    libjst::numa_topology topology = libjst::numa_topology::system();
+    EXPECT_GE(topology.node_count(), 1u);
+}
+
+TEST(numa_topology, bind_current_thread) {
+    libjst::numa_topology topology = libjst::numa_topology::system();
+    if (topology.cpus(0).empty())
+        GTEST_SKIP() << "The CPUs of the nodes are unknown.";
+
+    std::thread{[&] () {
+        libjst::numa_binding binding = topology.bind_current_thread(0);
+        libjst::numa_binding moved_binding{std::move(binding)};
+        EXPECT_FALSE(binding.is_bound());
+#if defined(__linux__)
+        EXPECT_TRUE(moved_binding.is_bound());
+#endif
+    }}.join();
+}
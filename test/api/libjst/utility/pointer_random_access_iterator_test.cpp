@@ -0,0 +1,103 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+// Enables the pointer iterators for this translation unit, like the CMake option LIBJST_POINTER_ITERATORS.
+#define LIBJST_POINTER_ITERATORS 1
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <libjst/utility/pointer_random_access_iterator.hpp>
+#include <libjst/utility/sorted_vector.hpp>
+#include <libjst/utility/stable_random_access_iterator.hpp>
+
+#include "iterator_test_template.hpp"
+
+namespace {
+
+using pointer_iterator = libjst::pointer_random_access_iterator<std::vector<int> const>;
+
+struct pointer_range
+{
+    std::vector<int> elements{};
+
+    pointer_iterator begin() const noexcept {
+        return pointer_iterator{std::addressof(elements), 0};
+    }
+
+    pointer_iterator end() const noexcept {
+        return pointer_iterator{std::addressof(elements), std::ranges::ssize(elements)};
+    }
+};
+
+} // namespace
+
+// ----------------------------------------------------------------------------
+// Iterator test
+// ----------------------------------------------------------------------------
+
+template <>
+struct iterator_fixture<pointer_iterator> : public ::testing::Test
+{
+    using iterator_tag = std::contiguous_iterator_tag;
+
+    static constexpr bool const_iterable = true;
+
+    pointer_range test_range{{1, 3, 5, 7, 9, 11, 13}};
+    std::vector<int> expected_range{1, 3, 5, 7, 9, 11, 13};
+};
+
+INSTANTIATE_TYPED_TEST_SUITE_P(pointer_random_access_iterator_test,
+                               iterator_fixture,
+                               ::testing::Types<pointer_iterator>, );
+
+TEST(pointer_random_access_iterator_test, concept)
+{
+    EXPECT_TRUE(std::contiguous_iterator<pointer_iterator>);
+    EXPECT_FALSE((std::output_iterator<pointer_iterator, int>));
+}
+
+TEST(pointer_random_access_iterator_test, from_stable_iterator)
+{
+    std::vector<int> elements{2, 4, 6, 8};
+    libjst::stable_random_access_iterator<std::vector<int>> stable_it{std::addressof(elements), 2};
+
+    pointer_iterator it{stable_it};
+    EXPECT_EQ(*it, 6);
+    EXPECT_EQ(it.base(), elements.data() + 2);
+    EXPECT_EQ((it - pointer_iterator{std::addressof(std::as_const(elements)), 0}), 2);
+}
+
+TEST(pointer_random_access_iterator_test, const_random_access_iterator_t)
+{
+    EXPECT_TRUE((std::same_as<libjst::const_random_access_iterator_t<std::vector<int>>, pointer_iterator>));
+    EXPECT_TRUE((std::same_as<libjst::const_random_access_iterator_t<std::deque<int>>,
+                              libjst::stable_random_access_iterator<std::deque<int> const>>));
+}
+
+TEST(pointer_random_access_iterator_test, sorted_vector)
+{
+    using sorted_vector_t = libjst::sorted_vector<std::size_t>;
+    EXPECT_TRUE((std::same_as<typename sorted_vector_t::const_iterator,
+                              libjst::pointer_random_access_iterator<std::vector<std::size_t> const>>));
+
+    sorted_vector_t values{};
+    for (std::size_t value : {5, 1, 3, 8})
+        values.insert(value);
+
+    auto hint = std::as_const(values).begin() + 2; // insertion with a hint, which may reallocate the container.
+    values.insert(hint, 4);
+    values.erase(std::ranges::next(std::as_const(values).begin()));
+    EXPECT_TRUE(std::ranges::equal(std::as_const(values), std::vector<std::size_t>{1, 4, 5, 8}));
+}
@@ -0,0 +1,113 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <ranges>
+#include <stdexcept>
+#include <vector>
+
+#include <libjst/utility/position_map.hpp>
+
+struct position_map_test : public testing::Test
+{
+    using position_map_t = libjst::position_map<uint32_t, int>;
+};
+
+// ----------------------------------------------------------------------------
+// Construction
+// ----------------------------------------------------------------------------
+
+TEST_F(position_map_test, construct_from_sorted)
+{
+    std::vector<uint32_t> keys{1, 3, 7, 10};
+    std::vector<int> values{10, 30, 70, 100};
+
+    position_map_t map{keys, values};
+
+    EXPECT_EQ(map.size(), 4u);
+    EXPECT_GE(map.capacity(), 4u);
+    auto it = map.begin();
+    for (size_t i = 0; i < keys.size(); ++i, ++it) {
+        EXPECT_EQ((*it).first, keys[i]);
+        EXPECT_EQ((*it).second, values[i]);
+    }
+    EXPECT_EQ(it, map.end());
+
+    // from non sized ranges
+    position_map_t filtered{keys | std::views::filter([] (uint32_t key) { return key > 2; }),
+                            values | std::views::filter([] (int value) { return value > 20; })};
+    EXPECT_EQ(filtered.size(), 3u);
+    EXPECT_EQ((*filtered.begin()).first, 3u);
+}
+
+TEST_F(position_map_test, construct_from_sorted_invalid)
+{
+    std::vector<uint32_t> keys{1, 3, 3, 10};
+    std::vector<int> values{10, 30, 70, 100};
+
+    EXPECT_THROW((position_map_t{keys, values}), std::invalid_argument);
+    EXPECT_THROW((position_map_t{std::vector<uint32_t>{1, 2}, values}), std::invalid_argument);
+    EXPECT_THROW((position_map_t{std::vector<uint32_t>{3, 1}, std::vector<int>{0, 1}}), std::invalid_argument);
+    EXPECT_THROW((position_map_t{std::vector<uint32_t>{1, 2} | std::views::filter([] (auto) { return true; }),
+                                 values}), std::invalid_argument);
+}
+
+// ----------------------------------------------------------------------------
+// Modifier
+// ----------------------------------------------------------------------------
+
+TEST_F(position_map_test, reserve)
+{
+    position_map_t map{};
+    map.reserve(100);
+    EXPECT_GE(map.capacity(), 100u);
+    EXPECT_TRUE(map.empty());
+}
+
+TEST_F(position_map_test, insert)
+{
+    position_map_t map{};
+
+    EXPECT_TRUE(map.insert({5, 50}).second);
+    EXPECT_TRUE(map.insert({1, 10}).second);
+    EXPECT_TRUE(map.insert({8, 80}).second);
+    EXPECT_FALSE(map.insert({5, 0}).second);
+
+    EXPECT_EQ(map.size(), 3u);
+    EXPECT_EQ((*map.lower_bound(5)).second, 50);
+    EXPECT_EQ((*map.begin()).first, 1u);
+}
+
+// ----------------------------------------------------------------------------
+// Lookup
+// ----------------------------------------------------------------------------
+
+TEST_F(position_map_test, lower_and_upper_bound)
+{
+    // Exceeds the linear scan threshold such that both search phases are exercised.
+    std::vector<uint32_t> keys(1000);
+    std::ranges::generate(keys, [key = 0u] () mutable { return key += 3; }); // 3, 6, ..., 3000
+    std::vector<int> values(keys.size());
+    std::iota(values.begin(), values.end(), 0);
+
+    position_map_t const map{keys, values};
+
+    for (uint32_t key = 0; key <= 3003; ++key) {
+        auto expected_lower = std::ranges::distance(keys.begin(), std::ranges::lower_bound(keys, key));
+        auto expected_upper = std::ranges::distance(keys.begin(), std::ranges::upper_bound(keys, key));
+        EXPECT_EQ(map.lower_bound(key) - map.begin(), expected_lower) << "key = " << key;
+        EXPECT_EQ(map.upper_bound(key) - map.begin(), expected_upper) << "key = " << key;
+    }
+
+    position_map_t const empty_map{};
+    EXPECT_EQ(empty_map.lower_bound(0), empty_map.end());
+    EXPECT_EQ(empty_map.upper_bound(0), empty_map.end());
+}
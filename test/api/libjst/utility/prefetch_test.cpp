@@ -0,0 +1,89 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <list>
+#include <vector>
+
+#include <libjst/utility/prefetch.hpp>
+#include <libjst/utility/sorted_vector.hpp>
+
+namespace {
+
+struct prefetch_recorder
+{
+    mutable std::vector<std::ptrdiff_t> positions{};
+
+    void prefetch(std::ptrdiff_t const position) const noexcept {
+        positions.push_back(position);
+    }
+};
+
+struct recording_iterator
+{
+    using difference_type = std::ptrdiff_t;
+    using value_type = int;
+
+    prefetch_recorder const * recorder{};
+
+    int operator*() const noexcept { return 0; }
+    recording_iterator & operator++() noexcept { return *this; }
+    recording_iterator operator++(int) noexcept { return *this; }
+
+    void prefetch(difference_type const distance) const noexcept {
+        recorder->prefetch(distance);
+    }
+};
+
+} // namespace
+
+TEST(prefetch_test, prefetch_element_member)
+{
+    prefetch_recorder recorder{};
+    libjst::prefetch_element(recorder, 3);
+    libjst::prefetch_element(recorder, 42);
+    EXPECT_EQ(recorder.positions, (std::vector<std::ptrdiff_t>{3, 42}));
+}
+
+TEST(prefetch_test, prefetch_element_out_of_range)
+{
+    std::vector<int> values{1, 2, 3};
+    libjst::prefetch_element(values, -1);
+    libjst::prefetch_element(values, 0);
+    libjst::prefetch_element(values, 3);
+    libjst::prefetch_element(values, 1 << 20);
+    libjst::prefetch_element(std::vector<int>{}, 0);
+    libjst::prefetch_element(std::list<int>{1, 2, 3}, 1);
+    EXPECT_EQ(values, (std::vector<int>{1, 2, 3}));
+}
+
+TEST(prefetch_test, prefetch_ahead)
+{
+    prefetch_recorder recorder{};
+    recording_iterator it{&recorder};
+    libjst::prefetch_ahead(it, 8);
+    libjst::prefetch_ahead(it, 0);
+    libjst::prefetch_ahead(it, -2);
+    EXPECT_EQ(recorder.positions, (std::vector<std::ptrdiff_t>{8}));
+
+    std::vector<int> values{1, 2, 3};
+    libjst::prefetch_ahead(values.begin(), 8); // iterators without a member prefetch ignore the hint.
+}
+
+TEST(prefetch_test, prefetch_ahead_sorted_vector)
+{
+    libjst::sorted_vector<std::size_t> values{};
+    for (std::size_t value : {5, 1, 3, 8})
+        values.insert(value);
+
+    for (auto it = values.begin(); it != values.end(); ++it)
+        libjst::prefetch_ahead(it, libjst::default_prefetch_distance);
+    libjst::prefetch_ahead(values.end(), libjst::default_prefetch_distance);
+    EXPECT_TRUE(std::ranges::equal(values, std::vector<std::size_t>{1, 3, 5, 8}));
+}
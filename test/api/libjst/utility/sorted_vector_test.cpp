@@ -9,7 +9,10 @@
 
 #include <algorithm>
 #include <concepts>
+#include <ranges>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <libjst/utility/sorted_vector.hpp>
 
@@ -54,6 +57,57 @@ TEST_F(sorted_vector_test, insert_hint)
     EXPECT_TRUE(std::ranges::equal(vec, (std::vector<size_t>{1, 3, 3, 5, 5, 5, 6, 10})));
 }
 
+TEST_F(sorted_vector_test, insert_range)
+{
+    sorted_vector_t vec{};
+    vec.insert(std::vector<size_t>{6, 3, 5});
+    EXPECT_TRUE(std::ranges::equal(vec, (std::vector<size_t>{3, 5, 6})));
+
+    vec.insert({10, 1, 5, 3, 5});
+    EXPECT_TRUE(std::ranges::equal(vec, (std::vector<size_t>{1, 3, 3, 5, 5, 5, 6, 10})));
+
+    vec.insert(std::views::iota(11u, 13u)); // behind all stored elements
+    vec.insert(std::vector<size_t>{});
+    EXPECT_TRUE(std::ranges::equal(vec, (std::vector<size_t>{1, 3, 3, 5, 5, 5, 6, 10, 11, 12})));
+}
+
+TEST_F(sorted_vector_test, insert_range_stable)
+{
+    // Compares only the first element, so equal elements are distinguished by the second.
+    struct compare_first {
+        constexpr bool operator()(std::pair<int, int> const & lhs, std::pair<int, int> const & rhs) const noexcept {
+            return lhs.first < rhs.first;
+        }
+    };
+
+    libjst::sorted_vector<std::pair<int, int>, compare_first> vec{};
+    vec.insert(std::pair{1, 0});
+    vec.insert(std::pair{2, 0});
+    vec.insert(std::vector<std::pair<int, int>>{{2, 1}, {1, 1}, {2, 2}, {0, 0}});
+    EXPECT_TRUE(std::ranges::equal(vec, (std::vector<std::pair<int, int>>{{0, 0}, {1, 0}, {1, 1},
+                                                                           {2, 0}, {2, 1}, {2, 2}})));
+}
+
+TEST_F(sorted_vector_test, merge)
+{
+    sorted_vector_t vec{};
+    vec.insert({1, 5, 6, 10});
+
+    sorted_vector_t source{};
+    source.insert({3, 3, 5, 5, 11});
+    vec.merge(source);
+    EXPECT_TRUE(source.empty());
+    EXPECT_TRUE(std::ranges::equal(vec, (std::vector<size_t>{1, 3, 3, 5, 5, 5, 6, 10, 11})));
+
+    sorted_vector_t other{};
+    other.insert({0, 12});
+    vec.merge(std::move(other));
+    EXPECT_TRUE(std::ranges::equal(vec, (std::vector<size_t>{0, 1, 3, 3, 5, 5, 5, 6, 10, 11, 12})));
+
+    vec.merge(vec);
+    EXPECT_EQ(vec.size(), 11u);
+}
+
 TEST_F(sorted_vector_test, emplace)
 {
     sorted_vector_t vec{};
@@ -361,3 +415,35 @@ TEST_F(sorted_vector_test, upper_bound)
     EXPECT_TRUE(std::as_const(vec).upper_bound(10) == vec.end());
     EXPECT_TRUE(std::as_const(vec).upper_bound(11) == vec.end());
 }
+
+TEST_F(sorted_vector_test, search_index)
+{
+    sorted_vector_t vec{};
+    vec.insert({1, 3, 3, 5, 5, 5, 6, 10});
+    EXPECT_FALSE(vec.has_search_index());
+
+    vec.build_search_index();
+    EXPECT_TRUE(vec.has_search_index());
+    for (size_t key = 0; key <= 11; ++key) {
+        EXPECT_EQ(vec.lower_bound(key) - vec.begin(), std::ranges::lower_bound(vec.data(), key) - vec.data().begin());
+        vec.build_search_index(); // data() drops the index.
+        EXPECT_EQ(vec.contains(key), std::ranges::binary_search(vec, key));
+    }
+    EXPECT_TRUE(std::as_const(vec).find(6) == std::ranges::next(vec.begin(), 6));
+    EXPECT_TRUE(std::as_const(vec).find(7) == vec.end());
+
+    // Every modification drops the index.
+    vec.insert(4);
+    EXPECT_FALSE(vec.has_search_index());
+    EXPECT_EQ(*vec.lower_bound(4), 4u);
+    vec.build_search_index();
+    vec.erase(vec.begin());
+    EXPECT_FALSE(vec.has_search_index());
+    vec.build_search_index();
+    vec.insert({0});
+    EXPECT_FALSE(vec.has_search_index());
+
+    sorted_vector_t copy{vec};
+    copy.build_search_index();
+    EXPECT_TRUE(copy == vec);
+}
@@ -0,0 +1,103 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <libjst/utility/task.hpp>
+
+namespace jst::test::task {
+
+libjst::task<int> answer() {
+    co_return 42;
+}
+
+libjst::task<std::string> nested() {
+    int const value = co_await answer();
+    co_return std::to_string(value);
+}
+
+libjst::task<int> failing() {
+    throw std::runtime_error{"failed"};
+    co_return 0;
+}
+
+template <typename scheduler_t>
+libjst::task<std::thread::id> thread_of(scheduler_t & scheduler) {
+    co_await libjst::schedule(scheduler);
+    co_return std::this_thread::get_id();
+}
+
+} // namespace jst::test::task
+
+TEST(task_test, sync_wait) {
+    EXPECT_EQ(libjst::sync_wait(jst::test::task::answer()), 42);
+    EXPECT_EQ(libjst::sync_wait(jst::test::task::nested()), "42");
+    EXPECT_THROW(libjst::sync_wait(jst::test::task::failing()), std::runtime_error);
+
+    libjst::inline_scheduler scheduler{};
+    EXPECT_EQ(libjst::sync_wait(jst::test::task::thread_of(scheduler)), std::this_thread::get_id());
+}
+
+TEST(task_test, lazy) {
+    bool started{false};
+    {
+        auto lazy = [&] () -> libjst::task<void> {
+            started = true;
+            co_return;
+        }();
+        EXPECT_TRUE(lazy);
+    }
+    EXPECT_FALSE(started);
+}
+
+TEST(task_test, schedule_on_pool) {
+    libjst::static_thread_pool pool{2};
+    EXPECT_EQ(pool.thread_count(), 2u);
+    EXPECT_NE(libjst::sync_wait(jst::test::task::thread_of(pool)), std::this_thread::get_id());
+}
+
+TEST(task_test, when_all) {
+    libjst::static_thread_pool pool{4};
+    std::vector<libjst::task<std::size_t>> tasks{};
+    for (std::size_t idx = 0; idx < 100; ++idx)
+        tasks.push_back([] (auto & scheduler, std::size_t value) -> libjst::task<std::size_t> {
+            co_await libjst::schedule(scheduler);
+            co_return value * value;
+        }(pool, idx));
+
+    std::vector<std::size_t> const squares = libjst::sync_wait(libjst::when_all(std::move(tasks)));
+    ASSERT_EQ(squares.size(), 100u);
+    for (std::size_t idx = 0; idx < squares.size(); ++idx)
+        EXPECT_EQ(squares[idx], idx * idx);
+
+    EXPECT_TRUE(libjst::sync_wait(libjst::when_all(std::vector<libjst::task<int>>{})).empty());
+}
+
+TEST(task_test, when_all_void_rethrows) {
+    libjst::static_thread_pool pool{2};
+    std::atomic<std::size_t> completed{};
+    std::vector<libjst::task<void>> tasks{};
+    for (std::size_t idx = 0; idx < 10; ++idx)
+        tasks.push_back([] (auto & scheduler, std::size_t value, std::atomic<std::size_t> & done)
+            -> libjst::task<void> {
+            co_await libjst::schedule(scheduler);
+            done.fetch_add(1);
+            if (value == 3)
+                throw std::invalid_argument{"three"};
+        }(pool, idx, completed));
+
+    EXPECT_THROW(libjst::sync_wait(libjst::when_all(std::move(tasks))), std::invalid_argument);
+    EXPECT_EQ(completed.load(), 10u); // all tasks completed before the exception was rethrown.
+}
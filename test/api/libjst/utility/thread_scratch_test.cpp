@@ -0,0 +1,102 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <libjst/utility/arena_allocator.hpp>
+#include <libjst/utility/thread_scratch.hpp>
+
+using scratch_t = std::vector<int>;
+
+TEST(thread_scratch_test, reuse)
+{
+    int const * data{};
+    {
+        std::shared_ptr<scratch_t> scratch = libjst::acquire_scratch<scratch_t>();
+        scratch->assign(100, 1);
+        data = scratch->data();
+    }
+
+    // The released object keeps its memory and is returned in the state it was released in.
+    std::shared_ptr<scratch_t> scratch = libjst::acquire_scratch<scratch_t>();
+    EXPECT_EQ(scratch->data(), data);
+    EXPECT_EQ(scratch->size(), 100u);
+}
+
+TEST(thread_scratch_test, in_use)
+{
+    std::shared_ptr<scratch_t> first = libjst::acquire_scratch<scratch_t>();
+    std::shared_ptr<scratch_t> copy = first;
+    std::shared_ptr<scratch_t> second = libjst::acquire_scratch<scratch_t>();
+    EXPECT_NE(first, second);
+
+    first.reset();
+    EXPECT_NE(libjst::acquire_scratch<scratch_t>(), copy); // still used by the copy
+
+    copy.reset();
+    second.reset();
+    std::shared_ptr<scratch_t> third = libjst::acquire_scratch<scratch_t>();
+    std::shared_ptr<scratch_t> fourth = libjst::acquire_scratch<scratch_t>();
+    EXPECT_NE(third, fourth);
+}
+
+TEST(thread_scratch_test, beyond_pool)
+{
+    std::vector<std::shared_ptr<scratch_t>> scratches{};
+    for (int i = 0; i < 32; ++i)
+        scratches.push_back(libjst::acquire_scratch<scratch_t>());
+
+    for (int i = 0; i < 32; ++i)
+        for (int j = i + 1; j < 32; ++j)
+            EXPECT_NE(scratches[i], scratches[j]);
+}
+
+TEST(thread_scratch_test, arena)
+{
+    std::shared_ptr<scratch_t> pooled = libjst::acquire_scratch<scratch_t>();
+    scratch_t const * const pooled_address = pooled.get();
+    pooled.reset();
+
+    {
+        libjst::scoped_arena arena{};
+        // Objects acquired within an arena are not pooled.
+        std::shared_ptr<scratch_t> scratch = libjst::acquire_scratch<scratch_t>();
+        EXPECT_NE(scratch.get(), pooled_address);
+    }
+
+    EXPECT_EQ(libjst::acquire_scratch<scratch_t>().get(), pooled_address);
+}
+
+TEST(thread_scratch_test, per_thread)
+{
+    std::shared_ptr<scratch_t> main_scratch = libjst::acquire_scratch<scratch_t>();
+    scratch_t const * const main_address = main_scratch.get();
+    main_scratch.reset();
+
+    std::vector<std::shared_ptr<scratch_t>> thread_scratches(4);
+    std::vector<std::thread> threads{};
+    for (std::size_t idx = 0; idx < thread_scratches.size(); ++idx)
+        threads.emplace_back([&, idx] () {
+            thread_scratches[idx] = libjst::acquire_scratch<scratch_t>();
+            thread_scratches[idx]->assign(10, static_cast<int>(idx));
+        });
+    for (std::thread & thread : threads)
+        thread.join();
+
+    for (std::size_t idx = 0; idx < thread_scratches.size(); ++idx) {
+        EXPECT_NE(thread_scratches[idx].get(), main_address);
+        EXPECT_EQ(thread_scratches[idx]->front(), static_cast<int>(idx));
+    }
+
+    // The objects of the other threads can be released on this thread.
+    thread_scratches.clear();
+    EXPECT_EQ(libjst::acquire_scratch<scratch_t>().get(), main_address);
+}
@@ -0,0 +1,150 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <ranges>
+#include <string>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/sequence_tree/coloured_tree.hpp>
+#include <libjst/sequence_tree/labelled_tree.hpp>
+#include <libjst/sequence_tree/left_extend_tree.hpp>
+#include <libjst/sequence_tree/merge_tree.hpp>
+#include <libjst/sequence_tree/prune_unsupported.hpp>
+#include <libjst/sequence_tree/trim_tree.hpp>
+#include <libjst/sequence_tree/volatile_tree.hpp>
+#include <libjst/traversal/tree_traverser_base.hpp>
+
+#include "allocation_counters.hpp"
+#include "perf_counters.hpp"
+
+static constexpr size_t source_size = 1ull << 14;
+static constexpr size_t haplotype_count = 64;
+static constexpr size_t window_size = 32;
+
+using coverage_t = libjst::bit_coverage<uint32_t>;
+using cms_t = libjst::dna_compressed_multisequence<std::string, coverage_t>;
+using rcs_store_t = libjst::rcs_store<std::string, cms_t>;
+
+// A store with the given number of variants spread evenly over the source, of which every fourth is a deletion.
+// The layers below trim() enumerate every path of the tree, whose number grows exponentially with the number of
+// variants, such that the store is kept small enough for all layers to be measured on the same store.
+inline rcs_store_t const & shared_store(size_t const variant_count)
+{
+    static std::map<size_t, rcs_store_t> stores{};
+    if (auto it = stores.find(variant_count); it != stores.end())
+        return it->second;
+
+    std::mt19937_64 generator{42};
+    std::string source(source_size, 'A');
+    std::ranges::generate(source, [&] () { return "ACGT"[generator() % 4]; });
+
+    rcs_store_t & store = stores.try_emplace(variant_count, source, haplotype_count).first->second;
+    auto domain = store.variants().coverage_domain();
+    size_t const distance = source_size / (variant_count + 1);
+    for (size_t idx = 1; idx <= variant_count; ++idx) {
+        uint32_t const position = idx * distance + generator() % (distance / 2);
+        std::vector<uint32_t> haplotypes{};
+        for (uint32_t haplotype = 0; haplotype < haplotype_count; ++haplotype)
+            if (generator() % 2 == 0)
+                haplotypes.push_back(haplotype);
+
+        bool const is_deletion = idx % 4 == 0;
+        std::string alt_sequence{};
+        if (!is_deletion)
+            alt_sequence.push_back((source[position] == 'A') ? 'C' : 'A');
+        store.add(std::ranges::range_value_t<cms_t>{libjst::breakpoint{position, is_deletion ? 4u : 1u},
+                                                    std::move(alt_sequence),
+                                                    coverage_t{haplotypes, domain}});
+    }
+    return store;
+}
+
+// The adaptor stacks of the state oblivious traverser, each adding one layer on top of the previous one.
+enum struct adaptor_layer {
+    volatile_tree,
+    labelled,
+    coloured,
+    trim,
+    prune_unsupported,
+    left_extend,
+    merge
+};
+
+template <adaptor_layer layer>
+inline auto make_tree(rcs_store_t const & store)
+{
+    if constexpr (layer == adaptor_layer::volatile_tree)
+        return libjst::make_volatile(store);
+    else if constexpr (layer == adaptor_layer::labelled)
+        return make_tree<adaptor_layer::volatile_tree>(store) | libjst::labelled();
+    else if constexpr (layer == adaptor_layer::coloured)
+        return make_tree<adaptor_layer::labelled>(store) | libjst::coloured();
+    else if constexpr (layer == adaptor_layer::trim)
+        return make_tree<adaptor_layer::coloured>(store) | libjst::trim(window_size - 1);
+    else if constexpr (layer == adaptor_layer::prune_unsupported)
+        return make_tree<adaptor_layer::trim>(store) | libjst::prune_unsupported();
+    else if constexpr (layer == adaptor_layer::left_extend)
+        return make_tree<adaptor_layer::prune_unsupported>(store) | libjst::left_extend(window_size - 1);
+    else
+        return make_tree<adaptor_layer::left_extend>(store) | libjst::merge();
+}
+
+// ----------------------------------------------------------------------------
+// Benchmark the node throughput of the adaptor stacks
+// ----------------------------------------------------------------------------
+
+// Arguments: the number of variants.
+// Visits every node of the tree; the symbols of the labels are counted once the tree is labelled.
+template <adaptor_layer layer>
+void benchmark_adaptor_stack(benchmark::State & state)
+{
+    auto tree = make_tree<layer>(shared_store(state.range(0)));
+
+    size_t nodes{};
+    size_t symbols{};
+    allocation_counters allocations{state};
+    perf_counters perf{state};
+    for (auto _ : state)
+    {
+        libjst::tree_traverser_base path{tree};
+        for (auto it = path.begin(); it != path.end(); ++it) {
+            ++nodes;
+            if constexpr (layer != adaptor_layer::volatile_tree)
+                symbols += std::ranges::size((*it).sequence());
+            else
+                benchmark::DoNotOptimize(*it);
+        }
+        benchmark::DoNotOptimize(symbols);
+    }
+    perf.stop();
+    allocations.stop();
+
+    state.counters["nodes"] = benchmark::Counter(nodes, benchmark::Counter::kAvgIterations);
+    state.counters["nodes_per_second"] = benchmark::Counter(nodes, benchmark::Counter::kIsRate);
+    if (nodes > 0)
+        state.counters["allocations_per_node"] = static_cast<double>(allocations.allocations()) / nodes;
+    if constexpr (layer != adaptor_layer::volatile_tree)
+        state.counters["bases_per_second"] = benchmark::Counter(symbols, benchmark::Counter::kIsRate);
+}
+
+BENCHMARK_TEMPLATE(benchmark_adaptor_stack, adaptor_layer::volatile_tree)->ArgName("variants")->Arg(8)->Arg(16);
+BENCHMARK_TEMPLATE(benchmark_adaptor_stack, adaptor_layer::labelled)->ArgName("variants")->Arg(8)->Arg(16);
+BENCHMARK_TEMPLATE(benchmark_adaptor_stack, adaptor_layer::coloured)->ArgName("variants")->Arg(8)->Arg(16);
+BENCHMARK_TEMPLATE(benchmark_adaptor_stack, adaptor_layer::trim)->ArgName("variants")->Arg(8)->Arg(16);
+BENCHMARK_TEMPLATE(benchmark_adaptor_stack, adaptor_layer::prune_unsupported)->ArgName("variants")->Arg(8)->Arg(16);
+BENCHMARK_TEMPLATE(benchmark_adaptor_stack, adaptor_layer::left_extend)->ArgName("variants")->Arg(8)->Arg(16);
+BENCHMARK_TEMPLATE(benchmark_adaptor_stack, adaptor_layer::merge)->ArgName("variants")->Arg(8)->Arg(16);
+
+BENCHMARK_MAIN();
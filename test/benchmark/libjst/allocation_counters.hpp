@@ -0,0 +1,158 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdint>
+#include <utility>
+
+#ifndef LIBJST_BENCHMARK_ALLOCATION_COUNTERS
+#define LIBJST_BENCHMARK_ALLOCATION_COUNTERS 0
+#endif
+
+#if LIBJST_BENCHMARK_ALLOCATION_COUNTERS
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+#endif
+
+// The allocations and the allocated bytes of all threads of the benchmark executable.
+struct allocation_statistics {
+    static inline std::atomic<uint64_t> count{};
+    static inline std::atomic<uint64_t> bytes{};
+
+    static void record(std::size_t const size) noexcept {
+        count.fetch_add(1, std::memory_order_relaxed);
+        bytes.fetch_add(size, std::memory_order_relaxed);
+    }
+};
+
+// The global operator new is replaced to count every allocation of the executable, i.e. also those of the standard
+// containers and of the threads spawned by the benchmark. The replacement functions must not be inline, hence this
+// header must only be included by a single translation unit of a benchmark executable.
+#if LIBJST_BENCHMARK_ALLOCATION_COUNTERS
+namespace libjst_benchmark_detail
+{
+    inline void * counted_allocate(std::size_t const size) noexcept {
+        allocation_statistics::record(size);
+        return std::malloc((size > 0) ? size : 1);
+    }
+
+    inline void * counted_allocate(std::size_t const size, std::align_val_t const alignment) noexcept {
+        allocation_statistics::record(size);
+        // The size passed to aligned_alloc must be a non-zero multiple of the alignment.
+        std::size_t const align = static_cast<std::size_t>(alignment);
+        return std::aligned_alloc(align, std::max<std::size_t>((size + align - 1) / align, 1) * align);
+    }
+
+    template <typename ...args_t>
+    void * checked_allocate(args_t ...args) {
+        if (void * memory = counted_allocate(args...); memory != nullptr)
+            return memory;
+        throw std::bad_alloc{};
+    }
+} // namespace libjst_benchmark_detail
+
+void * operator new(std::size_t size) { return libjst_benchmark_detail::checked_allocate(size); }
+void * operator new[](std::size_t size) { return libjst_benchmark_detail::checked_allocate(size); }
+void * operator new(std::size_t size, std::align_val_t alignment) {
+    return libjst_benchmark_detail::checked_allocate(size, alignment);
+}
+void * operator new[](std::size_t size, std::align_val_t alignment) {
+    return libjst_benchmark_detail::checked_allocate(size, alignment);
+}
+void * operator new(std::size_t size, std::nothrow_t const &) noexcept {
+    return libjst_benchmark_detail::counted_allocate(size);
+}
+void * operator new[](std::size_t size, std::nothrow_t const &) noexcept {
+    return libjst_benchmark_detail::counted_allocate(size);
+}
+void * operator new(std::size_t size, std::align_val_t alignment, std::nothrow_t const &) noexcept {
+    return libjst_benchmark_detail::counted_allocate(size, alignment);
+}
+void * operator new[](std::size_t size, std::align_val_t alignment, std::nothrow_t const &) noexcept {
+    return libjst_benchmark_detail::counted_allocate(size, alignment);
+}
+
+void operator delete(void * memory) noexcept { std::free(memory); }
+void operator delete[](void * memory) noexcept { std::free(memory); }
+void operator delete(void * memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void * memory, std::size_t) noexcept { std::free(memory); }
+void operator delete(void * memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void * memory, std::align_val_t) noexcept { std::free(memory); }
+void operator delete(void * memory, std::size_t, std::align_val_t) noexcept { std::free(memory); }
+void operator delete[](void * memory, std::size_t, std::align_val_t) noexcept { std::free(memory); }
+void operator delete(void * memory, std::nothrow_t const &) noexcept { std::free(memory); }
+void operator delete[](void * memory, std::nothrow_t const &) noexcept { std::free(memory); }
+void operator delete(void * memory, std::align_val_t, std::nothrow_t const &) noexcept { std::free(memory); }
+void operator delete[](void * memory, std::align_val_t, std::nothrow_t const &) noexcept { std::free(memory); }
+#endif
+
+// Counts the heap allocations of the benchmark and reports them per iteration as user counters.
+//
+// Like perf_counters, the counting starts with the constructor, which is placed right before the benchmark loop, and
+// ends with stop(), which is called right after it, such that the setup of the benchmark is not counted; the pauses
+// of the timing are counted. The allocations and the allocated bytes are reported as "allocations" and
+// "allocated_bytes"; the totals are returned by allocations() and allocated_bytes(), e.g. to report the allocations
+// per traversed node. Only the allocations by operator new are counted, and only if the benchmarks are configured
+// with LIBJST_BENCHMARK_ALLOCATION_COUNTERS; otherwise nothing is counted or reported.
+class allocation_counters {
+private:
+
+    benchmark::State & _state;
+    uint64_t _count{};
+    uint64_t _bytes{};
+    bool _stopped{false};
+
+public:
+
+    explicit allocation_counters(benchmark::State & state) :
+        _state{state},
+        _count{allocation_statistics::count.load(std::memory_order_relaxed)},
+        _bytes{allocation_statistics::bytes.load(std::memory_order_relaxed)}
+    {}
+
+    allocation_counters(allocation_counters const &) = delete;
+    allocation_counters & operator=(allocation_counters const &) = delete;
+
+    ~allocation_counters()
+    {
+        stop();
+    }
+
+    // Stops counting and reports the allocations per iteration.
+    void stop()
+    {
+        if (std::exchange(_stopped, true))
+            return;
+
+        _count = allocation_statistics::count.load(std::memory_order_relaxed) - _count;
+        _bytes = allocation_statistics::bytes.load(std::memory_order_relaxed) - _bytes;
+        if constexpr (LIBJST_BENCHMARK_ALLOCATION_COUNTERS) {
+            _state.counters["allocations"] = benchmark::Counter(static_cast<double>(_count),
+                                                                benchmark::Counter::kAvgIterations);
+            _state.counters["allocated_bytes"] = benchmark::Counter(static_cast<double>(_bytes),
+                                                                    benchmark::Counter::kAvgIterations,
+                                                                    benchmark::Counter::kIs1024);
+        }
+    }
+
+    // Returns the number of allocations counted until stop().
+    uint64_t allocations() const noexcept
+    {
+        return _stopped ? _count : 0;
+    }
+
+    // Returns the number of bytes allocated until stop().
+    uint64_t allocated_bytes() const noexcept
+    {
+        return _stopped ? _bytes : 0;
+    }
+};
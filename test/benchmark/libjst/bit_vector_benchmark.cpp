@@ -15,8 +15,13 @@
 #include <seqan3/test/performance/sequence_generator.hpp>
 #include <seqan3/test/performance/units.hpp>
 
+#include <libjst/utility/bit_matrix_transpose.hpp>
 #include <libjst/utility/bit_vector_adaptor.hpp>
 #include <libjst/utility/bit_vector.hpp>
+#include <libjst/utility/bit_vector_kernels.hpp>
+#include <libjst/utility/bit_vector_rank_select.hpp>
+
+#include "perf_counters.hpp"
 
 template <typename result_vector_t>
 auto generate_bit_vector_pair(size_t const size)
@@ -48,9 +53,11 @@ void benchmark_bit_vector(benchmark::State & state, bit_vector_t, operation_t &&
 
     bit_vector_t res{lhs};
 
+    perf_counters perf{state};
     for (auto _ : state) {
         operation(res, lhs, rhs);
     }
+    perf.stop();
 
     state.counters["#bits"] = std::ranges::count_if(res, [] (auto v) { return v; });
 }
@@ -62,9 +69,11 @@ void benchmark_bit_vector_reduce(benchmark::State & state, bit_vector_t, operati
 
     bool res{false};
 
+    perf_counters perf{state};
     for (auto _ : state) {
         operation(res, lhs);
     }
+    perf.stop();
 
     state.counters["#bits"] = std::ranges::count_if(lhs, [] (auto v) { return v; });
     state.counters["result"] = res;
@@ -78,9 +87,11 @@ void benchmark_bit_vector_reduce_zero(benchmark::State & state, bit_vector_t, op
 
     bool res{false};
 
+    perf_counters perf{state};
     for (auto _ : state) {
         operation(res, vec);
     }
+    perf.stop();
 
     state.counters["#bits"] = std::ranges::count_if(vec, [] (auto v) { return v; });
     state.counters["result"] = res;
@@ -94,9 +105,11 @@ void benchmark_bit_vector_reduce_all(benchmark::State & state, bit_vector_t, ope
 
     bool res{false};
 
+    perf_counters perf{state};
     for (auto _ : state) {
         operation(res, vec);
     }
+    perf.stop();
 
     state.counters["#bits"] = std::ranges::count_if(vec, [] (auto v) { return v; });
     state.counters["result"] = res;
@@ -146,6 +159,11 @@ inline auto bitparallel_any = [] (auto & res, auto const & bv) constexpr
     res = bv.any();
 };
 
+inline auto bitparallel_count = [] (auto & res, auto const & bv) constexpr
+{
+    res = bv.count() > 0;
+};
+
 static constexpr int32_t min_range = 1 << 5; // 2^5 = 32
 static constexpr int32_t max_range = 1 << 22; // 1^22 = 4194304
 static constexpr int32_t range_multiplier = 2;
@@ -209,6 +227,126 @@ BENCHMARK_CAPTURE(benchmark_bit_vector_reduce_zero,
                   libjst::bit_vector<>{},
                   bitparallel_any)->RangeMultiplier(range_multiplier)->Range(min_range, max_range);
 
+BENCHMARK_CAPTURE(benchmark_bit_vector_reduce,
+                  libjst_bv_count,
+                  libjst::bit_vector<>{},
+                  bitparallel_count)->RangeMultiplier(range_multiplier)->Range(min_range, max_range);
+
+// ----------------------------------------------------------------------------
+// Benchmark libjst::bit_vector_rank_select
+// ----------------------------------------------------------------------------
+
+template <bool is_select>
+void benchmark_rank_select(benchmark::State & state)
+{
+    auto [bits, positions] = generate_bit_vector_pair<libjst::bit_vector<>>(state.range(0));
+    libjst::bit_vector_rank_select rank_select{bits};
+    size_t const query_bound = is_select ? rank_select.count() : bits.size();
+
+    size_t query{};
+    size_t sum{};
+    perf_counters perf{state};
+    for (auto _ : state) {
+        query = (query + 7919) % std::max<size_t>(query_bound, 1); // strides through the vector.
+        if constexpr (is_select)
+            sum += (query_bound > 0) ? rank_select.select(query) : 0;
+        else
+            sum += rank_select.rank(query);
+    }
+    perf.stop();
+
+    benchmark::DoNotOptimize(sum);
+    state.counters["bytes"] = rank_select.memory_usage();
+}
+
+BENCHMARK_TEMPLATE(benchmark_rank_select, false)->RangeMultiplier(range_multiplier)->Range(min_range, max_range);
+BENCHMARK_TEMPLATE(benchmark_rank_select, true)->RangeMultiplier(range_multiplier)->Range(min_range, max_range);
+
+// ----------------------------------------------------------------------------
+// Benchmark the kernels of the dispatch targets
+// ----------------------------------------------------------------------------
+
+using libjst::detail::bit_kernel_target;
+using libjst::detail::bit_kernels;
+
+template <typename kernel_t>
+void benchmark_bit_kernel(benchmark::State & state, bit_kernel_target const target, kernel_t bit_kernels::* kernel)
+{
+    if (!libjst::detail::supports_bit_kernel_target(target)) {
+        state.SkipWithError("The target is not supported by this CPU.");
+        return;
+    }
+
+    bit_kernels const kernels = libjst::detail::select_bit_kernels(target);
+    auto [lhs, rhs] = generate_bit_vector_pair<libjst::bit_vector<>>(state.range(0));
+    libjst::bit_vector<> res{lhs};
+    std::size_t const word_count = std::ranges::size(static_cast<std::vector<uint64_t> const &>(lhs));
+
+    perf_counters perf{state};
+    for (auto _ : state) {
+        if constexpr (std::same_as<kernel_t, bit_kernels::binary_kernel_type>) {
+            (kernels.*kernel)(res.data(), lhs.data(), rhs.data(), word_count);
+            benchmark::ClobberMemory();
+        } else if constexpr (std::same_as<kernel_t, bit_kernels::transpose_kernel_type>) {
+            (kernels.*kernel)(res.data(), word_count / libjst::bit_block_size);
+            benchmark::ClobberMemory();
+        } else {
+            benchmark::DoNotOptimize((kernels.*kernel)(lhs.data(), word_count));
+        }
+    }
+    perf.stop();
+
+    state.counters["words"] = benchmark::Counter(static_cast<double>(word_count) * state.iterations(),
+                                                 benchmark::Counter::kIsRate);
+}
+
+#define LIBJST_BIT_KERNEL_BENCHMARK(target)                                                                          \
+    BENCHMARK_CAPTURE(benchmark_bit_kernel, target##_and, bit_kernel_target::target, &bit_kernels::and_words)       \
+        ->RangeMultiplier(range_multiplier)->Range(min_range, max_range);                                           \
+    BENCHMARK_CAPTURE(benchmark_bit_kernel, target##_and_not, bit_kernel_target::target, &bit_kernels::and_not_words)\
+        ->RangeMultiplier(range_multiplier)->Range(min_range, max_range);                                           \
+    BENCHMARK_CAPTURE(benchmark_bit_kernel, target##_any, bit_kernel_target::target, &bit_kernels::any_words)       \
+        ->RangeMultiplier(range_multiplier)->Range(min_range, max_range);                                           \
+    BENCHMARK_CAPTURE(benchmark_bit_kernel, target##_all, bit_kernel_target::target, &bit_kernels::all_words)       \
+        ->RangeMultiplier(range_multiplier)->Range(min_range, max_range);                                           \
+    BENCHMARK_CAPTURE(benchmark_bit_kernel, target##_count, bit_kernel_target::target, &bit_kernels::count_words)   \
+        ->RangeMultiplier(range_multiplier)->Range(min_range, max_range);                                           \
+    BENCHMARK_CAPTURE(benchmark_bit_kernel, target##_transpose, bit_kernel_target::target,                          \
+                      &bit_kernels::transpose_blocks)->RangeMultiplier(range_multiplier)->Range(min_range, max_range)
+
+LIBJST_BIT_KERNEL_BENCHMARK(scalar);
+LIBJST_BIT_KERNEL_BENCHMARK(avx2);
+LIBJST_BIT_KERNEL_BENCHMARK(avx512);
+LIBJST_BIT_KERNEL_BENCHMARK(neon);
+
+#undef LIBJST_BIT_KERNEL_BENCHMARK
+
+// The bit-by-bit conversion the block transpose replaces.
+void benchmark_bitwise_transpose(benchmark::State & state)
+{
+    auto [blocks, unused] = generate_bit_vector_pair<libjst::bit_vector<>>(state.range(0));
+    libjst::bit_vector<> transposed{blocks};
+    std::size_t const block_count = state.range(0) / (libjst::bit_block_size * libjst::bit_block_size);
+
+    perf_counters perf{state};
+    for (auto _ : state) {
+        for (std::size_t block = 0; block < block_count; ++block) {
+            std::size_t const offset = block * libjst::bit_block_size * libjst::bit_block_size;
+            for (std::size_t row = 0; row < libjst::bit_block_size; ++row)
+                for (std::size_t column = 0; column < libjst::bit_block_size; ++column)
+                    transposed[offset + column * libjst::bit_block_size + row] =
+                        blocks[offset + row * libjst::bit_block_size + column];
+        }
+        benchmark::ClobberMemory();
+    }
+    perf.stop();
+
+    state.counters["words"] = benchmark::Counter(static_cast<double>(state.range(0) / 64) * state.iterations(),
+                                                 benchmark::Counter::kIsRate);
+}
+
+BENCHMARK(benchmark_bitwise_transpose)->RangeMultiplier(range_multiplier)->Range(min_range, max_range);
+
 // // ----------------------------------------------------------------------------
 // // Benchmark std::vector<bool> adaptor
 // // ----------------------------------------------------------------------------
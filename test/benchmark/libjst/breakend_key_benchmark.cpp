@@ -0,0 +1,192 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <seqan3/test/performance/units.hpp>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/elias_fano_key_store.hpp>
+#include <libjst/rcms/packed_breakend_key.hpp>
+#include <libjst/utility/sorted_vector.hpp>
+
+static constexpr int32_t min_range = 1ull<<10;
+static constexpr int32_t max_range = 1ull<<20;
+static constexpr size_t query_count = 1ull<<12;
+
+template <typename position_t>
+inline std::vector<position_t> generate_positions(size_t const count, size_t const max_position)
+{
+    std::mt19937_64 generator{42};
+    std::uniform_int_distribution<size_t> distribution{0, max_position - 1};
+    std::vector<position_t> positions{};
+    positions.reserve(count);
+    std::ranges::generate_n(std::back_inserter(positions), count, [&] () {
+        return static_cast<position_t>(distribution(generator));
+    });
+    return positions;
+}
+
+// ----------------------------------------------------------------------------
+// Benchmark equal range on sorted breakend keys
+// ----------------------------------------------------------------------------
+
+template <typename position_t>
+void benchmark_key_equal_range(benchmark::State & state, position_t)
+{
+    using key_t = libjst::packed_breakend_key<position_t>;
+
+    size_t const size = state.range(0);
+    size_t const max_position = libjst::packed_breakend_key<uint32_t>::max_position;
+
+    libjst::sorted_vector<key_t> keys{};
+    std::vector<position_t> positions = generate_positions<position_t>(size, max_position);
+    std::ranges::sort(positions);
+    std::ranges::for_each(positions, [&] (position_t const position) {
+        keys.insert(keys.end(), key_t{static_cast<uint8_t>(position % 4), position});
+    });
+
+    std::vector<position_t> queries = generate_positions<position_t>(query_count, max_position);
+    size_t hits{};
+    for (auto _ : state)
+    {
+        for (position_t query : queries) {
+            auto range = std::ranges::equal_range(keys, query, std::ranges::less{}, [] (key_t const & key) {
+                return key.position();
+            });
+            hits += std::ranges::size(range);
+        }
+        benchmark::DoNotOptimize(hits);
+    }
+
+    state.counters["bytes_per_second"] = seqan3::test::bytes_per_second(queries.size());
+    state.counters["key_bytes"] = sizeof(key_t);
+}
+
+BENCHMARK_CAPTURE(benchmark_key_equal_range, key32, uint32_t{})->Range(min_range, max_range);
+BENCHMARK_CAPTURE(benchmark_key_equal_range, key64, uint64_t{})->Range(min_range, max_range);
+
+// ----------------------------------------------------------------------------
+// Benchmark conflict lookup in the compressed multisequence
+// ----------------------------------------------------------------------------
+
+template <typename position_t>
+void benchmark_cms_has_conflicts(benchmark::State & state, position_t)
+{
+    using coverage_t = libjst::bit_coverage<uint32_t>;
+    using cms_t = libjst::dna_compressed_multisequence<std::string, coverage_t, position_t>;
+    using value_t = std::ranges::range_value_t<cms_t>;
+
+    size_t const size = state.range(0);
+    size_t const source_size = size * 8;
+    libjst::coverage_domain_t<coverage_t> domain{0, 64};
+    coverage_t coverage{{0, 7, 13, 42}, domain};
+
+    std::vector<value_t> deltas{};
+    std::ranges::for_each(generate_positions<uint32_t>(size, source_size), [&] (uint32_t const position) {
+        deltas.emplace_back(libjst::breakpoint{position, 1}, std::string{"ACGT"[position % 4]}, coverage);
+    });
+    cms_t cms{std::string(source_size, 'A'), domain, deltas};
+
+    std::vector<value_t> queries{};
+    std::ranges::for_each(generate_positions<uint32_t>(query_count, source_size), [&] (uint32_t const position) {
+        queries.emplace_back(libjst::breakpoint{position, 1}, std::string{"C"}, coverage);
+    });
+
+    size_t conflicts{};
+    for (auto _ : state)
+    {
+        for (value_t const & query : queries)
+            conflicts += cms.has_conflicts(query);
+        benchmark::DoNotOptimize(conflicts);
+    }
+
+    state.counters["bytes_per_second"] = seqan3::test::bytes_per_second(queries.size());
+}
+
+BENCHMARK_CAPTURE(benchmark_cms_has_conflicts, key32, uint32_t{})->Range(min_range, max_range >> 4);
+BENCHMARK_CAPTURE(benchmark_cms_has_conflicts, key64, uint64_t{})->Range(min_range, max_range >> 4);
+
+// ----------------------------------------------------------------------------
+// Benchmark successor queries on plain and Elias-Fano compressed keys
+// ----------------------------------------------------------------------------
+
+template <typename position_t>
+inline auto generate_dense_cms(size_t const size)
+{
+    using coverage_t = libjst::bit_coverage<uint32_t>;
+    using cms_t = libjst::dna_compressed_multisequence<std::string, coverage_t, position_t>;
+    using value_t = std::ranges::range_value_t<cms_t>;
+
+    size_t const source_size = size * 16; // a variant every 16 positions on average
+    libjst::coverage_domain_t<coverage_t> domain{0, 64};
+    coverage_t coverage{{0, 7, 13, 42}, domain};
+
+    std::vector<value_t> deltas{};
+    std::ranges::for_each(generate_positions<uint32_t>(size, source_size), [&] (uint32_t const position) {
+        deltas.emplace_back(libjst::breakpoint{position, 1}, std::string{"ACGT"[position % 4]}, coverage);
+    });
+    return cms_t{std::string(source_size, 'A'), domain, deltas};
+}
+
+template <typename position_t>
+void benchmark_plain_key_upper_bound(benchmark::State & state, position_t)
+{
+    using key_t = libjst::packed_breakend_key<position_t>;
+
+    auto cms = generate_dense_cms<position_t>(state.range(0));
+    std::vector<key_t> keys{};
+    keys.reserve(cms.size());
+    for (auto && breakend : cms)
+        keys.push_back(breakend.get_key());
+
+    std::vector<uint32_t> queries = generate_positions<uint32_t>(query_count, cms.source().size());
+    size_t offsets{};
+    for (auto _ : state)
+    {
+        for (uint32_t query : queries) {
+            auto it = std::ranges::upper_bound(keys, query, std::ranges::less{}, [] (key_t const & key) {
+                return key.position();
+            });
+            offsets += it - keys.begin();
+        }
+        benchmark::DoNotOptimize(offsets);
+    }
+
+    state.counters["bytes_per_second"] = seqan3::test::bytes_per_second(queries.size());
+    state.counters["key_bits"] = static_cast<double>(keys.size() * sizeof(key_t) * 8) / keys.size();
+}
+
+template <typename position_t>
+void benchmark_elias_fano_key_upper_bound(benchmark::State & state, position_t)
+{
+    auto cms = generate_dense_cms<position_t>(state.range(0));
+    libjst::elias_fano_key_store<position_t> keys{cms};
+
+    std::vector<uint32_t> queries = generate_positions<uint32_t>(query_count, cms.source().size());
+    size_t offsets{};
+    for (auto _ : state)
+    {
+        for (uint32_t query : queries)
+            offsets += keys.upper_bound(query);
+        benchmark::DoNotOptimize(offsets);
+    }
+
+    state.counters["bytes_per_second"] = seqan3::test::bytes_per_second(queries.size());
+    state.counters["key_bits"] = static_cast<double>(keys.memory_usage() * 8) / keys.size();
+}
+
+BENCHMARK_CAPTURE(benchmark_plain_key_upper_bound, key32, uint32_t{})->Range(min_range, max_range);
+BENCHMARK_CAPTURE(benchmark_elias_fano_key_upper_bound, key32, uint32_t{})->Range(min_range, max_range);
+
+BENCHMARK_MAIN();
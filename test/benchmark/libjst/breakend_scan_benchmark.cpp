@@ -0,0 +1,170 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/haplotype_viewer.hpp>
+#include <libjst/rcms/interior_breakends.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+
+#include "perf_counters.hpp"
+#include "sequence_variant_simulation.hpp"
+
+static constexpr size_t source_size = 1ull << 20;
+static constexpr size_t haplotype_count = 64;
+
+using coverage_t = libjst::bit_coverage<uint32_t>;
+using cms_t = libjst::dna_compressed_multisequence<std::string, coverage_t>;
+using rcs_store_t = libjst::rcs_store<std::string, cms_t>;
+using cms_value_t = std::ranges::range_value_t<cms_t>;
+
+// A store with the given number of simulated variants, each covered by an eighth of the haplotypes.
+inline rcs_store_t const & shared_store(size_t const variant_count)
+{
+    static std::map<size_t, rcs_store_t> stores{};
+    if (auto it = stores.find(variant_count); it != stores.end())
+        return it->second;
+
+    std::mt19937_64 generator{42};
+    std::string source(source_size, 'A');
+    std::ranges::generate(source, [&] () { return "ACGT"[generator() % 4]; });
+
+    libjst::range_domain<uint32_t> const domain{0, haplotype_count};
+    std::vector<cms_value_t> deltas{};
+    for (auto const & [position, deletion, insertion] : generate_variants(source_size, variant_count)) {
+        if (position == 0 || position + deletion >= source_size)
+            continue;
+
+        std::vector<uint32_t> haplotypes{static_cast<uint32_t>(generator() % haplotype_count)};
+        for (uint32_t haplotype = 0; haplotype < haplotype_count; ++haplotype)
+            if (generator() % 8 == 0)
+                haplotypes.push_back(haplotype);
+        std::ranges::sort(haplotypes);
+        haplotypes.erase(std::ranges::unique(haplotypes).begin(), haplotypes.end());
+
+        std::string alt_sequence{};
+        if (!insertion.empty())
+            alt_sequence.push_back((source[position] == 'A') ? 'C' : 'A');
+        deltas.emplace_back(libjst::breakpoint{static_cast<uint32_t>(position), static_cast<uint32_t>(deletion)},
+                            std::move(alt_sequence),
+                            coverage_t{haplotypes, domain});
+    }
+    std::ranges::sort(deltas, std::less<>{}, [] (auto const & delta) { return libjst::low_breakend(delta); });
+    return stores.try_emplace(variant_count, std::move(source), haplotype_count, std::move(deltas)).first->second;
+}
+
+// ----------------------------------------------------------------------------
+// Benchmark the scan over the breakends
+// ----------------------------------------------------------------------------
+
+// Visits the low breakends of all variants. The checked scan visits the whole variant map and tests every breakend
+// for being one of the nil sentinels, while the interior scan visits only the breakends between them.
+// Arguments: variant count.
+template <bool use_interior>
+void benchmark_scan(benchmark::State & state)
+{
+    rcs_store_t const & store = shared_store(state.range(0));
+    auto const & variants = store.variants();
+
+    perf_counters perf{state};
+    for (auto _ : state)
+    {
+        size_t checksum{};
+        auto visit = [&] (auto && variant) {
+            if (variant.get_breakpoint_end() == libjst::breakpoint_end::low)
+                checksum += libjst::position(variant);
+        };
+
+        if constexpr (use_interior) {
+            for (auto && variant : libjst::interior_breakends(variants))
+                visit(variant);
+        } else {
+            for (auto && variant : variants) {
+                if (libjst::alt_kind(variant) == libjst::alternate_sequence_kind::unknown) // a nil sentinel
+                    continue;
+                visit(variant);
+            }
+        }
+        benchmark::DoNotOptimize(checksum);
+    }
+    perf.stop();
+
+    state.SetItemsProcessed(state.iterations() * std::ranges::size(variants));
+}
+
+// Looks up conflicts at random positions, which bounds every lookup by the interior breakends.
+void benchmark_has_conflicts(benchmark::State & state)
+{
+    rcs_store_t const & store = shared_store(state.range(0));
+    libjst::range_domain<uint32_t> const domain{0, haplotype_count};
+
+    std::mt19937_64 generator{7};
+    std::vector<cms_value_t> queries{};
+    for (size_t i = 0; i < 1024; ++i)
+        queries.emplace_back(libjst::breakpoint{static_cast<uint32_t>(generator() % source_size), 1u},
+                             std::string{"C"},
+                             coverage_t{{static_cast<uint32_t>(generator() % haplotype_count)}, domain});
+
+    perf_counters perf{state};
+    for (auto _ : state)
+    {
+        size_t conflicts{};
+        for (cms_value_t const & query : queries)
+            conflicts += store.variants().has_conflicts(query);
+        benchmark::DoNotOptimize(conflicts);
+    }
+    perf.stop();
+
+    state.SetItemsProcessed(state.iterations() * queries.size());
+}
+
+// Builds the journaled haplotype of the proxy, which dispatches on the class of every covered breakend, either by
+// decoding the breakend keys or by looking up the variant class index.
+// Arguments: variant count.
+template <bool use_class_index>
+void benchmark_haplotype_proxy(benchmark::State & state)
+{
+    rcs_store_t store = shared_store(state.range(0));
+    if constexpr (use_class_index)
+        store.build_variant_class_index();
+    libjst::haplotype_viewer viewer{store};
+
+    uint32_t haplotype{};
+    perf_counters perf{state};
+    for (auto _ : state)
+    {
+        auto && sequence = viewer[haplotype];
+        benchmark::DoNotOptimize(sequence);
+        haplotype = (haplotype + 1) % haplotype_count;
+    }
+    perf.stop();
+
+    state.SetItemsProcessed(state.iterations() * std::ranges::size(store.variants()));
+}
+
+static void scan_arguments(benchmark::internal::Benchmark * benchmark)
+{
+    benchmark->ArgNames({"variants"});
+    for (int64_t variants = 1 << 10; variants <= 1 << 16; variants <<= 3)
+        benchmark->Args({variants});
+}
+
+BENCHMARK_TEMPLATE(benchmark_scan, false)->Apply(scan_arguments);
+BENCHMARK_TEMPLATE(benchmark_scan, true)->Apply(scan_arguments);
+BENCHMARK(benchmark_has_conflicts)->Apply(scan_arguments);
+BENCHMARK_TEMPLATE(benchmark_haplotype_proxy, false)->Apply(scan_arguments);
+BENCHMARK_TEMPLATE(benchmark_haplotype_proxy, true)->Apply(scan_arguments);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,268 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/coverage/concept.hpp>
+#include <libjst/coverage/coverage_groups.hpp>
+#include <libjst/coverage/fixed_bit_coverage.hpp>
+#include <libjst/coverage/compressed_int_coverage.hpp>
+#include <libjst/coverage/hybrid_coverage.hpp>
+#include <libjst/coverage/int_coverage.hpp>
+#include <libjst/coverage/range_domain.hpp>
+
+#include "allocation_counters.hpp"
+
+// All coverage types are benchmarked with the same arguments and reported in one table, such that the representations
+// can be compared per domain size and density, e.g. to choose the thresholds of libjst::hybrid_coverage.
+using bit_coverage_t = libjst::bit_coverage<uint32_t>;
+using int_coverage_t = libjst::int_coverage<uint32_t>;
+using hybrid_coverage_t = libjst::hybrid_coverage<uint32_t>;
+using compressed_coverage_t = libjst::compressed_int_coverage<uint32_t>;
+using fixed_coverage_t = libjst::fixed_bit_coverage<uint32_t, 64>;
+
+// The sorted ids of a coverage over the domain where every sample is a member with the given density in parts per
+// million.
+inline std::vector<uint32_t> generate_ids(size_t const domain_size, size_t const density_ppm, uint64_t const seed)
+{
+    std::mt19937_64 generator{seed};
+    std::bernoulli_distribution is_member{density_ppm / 1'000'000.0};
+    std::vector<uint32_t> ids{};
+    for (uint32_t id = 0; id < domain_size; ++id)
+        if (is_member(generator))
+            ids.push_back(id);
+    return ids;
+}
+
+template <typename coverage_t>
+inline coverage_t generate_coverage(size_t const domain_size, size_t const density_ppm, uint64_t const seed)
+{
+    return coverage_t{generate_ids(domain_size, density_ppm, seed),
+                      libjst::range_domain<uint32_t>{0, static_cast<uint32_t>(domain_size)}};
+}
+
+template <typename coverage_t>
+inline bool contains(coverage_t const & coverage, uint32_t const id)
+{
+    if constexpr (requires { coverage.contains(id); })
+        return coverage.contains(id);
+    else
+        return coverage[id];
+}
+
+inline void set_counters(benchmark::State & state)
+{
+    state.counters["samples"] = state.range(0);
+    state.counters["density"] = state.range(1) / 1'000'000.0;
+}
+
+// ----------------------------------------------------------------------------
+// Benchmark the coverage operations
+// ----------------------------------------------------------------------------
+
+// Arguments: domain size, density in parts per million.
+template <typename coverage_t>
+void benchmark_construction(benchmark::State & state)
+{
+    std::vector<uint32_t> const ids = generate_ids(state.range(0), state.range(1), 42);
+    libjst::range_domain<uint32_t> const domain{0, static_cast<uint32_t>(state.range(0))};
+
+    allocation_counters allocations{state};
+    for (auto _ : state)
+    {
+        coverage_t coverage{ids, domain};
+        benchmark::DoNotOptimize(coverage);
+    }
+    allocations.stop();
+
+    set_counters(state);
+}
+
+template <typename coverage_t>
+void benchmark_intersection(benchmark::State & state)
+{
+    coverage_t const lhs = generate_coverage<coverage_t>(state.range(0), state.range(1), 42);
+    coverage_t const rhs = generate_coverage<coverage_t>(state.range(0), state.range(1), 7);
+
+    allocation_counters allocations{state};
+    for (auto _ : state)
+    {
+        auto result = libjst::coverage_intersection(lhs, rhs);
+        benchmark::DoNotOptimize(result);
+    }
+    allocations.stop();
+
+    set_counters(state);
+}
+
+template <typename coverage_t>
+void benchmark_difference(benchmark::State & state)
+{
+    coverage_t const lhs = generate_coverage<coverage_t>(state.range(0), state.range(1), 42);
+    coverage_t const rhs = generate_coverage<coverage_t>(state.range(0), state.range(1), 7);
+
+    allocation_counters allocations{state};
+    for (auto _ : state)
+    {
+        auto result = libjst::coverage_difference(lhs, rhs);
+        benchmark::DoNotOptimize(result);
+    }
+    allocations.stop();
+
+    set_counters(state);
+}
+
+template <typename coverage_t>
+void benchmark_union(benchmark::State & state)
+{
+    coverage_t const lhs = generate_coverage<coverage_t>(state.range(0), state.range(1), 42);
+    coverage_t const rhs = generate_coverage<coverage_t>(state.range(0), state.range(1), 7);
+    coverage_t target = lhs;
+
+    allocation_counters allocations{state};
+    for (auto _ : state)
+    {
+        libjst::coverage_union_into(target, lhs, rhs);
+        benchmark::DoNotOptimize(target);
+    }
+    allocations.stop();
+
+    set_counters(state);
+}
+
+// Looks up a fixed set of random samples per iteration.
+template <typename coverage_t>
+void benchmark_contains(benchmark::State & state)
+{
+    coverage_t const coverage = generate_coverage<coverage_t>(state.range(0), state.range(1), 42);
+
+    std::mt19937_64 generator{7};
+    std::vector<uint32_t> queries(1024);
+    std::ranges::generate(queries, [&] () { return static_cast<uint32_t>(generator() % state.range(0)); });
+
+    for (auto _ : state)
+    {
+        size_t hits{};
+        for (uint32_t id : queries)
+            hits += contains(coverage, id);
+        benchmark::DoNotOptimize(hits);
+    }
+
+    state.SetItemsProcessed(state.iterations() * queries.size());
+    set_counters(state);
+}
+
+template <typename coverage_t>
+void benchmark_any(benchmark::State & state)
+{
+    coverage_t const coverage = generate_coverage<coverage_t>(state.range(0), state.range(1), 42);
+
+    for (auto _ : state)
+    {
+        bool result = coverage.any();
+        benchmark::DoNotOptimize(result);
+    }
+
+    set_counters(state);
+}
+
+// The 26 populations of the 1000 Genomes Project, either contiguous as after reordering the samples or interleaved.
+inline libjst::coverage_groups generate_groups(size_t const domain_size, bool const contiguous)
+{
+    constexpr size_t group_count = 26;
+    std::vector<uint32_t> group_of(domain_size);
+    for (size_t id = 0; id < domain_size; ++id)
+        group_of[id] = contiguous ? id * group_count / domain_size : id % group_count;
+    return libjst::coverage_groups{group_of, group_count};
+}
+
+// Counts the members per group by testing every member of the domain.
+void benchmark_group_count_by_member(benchmark::State & state)
+{
+    bit_coverage_t const coverage = generate_coverage<bit_coverage_t>(state.range(0), state.range(1), 42);
+    libjst::coverage_groups const groups = generate_groups(state.range(0), state.range(2));
+    std::vector<size_t> counts(groups.group_count());
+
+    for (auto _ : state)
+    {
+        std::ranges::fill(counts, 0);
+        for (size_t id = 0; id < groups.size(); ++id)
+            counts[groups.group_of(id)] += coverage[id];
+        benchmark::DoNotOptimize(counts.data());
+    }
+
+    set_counters(state);
+}
+
+template <typename coverage_t>
+void benchmark_group_count(benchmark::State & state)
+{
+    coverage_t const coverage = generate_coverage<coverage_t>(state.range(0), state.range(1), 42);
+    libjst::coverage_groups const groups = generate_groups(state.range(0), state.range(2));
+    std::vector<size_t> counts(groups.group_count());
+
+    for (auto _ : state)
+    {
+        groups.count_into(coverage, counts);
+        benchmark::DoNotOptimize(counts.data());
+    }
+
+    set_counters(state);
+}
+
+static void group_count_arguments(benchmark::internal::Benchmark * benchmark)
+{
+    benchmark->ArgNames({"samples", "density_ppm", "contiguous"});
+    for (int64_t samples : {5'008, 100'000})
+        for (int64_t density_ppm : {1'000, 500'000})
+            for (int64_t contiguous : {0, 1})
+                benchmark->Args({samples, density_ppm, contiguous});
+}
+
+static void coverage_arguments(benchmark::internal::Benchmark * benchmark)
+{
+    benchmark->ArgNames({"samples", "density_ppm"});
+    for (int64_t samples : {10, 1'000, 100'000, 500'000})
+        for (int64_t density_ppm : {10, 1'000, 50'000, 500'000})
+            benchmark->Args({samples, density_ppm});
+}
+
+// The small cohorts a libjst::fixed_bit_coverage is meant for.
+static void small_coverage_arguments(benchmark::internal::Benchmark * benchmark)
+{
+    benchmark->ArgNames({"samples", "density_ppm"});
+    for (int64_t samples : {2, 16, 64})
+        for (int64_t density_ppm : {50'000, 500'000})
+            benchmark->Args({samples, density_ppm});
+}
+
+#define LIBJST_COVERAGE_BENCHMARK(operation)                                                      \
+    BENCHMARK_TEMPLATE(benchmark_##operation, bit_coverage_t)->Apply(coverage_arguments);        \
+    BENCHMARK_TEMPLATE(benchmark_##operation, int_coverage_t)->Apply(coverage_arguments);        \
+    BENCHMARK_TEMPLATE(benchmark_##operation, hybrid_coverage_t)->Apply(coverage_arguments);     \
+    BENCHMARK_TEMPLATE(benchmark_##operation, compressed_coverage_t)->Apply(coverage_arguments); \
+    BENCHMARK_TEMPLATE(benchmark_##operation, bit_coverage_t)->Apply(small_coverage_arguments);  \
+    BENCHMARK_TEMPLATE(benchmark_##operation, fixed_coverage_t)->Apply(small_coverage_arguments);
+
+LIBJST_COVERAGE_BENCHMARK(construction)
+LIBJST_COVERAGE_BENCHMARK(intersection)
+LIBJST_COVERAGE_BENCHMARK(difference)
+LIBJST_COVERAGE_BENCHMARK(union)
+LIBJST_COVERAGE_BENCHMARK(contains)
+LIBJST_COVERAGE_BENCHMARK(any)
+
+BENCHMARK(benchmark_group_count_by_member)->Apply(group_count_arguments);
+BENCHMARK_TEMPLATE(benchmark_group_count, bit_coverage_t)->Apply(group_count_arguments);
+BENCHMARK_TEMPLATE(benchmark_group_count, int_coverage_t)->Apply(group_count_arguments);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,384 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+// Runs the standard query workloads on real datasets instead of simulated stores: the import of the VCF, the exact
+// and the approximate search of needles sampled from the haplotypes, and the export of all haplotypes as FASTA.
+// The stores are imported from the VCF files of the test data, as the serialised .jst files of the data directory
+// were written by the former journaled sequence tree and can not be read by the rcs_store.
+//
+// Besides the options of google benchmark, the following options configure the workloads:
+//   --dataset=REF,VCF[,HAP]   adds a dataset given by its reference FASTA, its VCF and optionally the FASTA of its
+//                             haplotypes, from which the needles are sampled instead of the reference; can be given
+//                             several times, e.g. for a downloaded 1KG chromosome. Compressed files require zlib.
+//   --needles=N               the number of searched needles; defaults to 100.
+//   --needle_size=N           the size of the needles of at most 64 symbols; defaults to 32.
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <streambuf>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if LIBJST_HAS_ZLIB
+#include <zlib.h>
+#endif
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/matcher/myers_matcher.hpp>
+#include <libjst/matcher/shift_or_matcher.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/haplotype_fasta_writer.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/rcms/vcf_importer.hpp>
+#include <libjst/sequence_tree/volatile_tree.hpp>
+#include <libjst/traversal/state_oblivious_traverser.hpp>
+
+#include "perf_counters.hpp"
+
+using coverage_t = libjst::bit_coverage<uint32_t>;
+using cms_t = libjst::dna_compressed_multisequence<std::string, coverage_t>;
+using rcs_store_t = libjst::rcs_store<std::string, cms_t>;
+using importer_t = libjst::vcf_importer<std::string, cms_t>;
+
+// The files of a dataset, which are loaded on first use.
+struct dataset {
+    std::string name{};
+    std::string reference_file{};
+    std::string vcf_file{};
+    std::string haplotype_file{};
+
+    std::string source{};
+    std::string vcf{};
+    std::unique_ptr<rcs_store_t> store{};
+    std::vector<std::string> needles{};
+};
+
+struct dataset_options {
+    std::vector<dataset> datasets{};
+    size_t needle_count{100};
+    size_t needle_size{32};
+};
+
+inline dataset_options & options()
+{
+    static dataset_options instance{};
+    return instance;
+}
+
+// Reads the whole file, which is decompressed if it is gzip compressed and libjst was built with zlib.
+inline std::string read_file(std::string const & path)
+{
+    std::string text{};
+#if LIBJST_HAS_ZLIB
+    gzFile file = gzopen(path.c_str(), "rb");
+    if (file == nullptr)
+        throw std::runtime_error{"Could not open " + path + "."};
+
+    std::vector<char> buffer(1 << 16);
+    int count{};
+    while ((count = gzread(file, buffer.data(), buffer.size())) > 0)
+        text.append(buffer.data(), count);
+    gzclose(file);
+    if (count < 0)
+        throw std::runtime_error{"Could not decompress " + path + "."};
+#else
+    if (path.ends_with(".gz"))
+        throw std::runtime_error{"Reading " + path + " requires libjst to be built with zlib."};
+
+    std::ifstream file{path, std::ios::binary};
+    if (!file.good())
+        throw std::runtime_error{"Could not open " + path + "."};
+    std::ostringstream buffer{};
+    buffer << file.rdbuf();
+    text = std::move(buffer).str();
+#endif
+    return text;
+}
+
+// Returns the upper case sequences of the records of a FASTA file.
+inline std::vector<std::string> read_fasta(std::string const & path)
+{
+    std::vector<std::string> sequences{};
+    std::istringstream lines{read_file(path)};
+    for (std::string line{}; std::getline(lines, line);) {
+        if (line.starts_with('>')) {
+            sequences.emplace_back();
+        } else if (!sequences.empty()) {
+            std::erase(line, '\r');
+            std::ranges::transform(line, std::back_inserter(sequences.back()), [] (char const symbol) {
+                return static_cast<char>((symbol >= 'a' && symbol <= 'z') ? symbol - 'a' + 'A' : symbol);
+            });
+        }
+    }
+    if (sequences.empty())
+        throw std::runtime_error{path + " contains no FASTA record."};
+    return sequences;
+}
+
+inline rcs_store_t * import_store(std::string const & source, std::string const & vcf)
+{
+    std::istringstream stream{vcf};
+    return new rcs_store_t(importer_t{source}(stream));
+}
+
+// Loads the files of the dataset and samples the needles at random positions of the haplotypes.
+inline dataset & load_dataset(size_t const idx)
+{
+    dataset_options const & config = options();
+    dataset & data = options().datasets[idx];
+    if (data.store != nullptr)
+        return data;
+
+    data.source = read_fasta(data.reference_file).front();
+    data.vcf = read_file(data.vcf_file);
+    data.store.reset(import_store(data.source, data.vcf));
+
+    std::vector<std::string> haplotypes = data.haplotype_file.empty() ? std::vector<std::string>{data.source}
+                                                                      : read_fasta(data.haplotype_file);
+    std::erase_if(haplotypes, [&] (std::string const & haplotype) { return haplotype.size() < config.needle_size; });
+    if (haplotypes.empty())
+        throw std::runtime_error{"The sequences of " + data.name + " are shorter than the needles."};
+
+    std::mt19937_64 generator{42};
+    for (size_t needle = 0; needle < config.needle_count; ++needle) {
+        std::string const & haplotype = haplotypes[generator() % haplotypes.size()];
+        size_t const position = generator() % (haplotype.size() - config.needle_size + 1);
+        data.needles.push_back(haplotype.substr(position, config.needle_size));
+    }
+    return data;
+}
+
+// Loads the dataset or skips the benchmark if it can not be loaded, e.g. because zlib is not available.
+inline dataset * try_load_dataset(benchmark::State & state)
+{
+    try {
+        return std::addressof(load_dataset(state.range(0)));
+    } catch (std::exception const & error) {
+        state.SkipWithError(error.what());
+        return nullptr;
+    }
+}
+
+inline void dataset_counters(benchmark::State & state, dataset const & data)
+{
+    state.counters["source"] = data.source.size();
+    state.counters["variants"] = data.store->variants().size();
+    state.counters["haplotypes"] = data.store->size();
+}
+
+// ----------------------------------------------------------------------------
+// Benchmark the import of the VCF
+// ----------------------------------------------------------------------------
+
+// Arguments: the dataset.
+static void benchmark_import(benchmark::State & state)
+{
+    dataset * data = try_load_dataset(state);
+    if (data == nullptr)
+        return;
+
+    perf_counters perf{state};
+    for (auto _ : state)
+    {
+        std::unique_ptr<rcs_store_t> store{import_store(data->source, data->vcf)};
+        benchmark::DoNotOptimize(store->variants().size());
+    }
+    perf.stop();
+
+    state.SetBytesProcessed(data->vcf.size() * state.iterations());
+    dataset_counters(state, *data);
+}
+
+// ----------------------------------------------------------------------------
+// Benchmark the exact and the approximate search of the needles
+// ----------------------------------------------------------------------------
+
+// Searches every needle in the store and reports the searched needles and source bases per second.
+template <typename make_matcher_t>
+void search_needles(benchmark::State & state, dataset const & data, make_matcher_t && make_matcher)
+{
+    rcs_store_t const & store = *data.store;
+    std::vector<decltype(make_matcher(data.needles.front()))> patterns{};
+    for (std::string const & needle : data.needles)
+        patterns.push_back(make_matcher(needle));
+
+    size_t hits{};
+    perf_counters perf{state};
+    for (auto _ : state)
+    {
+        for (auto & pattern : patterns) {
+            pattern.reset();
+            libjst::state_oblivious_traverser{}(libjst::make_volatile(store), pattern, [&] (auto &&, auto &&) {
+                ++hits;
+            });
+        }
+        benchmark::DoNotOptimize(hits);
+    }
+    perf.stop();
+
+    state.counters["hits"] = benchmark::Counter(hits, benchmark::Counter::kAvgIterations);
+    state.counters["needles_per_second"] = benchmark::Counter(patterns.size() * state.iterations(),
+                                                              benchmark::Counter::kIsRate);
+    state.counters["bases_per_second"] = benchmark::Counter(patterns.size() * data.source.size() * state.iterations(),
+                                                            benchmark::Counter::kIsRate);
+    dataset_counters(state, data);
+}
+
+// Arguments: the dataset.
+static void benchmark_exact_search(benchmark::State & state)
+{
+    if (dataset * data = try_load_dataset(state); data != nullptr)
+        search_needles(state, *data, [] (std::string const & needle) { return libjst::shift_or_matcher{needle}; });
+}
+
+// Arguments: the dataset, the maximal number of errors.
+static void benchmark_approximate_search(benchmark::State & state)
+{
+    size_t const errors = state.range(1);
+    if (dataset * data = try_load_dataset(state); data != nullptr)
+        search_needles(state, *data, [&] (std::string const & needle) {
+            return libjst::myers_matcher{needle, errors};
+        });
+}
+
+// ----------------------------------------------------------------------------
+// Benchmark the export of the haplotypes
+// ----------------------------------------------------------------------------
+
+// Counts and discards the written characters, such that the export is measured without the file system.
+class counting_buffer : public std::streambuf {
+public:
+    size_t count{};
+
+protected:
+    int_type overflow(int_type const symbol) override {
+        count += !traits_type::eq_int_type(symbol, traits_type::eof());
+        return traits_type::not_eof(symbol);
+    }
+
+    std::streamsize xsputn(char_type const *, std::streamsize const size) override {
+        count += size;
+        return size;
+    }
+};
+
+// Arguments: the dataset, the number of threads of the writer.
+static void benchmark_haplotype_export(benchmark::State & state)
+{
+    dataset * data = try_load_dataset(state);
+    if (data == nullptr)
+        return;
+
+    std::vector<size_t> ids(data->store->size());
+    std::iota(ids.begin(), ids.end(), 0);
+    libjst::haplotype_fasta_writer<rcs_store_t>::options writer_options{};
+    writer_options.thread_count = state.range(1);
+
+    counting_buffer buffer{};
+    std::ostream stream{&buffer};
+    perf_counters perf{state};
+    for (auto _ : state)
+    {
+        libjst::haplotype_fasta_writer writer{*data->store, stream, writer_options};
+        writer.write(ids);
+        writer.close();
+    }
+    perf.stop();
+
+    state.SetBytesProcessed(buffer.count);
+    state.counters["haplotypes_per_second"] = benchmark::Counter(ids.size() * state.iterations(),
+                                                                 benchmark::Counter::kIsRate);
+    dataset_counters(state, *data);
+}
+
+// Returns the value of the option if the argument is --name=value.
+static bool parse_option(std::string_view const argument, std::string_view const name, std::string_view & value)
+{
+    if (!argument.starts_with("--") || !argument.substr(2).starts_with(name) ||
+        argument.substr(2 + name.size(), 1) != "=")
+        return false;
+
+    value = argument.substr(3 + name.size());
+    return true;
+}
+
+static size_t parse_size(std::string_view const value)
+{
+    return std::strtoull(std::string{value}.c_str(), nullptr, 10);
+}
+
+// Removes the dataset options from the arguments and stores them in the options; the test data is used if no
+// dataset was given.
+static void parse_dataset_options(int & argc, char ** argv)
+{
+    dataset_options & config = options();
+    int kept{1};
+    for (int idx = 1; idx < argc; ++idx) {
+        std::string_view value{};
+        if (parse_option(argv[idx], "dataset", value)) {
+            std::vector<std::string> files{};
+            for (auto && file : value | std::views::split(','))
+                files.emplace_back(file.begin(), file.end());
+            files.resize(std::max<size_t>(files.size(), 3));
+            std::string name = files[1].substr(files[1].find_last_of('/') + 1);
+            config.datasets.push_back(dataset{std::move(name), files[0], files[1], files[2]});
+        } else if (parse_option(argv[idx], "needles", value)) {
+            config.needle_count = std::max<size_t>(parse_size(value), 1);
+        } else if (parse_option(argv[idx], "needle_size", value)) {
+            config.needle_size = std::clamp<size_t>(parse_size(value), 1, 64);
+        } else {
+            argv[kept++] = argv[idx];
+        }
+    }
+    argc = kept;
+
+    if (config.datasets.empty()) {
+        for (std::string name : {"sim_ref_10Kb_SNPs", "sim_ref_10Kb_SNP_INDELs"})
+            config.datasets.push_back(dataset{name + ".vcf",
+                                              DATADIR"sim_ref_10Kb.fasta.gz",
+                                              DATADIR + name + ".vcf",
+                                              DATADIR + name + "_haplotypes.fasta.gz"});
+    }
+}
+
+int main(int argc, char ** argv)
+{
+    parse_dataset_options(argc, argv);
+
+    // The benchmarks are named after the dataset, whose index is the argument of the benchmark. The import and the
+    // export run on several threads and are hence measured in real time.
+    std::vector<dataset> const & datasets = options().datasets;
+    for (int64_t idx = 0; idx < static_cast<int64_t>(datasets.size()); ++idx) {
+        std::string const suffix = "/" + datasets[idx].name;
+        benchmark::RegisterBenchmark(("benchmark_import" + suffix).c_str(), benchmark_import)
+            ->ArgName("dataset")->Arg(idx)->UseRealTime();
+        benchmark::RegisterBenchmark(("benchmark_exact_search" + suffix).c_str(), benchmark_exact_search)
+            ->ArgName("dataset")->Arg(idx);
+        benchmark::RegisterBenchmark(("benchmark_approximate_search" + suffix).c_str(),
+                                     benchmark_approximate_search)
+            ->ArgNames({"dataset", "errors"})->Args({idx, 1})->Args({idx, 2});
+        benchmark::RegisterBenchmark(("benchmark_haplotype_export" + suffix).c_str(), benchmark_haplotype_export)
+            ->ArgNames({"dataset", "threads"})->Args({idx, 1})->Args({idx, 4})->UseRealTime();
+    }
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,192 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <random>
+#include <ranges>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/haplotype_viewer.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/rcms/region_viewer.hpp>
+
+#include "perf_counters.hpp"
+#include "sequence_variant_simulation.hpp"
+
+using coverage_t = libjst::bit_coverage<uint32_t>;
+using cms_t = libjst::dna_compressed_multisequence<std::string, coverage_t>;
+using rcs_store_t = libjst::rcs_store<std::string, cms_t>;
+
+// A store over a random source with one variant every 16 positions on average, each covered by an eighth of the
+// haplotypes, of which one percent are indels. The stores are cached per source size and haplotype count.
+inline rcs_store_t const & shared_store(size_t const source_size, size_t const haplotype_count)
+{
+    static std::map<std::pair<size_t, size_t>, std::unique_ptr<rcs_store_t>> stores{};
+    auto const key = std::pair{source_size, haplotype_count};
+    if (auto it = stores.find(key); it != stores.end())
+        return *it->second;
+
+    std::mt19937_64 generator{42};
+    std::string source(source_size, 'A');
+    std::ranges::generate(source, [&] () { return "ACGT"[generator() % 4]; });
+    auto other_base = [&] (char const base) {
+        size_t const rank = std::string{"ACGT"}.find(base);
+        return "ACGT"[(rank + 1 + generator() % 3) % 4];
+    };
+
+    auto & store = stores[key];
+    store = std::make_unique<rcs_store_t>(source, haplotype_count);
+    auto domain = store->variants().coverage_domain();
+    auto variants = generate_variants(source_size, source_size / 16, 0.01);
+    std::ranges::sort(variants, std::less<>{}, [] (auto const & variant) { return std::get<0>(variant); });
+    for (auto const & variant : variants) {
+        auto const & [position, deletion, insertion] = variant;
+        if (position == 0 || position + deletion >= source_size)
+            continue;
+
+        std::vector<uint32_t> haplotypes{};
+        for (uint32_t haplotype = 0; haplotype < haplotype_count; ++haplotype)
+            if (generator() % 8 == 0)
+                haplotypes.push_back(haplotype);
+        if (haplotypes.empty())
+            continue;
+
+        std::string alt_sequence{};
+        if (!insertion.empty())
+            alt_sequence.push_back(other_base(source[position]));
+
+        store->add(std::ranges::range_value_t<cms_t>{libjst::breakpoint{static_cast<uint32_t>(position),
+                                                                        static_cast<uint32_t>(deletion)},
+                                                     std::move(alt_sequence),
+                                                     coverage_t{haplotypes, domain}});
+    }
+    return *store;
+}
+
+inline void store_counters(benchmark::State & state, rcs_store_t const & store)
+{
+    state.counters["variants"] = store.variants().size();
+    state.counters["haplotypes_per_second"] = benchmark::Counter(store.size() * state.iterations(),
+                                                                 benchmark::Counter::kIsRate);
+    state.counters["bases_per_second"] = benchmark::Counter(store.size() * store.source().size() * state.iterations(),
+                                                            benchmark::Counter::kIsRate);
+}
+
+// ----------------------------------------------------------------------------
+// Benchmark the extraction of all haplotypes
+// ----------------------------------------------------------------------------
+
+// Constructs the journaled haplotype of every haplotype with the proxy of the viewer and iterates over it. Every
+// proxy sweeps all variants of the store, such that the time grows with the product of haplotypes and variants.
+// Arguments: source size, haplotype count.
+static void benchmark_haplotype_proxy(benchmark::State & state)
+{
+    rcs_store_t const & store = shared_store(state.range(0), state.range(1));
+    libjst::haplotype_viewer viewer{store};
+
+    size_t symbols{};
+    perf_counters perf{state};
+    for (auto _ : state)
+    {
+        for (size_t haplotype = 0; haplotype < viewer.size(); ++haplotype) {
+            auto && sequence = viewer[haplotype];
+            for (char const symbol : sequence)
+                symbols += symbol;
+        }
+        benchmark::DoNotOptimize(symbols);
+    }
+    perf.stop();
+
+    store_counters(state, store);
+}
+
+// Spells all haplotypes with the batched materialisation, which sweeps the variants once per block of haplotypes.
+// Arguments: source size, haplotype count, thread count.
+static void benchmark_haplotype_materialise(benchmark::State & state)
+{
+    rcs_store_t const & store = shared_store(state.range(0), state.range(1));
+    libjst::haplotype_viewer viewer{store};
+
+    perf_counters perf{state};
+    for (auto _ : state)
+    {
+        auto haplotypes = viewer.materialise_all(state.range(2));
+        benchmark::DoNotOptimize(haplotypes.data());
+    }
+    perf.stop();
+
+    store_counters(state, store);
+}
+
+// Extracts the distinct haplotype sequences of consecutive regions covering the source.
+// Arguments: source size, haplotype count, region size.
+static void benchmark_region_viewer(benchmark::State & state)
+{
+    rcs_store_t const & store = shared_store(state.range(0), state.range(1));
+    size_t const region_size = state.range(2);
+    libjst::region_viewer viewer{store};
+
+    size_t distinct{};
+    perf_counters perf{state};
+    for (auto _ : state)
+    {
+        for (size_t first = 0; first < store.source().size(); first += region_size)
+            distinct += viewer(first, first + region_size).size();
+        benchmark::DoNotOptimize(distinct);
+    }
+    perf.stop();
+
+    store_counters(state, store);
+    state.counters["distinct_per_region"] = static_cast<double>(distinct) /
+                                            (state.iterations() * ((store.source().size() - 1) / region_size + 1));
+}
+
+static void haplotype_arguments(benchmark::internal::Benchmark * benchmark)
+{
+    benchmark->ArgNames({"source", "haplotypes"});
+    for (int64_t source_size : {1 << 14, 1 << 16, 1 << 18})
+        for (int64_t haplotypes : {16, 128, 1024})
+            benchmark->Args({source_size, haplotypes});
+}
+
+static void materialise_arguments(benchmark::internal::Benchmark * benchmark)
+{
+    benchmark->ArgNames({"source", "haplotypes", "threads"});
+    for (int64_t source_size : {1 << 14, 1 << 16, 1 << 18})
+        for (int64_t haplotypes : {16, 128, 1024})
+            benchmark->Args({source_size, haplotypes, 1});
+    for (int64_t threads : {2, 4})
+        benchmark->Args({1 << 18, 1024, threads});
+}
+
+static void region_arguments(benchmark::internal::Benchmark * benchmark)
+{
+    benchmark->ArgNames({"source", "haplotypes", "region"});
+    for (int64_t source_size : {1 << 14, 1 << 16, 1 << 18})
+        for (int64_t haplotypes : {16, 128, 1024})
+            benchmark->Args({source_size, haplotypes, 1000});
+    for (int64_t region_size : {100, 10000})
+        benchmark->Args({1 << 18, 1024, region_size});
+}
+
+BENCHMARK(benchmark_haplotype_proxy)->Apply(haplotype_arguments)->Unit(benchmark::kMillisecond);
+BENCHMARK(benchmark_haplotype_materialise)->Apply(materialise_arguments)->Unit(benchmark::kMillisecond)
+                                          ->UseRealTime();
+BENCHMARK(benchmark_region_viewer)->Apply(region_arguments)->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,141 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/sequence_tree/seek_position.hpp>
+#include <libjst/traversal/hit_buffer.hpp>
+#include <libjst/traversal/hit_queue.hpp>
+
+static constexpr size_t hits_per_producer = 1 << 14;
+static constexpr size_t hits_per_label = 4;
+static constexpr size_t haplotype_count = 64;
+
+using coverage_t = libjst::bit_coverage<uint32_t>;
+
+// A label of a seekable tree, as reported to the callback of a traversal.
+struct label_type {
+    std::string symbols{};
+    libjst::seek_position seek_position{};
+    coverage_t haplotypes{};
+
+    std::string const & sequence() const noexcept {
+        return symbols;
+    }
+
+    libjst::seek_position const & position() const noexcept {
+        return seek_position;
+    }
+
+    coverage_t const & coverage() const noexcept {
+        return haplotypes;
+    }
+};
+
+// Every producer reports the hits of its own labels, with a new coverage every few hits.
+template <typename report_t>
+void produce(size_t const producer_count, report_t && report)
+{
+    std::vector<std::thread> producers{};
+    for (size_t producer = 0; producer < producer_count; ++producer) {
+        producers.emplace_back([&, producer] () {
+            libjst::range_domain<uint32_t> const domain{0, haplotype_count};
+            std::vector<label_type> labels{};
+            for (uint32_t haplotype = 0; haplotype < 8; ++haplotype) {
+                uint32_t const id = static_cast<uint32_t>((haplotype + producer) % haplotype_count);
+                labels.push_back(label_type{.symbols = std::string(64, 'A'), .haplotypes = coverage_t{{id}, domain}});
+            }
+            report(producer, labels);
+        });
+    }
+    for (std::thread & producer : producers)
+        producer.join();
+}
+
+template <typename callback_t>
+void report_hits(std::vector<label_type> const & labels, callback_t & callback)
+{
+    for (size_t hit = 0; hit < hits_per_producer; ++hit) {
+        label_type const & label = labels[(hit / hits_per_label) % labels.size()];
+        callback(label.symbols.begin() + (hit % label.symbols.size()), label);
+    }
+}
+
+// ----------------------------------------------------------------------------
+// Benchmark the delivery of the hits of concurrent producers
+// ----------------------------------------------------------------------------
+
+// Every producer reports its hits to one libjst::hit_buffer guarded by a mutex, i.e. locks once per hit.
+// Arguments: producer count, batch capacity.
+void benchmark_mutex_callback(benchmark::State & state)
+{
+    size_t const producer_count = state.range(0);
+    for (auto _ : state)
+    {
+        size_t consumed{};
+        std::mutex mutex{};
+        libjst::hit_buffer<coverage_t> buffer{static_cast<size_t>(state.range(1)), [&] (auto const & batch) {
+            consumed += batch.size();
+        }};
+        produce(producer_count, [&] (size_t, std::vector<label_type> const & labels) {
+            auto locked_buffer = [&] (auto && label_it, auto && label) {
+                std::scoped_lock lock{mutex};
+                buffer(label_it, label);
+            };
+            report_hits(labels, locked_buffer);
+        });
+        buffer.flush();
+        benchmark::DoNotOptimize(consumed);
+    }
+
+    state.SetItemsProcessed(state.iterations() * producer_count * hits_per_producer);
+}
+
+// Every producer fills its own batch and publishes it to the libjst::hit_queue, i.e. contends once per batch.
+// Arguments: producer count, batch capacity.
+void benchmark_hit_queue(benchmark::State & state)
+{
+    size_t const producer_count = state.range(0);
+    size_t wait_count{};
+    for (auto _ : state)
+    {
+        size_t consumed{};
+        libjst::hit_queue<coverage_t> queue{static_cast<size_t>(state.range(1)), 16, [&] (auto const & batch) {
+            consumed += batch.size();
+        }};
+        produce(producer_count, [&] (size_t, std::vector<label_type> const & labels) {
+            auto producer = queue.producer();
+            report_hits(labels, producer);
+        });
+        queue.close();
+        wait_count += queue.wait_count();
+        benchmark::DoNotOptimize(consumed);
+    }
+
+    state.SetItemsProcessed(state.iterations() * producer_count * hits_per_producer);
+    state.counters["waits"] = benchmark::Counter(wait_count, benchmark::Counter::kAvgIterations);
+}
+
+static void producer_arguments(benchmark::internal::Benchmark * benchmark)
+{
+    benchmark->ArgNames({"producers", "batch"});
+    for (int64_t producers = 1; producers <= 128; producers <<= 1)
+        benchmark->Args({producers, 1024});
+    benchmark->UseRealTime();
+}
+
+BENCHMARK(benchmark_mutex_callback)->Apply(producer_arguments);
+BENCHMARK(benchmark_hit_queue)->Apply(producer_arguments);
+
+BENCHMARK_MAIN();
@@ -14,6 +14,7 @@
 
 #include <libjst/sequence/journaled_sequence.hpp>
 
+#include "allocation_counters.hpp"
 #include "sequence_variant_simulation.hpp"
 
 /* Benchmark:
@@ -26,6 +27,7 @@
  * Access:
  *  * read left to right
  *  * random access
+ *  * copy left to right, symbol- and segment-wise
  *
  * Modify:
  *  * erase left to right
@@ -36,6 +38,7 @@
  * Types:
  *  * std::string
  *  * journaled_sequence
+ *  * balanced_journaled_sequence
  */
 
 static void benchmark_args(benchmark::internal::Benchmark* b) {
@@ -90,6 +93,38 @@ void benchmark_sequential_access(benchmark::State & state) {
 
 // BENCHMARK_TEMPLATE(benchmark_sequential_access, std::vector<char>)->Apply(benchmark_args);
 BENCHMARK_TEMPLATE(benchmark_sequential_access, libjst::journaled_sequence<std::vector<char>>)->Apply(benchmark_args);
+BENCHMARK_TEMPLATE(benchmark_sequential_access, libjst::balanced_journaled_sequence<std::vector<char>>)->Apply(benchmark_args);
+
+// ----------------------------------------------------------------------------
+// Benchmark copy
+// ----------------------------------------------------------------------------
+
+template <typename container_t, bool segmented>
+void benchmark_copy(benchmark::State & state) {
+
+    size_t const sequence_size = state.range(0);
+    std::vector<char> base_sequence{};
+    base_sequence.resize(sequence_size, 'A');
+
+    auto sequence_variants = generate_variants(base_sequence.size(), state.range(1));
+    auto target_seq = generate_sequence<container_t>(base_sequence, sequence_variants);
+
+    std::vector<char> buffer(target_seq.size());
+    for (auto _ : state) {
+        if constexpr (segmented)
+            libjst::segmented_copy(target_seq, buffer.data());
+        else
+            std::ranges::copy(target_seq, buffer.data());
+        benchmark::DoNotOptimize(buffer.data());
+        benchmark::ClobberMemory();
+    }
+
+    state.counters["bytes_per_second"] = seqan3::test::bytes_per_second(target_seq.size());
+}
+
+BENCHMARK_TEMPLATE(benchmark_copy, libjst::journaled_sequence<std::vector<char>>, false)->Apply(benchmark_args);
+BENCHMARK_TEMPLATE(benchmark_copy, libjst::journaled_sequence<std::vector<char>>, true)->Apply(benchmark_args);
+BENCHMARK_TEMPLATE(benchmark_copy, libjst::balanced_journaled_sequence<std::vector<char>>, true)->Apply(benchmark_args);
 
 // ----------------------------------------------------------------------------
 // Benchmark access random
@@ -131,6 +166,52 @@ void benchmark_random_access(benchmark::State & state) {
 
 // BENCHMARK_TEMPLATE(benchmark_random_access, std::vector<char>)->Apply(benchmark_args);
 BENCHMARK_TEMPLATE(benchmark_random_access, libjst::journaled_sequence<std::vector<char>>)->Apply(benchmark_args);
+BENCHMARK_TEMPLATE(benchmark_random_access, libjst::balanced_journaled_sequence<std::vector<char>>)->Apply(benchmark_args);
+
+// ----------------------------------------------------------------------------
+// Benchmark access with forward skips
+// ----------------------------------------------------------------------------
+
+// Advances the iterator by strides of up to 64 symbols, like the shifts of a skip-heavy search.
+template <typename container_t>
+void benchmark_skip_access(benchmark::State & state) {
+
+    size_t const sequence_size = state.range(0);
+    std::vector<char> base_sequence{};
+    base_sequence.resize(sequence_size, 'A');
+
+    auto sequence_variants = generate_variants(base_sequence.size(), state.range(1));
+    auto target_seq = generate_sequence<container_t>(base_sequence, sequence_variants);
+
+    std::vector<std::ptrdiff_t> strides{};
+    strides.resize(1024);
+    std::uniform_int_distribution<std::ptrdiff_t> stride_dist{1, 64};
+    std::mt19937 gen{};
+    gen.seed(static_cast<int>(state.range(1)));
+    std::ranges::generate(strides, [&](){ return stride_dist(gen); });
+
+    size_t A_count{};
+    size_t skip_count{};
+    for (auto _ : state) {
+        A_count = 0;
+        skip_count = 0;
+        auto it = std::ranges::begin(target_seq);
+        for (std::ptrdiff_t remaining = std::ranges::ssize(target_seq); ; ++skip_count) {
+            std::ptrdiff_t const stride = strides[skip_count % strides.size()];
+            if ((remaining -= stride) <= 0)
+                break;
+            it += stride;
+            benchmark::DoNotOptimize(A_count += (*it == 'A'));
+        }
+    }
+
+    state.counters["bytes_per_second"] = seqan3::test::bytes_per_second(target_seq.size());
+    state.counters["A_count"] = A_count;
+    state.counters["skip_count"] = skip_count;
+}
+
+BENCHMARK_TEMPLATE(benchmark_skip_access, libjst::journaled_sequence<std::vector<char>>)->Apply(benchmark_args);
+BENCHMARK_TEMPLATE(benchmark_skip_access, libjst::balanced_journaled_sequence<std::vector<char>>)->Apply(benchmark_args);
 
 // ----------------------------------------------------------------------------
 // Benchmark record back
@@ -140,6 +221,7 @@ template <typename container_t, typename sequence_t, typename variants_t>
 static size_t run_record(benchmark::State & state, sequence_t && base_sequence, variants_t && variants) {
 
     size_t target_size{};
+    allocation_counters allocations{state};
     for (auto _ : state) {
         container_t target_seq{base_sequence};
         // benchmark::DoNotOptimize(target_seq = container_t{base_sequence});
@@ -150,6 +232,7 @@ static size_t run_record(benchmark::State & state, sequence_t && base_sequence,
         }
         target_size = target_seq.size();
     }
+    allocations.stop();
     return target_size;
 }
 
@@ -173,6 +256,7 @@ void benchmark_sequential_record(benchmark::State & state) {
 
 // BENCHMARK_TEMPLATE(benchmark_sequential_record, std::vector<char>)->Apply(benchmark_args);
 BENCHMARK_TEMPLATE(benchmark_sequential_record, libjst::journaled_sequence<std::vector<char>>)->Apply(benchmark_args);
+BENCHMARK_TEMPLATE(benchmark_sequential_record, libjst::balanced_journaled_sequence<std::vector<char>>)->Apply(benchmark_args);
 
 // ----------------------------------------------------------------------------
 // Benchmark record random
@@ -195,6 +279,7 @@ void benchmark_random_record(benchmark::State & state) {
 
 // BENCHMARK_TEMPLATE(benchmark_random_record, std::vector<char>)->Apply(benchmark_args);
 BENCHMARK_TEMPLATE(benchmark_random_record, libjst::journaled_sequence<std::vector<char>>)->Apply(benchmark_args);
+BENCHMARK_TEMPLATE(benchmark_random_record, libjst::balanced_journaled_sequence<std::vector<char>>)->Apply(benchmark_args);
 
 // ----------------------------------------------------------------------------
 // Run benchmark
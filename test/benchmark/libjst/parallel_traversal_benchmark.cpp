@@ -0,0 +1,298 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+// Measures how the parallel chunk traversal scales with the number of threads. Every store size is searched with
+// 1, 2, 4, ... up to the maximal number of threads, and the speed-up and the efficiency are reported relative to the
+// single threaded search of the same store. The busy time of every worker is measured per chunk, from which the
+// mean and the maximal idle fraction of the workers are reported; a high idle fraction points to chunks that are
+// too coarse or to an imbalanced schedule.
+//
+// Besides the options of google benchmark, the following options configure the simulated stores:
+//   --max_threads=N           the maximal number of threads; defaults to the hardware concurrency.
+//   --source_sizes=N[,N...]   the source sizes of the simulated stores; defaults to 2^18,2^20,2^22.
+//   --haplotypes=N            the number of haplotypes; defaults to 64.
+//   --variant_distance=N      the average distance between two variants; defaults to 16.
+//   --indels=N                the indels per thousand variants; defaults to 10.
+//   --chunk_size=N            the source positions per chunk; defaults to 2^14.
+//   --window=N                the window size of the searched pattern; defaults to 32.
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <ranges>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/matcher/shift_or_matcher.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/sequence_tree/chunked_tree.hpp>
+#include <libjst/traversal/parallel_chunk_traverser.hpp>
+#include <libjst/traversal/state_oblivious_traverser.hpp>
+
+#include "allocation_counters.hpp"
+#include "sequence_variant_simulation.hpp"
+
+using coverage_t = libjst::bit_coverage<uint32_t>;
+using cms_t = libjst::dna_compressed_multisequence<std::string, coverage_t>;
+using rcs_store_t = libjst::rcs_store<std::string, cms_t>;
+
+// The dataset parameters, which can be overridden on the command line.
+struct scaling_options {
+    size_t max_threads{std::max<size_t>(std::thread::hardware_concurrency(), 1)};
+    std::vector<size_t> source_sizes{1ull << 18, 1ull << 20, 1ull << 22};
+    size_t haplotypes{64};
+    size_t variant_distance{16};
+    size_t indel_permille{10};
+    size_t chunk_size{1ull << 14};
+    size_t window_size{32};
+};
+
+inline scaling_options & options()
+{
+    static scaling_options instance{};
+    return instance;
+}
+
+// A store over a random source with one variant every variant_distance positions on average, each covered by an
+// eighth of the haplotypes. The stores are cached per source size.
+inline rcs_store_t const & shared_store(size_t const source_size)
+{
+    static std::map<size_t, std::unique_ptr<rcs_store_t>> stores{};
+    if (auto it = stores.find(source_size); it != stores.end())
+        return *it->second;
+
+    scaling_options const & config = options();
+    std::mt19937_64 generator{42};
+    std::string source(source_size, 'A');
+    std::ranges::generate(source, [&] () { return "ACGT"[generator() % 4]; });
+    auto other_base = [&] (char const base) {
+        size_t const rank = std::string{"ACGT"}.find(base);
+        return "ACGT"[(rank + 1 + generator() % 3) % 4];
+    };
+
+    auto & store = stores[source_size];
+    store = std::make_unique<rcs_store_t>(source, config.haplotypes);
+    auto domain = store->variants().coverage_domain();
+    auto variants = generate_variants(source_size, source_size / config.variant_distance,
+                                      config.indel_permille / 1000.0);
+    std::ranges::sort(variants, std::less<>{}, [] (auto const & variant) { return std::get<0>(variant); });
+    for (auto const & variant : variants) {
+        auto const & [position, deletion, insertion] = variant;
+        if (position == 0 || position + deletion >= source_size)
+            continue;
+
+        std::vector<uint32_t> haplotypes{};
+        for (uint32_t haplotype = 0; haplotype < config.haplotypes; ++haplotype)
+            if (generator() % 8 == 0)
+                haplotypes.push_back(haplotype);
+        if (haplotypes.empty())
+            continue;
+
+        std::string alt_sequence{};
+        if (!insertion.empty())
+            alt_sequence.push_back(other_base(source[position]));
+
+        store->add(std::ranges::range_value_t<cms_t>{libjst::breakpoint{static_cast<uint32_t>(position),
+                                                                        static_cast<uint32_t>(deletion)},
+                                                     std::move(alt_sequence),
+                                                     coverage_t{haplotypes, domain}});
+    }
+    return *store;
+}
+
+// Accumulates the time every thread spends traversing chunks.
+struct busy_clock {
+    std::mutex mutex{};
+    std::map<std::thread::id, std::chrono::nanoseconds> busy{};
+
+    void add(std::chrono::nanoseconds const duration) {
+        std::scoped_lock lock{mutex};
+        busy[std::this_thread::get_id()] += duration;
+    }
+};
+
+// Traverses a chunk with the state oblivious traverser and adds the elapsed time to the busy clock.
+struct timed_traverser {
+    busy_clock * clock{};
+
+    template <typename tree_t, typename pattern_t, typename callback_t>
+    void operator()(tree_t && tree, pattern_t & pattern, callback_t && callback) const {
+        auto const start = std::chrono::steady_clock::now();
+        libjst::state_oblivious_traverser{}((tree_t &&) tree, pattern, (callback_t &&) callback);
+        clock->add(std::chrono::steady_clock::now() - start);
+    }
+};
+
+struct hit_counter {
+    size_t count{};
+
+    template <typename label_it_t, typename label_t>
+    void operator()(label_it_t &&, label_t &&) noexcept {
+        ++count;
+    }
+};
+
+// The mean time of a single threaded search per source size and schedule, from which the speed-up is computed.
+inline std::map<std::pair<size_t, bool>, double> & baseline_seconds()
+{
+    static std::map<std::pair<size_t, bool>, double> instance{};
+    return instance;
+}
+
+// Arguments: source size, thread count, whether the chunks are split at runtime by the work stealing scheduler.
+static void benchmark_thread_scaling(benchmark::State & state)
+{
+    size_t const source_size = state.range(0);
+    size_t const thread_count = state.range(1);
+    bool const work_stealing = state.range(2) != 0;
+    scaling_options const & config = options();
+    rcs_store_t const & store = shared_store(source_size);
+
+    std::mt19937_64 generator{7};
+    std::string needle(config.window_size, 'A');
+    std::ranges::generate(needle, [&] () { return "ACGT"[generator() % 4]; });
+    libjst::shift_or_matcher const pattern{needle};
+
+    auto forest = libjst::chunk(store, config.chunk_size, config.window_size - 1);
+    busy_clock clock{};
+    libjst::parallel_chunk_traverser<timed_traverser> traverser{thread_count,
+                                                                work_stealing ? config.chunk_size / 16 : 0,
+                                                                timed_traverser{&clock}};
+
+    size_t hits{};
+    std::chrono::nanoseconds wall_time{};
+    allocation_counters allocations{state};
+    for (auto _ : state)
+    {
+        auto const start = std::chrono::steady_clock::now();
+        auto const counters = traverser(forest, pattern, hit_counter{});
+        wall_time += std::chrono::steady_clock::now() - start;
+        for (hit_counter const & counter : counters)
+            hits += counter.count;
+        benchmark::DoNotOptimize(hits);
+    }
+    allocations.stop();
+
+    // The workers that never traversed a chunk were idle for the whole search.
+    double const total_seconds = std::chrono::duration<double>(wall_time).count();
+    double idle_sum{};
+    double idle_max{};
+    std::vector<double> busy_seconds{};
+    for (auto const & [thread_id, busy] : clock.busy)
+        busy_seconds.push_back(std::chrono::duration<double>(busy).count());
+    busy_seconds.resize(std::max(busy_seconds.size(), thread_count), 0.0);
+    for (double const busy : busy_seconds) {
+        double const idle = std::max(total_seconds - busy, 0.0) / total_seconds;
+        idle_sum += idle;
+        idle_max = std::max(idle_max, idle);
+    }
+
+    double const seconds_per_search = total_seconds / state.iterations();
+    auto const baseline_key = std::pair{source_size, work_stealing};
+    if (thread_count == 1)
+        baseline_seconds()[baseline_key] = seconds_per_search;
+    if (auto it = baseline_seconds().find(baseline_key); it != baseline_seconds().end()) {
+        double const speed_up = it->second / seconds_per_search;
+        state.counters["speed_up"] = speed_up;
+        state.counters["efficiency"] = speed_up / thread_count;
+    }
+
+    state.counters["bases_per_second"] = benchmark::Counter(source_size * state.iterations(),
+                                                            benchmark::Counter::kIsRate);
+    state.counters["chunks"] = std::ranges::size(forest);
+    state.counters["variants"] = store.variants().size();
+    state.counters["idle_mean"] = idle_sum / busy_seconds.size();
+    state.counters["idle_max"] = idle_max;
+}
+
+// Returns the value of the option if the argument is --name=value.
+static bool parse_option(std::string_view const argument, std::string_view const name, std::string_view & value)
+{
+    if (!argument.starts_with("--") || !argument.substr(2).starts_with(name) ||
+        argument.substr(2 + name.size(), 1) != "=")
+        return false;
+
+    value = argument.substr(3 + name.size());
+    return true;
+}
+
+static size_t parse_size(std::string_view const value)
+{
+    return std::strtoull(std::string{value}.c_str(), nullptr, 10);
+}
+
+// Removes the dataset options from the arguments and stores them in the options.
+static void parse_scaling_options(int & argc, char ** argv)
+{
+    scaling_options & config = options();
+    int kept{1};
+    for (int idx = 1; idx < argc; ++idx) {
+        std::string_view value{};
+        if (parse_option(argv[idx], "max_threads", value)) {
+            config.max_threads = std::max<size_t>(parse_size(value), 1);
+        } else if (parse_option(argv[idx], "source_sizes", value)) {
+            config.source_sizes.clear();
+            for (auto && size : value | std::views::split(','))
+                config.source_sizes.push_back(parse_size(std::string_view{size.begin(), size.end()}));
+        } else if (parse_option(argv[idx], "haplotypes", value)) {
+            config.haplotypes = std::max<size_t>(parse_size(value), 1);
+        } else if (parse_option(argv[idx], "variant_distance", value)) {
+            config.variant_distance = std::max<size_t>(parse_size(value), 1);
+        } else if (parse_option(argv[idx], "indels", value)) {
+            config.indel_permille = parse_size(value);
+        } else if (parse_option(argv[idx], "chunk_size", value)) {
+            config.chunk_size = std::max<size_t>(parse_size(value), 1);
+        } else if (parse_option(argv[idx], "window", value)) {
+            config.window_size = std::clamp<size_t>(parse_size(value), 1, 64);
+        } else {
+            argv[kept++] = argv[idx];
+        }
+    }
+    argc = kept;
+}
+
+int main(int argc, char ** argv)
+{
+    parse_scaling_options(argc, argv);
+
+    // The single threaded search of every configuration is registered first, such that it is the baseline of the
+    // speed-up of the following ones.
+    scaling_options const & config = options();
+    std::vector<int64_t> thread_counts{};
+    for (size_t threads = 1; threads < config.max_threads; threads *= 2)
+        thread_counts.push_back(threads);
+    thread_counts.push_back(config.max_threads);
+
+    for (int64_t work_stealing : {0, 1})
+        for (size_t const source_size : config.source_sizes)
+            for (int64_t const threads : thread_counts)
+                benchmark::RegisterBenchmark("benchmark_thread_scaling", benchmark_thread_scaling)
+                    ->ArgNames({"source", "threads", "stealing"})
+                    ->Args({static_cast<int64_t>(source_size), threads, work_stealing})
+                    ->UseRealTime()
+                    ->Unit(benchmark::kMillisecond);
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
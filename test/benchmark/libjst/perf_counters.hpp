@@ -0,0 +1,124 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#pragma once
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#ifndef LIBJST_BENCHMARK_PERF_COUNTERS
+#define LIBJST_BENCHMARK_PERF_COUNTERS 0
+#endif
+
+#if LIBJST_BENCHMARK_PERF_COUNTERS && defined(__linux__)
+#include <cstring>
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Counts hardware events of the calling thread with perf_event and reports them per iteration as user counters.
+//
+// The counters are enabled by the constructor, which is placed right before the benchmark loop, and are read by
+// stop(), which is called right after it, such that the setup of the benchmark is not counted; the pauses of the
+// timing are counted. The counted events are cycles, instructions, cache misses, branch misses and data TLB misses.
+// An event that can not be opened, e.g. because of the perf_event_paranoid setting or within a virtual machine
+// without a PMU, is not reported. The counters are only collected if the benchmarks are configured with
+// LIBJST_BENCHMARK_PERF_COUNTERS on Linux and are a no-op otherwise.
+class perf_counters {
+private:
+
+    struct event {
+        char const * name;
+        uint32_t type;
+        uint64_t config;
+    };
+
+#if LIBJST_BENCHMARK_PERF_COUNTERS && defined(__linux__)
+    static constexpr std::array<event, 5> _events{{
+        {"cycles", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+        {"instructions", PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+        {"cache_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+        {"branch_misses", PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+        {"dtlb_misses", PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_DTLB |
+                                            (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                                            (PERF_COUNT_HW_CACHE_RESULT_MISS << 16)}
+    }};
+#else
+    static constexpr std::array<event, 0> _events{};
+#endif
+
+    benchmark::State & _state;
+    std::array<int, _events.size()> _descriptors{};
+    bool _stopped{false};
+
+public:
+
+    explicit perf_counters(benchmark::State & state) : _state{state}
+    {
+#if LIBJST_BENCHMARK_PERF_COUNTERS && defined(__linux__)
+        for (size_t idx = 0; idx < _events.size(); ++idx) {
+            perf_event_attr attributes{};
+            std::memset(&attributes, 0, sizeof(attributes));
+            attributes.size = sizeof(attributes);
+            attributes.type = _events[idx].type;
+            attributes.config = _events[idx].config;
+            attributes.disabled = 1;
+            attributes.exclude_kernel = 1;
+            attributes.exclude_hv = 1;
+            attributes.inherit = 1; // counts the threads spawned by the benchmark, e.g. parallel traversals.
+            _descriptors[idx] = static_cast<int>(syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0));
+        }
+        for (int const descriptor : _descriptors) {
+            if (descriptor >= 0) {
+                ioctl(descriptor, PERF_EVENT_IOC_RESET, 0);
+                ioctl(descriptor, PERF_EVENT_IOC_ENABLE, 0);
+            }
+        }
+#endif
+    }
+
+    perf_counters(perf_counters const &) = delete;
+    perf_counters & operator=(perf_counters const &) = delete;
+
+    ~perf_counters()
+    {
+        stop();
+#if LIBJST_BENCHMARK_PERF_COUNTERS && defined(__linux__)
+        for (int const descriptor : _descriptors)
+            if (descriptor >= 0)
+                close(descriptor);
+#endif
+    }
+
+    // Disables the counters and reports the events counted per iteration.
+    void stop()
+    {
+        if (std::exchange(_stopped, true))
+            return;
+
+#if LIBJST_BENCHMARK_PERF_COUNTERS && defined(__linux__)
+        for (int const descriptor : _descriptors)
+            if (descriptor >= 0)
+                ioctl(descriptor, PERF_EVENT_IOC_DISABLE, 0);
+
+        for (size_t idx = 0; idx < _events.size(); ++idx) {
+            uint64_t count{};
+            if (_descriptors[idx] < 0 || read(_descriptors[idx], &count, sizeof(count)) != sizeof(count))
+                continue;
+            _state.counters[_events[idx].name] = benchmark::Counter(static_cast<double>(count),
+                                                                    benchmark::Counter::kAvgIterations);
+        }
+#endif
+    }
+};
@@ -0,0 +1,138 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/sequence_tree/coloured_tree.hpp>
+#include <libjst/sequence_tree/labelled_tree.hpp>
+#include <libjst/sequence_tree/merge_tree.hpp>
+#include <libjst/sequence_tree/prune_unsupported.hpp>
+#include <libjst/sequence_tree/seekable_tree.hpp>
+#include <libjst/sequence_tree/trim_tree.hpp>
+#include <libjst/sequence_tree/volatile_tree.hpp>
+#include <libjst/traversal/tree_traverser_base.hpp>
+
+static constexpr size_t source_size = 1ull << 16;
+static constexpr size_t haplotype_count = 64;
+static constexpr size_t window_size = 32;
+
+using coverage_t = libjst::bit_coverage<uint32_t>;
+using cms_t = libjst::dna_compressed_multisequence<std::string, coverage_t>;
+using rcs_store_t = libjst::rcs_store<std::string, cms_t>;
+
+// A store with a SNV every 16 positions on average, shared by all benchmarks and threads.
+inline rcs_store_t const & shared_store()
+{
+    static rcs_store_t const store = [] () {
+        std::mt19937_64 generator{42};
+        std::string source(source_size, 'A');
+        std::ranges::generate(source, [&] () { return "ACGT"[generator() % 4]; });
+
+        rcs_store_t store{source, haplotype_count};
+        auto domain = store.variants().coverage_domain();
+        for (uint32_t position = 1; position < source_size; position += 1 + generator() % 31) {
+            std::vector<uint32_t> haplotypes{};
+            for (uint32_t haplotype = 0; haplotype < haplotype_count; ++haplotype)
+                if (generator() % 8 == 0)
+                    haplotypes.push_back(haplotype);
+            if (haplotypes.empty())
+                continue;
+
+            store.add(std::ranges::range_value_t<cms_t>{libjst::breakpoint{position, 1},
+                                                        std::string{(source[position] == 'A') ? 'C' : 'A'},
+                                                        coverage_t{haplotypes, domain}});
+        }
+        return store;
+    }();
+    return store;
+}
+
+inline auto make_tree()
+{
+    return libjst::make_volatile(shared_store()) | libjst::labelled()
+                                                 | libjst::coloured()
+                                                 | libjst::trim(window_size - 1)
+                                                 | libjst::prune_unsupported()
+                                                 | libjst::merge()
+                                                 | libjst::seek();
+}
+
+// The positions of all nodes of the tree in random order.
+inline std::vector<libjst::seek_position> const & shared_positions()
+{
+    static std::vector<libjst::seek_position> const positions = [] () {
+        auto tree = make_tree();
+        std::vector<libjst::seek_position> positions{};
+        libjst::tree_traverser_base path{tree};
+        for (auto it = path.begin(); it != path.end(); ++it)
+            positions.push_back((*it).position());
+
+        std::ranges::shuffle(positions, std::mt19937_64{7});
+        return positions;
+    }();
+    return positions;
+}
+
+// ----------------------------------------------------------------------------
+// Benchmark seeking every position on its own
+// ----------------------------------------------------------------------------
+
+void benchmark_seek(benchmark::State & state)
+{
+    auto tree = make_tree();
+    std::vector<libjst::seek_position> const & positions = shared_positions();
+    size_t const batch_size = std::min<size_t>(state.range(0), positions.size());
+
+    size_t symbols{};
+    for (auto _ : state)
+    {
+        for (size_t idx = 0; idx < batch_size; ++idx) {
+            auto node = tree.seek(positions[idx]);
+            symbols += std::ranges::size((*node).sequence());
+        }
+        benchmark::DoNotOptimize(symbols);
+    }
+
+    state.counters["seeks_per_second"] = benchmark::Counter(batch_size, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+// ----------------------------------------------------------------------------
+// Benchmark seeking a batch of positions at once
+// ----------------------------------------------------------------------------
+
+void benchmark_seek_many(benchmark::State & state)
+{
+    auto tree = make_tree();
+    std::vector<libjst::seek_position> const & positions = shared_positions();
+    size_t const batch_size = std::min<size_t>(state.range(0), positions.size());
+    std::span<libjst::seek_position const> batch{positions.data(), batch_size};
+
+    size_t symbols{};
+    for (auto _ : state)
+    {
+        tree.seek_many(batch, [&] (size_t, auto const & node) {
+            symbols += std::ranges::size((*node).sequence());
+        });
+        benchmark::DoNotOptimize(symbols);
+    }
+
+    state.counters["seeks_per_second"] = benchmark::Counter(batch_size, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK(benchmark_seek)->RangeMultiplier(8)->Range(1 << 6, 1 << 15)->ThreadRange(1, 8)->UseRealTime();
+BENCHMARK(benchmark_seek_many)->RangeMultiplier(8)->Range(1 << 6, 1 << 15)->ThreadRange(1, 8)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -33,7 +33,8 @@ variant_kind kind(variant_t const & var) {
         return variant_kind::deletion;
 }
 
-auto generate_variants(size_t const source_size, int const variant_count) {
+// Generates the given number of variants at distinct positions; the indel fraction applies to more than 10 variants.
+auto generate_variants(size_t const source_size, int const variant_count, double const indel_fraction = 0.01) {
     using sequence_t = std::vector<char>;
     // number of SNVs
     // number of small InDels
@@ -55,7 +56,7 @@ auto generate_variants(size_t const source_size, int const variant_count) {
     if (variant_count <= 10) { // Only SNVs
         snv_count = variant_count;
     } else { // SNV and InDel
-        snv_count = std::floor(variant_count * 0.99);
+        snv_count = std::floor(variant_count * (1.0 - indel_fraction));
         indel_count = std::max<int>(variant_count - snv_count, 0);
     }
     // std::cout << "Generate SNVs\n";
@@ -8,6 +8,7 @@
 #include <benchmark/benchmark.h>
 
 #include <algorithm>
+#include <cstdint>
 #include <cstring>
 #include <vector>
 #include <memory_resource>
@@ -17,7 +18,9 @@
 #include <seqan3/test/performance/sequence_generator.hpp>
 #include <seqan3/test/performance/units.hpp>
 
+#include <libjst/utility/pointer_random_access_iterator.hpp>
 #include <libjst/utility/sorted_vector.hpp>
+#include <libjst/utility/stable_random_access_iterator.hpp>
 
 static constexpr int32_t min_range = 1ull<<0;
 static constexpr int32_t max_range = 1ull<<10;
@@ -177,6 +180,83 @@ BENCHMARK_CAPTURE(benchmark_access_linear, sorted_vector, libjst::sorted_vector<
     ->Range(min_range, max_range);
 
 
+// ----------------------------------------------------------------------------
+// Benchmark the const iterators of sorted_vector
+// ----------------------------------------------------------------------------
+
+// Scans the elements like a tree node scans the breakends: the iterator is kept in memory between the steps, such
+// that the stable iterator reloads the container on every dereference. The pointer iterator is the const iterator
+// if LIBJST_POINTER_ITERATORS is enabled.
+template <typename iterator_t>
+void benchmark_iterator_scan(benchmark::State & state)
+{
+    size_t const size = state.range(0);
+
+    std::vector<size_t> elements;
+    std::ranges::generate_n(std::back_inserter(elements), size, [] () { return static_cast<size_t>(std::rand()); });
+    std::ranges::sort(elements);
+    std::vector<size_t> const & const_elements = elements;
+
+    size_t sum{};
+    for (auto _ : state)
+    {
+        iterator_t it{std::addressof(const_elements), 0};
+        iterator_t const last{std::addressof(const_elements), std::ranges::ssize(const_elements)};
+        for (; it != last; ++it)
+        {
+            benchmark::DoNotOptimize(it);
+            sum += *it;
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+
+    state.counters["elements_per_second"] = benchmark::Counter(size, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK_TEMPLATE(benchmark_iterator_scan, libjst::stable_random_access_iterator<std::vector<size_t> const>)
+    ->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(benchmark_iterator_scan, libjst::pointer_random_access_iterator<std::vector<size_t> const>)
+    ->RangeMultiplier(32)->Range(1 << 10, 1 << 20);
+
+// ----------------------------------------------------------------------------
+// Benchmark lower bound of random keys in large containers
+// ----------------------------------------------------------------------------
+
+template <typename build_index_t>
+void benchmark_lower_bound(benchmark::State & state, build_index_t)
+{
+    size_t const size = state.range(0);
+
+    std::vector<uint32_t> elements;
+    std::ranges::generate_n(std::back_inserter(elements), size, [] () { return static_cast<uint32_t>(std::rand()); });
+
+    libjst::sorted_vector<uint32_t> cont{};
+    cont.insert(elements);
+    if constexpr (build_index_t::value)
+        cont.build_search_index();
+
+    std::vector<uint32_t> keys;
+    std::ranges::generate_n(std::back_inserter(keys), 1 << 16, [] () { return static_cast<uint32_t>(std::rand()); });
+
+    size_t offset_sum{};
+    for (auto _ : state)
+    {
+        for (uint32_t key : keys)
+            offset_sum += cont.lower_bound(key) - cont.begin();
+
+        benchmark::DoNotOptimize(offset_sum);
+    }
+
+    state.counters["lookups_per_second"] = benchmark::Counter(keys.size(),
+                                                              benchmark::Counter::kIsIterationInvariantRate);
+    state.counters["size"] = cont.size();
+}
+
+BENCHMARK_CAPTURE(benchmark_lower_bound, binary_search, std::false_type{})
+    ->RangeMultiplier(8)->Range(1 << 10, 1 << 25);
+BENCHMARK_CAPTURE(benchmark_lower_bound, eytzinger_index, std::true_type{})
+    ->RangeMultiplier(8)->Range(1 << 10, 1 << 25);
+
 // ----------------------------------------------------------------------------
 // Run benchmark
 // ----------------------------------------------------------------------------
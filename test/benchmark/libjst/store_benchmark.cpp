@@ -0,0 +1,215 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <cereal/archives/binary.hpp>
+#include <cereal/archives/portable_binary.hpp>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/serialisation/concept.hpp>
+#include <libjst/serialisation/raw_archive.hpp>
+
+#include "sequence_variant_simulation.hpp"
+
+static constexpr size_t source_size = 1ull << 20;
+static constexpr size_t haplotype_count = 64;
+
+using coverage_t = libjst::bit_coverage<uint32_t>;
+using cms_t = libjst::dna_compressed_multisequence<std::string, coverage_t>;
+using rcs_store_t = libjst::rcs_store<std::string, cms_t>;
+using cms_value_t = std::ranges::range_value_t<cms_t>;
+
+inline std::string const & shared_source()
+{
+    static std::string const source = [] () {
+        std::mt19937_64 generator{42};
+        std::string source(source_size, 'A');
+        std::ranges::generate(source, [&] () { return "ACGT"[generator() % 4]; });
+        return source;
+    }();
+    return source;
+}
+
+// The simulated variants with one percent indels, each covered by an eighth of the haplotypes, either sorted by
+// their position or shuffled.
+inline std::vector<cms_value_t> generate_deltas(size_t const variant_count, bool const sorted)
+{
+    std::string const & source = shared_source();
+    libjst::range_domain<uint32_t> const domain{0, haplotype_count};
+    std::mt19937_64 generator{7};
+
+    auto variants = generate_variants(source_size, variant_count);
+    std::vector<cms_value_t> deltas{};
+    deltas.reserve(variants.size());
+    for (auto const & [position, deletion, insertion] : variants) {
+        if (position == 0 || position + deletion >= source_size)
+            continue;
+
+        std::vector<uint32_t> haplotypes{};
+        for (uint32_t haplotype = 0; haplotype < haplotype_count; ++haplotype)
+            if (generator() % 8 == 0)
+                haplotypes.push_back(haplotype);
+        if (haplotypes.empty())
+            haplotypes.push_back(0);
+
+        std::string alt_sequence{};
+        if (!insertion.empty())
+            alt_sequence.push_back((source[position] == 'A') ? 'C' : 'A');
+
+        deltas.emplace_back(libjst::breakpoint{static_cast<uint32_t>(position), static_cast<uint32_t>(deletion)},
+                            std::move(alt_sequence),
+                            coverage_t{haplotypes, domain});
+    }
+
+    if (sorted)
+        std::ranges::sort(deltas, std::less<>{}, [] (auto const & delta) { return libjst::low_breakend(delta); });
+    else
+        std::ranges::shuffle(deltas, generator);
+    return deltas;
+}
+
+// ----------------------------------------------------------------------------
+// Benchmark the construction of the store
+// ----------------------------------------------------------------------------
+
+// Adds the deltas one by one, which shifts the stored breakends on every insertion.
+// Arguments: variant count, whether the deltas are sorted.
+void benchmark_store_add(benchmark::State & state)
+{
+    std::vector<cms_value_t> const deltas = generate_deltas(state.range(0), state.range(1));
+
+    for (auto _ : state)
+    {
+        rcs_store_t store{shared_source(), haplotype_count};
+        for (cms_value_t const & delta : deltas)
+            store.add(delta);
+        benchmark::DoNotOptimize(store);
+    }
+
+    state.SetItemsProcessed(state.iterations() * deltas.size());
+}
+
+// Builds the breakend map of the store once from all deltas.
+void benchmark_store_bulk(benchmark::State & state)
+{
+    std::vector<cms_value_t> const deltas = generate_deltas(state.range(0), state.range(1));
+
+    for (auto _ : state)
+    {
+        rcs_store_t store{shared_source(), haplotype_count, deltas};
+        benchmark::DoNotOptimize(store);
+    }
+
+    state.SetItemsProcessed(state.iterations() * deltas.size());
+}
+
+static void construction_arguments(benchmark::internal::Benchmark * benchmark)
+{
+    benchmark->ArgNames({"variants", "sorted"});
+    for (int64_t sorted : {0, 1})
+        for (int64_t variants = 1 << 10; variants <= 1 << 16; variants <<= 2)
+            benchmark->Args({variants, sorted});
+}
+
+BENCHMARK(benchmark_store_add)->Apply(construction_arguments);
+BENCHMARK(benchmark_store_bulk)->Apply(construction_arguments);
+
+// ----------------------------------------------------------------------------
+// Benchmark the serialisation of the store
+// ----------------------------------------------------------------------------
+
+inline rcs_store_t const & shared_store(size_t const variant_count)
+{
+    static std::map<size_t, rcs_store_t> stores{};
+
+    if (auto it = stores.find(variant_count); it != stores.end())
+        return it->second;
+
+    return stores.try_emplace(variant_count, shared_source(), haplotype_count, generate_deltas(variant_count, true))
+                 .first->second;
+}
+
+template <typename oarchive_t>
+std::string save_store(rcs_store_t const & store)
+{
+    std::ostringstream stream{};
+    {
+        oarchive_t oarchive{stream};
+        libjst::save(store, oarchive);
+    } // the archive is completed on destruction
+    return std::move(stream).str();
+}
+
+// Arguments: variant count.
+template <typename oarchive_t>
+void benchmark_save(benchmark::State & state)
+{
+    rcs_store_t const & store = shared_store(state.range(0));
+
+    size_t bytes{};
+    for (auto _ : state)
+    {
+        std::string buffer = save_store<oarchive_t>(store);
+        bytes = buffer.size();
+        benchmark::DoNotOptimize(buffer);
+    }
+
+    state.SetBytesProcessed(state.iterations() * bytes);
+    state.counters["archive_bytes"] = bytes;
+}
+
+template <typename oarchive_t, typename iarchive_t>
+void benchmark_load(benchmark::State & state)
+{
+    std::string const buffer = save_store<oarchive_t>(shared_store(state.range(0)));
+
+    for (auto _ : state)
+    {
+        std::istringstream stream{buffer};
+        rcs_store_t store{};
+        {
+            iarchive_t iarchive{stream};
+            libjst::load(store, iarchive);
+            if constexpr (requires { iarchive.finish(); }) // verifies the checksum of the raw archive
+                iarchive.finish();
+        }
+        benchmark::DoNotOptimize(store);
+    }
+
+    state.SetBytesProcessed(state.iterations() * buffer.size());
+    state.counters["archive_bytes"] = buffer.size();
+}
+
+static void serialisation_arguments(benchmark::internal::Benchmark * benchmark)
+{
+    benchmark->ArgNames({"variants"});
+    for (int64_t variants = 1 << 10; variants <= 1 << 16; variants <<= 2)
+        benchmark->Args({variants});
+}
+
+BENCHMARK_TEMPLATE(benchmark_save, cereal::BinaryOutputArchive)->Apply(serialisation_arguments);
+BENCHMARK_TEMPLATE(benchmark_save, cereal::PortableBinaryOutputArchive)->Apply(serialisation_arguments);
+BENCHMARK_TEMPLATE(benchmark_save, libjst::raw_binary_output_archive)->Apply(serialisation_arguments);
+BENCHMARK_TEMPLATE(benchmark_load, cereal::BinaryOutputArchive, cereal::BinaryInputArchive)
+    ->Apply(serialisation_arguments);
+BENCHMARK_TEMPLATE(benchmark_load, cereal::PortableBinaryOutputArchive, cereal::PortableBinaryInputArchive)
+    ->Apply(serialisation_arguments);
+BENCHMARK_TEMPLATE(benchmark_load, libjst::raw_binary_output_archive, libjst::raw_binary_input_archive)
+    ->Apply(serialisation_arguments);
+
+BENCHMARK_MAIN();
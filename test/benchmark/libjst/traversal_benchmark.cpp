@@ -0,0 +1,263 @@
+// -----------------------------------------------------------------------------------------------------
+// Copyright (c) 2006-2021, Knut Reinert & Freie Universität Berlin
+// Copyright (c) 2016-2021, Knut Reinert & MPI für molekulare Genetik
+// This file may be used, modified and/or redistributed under the terms of the 3-clause BSD-License
+// shipped with this file and also available at: https://github.com/seqan/seqan3/blob/master/LICENSE.md
+// -----------------------------------------------------------------------------------------------------
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <functional>
+#include <map>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <libjst/coverage/bit_coverage.hpp>
+#include <libjst/matcher/aho_corasick_matcher.hpp>
+#include <libjst/matcher/shift_or_matcher.hpp>
+#include <libjst/rcms/dna_compressed_multisequence.hpp>
+#include <libjst/rcms/rcs_store.hpp>
+#include <libjst/sequence_tree/volatile_tree.hpp>
+#include <libjst/traversal/state_capture_traverser.hpp>
+#include <libjst/traversal/stack_publisher.hpp>
+#include <libjst/traversal/state_oblivious_traverser.hpp>
+#include <libjst/utility/memory_usage.hpp>
+
+#include "allocation_counters.hpp"
+#include "perf_counters.hpp"
+#include "sequence_variant_simulation.hpp"
+
+static constexpr size_t source_size = 1ull << 16;
+
+using coverage_t = libjst::bit_coverage<uint32_t>;
+using cms_t = libjst::dna_compressed_multisequence<std::string, coverage_t>;
+using rcs_store_t = libjst::rcs_store<std::string, cms_t>;
+
+// A store with one variant every variant_distance positions on average, of which indel_permille per thousand are
+// indels, and every variant covered by an eighth of the haplotypes. The stores are cached per configuration.
+inline rcs_store_t const & shared_store(size_t const haplotype_count,
+                                        size_t const variant_distance,
+                                        size_t const indel_permille)
+{
+    static std::map<std::tuple<size_t, size_t, size_t>, rcs_store_t> stores{};
+
+    auto key = std::tuple{haplotype_count, variant_distance, indel_permille};
+    if (auto it = stores.find(key); it != stores.end())
+        return it->second;
+
+    std::mt19937_64 generator{42};
+    std::string source(source_size, 'A');
+    std::ranges::generate(source, [&] () { return "ACGT"[generator() % 4]; });
+    auto other_base = [&] (char const base) {
+        size_t const rank = std::string{"ACGT"}.find(base);
+        return "ACGT"[(rank + 1 + generator() % 3) % 4];
+    };
+
+    rcs_store_t & store = stores.try_emplace(key, source, haplotype_count).first->second;
+    auto domain = store.variants().coverage_domain();
+    // The variants are added in the order of their positions, which appends every breakend to the breakend map.
+    auto variants = generate_variants(source_size, source_size / variant_distance, indel_permille / 1000.0);
+    std::ranges::sort(variants, std::less<>{}, [] (auto const & variant) { return std::get<0>(variant); });
+    for (auto const & variant : variants) {
+        auto const & [position, deletion, insertion] = variant;
+        if (position == 0 || position + deletion >= source_size)
+            continue;
+
+        std::vector<uint32_t> haplotypes{};
+        for (uint32_t haplotype = 0; haplotype < haplotype_count; ++haplotype)
+            if (generator() % 8 == 0)
+                haplotypes.push_back(haplotype);
+        if (haplotypes.empty())
+            continue;
+
+        std::string alt_sequence{};
+        if (!insertion.empty())
+            alt_sequence.push_back(other_base(source[position]));
+
+        store.add(std::ranges::range_value_t<cms_t>{libjst::breakpoint{static_cast<uint32_t>(position),
+                                                                       static_cast<uint32_t>(deletion)},
+                                                    std::move(alt_sequence),
+                                                    coverage_t{haplotypes, domain}});
+    }
+    return store;
+}
+
+// Counts the labels and the symbols the wrapped matcher is invoked with.
+template <typename matcher_t>
+struct counting_matcher {
+    matcher_t matcher;
+    size_t labels{};
+    size_t symbols{};
+
+    using state_type = typename matcher_t::state_type;
+
+    constexpr size_t window_size() const noexcept {
+        return matcher.window_size();
+    }
+
+    template <typename haystack_t, typename callback_t>
+    void operator()(haystack_t && haystack, callback_t && callback) {
+        ++labels;
+        symbols += std::ranges::size(haystack);
+        matcher(haystack, callback);
+    }
+
+    state_type capture() const noexcept {
+        return matcher.capture();
+    }
+
+    void restore(state_type const state) noexcept {
+        matcher.restore(state);
+    }
+
+    void reset() noexcept {
+        matcher.reset();
+    }
+};
+
+// ----------------------------------------------------------------------------
+// Benchmark the traversals for a pattern of the given window size
+// ----------------------------------------------------------------------------
+
+// Arguments: window size, haplotype count, average distance between two variants, indels per thousand variants.
+template <typename traverser_t>
+void benchmark_traversal(benchmark::State & state)
+{
+    size_t const window_size = state.range(0);
+    rcs_store_t const & store = shared_store(state.range(1), state.range(2), state.range(3));
+
+    std::mt19937_64 generator{7};
+    std::string needle(window_size, 'A');
+    std::ranges::generate(needle, [&] () { return "ACGT"[generator() % 4]; });
+    counting_matcher<libjst::shift_or_matcher> pattern{libjst::shift_or_matcher{needle}};
+
+    size_t hits{};
+    libjst::stack_depth_monitor monitor{};
+    allocation_counters allocations{state};
+    perf_counters perf{state};
+    for (auto _ : state)
+    {
+        traverser_t{}(libjst::make_volatile(store), pattern, [&] (auto &&, auto &&) { ++hits; }, monitor);
+        benchmark::DoNotOptimize(hits);
+    }
+    perf.stop();
+    allocations.stop();
+
+    state.counters["nodes_per_second"] = benchmark::Counter(pattern.labels, benchmark::Counter::kIsRate);
+    state.counters["bases_per_second"] = benchmark::Counter(pattern.symbols, benchmark::Counter::kIsRate);
+    state.counters["variants"] = store.variants().size();
+    if (pattern.labels > 0)
+        state.counters["allocations_per_node"] = static_cast<double>(allocations.allocations()) / pattern.labels;
+
+    // The memory of the store and the peak depth of the branch, recorded alongside the timings for capacity planning.
+    libjst::store_memory_usage const memory = store.memory_usage();
+    state.counters["store_bytes"] = benchmark::Counter(memory.total(), benchmark::Counter::kDefaults,
+                                                       benchmark::Counter::kIs1024);
+    state.counters["coverage_bytes"] = benchmark::Counter(memory.coverages, benchmark::Counter::kDefaults,
+                                                          benchmark::Counter::kIs1024);
+    state.counters["peak_depth"] = monitor.peak_depth();
+}
+
+static void traversal_arguments(benchmark::internal::Benchmark * benchmark)
+{
+    benchmark->ArgNames({"window", "haplotypes", "distance", "indels"});
+    for (int64_t window : {16, 32, 64})
+        benchmark->Args({window, 64, 16, 10});
+    for (int64_t haplotypes : {8, 256, 2048})
+        benchmark->Args({32, haplotypes, 16, 10});
+    for (int64_t distance : {4, 64})
+        benchmark->Args({32, 64, distance, 10});
+    for (int64_t indels : {0, 100})
+        benchmark->Args({32, 64, 16, indels});
+}
+
+BENCHMARK_TEMPLATE(benchmark_traversal, libjst::state_oblivious_traverser)->Apply(traversal_arguments);
+BENCHMARK_TEMPLATE(benchmark_traversal, libjst::state_capture_traverser)->Apply(traversal_arguments);
+
+// ----------------------------------------------------------------------------
+// Benchmark the cached left context of the state oblivious traverser
+// ----------------------------------------------------------------------------
+
+// Arguments: window size, average distance between two variants, whether the left context is cached.
+static void benchmark_left_context(benchmark::State & state)
+{
+    size_t const window_size = state.range(0);
+    rcs_store_t const & store = shared_store(64, state.range(1), 10);
+
+    std::mt19937_64 generator{7};
+    std::string needle(window_size, 'A');
+    std::ranges::generate(needle, [&] () { return "ACGT"[generator() % 4]; });
+    counting_matcher<libjst::shift_or_matcher> pattern{libjst::shift_or_matcher{needle}};
+
+    libjst::state_oblivious_traverser traverser{};
+    traverser.cache_left_context(state.range(2) != 0);
+    size_t hits{};
+    allocation_counters allocations{state};
+    perf_counters perf{state};
+    for (auto _ : state)
+    {
+        traverser(libjst::make_volatile(store), pattern, [&] (auto &&, auto &&) { ++hits; });
+        benchmark::DoNotOptimize(hits);
+    }
+    perf.stop();
+    allocations.stop();
+
+    state.counters["bases_per_second"] = benchmark::Counter(pattern.symbols, benchmark::Counter::kIsRate);
+}
+
+BENCHMARK(benchmark_left_context)->ArgNames({"window", "distance", "cached"})
+                                 ->ArgsProduct({{16, 64}, {4, 16}, {0, 1}});
+
+// ----------------------------------------------------------------------------
+// Benchmark the search of many guides in one traversal
+// ----------------------------------------------------------------------------
+
+// Arguments: number of guides of 23 bases, whether they are searched with one automaton instead of one by one.
+static void benchmark_multi_pattern(benchmark::State & state)
+{
+    size_t const guide_count = state.range(0);
+    rcs_store_t const & store = shared_store(64, 16, 10);
+
+    std::mt19937_64 generator{7};
+    std::vector<std::string> guides(guide_count, std::string(23, 'A'));
+    for (std::string & guide : guides)
+        std::ranges::generate(guide, [&] () { return "ACGT"[generator() % 4]; });
+
+    size_t hits{};
+    if (state.range(1) != 0) {
+        libjst::aho_corasick_matcher pattern{guides};
+        perf_counters perf{state};
+        for (auto _ : state)
+        {
+            libjst::state_oblivious_traverser{}(libjst::make_volatile(store), pattern, [&] (auto &&, auto &&) {
+                hits += pattern.matched_patterns().size();
+            });
+            benchmark::DoNotOptimize(hits);
+        }
+        perf.stop();
+        state.counters["automaton_bytes"] = benchmark::Counter(pattern.memory_usage(), benchmark::Counter::kDefaults,
+                                                               benchmark::Counter::kIs1024);
+    } else {
+        perf_counters perf{state};
+        for (auto _ : state)
+        {
+            for (std::string const & guide : guides)
+                libjst::state_oblivious_traverser{}(libjst::make_volatile(store), libjst::shift_or_matcher{guide},
+                                                    [&] (auto &&, auto &&) { ++hits; });
+            benchmark::DoNotOptimize(hits);
+        }
+        perf.stop();
+    }
+
+    state.counters["guides_per_second"] = benchmark::Counter(guide_count,
+                                                             benchmark::Counter::kIsIterationInvariantRate);
+}
+
+BENCHMARK(benchmark_multi_pattern)->ArgNames({"guides", "automaton"})
+                                  ->Args({16, 0})->Args({128, 0})
+                                  ->ArgsProduct({{16, 128, 4096, 65536}, {1}});
+
+BENCHMARK_MAIN();